@@ -341,6 +341,15 @@ _TESTS = {
             )
         },
 
+    #e3sm MMF tests of the single precision CRM, whose climate the MVK test
+    #compares against baselines generated with the same build
+    "e3sm_mmf_single_prec" : {
+        "tests" : (
+            "ERS_Ln9.ne4pg2_ne4pg2.F2010-MMF1.eam-mmf_single_prec",
+            "MVK_PS.ne4pg2_oQU480.F2010-MMF1.eam-mmf_single_prec",
+            )
+        },
+
     #e3sm tests to mimic production runs
     "e3sm_prod" : {
         "inherit" : "e3sm_atm_prod",
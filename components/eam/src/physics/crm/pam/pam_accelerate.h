@@ -2,7 +2,37 @@
 
 #include "pam_coupler.h"
 
+real constexpr pam_accelerate_dtemp_max = 5; // temperature tendency max threshold =>  5 K following UP-CAM
+
+// Largest horizontal-mean temperature change over a single CRM step seen
+// during the current (or, before pam_accelerate_nstop, the previous) CRM call
+// on this task. Negative until it has been measured once. The coupler is
+// reset every call, so this is kept here. Only used with crm_accel_adaptive.
+inline real &pam_accelerate_drift() {
+  static real drift = -1;
+  return drift;
+}
+
+// Choose the acceleration factor for this CRM call. crm_accel_factor from the
+// namelist is the upper bound; the factor is reduced until the accelerated
+// drift of the previous call stays below half of pam_accelerate_dtemp_max and
+// (1 + factor) divides nstop.
+inline real pam_accelerate_adaptive_factor( int nstop, real factor_max, real drift ) {
+  int factor = static_cast<int>(factor_max);
+  if (drift > 0) {
+    factor = std::min( factor, static_cast<int>(0.5*pam_accelerate_dtemp_max/drift) );
+  }
+  while (factor > 0 && nstop%(1+factor) != 0) { factor--; }
+  return factor;
+}
+
 void pam_accelerate_nstop( pam::PamCoupler &coupler, int &nstop) {
+  if (coupler.get_option<bool>("crm_accel_adaptive")) {
+    auto &drift = pam_accelerate_drift();
+    coupler.set_option<real>("crm_accel_factor",
+      pam_accelerate_adaptive_factor( nstop, coupler.get_option<real>("crm_accel_factor"), drift ));
+    drift = 0;
+  }
   auto crm_accel_factor = coupler.get_option<real>("crm_accel_factor");
   if(nstop%static_cast<int>((1+crm_accel_factor)) != 0) {
     printf("pam_accelerate_nstop: Error: (1+crm_accel_factor) does not divide equally into nstop: %4.4d  crm_accel_factor: %6.1f \n",nstop, crm_accel_factor);
@@ -105,8 +135,9 @@ inline void pam_accelerate( pam::PamCoupler &coupler, int nstep, int &nstop ) {
   auto accel_save_u = dm_device.get<real,2>("accel_save_u");
   auto accel_save_v = dm_device.get<real,2>("accel_save_v");
   //------------------------------------------------------------------------------------------------
-  bool crm_accel_uv     = coupler.get_option<bool>("crm_accel_uv");
-  real crm_accel_factor = coupler.get_option<real>("crm_accel_factor");
+  bool crm_accel_uv       = coupler.get_option<bool>("crm_accel_uv");
+  real crm_accel_factor   = coupler.get_option<real>("crm_accel_factor");
+  bool crm_accel_adaptive = coupler.get_option<bool>("crm_accel_adaptive");
   //------------------------------------------------------------------------------------------------
   real2d hmean_t  ("hmean_t",   nz,nens);
   real2d hmean_r  ("hmean_r",   nz,nens);
@@ -121,7 +152,7 @@ inline void pam_accelerate( pam::PamCoupler &coupler, int nstep, int &nstop ) {
   real2d qpoz     ("qpoz",      nz,nens);
   real2d qneg     ("qneg",      nz,nens);
   //------------------------------------------------------------------------------------------------
-  real constexpr dtemp_max = 5; // temperature tendency max threshold =>  5 K following UP-CAM
+  real constexpr dtemp_max = pam_accelerate_dtemp_max;
   real constexpr temp_min = 50; // temperature minimum minthreshold   => 50 K following UP-CAM
   //------------------------------------------------------------------------------------------------
   // Compute the horizontal mean for each variable
@@ -161,6 +192,15 @@ inline void pam_accelerate( pam::PamCoupler &coupler, int nstep, int &nstop ) {
     }
   });
   bool ceaseflag = ceaseflag_liveout.hostRead();
+  // record the drift used to choose the next call's factor in adaptive mode
+  if (crm_accel_adaptive) {
+    real2d ttend_abs("ttend_abs", nz,nens);
+    parallel_for( SimpleBounds<2>(nz,nens) , YAKL_LAMBDA (int k, int n) {
+      ttend_abs(k,n) = std::abs( ttend_acc(k,n) );
+    });
+    auto &drift = pam_accelerate_drift();
+    drift = std::max( drift, yakl::intrinsics::maxval(ttend_abs) );
+  }
   //------------------------------------------------------------------------------------------------
   // If acceleration tendencies are insane then just abort the acceleration
   if (ceaseflag) {
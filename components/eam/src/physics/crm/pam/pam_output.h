@@ -90,13 +90,10 @@ inline void pam_output_compute_means( pam::PamCoupler &coupler ) {
 inline void pam_output_copy_to_host( pam::PamCoupler &coupler ) {
   using yakl::c::parallel_for;
   using yakl::c::SimpleBounds;
-  using yakl::atomicAdd;
   auto &dm_device = coupler.get_data_manager_device_readwrite();
   auto &dm_host   = coupler.get_data_manager_host_readwrite();
   auto nens       = coupler.get_option<int>("ncrms");
   auto crm_nz     = coupler.get_option<int>("crm_nz");
-  auto crm_nx     = coupler.get_option<int>("crm_nx");
-  auto crm_ny     = coupler.get_option<int>("crm_ny");
   auto gcm_nlev   = coupler.get_option<int>("gcm_nlev");
   //------------------------------------------------------------------------------------------------
   auto qv_mean                = dm_device.get<real const,2>("qv_mean");
@@ -114,75 +111,59 @@ inline void pam_output_copy_to_host( pam::PamCoupler &coupler ) {
   auto gcm_forcing_tend_rho_d = dm_device.get<real const,2>("gcm_forcing_tend_rho_d");
   auto gcm_forcing_tend_qtot  = dm_device.get<real const,2>("gcm_forcing_tend_qtot" );
   //------------------------------------------------------------------------------------------------
-  // calculate quantites needed for forcing of total water mixing ratio
-  auto gcm_qv = dm_host.get<real const,2>("input_ql").createDeviceCopy();
-  auto gcm_qc = dm_host.get<real const,2>("input_qccl").createDeviceCopy();
-  auto gcm_qi = dm_host.get<real const,2>("input_qiil").createDeviceCopy();
-  auto dt_gcm = coupler.get_option<real>("gcm_physics_dt");
-  real r_dt_gcm = 1._fp / dt_gcm;
-  auto rho_d               = dm_device.get<real,4>("density_dry");
-  auto state_rho_d         = dm_host.get<real const,4>("state_rho_dry").createDeviceCopy();
-  auto state_qv            = dm_host.get<real const,4>("state_qv").createDeviceCopy();
-  auto state_qc            = dm_host.get<real const,4>("state_qc").createDeviceCopy();
-  auto state_qi            = dm_host.get<real const,4>("state_qi").createDeviceCopy();
-  real2d crm_hmean_qt   ("crm_hmean_qt"   ,crm_nz,nens);
-  parallel_for("Initialize horzontal means", SimpleBounds<2>(crm_nz,nens), YAKL_LAMBDA (int k_crm, int iens) {
-    crm_hmean_qt(k_crm,iens) = 0;
-  });
-  real r_nx_ny  = 1._fp/(crm_nx*crm_ny);  // precompute reciprocal to avoid costly divisions
-  parallel_for("Horz mean of CRM state", SimpleBounds<4>(crm_nz,crm_ny,crm_nx,nens), YAKL_LAMBDA (int k_crm, int j, int i, int iens) {
-    real tmp_qt = state_qv(k_crm,j,i,iens) + state_qc(k_crm,j,i,iens) + state_qi(k_crm,j,i,iens);
-    atomicAdd( crm_hmean_qt(k_crm,iens), tmp_qt * r_nx_ny );
-  });
-  //------------------------------------------------------------------------------------------------
-  // convert variables to GCM vertical grid
-  real2d forcing_tend_out_temp ("forcing_tend_out_temp ",gcm_nlev,nens);
-  real2d forcing_tend_out_rho_d("forcing_tend_out_rho_d",gcm_nlev,nens);
-  real2d forcing_tend_out_qt("forcing_tend_out_qt ",gcm_nlev,nens);
-  parallel_for("set output forcing tendencies", SimpleBounds<2>(gcm_nlev,nens), YAKL_LAMBDA (int k_gcm, int iens) {
+  // Gather all outputs on the GCM vertical grid into one array, so that they
+  // are moved to the host in a single transfer
+  int constexpr nout = 14;
+  real3d output_gcm("output_gcm",nout,gcm_nlev,nens);
+  parallel_for("gather output variables", SimpleBounds<2>(gcm_nlev,nens), YAKL_LAMBDA (int k_gcm, int iens) {
     int k_crm = gcm_nlev-1-k_gcm;
+    output_gcm( 0,k_gcm,iens) = qv_mean   (k_gcm,iens);
+    output_gcm( 1,k_gcm,iens) = qc_mean   (k_gcm,iens);
+    output_gcm( 2,k_gcm,iens) = qi_mean   (k_gcm,iens);
+    output_gcm( 3,k_gcm,iens) = qr_mean   (k_gcm,iens);
+    output_gcm( 4,k_gcm,iens) = nc_mean   (k_gcm,iens);
+    output_gcm( 5,k_gcm,iens) = ni_mean   (k_gcm,iens);
+    output_gcm( 6,k_gcm,iens) = nr_mean   (k_gcm,iens);
+    output_gcm( 7,k_gcm,iens) = qm_mean   (k_gcm,iens);
+    output_gcm( 8,k_gcm,iens) = bm_mean   (k_gcm,iens);
+    output_gcm( 9,k_gcm,iens) = rho_d_mean(k_gcm,iens);
+    output_gcm(10,k_gcm,iens) = rho_v_mean(k_gcm,iens);
     if (k_crm<crm_nz) {
-      forcing_tend_out_temp (k_gcm,iens) = gcm_forcing_tend_temp (k_crm,iens);
-      forcing_tend_out_rho_d(k_gcm,iens) = gcm_forcing_tend_rho_d(k_crm,iens);
-      forcing_tend_out_qt   (k_gcm,iens) = gcm_forcing_tend_qtot (k_crm,iens);
+      output_gcm(11,k_gcm,iens) = gcm_forcing_tend_temp (k_crm,iens);
+      output_gcm(12,k_gcm,iens) = gcm_forcing_tend_rho_d(k_crm,iens);
+      output_gcm(13,k_gcm,iens) = gcm_forcing_tend_qtot (k_crm,iens);
     } else {
-      forcing_tend_out_temp (k_gcm,iens) = 0.;
-      forcing_tend_out_rho_d(k_gcm,iens) = 0.;
-      forcing_tend_out_qt   (k_gcm,iens) = 0.;
+      output_gcm(11,k_gcm,iens) = 0.;
+      output_gcm(12,k_gcm,iens) = 0.;
+      output_gcm(13,k_gcm,iens) = 0.;
     }
   });
   //------------------------------------------------------------------------------------------------
-  auto output_qv_mean   = dm_host.get<real,2>("output_qv_mean");
-  auto output_qc_mean   = dm_host.get<real,2>("output_qc_mean");
-  auto output_qi_mean   = dm_host.get<real,2>("output_qi_mean");
-  auto output_qr_mean   = dm_host.get<real,2>("output_qr_mean");
-  auto output_nc_mean   = dm_host.get<real,2>("output_nc_mean");
-  auto output_ni_mean   = dm_host.get<real,2>("output_ni_mean");
-  auto output_nr_mean   = dm_host.get<real,2>("output_nr_mean");
-  auto output_qm_mean   = dm_host.get<real,2>("output_qm_mean");
-  auto output_bm_mean   = dm_host.get<real,2>("output_bm_mean");
-  auto output_rho_d_mean= dm_host.get<real,2>("output_rho_d_mean");
-  auto output_rho_v_mean= dm_host.get<real,2>("output_rho_v_mean");
-  auto output_t_ls      = dm_host.get<real,2>("output_t_ls");
-  auto output_rho_d_ls  = dm_host.get<real,2>("output_rho_d_ls");
-  auto output_qt_ls     = dm_host.get<real,2>("output_qt_ls");
-  //------------------------------------------------------------------------------------------------
   // Copy the data to host
-  qv_mean                 .deep_copy_to(output_qv_mean);
-  qc_mean                 .deep_copy_to(output_qc_mean);
-  qi_mean                 .deep_copy_to(output_qi_mean);
-  qr_mean                 .deep_copy_to(output_qr_mean);
-  nc_mean                 .deep_copy_to(output_nc_mean);
-  ni_mean                 .deep_copy_to(output_ni_mean);
-  nr_mean                 .deep_copy_to(output_nr_mean);
-  qm_mean                 .deep_copy_to(output_qm_mean);
-  bm_mean                 .deep_copy_to(output_bm_mean);
-  rho_d_mean              .deep_copy_to(output_rho_d_mean);
-  rho_v_mean              .deep_copy_to(output_rho_v_mean);
-  forcing_tend_out_temp   .deep_copy_to(output_t_ls);
-  forcing_tend_out_rho_d  .deep_copy_to(output_rho_d_ls);
-  forcing_tend_out_qt     .deep_copy_to(output_qt_ls);
-  yakl::fence();
+  auto output_gcm_host = output_gcm.createHostCopy();
+  auto output_qv_mean  = dm_host.get<real,2>("output_qv_mean");
+  decltype(output_qv_mean) output_host[nout] = {
+    output_qv_mean,
+    dm_host.get<real,2>("output_qc_mean"),
+    dm_host.get<real,2>("output_qi_mean"),
+    dm_host.get<real,2>("output_qr_mean"),
+    dm_host.get<real,2>("output_nc_mean"),
+    dm_host.get<real,2>("output_ni_mean"),
+    dm_host.get<real,2>("output_nr_mean"),
+    dm_host.get<real,2>("output_qm_mean"),
+    dm_host.get<real,2>("output_bm_mean"),
+    dm_host.get<real,2>("output_rho_d_mean"),
+    dm_host.get<real,2>("output_rho_v_mean"),
+    dm_host.get<real,2>("output_t_ls"),
+    dm_host.get<real,2>("output_rho_d_ls"),
+    dm_host.get<real,2>("output_qt_ls") };
+  for (int l=0; l<nout; l++) {
+    for (int k_gcm=0; k_gcm<gcm_nlev; k_gcm++) {
+      for (int iens=0; iens<nens; iens++) {
+        output_host[l](k_gcm,iens) = output_gcm_host(l,k_gcm,iens);
+      }
+    }
+  }
   //------------------------------------------------------------------------------------------------
 }
 
@@ -21,6 +21,11 @@ inline void pam_statistics_init( pam::PamCoupler &coupler ) {
   auto nz         = coupler.get_option<int>("crm_nz");
   auto ny         = coupler.get_option<int>("crm_ny");
   auto nx         = coupler.get_option<int>("crm_nx");
+  auto gcm_nlev   = coupler.get_option<int>("gcm_nlev");
+  //------------------------------------------------------------------------------------------------
+  // GCM layer thickness for water path, copied once here instead of on every CRM step
+  dm_device.register_and_allocate<real>("stat_input_pdel", "GCM layer pressure thickness", {gcm_nlev,nens},{"gcm_lev","nens"});
+  dm_host.get<real const,2>("input_pdel").deep_copy_to( dm_device.get<real,2>("stat_input_pdel") );
   //------------------------------------------------------------------------------------------------
   // aggregated quantities
   dm_device.register_and_allocate<real>("stat_aggregation_cnt",       "number of aggregated samples",  {nens},{"nens"});
@@ -313,7 +318,7 @@ inline void pam_statistics_timestep_aggregation( pam::PamCoupler &coupler ) {
   auto zint       = dm_device.get<real const,2>("vertical_interface_height");
   //------------------------------------------------------------------------------------------------
   // get CRM variables to be aggregated
-  auto input_pdel       = dm_host.get<real const,2>("input_pdel").createDeviceCopy();
+  auto input_pdel       = dm_device.get<real const,2>("stat_input_pdel");
   auto precip_liq       = dm_device.get<real const,3>("precip_liq_surf_out");
   auto precip_ice       = dm_device.get<real const,3>("precip_ice_surf_out");
   auto temp             = dm_device.get<real const,4>("temp"       );
@@ -495,8 +500,8 @@ inline void pam_statistics_copy_to_host( pam::PamCoupler &coupler ) {
   auto nens       = coupler.get_option<int>("ncrms");
   auto crm_nz     = coupler.get_option<int>("crm_nz");
   auto gcm_nlev   = coupler.get_option<int>("gcm_nlev");
+  bool enable_physics_tend_stats = coupler.get_option<bool>("enable_physics_tend_stats");
   //------------------------------------------------------------------------------------------------
-  // convert aggregated values to time means
   auto precip_liq            = dm_device.get<real,1>("precip_liq_aggregated");
   auto precip_ice            = dm_device.get<real,1>("precip_ice_aggregated");
   auto liqwp                 = dm_device.get<real,2>("liqwp_aggregated");
@@ -509,237 +514,111 @@ inline void pam_statistics_copy_to_host( pam::PamCoupler &coupler ) {
   auto rho_i_forcing         = dm_device.get<real,2>("rho_i_forcing_aggregated");
   auto cldfrac               = dm_device.get<real,2>("cldfrac_aggregated");
   auto clear_rh              = dm_device.get<real,2>("clear_rh");
-
-  auto phys_tend_sgs_cnt     = dm_device.get<real,1>("phys_tend_sgs_cnt");
   auto phys_tend_sgs_temp    = dm_device.get<real,2>("phys_tend_sgs_temp");
   auto phys_tend_sgs_qv      = dm_device.get<real,2>("phys_tend_sgs_qv");
   auto phys_tend_sgs_qc      = dm_device.get<real,2>("phys_tend_sgs_qc");
   auto phys_tend_sgs_qi      = dm_device.get<real,2>("phys_tend_sgs_qi");
   auto phys_tend_sgs_qr      = dm_device.get<real,2>("phys_tend_sgs_qr");
-
-  auto phys_tend_micro_cnt   = dm_device.get<real,1>("phys_tend_micro_cnt");
   auto phys_tend_micro_temp  = dm_device.get<real,2>("phys_tend_micro_temp");
   auto phys_tend_micro_qv    = dm_device.get<real,2>("phys_tend_micro_qv");
   auto phys_tend_micro_qc    = dm_device.get<real,2>("phys_tend_micro_qc");
   auto phys_tend_micro_qi    = dm_device.get<real,2>("phys_tend_micro_qi");
   auto phys_tend_micro_qr    = dm_device.get<real,2>("phys_tend_micro_qr");
-
-  auto phys_tend_dycor_cnt   = dm_device.get<real,1>("phys_tend_dycor_cnt");
   auto phys_tend_dycor_temp  = dm_device.get<real,2>("phys_tend_dycor_temp");
   auto phys_tend_dycor_qv    = dm_device.get<real,2>("phys_tend_dycor_qv");
   auto phys_tend_dycor_qc    = dm_device.get<real,2>("phys_tend_dycor_qc");
   auto phys_tend_dycor_qi    = dm_device.get<real,2>("phys_tend_dycor_qi");
   auto phys_tend_dycor_qr    = dm_device.get<real,2>("phys_tend_dycor_qr");
-
-  auto phys_tend_sponge_cnt  = dm_device.get<real,1>("phys_tend_sponge_cnt");
   auto phys_tend_sponge_temp = dm_device.get<real,2>("phys_tend_sponge_temp");
   auto phys_tend_sponge_qv   = dm_device.get<real,2>("phys_tend_sponge_qv");
   auto phys_tend_sponge_qc   = dm_device.get<real,2>("phys_tend_sponge_qc");
   auto phys_tend_sponge_qi   = dm_device.get<real,2>("phys_tend_sponge_qi");
   auto phys_tend_sponge_qr   = dm_device.get<real,2>("phys_tend_sponge_qr");
   //------------------------------------------------------------------------------------------------
-  // calculate output precip variables
-  // NOTE: the MMF doesn't need to distinguish between "convective" and "large-scale"
-  // so just put all precip into the convective category for now
-  real1d precip_tot_c("precip_liq_c",nens); // "convective" surface precipitation
-  real1d precip_ice_c("precip_ice_c",nens); // "convective" surface precipitation of ice (snow)
-  real1d precip_tot_l("precip_liq_l",nens); // "large-scale" surface precipitation
-  real1d precip_ice_l("precip_ice_l",nens); // "large-scale" surface precipitation of ice (snow)
-  parallel_for("finalize aggregated variables", SimpleBounds<1>(nens), YAKL_LAMBDA (int iens) {
-    precip_tot_c(iens) = precip_liq(iens) + precip_ice(iens);
-    precip_ice_c(iens) = precip_ice(iens);
-    precip_tot_l(iens) = 0;
-    precip_ice_l(iens) = 0;
-  });
-  //------------------------------------------------------------------------------------------------
-  // convert variables to GCM vertical grid
-  real2d liqwp_gcm           ("liqwp_gcm",            gcm_nlev,nens);
-  real2d icewp_gcm           ("icewp_gcm",            gcm_nlev,nens);
-  real2d liq_ice_exchange_gcm("liq_ice_exchange_gcm", gcm_nlev,nens);
-  real2d vap_liq_exchange_gcm("vap_liq_exchange_gcm", gcm_nlev,nens);
-  real2d vap_ice_exchange_gcm("vap_ice_exchange_gcm", gcm_nlev,nens);
-  real2d rho_v_forcing_gcm   ("rho_v_forcing_gcm",    gcm_nlev,nens);
-  real2d rho_l_forcing_gcm   ("rho_l_forcing_gcm",    gcm_nlev,nens);
-  real2d rho_i_forcing_gcm   ("rho_i_forcing_gcm",    gcm_nlev,nens);
-  real2d cldfrac_gcm         ("cldfrac_gcm",          gcm_nlev,nens);
-
-  real2d phys_tend_sgs_temp_gcm  ("phys_tend_sgs_temp_gcm",  gcm_nlev,nens);
-  real2d phys_tend_sgs_qv_gcm    ("phys_tend_sgs_qv_gcm",    gcm_nlev,nens);
-  real2d phys_tend_sgs_qc_gcm    ("phys_tend_sgs_qc_gcm",    gcm_nlev,nens);
-  real2d phys_tend_sgs_qi_gcm    ("phys_tend_sgs_qi_gcm",    gcm_nlev,nens);
-  real2d phys_tend_sgs_qr_gcm    ("phys_tend_sgs_qr_gcm",    gcm_nlev,nens);
-
-  real2d phys_tend_micro_temp_gcm("phys_tend_micro_temp_gcm",gcm_nlev,nens);
-  real2d phys_tend_micro_qv_gcm  ("phys_tend_micro_qv_gcm",  gcm_nlev,nens);
-  real2d phys_tend_micro_qc_gcm  ("phys_tend_micro_qc_gcm",  gcm_nlev,nens);
-  real2d phys_tend_micro_qi_gcm  ("phys_tend_micro_qi_gcm",  gcm_nlev,nens);
-  real2d phys_tend_micro_qr_gcm  ("phys_tend_micro_qr_gcm",  gcm_nlev,nens);
-
-  real2d phys_tend_dycor_temp_gcm ("phys_tend_dycor_temp_gcm", gcm_nlev,nens);
-  real2d phys_tend_dycor_qv_gcm   ("phys_tend_dycor_qv_gcm",   gcm_nlev,nens);
-  real2d phys_tend_dycor_qc_gcm   ("phys_tend_dycor_qc_gcm",   gcm_nlev,nens);
-  real2d phys_tend_dycor_qi_gcm   ("phys_tend_dycor_qi_gcm",   gcm_nlev,nens);
-  real2d phys_tend_dycor_qr_gcm   ("phys_tend_dycor_qr_gcm",   gcm_nlev,nens);
-
-  real2d phys_tend_sponge_temp_gcm("phys_tend_sponge_temp_gcm",gcm_nlev,nens);
-  real2d phys_tend_sponge_qv_gcm  ("phys_tend_sponge_qv_gcm",  gcm_nlev,nens);
-  real2d phys_tend_sponge_qc_gcm  ("phys_tend_sponge_qc_gcm",  gcm_nlev,nens);
-  real2d phys_tend_sponge_qi_gcm  ("phys_tend_sponge_qi_gcm",  gcm_nlev,nens);
-  real2d phys_tend_sponge_qr_gcm  ("phys_tend_sponge_qr_gcm",  gcm_nlev,nens);
-  // copy variables to equivalent variables on GCM grid
-  parallel_for(SimpleBounds<2>(gcm_nlev,nens), YAKL_LAMBDA (int k_gcm, int iens) {
+  // Gather all outputs into one array on the GCM vertical grid, so that they
+  // are moved to the host in a single transfer. Surface quantities use level 0,
+  // and clear_rh stays on the CRM grid as expected by the GCM.
+  // The physics tendencies are only gathered when they were aggregated; the
+  // host copies keep the zeros they are initialized with otherwise.
+  int constexpr nout_base = 14;
+  int constexpr nout_tend = 20;
+  int nout = enable_physics_tend_stats ? nout_base + nout_tend : nout_base;
+  real3d output_gcm("output_gcm",nout,gcm_nlev,nens);
+  parallel_for("gather aggregated variables", SimpleBounds<2>(gcm_nlev,nens), YAKL_LAMBDA (int k_gcm, int iens) {
     int k_crm = gcm_nlev-1-k_gcm;
+    // NOTE: the MMF doesn't need to distinguish between "convective" and "large-scale"
+    // so just put all precip into the convective category for now
+    if (k_gcm == 0) {
+      output_gcm(0,k_gcm,iens) = precip_liq(iens) + precip_ice(iens); // "convective" surface precipitation
+      output_gcm(1,k_gcm,iens) = precip_ice(iens);                    // "convective" surface precipitation of ice (snow)
+      output_gcm(2,k_gcm,iens) = 0;                                   // "large-scale" surface precipitation
+      output_gcm(3,k_gcm,iens) = 0;                                   // "large-scale" surface precipitation of ice (snow)
+    }
+    if (k_gcm < crm_nz) {
+      output_gcm(4,k_gcm,iens) = clear_rh(k_gcm,iens);
+    }
+    for (int l=5; l<nout; l++) { output_gcm(l,k_gcm,iens) = 0.; }
     if (k_crm<crm_nz) {
-      liqwp_gcm           (k_gcm,iens) = liqwp           (k_crm,iens);
-      icewp_gcm           (k_gcm,iens) = icewp           (k_crm,iens);
-      liq_ice_exchange_gcm(k_gcm,iens) = liq_ice_exchange(k_crm,iens);
-      vap_liq_exchange_gcm(k_gcm,iens) = vap_liq_exchange(k_crm,iens);
-      vap_ice_exchange_gcm(k_gcm,iens) = vap_ice_exchange(k_crm,iens);
-      rho_v_forcing_gcm   (k_gcm,iens) = rho_v_forcing   (k_crm,iens);
-      rho_l_forcing_gcm   (k_gcm,iens) = rho_l_forcing   (k_crm,iens);
-      rho_i_forcing_gcm   (k_gcm,iens) = rho_i_forcing   (k_crm,iens);
-      cldfrac_gcm         (k_gcm,iens) = cldfrac         (k_crm,iens);
-
-      phys_tend_sgs_temp_gcm  (k_gcm,iens) = phys_tend_sgs_temp  (k_crm,iens);
-      phys_tend_sgs_qv_gcm    (k_gcm,iens) = phys_tend_sgs_qv    (k_crm,iens);
-      phys_tend_sgs_qc_gcm    (k_gcm,iens) = phys_tend_sgs_qc    (k_crm,iens);
-      phys_tend_sgs_qi_gcm    (k_gcm,iens) = phys_tend_sgs_qi    (k_crm,iens);
-      phys_tend_sgs_qr_gcm    (k_gcm,iens) = phys_tend_sgs_qr    (k_crm,iens);
-
-      phys_tend_micro_temp_gcm(k_gcm,iens) = phys_tend_micro_temp(k_crm,iens);
-      phys_tend_micro_qv_gcm  (k_gcm,iens) = phys_tend_micro_qv  (k_crm,iens);
-      phys_tend_micro_qc_gcm  (k_gcm,iens) = phys_tend_micro_qc  (k_crm,iens);
-      phys_tend_micro_qi_gcm  (k_gcm,iens) = phys_tend_micro_qi  (k_crm,iens);
-      phys_tend_micro_qr_gcm  (k_gcm,iens) = phys_tend_micro_qr  (k_crm,iens);
-
-      phys_tend_dycor_temp_gcm (k_gcm,iens) = phys_tend_dycor_temp (k_crm,iens);
-      phys_tend_dycor_qv_gcm   (k_gcm,iens) = phys_tend_dycor_qv   (k_crm,iens);
-      phys_tend_dycor_qc_gcm   (k_gcm,iens) = phys_tend_dycor_qc   (k_crm,iens);
-      phys_tend_dycor_qi_gcm   (k_gcm,iens) = phys_tend_dycor_qi   (k_crm,iens);
-      phys_tend_dycor_qr_gcm   (k_gcm,iens) = phys_tend_dycor_qr   (k_crm,iens);
-
-      phys_tend_sponge_temp_gcm(k_gcm,iens) = phys_tend_sponge_temp(k_crm,iens);
-      phys_tend_sponge_qv_gcm  (k_gcm,iens) = phys_tend_sponge_qv  (k_crm,iens);
-      phys_tend_sponge_qc_gcm  (k_gcm,iens) = phys_tend_sponge_qc  (k_crm,iens);
-      phys_tend_sponge_qi_gcm  (k_gcm,iens) = phys_tend_sponge_qi  (k_crm,iens);
-      phys_tend_sponge_qr_gcm  (k_gcm,iens) = phys_tend_sponge_qr  (k_crm,iens);
-
-    } else {
-      liqwp_gcm           (k_gcm,iens) = 0.;
-      icewp_gcm           (k_gcm,iens) = 0.;
-      liq_ice_exchange_gcm(k_gcm,iens) = 0.;
-      vap_liq_exchange_gcm(k_gcm,iens) = 0.;
-      vap_ice_exchange_gcm(k_gcm,iens) = 0.;
-      rho_v_forcing_gcm   (k_gcm,iens) = 0.;
-      rho_l_forcing_gcm   (k_gcm,iens) = 0.;
-      rho_i_forcing_gcm   (k_gcm,iens) = 0.;
-      cldfrac_gcm         (k_gcm,iens) = 0.;
-
-      phys_tend_sgs_temp_gcm  (k_gcm,iens) = 0.;
-      phys_tend_sgs_qv_gcm    (k_gcm,iens) = 0.;
-      phys_tend_sgs_qc_gcm    (k_gcm,iens) = 0.;
-      phys_tend_sgs_qi_gcm    (k_gcm,iens) = 0.;
-      phys_tend_sgs_qr_gcm    (k_gcm,iens) = 0.;
-
-      phys_tend_micro_temp_gcm(k_gcm,iens) = 0.;
-      phys_tend_micro_qv_gcm  (k_gcm,iens) = 0.;
-      phys_tend_micro_qc_gcm  (k_gcm,iens) = 0.;
-      phys_tend_micro_qi_gcm  (k_gcm,iens) = 0.;
-      phys_tend_micro_qr_gcm  (k_gcm,iens) = 0.;
-
-      phys_tend_dycor_temp_gcm (k_gcm,iens) = 0.;
-      phys_tend_dycor_qv_gcm   (k_gcm,iens) = 0.;
-      phys_tend_dycor_qc_gcm   (k_gcm,iens) = 0.;
-      phys_tend_dycor_qi_gcm   (k_gcm,iens) = 0.;
-      phys_tend_dycor_qr_gcm   (k_gcm,iens) = 0.;
-
-      phys_tend_sponge_temp_gcm(k_gcm,iens) = 0.;
-      phys_tend_sponge_qv_gcm  (k_gcm,iens) = 0.;
-      phys_tend_sponge_qc_gcm  (k_gcm,iens) = 0.;
-      phys_tend_sponge_qi_gcm  (k_gcm,iens) = 0.;
-      phys_tend_sponge_qr_gcm  (k_gcm,iens) = 0.;
+      output_gcm( 5,k_gcm,iens) = liqwp           (k_crm,iens);
+      output_gcm( 6,k_gcm,iens) = icewp           (k_crm,iens);
+      output_gcm( 7,k_gcm,iens) = liq_ice_exchange(k_crm,iens);
+      output_gcm( 8,k_gcm,iens) = vap_liq_exchange(k_crm,iens);
+      output_gcm( 9,k_gcm,iens) = vap_ice_exchange(k_crm,iens);
+      output_gcm(10,k_gcm,iens) = rho_v_forcing   (k_crm,iens);
+      output_gcm(11,k_gcm,iens) = rho_l_forcing   (k_crm,iens);
+      output_gcm(12,k_gcm,iens) = rho_i_forcing   (k_crm,iens);
+      output_gcm(13,k_gcm,iens) = cldfrac         (k_crm,iens);
+      if (nout > nout_base) {
+        output_gcm(14,k_gcm,iens) = phys_tend_sgs_temp   (k_crm,iens);
+        output_gcm(15,k_gcm,iens) = phys_tend_sgs_qv     (k_crm,iens);
+        output_gcm(16,k_gcm,iens) = phys_tend_sgs_qc     (k_crm,iens);
+        output_gcm(17,k_gcm,iens) = phys_tend_sgs_qi     (k_crm,iens);
+        output_gcm(18,k_gcm,iens) = phys_tend_sgs_qr     (k_crm,iens);
+        output_gcm(19,k_gcm,iens) = phys_tend_micro_temp (k_crm,iens);
+        output_gcm(20,k_gcm,iens) = phys_tend_micro_qv   (k_crm,iens);
+        output_gcm(21,k_gcm,iens) = phys_tend_micro_qc   (k_crm,iens);
+        output_gcm(22,k_gcm,iens) = phys_tend_micro_qi   (k_crm,iens);
+        output_gcm(23,k_gcm,iens) = phys_tend_micro_qr   (k_crm,iens);
+        output_gcm(24,k_gcm,iens) = phys_tend_dycor_temp (k_crm,iens);
+        output_gcm(25,k_gcm,iens) = phys_tend_dycor_qv   (k_crm,iens);
+        output_gcm(26,k_gcm,iens) = phys_tend_dycor_qc   (k_crm,iens);
+        output_gcm(27,k_gcm,iens) = phys_tend_dycor_qi   (k_crm,iens);
+        output_gcm(28,k_gcm,iens) = phys_tend_dycor_qr   (k_crm,iens);
+        output_gcm(29,k_gcm,iens) = phys_tend_sponge_temp(k_crm,iens);
+        output_gcm(30,k_gcm,iens) = phys_tend_sponge_qv  (k_crm,iens);
+        output_gcm(31,k_gcm,iens) = phys_tend_sponge_qc  (k_crm,iens);
+        output_gcm(32,k_gcm,iens) = phys_tend_sponge_qi  (k_crm,iens);
+        output_gcm(33,k_gcm,iens) = phys_tend_sponge_qr  (k_crm,iens);
+      }
     }
   });
   //------------------------------------------------------------------------------------------------
   // copy data to host
-  auto precip_tot_c_host          = dm_host.get<real,1>("output_precc");
-  auto precip_ice_c_host          = dm_host.get<real,1>("output_precsc");
-  auto precip_tot_l_host          = dm_host.get<real,1>("output_precl");
-  auto precip_ice_l_host          = dm_host.get<real,1>("output_precsl");
-  auto liqwp_host                 = dm_host.get<real,2>("output_gliqwp");
-  auto icewp_host                 = dm_host.get<real,2>("output_gicewp");
-  auto liq_ice_exchange_host      = dm_host.get<real,2>("output_liq_ice_exchange");
-  auto vap_liq_exchange_host      = dm_host.get<real,2>("output_vap_liq_exchange");
-  auto vap_ice_exchange_host      = dm_host.get<real,2>("output_vap_ice_exchange");
-  auto output_rho_v_ls            = dm_host.get<real,2>("output_rho_v_ls");
-  auto output_rho_l_ls            = dm_host.get<real,2>("output_rho_l_ls");
-  auto output_rho_i_ls            = dm_host.get<real,2>("output_rho_i_ls");
-  auto cldfrac_host               = dm_host.get<real,2>("output_cld");
-  auto clear_rh_host              = dm_host.get<real,2>("output_clear_rh");
-
-  auto phys_tend_sgs_temp_host    = dm_host.get<real,2>("output_dt_sgs");
-  auto phys_tend_sgs_qv_host      = dm_host.get<real,2>("output_dqv_sgs");
-  auto phys_tend_sgs_qc_host      = dm_host.get<real,2>("output_dqc_sgs");
-  auto phys_tend_sgs_qi_host      = dm_host.get<real,2>("output_dqi_sgs");
-  auto phys_tend_sgs_qr_host      = dm_host.get<real,2>("output_dqr_sgs");
+  auto output_gcm_host = output_gcm.createHostCopy();
 
-  auto phys_tend_micro_temp_host  = dm_host.get<real,2>("output_dt_micro");
-  auto phys_tend_micro_qv_host    = dm_host.get<real,2>("output_dqv_micro");
-  auto phys_tend_micro_qc_host    = dm_host.get<real,2>("output_dqc_micro");
-  auto phys_tend_micro_qi_host    = dm_host.get<real,2>("output_dqi_micro");
-  auto phys_tend_micro_qr_host    = dm_host.get<real,2>("output_dqr_micro");
-
-  auto phys_tend_dycor_temp_host  = dm_host.get<real,2>("output_dt_dycor");
-  auto phys_tend_dycor_qv_host    = dm_host.get<real,2>("output_dqv_dycor");
-  auto phys_tend_dycor_qc_host    = dm_host.get<real,2>("output_dqc_dycor");
-  auto phys_tend_dycor_qi_host    = dm_host.get<real,2>("output_dqi_dycor");
-  auto phys_tend_dycor_qr_host    = dm_host.get<real,2>("output_dqr_dycor");
-
-  auto phys_tend_sponge_temp_host = dm_host.get<real,2>("output_dt_sponge");
-  auto phys_tend_sponge_qv_host   = dm_host.get<real,2>("output_dqv_sponge");
-  auto phys_tend_sponge_qc_host   = dm_host.get<real,2>("output_dqc_sponge");
-  auto phys_tend_sponge_qi_host   = dm_host.get<real,2>("output_dqi_sponge");
-  auto phys_tend_sponge_qr_host   = dm_host.get<real,2>("output_dqr_sponge");
-
-  precip_tot_c            .deep_copy_to(precip_tot_c_host);
-  precip_ice_c            .deep_copy_to(precip_ice_c_host);
-  precip_tot_l            .deep_copy_to(precip_tot_l_host);
-  precip_ice_l            .deep_copy_to(precip_ice_l_host);
-  liqwp_gcm               .deep_copy_to(liqwp_host);
-  icewp_gcm               .deep_copy_to(icewp_host);
-  liq_ice_exchange_gcm    .deep_copy_to(liq_ice_exchange_host);
-  vap_liq_exchange_gcm    .deep_copy_to(vap_liq_exchange_host);
-  vap_ice_exchange_gcm    .deep_copy_to(vap_ice_exchange_host);
-  rho_v_forcing_gcm       .deep_copy_to(output_rho_v_ls);
-  rho_l_forcing_gcm       .deep_copy_to(output_rho_l_ls);
-  rho_i_forcing_gcm       .deep_copy_to(output_rho_i_ls);
-  cldfrac_gcm             .deep_copy_to(cldfrac_host);
-  clear_rh                .deep_copy_to(clear_rh_host);
-
-  phys_tend_sgs_temp_gcm  .deep_copy_to(phys_tend_sgs_temp_host);
-  phys_tend_sgs_qv_gcm    .deep_copy_to(phys_tend_sgs_qv_host);
-  phys_tend_sgs_qc_gcm    .deep_copy_to(phys_tend_sgs_qc_host);
-  phys_tend_sgs_qi_gcm    .deep_copy_to(phys_tend_sgs_qi_host);
-  phys_tend_sgs_qr_gcm    .deep_copy_to(phys_tend_sgs_qr_host);
+  char const *output_1d_names[] = { "output_precc", "output_precsc", "output_precl", "output_precsl" };
+  for (int l=0; l<4; l++) {
+    auto output_host = dm_host.get<real,1>(output_1d_names[l]);
+    for (int iens=0; iens<nens; iens++) { output_host(iens) = output_gcm_host(l,0,iens); }
+  }
 
-  phys_tend_micro_temp_gcm.deep_copy_to(phys_tend_micro_temp_host);
-  phys_tend_micro_qv_gcm  .deep_copy_to(phys_tend_micro_qv_host);
-  phys_tend_micro_qc_gcm  .deep_copy_to(phys_tend_micro_qc_host);
-  phys_tend_micro_qi_gcm  .deep_copy_to(phys_tend_micro_qi_host);
-  phys_tend_micro_qr_gcm  .deep_copy_to(phys_tend_micro_qr_host);
+  auto clear_rh_host = dm_host.get<real,2>("output_clear_rh");
+  for (int k=0; k<crm_nz; k++) {
+    for (int iens=0; iens<nens; iens++) { clear_rh_host(k,iens) = output_gcm_host(4,k,iens); }
+  }
 
-  phys_tend_dycor_temp_gcm .deep_copy_to(phys_tend_dycor_temp_host);
-  phys_tend_dycor_qv_gcm   .deep_copy_to(phys_tend_dycor_qv_host);
-  phys_tend_dycor_qc_gcm   .deep_copy_to(phys_tend_dycor_qc_host);
-  phys_tend_dycor_qi_gcm   .deep_copy_to(phys_tend_dycor_qi_host);
-  phys_tend_dycor_qr_gcm   .deep_copy_to(phys_tend_dycor_qr_host);
-  
-  phys_tend_sponge_temp_gcm.deep_copy_to(phys_tend_sponge_temp_host);
-  phys_tend_sponge_qv_gcm  .deep_copy_to(phys_tend_sponge_qv_host);
-  phys_tend_sponge_qc_gcm  .deep_copy_to(phys_tend_sponge_qc_host);
-  phys_tend_sponge_qi_gcm  .deep_copy_to(phys_tend_sponge_qi_host);
-  phys_tend_sponge_qr_gcm  .deep_copy_to(phys_tend_sponge_qr_host);
-  yakl::fence();
+  char const *output_2d_names[] = {
+    "output_gliqwp", "output_gicewp", "output_liq_ice_exchange", "output_vap_liq_exchange",
+    "output_vap_ice_exchange", "output_rho_v_ls", "output_rho_l_ls", "output_rho_i_ls", "output_cld",
+    "output_dt_sgs",    "output_dqv_sgs",    "output_dqc_sgs",    "output_dqi_sgs",    "output_dqr_sgs",
+    "output_dt_micro",  "output_dqv_micro",  "output_dqc_micro",  "output_dqi_micro",  "output_dqr_micro",
+    "output_dt_dycor",  "output_dqv_dycor",  "output_dqc_dycor",  "output_dqi_dycor",  "output_dqr_dycor",
+    "output_dt_sponge", "output_dqv_sponge", "output_dqc_sponge", "output_dqi_sponge", "output_dqr_sponge" };
+  for (int l=5; l<nout; l++) {
+    auto output_host = dm_host.get<real,2>(output_2d_names[l-5]);
+    for (int k_gcm=0; k_gcm<gcm_nlev; k_gcm++) {
+      for (int iens=0; iens<nens; iens++) { output_host(k_gcm,iens) = output_gcm_host(l,k_gcm,iens); }
+    }
+  }
   //------------------------------------------------------------------------------------------------
 }
-
@@ -1,7 +1,28 @@
 
 #include "accelerate_crm.h"
 
-void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
+real constexpr ttend_threshold = 5.0;  // 5K, following UP-CAM implementation
+
+// Largest horizontal-mean temperature change over a single CRM step seen
+// during the current (or, before crm_accel_nstop, the previous) CRM call on
+// this task. Negative until it has been measured once. Only used with
+// crm_accel_adaptive.
+static real crm_accel_drift = -1.0;
+
+// Choose the acceleration factor for this CRM call. crm_accel_factor from the
+// namelist is the upper bound; the factor is reduced until the accelerated
+// drift of the previous call stays below half of ttend_threshold and
+// (1 + factor) divides nstop.
+static real crm_accel_adaptive_factor(int nstop, real factor_max, real drift) {
+  int factor = static_cast<int>(factor_max);
+  if (drift > 0.0) {
+    factor = min(factor, static_cast<int>(0.5*ttend_threshold/drift));
+  }
+  while (factor > 0 && nstop%(1+factor) != 0) { factor--; }
+  return factor;
+}
+
+void accelerate_crm(int nstep, int &nstop, bool &ceaseflag) {
   YAKL_SCOPE( t                  , ::t);
   YAKL_SCOPE( qcl                , ::qcl);
   YAKL_SCOPE( qci                , ::qci);
@@ -18,7 +39,6 @@ void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
   YAKL_SCOPE( ncrms              , ::ncrms);
   YAKL_SCOPE( crm_accel_factor   , ::crm_accel_factor);
 
-  real ttend_threshold = 5.0;  // 5K, following UP-CAM implementation
   real tmin = 50.0;  // should never get below 50K in crm, following UP-CAM implementation
   int idx_qt = index_water_vapor;
 
@@ -83,6 +103,17 @@ void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
   });
   ceaseflag = ceaseflag_liveout.hostRead();
 
+  if (crm_accel_adaptive) {
+    real2d ttend_abs("ttend_abs", nzm, ncrms);
+    // for (int k=0; k<nzm; k++) {
+    //  for (int icrm=0; icrm<ncrms; icrm++) {
+    parallel_for( SimpleBounds<2>(nzm,ncrms) , YAKL_LAMBDA (int k, int icrm) {
+      ttend_abs(k,icrm) = abs(ttend_acc(k,icrm));
+    });
+    yakl::ParallelMax<real,yakl::memDevice> pmax( nzm*ncrms );
+    crm_accel_drift = max(crm_accel_drift, pmax(ttend_abs.data()));
+  }
+
 
   //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
   //!! Make sure it isn't insane
@@ -195,6 +226,10 @@ void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
 
 
 void crm_accel_nstop(int &nstop) {
+  if (crm_accel_adaptive) {
+    crm_accel_factor = crm_accel_adaptive_factor(nstop, crm_accel_factor, crm_accel_drift);
+    crm_accel_drift = 0.0;
+  }
   if(nstop%static_cast<int>((1+crm_accel_factor)) != 0) {
     std::cout << "CRM acceleration unexpected exception:\n";
     std::cout << "(1+crm_accel_factor) does not divide equally into nstop\n";
@@ -17,13 +17,13 @@ void advect_scalar2D(real4d &f, real2d &flux) {
   int  constexpr offx_www = 2;
   int  constexpr j        = 0;
 
-  real4d mx   ("mx"   ,nzm,1,nx+2,ncrms);
-  real4d mn   ("mn"   ,nzm,1,nx+2,ncrms);
-  real4d uuu  ("uuu"  ,nzm,1,nx+5,ncrms);
-  real4d www  ("www"  ,nz,1,nx+4,ncrms);
-  real2d iadz ("iadz" ,nzm,ncrms);
-  real2d irho ("irho" ,nzm,ncrms);
-  real2d irhow("irhow",nzm,ncrms);
+  YAKL_SCOPE( mx             , :: adv_mx);
+  YAKL_SCOPE( mn             , :: adv_mn);
+  YAKL_SCOPE( uuu            , :: adv_uuu);
+  YAKL_SCOPE( www            , :: adv_www);
+  YAKL_SCOPE( iadz           , :: adv_iadz);
+  YAKL_SCOPE( irho           , :: adv_irho);
+  YAKL_SCOPE( irhow          , :: adv_irhow);
 
   // for (int i=0; i<nx+4; i++) {
   //  for (int icrm=0; icrm<ncrms; icrm++) {
@@ -212,13 +212,13 @@ void advect_scalar2D(real5d &f, int ind_f, real2d &flux) {
   int  constexpr offx_www = 2;
   int  constexpr j = 0;
 
-  real4d mx   ("mx"   ,nzm,1,nx+2,ncrms);
-  real4d mn   ("mn"   ,nzm,1,nx+2,ncrms);
-  real4d uuu  ("uuu"  ,nzm,1,nx+5,ncrms);
-  real4d www  ("www"  ,nz,1,nx+4,ncrms);
-  real2d iadz ("iadz" ,nzm,ncrms);
-  real2d irho ("irho" ,nzm,ncrms);
-  real2d irhow("irhow",nzm,ncrms);
+  YAKL_SCOPE( mx             , :: adv_mx);
+  YAKL_SCOPE( mn             , :: adv_mn);
+  YAKL_SCOPE( uuu            , :: adv_uuu);
+  YAKL_SCOPE( www            , :: adv_www);
+  YAKL_SCOPE( iadz           , :: adv_iadz);
+  YAKL_SCOPE( irho           , :: adv_irho);
+  YAKL_SCOPE( irhow          , :: adv_irhow);
 
   // for (int i=0; i<nx+4; i++) {
   //  for (int icrm=0; icrm<ncrms; icrm++) {
@@ -408,13 +408,13 @@ void advect_scalar2D(real5d &f, int ind_f, real3d &flux, int ind_flux) {
   int  constexpr offx_www = 2;
   int  constexpr j = 0;
 
-  real4d mx   ("mx"   ,nzm,1,nx+2,ncrms);
-  real4d mn   ("mn"   ,nzm,1,nx+2,ncrms);
-  real4d uuu  ("uuu"  ,nzm,1,nx+5,ncrms);
-  real4d www  ("www"  ,nz,1,nx+4,ncrms);
-  real2d iadz ("iadz" ,nzm,ncrms);
-  real2d irho ("irho" ,nzm,ncrms);
-  real2d irhow("irhow",nzm,ncrms);
+  YAKL_SCOPE( mx             , :: adv_mx);
+  YAKL_SCOPE( mn             , :: adv_mn);
+  YAKL_SCOPE( uuu            , :: adv_uuu);
+  YAKL_SCOPE( www            , :: adv_www);
+  YAKL_SCOPE( iadz           , :: adv_iadz);
+  YAKL_SCOPE( irho           , :: adv_irho);
+  YAKL_SCOPE( irhow          , :: adv_irhow);
 
   // for (int i=0; i<nx+4; i++) {
   //  for (int icrm=0; icrm<ncrms; icrm++) {
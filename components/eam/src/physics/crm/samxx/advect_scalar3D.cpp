@@ -23,14 +23,14 @@ void advect_scalar3D(real4d &f, real2d &flux) {
   int  constexpr offx_www = 2;
   int  constexpr offy_www = 2;
 
-  real4d mx   ("mx"   ,nzm,ny+2,nx+2,ncrms);
-  real4d mn   ("mn"   ,nzm,ny+2,nx+2,ncrms);
-  real4d uuu  ("uuu"  ,nzm,ny+4,nx+5,ncrms);
-  real4d vvv  ("vvv"  ,nzm,ny+5,nx+4,ncrms);
-  real4d www  ("www"  ,nz ,ny+4,nx+4,ncrms);
-  real2d iadz ("iadz" ,nzm,ncrms);
-  real2d irho ("irho" ,nzm,ncrms);
-  real2d irhow("irhow",nzm,ncrms);
+  YAKL_SCOPE( mx       , ::adv_mx);
+  YAKL_SCOPE( mn       , ::adv_mn);
+  YAKL_SCOPE( uuu      , ::adv_uuu);
+  YAKL_SCOPE( vvv      , ::adv_vvv);
+  YAKL_SCOPE( www      , ::adv_www);
+  YAKL_SCOPE( iadz     , ::adv_iadz);
+  YAKL_SCOPE( irho     , ::adv_irho);
+  YAKL_SCOPE( irhow    , ::adv_irhow);
 
   // for (int k=0; k<nzm; k++) {
   //   for (int j=0; j<ny+4; j++) {
@@ -320,14 +320,14 @@ void advect_scalar3D(real5d &f, int ind_f, real2d &flux) {
   int  constexpr offx_www = 2;
   int  constexpr offy_www = 2;
 
-  real4d mx   ("mx"   ,nzm,ny+2,nx+2,ncrms);
-  real4d mn   ("mn"   ,nzm,ny+2,nx+2,ncrms);
-  real4d uuu  ("uuu"  ,nzm,ny+4,nx+5,ncrms);
-  real4d vvv  ("vvv"  ,nzm,ny+5,nx+4,ncrms);
-  real4d www  ("www"  ,nz ,ny+4,nx+4,ncrms);
-  real2d iadz ("iadz" ,nzm,ncrms);
-  real2d irho ("irho" ,nzm,ncrms);
-  real2d irhow("irhow",nzm,ncrms);
+  YAKL_SCOPE( mx       , ::adv_mx);
+  YAKL_SCOPE( mn       , ::adv_mn);
+  YAKL_SCOPE( uuu      , ::adv_uuu);
+  YAKL_SCOPE( vvv      , ::adv_vvv);
+  YAKL_SCOPE( www      , ::adv_www);
+  YAKL_SCOPE( iadz     , ::adv_iadz);
+  YAKL_SCOPE( irho     , ::adv_irho);
+  YAKL_SCOPE( irhow    , ::adv_irhow);
 
   // for (int k=0; k<nzm; k++) {
   //   for (int j=0; j<ny+4; j++) {
@@ -617,14 +617,14 @@ void advect_scalar3D(real5d &f, int ind_f, real3d &flux, int ind_flux) {
   int  constexpr offx_www = 2;
   int  constexpr offy_www = 2;
 
-  real4d mx   ("mx"   ,nzm,ny+2,nx+2,ncrms);
-  real4d mn   ("mn"   ,nzm,ny+2,nx+2,ncrms);
-  real4d uuu  ("uuu"  ,nzm,ny+4,nx+5,ncrms);
-  real4d vvv  ("vvv"  ,nzm,ny+5,nx+4,ncrms);
-  real4d www  ("www"  ,nz ,ny+4,nx+4,ncrms);
-  real2d iadz ("iadz" ,nzm,ncrms);
-  real2d irho ("irho" ,nzm,ncrms);
-  real2d irhow("irhow",nzm,ncrms);
+  YAKL_SCOPE( mx       , ::adv_mx);
+  YAKL_SCOPE( mn       , ::adv_mn);
+  YAKL_SCOPE( uuu      , ::adv_uuu);
+  YAKL_SCOPE( vvv      , ::adv_vvv);
+  YAKL_SCOPE( www      , ::adv_www);
+  YAKL_SCOPE( iadz     , ::adv_iadz);
+  YAKL_SCOPE( irho     , ::adv_irho);
+  YAKL_SCOPE( irhow    , ::adv_irhow);
 
   // for (int k=0; k<nzm; k++) {
   //   for (int j=0; j<ny+4; j++) {
@@ -3,60 +3,50 @@
 //==============================================================================
 //==============================================================================
 
-void VT_filter(int filter_wn_max, real4d &f_in, real4d &f_out) {
-  // local variables
+void VT_filter(int filter_wn_max, int nlev, real4d &fft_buf) {
+  // Low-pass filter of fft_buf(0:nlev-1,0:ny-1,0:nx-1,:) in place. The levels
+  // of several fields can be stacked along the first dimension, so that they are
+  // all transformed in one batch.
   int nx2 = nx+2;
   int ny2 = ny+2*YES3D;
-  real4d fft_out ("fft_out" , nzm, ny2, nx2, ncrms);
 
-  int constexpr fftySize = ny > 4 ? ny : 4;
-  
   int nwx = nx2-(filter_wn_max+1)*2;
   int nwy = ny2-(filter_wn_max+1)*2;
 
   //----------------------------------------------------------------------------
   // Forward Fourier transform
 
-  parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    fft_out(k,j,i,icrm) = f_in(k,j,i,icrm);
-  });
-
-  vt_fftx.forward_real(fft_out, 2, nx);
-  if (RUN3D) { vt_ffty.forward_real(fft_out, 1, ny); }
+  vt_fftx.forward_real(fft_buf, 2, nx);
+  if (RUN3D) { vt_ffty.forward_real(fft_buf, 1, ny); }
 
   //----------------------------------------------------------------------------
   // Zero out the higher modes
 
   if (RUN3D) {
-    // for (int k=0; k<nzm; k++) {
+    // for (int k=0; k<nlev; k++) {
     //   for (int j=0; j<nwy; j++) {
     //     for (int i=0; i<nwx+1; i++) {
     //       for (int icrm=0; icrm<ncrms; icrm++) {
-    parallel_for( SimpleBounds<4>(nzm,nwy,nwx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
+    parallel_for( SimpleBounds<4>(nlev,nwy,nwx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
       int ii = i + 2*(filter_wn_max+1) ;
       int jj = j + 2*(filter_wn_max+1) ;
-      fft_out(k,jj,ii,icrm) = 0.0;
+      fft_buf(k,jj,ii,icrm) = 0.0;
     });
   } else {
-    // for (int k=0; k<nzm; k++) {
+    // for (int k=0; k<nlev; k++) {
     //   for (int i=0; i<nwx+1; i++) {
     //     for (int icrm=0; icrm<ncrms; icrm++) {
-    parallel_for( SimpleBounds<3>(nzm,nwx,ncrms) , YAKL_LAMBDA (int k, int i, int icrm) {
+    parallel_for( SimpleBounds<3>(nlev,nwx,ncrms) , YAKL_LAMBDA (int k, int i, int icrm) {
       int ii = i + 2*(filter_wn_max+1) ;
-      fft_out(k,0,ii,icrm) = 0.0;
+      fft_buf(k,0,ii,icrm) = 0.0;
     });
   }
 
   //----------------------------------------------------------------------------
   // Backward Fourier transform
 
-  if (RUN3D) { vt_ffty.inverse_real(fft_out); }
-  vt_fftx.inverse_real(fft_out);
-
-  parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    f_out(k,j,i,icrm) = fft_out(k,j,i,icrm);
-  });
-
+  if (RUN3D) { vt_ffty.inverse_real(fft_buf); }
+  vt_fftx.inverse_real(fft_buf);
 }
 
 //==============================================================================
@@ -115,60 +105,65 @@ void VT_diagnose() {
   });
 
   //----------------------------------------------------------------------------
-  // calculate fluctuations - either from horz mean or with a low-pass filter
+  // calculate fluctuations - either from horz mean or with a low-pass filter -
+  // and accumulate their variance
   //----------------------------------------------------------------------------
   if (VT_wn_max>0) { // use filtered state for fluctuations
-  
 
-    real4d tmp_t("tmp_t", nzm, ny, nx, ncrms);
-    real4d tmp_q("tmp_q", nzm, ny, nx, ncrms);
-    real4d tmp_u("tmp_u", nzm, ny, nx, ncrms);
+    // The three fields are stacked along the vertical dimension of a single
+    // buffer, so that they are filtered with one batched FFT per direction.
+    int constexpr nfld = 3;
+    int nx2 = nx+2;
+    int ny2 = ny+2*YES3D;
+    real4d fft_buf("fft_buf", nfld*nzm, ny2, nx2, ncrms);
 
     // do k = 1,nzm
     //   do j = 1,ny
     //     do i = 1,nx
     //       do icrm = 1,ncrms
     parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-      tmp_t(k,j,i,icrm) = t(k,j+offy_s,i+offx_s,icrm);
-      tmp_q(k,j,i,icrm) = micro_field(idx_qt,k,j+offy_s,i+offx_s,icrm);
-      tmp_t(k,j,i,icrm) = tmp_t(k,j,i,icrm) - t_mean(k,icrm);
-      tmp_q(k,j,i,icrm) = tmp_q(k,j,i,icrm) - q_mean(k,icrm);
-      tmp_u(k,j,i,icrm) = u(k,j+offy_u,i+offx_u,icrm);
-      tmp_u(k,j,i,icrm) = tmp_u(k,j,i,icrm) - u_mean(k,icrm);
+      fft_buf(      k,j,i,icrm) = t(k,j+offy_s,i+offx_s,icrm) - t_mean(k,icrm);
+      fft_buf(  nzm+k,j,i,icrm) = micro_field(idx_qt,k,j+offy_s,i+offx_s,icrm) - q_mean(k,icrm);
+      fft_buf(2*nzm+k,j,i,icrm) = u(k,j+offy_u,i+offx_u,icrm) - u_mean(k,icrm);
     });
 
-    VT_filter( VT_wn_max, tmp_t, t_vt_pert );
-    VT_filter( VT_wn_max, tmp_q, q_vt_pert );
-    VT_filter( VT_wn_max, tmp_u, u_vt_pert );
-
-  } else { // use total variance
+    VT_filter( VT_wn_max, nfld*nzm, fft_buf );
 
     // do k = 1,nzm
     //   do j = 1,ny
     //     do i = 1,nx
     //       do icrm = 1,ncrms
     parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-      t_vt_pert(k,j,i,icrm) = t(k,j+offy_s,i+offx_s,icrm) - t_mean(k,icrm);
-      q_vt_pert(k,j,i,icrm) = micro_field(idx_qt,k,j+offy_s,i+offx_s,icrm) - q_mean(k,icrm);
-      u_vt_pert(k,j,i,icrm) = u(k,j+offy_u,i+offx_u,icrm) - u_mean(k,icrm);
+      real t_pert = fft_buf(      k,j,i,icrm);
+      real q_pert = fft_buf(  nzm+k,j,i,icrm);
+      real u_pert = fft_buf(2*nzm+k,j,i,icrm);
+      t_vt_pert(k,j,i,icrm) = t_pert;
+      q_vt_pert(k,j,i,icrm) = q_pert;
+      u_vt_pert(k,j,i,icrm) = u_pert;
+      yakl::atomicAdd( t_vt(k,icrm) , t_pert * t_pert );
+      yakl::atomicAdd( q_vt(k,icrm) , q_pert * q_pert );
+      yakl::atomicAdd( u_vt(k,icrm) , u_pert * u_pert );
     });
-    
-  }
 
-  //----------------------------------------------------------------------------
-  // calculate variance
-  //----------------------------------------------------------------------------
+  } else { // use total variance
 
-  // do k = 1,nzm
-  //   do j = 1,ny
-  //     do i = 1,nx
-  //       do icrm = 1,ncrms
-  parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    yakl::atomicAdd( t_vt(k,icrm) , t_vt_pert(k,j,i,icrm) * t_vt_pert(k,j,i,icrm) );
-    yakl::atomicAdd( q_vt(k,icrm) , q_vt_pert(k,j,i,icrm) * q_vt_pert(k,j,i,icrm) );
-    yakl::atomicAdd( u_vt(k,icrm) , u_vt_pert(k,j,i,icrm) * u_vt_pert(k,j,i,icrm) );
-  });
+    // do k = 1,nzm
+    //   do j = 1,ny
+    //     do i = 1,nx
+    //       do icrm = 1,ncrms
+    parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
+      real t_pert = t(k,j+offy_s,i+offx_s,icrm) - t_mean(k,icrm);
+      real q_pert = micro_field(idx_qt,k,j+offy_s,i+offx_s,icrm) - q_mean(k,icrm);
+      real u_pert = u(k,j+offy_u,i+offx_u,icrm) - u_mean(k,icrm);
+      t_vt_pert(k,j,i,icrm) = t_pert;
+      q_vt_pert(k,j,i,icrm) = q_pert;
+      u_vt_pert(k,j,i,icrm) = u_pert;
+      yakl::atomicAdd( t_vt(k,icrm) , t_pert * t_pert );
+      yakl::atomicAdd( q_vt(k,icrm) , q_pert * q_pert );
+      yakl::atomicAdd( u_vt(k,icrm) , u_pert * u_pert );
+    });
 
+  }
 
   // do k = 1,nzm
   //   do icrm = 1,ncrms
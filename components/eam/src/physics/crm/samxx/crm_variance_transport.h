@@ -4,6 +4,6 @@
 #include "vars.h"
 #include "YAKL_fft.h"
 
-void VT_filter(int filter_wn_max, real4d &f_in, real4d &f_out);
+void VT_filter(int filter_wn_max, int nlev, real4d &fft_buf);
 void VT_diagnose();
 void VT_forcing();
@@ -85,9 +85,9 @@ void post_icycle() {
         cmtemp(j,i,icrm) = max(CF3D(nz-(k+1)-1,j,i,icrm), cmtemp(j,i,icrm));
       }
       tmp1 = rho(k,icrm)*adz(k,icrm)*dz(icrm);
-      real tmp;
+      real_dp tmp;
       if(tmp1*(qcl(k,j,i,icrm)+qci(k,j,i,icrm)) > cwp_threshold) {
-         yakl::atomicAdd(crm_output_cld(l,icrm), CF3D(k,j,i,icrm));
+         yakl::atomicAdd(crm_output_cld(l,icrm), (real_dp) CF3D(k,j,i,icrm));
          if(w(k+1,j+offy_w,i+offx_w,icrm)+w(k,j+offy_w,i+offx_w,icrm) > 2*wmin) {
            tmp = rho(k,icrm)*0.5*(w(k+1,j+offy_w,i+offx_w,icrm)+w(k,j+offy_w,i+offx_w,icrm)) * CF3D(k,j,i,icrm);
            yakl::atomicAdd(crm_output_mcup(l,icrm), tmp);
@@ -110,8 +110,8 @@ void post_icycle() {
            yakl::atomicAdd(crm_output_mcudn(l,icrm) , tmp);
          }
       }
-      yakl::atomicAdd(crm_output_gliqwp(l,icrm) , qcl(k,j,i,icrm));
-      yakl::atomicAdd(crm_output_gicewp(l,icrm) , qci(k,j,i,icrm));
+      yakl::atomicAdd(crm_output_gliqwp(l,icrm) , (real_dp) qcl(k,j,i,icrm));
+      yakl::atomicAdd(crm_output_gicewp(l,icrm) , (real_dp) qci(k,j,i,icrm));
     }
   });
 
@@ -125,15 +125,15 @@ void post_icycle() {
     int i_rad = i / (nx/crm_nx_rad);
     int j_rad = j / (ny/crm_ny_rad);
     real qsat_tmp;
-    real rh_tmp;
+    real_dp rh_tmp;
 
-    yakl::atomicAdd(crm_rad_temperature(k,j_rad,i_rad,icrm) , tabs(k,j,i,icrm));
-    real tmp = max(0.0,qv(k,j,i,icrm));
+    yakl::atomicAdd(crm_rad_temperature(k,j_rad,i_rad,icrm) , (real_dp) tabs(k,j,i,icrm));
+    real_dp tmp = max(0.0,(real_dp) qv(k,j,i,icrm));
     yakl::atomicAdd(crm_rad_qv(k,j_rad,i_rad,icrm) , tmp);
-    yakl::atomicAdd(crm_rad_qc(k,j_rad,i_rad,icrm) , qcl(k,j,i,icrm));
-    yakl::atomicAdd(crm_rad_qi(k,j_rad,i_rad,icrm) , qci(k,j,i,icrm));
+    yakl::atomicAdd(crm_rad_qc(k,j_rad,i_rad,icrm) , (real_dp) qcl(k,j,i,icrm));
+    yakl::atomicAdd(crm_rad_qi(k,j_rad,i_rad,icrm) , (real_dp) qci(k,j,i,icrm));
     if (qcl(k,j,i,icrm) + qci(k,j,i,icrm) > 0) {
-      yakl::atomicAdd(crm_rad_cld(k,j_rad,i_rad,icrm) , CF3D(k,j,i,icrm));
+      yakl::atomicAdd(crm_rad_cld(k,j_rad,i_rad,icrm) , (real_dp) CF3D(k,j,i,icrm));
     } else {
       qsatw_crm(tabs(k,j,i,icrm),pres(k,icrm),qsat_tmp);
       rh_tmp = qv(k,j,i,icrm)/qsat_tmp;
@@ -153,7 +153,7 @@ void post_icycle() {
     int l=plev+1-(k+1);
     int kx;
     real qsat;
-    real tmp;
+    real_dp tmp;
     if (w(k,j+offy_w,i+offx_w,icrm) > 0.0) {
       kx=max(0, k-1);
       qsatw_crm(tabs(kx,j,i,icrm),pres(kx,icrm),qsat);
@@ -179,16 +179,16 @@ void post_icycle() {
   //    for (int icrm=0; icrm<ncrms; icrm++) {
   parallel_for( SimpleBounds<3>(ny,nx,ncrms) , YAKL_LAMBDA (int j, int i, int icrm) {
     if(cwp(j,i,icrm) > cwp_threshold) {
-      yakl::atomicAdd(crm_output_cltot(icrm) , cttemp(j,i,icrm));
+      yakl::atomicAdd(crm_output_cltot(icrm) , (real_dp) cttemp(j,i,icrm));
     }
     if(cwph(j,i,icrm) > cwp_threshold) {
-      yakl::atomicAdd(crm_output_clhgh(icrm) , chtemp(j,i,icrm));
+      yakl::atomicAdd(crm_output_clhgh(icrm) , (real_dp) chtemp(j,i,icrm));
     }
     if(cwpm(j,i,icrm) > cwp_threshold) {
-      yakl::atomicAdd(crm_output_clmed(icrm) , cmtemp(j,i,icrm));
+      yakl::atomicAdd(crm_output_clmed(icrm) , (real_dp) cmtemp(j,i,icrm));
     }
     if(cwpl(j,i,icrm) > cwp_threshold) {
-      yakl::atomicAdd(crm_output_cllow(icrm) , cltemp(j,i,icrm));
+      yakl::atomicAdd(crm_output_cllow(icrm) , (real_dp) cltemp(j,i,icrm));
     }
   });
 
@@ -39,11 +39,53 @@ void precip_proc(real5d &q, int ind_q, real5d &qp, int ind_qp) {
     qpevp(k,icrm)=0.0;
   });
 
+  // Only levels with cloud or precipitation somewhere in the CRM need work below:
+  // elsewhere qn and qp are zero and every branch leaves q and qp unchanged.
+  // Compact the indices of these levels for each CRM so that the kernel below is
+  // launched over the deepest active range instead of all of nzm.
+  int2d level_active("level_active",nzm,ncrms);
+  int2d active_k    ("active_k"    ,nzm,ncrms);
+  int1d nactive     ("nactive"     ,ncrms);
+
+  // for (int k=0; k<nzm; k++) {
+  //  for (int icrm=0; icrm<ncrms; icrm++) {
+  parallel_for( SimpleBounds<2>(nzm,ncrms) , YAKL_LAMBDA (int k, int icrm) {
+    level_active(k,icrm) = 0;
+  });
+
   // for (int k=0; k<nzm; k++) {
   //   for (int j=0; j<ny; j++) {
   //     for (int i=0; i<nx; i++) {
   //       for (int icrm=0; icrm<ncrms; icrm++) {
   parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
+    if (qn(k,j,i,icrm) != 0.0 || qp(ind_qp,k,j+offy_s,i+offx_s,icrm) != 0.0) {
+      yakl::atomicMax(level_active(k,icrm),1);
+    }
+  });
+
+  // for (int icrm=0; icrm<ncrms; icrm++) {
+  parallel_for( ncrms , YAKL_LAMBDA (int icrm) {
+    int n = 0;
+    for (int k=0; k<nzm; k++) {
+      if (level_active(k,icrm) > 0) {
+        active_k(n,icrm) = k;
+        n++;
+      }
+    }
+    nactive(icrm) = n;
+  });
+
+  yakl::ParallelMax<int,yakl::memDevice> pmax( ncrms );
+  int nactive_max = pmax( nactive.data() );
+  if (nactive_max == 0) { return; }
+
+  // for (int n=0; n<nactive(icrm); n++) {
+  //   for (int j=0; j<ny; j++) {
+  //     for (int i=0; i<nx; i++) {
+  //       for (int icrm=0; icrm<ncrms; icrm++) {
+  parallel_for( SimpleBounds<4>(nactive_max,ny,nx,ncrms) , YAKL_LAMBDA (int n, int j, int i, int icrm) {
+    if (n >= nactive(icrm)) { return; }
+    int k = active_k(n,icrm);
     //-------     Autoconversion/accretion
     real omn, omp, omg, qcc, qii, autor, autos, accrr, qrr, accrcs, accris,
          qss, accrcg, accrig, tmp, qgg, dq, qsatt, qsat;
@@ -1,6 +1,11 @@
 
 #include "pressure.h"
 
+// The original FFT works in the precision of the CRM, not that of the solve
+#if defined(USE_ORIG_FFT) && defined(CRM_SINGLE_PRECISION)
+#error "USE_ORIG_FFT is not supported with CRM_SINGLE_PRECISION"
+#endif
+
 void pressure() {
   YAKL_SCOPE( p             , :: p );
   YAKL_SCOPE( rhow          , :: rhow );
@@ -20,23 +25,21 @@ void pressure() {
   int constexpr n3j=3*ny_gl/2+1;
   int constexpr fftySize = ny > 4 ? ny : 4;
 
-  real4d f ("f" , nzslab, ny2, nx2, ncrms);
-  real4d ff("ff", nzm,ny2,nx+1,ncrms);
-  real2d a ("a" , nzm, ncrms);
-  real2d c ("c" , nzm, ncrms);
+  // The vertical solve below works in place on f, so f must hold all levels.
+  static_assert(nsubdomains == 1, "pressure() requires a single pressure slab");
+
+  // The transforms and the vertical solve are done in double precision, so
+  // that a single precision CRM still gets an accurate pressure
+  real4d_dp f ("f" , nzslab, ny2, nx2, ncrms);
 
-  int iwall = 0;
-  int nypp, jwall;
+  int nypp;
 
   if (RUN2D) {
     nypp = 1;
-    jwall = 0;
   } else {
     nypp = ny+2;
   }
 
-  real2d eign("eign",nypp,nx+1);
-
   press_rhs();
 
   // for (int k=0; k<nzslab; k++) {
@@ -93,85 +96,65 @@ void pressure() {
 
   #endif
 
-  // for(int k=0; k<nzslab; k++) {
-  //  for(int j=0; j<nypp; j++) {
-  //    for(int i=0; i<nx+1; i++) {
-  //      for(int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<4>(nzslab,nypp,nx+1,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    ff(k,j,i,icrm) = f(k,j,i,icrm);
-  });
-
-  // for (int k=0; k<nzm; k++) {
-  //  for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<2>(nzm,ncrms) , YAKL_LAMBDA (int k, int icrm) {
-    a(k,icrm)=rhow(k,icrm)/(adz(k,icrm)*adzw(k,icrm)*dz(icrm)*dz(icrm));
-    c(k,icrm)=rhow(k+1,icrm)/(adz(k,icrm)*adzw(k+1,icrm)*dz(icrm)*dz(icrm));
-  });
-
-  //   for (int j=0; j<nypp; j++) {
-  //     for (int i=0; i<nx+1; i++) {
-  parallel_for( SimpleBounds<2>(nypp,nx+1) , YAKL_LAMBDA (int j, int i) {
-    int jt = 0;
-    int it = 0;
-
-    real ddx2=1.0/(dx*dx);
-    real ddy2=1.0/(dy*dy);
-    real pii = 3.14159265358979323846;
-    real xnx=pii/nx;
-    real xny=pii/ny;
-    int jd=((j+1)+jt-0.1)/2.0;
-    real facty = 2.0;
-    real xj=jd;
-    int id=((i+1)+it-0.1)/2.0;
-    real factx = 2.0;
-    real xi=id;
-    eign(j,i)=(2.0*cos(factx*xnx*xi)-2.0)*ddx2+(2.0*cos(facty*xny*xj)-2.0)*ddy2;
-  });
-
+  // Solve the tridiagonal system in the vertical for each wavenumber, in place
+  // on the transformed f. The coefficients and eigenvalues are computed here
+  // rather than in separate kernels.
   // for (int j=0; j<nypp; j++) {
   //  for (int i=0; i<nx+1; i++) {
   //    for (int icrm=0; icrm<ncrms; icrm++) {
   parallel_for( SimpleBounds<3>(nypp,nx+1,ncrms) , YAKL_LAMBDA (int j, int i, int icrm) {
-    SArray<real,1,nzm-1> alfa;
-    SArray<real,1,nzm-1> beta;
+    SArray<real_dp,1,nzm-1> alfa;
+    SArray<real_dp,1,nzm-1> beta;
 
     int jt = 0;
     int it = 0;
     int jd=((j+1)+jt-0.1)/2.0;
     int id=((i+1)+it-0.1)/2.0;
-    real b;
+
+    real_dp eign; {
+      real_dp ddx2=1.0/((real_dp)dx*dx);
+      real_dp ddy2=1.0/((real_dp)dy*dy);
+      real_dp pii = 3.14159265358979323846;
+      real_dp xnx=pii/nx;
+      real_dp xny=pii/ny;
+      real_dp facty = 2.0;
+      real_dp xj=jd;
+      real_dp factx = 2.0;
+      real_dp xi=id;
+      eign=(2.0*cos(factx*xnx*xi)-2.0)*ddx2+(2.0*cos(facty*xny*xj)-2.0)*ddy2;
+    }
+
+    real_dp const dz2 = (real_dp)dz(icrm)*dz(icrm);
+    auto a = [&] (int k) { return rhow(k  ,icrm)/(adz(k,icrm)*adzw(k  ,icrm)*dz2); };
+    auto c = [&] (int k) { return rhow(k+1,icrm)/(adz(k,icrm)*adzw(k+1,icrm)*dz2); };
+
+    real_dp b;
     if(id+jd == 0) {
-      b=1.0/(eign(j,i)*rho(0,icrm)-a(0,icrm)-c(0,icrm));
-      alfa(0)=-c(0,icrm)*b;
-      beta(0)=ff(0,j,i,icrm)*b;
+      b=1.0/(eign*rho(0,icrm)-a(0)-c(0));
+      alfa(0)=-c(0)*b;
+      beta(0)=f(0,j,i,icrm)*b;
     }
     else {
-      b=1.0/(eign(j,i)*rho(0,icrm)-c(0,icrm));
-      alfa(0)=-c(0,icrm)*b;
-      beta(0)=ff(0,j,i,icrm)*b;
+      b=1.0/(eign*rho(0,icrm)-c(0));
+      alfa(0)=-c(0)*b;
+      beta(0)=f(0,j,i,icrm)*b;
     }
 
-    real e;
+    real_dp e;
     for(int k=1; k<nzm-1; k++) {
-      e=1.0/(eign(j,i)*rho(k,icrm)-a(k,icrm)-c(k,icrm)+a(k,icrm)*alfa(k-1));
-      alfa(k)=-c(k,icrm)*e;
-      beta(k)=(ff(k,j,i,icrm)-a(k,icrm)*beta(k-1))*e;
+      real_dp const ak = a(k);
+      e=1.0/(eign*rho(k,icrm)-ak-c(k)+ak*alfa(k-1));
+      alfa(k)=-c(k)*e;
+      beta(k)=(f(k,j,i,icrm)-ak*beta(k-1))*e;
     }
-    ff(nzm-1,j,i,icrm)=(ff(nzm-1,j,i,icrm)-a(nzm-1,icrm)*beta(nzm-2))/
-                       (eign(j,i)*rho(nzm-1,icrm)-a(nzm-1,icrm)+a(nzm-1,icrm)*alfa(nzm-2));
+    real_dp const an = a(nzm-1);
+    f(nzm-1,j,i,icrm)=(f(nzm-1,j,i,icrm)-an*beta(nzm-2))/
+                      (eign*rho(nzm-1,icrm)-an+an*alfa(nzm-2));
     for(int k=nzm-2; k>=0; k--) {
-      ff(k,j,i,icrm)=alfa(k)*ff(k+1,j,i,icrm)+beta(k);
+      f(k,j,i,icrm)=alfa(k)*f(k+1,j,i,icrm)+beta(k);
     }
   });
 
-  // for (int k=0; k<nzslab; k++) {
-  //   for (int j=0; j<nypp; j++) {
-  //     for (int i=0; i<nx+1; i++) {
-  //       for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<4>(nzslab,nypp,nx+1,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    f(k,j,i,icrm) = ff(k,j,i,icrm);
-  });
-
   #ifndef USE_ORIG_FFT
 
     if (RUN3D) { pressure_ffty.inverse_real(f); }
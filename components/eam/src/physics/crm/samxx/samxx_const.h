@@ -26,7 +26,14 @@ void DEBUG_SCALAR(T var) {
   std::cout << std::setprecision(16) << std::scientific << var << std::endl;
 }
 
+#ifdef CRM_SINGLE_PRECISION
+typedef float real;
+#else
 typedef double real;
+#endif
+// Precision of the pressure solve and of the statistics accumulated over the
+// CRM time loop, which stay in double when the rest of the CRM is single
+typedef double real_dp;
 
 int  constexpr crm_nx     = CRM_NX;
 int  constexpr crm_ny     = CRM_NY;
@@ -291,6 +298,11 @@ typedef yakl::Array<real,5,yakl::memDevice,yakl::styleC> real5d;
 typedef yakl::Array<real,6,yakl::memDevice,yakl::styleC> real6d;
 typedef yakl::Array<real,7,yakl::memDevice,yakl::styleC> real7d;
 
+typedef yakl::Array<real_dp,1,yakl::memDevice,yakl::styleC> real1d_dp;
+typedef yakl::Array<real_dp,2,yakl::memDevice,yakl::styleC> real2d_dp;
+typedef yakl::Array<real_dp,3,yakl::memDevice,yakl::styleC> real3d_dp;
+typedef yakl::Array<real_dp,4,yakl::memDevice,yakl::styleC> real4d_dp;
+
 typedef yakl::Array<int,1,yakl::memDevice,yakl::styleC> int1d;
 typedef yakl::Array<int,2,yakl::memDevice,yakl::styleC> int2d;
 typedef yakl::Array<int,3,yakl::memDevice,yakl::styleC> int3d;
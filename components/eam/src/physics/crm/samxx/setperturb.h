@@ -3,6 +3,7 @@
 
 #include "samxx_const.h"
 #include "vars.h"
+#include "shr_RandNum_philox.h"
 
 void setperturb();
 
@@ -20,8 +20,8 @@ void allocate() {
   chtemp           = real3d( "chtemp             "  ,ny , nx , ncrms);
   cttemp           = real3d( "cttemp             "  ,ny , nx , ncrms);
   dd_crm           = real2d( "dd_crm             "      ,plev, ncrms);
-  mui_crm          = real2d( "mui_crm            "    ,plev+1, ncrms);
-  mdi_crm          = real2d( "mdi_crm            "    ,plev+1, ncrms);
+  mui_crm          = real2d_dp( "mui_crm            "    ,plev+1, ncrms);
+  mdi_crm          = real2d_dp( "mdi_crm            "    ,plev+1, ncrms);
   ustar            = real1d( "ustar              "           , ncrms);
   wnd              = real1d( "wnd                "           , ncrms);
   qtot             = real2d( "qtot               "    ,    20, ncrms);
@@ -113,6 +113,24 @@ void allocate() {
   fluxtt           = real3d( "fluxtt          "           , ny         , nx     , ncrms ); 
   fluxtq           = real3d( "fluxtq          "           , ny         , nx     , ncrms ); 
   fzero            = real3d( "fzero           "           , ny         , nx     , ncrms ); 
+  adv_f0           = real4d( "adv_f0          "     , nzm , dimy_s     , dimx_s , ncrms ); 
+  adv_mx           = real4d( "adv_mx          "     , nzm , RUN3D ? ny+2 : 1 , nx+2 , ncrms ); 
+  adv_mn           = real4d( "adv_mn          "     , nzm , RUN3D ? ny+2 : 1 , nx+2 , ncrms ); 
+  adv_uuu          = real4d( "adv_uuu         "     , nzm , RUN3D ? ny+4 : 1 , nx+5 , ncrms ); 
+  if (RUN3D) {
+    adv_vvv        = real4d( "adv_vvv         "     , nzm , ny+5       , nx+4   , ncrms ); 
+  }
+  adv_www          = real4d( "adv_www         "     , nz  , RUN3D ? ny+4 : 1 , nx+4 , ncrms ); 
+  adv_iadz         = real2d( "adv_iadz        "                        , nzm    , ncrms ); 
+  adv_irho         = real2d( "adv_irho        "                        , nzm    , ncrms ); 
+  adv_irhow        = real2d( "adv_irhow       "                        , nzm    , ncrms ); 
+  diff_df          = real4d( "diff_df         "     , nzm , dimy_s     , dimx_s , ncrms ); 
+  diff_flx_x       = real4d( "diff_flx_x      "     , nzm+1 , RUN3D ? ny+1 : 1 , nx+1 , ncrms ); 
+  if (RUN3D) {
+    diff_flx_y     = real4d( "diff_flx_y      "     , nzm+1 , ny+1     , nx+1   , ncrms ); 
+    diff_flx_z     = real4d( "diff_flx_z      "     , nzm+1 , ny+1     , nx+1   , ncrms ); 
+  }
+  diff_dfdt        = real4d( "diff_dfdt       "     , nz  , ny         , nx     , ncrms ); 
   precsfc          = real3d( "precsfc         "           , ny         , nx     , ncrms ); 
   precssfc         = real3d( "precssfc        "           , ny         , nx     , ncrms ); 
   t0               = real2d( "t0              "                        , nzm    , ncrms ); 
@@ -495,8 +513,8 @@ void finalize() {
   chtemp           = real3d();
   cttemp           = real3d();
   dd_crm           = real2d();
-  mui_crm          = real2d();
-  mdi_crm          = real2d();
+  mui_crm          = real2d_dp();
+  mdi_crm          = real2d_dp();
   ustar            = real1d();
   wnd              = real1d();
   qtot             = real2d();
@@ -578,6 +596,20 @@ void finalize() {
   fluxtt           = real3d();
   fluxtq           = real3d();
   fzero            = real3d();
+  adv_f0           = real4d();
+  adv_mx           = real4d();
+  adv_mn           = real4d();
+  adv_uuu          = real4d();
+  adv_vvv          = real4d();
+  adv_www          = real4d();
+  adv_iadz         = real2d();
+  adv_irho         = real2d();
+  adv_irhow        = real2d();
+  diff_df          = real4d();
+  diff_flx_x       = real4d();
+  diff_flx_y       = real4d();
+  diff_flx_z       = real4d();
+  diff_dfdt        = real4d();
   precsfc          = real3d();
   precssfc         = real3d();
   t0               = real2d();
@@ -754,23 +786,23 @@ void create_and_copy_inputs(real *crm_input_bflxls_p, real *crm_input_wndls_p, r
   ::crm_state_qp              = real4d( "crm_state_qp            ", crm_nz, crm_ny    , crm_nx    , pcols);
   ::crm_state_qn              = real4d( "crm_state_qn            ", crm_nz, crm_ny    , crm_nx    , pcols);
   ::crm_rad_qrad              = real4d( "crm_rad_qrad            ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
-  ::crm_rad_temperature       = real4d( "crm_rad_temperature     ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
-  ::crm_rad_qv                = real4d( "crm_rad_qv              ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
-  ::crm_rad_qc                = real4d( "crm_rad_qc              ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
-  ::crm_rad_qi                = real4d( "crm_rad_qi              ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
-  ::crm_rad_cld               = real4d( "crm_rad_cld             ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
+  ::crm_rad_temperature       = real4d_dp( "crm_rad_temperature     ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
+  ::crm_rad_qv                = real4d_dp( "crm_rad_qv              ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
+  ::crm_rad_qc                = real4d_dp( "crm_rad_qc              ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
+  ::crm_rad_qi                = real4d_dp( "crm_rad_qi              ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
+  ::crm_rad_cld               = real4d_dp( "crm_rad_cld             ", crm_nz, crm_ny_rad, crm_nx_rad, pcols);
   ::crm_output_subcycle_factor  = real1d( "crm_output_subcycle_factor"                                , pcols); 
   ::crm_output_prectend       = real1d( "crm_output_prectend     "                                , pcols); 
   ::crm_output_precstend      = real1d( "crm_output_precstend    "                                , pcols); 
-  ::crm_output_cld            = real2d( "crm_output_cld          "                   , plev       , pcols); 
-  ::crm_output_cldtop         = real2d( "crm_output_cldtop       "                   , plev       , pcols); 
-  ::crm_output_gicewp         = real2d( "crm_output_gicewp       "                   , plev       , pcols); 
-  ::crm_output_gliqwp         = real2d( "crm_output_gliqwp       "                   , plev       , pcols); 
+  ::crm_output_cld            = real2d_dp( "crm_output_cld          "                   , plev       , pcols); 
+  ::crm_output_cldtop         = real2d_dp( "crm_output_cldtop       "                   , plev       , pcols); 
+  ::crm_output_gicewp         = real2d_dp( "crm_output_gicewp       "                   , plev       , pcols); 
+  ::crm_output_gliqwp         = real2d_dp( "crm_output_gliqwp       "                   , plev       , pcols); 
   ::crm_output_mctot          = real2d( "crm_output_mctot        "                   , plev       , pcols); 
-  ::crm_output_mcup           = real2d( "crm_output_mcup         "                   , plev       , pcols); 
-  ::crm_output_mcdn           = real2d( "crm_output_mcdn         "                   , plev       , pcols); 
-  ::crm_output_mcuup          = real2d( "crm_output_mcuup        "                   , plev       , pcols); 
-  ::crm_output_mcudn          = real2d( "crm_output_mcudn        "                   , plev       , pcols); 
+  ::crm_output_mcup           = real2d_dp( "crm_output_mcup         "                   , plev       , pcols); 
+  ::crm_output_mcdn           = real2d_dp( "crm_output_mcdn         "                   , plev       , pcols); 
+  ::crm_output_mcuup          = real2d_dp( "crm_output_mcuup        "                   , plev       , pcols); 
+  ::crm_output_mcudn          = real2d_dp( "crm_output_mcudn        "                   , plev       , pcols); 
   ::crm_output_qc_mean        = real2d( "crm_output_qc_mean      "                   , plev       , pcols); 
   ::crm_output_qi_mean        = real2d( "crm_output_qi_mean      "                   , plev       , pcols); 
   ::crm_output_qs_mean        = real2d( "crm_output_qs_mean      "                   , plev       , pcols); 
@@ -800,10 +832,10 @@ void create_and_copy_inputs(real *crm_input_bflxls_p, real *crm_input_wndls_p, r
   ::crm_output_t_ls           = real2d( "crm_output_t_ls         "                   , plev       , pcols); 
   ::crm_output_jt_crm         = real1d( "crm_output_jt_crm       "                                , pcols); 
   ::crm_output_mx_crm         = real1d( "crm_output_mx_crm       "                                , pcols); 
-  ::crm_output_cltot          = real1d( "crm_output_cltot        "                                , pcols); 
-  ::crm_output_clhgh          = real1d( "crm_output_clhgh        "                                , pcols); 
-  ::crm_output_clmed          = real1d( "crm_output_clmed        "                                , pcols); 
-  ::crm_output_cllow          = real1d( "crm_output_cllow        "                                , pcols); 
+  ::crm_output_cltot          = real1d_dp( "crm_output_cltot        "                                , pcols); 
+  ::crm_output_clhgh          = real1d_dp( "crm_output_clhgh        "                                , pcols); 
+  ::crm_output_clmed          = real1d_dp( "crm_output_clmed        "                                , pcols); 
+  ::crm_output_cllow          = real1d_dp( "crm_output_cllow        "                                , pcols); 
   ::crm_output_sltend         = real2d( "crm_output_sltend       "                   , plev       , pcols); 
   ::crm_output_qltend         = real2d( "crm_output_qltend       "                   , plev       , pcols); 
   ::crm_output_qcltend        = real2d( "crm_output_qcltend      "                   , plev       , pcols); 
@@ -832,7 +864,7 @@ void create_and_copy_inputs(real *crm_input_bflxls_p, real *crm_input_wndls_p, r
   ::crm_output_precsl         = real1d( "crm_output_precsl       "                                , pcols); 
   ::crm_output_prec_crm       = real3d( "crm_output_prec_crm     "          , crm_ny    , crm_nx  , pcols); 
 
-  ::crm_clear_rh              = real2d( "crm_clear_rh            "                      , crm_nz  , ncrms); 
+  ::crm_clear_rh              = real2d_dp( "crm_clear_rh            "                      , crm_nz  , ncrms); 
   ::lat0                      = real1d( "lat0                    "                                , ncrms); 
   ::long0                     = real1d( "long0                   "                                , ncrms); 
   ::gcolp                     = int1d ( "gcolp                   "                                , ncrms); 
@@ -869,10 +901,10 @@ void create_and_copy_inputs(real *crm_input_bflxls_p, real *crm_input_wndls_p, r
   lat0                    .deep_copy_to(::lat0                    );
   long0                   .deep_copy_to(::long0                   );
   gcolp                   .deep_copy_to(::gcolp                   );
-  crm_output_cltot        .deep_copy_to(::crm_output_cltot        );
-  crm_output_clhgh        .deep_copy_to(::crm_output_clhgh        );
-  crm_output_clmed        .deep_copy_to(::crm_output_clmed        );
-  crm_output_cllow        .deep_copy_to(::crm_output_cllow        );
+  deep_copy_convert( crm_output_cltot        , ::crm_output_cltot        );
+  deep_copy_convert( crm_output_clhgh        , ::crm_output_clhgh        );
+  deep_copy_convert( crm_output_clmed        , ::crm_output_clmed        );
+  deep_copy_convert( crm_output_cllow        , ::crm_output_cllow        );
 }
 
 
@@ -990,23 +1022,23 @@ void copy_outputs(real *crm_state_u_wind_p, real *crm_state_v_wind_p, real *crm_
   crm_state_qv              .deep_copy_to( ::crm_state_qv               );
   crm_state_qp              .deep_copy_to( ::crm_state_qp               );
   crm_state_qn              .deep_copy_to( ::crm_state_qn               );
-  crm_rad_temperature       .deep_copy_to( ::crm_rad_temperature        );
-  crm_rad_qv                .deep_copy_to( ::crm_rad_qv                 );
-  crm_rad_qc                .deep_copy_to( ::crm_rad_qc                 );
-  crm_rad_qi                .deep_copy_to( ::crm_rad_qi                 );
-  crm_rad_cld               .deep_copy_to( ::crm_rad_cld                );
+  deep_copy_convert( crm_rad_temperature       , ::crm_rad_temperature        );
+  deep_copy_convert( crm_rad_qv                , ::crm_rad_qv                 );
+  deep_copy_convert( crm_rad_qc                , ::crm_rad_qc                 );
+  deep_copy_convert( crm_rad_qi                , ::crm_rad_qi                 );
+  deep_copy_convert( crm_rad_cld               , ::crm_rad_cld                );
   crm_output_subcycle_factor  .deep_copy_to( ::crm_output_subcycle_factor   ); 
   crm_output_prectend       .deep_copy_to( ::crm_output_prectend        ); 
   crm_output_precstend      .deep_copy_to( ::crm_output_precstend       ); 
-  crm_output_cld            .deep_copy_to( ::crm_output_cld             ); 
-  crm_output_cldtop         .deep_copy_to( ::crm_output_cldtop          ); 
-  crm_output_gicewp         .deep_copy_to( ::crm_output_gicewp          ); 
-  crm_output_gliqwp         .deep_copy_to( ::crm_output_gliqwp          ); 
+  deep_copy_convert( crm_output_cld            , ::crm_output_cld             ); 
+  deep_copy_convert( crm_output_cldtop         , ::crm_output_cldtop          ); 
+  deep_copy_convert( crm_output_gicewp         , ::crm_output_gicewp          ); 
+  deep_copy_convert( crm_output_gliqwp         , ::crm_output_gliqwp          ); 
   crm_output_mctot          .deep_copy_to( ::crm_output_mctot           ); 
-  crm_output_mcup           .deep_copy_to( ::crm_output_mcup            ); 
-  crm_output_mcdn           .deep_copy_to( ::crm_output_mcdn            ); 
-  crm_output_mcuup          .deep_copy_to( ::crm_output_mcuup           ); 
-  crm_output_mcudn          .deep_copy_to( ::crm_output_mcudn           ); 
+  deep_copy_convert( crm_output_mcup           , ::crm_output_mcup            ); 
+  deep_copy_convert( crm_output_mcdn           , ::crm_output_mcdn            ); 
+  deep_copy_convert( crm_output_mcuup          , ::crm_output_mcuup           ); 
+  deep_copy_convert( crm_output_mcudn          , ::crm_output_mcudn           ); 
   crm_output_qc_mean        .deep_copy_to( ::crm_output_qc_mean         ); 
   crm_output_qi_mean        .deep_copy_to( ::crm_output_qi_mean         ); 
   crm_output_qs_mean        .deep_copy_to( ::crm_output_qs_mean         ); 
@@ -1036,10 +1068,10 @@ void copy_outputs(real *crm_state_u_wind_p, real *crm_state_v_wind_p, real *crm_
   crm_output_t_ls           .deep_copy_to( ::crm_output_t_ls            ); 
   crm_output_jt_crm         .deep_copy_to( ::crm_output_jt_crm          ); 
   crm_output_mx_crm         .deep_copy_to( ::crm_output_mx_crm          ); 
-  crm_output_cltot          .deep_copy_to( ::crm_output_cltot           ); 
-  crm_output_clhgh          .deep_copy_to( ::crm_output_clhgh           ); 
-  crm_output_clmed          .deep_copy_to( ::crm_output_clmed           ); 
-  crm_output_cllow          .deep_copy_to( ::crm_output_cllow           ); 
+  deep_copy_convert( crm_output_cltot          , ::crm_output_cltot           ); 
+  deep_copy_convert( crm_output_clhgh          , ::crm_output_clhgh           ); 
+  deep_copy_convert( crm_output_clmed          , ::crm_output_clmed           ); 
+  deep_copy_convert( crm_output_cllow          , ::crm_output_cllow           ); 
   crm_output_sltend         .deep_copy_to( ::crm_output_sltend          ); 
   crm_output_qltend         .deep_copy_to( ::crm_output_qltend          ); 
   crm_output_qcltend        .deep_copy_to( ::crm_output_qcltend         ); 
@@ -1066,7 +1098,7 @@ void copy_outputs(real *crm_state_u_wind_p, real *crm_state_v_wind_p, real *crm_
   crm_output_precsc         .deep_copy_to( ::crm_output_precsc          ); 
   crm_output_precsl         .deep_copy_to( ::crm_output_precsl          ); 
   crm_output_prec_crm       .deep_copy_to( ::crm_output_prec_crm        );  
-  crm_clear_rh              .deep_copy_to( ::crm_clear_rh               );  
+  deep_copy_convert( crm_clear_rh              , ::crm_clear_rh               );  
 }
 
 
@@ -1186,23 +1218,23 @@ void copy_outputs_and_destroy(real *crm_state_u_wind_p, real *crm_state_v_wind_p
   ::crm_state_qv            .deep_copy_to(crm_state_qv            );
   ::crm_state_qp            .deep_copy_to(crm_state_qp            );
   ::crm_state_qn            .deep_copy_to(crm_state_qn            );
-  ::crm_rad_temperature     .deep_copy_to(crm_rad_temperature     );
-  ::crm_rad_qv              .deep_copy_to(crm_rad_qv              );
-  ::crm_rad_qc              .deep_copy_to(crm_rad_qc              );
-  ::crm_rad_qi              .deep_copy_to(crm_rad_qi              );
-  ::crm_rad_cld             .deep_copy_to(crm_rad_cld             );
+  deep_copy_convert( ::crm_rad_temperature     , crm_rad_temperature     );
+  deep_copy_convert( ::crm_rad_qv              , crm_rad_qv              );
+  deep_copy_convert( ::crm_rad_qc              , crm_rad_qc              );
+  deep_copy_convert( ::crm_rad_qi              , crm_rad_qi              );
+  deep_copy_convert( ::crm_rad_cld             , crm_rad_cld             );
   ::crm_output_subcycle_factor.deep_copy_to(crm_output_subcycle_factor);
   ::crm_output_prectend     .deep_copy_to(crm_output_prectend     );
   ::crm_output_precstend    .deep_copy_to(crm_output_precstend    );
-  ::crm_output_cld          .deep_copy_to(crm_output_cld          );
-  ::crm_output_cldtop       .deep_copy_to(crm_output_cldtop       );
-  ::crm_output_gicewp       .deep_copy_to(crm_output_gicewp       );
-  ::crm_output_gliqwp       .deep_copy_to(crm_output_gliqwp       );
+  deep_copy_convert( ::crm_output_cld          , crm_output_cld          );
+  deep_copy_convert( ::crm_output_cldtop       , crm_output_cldtop       );
+  deep_copy_convert( ::crm_output_gicewp       , crm_output_gicewp       );
+  deep_copy_convert( ::crm_output_gliqwp       , crm_output_gliqwp       );
   ::crm_output_mctot        .deep_copy_to(crm_output_mctot        );
-  ::crm_output_mcup         .deep_copy_to(crm_output_mcup         );
-  ::crm_output_mcdn         .deep_copy_to(crm_output_mcdn         );
-  ::crm_output_mcuup        .deep_copy_to(crm_output_mcuup        );
-  ::crm_output_mcudn        .deep_copy_to(crm_output_mcudn        );
+  deep_copy_convert( ::crm_output_mcup         , crm_output_mcup         );
+  deep_copy_convert( ::crm_output_mcdn         , crm_output_mcdn         );
+  deep_copy_convert( ::crm_output_mcuup        , crm_output_mcuup        );
+  deep_copy_convert( ::crm_output_mcudn        , crm_output_mcudn        );
   ::crm_output_qc_mean      .deep_copy_to(crm_output_qc_mean      );
   ::crm_output_qi_mean      .deep_copy_to(crm_output_qi_mean      );
   ::crm_output_qs_mean      .deep_copy_to(crm_output_qs_mean      );
@@ -1232,10 +1264,10 @@ void copy_outputs_and_destroy(real *crm_state_u_wind_p, real *crm_state_v_wind_p
   ::crm_output_t_ls         .deep_copy_to(crm_output_t_ls         );
   ::crm_output_jt_crm       .deep_copy_to(crm_output_jt_crm       );
   ::crm_output_mx_crm       .deep_copy_to(crm_output_mx_crm       );
-  ::crm_output_cltot        .deep_copy_to(crm_output_cltot        );
-  ::crm_output_clhgh        .deep_copy_to(crm_output_clhgh        );
-  ::crm_output_clmed        .deep_copy_to(crm_output_clmed        );
-  ::crm_output_cllow        .deep_copy_to(crm_output_cllow        );
+  deep_copy_convert( ::crm_output_cltot        , crm_output_cltot        );
+  deep_copy_convert( ::crm_output_clhgh        , crm_output_clhgh        );
+  deep_copy_convert( ::crm_output_clmed        , crm_output_clmed        );
+  deep_copy_convert( ::crm_output_cllow        , crm_output_cllow        );
   ::crm_output_sltend       .deep_copy_to(crm_output_sltend       );
   ::crm_output_qltend       .deep_copy_to(crm_output_qltend       );
   ::crm_output_qcltend      .deep_copy_to(crm_output_qcltend      );
@@ -1262,7 +1294,7 @@ void copy_outputs_and_destroy(real *crm_state_u_wind_p, real *crm_state_v_wind_p
   ::crm_output_precsc       .deep_copy_to(crm_output_precsc       );
   ::crm_output_precsl       .deep_copy_to(crm_output_precsl       );
   ::crm_output_prec_crm     .deep_copy_to(crm_output_prec_crm     );
-  ::crm_clear_rh            .deep_copy_to(crm_clear_rh            );
+  deep_copy_convert( ::crm_clear_rh            , crm_clear_rh            );
 
   // Deallocate data
   ::crm_input_bflxls          = real1d();
@@ -1292,23 +1324,23 @@ void copy_outputs_and_destroy(real *crm_state_u_wind_p, real *crm_state_v_wind_p
   ::crm_state_qp              = real4d();
   ::crm_state_qn              = real4d();
   ::crm_rad_qrad              = real4d();
-  ::crm_rad_temperature       = real4d();
-  ::crm_rad_qv                = real4d();
-  ::crm_rad_qc                = real4d();
-  ::crm_rad_qi                = real4d();
-  ::crm_rad_cld               = real4d();
+  ::crm_rad_temperature       = real4d_dp();
+  ::crm_rad_qv                = real4d_dp();
+  ::crm_rad_qc                = real4d_dp();
+  ::crm_rad_qi                = real4d_dp();
+  ::crm_rad_cld               = real4d_dp();
   ::crm_output_subcycle_factor  = real1d();
   ::crm_output_prectend       = real1d();
   ::crm_output_precstend      = real1d();
-  ::crm_output_cld            = real2d();
-  ::crm_output_cldtop         = real2d();
-  ::crm_output_gicewp         = real2d();
-  ::crm_output_gliqwp         = real2d();
+  ::crm_output_cld            = real2d_dp();
+  ::crm_output_cldtop         = real2d_dp();
+  ::crm_output_gicewp         = real2d_dp();
+  ::crm_output_gliqwp         = real2d_dp();
   ::crm_output_mctot          = real2d();
-  ::crm_output_mcup           = real2d();
-  ::crm_output_mcdn           = real2d();
-  ::crm_output_mcuup          = real2d();
-  ::crm_output_mcudn          = real2d();
+  ::crm_output_mcup           = real2d_dp();
+  ::crm_output_mcdn           = real2d_dp();
+  ::crm_output_mcuup          = real2d_dp();
+  ::crm_output_mcudn          = real2d_dp();
   ::crm_output_qc_mean        = real2d();
   ::crm_output_qi_mean        = real2d();
   ::crm_output_qs_mean        = real2d();
@@ -1338,10 +1370,10 @@ void copy_outputs_and_destroy(real *crm_state_u_wind_p, real *crm_state_v_wind_p
   ::crm_output_t_ls           = real2d();
   ::crm_output_jt_crm         = real1d();
   ::crm_output_mx_crm         = real1d();
-  ::crm_output_cltot          = real1d();
-  ::crm_output_clhgh          = real1d();
-  ::crm_output_clmed          = real1d();
-  ::crm_output_cllow          = real1d();
+  ::crm_output_cltot          = real1d_dp();
+  ::crm_output_clhgh          = real1d_dp();
+  ::crm_output_clmed          = real1d_dp();
+  ::crm_output_cllow          = real1d_dp();
   ::crm_output_sltend         = real2d();
   ::crm_output_qltend         = real2d();
   ::crm_output_qcltend        = real2d();
@@ -1368,7 +1400,7 @@ void copy_outputs_and_destroy(real *crm_state_u_wind_p, real *crm_state_v_wind_p
   ::crm_output_precsc         = real1d();
   ::crm_output_precsl         = real1d();
   ::crm_output_prec_crm       = real3d();
-  ::crm_clear_rh              = real2d();
+  ::crm_clear_rh              = real2d_dp();
   ::lat0                      = real1d();
   ::long0                     = real1d();
   ::gcolp                     = int1d();
@@ -1548,6 +1580,20 @@ real3d fluxtv          ;
 real3d fluxtt          ;
 real3d fluxtq          ;
 real3d fzero           ;
+real4d adv_f0          ;
+real4d adv_mx          ;
+real4d adv_mn          ;
+real4d adv_uuu         ;
+real4d adv_vvv         ;
+real4d adv_www         ;
+real2d adv_iadz        ;
+real2d adv_irho        ;
+real2d adv_irhow       ;
+real4d diff_df         ;
+real4d diff_flx_x      ;
+real4d diff_flx_y      ;
+real4d diff_flx_z      ;
+real4d diff_dfdt       ;
 real3d precsfc         ;
 real3d precssfc        ;
 real2d t0              ;
@@ -1710,8 +1756,8 @@ real3d cmtemp          ;
 real3d chtemp          ;
 real3d cttemp          ;
 real2d dd_crm          ;
-real2d mui_crm         ;
-real2d mdi_crm         ;
+real2d_dp mui_crm         ;
+real2d_dp mdi_crm         ;
 real1d ustar           ;
 real1d wnd             ;
 real2d qtot            ;
@@ -1746,23 +1792,23 @@ real4d crm_state_qv;
 real4d crm_state_qp;
 real4d crm_state_qn;
 real4d crm_rad_qrad;
-real4d crm_rad_temperature;
-real4d crm_rad_qv; 
-real4d crm_rad_qc; 
-real4d crm_rad_qi; 
-real4d crm_rad_cld; 
+real4d_dp crm_rad_temperature;
+real4d_dp crm_rad_qv; 
+real4d_dp crm_rad_qc; 
+real4d_dp crm_rad_qi; 
+real4d_dp crm_rad_cld; 
 real1d crm_output_subcycle_factor;
 real1d crm_output_prectend;
 real1d crm_output_precstend; 
-real2d crm_output_cld; 
-real2d crm_output_cldtop; 
-real2d crm_output_gicewp;
-real2d crm_output_gliqwp; 
+real2d_dp crm_output_cld; 
+real2d_dp crm_output_cldtop; 
+real2d_dp crm_output_gicewp;
+real2d_dp crm_output_gliqwp; 
 real2d crm_output_mctot; 
-real2d crm_output_mcup; 
-real2d crm_output_mcdn; 
-real2d crm_output_mcuup; 
-real2d crm_output_mcudn;
+real2d_dp crm_output_mcup; 
+real2d_dp crm_output_mcdn; 
+real2d_dp crm_output_mcuup; 
+real2d_dp crm_output_mcudn;
 real2d crm_output_qc_mean;
 real2d crm_output_qi_mean;
 real2d crm_output_qs_mean;
@@ -1792,10 +1838,10 @@ real2d crm_output_qt_ls;
 real2d crm_output_t_ls; 
 real1d crm_output_jt_crm; 
 real1d crm_output_mx_crm; 
-real1d crm_output_cltot; 
-real1d crm_output_clhgh; 
-real1d crm_output_clmed; 
-real1d crm_output_cllow; 
+real1d_dp crm_output_cltot; 
+real1d_dp crm_output_clhgh; 
+real1d_dp crm_output_clmed; 
+real1d_dp crm_output_cllow; 
 real2d crm_output_sltend; 
 real2d crm_output_qltend; 
 real2d crm_output_qcltend; 
@@ -1822,7 +1868,7 @@ real1d crm_output_precl;
 real1d crm_output_precsc; 
 real1d crm_output_precsl; 
 real3d crm_output_prec_crm;
-real2d crm_clear_rh;
+real2d_dp crm_clear_rh;
 int2d crm_clear_rh_cnt;
 real1d lat0; 
 real1d long0;
@@ -1957,6 +2003,7 @@ bool use_ESMT;
 bool crm_accel_uv;
 bool use_crm_accel;
 real crm_accel_factor;
+bool crm_accel_adaptive;
 
 real factor_xy;
 real factor_xyt;
@@ -1973,8 +2020,8 @@ bool crm_accel_ceaseflag;
 
 int igstep;
 
-yakl::RealFFT1D<real> pressure_fftx;
-yakl::RealFFT1D<real> pressure_ffty;
+yakl::RealFFT1D<real_dp> pressure_fftx;
+yakl::RealFFT1D<real_dp> pressure_ffty;
 yakl::RealFFT1D<real> vt_fftx;
 yakl::RealFFT1D<real> vt_ffty;
 yakl::RealFFT1D<real> esmt_fftx;
@@ -31,6 +31,30 @@ inline real arraySum(real1d &arr) {
 }
 
 
+// Copies the Fortran data of a statistic to its device array, which is in
+// double precision even when the CRM is single (see real_dp)
+template <class T, class U, int N>
+inline void deep_copy_convert(yakl::Array<T,N,yakl::memHost,yakl::styleC> const &from,
+                              yakl::Array<U,N,yakl::memDevice,yakl::styleC> const &to) {
+  auto to_host = to.createHostObject();
+  for (int i=0; i<from.get_totElems(); i++) {
+    to_host.data()[i] = from.data()[i];
+  }
+  to_host.deep_copy_to(to);
+}
+
+
+// Copies the device array of a statistic back to its Fortran data
+template <class T, class U, int N>
+inline void deep_copy_convert(yakl::Array<T,N,yakl::memDevice,yakl::styleC> const &from,
+                              yakl::Array<U,N,yakl::memHost,yakl::styleC> const &to) {
+  auto from_host = from.createHostCopy();
+  for (int i=0; i<to.get_totElems(); i++) {
+    to.data()[i] = from_host.data()[i];
+  }
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////
 // These arrays use non-1 lower bounds in the Fortran code
 // They must be indexed differently in the C++ code
@@ -240,6 +264,7 @@ extern bool use_ESMT;
 extern bool crm_accel_uv;
 extern bool use_crm_accel;
 extern real crm_accel_factor;
+extern bool crm_accel_adaptive;
 
 extern real4d tabs            ;
 extern real4d qv              ;
@@ -260,6 +285,23 @@ extern real3d fluxtv          ;
 extern real3d fluxtt          ;
 extern real3d fluxtq          ;
 extern real3d fzero           ;
+
+// Scratch for advect_scalar* and diffuse_scalar*. These are called once per
+// scalar per step, so their temporaries are allocated once in allocate().
+extern real4d adv_f0          ;
+extern real4d adv_mx          ;
+extern real4d adv_mn          ;
+extern real4d adv_uuu         ;
+extern real4d adv_vvv         ;
+extern real4d adv_www         ;
+extern real2d adv_iadz        ;
+extern real2d adv_irho        ;
+extern real2d adv_irhow       ;
+extern real4d diff_df         ;
+extern real4d diff_flx_x      ;
+extern real4d diff_flx_y      ;
+extern real4d diff_flx_z      ;
+extern real4d diff_dfdt       ;
 extern real3d precsfc         ;
 extern real3d precssfc        ;
 extern real2d t0              ;
@@ -416,8 +458,8 @@ extern real3d cmtemp          ;
 extern real3d chtemp          ;
 extern real3d cttemp          ;
 extern real2d dd_crm          ;
-extern real2d mui_crm         ;
-extern real2d mdi_crm         ;
+extern real2d_dp mui_crm         ;
+extern real2d_dp mdi_crm         ;
 extern real1d ustar           ;
 extern real1d wnd             ;
 extern real2d qtot            ;
@@ -453,23 +495,23 @@ extern real4d crm_state_qv;
 extern real4d crm_state_qp;
 extern real4d crm_state_qn;
 extern real4d crm_rad_qrad;
-extern real4d crm_rad_temperature;
-extern real4d crm_rad_qv; 
-extern real4d crm_rad_qc; 
-extern real4d crm_rad_qi; 
-extern real4d crm_rad_cld; 
+extern real4d_dp crm_rad_temperature;
+extern real4d_dp crm_rad_qv; 
+extern real4d_dp crm_rad_qc; 
+extern real4d_dp crm_rad_qi; 
+extern real4d_dp crm_rad_cld; 
 extern real1d crm_output_subcycle_factor;
 extern real1d crm_output_prectend;
 extern real1d crm_output_precstend; 
-extern real2d crm_output_cld; 
-extern real2d crm_output_cldtop; 
-extern real2d crm_output_gicewp;
-extern real2d crm_output_gliqwp; 
+extern real2d_dp crm_output_cld; 
+extern real2d_dp crm_output_cldtop; 
+extern real2d_dp crm_output_gicewp;
+extern real2d_dp crm_output_gliqwp; 
 extern real2d crm_output_mctot; 
-extern real2d crm_output_mcup; 
-extern real2d crm_output_mcdn; 
-extern real2d crm_output_mcuup; 
-extern real2d crm_output_mcudn;
+extern real2d_dp crm_output_mcup; 
+extern real2d_dp crm_output_mcdn; 
+extern real2d_dp crm_output_mcuup; 
+extern real2d_dp crm_output_mcudn;
 extern real2d crm_output_qc_mean;
 extern real2d crm_output_qi_mean;
 extern real2d crm_output_qs_mean;
@@ -499,10 +541,10 @@ extern real2d crm_output_qt_ls;
 extern real2d crm_output_t_ls; 
 extern real1d crm_output_jt_crm; 
 extern real1d crm_output_mx_crm; 
-extern real1d crm_output_cltot; 
-extern real1d crm_output_clhgh; 
-extern real1d crm_output_clmed; 
-extern real1d crm_output_cllow; 
+extern real1d_dp crm_output_cltot; 
+extern real1d_dp crm_output_clhgh; 
+extern real1d_dp crm_output_clmed; 
+extern real1d_dp crm_output_cllow; 
 extern real2d crm_output_sltend; 
 extern real2d crm_output_qltend; 
 extern real2d crm_output_qcltend; 
@@ -531,7 +573,7 @@ extern real1d crm_output_precsc;
 extern real1d crm_output_precsl; 
 extern real3d crm_output_prec_crm; 
 
-extern real2d crm_clear_rh;
+extern real2d_dp crm_clear_rh;
 extern int2d  crm_clear_rh_cnt;
 extern real1d lat0; 
 extern real1d long0;
@@ -552,8 +594,8 @@ extern bool crm_accel_ceaseflag;
 
 extern int igstep;
 
-extern yakl::RealFFT1D<real> pressure_fftx;
-extern yakl::RealFFT1D<real> pressure_ffty;
+extern yakl::RealFFT1D<real_dp> pressure_fftx;
+extern yakl::RealFFT1D<real_dp> pressure_ffty;
 extern yakl::RealFFT1D<real> vt_fftx;
 extern yakl::RealFFT1D<real> vt_ffty;
 extern yakl::RealFFT1D<real> esmt_fftx;
@@ -32,6 +32,7 @@
 
 #include <fstream>
 #include <random>
+#include <set>
 
 namespace scream {
 
@@ -890,6 +891,20 @@ void AtmosphereDriver::restart_model ()
 
   m_atm_logger->info("    [EAMxx] Restart filename: " + filename);
 
+  // If the model restart output skipped the fields that did not change since the previous
+  // restart file, the restart file lists them, together with the files containing them
+  std::map<std::string,std::string> previous_restarts;
+  if (scorpio::has_attribute(filename,"fields_in_previous_restarts")) {
+    const auto names = ekat::split(scorpio::get_attribute<std::string>(filename,"fields_in_previous_restarts"),",");
+    const auto files = ekat::split(scorpio::get_attribute<std::string>(filename,"previous_restart_files"),",");
+    EKAT_REQUIRE_MSG (names.size()==files.size(),
+        "Error! Mismatching lists of fields in previous restarts and of their files.\n"
+        " - file name: " + filename + "\n");
+    for (size_t i=0; i<names.size(); ++i) {
+      previous_restarts[names[i]] = files[i];
+    }
+  }
+
   for (auto& it : m_field_mgrs) {
     if (fvphyshack and it.second->get_grid()->name() == "Physics GLL") continue;
     if (not it.second->has_group("RESTART")) {
@@ -898,10 +913,20 @@ void AtmosphereDriver::restart_model ()
     }
     const auto& restart_group = it.second->get_groups_info().at("RESTART");
     std::vector<std::string> fnames;
+    std::map<std::string,std::vector<std::string>> fnames_in_previous_restarts;
     for (const auto& fn : restart_group->m_fields_names) {
-      fnames.push_back(fn);
+      auto prev = previous_restarts.find(fn);
+      if (prev!=previous_restarts.end()) {
+        fnames_in_previous_restarts[prev->second].push_back(fn);
+      } else {
+        fnames.push_back(fn);
+      }
     }
     read_fields_from_file (fnames,it.second->get_grid(),filename,m_current_ts);
+    for (const auto& prev : fnames_in_previous_restarts) {
+      m_atm_logger->info("    [EAMxx] Reading unchanged restart fields from: " + prev.first);
+      read_fields_from_file (prev.second,it.second->get_grid(),prev.first,m_current_ts);
+    }
   }
 
   // Restart the num steps counter in the atm time stamp
@@ -1611,6 +1636,20 @@ void AtmosphereDriver::run (const int dt) {
   // Update current time stamps
   m_current_ts += dt;
 
+  // Some processes may leave work pending at the end of run (e.g., COSP on a host thread),
+  // to be completed in a later step. Complete it now only if a file written at this step
+  // (e.g., a restart file) contains the internal fields where its results are stored.
+  std::set<std::string> internal_fields;
+  for (const auto& f : m_atm_process_group->get_internal_fields()) {
+    internal_fields.insert(f.name());
+  }
+  for (const auto& out_mgr : m_output_managers) {
+    if (out_mgr.writes_any_field(m_current_ts,internal_fields)) {
+      m_atm_process_group->finish_step();
+      break;
+    }
+  }
+
   // Update output streams
   m_atm_logger->debug("[EAMxx::run] running output managers...");
   for (auto& out_mgr : m_output_managers) {
@@ -155,6 +155,9 @@ protected:
   view_1d<DefaultDevice, SurfaceCouplingColumnInfo> m_column_info_d;
   decltype(m_column_info_d)::HostMirror             m_column_info_h;
 
+  // For each cpl export, the index of the corresponding scream export (-1 if none)
+  view_1d<DefaultDevice, int> m_cpl_to_scream_idx;
+
 }; // class SurfaceCouplingExporter
 
 } // namespace scream
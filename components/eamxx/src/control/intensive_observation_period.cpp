@@ -9,6 +9,7 @@
 
 #include "pio.h"
 
+#include <map>
 #include <numeric>
 
 // Extend ekat mpi type for <Real,int> pairs,
@@ -68,8 +69,12 @@ void read_dimensionless_variable_from_file(const std::string& filename,
 }
 
 // Read variable with arbitrary number of dimensions from file.
+// IOP data is not partitioned, so only the root rank requests the dofs
+// from PIO, and then broadcasts them to the other ranks. This avoids the
+// PIO rearranger sending the whole variable to every rank.
 template<typename T>
-void read_variable_from_file(const std::string&              filename,
+void read_variable_from_file(const ekat::Comm&               comm,
+                             const std::string&              filename,
                              const std::string&              varname,
                              const std::string&              vartype,
                              const std::vector<std::string>& dimnames,
@@ -86,16 +91,20 @@ void read_variable_from_file(const std::string&              filename,
       data_size *= dim_len;
   }
 
-  // Read into data
+  // Read into data on root rank
+  const int my_size = comm.am_i_root() ? data_size : 0;
   scorpio::register_file(filename, scorpio::FileMode::Read);
-  std::string io_decomp_tag = varname+","+filename;
+  std::string io_decomp_tag = varname+","+filename+",root-only";
   scorpio::register_variable(filename, varname, varname, dimnames, vartype, io_decomp_tag);
-  std::vector<scorpio::offset_t> dof_offsets(data_size);
+  std::vector<scorpio::offset_t> dof_offsets(my_size);
   std::iota(dof_offsets.begin(), dof_offsets.end(), 0);
   scorpio::set_dof(filename, varname, dof_offsets.size(), dof_offsets.data());
   scorpio::set_decomp(filename);
-  scorpio::grid_read_data_array(filename, varname, time_idx, data, data_size);
+  scorpio::grid_read_data_array(filename, varname, time_idx, data, my_size);
   scorpio::eam_pio_closefile(filename);
+
+  // Share with the other ranks
+  comm.broadcast(data, data_size, comm.root_rank());
 }
 }
 
@@ -259,7 +268,7 @@ initialize_iop_file(const util::TimeStamp& run_t0,
   const auto ntimes = scorpio::get_dimlen(iop_file, time_dimname);
   m_time_info.iop_file_times_in_sec =
     decltype(m_time_info.iop_file_times_in_sec)("iop_file_times", ntimes);
-  read_variable_from_file(iop_file, "tsec", "int", {time_dimname}, -1,
+  read_variable_from_file(m_comm, iop_file, "tsec", "int", {time_dimname}, -1,
                           m_time_info.iop_file_times_in_sec.data());
 
   // Check that lat/lon from iop file match the targets in parameters. Note that
@@ -268,8 +277,8 @@ initialize_iop_file(const util::TimeStamp& run_t0,
   const auto nlons = scorpio::get_dimlen(iop_file, "lon");
   EKAT_REQUIRE_MSG(nlats==1 and nlons==1, "Error! IOP data file requires a single lat/lon pair.\n");
   Real iop_file_lat, iop_file_lon;
-  read_variable_from_file(iop_file, "lat", "real", {"lat"}, -1, &iop_file_lat);
-  read_variable_from_file(iop_file, "lon", "real", {"lon"}, -1, &iop_file_lon);
+  read_variable_from_file(m_comm, iop_file, "lat", "real", {"lat"}, -1, &iop_file_lat);
+  read_variable_from_file(m_comm, iop_file, "lon", "real", {"lon"}, -1, &iop_file_lon);
   EKAT_REQUIRE_MSG(iop_file_lat == m_params.get<Real>("target_latitude"),
                   "Error! IOP file variable \"lat\" does not match target_latitude from IOP parameters.\n");
   EKAT_REQUIRE_MSG(std::fmod(iop_file_lon + 360, 360) == m_params.get<Real>("target_longitude"),
@@ -288,7 +297,7 @@ initialize_iop_file(const util::TimeStamp& run_t0,
   Field iop_file_pressure(fid);
   iop_file_pressure.allocate_view();
   auto data = iop_file_pressure.get_view<Real*, Host>().data();
-  read_variable_from_file(iop_file, "lev", "real", {"lev"}, -1, data);
+  read_variable_from_file(m_comm, iop_file, "lev", "real", {"lev"}, -1, data);
   // Convert to pressure to millibar (file gives pressure in Pa)
   for (int ilev=0; ilev<file_levs; ++ilev) data[ilev] /= 100;
   iop_file_pressure.sync_to_dev();
@@ -513,6 +522,24 @@ read_iop_file_data (const util::TimeStamp& current_ts)
   // there is no need to reload data. Return early
   if (iop_file_time_idx == m_time_info.time_idx_of_current_data) return;
 
+  // Keep the file open until all variables are read, rather than
+  // opening and closing it for each variable.
+  scorpio::register_file(iop_file, scorpio::FileMode::Read);
+
+  // Some file variables are used by more than one iop field (e.g., usrf for
+  // u and u_ls, or Ps). Read each of them only once for this time index.
+  std::map<std::string,std::vector<Real>> file_data;
+  auto read_iop_file_var = [&](const std::string& varname,
+                               const std::vector<std::string>& dimnames,
+                               const int size) -> const std::vector<Real>& {
+    auto it = file_data.find(varname);
+    if (it==file_data.end()) {
+      it = file_data.emplace(varname,std::vector<Real>(size)).first;
+      read_variable_from_file(m_comm, iop_file, varname, "real", dimnames, iop_file_time_idx, it->second.data());
+    }
+    return it->second;
+  };
+
   const auto file_levs = scorpio::get_dimlen(iop_file, "lev");
   const auto iop_file_pressure = m_helper_fields["iop_file_pressure"];
   const auto model_pressure = m_helper_fields["model_pressure"];
@@ -536,8 +563,7 @@ read_iop_file_data (const util::TimeStamp& current_ts)
   int model_end;
   if (has_level_data) {
     // Load surface pressure (Ps) from iop file
-    auto ps_data = surface_pressure.get_view<Real, Host>().data();
-    read_variable_from_file(iop_file, "Ps", "real", {"lon","lat"}, iop_file_time_idx, ps_data);
+    surface_pressure.get_view<Real, Host>()() = read_iop_file_var("Ps", {"lon","lat"}, 1)[0];
     surface_pressure.sync_to_dev();
 
     // Pre-process file pressures, store number of file levels
@@ -612,8 +638,7 @@ read_iop_file_data (const util::TimeStamp& current_ts)
 
     if (field.rank()==0) {
       // For scalar data, read iop file variable directly into field data
-      auto data = field.get_view<Real, Host>().data();
-      read_variable_from_file(iop_file, file_varname, "real", {"lon","lat"}, iop_file_time_idx, data);
+      field.get_view<Real, Host>()() = read_iop_file_var(file_varname, {"lon","lat"}, 1)[0];
       field.sync_to_dev();
     } else if (field.rank()==1) {
       // Create temporary fields for reading iop file variables. We use
@@ -628,8 +653,7 @@ read_iop_file_data (const util::TimeStamp& current_ts)
       iop_file_field.allocate_view();
 
       // Read data from iop file.
-      std::vector<Real> data(file_levs);
-      read_variable_from_file(iop_file, file_varname, "real", {"lon","lat","lev"}, iop_file_time_idx, data.data());
+      const auto& data = read_iop_file_var(file_varname, {"lon","lat","lev"}, file_levs);
 
       // Copy first adjusted_file_levs-1 values to field
       auto iop_file_v_h = iop_file_field.get_view<Real*,Host>();
@@ -639,7 +663,7 @@ read_iop_file_data (const util::TimeStamp& current_ts)
       const auto has_srf = m_iop_field_surface_varnames.count(fname)>0;
       if (has_srf) {
         const auto srf_varname = m_iop_field_surface_varnames[fname];
-        read_variable_from_file(iop_file, srf_varname, "real", {"lon","lat"}, iop_file_time_idx, &iop_file_v_h(adjusted_file_levs-1));
+        iop_file_v_h(adjusted_file_levs-1) = read_iop_file_var(srf_varname, {"lon","lat"}, 1)[0];
       } else {
         // No surface value exists, compute surface value
         const auto dx = iop_file_v_h(adjusted_file_levs-2) - iop_file_v_h(adjusted_file_levs-3);
@@ -701,6 +725,8 @@ read_iop_file_data (const util::TimeStamp& current_ts)
     }
   }
 
+  scorpio::eam_pio_closefile(iop_file);
+
   // Now that data is loaded, reset the index of the currently loaded data.
   m_time_info.time_idx_of_current_data = iop_file_time_idx;
 }
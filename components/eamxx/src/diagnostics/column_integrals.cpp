@@ -0,0 +1,208 @@
+#include "diagnostics/column_integrals.hpp"
+#include "physics/share/physics_constants.hpp"
+
+#include <ekat/kokkos/ekat_kokkos_utils.hpp>
+
+#include <set>
+
+namespace scream {
+namespace {
+
+// The sums of all integrals of a column, reduced over the levels at once
+struct ColumnSums {
+  Real v[ColumnIntegralsDiagnostic::max_integrals];
+
+  KOKKOS_INLINE_FUNCTION
+  ColumnSums () {
+    for (int n=0; n<ColumnIntegralsDiagnostic::max_integrals; ++n) {
+      v[n] = 0;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  ColumnSums& operator+= (const ColumnSums& rhs) {
+    for (int n=0; n<ColumnIntegralsDiagnostic::max_integrals; ++n) {
+      v[n] += rhs.v[n];
+    }
+    return *this;
+  }
+};
+
+// The tracer and (for vapor fluxes) wind component of an integral
+void get_integrand (const std::string& name, std::string& qname, int& wind_comp)
+{
+  wind_comp = -1;
+  if (name=="LiqWaterPath") {
+    qname = "qc";
+  } else if (name=="IceWaterPath") {
+    qname = "qi";
+  } else if (name=="RainWaterPath") {
+    qname = "qr";
+  } else if (name=="RimeWaterPath") {
+    qname = "qm";
+  } else if (name=="VapWaterPath") {
+    qname = "qv";
+  } else if (name=="ZonalVapFlux") {
+    qname = "qv";
+    wind_comp = 0;
+  } else if (name=="MeridionalVapFlux") {
+    qname = "qv";
+    wind_comp = 1;
+  } else {
+    EKAT_ERROR_MSG (
+        "Error! Invalid integral in ColumnIntegralsDiagnostic.\n"
+        "  - input value: " + name + "\n"
+        "  - valid values: LiqWaterPath, IceWaterPath, RainWaterPath, RimeWaterPath,\n"
+        "                  VapWaterPath, ZonalVapFlux, MeridionalVapFlux\n");
+  }
+}
+
+} // anonymous namespace
+} // namespace scream
+
+namespace Kokkos {
+template<>
+struct reduction_identity<scream::ColumnSums> {
+  KOKKOS_FORCEINLINE_FUNCTION static scream::ColumnSums sum() { return scream::ColumnSums(); }
+};
+} // namespace Kokkos
+
+namespace scream
+{
+
+ColumnIntegralsDiagnostic::
+ColumnIntegralsDiagnostic (const ekat::Comm& comm, const ekat::ParameterList& params)
+  : AtmosphereDiagnostic(comm,params)
+{
+  EKAT_REQUIRE_MSG (params.isParameter("integrals"),
+      "Error! ColumnIntegralsDiagnostic requires 'integrals' in its input parameters.\n");
+
+  m_integrals = m_params.get<std::vector<std::string>>("integrals");
+  EKAT_REQUIRE_MSG (m_integrals.size()>0 and m_integrals.size()<=max_integrals,
+      "Error! Invalid number of integrals in ColumnIntegralsDiagnostic.\n"
+      "  - num integrals: " + std::to_string(m_integrals.size()) + "\n"
+      "  - max integrals: " + std::to_string(max_integrals) + "\n");
+  std::string qname;
+  int wind_comp;
+  for (const auto& name : m_integrals) {
+    get_integrand(name,qname,wind_comp);
+  }
+}
+
+FieldLayout ColumnIntegralsDiagnostic::
+output_layout (const int num_integrals, const int num_cols)
+{
+  using namespace ShortFieldTagsNames;
+  return FieldLayout ({CMP,COL},{num_integrals,num_cols});
+}
+
+void ColumnIntegralsDiagnostic::
+set_grids(const std::shared_ptr<const GridsManager> grids_manager)
+{
+  using namespace ekat::units;
+  using namespace ShortFieldTagsNames;
+
+  auto Q = kg/kg;
+  Q.set_string("kg/kg");
+
+  auto grid  = grids_manager->get_grid("Physics");
+  const auto& grid_name = grid->name();
+  m_num_cols = grid->get_num_local_dofs(); // Number of columns on this rank
+  m_num_levs = grid->get_num_vertical_levels();  // Number of levels per column
+
+  auto scalar3d = grid->get_3d_scalar_layout(true);
+  auto vector3d = grid->get_3d_vector_layout(true,CMP,2);
+
+  // The fields required for this diagnostic to be computed
+  add_field<Required>("pseudo_density", scalar3d, Pa, grid_name);
+  std::set<std::string> inputs;
+  std::string qname;
+  int wind_comp;
+  for (const auto& name : m_integrals) {
+    get_integrand(name,qname,wind_comp);
+    if (inputs.insert(qname).second) {
+      add_field<Required>(qname, scalar3d, Q, grid_name);
+    }
+    if (wind_comp>=0 and inputs.insert("horiz_winds").second) {
+      add_field<Required>("horiz_winds", vector3d, m/s, grid_name);
+    }
+  }
+
+  // Construct and allocate the diagnostic field. The integrals have different
+  // units, so the field is nondimensional; the diags copying from it carry the units.
+  FieldIdentifier fid (name(), output_layout(m_integrals.size(),m_num_cols),
+                       Units::nondimensional(), grid_name);
+  m_diagnostic_output = Field(fid);
+  m_diagnostic_output.allocate_view();
+}
+
+void ColumnIntegralsDiagnostic::
+initialize_impl (const RunType /*run_type*/)
+{
+  // The input fields don't change, so store their data once
+  const int num_integrals = m_integrals.size();
+  m_integrals_dev = decltype(m_integrals_dev)("column integrals",num_integrals);
+  auto integrals_h = Kokkos::create_mirror_view(m_integrals_dev);
+  std::string qname;
+  int wind_comp;
+  for (int n=0; n<num_integrals; ++n) {
+    get_integrand(m_integrals[n],qname,wind_comp);
+    auto q = get_field_in(qname).get_view<const Real**>();
+    integrals_h(n).q        = q.data();
+    integrals_h(n).q_stride = q.stride(0);
+    if (wind_comp>=0) {
+      auto wind = get_field_in("horiz_winds").get_component(wind_comp).get_view<const Real**>();
+      integrals_h(n).wind        = wind.data();
+      integrals_h(n).wind_stride = wind.stride(0);
+    } else {
+      integrals_h(n).wind        = nullptr;
+      integrals_h(n).wind_stride = 0;
+    }
+  }
+  Kokkos::deep_copy(m_integrals_dev,integrals_h);
+}
+
+void ColumnIntegralsDiagnostic::compute_diagnostic_impl()
+{
+  using PC  = scream::physics::Constants<Real>;
+  using KT  = KokkosTypes<DefaultDevice>;
+  using MT  = typename KT::MemberType;
+  using ESU = ekat::ExeSpaceUtils<typename KT::ExeSpace>;
+
+  constexpr Real g = PC::gravit;
+
+  const auto diag      = m_diagnostic_output.get_view<Real**>();
+  const auto rho       = get_field_in("pseudo_density").get_view<const Real**>();
+  const auto integrals = m_integrals_dev;
+
+  const int num_levs      = m_num_levs;
+  const int num_integrals = m_integrals.size();
+  const auto policy = ESU::get_default_team_policy(m_num_cols, m_num_levs);
+  Kokkos::parallel_for("Compute " + name(), policy,
+                       KOKKOS_LAMBDA(const MT& team) {
+    const int icol = team.league_rank();
+
+    // Read pseudo_density once per level, for all integrals
+    ColumnSums sums;
+    Kokkos::parallel_reduce(Kokkos::TeamVectorRange(team, num_levs),
+                            [&] (const int& ilev, ColumnSums& lsums) {
+      const Real dm = rho(icol,ilev) / g;
+      for (int n=0; n<num_integrals; ++n) {
+        const auto& in = integrals(n);
+        Real val = in.q[icol*in.q_stride + ilev] * dm;
+        if (in.wind!=nullptr) {
+          val *= in.wind[icol*in.wind_stride + ilev];
+        }
+        lsums.v[n] += val;
+      }
+    },Kokkos::Sum<ColumnSums>(sums));
+
+    Kokkos::single(Kokkos::PerTeam(team),[&] {
+      for (int n=0; n<num_integrals; ++n) {
+        diag(n,icol) = sums.v[n];
+      }
+    });
+  });
+}
+
+} //namespace scream
@@ -0,0 +1,66 @@
+#ifndef EAMXX_COLUMN_INTEGRALS_DIAGNOSTIC_HPP
+#define EAMXX_COLUMN_INTEGRALS_DIAGNOSTIC_HPP
+
+#include "share/atm_process/atmosphere_diagnostic.hpp"
+
+namespace scream
+{
+
+/*
+ * This diagnostic computes several vertical integrals of q*pseudo_density/g
+ * (water paths) and u*q*pseudo_density/g (vapor fluxes) in a single pass
+ * over the columns. Its output has layout (CMP,COL), with one component per
+ * integral, in the order of the 'integrals' parameter. The WaterPath and
+ * VaporFlux diagnostics copy their component from it when they are given
+ * the list of integrals that their output stream requests.
+ */
+
+class ColumnIntegralsDiagnostic : public AtmosphereDiagnostic
+{
+public:
+  // Maximum number of integrals computed by one instance
+  static constexpr int max_integrals = 8;
+
+  // Constructors
+  ColumnIntegralsDiagnostic (const ekat::Comm& comm, const ekat::ParameterList& params);
+
+  // Set type to diagnostic
+  AtmosphereProcessType type () const { return AtmosphereProcessType::Diagnostic; }
+
+  // The name of the diagnostic
+  std::string name () const { return "ColumnIntegrals"; }
+
+  // Set the grid
+  void set_grids (const std::shared_ptr<const GridsManager> grids_manager);
+
+  // Layout of the output, for diagnostics that depend on it
+  static FieldLayout output_layout (const int num_integrals, const int num_cols);
+
+  // Description of an integral, as seen by the kernel
+  struct Integral {
+    const Real* q;
+    const Real* wind;       // nullptr for water paths
+    int         q_stride;
+    int         wind_stride;
+  };
+
+protected:
+#ifdef KOKKOS_ENABLE_CUDA
+public:
+#endif
+  void compute_diagnostic_impl ();
+protected:
+  void initialize_impl (const RunType /*run_type*/);
+
+  // Keep track of field dimensions
+  int m_num_cols;
+  int m_num_levs;
+
+  std::vector<std::string> m_integrals;
+
+  KokkosTypes<DefaultDevice>::view_1d<Integral> m_integrals_dev;
+}; // class ColumnIntegralsDiagnostic
+
+} //namespace scream
+
+#endif // EAMXX_COLUMN_INTEGRALS_DIAGNOSTIC_HPP
@@ -47,12 +47,6 @@ void DryStaticEnergyDiagnostic::set_grids(const std::shared_ptr<const GridsManag
   auto& C_ap = m_diagnostic_output.get_header().get_alloc_properties();
   C_ap.request_allocation(ps);
   m_diagnostic_output.allocate_view();
-
-  // Initialize a 2d view of dz to be used in compute_diagnostic
-  const auto npacks     = ekat::npack<Pack>(m_num_levs);
-  const auto npacks_p1  = ekat::npack<Pack>(m_num_levs+1);
-  m_tmp_mid = view_2d("",m_num_cols,npacks);
-  m_tmp_int = view_2d("",m_num_cols,npacks_p1);
 }
 // =========================================================================================
 void DryStaticEnergyDiagnostic::compute_diagnostic_impl()
@@ -74,8 +68,12 @@ void DryStaticEnergyDiagnostic::compute_diagnostic_impl()
   const Real surf_geopotential = 0.0;
 
   const int num_levs = m_num_levs;
-  auto      tmp_mid  = m_tmp_mid;
-  auto      tmp_int  = m_tmp_int;
+
+  // Temporaries for dz/z_mid and z_int, in the diagnostics scratch memory
+  const auto npacks_p1 = ekat::npack<Pack>(m_num_levs+1);
+  auto mem = reinterpret_cast<Pack*>(get_scratch_memory((npacks+npacks_p1)*m_num_cols*Pack::n));
+  const view_2d tmp_mid (mem,m_num_cols,npacks);
+  const view_2d tmp_int (mem+tmp_mid.size(),m_num_cols,npacks_p1);
 
   Kokkos::parallel_for("DryStaticEnergyDiagnostic",
                        default_policy,
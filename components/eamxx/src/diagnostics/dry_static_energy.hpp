@@ -36,10 +36,6 @@ protected:
   Int m_num_cols;
   Int m_num_levs;
 
-  // Temporary view to set dz in compute diagnostic
-  view_2d m_tmp_mid;
-  view_2d m_tmp_int;
-
 }; // class DryStaticEnergyDiagnostic
 
 } //namespace scream
@@ -3,33 +3,6 @@
 #include "ekat/std_meta/ekat_std_utils.hpp"
 #include "ekat/util/ekat_units.hpp"
 
-namespace
-{
-// Find first position in array pointed by [beg,end) that is below z
-// If all z's in array are >=z, return end
-template<typename T>
-KOKKOS_INLINE_FUNCTION
-const T* find_first_smaller_z (const T* beg, const T* end, const T& z)
-{
-  // It's easier to find the last entry that is not smaller than z,
-  // and then we'll return the ptr after that
-  int count = end - beg;
-  while (count>1) {
-    auto mid = beg + count/2 - 1;
-    // if (z>=*mid) {
-    if (*mid>=z) {
-      beg = mid+1;
-    } else {
-      end = mid+1;
-    }
-    count = end - beg;
-  }
-
-  return *beg < z ? beg : end;
-}
-
-} // anonymous namespace
-
 namespace scream
 {
 
@@ -92,6 +65,11 @@ initialize_impl (const RunType /*run_type*/)
   // Figure out the z value
   m_z_name = tag==LEV ? "z_mid" : "z_int";
 
+  // Get the interpolation weights, shared with the other diags at this height
+  using Weights = vinterp::VerticalInterpWeights;
+  m_weights = Weights::get_shared_weights(get_field_in(m_z_name),{m_z},
+                                          Weights::OutOfBounds::Extrapolate);
+
   // All good, create the diag output
   FieldIdentifier d_fid (m_diag_name,layout.strip_dim(tag),fid.get_units(),fid.get_grid_name());
   m_diagnostic_output = Field(d_fid);
@@ -111,77 +89,10 @@ initialize_impl (const RunType /*run_type*/)
 // =========================================================================================
 void FieldAtHeight::compute_diagnostic_impl()
 {
-  const auto z_view = get_field_in(m_z_name).get_view<const Real**>();
-  const Field& f = get_field_in(m_field_name);
-  const auto& fl = f.get_header().get_identifier().get_layout();
-
-  using RangePolicy = typename KokkosTypes<DefaultDevice>::RangePolicy;
-
-  auto z_tgt = m_z;
-  auto nlevs = fl.dims().back();
-  if (fl.rank()==2) {
-    const auto f_view = f.get_view<const Real**>();
-    const auto d_view = m_diagnostic_output.get_view<Real*>();
-
-    RangePolicy policy (0,fl.dims()[0]);
-    Kokkos::parallel_for(policy,
-        KOKKOS_LAMBDA(const int i) {
-        auto f_i = ekat::subview(f_view,i);
-        auto z_i = ekat::subview(z_view,i);
-
-        auto beg = z_i.data();
-        auto end = beg+nlevs;
-        auto it = find_first_smaller_z(beg,end,z_tgt);
-        if (it==beg) {
-          // We just extapolate with first entry
-          d_view(i) = f_i(0);
-        } else if (it==end) {
-          // We just extapolate with last entry
-          d_view(i) = f_i(nlevs-1);
-        } else {
-          auto pos = it-beg;
-          auto z0 = z_i(pos-1);
-          auto z1 = z_i(pos);
-          auto f0 = f_i(pos-1);
-          auto f1 = f_i(pos);
-
-          d_view(i) = ( (z_tgt-z0)*f1 + (z1-z_tgt)*f0 ) / (z1-z0);
-        }
-    });
-  } else {
-    const auto f_view = f.get_view<const Real***>();
-    const auto d_view = m_diagnostic_output.get_view<Real**>();
-
-    const auto dim0 = fl.dims()[0];
-    const auto dim1 = fl.dims()[1];
-    RangePolicy policy (0,dim0*dim1);
-    Kokkos::parallel_for(policy,
-        KOKKOS_LAMBDA(const int idx) {
-        const int i = idx / dim1;
-        const int j = idx % dim1;
-        auto f_ij = ekat::subview(f_view,i,j);
-        auto z_i  = ekat::subview(z_view,i);
-
-        auto beg = z_i.data();
-        auto end = beg+nlevs;
-        auto it = find_first_smaller_z(beg,end,z_tgt);
-        if (it==beg) {
-          // We just extapolate with first entry
-          d_view(i,j) = f_ij(0);
-        } else if (it==end) {
-          // We just extapolate with last entry
-          d_view(i,j) = f_ij(nlevs-1);
-        } else {
-          auto pos = it-beg;
-          auto z0 = z_i(pos-1);
-          auto z1 = z_i(pos);
-          auto f0 = f_ij(pos-1);
-          auto f1 = f_ij(pos);
-
-          d_view(i,j) = ( (z_tgt-z0)*f1 + (z1-z_tgt)*f0 ) / (z1-z0);
-        }
-    });
-  }
+  // Weights are recomputed only if z changed since another diag computed them
+  m_weights->compute(get_field_in(m_z_name));
+
+  m_weights->apply({get_field_in(m_field_name)},{m_diagnostic_output},0);
 }
 
 } //namespace scream
@@ -2,12 +2,17 @@
 #define EAMXX_FIELD_AT_HEIGHT_HPP
 
 #include "share/atm_process/atmosphere_diagnostic.hpp"
+#include "share/util/eamxx_vertical_interp_weights.hpp"
 
 namespace scream
 {
 
 /*
  * This diagnostic will produce a slice of a field at a given height (above surface)
+ *
+ * Values above (below) the top (bottom) level are extrapolated with the value at
+ * the top (bottom) level. Like FieldAtPressureLevel, the interpolation weights are
+ * shared with the other diagnostics at the same height.
  */
 
 class FieldAtHeight : public AtmosphereDiagnostic
@@ -35,6 +40,8 @@ protected:
   std::string         m_z_name;
   std::string         m_field_name;
 
+  std::shared_ptr<vinterp::VerticalInterpWeights> m_weights;
+
   Real                m_z;
 };
 
@@ -2,26 +2,23 @@
 #define EAMXX_FIELD_AT_PRESSURE_LEVEL_HPP
 
 #include "share/atm_process/atmosphere_diagnostic.hpp"
-
-#include <ekat/ekat_pack.hpp>
+#include "share/util/eamxx_vertical_interp_weights.hpp"
 
 namespace scream
 {
 
 /*
  * This diagnostic will produce a slice of a field at a given pressure level
+ *
+ * The interpolation weights are shared by all the diagnostics at the same
+ * pressure level, so that the bracketing of the pressure level is done only
+ * once per column per time step.
  */
 
 class FieldAtPressureLevel : public AtmosphereDiagnostic
 {
 public:
 
-  using KT = KokkosTypes<DefaultDevice>;
-  template <typename S>
-  using view_1d = typename KT::template view_1d<S>;
-  template <typename S>
-  using view_2d = typename KT::template view_2d<S>;
-
   // Constructors
   FieldAtPressureLevel (const ekat::Comm& comm, const ekat::ParameterList& params);
 
@@ -39,16 +36,14 @@ public:
 protected:
   void initialize_impl (const RunType /*run_type*/);
 
-  using Pack1 = ekat::Pack<Real,1>;
+  using weights_ptr = std::shared_ptr<vinterp::VerticalInterpWeights>;
 
   std::string         m_pressure_name;
   std::string         m_field_name;
   std::string         m_diag_name;
 
-  view_1d<Pack1>      m_p_tgt;
-  Field               m_mask_field;
+  weights_ptr         m_weights;
   Real                m_pressure_level;
-  int                 m_num_levs;
   Real                m_mask_val;
 
 }; // class FieldAtPressureLevel
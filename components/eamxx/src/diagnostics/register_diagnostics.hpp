@@ -16,6 +16,7 @@
 #include "diagnostics/longwave_cloud_forcing.hpp"
 #include "diagnostics/relative_humidity.hpp"
 #include "diagnostics/vapor_flux.hpp"
+#include "diagnostics/column_integrals.hpp"
 #include "diagnostics/field_at_pressure_level.hpp"
 #include "diagnostics/precip_surf_mass_flux.hpp"
 #include "diagnostics/surf_upward_latent_heat_flux.hpp"
@@ -43,6 +44,7 @@ inline void register_diagnostics () {
   diag_factory.register_product("LongwaveCloudForcing",&create_atmosphere_diagnostic<LongwaveCloudForcingDiagnostic>);
   diag_factory.register_product("RelativeHumidity",&create_atmosphere_diagnostic<RelativeHumidityDiagnostic>);
   diag_factory.register_product("VaporFlux",&create_atmosphere_diagnostic<VaporFluxDiagnostic>);
+  diag_factory.register_product("ColumnIntegrals",&create_atmosphere_diagnostic<ColumnIntegralsDiagnostic>);
   diag_factory.register_product("precip_surf_mass_flux",&create_atmosphere_diagnostic<PrecipSurfMassFlux>);
   diag_factory.register_product("surface_upward_latent_heat_flux",&create_atmosphere_diagnostic<SurfaceUpwardLatentHeatFlux>);
 }
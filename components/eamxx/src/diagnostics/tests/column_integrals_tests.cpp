@@ -0,0 +1,145 @@
+#include "catch2/catch.hpp"
+
+#include "share/grid/mesh_free_grids_manager.hpp"
+#include "diagnostics/register_diagnostics.hpp"
+
+#include "physics/share/physics_constants.hpp"
+
+#include "share/util/scream_setup_random_test.hpp"
+#include "share/field/field_utils.hpp"
+
+#include "ekat/util/ekat_test_utils.hpp"
+#include "ekat/util/ekat_string_utils.hpp"
+
+namespace scream {
+
+std::shared_ptr<GridsManager>
+create_gm (const ekat::Comm& comm, const int ncols, const int nlevs) {
+
+  const int num_global_cols = ncols*comm.size();
+
+  using vos_t = std::vector<std::string>;
+  ekat::ParameterList gm_params;
+  gm_params.set("grids_names",vos_t{"Point Grid"});
+  auto& pl = gm_params.sublist("Point Grid");
+  pl.set<std::string>("type","point_grid");
+  pl.set("aliases",vos_t{"Physics"});
+  pl.set<int>("number_of_global_columns", num_global_cols);
+  pl.set<int>("number_of_vertical_levels", nlevs);
+
+  auto gm = create_mesh_free_grids_manager(comm,gm_params);
+  gm->build_grids();
+
+  return gm;
+}
+
+// Create a WaterPath or VaporFlux diag for the given integral name
+std::shared_ptr<AtmosphereDiagnostic>
+create_integral_diag (const ekat::Comm& comm, const std::string& name,
+                      const std::vector<std::string>& column_integrals)
+{
+  auto& diag_factory = AtmosphereDiagnosticFactory::instance();
+  ekat::ParameterList params;
+  if (not column_integrals.empty()) {
+    params.set("column_integrals",column_integrals);
+  }
+  if (name.find("WaterPath")!=std::string::npos) {
+    params.set<std::string>("Water Kind",ekat::split(name,"WaterPath").front());
+    return diag_factory.create("WaterPath",comm,params);
+  } else {
+    params.set<std::string>("Wind Component",ekat::split(name,"VapFlux").front());
+    return diag_factory.create("VaporFlux",comm,params);
+  }
+}
+
+//-----------------------------------------------------------------------------------------------//
+TEST_CASE("column_integrals_test", "[column_integrals_test]")
+{
+  using PC = scream::physics::Constants<Real>;
+
+  constexpr int num_levs = 33;
+  constexpr int ncols    = 5;
+  constexpr Real tol     = 1000*PC::macheps;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  auto gm = create_gm(comm,ncols,num_levs);
+  auto engine = scream::setup_random_test();
+  util::TimeStamp t0 ({2022,1,1},{0,0,0});
+
+  register_diagnostics();
+
+  const std::vector<std::string> integrals = {
+    "LiqWaterPath", "IceWaterPath", "RainWaterPath", "RimeWaterPath",
+    "VapWaterPath", "ZonalVapFlux", "MeridionalVapFlux"
+  };
+
+  // Bad inputs
+  auto& diag_factory = AtmosphereDiagnosticFactory::instance();
+  ekat::ParameterList params;
+  REQUIRE_THROWS (diag_factory.create("ColumnIntegrals",comm,params)); // No 'integrals'
+  params.set("integrals",std::vector<std::string>{"Foo"});
+  REQUIRE_THROWS (diag_factory.create("ColumnIntegrals",comm,params)); // Invalid integral
+  REQUIRE_THROWS (create_integral_diag(comm,"LiqWaterPath",{"IceWaterPath"})); // Not in the list
+
+  // The diag computing all integrals at once, and the diags copying from it
+  params.set("integrals",integrals);
+  auto col_int = diag_factory.create("ColumnIntegrals",comm,params);
+  col_int->set_grids(gm);
+  std::map<std::string,std::shared_ptr<AtmosphereDiagnostic>> batched, single;
+  for (const auto& name : integrals) {
+    batched[name] = create_integral_diag(comm,name,integrals);
+    batched[name]->set_grids(gm);
+    single[name] = create_integral_diag(comm,name,{});
+    single[name]->set_grids(gm);
+  }
+
+  // Random inputs
+  using RPDF = std::uniform_real_distribution<Real>;
+  std::map<std::string,Field> input_fields;
+  auto set_inputs = [&](const std::shared_ptr<AtmosphereDiagnostic>& diag) {
+    for (const auto& req : diag->get_required_field_requests()) {
+      const auto& name = req.fid.name();
+      if (input_fields.count(name)==0) {
+        Field f(req.fid);
+        f.allocate_view();
+        randomize(f,engine,RPDF(0.1,10.0));
+        f.get_header().get_tracking().update_time_stamp(t0);
+        input_fields.emplace(name,f);
+      }
+      diag->set_required_field(input_fields.at(name).get_const());
+    }
+    diag->initialize(t0,RunType::Initial);
+  };
+  set_inputs(col_int);
+  input_fields.emplace(col_int->get_diagnostic().name(),col_int->get_diagnostic());
+  for (const auto& name : integrals) {
+    set_inputs(single[name]);
+    set_inputs(batched[name]);
+  }
+  REQUIRE (batched["LiqWaterPath"]->get_required_field_requests().size()==1);
+
+  // The integrals computed in one pass must match the ones computed separately
+  col_int->compute_diagnostic();
+  for (const auto& name : integrals) {
+    single[name]->compute_diagnostic();
+    batched[name]->compute_diagnostic();
+
+    auto f1 = single[name]->get_diagnostic();
+    auto f2 = batched[name]->get_diagnostic();
+    f1.sync_to_host();
+    f2.sync_to_host();
+    auto v1 = f1.get_view<const Real*,Host>();
+    auto v2 = f2.get_view<const Real*,Host>();
+    for (int icol=0; icol<ncols; ++icol) {
+      REQUIRE (std::abs(v1(icol)-v2(icol)) <= tol*std::abs(v1(icol)));
+    }
+  }
+
+  col_int->finalize();
+  for (const auto& name : integrals) {
+    single[name]->finalize();
+    batched[name]->finalize();
+  }
+}
+
+} // namespace scream
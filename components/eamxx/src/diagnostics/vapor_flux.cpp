@@ -1,8 +1,11 @@
 #include "diagnostics/vapor_flux.hpp"
+#include "diagnostics/column_integrals.hpp"
 #include "physics/share/physics_constants.hpp"
 
 #include <ekat/kokkos/ekat_kokkos_utils.hpp>
 
+#include <algorithm>
+
 namespace scream
 {
 
@@ -24,6 +27,16 @@ VaporFluxDiagnostic (const ekat::Comm& comm, const ekat::ParameterList& params)
         "  - input value: " + comp + "\n"
         "  - valid values: Zonal, Meridional\n");
   }
+
+  // If the output stream computes several column integrals together, we
+  // simply copy ours from them
+  if (params.isParameter("column_integrals")) {
+    m_column_integrals = m_params.get<std::vector<std::string>>("column_integrals");
+    auto it = std::find(m_column_integrals.begin(),m_column_integrals.end(),name());
+    EKAT_REQUIRE_MSG (it!=m_column_integrals.end(),
+        "Error! The 'column_integrals' parameter does not contain " + name() + ".\n");
+    m_integral_idx = std::distance(m_column_integrals.begin(),it);
+  }
 }
 
 std::string VaporFluxDiagnostic::name() const
@@ -52,9 +65,15 @@ void VaporFluxDiagnostic::set_grids(const std::shared_ptr<const GridsManager> gr
   auto vector3d = grid->get_3d_vector_layout(true,CMP,2);
 
   // The fields required for this diagnostic to be computed
-  add_field<Required>("pseudo_density", scalar3d, Pa,  grid_name);
-  add_field<Required>("qv",             scalar3d, Q,   grid_name);
-  add_field<Required>("horiz_winds",    vector3d, m/s, grid_name);
+  if (m_integral_idx>=0) {
+    add_field<Required>("ColumnIntegrals",
+                        ColumnIntegralsDiagnostic::output_layout(m_column_integrals.size(),m_num_cols),
+                        Units::nondimensional(), grid_name);
+  } else {
+    add_field<Required>("pseudo_density", scalar3d, Pa,  grid_name);
+    add_field<Required>("qv",             scalar3d, Q,   grid_name);
+    add_field<Required>("horiz_winds",    vector3d, m/s, grid_name);
+  }
 
   // Construct and allocate the diagnostic field
   FieldIdentifier fid (name(), scalar2d, kg/m/s, grid_name);
@@ -72,6 +91,12 @@ void VaporFluxDiagnostic::compute_diagnostic_impl()
   constexpr Real g = PC::gravit;
 
   const auto diag  = m_diagnostic_output.get_view<Real*>();
+  if (m_integral_idx>=0) {
+    const auto integrals = get_field_in("ColumnIntegrals").get_view<const Real**>();
+    Kokkos::deep_copy(diag,ekat::subview(integrals,m_integral_idx));
+    return;
+  }
+
   const auto qv    = get_field_in("qv").get_view<const Real**>();
   const auto rho   = get_field_in("pseudo_density").get_view<const Real**>();
   const auto wind  = get_field_in("horiz_winds").get_component(m_component).get_view<const Real**>();
@@ -37,6 +37,11 @@ protected:
   int m_num_levs;
 
   int m_component;
+
+  // If set, the integral is copied from the ColumnIntegrals diagnostic,
+  // which computes all the column integrals of the output stream at once
+  std::vector<std::string> m_column_integrals;
+  int m_integral_idx = -1;
 };
 
 } //namespace scream
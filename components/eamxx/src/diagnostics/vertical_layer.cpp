@@ -62,17 +62,6 @@ set_grids(const std::shared_ptr<const GridsManager> grids_manager)
   auto& C_ap = m_diagnostic_output.get_header().get_alloc_properties();
   C_ap.request_allocation(ps);
   m_diagnostic_output.allocate_view();
-
-  // Initialize temporary views based on need.
-  if (not m_only_compute_dz) {
-    if (m_is_interface_layout) {
-      const auto npacks = ekat::npack<Pack>(m_num_levs);
-      m_tmp_midpoint_view = view_2d("tmp_mid",m_num_cols,npacks);
-    } else {
-      const auto npacks_p1 = ekat::npack<Pack>(m_num_levs+1);
-      m_tmp_interface_view = view_2d("tmp_int",m_num_cols,npacks_p1);
-    }
-  }
 }
 // =========================================================================================
 void VerticalLayerDiagnostic::compute_diagnostic_impl()
@@ -102,10 +91,13 @@ void VerticalLayerDiagnostic::compute_diagnostic_impl()
     midpoint_view  = m_diagnostic_output.get_view<Pack**>();
   } else if (is_interface_layout) {
     interface_view = m_diagnostic_output.get_view<Pack**>();
-    midpoint_view  = m_tmp_midpoint_view;
+    auto mem = reinterpret_cast<Pack*>(get_scratch_memory(npacks*m_num_cols*Pack::n));
+    midpoint_view  = view_2d(mem,m_num_cols,npacks);
   } else {
+    const auto npacks_p1 = ekat::npack<Pack>(m_num_levs+1);
+    auto mem = reinterpret_cast<Pack*>(get_scratch_memory(npacks_p1*m_num_cols*Pack::n));
     midpoint_view  = m_diagnostic_output.get_view<Pack**>();
-    interface_view = m_tmp_interface_view;
+    interface_view = view_2d(mem,m_num_cols,npacks_p1);
   }
 
   Kokkos::parallel_for("VerticalLayerDiagnostic",
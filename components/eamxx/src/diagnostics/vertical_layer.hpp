@@ -52,10 +52,6 @@ protected:
   Int m_num_cols;
   Int m_num_levs;
 
-  // Temporary view to set dz, z_mid, and z_int
-  view_2d m_tmp_interface_view;
-  view_2d m_tmp_midpoint_view;
-
   // The diagnostic name. This will dictate which
   // field in the computation is output (dz, z_int, or z_mid).
   std::string m_diag_name;
@@ -1,8 +1,11 @@
 #include "diagnostics/water_path.hpp"
+#include "diagnostics/column_integrals.hpp"
 #include "physics/share/physics_constants.hpp"
 
 #include <ekat/kokkos/ekat_kokkos_utils.hpp>
 
+#include <algorithm>
+
 namespace scream
 {
 
@@ -30,6 +33,16 @@ WaterPathDiagnostic (const ekat::Comm& comm, const ekat::ParameterList& params)
         "  - input value: " + m_kind + "\n"
         "  - valid values: Liq, Ice, Rain, Rime, Vap\n");
   }
+
+  // If the output stream computes several column integrals together, we
+  // simply copy ours from them
+  if (params.isParameter("column_integrals")) {
+    m_column_integrals = m_params.get<std::vector<std::string>>("column_integrals");
+    auto it = std::find(m_column_integrals.begin(),m_column_integrals.end(),name());
+    EKAT_REQUIRE_MSG (it!=m_column_integrals.end(),
+        "Error! The 'column_integrals' parameter does not contain " + name() + ".\n");
+    m_integral_idx = std::distance(m_column_integrals.begin(),it);
+  }
 }
 
 std::string WaterPathDiagnostic::name() const
@@ -55,8 +68,14 @@ set_grids(const std::shared_ptr<const GridsManager> grids_manager)
   auto scalar3d = grid->get_3d_scalar_layout(true);
 
   // The fields required for this diagnostic to be computed
-  add_field<Required>("pseudo_density", scalar3d, Pa, grid_name);
-  add_field<Required>(m_qname,          scalar3d, Q,  grid_name);
+  if (m_integral_idx>=0) {
+    add_field<Required>("ColumnIntegrals",
+                        ColumnIntegralsDiagnostic::output_layout(m_column_integrals.size(),m_num_cols),
+                        Units::nondimensional(), grid_name);
+  } else {
+    add_field<Required>("pseudo_density", scalar3d, Pa, grid_name);
+    add_field<Required>(m_qname,          scalar3d, Q,  grid_name);
+  }
 
   // Construct and allocate the diagnostic field
   FieldIdentifier fid (name(), scalar2d, kg/m2, grid_name);
@@ -74,6 +93,12 @@ void WaterPathDiagnostic::compute_diagnostic_impl()
   constexpr Real g = PC::gravit;
 
   const auto wp     = m_diagnostic_output.get_view<Real*>();
+  if (m_integral_idx>=0) {
+    const auto integrals = get_field_in("ColumnIntegrals").get_view<const Real**>();
+    Kokkos::deep_copy(wp,ekat::subview(integrals,m_integral_idx));
+    return;
+  }
+
   const auto q      = get_field_in(m_qname).get_view<const Real**>();
   const auto rho    = get_field_in("pseudo_density").get_view<const Real**>();
 
@@ -38,6 +38,11 @@ protected:
 
   std::string m_qname;
   std::string m_kind;
+
+  // If set, the integral is copied from the ColumnIntegrals diagnostic,
+  // which computes all the column integrals of the output stream at once
+  std::vector<std::string> m_column_integrals;
+  int m_integral_idx = -1;
 }; // class WaterPathDiagnostic
 
 } //namespace scream
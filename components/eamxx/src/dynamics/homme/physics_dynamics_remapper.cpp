@@ -340,7 +340,7 @@ KOKKOS_FUNCTION
 void PhysicsDynamicsRemapper::
 set_dyn_to_zero(const MT& team) const
 {
-  const int i = team.league_rank();
+  const int i = m_fwd_first_field + team.league_rank();
 
   switch (m_layout(i)) {
     case etoi(LayoutType::Scalar2D):
@@ -432,13 +432,25 @@ do_remap_fwd()
 #endif
 
 
-  // TeamPolicy over this->m_num_fields
-  const TeamPolicy policy(this->m_num_fields,team_size);
-  Kokkos::parallel_for(policy, *this);
-  Kokkos::fence();
+  // For each group of fields, remap, then start exchanging the element halo,
+  // so that the messages are in flight while we remap the next group.
+  const int num_groups = m_be.size();
+  for (int g=0; g<num_groups; ++g) {
+    m_fwd_first_field = m_be_fields_beg[g];
+
+    // TeamPolicy over the fields of this group
+    const TeamPolicy policy(m_be_fields_beg[g+1]-m_be_fields_beg[g],team_size);
+    Kokkos::parallel_for(policy, *this);
+    Kokkos::fence();
+
+    m_be[g]->pack_and_send();
+  }
+  m_fwd_first_field = 0;
 
-  // Exchange element halo
-  m_be->exchange();
+  // Complete the exchanges
+  for (auto& be : m_be) {
+    be->recv_and_unpack();
+  }
 }
 
 void PhysicsDynamicsRemapper::
@@ -473,43 +485,6 @@ setup_boundary_exchange () {
 
   using Scalar = Homme::Scalar;
 
-  int num_2d = 0;
-  int num_3d_mid = 0;
-  int num_3d_int = 0;
-  for (int i=0; i<this->m_num_fields; ++i) {
-    const auto& layout = m_dyn_fields[i].get_header().get_identifier().get_layout();
-    const auto lt = get_layout_type(layout.tags());
-    switch (lt) {
-      case LayoutType::Scalar2D:
-        ++num_2d;
-        break;
-      case LayoutType::Vector2D:
-        num_2d += layout.dim(1);
-        break;
-      case LayoutType::Scalar3D:
-        if (layout.dims().back()==HOMMEXX_NUM_PHYSICAL_LEV) {
-          ++num_3d_mid;
-        } else if (layout.dims().back()==HOMMEXX_NUM_INTERFACE_LEV) {
-          ++num_3d_int;
-        } else {
-          EKAT_ERROR_MSG ("Error! Unexpected vertical level extent.\n");
-        }
-        break;
-      case LayoutType::Vector3D:
-        // A vector field (not a state): remap all components
-        if (layout.dims().back()==HOMMEXX_NUM_PHYSICAL_LEV) {
-          num_3d_mid += layout.dim(1);
-        } else if (layout.dims().back()==HOMMEXX_NUM_INTERFACE_LEV) {
-          num_3d_int += layout.dim(1);
-        } else {
-          EKAT_ERROR_MSG ("Error! Unexpected vertical level extent.\n");
-        }
-        break;
-    default:
-      EKAT_ERROR_MSG("Error! Invalid layout. This is an internal error. Please, contact developers\n");
-    }
-  }
-
   // Make sure stuff is created in the context first
   c.create_if_not_there<Homme::MpiBuffersManagerMap>();
 
@@ -521,40 +496,100 @@ setup_boundary_exchange () {
 
   constexpr int NLEV = HOMMEXX_NUM_LEV;
   constexpr int NINT = HOMMEXX_NUM_LEV_P;
-  m_be = std::make_shared<Homme::BoundaryExchange>(conn,bm);
-  m_be->set_num_fields(0,num_2d,num_3d_mid,num_3d_int);
 
-  // If some fields are already bound, set them in the bd exchange
-  for (int i=0; i<this->m_num_fields; ++i) {
-    const auto& layout = m_dyn_fields[i].get_header().get_identifier().get_layout();
-    const auto& dims = layout.dims();
-    const auto lt = get_layout_type(layout.tags());
-    switch (lt) {
-      case LayoutType::Scalar2D:
-        m_be->register_field(getHommeView<Real*[NP][NP]>(m_dyn_fields[i]));
-        break;
-      case LayoutType::Vector2D:
-        m_be->register_field(getHommeView<Real**[NP][NP]>(m_dyn_fields[i]),dims[1],0);
-        break;
-      case LayoutType::Scalar3D:
-        if (dims.back()==HOMMEXX_NUM_PHYSICAL_LEV) {
-          m_be->register_field(getHommeView<Scalar*[NP][NP][NLEV]>(m_dyn_fields[i]));
-        } else {
-          m_be->register_field(getHommeView<Scalar*[NP][NP][NINT]>(m_dyn_fields[i]));
-        }
-        break;
-      case LayoutType::Vector3D:
-        if (dims.back()==HOMMEXX_NUM_PHYSICAL_LEV) {
-          m_be->register_field(getHommeView<Scalar**[NP][NP][NLEV]>(m_dyn_fields[i]),dims[1],0);
-        } else {
-          m_be->register_field(getHommeView<Scalar**[NP][NP][NINT]>(m_dyn_fields[i]),dims[1],0);
-        }
-        break;
-    default:
-      EKAT_ERROR_MSG("Error! Invalid layout. This is an internal error. Please, contact developers\n");
+  // Create a BE for the dyn fields in [beg,end)
+  auto create_be = [&](const int beg, const int end,
+                       const std::shared_ptr<Homme::MpiBuffersManager>& buffers) {
+    int num_2d = 0;
+    int num_3d_mid = 0;
+    int num_3d_int = 0;
+    for (int i=beg; i<end; ++i) {
+      const auto& layout = m_dyn_fields[i].get_header().get_identifier().get_layout();
+      const auto lt = get_layout_type(layout.tags());
+      switch (lt) {
+        case LayoutType::Scalar2D:
+          ++num_2d;
+          break;
+        case LayoutType::Vector2D:
+          num_2d += layout.dim(1);
+          break;
+        case LayoutType::Scalar3D:
+          if (layout.dims().back()==HOMMEXX_NUM_PHYSICAL_LEV) {
+            ++num_3d_mid;
+          } else if (layout.dims().back()==HOMMEXX_NUM_INTERFACE_LEV) {
+            ++num_3d_int;
+          } else {
+            EKAT_ERROR_MSG ("Error! Unexpected vertical level extent.\n");
+          }
+          break;
+        case LayoutType::Vector3D:
+          // A vector field (not a state): remap all components
+          if (layout.dims().back()==HOMMEXX_NUM_PHYSICAL_LEV) {
+            num_3d_mid += layout.dim(1);
+          } else if (layout.dims().back()==HOMMEXX_NUM_INTERFACE_LEV) {
+            num_3d_int += layout.dim(1);
+          } else {
+            EKAT_ERROR_MSG ("Error! Unexpected vertical level extent.\n");
+          }
+          break;
+      default:
+        EKAT_ERROR_MSG("Error! Invalid layout. This is an internal error. Please, contact developers\n");
+      }
     }
+
+    auto be = std::make_shared<Homme::BoundaryExchange>(conn,buffers);
+    be->set_num_fields(0,num_2d,num_3d_mid,num_3d_int);
+
+    // If some fields are already bound, set them in the bd exchange
+    for (int i=beg; i<end; ++i) {
+      const auto& layout = m_dyn_fields[i].get_header().get_identifier().get_layout();
+      const auto& dims = layout.dims();
+      const auto lt = get_layout_type(layout.tags());
+      switch (lt) {
+        case LayoutType::Scalar2D:
+          be->register_field(getHommeView<Real*[NP][NP]>(m_dyn_fields[i]));
+          break;
+        case LayoutType::Vector2D:
+          be->register_field(getHommeView<Real**[NP][NP]>(m_dyn_fields[i]),dims[1],0);
+          break;
+        case LayoutType::Scalar3D:
+          if (dims.back()==HOMMEXX_NUM_PHYSICAL_LEV) {
+            be->register_field(getHommeView<Scalar*[NP][NP][NLEV]>(m_dyn_fields[i]));
+          } else {
+            be->register_field(getHommeView<Scalar*[NP][NP][NINT]>(m_dyn_fields[i]));
+          }
+          break;
+        case LayoutType::Vector3D:
+          if (dims.back()==HOMMEXX_NUM_PHYSICAL_LEV) {
+            be->register_field(getHommeView<Scalar**[NP][NP][NLEV]>(m_dyn_fields[i]),dims[1],0);
+          } else {
+            be->register_field(getHommeView<Scalar**[NP][NP][NINT]>(m_dyn_fields[i]),dims[1],0);
+          }
+          break;
+      default:
+        EKAT_ERROR_MSG("Error! Invalid layout. This is an internal error. Please, contact developers\n");
+      }
+    }
+    be->registration_completed();
+    return be;
+  };
+
+  // With 2+ fields, use two groups: the first uses Homme's shared MPI buffers,
+  // while the second needs its own, since both exchanges are in flight together.
+  m_be.clear();
+  m_be_buffers.clear();
+  m_be_fields_beg.clear();
+  m_be_fields_beg.push_back(0);
+  if (this->m_num_fields>=2) {
+    const int half = this->m_num_fields / 2;
+    m_be_buffers.push_back(std::make_shared<Homme::MpiBuffersManager>(conn));
+    m_be.push_back(create_be(0,half,bm));
+    m_be.push_back(create_be(half,this->m_num_fields,m_be_buffers.back()));
+    m_be_fields_beg.push_back(half);
+  } else {
+    m_be.push_back(create_be(0,this->m_num_fields,bm));
   }
-  m_be->registration_completed();
+  m_be_fields_beg.push_back(this->m_num_fields);
 }
 
 template <typename MT>
@@ -562,7 +597,7 @@ KOKKOS_FUNCTION
 void PhysicsDynamicsRemapper::
 local_remap_fwd_2d (const MT& team) const
 {
-  const int i = team.league_rank();
+  const int i = m_fwd_first_field + team.league_rank();
 
   switch (m_layout(i)) {
     case etoi(LayoutType::Scalar2D):
@@ -572,7 +607,7 @@ local_remap_fwd_2d (const MT& team) const
 
       const auto tr = Kokkos::TeamVectorRange(team, m_num_phys_cols);
       const auto f = [&] (const int icol) {
-        const auto& elgp = Kokkos::subview(m_lid2elgp,m_p2d(icol),Kokkos::ALL());
+        const auto& elgp = Kokkos::subview(m_p2d,icol,Kokkos::ALL());
         dyn(elgp[0],elgp[1],elgp[2]) = phys(icol);
       };
       Kokkos::parallel_for(tr, f);
@@ -589,7 +624,7 @@ local_remap_fwd_2d (const MT& team) const
         const int icol = idx / vec_dim;
         const int idim = idx % vec_dim;
 
-        const auto& elgp = Kokkos::subview(m_lid2elgp,m_p2d(icol),Kokkos::ALL());
+        const auto& elgp = Kokkos::subview(m_p2d,icol,Kokkos::ALL());
         dyn(elgp[0],idim,elgp[1],elgp[2]) = phys(icol,idim);
       };
       Kokkos::parallel_for(tr, f);
@@ -605,7 +640,7 @@ KOKKOS_FUNCTION
 void PhysicsDynamicsRemapper::
 local_remap_fwd_3d (const MT& team) const
 {
-  const int i = team.league_rank();
+  const int i = m_fwd_first_field + team.league_rank();
 
   constexpr int PackSize = sizeof(ScalarT) / sizeof(Real);
   using PI = ekat::PackInfo<PackSize>;
@@ -622,7 +657,7 @@ local_remap_fwd_3d (const MT& team) const
         const int icol = idx / num_packs;
         const int ilev = idx % num_packs;
 
-        const auto& elgp = Kokkos::subview(m_lid2elgp,m_p2d(icol),Kokkos::ALL());
+        const auto& elgp = Kokkos::subview(m_p2d,icol,Kokkos::ALL());
         dyn(elgp[0],elgp[1],elgp[2],ilev) = phys(icol,ilev);
       };
       Kokkos::parallel_for(tr, f);
@@ -640,7 +675,7 @@ local_remap_fwd_3d (const MT& team) const
         const int idim = (idx / num_packs) % vec_dim;
         const int ilev =  idx % num_packs;
 
-        const auto& elgp = Kokkos::subview(m_lid2elgp,m_p2d(icol),Kokkos::ALL());
+        const auto& elgp = Kokkos::subview(m_p2d,icol,Kokkos::ALL());
         dyn(elgp[0],idim,elgp[1],elgp[2],ilev) = phys(icol,idim,ilev);
       };
       Kokkos::parallel_for(tr, f);
@@ -659,7 +694,7 @@ local_remap_bwd_2d (const MT& team) const
   const int rank = team.league_rank();
   const int i    = rank % this->m_num_fields;
   const int icol = rank / this->m_num_fields;
-  const auto& elgp = Kokkos::subview(m_lid2elgp,m_p2d(icol),Kokkos::ALL());
+  const auto& elgp = Kokkos::subview(m_p2d,icol,Kokkos::ALL());
 
   switch (m_layout(i)) {
     case etoi(LayoutType::Scalar2D):
@@ -696,7 +731,7 @@ local_remap_bwd_3d (const MT& team) const
   const int rank = team.league_rank();
   const int i    = rank % this->m_num_fields;
   const int icol = rank / this->m_num_fields;
-  const auto& elgp = Kokkos::subview(m_lid2elgp,m_p2d(icol),Kokkos::ALL());
+  const auto& elgp = Kokkos::subview(m_p2d,icol,Kokkos::ALL());
 
   constexpr int PackSize = sizeof(ScalarT) / sizeof(Real);
   using PI = ekat::PackInfo<PackSize>;
@@ -748,21 +783,30 @@ create_p2d_map () {
   auto phys_gids = m_phys_grid->get_dofs_gids().get_view<const gid_type*>();
 
   auto policy = KokkosTypes<DefaultDevice>::RangePolicy(0,num_phys_dofs);
-  m_p2d = decltype(m_p2d) ("",num_phys_dofs);
+  m_p2d = decltype(m_p2d) ("",num_phys_dofs,3);
   auto p2d = m_p2d;
+  auto lid2elgp = m_lid2elgp;
 
+  // Store the (elem,gp,gp) indices of the matching dyn dof directly, so that
+  // the remap kernels only go through one level of indirection.
+  // Homme's physics columns are ordered like the elements, so the matching dyn
+  // dof is close to the proportional position of the phys dof in the dyn grid.
+  // Search outward from there, rather than from the start of the dyn dofs.
   Kokkos::parallel_for(policy,KOKKOS_LAMBDA(const int idof){
     auto gid = phys_gids(idof);
-    bool found = false;
-    for (int i=0; i<num_dyn_dofs; ++i) {
-      if (dyn_gids(i)==gid) {
-        p2d(idof) = i;
-        found = true;
-        break;
+    const int hint = static_cast<int>((static_cast<long long>(idof)*num_dyn_dofs)/num_phys_dofs);
+    int lid = -1;
+    for (int n=0; lid<0 && (hint-n>=0 || hint+n<num_dyn_dofs); ++n) {
+      if (hint+n<num_dyn_dofs && dyn_gids(hint+n)==gid) {
+        lid = hint+n;
+      } else if (hint-n>=0 && dyn_gids(hint-n)==gid) {
+        lid = hint-n;
       }
     }
-    EKAT_KERNEL_ASSERT_MSG (found, "Error! Physics grid gid not found in the dynamics grid.\n");
-    (void)found;
+    EKAT_KERNEL_ASSERT_MSG (lid>=0, "Error! Physics grid gid not found in the dynamics grid.\n");
+    for (int k=0; k<3; ++k) {
+      p2d(idof,k) = lid2elgp(lid,k);
+    }
   });
 }
 
@@ -771,7 +815,7 @@ KOKKOS_INLINE_FUNCTION
 void PhysicsDynamicsRemapper::
 operator()(const RemapFwdTag&, const MT& team) const
 {
-  const int i = team.league_rank();
+  const int i = m_fwd_first_field + team.league_rank();
 
   switch (m_layout(i)) {
     case etoi(LayoutType::Scalar2D):
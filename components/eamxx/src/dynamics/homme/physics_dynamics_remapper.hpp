@@ -9,6 +9,7 @@
 
 namespace Homme {
 class BoundaryExchange;
+class MpiBuffersManager;
 }
 
 namespace scream
@@ -82,9 +83,21 @@ protected:
   int m_num_phys_cols;
   typename Field::view_dev_t<const int**>  m_lid2elgp;
 
-  std::shared_ptr<Homme::BoundaryExchange>  m_be;
-
-  view_1d<int>  m_p2d;
+  // The dyn fields are split in groups, each with its own BE, so that the halo
+  // exchange of one group is in flight while the next group is remapped.
+  // Group g contains fields [m_be_fields_beg[g],m_be_fields_beg[g+1]).
+  // All groups but the first need their own MPI buffers, since their
+  // exchanges are in flight at the same time.
+  // NOTE: the buffers must outlive the BEs, so declare them first.
+  std::vector<std::shared_ptr<Homme::MpiBuffersManager>>  m_be_buffers;
+  std::vector<std::shared_ptr<Homme::BoundaryExchange>>   m_be;
+  std::vector<int>                                        m_be_fields_beg;
+
+  // Index of the first field handled by the current fwd remap kernel
+  int m_fwd_first_field = 0;
+
+  // For each phys column, the (elem,gp,gp) indices of a matching dyn dof
+  view_Nd<int,2>  m_p2d;
 
 #ifdef KOKKOS_ENABLE_CUDA
 public:
@@ -23,6 +23,22 @@ namespace scream {
         template <typename S>
         using view_3d = typename ekat::KokkosTypes<HostDevice>::template view_3d<S>;
 
+        // Host views used by main to permute the data for F90. They are allocated once,
+        // so that main does not allocate (and initialize) any view when it is called.
+        struct Workspace {
+            lview_host_2d T_mid, p_mid, p_int, qv, cldfrac, reff_qc, reff_qi, dtau067, dtau105;
+            lview_host_3d isccp_ctptau;
+
+            Workspace () = default;
+            Workspace (const Int ncol, const Int nlay, const Int ntau, const Int nctp)
+              : T_mid("T_mid_h", ncol, nlay), p_mid("p_mid_h", ncol, nlay), p_int("p_int_h", ncol, nlay+1)
+              , qv("qv_h", ncol, nlay), cldfrac("cldfrac_h", ncol, nlay)
+              , reff_qc("reff_qc_h", ncol, nlay), reff_qi("reff_qi_h", ncol, nlay)
+              , dtau067("dtau_067_h", ncol, nlay), dtau105("dtau105_h", ncol, nlay)
+              , isccp_ctptau("isccp_ctptau_h", ncol, ntau, nctp)
+            {}
+        };
+
         inline void initialize(int ncol, int nsubcol, int nlay) {
             cosp_c2f_init(ncol, nsubcol, nlay);
         };
@@ -36,15 +52,20 @@ namespace scream {
                 view_2d<const Real>& qv     , view_2d<const Real>& cldfrac,
                 view_2d<const Real>& reff_qc, view_2d<const Real>& reff_qi,
                 view_2d<const Real>& dtau067, view_2d<const Real>& dtau105,
-                view_1d<Real>& isccp_cldtot , view_3d<Real>& isccp_ctptau) {
+                view_1d<Real>& isccp_cldtot , view_3d<Real>& isccp_ctptau,
+                const Workspace& ws) {
 
             // Make host copies and permute data as needed
-            lview_host_2d
-                  T_mid_h("T_mid_h", ncol, nlay), p_mid_h("p_mid_h", ncol, nlay), p_int_h("p_int_h", ncol, nlay+1),
-                  qv_h("qv_h", ncol, nlay), cldfrac_h("cldfrac_h", ncol, nlay),
-                  reff_qc_h("reff_qc_h", ncol, nlay), reff_qi_h("reff_qi_h", ncol, nlay),
-                  dtau067_h("dtau_067_h", ncol, nlay), dtau105_h("dtau105_h", ncol, nlay);
-            lview_host_3d isccp_ctptau_h("isccp_ctptau_h", ncol, ntau, nctp);
+            const auto& T_mid_h = ws.T_mid;
+            const auto& p_mid_h = ws.p_mid;
+            const auto& p_int_h = ws.p_int;
+            const auto& qv_h = ws.qv;
+            const auto& cldfrac_h = ws.cldfrac;
+            const auto& reff_qc_h = ws.reff_qc;
+            const auto& reff_qi_h = ws.reff_qi;
+            const auto& dtau067_h = ws.dtau067;
+            const auto& dtau105_h = ws.dtau105;
+            const auto& isccp_ctptau_h = ws.isccp_ctptau;
 
             // Copy to layoutLeft host views
             for (int i = 0; i < ncol; i++) {
@@ -1,5 +1,4 @@
 #include "eamxx_cosp.hpp"
-#include "cosp_functions.hpp"
 #include "share/property_checks/field_within_interval_check.hpp"
 
 #include "ekat/ekat_assert.hpp"
@@ -25,6 +24,12 @@ Cosp::Cosp (const ekat::Comm& comm, const ekat::ParameterList& params)
 
   // How many subcolumns to use for COSP
   m_num_subcols = m_params.get<Int>("cosp_subcolumns", 10);
+
+  // Whether to run COSP on a host thread, concurrently with the next steps
+  m_run_async = m_params.get<bool>("cosp_async", false);
+  if (m_run_async) {
+    m_restart_extra_data["cosp_async_pending"] = std::make_shared<ekat::any>(0);
+  }
 }
 
 // =========================================================================================
@@ -85,13 +90,24 @@ void Cosp::set_grids(const std::shared_ptr<const GridsManager> grids_manager)
   add_field<Computed>("isccp_ctptau", scalar4d_layout_ctptau, percent, grid_name, 1);
   add_field<Computed>("isccp_mask"  , scalar2d_layout, nondim, grid_name);
 
+  if (m_run_async) {
+    // Results of the async run, stored as internal fields so that the AD adds them to restart files
+    m_async_results["isccp_cldtot"] = Field(FieldIdentifier("cosp_async_isccp_cldtot", scalar2d_layout, percent, grid_name));
+    m_async_results["isccp_ctptau"] = Field(FieldIdentifier("cosp_async_isccp_ctptau", scalar4d_layout_ctptau, percent, grid_name));
+    m_async_results["isccp_mask"  ] = Field(FieldIdentifier("cosp_async_isccp_mask",   scalar2d_layout, nondim, grid_name));
+    for (auto& it : m_async_results) {
+      it.second.allocate_view();
+      add_internal_field(it.second);
+    }
+  }
 }
 
 // =========================================================================================
-void Cosp::initialize_impl (const RunType /* run_type */)
+void Cosp::initialize_impl (const RunType run_type)
 {
   // Set property checks for fields in this process
   CospFunc::initialize(m_num_cols, m_num_subcols, m_num_levs);
+  m_workspace = CospFunc::Workspace(m_num_cols, m_num_levs, m_num_isccptau, m_num_isccpctp);
 
 
   // Add note to output files about processing ISCCP fields that are only valid during
@@ -103,6 +119,19 @@ void Cosp::initialize_impl (const RunType /* run_type */)
       auto& atts = f.get_header().get_extra_data<stratts_t>("io: string attributes");
       atts["note"] = "Night values are zero; divide by isccp_mask to get daytime mean";
   }
+
+  if (m_run_async) {
+    for (const auto& f : get_fields_in()) {
+      m_inputs_snapshot[f.name()] = f.clone();
+    }
+    // In restarted runs, the results were read from the restart file
+    if (run_type==RunType::Initial) {
+      for (auto& it : m_async_results) {
+        it.second.deep_copy(0);
+        it.second.get_header().get_tracking().update_time_stamp(timestamp());
+      }
+    }
+  }
 }
 
 // =========================================================================================
@@ -126,87 +155,160 @@ void Cosp::run_impl (const double dt)
   auto ts = timestamp();
   auto update_cosp = cosp_do(cosp_freq_in_steps, ts.get_num_steps());
 
-  // Get fields from field manager; note that we get host views because this
-  // interface serves primarily as a wrapper to a c++ to f90 bridge for the COSP
-  // all then need to be copied to layoutLeft views to permute the indices for
-  // F90.
-  //
-  // Need to make sure device data is synced to host?
-  get_field_in("qv").sync_to_host();
-  get_field_in("qc").sync_to_host();
-  get_field_in("qi").sync_to_host();
-  get_field_in("sunlit").sync_to_host();
-  get_field_in("surf_radiative_T").sync_to_host();
-  get_field_in("T_mid").sync_to_host();
-  get_field_in("p_mid").sync_to_host();
-  get_field_in("p_int").sync_to_host();
-  get_field_in("cldfrac_tot_for_analysis").sync_to_host();
-  get_field_in("eff_radius_qc").sync_to_host();
-  get_field_in("eff_radius_qi").sync_to_host();
-  get_field_in("dtau067").sync_to_host();
-  get_field_in("dtau105").sync_to_host();
-
-  auto qv      = get_field_in("qv").get_view<const Real**, Host>();
-  auto qc      = get_field_in("qc").get_view<const Real**, Host>();
-  auto qi      = get_field_in("qi").get_view<const Real**, Host>();
-  auto sunlit  = get_field_in("sunlit").get_view<const Real*, Host>();
-  auto skt     = get_field_in("surf_radiative_T").get_view<const Real*, Host>();
-  auto T_mid   = get_field_in("T_mid").get_view<const Real**, Host>();
-  auto p_mid   = get_field_in("p_mid").get_view<const Real**, Host>();
-  auto p_int   = get_field_in("p_int").get_view<const Real**, Host>();
-  auto cldfrac = get_field_in("cldfrac_tot_for_analysis").get_view<const Real**, Host>();
-  auto reff_qc = get_field_in("eff_radius_qc").get_view<const Real**, Host>();
-  auto reff_qi = get_field_in("eff_radius_qi").get_view<const Real**, Host>();
-  auto dtau067 = get_field_in("dtau067").get_view<const Real**, Host>();
-  auto dtau105 = get_field_in("dtau105").get_view<const Real**, Host>();
   auto isccp_cldtot = get_field_out("isccp_cldtot").get_view<Real*, Host>();
   auto isccp_ctptau = get_field_out("isccp_ctptau").get_view<Real***, Host>();
   auto isccp_mask   = get_field_out("isccp_mask"  ).get_view<Real*, Host>();  // Copy of sunlit flag with COSP frequency for proper averaging
 
-  // Call COSP wrapper routines
-  if (update_cosp) {
-    Real emsfc_lw = 0.99;
-    Kokkos::deep_copy(isccp_mask, sunlit);
-    CospFunc::main(
-            m_num_cols, m_num_subcols, m_num_levs, m_num_isccptau, m_num_isccpctp,
-            emsfc_lw, sunlit, skt, T_mid, p_mid, p_int, qv,
-            cldfrac, reff_qc, reff_qi, dtau067, dtau105,
-            isccp_cldtot, isccp_ctptau
-    );
-    // Remask night values to ZERO since our I/O does not know how to handle masked/missing values
-    // in temporal averages; this is all host data, so we can just use host loops like its the 1980s
-    for (int i = 0; i < m_num_cols; i++) {
-        if (sunlit(i) == 0) {
-            isccp_cldtot(i) = 0;
-            for (int j = 0; j < m_num_isccptau; j++) {
-                for (int k = 0; k < m_num_isccpctp; k++) {
-                    isccp_ctptau(i,j,k) = 0;
-                }
-            }
-        }
+  // If not updating COSP statistics, the outputs are set to ZERO; this essentially weights
+  // the ISCCP cloud properties by the sunlit mask. What will be output for time-averages
+  // then is the time-average mask-weighted statistics; to get true averages, we need to
+  // divide by the time-average of the mask. I.e., if M is the sunlit mask, and X is the ISCCP
+  // statistic, then
+  //
+  //     avg(X) = sum(M * X) / sum(M) = (sum(M * X)/N) / (sum(M)/N) = avg(M * X) / avg(M)
+  //
+  // TODO: mask this when/if the AD ever supports masked averages
+  if (m_run_async) {
+    // Store the results of the run launched at the previous step (if any). Since the
+    // mask is stored along with them, the time averages are not affected by the lag.
+    // The outputs are stamped with the end of the previous step (see update_time_stamps).
+    join_async_run();
+    auto& pending = ekat::any_cast<int>(*m_restart_extra_data["cosp_async_pending"]);
+    for (const auto& it : m_async_results) {
+      auto f = get_field_out(it.first);
+      if (pending==1) {
+        f.deep_copy(it.second);
+      } else {
+        f.deep_copy(0);
+      }
+    }
+    pending = 0;
+    m_outputs_ts = ts;
+
+    if (update_cosp) {
+      // Snapshot the inputs, and run COSP on them on a separate host thread.
+      // NOTE: the thread only runs serial host code, on views allocated in
+      //       set_grids and initialize_impl, so it does not launch kernels nor allocate views.
+      for (auto& it : m_inputs_snapshot) {
+        it.second.deep_copy(get_field_in(it.first));
+        it.second.sync_to_host();
+      }
+      auto cldtot = m_async_results.at("isccp_cldtot").get_view<Real*, Host>();
+      auto ctptau = m_async_results.at("isccp_ctptau").get_view<Real***, Host>();
+      auto mask   = m_async_results.at("isccp_mask"  ).get_view<Real*, Host>();
+      Kokkos::deep_copy(mask, m_inputs_snapshot.at("sunlit").get_view<const Real*, Host>());
+      m_async_run = std::async(std::launch::async, [this,cldtot,ctptau] () {
+        compute_isccp(m_inputs_snapshot, cldtot, ctptau);
+      });
+      pending = 1;
     }
   } else {
-    // If not updating COSP statistics, set these to ZERO; this essentially weights
-    // the ISCCP cloud properties by the sunlit mask. What will be output for time-averages
-    // then is the time-average mask-weighted statistics; to get true averages, we need to
-    // divide by the time-average of the mask. I.e., if M is the sunlit mask, and X is the ISCCP
-    // statistic, then
-    //
-    //     avg(X) = sum(M * X) / sum(M) = (sum(M * X)/N) / (sum(M)/N) = avg(M * X) / avg(M)
-    //
-    // TODO: mask this when/if the AD ever supports masked averages
-    Kokkos::deep_copy(isccp_cldtot, 0.0);
-    Kokkos::deep_copy(isccp_ctptau, 0.0);
-    Kokkos::deep_copy(isccp_mask  , 0.0);
+    if (update_cosp) {
+      // Note that we get host views because this interface serves primarily as a
+      // wrapper to a c++ to f90 bridge for the COSP, so device data must be synced to host.
+      std::map<std::string,Field> inputs;
+      for (const auto& f : get_fields_in()) {
+        f.sync_to_host();
+        inputs[f.name()] = f;
+      }
+      Kokkos::deep_copy(isccp_mask, get_field_in("sunlit").get_view<const Real*, Host>());
+      compute_isccp(inputs, isccp_cldtot, isccp_ctptau);
+    } else {
+      Kokkos::deep_copy(isccp_cldtot, 0.0);
+      Kokkos::deep_copy(isccp_ctptau, 0.0);
+      Kokkos::deep_copy(isccp_mask  , 0.0);
+    }
+    get_field_out("isccp_cldtot").sync_to_dev();
+    get_field_out("isccp_ctptau").sync_to_dev();
+    get_field_out("isccp_mask"  ).sync_to_dev();
+  }
+}
+
+// =========================================================================================
+void Cosp::finish_step_impl ()
+{
+  // A restart file is about to be written: make sure it gets the results of the pending run
+  join_async_run();
+}
+
+// =========================================================================================
+void Cosp::join_async_run ()
+{
+  if (not m_async_run.valid()) {
+    return;
+  }
+  m_async_run.get();
+
+  // The run was launched in the step ending at the current time stamp (since
+  // the process time stamp is advanced at the end of the step).
+  for (auto& it : m_async_results) {
+    it.second.sync_to_dev();
+    it.second.get_header().get_tracking().update_time_stamp(timestamp());
+  }
+}
+
+// =========================================================================================
+void Cosp::update_time_stamps ()
+{
+  if (not m_run_async) {
+    AtmosphereProcess::update_time_stamps();
+    return;
+  }
+
+  for (auto f : get_fields_out()) {
+    f.get_header().get_tracking().update_time_stamp(m_outputs_ts);
+  }
+}
+
+// =========================================================================================
+void Cosp::compute_isccp (const std::map<std::string,Field>& inputs,
+                          const view_1d_host& isccp_cldtot,
+                          const view_3d_host& isccp_ctptau) const
+{
+  // The COSP wrapper needs host data, which is then copied to layoutLeft
+  // views, to permute the indices for F90.
+  auto qv      = inputs.at("qv").get_view<const Real**, Host>();
+  auto sunlit  = inputs.at("sunlit").get_view<const Real*, Host>();
+  auto skt     = inputs.at("surf_radiative_T").get_view<const Real*, Host>();
+  auto T_mid   = inputs.at("T_mid").get_view<const Real**, Host>();
+  auto p_mid   = inputs.at("p_mid").get_view<const Real**, Host>();
+  auto p_int   = inputs.at("p_int").get_view<const Real**, Host>();
+  auto cldfrac = inputs.at("cldfrac_tot_for_analysis").get_view<const Real**, Host>();
+  auto reff_qc = inputs.at("eff_radius_qc").get_view<const Real**, Host>();
+  auto reff_qi = inputs.at("eff_radius_qi").get_view<const Real**, Host>();
+  auto dtau067 = inputs.at("dtau067").get_view<const Real**, Host>();
+  auto dtau105 = inputs.at("dtau105").get_view<const Real**, Host>();
+  auto cldtot  = isccp_cldtot;
+  auto ctptau  = isccp_ctptau;
+
+  // Call COSP wrapper routines
+  Real emsfc_lw = 0.99;
+  CospFunc::main(
+          m_num_cols, m_num_subcols, m_num_levs, m_num_isccptau, m_num_isccpctp,
+          emsfc_lw, sunlit, skt, T_mid, p_mid, p_int, qv,
+          cldfrac, reff_qc, reff_qi, dtau067, dtau105,
+          cldtot, ctptau, m_workspace
+  );
+  // Remask night values to ZERO since our I/O does not know how to handle masked/missing values
+  // in temporal averages; this is all host data, so we can just use host loops like its the 1980s
+  for (int i = 0; i < m_num_cols; i++) {
+      if (sunlit(i) == 0) {
+          isccp_cldtot(i) = 0;
+          for (int j = 0; j < m_num_isccptau; j++) {
+              for (int k = 0; k < m_num_isccpctp; k++) {
+                  isccp_ctptau(i,j,k) = 0;
+              }
+          }
+      }
   }
-  get_field_out("isccp_cldtot").sync_to_dev();
-  get_field_out("isccp_ctptau").sync_to_dev();
-  get_field_out("isccp_mask"  ).sync_to_dev();
 }
 
 // =========================================================================================
 void Cosp::finalize_impl()
 {
+  // Wait for the pending asynchronous run (if any), before finalizing COSP
+  finish_step_impl();
+
   // Finalize COSP wrappers
   CospFunc::finalize();
 }
@@ -2,8 +2,10 @@
 #define SCREAM_COSP_HPP
 
 #include "share/atm_process/atmosphere_process.hpp"
+#include "cosp_functions.hpp"
 #include "ekat/ekat_parameter_list.hpp"
 
+#include <future>
 #include <string>
 
 namespace scream
@@ -51,6 +53,19 @@ protected:
   void initialize_impl (const RunType run_type);
   void run_impl        (const double dt);
   void finalize_impl   ();
+  void finish_step_impl ();
+
+  // In async mode, the outputs hold the results for the previous step
+  void update_time_stamps ();
+
+  // Run the COSP simulators on the host data of the given input fields
+  // (sunlit, skt, T_mid,...), storing the results in the given host views.
+  // Night columns are masked to zero.
+  using view_1d_host = typename KokkosTypes<HostDevice>::template view_1d<Real>;
+  using view_3d_host = typename KokkosTypes<HostDevice>::template view_3d<Real>;
+  void compute_isccp (const std::map<std::string,Field>& inputs,
+                      const view_1d_host& isccp_cldtot,
+                      const view_3d_host& isccp_ctptau) const;
 
   // cosp frequency; positive is interpreted as number of steps, negative as number of hours
   int m_cosp_frequency;
@@ -64,6 +79,24 @@ protected:
   Int m_num_isccpctp = 7;
   Int m_num_cth = 16;
 
+  // Host views used to permute the data for the F90 COSP wrapper
+  CospFunc::Workspace m_workspace;
+
+  // If true, COSP runs on a host thread, on a snapshot of its inputs taken at
+  // the COSP step, concurrently with the following processes and steps. The
+  // results are stored in the m_async_results internal fields (which are saved
+  // in restart files), and copied to the outputs at the next step, with the time
+  // stamp of the snapshot. The "cosp_async_pending" restart extra data is 1 if
+  // m_async_results holds results not yet copied to the outputs.
+  bool m_run_async;
+  std::future<void>             m_async_run;
+  std::map<std::string,Field>   m_inputs_snapshot;
+  std::map<std::string,Field>   m_async_results;
+  TimeStamp                     m_outputs_ts;
+
+  // Wait for the pending async run (if any), and sync its results to device
+  void join_async_run ();
+
   std::shared_ptr<const AbstractGrid> m_grid;
 
 }; // class Cosp
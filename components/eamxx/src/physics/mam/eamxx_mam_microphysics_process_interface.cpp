@@ -298,9 +298,9 @@ void MAMMicrophysics::run_impl(const double dt) {
   const auto scan_policy = ekat::ExeSpaceUtils<KT::ExeSpace>::get_thread_range_parallel_scan_team_policy(ncol_, nlev_);
   const auto policy      = ekat::ExeSpaceUtils<KT::ExeSpace>::get_default_team_policy(ncol_, nlev_);
 
-  // preprocess input -- needs a scan for the calculation of atm height
+  // preprocess input -- needs a scan for the calculation of atm height.
+  // No fence needed: the nucleation kernel runs on the same execution space.
   Kokkos::parallel_for("preprocess", scan_policy, preprocess_);
-  Kokkos::fence();
 
   // Reset internal WSM variables.
   //workspace_mgr_.reset_internals();
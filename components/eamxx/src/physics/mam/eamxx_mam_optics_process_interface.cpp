@@ -67,37 +67,17 @@ void MAMOptics::initialize_impl(const RunType run_type) {
 
 void MAMOptics::run_impl(const double dt) {
 
-  const auto policy = ekat::ExeSpaceUtils<KT::ExeSpace>::get_default_team_policy(ncol_, nlev_);
-
-  // get the aerosol optics fields
-  auto aero_g_sw   = get_field_out("aero_g_sw").get_view<Real***>();
-  auto aero_ssa_sw = get_field_out("aero_ssa_sw").get_view<Real***>();
-  auto aero_tau_sw = get_field_out("aero_tau_sw").get_view<Real***>();
-  auto aero_tau_lw = get_field_out("aero_tau_lw").get_view<Real***>();
-
-  auto aero_nccn   = get_field_out("nccn").get_view<Real**>(); // FIXME: get rid of this
-
-  // Compute optical properties on all local columns.
-  // (Strictly speaking, we don't need this parallel_for here yet, but we leave
-  //  it in anticipation of column-specific aerosol optics to come.)
-  Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const ThreadTeam& team) {
-    const Int icol = team.league_rank(); // column index
-
-    auto g_sw = ekat::subview(aero_g_sw, icol);
-    auto ssa_sw = ekat::subview(aero_ssa_sw, icol);
-    auto tau_sw = ekat::subview(aero_tau_sw, icol);
-    auto tau_lw = ekat::subview(aero_tau_lw, icol);
-
-    // populate these fields with reasonable representative values
-    Kokkos::deep_copy(g_sw, 0.5);
-    Kokkos::deep_copy(ssa_sw, 0.7);
-    Kokkos::deep_copy(tau_sw, 0.0);
-    Kokkos::deep_copy(tau_lw, 0.0);
-
-    // FIXME: Get rid of this
-    auto nccn = ekat::subview(aero_nccn, icol);
-    Kokkos::deep_copy(nccn, 50.0);
-  });
+  // Populate the aerosol optics fields with reasonable representative values.
+  // These do not depend on the column yet, so fill the whole fields at once,
+  // rather than launching a team per column to fill each column separately.
+  // FIXME: replace with column-specific aerosol optics, batched over modes
+  get_field_out("aero_g_sw").deep_copy(0.5);
+  get_field_out("aero_ssa_sw").deep_copy(0.7);
+  get_field_out("aero_tau_sw").deep_copy(0.0);
+  get_field_out("aero_tau_lw").deep_copy(0.0);
+
+  // FIXME: Get rid of this
+  get_field_out("nccn").deep_copy(50.0);
 }
 
 void MAMOptics::finalize_impl()
@@ -103,6 +103,39 @@ void MLCorrection::run_impl(const double dt) {
   const auto& tracers_info = tracers.m_info;
   Int num_tracers = tracers_info->size();
 
+  // The numpy arrays below wrap the fields host memory (no copy), so the only data
+  // movement is between device and host, which we limit to the fields that the
+  // loaded models actually use (a "NONE" model path gives a None model).
+  const bool has_model_tq  = not ML_model_tq.is_none();
+  const bool has_model_uv  = not ML_model_uv.is_none();
+  const bool has_model_sfc = not ML_model_sfc_fluxes.is_none();
+  std::vector<Field> fields_in, fields_out;
+  if (has_model_tq or has_model_uv or has_model_sfc) {
+    fields_out.push_back(get_field_out("T_mid"));
+    fields_out.push_back(*tracers.m_bundle);  // qv is passed with the tracers stride
+  }
+  if (has_model_uv) {
+    fields_out.push_back(get_field_out("horiz_winds"));
+  }
+  if (has_model_uv or has_model_sfc) {
+    fields_in.push_back(get_field_in("phis"));
+  }
+  if (has_model_sfc) {
+    fields_in.push_back(get_field_in("sfc_alb_dif_vis"));
+    fields_out.push_back(get_field_out("SW_flux_dn"));
+    fields_out.push_back(get_field_out("sfc_flux_sw_net"));
+    fields_out.push_back(get_field_out("sfc_flux_lw_dn"));
+  }
+  if (fields_out.empty()) {
+    return;
+  }
+  for (const auto& f : fields_in) {
+    f.sync_to_host();
+  }
+  for (const auto& f : fields_out) {
+    f.sync_to_host();
+  }
+
   ekat::disable_all_fpes();  // required for importing numpy
   if ( Py_IsInitialized() == 0 ) {
     pybind11::initialize_interpreter();
@@ -135,6 +168,10 @@ void MLCorrection::run_impl(const double dt) {
       ML_model_tq, ML_model_uv, ML_model_sfc_fluxes, datetime_str);
   pybind11::gil_scoped_release no_gil;  
   ekat::enable_fpes(fpe_mask);   
+
+  for (const auto& f : fields_out) {
+    f.sync_to_dev();
+  }
 }
 
 // =========================================================================================
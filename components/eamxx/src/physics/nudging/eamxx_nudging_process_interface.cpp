@@ -1,5 +1,6 @@
 #include "eamxx_nudging_process_interface.hpp"
 #include "share/util/scream_universal_constants.hpp"
+#include "share/util/scream_combine_ops.hpp"
 #include "share/grid/remap/refining_remapper_p2p.hpp"
 #include "share/grid/remap/do_nothing_remapper.hpp"
 
@@ -14,6 +15,7 @@ Nudging::Nudging (const ekat::Comm& comm, const ekat::ParameterList& params)
   m_timescale = m_params.get<int>("nudging_timescale",0);
   m_fields_nudge = m_params.get<std::vector<std::string>>("nudging_fields");
   m_use_weights   = m_params.get<bool>("use_nudging_weights",false);
+  m_prefetch_data = m_params.get<bool>("prefetch_data",false);
   // If we are doing horizontal refine-remapping, we need to get the mapfile from user
   m_refine_remap_file = m_params.get<std::string>(
       "nudging_refine_remap_mapfile", "no-file-given");
@@ -144,81 +146,76 @@ void Nudging::set_grids(const std::shared_ptr<const GridsManager> grids_manager)
   }
 }
 // =========================================================================================
-void Nudging::apply_tendency(Field& base, const Field& next, const Real dt)
+void Nudging::interpolate_p_mid_ext (const Real weight0)
 {
-  // Calculate the weight to apply the tendency
-  const Real dtend = dt/Real(m_timescale);
-  EKAT_REQUIRE_MSG(dtend>=0,"Error! Nudging::apply_tendency - timescale tendency of " << std::to_string(dt) 
-		  << " / " << std::to_string(m_timescale) << " = " << std::to_string(dtend) 
-		  << " is invalid.  Please check the timescale and/or dt");
-  // Now apply the tendency.
-  Field tend = base.clone();
-  // Use update internal to set tendency, will be (1.0*next - 1.0*base), note tend=base at this point.
-  tend.update(next,Real(1.0),Real(-1.0));
-  base.update(tend,dtend,Real(1.0));
+  // Same as TimeInterpolation::perform_time_interpolation, for the only field that is
+  // not interpolated on the fly in run_impl
+  const Real weight1 = 1.0-weight0;
+  auto p_mid_ext_v = get_helper_field("p_mid_ext").get_view<Real**>();
+  auto p_mid_0_v   = m_time_interp.get_field_time0("p_mid").get_view<const Real**>();
+  auto p_mid_1_v   = m_time_interp.get_field_time1("p_mid").get_view<const Real**>();
+  const Real fill_value = constants::DefaultFillValue<Real>().value;
+
+  const int num_cols = p_mid_ext_v.extent(0);
+  const int num_levs = p_mid_ext_v.extent(1);
+  Kokkos::parallel_for("interpolate_p_mid_ext",
+      Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {num_cols, num_levs}),
+      KOKKOS_LAMBDA(int i, int j) {
+    p_mid_ext_v(i,j) = p_mid_0_v(i,j);
+    combine_and_fill<CombineMode::ScaleUpdate>(p_mid_1_v(i,j),p_mid_ext_v(i,j),fill_value,weight1,weight0);
+  });
 }
 // =========================================================================================
-void Nudging::apply_weighted_tendency(Field& base, const Field& next, const Field& weights, const Real dt)
+void Nudging::apply_tendencies (const Real dt)
 {
   // Calculate the weight to apply the tendency
-  const Real dtend = dt/Real(m_timescale);
-  EKAT_REQUIRE_MSG(dtend>=0,"Error! Nudging::apply_tendency - timescale tendency of " << std::to_string(dt)
+  const bool replace = m_timescale <= 0;
+  const Real dtend = replace ? Real(0) : dt/Real(m_timescale);
+  EKAT_REQUIRE_MSG(dtend>=0,"Error! Nudging::apply_tendencies - timescale tendency of " << std::to_string(dt)
                   << " / " << std::to_string(m_timescale) << " = " << std::to_string(dtend)
                   << " is invalid.  Please check the timescale and/or dt");
-  // Now apply the tendency.
-  Field tend = base.clone();
-
-  // Use update internal to set tendency, will be (weights*next - weights*base), note tend=base at this point.
-  auto base_view = base.get_view<const Real**>();
-  auto tend_view = tend.get_view<      Real**>();
-  auto next_view = next.get_view<      Real**>();
-  auto w_view    = weights.get_view<   Real**>();
-
-  const int num_cols       = base_view.extent(0);
-  const int num_vert_packs = base_view.extent(1);
-  Kokkos::parallel_for(Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {num_cols, num_vert_packs}), KOKKOS_LAMBDA(int i, int j) {
-    tend_view(i,j) = next_view(i,j)*w_view(i,j) - base_view(i,j)*w_view(i,j);
+
+  const bool use_weights = m_use_weights;
+  const Real cutoff      = m_refine_remap_vert_cutoff;
+  view_2d<const Real> w_view;
+  if (use_weights) {
+    // NOTES: do we really need the vertical interpolation for nudging weights? Since we are going to
+    //        use the same grids as the case by providing the nudging weights file.
+    //        I would not apply the vertical interpolation here, but it depends...
+    w_view = get_helper_field("nudging_weights").get_view<const Real**>();
+  }
+  auto pmid_view = get_field_in("p_mid").get_view<const Real**>();
+  const Real fill_value = constants::DefaultFillValue<Real>().value;
+
+  // One pass over all nudged fields. With x the atm state and y the nudging target, the
+  // tendency is y-x (masked if either one is masked), w*y-w*x with nudging weights, or
+  // y-x zeroed closer to the surface than the vertical cutoff, and x is updated to x+dtend*tend.
+  // If the timescale is not positive, we do direct replacement.
+  const auto nudged_fields = m_nudged_fields;
+  const int num_fields = nudged_fields.extent(0);
+  Kokkos::parallel_for("apply_nudging_tendencies",
+      Kokkos::MDRangePolicy<Kokkos::Rank<3>>({0, 0, 0}, {num_fields, m_num_cols, m_num_levs}),
+      KOKKOS_LAMBDA(int ifld, int i, int j) {
+    const auto& f = nudged_fields(ifld);
+    Real& x = f.atm_state[i*f.atm_stride + j];
+    const Real y = f.int_state[i*f.int_stride + j];
+    if (replace) {
+      x = y;
+      return;
+    }
+    Real tend;
+    if (use_weights) {
+      tend = y*w_view(i,j) - x*w_view(i,j);
+    } else if (cutoff > 0.0) {
+      // If the pressure is above the cutoff, then we are closer to the surface,
+      // and we don't apply the tendency
+      tend = pmid_view(i,j) > cutoff ? Real(0) : y - x;
+    } else {
+      tend = x;
+      combine_and_fill<CombineMode::ScaleUpdate>(y,tend,fill_value,Real(1.0),Real(-1.0));
+    }
+    combine_and_fill<CombineMode::ScaleUpdate>(tend,x,fill_value,dtend,Real(1.0));
   });
-  base.update(tend, dtend, Real(1.0));
-}
-// =========================================================================================
-void Nudging::apply_vert_cutoff_tendency(Field &base, const Field &next,
-                                         const Field &p_mid, const Real cutoff,
-                                         const Real dt) {
-  // Calculate the weight to apply the tendency
-  const Real dtend = dt / Real(m_timescale);
-  EKAT_REQUIRE_MSG(dtend >= 0,
-                   "Error! Nudging::apply_tendency - timescale tendency of "
-                       << std::to_string(dt) << " / "
-                       << std::to_string(m_timescale) << " = "
-                       << std::to_string(dtend)
-                       << " is invalid.  Please check the timescale and/or dt");
-  // Now apply the tendency.
-  Field tend = base.clone();
-
-  // Use update internal to set tendency, will be (weights*next - weights*base),
-  // note tend=base at this point.
-  auto base_view = base.get_view<const Real **>();
-  auto tend_view = tend.get_view<Real **>();
-  auto next_view = next.get_view<Real **>();
-  auto pmid_view = p_mid.get_view<Real **>();
-
-  const int num_cols       = base_view.extent(0);
-  const int num_vert_packs = base_view.extent(1);
-  Kokkos::parallel_for(
-      Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0},
-                                             {num_cols, num_vert_packs}),
-      KOKKOS_LAMBDA(int i, int j) {
-        // If the pressure is above the cutoff, then we are closer to the surface
-        if (pmid_view(i, j) > cutoff) {
-          // Don't apply the tendency closer to the surface
-          tend_view(i, j) = 0.0;
-        } else {
-          // Apply the tendency farther up from the surface
-          tend_view(i, j) = next_view(i, j) - base_view(i, j);
-        }
-      });
-  base.update(tend, dtend, Real(1.0));
 }
 // =============================================================================================================
 void Nudging::initialize_impl (const RunType /* run_type */)
@@ -273,6 +270,12 @@ void Nudging::initialize_impl (const RunType /* run_type */)
 
   // Initialize the time interpolator
   m_time_interp = util::TimeInterpolation(grid_ext, m_datafiles);
+  if (m_prefetch_data and not m_time_interp.set_prefetch(true)) {
+    if (m_comm.am_i_root()) {
+      m_atm_logger->warn("[EAMxx::nudging] prefetch_data requested, but MPI was not initialized "
+                         "with MPI_THREAD_MULTIPLE. Nudging data will be read synchronously.\n");
+    }
+  }
 
   constexpr int ps = SCREAM_PACK_SIZE;
   // To be extra careful, this should be the ext_grid
@@ -332,6 +335,19 @@ void Nudging::initialize_impl (const RunType /* run_type */)
   // Close the registration!
   m_refine_remapper->registration_ends();
 
+  // Store the nudged fields for the kernel that applies the tendencies
+  m_nudged_fields = view_1d<NudgedField>("nudged_fields",m_fields_nudge.size());
+  auto nudged_fields_h = Kokkos::create_mirror_view(m_nudged_fields);
+  for (size_t i=0; i<m_fields_nudge.size(); ++i) {
+    auto atm_state_view = get_field_out_wrap(m_fields_nudge[i]).get_view<Real**>();
+    auto int_state_view = get_helper_field(m_fields_nudge[i]).get_view<const Real**>();
+    nudged_fields_h(i).atm_state  = atm_state_view.data();
+    nudged_fields_h(i).int_state  = int_state_view.data();
+    nudged_fields_h(i).atm_stride = atm_state_view.stride(0);
+    nudged_fields_h(i).int_stride = int_state_view.stride(0);
+  }
+  Kokkos::deep_copy(m_nudged_fields,nudged_fields_h);
+
   // load nudging weights from file
   // NOTE: the regional nudging use the same grid as the run, no need to
   // do the interpolation.
@@ -358,8 +374,13 @@ void Nudging::run_impl (const double dt)
   // end of the full step in scream.
   auto ts = timestamp()+dt;
 
-  // Perform time interpolation
-  m_time_interp.perform_time_interpolation(ts);
+  // Update the time snaps of nudging data. The nudged fields are interpolated in time
+  // in the kernel that corrects their masked values, rather than by m_time_interp.
+  const Real weight0 = m_time_interp.update_data_and_get_weight(ts);
+  const Real weight1 = 1.0-weight0;
+  if (m_src_pres_type == TIME_DEPENDENT_3D_PROFILE) {
+    interpolate_p_mid_ext(weight0);
+  }
 
   // Process data and nudge the atmosphere state
   const auto& p_mid_v = get_field_in("p_mid").get_view<const mPack**>();
@@ -377,6 +398,9 @@ void Nudging::run_impl (const double dt)
     auto ext_state_field = get_helper_field(name+"_ext"); // ext horiz, ext vert
     auto tmp_state_field = get_helper_field(name+"_tmp"); // ext horiz, int vert
     auto ext_state_view  = ext_state_field.get_view<mPack**>();
+    auto ext_state_view_s = ext_state_field.get_view<Real**>();
+    auto ext_state_0_view = m_time_interp.get_field_time0(name).get_view<const Real**>();
+    auto ext_state_1_view = m_time_interp.get_field_time1(name).get_view<const Real**>();
     auto tmp_state_view  = tmp_state_field.get_view<mPack**>();
     auto atm_state_view  = atm_state_field.get_view<mPack**>();  // TODO: Right now assume whatever field is defined on COLxLEV
     auto int_state_view  = int_state_field.get_view<mPack**>();
@@ -385,7 +409,7 @@ void Nudging::run_impl (const double dt)
     // We pre-process the data and map any masked values (sometimes called "filled" values) to the
     // nearest un-masked value.
     // Here we are updating the ext_state_view, which is the time interpolated values taken from the nudging
-    // data.
+    // data. The time interpolation happens in the same kernel.
     Real var_fill_value = constants::DefaultFillValue<Real>().value;
     // Query the helper field for the fill value, if not present use default
     if (ext_state_field.get_header().has_extra_data("mask_value")) {
@@ -398,6 +422,16 @@ void Nudging::run_impl (const double dt)
     Kokkos::parallel_for("correct_for_masked_values", policy,
        	       KOKKOS_LAMBDA(MemberType const& team) {
       const int icol = team.league_rank();
+      // Interpolate the column in time; as in Field::update, a value masked
+      // at either time snap stays masked
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team,num_src_levs),
+                           [&](const int kk) {
+        const Real v0 = ext_state_0_view(icol,kk);
+        const Real v1 = ext_state_1_view(icol,kk);
+        ext_state_view_s(icol,kk) = (v0==var_fill_value or v1==var_fill_value)
+                                  ? var_fill_value : weight0*v0 + weight1*v1;
+      });
+      team.team_barrier();
       auto ext_state_view_1d = ekat::subview(ext_state_view,icol);
       Real fill_value;
       int  fill_idx = -1;
@@ -506,38 +540,8 @@ void Nudging::run_impl (const double dt)
   // this remap step is a no-op; otherwise, we refine-remap from tmp to int
   m_refine_remapper->remap(true);
 
-  for (auto name : m_fields_nudge) {
-    auto atm_state_field = get_field_out_wrap(name);      // int horiz, int vert
-    auto int_state_field = get_helper_field(name);        // int horiz, int vert
-    auto atm_state_view  = atm_state_field.get_view<mPack**>();  // TODO: Right now assume whatever field is defined on COLxLEV
-    auto int_state_view  = int_state_field.get_view<mPack**>();
-    // Apply the nudging tendencies to the ATM state
-    if (m_timescale <= 0) {
-      // We do direct replacement
-      Kokkos::deep_copy(atm_state_view,int_state_view);
-    } else {
-      // Back out a tendency and apply it.
-      if (m_use_weights) {
-        // get nudging weights field
-        // NOTES: do we really need the vertical interpolation for nudging weights? Since we are going to 
-        //        use the same grids as the case by providing the nudging weights file.
-        //        I would not apply the vertical interpolation here, but it depends...
-        //
-        auto nudging_weights_field = get_helper_field("nudging_weights");
-        // appply the nudging tendencies to the ATM states
-        apply_weighted_tendency(atm_state_field, int_state_field, nudging_weights_field, dt);
-      } else if (m_refine_remap_vert_cutoff > 0.0) {
-        // If we have a cutoff, we apply the tendency with p_mid cutoff
-        // First, get p_mid the field in the atm (i.e., int) state
-        auto p_mid_field = get_field_in("p_mid");
-        // Then, call the tendency with a Heaviside-like cutoff
-        apply_vert_cutoff_tendency(atm_state_field, int_state_field,
-                                   p_mid_field, m_refine_remap_vert_cutoff, dt);
-      } else {
-        apply_tendency(atm_state_field, int_state_field, dt);
-      }
-    }
-  }
+  // Apply the nudging tendencies to the ATM state
+  apply_tendencies(dt);
 }
 
 // =========================================================================================
@@ -66,8 +66,15 @@ public:
   // Set the grid
   void set_grids (const std::shared_ptr<const GridsManager> grids_manager);
 
-  // Internal function to apply nudging at specific timescale with weights
-  void apply_weighted_tendency(Field& base, const Field& next, const Field& weights, const Real dt);
+  // A nudged field, as seen by the kernel applying the tendencies of all fields at once.
+  // U and V are strided components of horiz_winds, so we store the data pointers together
+  // with the distance between two columns.
+  struct NudgedField {
+    Real*       atm_state;   // int horiz, int vert (the atmosphere state)
+    const Real* int_state;   // int horiz, int vert (the nudging target)
+    int         atm_stride;
+    int         int_stride;
+  };
 
   // Structure for storing local variables initialized using the ATMBufferManager
   struct Buffer {
@@ -85,13 +92,10 @@ protected:
 
   void run_impl        (const double dt);
 
-  /* Nudge from coarse data */
-  // See more details later in this file
-  // Must add this here to make it public for CUDA
-  // (refining) remapper vertically-weighted tendency application
-  void apply_vert_cutoff_tendency(Field &base, const Field &next,
-                                  const Field &p_mid, const Real cutoff,
-                                  const Real dt);
+  // Time-interpolate the source pressure, for TIME_DEPENDENT_3D_PROFILE
+  void interpolate_p_mid_ext (const Real weight0);
+  // Apply the nudging tendencies of all nudged fields in one kernel
+  void apply_tendencies (const Real dt);
 protected:
 
   Field get_field_out_wrap(const std::string& field_name);
@@ -117,8 +121,6 @@ protected:
   bool has_helper_field (const std::string& name) const { return m_helper_fields.find(name)!=m_helper_fields.end(); }
   // Retrieve a helper field
   Field get_helper_field (const std::string& name) const { return m_helper_fields.at(name); }
-  // Internal function to apply nudging at specific timescale
-  void apply_tendency(Field& base, const Field& next, const Real dt);
 
   std::shared_ptr<const AbstractGrid>   m_grid;
   // Keep track of field dimensions and the iteration count
@@ -127,6 +129,8 @@ protected:
   int m_num_src_levs;
   int m_timescale;
   bool m_use_weights;
+  // If true, read the next time snap of nudging data in the background
+  bool m_prefetch_data;
   std::vector<std::string> m_datafiles;
   std::string              m_static_vertical_pressure_file;
   // add nudging weights for regional nudging update
@@ -139,6 +143,8 @@ protected:
   std::map<std::string,Field> m_helper_fields;
 
   std::vector<std::string> m_fields_nudge;
+  // The nudged fields, on device, in the same order as m_fields_nudge
+  view_1d<NudgedField>     m_nudged_fields;
 
   /* Nudge from coarse data */
   // if true, remap coarse data to fine grid
@@ -30,8 +30,7 @@ void Functions<Real,DefaultDevice>
     const uview_2d<Spack>& qc_tend,
     const uview_2d<Spack>& nc_tend,
     const uview_1d<Scalar>& precip_liq_surf,
-    const uview_1d<bool>& nucleationPossible,
-    const uview_1d<bool>& hydrometeorsPresent)
+    const uview_1d<const Int>& active_cols)
 {
   using ExeSpace = typename KT::ExeSpace;
   const Int nk_pack = ekat::npack<Spack>(nk);
@@ -41,11 +40,8 @@ void Functions<Real,DefaultDevice>
     "p3_cloud_sedimentation",
     policy, KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
+    const Int i = active_cols(team.league_rank());
     auto workspace = workspace_mgr.get_workspace(team);
-    if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
-      return;
-    }
 
     cloud_sedimentation(
       ekat::subview(qc_incld, i), ekat::subview(rho, i), ekat::subview(inv_rho, i), ekat::subview(cld_frac_l, i), 
@@ -27,8 +27,7 @@ void Functions<Real,DefaultDevice>
   const uview_2d<Spack>& ni_tend,
   const view_ice_table& ice_table_vals,
   const uview_1d<Scalar>& precip_ice_surf,
-  const uview_1d<bool>& nucleationPossible,
-  const uview_1d<bool>& hydrometeorsPresent)
+  const uview_1d<const Int>& active_cols)
 {
   using ExeSpace = typename KT::ExeSpace;
   const Int nk_pack = ekat::npack<Spack>(nk);
@@ -37,10 +36,7 @@ void Functions<Real,DefaultDevice>
   Kokkos::parallel_for("p3_ice_sedimentation",
     policy, KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
-    if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
-      return;
-    }
+    const Int i = active_cols(team.league_rank());
     auto workspace = workspace_mgr.get_workspace(team);
 
     // Ice sedimentation:  (adaptive substepping)
@@ -70,8 +66,7 @@ void Functions<Real,DefaultDevice>
   const uview_2d<Spack>& qm,
   const uview_2d<Spack>& bm,
   const uview_2d<Spack>& th_atm,
-  const uview_1d<bool>& nucleationPossible,
-  const uview_1d<bool>& hydrometeorsPresent)
+  const uview_1d<const Int>& active_cols)
 {
   using ExeSpace = typename KT::ExeSpace;
   const Int nk_pack = ekat::npack<Spack>(nk);
@@ -81,10 +76,7 @@ void Functions<Real,DefaultDevice>
     "p3_homogeneous",
     policy, KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
-    if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
-      return;
-    }
+    const Int i = active_cols(team.league_rank());
 
     // homogeneous freezing of cloud and rain
     homogeneous_freezing(
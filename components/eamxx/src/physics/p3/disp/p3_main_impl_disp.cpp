@@ -4,6 +4,8 @@
 #include "physics/share/physics_saturation_impl.hpp"
 #include "ekat/kokkos/ekat_subview_utils.hpp"
 
+#include <Kokkos_Sort.hpp>
+
 namespace scream {
 namespace p3 {
 
@@ -96,6 +98,93 @@ void Functions<Real,DefaultDevice>
  });
 }
 
+template <>
+Int Functions<Real,DefaultDevice>
+::get_active_columns_disp(
+  const Int& nj,
+  const uview_1d<const bool>& nucleationPossible,
+  const uview_1d<const bool>& hydrometeorsPresent,
+  const uview_1d<Int>& active_cols)
+{
+  using ExeSpace = typename KT::ExeSpace;
+  Int nactive = 0;
+  Kokkos::parallel_scan("p3_get_active_columns",
+    Kokkos::RangePolicy<ExeSpace>(0, nj), KOKKOS_LAMBDA(const Int i, Int& offset, const bool final) {
+    if (nucleationPossible(i) || hydrometeorsPresent(i)) {
+      if (final) {
+        active_cols(offset) = i;
+      }
+      ++offset;
+    }
+  }, nactive);
+  return nactive;
+}
+
+template <>
+void Functions<Real,DefaultDevice>
+::sort_active_columns_disp(
+  const Int& nactive,
+  const Int& nk,
+  const uview_2d<const Spack>& qr_incld,
+  const uview_2d<const Spack>& qi_incld,
+  const uview_2d<const Spack>& inv_dz,
+  const uview_1d<Int>& active_cols)
+{
+  using ExeSpace = typename KT::ExeSpace;
+  using RangePolicy = Kokkos::RangePolicy<ExeSpace>;
+
+  if (nactive<2) {
+    return;
+  }
+
+  // Sedimentation substeps each column until its Courant number is consumed, so
+  // the cost of a column grows with max(V*dt/dz). Fall speeds grow with the mixing
+  // ratios, so we use max((qr+qi)/dz) as a cheap estimate, which needs no table lookup.
+  // Store its opposite, so that sorting in ascending order puts costly columns first,
+  // and the teams running them are not left alone at the end of the kernel.
+  const Int nk_pack = ekat::npack<Spack>(nk);
+  view_1d<Scalar> cost("sed_cost", nactive);
+  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(nactive, nk_pack);
+  Kokkos::parallel_for("p3_sed_cost_disp",
+    policy, KOKKOS_LAMBDA(const MemberType& team) {
+
+    const Int i = active_cols(team.league_rank());
+    Scalar col_cost = 0;
+    Kokkos::parallel_reduce(
+      Kokkos::TeamVectorRange(team, nk_pack), [&] (Int k, Scalar& lmax) {
+      const auto in_range = ekat::range<IntSmallPack>(k*Spack::n) < nk;
+      const auto cost_k = max(in_range, 0, (qr_incld(i,k) + qi_incld(i,k)) * inv_dz(i,k));
+      if (cost_k > lmax) lmax = cost_k;
+    }, Kokkos::Max<Scalar>(col_cost));
+
+    Kokkos::single(Kokkos::PerTeam(team), [&] () {
+      cost(team.league_rank()) = -col_cost;
+    });
+  });
+
+  using minmax_t = Kokkos::MinMax<Scalar>;
+  typename minmax_t::value_type minmax;
+  Kokkos::parallel_reduce("p3_sed_cost_range_disp",
+    RangePolicy(0, nactive), KOKKOS_LAMBDA(const Int j, typename minmax_t::value_type& lminmax) {
+    if (cost(j) < lminmax.min_val) lminmax.min_val = cost(j);
+    if (cost(j) > lminmax.max_val) lminmax.max_val = cost(j);
+  }, minmax_t(minmax));
+
+  if (not (minmax.max_val > minmax.min_val)) {
+    // All columns cost the same, nothing to do
+    return;
+  }
+
+  // Binning the columns by cost is enough to even out the trip counts,
+  // there is no need for an exact sort
+  constexpr int num_bins = 32;
+  using bin_op_t = Kokkos::BinOp1D<view_1d<Scalar>>;
+  bin_op_t bin_op(num_bins, minmax.min_val, minmax.max_val);
+  Kokkos::BinSort<view_1d<Scalar>,bin_op_t> sorter(cost, bin_op);
+  sorter.create_permute_vector();
+  sorter.sort(active_cols, 0, nactive);
+}
+
 template <>
 Int Functions<Real,DefaultDevice>
 ::p3_main_internal_disp(
@@ -129,6 +218,9 @@ Int Functions<Real,DefaultDevice>
   view_1d<bool> nucleationPossible("nucleationPossible", nj);
   view_1d<bool> hydrometeorsPresent("hydrometeorsPresent", nj);
 
+  // indices of the columns with work to do after part1
+  view_1d<Int> active_cols("active_cols", nj);
+
   // 
   // Create temporary variables needed for p3
   //
@@ -233,11 +325,15 @@ Int Functions<Real,DefaultDevice>
       bm, qc_incld, qr_incld, qi_incld, qm_incld, nc_incld, nr_incld,
       ni_incld, bm_incld, nucleationPossible, hydrometeorsPresent);
 
+  // Clear-sky columns have nothing left to do: launch the remaining kernels
+  // only over the active ones.
+  Int nactive = get_active_columns_disp(nj, nucleationPossible, hydrometeorsPresent, active_cols);
+
   // ------------------------------------------------------------------------------------------
   // main k-loop (for processes):
 
   p3_main_part2_disp(
-      nj, nk, runtime_options.max_total_ni, infrastructure.predictNc, infrastructure.prescribedCCN, infrastructure.dt, inv_dt,
+      nactive, nk, runtime_options.max_total_ni, infrastructure.predictNc, infrastructure.prescribedCCN, infrastructure.dt, inv_dt,
       lookup_tables.dnu_table_vals, lookup_tables.ice_table_vals, lookup_tables.collect_table_vals, 
       lookup_tables.revap_table_vals, pres, dpres, dz, nc_nuceat_tend, inv_exner,
       exner, inv_cld_frac_l, inv_cld_frac_i, inv_cld_frac_r, ni_activated, inv_qc_relvar, cld_frac_i,
@@ -247,12 +343,16 @@ Int Functions<Real,DefaultDevice>
       nr_incld, ni_incld, bm_incld, mu_c, nu, lamc, cdist, cdist1, cdistr,
       mu_r, lamr, logn0r, qv2qi_depos_tend, precip_total_tend, nevapr, qr_evap_tend,
       vap_liq_exchange, vap_ice_exchange, liq_ice_exchange,
-      pratot, prctot, nucleationPossible, hydrometeorsPresent);
+      pratot, prctot, active_cols, hydrometeorsPresent);
 
   //NOTE: At this point, it is possible to have negative (but small) nc, nr, ni.  This is not
   //      a problem; those values get clipped to zero in the sedimentation section (if necessary).
   //      (This is not done above simply for efficiency purposes.)
 
+  // Part2 may have removed all hydrometeors from some columns
+  nactive = get_active_columns_disp(nj, nucleationPossible, hydrometeorsPresent, active_cols);
+  sort_active_columns_disp(nactive, nk, qr_incld, qi_incld, inv_dz, active_cols);
+
   // -----------------------------------------------------------------------------------------
   // End of main microphysical processes section
   // =========================================================================================
@@ -263,40 +363,40 @@ Int Functions<Real,DefaultDevice>
   // Cloud sedimentation:  (adaptive substepping)
   cloud_sedimentation_disp(
       qc_incld, rho, inv_rho, cld_frac_l, acn, inv_dz, lookup_tables.dnu_table_vals, workspace_mgr,
-      nj, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, infrastructure.predictNc,
+      nactive, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, infrastructure.predictNc,
       qc, nc, nc_incld, mu_c, lamc, qtend_ignore, ntend_ignore,
-      diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent);
+      diagnostic_outputs.precip_liq_surf, active_cols);
 
 
   // Rain sedimentation:  (adaptive substepping)
   rain_sedimentation_disp(
       rho, inv_rho, rhofacr, cld_frac_r, inv_dz, qr_incld, workspace_mgr,
-      lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, nj, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, qr,
+      lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, nactive, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, qr,
       nr, nr_incld, mu_r, lamr, precip_liq_flux, qtend_ignore, ntend_ignore,
-      diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent);
+      diagnostic_outputs.precip_liq_surf, active_cols);
 
   // Ice sedimentation:  (adaptive substepping)
   ice_sedimentation_disp(
-      rho, inv_rho, rhofaci, cld_frac_i, inv_dz, workspace_mgr, nj, nk, ktop, kbot,
+      rho, inv_rho, rhofaci, cld_frac_i, inv_dz, workspace_mgr, nactive, nk, ktop, kbot,
       kdir, infrastructure.dt, inv_dt, qi, qi_incld, ni, ni_incld,
       qm, qm_incld, bm, bm_incld, qtend_ignore, ntend_ignore,
-      lookup_tables.ice_table_vals, diagnostic_outputs.precip_ice_surf, nucleationPossible, hydrometeorsPresent);
+      lookup_tables.ice_table_vals, diagnostic_outputs.precip_ice_surf, active_cols);
 
   // homogeneous freezing f cloud and rain
   homogeneous_freezing_disp(
-      T_atm, inv_exner, latent_heat_fusion, nj, nk, ktop, kbot, kdir, qc, nc, qr, nr, qi,
-      ni, qm, bm, th, nucleationPossible, hydrometeorsPresent);
+      T_atm, inv_exner, latent_heat_fusion, nactive, nk, ktop, kbot, kdir, qc, nc, qr, nr, qi,
+      ni, qm, bm, th, active_cols);
 
   //
   // final checks to ensure consistency of mass/number
   // and compute diagnostic fields for output
   //
   p3_main_part3_disp(
-      nj, nk_pack, runtime_options.max_total_ni, lookup_tables.dnu_table_vals, lookup_tables.ice_table_vals, inv_exner, cld_frac_l, cld_frac_r, cld_frac_i,
+      nactive, nk_pack, runtime_options.max_total_ni, lookup_tables.dnu_table_vals, lookup_tables.ice_table_vals, inv_exner, cld_frac_l, cld_frac_r, cld_frac_i,
       rho, inv_rho, rhofaci, qv, th, qc, nc, qr, nr, qi, ni,
       qm, bm, latent_heat_vapor, latent_heat_sublim, mu_c, nu, lamc, mu_r, lamr,
       vap_liq_exchange, ze_rain, ze_ice, diag_vm_qi, diag_eff_radius_qi, diag_diam_qi,
-      rho_qi, diag_equiv_reflectivity, diag_eff_radius_qc, diag_eff_radius_qr, nucleationPossible, hydrometeorsPresent);
+      rho_qi, diag_equiv_reflectivity, diag_eff_radius_qc, diag_eff_radius_qr, active_cols);
 
   //
   // merge ice categories with similar properties
@@ -88,7 +88,7 @@ void Functions<Real,DefaultDevice>
   const uview_2d<Spack>& liq_ice_exchange,
   const uview_2d<Spack>& pratot,
   const uview_2d<Spack>& prctot,
-  const uview_1d<bool>& nucleationPossible,
+  const uview_1d<const Int>& active_cols,
   const uview_1d<bool>& hydrometeorsPresent)
 {
   using ExeSpace = typename KT::ExeSpace;
@@ -99,10 +99,7 @@ void Functions<Real,DefaultDevice>
     "p3_main_part2_disp",
     policy, KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
-    if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
-      return; 
-    }
+    const Int i = active_cols(team.league_rank());
 
     // ------------------------------------------------------------------------------------------
     // main k-loop (for processes):
@@ -55,8 +55,7 @@ void Functions<Real,DefaultDevice>
   const uview_2d<Spack>& diag_equiv_reflectivity,
   const uview_2d<Spack>& diag_eff_radius_qc,
   const uview_2d<Spack>& diag_eff_radius_qr,
-  const uview_1d<bool>& nucleationPossible,
-  const uview_1d<bool>& hydrometeorsPresent)
+  const uview_1d<const Int>& active_cols)
 {
   using ExeSpace = typename KT::ExeSpace;
   const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(nj, nk_pack);
@@ -65,10 +64,7 @@ void Functions<Real,DefaultDevice>
     "p3_main_part3_disp",
     policy, KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
-    if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
-      return;
-    }
+    const Int i = active_cols(team.league_rank());
 
     //
     // final checks to ensure consistency of mass/number
@@ -26,8 +26,7 @@ void Functions<Real,DefaultDevice>
   const uview_2d<Spack>& qr_tend,
   const uview_2d<Spack>& nr_tend,
   const uview_1d<Scalar>& precip_liq_surf,
-  const uview_1d<bool>& nucleationPossible,
-  const uview_1d<bool>& hydrometeorsPresent)
+  const uview_1d<const Int>& active_cols)
 {
   using ExeSpace = typename KT::ExeSpace;
   const Int nk_pack = ekat::npack<Spack>(nk);
@@ -36,11 +35,8 @@ void Functions<Real,DefaultDevice>
   Kokkos::parallel_for("p3_rain_sed_disp",
     policy, KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
+    const Int i = active_cols(team.league_rank());
     auto workspace = workspace_mgr.get_workspace(team);
-    if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
-      return;
-    }
 
     // Rain sedimentation:  (adaptive substepping)
     rain_sedimentation(
@@ -89,9 +89,10 @@ void Functions<S,D>
                       view_dnu_table& dnu) {
   // initialize on host
 
-  using DeviceTable1   = typename view_1d_table::non_const_type;
-  using DeviceTable2   = typename view_2d_table::non_const_type;
-  using DeviceDnuTable = typename view_dnu_table::non_const_type;
+  // The RandomAccess trait is only meant for const data, so fill plain views
+  using DeviceTable1   = typename KT::template view<typename view_1d_table::non_const_data_type>;
+  using DeviceTable2   = typename KT::template view<typename view_2d_table::non_const_data_type>;
+  using DeviceDnuTable = typename KT::template view<typename view_dnu_table::non_const_data_type>;
 
   const auto vn_table_vals_d    = DeviceTable2("vn_table_vals");
   const auto vm_table_vals_d    = DeviceTable2("vm_table_vals");
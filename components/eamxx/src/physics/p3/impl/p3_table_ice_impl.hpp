@@ -3,7 +3,14 @@
 
 #include "p3_functions.hpp" // for ETI only but harmless for GPU
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <unistd.h>
 
 namespace scream {
 namespace p3 {
@@ -13,12 +20,126 @@ namespace p3 {
  * this file, #include p3_functions.hpp instead.
  */
 
+namespace impl {
+
+// FNV-1a hash, used to key and checksum the binary cache of the ice lookup tables
+inline std::uint64_t hash_bytes (const void* data, const std::size_t nbytes,
+                                  std::uint64_t h = 14695981039346656037ull)
+{
+  const auto bytes = reinterpret_cast<const unsigned char*>(data);
+  for (std::size_t n=0; n<nbytes; ++n) {
+    h ^= bytes[n];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+constexpr char ice_tables_cache_magic[8] = {'P','3','T','A','B','L','E','S'};
+
+} // namespace impl
+
+template <typename S, typename D>
+std::uint64_t Functions<S,D>
+::ice_lookup_tables_cache_key ()
+{
+  // Any change to the table version, sizes, or precision invalidates the cache
+  const std::string version = P3C::p3_version;
+  const std::int64_t params[] = {P3C::densize, P3C::rimsize, P3C::isize, P3C::rcollsize,
+                                 P3C::ice_table_size, P3C::collect_table_size,
+                                 static_cast<std::int64_t>(sizeof(S))};
+  const auto h = impl::hash_bytes(version.data(),version.size());
+  return impl::hash_bytes(params,sizeof(params),h);
+}
+
+template <typename S, typename D>
+template <typename IceTableH, typename CollectTableH>
+bool Functions<S,D>
+::read_ice_lookup_tables_cache (const std::string& filename,
+                                const IceTableH& ice_table_vals_h,
+                                const CollectTableH& collect_table_vals_h)
+{
+  std::ifstream in(filename, std::ios::binary);
+  if (not in.good()) {
+    return false;
+  }
+
+  const auto ice_size = ice_table_vals_h.size();
+  const auto collect_size = collect_table_vals_h.size();
+
+  char magic[8];
+  std::uint64_t key, checksum;
+  in.read(magic,sizeof(magic));
+  in.read(reinterpret_cast<char*>(&key),sizeof(key));
+  in.read(reinterpret_cast<char*>(&checksum),sizeof(checksum));
+  if (not in.good() or
+      not std::equal(magic,magic+8,impl::ice_tables_cache_magic) or
+      key!=ice_lookup_tables_cache_key()) {
+    return false;
+  }
+
+  // Read into temporaries, so that the output views are untouched on failure
+  std::vector<S> ice(ice_size), collect(collect_size);
+  in.read(reinterpret_cast<char*>(ice.data()),ice_size*sizeof(S));
+  in.read(reinterpret_cast<char*>(collect.data()),collect_size*sizeof(S));
+  if (not in.good()) {
+    return false;
+  }
+  auto h = impl::hash_bytes(ice.data(),ice_size*sizeof(S));
+  h = impl::hash_bytes(collect.data(),collect_size*sizeof(S),h);
+  if (h!=checksum) {
+    return false;
+  }
+
+  std::copy(ice.begin(),ice.end(),ice_table_vals_h.data());
+  std::copy(collect.begin(),collect.end(),collect_table_vals_h.data());
+  return true;
+}
+
+template <typename S, typename D>
+template <typename IceTableH, typename CollectTableH>
+void Functions<S,D>
+::write_ice_lookup_tables_cache (const std::string& filename,
+                                 const IceTableH& ice_table_vals_h,
+                                 const CollectTableH& collect_table_vals_h)
+{
+  const auto ice_size = ice_table_vals_h.size();
+  const auto collect_size = collect_table_vals_h.size();
+  const std::uint64_t key = ice_lookup_tables_cache_key();
+  auto checksum = impl::hash_bytes(ice_table_vals_h.data(),ice_size*sizeof(S));
+  checksum = impl::hash_bytes(collect_table_vals_h.data(),collect_size*sizeof(S),checksum);
+
+  // Write to a rank-unique tmp file, then rename it, so that concurrent
+  // writers never leave a partially written cache behind
+  std::ostringstream tmp_name;
+  tmp_name << filename << ".tmp." << ::getpid();
+  {
+    std::ofstream out(tmp_name.str(), std::ios::binary);
+    if (not out.good()) {
+      return;
+    }
+    out.write(impl::ice_tables_cache_magic,sizeof(impl::ice_tables_cache_magic));
+    out.write(reinterpret_cast<const char*>(&key),sizeof(key));
+    out.write(reinterpret_cast<const char*>(&checksum),sizeof(checksum));
+    out.write(reinterpret_cast<const char*>(ice_table_vals_h.data()),ice_size*sizeof(S));
+    out.write(reinterpret_cast<const char*>(collect_table_vals_h.data()),collect_size*sizeof(S));
+    if (not out.good()) {
+      out.close();
+      std::remove(tmp_name.str().c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_name.str().c_str(),filename.c_str())!=0) {
+    std::remove(tmp_name.str().c_str());
+  }
+}
+
 template <typename S, typename D>
 void Functions<S,D>
 ::init_kokkos_ice_lookup_tables(view_ice_table& ice_table_vals, view_collect_table& collect_table_vals) {
 
-  using DeviceIcetable = typename view_ice_table::non_const_type;
-  using DeviceColtable = typename view_collect_table::non_const_type;
+  // The RandomAccess trait is only meant for const data, so fill plain views
+  using DeviceIcetable = typename KT::template view<typename view_ice_table::non_const_data_type>;
+  using DeviceColtable = typename KT::template view<typename view_collect_table::non_const_data_type>;
 
   const auto ice_table_vals_d     = DeviceIcetable("ice_table_vals");
   const auto collect_table_vals_d = DeviceColtable("collect_table_vals");
@@ -32,42 +153,53 @@ void Functions<S,D>
 
   std::string filename = std::string(P3C::p3_lookup_base) + std::string(P3C::p3_version);
 
-  std::ifstream in(filename);
-
-  // read header
-  std::string version, version_val;
-  in >> version >> version_val;
-  EKAT_REQUIRE_MSG(version == "VERSION", "Bad " << filename << ", expected VERSION X.Y.Z header");
-  EKAT_REQUIRE_MSG(version_val == P3C::p3_version, "Bad " << filename << ", expected version " << P3C::p3_version << ", but got " << version_val);
-
-  // read tables
-  double dum_s; int dum_i; // dum_s needs to be double to stream correctly
-  for (int jj = 0; jj < P3C::densize; ++jj) {
-    for (int ii = 0; ii < P3C::rimsize; ++ii) {
-      for (int i = 0; i < P3C::isize; ++i) {
-        in >> dum_i >> dum_i;
-        int j_idx = 0;
-        for (int j = 0; j < 15; ++j) {
-          in >> dum_s;
-          if (j > 1 && j != 10) {
-            ice_table_vals_h(jj, ii, i, j_idx++) = dum_s;
+  // Parsing the ascii table is slow, so, the first time it is parsed, the host
+  // tables are stored in a binary cache next to it. The cache is keyed on the
+  // table version, the table sizes, and the size of Scalar, and it is only
+  // used if its key and payload checksum match. Otherwise, it is regenerated.
+  const std::string cache_filename = filename + (sizeof(Scalar)==sizeof(double) ? ".dbl.bin" : ".flt.bin");
+  if (not read_ice_lookup_tables_cache(cache_filename, ice_table_vals_h, collect_table_vals_h)) {
+    std::ifstream in(filename);
+    EKAT_REQUIRE_MSG(in.good(), "Error! Could not open P3 lookup table file " << filename << "\n");
+
+    // read header
+    std::string version, version_val;
+    in >> version >> version_val;
+    EKAT_REQUIRE_MSG(version == "VERSION", "Bad " << filename << ", expected VERSION X.Y.Z header");
+    EKAT_REQUIRE_MSG(version_val == P3C::p3_version, "Bad " << filename << ", expected version " << P3C::p3_version << ", but got " << version_val);
+
+    // read tables
+    double dum_s; int dum_i; // dum_s needs to be double to stream correctly
+    for (int jj = 0; jj < P3C::densize; ++jj) {
+      for (int ii = 0; ii < P3C::rimsize; ++ii) {
+        for (int i = 0; i < P3C::isize; ++i) {
+          in >> dum_i >> dum_i;
+          int j_idx = 0;
+          for (int j = 0; j < 15; ++j) {
+            in >> dum_s;
+            if (j > 1 && j != 10) {
+              ice_table_vals_h(jj, ii, i, j_idx++) = dum_s;
+            }
           }
         }
-      }
 
-      for (int i = 0; i < P3C::isize; ++i) {
-        for (int j = 0; j < P3C::rcollsize; ++j) {
-          in >> dum_i >> dum_i;
-          int k_idx = 0;
-          for (int k = 0; k < 6; ++k) {
-            in >> dum_s;
-            if (k == 3 || k == 4) {
-              collect_table_vals_h(jj, ii, i, j, k_idx++) = std::log10(dum_s);
+        for (int i = 0; i < P3C::isize; ++i) {
+          for (int j = 0; j < P3C::rcollsize; ++j) {
+            in >> dum_i >> dum_i;
+            int k_idx = 0;
+            for (int k = 0; k < 6; ++k) {
+              in >> dum_s;
+              if (k == 3 || k == 4) {
+                collect_table_vals_h(jj, ii, i, j, k_idx++) = std::log10(dum_s);
+              }
             }
           }
         }
       }
     }
+
+    // Failing to write the cache (e.g., read-only data dir) is not an error
+    write_ice_lookup_tables_cache(cache_filename, ice_table_vals_h, collect_table_vals_h);
   }
 
   // deep copy to device
@@ -8,6 +8,9 @@
 #include "ekat/ekat_pack_kokkos.hpp"
 #include "ekat/ekat_workspace.hpp"
 
+#include <cstdint>
+#include <string>
+
 namespace scream {
 namespace p3 {
 
@@ -60,7 +63,7 @@ struct Functions
   template <typename S>
   using BigPack = ekat::Pack<S,SCREAM_PACK_SIZE>;
   template <typename S>
-  using SmallPack = ekat::Pack<S,SCREAM_SMALL_PACK_SIZE>;
+  using SmallPack = ekat::Pack<S,SCREAM_P3_SMALL_PACK_SIZE>;
 
   using IntSmallPack = SmallPack<Int>;
   using Pack = BigPack<Scalar>;
@@ -78,21 +81,29 @@ struct Functions
   template <typename S>
   using view_2d = typename KT::template view_2d<S>;
 
+  // The lookup tables are read-only after init, and are gathered from at
+  // scattered locations, so access them through the read-only data cache
+  // (texture/__ldg on CUDA). The quantities needed at one interpolation point
+  // are the fastest index, so they are contiguous in memory.
+  template <typename DataType>
+  using view_table = Kokkos::View<const DataType, typename KT::Layout, typename KT::Device,
+                                  Kokkos::MemoryTraits<Kokkos::RandomAccess>>;
+
   // lookup table values for rain shape parameter mu_r
-  using view_1d_table = typename KT::template view_1d_table<Scalar, C::MU_R_TABLE_DIM>;
+  using view_1d_table = view_table<Scalar[C::MU_R_TABLE_DIM]>;
 
   // lookup table values for rain number- and mass-weighted fallspeeds and ventilation parameters
-  using view_2d_table = typename KT::template view_2d_table<Scalar, C::VTABLE_DIM0, C::VTABLE_DIM1>;
+  using view_2d_table = view_table<Scalar[C::VTABLE_DIM0][C::VTABLE_DIM1]>;
 
   // ice lookup table values
-  using view_ice_table    = typename KT::template view<const Scalar[P3C::densize][P3C::rimsize][P3C::isize][P3C::ice_table_size]>;
+  using view_ice_table    = view_table<Scalar[P3C::densize][P3C::rimsize][P3C::isize][P3C::ice_table_size]>;
 
   // ice lookup table values for ice-rain collision/collection
-  using view_collect_table = typename KT::template view<const Scalar[P3C::densize][P3C::rimsize][P3C::isize][P3C::rcollsize][P3C::collect_table_size]>;
+  using view_collect_table = view_table<Scalar[P3C::densize][P3C::rimsize][P3C::isize][P3C::rcollsize][P3C::collect_table_size]>;
 
   // droplet spectral shape parameter for mass spectra, used for Seifert and Beheng (2001)
   // warm rain autoconversion/accretion option only (iparam = 1)
-  using view_dnu_table = typename KT::template view_1d_table<Scalar, P3C::dnusize>;
+  using view_dnu_table = view_table<Scalar[P3C::dnusize]>;
 
   template <typename S, int N>
   using view_1d_ptr_array = typename KT::template view_1d_ptr_carray<S, N>;
@@ -270,6 +281,19 @@ struct Functions
   static void init_kokkos_ice_lookup_tables(
     view_ice_table& ice_table_vals, view_collect_table& collect_table_vals);
 
+  // Binary cache of the host ice/collection tables, which spares the parsing
+  // of the ascii lookup table. The read returns false if the cache is missing,
+  // stale (different version, sizes, or precision), or corrupted.
+  static std::uint64_t ice_lookup_tables_cache_key();
+
+  template <typename IceTableH, typename CollectTableH>
+  static bool read_ice_lookup_tables_cache(const std::string& filename,
+    const IceTableH& ice_table_vals_h, const CollectTableH& collect_table_vals_h);
+
+  template <typename IceTableH, typename CollectTableH>
+  static void write_ice_lookup_tables_cache(const std::string& filename,
+    const IceTableH& ice_table_vals_h, const CollectTableH& collect_table_vals_h);
+
   // Map (mu_r, lamr) to Table3 data.
   KOKKOS_FUNCTION
   static void lookup(const Spack& mu_r, const Spack& lamr,
@@ -416,6 +440,8 @@ struct Functions
     Scalar& precip_liq_surf);
 
 #ifdef SCREAM_SMALL_KERNELS
+  // The kernels of the small-kernels version of p3_main that follow part1 are
+  // launched only over the nj columns listed in active_cols (see get_active_columns_disp).
   static void cloud_sedimentation_disp(
     const uview_2d<Spack>& qc_incld,
     const uview_2d<const Spack>& rho,
@@ -435,8 +461,7 @@ struct Functions
     const uview_2d<Spack>& qc_tend,
     const uview_2d<Spack>& nc_tend,
     const uview_1d<Scalar>& precip_liq_surf,
-    const uview_1d<bool>& is_nucleat_possible,
-    const uview_1d<bool>& is_hydromet_present);
+    const uview_1d<const Int>& active_cols);
 #endif
 
   // TODO: comment
@@ -482,8 +507,7 @@ struct Functions
     const uview_2d<Spack>& qr_tend,
     const uview_2d<Spack>& nr_tend,
     const uview_1d<Scalar>& precip_liq_surf,
-    const uview_1d<bool>& is_nucleat_possible,
-    const uview_1d<bool>& is_hydromet_present);
+    const uview_1d<const Int>& active_cols);
 #endif
 
   // TODO: comment
@@ -531,8 +555,7 @@ struct Functions
     const uview_2d<Spack>& ni_tend,
     const view_ice_table& ice_table_vals,
     const uview_1d<Scalar>& precip_ice_surf,
-    const uview_1d<bool>& is_nucleat_possible,
-    const uview_1d<bool>& is_hydromet_present);
+    const uview_1d<const Int>& active_cols);
 #endif
 
   // homogeneous freezing of cloud and rain
@@ -568,8 +591,7 @@ struct Functions
     const uview_2d<Spack>& qm,
     const uview_2d<Spack>& bm,
     const uview_2d<Spack>& th_atm,
-    const uview_1d<bool>& is_nucleat_possible,
-    const uview_1d<bool>& is_hydromet_present);
+    const uview_1d<const Int>& active_cols);
 #endif
 
   // -- Find layers
@@ -1092,6 +1114,24 @@ struct Functions
     const Int& nk);
 
 #ifdef SCREAM_SMALL_KERNELS
+  // Store in active_cols the indices of the columns where nucleation is possible
+  // or hydrometeors are present, and return how many there are.
+  static Int get_active_columns_disp(
+    const Int& nj,
+    const uview_1d<const bool>& is_nucleat_possible,
+    const uview_1d<const bool>& is_hydromet_present,
+    const uview_1d<Int>& active_cols);
+
+  // Reorder the first nj entries of active_cols so that the columns likely to
+  // need more sedimentation substeps come first.
+  static void sort_active_columns_disp(
+    const Int& nj,
+    const Int& nk,
+    const uview_2d<const Spack>& qr_incld,
+    const uview_2d<const Spack>& qi_incld,
+    const uview_2d<const Spack>& inv_dz,
+    const uview_1d<Int>& active_cols);
+
   static void p3_main_part2_disp(
     const Int& nj,
     const Int& nk,
@@ -1168,7 +1208,7 @@ struct Functions
     const uview_2d<Spack>& liq_ice_exchange,
     const uview_2d<Spack>& pratot,
     const uview_2d<Spack>& prctot,
-    const uview_1d<bool>& is_nucleat_possible,
+    const uview_1d<const Int>& active_cols,
     const uview_1d<bool>& is_hydromet_present);
 #endif
 
@@ -1255,8 +1295,7 @@ struct Functions
     const uview_2d<Spack>& diag_equiv_reflectivity,
     const uview_2d<Spack>& diag_eff_radius_qc,
     const uview_2d<Spack>& diag_eff_radius_qr,
-    const uview_1d<bool>& is_nucleat_possible,
-    const uview_1d<bool>& is_hydromet_present);
+    const uview_1d<const Int>& active_cols);
 #endif
 
   // Return microseconds elapsed
@@ -96,7 +96,7 @@ struct Baseline {
                     << ", prescribed_CCN=" << d->do_prescribed_CCN;
 
           if (!use_fortran) {
-            std::cout << ", small_packn=" << SCREAM_SMALL_PACK_SIZE;
+            std::cout << ", small_packn=" << SCREAM_P3_SMALL_PACK_SIZE;
           }
           std::cout << std::endl;
         }
@@ -41,7 +41,7 @@ struct UnitWrap::UnitTest<D>::TestUpwind {
 static void run_phys()
 {
   using ekat::repack;
-  constexpr auto SPS = SCREAM_SMALL_PACK_SIZE;
+  constexpr auto SPS = SCREAM_P3_SMALL_PACK_SIZE;
 
   static const Int nfield = 2;
 
@@ -8,6 +8,7 @@
 #include "share/property_checks/field_within_interval_check.hpp"
 #include "share/util/scream_common_physics_functions.hpp"
 #include "share/util/scream_column_ops.hpp"
+#include "share/util/scream_utils.hpp"
 
 #include "ekat/ekat_assert.hpp"
 
@@ -63,21 +64,43 @@ void RRTMGPRadiation::set_grids(const std::shared_ptr<const GridsManager> grids_
   m_lat  = m_grid->get_geometry_data("lat");
   m_lon  = m_grid->get_geometry_data("lon");
 
-  // Figure out radiation column chunks stats
-  m_col_chunk_size = std::min(m_params.get("column_chunk_size", m_ncol),m_ncol);
-  m_num_col_chunks = (m_ncol+m_col_chunk_size-1) / m_col_chunk_size;
+  // Set up dimension layouts
+  m_nswgpts = m_params.get<int>("nswgpts",112);
+  m_nlwgpts = m_params.get<int>("nlwgpts",128);
+
+  // Optionally, only compute radiation on one every m_col_stride columns,
+  // and fill the others from the computed ones.
+  m_col_stride = m_params.get<int>("column_subsample_stride",1);
+  EKAT_REQUIRE_MSG (m_col_stride>=1,
+      "Error! Invalid value for column_subsample_stride: " + std::to_string(m_col_stride) + "\n"
+      "       Valid values are >= 1.\n");
+  m_ncol_rad = (m_ncol+m_col_stride-1) / m_col_stride;
+
+  // Figure out radiation column chunks stats. A non-positive chunk size means
+  // the chunk size is chosen so that the chunk memory fits in a fraction of the
+  // device memory (on CPU, or if the device memory is unknown, use one chunk).
+  m_col_chunk_size = m_params.get("column_chunk_size", m_ncol_rad);
+  if (m_col_chunk_size<=0) {
+    const auto mem_fraction = m_params.get<double>("column_chunk_memory_fraction",0.25);
+    EKAT_REQUIRE_MSG (mem_fraction>0 and mem_fraction<=1,
+        "Error! Invalid value for column_chunk_memory_fraction: " + std::to_string(mem_fraction) + "\n"
+        "       Valid values are in (0,1].\n");
+    const size_t dev_mem = get_device_mem_size();
+    m_col_chunk_size = dev_mem==0 ? m_ncol_rad
+                     : std::max(1,static_cast<int>(mem_fraction*dev_mem / chunk_mem_per_col_in_bytes()));
+  }
+  m_col_chunk_size = std::min(m_col_chunk_size,m_ncol_rad);
+  m_num_col_chunks = (m_ncol_rad+m_col_chunk_size-1) / m_col_chunk_size;
   m_col_chunk_beg.resize(m_num_col_chunks+1,0);
   for (int i=0; i<m_num_col_chunks; ++i) {
-    m_col_chunk_beg[i+1] = std::min(m_ncol,m_col_chunk_beg[i] + m_col_chunk_size);
+    m_col_chunk_beg[i+1] = std::min(m_ncol_rad,m_col_chunk_beg[i] + m_col_chunk_size);
   }
   this->log(LogLevel::debug,
             "[RRTMGP::set_grids] Col chunking stats:\n"
+            "  - Column subsampling stride: " + std::to_string(m_col_stride) + "\n"
             "  - Chunk size: " + std::to_string(m_col_chunk_size) + "\n"
             "  - Number of chunks: " + std::to_string(m_num_col_chunks) + "\n");
 
-  // Set up dimension layouts
-  m_nswgpts = m_params.get<int>("nswgpts",112);
-  m_nlwgpts = m_params.get<int>("nlwgpts",128);
   FieldLayout scalar2d_layout     { {COL   }, {m_ncol    } };
   FieldLayout scalar3d_layout_mid { {COL,LEV}, {m_ncol,m_nlay} };
   FieldLayout scalar3d_layout_int { {COL,ILEV}, {m_ncol,m_nlay+1} };
@@ -196,21 +219,36 @@ void RRTMGPRadiation::set_grids(const std::shared_ptr<const GridsManager> grids_
   }
 }  // RRTMGPRadiation::set_grids
 
-size_t RRTMGPRadiation::requested_buffer_size_in_bytes() const
+size_t RRTMGPRadiation::buffer_size_per_col_in_bytes() const
 {
   const size_t interface_request =
-    Buffer::num_1d_ncol*m_col_chunk_size +
-    Buffer::num_2d_nlay*m_col_chunk_size*m_nlay +
-    Buffer::num_2d_nlay_p1*m_col_chunk_size*(m_nlay+1) +
-    Buffer::num_2d_nswbands*m_col_chunk_size*m_nswbands +
-    Buffer::num_3d_nlev_nswbands*m_col_chunk_size*(m_nlay+1)*m_nswbands +
-    Buffer::num_3d_nlev_nlwbands*m_col_chunk_size*(m_nlay+1)*m_nlwbands +
-    Buffer::num_3d_nlay_nswbands*m_col_chunk_size*(m_nlay)*m_nswbands +
-    Buffer::num_3d_nlay_nlwbands*m_col_chunk_size*(m_nlay)*m_nlwbands +
-    Buffer::num_3d_nlay_nswgpts*m_col_chunk_size*(m_nlay)*m_nswgpts +
-    Buffer::num_3d_nlay_nlwgpts*m_col_chunk_size*(m_nlay)*m_nlwgpts;
+    Buffer::num_1d_ncol +
+    Buffer::num_2d_nlay*m_nlay +
+    Buffer::num_2d_nlay_p1*(m_nlay+1) +
+    Buffer::num_2d_nswbands*m_nswbands +
+    Buffer::num_3d_nlev_nswbands*(m_nlay+1)*m_nswbands +
+    Buffer::num_3d_nlev_nlwbands*(m_nlay+1)*m_nlwbands +
+    Buffer::num_3d_nlay_nswbands*(m_nlay)*m_nswbands +
+    Buffer::num_3d_nlay_nlwbands*(m_nlay)*m_nlwbands +
+    Buffer::num_3d_nlay_nswgpts*(m_nlay)*m_nswgpts +
+    Buffer::num_3d_nlay_nlwgpts*(m_nlay)*m_nlwgpts;
 
   return interface_request * sizeof(Real);
+}
+
+size_t RRTMGPRadiation::chunk_mem_per_col_in_bytes() const
+{
+  // Besides our buffer, rrtmgp allocates its own temporaries for each chunk.
+  // The largest are the gas/cloud optical properties and the Planck sources,
+  // which amount to a handful of (nlay+1,ngpt) arrays per column. Use a rough
+  // (conservative) estimate of 8 such arrays per band set.
+  const size_t rrtmgp_request = 8*(m_nlay+1)*(m_nswgpts+m_nlwgpts);
+  return buffer_size_per_col_in_bytes() + rrtmgp_request*sizeof(Real);
+}
+
+size_t RRTMGPRadiation::requested_buffer_size_in_bytes() const
+{
+  return buffer_size_per_col_in_bytes()*m_col_chunk_size;
 } // RRTMGPRadiation::requested_buffer_size
 // =========================================================================================
 
@@ -394,6 +432,10 @@ void RRTMGPRadiation::initialize_impl(const RunType /* run_type */) {
   // Whether or not to do MCICA subcolumn sampling
   m_do_subcol_sampling = m_params.get<bool>("do_subcol_sampling",true);
 
+  if (m_col_stride>1) {
+    m_cosine_zenith_all = view_1d_real("cosine_zenith_all",m_ncol);
+  }
+
   // Initialize yakl
   yakl_init();
 
@@ -540,6 +582,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
   const auto nswbands = m_nswbands;
   const auto nlwgpts = m_nlwgpts;
   const auto do_aerosol_rad = m_do_aerosol_rad;
+  const auto stride = m_col_stride;
 
   // Are we going to update fluxes and heating this step?
   auto ts = timestamp();
@@ -582,6 +625,10 @@ void RRTMGPRadiation::run_impl (const double dt) {
     // o3 is computed elsewhere (either read from file or computed by chemistry);
     // n2 and co are set to constants and are not handled by trcmix;
     // the rest are handled by trcmix
+    // The prescribed gases (all but h2o) only depend on constant VMR values and on p_mid,
+    // so we can skip them if they were already computed (o2 and co2 do not even depend on p_mid).
+    const auto& pmid_ts = get_field_in("p_mid").get_header().get_tracking().get_time_stamp();
+    const bool pmid_changed = not (m_prescribed_gases_pmid_ts.is_valid() and pmid_ts==m_prescribed_gases_pmid_ts);
     const auto gas_mol_weights = m_gas_mol_weights;
     for (int igas = 0; igas < m_ngas; igas++) {
       auto name = m_gas_names[igas];
@@ -590,6 +637,12 @@ void RRTMGPRadiation::run_impl (const double dt) {
       // as a constant value, read from file during init. Skip these.
       if (name=="o3" or name == "n2" or name == "co") continue;
 
+      if (name=="o2" or name=="co2") {
+        if (m_const_gases_set) continue;
+      } else if (name!="h2o" and not pmid_changed) {
+        continue;
+      }
+
       auto d_vmr = get_field_out(name + "_volume_mix_ratio").get_view<Real**>();
       if (name == "h2o") {
         // h2o is (wet) mass mixing ratio in FM, otherwise known as "qv", which we've already read in above
@@ -619,6 +672,8 @@ void RRTMGPRadiation::run_impl (const double dt) {
         });
       }
     }
+    m_const_gases_set = true;
+    m_prescribed_gases_pmid_ts = pmid_ts;
 
     // Loop over each chunk of columns
     for (int ic=0; ic<m_num_col_chunks; ++ic) {
@@ -719,8 +774,8 @@ void RRTMGPRadiation::run_impl (const double dt) {
         } else {
           // Now use solar declination to calculate zenith angle for all points
           for (int i=0;i<ncol;i++) {
-            double lat = h_lat(i+beg)*PC::Pi/180.0;  // Convert lat/lon to radians
-            double lon = h_lon(i+beg)*PC::Pi/180.0;
+            double lat = h_lat((i+beg)*stride)*PC::Pi/180.0;  // Convert lat/lon to radians
+            double lon = h_lon((i+beg)*stride)*PC::Pi/180.0;
             h_mu0(i) = shr_orb_cosz_c2f(calday, lat, lon, delta, m_rad_freq_in_steps * dt);
           }
         }
@@ -729,7 +784,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
         const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(ncol, m_nlay);
         Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
           const int i = team.league_rank();
-          const int icol = i+beg;
+          const int icol = (i+beg)*stride;
 
           // Calculate dz
           const auto pseudo_density = ekat::subview(d_pdel, icol);
@@ -833,7 +888,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
         const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(ncol, m_nlay);
         Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
           const int i = team.league_rank();
-          const int icol = i + beg;
+          const int icol = (i + beg)*stride;
           Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlay), [&] (const int& k) {
             tmp2d(i+1,k+1) = d_vmr(icol,k); // Note that for YAKL arrays i and k start with index 1
           });
@@ -861,7 +916,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
         const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(ncol, m_nlay);
         Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
           const int i = team.league_rank();
-          const int icol = i + beg;
+          const int icol = (i + beg)*stride;
           Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlay), [&] (const int& k) {
             if (d_cldfrac_tot(icol,k) > 0) {
               cldfrac_tot(i+1,k+1) = 1;
@@ -874,7 +929,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
         const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(ncol, m_nlay);
         Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
           const int i = team.league_rank();
-          const int icol = i + beg;
+          const int icol = (i + beg)*stride;
           Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlay), [&] (const int& k) {
             cldfrac_tot(i+1,k+1) = d_cldfrac_tot(icol,k);
           });
@@ -943,7 +998,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
         const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(ncol, m_nlay);
         Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
           const int idx = team.league_rank();
-          const int icol = idx+beg;
+          const int icol = (idx+beg)*stride;
           Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlay), [&] (const int& ilay) {
             // Combine SW and LW heating into a net heating tendency; use d_rad_heating_pdel temporarily
             // Note that for YAKL arrays i and k start with index 1
@@ -973,11 +1028,19 @@ void RRTMGPRadiation::run_impl (const double dt) {
           sfc_flux_dif_vis, sfc_flux_dif_nir
       );
 
+      // Diagnostics are computed directly in the output fields, unless the columns
+      // are subsampled, in which case the chunk columns are not contiguous in the
+      // fields, and we compute them in temporaries and copy them back later.
+      auto diag_1d = [&](const std::string& name, const decltype(d_cldlow)& v) -> real1d {
+        return stride==1 ? real1d(name.c_str(), v.data() + beg, ncol)
+                         : real1d(name.c_str(), ncol);
+      };
+
       // Compute diagnostic total cloud area (vertically-projected cloud cover)
-      real1d cldlow ("cldlow", d_cldlow.data() + m_col_chunk_beg[ic], ncol);
-      real1d cldmed ("cldmed", d_cldmed.data() + m_col_chunk_beg[ic], ncol);
-      real1d cldhgh ("cldhgh", d_cldhgh.data() + m_col_chunk_beg[ic], ncol);
-      real1d cldtot ("cldtot", d_cldtot.data() + m_col_chunk_beg[ic], ncol);
+      auto cldlow = diag_1d("cldlow", d_cldlow);
+      auto cldmed = diag_1d("cldmed", d_cldmed);
+      auto cldhgh = diag_1d("cldhgh", d_cldhgh);
+      auto cldtot = diag_1d("cldtot", d_cldtot);
       // NOTE: limits for low, mid, and high clouds are mostly taken from EAM F90 source, with the
       // exception that I removed the restriction on low clouds to be above (numerically lower pressures)
       // 1200 hPa, and on high clouds to be below (numerically high pressures) 50 hPa. This probably
@@ -995,14 +1058,14 @@ void RRTMGPRadiation::run_impl (const double dt) {
       auto idx_105 = rrtmgp::get_wavelength_index_lw(10.5e-6);
 
       // Compute cloud-top diagnostics following AeroCOM recommendation
-      real1d T_mid_at_cldtop ("T_mid_at_cldtop", d_T_mid_at_cldtop.data() + m_col_chunk_beg[ic], ncol);
-      real1d p_mid_at_cldtop ("p_mid_at_cldtop", d_p_mid_at_cldtop.data() + m_col_chunk_beg[ic], ncol);
-      real1d cldfrac_ice_at_cldtop ("cldfrac_ice_at_cldtop", d_cldfrac_ice_at_cldtop.data() + m_col_chunk_beg[ic], ncol);
-      real1d cldfrac_liq_at_cldtop ("cldfrac_liq_at_cldtop", d_cldfrac_liq_at_cldtop.data() + m_col_chunk_beg[ic], ncol);
-      real1d cldfrac_tot_at_cldtop ("cldfrac_tot_at_cldtop", d_cldfrac_tot_at_cldtop.data() + m_col_chunk_beg[ic], ncol);
-      real1d cdnc_at_cldtop ("cdnc_at_cldtop", d_cdnc_at_cldtop.data() + m_col_chunk_beg[ic], ncol);
-      real1d eff_radius_qc_at_cldtop ("eff_radius_qc_at_cldtop", d_eff_radius_qc_at_cldtop.data() + m_col_chunk_beg[ic], ncol);
-      real1d eff_radius_qi_at_cldtop ("eff_radius_qi_at_cldtop", d_eff_radius_qi_at_cldtop.data() + m_col_chunk_beg[ic], ncol);
+      auto T_mid_at_cldtop = diag_1d("T_mid_at_cldtop", d_T_mid_at_cldtop);
+      auto p_mid_at_cldtop = diag_1d("p_mid_at_cldtop", d_p_mid_at_cldtop);
+      auto cldfrac_ice_at_cldtop = diag_1d("cldfrac_ice_at_cldtop", d_cldfrac_ice_at_cldtop);
+      auto cldfrac_liq_at_cldtop = diag_1d("cldfrac_liq_at_cldtop", d_cldfrac_liq_at_cldtop);
+      auto cldfrac_tot_at_cldtop = diag_1d("cldfrac_tot_at_cldtop", d_cldfrac_tot_at_cldtop);
+      auto cdnc_at_cldtop = diag_1d("cdnc_at_cldtop", d_cdnc_at_cldtop);
+      auto eff_radius_qc_at_cldtop = diag_1d("eff_radius_qc_at_cldtop", d_eff_radius_qc_at_cldtop);
+      auto eff_radius_qi_at_cldtop = diag_1d("eff_radius_qi_at_cldtop", d_eff_radius_qi_at_cldtop);
 
       rrtmgp::compute_aerocom_cloudtop(
           ncol, nlay, t_lay, p_lay, p_del, z_del, qc, qi, rel, rei, cldfrac_tot,
@@ -1014,7 +1077,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
       const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(ncol, m_nlay);
       Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
         const int i = team.league_rank();
-        const int icol = i + beg;
+        const int icol = (i + beg)*stride;
         d_sfc_flux_dir_nir(icol) = sfc_flux_dir_nir(i+1);
         d_sfc_flux_dir_vis(icol) = sfc_flux_dir_vis(i+1);
         d_sfc_flux_dif_nir(icol) = sfc_flux_dif_nir(i+1);
@@ -1053,9 +1116,29 @@ void RRTMGPRadiation::run_impl (const double dt) {
         } else {
             d_sunlit(icol) = 0.0;
         }
+        if (stride>1) {
+          d_cldlow(icol) = cldlow(i+1);
+          d_cldmed(icol) = cldmed(i+1);
+          d_cldhgh(icol) = cldhgh(i+1);
+          d_cldtot(icol) = cldtot(i+1);
+          d_T_mid_at_cldtop(icol) = T_mid_at_cldtop(i+1);
+          d_p_mid_at_cldtop(icol) = p_mid_at_cldtop(i+1);
+          d_cldfrac_ice_at_cldtop(icol) = cldfrac_ice_at_cldtop(i+1);
+          d_cldfrac_liq_at_cldtop(icol) = cldfrac_liq_at_cldtop(i+1);
+          d_cldfrac_tot_at_cldtop(icol) = cldfrac_tot_at_cldtop(i+1);
+          d_cdnc_at_cldtop(icol) = cdnc_at_cldtop(i+1);
+          d_eff_radius_qc_at_cldtop(icol) = eff_radius_qc_at_cldtop(i+1);
+          d_eff_radius_qi_at_cldtop(icol) = eff_radius_qi_at_cldtop(i+1);
+        }
       });
     } // loop over chunk
 
+    // Fill the columns where radiation was not computed
+    if (stride>1) {
+      Kokkos::fence();
+      fill_subsampled_columns(calday, delta, dt);
+    }
+
     // Restore the refCounted array.
     m_gas_concs.concs = gas_concs;
 
@@ -1111,6 +1194,153 @@ void RRTMGPRadiation::run_impl (const double dt) {
 }
 // =========================================================================================
 
+void RRTMGPRadiation::fill_subsampled_columns (const double calday, const double delta, const double dt) {
+  using PC = scream::physics::Constants<Real>;
+
+  // Each column j that was skipped gets the fluxes of the computed column i=j-j%stride.
+  // Local columns are numbered element by element, so i is a nearby column.
+  // To account for the different state of the two columns:
+  //  - the cloud radiative effect (all-sky minus clear-sky fluxes) of column i
+  //    is scaled by the ratio of the (max overlap) cloud covers of the two columns,
+  //    capped at 1 (we do not extrapolate clouds that column i does not have);
+  //  - the SW fluxes are scaled by the ratio of the cosine of the zenith angles.
+  // The heating is then computed from the fluxes of column j, so that the column
+  // energy budget stays consistent. The remaining diagnostics are copied from column i.
+  const int stride = m_col_stride;
+  const int nlay   = m_nlay;
+
+  // Cosine of the zenith angle on all columns (not just the computed ones)
+  auto h_lat = m_lat.get_view<const Real*,Host>();
+  auto h_lon = m_lon.get_view<const Real*,Host>();
+  auto h_mu0 = Kokkos::create_mirror_view(m_cosine_zenith_all);
+  for (int i=0; i<m_ncol; ++i) {
+    if (m_fixed_solar_zenith_angle > 0) {
+      h_mu0(i) = m_fixed_solar_zenith_angle;
+    } else {
+      double lat = h_lat(i)*PC::Pi/180.0;
+      double lon = h_lon(i)*PC::Pi/180.0;
+      h_mu0(i) = shr_orb_cosz_c2f(calday, lat, lon, delta, m_rad_freq_in_steps * dt);
+    }
+  }
+  Kokkos::deep_copy(m_cosine_zenith_all,h_mu0);
+  auto mu0 = m_cosine_zenith_all;
+
+  auto d_pdel        = get_field_in("pseudo_density").get_view<const Real**>();
+  auto d_cldfrac_tot = get_field_in("cldfrac_tot").get_view<const Real**>();
+
+  auto sw_up      = get_field_out("SW_flux_up").get_view<Real**>();
+  auto sw_dn      = get_field_out("SW_flux_dn").get_view<Real**>();
+  auto sw_dn_dir  = get_field_out("SW_flux_dn_dir").get_view<Real**>();
+  auto lw_up      = get_field_out("LW_flux_up").get_view<Real**>();
+  auto lw_dn      = get_field_out("LW_flux_dn").get_view<Real**>();
+  auto sw_clr_up     = get_field_out("SW_clrsky_flux_up").get_view<Real**>();
+  auto sw_clr_dn     = get_field_out("SW_clrsky_flux_dn").get_view<Real**>();
+  auto sw_clr_dn_dir = get_field_out("SW_clrsky_flux_dn_dir").get_view<Real**>();
+  auto lw_clr_up     = get_field_out("LW_clrsky_flux_up").get_view<Real**>();
+  auto lw_clr_dn     = get_field_out("LW_clrsky_flux_dn").get_view<Real**>();
+
+  // Fields that are simply copied from column i (SW fluxes scaled by the zenith angle ratio)
+  auto copy_from_computed = [&](const std::string& name, const bool is_sw) {
+    auto f = get_field_out(name);
+    if (f.rank()==1) {
+      auto v = f.get_view<Real*>();
+      Kokkos::parallel_for(Kokkos::RangePolicy<ExeSpace>(0,m_ncol),
+                           KOKKOS_LAMBDA (const int j) {
+        const int i = j - j%stride;
+        if (i!=j) v(j) = v(i);
+      });
+    } else {
+      auto v = f.get_view<Real**>();
+      const int nlev = v.extent_int(1);
+      Kokkos::parallel_for(Kokkos::RangePolicy<ExeSpace>(0,m_ncol*nlev),
+                           KOKKOS_LAMBDA (const int idx) {
+        const int j = idx / nlev;
+        const int k = idx % nlev;
+        const int i = j - j%stride;
+        if (i==j) return;
+        const Real fsw = (mu0(i)>0 and mu0(j)>0) ? mu0(j)/mu0(i) : 0;
+        v(j,k) = is_sw ? fsw*v(i,k) : v(i,k);
+      });
+    }
+  };
+  for (const auto& name : {"SW_clnclrsky_flux_up", "SW_clnclrsky_flux_dn", "SW_clnclrsky_flux_dn_dir",
+                           "SW_clnsky_flux_up", "SW_clnsky_flux_dn", "SW_clnsky_flux_dn_dir"}) {
+    copy_from_computed(name,true);
+  }
+  for (const auto& name : {"LW_clnclrsky_flux_up", "LW_clnclrsky_flux_dn",
+                           "LW_clnsky_flux_up", "LW_clnsky_flux_dn",
+                           "dtau067", "dtau105",
+                           "cldlow", "cldmed", "cldhgh", "cldtot",
+                           "T_mid_at_cldtop", "p_mid_at_cldtop",
+                           "cldfrac_ice_at_cldtop", "cldfrac_liq_at_cldtop", "cldfrac_tot_at_cldtop",
+                           "cdnc_at_cldtop", "eff_radius_qc_at_cldtop", "eff_radius_qi_at_cldtop"}) {
+    copy_from_computed(name,false);
+  }
+
+  auto d_rad_heating_pdel = get_field_out("rad_heating_pdel").get_view<Real**>();
+  auto d_sfc_flux_dir_vis = get_field_out("sfc_flux_dir_vis").get_view<Real*>();
+  auto d_sfc_flux_dir_nir = get_field_out("sfc_flux_dir_nir").get_view<Real*>();
+  auto d_sfc_flux_dif_vis = get_field_out("sfc_flux_dif_vis").get_view<Real*>();
+  auto d_sfc_flux_dif_nir = get_field_out("sfc_flux_dif_nir").get_view<Real*>();
+  auto d_sfc_flux_sw_net  = get_field_out("sfc_flux_sw_net").get_view<Real*>();
+  auto d_sfc_flux_lw_dn   = get_field_out("sfc_flux_lw_dn").get_view<Real*>();
+  auto d_sunlit           = get_field_out("sunlit").get_view<Real*>();
+
+  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(m_ncol, nlay);
+  Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
+    const int j = team.league_rank();
+    const int i = j - j%stride;
+    if (i==j) return;
+
+    // Cloud radiative effect weight
+    Real cov_i, cov_j;
+    Kokkos::parallel_reduce(Kokkos::TeamVectorRange(team, nlay), [&] (const int k, Real& cov) {
+      cov = ekat::impl::max(cov,d_cldfrac_tot(i,k));
+    }, Kokkos::Max<Real>(cov_i));
+    Kokkos::parallel_reduce(Kokkos::TeamVectorRange(team, nlay), [&] (const int k, Real& cov) {
+      cov = ekat::impl::max(cov,d_cldfrac_tot(j,k));
+    }, Kokkos::Max<Real>(cov_j));
+    const Real w   = cov_i>0 ? ekat::impl::min(cov_j/cov_i,Real(1)) : Real(1);
+    const Real fsw = (mu0(i)>0 and mu0(j)>0) ? mu0(j)/mu0(i) : 0;
+
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlay+1), [&] (const int k) {
+      sw_clr_up(j,k)     = fsw*sw_clr_up(i,k);
+      sw_clr_dn(j,k)     = fsw*sw_clr_dn(i,k);
+      sw_clr_dn_dir(j,k) = fsw*sw_clr_dn_dir(i,k);
+      lw_clr_up(j,k)     = lw_clr_up(i,k);
+      lw_clr_dn(j,k)     = lw_clr_dn(i,k);
+      sw_up(j,k)     = sw_clr_up(j,k)     + w*fsw*(sw_up(i,k)-sw_clr_up(i,k));
+      sw_dn(j,k)     = sw_clr_dn(j,k)     + w*fsw*(sw_dn(i,k)-sw_clr_dn(i,k));
+      sw_dn_dir(j,k) = sw_clr_dn_dir(j,k) + w*fsw*(sw_dn_dir(i,k)-sw_clr_dn_dir(i,k));
+      lw_up(j,k)     = lw_clr_up(j,k)     + w*(lw_up(i,k)-lw_clr_up(i,k));
+      lw_dn(j,k)     = lw_clr_dn(j,k)     + w*(lw_dn(i,k)-lw_clr_dn(i,k));
+    });
+    team.team_barrier();
+
+    // Same as rrtmgp::compute_heating_rate; note that at this stage d_rad_heating_pdel
+    // contains the heating rate, not yet multiplied by pdel.
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlay), [&] (const int k) {
+      d_rad_heating_pdel(j,k) = ( sw_up(j,k+1) - sw_up(j,k) - sw_dn(j,k+1) + sw_dn(j,k)
+                                + lw_up(j,k+1) - lw_up(j,k) - lw_dn(j,k+1) + lw_dn(j,k) )
+                              * PC::gravit / (PC::Cpair * d_pdel(j,k));
+    });
+
+    Kokkos::single(Kokkos::PerTeam(team), [&] () {
+      // Partition the surface SW flux among bands/components as in column i
+      const Real fsfc = sw_dn(i,nlay)>0 ? sw_dn(j,nlay)/sw_dn(i,nlay) : 0;
+      d_sfc_flux_dir_vis(j) = fsfc*d_sfc_flux_dir_vis(i);
+      d_sfc_flux_dir_nir(j) = fsfc*d_sfc_flux_dir_nir(i);
+      d_sfc_flux_dif_vis(j) = fsfc*d_sfc_flux_dif_vis(i);
+      d_sfc_flux_dif_nir(j) = fsfc*d_sfc_flux_dif_nir(i);
+      d_sfc_flux_sw_net(j)  = sw_dn(j,nlay) - sw_up(j,nlay);
+      d_sfc_flux_lw_dn(j)   = lw_dn(j,nlay);
+      d_sunlit(j) = sw_clr_dn(j,0)>0 ? 1.0 : 0.0;
+    });
+  });
+  Kokkos::fence();
+}
+// =========================================================================================
+
 void RRTMGPRadiation::finalize_impl  () {
   m_gas_concs.reset();
   rrtmgp::rrtmgp_finalize();
@@ -47,12 +47,22 @@ public:
   void run_impl        (const double dt);
   void finalize_impl   ();
 
+  // Fill the columns skipped by the column subsampling
+  void fill_subsampled_columns (const double calday, const double delta, const double dt);
+
   // Keep track of number of columns and levels
   int m_ncol;
   int m_num_col_chunks;
   int m_col_chunk_size;
   std::vector<int> m_col_chunk_beg;
   int m_nlay;
+
+  // Radiation is computed on one every m_col_stride local columns (m_ncol_rad
+  // in total, chunked as above); the other columns are filled from the closest
+  // computed column preceding them (see fill_subsampled_columns).
+  int m_col_stride;
+  int m_ncol_rad;
+  view_1d_real m_cosine_zenith_all;
   Field m_lat;
   Field m_lon;
 
@@ -99,6 +109,11 @@ public:
   Real m_n2vmr;
   Real m_covmr;
 
+  // The prescribed gases VMR only change if p_mid changes (o2 and co2 not even then),
+  // so keep track of the p_mid time stamp at the last update, to skip recomputing them
+  TimeStamp m_prescribed_gases_pmid_ts;
+  bool m_const_gases_set = false;
+
   // Rad frequency in number of steps
   int m_rad_freq_in_steps;
 
@@ -208,6 +223,11 @@ protected:
   // Computes total number of bytes needed for local variables
   size_t requested_buffer_size_in_bytes() const;
 
+  // Memory needed by a single column in the buffer, and in a chunk overall
+  // (buffer plus rrtmgp temporaries), used to pick the chunk size
+  size_t buffer_size_per_col_in_bytes() const;
+  size_t chunk_mem_per_col_in_bytes() const;
+
   // Set local variables using memory provided by
   // the ATMBufferManager
   void init_buffers(const ATMBufferManager &buffer_manager);
@@ -0,0 +1,115 @@
+#ifndef PHYSICS_TRIDIAG_HPP
+#define PHYSICS_TRIDIAG_HPP
+
+#include "share/scream_types.hpp"
+
+#include "ekat/ekat_pack_kokkos.hpp"
+#include "ekat/util/ekat_tridiag.hpp"
+
+namespace scream {
+namespace physics {
+
+/*
+ * Batched tridiagonal solver for the implicit vertical diffusion of
+ * several quantities sharing the same matrix (e.g., SHOC's thl, qw, tke
+ * and tracers).
+ *
+ * The system is A X = B, with A given by its sub- (dl), main (d) and
+ * super-diagonal (du), each a scalar view of length nlev, and with the
+ * nrhs right hand sides stored in the columns of X, which is overwritten
+ * with the solution. The entries X(k,j) can be packs, in which case each
+ * pack lane is a separate rhs, so that the solve is vectorized across
+ * quantities. The diagonals are overwritten with the factorization.
+ *
+ * Algorithms:
+ *  - Thomas: the matrix is factorized once, by a single thread, and the
+ *    columns of X are then distributed over the team threads. This is
+ *    the best choice on CPU, where the vector length is 1 and the packs
+ *    provide the vectorization.
+ *  - CyclicReduction: O(log nlev) depth, using all the team threads and
+ *    vector lanes on each column of X. This is the best choice on GPU, with few rhs.
+ *    Pack entries of X are scalarized internally.
+ *  - BFB: the ekat bfb solver, whose result does not depend on the
+ *    team size or the architecture.
+ *  - Default: BFB in EKAT_DEFAULT_BFB builds, and Thomas on CPU. On GPU,
+ *    Thomas if there are at least as many rhs as team threads (e.g., SHOC
+ *    with many tracers), since then a single factorization feeds all the
+ *    threads, and CyclicReduction otherwise.
+ */
+
+struct Tridiag
+{
+  enum class Algorithm {
+    Default,
+    Thomas,
+    CyclicReduction,
+    BFB
+  };
+
+  template <typename MemberType, typename DiagView, typename RhsView>
+  KOKKOS_INLINE_FUNCTION
+  static void solve (const MemberType& team,
+                     const DiagView& dl, const DiagView& d, const DiagView& du,
+                     const RhsView& X,
+                     const Algorithm alg = Algorithm::Default)
+  {
+    switch (alg) {
+      case Algorithm::Thomas:
+        thomas(team,dl,d,du,X);
+        break;
+      case Algorithm::CyclicReduction:
+        ekat::tridiag::cr(team,dl,d,du,ekat::scalarize(X));
+        break;
+      case Algorithm::BFB:
+        ekat::tridiag::bfb(team,dl,d,du,X);
+        break;
+      default:
+#ifdef EKAT_DEFAULT_BFB
+        ekat::tridiag::bfb(team,dl,d,du,X);
+#elif defined(EAMXX_ENABLE_GPU)
+        if (X.extent_int(1)>=team.team_size()) {
+          thomas(team,dl,d,du,X);
+        } else {
+          ekat::tridiag::cr(team,dl,d,du,ekat::scalarize(X));
+        }
+#else
+        thomas(team,dl,d,du,X);
+#endif
+    }
+  }
+
+  // Thomas algorithm, with the rhs columns (or rhs packs) distributed over the team threads
+  template <typename MemberType, typename DiagView, typename RhsView>
+  KOKKOS_INLINE_FUNCTION
+  static void thomas (const MemberType& team,
+                      const DiagView& dl, const DiagView& d, const DiagView& du,
+                      const RhsView& X)
+  {
+    const int nlev = d.extent_int(0);
+    const int nrhs = X.extent_int(1);
+
+    // The factorization does not depend on the rhs, so do it once
+    Kokkos::single(Kokkos::PerTeam(team), [&] () {
+      for (int k=1; k<nlev; ++k) {
+        dl(k) /= d(k-1);
+        d(k)  -= dl(k)*du(k-1);
+      }
+    });
+    team.team_barrier();
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nrhs), [&] (const int j) {
+      for (int k=1; k<nlev; ++k) {
+        X(k,j) -= dl(k)*X(k-1,j);
+      }
+      X(nlev-1,j) /= d(nlev-1);
+      for (int k=nlev-1; k>0; --k) {
+        X(k-1,j) = (X(k-1,j) - du(k-1)*X(k,j)) / d(k-1);
+      }
+    });
+  }
+};
+
+} // namespace physics
+} // namespace scream
+
+#endif // PHYSICS_TRIDIAG_HPP
@@ -0,0 +1,81 @@
+#include "catch2/catch.hpp"
+
+#include "physics/share/physics_tridiag.hpp"
+#include "share/scream_types.hpp"
+#include "share/util/scream_setup_random_test.hpp"
+
+#include "ekat/kokkos/ekat_kokkos_utils.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace scream {
+namespace physics {
+namespace unit_test {
+
+TEST_CASE("tridiag_solve", "[physics_tridiag]")
+{
+  using KT       = KokkosTypes<DefaultDevice>;
+  using ExeSpace = typename KT::ExeSpace;
+  using Spack    = ekat::Pack<Real,SCREAM_SMALL_PACK_SIZE>;
+  using Alg      = Tridiag::Algorithm;
+
+  auto engine = setup_random_test();
+  std::uniform_real_distribution<Real> pdf(-1,1);
+
+  const int nlev = 72;
+  const int nrhs_packs = 3;
+  const int nrhs = nrhs_packs*Spack::n;
+
+  // Diagonally dominant system, as in implicit diffusion
+  KT::view_1d<Real> dl("dl",nlev), d("d",nlev), du("du",nlev);
+  KT::view_2d<Spack> B("B",nlev,nrhs_packs);
+  auto dl_h = Kokkos::create_mirror_view(dl);
+  auto d_h  = Kokkos::create_mirror_view(d);
+  auto du_h = Kokkos::create_mirror_view(du);
+  auto B_h  = Kokkos::create_mirror_view(B);
+  for (int k=0; k<nlev; ++k) {
+    dl_h(k) = k==0 ? 0 : pdf(engine);
+    du_h(k) = k==nlev-1 ? 0 : pdf(engine);
+    d_h(k)  = 3 + pdf(engine);
+    for (int j=0; j<nrhs_packs; ++j) {
+      for (int s=0; s<Spack::n; ++s) {
+        B_h(k,j)[s] = pdf(engine);
+      }
+    }
+  }
+
+  for (auto alg : {Alg::Default, Alg::Thomas, Alg::CyclicReduction, Alg::BFB}) {
+    // The solver overwrites the diagonals with the factorization
+    KT::view_1d<Real> dl_d("dl",nlev), d_d("d",nlev), du_d("du",nlev);
+    KT::view_2d<Spack> X("X",nlev,nrhs_packs);
+    Kokkos::deep_copy(dl_d,dl_h);
+    Kokkos::deep_copy(d_d,d_h);
+    Kokkos::deep_copy(du_d,du_h);
+    Kokkos::deep_copy(X,B_h);
+
+    const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(1, nlev);
+    Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const KT::MemberType& team) {
+      Tridiag::solve(team,dl_d,d_d,du_d,X,alg);
+    });
+
+    // Check the residual of each rhs against the original matrix
+    auto X_h = Kokkos::create_mirror_view(X);
+    Kokkos::deep_copy(X_h,X);
+    const auto Xs = ekat::scalarize(X_h);
+    const auto Bs = ekat::scalarize(B_h);
+    for (int j=0; j<nrhs; ++j) {
+      for (int k=0; k<nlev; ++k) {
+        Real Ax = d_h(k)*Xs(k,j);
+        if (k>0)      Ax += dl_h(k)*Xs(k-1,j);
+        if (k<nlev-1) Ax += du_h(k)*Xs(k+1,j);
+        REQUIRE (std::abs(Ax-Bs(k,j)) < 1e3*std::numeric_limits<Real>::epsilon());
+      }
+    }
+  }
+}
+
+} // namespace unit_test
+} // namespace physics
+} // namespace scream
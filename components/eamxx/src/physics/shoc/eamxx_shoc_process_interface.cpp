@@ -536,12 +536,12 @@ void SHOCMacrophysics::check_flux_state_consistency(const double dt)
   const auto nlev_packs      = ekat::npack<Spack>(nlevs);
   const auto last_pack_idx   = (nlevs-1)/Spack::n;
   const auto last_pack_entry = (nlevs-1)%Spack::n;
-  const auto policy          = ekat::ExeSpaceUtils<KT::ExeSpace>::get_default_team_policy(m_num_cols, nlev_packs);
-  Kokkos::parallel_for("check_flux_state_consistency",
-                       policy,
-                       KOKKOS_LAMBDA (const KT::MemberType& team) {
-    const auto i = team.league_rank();
 
+  // The check only involves the lowest level, and the fixer is seldom needed,
+  // so use a flat loop over columns rather than a team per column.
+  Kokkos::parallel_for("check_flux_state_consistency",
+                       KT::RangePolicy(0, m_num_cols),
+                       KOKKOS_LAMBDA (const int i) {
     const auto& pseudo_density_i = ekat::subview(pseudo_density, i);
     const auto& qv_i             = ekat::subview(qv, i);
 
@@ -554,17 +554,17 @@ void SHOCMacrophysics::check_flux_state_consistency(const double dt)
     if (condition < 0) {
       const auto cc = abs(surf_evap(i)*dt*gravit);
 
-      auto tracer_mass = [&](const int k) {
-        return qv_i(k)*pseudo_density_i(k);
-      };
-      Real mm = ekat::ExeSpaceUtils<KT::ExeSpace>::view_reduction(team, 0, nlevs, tracer_mass);
+      Real mm = 0;
+      for (int k=0; k<nlevs; ++k) {
+        mm += qv_i(k/Spack::n)[k%Spack::n]*pseudo_density_i(k/Spack::n)[k%Spack::n];
+      }
 
       EKAT_KERNEL_ASSERT_MSG(mm >= cc, "Error! Total mass of column vapor should be greater than mass of surf_evap.\n");
 
-      Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlev_packs), [&](const int& k) {
+      for (int k=0; k<nlev_packs; ++k) {
         const auto adjust = cc*qv_i(k)*pseudo_density_i(k)/mm;
         qv_i(k) = (qv_i(k)*pseudo_density_i(k) - adjust)/pseudo_density_i(k);
-      });
+      }
 
       surf_evap(i) = 0;
     }
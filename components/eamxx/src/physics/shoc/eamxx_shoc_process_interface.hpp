@@ -62,6 +62,9 @@ public:
   // Set the grid
   void set_grids (const std::shared_ptr<const GridsManager> grids_manager);
 
+  // SHOC is not designed to run with a dt longer than 5 minutes (see run_impl)
+  double get_max_stable_dt () const override { return 300; }
+
   /*--------------------------------------------------------------------------------------------*/
   // Most individual processes have a pre-processing step that constructs needed variables from
   // the set of fields stored in the field manager.  A structure like this defines those operations,
@@ -2,7 +2,7 @@
 #define SHOC_TRIDIAG_SOLVER_IMPL_HPP
 
 #include "shoc_functions.hpp" // for ETI only but harmless for GPU
-#include "ekat/util/ekat_tridiag.hpp"
+#include "physics/share/physics_tridiag.hpp"
 
 namespace scream {
 namespace shoc {
@@ -83,16 +83,8 @@ void Functions<S,D>::vd_shoc_solve(
   const uview_1d<Scalar>& d,
   const uview_2d<Spack>&  var)
 {
-#ifdef EKAT_DEFAULT_BFB
-  ekat::tridiag::bfb(team, dl, d, du, var);
-#else
-#ifdef EAMXX_ENABLE_GPU
-  ekat::tridiag::cr(team, dl, d, du, ekat::scalarize(var));
-#else
-  const auto f = [&] () { ekat::tridiag::thomas(dl, d, du, var); };
-  Kokkos::single(Kokkos::PerTeam(team), f);
-#endif
-#endif
+  // All the rhs in var share the matrix, and are solved in a single call
+  physics::Tridiag::solve(team, dl, d, du, var);
 }
 
 } // namespace shoc
@@ -81,7 +81,7 @@ struct Baseline {
                     << ", dt=" << d->dtime << ", ts=" << ps.nsteps;
 
           if (!use_fortran) {
-            std::cout << ", small_packn=" << SCREAM_SMALL_PACK_SIZE;
+            std::cout << ", small_packn=" << SCREAM_SHOC_SMALL_PACK_SIZE;
           }
           std::cout << std::endl;
         }
@@ -163,6 +163,16 @@ void SPA::initialize_impl (const RunType /* run_type */)
   EKAT_REQUIRE_MSG(m_params.isParameter("spa_data_file"),"ERROR: spa_data_file is missing from SPA parameter list.");
   m_spa_remap_file = m_params.get<std::string>("spa_remap_file");
 
+  // Optionally read the data of the following month in the background
+  m_prefetch_data = m_params.get<bool>("prefetch_data",false);
+  if (m_prefetch_data and not scorpio::async_io_supported()) {
+    if (m_comm.am_i_root()) {
+      m_atm_logger->warn("[EAMxx::spa] prefetch_data requested, but MPI was not initialized "
+                         "with MPI_THREAD_MULTIPLE. SPA data will be read synchronously.\n");
+    }
+    m_prefetch_data = false;
+  }
+
   // Set the SPA remap weights.  
   // TODO: We may want to provide an option to calculate weights on-the-fly. 
   //       If so, then the EKAT_REQUIRE_MSG above will need to be removed and 
@@ -181,12 +191,14 @@ void SPA::initialize_impl (const RunType /* run_type */)
   // Initialize the size of the SPAData structures:  add 2 to number of levels for padding
   SPAData_start = SPAFunc::SPAInput(m_dofs_gids.size(), m_num_src_levs+2, m_nswbands, m_nlwbands);
   SPAData_end   = SPAFunc::SPAInput(m_dofs_gids.size(), m_num_src_levs+2, m_nswbands, m_nlwbands);
+  m_vert_interp = std::make_shared<SPAFunc::LIV>(m_num_cols, m_num_src_levs+2, m_num_levs);
 
   // Update the local time state information and load the first set of SPA data for interpolation:
   auto ts = timestamp();
   SPATimeState.inited = false;
   SPATimeState.current_month = ts.get_month();
-  SPAFunc::update_spa_timestate(m_spa_data_file,m_nswbands,m_nlwbands,ts,SPAHorizInterp,SPATimeState,SPAData_start,SPAData_end);
+  SPAFunc::update_spa_timestate(m_spa_data_file,m_nswbands,m_nlwbands,ts,SPAHorizInterp,SPATimeState,
+                                SPAFileReader,SPAData_start,SPAData_end,m_prefetch_data);
 
   // Set property checks for fields in this process
   using Interval = FieldWithinIntervalCheck;
@@ -208,18 +220,23 @@ void SPA::run_impl (const double dt)
   /* Update the SPATimeState to reflect the current time, note the addition of dt */
   SPATimeState.t_now = ts.frac_of_year_in_days();
   /* Update time state and if the month has changed, update the data.*/
-  SPAFunc::update_spa_timestate(m_spa_data_file,m_nswbands,m_nlwbands,ts,SPAHorizInterp,SPATimeState,SPAData_start,SPAData_end);
+  SPAFunc::update_spa_timestate(m_spa_data_file,m_nswbands,m_nlwbands,ts,SPAHorizInterp,SPATimeState,
+                                SPAFileReader,SPAData_start,SPAData_end,m_prefetch_data);
 
   // Call the main SPA routine to get interpolated aerosol forcings.
   const auto& pmid_tgt = get_field_in("p_mid").get_view<const Pack**>();
   SPAFunc::spa_main(SPATimeState, pmid_tgt, m_buffer.p_mid_src,
-                    SPAData_start,SPAData_end,m_buffer.spa_temp,SPAData_out);
+                    SPAData_start,SPAData_end,m_buffer.spa_temp,SPAData_out,
+                    *m_vert_interp);
 }
 
 // =========================================================================================
 void SPA::finalize_impl()
 {
-  // Do nothing
+  // Close the data file (this waits for any pending prefetch)
+  if (SPAFileReader.input) {
+    SPAFileReader.input->finalize();
+  }
 }
 
 } // namespace scream
@@ -92,14 +92,20 @@ protected:
   // SPA specific files
   std::string m_spa_remap_file;
   std::string m_spa_data_file;
+  // If true, read the data of the following month in the background
+  bool        m_prefetch_data;
 
   // Structures to store the data used for interpolation
   SPAFunc::SPATimeState     SPATimeState;
   SPAFunc::SPAHorizInterp   SPAHorizInterp;
+  SPAFunc::SPAFileReader    SPAFileReader;
   SPAFunc::SPAInput         SPAData_start;
   SPAFunc::SPAInput         SPAData_end;
   SPAFunc::SPAOutput        SPAData_out;
 
+  // Vertical interpolation object, created once and reused at every step
+  std::shared_ptr<SPAFunc::LIV> m_vert_interp;
+
   std::shared_ptr<const AbstractGrid>   m_grid;
 }; // class SPA 
 
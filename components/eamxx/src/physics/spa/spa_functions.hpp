@@ -3,6 +3,7 @@
 
 #include "share/grid/abstract_grid.hpp"
 #include "share/grid/remap/horizontal_remap_utility.hpp"
+#include "share/io/scorpio_input.hpp"
 #include "share/scream_types.hpp"
 #include "share/util/scream_time_stamp.hpp"
 
@@ -10,6 +11,7 @@
 #include "ekat/ekat_pack_utils.hpp"
 #include "ekat/ekat_workspace.hpp"
 #include "ekat/mpi/ekat_comm.hpp"
+#include "ekat/util/ekat_lin_interp.hpp"
 
 namespace scream {
 namespace spa {
@@ -36,6 +38,8 @@ struct SPAFunctions
   using KT = KokkosTypes<Device>;
   using MemberType = typename KT::MemberType;
 
+  using LIV = ekat::LinInterp<Real,Spack::n>;
+
   using WorkspaceManager = typename ekat::WorkspaceManager<Spack, Device>;
   using Workspace        = typename WorkspaceManager::Workspace;
 
@@ -160,6 +164,28 @@ struct SPAFunctions
     ekat::Comm m_comm;
 
   }; // SPAHorizInterp
+
+  struct SPAFileReader {
+    // This structure stores the source data of one time slice of the SPA data file,
+    // before the horizontal remap, together with the input stream used to read it.
+    // The input stream only reads into the host views, so that a time slice can be
+    // read in the background (see update_spa_timestate).
+    SPAFileReader() = default;
+
+    std::shared_ptr<AtmosphereInput> input;
+    // Number of levels in the source data
+    int source_data_nlevs;
+    // Zero-based time index of the data in (or being read into) the host views, -1 if none
+    int time_index = -1;
+
+    typename view_1d<Real>::HostMirror hyam_h, hybm_h;
+    view_1d<Real> PS;
+    view_2d<Real> CCN3;
+    view_3d<Real> AER_G_SW, AER_SSA_SW, AER_TAU_SW, AER_TAU_LW;
+    typename view_1d<Real>::HostMirror PS_h;
+    typename view_2d<Real>::HostMirror CCN3_h;
+    typename view_3d<Real>::HostMirror AER_G_SW_h, AER_SSA_SW_h, AER_TAU_SW_h, AER_TAU_LW_h;
+  }; // SPAFileReader
   /* ------------------------------------------------------------------------------------------- */
   // SPA routines
   static void spa_main(
@@ -171,6 +197,18 @@ struct SPAFunctions
     const SPAInput&   data_tmp,         // Temporary
     const SPAOutput&  data_out);
 
+  // Same as above, but reuses the input vertical interpolation object, which must
+  // be sized for (ncols, nlevs_src, nlevs_tgt), rather than creating one at each call
+  static void spa_main(
+    const SPATimeState& time_state,
+    const view_2d<const Spack>& p_tgt,
+    const view_2d<      Spack>& p_src,  // Temporary
+    const SPAInput&   data_beg,
+    const SPAInput&   data_end,
+    const SPAInput&   data_tmp,         // Temporary
+    const SPAOutput&  data_out,
+          LIV&        vert_interp);
+
   static void get_remap_weights_from_file(
     const std::string&             remap_file_name,
     const gid_type                 min_dof,
@@ -182,6 +220,22 @@ struct SPAFunctions
     const view_1d<const gid_type>& dofs_gids,
           SPAHorizInterp&          spa_horiz_interp);
 
+  static void init_spa_file_reader(
+    const std::string&    spa_data_file_name,
+    const int             nswbands,
+    const int             nlwbands,
+          SPAHorizInterp& spa_horiz_interp,
+          SPAFileReader&  reader);
+
+  static void read_spa_data(
+    const SPAFileReader&  reader,
+    const int             time_index);
+
+  static void remap_spa_data(
+    const SPAFileReader&  reader,
+          SPAHorizInterp& spa_horiz_interp,
+          SPAInput&       spa_data);
+
   static void update_spa_data_from_file(
     const std::string&    spa_data_file_name,
     const int             time_index,
@@ -190,6 +244,8 @@ struct SPAFunctions
           SPAHorizInterp& spa_horiz_interp,
           SPAInput&       spa_data);
 
+  // If prefetch=true, the data of the month after next is read on the
+  // async I/O thread at month changes (requires MPI_THREAD_MULTIPLE).
   static void update_spa_timestate(
     const std::string&     spa_data_file_name,
     const int              nswbands,
@@ -197,8 +253,10 @@ struct SPAFunctions
     const util::TimeStamp& ts,
           SPAHorizInterp&  spa_horiz_interp,
           SPATimeState&    time_state,
+          SPAFileReader&   reader,
           SPAInput&        spa_beg,
-          SPAInput&        spa_end);
+          SPAInput&        spa_end,
+    const bool             prefetch = false);
 
   // The following three are called during spa_main
   static void perform_time_interpolation (
@@ -219,6 +277,20 @@ struct SPAFunctions
       const SPAData&  data_in,
       const SPAData&  data_out);
 
+  // Fused version of the three routines above, used by spa_main. It only
+  // launches two kernels: one per column, for PS time interpolation, source
+  // pressure levels, and vertical interpolation setup, and one per column and
+  // variable, for time interpolation followed by vertical interpolation.
+  static void perform_time_and_vertical_interpolation (
+      const SPATimeState& time_state,
+      const view_2d<const Spack>& p_tgt,
+      const view_2d<      Spack>& p_src,
+      const SPAInput&  data_beg,
+      const SPAInput&  data_end,
+      const SPAInput&  data_tmp,
+      const SPAData&   data_out,
+            LIV&       vert_interp);
+
   // Return the subcolumn of the proper variable, where ivar
   // is a condensed idx for var and possibly band. In particular:
   //  - ivar=0: return CCN
@@ -96,6 +96,22 @@ void SPAFunctions<S,D>
   const SPAInput&   data_end,
   const SPAInput&   data_tmp,
   const SPAOutput&  data_out)
+{
+  LIV vert_interp(data_out.ncols,data_beg.data.nlevs,data_out.nlevs);
+  spa_main(time_state,p_tgt,p_src,data_beg,data_end,data_tmp,data_out,vert_interp);
+}
+
+template <typename S, typename D>
+void SPAFunctions<S,D>
+::spa_main(
+  const SPATimeState& time_state,
+  const view_2d<const Spack>& p_tgt,
+  const view_2d<      Spack>& p_src,
+  const SPAInput&   data_beg,
+  const SPAInput&   data_end,
+  const SPAInput&   data_tmp,
+  const SPAOutput&  data_out,
+        LIV&        vert_interp)
 {
   // Beg/End/Tmp month must have all sizes matching
   EKAT_REQUIRE_MSG (
@@ -125,14 +141,12 @@ void SPAFunctions<S,D>
       "Error! Horizontal interpolation is performed *before* calling spa_main,\n"
       "       SPAInput and SPAOutput data structs must have the same number columns.\n");
 
-  // Step 1. Perform time interpolation
-  perform_time_interpolation(time_state,data_beg,data_end,data_tmp);
-
-  // Step 2. Compute source pressure levels
-  compute_source_pressure_levels(data_tmp.PS, p_src, data_beg.hyam, data_beg.hybm);
-
-  // Step 3. Perform vertical interpolation
-  perform_vertical_interpolation(p_src, p_tgt, data_tmp.data, data_out);
+  // Perform time interpolation, compute source pressure levels, and perform
+  // vertical interpolation. Note: the source pressure depends on the time-interpolated
+  // surface pressure, so the vertical interpolation setup must be redone at every call.
+  perform_time_and_vertical_interpolation(time_state, p_tgt, p_src,
+                                          data_beg, data_end, data_tmp,
+                                          data_out, vert_interp);
 }
 
 /*-----------------------------------------------------------------*/
@@ -295,6 +309,100 @@ perform_vertical_interpolation(
   Kokkos::fence();
 }
 
+template<typename S, typename D>
+void SPAFunctions<S,D>::
+perform_time_and_vertical_interpolation(
+  const SPATimeState& time_state,
+  const view_2d<const Spack>& p_tgt,
+  const view_2d<      Spack>& p_src,
+  const SPAInput&  data_beg,
+  const SPAInput&  data_end,
+  const SPAInput&  data_tmp,
+  const SPAData&   data_out,
+        LIV&       vert_interp)
+{
+  // NOTE: we *assume* data_beg and data_end have the *same* hybrid v coords.
+  //       IF this ever ceases to be the case, you can interp those too.
+
+  using ExeSpace = typename KT::ExeSpace;
+  using ESU = ekat::ExeSpaceUtils<ExeSpace>;
+  using C = scream::physics::Constants<Real>;
+
+  constexpr auto P0 = C::P0;
+
+  // Gather time stamp info
+  auto& t_now = time_state.t_now;
+  auto& t_beg = time_state.t_beg_month;
+  auto& delta_t = time_state.days_this_month;
+
+  auto delta_t_fraction = (t_now-t_beg) / delta_t;
+
+  EKAT_REQUIRE_MSG (delta_t_fraction>=0 && delta_t_fraction<=1,
+      "Error! Convex interpolation with coefficient out of [0,1].\n"
+      "  t_now  : " + std::to_string(t_now) + "\n"
+      "  t_beg  : " + std::to_string(t_beg) + "\n"
+      "  delta_t: " + std::to_string(delta_t) + "\n");
+
+  const int ncols = data_beg.data.ncols;
+  const int num_vars = 1+data_beg.data.nswbands*3+data_beg.data.nlwbands;
+  const int num_src_packs = ekat::PackInfo<Spack::n>::num_packs(data_beg.data.nlevs);
+  const int num_tgt_packs = ekat::PackInfo<Spack::n>::num_packs(data_out.nlevs);
+
+  const auto hyam = data_beg.hyam;
+  const auto hybm = data_beg.hybm;
+
+  // Step 1: time interpolation of PS, source pressure levels, and setup of the
+  //         vertical interpolation. These only depend on the column.
+  //         Note: LIV::setup uses the team league rank as column index.
+  const auto policy_setup = ESU::get_default_team_policy(ncols, num_tgt_packs);
+  Kokkos::parallel_for("spa_p_src_and_vert_interp_setup_loop", policy_setup,
+    KOKKOS_LAMBDA(const MemberType& team) {
+    const int icol = team.league_rank();
+
+    const auto ps = linear_interp(data_beg.PS(icol),data_end.PS(icol),delta_t_fraction);
+    Kokkos::single(Kokkos::PerTeam(team),[&]{
+      data_tmp.PS(icol) = ps;
+    });
+
+    const auto p_src_col = ekat::subview(p_src,icol);
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team,num_src_packs),
+                         [&](const int k) {
+      p_src_col(k) = ps * hybm(k)  + P0 * hyam(k);
+    });
+    team.team_barrier();
+
+    vert_interp.setup(team, p_src_col, ekat::subview(p_tgt,icol));
+  });
+
+  // Step 2: time interpolation followed by vertical interpolation, in || over
+  //         columns as well as over variables and bands. No fence is needed
+  //         between the two kernels, since they run on the same execution space.
+  const auto policy_interp = ESU::get_default_team_policy(ncols*num_vars, num_tgt_packs);
+  Kokkos::parallel_for("spa_time_vert_interp_loop", policy_interp,
+    KOKKOS_LAMBDA(const MemberType& team) {
+
+    // The policy is over ncols*num_vars, so retrieve icol/ivar
+    const int icol = team.league_rank() / num_vars;
+    const int ivar = team.league_rank() % num_vars;
+
+    // Get column of beg/end/tmp/out variable
+    const auto var_beg = get_var_column (data_beg.data,icol,ivar);
+    const auto var_end = get_var_column (data_end.data,icol,ivar);
+    const auto var_tmp = get_var_column (data_tmp.data,icol,ivar);
+    const auto var_out = get_var_column (data_out,icol,ivar);
+
+    Kokkos::parallel_for (Kokkos::TeamVectorRange(team,num_src_packs),
+                          [&] (const int& k) {
+      var_tmp(k) = linear_interp(var_beg(k),var_end(k),delta_t_fraction);
+    });
+    team.team_barrier();
+
+    vert_interp.lin_interp(team, ekat::subview(p_src,icol), ekat::subview(p_tgt,icol),
+                           var_tmp, var_out, icol);
+  });
+  Kokkos::fence();
+}
+
 /*-----------------------------------------------------------------*/
 // Function to set the remap and weights for a one-to-one mapping.
 // This is used when the SPA data and the simulation grid are the
@@ -351,6 +459,118 @@ void SPAFunctions<S,D>
   stop_timer("EAMxx::SPA::get_remap_weights_from_file");
 
 }  // END get_remap_weights_from_file
+/*-----------------------------------------------------------------*/
+/* Set up the reader of the SPA data file: the source grid, the views for the source
+ * data of one time slice, and the input stream, so that reading a time slice only
+ * requires reading the variables.
+ */
+template<typename S, typename D>
+void SPAFunctions<S,D>
+::init_spa_file_reader(
+    const std::string&          spa_data_file_name,
+    const int                   nswbands,
+    const int                   nlwbands,
+          SPAHorizInterp&       spa_horiz_interp,
+          SPAFileReader&        reader)
+{
+  // Ensure all ranks are operating independently when reading the file, so there's a copy on all ranks
+  auto comm = spa_horiz_interp.m_comm;
+
+  // Use HorizontalMap to define the set of source column data we need to load
+  auto& spa_horiz_map = spa_horiz_interp.horiz_map;
+  auto unique_src_dofs = spa_horiz_map.get_unique_source_dofs();
+  const int num_local_cols = spa_horiz_map.get_num_unique_dofs();
+
+  // Retrieve the dimensions of the data in the file
+  scorpio::register_file(spa_data_file_name,scorpio::Read);
+  const int source_data_nlevs = scorpio::get_dimlen(spa_data_file_name,"lev");
+  const int num_global_cols   = scorpio::get_dimlen(spa_data_file_name,"ncol");
+  EKAT_REQUIRE_MSG(nswbands==scorpio::get_dimlen(spa_data_file_name,"swband"),
+      "ERROR update_spa_data_from_file: Number of SW bands in simulation doesn't match the SPA data file");
+  EKAT_REQUIRE_MSG(nlwbands==scorpio::get_dimlen(spa_data_file_name,"lwband"),
+      "ERROR update_spa_data_from_file: Number of LW bands in simulation doesn't match the SPA data file");
+  scorpio::eam_pio_closefile(spa_data_file_name);
+
+  // Construct the grid needed for input:
+  auto grid = std::make_shared<PointGrid>("grid",num_local_cols,num_global_cols,source_data_nlevs,comm);
+  Kokkos::deep_copy(grid->get_dofs_gids().template get_view<gid_type*>(),unique_src_dofs);
+  grid->get_dofs_gids().sync_to_host();
+
+  // Construct the views to read source data in from file
+  // Note, all of the views being created here are meant to hold the source resolution
+  // data that will need to be horizontally interpolated to the simulation grid using the remap
+  // data (see remap_spa_data).
+  reader.source_data_nlevs = source_data_nlevs;
+  reader.hyam_h     = decltype(reader.hyam_h)("hyam",source_data_nlevs);
+  reader.hybm_h     = decltype(reader.hybm_h)("hybm",source_data_nlevs);
+  reader.PS         = view_1d<Real>("PS",num_local_cols);
+  reader.CCN3       = view_2d<Real>("CCN3",num_local_cols,source_data_nlevs);
+  reader.AER_G_SW   = view_3d<Real>("AER_G_SW",num_local_cols,nswbands,source_data_nlevs);
+  reader.AER_SSA_SW = view_3d<Real>("AER_SSA_SW",num_local_cols,nswbands,source_data_nlevs);
+  reader.AER_TAU_SW = view_3d<Real>("AER_TAU_SW",num_local_cols,nswbands,source_data_nlevs);
+  reader.AER_TAU_LW = view_3d<Real>("AER_TAU_LW",num_local_cols,nlwbands,source_data_nlevs);
+
+  reader.PS_h         = Kokkos::create_mirror_view(reader.PS);
+  reader.CCN3_h       = Kokkos::create_mirror_view(reader.CCN3);
+  reader.AER_G_SW_h   = Kokkos::create_mirror_view(reader.AER_G_SW);
+  reader.AER_SSA_SW_h = Kokkos::create_mirror_view(reader.AER_SSA_SW);
+  reader.AER_TAU_SW_h = Kokkos::create_mirror_view(reader.AER_TAU_SW);
+  reader.AER_TAU_LW_h = Kokkos::create_mirror_view(reader.AER_TAU_LW);
+
+  // Set up input structure to read data from file.
+  using namespace ShortFieldTagsNames;
+  FieldLayout scalar1d_layout { {LEV}, {source_data_nlevs} };
+  FieldLayout scalar2d_layout_mid { {COL}, {num_local_cols} };
+  FieldLayout scalar3d_layout_mid { {COL,LEV}, {num_local_cols, source_data_nlevs} };
+  FieldLayout scalar3d_swband_layout { {COL,SWBND, LEV}, {num_local_cols, nswbands, source_data_nlevs} }; 
+  FieldLayout scalar3d_lwband_layout { {COL,LWBND, LEV}, {num_local_cols, nlwbands, source_data_nlevs} };
+  std::map<std::string,view_1d_host<Real>> host_views;
+  std::map<std::string,FieldLayout>  layouts;
+  // Define each input variable we need
+  host_views["hyam"] = view_1d_host<Real>(reader.hyam_h.data(),reader.hyam_h.size());
+  layouts.emplace("hyam", scalar1d_layout);
+  host_views["hybm"] = view_1d_host<Real>(reader.hybm_h.data(),reader.hybm_h.size());
+  layouts.emplace("hybm", scalar1d_layout);
+  //
+  host_views["PS"] = view_1d_host<Real>(reader.PS_h.data(),reader.PS_h.size());
+  layouts.emplace("PS", scalar2d_layout_mid);
+  //
+  host_views["CCN3"] = view_1d_host<Real>(reader.CCN3_h.data(),reader.CCN3_h.size());
+  layouts.emplace("CCN3",scalar3d_layout_mid);
+  //
+  host_views["AER_G_SW"] = view_1d_host<Real>(reader.AER_G_SW_h.data(),reader.AER_G_SW_h.size());
+  layouts.emplace("AER_G_SW",scalar3d_swband_layout);
+  //
+  host_views["AER_SSA_SW"] = view_1d_host<Real>(reader.AER_SSA_SW_h.data(),reader.AER_SSA_SW_h.size());
+  layouts.emplace("AER_SSA_SW",scalar3d_swband_layout);
+  //
+  host_views["AER_TAU_SW"] = view_1d_host<Real>(reader.AER_TAU_SW_h.data(),reader.AER_TAU_SW_h.size());
+  layouts.emplace("AER_TAU_SW",scalar3d_swband_layout);
+  //
+  host_views["AER_TAU_LW"] = view_1d_host<Real>(reader.AER_TAU_LW_h.data(),reader.AER_TAU_LW_h.size());
+  layouts.emplace("AER_TAU_LW",scalar3d_lwband_layout);
+  //
+
+  // Now that we have all the variables defined we can create the scorpio_input class to grab the data.
+  ekat::ParameterList spa_data_in_params;
+  spa_data_in_params.set("Filename",spa_data_file_name);
+  spa_data_in_params.set("Skip_Grid_Checks",true);  // We need to skip grid checks because multiple ranks may want the same column of source data.
+  reader.input = std::make_shared<AtmosphereInput>(spa_data_in_params,grid,host_views,layouts);
+  reader.time_index = -1;
+} // END init_spa_file_reader
+
+/*-----------------------------------------------------------------*/
+template<typename S, typename D>
+void SPAFunctions<S,D>
+::read_spa_data(
+    const SPAFileReader&        reader,
+    const int                   time_index)
+{
+  // Note: this only reads into the host views of the reader. The device views
+  //       are only updated in remap_spa_data.
+  reader.input->read_variables(time_index);
+} // END read_spa_data
+
 /*-----------------------------------------------------------------*/
 /* Note: In this routine the SPA source data is padded in the vertical
  * to facilitate the proper behavior at the boundaries when doing the
@@ -397,125 +617,29 @@ void SPAFunctions<S,D>
  */
 template<typename S, typename D>
 void SPAFunctions<S,D>
-::update_spa_data_from_file(
-    const std::string&          spa_data_file_name,
-    const int                   time_index, // zero-based
-    const int                   nswbands,
-    const int                   nlwbands,
+::remap_spa_data(
+    const SPAFileReader&        reader,
           SPAHorizInterp&       spa_horiz_interp,
           SPAInput&             spa_data)
 {
-  start_timer("EAMxx::SPA::update_spa_data_from_file");
-  // Ensure all ranks are operating independently when reading the file, so there's a copy on all ranks
-  auto comm = spa_horiz_interp.m_comm;
-
-  // Use HorizontalMap to define the set of source column data we need to load
   auto& spa_horiz_map = spa_horiz_interp.horiz_map;
-  auto unique_src_dofs = spa_horiz_map.get_unique_source_dofs();
-  const int num_local_cols = spa_horiz_map.get_num_unique_dofs();
-  scorpio::register_file(spa_data_file_name,scorpio::Read);
-  const int source_data_nlevs = scorpio::get_dimlen(spa_data_file_name,"lev");
-
-  // Construct local arrays to read data into
-  // Note, all of the views being created here are meant to hold the source resolution
-  // data that will need to be horizontally interpolated to the simulation grid using the remap
-  // data.  For example, 
-  //   We will first define the data surface pressure PS_v and read that from file.
-  //   then we will use the horizontal interpolation structure, spa_horiz_interp, to
-  //   interpolate PS_v onto the simulation grid: PS_v -> spa_data.PS
-  //   and so on for the other variables.
-  start_timer("EAMxx::SPA::update_spa_data_from_file::read_data");
-  std::vector<std::string> fnames = {"hyam","hybm","PS","CCN3","AER_G_SW","AER_SSA_SW","AER_TAU_SW","AER_TAU_LW"};
-  ekat::ParameterList spa_data_in_params;
-  spa_data_in_params.set("Field Names",fnames);
-  spa_data_in_params.set("Filename",spa_data_file_name);
-  spa_data_in_params.set("Skip_Grid_Checks",true);  // We need to skip grid checks because multiple ranks may want the same column of source data.
-  
-  // Retrieve number of cols on spa_data_file.
-  scorpio::register_file(spa_data_file_name,scorpio::Read);
-  int num_global_cols = scorpio::get_dimlen(spa_data_file_name,"ncol");
-  scorpio::eam_pio_closefile(spa_data_file_name);
-
-  // Construct the grid needed for input:
-  auto grid = std::make_shared<PointGrid>("grid",num_local_cols,num_global_cols,source_data_nlevs,comm);
-  Kokkos::deep_copy(grid->get_dofs_gids().template get_view<gid_type*>(),unique_src_dofs);
-  grid->get_dofs_gids().sync_to_host();
+  const int nswbands = reader.AER_G_SW.extent_int(1);
+  const int nlwbands = reader.AER_TAU_LW.extent_int(1);
 
   // Check that padding matches source size:
-  EKAT_REQUIRE(source_data_nlevs+2 == spa_data.data.nlevs);
-  EKAT_REQUIRE_MSG(nswbands==scorpio::get_dimlen(spa_data_file_name,"swband"),
-      "ERROR update_spa_data_from_file: Number of SW bands in simulation doesn't match the SPA data file");
-  EKAT_REQUIRE_MSG(nlwbands==scorpio::get_dimlen(spa_data_file_name,"lwband"),
-      "ERROR update_spa_data_from_file: Number of LW bands in simulation doesn't match the SPA data file");
-
-  // Constuct views to read source data in from file
-  typename view_1d<Real>::HostMirror hyam_v_h("hyam",source_data_nlevs);
-  typename view_1d<Real>::HostMirror hybm_v_h("hybm",source_data_nlevs);
-  view_1d<Real> PS_v("PS",num_local_cols);
-  view_2d<Real> CCN3_v("CCN3",num_local_cols,source_data_nlevs);
-  view_3d<Real> AER_G_SW_v("AER_G_SW",num_local_cols,nswbands,source_data_nlevs);
-  view_3d<Real> AER_SSA_SW_v("AER_SSA_SW",num_local_cols,nswbands,source_data_nlevs);
-  view_3d<Real> AER_TAU_SW_v("AER_TAU_SW",num_local_cols,nswbands,source_data_nlevs);
-  view_3d<Real> AER_TAU_LW_v("AER_TAU_LW",num_local_cols,nlwbands,source_data_nlevs);
-
-  auto PS_v_h         = Kokkos::create_mirror_view(PS_v);
-  auto CCN3_v_h       = Kokkos::create_mirror_view(CCN3_v);      
-  auto AER_G_SW_v_h   = Kokkos::create_mirror_view(AER_G_SW_v);
-  auto AER_SSA_SW_v_h = Kokkos::create_mirror_view(AER_SSA_SW_v);
-  auto AER_TAU_SW_v_h = Kokkos::create_mirror_view(AER_TAU_SW_v);
-  auto AER_TAU_LW_v_h = Kokkos::create_mirror_view(AER_TAU_LW_v);
+  EKAT_REQUIRE(reader.source_data_nlevs+2 == spa_data.data.nlevs);
 
-  // Set up input structure to read data from file.
-  using namespace ShortFieldTagsNames;
-  FieldLayout scalar1d_layout { {LEV}, {source_data_nlevs} };
-  FieldLayout scalar2d_layout_mid { {COL}, {num_local_cols} };
-  FieldLayout scalar3d_layout_mid { {COL,LEV}, {num_local_cols, source_data_nlevs} };
-  FieldLayout scalar3d_swband_layout { {COL,SWBND, LEV}, {num_local_cols, nswbands, source_data_nlevs} }; 
-  FieldLayout scalar3d_lwband_layout { {COL,LWBND, LEV}, {num_local_cols, nlwbands, source_data_nlevs} };
-  std::map<std::string,view_1d_host<Real>> host_views;
-  std::map<std::string,FieldLayout>  layouts;
-  // Define each input variable we need
-  host_views["hyam"] = view_1d_host<Real>(hyam_v_h.data(),hyam_v_h.size());
-  layouts.emplace("hyam", scalar1d_layout);
-  host_views["hybm"] = view_1d_host<Real>(hybm_v_h.data(),hybm_v_h.size());
-  layouts.emplace("hybm", scalar1d_layout);
-  //
-  host_views["PS"] = view_1d_host<Real>(PS_v_h.data(),PS_v_h.size());
-  layouts.emplace("PS", scalar2d_layout_mid);
-  //
-  host_views["CCN3"] = view_1d_host<Real>(CCN3_v_h.data(),CCN3_v_h.size());
-  layouts.emplace("CCN3",scalar3d_layout_mid);
-  //
-  host_views["AER_G_SW"] = view_1d_host<Real>(AER_G_SW_v_h.data(),AER_G_SW_v_h.size());
-  layouts.emplace("AER_G_SW",scalar3d_swband_layout);
-  //
-  host_views["AER_SSA_SW"] = view_1d_host<Real>(AER_SSA_SW_v_h.data(),AER_SSA_SW_v_h.size());
-  layouts.emplace("AER_SSA_SW",scalar3d_swband_layout);
-  //
-  host_views["AER_TAU_SW"] = view_1d_host<Real>(AER_TAU_SW_v_h.data(),AER_TAU_SW_v_h.size());
-  layouts.emplace("AER_TAU_SW",scalar3d_swband_layout);
-  //
-  host_views["AER_TAU_LW"] = view_1d_host<Real>(AER_TAU_LW_v_h.data(),AER_TAU_LW_v_h.size());
-  layouts.emplace("AER_TAU_LW",scalar3d_lwband_layout);
-  //
-  
-  // Now that we have all the variables defined we can use the scorpio_input class to grab the data.
-  AtmosphereInput spa_data_input(spa_data_in_params,grid,host_views,layouts);
-  spa_data_input.read_variables(time_index);
-  spa_data_input.finalize();
-  scorpio::eam_pio_closefile(spa_data_file_name);
-  stop_timer("EAMxx::SPA::update_spa_data_from_file::read_data");
-  start_timer("EAMxx::SPA::update_spa_data_from_file::apply_remap");
+  start_timer("EAMxx::SPA::remap_spa_data::apply_remap");
   // Copy data from host back to the device views.
-  Kokkos::deep_copy(PS_v,PS_v_h);
-  Kokkos::deep_copy(CCN3_v      , CCN3_v_h);      
-  Kokkos::deep_copy(AER_G_SW_v  , AER_G_SW_v_h);
-  Kokkos::deep_copy(AER_SSA_SW_v, AER_SSA_SW_v_h);
-  Kokkos::deep_copy(AER_TAU_SW_v, AER_TAU_SW_v_h);
-  Kokkos::deep_copy(AER_TAU_LW_v, AER_TAU_LW_v_h);
+  Kokkos::deep_copy(reader.PS        , reader.PS_h);
+  Kokkos::deep_copy(reader.CCN3      , reader.CCN3_h);
+  Kokkos::deep_copy(reader.AER_G_SW  , reader.AER_G_SW_h);
+  Kokkos::deep_copy(reader.AER_SSA_SW, reader.AER_SSA_SW_h);
+  Kokkos::deep_copy(reader.AER_TAU_SW, reader.AER_TAU_SW_h);
+  Kokkos::deep_copy(reader.AER_TAU_LW, reader.AER_TAU_LW_h);
 
   // Apply the remap to this data
-  spa_horiz_map.apply_remap(PS_v,spa_data.PS); // Note PS is not padded, so remap can be applied right away
+  spa_horiz_map.apply_remap(reader.PS,spa_data.PS); // Note PS is not padded, so remap can be applied right away
   // For padded data we need create temporary arrays to store the direct remapped data, then we can add
   // padding.
   int tgt_ncol = spa_data.data.ncols;
@@ -526,13 +650,13 @@ void SPAFunctions<S,D>
   view_3d<Real> AER_TAU_SW_unpad("",tgt_ncol,nswbands,tgt_nlev);
   view_3d<Real> AER_TAU_LW_unpad("",tgt_ncol,nlwbands,tgt_nlev);
   // Apply remap to "unpadded" data
-  spa_horiz_map.apply_remap(CCN3_v,CCN3_unpad);
-  spa_horiz_map.apply_remap(AER_G_SW_v, AER_G_SW_unpad);
-  spa_horiz_map.apply_remap(AER_SSA_SW_v, AER_SSA_SW_unpad);
-  spa_horiz_map.apply_remap(AER_TAU_SW_v, AER_TAU_SW_unpad);
-  spa_horiz_map.apply_remap(AER_TAU_LW_v, AER_TAU_LW_unpad);
-  stop_timer("EAMxx::SPA::update_spa_data_from_file::apply_remap");
-  start_timer("EAMxx::SPA::update_spa_data_from_file::copy_and_pad");
+  spa_horiz_map.apply_remap(reader.CCN3,CCN3_unpad);
+  spa_horiz_map.apply_remap(reader.AER_G_SW, AER_G_SW_unpad);
+  spa_horiz_map.apply_remap(reader.AER_SSA_SW, AER_SSA_SW_unpad);
+  spa_horiz_map.apply_remap(reader.AER_TAU_SW, AER_TAU_SW_unpad);
+  spa_horiz_map.apply_remap(reader.AER_TAU_LW, AER_TAU_LW_unpad);
+  stop_timer("EAMxx::SPA::remap_spa_data::apply_remap");
+  start_timer("EAMxx::SPA::remap_spa_data::copy_and_pad");
   // Copy unpadded data to SPA data structure, add padding.
   // Note, all variables we map to are packed, while all the data we just loaded as
   // input are in real N-D views.  So we need to set the pack and index of the actual
@@ -591,7 +715,7 @@ void SPAFunctions<S,D>
       spa_data.data.AER_TAU_LW(icol,nband,kpack)[klev2] = AER_TAU_LW_unpad(icol,nband,klev1);
     }
   });
-  stop_timer("EAMxx::SPA::update_spa_data_from_file::copy_and_pad");
+  stop_timer("EAMxx::SPA::remap_spa_data::copy_and_pad");
   // The hybrid coordinates are just vertical data, so not remapped.  We still need to make
   // a padded version of the data.
   //   hya/b[0] = 0.0, note this is handled by deep copy above
@@ -600,18 +724,41 @@ void SPAFunctions<S,D>
   auto hybm_h       = Kokkos::create_mirror_view(spa_data.hybm);
   Kokkos::deep_copy(hyam_h,0.0);
   Kokkos::deep_copy(hybm_h,0.0);
-  for (int kk=0; kk<source_data_nlevs; kk++) {
+  for (int kk=0; kk<reader.source_data_nlevs; kk++) {
     int pack = (kk+1) / Spack::n; 
     int kidx = (kk+1) % Spack::n;
-    hyam_h(pack)[kidx] = hyam_v_h(kk);
-    hybm_h(pack)[kidx] = hybm_v_h(kk);
+    hyam_h(pack)[kidx] = reader.hyam_h(kk);
+    hybm_h(pack)[kidx] = reader.hybm_h(kk);
   }
-  const int pack = (source_data_nlevs+1) / Spack::n;
-  const int kidx = (source_data_nlevs+1) % Spack::n;
+  const int pack = (reader.source_data_nlevs+1) / Spack::n;
+  const int kidx = (reader.source_data_nlevs+1) % Spack::n;
   hyam_h(pack)[kidx] = 1e5; 
   hybm_h(pack)[kidx] = 0.0;
   Kokkos::deep_copy(spa_data.hyam,hyam_h);
   Kokkos::deep_copy(spa_data.hybm,hybm_h);
+} // END remap_spa_data
+
+/*-----------------------------------------------------------------*/
+template<typename S, typename D>
+void SPAFunctions<S,D>
+::update_spa_data_from_file(
+    const std::string&          spa_data_file_name,
+    const int                   time_index, // zero-based
+    const int                   nswbands,
+    const int                   nlwbands,
+          SPAHorizInterp&       spa_horiz_interp,
+          SPAInput&             spa_data)
+{
+  start_timer("EAMxx::SPA::update_spa_data_from_file");
+  SPAFileReader reader;
+  init_spa_file_reader(spa_data_file_name,nswbands,nlwbands,spa_horiz_interp,reader);
+
+  start_timer("EAMxx::SPA::update_spa_data_from_file::read_data");
+  read_spa_data(reader,time_index);
+  reader.input->finalize();
+  stop_timer("EAMxx::SPA::update_spa_data_from_file::read_data");
+
+  remap_spa_data(reader,spa_horiz_interp,spa_data);
   stop_timer("EAMxx::SPA::update_spa_data_from_file");
 
 } // END update_spa_data_from_file
@@ -626,8 +773,10 @@ void SPAFunctions<S,D>
   const util::TimeStamp& ts,
         SPAHorizInterp&  spa_horiz_interp,
         SPATimeState&    time_state, 
+        SPAFileReader&   reader,
         SPAInput&        spa_beg,
-        SPAInput&        spa_end)
+        SPAInput&        spa_end,
+  const bool             prefetch)
 {
 
   // Now we check if we have to update the data that changes monthly
@@ -635,20 +784,61 @@ void SPAFunctions<S,D>
   //        any other frequency.
   const auto month = ts.get_month();
   if (month != time_state.current_month or !time_state.inited) {
+    const bool is_next_month = time_state.inited and
+      month == (time_state.current_month==12 ? 1 : time_state.current_month+1);
 
     // Update the SPA time state information
     time_state.current_month = month;
     time_state.t_beg_month = util::TimeStamp({ts.get_year(),month,1}, {0,0,0}).frac_of_year_in_days();
     time_state.days_this_month = util::days_in_month(ts.get_year(),month);
+
+    if (not reader.input) {
+      init_spa_file_reader(spa_data_file_name,nswbands,nlwbands,spa_horiz_interp,reader);
+    }
+
+    // Read (unless it was prefetched) and remap the data of a time slice.
+    // Note: the read waits for any pending prefetch, since all scorpio calls do.
+    auto load = [&](const int time_index, SPAInput& spa_data) {
+      start_timer("EAMxx::SPA::update_spa_data_from_file");
+      if (reader.time_index==time_index) {
+        scorpio::wait_for_async_io();
+      } else {
+        start_timer("EAMxx::SPA::update_spa_data_from_file::read_data");
+        read_spa_data(reader,time_index);
+        reader.time_index = time_index;
+        stop_timer("EAMxx::SPA::update_spa_data_from_file::read_data");
+      }
+      remap_spa_data(reader,spa_horiz_interp,spa_data);
+      stop_timer("EAMxx::SPA::update_spa_data_from_file");
+    };
+
     // Update the SPA forcing data for this month and next month
-    // Start by copying next months data to this months data structure.  
+    // If we moved to the next month, its data is already in spa_end, so we simply
+    // swap beg and end, and only load the data of the following month.
     // NOTE: If the timestep is bigger than monthly this could cause the wrong values
     //       to be assigned.  A timestep greater than a month is very unlikely so we
     //       will proceed.
     // NOTE: we use zero-based time indexing here.
-    update_spa_data_from_file(spa_data_file_name,time_state.current_month-1,nswbands,nlwbands,spa_horiz_interp,spa_beg);
+    if (is_next_month) {
+      std::swap(spa_beg,spa_end);
+    } else {
+      load(time_state.current_month-1,spa_beg);
+    }
     int next_month = time_state.current_month==12 ? 1 : time_state.current_month+1;
-    update_spa_data_from_file(spa_data_file_name,next_month-1,nswbands,nlwbands,spa_horiz_interp,spa_end);
+    load(next_month-1,spa_end);
+
+    // Read the data of the month after next in the background, while the model runs.
+    // Only the read runs on the async I/O thread, into the host views of the reader,
+    // which are not used until the next month change.
+    if (prefetch) {
+      const int prefetch_month = next_month==12 ? 1 : next_month+1;
+      const int time_index = prefetch_month-1;
+      auto input = reader.input;
+      scorpio::read_async([input,time_index]() {
+        input->read_variables(time_index);
+      });
+      reader.time_index = time_index;
+    }
     // If time state was not initialized it is now:
     time_state.inited = true;
   }
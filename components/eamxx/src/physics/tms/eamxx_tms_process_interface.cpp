@@ -70,10 +70,8 @@ void TurbulentMountainStress::initialize_impl (const RunType /* run_type */)
 void TurbulentMountainStress::run_impl (const double /* dt */)
 {
   // Helper views
-  const auto pseudo_density = get_field_in("pseudo_density").get_view<const Spack**>();
-  const auto qv             = get_field_in("qv").get_view<const Spack**>();
-  const auto dz             = m_buffer.dz;
-  const auto z_int          = m_buffer.z_int;
+  const auto pseudo_density = ekat::scalarize(get_field_in("pseudo_density").get_view<const Spack**>());
+  const auto qv             = ekat::scalarize(get_field_in("qv").get_view<const Spack**>());
 
   // Input views
   const auto horiz_winds = get_field_in("horiz_winds").get_view<const Spack***>();
@@ -88,35 +86,32 @@ void TurbulentMountainStress::run_impl (const double /* dt */)
   const auto surf_drag_coeff_tms = get_field_out("surf_drag_coeff_tms").get_view<Real*>();
   const auto wind_stress_tms     = get_field_out("wind_stress_tms").get_view<Real**>();
 
-  // Preprocess inputs
+  // Preprocess inputs. TMS only uses the 2 lowest levels, so there's no need to
+  // compute exner and z_mid on the whole column with a team per column. Instead,
+  // do a flat loop over columns, and compute them only on those 2 levels.
+  // Note: the z_int values are accumulated from the surface, as in calculate_z_int.
   const int ncols = m_ncols;
   const int nlevs = m_nlevs;
-  const int nlev_packs = ekat::npack<Spack>(nlevs);
-  // calculate_z_int contains a team-level parallel_scan, which requires a special policy
-  const auto scan_policy = ekat::ExeSpaceUtils<TMSFunctions::KT::ExeSpace>::get_thread_range_parallel_scan_team_policy(ncols, nlev_packs);
-  Kokkos::parallel_for(scan_policy, KOKKOS_LAMBDA (const TMSFunctions::KT::MemberType& team) {
-    const int i = team.league_rank();
-
-    const auto p_mid_i = ekat::subview(p_mid, i);
-    const auto exner_i = ekat::subview(exner, i);
-    const auto pseudo_density_i = ekat::subview(pseudo_density, i);
-    const auto T_mid_i = ekat::subview(T_mid, i);
-    const auto qv_i = ekat::subview(qv, i);
-    const auto dz_i = ekat::subview(dz, i);
-    const auto z_int_i = ekat::subview(z_int, i);
-    const auto z_mid_i = ekat::subview(z_mid, i);
-
-    // Calculate exner
-    PF::exner_function<Spack>(team, p_mid_i, exner_i);
-
-    // Calculate z_mid
-    PF::calculate_dz(team, pseudo_density_i, p_mid_i, T_mid_i, qv_i, dz_i);
-    const Real z_surf = 0.0; // For now, set z_int(i,nlevs) = z_surf = 0
-    team.team_barrier();
-    PF::calculate_z_int(team, nlevs, dz_i, z_surf, z_int_i);
-    team.team_barrier();
-    PF::calculate_z_mid(team, nlevs, z_int_i, z_mid_i);
-  });
+  {
+    const auto T_mid_s = ekat::scalarize(T_mid);
+    const auto p_mid_s = ekat::scalarize(p_mid);
+    const auto exner_s = ekat::scalarize(exner);
+    const auto z_mid_s = ekat::scalarize(z_mid);
+    const int kb = nlevs-1;
+    const int kt = nlevs-2;
+    Kokkos::parallel_for(TMSFunctions::KT::RangePolicy(0, ncols), KOKKOS_LAMBDA (const int i) {
+      const Real z_surf = 0.0; // For now, set z_int(i,nlevs) = z_surf = 0
+      const auto dz_b = PF::calculate_dz(pseudo_density(i,kb), p_mid_s(i,kb), T_mid_s(i,kb), qv(i,kb));
+      const auto dz_t = PF::calculate_dz(pseudo_density(i,kt), p_mid_s(i,kt), T_mid_s(i,kt), qv(i,kt));
+      const auto z_int_b = z_surf + dz_b;
+      const auto z_int_t = z_int_b + dz_t;
+
+      exner_s(i,kb) = PF::exner_function(p_mid_s(i,kb));
+      exner_s(i,kt) = PF::exner_function(p_mid_s(i,kt));
+      z_mid_s(i,kb) = 0.5*(z_int_b + z_surf);
+      z_mid_s(i,kt) = 0.5*(z_int_t + z_int_b);
+    });
+  }
 
   // Compute TMS
   TMSFunctions::compute_tms(ncols, nlevs,
@@ -138,9 +133,7 @@ void TurbulentMountainStress::finalize_impl()
 size_t TurbulentMountainStress::requested_buffer_size_in_bytes() const
 {
   const int nlev_packs  = ekat::npack<Spack>(m_nlevs);
-  const int nlevi_packs = ekat::npack<Spack>(m_nlevs+1);
-  return Buffer::num_2d_midpoint_views*m_ncols*nlev_packs*sizeof(Spack) +
-         Buffer::num_2d_interface_views*m_ncols*nlevi_packs*sizeof(Spack);
+  return Buffer::num_2d_midpoint_views*m_ncols*nlev_packs*sizeof(Spack);
 }
 // =========================================================================================
 void TurbulentMountainStress::init_buffers(const ATMBufferManager &buffer_manager)
@@ -150,10 +143,9 @@ void TurbulentMountainStress::init_buffers(const ATMBufferManager &buffer_manage
 
   Spack* mem = reinterpret_cast<Spack*>(buffer_manager.get_memory());
   const int nlev_packs  = ekat::npack<Spack>(m_nlevs);
-  const int nlevi_packs = ekat::npack<Spack>(m_nlevs+1);
 
   uview_2d* buffer_mid_view_ptrs[Buffer::num_2d_midpoint_views] = {
-    &m_buffer.exner, &m_buffer.dz, &m_buffer.z_mid
+    &m_buffer.exner, &m_buffer.z_mid
   };
 
   for (int i=0; i<Buffer::num_2d_midpoint_views; ++i) {
@@ -161,15 +153,6 @@ void TurbulentMountainStress::init_buffers(const ATMBufferManager &buffer_manage
     mem += buffer_mid_view_ptrs[i]->size();
   }
 
-  uview_2d* buffer_int_view_ptrs[Buffer::num_2d_interface_views] = {
-    &m_buffer.z_int
-  };
-
-  for (int i=0; i<Buffer::num_2d_interface_views; ++i) {
-    *buffer_int_view_ptrs[i] = uview_2d(mem, m_ncols, nlevi_packs);
-    mem += buffer_int_view_ptrs[i]->size();
-  }
-
   size_t used_mem = (reinterpret_cast<Real*>(mem) - buffer_manager.get_memory())*sizeof(Real);
   EKAT_REQUIRE_MSG(used_mem == requested_buffer_size_in_bytes(),
                    "Error! Used memory != requested memory for TurbulentMountainStress.");
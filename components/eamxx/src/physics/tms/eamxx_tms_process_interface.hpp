@@ -43,10 +43,9 @@ public:
 
   // Structure for storing local variables initialized using the ATMBufferManager
   struct Buffer {
-    static constexpr int num_2d_midpoint_views = 3;
-    static constexpr int num_2d_interface_views = 1;
+    static constexpr int num_2d_midpoint_views = 2;
 
-    uview_2d exner, dz, z_mid, z_int;
+    uview_2d exner, z_mid;
   };
 
 #ifndef KOKKOS_ENABLE_CUDA
@@ -3,6 +3,16 @@
 namespace scream
 {
 
+namespace {
+// Scratch memory of all diagnostics. The entry is weak, so that the memory is
+// released when the last diagnostic using it is destroyed (before Kokkos is finalized).
+using scratch_type = KokkosTypes<DefaultDevice>::view_1d<Real>;
+std::weak_ptr<scratch_type>& shared_scratch () {
+  static std::weak_ptr<scratch_type> scratch;
+  return scratch;
+}
+} // anonymous namespace
+
 AtmosphereDiagnostic::
 AtmosphereDiagnostic (const ekat::Comm& comm, const ekat::ParameterList& params)
   : AtmosphereProcess(comm,params)
@@ -24,14 +34,7 @@ void AtmosphereDiagnostic::compute_diagnostic (const double dt) {
 
   // Set the timestamp of the diagnostic to the most
   // recent timestamp among the inputs
-  const auto& inputs = get_fields_in();
-  util::TimeStamp ts;
-  for (const auto& f : inputs) {
-    const auto& fts = f.get_header().get_tracking().get_time_stamp();
-    if (not ts.is_valid() || ts<fts) {
-      ts = fts;
-    }
-  }
+  const auto ts = get_inputs_time_stamp();
 
   // If all inputs have invalid timestamps, we have a problem.
   EKAT_REQUIRE_MSG (ts.is_valid(),
@@ -46,6 +49,42 @@ void AtmosphereDiagnostic::compute_diagnostic (const double dt) {
   // to something invalid, which can be used by downstream classes to determine
   // if the diag has been successfully computed or not.
   compute_diagnostic_impl ();
+
+  if (m_diagnostic_output.get_header().get_tracking().get_time_stamp().is_valid()) {
+    m_last_compute_ts = ts;
+  } else {
+    m_last_compute_ts = util::TimeStamp();
+  }
+}
+
+util::TimeStamp AtmosphereDiagnostic::get_inputs_time_stamp () const {
+  util::TimeStamp ts;
+  for (const auto& f : get_fields_in()) {
+    const auto& fts = f.get_header().get_tracking().get_time_stamp();
+    if (not ts.is_valid() || ts<fts) {
+      ts = fts;
+    }
+  }
+  return ts;
+}
+
+bool AtmosphereDiagnostic::is_up_to_date () const {
+  return m_last_compute_ts.is_valid() and m_last_compute_ts==get_inputs_time_stamp();
+}
+
+Real* AtmosphereDiagnostic::get_scratch_memory (const size_t num_reals) {
+  if (m_scratch==nullptr) {
+    m_scratch = shared_scratch().lock();
+    if (m_scratch==nullptr) {
+      m_scratch = std::make_shared<scratch_type>();
+      shared_scratch() = m_scratch;
+    }
+  }
+  if (m_scratch->size()<num_reals) {
+    // Other diags retrieve the memory at every compute, so they see the new allocation
+    *m_scratch = scratch_type("diagnostics scratch",num_reals);
+  }
+  return m_scratch->data();
 }
 
 void AtmosphereDiagnostic::run_impl (const double dt) {
@@ -52,6 +52,14 @@ public:
   Field get_diagnostic () const;
 
   void compute_diagnostic (const double dt = 0);
+
+  // The most recent time stamp among the inputs
+  util::TimeStamp get_inputs_time_stamp () const;
+
+  // Whether the diag output was computed from the inputs at their current
+  // time stamp. Users sharing a diagnostic (e.g., several output streams)
+  // can use this to avoid recomputing it.
+  bool is_up_to_date () const;
 protected:
 
   void set_required_field_impl (const Field& f) final;
@@ -66,11 +74,22 @@ protected:
   void run_impl (const double dt);
   void finalize_impl   () { /* Nothing to do */ }
 
+  // Scratch memory shared by all diagnostics. Diagnostics are computed one at a
+  // time, so their temporaries can live in the same memory, sized by the largest
+  // request, rather than each diag allocating its own. The memory is only valid
+  // until compute_diagnostic_impl returns, so it must be retrieved at every call.
+  Real* get_scratch_memory (const size_t num_reals);
+
   // Some diagnostics will need the timestep, store here.
   double m_dt;
 
   // Diagnostics are meant to return a field
   Field m_diagnostic_output;
+
+  // Inputs time stamp at the last successful call to compute_diagnostic
+  util::TimeStamp m_last_compute_ts;
+
+  std::shared_ptr<KokkosTypes<DefaultDevice>::view_1d<Real>> m_scratch;
 };
 
 // A short name for the factory for atmosphere diagnostics
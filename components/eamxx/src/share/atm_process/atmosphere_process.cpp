@@ -5,7 +5,11 @@
 
 #include "ekat/ekat_assert.hpp"
 
+#include <chrono>
+#include <cmath>
+#include <limits>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
@@ -53,16 +57,30 @@ AtmosphereProcess (const ekat::Comm& comm, const ekat::ParameterList& params)
   EKAT_REQUIRE_MSG (m_num_subcycles>0,
       "Error! Invalid number of subcycles in param list " + m_params.name() + ".\n"
       "  - Num subcycles: " + std::to_string(m_num_subcycles) + "\n");
+  m_num_subcycles_param = m_num_subcycles;
+
+  m_adaptive_subcycling = m_params.get<bool>("adaptive_subcycling",false);
+  m_max_num_subcycles = std::max(m_params.get<int>("max_number_of_subcycles",16),m_num_subcycles);
 
   m_timer_prefix = m_params.get<std::string>("Timer Prefix","EAMxx::");
 
   m_repair_log_level = str2LogLevel(m_params.get<std::string>("repair_log_level","warn"));
 
+  m_property_checks_frequency = m_params.get<int>("property_checks_frequency",1);
+  m_property_checks_num_col_chunks = m_params.get<int>("property_checks_num_column_chunks",1);
+  EKAT_REQUIRE_MSG (m_property_checks_frequency>0 && m_property_checks_num_col_chunks>0,
+      "Error! Invalid property checks sampling in param list " + m_params.name() + ".\n"
+      "  - property_checks_frequency: " + std::to_string(m_property_checks_frequency) + "\n"
+      "  - property_checks_num_column_chunks: " + std::to_string(m_property_checks_num_col_chunks) + "\n");
+
   // Info for mass and energy conservation checks
   m_column_conservation_check_data.has_check =
       m_params.get<bool>("enable_column_conservation_checks", false);
 
   m_internal_diagnostics_level = m_params.get<int>("internal_diagnostics_level", 0);
+  m_incr_hash.nsteps = m_params.get<int>("bfb_hash_nsteps", 0);
+
+  m_perf_stats.enabled = m_params.get<bool>("report_performance_stats", false);
 }
 
 void AtmosphereProcess::initialize (const TimeStamp& t0, const RunType run_type) {
@@ -87,12 +105,20 @@ void AtmosphereProcess::initialize (const TimeStamp& t0, const RunType run_type)
 
 void AtmosphereProcess::run (const double dt) {
   m_atm_logger->debug("[EAMxx::" + this->name() + "] run...");
-  start_timer (m_timer_prefix + this->name() + "::run");
+  start_run_timer (RunTimerRun);
+  if (m_perf_stats.enabled) {
+    Kokkos::fence();
+  }
+  const auto run_start = std::chrono::steady_clock::now();
   if (m_params.get("enable_precondition_checks", true)) {
     // Run 'pre-condition' property checks stored in this AP
     run_precondition_checks();
   }
 
+  if (m_adaptive_subcycling) {
+    set_adaptive_num_subcycles(dt);
+  }
+
   // Let the derived class do the actual run
   auto dt_sub = dt / m_num_subcycles;
 
@@ -133,18 +159,122 @@ void AtmosphereProcess::run (const double dt) {
     run_postcondition_checks();
   }
 
+  ++m_num_runs;
   m_time_stamp += dt;
   if (m_update_time_stamps) {
     // Update all output fields time stamps
     update_time_stamps ();
   }
-  stop_timer (m_timer_prefix + this->name() + "::run");
+  if (m_incr_hash.nsteps>0) {
+    update_incremental_global_state_hash ();
+  }
+  if (m_perf_stats.enabled) {
+    Kokkos::fence();
+    const auto run_end = std::chrono::steady_clock::now();
+    m_perf_stats.run_time += std::chrono::duration<double>(run_end-run_start).count();
+    ++m_perf_stats.num_runs;
+  }
+  stop_run_timer (RunTimerRun);
+}
+
+void AtmosphereProcess::set_adaptive_num_subcycles (const double dt) {
+  // All ranks must agree on the number of subcycles, since the process may
+  // perform collective operations inside each subcycle. Use the most
+  // restrictive stable dt across ranks (non-positive values mean no estimate).
+  const double local_dt = get_max_stable_dt();
+  const double my_val = local_dt>0 ? local_dt : std::numeric_limits<double>::max();
+  double max_stable_dt;
+  m_comm.all_reduce(&my_val,&max_stable_dt,1,MPI_MIN);
+
+  if (max_stable_dt==std::numeric_limits<double>::max()) {
+    m_num_subcycles = m_num_subcycles_param;
+  } else {
+    const int n = static_cast<int>(std::ceil(dt/max_stable_dt));
+    m_num_subcycles = std::min(std::max(n,1),m_max_num_subcycles);
+    if (n>m_max_num_subcycles) {
+      log(LogLevel::warn,
+          "[EAMxx::" + this->name() + "] the stable dt (" + std::to_string(max_stable_dt) + "s)"
+          " requires " + std::to_string(n) + " subcycles, but max_number_of_subcycles is "
+          + std::to_string(m_max_num_subcycles) + ".\n");
+    }
+  }
 }
 
 void AtmosphereProcess::finalize (/* what inputs? */) {
+  if (m_perf_stats.enabled) {
+    report_performance_stats();
+  }
+  if (m_incr_hash.nsteps>0) {
+    flush_incremental_global_state_hash (true);
+  }
   finalize_impl(/* what inputs? */);
 }
 
+void AtmosphereProcess::report_performance_stats () const {
+  using namespace ShortFieldTagsNames;
+
+  // Estimate the memory traffic of one run from the size of the fields the
+  // process requires and computes. Fields that are both are counted in both.
+  // We also get the largest number of columns and levels the process works on.
+  double bytes[2] = {0,0};
+  int ncols = 0, nlevs = 0;
+  auto add_field = [&](const Field& f, const int idx) {
+    const auto& fl = f.get_header().get_identifier().get_layout();
+    bytes[idx] += static_cast<double>(fl.size())*get_type_size(f.data_type());
+    if (fl.has_tag(COL)) {
+      ncols = std::max(ncols,fl.dim(COL));
+    }
+    for (auto t : {LEV, ILEV}) {
+      if (fl.has_tag(t)) {
+        nlevs = std::max(nlevs,fl.dim(t));
+      }
+    }
+  };
+  auto add_group = [&](const FieldGroup& g, const int idx) {
+    if (g.m_info->m_bundled) {
+      add_field(*g.m_bundle,idx);
+    } else {
+      for (const auto& it : g.m_fields) {
+        add_field(*it.second,idx);
+      }
+    }
+  };
+  for (const auto& f : m_fields_in)  { add_field(f,0); }
+  for (const auto& f : m_fields_out) { add_field(f,1); }
+  for (const auto& g : m_groups_in)  { add_group(g,0); }
+  for (const auto& g : m_groups_out) { add_group(g,1); }
+
+  // Aggregate across ranks. Throughput uses the slowest rank's time, since
+  // that is what determines the time to solution.
+  const int nruns = m_perf_stats.num_runs;
+  double max_time, gbytes[2], gcols;
+  const double my_cols = ncols;
+  m_comm.all_reduce(&m_perf_stats.run_time,&max_time,1,MPI_MAX);
+  m_comm.all_reduce(bytes,gbytes,2,MPI_SUM);
+  m_comm.all_reduce(&my_cols,&gcols,1,MPI_SUM);
+
+  if (nruns==0 || max_time<=0) {
+    return;
+  }
+
+  const double time_per_run = max_time / nruns;
+  const double gb = 1e-9;
+  std::stringstream ss;
+  ss << "[EAMxx::" << this->name() << "] performance stats (" << nruns << " runs):\n"
+     << "  - time per run (s, max over ranks): " << time_per_run << "\n"
+     << "  - bytes read per run (GB, all ranks): " << gbytes[0]*gb << "\n"
+     << "  - bytes written per run (GB, all ranks): " << gbytes[1]*gb << "\n"
+     << "  - effective bandwidth (GB/s): " << (gbytes[0]+gbytes[1])*gb/time_per_run << "\n";
+  if (gcols>0) {
+    ss << "  - columns per second: " << gcols/time_per_run << "\n";
+  }
+  if (gcols>0 && nlevs>0) {
+    // Per rank, using the average number of columns per rank
+    ss << "  - time per column per level (s): " << time_per_run/(gcols/m_comm.size()*nlevs) << "\n";
+  }
+  m_atm_logger->info(ss.str());
+}
+
 void AtmosphereProcess::setup_tendencies_requests () {
   using vos_t = std::vector<std::string>;
   auto tend_vec = m_params.get<vos_t>("compute_tendencies",{});
@@ -365,6 +495,7 @@ void AtmosphereProcess::run_property_check (const prop_check_ptr&       property
                                             const CheckFailHandling     check_fail_handling,
                                             const PropertyCheckCategory property_check_category) const {
   m_atm_logger->trace("[" + this->name() + "] run_property_check '" + property_check->name() + "'...");
+  const bool sampled = property_check->is_sampled();
   auto res_and_msg = property_check->check();
 
   // string for output
@@ -372,6 +503,23 @@ void AtmosphereProcess::run_property_check (const prop_check_ptr&       property
   if (property_check_category == PropertyCheckCategory::Precondition)  pre_post_str = "pre-condition";
   if (property_check_category == PropertyCheckCategory::Postcondition) pre_post_str = "post-condition";
 
+  const bool sampling = m_property_checks_frequency>1 || m_property_checks_num_col_chunks>1;
+  if (res_and_msg.result==CheckResult::Pass) {
+    if (not sampled) {
+      property_check->set_escalated(false);
+    }
+  } else if (sampling && not property_check->is_escalated()) {
+    // A hit while sampling: from now on, run the check on all columns at every
+    // run, until it passes. If possible, re-run it on all columns right away,
+    // so that the outcome (and the repair, if any) covers the whole field.
+    property_check->set_escalated(true);
+    m_atm_logger->debug("[" + this->name() + "] " + pre_post_str + " property check '"
+                        + property_check->name() + "' did not pass on sampled data. Escalating to full check.");
+    if (sampled && property_check->can_rerun_on_all_columns()) {
+      res_and_msg = property_check->check();
+    }
+  }
+
   if (res_and_msg.result==CheckResult::Pass) {
     // Do nothing
   } else if (res_and_msg.result==CheckResult::Repairable) {
@@ -458,49 +606,58 @@ void AtmosphereProcess::run_property_check (const prop_check_ptr&       property
 
 void AtmosphereProcess::run_precondition_checks () const {
   m_atm_logger->debug("[" + this->name() + "] run_precondition_checks...");
-  start_timer(m_timer_prefix + this->name() + "::run-precondition-checks");
+  start_run_timer(RunTimerPrecondition);
   // Run all pre-condition property checks
   for (const auto& it : m_precondition_checks) {
+    if (not setup_property_check_sample(it.second)) {
+      continue;
+    }
     run_property_check(it.second, it.first,
                        PropertyCheckCategory::Precondition);
   }
-  stop_timer(m_timer_prefix + this->name() + "::run-precondition-checks");
+  stop_run_timer(RunTimerPrecondition);
   m_atm_logger->debug("[" + this->name() + "] run_precondition_checks...done!");
 }
 
 void AtmosphereProcess::run_postcondition_checks () const {
   m_atm_logger->debug("[" + this->name() + "] run_postcondition_checks...");
-  start_timer(m_timer_prefix + this->name() + "::run-postcondition-checks");
+  start_run_timer(RunTimerPostcondition);
   // Run all post-condition property checks
   for (const auto& it : m_postcondition_checks) {
+    if (not setup_property_check_sample(it.second)) {
+      continue;
+    }
     run_property_check(it.second, it.first,
                        PropertyCheckCategory::Postcondition);
   }
-  stop_timer(m_timer_prefix + this->name() + "::run-postcondition-checks");
+  stop_run_timer(RunTimerPostcondition);
   m_atm_logger->debug("[" + this->name() + "] run_postcondition_checks...done!");
 }
 
 void AtmosphereProcess::run_column_conservation_check () const {
   m_atm_logger->debug("[" + this->name() + "] run_column_conservation_check...");
-  start_timer(m_timer_prefix + this->name() + "::run-column-conservation-checks");
-  // Conservation check is run as a postcondition check
-  run_property_check(m_column_conservation_check.second,
-                     m_column_conservation_check.first,
-                     PropertyCheckCategory::Postcondition);
-  stop_timer(m_timer_prefix + this->name() + "::run-column-conservation-checks");
+  start_run_timer(RunTimerColumnConservation);
+  // Conservation check is run as a postcondition check. The current mass/energy
+  // were computed for the same sample, since m_num_runs has not changed since then.
+  if (setup_property_check_sample(m_column_conservation_check.second)) {
+    run_property_check(m_column_conservation_check.second,
+                       m_column_conservation_check.first,
+                       PropertyCheckCategory::Postcondition);
+  }
+  stop_run_timer(RunTimerColumnConservation);
   m_atm_logger->debug("[" + this->name() + "] run_column-conservation_checks...done!");
 }
 
 void AtmosphereProcess::init_step_tendencies () {
   if (m_compute_proc_tendencies) {
-    start_timer(m_timer_prefix + this->name() + "::compute_tendencies");
+    start_run_timer(RunTimerTendencies);
     for (auto& it : m_start_of_step_fields) {
       const auto& fname = it.first;
       const auto& f     = get_field_out(fname);
             auto& f_beg = it.second;
       f_beg.deep_copy(f);
     }
-    stop_timer(m_timer_prefix + this->name() + "::compute_tendencies");
+    stop_run_timer(RunTimerTendencies);
   }
 }
 
@@ -508,7 +665,7 @@ void AtmosphereProcess::compute_step_tendencies (const double dt) {
   using namespace ShortFieldTagsNames;
   if (m_compute_proc_tendencies) {
     m_atm_logger->debug("[" + this->name() + "] computing tendencies...");
-    start_timer(m_timer_prefix + this->name() + "::compute_tendencies");
+    start_run_timer(RunTimerTendencies);
     for (auto it : m_proc_tendencies) {
       // Note: f_beg is nonconst, so we can store step tendency in it
       const auto& tname = it.first;
@@ -521,10 +678,32 @@ void AtmosphereProcess::compute_step_tendencies (const double dt) {
       f_beg.update(f,1,-1);
       tend.update(f_beg,1,1);
     }
-    stop_timer(m_timer_prefix + this->name() + "::compute_tendencies");
+    stop_run_timer(RunTimerTendencies);
   }
 }
 
+void AtmosphereProcess::start_run_timer (const RunTimer t) const {
+  auto& timer = m_run_timers[t];
+  if (timer.name=="") {
+    switch (t) {
+      case RunTimerRun:                timer.name = "::run"; break;
+      case RunTimerPrecondition:       timer.name = "::run-precondition-checks"; break;
+      case RunTimerPostcondition:      timer.name = "::run-postcondition-checks"; break;
+      case RunTimerColumnConservation: timer.name = "::run-column-conservation-checks"; break;
+      case RunTimerTendencies:         timer.name = "::compute_tendencies"; break;
+      default:
+        EKAT_ERROR_MSG ("Error! Unexpected run timer.\n");
+    }
+    timer.name = m_timer_prefix + this->name() + timer.name;
+  }
+  start_timer(timer.name,timer.handle);
+}
+
+void AtmosphereProcess::stop_run_timer (const RunTimer t) const {
+  auto& timer = m_run_timers[t];
+  stop_timer(timer.name,timer.handle);
+}
+
 bool AtmosphereProcess::has_required_field (const FieldIdentifier& id) const {
   return has_required_field(id.name(),id.get_grid_name());
 }
@@ -1110,8 +1289,25 @@ void AtmosphereProcess::compute_column_conservation_checks_data (const int dt)
   const auto& conservation_check =
       std::dynamic_pointer_cast<MassAndEnergyColumnConservationCheck>(m_column_conservation_check.second);
   conservation_check->set_dt(dt);
-  conservation_check->compute_current_mass();
-  conservation_check->compute_current_energy();
+  if (setup_property_check_sample(conservation_check)) {
+    conservation_check->compute_current_mass();
+    conservation_check->compute_current_energy();
+  }
+}
+
+bool AtmosphereProcess::
+setup_property_check_sample (const prop_check_ptr& property_check) const
+{
+  if (not property_check->is_escalated() &&
+      m_num_runs % m_property_checks_frequency != 0) {
+    return false;
+  }
+
+  // Cycle through the chunks over the runs where checks are performed
+  const int nchunks = m_property_checks_num_col_chunks;
+  const int chunk = (m_num_runs / m_property_checks_frequency) % nchunks;
+  property_check->set_sampled_chunk(chunk,nchunks);
+  return true;
 }
 
 } // namespace scream
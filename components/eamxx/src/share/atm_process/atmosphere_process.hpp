@@ -11,6 +11,8 @@
 #include "share/field/field.hpp"
 #include "share/field/field_group.hpp"
 #include "share/grid/grids_manager.hpp"
+#include "share/util/scream_timing.hpp"
+#include "share/util/scream_bfbhash.hpp"
 
 #include "ekat/mpi/ekat_comm.hpp"
 #include "ekat/ekat_parameter_list.hpp"
@@ -20,10 +22,12 @@
 #include "ekat/std_meta/ekat_std_any.hpp"
 #include "ekat/logging/ekat_logger.hpp"
 
+#include <array>
 #include <memory>
 #include <string>
 #include <set>
 #include <list>
+#include <vector>
 
 namespace scream
 {
@@ -111,6 +115,18 @@ public:
   void run (const double dt);
   void finalize   (/* what inputs? */);
 
+  // Complete the work that run may have left pending (e.g., on a host thread), storing
+  // its results in the internal fields of this process. The AD calls this at the end of
+  // a step only if a file written at that step (e.g., a restart file) contains some
+  // internal field. Otherwise, the process completes the work during a later run.
+  void finish_step () { finish_step_impl(); }
+
+  // Processes whose stable step depends on the current state can override this,
+  // returning the largest stable dt (in seconds) for the current (local) state.
+  // A non-positive value means the process has no such estimate.
+  // If adaptive_subcycling=true, run uses it to pick the number of subcycles.
+  virtual double get_max_stable_dt () const { return -1; }
+
   // Return the MPI communicator
   const ekat::Comm& get_comm () const { return m_comm; }
 
@@ -275,6 +291,14 @@ public:
                                const bool out = true, const bool internal = true) const;
   // For BFB tracking in production simulations.
   void print_fast_global_state_hash(const std::string& label) const;
+  // Incremental version of the above, enabled with bfb_hash_nsteps>0. After each
+  // run, hash the output fields whose time stamp advanced since they were last
+  // hashed, and accumulate the hashes locally (in total and per field). Every
+  // bfb_hash_nsteps runs, the accumulated hashes are reduced across ranks with a
+  // non-blocking reduction, which is completed (and printed, along with a per-field
+  // summary) when the next reduction is started, or at finalization.
+  void update_incremental_global_state_hash ();
+  void flush_incremental_global_state_hash (const bool final);
 
 protected:
 
@@ -405,11 +429,16 @@ protected:
   // Override this method to finalize the derived class
   virtual void finalize_impl(/* what inputs? */) = 0;
 
+  // Override this method if run_impl leaves work pending, to wait for it
+  // and store its results in the internal fields.
+  virtual void finish_step_impl () {}
+
   // This provides access to this process's timestamp.
   const TimeStamp& timestamp() const { return m_time_stamp; }
 
   // These three methods modify the FieldTracking of the input field (see field_tracking.hpp)
-  void update_time_stamps ();
+  // Processes whose outputs refer to an earlier time can override update_time_stamps.
+  virtual void update_time_stamps ();
   void add_me_as_provider (const Field& f);
   void add_me_as_customer (const Field& f);
 
@@ -454,6 +483,24 @@ protected:
   // A prefix to add to this atm proc timer
   std::string m_timer_prefix;
 
+  // Timers used at every run call. Their names and GPTL handles are set at
+  // the first use, to avoid building and hashing the names at every step.
+  enum RunTimer : int {
+    RunTimerRun = 0,
+    RunTimerPrecondition,
+    RunTimerPostcondition,
+    RunTimerColumnConservation,
+    RunTimerTendencies,
+    NumRunTimers
+  };
+  struct TimerInfo {
+    std::string     name;
+    timer_handle_t  handle = nullptr;
+  };
+  mutable std::array<TimerInfo,NumRunTimers> m_run_timers;
+  void start_run_timer (const RunTimer t) const;
+  void stop_run_timer (const RunTimer t) const;
+
   // The logger for the whole atmosphere
   // WARNING: this is non-const, but you should *NOT* modify its
   //          log level and/or its sinks. If you just need to log
@@ -499,6 +546,10 @@ private:
   // check: dt, tolerance, current mass and energy value per column.
   void compute_column_conservation_checks_data (const int dt);
 
+  // Whether the property check is due in this run, given the sampling settings.
+  // If it is, also set which chunk of columns the check inspects.
+  bool setup_property_check_sample (const prop_check_ptr& property_check) const;
+
   // Run an individual property check. The input property_check_category_name
   void run_property_check (const prop_check_ptr&       property_check,
                            const CheckFailHandling     check_fail_handling,
@@ -560,6 +611,14 @@ private:
   // The number of times this process needs to be subcycled
   int m_num_subcycles = 1;
 
+  // With adaptive subcycling, the number of subcycles is recomputed at each
+  // run from get_max_stable_dt, between 1 and m_max_num_subcycles. If the
+  // process has no estimate, we use number_of_subcycles from the params.
+  bool m_adaptive_subcycling = false;
+  int m_max_num_subcycles;
+  int m_num_subcycles_param;
+  void set_adaptive_num_subcycles (const double dt);
+
   // This can be queried by derived classes, in case they need to know which
   // iteration of the subcycle this is
   int m_subcycle_iter;
@@ -573,8 +632,79 @@ private:
   // Log level for when property checks perform a repair
   ekat::logger::LogLevel  m_repair_log_level;
 
+  // Sampling of property checks: run them only every m_property_checks_frequency
+  // runs, and only on one of m_property_checks_num_col_chunks chunks of columns,
+  // cycling through the chunks. A check that does not pass is run on all columns
+  // at every run, until it passes again.
+  int m_property_checks_frequency = 1;
+  int m_property_checks_num_col_chunks = 1;
+
+  // How many times the run method has been called
+  int m_num_runs = 0;
+
+  // Optional throughput stats for this process, reported at finalization.
+  // The run time is measured after a fence, so it is only collected if
+  // report_performance_stats=true, to avoid perturbing production runs.
+  struct PerfStats {
+    bool    enabled = false;
+    int     num_runs = 0;
+    double  run_time = 0;   // Seconds spent in run, summed over all calls
+  };
+  PerfStats m_perf_stats;
+  void report_performance_stats () const;
+
   // Controls global hashing output for debugging non-BFBness.
   int m_internal_diagnostics_level;
+
+  // State of the incremental BFB hashing (see update_incremental_global_state_hash)
+  struct IncrementalHash {
+    // The data of a field, as rows of 'last' entries, 'alloc_last' apart (to skip the padding).
+    // Subfields have no data, and are hashed separately.
+    struct Entry {
+      const Real* data;
+      int         size;
+      int         last;
+      int         alloc_last;
+    };
+    // A range of the data of a field, hashed by a single team
+    struct Chunk {
+      int entry;
+      int begin;
+      int end;
+    };
+    template<typename T>
+    using view_1d = KokkosTypes<DefaultDevice>::view_1d<T>;
+
+    int                 nsteps = 0;       // Steps between reductions (0 means disabled)
+    int                 num_steps = 0;    // Steps accumulated in local
+    bool                inited = false;
+    bfbhash::HashType   local = 0;
+
+    // The hashed fields, the time stamp at which they were last hashed, their hash
+    // accumulated in local, and how many times they were hashed since the last reduction
+    std::vector<Field>              fields;
+    std::vector<TimeStamp>          last_hashed;
+    std::vector<bfbhash::HashType>  field_local;
+    std::vector<int>                num_hashed;
+
+    // The device data of the fields, split in chunks, and the fields hashed in this run
+    view_1d<Entry>                          entries;
+    view_1d<Chunk>                          chunks;
+    view_1d<int>                            active;
+    view_1d<int>::HostMirror                active_h;
+    view_1d<bfbhash::HashType>              hashes;
+    view_1d<bfbhash::HashType>::HostMirror  hashes_h;
+
+    // Buffers and request of the pending reduction (must not be touched until completed).
+    // The first entry is the total hash, followed by the hash of each field.
+    std::vector<bfbhash::HashType>  send;
+    std::vector<bfbhash::HashType>  global;
+    std::vector<int>                send_num_hashed;
+    MPI_Request                     req = MPI_REQUEST_NULL;
+    int                             last_step = 0;    // Last step included in the pending reduction
+  };
+  IncrementalHash m_incr_hash;
+  void setup_incremental_global_state_hash ();
 };
 
 // ================= IMPLEMENTATION ================== //
@@ -394,6 +394,12 @@ void AtmosphereProcessGroup::run_sequential (const double dt) {
   //  - nobody from outside told this APG to not update timestamps
   const bool do_update = do_update_time_stamp() &&
                       (get_subcycle_iter()==get_num_subcycles()-1);
+  // Note: the sequence below cannot be captured in a CUDA/HIP graph and replayed.
+  // Each AtmosphereProcess::run interleaves kernels with host work that must run
+  // every step (property checks reading results back to host, time stamp updates,
+  // MPI reductions in conservation checks and diagnostics, I/O in some processes),
+  // and several processes fence or deep copy to host inside run_impl. Kernels of
+  // consecutive processes are otherwise enqueued asynchronously, with no fence here.
   for (auto atm_proc : m_atm_processes) {
     atm_proc->set_update_time_stamps(do_update);
     // Run the process
@@ -411,6 +417,12 @@ void AtmosphereProcessGroup::run_parallel (const double /* dt */) {
   EKAT_REQUIRE_MSG (false,"Error! Parallel splitting not yet implemented.\n");
 }
 
+void AtmosphereProcessGroup::finish_step_impl () {
+  for (auto atm_proc : m_atm_processes) {
+    atm_proc->finish_step();
+  }
+}
+
 void AtmosphereProcessGroup::finalize_impl (/* what inputs? */) {
   for (auto atm_proc : m_atm_processes) {
     atm_proc->finalize(/* what inputs? */);
@@ -664,6 +676,18 @@ process_required_field (const FieldRequest& req) {
   }
 }
 
+double AtmosphereProcessGroup::get_max_stable_dt () const
+{
+  double dt = -1;
+  for (const auto& atm_proc : m_atm_processes) {
+    const double proc_dt = atm_proc->get_max_stable_dt();
+    if (proc_dt>0 && (dt<=0 || proc_dt<dt)) {
+      dt = proc_dt;
+    }
+  }
+  return dt;
+}
+
 size_t AtmosphereProcessGroup::requested_buffer_size_in_bytes () const
 {
   size_t buf_size = 0;
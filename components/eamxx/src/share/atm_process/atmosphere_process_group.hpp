@@ -68,6 +68,9 @@ public:
 
   ScheduleType get_schedule_type () const { return m_group_schedule_type; }
 
+  // The group is as restrictive as its most restrictive process
+  double get_max_stable_dt () const override;
+
   // Computes total number of bytes needed for local variables
   size_t requested_buffer_size_in_bytes () const;
 
@@ -116,6 +119,7 @@ protected:
   void initialize_impl ();
   void run_impl        (const double dt);
   void finalize_impl   (/* what inputs? */);
+  void finish_step_impl ();
 
   void run_sequential (const double dt);
   void run_parallel   (const double dt);
@@ -4,7 +4,9 @@
 #include "share/util/scream_bfbhash.hpp"
 #include "ekat/ekat_assert.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
 
 namespace scream {
 namespace {
@@ -20,7 +22,6 @@ void hash (const Field::view_dev_t<const Real*>& v,
     KOKKOS_LAMBDA(const int idx, HashType& accum) {
       bfbhash::hash(v(idx), accum);
     }, bfbhash::HashReducer<>(accum));
-  Kokkos::fence();
   bfbhash::hash(accum, accum_out);  
 }
 
@@ -35,7 +36,6 @@ void hash (const Field::view_dev_t<const Real**>& v,
       unflatten_idx(idx, dims, i, j);
       bfbhash::hash(v(i,j), accum);
     }, bfbhash::HashReducer<>(accum));
-  Kokkos::fence();
   bfbhash::hash(accum, accum_out);
 }
 
@@ -50,7 +50,6 @@ void hash (const Field::view_dev_t<const Real***>& v,
       unflatten_idx(idx, dims, i, j, k);
       bfbhash::hash(v(i,j,k), accum);
     }, bfbhash::HashReducer<>(accum));
-  Kokkos::fence();
   bfbhash::hash(accum, accum_out);
 }
 
@@ -65,7 +64,6 @@ void hash (const Field::view_dev_t<const Real****>& v,
       unflatten_idx(idx, dims, i, j, k, m);
       bfbhash::hash(v(i,j,k,m), accum);
     }, bfbhash::HashReducer<>(accum));
-  Kokkos::fence();
   bfbhash::hash(accum, accum_out);
 }
 
@@ -80,7 +78,6 @@ void hash (const Field::view_dev_t<const Real*****>& v,
       unflatten_idx(idx, dims, i, j, k, m, n);
       bfbhash::hash(v(i,j,k,m,n), accum);
     }, bfbhash::HashReducer<>(accum));
-  Kokkos::fence();
   bfbhash::hash(accum, accum_out);
 }
 
@@ -144,4 +141,167 @@ void AtmosphereProcess::print_fast_global_state_hash (const std::string& label)
             timestamp().get_num_steps(), gaccum, label.c_str());
 }
 
+void AtmosphereProcess::setup_incremental_global_state_hash () {
+  auto& ih = m_incr_hash;
+
+  // The fields of bundled groups are subfields of the bundle, so hash the bundle instead
+  std::vector<Field> fields (m_fields_out.begin(), m_fields_out.end());
+  for (const auto& g : m_groups_out) {
+    if (g.m_bundle) {
+      fields.push_back(*g.m_bundle);
+    } else {
+      for (const auto& e : g.m_fields)
+        fields.push_back(*e.second);
+    }
+  }
+
+  // Split the data of each field in chunks, so that large fields are spread over many teams
+  constexpr int chunk_size = 16384;
+  std::vector<IncrementalHash::Entry> entries;
+  std::vector<IncrementalHash::Chunk> chunks;
+  for (const auto& f : fields) {
+    const auto& id = f.get_header().get_identifier();
+    if (id.data_type() != DataType::DoubleType) continue;
+    const auto& ap = f.get_header().get_alloc_properties();
+    const auto& lo = id.get_layout();
+    IncrementalHash::Entry e = {nullptr, static_cast<int>(lo.size()), 1, 1};
+    if (not ap.is_subfield()) {
+      e.data = f.get_internal_view_data<const Real>();
+      e.last = lo.dims().back();
+      e.alloc_last = ap.get_last_extent();
+      for (int begin = 0; begin < e.size; begin += chunk_size)
+        chunks.push_back({static_cast<int>(entries.size()), begin, std::min(begin+chunk_size, e.size)});
+    }
+    entries.push_back(e);
+    ih.fields.push_back(f);
+  }
+
+  const int n = entries.size();
+  ih.last_hashed.resize(n);
+  ih.field_local.resize(n, 0);
+  ih.num_hashed.resize(n, 0);
+  ih.send.resize(n+1, 0);
+  ih.global.resize(n+1, 0);
+  ih.send_num_hashed.resize(n, 0);
+
+  using Unmanaged = Kokkos::MemoryTraits<Kokkos::Unmanaged>;
+  ih.entries = decltype(ih.entries)("incr_hash_entries", n);
+  ih.chunks  = decltype(ih.chunks)("incr_hash_chunks", chunks.size());
+  Kokkos::deep_copy(ih.entries, Kokkos::View<const IncrementalHash::Entry*, Kokkos::HostSpace, Unmanaged>(entries.data(), n));
+  Kokkos::deep_copy(ih.chunks,  Kokkos::View<const IncrementalHash::Chunk*, Kokkos::HostSpace, Unmanaged>(chunks.data(), chunks.size()));
+  ih.active   = decltype(ih.active)("incr_hash_active", n);
+  ih.active_h = Kokkos::create_mirror_view(ih.active);
+  ih.hashes   = decltype(ih.hashes)("incr_hash_hashes", n);
+  ih.hashes_h = Kokkos::create_mirror_view(ih.hashes);
+  ih.inited = true;
+}
+
+void AtmosphereProcess::update_incremental_global_state_hash () {
+  auto& ih = m_incr_hash;
+  if (not ih.inited)
+    setup_incremental_global_state_hash();
+
+  // Only hash the fields whose time stamp advanced since they were last hashed
+  const int n = ih.fields.size();
+  bool any_on_device = false;
+  for (int i = 0; i < n; ++i) {
+    const auto& ts = ih.fields[i].get_header().get_tracking().get_time_stamp();
+    const bool advanced = ts.is_valid() and
+                          (not ih.last_hashed[i].is_valid() or ih.last_hashed[i] < ts);
+    ih.active_h(i) = advanced ? 1 : 0;
+    if (advanced) {
+      ih.last_hashed[i] = ts;
+      if (not ih.fields[i].get_header().get_alloc_properties().is_subfield())
+        any_on_device = true;
+    }
+  }
+
+  // Hash all the fields in one kernel, with a team per chunk. Since bfbhash::hash is a
+  // sum modulo 2^64, the hashes of the chunks of a field can be summed atomically.
+  // Only the copy of the hashes to host waits for the kernel.
+  if (any_on_device) {
+    using TeamPolicy = Kokkos::TeamPolicy<ExeSpace>;
+    const auto entries = ih.entries;
+    const auto chunks  = ih.chunks;
+    const auto active  = ih.active;
+    const auto hashes  = ih.hashes;
+    const ExeSpace space;
+    Kokkos::deep_copy(space, active, ih.active_h);
+    Kokkos::deep_copy(space, hashes, 0);
+    Kokkos::parallel_for(
+      TeamPolicy(space, chunks.extent(0), Kokkos::AUTO),
+      KOKKOS_LAMBDA(const TeamPolicy::member_type& team) {
+        const auto c = chunks(team.league_rank());
+        if (active(c.entry) == 0) return;
+        const auto e = entries(c.entry);
+        HashType accum = 0;
+        Kokkos::parallel_reduce(
+          Kokkos::TeamThreadRange(team, c.begin, c.end),
+          [&](const int idx, HashType& accum) {
+            bfbhash::hash(e.data[(idx/e.last)*e.alloc_last + idx%e.last], accum);
+          }, bfbhash::HashReducer<>(accum));
+        Kokkos::single(Kokkos::PerTeam(team), [&]() {
+          Kokkos::atomic_add(&hashes(c.entry), accum);
+        });
+      });
+    Kokkos::deep_copy(ih.hashes_h, hashes);
+  }
+
+  for (int i = 0; i < n; ++i) {
+    if (ih.active_h(i) == 0) continue;
+    HashType h = 0;
+    if (ih.fields[i].get_header().get_alloc_properties().is_subfield())
+      hash(ih.fields[i], h);
+    else
+      h = ih.hashes_h(i);
+    bfbhash::hash(h, ih.field_local[i]);
+    bfbhash::hash(h, ih.local);
+    ++ih.num_hashed[i];
+  }
+
+  ++ih.num_steps;
+  if (ih.num_steps == ih.nsteps)
+    flush_incremental_global_state_hash(false);
+}
+
+void AtmosphereProcess::flush_incremental_global_state_hash (const bool final) {
+  auto& ih = m_incr_hash;
+
+  // Complete the pending reduction. Unless the ranks are out of sync, it was
+  // started nsteps runs ago, so this wait should not block.
+  if (ih.req != MPI_REQUEST_NULL) {
+    MPI_Wait(&ih.req, MPI_STATUS_IGNORE);
+    if (m_comm.am_i_root()) {
+      fprintf(stderr, "bfbhash> %14d %16lx (%s-incr)\n",
+              ih.last_step, ih.global[0], name().c_str());
+      // Per-field summary, for the fields hashed since the previous reduction
+      for (size_t i = 0; i < ih.fields.size(); ++i)
+        if (ih.send_num_hashed[i] > 0)
+          fprintf(stderr, "bfbhash> %14d %16lx (%s-incr:%s, hashed %d times)\n",
+                  ih.last_step, ih.global[i+1], name().c_str(),
+                  ih.fields[i].name().c_str(), ih.send_num_hashed[i]);
+    }
+  }
+
+  if (ih.num_steps == 0) return;
+
+  // Start a new reduction with the hashes accumulated since the last one
+  const int n = ih.fields.size();
+  ih.send[0] = ih.local;
+  for (int i = 0; i < n; ++i) {
+    ih.send[i+1] = ih.field_local[i];
+    ih.send_num_hashed[i] = ih.num_hashed[i];
+  }
+  ih.last_step = timestamp().get_num_steps();
+  bfbhash::iall_reduce_HashType(m_comm.mpi_comm(), ih.send.data(), ih.global.data(), n+1, &ih.req);
+  ih.local = 0;
+  std::fill(ih.field_local.begin(), ih.field_local.end(), 0);
+  std::fill(ih.num_hashed.begin(), ih.num_hashed.end(), 0);
+  ih.num_steps = 0;
+
+  // At finalization, there is no later step to complete the reduction in
+  if (final)
+    flush_incremental_global_state_hash(true);
+}
+
 } // namespace scream
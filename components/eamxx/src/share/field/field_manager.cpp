@@ -115,9 +115,14 @@ add_to_group (const std::string& field_name, const std::string& group_name)
   if (not group) {
     group = std::make_shared<FieldGroupInfo>(group_name);
   }
+  // If the field is already in the group (e.g., a subfield of a bundled group), there's nothing to do
+  if (ekat::contains(group->m_fields_names,field_name)) {
+    return;
+  }
   EKAT_REQUIRE_MSG (not group->m_bundled,
       "Error! Cannot add fields to a group that is bundled.\n"
-      "   group name: " + field_name + "\n");
+      "   field name: " + field_name + "\n"
+      "   group name: " + group_name + "\n");
 
   EKAT_REQUIRE_MSG (has_field(field_name),
       "Error! Cannot add field to group, since the field is not present in this FieldManager.\n"
@@ -76,7 +76,8 @@ public:
   const group_info_map& get_groups_info () const { return m_field_groups; }
 
   // Adds $field_name to group $group_name (creating the group, if necessary).
-  // NOTE: if $group_name is allocated as a bundled field, this throws.
+  // NOTE: if $group_name is allocated as a bundled field, this throws, unless
+  //       the field is already in the group (in which case it's a no-op).
   // NOTE: must be called after registration ends
   void add_to_group (const std::string& field_name, const std::string& group_name);
 
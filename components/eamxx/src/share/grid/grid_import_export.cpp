@@ -2,6 +2,8 @@
 
 #include "share/field/field_utils.hpp"
 
+#include <ekat/kokkos/ekat_kokkos_utils.hpp>
+
 namespace scream
 {
 
@@ -169,6 +171,420 @@ GridImportExport (const std::shared_ptr<const AbstractGrid>& unique,
     }
     Kokkos::deep_copy(m_num_imports_per_pid,m_num_imports_per_pid_h);
   }
+
+  // Compute offsets of each pid in the import/export arrays
+  {
+    const int nranks = m_comm.size();
+    m_import_pids_offsets = view_1d<int>("",nranks+1);
+    m_export_pids_offsets = view_1d<int>("",nranks+1);
+    auto imp_offsets_h = Kokkos::create_mirror_view(m_import_pids_offsets);
+    auto exp_offsets_h = Kokkos::create_mirror_view(m_export_pids_offsets);
+    imp_offsets_h(0) = exp_offsets_h(0) = 0;
+    for (int pid=0; pid<nranks; ++pid) {
+      imp_offsets_h(pid+1) = imp_offsets_h(pid) + m_num_imports_per_pid_h(pid);
+      exp_offsets_h(pid+1) = exp_offsets_h(pid) + m_num_exports_per_pid_h(pid);
+    }
+    Kokkos::deep_copy(m_import_pids_offsets,imp_offsets_h);
+    Kokkos::deep_copy(m_export_pids_offsets,exp_offsets_h);
+  }
+}
+
+GridImportExport::~GridImportExport ()
+{
+  // Persistent requests must be freed, but only if MPI is still up
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (finalized) {
+    return;
+  }
+  for (auto plans : {&m_scatter_plans, &m_gather_plans}) {
+    for (auto& it : *plans) {
+      for (auto& req : it.second.send_req) {
+        MPI_Request_free(&req);
+      }
+      for (auto& req : it.second.recv_req) {
+        MPI_Request_free(&req);
+      }
+    }
+  }
+}
+
+void GridImportExport::
+scatter (const std::vector<Field>& src,
+         const std::vector<Field>& dst)
+{
+  exchange(src,dst,true);
+}
+
+void GridImportExport::
+gather (const std::vector<Field>& src,
+        const std::vector<Field>& dst)
+{
+  exchange(src,dst,false);
+}
+
+void GridImportExport::
+exchange (const std::vector<Field>& src,
+          const std::vector<Field>& dst,
+          const bool is_scatter)
+{
+  const std::string name = is_scatter ? "scatter" : "gather";
+
+  auto& plan = get_comm_plan(src,dst,is_scatter);
+
+  // In a scatter we send our exports and recv our imports, in a gather the opposite
+  const auto& send_pids    = is_scatter ? m_export_pids : m_import_pids;
+  const auto& send_lids    = is_scatter ? m_export_lids : m_import_lids;
+  const auto& send_ncols   = is_scatter ? m_num_exports_per_pid : m_num_imports_per_pid;
+  const auto& send_offsets = is_scatter ? m_export_pids_offsets : m_import_pids_offsets;
+  const auto& recv_pids    = is_scatter ? m_import_pids : m_export_pids;
+  const auto& recv_lids    = is_scatter ? m_import_lids : m_export_lids;
+  const auto& recv_ncols   = is_scatter ? m_num_imports_per_pid : m_num_exports_per_pid;
+  const auto& recv_offsets = is_scatter ? m_import_pids_offsets : m_export_pids_offsets;
+
+  // Fire the recv requests right away, so that if some other ranks
+  // is done packing before us, we can start receiving their data
+  if (not plan.recv_req.empty()) {
+    check_mpi_call(MPI_Startall(plan.recv_req.size(),plan.recv_req.data()),
+                   "GridImportExport::" + name + ", starting persistent recv requests.\n");
+  }
+
+  pack (src,plan,send_pids,send_lids,send_ncols,send_offsets);
+
+  // Wait for all threads to be done packing
+  Kokkos::fence();
+
+  // If MPI does not use dev pointers, we need to deep copy from dev to host
+  if (not MpiOnDev) {
+    Kokkos::deep_copy (plan.mpi_send_buf,plan.send_buf);
+  }
+
+  if (not plan.send_req.empty()) {
+    check_mpi_call(MPI_Startall(plan.send_req.size(),plan.send_req.data()),
+                   "GridImportExport::" + name + ", starting persistent send requests.\n");
+  }
+
+  if (not plan.recv_req.empty()) {
+    check_mpi_call(MPI_Waitall(plan.recv_req.size(),plan.recv_req.data(),MPI_STATUSES_IGNORE),
+                   "GridImportExport::" + name + ", waiting on persistent recv requests.\n");
+  }
+
+  // If MPI does not use dev pointers, we need to deep copy from host to dev
+  if (not MpiOnDev) {
+    Kokkos::deep_copy (plan.recv_buf,plan.mpi_recv_buf);
+  }
+
+  // In a gather, a dof may be received from multiple pids, so we accumulate
+  if (not is_scatter) {
+    for (auto f : dst) {
+      f.deep_copy(0);
+    }
+  }
+  unpack (dst,plan,recv_pids,recv_lids,recv_ncols,recv_offsets,not is_scatter);
+
+  if (not plan.send_req.empty()) {
+    check_mpi_call(MPI_Waitall(plan.send_req.size(),plan.send_req.data(),MPI_STATUSES_IGNORE),
+                   "GridImportExport::" + name + ", waiting on persistent send requests.\n");
+  }
+}
+
+auto GridImportExport::
+get_comm_plan (const std::vector<Field>& src,
+               const std::vector<Field>& dst,
+               const bool is_scatter)
+ -> CommPlan&
+{
+  using namespace ShortFieldTagsNames;
+
+  const std::string name = is_scatter ? "scatter" : "gather";
+  const auto& src_grid = is_scatter ? m_unique : m_overlapped;
+  const auto& dst_grid = is_scatter ? m_overlapped : m_unique;
+
+  EKAT_REQUIRE_MSG (src.size()==dst.size(),
+      "Error! GridImportExport::" + name + " requires the same number of src and dst fields.\n"
+      "  - num src fields: " + std::to_string(src.size()) + "\n"
+      "  - num dst fields: " + std::to_string(dst.size()) + "\n");
+
+  const int nfields = src.size();
+  std::vector<int> col_sizes(nfields);
+  for (int i=0; i<nfields; ++i) {
+    const auto& src_fl = src[i].get_header().get_identifier().get_layout();
+    const auto& dst_fl = dst[i].get_header().get_identifier().get_layout();
+    EKAT_REQUIRE_MSG (src[i].data_type()==DataType::RealType and
+                      dst[i].data_type()==DataType::RealType,
+        "Error! GridImportExport::" + name + " only supports Real fields.\n"
+        "  - src field: " + src[i].name() + "\n"
+        "  - dst field: " + dst[i].name() + "\n");
+    EKAT_REQUIRE_MSG (src_fl.rank()>=1 and src_fl.tag(0)==COL and
+                      src_fl.dim(0)==src_grid->get_num_local_dofs(),
+        "Error! Bad layout for src field in GridImportExport::" + name + ".\n"
+        "  - src field : " + src[i].name() + "\n"
+        "  - src layout: " + to_string(src_fl) + "\n");
+    EKAT_REQUIRE_MSG (dst_fl.rank()>=1 and dst_fl.tag(0)==COL and
+                      dst_fl.dim(0)==dst_grid->get_num_local_dofs(),
+        "Error! Bad layout for dst field in GridImportExport::" + name + ".\n"
+        "  - dst field : " + dst[i].name() + "\n"
+        "  - dst layout: " + to_string(dst_fl) + "\n");
+    EKAT_REQUIRE_MSG (src_fl.strip_dim(COL)==dst_fl.strip_dim(COL),
+        "Error! Incompatible src/dst layouts in GridImportExport::" + name + ".\n"
+        "  - src field : " + src[i].name() + "\n"
+        "  - src layout: " + to_string(src_fl) + "\n"
+        "  - dst field : " + dst[i].name() + "\n"
+        "  - dst layout: " + to_string(dst_fl) + "\n");
+    col_sizes[i] = src_fl.strip_dim(COL).size();
+  }
+
+  auto& plans = is_scatter ? m_scatter_plans : m_gather_plans;
+  auto it = plans.find(col_sizes);
+  if (it!=plans.end()) {
+    return it->second;
+  }
+
+  // First time we see this batch shape: create buffers and requests.
+  // Note: std::map nodes are never moved, so the buffers addresses
+  //       stored in the persistent requests stay valid.
+  auto& plan = plans[col_sizes];
+
+  plan.col_sizes_scan_sum.resize(nfields+1,0);
+  for (int i=0; i<nfields; ++i) {
+    plan.col_sizes_scan_sum[i+1] = plan.col_sizes_scan_sum[i] + col_sizes[i];
+  }
+  const int total_col_size = plan.col_sizes_scan_sum.back();
+
+  const auto& ncols_send_h = is_scatter ? m_num_exports_per_pid_h : m_num_imports_per_pid_h;
+  const auto& ncols_recv_h = is_scatter ? m_num_imports_per_pid_h : m_num_exports_per_pid_h;
+  const int ncols_send = is_scatter ? m_export_lids.size() : m_import_lids.size();
+  const int ncols_recv = is_scatter ? m_import_lids.size() : m_export_lids.size();
+
+  plan.send_buf = view_1d<Real>("GridImportExport::send_buf",ncols_send*total_col_size);
+  plan.recv_buf = view_1d<Real>("GridImportExport::recv_buf",ncols_recv*total_col_size);
+  plan.mpi_send_buf = Kokkos::create_mirror_view(decltype(plan.mpi_send_buf)::execution_space(),plan.send_buf);
+  plan.mpi_recv_buf = Kokkos::create_mirror_view(decltype(plan.mpi_recv_buf)::execution_space(),plan.recv_buf);
+
+  const auto mpi_comm = m_comm.mpi_comm();
+  const auto mpi_real = ekat::get_mpi_type<Real>();
+  const int tag = is_scatter ? 0 : 1;
+  for (int pid=0, send_offset=0, recv_offset=0; pid<m_comm.size(); ++pid) {
+    if (ncols_send_h(pid)>0) {
+      auto send_ptr = plan.mpi_send_buf.data() + send_offset*total_col_size;
+      auto send_count = ncols_send_h(pid)*total_col_size;
+      auto& req = plan.send_req.emplace_back();
+      check_mpi_call(MPI_Send_init (send_ptr, send_count, mpi_real, pid,
+                                    tag, mpi_comm, &req),
+                     "GridImportExport::" + name + ", creating persistent send request.\n");
+    }
+    if (ncols_recv_h(pid)>0) {
+      auto recv_ptr = plan.mpi_recv_buf.data() + recv_offset*total_col_size;
+      auto recv_count = ncols_recv_h(pid)*total_col_size;
+      auto& req = plan.recv_req.emplace_back();
+      check_mpi_call(MPI_Recv_init (recv_ptr, recv_count, mpi_real, pid,
+                                    tag, mpi_comm, &req),
+                     "GridImportExport::" + name + ", creating persistent recv request.\n");
+    }
+    send_offset += ncols_send_h(pid);
+    recv_offset += ncols_recv_h(pid);
+  }
+
+  return plan;
+}
+
+void GridImportExport::
+pack (const std::vector<Field>& fields, const CommPlan& plan,
+      const view_1d<int>& pids, const view_1d<int>& lids,
+      const view_1d<int>& ncols_per_pid,
+      const view_1d<int>& pids_offsets) const
+{
+  using RangePolicy = typename KT::RangePolicy;
+  using TeamMember  = typename KT::MemberType;
+  using ESU         = ekat::ExeSpaceUtils<typename KT::ExeSpace>;
+
+  auto buf = plan.send_buf;
+  const int num_items = pids.size();
+  const int total_col_size = plan.col_sizes_scan_sum.back();
+  for (size_t ifield=0; ifield<fields.size(); ++ifield) {
+    const auto& f = fields[ifield];
+    const auto& fl = f.get_header().get_identifier().get_layout();
+    const auto f_col_sizes_scan_sum = plan.col_sizes_scan_sum[ifield];
+    switch (fl.rank()) {
+      case 1:
+      {
+        const auto v = f.get_strided_view<const Real*>();
+        auto pack = KOKKOS_LAMBDA(const int idx) {
+          const int pid  = pids(idx);
+          const int icol = lids(idx);
+          const auto pid_offset = pids_offsets(pid);
+          const auto pos_within_pid = idx - pid_offset;
+          auto offset = pid_offset*total_col_size
+                      + ncols_per_pid(pid)*f_col_sizes_scan_sum
+                      + pos_within_pid;
+          buf(offset) = v(icol);
+        };
+        Kokkos::parallel_for(RangePolicy(0,num_items),pack);
+        break;
+      }
+      case 2:
+      {
+        const auto v = f.get_view<const Real**>();
+        const int dim1 = fl.dim(1);
+        auto policy = ESU::get_default_team_policy(num_items,dim1);
+        auto pack = KOKKOS_LAMBDA(const TeamMember& team) {
+          const int idx  = team.league_rank();
+          const int pid  = pids(idx);
+          const int icol = lids(idx);
+          const auto pid_offset = pids_offsets(pid);
+          const auto pos_within_pid = idx - pid_offset;
+          auto offset = pid_offset*total_col_size
+                      + ncols_per_pid(pid)*f_col_sizes_scan_sum
+                      + pos_within_pid*dim1;
+          auto col_pack = [&](const int& k) {
+            buf(offset+k) = v(icol,k);
+          };
+          auto tvr = Kokkos::TeamVectorRange(team,dim1);
+          Kokkos::parallel_for(tvr,col_pack);
+        };
+        Kokkos::parallel_for(policy,pack);
+        break;
+      }
+      case 3:
+      {
+        const auto v = f.get_view<const Real***>();
+        const int dim1 = fl.dim(1);
+        const int dim2 = fl.dim(2);
+        const int f_col_size = dim1*dim2;
+        auto policy = ESU::get_default_team_policy(num_items,f_col_size);
+        auto pack = KOKKOS_LAMBDA(const TeamMember& team) {
+          const int idx  = team.league_rank();
+          const int pid  = pids(idx);
+          const int icol = lids(idx);
+          const auto pid_offset = pids_offsets(pid);
+          const auto pos_within_pid = idx - pid_offset;
+          auto offset = pid_offset*total_col_size
+                      + ncols_per_pid(pid)*f_col_sizes_scan_sum
+                      + pos_within_pid*f_col_size;
+          auto col_pack = [&](const int& jk) {
+            const int j = jk / dim2;
+            const int k = jk % dim2;
+            buf(offset+jk) = v(icol,j,k);
+          };
+          auto tvr = Kokkos::TeamVectorRange(team,f_col_size);
+          Kokkos::parallel_for(tvr,col_pack);
+        };
+        Kokkos::parallel_for(policy,pack);
+        break;
+      }
+      default:
+        EKAT_ERROR_MSG ("Unexpected field rank in GridImportExport::pack.\n"
+            "  - MPI rank  : " + std::to_string(m_comm.rank()) + "\n"
+            "  - field name: " + f.name() + "\n"
+            "  - field rank: " + std::to_string(fl.rank()) + "\n");
+    }
+  }
+}
+
+void GridImportExport::
+unpack (const std::vector<Field>& fields, const CommPlan& plan,
+        const view_1d<int>& pids, const view_1d<int>& lids,
+        const view_1d<int>& ncols_per_pid,
+        const view_1d<int>& pids_offsets,
+        const bool accumulate) const
+{
+  using RangePolicy = typename KT::RangePolicy;
+  using TeamMember  = typename KT::MemberType;
+  using ESU         = ekat::ExeSpaceUtils<typename KT::ExeSpace>;
+
+  auto buf = plan.recv_buf;
+  const int num_items = pids.size();
+  const int total_col_size = plan.col_sizes_scan_sum.back();
+  for (size_t ifield=0; ifield<fields.size(); ++ifield) {
+    const auto& f = fields[ifield];
+    const auto& fl = f.get_header().get_identifier().get_layout();
+    const auto f_col_sizes_scan_sum = plan.col_sizes_scan_sum[ifield];
+    switch (fl.rank()) {
+      case 1:
+      {
+        const auto v = f.get_strided_view<Real*>();
+        auto unpack = KOKKOS_LAMBDA(const int idx) {
+          const int pid  = pids(idx);
+          const int icol = lids(idx);
+          const auto pid_offset = pids_offsets(pid);
+          const auto pos_within_pid = idx - pid_offset;
+          auto offset = pid_offset*total_col_size
+                      + ncols_per_pid(pid)*f_col_sizes_scan_sum
+                      + pos_within_pid;
+          if (accumulate) {
+            Kokkos::atomic_add(&v(icol),buf(offset));
+          } else {
+            v(icol) = buf(offset);
+          }
+        };
+        Kokkos::parallel_for(RangePolicy(0,num_items),unpack);
+        break;
+      }
+      case 2:
+      {
+        const auto v = f.get_view<Real**>();
+        const int dim1 = fl.dim(1);
+        auto policy = ESU::get_default_team_policy(num_items,dim1);
+        auto unpack = KOKKOS_LAMBDA(const TeamMember& team) {
+          const int idx  = team.league_rank();
+          const int pid  = pids(idx);
+          const int icol = lids(idx);
+          const auto pid_offset = pids_offsets(pid);
+          const auto pos_within_pid = idx - pid_offset;
+          auto offset = pid_offset*total_col_size
+                      + ncols_per_pid(pid)*f_col_sizes_scan_sum
+                      + pos_within_pid*dim1;
+          auto col_unpack = [&](const int& k) {
+            if (accumulate) {
+              Kokkos::atomic_add(&v(icol,k),buf(offset+k));
+            } else {
+              v(icol,k) = buf(offset+k);
+            }
+          };
+          auto tvr = Kokkos::TeamVectorRange(team,dim1);
+          Kokkos::parallel_for(tvr,col_unpack);
+        };
+        Kokkos::parallel_for(policy,unpack);
+        break;
+      }
+      case 3:
+      {
+        const auto v = f.get_view<Real***>();
+        const int dim1 = fl.dim(1);
+        const int dim2 = fl.dim(2);
+        const int f_col_size = dim1*dim2;
+        auto policy = ESU::get_default_team_policy(num_items,f_col_size);
+        auto unpack = KOKKOS_LAMBDA(const TeamMember& team) {
+          const int idx  = team.league_rank();
+          const int pid  = pids(idx);
+          const int icol = lids(idx);
+          const auto pid_offset = pids_offsets(pid);
+          const auto pos_within_pid = idx - pid_offset;
+          auto offset = pid_offset*total_col_size
+                      + ncols_per_pid(pid)*f_col_sizes_scan_sum
+                      + pos_within_pid*f_col_size;
+          auto col_unpack = [&](const int& jk) {
+            const int j = jk / dim2;
+            const int k = jk % dim2;
+            if (accumulate) {
+              Kokkos::atomic_add(&v(icol,j,k),buf(offset+jk));
+            } else {
+              v(icol,j,k) = buf(offset+jk);
+            }
+          };
+          auto tvr = Kokkos::TeamVectorRange(team,f_col_size);
+          Kokkos::parallel_for(tvr,col_unpack);
+        };
+        Kokkos::parallel_for(policy,unpack);
+        break;
+      }
+      default:
+        EKAT_ERROR_MSG ("Unexpected field rank in GridImportExport::unpack.\n"
+            "  - MPI rank  : " + std::to_string(m_comm.rank()) + "\n"
+            "  - field name: " + f.name() + "\n"
+            "  - field rank: " + std::to_string(fl.rank()) + "\n");
+    }
+  }
 }
 
 } // namespace scream
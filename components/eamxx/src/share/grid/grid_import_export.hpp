@@ -3,6 +3,7 @@
 
 #include "share/grid/abstract_grid.hpp"
 #include "share/scream_types.hpp"       // For KokkosTypes
+#include "scream_config.h"              // For SCREAM_MPI_ON_DEVICE
 #include "share/util/scream_utils.hpp"  // For check_mpi_call
 
 #include <ekat/mpi/ekat_comm.hpp>
@@ -10,6 +11,7 @@
 #include <memory>
 #include <map>
 #include <vector>
+#include <type_traits>
 
 namespace scream
 {
@@ -38,17 +40,24 @@ namespace scream
  * for ease of use in non-performance critical code.
  * On the other hand, the import/export data (pids/lids) can
  * be used both on host and device, for more efficient pack/unpack methods.
+ *
+ * For performance critical code, the Field-based overloads of gather/scatter
+ * can be used instead. They operate on a batch of fields at once, pack/unpack
+ * on device, and use persistent send/recv requests. The buffers and requests
+ * are created the first time a given batch shape (i.e., the list of fields
+ * column sizes) is used, and are reused in later calls. If SCREAM_MPI_ON_DEVICE
+ * is ON, the device buffers are passed directly to MPI.
  */
 
 class GridImportExport {
 public:
   using KT = KokkosTypes<DefaultDevice>;
   template<typename T>
-  using view_1d = typename KT::view_1d<int>;
+  using view_1d = typename KT::view_1d<T>;
 
   GridImportExport (const std::shared_ptr<const AbstractGrid>& unique,
                     const std::shared_ptr<const AbstractGrid>& overlapped);
-  ~GridImportExport () = default;
+  ~GridImportExport ();
 
   template<typename T>
   void scatter (const MPI_Datatype mpi_data_t,
@@ -60,6 +69,18 @@ public:
                const std::map<int,std::vector<T>>& src,
                      std::map<int,std::vector<T>>& dst) const;
 
+  // Field-based versions. The i-th src and dst fields must have the same
+  // layout (except for the COL extent), with COL as first dimension.
+  //  - scatter: src fields are on the unique grid, dst fields on the overlapped grid
+  //  - gather: src fields are on the overlapped grid, dst fields on the unique grid.
+  //    Since a dof may be present on multiple ranks of the overlapped grid,
+  //    dst is set to the sum of all the contributions (or 0, if the dof
+  //    is not present on the overlapped grid).
+  void scatter (const std::vector<Field>& src,
+                const std::vector<Field>& dst);
+  void gather (const std::vector<Field>& src,
+               const std::vector<Field>& dst);
+
   view_1d<int> num_exports_per_pid () const { return m_num_exports_per_pid; }
   view_1d<int> num_imports_per_pid () const { return m_num_imports_per_pid; }
 
@@ -76,6 +97,55 @@ public:
   view_1d<int>::HostMirror export_pids_h () const { return m_export_pids_h; }
   view_1d<int>::HostMirror export_lids_h () const { return m_export_lids_h; }
 
+protected:
+
+  // If MpiOnDev=true, we pass device pointers to MPI. Otherwise, we use host mirrors.
+  static constexpr bool MpiOnDev = SCREAM_MPI_ON_DEVICE;
+  template<typename T>
+  using mpi_view_1d = typename std::conditional<
+                        MpiOnDev,
+                        view_1d<T>,
+                        typename view_1d<T>::HostMirror
+                      >::type;
+
+  // Buffers and persistent requests for the Field-based gather/scatter.
+  // The send/recv buffers are organized by pid, and, within each pid,
+  // by field, with all the columns of a field stored contiguously.
+  struct CommPlan {
+    // Exclusive scan sum of the col size of each field
+    std::vector<int>          col_sizes_scan_sum;
+
+    view_1d<Real>             send_buf;
+    view_1d<Real>             recv_buf;
+
+    // If MpiOnDev=true, they simply alias the ones above
+    mpi_view_1d<Real>         mpi_send_buf;
+    mpi_view_1d<Real>         mpi_recv_buf;
+
+    std::vector<MPI_Request>  send_req;
+    std::vector<MPI_Request>  recv_req;
+  };
+
+  void exchange (const std::vector<Field>& src,
+                 const std::vector<Field>& dst,
+                 const bool is_scatter);
+
+  CommPlan& get_comm_plan (const std::vector<Field>& src,
+                           const std::vector<Field>& dst,
+                           const bool is_scatter);
+
+#ifdef KOKKOS_ENABLE_CUDA
+public:
+#endif
+  void pack (const std::vector<Field>& fields, const CommPlan& plan,
+             const view_1d<int>& pids, const view_1d<int>& lids,
+             const view_1d<int>& ncols_per_pid,
+             const view_1d<int>& pids_offsets) const;
+  void unpack (const std::vector<Field>& fields, const CommPlan& plan,
+               const view_1d<int>& pids, const view_1d<int>& lids,
+               const view_1d<int>& ncols_per_pid,
+               const view_1d<int>& pids_offsets,
+               const bool accumulate) const;
 protected:
 
   std::shared_ptr<const AbstractGrid>   m_unique;
@@ -99,6 +169,14 @@ protected:
   view_1d<int>::HostMirror  m_num_imports_per_pid_h;
   view_1d<int>::HostMirror  m_num_exports_per_pid_h;
 
+  // Offset of each pid in the import/export arrays (size is nranks+1)
+  view_1d<int>  m_import_pids_offsets;
+  view_1d<int>  m_export_pids_offsets;
+
+  // Comm plans for the Field-based gather/scatter, keyed by the fields col sizes
+  std::map<std::vector<int>,CommPlan>   m_scatter_plans;
+  std::map<std::vector<int>,CommPlan>   m_gather_plans;
+
   ekat::Comm    m_comm;
 };
 
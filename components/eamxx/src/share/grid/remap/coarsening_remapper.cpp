@@ -156,10 +156,16 @@ void CoarseningRemapper::do_remap_fwd ()
     return (ap.get_last_extent() % SCREAM_PACK_SIZE) == 0;
   };
 
-  // Loop over each field
+  // First, perform the local mat-vec. Recall that in these y=Ax products,
+  // x is the src field, and y is the overlapped tgt field.
+  // Fields that can be batched are all handled by a single kernel.
+  local_mat_vec_batched ();
+
+  // Loop over each remaining field
   for (int i=0; i<m_num_fields; ++i) {
-    // First, perform the local mat-vec. Recall that in these y=Ax products,
-    // x is the src field, and y is the overlapped tgt field.
+    if (m_is_batched[i]) {
+      continue;
+    }
     const auto& f_src = m_src_fields[i];
     const auto& f_ov  = m_ov_fields[i];
 
@@ -465,6 +471,47 @@ local_mat_vec (const Field& x, const Field& y, const Field& mask) const
   }
 }
 
+void CoarseningRemapper::local_mat_vec_batched () const
+{
+  using MemberType  = typename KT::MemberType;
+  using ESU         = ekat::ExeSpaceUtils<typename KT::ExeSpace>;
+
+  const int nbatch = m_batch_entries.size();
+  if (nbatch==0) {
+    return;
+  }
+
+  const int nrows = m_ov_coarse_grid->get_num_local_dofs();
+  const auto row_offsets = m_row_offsets;
+  const auto col_lids = m_col_lids;
+  const auto weights = m_weights;
+  const auto entries = m_batch_entries;
+  auto policy = ESU::get_default_team_policy(nbatch*nrows,m_batch_max_col_size);
+  Kokkos::parallel_for(policy,
+                       KOKKOS_LAMBDA(const MemberType& team) {
+    const int ib  = team.league_rank() / nrows;
+    const int row = team.league_rank() % nrows;
+    const auto& e = entries(ib);
+
+    const int nlast = e.col_size / e.last_dim;
+    const int src_stride = nlast*e.src_last;
+    const int ov_stride  = nlast*e.ov_last;
+    const auto beg = row_offsets(row);
+    const auto end = row_offsets(row+1);
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team,e.col_size),
+                         [&](const int k) {
+      const int kq = k / e.last_dim;
+      const int kr = k % e.last_dim;
+      const int ks = kq*e.src_last + kr;
+      Real y = weights(beg)*e.src[col_lids(beg)*src_stride + ks];
+      for (int icol=beg+1; icol<end; ++icol) {
+        y += weights(icol)*e.src[col_lids(icol)*src_stride + ks];
+      }
+      e.ov[row*ov_stride + kq*e.ov_last + kr] = y;
+    });
+  });
+}
+
 void CoarseningRemapper::pack_and_send ()
 {
   using RangePolicy = typename KT::RangePolicy;
@@ -476,7 +523,34 @@ void CoarseningRemapper::pack_and_send ()
   const auto lids_pids = m_send_lids_pids;
   const auto buf = m_send_buffer;
 
+  // Pack all the batched fields with a single kernel
+  const int nbatch = m_batch_entries.size();
+  if (nbatch>0) {
+    const auto entries = m_batch_entries;
+    const auto f_pid_offsets = m_send_f_pid_offsets;
+    auto policy = ESU::get_default_team_policy(nbatch*num_send_gids,m_batch_max_col_size);
+    Kokkos::parallel_for(policy,
+                         KOKKOS_LAMBDA(const MemberType& team){
+      const int ib = team.league_rank() / num_send_gids;
+      const int i  = team.league_rank() % num_send_gids;
+      const auto& e = entries(ib);
+      const int lid = lids_pids(i,0);
+      const int pid = lids_pids(i,1);
+      const int lidpos = i - pid_lid_start(pid);
+      const int offset = f_pid_offsets(e.ifield,pid) + lidpos*e.col_size;
+      const int ov_stride = (e.col_size / e.last_dim)*e.ov_last;
+
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team,e.col_size),
+                           [&](const int k) {
+        buf(offset + k) = e.ov[lid*ov_stride + (k/e.last_dim)*e.ov_last + k%e.last_dim];
+      });
+    });
+  }
+
   for (int ifield=0; ifield<m_num_fields; ++ifield) {
+    if (m_is_batched[ifield]) {
+      continue;
+    }
     const auto& f  = m_ov_fields[ifield];
     const auto& fl = f.get_header().get_identifier().get_layout();
     const auto f_pid_offsets = ekat::subview(m_send_f_pid_offsets,ifield);
@@ -587,7 +661,40 @@ void CoarseningRemapper::recv_and_unpack ()
   const auto recv_lids_beg = m_recv_lids_beg;
   const auto recv_lids_end = m_recv_lids_end;
   const auto recv_lids_pidpos = m_recv_lids_pidpos;
+
+  // Unpack all the batched fields with a single kernel. Each entry is
+  // the sum of all contributions, so there's no need to zero out the field
+  const int nbatch = m_batch_entries.size();
+  if (nbatch>0) {
+    const auto entries = m_batch_entries;
+    const auto f_pid_offsets = m_recv_f_pid_offsets;
+    auto policy = ESU::get_default_team_policy(nbatch*num_tgt_dofs,m_batch_max_col_size);
+    Kokkos::parallel_for(policy,
+                         KOKKOS_LAMBDA(const MemberType& team){
+      const int ib  = team.league_rank() / num_tgt_dofs;
+      const int lid = team.league_rank() % num_tgt_dofs;
+      const auto& e = entries(ib);
+      const int recv_beg = recv_lids_beg(lid);
+      const int recv_end = recv_lids_end(lid);
+      const int tgt_stride = (e.col_size / e.last_dim)*e.tgt_last;
+
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team,e.col_size),
+                           [&](const int k) {
+        Real sum = 0;
+        for (int irecv=recv_beg; irecv<recv_end; ++irecv) {
+          const int pid = recv_lids_pidpos(irecv,0);
+          const int lidpos = recv_lids_pidpos(irecv,1);
+          sum += buf (f_pid_offsets(e.ifield,pid) + lidpos*e.col_size + k);
+        }
+        e.tgt[lid*tgt_stride + (k/e.last_dim)*e.tgt_last + k%e.last_dim] = sum;
+      });
+    });
+  }
+
   for (int ifield=0; ifield<m_num_fields; ++ifield) {
+    if (m_is_batched[ifield]) {
+      continue;
+    }
           auto& f  = m_tgt_fields[ifield];
     const auto& fl = f.get_header().get_identifier().get_layout();
     const auto f_pid_offsets = ekat::subview(m_recv_f_pid_offsets,ifield);
@@ -949,6 +1056,53 @@ void CoarseningRemapper::setup_mpi_data_structures ()
     MPI_Recv_init (recv_ptr, n, mpi_real, pid,
                    0, mpi_comm, &req);
   }
+
+  setup_batched_fields ();
+}
+
+void CoarseningRemapper::setup_batched_fields ()
+{
+  using namespace ShortFieldTagsNames;
+
+  // A field can be batched if it uses no mask, and if src and tgt are not subfields,
+  // so that their data is contiguous, with (possibly) padding along the last dim.
+  std::vector<BatchEntry> entries;
+  m_is_batched.assign(m_num_fields,false);
+  m_batch_max_col_size = 0;
+  for (int i=0; i<m_num_fields; ++i) {
+    const auto& f_src = m_src_fields[i];
+    const auto& f_ov  = m_ov_fields[i];
+    const auto& f_tgt = m_tgt_fields[i];
+    const auto& fl = f_src.get_header().get_identifier().get_layout();
+    const bool has_mask = m_field_idx_to_mask_idx.count(i)==1 and m_field_idx_to_mask_idx.at(i)>0;
+    if (has_mask or fl.rank()>3 or
+        not f_src.get_header().get_parent().expired() or
+        not f_tgt.get_header().get_parent().expired()) {
+      continue;
+    }
+
+    BatchEntry e;
+    e.src = f_src.get_internal_view_data<const Real>();
+    e.ov  = f_ov.get_internal_view_data<Real>();
+    e.tgt = f_tgt.get_internal_view_data<Real>();
+    e.ifield = i;
+    e.col_size = fl.strip_dim(COL).size();
+    e.last_dim = fl.rank()==1 ? 1 : fl.dims().back();
+    e.src_last = fl.rank()==1 ? 1 : f_src.get_header().get_alloc_properties().get_last_extent();
+    e.ov_last  = fl.rank()==1 ? 1 : f_ov.get_header().get_alloc_properties().get_last_extent();
+    e.tgt_last = fl.rank()==1 ? 1 : f_tgt.get_header().get_alloc_properties().get_last_extent();
+    entries.push_back(e);
+
+    m_is_batched[i] = true;
+    m_batch_max_col_size = std::max(m_batch_max_col_size,e.col_size);
+  }
+
+  m_batch_entries = view_1d<BatchEntry>("",entries.size());
+  auto entries_h = Kokkos::create_mirror_view(m_batch_entries);
+  for (size_t i=0; i<entries.size(); ++i) {
+    entries_h(i) = entries[i];
+  }
+  Kokkos::deep_copy(m_batch_entries,entries_h);
 }
 
 void CoarseningRemapper::clean_up ()
@@ -965,6 +1119,8 @@ void CoarseningRemapper::clean_up ()
   m_recv_lids_pidpos    = view_2d<int>();
   m_recv_lids_beg       = view_1d<int>();
   m_recv_lids_end       = view_1d<int>();
+  m_batch_entries       = view_1d<BatchEntry>();
+  m_is_batched.clear();
   m_send_req.clear();
   m_recv_req.clear();
 
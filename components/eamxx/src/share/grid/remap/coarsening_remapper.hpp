@@ -61,6 +61,9 @@ protected:
 
   void setup_mpi_data_structures () override;
 
+  // Collect the fields that can be remapped with the batched kernels
+  void setup_batched_fields ();
+
   std::vector<int> get_pids_for_recv (const std::vector<int>& send_to_pids) const;
 
   std::map<int,std::vector<int>>
@@ -78,6 +81,7 @@ public:
   void local_mat_vec (const Field& f_src, const Field& f_tgt, const Field& mask) const;
   template<int N>
   void rescale_masked_fields (const Field& f_tgt, const Field& f_mask) const;
+  void local_mat_vec_batched () const;
   void pack_and_send ();
   void recv_and_unpack ();
   // Overload, not hide
@@ -147,6 +151,25 @@ protected:
   // Send/recv requests
   std::vector<MPI_Request>  m_recv_req;
   std::vector<MPI_Request>  m_send_req;
+
+  // Fields without mask that are not subfields are contiguous arrays, with the column
+  // as first index and (possibly) padding along the last dimension. The mat-vec, pack
+  // and unpack of all these fields are done by one kernel each, which gets the data
+  // pointers and sizes of each field from this view.
+  struct BatchEntry {
+    const Real*   src;
+    Real*         ov;
+    Real*         tgt;
+    int           ifield;     // Index of the field in the pid offsets views
+    int           col_size;   // Number of entries per column
+    int           last_dim;   // Extent of the last dimension (1 for rank-1 fields)
+    int           src_last;   // Allocated extent of the last dimension of src/ov/tgt
+    int           ov_last;
+    int           tgt_last;
+  };
+  view_1d<BatchEntry>   m_batch_entries;
+  int                   m_batch_max_col_size = 0;
+  std::vector<bool>     m_is_batched;
 };
 
 } // namespace scream
@@ -11,6 +11,27 @@
 namespace scream
 {
 
+struct HorizInterpRemapperBase::MapData {
+  // The coarse grid, before any geometry data is added to it. Each remapper
+  // uses a shallow clone, since CoarseningRemapper adds geo data to its own.
+  std::shared_ptr<const AbstractGrid> coarse_grid;
+  grid_ptr_type   ov_coarse_grid;
+
+  view_1d<int>    row_offsets;
+  view_1d<int>    col_lids;
+  view_1d<Real>   weights;
+};
+
+namespace {
+// Map data of all existing horizontal interpolation remappers. Entries are weak,
+// so the data is released when the last remapper using it is destroyed.
+template<typename MapData>
+std::map<std::string,std::weak_ptr<const MapData>>& map_data_registry () {
+  static std::map<std::string,std::weak_ptr<const MapData>> registry;
+  return registry;
+}
+} // anonymous namespace
+
 HorizInterpRemapperBase::
 HorizInterpRemapperBase (const grid_ptr_type& fine_grid,
                          const std::string& map_file,
@@ -30,12 +51,40 @@ HorizInterpRemapperBase (const grid_ptr_type& fine_grid,
   // This is a special remapper. We only go in one direction
   m_bwd_allowed = false;
 
-  // Read the map file, loading the triplets this rank needs for the crs matrix
-  // in the map file that this rank has to read
-  auto my_triplets = get_my_triplets (map_file);
-
-  // Create coarse/ov_coarse grids
-  create_coarse_grids (my_triplets);
+  // Reuse the map data if another remapper already built it. Remappers are
+  // created in the same order on all ranks, so all ranks agree on the outcome.
+  const std::string key = map_file + "|" + fine_grid->name()
+                        + "|" + std::to_string(fine_grid->get_num_global_dofs())
+                        + "|" + std::to_string(fine_grid->get_num_vertical_levels())
+                        + "|" + (m_type==InterpType::Refine ? "refine" : "coarsen");
+  auto& registry = map_data_registry<MapData>();
+  m_map_data = registry[key].lock();
+  if (m_map_data==nullptr) {
+    // Read the map file, loading the triplets this rank needs for the crs matrix
+    // in the map file that this rank has to read
+    auto my_triplets = get_my_triplets (map_file);
+
+    // Create coarse/ov_coarse grids
+    create_coarse_grids (my_triplets);
+
+    // Create crs matrix
+    create_crs_matrix_structures (my_triplets);
+
+    auto map_data = std::make_shared<MapData>();
+    map_data->coarse_grid    = m_coarse_grid;
+    map_data->ov_coarse_grid = m_ov_coarse_grid;
+    map_data->row_offsets    = m_row_offsets;
+    map_data->col_lids       = m_col_lids;
+    map_data->weights        = m_weights;
+    registry[key] = map_data;
+    m_map_data = map_data;
+  } else {
+    m_ov_coarse_grid = m_map_data->ov_coarse_grid;
+    m_row_offsets    = m_map_data->row_offsets;
+    m_col_lids       = m_map_data->col_lids;
+    m_weights        = m_map_data->weights;
+  }
+  m_coarse_grid = m_map_data->coarse_grid->clone(m_map_data->coarse_grid->name(),true);
 
   // Set src/tgt grid, based on interpolation type
   if (m_type==InterpType::Refine) {
@@ -43,9 +92,6 @@ HorizInterpRemapperBase (const grid_ptr_type& fine_grid,
   } else {
     set_grids (m_fine_grid,m_coarse_grid);
   }
-
-  // Create crs matrix
-  create_crs_matrix_structures (my_triplets);
 }
 
 FieldLayout HorizInterpRemapperBase::
@@ -129,6 +129,12 @@ public:
   view_1d<int>    m_col_lids;
   view_1d<Real>   m_weights;
 
+  // The coarse grids and crs matrix built from the map file. Remappers with the
+  // same map file, fine grid, and interp type share them, so that the map file
+  // is read and processed only once.
+  struct MapData;
+  std::shared_ptr<const MapData>  m_map_data;
+
   InterpType      m_type;
 
   ekat::Comm      m_comm;
@@ -6,6 +6,7 @@
 #include <ekat/kokkos/ekat_kokkos_utils.hpp>
 #include <ekat/ekat_pack_utils.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 namespace scream
@@ -13,8 +14,10 @@ namespace scream
 
 RefiningRemapperRMA::
 RefiningRemapperRMA (const grid_ptr_type& tgt_grid,
-                     const std::string& map_file)
+                     const std::string& map_file,
+                     const bool use_shared_mem_window)
  : HorizInterpRemapperBase(tgt_grid,map_file,InterpType::Refine)
+ , m_use_shared_mem_window(use_shared_mem_window)
 {
   // Nothing to do here
 }
@@ -27,37 +30,51 @@ RefiningRemapperRMA::
 
 void RefiningRemapperRMA::do_remap_fwd ()
 {
-  // Start RMA epoch on each field
-  for (int i=0; i<m_num_fields; ++i) {
-    check_mpi_call(MPI_Win_post(m_mpi_group,0,m_mpi_win[i]),
-                   "MPI_Win_post for field: " + m_src_fields[i].name());
-    check_mpi_call(MPI_Win_start(m_mpi_group,0,m_mpi_win[i]),
-                   "MPI_Win_start for field: " + m_src_fields[i].name());
+  const auto mpi_comm = m_comm.mpi_comm();
+
+  // Pack the src fields, and make the host buffer available to the other ranks
+  pack_src_fields();
+  Kokkos::deep_copy(m_mpi_send_buffer,m_send_buffer);
+  if (m_shm_win!=MPI_WIN_NULL) {
+    check_mpi_call(MPI_Win_sync(m_shm_win),"MPI_Win_sync");
+  }
+  check_mpi_call(MPI_Win_sync(m_mpi_win),"MPI_Win_sync");
+  check_mpi_call(MPI_Barrier(mpi_comm),"MPI_Barrier");
+  if (m_shm_win!=MPI_WIN_NULL) {
+    // The sync before the barrier publishes our writes. This one makes the writes
+    // of the other ranks on the node visible to our loads (unified memory model).
+    check_mpi_call(MPI_Win_sync(m_shm_win),"MPI_Win_sync");
   }
 
-  // Loop over fields, and grab data
-  constexpr HostOrDevice MpiDev = MpiOnDev ? Device : Host;
+  // Grab all the fields of each remote column at once. Columns that are
+  // consecutive on the same pid are retrieved with a single get/copy.
   const auto& dt = ekat::get_mpi_type<Real>();
-  for (int i=0; i<m_num_fields; ++i) {
-    const int col_size = m_col_size[i];
-    const int col_stride = m_col_stride[i];
-    const int col_offset = m_col_offset[i];
-    const auto& win = m_mpi_win[i];
-    auto ov_data = m_ov_fields[i].get_internal_view_data<Real,MpiDev>();
-    for (int icol=0; icol<m_ov_coarse_grid->get_num_local_dofs(); ++icol) {
-      const int pid = m_remote_pids[icol];
-      const int lid = m_remote_lids[icol];
-      check_mpi_call(MPI_Get(ov_data+icol*col_size,col_size,dt,pid,
-                             lid*col_stride+col_offset,col_size,dt,win),
-                     "MPI_Get for field: " + m_ov_fields[i].name());
+  const int ncols = m_ov_coarse_grid->get_num_local_dofs();
+  const int bcs = m_buf_col_size;
+  auto recv_data = m_mpi_recv_buffer.data();
+  for (int icol=0; icol<ncols; ) {
+    const int pid = m_remote_pids[icol];
+    const int lid = m_remote_lids[icol];
+    int n = 1;
+    while (icol+n<ncols and m_remote_pids[icol+n]==pid and m_remote_lids[icol+n]==lid+n) {
+      ++n;
     }
+    const auto node_buf = m_node_send_buffers.empty() ? nullptr : m_node_send_buffers[pid];
+    if (node_buf!=nullptr) {
+      std::copy_n(node_buf+lid*bcs,n*bcs,recv_data+icol*bcs);
+    } else {
+      check_mpi_call(MPI_Get(recv_data+icol*bcs,n*bcs,dt,pid,lid*bcs,n*bcs,dt,m_mpi_win),
+                     "MPI_Get for columns of pid " + std::to_string(pid));
+    }
+    icol += n;
   }
+  check_mpi_call(MPI_Win_flush_all(m_mpi_win),"MPI_Win_flush_all");
 
-  // Close access RMA epoch on each field (exposure is still open)
-  for (int i=0; i<m_num_fields; ++i) {
-    check_mpi_call(MPI_Win_complete(m_mpi_win[i]),
-                   "MPI_Win_complete for field: " + m_ov_fields[i].name());
-  }
+  // Nobody reads our buffer anymore, so it can be overwritten at the next call
+  check_mpi_call(MPI_Barrier(mpi_comm),"MPI_Barrier");
+
+  Kokkos::deep_copy(m_recv_buffer,m_mpi_recv_buffer);
+  unpack_ov_fields();
 
   // Helpef function, to establish if a field can be handled with packs
   auto can_pack_field = [](const Field& f) {
@@ -88,12 +105,75 @@ void RefiningRemapperRMA::do_remap_fwd ()
       local_mat_vec<1>(f_ov_src,f_tgt);
     }
   }
+}
+
+namespace {
+// Number of entries along the last dim, and its allocated size (including padding)
+std::pair<int,int> last_dims (const Field& f) {
+  const auto& fh = f.get_header();
+  const auto& layout = fh.get_identifier().get_layout();
+  if (layout.rank()==1) {
+    return std::make_pair(1,1);
+  }
+  return std::make_pair(layout.dims().back(),fh.get_alloc_properties().get_last_extent());
+}
+} // anonymous namespace
+
+void RefiningRemapperRMA::pack_src_fields ()
+{
+  using RangePolicy = typename KT::RangePolicy;
 
-  // Close exposure RMA epoch on each field
+  const int ncols = m_src_grid->get_num_local_dofs();
+  const int bcs = m_buf_col_size;
+  auto buf = m_send_buffer;
   for (int i=0; i<m_num_fields; ++i) {
-    check_mpi_call(MPI_Win_wait(m_mpi_win[i]),
-                   "MPI_Win_post for field: " + m_src_fields[i].name());
+    const auto& f = m_src_fields[i];
+    const int col_size   = m_col_size[i];
+    const int col_stride = m_col_stride[i];
+    const int offset     = m_col_offset[i];
+    const int buf_offset = m_buf_col_offset[i];
+    const auto dims = last_dims(f);
+    const int last = dims.first;
+    const int alloc_last = dims.second;
+    auto data = f.get_internal_view_data<const Real>();
+    auto pack = KOKKOS_LAMBDA (const int idx) {
+      const int icol = idx / col_size;
+      const int k    = idx % col_size;
+      buf(icol*bcs + buf_offset + k) =
+        data[icol*col_stride + offset + (k/last)*alloc_last + k%last];
+    };
+    Kokkos::parallel_for("RefiningRemapperRMA::pack_src_fields",
+                         RangePolicy(0,ncols*col_size),pack);
+  }
+  Kokkos::fence();
+}
+
+void RefiningRemapperRMA::unpack_ov_fields ()
+{
+  using RangePolicy = typename KT::RangePolicy;
+
+  const int ncols = m_ov_coarse_grid->get_num_local_dofs();
+  const int bcs = m_buf_col_size;
+  auto buf = m_recv_buffer;
+  for (int i=0; i<m_num_fields; ++i) {
+    const auto& f = m_ov_fields[i];
+    const int col_size   = m_col_size[i];
+    const int buf_offset = m_buf_col_offset[i];
+    const auto dims = last_dims(f);
+    const int last = dims.first;
+    const int alloc_last = dims.second;
+    const int col_alloc_size = (col_size/last)*alloc_last;
+    auto data = f.get_internal_view_data<Real>();
+    auto unpack = KOKKOS_LAMBDA (const int idx) {
+      const int icol = idx / col_size;
+      const int k    = idx % col_size;
+      data[icol*col_alloc_size + (k/last)*alloc_last + k%last] =
+        buf(icol*bcs + buf_offset + k);
+    };
+    Kokkos::parallel_for("RefiningRemapperRMA::unpack_ov_fields",
+                         RangePolicy(0,ncols*col_size),unpack);
   }
+  Kokkos::fence();
 }
 
 void RefiningRemapperRMA::setup_mpi_data_structures ()
@@ -102,20 +182,17 @@ void RefiningRemapperRMA::setup_mpi_data_structures ()
 
   // Extract some raw mpi info
   const auto mpi_comm  = m_comm.mpi_comm();
-  check_mpi_call(MPI_Comm_group(mpi_comm,&m_mpi_group),"MPI_Comm_group");
 
   // Figure out where data needs to be retrieved from
   const auto ov_src_gids = m_ov_coarse_grid->get_dofs_gids().get_view<const gid_type*,Host>();
   m_src_grid->get_remote_pids_and_lids(ov_src_gids,m_remote_pids,m_remote_lids);
 
-  // TODO: scope out possibility of using sub-groups for start/post calls
-  //       (but I'm afraid you can't, b/c start/post may require same groups)
-
-  // Create per-field structures
-  m_mpi_win.resize(m_num_fields);
+  // Create per-field structures, and the layout of a column in the packed buffers
   m_col_size.resize(m_num_fields);
   m_col_stride.resize(m_num_fields);
   m_col_offset.resize(m_num_fields,0);
+  m_buf_col_offset.resize(m_num_fields);
+  m_buf_col_size = 0;
   for (int i=0; i<m_num_fields; ++i) {
     const auto& f = m_src_fields[i];
     const auto& fh = f.get_header();
@@ -127,41 +204,102 @@ void RefiningRemapperRMA::setup_mpi_data_structures ()
 
     // If field has a parent, col_stride and col_offset need to be adjusted
     auto p = fh.get_parent().lock();
-    auto win_size = layout.size()*sizeof(Real);
     if (p) {
       EKAT_REQUIRE_MSG (p->get_parent().lock()==nullptr,
           "Error! We do not support remapping of subfields of other subfields.\n");
       const auto& sv_info = fap.get_subview_info();
       m_col_offset[i] = sv_info.slice_idx  * col_stride;
       m_col_stride[i] = sv_info.dim_extent * col_stride;
-      win_size *= sv_info.dim_extent;
     }
 
-    auto data = f.get_internal_view_data<Real,Host>();
-    check_mpi_call(MPI_Win_create(data,win_size,sizeof(Real),
-                                  MPI_INFO_NULL,mpi_comm,&m_mpi_win[i]),
-                   "[RefiningRemapperRMA::setup_mpi_data_structures] MPI_Win_create");
+    m_buf_col_offset[i] = m_buf_col_size;
+    m_buf_col_size += m_col_size[i];
+  }
+
+  // Allocate the buffers. The host send buffer is exposed in the window, so, if
+  // requested, we allocate it in memory shared by the ranks on the same node.
+  const int nsrc = m_src_grid->get_num_local_dofs();
+  const int nov  = m_ov_coarse_grid->get_num_local_dofs();
+  const MPI_Aint send_size = std::max(nsrc*m_buf_col_size,1);
+  m_send_buffer = view_1d<Real>("",send_size);
+  m_recv_buffer = view_1d<Real>("",std::max(nov*m_buf_col_size,1));
+  m_mpi_recv_buffer = Kokkos::create_mirror_view(m_recv_buffer);
+  if (m_use_shared_mem_window) {
+    check_mpi_call(MPI_Comm_split_type(mpi_comm,MPI_COMM_TYPE_SHARED,m_comm.rank(),
+                                       MPI_INFO_NULL,&m_node_comm),
+                   "[RefiningRemapperRMA::setup_mpi_data_structures] MPI_Comm_split_type");
+    Real* shm_data;
+    check_mpi_call(MPI_Win_allocate_shared(send_size*sizeof(Real),sizeof(Real),MPI_INFO_NULL,
+                                           m_node_comm,&shm_data,&m_shm_win),
+                   "[RefiningRemapperRMA::setup_mpi_data_structures] MPI_Win_allocate_shared");
+    check_mpi_call(MPI_Win_lock_all(MPI_MODE_NOCHECK,m_shm_win),"MPI_Win_lock_all");
+    m_mpi_send_buffer = decltype(m_mpi_send_buffer)(shm_data,send_size);
+
+    // Map the ranks of m_comm on this node to their buffer
+    MPI_Group group, node_group;
+    check_mpi_call(MPI_Comm_group(mpi_comm,&group),"MPI_Comm_group");
+    check_mpi_call(MPI_Comm_group(m_node_comm,&node_group),"MPI_Comm_group");
+    const int size = m_comm.size();
+    std::vector<int> ranks(size), node_ranks(size);
+    std::iota(ranks.begin(),ranks.end(),0);
+    check_mpi_call(MPI_Group_translate_ranks(group,size,ranks.data(),node_group,node_ranks.data()),
+                   "MPI_Group_translate_ranks");
+    check_mpi_call(MPI_Group_free(&group),"MPI_Group_free");
+    check_mpi_call(MPI_Group_free(&node_group),"MPI_Group_free");
+    m_node_send_buffers.resize(size,nullptr);
+    for (int pid=0; pid<size; ++pid) {
+      if (node_ranks[pid]==MPI_UNDEFINED) {
+        continue;
+      }
+      MPI_Aint seg_size;
+      int disp_unit;
+      Real* ptr;
+      check_mpi_call(MPI_Win_shared_query(m_shm_win,node_ranks[pid],&seg_size,&disp_unit,&ptr),
+                     "MPI_Win_shared_query");
+      m_node_send_buffers[pid] = ptr;
+    }
+  } else {
+    m_mpi_send_buffer = Kokkos::create_mirror_view(m_send_buffer);
+  }
+
+  // One window for all fields, kept in a passive target epoch until clean up
+  check_mpi_call(MPI_Win_create(m_mpi_send_buffer.data(),send_size*sizeof(Real),sizeof(Real),
+                                MPI_INFO_NULL,mpi_comm,&m_mpi_win),
+                 "[RefiningRemapperRMA::setup_mpi_data_structures] MPI_Win_create");
 #ifndef EKAT_MPI_ERRORS_ARE_FATAL
-    check_mpi_call(MPI_Win_set_errhandler(m_mpi_win[i],MPI_ERRORS_RETURN),
-                   "[RefiningRemapperRMA::setup_mpi_data_structure] setting MPI_ERRORS_RETURN handler on MPI_Win");
+  check_mpi_call(MPI_Win_set_errhandler(m_mpi_win,MPI_ERRORS_RETURN),
+                 "[RefiningRemapperRMA::setup_mpi_data_structure] setting MPI_ERRORS_RETURN handler on MPI_Win");
 #endif
-  }
+  check_mpi_call(MPI_Win_lock_all(MPI_MODE_NOCHECK,m_mpi_win),"MPI_Win_lock_all");
 }
 
 void RefiningRemapperRMA::clean_up ()
 {
-  // Clear all MPI related structures
-  if (m_mpi_group!=MPI_GROUP_NULL) {
-    check_mpi_call(MPI_Group_free(&m_mpi_group),"MPI_Group_free");
-    m_mpi_group = MPI_GROUP_NULL;
+  // Clear all MPI related structures. The host send buffer may live in the
+  // shared window memory, so release it before freeing the windows.
+  m_mpi_send_buffer = decltype(m_mpi_send_buffer)();
+  if (m_mpi_win!=MPI_WIN_NULL) {
+    check_mpi_call(MPI_Win_unlock_all(m_mpi_win),"MPI_Win_unlock_all");
+    check_mpi_call(MPI_Win_free(&m_mpi_win),"MPI_Win_free");
+  }
+  if (m_shm_win!=MPI_WIN_NULL) {
+    check_mpi_call(MPI_Win_unlock_all(m_shm_win),"MPI_Win_unlock_all");
+    check_mpi_call(MPI_Win_free(&m_shm_win),"MPI_Win_free");
   }
-  for (auto& win : m_mpi_win) {
-    check_mpi_call(MPI_Win_free(&win),"MPI_Win_free");
+  if (m_node_comm!=MPI_COMM_NULL) {
+    check_mpi_call(MPI_Comm_free(&m_node_comm),"MPI_Comm_free");
   }
-  m_mpi_win.clear();
+  m_node_send_buffers.clear();
+  m_send_buffer = view_1d<Real>();
+  m_recv_buffer = view_1d<Real>();
+  m_mpi_recv_buffer = decltype(m_mpi_recv_buffer)();
   m_remote_pids.clear();
   m_remote_lids.clear();
   m_col_size.clear();
+  m_col_stride.clear();
+  m_col_offset.clear();
+  m_buf_col_offset.clear();
+  m_buf_col_size = 0;
 
   HorizInterpRemapperBase::clean_up();
 }
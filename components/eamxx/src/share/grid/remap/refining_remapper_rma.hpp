@@ -42,6 +42,15 @@ namespace scream
  * standard since 2.0, but its support is still sub-optimal, due to
  * limited effort in optimizing it by the vendors. Furthermore, as of
  * Oct 2023, RMA operations are not supported by GPU-aware implementations.
+ *
+ * The src fields are packed column by column in a single host buffer, which
+ * is exposed in one MPI window, created at setup and kept in a passive-target
+ * epoch (lock_all) until clean up. At each remap, all the data of a remote column
+ * is retrieved with one MPI_Get (consecutive columns are merged), and two
+ * barriers delimit the time during which the buffers can be read.
+ * If use_shared_mem_window=true, the buffer is allocated with MPI_Win_allocate_shared
+ * on the ranks of each node, and the columns owned by ranks on the same node
+ * are copied directly from their buffer, without MPI_Get.
  */
 
 class RefiningRemapperRMA : public HorizInterpRemapperBase
@@ -49,7 +58,8 @@ class RefiningRemapperRMA : public HorizInterpRemapperBase
 public:
 
   RefiningRemapperRMA (const grid_ptr_type& tgt_grid,
-                       const std::string& map_file);
+                       const std::string& map_file,
+                       const bool use_shared_mem_window = false);
 
   ~RefiningRemapperRMA ();
 
@@ -68,17 +78,13 @@ protected:
 
 protected:
 
-  // Wrap a pointer in an MPI_Win
-  template<typename T>
-  MPI_Win get_mpi_window (T* v, int n) const {
-    MPI_Win win;
-    check_mpi_call (MPI_Win_create(v,n*sizeof(T),sizeof(T),
-                                   MPI_INFO_NULL,m_comm.mpi_comm(),&win),
-                    "MPI_Win_create");
-    return win;
-  }
-
-  MPI_Group             m_mpi_group = MPI_GROUP_NULL;
+#ifdef KOKKOS_ENABLE_CUDA
+public:
+#endif
+  // Pack the src fields into the send buffer, and unpack the recv buffer into the ov fields
+  void pack_src_fields ();
+  void unpack_ov_fields ();
+protected:
 
   // Unfortunately there is no GPU-aware mpi for RMA operations.
   //static constexpr bool MpiOnDev = SCREAM_MPI_ON_DEVICE;
@@ -102,8 +108,27 @@ protected:
   std::vector<int>          m_col_stride;
   std::vector<int>          m_col_offset;
 
-  // One MPI window object for each field
-  std::vector<MPI_Win>      m_mpi_win;
+  // Offset of each field in a column of the packed buffers, and the size
+  // of a packed column (the sum of m_col_size)
+  std::vector<int>          m_buf_col_offset;
+  int                       m_buf_col_size = 0;
+
+  // The packed src fields (exposed to the other ranks), and the packed ov fields.
+  // The host buffers are the ones passed to MPI.
+  view_1d<Real>                       m_send_buffer;
+  view_1d<Real>                       m_recv_buffer;
+  typename view_1d<Real>::HostMirror  m_mpi_send_buffer;
+  typename view_1d<Real>::HostMirror  m_mpi_recv_buffer;
+
+  // The MPI window on m_mpi_send_buffer for all ranks
+  MPI_Win                   m_mpi_win = MPI_WIN_NULL;
+
+  // On-node shared memory: the node comm, the shared window, and, for each rank
+  // in m_comm, the pointer to its send buffer (nullptr if not on this node)
+  bool                      m_use_shared_mem_window;
+  MPI_Comm                  m_node_comm = MPI_COMM_NULL;
+  MPI_Win                   m_shm_win   = MPI_WIN_NULL;
+  std::vector<const Real*>  m_node_send_buffers;
 };
 
 } // namespace scream
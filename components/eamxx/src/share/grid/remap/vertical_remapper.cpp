@@ -1,7 +1,6 @@
 #include "vertical_remapper.hpp"
 
 #include "share/grid/point_grid.hpp"
-#include "share/util/scream_vertical_interpolation.hpp"
 #include "share/io/scorpio_input.hpp"
 #include "share/field/field_tag.hpp"
 #include "share/field/field_identifier.hpp"
@@ -306,33 +305,37 @@ void VerticalRemapper::do_registration_ends ()
     "Field for vertical profile of the source data for layout LEV has not been set.\n");
   EKAT_REQUIRE_MSG(m_int_set,"Error::VerticalRemapper:registration_ends,\n"
     "Field for vertical profile of the source data for layout ILEV has not been set.\n");
+
+  // Get the interpolation weights. Other remappers with the same profiles and
+  // pressure levels will share them.
+  using Weights = vinterp::VerticalInterpWeights;
+  auto remap_pres = m_remap_pres.get_view<const Real*,Host>();
+  std::vector<Real> p_tgt(remap_pres.data(),remap_pres.data()+m_num_remap_levs);
+  m_mid_weights = Weights::get_shared_weights(m_src_mid,p_tgt,Weights::OutOfBounds::Mask);
+  m_int_weights = Weights::get_shared_weights(m_src_int,p_tgt,Weights::OutOfBounds::Mask);
 }
 
 void VerticalRemapper::do_remap_fwd ()
 {
   using namespace ShortFieldTagsNames;
-  // Loop over each field
-  constexpr auto can_pack = SCREAM_PACK_SIZE>1;
-  const auto& tgt_pres_ap = m_remap_pres.get_header().get_alloc_properties();
+
+  // Update the weights (if the src profiles changed)
+  m_mid_weights->compute(m_src_mid);
+  m_int_weights->compute(m_src_int);
+
+  // Sort fields by src vertical layout, and interpolate each group with one kernel
+  std::vector<Field> mid_src, mid_tgt, int_src, int_tgt;
   for (int i=0; i<m_num_fields; ++i) {
     const auto& f_src    = m_src_fields[i];
           auto  f_tgt    = m_tgt_fields[i];
     const auto& layout   = f_src.get_header().get_identifier().get_layout();
     const auto  src_tag  = layout.tags().back();
-    const bool  do_remap = ekat::contains(std::vector<FieldTag>{ILEV,LEV},src_tag);
-    if (do_remap) {
-      // Dispatch kernel with the largest possible pack size
-      const auto& src_ap = f_src.get_header().get_alloc_properties();
-      const auto& tgt_ap = f_tgt.get_header().get_alloc_properties();
-      const auto& src_pres_ap = src_tag == LEV ? m_src_mid.get_header().get_alloc_properties() : m_src_int.get_header().get_alloc_properties();
-      if (can_pack && src_ap.is_compatible<RPack<SCREAM_PACK_SIZE>>() &&
-                      tgt_ap.is_compatible<RPack<SCREAM_PACK_SIZE>>() &&
-                      src_pres_ap.is_compatible<RPack<SCREAM_PACK_SIZE>>() &&
-                      tgt_pres_ap.is_compatible<RPack<SCREAM_PACK_SIZE>>()) {
-        apply_vertical_interpolation<SCREAM_PACK_SIZE>(f_src,f_tgt); 
-      } else {
-        apply_vertical_interpolation<1>(f_src,f_tgt); 
-      }
+    if (src_tag==LEV) {
+      mid_src.push_back(f_src);
+      mid_tgt.push_back(f_tgt);
+    } else if (src_tag==ILEV) {
+      int_src.push_back(f_src);
+      int_tgt.push_back(f_tgt);
     } else {
       // There is nothing to do, this field cannot be vertically interpolated,
       // so just copy it over.  Note, if this field has its own mask data make
@@ -345,77 +348,26 @@ void VerticalRemapper::do_remap_fwd ()
       f_tgt.deep_copy(f_src);
     }
   }
+  // The masks are 1 where the tgt pressure is within the src profile, 0 elsewhere.
+  // They are computed in the same kernel as the fields with the same src profile.
+  std::vector<Field> mid_masks, int_masks;
   for (unsigned i=0; i<m_tgt_masks.size(); ++i) {
-          auto& f_src    = m_src_masks[i];
+    const auto& f_src    = m_src_masks[i];
           auto& f_tgt    = m_tgt_masks[i];
     const auto& layout   = f_src.get_header().get_identifier().get_layout();
     const auto  src_tag  = layout.tags().back();
-    const bool  do_remap = ekat::contains(std::vector<FieldTag>{ILEV,LEV},src_tag);
-    if (do_remap) {
-      // If we are remapping then we need to initialize the mask source values to 1.0
-      f_src.deep_copy(1.0);
-      // Dispatch kernel with the largest possible pack size
-      const auto& src_ap = f_src.get_header().get_alloc_properties();
-      const auto& tgt_ap = f_tgt.get_header().get_alloc_properties();
-      const auto& src_pres_ap = src_tag == LEV ? m_src_mid.get_header().get_alloc_properties() : m_src_int.get_header().get_alloc_properties();
-      if (can_pack && src_ap.is_compatible<RPack<SCREAM_PACK_SIZE>>() &&
-                      tgt_ap.is_compatible<RPack<SCREAM_PACK_SIZE>>() &&
-                      src_pres_ap.is_compatible<RPack<SCREAM_PACK_SIZE>>() &&
-                      tgt_pres_ap.is_compatible<RPack<SCREAM_PACK_SIZE>>()) {
-        apply_vertical_interpolation<SCREAM_PACK_SIZE>(f_src,f_tgt,true); 
-      } else {
-        apply_vertical_interpolation<1>(f_src,f_tgt,true); 
-      }
+    if (src_tag==LEV) {
+      mid_masks.push_back(f_tgt);
+    } else if (src_tag==ILEV) {
+      int_masks.push_back(f_tgt);
     } else {
       // There is nothing to do, this field cannot be vertically interpolated,
       // so just copy it over.
       f_tgt.deep_copy(f_src);
     }
   }
-}
-
-template<int Packsize>
-void VerticalRemapper::
-apply_vertical_interpolation(const Field& f_src, const Field& f_tgt, const bool mask_interp) const
-{
-    
-    using Pack = ekat::Pack<Real,Packsize>;
-    using namespace ShortFieldTagsNames;
-    using namespace scream::vinterp;
-    const auto& layout = f_src.get_header().get_identifier().get_layout();
-    const auto  rank   = f_src.rank();
-    const auto src_tag = layout.tags().back();
-    const auto src_num_levs = layout.dims().back();
-    // ARG mask_interp checks if this is a vertical interpolation of the mask array that tracks masked 0.0 or not 1.0
-    Real mask_val = mask_interp ? 0.0 : m_mask_val;
-
-    Field    src_lev_f;
-    if (src_tag == ILEV) {
-      src_lev_f = m_src_int;
-    } else {
-      src_lev_f = m_src_mid;
-    }
-    auto src_lev  = src_lev_f.get_view<const Pack**>();
-    auto remap_pres_view = m_remap_pres.get_view<Pack*>();
-    switch(rank) {
-      case 2:
-      {
-        auto src_view = f_src.get_view<const Pack**>();
-        auto tgt_view = f_tgt.get_view<      Pack**>();
-        perform_vertical_interpolation<Real,Packsize,2>(src_lev,remap_pres_view,src_view,tgt_view,src_num_levs,m_num_remap_levs,mask_val);
-        break;
-      }
-      case 3:
-      {
-        auto src_view = f_src.get_view<const Pack***>();
-        auto tgt_view = f_tgt.get_view<      Pack***>();
-        perform_vertical_interpolation<Real,Packsize,3>(src_lev,remap_pres_view,src_view,tgt_view,src_num_levs,m_num_remap_levs,mask_val);
-        break;
-      }
-      default:
-        EKAT_ERROR_MSG ("Error! Field rank (" + std::to_string(rank) + ") not supported by VerticalRemapper.\n");
-    }
-
+  m_mid_weights->apply(mid_src,mid_tgt,mid_masks,m_mask_val);
+  m_int_weights->apply(int_src,int_tgt,int_masks,m_mask_val);
 }
 
 } // namespace scream
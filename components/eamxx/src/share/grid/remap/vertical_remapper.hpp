@@ -3,6 +3,7 @@
 
 #include "share/field/field_tag.hpp"
 #include "share/grid/remap/abstract_remapper.hpp"
+#include "share/util/eamxx_vertical_interp_weights.hpp"
 
 #include "ekat/ekat_pack.hpp"
 
@@ -11,6 +12,10 @@ namespace scream
 
 /*
  * A remapper to interpolate fields on a separate vertical grid
+ *
+ * The interpolation weights for the LEV and ILEV source profiles are computed
+ * once per remap (and only if the profiles changed), and are then applied to
+ * all the fields with the same vertical layout with one kernel.
  */
 
 class VerticalRemapper : public AbstractRemapper
@@ -102,13 +107,6 @@ protected:
   void set_pressure_levels (const std::string& map_file);
   void do_print();
 
-#ifdef KOKKOS_ENABLE_CUDA
-public:
-#endif
-  template<int N>
-  void apply_vertical_interpolation (const Field& f_src, const Field& f_tgt, const bool mask_interp=false) const;
-protected:
-
   using KT = KokkosTypes<DefaultDevice>;
   using gid_type = AbstractGrid::gid_type;
 
@@ -138,6 +136,10 @@ protected:
   Field                 m_src_int;  // Src vertical profile for ILEV layouts
   bool                  m_mid_set = false;
   bool                  m_int_set = false;
+
+  // Interpolation weights from the LEV and ILEV src profiles to the tgt pressure levels
+  std::shared_ptr<vinterp::VerticalInterpWeights> m_mid_weights;
+  std::shared_ptr<vinterp::VerticalInterpWeights> m_int_weights;
 };
 
 } // namespace scream
@@ -1,9 +1,11 @@
 #include "share/io/scorpio_input.hpp"
 
 #include "share/io/scream_scorpio_interface.hpp"
+#include "share/io/scream_io_utils.hpp"
 
 #include <ekat/util/ekat_string_utils.hpp>
 
+#include <map>
 #include <memory>
 #include <numeric>
 
@@ -360,6 +362,9 @@ void AtmosphereInput::register_variables()
   // This allows SCORPIO to lookup vars in the nc file with the correct
   // dof decomposition across different ranks.
 
+  // Identify the dofs partition once, since it requires a collective
+  m_grid_dofs_key = get_grid_dofs_key(*m_io_grid);
+
   // Cycle through all fields
   const auto& fp_precision = "real";
   for (auto const& name : m_fields_names) {
@@ -413,7 +418,7 @@ AtmosphereInput::get_vec_of_dims(const FieldLayout& layout)
 std::string AtmosphereInput::
 get_io_decomp(const FieldLayout& layout)
 {
-  std::string decomp_tag = "dt=real,grid-idx=" + std::to_string(m_io_grid->get_unique_grid_id()) + ",layout=";
+  std::string decomp_tag = "dt=real,grid-dofs=" + m_grid_dofs_key + ",layout=";
 
   std::vector<int> range(layout.rank());
   std::iota(range.begin(),range.end(),0);
@@ -432,8 +437,17 @@ void AtmosphereInput::set_degrees_of_freedom()
 {
   // For each field, tell PIO the offset of each DOF to be read.
   // Here, offset is meant in the *global* array in the nc file.
+  // Fields with the same layout (e.g., all the 3d ICs) share the same offsets,
+  // so compute them once per IO decomposition, rather than once per field.
+  std::map<std::string,std::vector<scorpio::offset_t>> decomp_dofs;
   for (auto const& name : m_fields_names) {
-    auto var_dof = get_var_dof_offsets(m_layouts.at(name));
+    const auto& layout = m_layouts.at(name);
+    const auto decomp_tag = get_io_decomp(layout);
+    auto it = decomp_dofs.find(decomp_tag);
+    if (it==decomp_dofs.end()) {
+      it = decomp_dofs.emplace(decomp_tag,get_var_dof_offsets(layout)).first;
+    }
+    auto& var_dof = it->second;
     scorpio::set_dof(m_filename,name,var_dof.size(),var_dof.data());
   }
 } // set_degrees_of_freedom
@@ -10,12 +10,37 @@
 #include "ekat/util/ekat_string_utils.hpp"
 #include "ekat/std_meta/ekat_std_utils.hpp"
 
+#include <algorithm>
 #include <numeric>
+#include <sstream>
 #include <fstream>
 
 namespace scream
 {
 
+namespace {
+// Diagnostics created by any output stream, so that streams requesting the same
+// diagnostic (with the same sim field manager and fill value) share it, and the
+// diag is computed only once per time stamp. Entries are weak, so a diag is
+// released when the last stream using it is destroyed.
+std::map<std::string,std::weak_ptr<AtmosphereDiagnostic>>& shared_diagnostics () {
+  static std::map<std::string,std::weak_ptr<AtmosphereDiagnostic>> diags;
+  return diags;
+}
+
+// Diagnostics that are vertical integrals over pseudo_density, which can be
+// computed in one pass by the ColumnIntegrals diagnostic
+bool is_column_integral (const std::string& diag_field_name) {
+  return diag_field_name=="LiqWaterPath" or
+         diag_field_name=="IceWaterPath" or
+         diag_field_name=="RainWaterPath" or
+         diag_field_name=="RimeWaterPath" or
+         diag_field_name=="VapWaterPath" or
+         diag_field_name=="ZonalVapFlux" or
+         diag_field_name=="MeridionalVapFlux";
+}
+} // anonymous namespace
+
 // This helper function updates the current output val with a new one,
 // according to the "averaging" type, and according to the number of
 // model time steps since the last output step.
@@ -352,6 +377,9 @@ void AtmosphereOutput::init()
 
   // Now that the fields have been gathered register the local views which will be used to determine output data to be written.
   register_views();
+
+  // Group fields that can be accumulated together
+  setup_batched_accumulation();
 }
 
 void AtmosphereOutput::
@@ -429,13 +457,32 @@ run (const std::string& filename,
       auto& dev_view = m_local_tmp_avg_cnt_views_1d.at(name);
       Kokkos::deep_copy(dev_view,1.0);
     }
-    // Now we cycle through all the fields
+    // Now we cycle through all the fields, with one kernel per batch of fields
     for (const auto& name : m_fields_names) {
+      if (m_batched_fields.count(name)==1) {
+        continue;
+      }
       auto field    = get_field(name,"io");
       auto lookup   = m_field_to_avg_cnt_map.at(name);
       auto dev_view = m_local_tmp_avg_cnt_views_1d.at(lookup);
       update_avg_cnt_view(field,dev_view);
     }
+    const auto fill_value = m_fill_value;
+    for (const auto& batch : m_accum_batches) {
+      const auto entries = batch.entries;
+      const int size = batch.size;
+      const int last_dim = batch.last_dim;
+      const int alloc_last_dim = batch.alloc_last_dim;
+      KT::RangePolicy policy(0,entries.extent_int(0)*size);
+      Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
+        const int ifield = idx / size;
+        const int i = idx % size;
+        const auto& e = entries(ifield);
+        if (e.src[(i/last_dim)*alloc_last_dim + i%last_dim]==fill_value) {
+          e.avg_cnt[i] = 0.0;
+        }
+      });
+    }
     // Finally, we update the overall avg_cnt_views
     for (const auto& name : m_avg_cnt_names) {
       auto track_view = m_dev_views_1d.at(name);
@@ -448,14 +495,57 @@ run (const std::string& filename,
     }
   }
 
-  // Take care of updating and possibly writing fields.
-  for (auto const& name : m_fields_names) {
-    // Get all the info for this field.
-          auto  field = get_field(name,"io");
-    const auto& layout = m_layouts.at(field.name());
-    const auto& dims = layout.dims();
-    const auto  rank = layout.rank();
+  // Bring the data of a variable to host, and either write it or, in async mode,
+  // copy it into the staging buffers of this write step for a later write.
+  // With snapshot buffering, output steps copy it into the next slot of the snapshot
+  // buffers instead, and record the time index of this snapshot for the later write.
+  if (is_write_step and m_async_write) {
+    m_staging_idx = 1 - m_staging_idx;
+    m_staged_writes.clear();
+  }
+  const bool buffer_step = output_step and m_snapshot_buffer_size>1;
+  int buffer_time_index = -1;
+  if (buffer_step) {
+    EKAT_REQUIRE_MSG (m_num_buffered<m_snapshot_buffer_size,
+        "Error! The snapshot buffers are full. Call buffered_writes before the next output step.\n");
+    if (m_num_buffered==0) {
+      // The buffers may still be read by the async writes of the last buffered snapshots
+      wait_for_async_io();
+    }
+    buffer_time_index = get_curr_time_index(filename);
+  }
+  auto write_or_stage = [&](const std::string& name, const view_1d_dev& view_dev) {
+    if (buffer_step) {
+      const int size = view_dev.size();
+      auto& buffer = m_snapshot_buffers[name];
+      if (buffer.size()==0) {
+        buffer = view_1d_host("",m_snapshot_buffer_size*size);
+      }
+      const auto slot = std::make_pair(m_num_buffered*size,(m_num_buffered+1)*size);
+      auto view_host = Kokkos::subview(buffer,slot);
+      Kokkos::deep_copy (view_host,view_dev);
+      m_buffered_writes.push_back({filename,name,view_host.data(),size,buffer_time_index});
+    } else if (m_async_write) {
+      auto& staging = m_staging_views_1d[m_staging_idx];
+      if (staging.count(name)==0) {
+        staging.emplace(name,view_1d_host("",view_dev.size()));
+      }
+      auto view_host = staging.at(name);
+      Kokkos::deep_copy (view_host,view_dev);
+      m_staged_writes.push_back({filename,name,view_host.data(),static_cast<int>(view_host.size())});
+    } else {
+      auto view_host = m_host_views_1d.at(name);
+      Kokkos::deep_copy (view_host,view_dev);
+      auto func_start = std::chrono::steady_clock::now();
+      grid_write_data_array(filename,name,view_host.data(),view_host.size());
+      auto func_finish = std::chrono::steady_clock::now();
+      auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
+      duration_write += duration_loc.count();
+    }
+  };
 
+  for (auto const& name : m_fields_names) {
+    auto field = get_field(name,"io");
     if (not field.get_header().get_tracking().get_time_stamp().is_valid()) {
       // Safety check: make sure that the user is ok with this
       if (allow_invalid_fields) {
@@ -465,6 +555,38 @@ run (const std::string& filename,
             "Error! Time-dependent output field '" + name + "' has not been initialized yet\n.");
       }
     }
+  }
+
+  // Update the 'running-tally' views of the batched fields, with one kernel per batch
+  for (const auto& batch : m_accum_batches) {
+    const auto entries = batch.entries;
+    const int size = batch.size;
+    const int last_dim = batch.last_dim;
+    const int alloc_last_dim = batch.alloc_last_dim;
+    const auto avg_type = m_avg_type;
+    const bool track_avg_cnt = m_track_avg_cnt && m_add_time_dim;
+    const auto fill_value = m_fill_value;
+    KT::RangePolicy policy(0,entries.extent_int(0)*size);
+    Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
+      const int ifield = idx / size;
+      const int i = idx % size;
+      const auto& e = entries(ifield);
+      const Real new_val = e.src[(i/last_dim)*alloc_last_dim + i%last_dim];
+      if (track_avg_cnt) {
+        combine_and_fill(new_val,e.avg[i],e.avg_cnt[i],avg_type,fill_value);
+      } else {
+        combine(new_val,e.avg[i],avg_type);
+      }
+    });
+  }
+
+  // Take care of updating and possibly writing fields.
+  for (auto const& name : m_fields_names) {
+    // Get all the info for this field.
+          auto  field = get_field(name,"io");
+    const auto& layout = m_layouts.at(field.name());
+    const auto& dims = layout.dims();
+    const auto  rank = layout.rank();
 
     const bool is_diagnostic = (m_diagnostics.find(name) != m_diagnostics.end());
     const bool is_aliasing_field_view =
@@ -502,8 +624,9 @@ run (const std::string& filename,
     auto fill_value = m_fill_value;
     auto avg_coeff_threshold = m_avg_coeff_threshold;
     // If the dev_view_1d is aliasing the field device view (must be Instant output),
-    // then there's no point in copying from the field's view to dev_view
-    if (not is_aliasing_field_view) {
+    // then there's no point in copying from the field's view to dev_view.
+    // Batched fields have already been updated above.
+    if (not is_aliasing_field_view and m_batched_fields.count(name)==0) {
       switch (rank) {
         case 1:
         {
@@ -628,37 +751,79 @@ run (const std::string& filename,
           });
         }
       }
-      // Bring data to host
-      auto view_host = m_host_views_1d.at(name);
-      Kokkos::deep_copy (view_host,view_dev);
-      auto func_start = std::chrono::steady_clock::now();
-      grid_write_data_array(filename,name,view_host.data(),view_host.size());
-      auto func_finish = std::chrono::steady_clock::now();
-      auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
-      duration_write += duration_loc.count();
+      if (m_skipped_fields.count(name)==0) {
+        write_or_stage(name,view_dev);
+        if (m_skip_unchanged_fields) {
+          m_last_written[name] = {get_field(name,"sim").get_header().get_tracking().get_time_stamp(),filename};
+        }
+      }
     }
   }
   // Handle writing the average count variables to file
   if (is_write_step) {
     for (const auto& name : m_avg_cnt_names) {
       auto& view_dev = m_dev_views_1d.at(name);
-      // Bring data to host
-      auto view_host = m_host_views_1d.at(name);
-      Kokkos::deep_copy (view_host,view_dev);
-      auto func_start = std::chrono::steady_clock::now();
-      grid_write_data_array(filename,name,view_host.data(),view_host.size());
-      auto func_finish = std::chrono::steady_clock::now();
-      auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
-      duration_write += duration_loc.count();
+      write_or_stage(name,view_dev);
     }
   }
+  if (buffer_step) {
+    ++m_num_buffered;
+  }
   if (is_write_step) {
     if (m_atm_logger) {
-      m_atm_logger->info("[EAMxx::scorpio_output] Writing variables to file:\n\t " + filename + " ...done! (Elapsed time = " + std::to_string(duration_write/1000.0) +" seconds)\n");
+      if (buffer_step) {
+        m_atm_logger->info("[EAMxx::scorpio_output] Writing variables to file:\n\t " + filename + " ...buffered (" +
+                           std::to_string(m_num_buffered) + "/" + std::to_string(m_snapshot_buffer_size) + ")!\n");
+      } else if (m_async_write) {
+        m_atm_logger->info("[EAMxx::scorpio_output] Writing variables to file:\n\t " + filename + " ...staged for async write!\n");
+      } else {
+        m_atm_logger->info("[EAMxx::scorpio_output] Writing variables to file:\n\t " + filename + " ...done! (Elapsed time = " + std::to_string(duration_write/1000.0) +" seconds)\n");
+      }
     }
   }
 } // run
 
+std::function<void()> AtmosphereOutput::staged_writes ()
+{
+  // Copy the list, since the next write step may stage new writes
+  // before these are done
+  auto writes = m_staged_writes;
+  m_staged_writes.clear();
+  return [writes]() {
+    for (const auto& w : writes) {
+      scorpio::grid_write_data_array(w.filename,w.varname,w.data,w.size);
+    }
+  };
+}
+
+void AtmosphereOutput::set_snapshot_buffering (const int nsnaps)
+{
+  EKAT_REQUIRE_MSG (nsnaps>=1,
+      "Error! Invalid number of buffered snapshots: " + std::to_string(nsnaps) + "\n");
+  EKAT_REQUIRE_MSG (m_num_buffered==0,
+      "Error! Cannot change the snapshot buffering while snapshots are buffered.\n");
+  m_snapshot_buffer_size = nsnaps;
+  m_snapshot_buffers.clear();
+}
+
+std::function<void()> AtmosphereOutput::buffered_writes ()
+{
+  // Group the writes by variable, so that the snapshots of a variable are written
+  // back to back, and PIO can aggregate them in its write buffer
+  auto writes = m_buffered_writes;
+  std::stable_sort(writes.begin(),writes.end(),
+                   [](const StagedWrite& a, const StagedWrite& b) {
+                     return a.varname<b.varname;
+                   });
+  m_buffered_writes.clear();
+  m_num_buffered = 0;
+  return [writes]() {
+    for (const auto& w : writes) {
+      scorpio::grid_write_data_array(w.filename,w.varname,w.data,w.size,w.time_index);
+    }
+  };
+}
+
 long long AtmosphereOutput::
 res_dep_memory_footprint () const {
   long long rdmf = 0;
@@ -700,6 +865,11 @@ res_dep_memory_footprint () const {
     }
   }
 
+  // Host buffers of the snapshot buffering
+  for (const auto& it : m_snapshot_buffers) {
+    rdmf += it.second.size()*sizeof(Real);
+  }
+
   return rdmf;
 }
 /* ---------------------------------------------------------- */
@@ -846,6 +1016,59 @@ void AtmosphereOutput::register_views()
   reset_dev_views();
 }
 /* ---------------------------------------------------------- */
+void AtmosphereOutput::setup_batched_accumulation()
+{
+  // A field can be batched if its running tally is not aliasing the field view,
+  // and if the field is not a subfield, so that its data is a contiguous array
+  // with (possibly) padding along the last dimension. Fields are batched together
+  // if they have the same layout and the same padded last extent.
+  using key_t = std::pair<std::vector<int>,int>;
+  std::map<key_t,std::vector<BatchEntry>> batches;
+  for (const auto& name : m_fields_names) {
+    auto field = get_field(name,"io");
+    const auto& fh  = field.get_header();
+    const auto& fap = fh.get_alloc_properties();
+    const auto& layout = m_layouts.at(name);
+
+    const bool is_diagnostic = (m_diagnostics.find(name) != m_diagnostics.end());
+    const bool is_aliasing_field_view =
+        m_avg_type==OutputAvgType::Instant &&
+        fap.get_padding()==0 &&
+        fh.get_parent().expired() &&
+        not is_diagnostic;
+    if (is_aliasing_field_view or not fh.get_parent().expired() or layout.rank()==0) {
+      continue;
+    }
+
+    BatchEntry e;
+    e.src = field.get_internal_view_data<const Real,Device>();
+    e.avg = m_dev_views_1d.at(name).data();
+    e.avg_cnt = nullptr;
+    if (m_track_avg_cnt && m_add_time_dim) {
+      e.avg_cnt = m_local_tmp_avg_cnt_views_1d.at(m_field_to_avg_cnt_map.at(name)).data();
+    }
+    batches[key_t(layout.dims(),fap.get_last_extent())].push_back(e);
+    m_batched_fields.insert(name);
+  }
+
+  for (const auto& it : batches) {
+    const auto& dims = it.first.first;
+    const auto& entries = it.second;
+
+    AccumBatch batch;
+    batch.size = std::accumulate(dims.begin(),dims.end(),1,std::multiplies<int>());
+    batch.last_dim = dims.back();
+    batch.alloc_last_dim = it.first.second;
+    batch.entries = decltype(batch.entries)("",entries.size());
+    auto entries_h = Kokkos::create_mirror_view(batch.entries);
+    for (size_t i=0; i<entries.size(); ++i) {
+      entries_h(i) = entries[i];
+    }
+    Kokkos::deep_copy(batch.entries,entries_h);
+    m_accum_batches.push_back(batch);
+  }
+}
+/* ---------------------------------------------------------- */
 void AtmosphereOutput::set_avg_cnt_tracking(const std::string& name, const std::string& avg_cnt_suffix, const FieldLayout& layout)
 {
   // Make sure this field "name" hasn't already been regsitered with avg_cnt tracking.
@@ -929,9 +1152,12 @@ register_variables(const std::string& filename,
       "  - input value: " + fp_precision + "\n"
       "  - supported values: float, single, double, real\n");
 
+  // Identify the dofs partition once, since it requires a collective
+  const auto grid_dofs_key = get_grid_dofs_key(*m_io_grid);
+
   // Helper lambdas
   auto set_decomp_tag = [&](const FieldLayout& layout) {
-    std::string decomp_tag = "dt=real,grid-idx=" + std::to_string(m_io_grid->get_unique_grid_id()) + ",layout=";
+    std::string decomp_tag = "dt=real,grid-dofs=" + grid_dofs_key + ",layout=";
 
     std::vector<int> range(layout.rank());
     std::iota(range.begin(),range.end(),0);
@@ -968,11 +1194,14 @@ register_variables(const std::string& filename,
 
   // Cycle through all fields and register.
   for (auto const& name : m_fields_names) {
+    if (m_skipped_fields.count(name)==1) {
+      continue;
+    }
     auto field = get_field(name,"io");
     auto& fid  = field.get_header().get_identifier();
     // Make a unique tag for each decomposition. To reuse decomps successfully,
     // we must be careful to make the tags 1-1 with the intended decomp. Here we
-    // use the I/O grid name and its global #DOFs, then append the local
+    // use a key identifying the I/O grid dofs partition, then append the local
     // dimension data.
     //   We use real here because the data type for the decomp is the one used
     // in the simulation and not the one used in the output file.
@@ -1133,6 +1362,9 @@ void AtmosphereOutput::set_degrees_of_freedom(const std::string& filename)
 
   // Cycle through all fields and set dof.
   for (auto const& name : m_fields_names) {
+    if (m_skipped_fields.count(name)==1) {
+      continue;
+    }
     auto field = get_field(name,"io");
     const auto& fid  = field.get_header().get_identifier();
     auto var_dof = get_var_dof_offsets(fid.get_layout());
@@ -1159,6 +1391,21 @@ setup_output_file(const std::string& filename,
 {
   using namespace scream::scorpio;
 
+  // Find the fields that did not change since they were written in a previous file
+  m_skipped_fields.clear();
+  if (m_skip_unchanged_fields) {
+    for (const auto& name : m_fields_names) {
+      auto it = m_last_written.find(name);
+      if (it==m_last_written.end()) {
+        continue;
+      }
+      const auto& ts = get_field(name,"sim").get_header().get_tracking().get_time_stamp();
+      if (ts.is_valid() and ts==it->second.first) {
+        m_skipped_fields[name] = it->second.second;
+      }
+    }
+  }
+
   // Register dimensions with netCDF file.
   for (auto it : m_dims) {
     register_dimension(filename,it.first,it.first,it.second.first,it.second.second);
@@ -1201,6 +1448,12 @@ compute_diagnostic(const std::string& name, const bool allow_invalid_fields)
     }
   }
 
+  // The diag may be shared with other output streams. If one of them already
+  // computed it at the current time stamp, simply reuse the result.
+  if (diag->is_up_to_date()) {
+    return;
+  }
+
   // Either allow_invalid_fields=false, or all inputs are valid. Proceed.
   diag->compute_diagnostic();
 
@@ -1238,6 +1491,18 @@ get_field(const std::string& name, const std::string& mode) const
 void AtmosphereOutput::set_diagnostics()
 {
   const auto sim_field_mgr = get_field_manager("sim");
+
+  // If the stream requests more than one column integral, they are all computed
+  // in a single pass over the columns, and each diag copies its result
+  for (const auto& fname : m_fields_names) {
+    if (!sim_field_mgr->has_field(fname) and is_column_integral(fname)) {
+      m_column_integrals.push_back(fname);
+    }
+  }
+  if (m_column_integrals.size()<2) {
+    m_column_integrals.clear();
+  }
+
   // Create all diagnostics
   for (auto& fname : m_fields_names) {
     if (!sim_field_mgr->has_field(fname)) {
@@ -1315,11 +1580,20 @@ AtmosphereOutput::create_diagnostic (const std::string& diag_field_name) {
     diag_name = "WaterPath";
     // split will return the list [X, ''], with X being whatever is before 'WaterPath'
     params.set<std::string>("Water Kind",ekat::split(diag_field_name,"WaterPath").front());
+    if (not m_column_integrals.empty()) {
+      params.set("column_integrals",m_column_integrals);
+    }
   } else if (diag_field_name=="MeridionalVapFlux" or
              diag_field_name=="ZonalVapFlux") {
     diag_name = "VaporFlux";
     // split will return the list [X, ''], with X being whatever is before 'VapFlux'
     params.set<std::string>("Wind Component",ekat::split(diag_field_name,"VapFlux").front());
+    if (not m_column_integrals.empty()) {
+      params.set("column_integrals",m_column_integrals);
+    }
+  } else if (diag_field_name=="ColumnIntegrals") {
+    diag_name = diag_field_name;
+    params.set("integrals",m_column_integrals);
   } else {
     diag_name = diag_field_name;
   }
@@ -1332,15 +1606,28 @@ AtmosphereOutput::create_diagnostic (const std::string& diag_field_name) {
     params.set<std::string>("diag_name", diag_name);
   }
 
-  // Create the diagnostic
-  auto diag = diag_factory.create(diag_name,m_comm,params);
-  diag->set_grids(m_grids_manager);
+  // Reuse the diagnostic if another stream already created it, otherwise create it
+  const auto sim_field_mgr = get_field_manager("sim");
+  std::stringstream key;
+  key << sim_field_mgr.get() << "|" << diag_field_name << "|" << m_fill_value;
+  if (diag_name=="WaterPath" or diag_name=="VaporFlux" or diag_name=="ColumnIntegrals") {
+    // These diags depend on the set of column integrals of the stream
+    for (const auto& n : m_column_integrals) {
+      key << "|" << n;
+    }
+  }
+  auto diag = shared_diagnostics()[key.str()].lock();
+  const bool is_shared = diag!=nullptr;
+  if (not is_shared) {
+    diag = diag_factory.create(diag_name,m_comm,params);
+    diag->set_grids(m_grids_manager);
+  }
 
   // Add empty entry for this map, so .at(..) always works
   auto& deps = m_diag_depends_on_diags[diag->name()];
 
-  // Initialize the diagnostic
-  const auto sim_field_mgr = get_field_manager("sim");
+  // Initialize the diagnostic. Dependencies are retrieved even if the diag is shared,
+  // so that this stream keeps them alive and can compute them.
   for (const auto& freq : diag->get_required_field_requests()) {
     const auto& fname = freq.fid.name();
     if (!sim_field_mgr->has_field(fname)) {
@@ -1351,9 +1638,14 @@ AtmosphereOutput::create_diagnostic (const std::string& diag_field_name) {
       auto dep = m_diagnostics.at(fname);
       deps.push_back(fname);
     }
-    diag->set_required_field (get_field(fname,"sim"));
+    if (not is_shared) {
+      diag->set_required_field (get_field(fname,"sim"));
+    }
+  }
+  if (not is_shared) {
+    diag->initialize(util::TimeStamp(),RunType::Initial);
+    shared_diagnostics()[key.str()] = diag;
   }
-  diag->initialize(util::TimeStamp(),RunType::Initial);
   // If specified, set avg_cnt tracking for this diagnostic.
   if (m_add_time_dim && m_track_avg_cnt) {
     const auto diag_field = diag->get_diagnostic();
@@ -150,11 +150,52 @@ public:
     return m_io_grid;
   }
 
+  const std::vector<std::string>& get_fields_names () const {
+    return m_fields_names;
+  }
+
   // Option to add a logger
   void set_logger(const std::shared_ptr<ekat::logger::LoggerBase>& atm_logger) {
       m_atm_logger = atm_logger;
   }
 
+  // In async mode, run does not write the fields at write steps, but copies them into
+  // host staging buffers. The writes are then obtained with staged_writes, which the
+  // caller can run on the async write thread (see scorpio::write_async).
+  void set_async_write (const bool async_write) {
+    m_async_write = async_write;
+  }
+
+  // Returns the writes staged by the last write step, and clears them. The staging
+  // buffers alternate between write steps, so the writes of one step can still be
+  // running while the next one is staged.
+  std::function<void()> staged_writes ();
+
+  // Snapshot buffering: rather than writing the fields at each output step, run copies
+  // them into host buffers holding up to nsnaps snapshots, together with the time index
+  // of the snapshot. The writes of all buffered snapshots are then obtained at once with
+  // buffered_writes, which the caller must do when the buffers are full, and before the
+  // output file is flushed or closed.
+  void set_snapshot_buffering (const int nsnaps);
+  int num_buffered_snapshots () const { return m_num_buffered; }
+  bool snapshot_buffers_full () const {
+    return m_snapshot_buffer_size>1 and m_num_buffered==m_snapshot_buffer_size;
+  }
+
+  // Returns the writes of all buffered snapshots, grouped by variable, and empties the
+  // buffers. The buffers are not refilled until any async write is complete.
+  std::function<void()> buffered_writes ();
+
+  // Skip the fields whose time stamp did not change since they were last written (e.g.,
+  // time-invariant fields in model restart files). setup_output_file does not register
+  // them in the new file, and skipped_fields maps each of them to the file containing it.
+  void set_skip_unchanged_fields (const bool skip) {
+    m_skip_unchanged_fields = skip;
+  }
+  const std::map<std::string,std::string>& skipped_fields () const {
+    return m_skipped_fields;
+  }
+
 protected:
   // Internal functions
   void set_grid (const std::shared_ptr<const AbstractGrid>& grid);
@@ -168,6 +209,7 @@ protected:
   void set_degrees_of_freedom(const std::string& filename);
   std::vector<scorpio::offset_t> get_var_dof_offsets (const FieldLayout& layout);
   void register_views();
+  void setup_batched_accumulation();
   Field get_field(const std::string& name, const std::string& mode) const;
   void compute_diagnostic (const std::string& name, const bool allow_invalid_fields = false);
   void set_diagnostics();
@@ -203,6 +245,8 @@ protected:
   std::map<std::string,std::pair<int,bool>>             m_dims;
   std::map<std::string,std::shared_ptr<atm_diag_type>>  m_diagnostics;
   std::map<std::string,std::vector<std::string>>        m_diag_depends_on_diags;
+  // Column integral diags of this stream, computed together by the ColumnIntegrals diag
+  std::vector<std::string>                              m_column_integrals;
   std::map<std::string,bool>                            m_diag_computed;
 
   // Use float, so that if output fp_precision=float, this is a representable value.
@@ -221,6 +265,50 @@ protected:
   bool m_add_time_dim;
   bool m_track_avg_cnt = false;
 
+  // Batched accumulation: the non-aliased fields with the same layout and allocation
+  // are combined into their running tallies by one kernel, which gets the data
+  // pointers of the field, the tally and the avg count of each field in the batch.
+  struct BatchEntry {
+    const Real*   src;
+    Real*         avg;
+    Real*         avg_cnt;
+  };
+  struct AccumBatch {
+    int                         size;
+    int                         last_dim;
+    int                         alloc_last_dim;
+    KT::view_1d<BatchEntry>     entries;
+  };
+  std::vector<AccumBatch>   m_accum_batches;
+  std::set<std::string>     m_batched_fields;
+
+  // Async write: the two sets of host staging buffers, the set used at the last
+  // write step, and the writes staged at that step
+  struct StagedWrite {
+    std::string   filename;
+    std::string   varname;
+    const Real*   data;
+    int           size;
+    int           time_index = -1;
+  };
+  bool                                  m_async_write = false;
+  std::map<std::string,view_1d_host>    m_staging_views_1d[2];
+  int                                   m_staging_idx = 0;
+  std::vector<StagedWrite>              m_staged_writes;
+
+  // Snapshot buffering: the buffers of each variable (m_snapshot_buffer_size snapshots),
+  // the number of snapshots currently buffered, and the writes of these snapshots
+  int                                   m_snapshot_buffer_size = 1;
+  int                                   m_num_buffered = 0;
+  std::map<std::string,view_1d_host>    m_snapshot_buffers;
+  std::vector<StagedWrite>              m_buffered_writes;
+
+  // Skipping unchanged fields: the time stamp of each field when it was last written,
+  // together with the file, and the fields skipped in the current file
+  bool                                                          m_skip_unchanged_fields = false;
+  std::map<std::string,std::pair<util::TimeStamp,std::string>>  m_last_written;
+  std::map<std::string,std::string>                             m_skipped_fields;
+
   // The logger to be used throughout the ATM to log message
   std::shared_ptr<ekat::logger::LoggerBase> m_atm_logger;
 };
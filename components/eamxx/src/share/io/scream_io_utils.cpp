@@ -1,7 +1,10 @@
 #include "share/io/scream_io_utils.hpp"
+#include "share/grid/abstract_grid.hpp"
+#include "share/util/scream_bfbhash.hpp"
 #include "share/util/scream_utils.hpp"
 
 #include <fstream>
+#include <sstream>
 
 namespace scream {
 
@@ -70,4 +73,33 @@ std::string find_filename_in_rpointer (
   return filename;
 }
 
+std::string get_grid_dofs_key (const AbstractGrid& grid)
+{
+  using namespace bfbhash;
+
+  // The decomposition depends on which rank holds each dof, and in which order,
+  // so mix each gid with its (rank,lid) position before accumulating it.
+  auto mix = [](HashType x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  };
+
+  const auto& comm = grid.get_comm();
+  const auto gids_h = grid.get_dofs_gids().get_view<const AbstractGrid::gid_type*,Host>();
+  const HashType rank = comm.rank();
+  HashType local = 0;
+  for (int i=0; i<grid.get_num_local_dofs(); ++i) {
+    const HashType pos = mix((rank << 32) + i);
+    hash(mix(pos ^ static_cast<HashType>(gids_h(i))), local);
+  }
+  HashType global = 0;
+  all_reduce_HashType(comm.mpi_comm(),&local,&global,1);
+
+  std::stringstream ss;
+  ss << grid.get_num_global_dofs() << "-" << std::hex << global;
+  return ss.str();
+}
+
 } // namespace scream
@@ -54,7 +54,7 @@ struct IOControl {
     return frequency_units!="none" && frequency_units!="never";
   }
 
-  bool is_write_step (const util::TimeStamp& ts) {
+  bool is_write_step (const util::TimeStamp& ts) const {
     // Mini-routine to determine if it is time to write output to file.
     // The current allowable options are nsteps, nsecs, nmins, nhours, ndays, nmonths, nyears
     // We query the frequency_units string value to determine which option it is.
@@ -137,5 +137,14 @@ std::string find_filename_in_rpointer (
     const ekat::Comm& comm,
     const util::TimeStamp& run_t0);
 
+class AbstractGrid;
+
+// Returns a string that identifies the partition of the grid dofs across ranks.
+// IO classes use it in the PIO decomposition tags, so that decompositions are
+// reused across files and across grid objects with the same dofs (e.g., clones
+// of the physics grid created by SPA, nudging, or prescribed surface data).
+// NOTE: this is a collective call over the grid communicator.
+std::string get_grid_dofs_key (const AbstractGrid& grid);
+
 } // namespace scream
 #endif // SCREAM_IO_UTILS_HPP
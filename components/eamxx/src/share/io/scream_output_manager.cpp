@@ -10,9 +10,11 @@
 #include "ekat/util/ekat_string_utils.hpp"
 
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <chrono>
 #include <ctime>
+#include <filesystem>
 
 namespace scream
 {
@@ -85,6 +87,45 @@ setup (const ekat::Comm& io_comm, const ekat::ParameterList& params,
   m_output_file_specs.filename_with_mpiranks = out_control_pl.get("MPI Ranks in Filename",false);
   m_output_file_specs.save_grid_data         = out_control_pl.get("save_grid_data",!m_is_model_restart_output);
 
+  // Async write: the writes of a write step run on a background thread, while the
+  // model continues. This requires MPI_THREAD_MULTIPLE, since PIO calls MPI from that thread.
+  // Model restarts are written asynchronously by default, when supported.
+  const bool async_write_requested = out_control_pl.isParameter("async_write");
+  m_async_write = out_control_pl.get("async_write",m_is_model_restart_output);
+  if (m_async_write and not scorpio::async_io_supported()) {
+    if (m_atm_logger and async_write_requested) {
+      m_atm_logger->warn("[EAMxx::output_manager] async_write requested for " + m_filename_prefix +
+                         ", but MPI was not initialized with MPI_THREAD_MULTIPLE. Writes will be synchronous.\n");
+    }
+    m_async_write = false;
+  }
+
+  // Snapshot buffering: the output streams keep this many snapshots in host memory, and
+  // write them to file together. Model restart files have a single snapshot.
+  m_snapshot_buffer_size = m_is_model_restart_output ? 1 : out_control_pl.get("buffered_snapshots",1);
+  EKAT_REQUIRE_MSG (m_snapshot_buffer_size>=1,
+      "Error! Invalid value for 'buffered_snapshots' in output stream " + m_filename_prefix + ".\n"
+      "  - buffered_snapshots: " + std::to_string(m_snapshot_buffer_size) + "\n"
+      "  - must be at least 1\n");
+
+  // Model restart files can be written to a staging directory (e.g., a burst buffer), and
+  // can skip the fields that did not change since the previous restart file was written
+  if (m_is_model_restart_output) {
+    m_staging_directory = out_control_pl.get<std::string>("staging_directory","");
+    m_skip_unchanged_fields = out_control_pl.get("skip_unchanged_fields",false);
+    if (m_staging_directory!="") {
+      if (m_io_comm.am_i_root()) {
+        std::error_code ec;
+        std::filesystem::create_directories(m_staging_directory,ec);
+        EKAT_REQUIRE_MSG (not ec,
+            "Error! Could not create the staging directory for model restart files.\n"
+            "  - staging_directory: " + m_staging_directory + "\n"
+            "  - error: " + ec.message() + "\n");
+      }
+      m_io_comm.barrier();
+    }
+  }
+
   // Here, store if PG2 fields will be present in output streams.
   // Will be useful if multiple grids are defined (see below).
   bool pg2_grid_in_io_streams = false;
@@ -97,6 +138,9 @@ setup (const ekat::Comm& io_comm, const ekat::ParameterList& params,
   if (field_mgrs.size()==1) {
     auto output = std::make_shared<output_type>(m_io_comm,m_params,field_mgrs.begin()->second,grids_mgr);
     output->set_logger(m_atm_logger);
+    output->set_async_write(m_async_write);
+    output->set_snapshot_buffering(m_snapshot_buffer_size);
+    output->set_skip_unchanged_fields(m_skip_unchanged_fields);
     m_output_streams.push_back(output);
   } else {
     for (auto it=fields_pl.sublists_names_cbegin(); it!=fields_pl.sublists_names_cend(); ++it) {
@@ -130,6 +174,9 @@ setup (const ekat::Comm& io_comm, const ekat::ParameterList& params,
 
       auto output = std::make_shared<output_type>(m_io_comm,m_params,field_mgrs.at(gname),grids_mgr);
       output->set_logger(m_atm_logger);
+      output->set_async_write(m_async_write);
+      output->set_snapshot_buffering(m_snapshot_buffer_size);
+      output->set_skip_unchanged_fields(m_skip_unchanged_fields);
       m_output_streams.push_back(output);
     }
   }
@@ -366,7 +413,7 @@ void OutputManager::run(const util::TimeStamp& timestamp)
   // Create and setup output/checkpoint file(s), if necessary
   start_timer(timer_root+"::get_new_file");
   auto setup_output_file = [&](IOControl& control, IOFileSpecs& filespecs,
-                               bool add_to_rpointer, const std::string& file_type) {
+                               const std::string& file_type) {
     // Check if we need to open a new file
     if (not filespecs.is_open) {
       // If this is normal output, with some sort of average, then the timestamp should be
@@ -376,34 +423,13 @@ void OutputManager::run(const util::TimeStamp& timestamp)
                    ? timestamp : control.timestamp_of_last_write;
 
       filespecs.filename = compute_filename (control,filespecs,file_ts);
+      if (m_staging_directory!="") {
+        filespecs.filename = m_staging_directory + "/" + filespecs.filename;
+      }
       // Register all dims/vars, write geometry data (e.g. lat/lon/hyam/hybm)
       setup_file(filespecs,control);
     }
 
-    // If we are going to write an output checkpoint file, or a model restart file,
-    // we need to append to the filename ".rhist" or ".r" respectively, and add
-    // the filename to the rpointer.atm file.
-    if (add_to_rpointer && m_io_comm.am_i_root()) {
-      std::ofstream rpointer;
-      if (m_is_model_restart_output) {
-        rpointer.open("rpointer.atm");  // Open rpointer and nuke its content
-      } else if (is_checkpoint_step) {
-        // Output restart unit tests do not have a model-output stream that generates rpointer.atm,
-        // so allow to skip the next check for them.
-        auto is_unit_testing = m_params.sublist("Checkpoint Control").get("is_unit_testing",false);
-        EKAT_REQUIRE_MSG (is_unit_testing || std::ifstream("rpointer.atm").good(),
-            "Error! Cannot find rpointer.atm file to append history restart file in.\n"
-            " Model restart output is supposed to be in charge of creating rpointer.atm.\n"
-            " There are two possible causes:\n"
-            "   1. You have a 'Checkpoint Control' list in your output stream, but no Scorpio::model_restart\n"
-            "      section in the input yaml file. This makes no sense, please correct.\n"
-            "   2. The current implementation assumes that the model restart OutputManager runs\n"
-            "      *before* any other output stream (so it can nuke rpointer.atm if already existing).\n"
-            "      If this has changed, we need to revisit this piece of the code.\n");
-        rpointer.open("rpointer.atm",std::ofstream::app);  // Open rpointer file and append to it
-      }
-      rpointer << filespecs.filename << std::endl;
-    }
 
     if (m_atm_logger) {
       m_atm_logger->info("[EAMxx::output_manager] - Writing " + file_type + ":");
@@ -412,13 +438,13 @@ void OutputManager::run(const util::TimeStamp& timestamp)
   };
 
   if (is_output_step) {
-    setup_output_file(m_output_control,m_output_file_specs,m_is_model_restart_output,m_is_model_restart_output ? "model restart" : "model output");
+    setup_output_file(m_output_control,m_output_file_specs,m_is_model_restart_output ? "model restart" : "model output");
 
     // Update time (must be done _before_ writing fields)
     pio_update_time(m_output_file_specs.filename,timestamp.days_from(m_case_t0));
   }
   if (is_checkpoint_step) {
-    setup_output_file(m_checkpoint_control,m_checkpoint_file_specs,true,"history restart");
+    setup_output_file(m_checkpoint_control,m_checkpoint_file_specs,"history restart");
 
     if (is_full_checkpoint_step) {
       // Update time (must be done _before_ writing fields)
@@ -451,56 +477,162 @@ void OutputManager::run(const util::TimeStamp& timestamp)
       }
     }
 
-    auto write_global_data = [&](IOControl& control, IOFileSpecs& filespecs) {
-      if (m_atm_logger) {
-        m_atm_logger->debug("[OutputManager]: writing globals...\n");
+    // The writes of this step. In async mode they run on the async write thread after
+    // this function returns, so they must only capture copies of this manager's data.
+    std::vector<std::function<void()>> writes;
+    if (m_async_write) {
+      for (auto& it : m_output_streams) {
+        writes.push_back(it->staged_writes());
       }
-      if (m_is_model_restart_output) {
-        // Only write nsteps on model restart
-        set_attribute(filespecs.filename,"nsteps",timestamp.get_num_steps());
-      } else {
-        if (filespecs.hist_restart_file) {
-          // Update the date of last write and sample size
-          scorpio::write_timestamp (filespecs.filename,"last_write",m_output_control.timestamp_of_last_write);
-          scorpio::set_attribute (filespecs.filename,"last_output_filename",m_output_file_specs.filename);
-          scorpio::set_attribute (filespecs.filename,"num_snapshots_since_last_write",m_output_control.nsamples_since_last_write);
+    }
+
+    // Write the buffered snapshots when the buffers are full, and before the output file
+    // is flushed or closed, or a history restart file records the state of the output
+    if (m_snapshot_buffer_size>1) {
+      const auto& specs = m_output_file_specs;
+      const int nsnaps = specs.num_snapshots_in_file + (is_output_step ? 1 : 0);
+      const bool file_done = nsnaps>=specs.max_snapshots_in_file or
+                             (specs.flush_frequency>0 and nsnaps%specs.flush_frequency==0);
+      for (auto& it : m_output_streams) {
+        if (it->num_buffered_snapshots()>0 and
+            (it->snapshot_buffers_full() or file_done or is_checkpoint_step)) {
+          writes.push_back(it->buffered_writes());
         }
-        // Write these in both output and rhist file. The former, b/c we need these info when we postprocess
-        // output, and the latter b/c we want to make sure these params don't change across restarts
-        set_attribute(filespecs.filename,"averaging_type",e2str(m_avg_type));
-        set_attribute(filespecs.filename,"averaging_frequency_units",m_output_control.frequency_units);
-        set_attribute(filespecs.filename,"averaging_frequency",m_output_control.frequency);
-        set_attribute(filespecs.filename,"max_snapshots_per_file",m_output_file_specs.max_snapshots_in_file);
-        const auto& fp_precision = m_params.get<std::string>("Floating Point Precision");
-        set_attribute(filespecs.filename,"fp_precision",fp_precision);
       }
+    }
 
-      // Write all stored globals
-      for (const auto& it : m_globals) {
-        const auto& name = it.first;
-        const auto& any = it.second;
-        set_any_attribute(filespecs.filename,name,any);
+    auto write_global_data = [&](IOControl& control, IOFileSpecs& filespecs, bool add_to_rpointer) {
+      if (m_atm_logger) {
+        m_atm_logger->debug("[OutputManager]: writing globals...\n");
+      }
+      const auto filename = filespecs.filename;
+      const auto is_model_restart_output = m_is_model_restart_output;
+      const auto hist_restart_file = filespecs.hist_restart_file;
+      const auto nsteps = timestamp.get_num_steps();
+      const auto last_write = m_output_control.timestamp_of_last_write;
+      const auto last_output_filename = m_output_file_specs.filename;
+      const auto nsamples = m_output_control.nsamples_since_last_write;
+      const auto avg_type = e2str(m_avg_type);
+      const auto freq_units = m_output_control.frequency_units;
+      const auto freq = m_output_control.frequency;
+      const auto max_snapshots = m_output_file_specs.max_snapshots_in_file;
+      const auto fp_precision = m_is_model_restart_output ? std::string("")
+                              : m_params.get<std::string>("Floating Point Precision");
+      const auto globals = m_globals;
+      const auto time_bnds = m_time_bnds;
+      const auto am_root = m_io_comm.am_i_root();
+      const auto drained = drained_filename(filename);
+      // Output restart unit tests do not have a model-output stream that generates rpointer.atm,
+      // so allow to skip the check on its existence for them.
+      const auto is_unit_testing = m_params.isSublist("Checkpoint Control") and
+                                   m_params.sublist("Checkpoint Control").get("is_unit_testing",false);
+
+      // The fields not written in this model restart file, and the files containing them
+      std::string skipped_fields, skipped_fields_files;
+      for (const auto& os : m_output_streams) {
+        for (const auto& it : os->skipped_fields()) {
+          skipped_fields += (skipped_fields.empty() ? "" : ",") + it.first;
+          skipped_fields_files += (skipped_fields_files.empty() ? "" : ",") + drained_filename(it.second);
+        }
       }
 
       // We're adding one snapshot to the file
       ++filespecs.num_snapshots_in_file;
 
-      if (m_time_bnds.size()>0) {
-        scorpio::grid_write_data_array(filespecs.filename, "time_bnds", m_time_bnds.data(), 2);
-      }
-
       // Since we wrote to file we need to reset the nsamples_since_last_write, the timestamp ...
       control.nsamples_since_last_write = 0;
       control.timestamp_of_last_write = timestamp;
 
       // Check if we need to close the output file
-      if (filespecs.file_is_full()) {
-        eam_pio_closefile(filespecs.filename);
+      const bool close_file = filespecs.file_is_full();
+      const bool flush_file = not close_file and filespecs.file_needs_flush();
+      if (close_file) {
         filespecs.num_snapshots_in_file = 0;
         filespecs.is_open = false;
-      } else if (filespecs.file_needs_flush()) {
-        eam_flush_file (filespecs.filename);
       }
+
+      writes.push_back([=]() {
+        if (is_model_restart_output) {
+          // Only write nsteps on model restart
+          set_attribute(filename,"nsteps",nsteps);
+          if (not skipped_fields.empty()) {
+            set_attribute(filename,"fields_in_previous_restarts",skipped_fields);
+            set_attribute(filename,"previous_restart_files",skipped_fields_files);
+          }
+        } else {
+          if (hist_restart_file) {
+            // Update the date of last write and sample size
+            scorpio::write_timestamp (filename,"last_write",last_write);
+            scorpio::set_attribute (filename,"last_output_filename",last_output_filename);
+            scorpio::set_attribute (filename,"num_snapshots_since_last_write",nsamples);
+          }
+          // Write these in both output and rhist file. The former, b/c we need these info when we postprocess
+          // output, and the latter b/c we want to make sure these params don't change across restarts
+          set_attribute(filename,"averaging_type",avg_type);
+          set_attribute(filename,"averaging_frequency_units",freq_units);
+          set_attribute(filename,"averaging_frequency",freq);
+          set_attribute(filename,"max_snapshots_per_file",max_snapshots);
+          set_attribute(filename,"fp_precision",fp_precision);
+        }
+
+        // Write all stored globals
+        for (const auto& it : globals) {
+          const auto& name = it.first;
+          const auto& any = it.second;
+          set_any_attribute(filename,name,any);
+        }
+
+        if (time_bnds.size()>0) {
+          scorpio::grid_write_data_array(filename, "time_bnds", time_bnds.data(), 2);
+        }
+
+        if (close_file) {
+          eam_pio_closefile(filename);
+
+          // Move the file out of the staging directory. With async writes, this
+          // happens on the async write thread, while the model continues.
+          if (am_root and drained!=filename) {
+            std::error_code ec;
+            std::filesystem::rename(filename,drained,ec);
+            if (ec) {
+              // Likely a different file system: copy, then remove
+              ec.clear();
+              std::filesystem::copy_file(filename,drained,std::filesystem::copy_options::overwrite_existing,ec);
+              EKAT_REQUIRE_MSG (not ec,
+                  "Error! Could not move model restart file out of the staging directory.\n"
+                  "  - staged file: " + filename + "\n"
+                  "  - destination: " + drained + "\n"
+                  "  - error: " + ec.message() + "\n");
+              std::filesystem::remove(filename,ec);
+            }
+          }
+        } else if (flush_file) {
+          eam_flush_file (filename);
+        }
+
+        // A model restart file, or a history restart file, is added to the rpointer.atm file only
+        // once it is complete and in its final location. With async writes, this happens on the
+        // async write thread, which runs the writes of all output managers in the order they were
+        // issued, so the model restart still creates rpointer.atm before the history restarts.
+        if (add_to_rpointer and am_root) {
+          std::ofstream rpointer;
+          if (is_model_restart_output) {
+            rpointer.open("rpointer.atm");  // Open rpointer and nuke its content
+          } else {
+            EKAT_REQUIRE_MSG (is_unit_testing || std::ifstream("rpointer.atm").good(),
+                "Error! Cannot find rpointer.atm file to append history restart file in.\n"
+                " Model restart output is supposed to be in charge of creating rpointer.atm.\n"
+                " There are two possible causes:\n"
+                "   1. You have a 'Checkpoint Control' list in your output stream, but no Scorpio::model_restart\n"
+                "      section in the input yaml file. This makes no sense, please correct.\n"
+                "   2. The current implementation assumes that the model restart OutputManager runs\n"
+                "      *before* any other output stream (so it can nuke rpointer.atm if already existing).\n"
+                "      If this has changed, we need to revisit this piece of the code.\n");
+            rpointer.open("rpointer.atm",std::ofstream::app);  // Open rpointer file and append to it
+          }
+          rpointer << drained << std::endl;
+        }
+      });
     };
 
     start_timer(timer_root+"::update_snapshot_tally");
@@ -508,10 +640,21 @@ void OutputManager::run(const util::TimeStamp& timestamp)
     // That's b/c write_global_data will update m_output_control.timestamp_of_last_write,
     // which is later written as global data in the hist restart file
     if (is_output_step) {
-      write_global_data(m_output_control,m_output_file_specs);
+      write_global_data(m_output_control,m_output_file_specs,m_is_model_restart_output);
     }
     if (is_checkpoint_step) {
-      write_global_data(m_checkpoint_control,m_checkpoint_file_specs);
+      write_global_data(m_checkpoint_control,m_checkpoint_file_specs,true);
+    }
+
+    auto run_writes = [writes]() {
+      for (const auto& w : writes) {
+        w();
+      }
+    };
+    if (m_async_write) {
+      scorpio::write_async(run_writes);
+    } else {
+      run_writes();
     }
     stop_timer(timer_root+"::update_snapshot_tally");
     if (is_output_step && m_time_bnds.size()>0) {
@@ -524,6 +667,14 @@ void OutputManager::run(const util::TimeStamp& timestamp)
 /*===============================================================================================*/
 void OutputManager::finalize()
 {
+  // Write any buffered snapshot, then complete any async write still running
+  for (auto& it : m_output_streams) {
+    if (it->num_buffered_snapshots()>0) {
+      it->buffered_writes()();
+    }
+  }
+  scorpio::wait_for_async_io();
+
   // Close any output file still open
   if (m_output_file_specs.is_open) {
     scorpio::eam_pio_closefile (m_output_file_specs.filename);
@@ -537,6 +688,31 @@ void OutputManager::finalize()
   std::swap(*this,other);
 }
 
+/*===============================================================================================*/
+bool OutputManager::
+writes_any_field (const util::TimeStamp& timestamp, const std::set<std::string>& names) const
+{
+  if (m_output_disabled) {
+    return false;
+  }
+
+  // Same logic as in run, where is_output_step or is_checkpoint_step trigger a write
+  const bool is_t0_output = timestamp==m_case_t0;
+  if (not m_output_control.is_write_step(timestamp) and not is_t0_output and
+      not m_checkpoint_control.is_write_step(timestamp)) {
+    return false;
+  }
+
+  for (const auto& os : m_output_streams) {
+    for (const auto& name : os->get_fields_names()) {
+      if (names.count(name)==1) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 long long OutputManager::res_dep_memory_footprint () const {
   long long mf = 0;
   for (const auto& os : m_output_streams) {
@@ -546,6 +722,16 @@ long long OutputManager::res_dep_memory_footprint () const {
   return mf;
 }
 
+std::string OutputManager::
+drained_filename (const std::string& filename) const
+{
+  if (m_staging_directory=="") {
+    return filename;
+  }
+  const auto prefix = m_staging_directory + "/";
+  return filename.compare(0,prefix.size(),prefix)==0 ? filename.substr(prefix.size()) : filename;
+}
+
 std::string OutputManager::
 compute_filename (const IOControl& control,
                   const IOFileSpecs& file_specs,
@@ -14,6 +14,8 @@
 #include "ekat/ekat_parameter_list.hpp"
 #include "ekat/ekat_parse_yaml_file.hpp"
 
+#include <set>
+
 namespace scream
 {
 
@@ -113,6 +115,9 @@ public:
   void run (const util::TimeStamp& current_ts);
   void finalize();
 
+  // Whether run(ts) will write (as output or checkpoint) any of the given fields
+  bool writes_any_field (const util::TimeStamp& ts, const std::set<std::string>& names) const;
+
   long long res_dep_memory_footprint () const;
 protected:
 
@@ -120,6 +125,9 @@ protected:
                                 const IOFileSpecs& file_specs,
                                 const util::TimeStamp& timestamp) const;
 
+  // The name of a file once moved out of the staging directory (if any)
+  std::string drained_filename (const std::string& filename) const;
+
   void set_file_header(const IOFileSpecs& file_specs);
 
   // Craft the restart parameter list
@@ -174,6 +182,21 @@ protected:
   // If the user specifies freq units "none" or "never", output is disabled
   bool m_output_disabled = false;
 
+  // Whether the writes of a write step run on the async write thread (see scorpio::write_async)
+  bool m_async_write = false;
+
+  // Number of output snapshots buffered in host memory by the output streams before
+  // they are written to file (1 means no buffering)
+  int m_snapshot_buffer_size = 1;
+
+  // Model restart only: if not empty, files are written in this directory (e.g., a
+  // node-local burst buffer), and moved to the run directory once closed
+  std::string m_staging_directory;
+
+  // Model restart only: fields that did not change since the previous restart file
+  // are not written again, and the file records where to read them from
+  bool m_skip_unchanged_fields = false;
+
   // The initial time stamp of the simulation and run. For initial runs, they coincide,
   // but for restarted runs, run_t0>case_t0, with the former being the time at which the
   // restart happens, and the latter being the start time of the *original* run.
@@ -7,6 +7,8 @@
 
 #include <pio.h>
 
+#include <algorithm>
+#include <future>
 #include <string>
 
 
@@ -23,9 +25,9 @@ extern "C" {
   void grid_read_data_array_c2f_float(const char*&& filename, const char*&& varname, const Int time_index, float *buf, const int buf_size);
   void grid_read_data_array_c2f_double(const char*&& filename, const char*&& varname, const Int time_index, double *buf, const int buf_size);
 
-  void grid_write_data_array_c2f_int(const char*&& filename, const char*&& varname, const int* buf, const int buf_size);
-  void grid_write_data_array_c2f_float(const char*&& filename, const char*&& varname, const float* buf, const int buf_size);
-  void grid_write_data_array_c2f_double(const char*&& filename, const char*&& varname, const double* buf, const int buf_size);
+  void grid_write_data_array_c2f_int(const char*&& filename, const char*&& varname, const Int time_index, const int* buf, const int buf_size);
+  void grid_write_data_array_c2f_float(const char*&& filename, const char*&& varname, const Int time_index, const float* buf, const int buf_size);
+  void grid_write_data_array_c2f_double(const char*&& filename, const char*&& varname, const Int time_index, const double* buf, const int buf_size);
   void eam_init_pio_subsystem_c2f(const int mpicom, const int atm_id);
   void eam_pio_finalize_c2f();
   void eam_pio_closefile_c2f(const char*&& filename);
@@ -76,12 +78,48 @@ std::string nctype2str (const int type) {
   return "UNKNOWN";
 }
 /* ----------------------------------------------------------------- */
+namespace {
+// The I/O running on the async thread, if any, and whether the
+// calling thread is the async thread, which must not wait for itself
+std::future<void> s_async_io;
+thread_local bool t_is_async_thread = false;
+}
+
+bool async_io_supported () {
+  int provided;
+  MPI_Query_thread(&provided);
+  return provided==MPI_THREAD_MULTIPLE;
+}
+/* ----------------------------------------------------------------- */
+void write_async (const std::function<void()>& writes) {
+  wait_for_async_io();
+  s_async_io = std::async(std::launch::async,[writes]() {
+    t_is_async_thread = true;
+    writes();
+  });
+}
+/* ----------------------------------------------------------------- */
+void read_async (const std::function<void()>& reads) {
+  // Reads and writes share the same thread, so they run in the order they are issued
+  write_async(reads);
+}
+/* ----------------------------------------------------------------- */
+void wait_for_async_io () {
+  if (t_is_async_thread or not s_async_io.valid()) {
+    return;
+  }
+  // If the async I/O threw, get() rethrows the exception on this thread
+  s_async_io.get();
+}
+/* ----------------------------------------------------------------- */
 void eam_init_pio_subsystem(const ekat::Comm& comm) {
+  wait_for_async_io();
   MPI_Fint fcomm = MPI_Comm_c2f(comm.mpi_comm());
   eam_init_pio_subsystem(fcomm);
 }
 
 void eam_init_pio_subsystem(const int mpicom, const int atm_id) {
+  wait_for_async_io();
   // TODO: Right now the compid has been hardcoded to 0 and the flag
   // to create a init a subsystem in SCREAM is hardcoded to true.
   // When surface coupling is established we will need to refactor this
@@ -91,28 +129,34 @@ void eam_init_pio_subsystem(const int mpicom, const int atm_id) {
 }
 /* ----------------------------------------------------------------- */
 void eam_pio_finalize() {
+  wait_for_async_io();
   eam_pio_finalize_c2f();
 }
 /* ----------------------------------------------------------------- */
 void register_file(const std::string& filename, const FileMode mode) {
+  wait_for_async_io();
   register_file_c2f(filename.c_str(),mode);
 }
 /* ----------------------------------------------------------------- */
 void eam_pio_closefile(const std::string& filename) {
+  wait_for_async_io();
 
   eam_pio_closefile_c2f(filename.c_str());
 }
 void eam_flush_file(const std::string& filename) {
+  wait_for_async_io();
   eam_pio_flush_file_c2f(filename.c_str());
 }
 /* ----------------------------------------------------------------- */
 void set_decomp(const std::string& filename) {
+  wait_for_async_io();
 
   set_decomp_c2f(filename.c_str());
 }
 /* ----------------------------------------------------------------- */
 int get_dimlen(const std::string& filename, const std::string& dimname)
 {
+  wait_for_async_io();
   int ncid, dimid, err;
   PIO_Offset len;
 
@@ -150,6 +194,7 @@ int get_dimlen(const std::string& filename, const std::string& dimname)
 /* ----------------------------------------------------------------- */
 bool has_dim (const std::string& filename, const std::string& dimname)
 {
+  wait_for_async_io();
   int ncid, dimid, err;
 
   bool was_open = is_file_open_c2f(filename.c_str(),-1);
@@ -177,6 +222,7 @@ bool has_dim (const std::string& filename, const std::string& dimname)
 /* ----------------------------------------------------------------- */
 bool has_variable (const std::string& filename, const std::string& varname)
 {
+  wait_for_async_io();
   int ncid, varid, err;
 
   bool was_open = is_file_open_c2f(filename.c_str(),-1);
@@ -202,17 +248,29 @@ bool has_variable (const std::string& filename, const std::string& varname)
 }
 /* ----------------------------------------------------------------- */
 void set_dof(const std::string& filename, const std::string& varname, const Int dof_len, const std::int64_t* x_dof) {
+  wait_for_async_io();
 
   set_dof_c2f(filename.c_str(),varname.c_str(),dof_len,x_dof);
 }
 /* ----------------------------------------------------------------- */
 void pio_update_time(const std::string& filename, const double time) {
+  wait_for_async_io();
 
   pio_update_time_c2f(filename.c_str(),time);
 }
 /* ----------------------------------------------------------------- */
+int get_curr_time_index(const std::string& filename) {
+  wait_for_async_io();
+
+  const int nrecs = get_num_records_c2f(filename.c_str());
+  EKAT_REQUIRE_MSG (nrecs>=0,
+      "Error! Could not find file '" + filename + "' among the open files.\n");
+  return std::max(nrecs,1)-1;
+}
+/* ----------------------------------------------------------------- */
 void register_dimension(const std::string &filename, const std::string& shortname, const std::string& longname, const int length, const bool partitioned)
 {
+  wait_for_async_io();
   int mode = get_file_mode_c2f(filename.c_str());
   std::string mode_str = mode==Read ? "Read" : (mode==Write ? "Write" : "Append");
   if (mode!=Write) {
@@ -262,6 +320,7 @@ void register_variable(const std::string& filename, const std::string& shortname
                        const std::vector<std::string>& var_dimensions,
                        const std::string& dtype, const std::string& pio_decomp_tag)
 {
+  wait_for_async_io();
   // This overload does not require to specify an nc data type, so it *MUST* be used when the
   // file access mode is either Read or Append. Either way, a) the var should be on file already,
   // and b) so should be the dimensions
@@ -281,6 +340,7 @@ void register_variable(const std::string &filename, const std::string& shortname
                        const std::string& units_in, const std::vector<std::string>& var_dimensions,
                        const std::string& dtype, const std::string& nc_dtype_in, const std::string& pio_decomp_tag)
 {
+  wait_for_async_io();
   // Local copies, since we can modify them in case of defaults
   auto units = units_in;
   auto nc_dtype = nc_dtype_in;
@@ -427,26 +487,32 @@ void register_variable(const std::string &filename, const std::string& shortname
 }
 /* ----------------------------------------------------------------- */
 void set_variable_metadata (const std::string& filename, const std::string& varname, const std::string& meta_name, const float meta_val) {
+  wait_for_async_io();
   set_variable_metadata_float_c2f(filename.c_str(),varname.c_str(),meta_name.c_str(),meta_val);
 }
 /* ----------------------------------------------------------------- */
 void set_variable_metadata (const std::string& filename, const std::string& varname, const std::string& meta_name, const double meta_val) {
+  wait_for_async_io();
   set_variable_metadata_double_c2f(filename.c_str(),varname.c_str(),meta_name.c_str(),meta_val);
 }
 /* ----------------------------------------------------------------- */
 void set_variable_metadata (const std::string& filename, const std::string& varname, const std::string& meta_name, const std::string& meta_val) {
+  wait_for_async_io();
   set_variable_metadata_char_c2f(filename.c_str(),varname.c_str(),meta_name.c_str(),meta_val.c_str());
 }
 /* ----------------------------------------------------------------- */
 void get_variable_metadata (const std::string& filename, const std::string& varname, const std::string& meta_name, float& meta_val) {
+  wait_for_async_io();
   meta_val = get_variable_metadata_float_c2f(filename.c_str(),varname.c_str(),meta_name.c_str());
 }
 /* ----------------------------------------------------------------- */
 void get_variable_metadata (const std::string& filename, const std::string& varname, const std::string& meta_name, double& meta_val) {
+  wait_for_async_io();
   meta_val = get_variable_metadata_double_c2f(filename.c_str(),varname.c_str(),meta_name.c_str());
 }
 /* ----------------------------------------------------------------- */
 void get_variable_metadata (const std::string& filename, const std::string& varname, const std::string& meta_name, std::string& meta_val) {
+  wait_for_async_io();
   meta_val.resize(256);
   get_variable_metadata_char_c2f(filename.c_str(),varname.c_str(),meta_name.c_str(),&meta_val[0]);
 
@@ -456,12 +522,35 @@ void get_variable_metadata (const std::string& filename, const std::string& varn
   }
 }
 /* ----------------------------------------------------------------- */
+bool has_attribute (const std::string& filename, const std::string& att_name) {
+  wait_for_async_io();
+  register_file(filename,Read);
+  auto ncid = get_file_ncid_c2f (filename.c_str());
+  EKAT_REQUIRE_MSG (ncid>=0,
+      "[has_attribute] Error! Could not retrieve file ncid.\n"
+        " - filename : " + filename + "\n");
+
+  nc_type type;
+  PIO_Offset len;
+  int err = PIOc_inq_att(ncid,PIO_GLOBAL,att_name.c_str(),&type,&len);
+  EKAT_REQUIRE_MSG (err==PIO_NOERR or err==PIO_ENOTATT,
+      "[has_attribute] Error! Something went wrong while inquiring global attribute.\n"
+        " - filename : " + filename + "\n"
+        " - attribute: " + att_name + "\n"
+        " - pio error: " << err << "\n");
+
+  eam_pio_closefile(filename);
+  return err==PIO_NOERR;
+}
+/* ----------------------------------------------------------------- */
 ekat::any get_any_attribute (const std::string& filename, const std::string& att_name) {
+  wait_for_async_io();
   auto out = get_any_attribute(filename,"GLOBAL",att_name);
   return out;
 }
 /* ----------------------------------------------------------------- */
 ekat::any get_any_attribute (const std::string& filename, const std::string& var_name, const std::string& att_name) {
+  wait_for_async_io();
   register_file(filename,Read);
   auto ncid = get_file_ncid_c2f (filename.c_str());
   EKAT_REQUIRE_MSG (ncid>=0,
@@ -535,6 +624,7 @@ ekat::any get_any_attribute (const std::string& filename, const std::string& var
   return att;
 }
 void set_any_attribute (const std::string& filename, const std::string& att_name, const ekat::any& att) {
+  wait_for_async_io();
   auto ncid = get_file_ncid_c2f (filename.c_str());
   int err;
 
@@ -590,40 +680,48 @@ void set_any_attribute (const std::string& filename, const std::string& att_name
 }
 /* ----------------------------------------------------------------- */
 void eam_pio_enddef(const std::string &filename) {
+  wait_for_async_io();
   eam_pio_enddef_c2f(filename.c_str());
 }
 /* ----------------------------------------------------------------- */
 void eam_pio_redef(const std::string &filename) {
+  wait_for_async_io();
   eam_pio_redef_c2f(filename.c_str());
 }
 /* ----------------------------------------------------------------- */
 template<>
 void grid_read_data_array<int>(const std::string &filename, const std::string &varname,
                           const int time_index, int *hbuf, const int buf_size) {
+  wait_for_async_io();
   grid_read_data_array_c2f_int(filename.c_str(),varname.c_str(),time_index,hbuf,buf_size);
 }
 template<>
 void grid_read_data_array<float>(const std::string &filename, const std::string &varname,
                                 const int time_index, float *hbuf, const int buf_size) {
+  wait_for_async_io();
   grid_read_data_array_c2f_float(filename.c_str(),varname.c_str(),time_index,hbuf,buf_size);
 }
 template<>
 void grid_read_data_array<double>(const std::string &filename, const std::string &varname,
                                   const int time_index, double *hbuf, const int buf_size) {
+  wait_for_async_io();
   grid_read_data_array_c2f_double(filename.c_str(),varname.c_str(),time_index,hbuf,buf_size);
 }
 /* ----------------------------------------------------------------- */
 template<>
-void grid_write_data_array<int>(const std::string &filename, const std::string &varname, const int* hbuf, const int buf_size) {
-  grid_write_data_array_c2f_int(filename.c_str(),varname.c_str(),hbuf,buf_size);
+void grid_write_data_array<int>(const std::string &filename, const std::string &varname, const int* hbuf, const int buf_size, const int time_index) {
+  wait_for_async_io();
+  grid_write_data_array_c2f_int(filename.c_str(),varname.c_str(),time_index,hbuf,buf_size);
 }
 template<>
-void grid_write_data_array<float>(const std::string &filename, const std::string &varname, const float* hbuf, const int buf_size) {
-  grid_write_data_array_c2f_float(filename.c_str(),varname.c_str(),hbuf,buf_size);
+void grid_write_data_array<float>(const std::string &filename, const std::string &varname, const float* hbuf, const int buf_size, const int time_index) {
+  wait_for_async_io();
+  grid_write_data_array_c2f_float(filename.c_str(),varname.c_str(),time_index,hbuf,buf_size);
 }
 template<>
-void grid_write_data_array<double>(const std::string &filename, const std::string &varname, const double* hbuf, const int buf_size) {
-  grid_write_data_array_c2f_double(filename.c_str(),varname.c_str(),hbuf,buf_size);
+void grid_write_data_array<double>(const std::string &filename, const std::string &varname, const double* hbuf, const int buf_size, const int time_index) {
+  wait_for_async_io();
+  grid_write_data_array_c2f_double(filename.c_str(),varname.c_str(),time_index,hbuf,buf_size);
 }
 /* ----------------------------------------------------------------- */
 void write_timestamp (const std::string& filename, const std::string& ts_name, const util::TimeStamp& ts)
@@ -8,6 +8,7 @@
 #include "ekat/mpi/ekat_comm.hpp"
 #include "ekat/util/ekat_string_utils.hpp"
 
+#include <functional>
 #include <vector>
 
 /* C++/F90 bridge to F90 SCORPIO routines */
@@ -24,6 +25,18 @@ namespace scorpio {
     Append = 2,
     Write = 4
   };
+  /* Asynchronous I/O. The writes passed to write_async, and the reads passed to read_async, run
+   * on a background thread while the caller continues. Since scorpio calls are collective and PIO
+   * is not thread safe, every other function of this interface first waits for the pending I/O,
+   * so that all ranks call PIO in the same order and only one thread is in PIO at a time. The
+   * extern "C" queries below do not wait, and must be preceded by a call to one of the functions that do.
+   * The tasks must only use host data that is not used by the caller until they complete
+   * (see wait_for_async_io), and the caller must check async_io_supported, since the tasks
+   * call MPI from the background thread. */
+  bool async_io_supported ();
+  void write_async (const std::function<void()>& writes);
+  void read_async (const std::function<void()>& reads);
+  void wait_for_async_io ();
   /* All scorpio usage requires that the pio_subsystem is initialized. Happens only once per simulation */
   void eam_init_pio_subsystem(const ekat::Comm& comm);
   void eam_init_pio_subsystem(const int mpicom, const int atm_id = 0);
@@ -57,6 +70,7 @@ namespace scorpio {
   void get_variable_metadata (const std::string& filename, const std::string& varname, const std::string& meta_name, double& meta_val);
   void get_variable_metadata (const std::string& filename, const std::string& varname, const std::string& meta_name, std::string& meta_val);
   /* Register a variable with a file.  Called during the file setup, for an input stream. */
+  bool has_attribute (const std::string& filename, const std::string& att_name);
   ekat::any get_any_attribute (const std::string& filename, const std::string& att_name);
   ekat::any get_any_attribute (const std::string& filename, const std::string& var_name, const std::string& att_name);
   void set_any_attribute (const std::string& filename, const std::string& att_name, const ekat::any& att);
@@ -66,6 +80,8 @@ namespace scorpio {
   void eam_pio_redef(const std::string &filename);
   /* Called each timestep to update the timesnap for the last written output. */
   void pio_update_time(const std::string &filename, const double time);
+  /* Returns the zero-based time index that writes go to by default, i.e. the last record added by pio_update_time. */
+  int get_curr_time_index(const std::string &filename);
 
   // Read data for a specific variable from a specific file. To read data that
   // isn't associated with a time index, or to read data at the most recent
@@ -73,10 +89,11 @@ namespace scorpio {
   template<typename T>
   void grid_read_data_array (const std::string &filename, const std::string &varname,
                              const int time_index, T* hbuf, const int buf_size);
-  /* Write data for a specific variable to a specific file. */
+  /* Write data for a specific variable to a specific file. Time-dependent variables
+   * are written at the last time index, unless a zero-based time_index is given. */
   template<typename T>
   void grid_write_data_array(const std::string &filename, const std::string &varname,
-                             const T* hbuf, const int buf_size);
+                             const T* hbuf, const int buf_size, const int time_index = -1);
 
   template<typename T>
   T get_attribute (const std::string& filename, const std::string& att_name)
@@ -101,6 +118,8 @@ extern "C" {
   bool is_eam_pio_subsystem_inited();
   /* Checks if a file is already open, with the given mode */
   int get_file_ncid_c2f(const char*&& filename);
+  /* Number of time records of a file, or -1 if the file is not open */
+  int get_num_records_c2f(const char*&& filename);
   // If mode<0, then simply checks if file is open, regardless of mode
   bool is_file_open_c2f(const char*&& filename, const int& mode);
   /* Query a netCDF file for the time variable */
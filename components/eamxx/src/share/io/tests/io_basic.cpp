@@ -126,7 +126,8 @@ get_fm (const std::shared_ptr<const AbstractGrid>& grid,
 
 // Returns fields after initialization
 void write (const std::string& avg_type, const std::string& freq_units,
-            const int freq, const int seed, const ekat::Comm& comm)
+            const int freq, const int seed, const ekat::Comm& comm,
+            const bool async_write = false, const int buffered_snapshots = 1)
 {
   // Create grid
   auto gm = get_gm(comm);
@@ -154,6 +155,8 @@ void write (const std::string& avg_type, const std::string& freq_units,
   ctrl_pl.set("Frequency",freq);
   ctrl_pl.set("MPI Ranks in Filename",true);
   ctrl_pl.set("save_grid_data",false);
+  ctrl_pl.set("async_write",async_write);
+  ctrl_pl.set("buffered_snapshots",buffered_snapshots);
 
   // Create Output manager
   OutputManager om;
@@ -311,4 +314,48 @@ TEST_CASE ("io_basic") {
   scorpio::eam_pio_finalize();
 }
 
+TEST_CASE ("io_basic_async") {
+  // Same as above, but the writes run on the async write thread (if MPI
+  // supports it, otherwise they fall back to synchronous writes)
+  std::vector<std::string> avg_type = {
+    "INSTANT",
+    "AVERAGE"
+  };
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  scorpio::eam_init_pio_subsystem(comm);
+
+  auto seed = get_random_test_seed(&comm);
+
+  const int freq = 5;
+  for (const auto& avg : avg_type) {
+    write(avg,"nsteps",freq,seed,comm,true);
+    read(avg,"nsteps",freq,seed,comm);
+  }
+  scorpio::eam_pio_finalize();
+}
+
+TEST_CASE ("io_basic_buffered") {
+  // Same as above, but the snapshots are buffered in host memory and written two
+  // at a time, with the last (partial) buffer written at finalization
+  std::vector<std::string> avg_type = {
+    "INSTANT",
+    "AVERAGE"
+  };
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  scorpio::eam_init_pio_subsystem(comm);
+
+  auto seed = get_random_test_seed(&comm);
+
+  const int freq = 5;
+  for (const auto& avg : avg_type) {
+    write(avg,"nsteps",freq,seed,comm,false,2);
+    read(avg,"nsteps",freq,seed,comm);
+    write(avg,"nsteps",freq,seed,comm,true,2);
+    read(avg,"nsteps",freq,seed,comm);
+  }
+  scorpio::eam_pio_finalize();
+}
+
 } // anonymous namespace
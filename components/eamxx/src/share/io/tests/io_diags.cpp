@@ -249,6 +249,39 @@ void read (const int seed, const ekat::Comm& comm)
   REQUIRE (views_are_equal(d,f0));
 }
 
+void check_up_to_date (const ekat::Comm& comm)
+{
+  auto gm = get_gm(comm);
+  auto grid = gm->get_grid("Point Grid");
+
+  auto t0 = get_t0();
+  auto fm = get_fm(grid,t0,0);
+
+  ekat::ParameterList params;
+  MyDiag diag(comm,params);
+  diag.set_grids(gm);
+  for (const auto& req : diag.get_required_field_requests()) {
+    diag.set_required_field(fm->get_field(req.fid.name()));
+  }
+  diag.initialize(t0,RunType::Initial);
+
+  // Not computed yet
+  REQUIRE (not diag.is_up_to_date());
+
+  diag.compute_diagnostic();
+  REQUIRE (diag.is_up_to_date());
+  REQUIRE (diag.get_inputs_time_stamp()==t0);
+
+  // Advancing the inputs makes the diag stale
+  for (const auto& f : diag.get_fields_in()) {
+    f.get_header().get_tracking().update_time_stamp(t0+1);
+  }
+  REQUIRE (not diag.is_up_to_date());
+
+  diag.compute_diagnostic();
+  REQUIRE (diag.is_up_to_date());
+}
+
 TEST_CASE ("io_diags") {
   ekat::Comm comm(MPI_COMM_WORLD);
   scorpio::eam_init_pio_subsystem(comm);
@@ -273,6 +306,10 @@ TEST_CASE ("io_diags") {
   write(seed,comm);
   read(seed,comm);
   print(" PASS\n");
+
+  print ("-> Check diagnostic up-to-date status ", 40);
+  check_up_to_date(comm);
+  print(" PASS\n");
   scorpio::eam_pio_finalize();
 }
 
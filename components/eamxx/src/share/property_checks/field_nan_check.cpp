@@ -42,13 +42,26 @@ PropertyCheck::ResultAndMsg FieldNaNCheck::check_impl() const {
   const auto extents = layout.extents();
   const auto size = layout.size();
 
+  // If the field is over columns, only inspect the sampled ones. Since the
+  // column is the slowest index, they map to a contiguous range of entries.
+  using namespace ShortFieldTagsNames;
+  using RangePolicy = Kokkos::RangePolicy<Field::device_t::execution_space>;
+  int beg = 0, end = size;
+  if (layout.rank()>0 && layout.tag(0)==COL && layout.dim(0)>0) {
+    const int col_size = size / layout.dim(0);
+    const auto cols = sampled_cols_range(layout.dim(0));
+    beg = cols.first*col_size;
+    end = cols.second*col_size;
+  }
+  const auto policy = RangePolicy(beg,end);
+
   int invalid_idx = -1;
   using max_t = Kokkos::Max<int>;
   switch (layout.rank()) {
     case 1:
       {
         auto v = f.template get_view<const_ST*>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int i, int& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int i, int& result) {
           if (ekat::is_invalid(v(i))) {
             result = i;
           }
@@ -58,7 +71,7 @@ PropertyCheck::ResultAndMsg FieldNaNCheck::check_impl() const {
     case 2:
       {
         auto v = f.template get_view<const_ST**>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, int& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, int& result) {
           int i,j;
           unflatten_idx(idx,extents,i,j);
           if (ekat::is_invalid(v(i,j))) {
@@ -70,7 +83,7 @@ PropertyCheck::ResultAndMsg FieldNaNCheck::check_impl() const {
     case 3:
       {
         auto v = f.template get_view<const_ST***>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, int& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, int& result) {
           int i,j,k;
           unflatten_idx(idx,extents,i,j,k);
           if (ekat::is_invalid(v(i,j,k))) {
@@ -82,7 +95,7 @@ PropertyCheck::ResultAndMsg FieldNaNCheck::check_impl() const {
     case 4:
       {
         auto v = f.template get_view<const_ST****>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, int& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, int& result) {
           int i,j,k,l;
           unflatten_idx(idx,extents,i,j,k,l);
           if (ekat::is_invalid(v(i,j,k,l))) {
@@ -94,7 +107,7 @@ PropertyCheck::ResultAndMsg FieldNaNCheck::check_impl() const {
     case 5:
       {
         auto v = f.template get_view<const_ST*****>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, int& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, int& result) {
           int i,j,k,l,m;
           unflatten_idx(idx,extents,i,j,k,l,m);
           if (ekat::is_invalid(v(i,j,k,l,m))) {
@@ -106,7 +119,7 @@ PropertyCheck::ResultAndMsg FieldNaNCheck::check_impl() const {
     case 6:
       {
         auto v = f.template get_view<const_ST******>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, int& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, int& result) {
           int i,j,k,l,m,n;
           unflatten_idx(idx,extents,i,j,k,l,m,n);
           if (ekat::is_invalid(v(i,j,k,l,m,n))) {
@@ -129,7 +142,6 @@ PropertyCheck::ResultAndMsg FieldNaNCheck::check_impl() const {
     res_and_msg.fail_loc_tags = layout.tags();
     res_and_msg.msg  = "FieldNaNCheck failed.\n";
     res_and_msg.msg += "  - field id: " + f.get_header().get_identifier().get_id_string() + "\n";
-    using namespace ShortFieldTagsNames;
 
     int col_lid;
 
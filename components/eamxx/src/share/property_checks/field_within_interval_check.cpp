@@ -88,6 +88,19 @@ PropertyCheck::ResultAndMsg FieldWithinIntervalCheck::check_impl () const
   const auto extents = layout.extents();
   const auto size = layout.size();
 
+  // If the field is over columns, only inspect the sampled ones. Since the
+  // column is the slowest index, they map to a contiguous range of entries.
+  using namespace ShortFieldTagsNames;
+  using RangePolicy = Kokkos::RangePolicy<Field::device_t::execution_space>;
+  int beg = 0, end = size;
+  if (layout.rank()>0 && layout.tag(0)==COL && layout.dim(0)>0) {
+    const int col_size = size / layout.dim(0);
+    const auto cols = sampled_cols_range(layout.dim(0));
+    beg = cols.first*col_size;
+    end = cols.second*col_size;
+  }
+  const auto policy = RangePolicy(beg,end);
+
   using minmaxloc_t = Kokkos::MinMaxLoc<nonconst_ST,int>;
   using minmaxloc_value_t = typename minmaxloc_t::value_type;
   minmaxloc_value_t minmaxloc;
@@ -95,7 +108,7 @@ PropertyCheck::ResultAndMsg FieldWithinIntervalCheck::check_impl () const
     case 1:
       {
         auto v = f.template get_view<const_ST*>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int i, minmaxloc_value_t& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int i, minmaxloc_value_t& result) {
           if (v(i)<result.min_val) {
             result.min_val = v(i);
             result.min_loc = i;
@@ -110,7 +123,7 @@ PropertyCheck::ResultAndMsg FieldWithinIntervalCheck::check_impl () const
     case 2:
       {
         auto v = f.template get_view<const_ST**>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
           int i,j;
           unflatten_idx(idx,extents,i,j);
           if (v(i,j)<result.min_val) {
@@ -127,7 +140,7 @@ PropertyCheck::ResultAndMsg FieldWithinIntervalCheck::check_impl () const
     case 3:
       {
         auto v = f.template get_view<const_ST***>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
           int i,j,k;
           unflatten_idx(idx,extents,i,j,k);
           if (v(i,j,k)<result.min_val) {
@@ -144,7 +157,7 @@ PropertyCheck::ResultAndMsg FieldWithinIntervalCheck::check_impl () const
     case 4:
       {
         auto v = f.template get_view<const_ST****>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
           int i,j,k,l;
           unflatten_idx(idx,extents,i,j,k,l);
           if (v(i,j,k,l)<result.min_val) {
@@ -161,7 +174,7 @@ PropertyCheck::ResultAndMsg FieldWithinIntervalCheck::check_impl () const
     case 5:
       {
         auto v = f.template get_view<const_ST*****>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
           int i,j,k,l,m;
           unflatten_idx(idx,extents,i,j,k,l,m);
           if (v(i,j,k,l,m)<result.min_val) {
@@ -178,7 +191,7 @@ PropertyCheck::ResultAndMsg FieldWithinIntervalCheck::check_impl () const
     case 6:
       {
         auto v = f.template get_view<const_ST******>();
-        Kokkos::parallel_reduce(size, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
+        Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int idx, minmaxloc_value_t& result) {
           int i,j,k,l,m,n;
           unflatten_idx(idx,extents,i,j,k,l,m,n);
           if (v(i,j,k,l,m,n)<result.min_val) {
@@ -248,8 +261,6 @@ PropertyCheck::ResultAndMsg FieldWithinIntervalCheck::check_impl () const
     res_and_msg.fail_loc_tags = layout.tags();
   }
 
-  using namespace ShortFieldTagsNames;
-
   int min_col_lid = -1, max_col_lid = -1;
   bool has_latlon = false;
   bool has_col_info = m_grid and layout.tag(0)==COL;
@@ -62,9 +62,11 @@ void MassAndEnergyColumnConservationCheck::compute_current_mass ()
   const auto qi = m_fields.at("qi").get_view<const Real**>();
   const auto qr = m_fields.at("qr").get_view<const Real**>();
 
-  const auto policy = ExeSpaceUtils::get_default_team_policy(ncols, nlevs);
+  const auto cols = sampled_cols_range(ncols);
+  const int  beg  = cols.first;
+  const auto policy = ExeSpaceUtils::get_default_team_policy(cols.second-beg, nlevs);
   Kokkos::parallel_for(policy, KOKKOS_LAMBDA (const KT::MemberType& team) {
-    const int i = team.league_rank();
+    const int i = beg + team.league_rank();
 
     const auto pseudo_density_i = ekat::subview(pseudo_density, i);
     const auto qv_i             = ekat::subview(qv, i);
@@ -91,9 +93,11 @@ void MassAndEnergyColumnConservationCheck::compute_current_energy ()
   const auto ps = m_fields.at("ps").get_view<const Real*>();
   const auto phis = m_fields.at("phis").get_view<const Real*>();
 
-  const auto policy = ExeSpaceUtils::get_default_team_policy(ncols, nlevs);
+  const auto cols = sampled_cols_range(ncols);
+  const int  beg  = cols.first;
+  const auto policy = ExeSpaceUtils::get_default_team_policy(cols.second-beg, nlevs);
   Kokkos::parallel_for(policy, KOKKOS_LAMBDA (const KT::MemberType& team) {
-    const int i = team.league_rank();
+    const int i = beg + team.league_rank();
 
     const auto pseudo_density_i = ekat::subview(pseudo_density, i);
     const auto T_mid_i          = ekat::subview(T_mid, i);
@@ -139,11 +143,14 @@ PropertyCheck::ResultAndMsg MassAndEnergyColumnConservationCheck::check() const
   maxloc_value_t maxloc_mass;
   maxloc_value_t maxloc_energy;
 
-  // Mass error calculation
-  const auto policy = ExeSpaceUtils::get_default_team_policy(ncols, nlevs);
+  // Mass error calculation (only on the sampled columns, for which the
+  // current mass/energy were computed)
+  const auto cols = sampled_cols_range(ncols);
+  const int  beg  = cols.first;
+  const auto policy = ExeSpaceUtils::get_default_team_policy(cols.second-beg, nlevs);
   Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA (const KT::MemberType& team,
                                                  maxloc_value_t&       result) {
-    const int i = team.league_rank();
+    const int i = beg + team.league_rank();
 
     const auto pseudo_density_i = ekat::subview(pseudo_density, i);
     const auto qv_i             = ekat::subview(qv, i);
@@ -176,7 +183,7 @@ PropertyCheck::ResultAndMsg MassAndEnergyColumnConservationCheck::check() const
   Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA (const KT::MemberType& team,
                                                  maxloc_value_t&       result) {
 
-    const int i = team.league_rank();
+    const int i = beg + team.league_rank();
 
     const auto pseudo_density_i = ekat::subview(pseudo_density, i);
     const auto T_mid_i          = ekat::subview(T_mid, i);
@@ -54,6 +54,9 @@ public:
   // Computes mass and energy and tests against a tolerance.
   ResultAndMsg check () const override;
 
+  // The current mass/energy are only computed on the sampled columns
+  bool can_rerun_on_all_columns () const override { return false; }
+
   std::shared_ptr<const AbstractGrid> get_grid () const { return m_grid; }
 
   // Set the timestep for the process running the check. This
@@ -2,6 +2,7 @@
 
 #include <ekat/ekat_assert.hpp>
 
+#include <algorithm>
 #include <string>
 #include <list>
 
@@ -91,6 +92,33 @@ void PropertyCheck::check_and_repair () const {
   }
 }
 
+void PropertyCheck::
+set_sampled_chunk (const int chunk, const int num_chunks)
+{
+  EKAT_REQUIRE_MSG (num_chunks>0 && chunk>=0 && chunk<num_chunks,
+      "Error! Invalid column chunk for property check sampling.\n"
+      "  - PropertyCheck name: " + name() + "\n"
+      "  - Chunk: " + std::to_string(chunk) + "\n"
+      "  - Num chunks: " + std::to_string(num_chunks) + "\n");
+
+  m_chunk = chunk;
+  m_num_chunks = num_chunks;
+}
+
+std::pair<int,int> PropertyCheck::
+sampled_cols_range (const int ncols) const
+{
+  if (not is_sampled()) {
+    return std::make_pair(0,ncols);
+  }
+
+  // The last chunk(s) may be smaller (or even empty, if ncols<m_num_chunks)
+  const int chunk_size = (ncols + m_num_chunks - 1) / m_num_chunks;
+  const int beg = std::min(m_chunk*chunk_size,ncols);
+  const int end = std::min(beg+chunk_size,ncols);
+  return std::make_pair(beg,end);
+}
+
 bool PropertyCheck::same_as (const PropertyCheck& pc) const
 {
   if (this->name()!=pc.name()) {
@@ -118,7 +118,31 @@ public:
   // Whether the input check is the same as this class
   virtual bool same_as (const PropertyCheck& pc) const;
 
+  // Column sampling: split the local columns in num_chunks contiguous chunks,
+  // and have check() only inspect the given chunk. Checks that are not over
+  // columns ignore this, and always inspect all the data. By default, there
+  // is only one chunk (i.e., all columns are checked).
+  void set_sampled_chunk (const int chunk, const int num_chunks);
+
+  // Whether the next call to check() only inspects a subset of the columns
+  bool is_sampled () const { return m_num_chunks>1 && not m_escalated; }
+
+  // An escalated check ignores the sampling, and inspects all the columns.
+  // Checks are escalated when a sampled check does not pass, and stay so
+  // until they pass on all columns.
+  void set_escalated (const bool escalated) { m_escalated = escalated; }
+  bool is_escalated () const { return m_escalated; }
+
+  // Whether check() can be re-run on all columns right after running on a
+  // subset of them. Checks relying on data computed *before* the process runs
+  // for the sampled columns only cannot, and must wait for the next run.
+  virtual bool can_rerun_on_all_columns () const { return true; }
+
 protected:
+  // The range [beg,end) of local columns that check() should inspect,
+  // out of the given number of columns
+  std::pair<int,int> sampled_cols_range (const int ncols) const;
+
   virtual void repair_impl () const {
     EKAT_ERROR_MSG ("Error! The method 'repair_impl' has not been overridden.\n"
         "  PropertyCheck name: " + name() + "\n");
@@ -128,6 +152,11 @@ protected:
   std::list<Field*>   m_repairable_fields;
 
   std::list<Field> m_additional_data_fields;
+
+  // Column sampling
+  int   m_chunk      = 0;
+  int   m_num_chunks = 1;
+  bool  m_escalated  = false;
 };
 
 } // namespace scream
@@ -334,6 +334,19 @@ protected:
   }
 };
 
+// Like AddOne, but reports a max stable dt, for adaptive subcycling
+class AddOneStableDt : public AddOne
+{
+public:
+  AddOneStableDt (const ekat::Comm& comm,const ekat::ParameterList& params)
+   : AddOne(comm,params)
+  {
+    // Nothing to do here
+  }
+
+  double get_max_stable_dt () const override { return 2; }
+};
+
 // ================================ TESTS ============================== //
 
 TEST_CASE("process_factory", "") {
@@ -580,6 +593,35 @@ TEST_CASE ("subcycling") {
   for (size_t i=0; i<v.size(); ++i) {
     REQUIRE (v_sub[i]==5*v[i]);
   }
+
+  SECTION ("adaptive") {
+    // With a stable dt of 2, running for dt=5 requires 3 subcycles,
+    // unless the max number of subcycles is smaller than that.
+    for (int max_nsub : {16, 2}) {
+      ekat::ParameterList params_ad;
+      params_ad.set<std::string>("Grid Name", "Point Grid");
+      params_ad.set<bool>("adaptive_subcycling", true);
+      params_ad.set<int>("max_number_of_subcycles", max_nsub);
+      auto ap_ad = std::make_shared<AddOneStableDt>(comm,params_ad);
+      ap_ad->set_grids(gm);
+      for(const auto& req : ap_ad->get_required_field_requests()) {
+        Field f(req.fid);
+        f.allocate_view();
+        f.deep_copy(0);
+        f.get_header().get_tracking().update_time_stamp(t0);
+        ap_ad->set_required_field(f.get_const());
+        ap_ad->set_computed_field(f);
+      }
+      ap_ad->initialize(t0,RunType::Initial);
+      ap_ad->run(dt);
+
+      const int nsub = std::min(3,max_nsub);
+      auto v_ad = ap_ad->get_fields_in().front().get_view<const Real*,Host>();
+      for (size_t i=0; i<v.size(); ++i) {
+        REQUIRE (v_ad[i]==nsub*v[i]);
+      }
+    }
+  }
 }
 
 TEST_CASE ("diagnostics") {
@@ -157,6 +157,7 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
   printf("   - Fields Manager...\n");
   auto fields_man_t0 = get_fm(grid, t0, seed);
   auto fields_man_deep = get_fm(grid, t0, seed);  // A field manager for checking deep copies.
+  auto fields_man_pref = get_fm(grid, t0, seed);  // A field manager for checking prefetched data.
   std::vector<std::string> fnames;
   for (auto it : *fields_man_t0) {
     fnames.push_back(it.second->name());
@@ -171,14 +172,20 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
   printf(  "Constructing a time interpolation object ...\n");
   util::TimeInterpolation time_interpolator(grid,list_of_files);
   util::TimeInterpolation time_interpolator_deep(grid,list_of_files);
+  // Reads the next snap of data in the background (or synchronously, if MPI does not support it)
+  util::TimeInterpolation time_interpolator_pref(grid,list_of_files);
+  time_interpolator_pref.set_prefetch(true);
   for (auto name : fnames) {
     auto ff      = fields_man_t0->get_field(name);
     auto ff_deep = fields_man_deep->get_field(name);
+    auto ff_pref = fields_man_pref->get_field(name);
     time_interpolator.add_field(ff);
     time_interpolator_deep.add_field(ff_deep,true);
+    time_interpolator_pref.add_field(ff_pref,true);
   }
   time_interpolator.initialize_data_from_files();
   time_interpolator_deep.initialize_data_from_files();
+  time_interpolator_pref.initialize_data_from_files();
   printf(  "Constructing a time interpolation object ... DONE\n");
 
   // Now check that the interpolator is working as expected.  Should be able to
@@ -209,6 +216,7 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
     }
     time_interpolator.perform_time_interpolation(ts);
     time_interpolator_deep.perform_time_interpolation(ts);
+    time_interpolator_pref.perform_time_interpolation(ts);
     // Now compare the interp_fields to the fields in the field manager which should be updated.
     for (auto name : fnames) {
       auto field      = fields_man_t0->get_field(name);
@@ -219,6 +227,8 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
       REQUIRE(views_are_equal(field_deep,time_interpolator_deep.get_field(name)));
       // Check that the deep and shallow fields match showing that both approaches got the correct answer.
       REQUIRE(views_are_equal(field,field_deep));
+      // Check that prefetching the data gives the same answer.
+      REQUIRE(views_are_equal(field_deep,fields_man_pref->get_field(name)));
     }
 
   }
@@ -226,6 +236,7 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
 
   time_interpolator.finalize();
   time_interpolator_deep.finalize();
+  time_interpolator_pref.finalize();
   printf("                        ... DONE\n");
 
   // All done with IO
@@ -676,6 +676,10 @@ TEST_CASE("tracers_bundle", "") {
   REQUIRE (qv_ptr->equivalent(qv));
   REQUIRE (qc_ptr->equivalent(qc));
   REQUIRE (qr_ptr->equivalent(qr));
+
+  // Adding a field that is already in the bundled group is a no-op
+  REQUIRE_NOTHROW (field_mgr.add_to_group("qc","tracers"));
+  REQUIRE (field_mgr.get_field_group("tracers").m_info->size()==3);
 }
 
 TEST_CASE("multiple_bundles") {
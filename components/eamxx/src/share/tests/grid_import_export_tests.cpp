@@ -196,6 +196,74 @@ TEST_CASE ("grid_import_export") {
   if (comm.am_i_root()) {
     printf(" -> Testing scatter routine ... %s\n",ok ? "PASS" : "FAIL");
   }
+
+  // Test Field-based scatter/gather
+  if (comm.am_i_root()) {
+    printf(" -> Testing field scatter/gather ...\n");
+  }
+  ok = true;
+  const auto nondim = ekat::units::Units::nondimensional();
+  const int ncmps = 3;
+  auto create_fields = [&](const std::shared_ptr<const AbstractGrid>& grid) {
+    const int ncols = grid->get_num_local_dofs();
+    std::vector<Field> fields;
+    fields.emplace_back(FieldIdentifier("f1",FieldLayout({COL},{ncols}),nondim,grid->name()));
+    fields.emplace_back(FieldIdentifier("f2",FieldLayout({COL,CMP},{ncols,ncmps}),nondim,grid->name()));
+    for (auto& f : fields) {
+      f.allocate_view();
+    }
+    return fields;
+  };
+  auto src_fields = create_fields(src_grid);
+  auto dst_fields = create_fields(dst_grid);
+
+  // Repeat, to check that buffers/requests are correctly reused
+  for (int iter=0; iter<2; ++iter) {
+    auto u1 = src_fields[0].get_view<Real*,Host>();
+    auto u2 = src_fields[1].get_view<Real**,Host>();
+    for (int i=0; i<src_grid->get_num_local_dofs(); ++i) {
+      u1(i) = src_gids[i] + iter;
+      for (int k=0; k<ncmps; ++k) {
+        u2(i,k) = 10*src_gids[i] + k + iter;
+      }
+    }
+    for (auto& f : src_fields) {
+      f.sync_to_dev();
+    }
+    imp_exp.scatter(src_fields,dst_fields);
+
+    auto o1 = dst_fields[0].get_view<Real*,Host>();
+    auto o2 = dst_fields[1].get_view<Real**,Host>();
+    for (auto& f : dst_fields) {
+      f.sync_to_host();
+    }
+    for (int i=0; i<dst_grid->get_num_local_dofs(); ++i) {
+      CHECK (o1(i)==dst_gids[i]+iter);
+      ok &= catch_capture.lastAssertionPassed();
+      for (int k=0; k<ncmps; ++k) {
+        CHECK (o2(i,k)==10*dst_gids[i]+k+iter);
+        ok &= catch_capture.lastAssertionPassed();
+      }
+    }
+
+    // Gathering back sums the contributions of all the copies of each dof
+    imp_exp.gather(dst_fields,src_fields);
+    for (auto& f : src_fields) {
+      f.sync_to_host();
+    }
+    for (int i=0; i<src_grid->get_num_local_dofs(); ++i) {
+      const Real n = num_imp_per_lid[i];
+      CHECK (u1(i)==n*(src_gids[i]+iter));
+      ok &= catch_capture.lastAssertionPassed();
+      for (int k=0; k<ncmps; ++k) {
+        CHECK (u2(i,k)==n*(10*src_gids[i]+k+iter));
+        ok &= catch_capture.lastAssertionPassed();
+      }
+    }
+  }
+  if (comm.am_i_root()) {
+    printf(" -> Testing field scatter/gather ... %s\n",ok ? "PASS" : "FAIL");
+  }
 }
 
 } // anonymous namespace
@@ -130,6 +130,36 @@ TEST_CASE("property_checks", "") {
     REQUIRE( res_and_msg.msg == expected_msg );
   }
 
+  // Check that sampled checks only inspect the requested chunk of columns
+  SECTION("sampled_nan_check") {
+    auto nan_check = std::make_shared<FieldNaNCheck>(f,grid);
+
+    f.deep_copy(1.0);
+    auto f_view = f.get_view<Real***,Host>();
+    f_view(1,2,3) = std::numeric_limits<Real>::quiet_NaN();
+    f.sync_to_dev();
+
+    // Only the 2nd column has a NaN
+    nan_check->set_sampled_chunk(0,num_lcols);
+    REQUIRE (nan_check->is_sampled());
+    REQUIRE (nan_check->check().result==CheckResult::Pass);
+    nan_check->set_sampled_chunk(1,num_lcols);
+    REQUIRE (nan_check->check().result==CheckResult::Fail);
+
+    // Escalated checks inspect all columns, regardless of the chunk
+    nan_check->set_sampled_chunk(0,num_lcols);
+    nan_check->set_escalated(true);
+    REQUIRE (not nan_check->is_sampled());
+    REQUIRE (nan_check->check().result==CheckResult::Fail);
+
+    // With more chunks than columns, some chunks are empty
+    nan_check->set_escalated(false);
+    nan_check->set_sampled_chunk(num_lcols,num_lcols+1);
+    REQUIRE (nan_check->check().result==CheckResult::Pass);
+
+    REQUIRE_THROWS (nan_check->set_sampled_chunk(num_lcols,num_lcols));
+  }
+
   // Check that the values of a field lie within an interval.
   SECTION ("field_within_interval_check") {
     const auto num_reals = f.get_header().get_alloc_properties().get_num_scalars();
@@ -16,6 +16,13 @@ public:
    : RefiningRemapperP2P(tgt_grid,map_file) {}
 
   ~RefiningRemapperP2PTester () = default;
+
+  bool shares_map_data_with (const RefiningRemapperP2PTester& other) const {
+    return m_ov_coarse_grid==other.m_ov_coarse_grid and
+           m_row_offsets.data()==other.m_row_offsets.data() and
+           m_col_lids.data()==other.m_col_lids.data() and
+           m_weights.data()==other.m_weights.data();
+  }
 };
 
 Field create_field (const std::string& name, const LayoutType lt, const AbstractGrid& grid)
@@ -212,6 +219,15 @@ TEST_CASE ("refining_remapper") {
   auto r = std::make_shared<RefiningRemapperP2PTester>(tgt_grid,filename);
   auto src_grid = r->get_src_grid();
 
+  // A second remapper with the same map file and tgt grid reuses the map data,
+  // but has its own src grid
+  {
+    auto r2 = std::make_shared<RefiningRemapperP2PTester>(tgt_grid,filename);
+    REQUIRE (r2->shares_map_data_with(*r));
+    REQUIRE (r2->get_src_grid()!=src_grid);
+    REQUIRE (r2->get_src_grid()->get_num_global_dofs()==src_grid->get_num_global_dofs());
+  }
+
   auto bundle_src = create_field("bundle3d_src",LayoutType::Vector3D,*src_grid,engine);
   auto s2d_src   = create_field("s2d_src",LayoutType::Scalar2D,*src_grid,engine);
   auto v2d_src   = create_field("v2d_src",LayoutType::Vector2D,*src_grid,engine);
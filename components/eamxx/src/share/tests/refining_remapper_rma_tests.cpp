@@ -12,8 +12,9 @@ namespace scream {
 class RefiningRemapperRMATester : public RefiningRemapperRMA {
 public:
   RefiningRemapperRMATester (const grid_ptr_type& tgt_grid,
-                          const std::string& map_file)
-   : RefiningRemapperRMA(tgt_grid,map_file) {}
+                          const std::string& map_file,
+                          const bool use_shared_mem_window = false)
+   : RefiningRemapperRMA(tgt_grid,map_file,use_shared_mem_window) {}
 
   ~RefiningRemapperRMATester () = default;
 
@@ -26,7 +27,10 @@ public:
     REQUIRE (m_col_size.size()==n);
     REQUIRE (m_col_stride.size()==n);
     REQUIRE (m_col_offset.size()==n);
-    REQUIRE (m_mpi_win.size()==n);
+    REQUIRE (m_buf_col_offset.size()==n);
+    REQUIRE (m_mpi_win!=MPI_WIN_NULL);
+    REQUIRE (m_send_buffer.extent_int(0)>=m_src_grid->get_num_local_dofs()*m_buf_col_size);
+    REQUIRE (m_recv_buffer.extent_int(0)>=m_ov_coarse_grid->get_num_local_dofs()*m_buf_col_size);
     REQUIRE (m_remote_lids.size()==static_cast<size_t>(m_ov_coarse_grid->get_num_local_dofs()));
     REQUIRE (m_remote_pids.size()==static_cast<size_t>(m_ov_coarse_grid->get_num_local_dofs()));
 
@@ -45,6 +49,7 @@ public:
         REQUIRE (m_col_stride[i]==col_alloc_size);
         REQUIRE (m_col_offset[i]==0);
       }
+      REQUIRE (m_buf_col_offset[i]==(i==0 ? 0 : m_buf_col_offset[i-1]+m_col_size[i-1]));
     }
 
     // Test CRS matirx
@@ -474,6 +479,41 @@ TEST_CASE ("refining_remapper") {
     }
   }
 
+  // The remapper with a shared memory window must give the same results,
+  // also when the window is reused for several remaps
+  {
+    if (comm.am_i_root()) {
+      printf(" -> Checking shared mem window ..\n");
+    }
+    bool ok = true;
+    auto r_shm = std::make_shared<RefiningRemapperRMATester>(tgt_grid,filename,true);
+
+    std::vector<Field> src = {s2d_src,v2d_src,s3d_src,v3d_src,
+                              bundle_src.get_component(0),bundle_src.get_component(1)};
+    std::vector<Field> tgt = {s2d_tgt,v2d_tgt,s3d_tgt,v3d_tgt,
+                              bundle_tgt.get_component(0),bundle_tgt.get_component(1)};
+    std::vector<Field> tgt_shm;
+    r_shm->registration_begins();
+    for (size_t i=0; i<src.size(); ++i) {
+      tgt_shm.push_back(tgt[i].clone());
+      tgt_shm.back().deep_copy(0);
+      r_shm->register_field(src[i],tgt_shm.back());
+    }
+    r_shm->registration_ends();
+    r_shm->test_internals();
+
+    for (int n=0; n<2; ++n) {
+      r_shm->remap(true);
+      for (size_t i=0; i<tgt.size(); ++i) {
+        CHECK (views_are_equal(tgt[i],tgt_shm[i]));
+        ok &= catch_capture.lastAssertionPassed();
+      }
+    }
+    if (comm.am_i_root()) {
+      printf(" -> Checking shared mem window .. %s\n",ok ? "PASS" : "FAIL");
+    }
+  }
+
   // Clean up
   r = nullptr;
   scorpio::eam_pio_finalize();
@@ -1,6 +1,8 @@
 #include <catch2/catch.hpp>
 
 #include "share/util/scream_vertical_interpolation.hpp"
+#include "share/util/eamxx_vertical_interp_weights.hpp"
+#include "share/field/field.hpp"
 
 using namespace scream;
 using namespace vinterp;
@@ -355,3 +357,159 @@ TEST_CASE("testing_masking"){
 
 }
 
+TEST_CASE("vertical_interp_weights"){
+  using namespace ShortFieldTagsNames;
+  using Weights = VerticalInterpWeights;
+
+  const int ncols = 3;
+  const int nlevs = 8;
+  const int ncmps = 2;
+  const auto nondim = ekat::units::Units::nondimensional();
+
+  auto make_field = [&](const std::string& name, const std::vector<FieldTag>& tags,
+                        const std::vector<int>& dims, const int pack_size = 1) {
+    Field f(FieldIdentifier(name,FieldLayout(tags,dims),nondim,"grid"));
+    f.get_header().get_alloc_properties().request_allocation(pack_size);
+    f.allocate_view();
+    return f;
+  };
+
+  // The src coordinate increases along the column: x(icol,k) = k+1+icol/2
+  auto x = make_field("x",{COL,LEV},{ncols,nlevs},SCREAM_PACK_SIZE);
+  auto s = make_field("s",{COL,LEV},{ncols,nlevs},SCREAM_PACK_SIZE);
+  auto v = make_field("v",{COL,CMP,LEV},{ncols,ncmps,nlevs});
+  auto x_h = x.get_view<Real**,Host>();
+  auto s_h = s.get_view<Real**,Host>();
+  auto v_h = v.get_view<Real***,Host>();
+  auto y = [](int icol, int icmp, Real xk) { return 2*xk + icol + 10*icmp; };
+  for (int icol=0; icol<ncols; ++icol) {
+    for (int k=0; k<nlevs; ++k) {
+      x_h(icol,k) = k + 1 + icol/2.0;
+      s_h(icol,k) = y(icol,0,x_h(icol,k));
+      for (int icmp=0; icmp<ncmps; ++icmp) {
+        v_h(icol,icmp,k) = y(icol,icmp,x_h(icol,k));
+      }
+    }
+  }
+  x.sync_to_dev();
+  s.sync_to_dev();
+  v.sync_to_dev();
+  x.get_header().get_tracking().update_time_stamp(util::TimeStamp({2000,1,1},{0,0,0}));
+
+  // Tgt values below, inside, at the end of, and above the src range
+  const std::vector<Real> x_tgt = {0.5, 2.5, 4.25, 8, 100};
+  const int ntgt = x_tgt.size();
+  const Real mask_val = -1;
+
+  SECTION ("mask") {
+    auto w = Weights::get_shared_weights(x,x_tgt,Weights::OutOfBounds::Mask);
+    REQUIRE (w==Weights::get_shared_weights(x,x_tgt,Weights::OutOfBounds::Mask));
+    REQUIRE (w!=Weights::get_shared_weights(x,x_tgt,Weights::OutOfBounds::Extrapolate));
+    w->compute(x);
+
+    // Scalar and vector fields are interpolated in the same call
+    auto s_tgt = make_field("s_tgt",{COL,LEV},{ncols,ntgt},SCREAM_PACK_SIZE);
+    auto v_tgt = make_field("v_tgt",{COL,CMP,LEV},{ncols,ncmps,ntgt});
+    auto v1_tgt = make_field("v1_tgt",{COL,CMP},{ncols,ncmps});
+    auto mask = make_field("mask",{COL,LEV},{ncols,ntgt});
+    auto fused_mask = make_field("fused_mask",{COL,LEV},{ncols,ntgt});
+    w->apply({s,v},{s_tgt,v_tgt},mask_val);
+    w->compute_mask(mask);
+
+    // Masks can also be computed in the same kernel as the fields
+    auto s_tgt2 = make_field("s_tgt2",{COL,LEV},{ncols,ntgt},SCREAM_PACK_SIZE);
+    w->apply({s},{s_tgt2},{fused_mask},mask_val);
+
+    s_tgt.sync_to_host();
+    s_tgt2.sync_to_host();
+    v_tgt.sync_to_host();
+    mask.sync_to_host();
+    fused_mask.sync_to_host();
+    auto s_tgt_h = s_tgt.get_view<const Real**,Host>();
+    auto s_tgt2_h = s_tgt2.get_view<const Real**,Host>();
+    auto v_tgt_h = v_tgt.get_view<const Real***,Host>();
+    auto mask_h = mask.get_view<const Real**,Host>();
+    auto fused_mask_h = fused_mask.get_view<const Real**,Host>();
+    for (int icol=0; icol<ncols; ++icol) {
+      for (int j=0; j<ntgt; ++j) {
+        const bool out = x_tgt[j]<x_h(icol,0) or x_tgt[j]>x_h(icol,nlevs-1);
+        REQUIRE (mask_h(icol,j)==(out ? 0 : 1));
+        REQUIRE (fused_mask_h(icol,j)==mask_h(icol,j));
+        REQUIRE (s_tgt2_h(icol,j)==s_tgt_h(icol,j));
+        REQUIRE (s_tgt_h(icol,j)==Approx(out ? mask_val : y(icol,0,x_tgt[j])));
+        for (int icmp=0; icmp<ncmps; ++icmp) {
+          REQUIRE (v_tgt_h(icol,icmp,j)==Approx(out ? mask_val : y(icol,icmp,x_tgt[j])));
+        }
+      }
+    }
+
+    // Weights are not recomputed if the time stamp of the coordinate did not change
+    auto idx = Kokkos::create_mirror_view(w->get_indices());
+    Kokkos::deep_copy(idx,w->get_indices());
+    x.deep_copy(1000);
+    w->compute(x);
+    auto idx2 = Kokkos::create_mirror_view(w->get_indices());
+    Kokkos::deep_copy(idx2,w->get_indices());
+    REQUIRE (idx2(0,1)==idx(0,1));
+    x.get_header().get_tracking().update_time_stamp(util::TimeStamp({2000,1,1},{0,0,1}));
+    w->compute(x);
+    Kokkos::deep_copy(idx2,w->get_indices());
+    REQUIRE (idx2(0,1)==-1);
+
+    // Single tgt value, for a field without the level dim
+    auto w1 = Weights::get_shared_weights(s,{4.25},Weights::OutOfBounds::Mask);
+    auto v_lev = make_field("v_lev",{COL,CMP,LEV},{ncols,ncmps,nlevs});
+    auto v_lev_h = v_lev.get_view<Real***,Host>();
+    for (int icol=0; icol<ncols; ++icol) {
+      for (int icmp=0; icmp<ncmps; ++icmp) {
+        for (int k=0; k<nlevs; ++k) {
+          v_lev_h(icol,icmp,k) = k;
+        }
+      }
+    }
+    v_lev.sync_to_dev();
+    w1->compute(s);
+    CHECK_THROWS (w1->apply({v_lev},{v_tgt},mask_val)); // tgt must have 1 level or none
+    w1->apply({v_lev},{v1_tgt},mask_val);
+    v1_tgt.sync_to_host();
+    auto v1_tgt_h = v1_tgt.get_view<const Real**,Host>();
+    for (int icol=0; icol<ncols; ++icol) {
+      for (int icmp=0; icmp<ncmps; ++icmp) {
+        // s=2*x+icol, with x=k+1+icol/2 at level k
+        const Real s_lev0 = 2 + 2*icol;
+        const Real k = (4.25 - s_lev0) / 2;
+        const bool out = k<0 or k>nlevs-1;
+        REQUIRE (v1_tgt_h(icol,icmp)==Approx(out ? mask_val : k));
+      }
+    }
+  }
+
+  SECTION ("extrapolate") {
+    // Decreasing coordinate (like height), with constant extrapolation
+    auto z = make_field("z",{COL,ILEV},{ncols,nlevs});
+    auto z_h = z.get_view<Real**,Host>();
+    for (int icol=0; icol<ncols; ++icol) {
+      for (int k=0; k<nlevs; ++k) {
+        z_h(icol,k) = nlevs-k;
+      }
+    }
+    z.sync_to_dev();
+
+    Weights w(x_tgt,Weights::OutOfBounds::Extrapolate);
+    w.compute(z);
+    auto s_tgt = make_field("s_tgt",{COL,LEV},{ncols,ntgt});
+    w.apply({s},{s_tgt},mask_val);
+    s_tgt.sync_to_host();
+    auto s_tgt_h = s_tgt.get_view<const Real**,Host>();
+    for (int icol=0; icol<ncols; ++icol) {
+      for (int j=0; j<ntgt; ++j) {
+        // z=x_tgt[j] corresponds to level nlevs-x_tgt[j], clipped to [0,nlevs-1]
+        const Real lev = std::min(std::max(nlevs-x_tgt[j],Real(0)),Real(nlevs-1));
+        const int k0 = static_cast<int>(lev);
+        const Real s_lev = k0==nlevs-1 ? s_h(icol,k0)
+                                       : s_h(icol,k0) + (lev-k0)*(s_h(icol,k0+1)-s_h(icol,k0));
+        REQUIRE (s_tgt_h(icol,j)==Approx(s_lev));
+      }
+    }
+  }
+}
@@ -30,6 +30,11 @@ TimeInterpolation::TimeInterpolation(
 void TimeInterpolation::finalize()
 {
   if (m_is_data_from_file) {
+    if (m_prefetch_atm_input) {
+      // Note: finalize waits for any pending prefetch
+      m_prefetch_atm_input->finalize();
+      m_prefetch_atm_input = nullptr;
+    }
     m_file_data_atm_input.finalize();
     m_is_data_from_file=false;
   }
@@ -48,19 +53,7 @@ void TimeInterpolation::finalize()
  */
 void TimeInterpolation::perform_time_interpolation(const TimeStamp& time_in)
 {
-  // Declare the output map
-  std::map<std::string,Field> interpolated_fields;
-
-  // If data is handled by files we need to check that the timestamps are still relevant
-  if (m_file_data_triplets.size()>0) {
-    check_and_update_data(time_in);
-  }
-
-  // Gather weights for interpolation.  Note, timestamp differences are integers and we need a
-  // real defined weight.
-  const Real w_num = m_time1 - time_in;
-  const Real w_den = m_time1 - m_time0;
-  const Real weight0 = w_num/w_den;
+  const Real weight0 = update_data_and_get_weight(time_in);
   const Real weight1 = 1.0-weight0;
 
   // Cycle through all stored fields and conduct the time interpolation
@@ -74,6 +67,30 @@ void TimeInterpolation::perform_time_interpolation(const TimeStamp& time_in)
   }
 }
 /*-----------------------------------------------------------------------------------------------*/
+/* Function which updates the two time snaps of data so that they bracket the input time, and
+ * returns the interpolation weight w of the first snap (see perform_time_interpolation).
+ * Callers that fuse the time interpolation into their own kernels use this function together
+ * with get_field_time0/get_field_time1, rather than perform_time_interpolation, so that the
+ * interpolated fields are never computed.
+ * Input:
+ *   time_in - A timestamp to interpolate onto.
+ * Output
+ *   The weight w of the snap at time0; the weight of the snap at time1 is 1-w.
+ */
+Real TimeInterpolation::update_data_and_get_weight(const TimeStamp& time_in)
+{
+  // If data is handled by files we need to check that the timestamps are still relevant
+  if (m_file_data_triplets.size()>0) {
+    check_and_update_data(time_in);
+  }
+
+  // Gather weights for interpolation.  Note, timestamp differences are integers and we need a
+  // real defined weight.
+  const Real w_num = m_time1 - time_in;
+  const Real w_den = m_time1 - m_time0;
+  return w_num/w_den;
+}
+/*-----------------------------------------------------------------------------------------------*/
 /* Function which registers a field in the local field managers.
  * Input:
  *   field_in - Is a field with the appropriate dimensions and metadata to match the interpolation
@@ -103,6 +120,21 @@ void TimeInterpolation::add_field(const Field& field_in, const bool store_shallo
   m_field_names.push_back(name);
 }
 /*-----------------------------------------------------------------------------------------------*/
+/* Function which enables prefetching of the data from files.
+ * Input:
+ *   prefetch - Whether the next time snap of data should be read in the background.
+ * Output:
+ *   Whether prefetching is enabled.  It is only possible when the data comes from files and MPI
+ *   supports MPI_THREAD_MULTIPLE, since the reads call MPI from the async I/O thread.
+ */
+bool TimeInterpolation::set_prefetch(const bool prefetch)
+{
+  EKAT_REQUIRE_MSG(m_prefetch_idx<0 and not m_prefetch_atm_input,
+      "Error!! TimeInterpolation::set_prefetch - prefetching must be set before reading any data.\n");
+  m_prefetch = prefetch and m_is_data_from_file and scorpio::async_io_supported();
+  return m_prefetch;
+}
+/*-----------------------------------------------------------------------------------------------*/
 /* Function to shift all data from time1 to time0, update timestamp for time0
  */
 void TimeInterpolation::shift_data()
@@ -308,10 +340,18 @@ void TimeInterpolation::set_file_data_triplets(const vos_type& list_of_files) {
 /*-----------------------------------------------------------------------------------------------*/
 /* Function to read a new set of data from file using the current iterator pointing to the current
  * DataFromFileTriplet.
+ * If prefetching is enabled, the data may already be in the standby fields, in which case it is
+ * simply copied, and the data of the following triplet is prefetched.
  */
 void TimeInterpolation::read_data()
 {
   const auto triplet_curr = m_file_data_triplets[m_triplet_idx];
+  if (m_prefetch_idx==m_triplet_idx) {
+    copy_prefetched_data();
+    m_time1 = triplet_curr.timestamp;
+    prefetch_data(m_triplet_idx+1);
+    return;
+  }
   if (triplet_curr.filename != m_file_data_atm_input.get_filename()) {
     // Then we need to close this input stream and open a new one
     m_file_data_atm_input.finalize();
@@ -330,6 +370,72 @@ void TimeInterpolation::read_data()
   }
   m_file_data_atm_input.read_variables(triplet_curr.time_idx);
   m_time1 = triplet_curr.timestamp;
+  if (m_prefetch) {
+    prefetch_data(m_triplet_idx+1);
+  }
+}
+/*-----------------------------------------------------------------------------------------------*/
+/* Function to start reading the data of a triplet into the standby fields on the async I/O thread.
+ * Input:
+ *   triplet_idx - The index of the DataFromFileTriplet to read.
+ *
+ * Only the read runs on the async thread: the standby fields and the input stream (which
+ * registers the file and the decompositions) are set up here, when a new file is reached.
+ */
+void TimeInterpolation::prefetch_data(const int triplet_idx)
+{
+  if (triplet_idx>=static_cast<int>(m_file_data_triplets.size())) {
+    // Nothing left to prefetch
+    return;
+  }
+  const auto& triplet = m_file_data_triplets[triplet_idx];
+  if (m_standby_fields.size()==0) {
+    for (const auto& name : m_field_names) {
+      Field standby(m_fm_time1->get_field(name).get_header().get_identifier());
+      standby.allocate_view();
+      m_standby_fields.emplace(name,standby);
+    }
+  }
+  if (not m_prefetch_atm_input or triplet.filename != m_prefetch_atm_input->get_filename()) {
+    if (m_prefetch_atm_input) {
+      m_prefetch_atm_input->finalize();
+    }
+    std::map<std::string,AtmosphereInput::view_1d_host> host_views;
+    std::map<std::string,FieldLayout> layouts;
+    for (const auto& it : m_standby_fields) {
+      const auto& fl = it.second.get_header().get_identifier().get_layout();
+      host_views[it.first] = AtmosphereInput::view_1d_host(it.second.get_internal_view_data<Real,Host>(),fl.size());
+      layouts.emplace(it.first,fl);
+    }
+    ekat::ParameterList input_params;
+    input_params.set("Filename",triplet.filename);
+    m_prefetch_atm_input = std::make_shared<AtmosphereInput>(input_params,m_fm_time1->get_grid(),host_views,layouts);
+    for (const auto& name : m_field_names) {
+      scorpio::get_variable_metadata(triplet.filename,name,"_FillValue",m_standby_fill_values[name]);
+    }
+  }
+  auto input = m_prefetch_atm_input;
+  const int time_idx = triplet.time_idx;
+  scorpio::read_async([input,time_idx]() {
+    input->read_variables(time_idx);
+  });
+  m_prefetch_idx = triplet_idx;
+}
+/*-----------------------------------------------------------------------------------------------*/
+/* Function to copy the prefetched data from the standby fields to the time1 fields, once the
+ * read is complete.
+ */
+void TimeInterpolation::copy_prefetched_data()
+{
+  scorpio::wait_for_async_io();
+  for (auto& it : m_standby_fields) {
+    auto& standby = it.second;
+    standby.sync_to_dev();
+    auto& field1 = m_fm_time1->get_field(it.first);
+    field1.deep_copy(standby);
+    field1.get_header().set_extra_data("mask_value",m_standby_fill_values.at(it.first));
+  }
+  m_prefetch_idx = -1;
 }
 /*-----------------------------------------------------------------------------------------------*/
 /* Function to check the current set of interpolation data against a timestamp and, if needed,
@@ -32,15 +32,30 @@ public:
   void update_data_from_field(const Field& field_in);
   void update_timestamp(const TimeStamp& ts_in);
   void perform_time_interpolation(const TimeStamp& time_in);
+  Real update_data_and_get_weight(const TimeStamp& time_in);
   void finalize();
 
   // Build interpolator
   void add_field(const Field& field_in, const bool store_shallow_copy=false);
 
+  // When reading data from files, read the next time snap of data on the async I/O thread
+  // (see scorpio::read_async) while the model runs, so that crossing a time snap does not
+  // stall on the file read. Must be called before initialize_data_from_files. Requires MPI
+  // to support MPI_THREAD_MULTIPLE: returns whether prefetching is enabled.
+  bool set_prefetch(const bool prefetch);
+
   // Getters
   Field get_field(const std::string& name) {
     return m_interp_fields.at(name);
   };
+  // The data at the two time snaps, for callers that interpolate in their own kernels
+  // (see update_data_and_get_weight)
+  Field get_field_time0(const std::string& name) const {
+    return m_fm_time0->get_field(name);
+  };
+  Field get_field_time1(const std::string& name) const {
+    return m_fm_time1->get_field(name);
+  };
 
   // Informational
   void print();
@@ -69,6 +84,10 @@ protected:
   void read_data();
   void check_and_update_data(const TimeStamp& ts_in);
 
+  // Helper functions for prefetching the data of a triplet into the standby fields
+  void prefetch_data(const int triplet_idx);
+  void copy_prefetched_data();
+
   // Local field managers used to store two time snaps of data for interpolation
   fm_type  m_fm_time0;
   fm_type  m_fm_time1;
@@ -85,6 +104,14 @@ protected:
   AtmosphereInput                            m_file_data_atm_input;
   bool                                       m_is_data_from_file=false;
 
+  // Variables related to prefetching data from file. The standby fields are not padded,
+  // so that the input stream can read directly into their host views.
+  bool                                       m_prefetch=false;
+  int                                        m_prefetch_idx=-1;
+  std::map<std::string,Field>                m_standby_fields;
+  std::map<std::string,float>                m_standby_fill_values;
+  std::shared_ptr<AtmosphereInput>           m_prefetch_atm_input;
+
 
 }; // class TimeInterpolation
 
@@ -0,0 +1,374 @@
+#include "share/util/eamxx_vertical_interp_weights.hpp"
+
+#include <ekat/kokkos/ekat_kokkos_utils.hpp>
+
+#include <sstream>
+
+namespace scream {
+namespace vinterp {
+
+namespace {
+
+// Pointer and strides of a field of rank<=3 seen as a (ncols,ncmps,nlevs) array,
+// taking into account padding and (if a subfield) the layout of the parent.
+struct FieldStrides {
+  int col_stride = 0;
+  int cmp_stride = 0;
+  int offset     = 0;
+};
+
+FieldStrides get_strides (const Field& f)
+{
+  const auto& fh = f.get_header();
+  const auto& fap = fh.get_alloc_properties();
+  const auto& layout = fh.get_identifier().get_layout();
+  const int rank = layout.rank();
+
+  FieldStrides s;
+  auto p = fh.get_parent().lock();
+  if (p) {
+    const auto& sv_info = fap.get_subview_info();
+    const auto& p_layout = p->get_identifier().get_layout();
+    const int p_last = p->get_alloc_properties().get_last_extent();
+    EKAT_REQUIRE_MSG (p->get_parent().lock()==nullptr,
+        "Error! VerticalInterpWeights does not support subfields of other subfields.\n"
+        " - field name: " + f.name() + "\n");
+    EKAT_REQUIRE_MSG (sv_info.dim_idx==1 and p_layout.rank()<=3,
+        "Error! VerticalInterpWeights only supports subfields along the 2nd dim of a rank 2 or 3 field.\n"
+        " - field name: " + f.name() + "\n"
+        " - parent layout: " + to_string(p_layout) + "\n");
+    if (p_layout.rank()==2) {
+      // Parent is (COL,CMP), subfield is (COL)
+      s.col_stride = p_last;
+      s.offset = sv_info.slice_idx;
+    } else {
+      // Parent is (COL,CMP,LEV), subfield is (COL,LEV)
+      s.col_stride = sv_info.dim_extent*p_last;
+      s.offset = sv_info.slice_idx*p_last;
+    }
+    return s;
+  }
+
+  switch (rank) {
+    case 1:
+      s.col_stride = 1;
+      break;
+    case 2:
+      s.col_stride = fap.get_last_extent();
+      s.cmp_stride = 1;
+      break;
+    case 3:
+      s.col_stride = layout.dim(1)*fap.get_last_extent();
+      s.cmp_stride = fap.get_last_extent();
+      break;
+    default:
+      EKAT_ERROR_MSG ("Error! Unsupported field rank in VerticalInterpWeights.\n"
+                      " - field name: " + f.name() + "\n"
+                      " - field layout: " + to_string(layout) + "\n");
+  }
+  return s;
+}
+
+} // anonymous namespace
+
+VerticalInterpWeights::
+VerticalInterpWeights (const std::vector<Real>& x_tgt,
+                       const OutOfBounds oob)
+ : m_oob (oob)
+{
+  EKAT_REQUIRE_MSG (x_tgt.size()>0,
+      "Error! VerticalInterpWeights requires at least one tgt value.\n");
+
+  m_x_tgt = view_1d<Real>("x_tgt",x_tgt.size());
+  auto x_tgt_h = Kokkos::create_mirror_view(m_x_tgt);
+  for (size_t i=0; i<x_tgt.size(); ++i) {
+    x_tgt_h(i) = x_tgt[i];
+  }
+  Kokkos::deep_copy(m_x_tgt,x_tgt_h);
+}
+
+std::shared_ptr<VerticalInterpWeights>
+VerticalInterpWeights::
+get_shared_weights (const Field& x_src,
+                    const std::vector<Real>& x_tgt,
+                    const OutOfBounds oob)
+{
+  using ptr_t = std::shared_ptr<VerticalInterpWeights>;
+
+  // Store the weights in the coordinate header, so that they are visible
+  // to all objects that use this field, under a key built from the tgt values
+  std::stringstream key;
+  key.precision(17);
+  key << "vinterp weights:" << (oob==OutOfBounds::Mask ? "mask" : "extrap");
+  for (auto x : x_tgt) {
+    key << " " << x;
+  }
+
+  auto& fh = *x_src.get_header_ptr();
+  if (not fh.has_extra_data(key.str())) {
+    fh.set_extra_data(key.str(),std::make_shared<VerticalInterpWeights>(x_tgt,oob));
+  }
+  return fh.get_extra_data<ptr_t>(key.str());
+}
+
+void VerticalInterpWeights::compute (const Field& x_src)
+{
+  using namespace ShortFieldTagsNames;
+  using RangePolicy = typename KT::RangePolicy;
+
+  const auto& fh = x_src.get_header();
+  const auto& layout = fh.get_identifier().get_layout();
+  EKAT_REQUIRE_MSG (layout.rank()==2 and layout.tag(0)==COL and
+                    (layout.tag(1)==LEV or layout.tag(1)==ILEV),
+      "Error! VerticalInterpWeights expects a (COL,LEV) or (COL,ILEV) src coordinate.\n"
+      " - field name: " + x_src.name() + "\n"
+      " - field layout: " + to_string(layout) + "\n");
+
+  // Nothing to do if the coordinate did not change since last call
+  const auto x = x_src.get_view<const Real**>();
+  const auto& ts = fh.get_tracking().get_time_stamp();
+  const int ncols = layout.dim(0);
+  const int nlevs = layout.dim(1);
+  if (ts.is_valid() and ts==m_x_src_ts and x.data()==m_x_src_data and
+      nlevs==m_x_src_nlevs and m_idx.extent_int(0)==ncols) {
+    return;
+  }
+
+  const int ntgt = num_tgt_levs();
+  if (m_idx.extent_int(0)!=ncols) {
+    m_idx = view_2d<int>("vinterp_idx",ncols,ntgt);
+    m_w   = view_2d<Real>("vinterp_w",ncols,ntgt);
+  }
+
+  auto idx = m_idx;
+  auto w = m_w;
+  auto x_tgt = m_x_tgt;
+  const bool mask = m_oob==OutOfBounds::Mask;
+  auto lambda = KOKKOS_LAMBDA (const int i) {
+    const int icol = i / ntgt;
+    const int j    = i % ntgt;
+
+    // Work with s*x, which is always increasing
+    const Real s  = x(icol,nlevs-1)<x(icol,0) ? -1 : 1;
+    const Real t  = x_tgt(j);
+    const Real st = s*t;
+    if (st<s*x(icol,0) or st>s*x(icol,nlevs-1)) {
+      if (mask) {
+        idx(icol,j) = -1;
+        w(icol,j) = 0;
+      } else {
+        idx(icol,j) = st<s*x(icol,0) ? 0 : nlevs-1;
+        w(icol,j) = 1;
+      }
+      return;
+    }
+
+    // Find the largest k in [0,nlevs-2] such that s*x(k)<=s*t
+    int lo = 0, hi = nlevs-1;
+    while (hi-lo>1) {
+      const int mid = (lo+hi)/2;
+      if (s*x(icol,mid)<=st) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    idx(icol,j) = lo;
+    if (nlevs==1 or x(icol,lo+1)==x(icol,lo)) {
+      w(icol,j) = 1;
+    } else {
+      w(icol,j) = (x(icol,lo+1)-t) / (x(icol,lo+1)-x(icol,lo));
+    }
+  };
+  Kokkos::parallel_for("VerticalInterpWeights::compute",
+                       RangePolicy(0,ncols*ntgt),lambda);
+  Kokkos::fence();
+
+  m_x_src_ts = ts;
+  m_x_src_data = x.data();
+  m_x_src_nlevs = nlevs;
+}
+
+auto VerticalInterpWeights::
+make_entry (const Field& src, const Field& tgt) const -> Entry
+{
+  EKAT_REQUIRE_MSG (m_x_src_nlevs>0,
+      "Error! VerticalInterpWeights::compute must be called before applying the weights.\n");
+
+  const auto& s_layout = src.get_header().get_identifier().get_layout();
+  const auto& t_layout = tgt.get_header().get_identifier().get_layout();
+  const int ntgt = num_tgt_levs();
+  const bool tgt_has_levs = t_layout.rank()==s_layout.rank();
+  EKAT_REQUIRE_MSG ((s_layout.rank()==2 or s_layout.rank()==3) and
+                    s_layout.dims().back()==m_x_src_nlevs and
+                    s_layout.dim(0)==m_idx.extent_int(0),
+      "Error! Src field layout not compatible with the interpolation weights.\n"
+      " - src name: " + src.name() + "\n"
+      " - src layout: " + to_string(s_layout) + "\n"
+      " - num src levels: " + std::to_string(m_x_src_nlevs) + "\n");
+  EKAT_REQUIRE_MSG ((tgt_has_levs and t_layout.dims().back()==ntgt) or
+                    (t_layout.rank()==s_layout.rank()-1 and ntgt==1),
+      "Error! Tgt field layout not compatible with the interpolation weights.\n"
+      " - tgt name: " + tgt.name() + "\n"
+      " - tgt layout: " + to_string(t_layout) + "\n"
+      " - num tgt levels: " + std::to_string(ntgt) + "\n");
+
+  // Src and tgt are seen as (ncols,ncmps,nlevs). When tgt has no level dim,
+  // its "cmp" dimension is the last one (or absent).
+  const auto ss = get_strides(src);
+  const auto ts = get_strides(tgt);
+  Entry e;
+  e.src = src.get_internal_view_data<const Real>() + ss.offset;
+  e.tgt = tgt.get_internal_view_data<Real>() + ts.offset;
+  e.ncmps = s_layout.rank()==3 ? s_layout.dim(1) : 1;
+  e.src_col_stride = ss.col_stride;
+  e.src_cmp_stride = ss.cmp_stride;
+  e.tgt_col_stride = ts.col_stride;
+  e.tgt_cmp_stride = tgt_has_levs ? ts.cmp_stride : 1;
+  return e;
+}
+
+void VerticalInterpWeights::
+apply (const std::vector<Field>& src,
+       const std::vector<Field>& tgt,
+       const Real mask_val) const
+{
+  apply(src,tgt,{},mask_val);
+}
+
+void VerticalInterpWeights::
+apply (const std::vector<Field>& src,
+       const std::vector<Field>& tgt,
+       const std::vector<Field>& masks,
+       const Real mask_val) const
+{
+  EKAT_REQUIRE_MSG (src.size()==tgt.size(),
+      "Error! VerticalInterpWeights::apply requires the same number of src and tgt fields.\n");
+
+  std::vector<Entry> entries;
+  for (size_t i=0; i<src.size(); ++i) {
+    entries.push_back(make_entry(src[i],tgt[i]));
+  }
+  for (const auto& m : masks) {
+    entries.push_back(make_mask_entry(m));
+  }
+  apply_impl(entries,mask_val);
+}
+
+void VerticalInterpWeights::
+compute_mask (const Field& mask) const
+{
+  apply_impl({make_mask_entry(mask)},0);
+}
+
+auto VerticalInterpWeights::
+make_mask_entry (const Field& mask) const -> Entry
+{
+  using namespace ShortFieldTagsNames;
+
+  EKAT_REQUIRE_MSG (m_x_src_nlevs>0,
+      "Error! VerticalInterpWeights::compute must be called before computing the mask.\n");
+
+  // The mask has the layout of a tgt field, with or without the tgt levels dim
+  const auto& layout = mask.get_header().get_identifier().get_layout();
+  const int rank = layout.rank();
+  const auto last_tag = layout.tags().back();
+  const bool has_levs = rank>=2 and (last_tag==LEV or last_tag==ILEV);
+  EKAT_REQUIRE_MSG ((has_levs and layout.dims().back()==num_tgt_levs()) or
+                    (not has_levs and rank<=2 and num_tgt_levs()==1),
+      "Error! Mask field layout not compatible with the interpolation weights.\n"
+      " - mask name: " + mask.name() + "\n"
+      " - mask layout: " + to_string(layout) + "\n"
+      " - num tgt levels: " + std::to_string(num_tgt_levs()) + "\n");
+  const auto ms = get_strides(mask);
+  Entry e;
+  e.src = nullptr;
+  e.tgt = mask.get_internal_view_data<Real>() + ms.offset;
+  e.ncmps = (has_levs ? rank==3 : rank==2) ? layout.dim(1) : 1;
+  e.src_col_stride = 0;
+  e.src_cmp_stride = 0;
+  e.tgt_col_stride = ms.col_stride;
+  e.tgt_cmp_stride = has_levs ? ms.cmp_stride : 1;
+  return e;
+}
+
+auto VerticalInterpWeights::
+get_device_entries (const std::vector<Entry>& entries) const -> const DeviceEntries&
+{
+  // The entries only change if the fields do (or are reallocated), so they are
+  // usually found in the list of those copied on device by earlier calls
+  for (const auto& de : m_device_entries) {
+    if (de.entries==entries) {
+      return de;
+    }
+  }
+
+  const int nentries = entries.size();
+  DeviceEntries de;
+  de.entries = entries;
+  de.d_entries = decltype(de.d_entries)("vinterp_entries",nentries);
+  de.max_ncmps = 1;
+  auto h_entries = Kokkos::create_mirror_view(de.d_entries);
+  for (int i=0; i<nentries; ++i) {
+    h_entries(i) = entries[i];
+    de.max_ncmps = std::max(de.max_ncmps,entries[i].ncmps);
+  }
+  Kokkos::deep_copy(de.d_entries,h_entries);
+
+  m_device_entries.push_back(de);
+  return m_device_entries.back();
+}
+
+void VerticalInterpWeights::
+apply_impl (const std::vector<Entry>& entries,
+            const Real mask_val) const
+{
+  using ESU = ekat::ExeSpaceUtils<typename KT::ExeSpace>;
+  using MemberType = typename KT::MemberType;
+
+  const int nentries = entries.size();
+  if (nentries==0) {
+    return;
+  }
+
+  // Get the entries on device
+  const auto& de = get_device_entries(entries);
+  const auto d_entries = de.d_entries;
+  const int max_ncmps = de.max_ncmps;
+
+  const int ncols = m_idx.extent_int(0);
+  const int ntgt  = num_tgt_levs();
+  auto idx = m_idx;
+  auto w = m_w;
+
+  // One team per (entry,col), with threads over the (cmp,tgt) entries
+  auto policy = ESU::get_default_team_policy(nentries*ncols,max_ncmps*ntgt);
+  auto lambda = KOKKOS_LAMBDA (const MemberType& team) {
+    const int ie   = team.league_rank() / ncols;
+    const int icol = team.league_rank() % ncols;
+    const auto& e = d_entries(ie);
+    auto tgt_col = e.tgt + icol*e.tgt_col_stride;
+    auto src_col = e.src==nullptr ? e.src : e.src + icol*e.src_col_stride;
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team,e.ncmps*ntgt),
+                         [&](const int i) {
+      const int icmp = i / ntgt;
+      const int j    = i % ntgt;
+      const int k    = idx(icol,j);
+      Real& y = tgt_col[icmp*e.tgt_cmp_stride + j];
+      if (e.src==nullptr) {
+        y = k<0 ? 0 : 1;
+      } else if (k<0) {
+        y = mask_val;
+      } else {
+        const Real wk = w(icol,j);
+        const auto y_src = src_col + icmp*e.src_cmp_stride;
+        y = wk==1 ? y_src[k] : wk*y_src[k] + (1-wk)*y_src[k+1];
+      }
+    });
+  };
+  Kokkos::parallel_for("VerticalInterpWeights::apply",policy,lambda);
+  Kokkos::fence();
+}
+
+} // namespace vinterp
+} // namespace scream
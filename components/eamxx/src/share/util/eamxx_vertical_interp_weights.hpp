@@ -0,0 +1,147 @@
+#ifndef EAMXX_VERTICAL_INTERP_WEIGHTS_HPP
+#define EAMXX_VERTICAL_INTERP_WEIGHTS_HPP
+
+#include "share/field/field.hpp"
+#include "share/util/scream_time_stamp.hpp"
+
+namespace scream {
+namespace vinterp {
+
+/*
+ * Weights for the linear interpolation of column data from the src vertical
+ * coordinate (e.g., p_mid, z_int) to a fixed set of tgt coordinate values.
+ *
+ * For each column and tgt value, the class stores the index k of the src level
+ * bracketing the tgt from above/below and the weight w, so that
+ *
+ *    y_tgt = w*y_src(k) + (1-w)*y_src(k+1)
+ *
+ * Tgt values outside the range of the src coordinate are either masked (k<0),
+ * or set to the value at the nearest end of the column (constant extrapolation).
+ * The src coordinate can be increasing (e.g., pressure) or decreasing (e.g., height).
+ *
+ * The bracket search is the expensive part of the interpolation, and it only
+ * depends on the coordinate. Hence, the weights are computed once, and recomputed
+ * only if the coordinate field time stamp changes (or is not valid). They can then
+ * be applied to several fields at once, with a single kernel launch.
+ *
+ * Objects interpolating to the same tgt values with the same coordinate field
+ * can share their weights via get_shared_weights, which stores them in the
+ * extra data of the coordinate field header.
+ */
+
+class VerticalInterpWeights
+{
+public:
+  using KT = KokkosTypes<DefaultDevice>;
+
+  template<typename T>
+  using view_1d = typename KT::template view_1d<T>;
+  template<typename T>
+  using view_2d = typename KT::template view_2d<T>;
+
+  enum class OutOfBounds {
+    Mask,         // Set tgt to mask value
+    Extrapolate   // Set tgt to the value at the first/last src level
+  };
+
+  VerticalInterpWeights (const std::vector<Real>& x_tgt,
+                         const OutOfBounds oob);
+
+  // Get the weights for the given coordinate field and tgt values, creating
+  // them if no other object requested them before.
+  static std::shared_ptr<VerticalInterpWeights>
+  get_shared_weights (const Field& x_src,
+                      const std::vector<Real>& x_tgt,
+                      const OutOfBounds oob);
+
+  // Compute the weights for the src coordinate x_src, with layout (COL,LEV)
+  // or (COL,ILEV), unless they are already up to date.
+  void compute (const Field& x_src);
+
+  // Interpolate src[i] into tgt[i] for all i, in a single kernel.
+  // The src fields must have a layout ending with the levels of x_src.
+  // The tgt fields have the same layout as the src, with the last dimension
+  // equal to the number of tgt values, or stripped, if there is only one tgt value.
+  // Subfields are supported, as long as they are slices of the second dimension.
+  void apply (const std::vector<Field>& src,
+              const std::vector<Field>& tgt,
+              const Real mask_val) const;
+
+  // Same as above, but also computes the given masks (see compute_mask),
+  // all in the same kernel as the interpolation.
+  void apply (const std::vector<Field>& src,
+              const std::vector<Field>& tgt,
+              const std::vector<Field>& masks,
+              const Real mask_val) const;
+
+  // Set the entries of the field mask to 1 where the tgt value is within the
+  // src range, and 0 otherwise. The layout of mask follows the same rules
+  // as the tgt fields of apply.
+  void compute_mask (const Field& mask) const;
+
+  int num_tgt_levs () const { return m_x_tgt.extent_int(0); }
+
+  view_2d<const int>  get_indices () const { return m_idx; }
+  view_2d<const Real> get_weights () const { return m_w; }
+
+protected:
+
+  // Data layout of one src/tgt pair, seen as (ncols,ncmps,nlevs) arrays.
+  // A null src marks a mask entry.
+  struct Entry {
+    const Real* src;
+    Real*       tgt;
+    int ncmps;
+    int src_col_stride;
+    int src_cmp_stride;
+    int tgt_col_stride;
+    int tgt_cmp_stride;
+
+    bool operator== (const Entry& rhs) const {
+      return src==rhs.src and tgt==rhs.tgt and ncmps==rhs.ncmps and
+             src_col_stride==rhs.src_col_stride and src_cmp_stride==rhs.src_cmp_stride and
+             tgt_col_stride==rhs.tgt_col_stride and tgt_cmp_stride==rhs.tgt_cmp_stride;
+    }
+  };
+
+  // Device copy of a list of entries, built once per list of fields
+  struct DeviceEntries {
+    std::vector<Entry>                    entries;
+    typename KT::template view_1d<Entry>  d_entries;
+    int                                   max_ncmps;
+  };
+
+  Entry make_entry (const Field& src, const Field& tgt) const;
+  Entry make_mask_entry (const Field& mask) const;
+  const DeviceEntries& get_device_entries (const std::vector<Entry>& entries) const;
+
+#ifdef KOKKOS_ENABLE_CUDA
+public:
+#endif
+  void apply_impl (const std::vector<Entry>& entries,
+                   const Real mask_val) const;
+protected:
+
+  view_1d<Real>     m_x_tgt;
+  OutOfBounds       m_oob;
+
+  // Weights: (ncols,ntgt) views
+  view_2d<int>      m_idx;
+  view_2d<Real>     m_w;
+
+  // Info on the coordinate the weights were computed for
+  const Real*       m_x_src_data = nullptr;
+  util::TimeStamp   m_x_src_ts;
+  int               m_x_src_nlevs = -1;
+
+  // Device copies of the entries of the lists of fields applied so far, so that
+  // apply does not allocate and copy them at every call. Since the weights can
+  // be shared, there may be one list per user.
+  mutable std::vector<DeviceEntries> m_device_entries;
+};
+
+} // namespace vinterp
+} // namespace scream
+
+#endif // EAMXX_VERTICAL_INTERP_WEIGHTS_HPP
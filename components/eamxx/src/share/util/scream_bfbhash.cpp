@@ -21,5 +21,15 @@ int all_reduce_HashType (MPI_Comm comm, const HashType* sendbuf, HashType* rcvbu
   return stat;
 }
 
+int iall_reduce_HashType (MPI_Comm comm, const HashType* sendbuf, HashType* rcvbuf,
+                          int count, MPI_Request* request) {
+  // The op must stay valid until the request completes, so we create it
+  // once, and let MPI free it at finalization.
+  static MPI_Op op = MPI_OP_NULL;
+  if (op == MPI_OP_NULL) MPI_Op_create(reduce_hash, true, &op);
+  return MPI_Iallreduce(sendbuf, rcvbuf, count, MPI_LONG_LONG_INT, op, comm,
+                        request);
+}
+
 } // namespace bfbhash
 } // namespace scream
@@ -50,6 +50,11 @@ private:
 int all_reduce_HashType(MPI_Comm comm, const HashType* sendbuf, HashType* rcvbuf,
                         int count);
 
+// Non-blocking version of the above. The buffers must not be touched until
+// the request is completed (e.g., with MPI_Wait).
+int iall_reduce_HashType(MPI_Comm comm, const HashType* sendbuf, HashType* rcvbuf,
+                         int count, MPI_Request* request);
+
 } // namespace bfbhash
 } // namespace scream
 
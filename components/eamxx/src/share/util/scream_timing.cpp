@@ -1,5 +1,7 @@
 #include "share/util/scream_timing.hpp"
 
+#include <Kokkos_Core.hpp>
+
 #include <gptl.h>
 
 namespace scream {
@@ -24,6 +26,16 @@ void stop_timer (const std::string& name) {
   GPTLstop(name.c_str());
 }
 
+void start_timer (const std::string& name, timer_handle_t& handle) {
+  GPTLstart_handle(name.c_str(),&handle);
+  Kokkos::Profiling::pushRegion(name);
+}
+
+void stop_timer (const std::string& name, timer_handle_t& handle) {
+  Kokkos::Profiling::popRegion();
+  GPTLstop_handle(name.c_str(),&handle);
+}
+
 void write_timers_to_file (const ekat::Comm& comm, const std::string& fname) {
   GPTLpr_summary_file (comm.mpi_comm(),fname.c_str());
 }
@@ -15,6 +15,17 @@ void finalize_gptl ();
 void start_timer (const std::string& name);
 void stop_timer (const std::string& name);
 
+// Same as above, but the caller keeps a GPTL handle for the timer (initially
+// null), so that GPTL does not hash the name at each call. Meant for timers
+// that are started/stopped at every step. These also mark the timed region
+// for Kokkos Tools, so that tool-based profilers can attribute device work
+// to it without the need for fences. Calls must be properly nested.
+// GPTL timers are per thread: a handle set by one thread is ignored by the
+// others, which fall back to the name lookup.
+using timer_handle_t = void*;
+void start_timer (const std::string& name, timer_handle_t& handle);
+void stop_timer (const std::string& name, timer_handle_t& handle);
+
 void write_timers_to_file (const ekat::Comm& comm, const std::string& fname);
 
 } // namespace scream
@@ -6,6 +6,12 @@
 #include <sys/resource.h>
 #endif
 
+#if defined(KOKKOS_ENABLE_CUDA)
+#include <cuda_runtime.h>
+#elif defined(KOKKOS_ENABLE_HIP)
+#include <hip/hip_runtime.h>
+#endif
+
 namespace scream {
 
 long long get_mem_usage (const MemoryUnits u) {
@@ -43,4 +49,17 @@ long long get_mem_usage (const MemoryUnits u) {
   return mem;
 }
 
+size_t get_device_mem_size () {
+  size_t free_mem = 0, total_mem = 0;
+#if defined(KOKKOS_ENABLE_CUDA)
+  EKAT_REQUIRE_MSG (cudaMemGetInfo(&free_mem,&total_mem)==cudaSuccess,
+      "Error! Could not query the device memory.\n");
+#elif defined(KOKKOS_ENABLE_HIP)
+  EKAT_REQUIRE_MSG (hipMemGetInfo(&free_mem,&total_mem)==hipSuccess,
+      "Error! Could not query the device memory.\n");
+#endif
+  (void) free_mem;
+  return total_mem;
+}
+
 } // namespace scream
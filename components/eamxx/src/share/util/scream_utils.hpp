@@ -36,6 +36,10 @@ cmvdc (const VT& v)
 // Gets current memory (RAM) usage by current process.
 long long get_mem_usage (const MemoryUnits u);
 
+// Gets the total memory (in bytes) of the device used by the default
+// execution space, or 0 if the default execution space is not a GPU.
+size_t get_device_mem_size ();
+
 // Micro-utility, that given an enum returns the underlying int.
 // The only use of this is if you need to sort scoped enums.
 template<typename EnumT>
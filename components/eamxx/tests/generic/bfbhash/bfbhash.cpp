@@ -51,6 +51,13 @@ TEST_CASE("bfbhash")
     REQUIRE(x != y); // but the hasher does
   }
 
+  { // Hashing is a sum modulo 2^64, so partial hashes can be combined with atomic adds.
+    const HashType a = 0xfedcba9876543210ULL, b = 0x8000000000000001ULL;
+    HashType x = a;
+    hash(b, x);
+    REQUIRE(x == a + b);
+  }
+
   testeq<float>();
   testeq<double>();
 
@@ -62,6 +69,12 @@ TEST_CASE("bfbhash")
     HashType c = 0;
     for (int i = 0, n = comm.size(); i < n; ++i) hash(HashType(i), c);
     REQUIRE(b == c);
+
+    HashType d;
+    MPI_Request req;
+    iall_reduce_HashType(MPI_COMM_WORLD, &a, &d, 1, &req);
+    MPI_Wait(&req, MPI_STATUS_IGNORE);
+    REQUIRE(d == c);
   }
 }
 
@@ -212,14 +212,14 @@ struct CaarFunctorImpl {
     }
 
     profiling_resume();
-    GPTLstart("caar compute");
+    start_timer("caar compute");
     Kokkos::parallel_for("caar loop pre-boundary exchange", m_policy, *this);
     Kokkos::fence();
-    GPTLstop("caar compute");
+    stop_timer("caar compute");
 
-    GPTLstart("caar_bexchV");
+    start_timer("caar_bexchV");
     m_bes[data.np1]->exchange(m_geometry.m_rspheremp);
-    GPTLstop("caar_bexchV");
+    stop_timer("caar_bexchV");
 
     profiling_pause();
   }
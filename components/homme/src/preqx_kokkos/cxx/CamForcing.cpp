@@ -147,7 +147,7 @@ void tracer_forcing(
 }
 
 void apply_cam_forcing(const Real &dt) {
-  GPTLstart("ApplyCAMForcing");
+  start_timer("ApplyCAMForcing");
   const Elements &elems = Context::singleton().get<Elements>();
   const TimeLevel &tl = Context::singleton().get<TimeLevel>();
 
@@ -162,15 +162,15 @@ void apply_cam_forcing(const Real &dt) {
   }
   tracer_forcing(tracers.fq, hvcoord, tl, tracers.num_tracers(),
                  sim_params.moisture, dt, elems.m_state.m_ps_v, tracers.qdp, tracers.Q);
-  GPTLstop("ApplyCAMForcing");
+  stop_timer("ApplyCAMForcing");
 }
 
 void apply_cam_forcing_dynamics(const Real &dt) {
-  GPTLstart("ApplyCAMForcing_dynamics");
+  start_timer("ApplyCAMForcing_dynamics");
   const Elements &elems = Context::singleton().get<Elements>();
   const TimeLevel &tl = Context::singleton().get<TimeLevel>();
   state_forcing(elems.m_forcing.m_ft, elems.m_forcing.m_fm, tl.n0, dt, elems.m_state.m_t, elems.m_state.m_v);
-  GPTLstop("ApplyCAMForcing_dynamics");
+  stop_timer("ApplyCAMForcing_dynamics");
 }
 
 } // namespace Homme
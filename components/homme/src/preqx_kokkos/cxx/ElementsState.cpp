@@ -16,12 +16,16 @@
 
 namespace Homme {
 
-void ElementsState::init(const int num_elems) {
+void ElementsState::init(const int num_elems, const bool alloc_storage) {
   // Sanity check
   assert (num_elems>0);
 
   m_num_elems = num_elems;
 
+  if (!alloc_storage) {
+    return;
+  }
+
   m_v    = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][2][NP][NP][NUM_LEV]>("Horizontal Velocity", m_num_elems);
   m_t    = ExecViewManaged<Scalar * [NUM_TIME_LEVELS]   [NP][NP][NUM_LEV]>("Temperature", m_num_elems);
   m_dp3d = ExecViewManaged<Scalar * [NUM_TIME_LEVELS]   [NP][NP][NUM_LEV]>("DP3D", m_num_elems);
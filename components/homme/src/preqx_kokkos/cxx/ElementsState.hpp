@@ -28,7 +28,7 @@ public:
 
   ElementsState() : m_num_elems(0) {}
 
-  void init(const int num_elems);
+  void init(const int num_elems, const bool alloc_storage = true);
 
   void randomize(const int seed);
   void randomize(const int seed, const Real max_pressure);
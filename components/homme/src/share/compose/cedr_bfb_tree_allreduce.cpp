@@ -105,15 +105,18 @@ void BfbTreeAllReducer<ES>
       for (Int j = 0; j < nf; ++j) d[j] = s[j];
     }
   }
-  // Leaves to root.
+  // Leaves to root. Post all the receives up front; see the comment in
+  // QLT::run for why this is safe.
   for (size_t il = 0; il < ns.levels.size(); ++il) {
     auto& lvl = ns.levels[il];
-    // Set up receives.
     for (size_t i = 0; i < lvl.kids.size(); ++i) {
       const auto& mmd = lvl.kids[i];
       mpi::irecv(*p_, &bd_[mmd.offset * nf], mmd.size * nf, mmd.rank, mpitag,
                  &lvl.kids_req[i]);
     }
+  }
+  for (size_t il = 0; il < ns.levels.size(); ++il) {
+    auto& lvl = ns.levels[il];
     mpi::waitall(lvl.kids_req.size(), lvl.kids_req.data());
     // Combine kids' data.
     for (const auto& idx : lvl.nodes) {
@@ -325,12 +325,16 @@ Int QLT<ES>::get_num_tracers () const {
 }
 
 template <typename ES> void QLT<ES>
-::l2r_recv (const tree::NodeSets::Level& lvl, const Int& l2rndps) const {
+::l2r_post_recv (const tree::NodeSets::Level& lvl, const Int& l2rndps) const {
   for (size_t i = 0; i < lvl.kids.size(); ++i) {
     const auto& mmd = lvl.kids[i];
     mpi::irecv(*p_, o.bd_.l2r_data.data() + mmd.offset*l2rndps, mmd.size*l2rndps,
                mmd.rank, tree::NodeSets::mpitag, &lvl.kids_req[i]);
   }
+}
+
+template <typename ES> void QLT<ES>
+::l2r_wait_recv (const tree::NodeSets::Level& lvl) const {
   Timer::start(Timer::waitall);
   mpi::waitall(lvl.kids_req.size(), lvl.kids_req.data());
   Timer::stop(Timer::waitall);
@@ -622,9 +626,20 @@ void QLT<ES>::run () {
   // Number of data per slot.
   const Int l2rndps = o.md_.a_h.prob2bl2r[o.md_.nprobtypes];
   const Int r2lndps = o.md_.a_h.prob2br2l[o.md_.nprobtypes];
+  // Post all the leaves-to-root receives up front, so that kids' data that
+  // arrive while this rank works on lower levels go directly to l2r_data
+  // rather than to MPI's unexpected-message queue. This is safe because each
+  // rank posts these receives, and sends the corresponding messages, in
+  // increasing level order, messages between two ranks with the same tag are
+  // matched in order, and all the r2l messages a rank sends come after its
+  // l2r messages.
+  for (size_t il = 0; il < ns_->levels.size(); ++il) {
+    const auto& lvl = ns_->levels[il];
+    if (lvl.kids.size()) l2r_post_recv(lvl, l2rndps);
+  }
   for (size_t il = 0; il < ns_->levels.size(); ++il) {
     auto& lvl = ns_->levels[il];
-    if (lvl.kids.size()) l2r_recv(lvl, l2rndps);
+    if (lvl.kids.size()) l2r_wait_recv(lvl);
     l2r_combine_kid_data(il, l2rndps);    
     if (lvl.me.size()) l2r_send_to_parents(lvl, l2rndps);
   }
@@ -209,7 +209,8 @@ protected:
   DeviceOp o;
 
 PRIVATE_CUDA:
-  void l2r_recv(const tree::NodeSets::Level& lvl, const Int& l2rndps) const;
+  void l2r_post_recv(const tree::NodeSets::Level& lvl, const Int& l2rndps) const;
+  void l2r_wait_recv(const tree::NodeSets::Level& lvl) const;
   void l2r_combine_kid_data(const Int& lvlidx, const Int& l2rndps) const;
   void l2r_send_to_parents(const tree::NodeSets::Level& lvl, const Int& l2rndps) const;
   void root_compute(const Int& l2rndps, const Int& r2lndps) const;
@@ -45,6 +45,11 @@ typedef Kokkos::Experimental::SYCL ComposeGpuSpace;
 // Look for MPI-related memory leaks.
 //#define COMPOSE_DEBUG_MPI
 
+// Exchange the SL departure point requests and q data with MPI-3 neighborhood
+// collectives on a distributed graph communicator rather than with
+// point-to-point messages.
+//#define COMPOSE_NEIGHBOR_COLL
+
 #if ! defined COMPOSE_PORT
 # if defined HORIZ_OPENMP
 #  define COMPOSE_HORIZ_OPENMP
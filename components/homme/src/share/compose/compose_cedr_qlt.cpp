@@ -214,21 +214,30 @@ void QLT<ES>::runimpl () {
     const Int l2rndps = md_.a_d.prob2bl2r[md_.nprobtypes];
     const Int r2lndps = md_.a_d.prob2br2l[md_.nprobtypes];
 
-    // Leaves to root.
+    // Leaves to root. Post all the receives up front, as in
+    // cedr::qlt::QLT::run.
+#if defined THREAD_QLT_RUN && defined COMPOSE_HORIZ_OPENMP
+#   pragma omp master
+#endif
+    {
+      for (size_t il = 0; il < ns_->levels.size(); ++il) {
+        auto& lvl = ns_->levels[il];
+        for (size_t i = 0; i < lvl.kids.size(); ++i) {
+          const auto& mmd = lvl.kids[i];
+          mpi::irecv(*p_, &bd_.l2r_data(mmd.offset*l2rndps), mmd.size*l2rndps, mmd.rank,
+                     mpitag, &lvl.kids_req[i]);
+        }
+      }
+    }
     for (size_t il = 0; il < ns_->levels.size(); ++il) {
       auto& lvl = ns_->levels[il];
 
-      // Set up receives.
+      // Wait on receives.
       if (lvl.kids.size()) {
 #if defined THREAD_QLT_RUN && defined COMPOSE_HORIZ_OPENMP
 #       pragma omp master
 #endif
         {
-          for (size_t i = 0; i < lvl.kids.size(); ++i) {
-            const auto& mmd = lvl.kids[i];
-            mpi::irecv(*p_, &bd_.l2r_data(mmd.offset*l2rndps), mmd.size*l2rndps, mmd.rank,
-                       mpitag, &lvl.kids_req[i]);
-          }
           mpi::waitall(lvl.kids_req.size(), lvl.kids_req.data());
         }
 #if defined THREAD_QLT_RUN && defined COMPOSE_HORIZ_OPENMP
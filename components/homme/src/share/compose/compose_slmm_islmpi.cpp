@@ -761,6 +761,9 @@ void alloc_mpi_buffers (IslMpi<MT>& cm, Real* sendbuf, Real* recvbuf) {
       omp_init_lock(&lock);
   }
 #endif  
+#ifdef COMPOSE_NEIGHBOR_COLL
+  init_neighbor_comm(cm);
+#endif
 }
 
 // At simulation initialization, set up a bunch of stuff to make the work at
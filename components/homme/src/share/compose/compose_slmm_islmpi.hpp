@@ -534,6 +534,13 @@ struct IslMpi {
 #endif
   FixedCapList<Int, DDT> sendcount, x_bulkdata_offset;
   ListOfLists<Real, HDT> sendbuf_meta_h, recvbuf_meta_h; // not mirrors
+#ifdef COMPOSE_NEIGHBOR_COLL
+  // Distributed graph comm over the remote ranks in 'ranks', and the counts
+  // and displacements, in Reals, of the neighborhood collectives.
+  MPI_Comm nbr_comm = MPI_COMM_NULL;
+  MPI_Request nbr_req = MPI_REQUEST_NULL;
+  std::vector<int> nbr_sendcount, nbr_senddispl, nbr_recvcount, nbr_recvdispl;
+#endif
   FixedCapList<Int, DDT> rmt_xs, rmt_qs_extrema;
   Int nrmt_xs, nrmt_qs_extrema;
 
@@ -570,6 +577,11 @@ struct IslMpi {
   IslMpi& operator=(const IslMpi&) = delete;
 
   ~IslMpi () {
+#ifdef COMPOSE_NEIGHBOR_COLL
+    int fin;
+    MPI_Finalized(&fin);
+    if ( ! fin && nbr_comm != MPI_COMM_NULL) MPI_Comm_free(&nbr_comm);
+#endif
 #ifdef COMPOSE_HORIZ_OPENMP
     const Int nrmtrank = static_cast<Int>(ranks.n()) - 1;
     for (Int ri = 0; ri < nrmtrank; ++ri) {
@@ -624,6 +636,10 @@ void analyze_dep_points(IslMpi<MT>& cm, const Int& nets, const Int& nete,
 
 template <typename MT>
 void init_mylid_with_comm_threaded(IslMpi<MT>& cm, const Int& nets, const Int& nete);
+#ifdef COMPOSE_NEIGHBOR_COLL
+template <typename MT>
+void init_neighbor_comm(IslMpi<MT>& cm);
+#endif
 template <typename MT>
 void setup_irecv(IslMpi<MT>& cm, const bool skip_if_empty = false);
 template <typename MT>
@@ -37,8 +37,81 @@ void init_mylid_with_comm_threaded (IslMpi<MT>& cm, const Int& nets, const Int&
 #endif
 }
 
+#ifdef COMPOSE_NEIGHBOR_COLL
+// The comm pattern is symmetric: I receive from each rank I send to. Thus, the
+// graph's sources and destinations are both the remote ranks in cm.ranks, in
+// the same order, and neighbor i in the collectives is rank index ri = i.
+template <typename MT>
+void init_neighbor_comm (IslMpi<MT>& cm) {
+  const Int nrmtrank = static_cast<Int>(cm.ranks.size()) - 1;
+  std::vector<int> nbrs(nrmtrank);
+  for (Int ri = 0; ri < nrmtrank; ++ri) nbrs[ri] = cm.ranks(ri);
+  MPI_Dist_graph_create_adjacent(cm.p->comm(), nrmtrank, nbrs.data(), MPI_UNWEIGHTED,
+                                 nrmtrank, nbrs.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, 0 /* don't reorder */, &cm.nbr_comm);
+  cm.nbr_sendcount.resize(nrmtrank);
+  cm.nbr_senddispl.resize(nrmtrank);
+  cm.nbr_recvcount.resize(nrmtrank);
+  cm.nbr_recvdispl.resize(nrmtrank);
+  for (Int ri = 0; ri < nrmtrank; ++ri) {
+    cm.nbr_senddispl[ri] = cm.sendbuf.get_h(ri).data() - cm.sendbuf.get_h(0).data();
+    cm.nbr_recvdispl[ri] = cm.recvbuf.get_h(ri).data() - cm.recvbuf.get_h(0).data();
+  }
+}
+
+// Replaces the isend/irecv pairs of one exchange. A receiver does not know
+// how much it will get, so the counts are exchanged first.
+template <typename MT>
+void neighbor_isend (IslMpi<MT>& cm) {
+  const Int nrmtrank = static_cast<Int>(cm.ranks.size()) - 1;
+  if (nrmtrank == 0) return;
+  for (Int ri = 0; ri < nrmtrank; ++ri) {
+    cm.nbr_sendcount[ri] = cm.sendcount_h(ri);
+#ifdef COMPOSE_MPI_ON_HOST
+    typedef typename IslMpi<MT>::template ArrayH<Real*> ArrayH;
+    typedef typename IslMpi<MT>::template ArrayD<Real*> ArrayD;
+    Kokkos::deep_copy(ArrayH(cm.sendbuf_h(ri).data(), cm.sendcount_h(ri)),
+                      ArrayD(cm.sendbuf.get_h(ri).data(), cm.sendcount_h(ri)));
+#endif
+  }
+  MPI_Neighbor_alltoall(cm.nbr_sendcount.data(), 1, MPI_INT,
+                        cm.nbr_recvcount.data(), 1, MPI_INT, cm.nbr_comm);
+  for (Int ri = 0; ri < nrmtrank; ++ri)
+    slmm_assert(cm.nbr_recvcount[ri] <= cm.recvbuf.get_h(ri).n());
+#ifdef COMPOSE_MPI_ON_HOST
+  Real* const sendbuf = cm.sendbuf_h(0).data();
+  Real* const recvbuf = cm.recvbuf_h(0).data();
+#else
+  Real* const sendbuf = cm.sendbuf.get_h(0).data();
+  Real* const recvbuf = cm.recvbuf.get_h(0).data();
+#endif
+  MPI_Ineighbor_alltoallv(sendbuf, cm.nbr_sendcount.data(), cm.nbr_senddispl.data(),
+                          mpi::get_type<Real>(),
+                          recvbuf, cm.nbr_recvcount.data(), cm.nbr_recvdispl.data(),
+                          mpi::get_type<Real>(), cm.nbr_comm, &cm.nbr_req);
+}
+
+template <typename MT>
+void neighbor_wait (IslMpi<MT>& cm) {
+  if (cm.nbr_req == MPI_REQUEST_NULL) return;
+  MPI_Wait(&cm.nbr_req, MPI_STATUS_IGNORE);
+#ifdef COMPOSE_MPI_ON_HOST
+  typedef typename IslMpi<MT>::template ArrayH<Real*> ArrayH;
+  typedef typename IslMpi<MT>::template ArrayD<Real*> ArrayD;
+  const Int nrmtrank = static_cast<Int>(cm.ranks.size()) - 1;
+  for (Int ri = 0; ri < nrmtrank; ++ri) {
+    const int count = cm.nbr_recvcount[ri];
+    Kokkos::deep_copy(ArrayD(cm.recvbuf.get_h(ri).data(), count),
+                      ArrayH(cm.recvbuf_h(ri).data(), count));
+  }
+#endif
+}
+#endif
+
 template <typename MT>
 void setup_irecv (IslMpi<MT>& cm, const bool skip_if_empty) {
+#ifndef COMPOSE_NEIGHBOR_COLL
+  // (With neighborhood collectives, the receives are posted in isend.)
 #ifdef COMPOSE_HORIZ_OPENMP
 # pragma omp master
 #endif
@@ -60,6 +133,7 @@ void setup_irecv (IslMpi<MT>& cm, const bool skip_if_empty) {
                  &cm.recvreq.back());
     }
   }
+#endif
 }
 
 template <typename MT>
@@ -69,6 +143,9 @@ void isend (IslMpi<MT>& cm, const bool want_req, const bool skip_if_empty) {
 # pragma omp master
 #endif
   {
+#ifdef COMPOSE_NEIGHBOR_COLL
+    neighbor_isend(cm);
+#else
     const Int nrmtrank = static_cast<Int>(cm.ranks.size()) - 1;
     for (Int ri = 0; ri < nrmtrank; ++ri) {
       if (skip_if_empty && cm.sendcount_h(ri) == 0) continue;
@@ -84,6 +161,7 @@ void isend (IslMpi<MT>& cm, const bool want_req, const bool skip_if_empty) {
       mpi::isend(*cm.p, sendbuf.data(), cm.sendcount_h(ri),
                  cm.ranks(ri), 42, want_req ? &cm.sendreq(ri) : nullptr);
     }
+#endif
   }
 }
 
@@ -93,10 +171,15 @@ void wait_on_send (IslMpi<MT>& cm, const bool skip_if_empty) {
 # pragma omp master
 #endif
   {
+#ifdef COMPOSE_NEIGHBOR_COLL
+    // The collective was completed in recv.
+    neighbor_wait(cm);
+#else
     for (Int ri = 0; ri < cm.sendreq.n(); ++ri) {
       if (skip_if_empty && cm.sendcount_h(ri) == 0) continue;
       mpi::wait(&cm.sendreq(ri));
     }
+#endif
   }
 #ifdef COMPOSE_HORIZ_OPENMP
 # pragma omp barrier
@@ -105,7 +188,9 @@ void wait_on_send (IslMpi<MT>& cm, const bool skip_if_empty) {
 
 template <typename MT>
 void wait_on_recv (IslMpi<MT>& cm) {
-#ifdef COMPOSE_MPI_ON_HOST
+#if defined COMPOSE_NEIGHBOR_COLL
+  neighbor_wait(cm);
+#elif defined COMPOSE_MPI_ON_HOST
   typedef typename IslMpi<MT>::template ArrayH<Real*> ArrayH;
   typedef typename IslMpi<MT>::template ArrayD<Real*> ArrayD;
   const int nreq = cm.recvreq.n();
@@ -130,7 +215,9 @@ void recv_and_wait_on_send (IslMpi<MT>& cm) {
 # pragma omp master
 #endif
   {
+#ifndef COMPOSE_NEIGHBOR_COLL
     mpi::waitall(cm.sendreq.n(), cm.sendreq.data());
+#endif
     wait_on_recv(cm);
   }
 #ifdef COMPOSE_HORIZ_OPENMP
@@ -153,6 +240,9 @@ void recv (IslMpi<MT>& cm, const bool skip_if_empty) {
 
 template void init_mylid_with_comm_threaded(
   IslMpi<ko::MachineTraits>& cm, const Int& nets, const Int& nete);
+#ifdef COMPOSE_NEIGHBOR_COLL
+template void init_neighbor_comm(IslMpi<ko::MachineTraits>& cm);
+#endif
 template void setup_irecv(IslMpi<ko::MachineTraits>& cm, const bool skip_if_empty);
 template void isend(IslMpi<ko::MachineTraits>& cm, const bool want_req,
                     const bool skip_if_empty);
@@ -359,7 +359,10 @@ void calc_coefs (const slmm::SphereToRef<typename MT::DES>& s2r,
   interpolate<MT>(alg, ref_coord, rx, ry);
 }
 
-template <Int np, typename MT>
+// If qsize_ct > 0, it is the number of tracers, known at compile time, and the
+// tracer loops have fixed trip counts. Otherwise the number of tracers is
+// cm.qsize.
+template <Int np, Int qsize_ct, typename MT>
 void calc_own_q (IslMpi<MT>& cm, const Int& nets, const Int& nete,
                  const DepPoints<MT>& dep_points,
                  const QExtrema<MT>& q_min, const QExtrema<MT>& q_max) {
@@ -372,9 +375,10 @@ void calc_own_q (IslMpi<MT>& cm, const Int& nets, const Int& nete,
   const auto& local_meshes = cm.advecter->local_meshes();
   const auto alg = cm.advecter->alg();
   const auto& own_dep_list = cm.own_dep_list;
-  const Int qsize = cm.qsize;
+  const Int qsize_rt = cm.qsize;
   static const Int blocksize = 8;
   const auto f = COMPOSE_LAMBDA (const Int& it) {
+    const Int qsize = qsize_ct > 0 ? qsize_ct : qsize_rt;
     const Int tci = own_dep_list(it,0);
     const Int tgt_lev = own_dep_list(it,1);
     const Int tgt_k = own_dep_list(it,2);
@@ -416,6 +420,18 @@ void calc_own_q (IslMpi<MT>& cm, const Int& nets, const Int& nete,
     ko::RangePolicy<typename MT::DES>(0, cm.own_dep_list_len), f);
 }
 
+template <Int np, typename MT>
+void calc_own_q (IslMpi<MT>& cm, const Int& nets, const Int& nete,
+                 const DepPoints<MT>& dep_points,
+                 const QExtrema<MT>& q_min, const QExtrema<MT>& q_max) {
+  switch (cm.qsize) {
+  case  4: calc_own_q<np, 4>(cm, nets, nete, dep_points, q_min, q_max); break;
+  case 10: calc_own_q<np,10>(cm, nets, nete, dep_points, q_min, q_max); break;
+  case 40: calc_own_q<np,40>(cm, nets, nete, dep_points, q_min, q_max); break;
+  default: calc_own_q<np, 0>(cm, nets, nete, dep_points, q_min, q_max);
+  }
+}
+
 template <typename MT>
 void copy_q (IslMpi<MT>& cm, const Int& nets,
              const QExtrema<MT>& q_min, const QExtrema<MT>& q_max) {
@@ -529,7 +545,8 @@ void calc_rmt_q_pass1_scan (IslMpi<MT>& cm) {
   cm.nrmt_qs_extrema = qcnt;
 }
 
-template <Int np, typename MT>
+// qsize_ct is as in calc_own_q.
+template <Int np, Int qsize_ct, typename MT>
 void calc_rmt_q_pass2 (IslMpi<MT>& cm) {
   const auto& q_src = cm.tracer_arrays->q;
   const auto& rmt_qs_extrema = cm.rmt_qs_extrema;
@@ -537,9 +554,10 @@ void calc_rmt_q_pass2 (IslMpi<MT>& cm) {
   const auto& ed_d = cm.ed_d;
   const auto& sendbuf = cm.sendbuf;
   const auto& recvbuf = cm.recvbuf;
-  const Int qsize = cm.qsize;
+  const Int qsize_rt = cm.qsize;
 
   const auto fqe = COMPOSE_LAMBDA (const Int& it) {
+    const Int qsize = qsize_ct > 0 ? qsize_ct : qsize_rt;
     const Int
     ri = rmt_qs_extrema(4*it), lid = rmt_qs_extrema(4*it + 1),
     lev = rmt_qs_extrema(4*it + 2), qos = qsize*rmt_qs_extrema(4*it + 3);  
@@ -558,6 +576,7 @@ void calc_rmt_q_pass2 (IslMpi<MT>& cm) {
   static const Int blocksize = 8;
 
   const auto fx = COMPOSE_LAMBDA (const Int& it) {
+    const Int qsize = qsize_ct > 0 ? qsize_ct : qsize_rt;
     const Int
     ri = rmt_xs(5*it), lid = rmt_xs(5*it + 1), lev = rmt_xs(5*it + 2),
     xos = rmt_xs(5*it + 3), qos = qsize*rmt_xs(5*it + 4);
@@ -591,6 +610,16 @@ void calc_rmt_q_pass2 (IslMpi<MT>& cm) {
   ko::fence();
 }
 
+template <Int np, typename MT>
+void calc_rmt_q_pass2 (IslMpi<MT>& cm) {
+  switch (cm.qsize) {
+  case  4: calc_rmt_q_pass2<np, 4>(cm); break;
+  case 10: calc_rmt_q_pass2<np,10>(cm); break;
+  case 40: calc_rmt_q_pass2<np,40>(cm); break;
+  default: calc_rmt_q_pass2<np, 0>(cm);
+  }
+}
+
 #endif // COMPOSE_PORT
 
 template <Int np, typename MT>
@@ -179,34 +179,34 @@ void ComposeTransportImpl::init_boundary_exchanges () {
 }
 
 void ComposeTransportImpl::run (const TimeLevel& tl, const Real dt) {
-  GPTLstart("compose_transport");
+  start_timer("compose_transport");
 
   calc_trajectory(tl.np1, dt);
   
-  GPTLstart("compose_isl");
+  start_timer("compose_isl");
   homme::compose::advect(tl.np1, tl.n0_qdp, tl.np1_qdp);
-  GPTLstop("compose_isl");
+  stop_timer("compose_isl");
   
   if (m_data.hv_q > 0 && m_data.nu_q > 0) {
-    GPTLstart("compose_hypervis_scalar");
+    start_timer("compose_hypervis_scalar");
     advance_hypervis_scalar(dt);
     Kokkos::fence();
-    GPTLstop("compose_hypervis_scalar");
+    stop_timer("compose_hypervis_scalar");
   }
   
-  GPTLstart("compose_cedr_global");
+  start_timer("compose_cedr_global");
   homme::compose::set_dp3d_np1(m_data.independent_time_steps ?
                                0 : // dp3d is actually divdp
                                tl.np1);
   const auto run_cedr = homme::compose::property_preserve_global();
   if (run_cedr) Kokkos::fence();
-  GPTLstop("compose_cedr_global");
-  GPTLstart("compose_cedr_local");
+  stop_timer("compose_cedr_global");
+  start_timer("compose_cedr_local");
   if (run_cedr) {
     homme::compose::property_preserve_local(m_data.limiter_option);
     Kokkos::fence();
   }
-  GPTLstop("compose_cedr_local");    
+  stop_timer("compose_cedr_local");    
 
   const auto np1 = tl.np1;
   const auto np1_qdp = tl.np1_qdp;
@@ -228,7 +228,7 @@ void ComposeTransportImpl::run (const TimeLevel& tl, const Real dt) {
   }
   
   { // DSS qdp and omega
-    GPTLstart("compose_dss_q");
+    start_timer("compose_dss_q");
     const auto qdp = m_tracers.qdp;
     const auto spheremp = m_geometry.m_spheremp;
     const auto f1 = KOKKOS_LAMBDA (const int idx) {
@@ -246,17 +246,17 @@ void ComposeTransportImpl::run (const TimeLevel& tl, const Real dt) {
     launch_ie_ij_nlev<num_lev_pack>(f2);
     m_qdp_dss_be[tl.np1_qdp]->exchange(m_geometry.m_rspheremp);
     Kokkos::fence();
-    GPTLstop("compose_dss_q");
+    stop_timer("compose_dss_q");
   }
   
   if (m_data.cdr_check) {
-    GPTLstart("compose_cedr_check");
+    start_timer("compose_cedr_check");
     homme::compose::property_preserve_check();
     Kokkos::fence();
-    GPTLstop("compose_cedr_check");
+    stop_timer("compose_cedr_check");
   }
   
-  GPTLstop("compose_transport");
+  stop_timer("compose_transport");
 }
 
 } // namespace Homme
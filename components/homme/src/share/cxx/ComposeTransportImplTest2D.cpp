@@ -161,7 +161,7 @@ void ComposeTransportImpl::test_2d (const bool bfb, const int nstep, std::vector
 
   fill_ics(*this, tl.n0_qdp, tl.np1);
 
-  GPTLstart("compose_stt_step");
+  start_timer("compose_stt_step");
   for (int i = 0; i < nstep; ++i) {
     const auto tprev = dt*i;
     const auto t = dt*(i+1);
@@ -178,7 +178,7 @@ void ComposeTransportImpl::test_2d (const bool bfb, const int nstep, std::vector
     tl.nstep += params.qsplit;
     tl.update_tracers_levels(params.qsplit);
   }
-  GPTLstop("compose_stt_step");
+  stop_timer("compose_stt_step");
 
   finish(*this, Context::singleton().get<Comm>(), tl.n0_qdp, tl.np1, eval);
 }
@@ -346,7 +346,7 @@ KOKKOS_FUNCTION static void calc_vertically_lagrangian_levels (
    In the code, v(p1,t0) = vstar, v(p1,t1) is vn0.
  */
 void ComposeTransportImpl::calc_trajectory (const int np1, const Real dt) {
-  GPTLstart("compose_calc_trajectory");
+  start_timer("compose_calc_trajectory");
   const auto sphere_ops = m_sphere_ops;
   const auto geo = m_geometry;
   const auto m_vec_sph2cart = geo.m_vec_sph2cart;
@@ -369,7 +369,7 @@ void ComposeTransportImpl::calc_trajectory (const int np1, const Real dt) {
     const auto m_dp = m_derived.m_dp;
     const auto m_divdp = m_derived.m_divdp;
     if (m_data.independent_time_steps) {
-      GPTLstart("compose_3d_levels");
+      start_timer("compose_3d_levels");
       const auto copy_v = KOKKOS_LAMBDA (const int idx) {
         int ie, lev, i, j;
         cti::idx_ie_packlev_ij(idx, ie, lev, i, j);
@@ -409,9 +409,9 @@ void ComposeTransportImpl::calc_trajectory (const int np1, const Real dt) {
       Kokkos::fence();
       Kokkos::parallel_for(m_tp_ne, sphere);
       Kokkos::fence();
-      GPTLstop("compose_3d_levels");
+      stop_timer("compose_3d_levels");
     }
-    GPTLstart("compose_v_bexchv");
+    start_timer("compose_v_bexchv");
     const auto calc_midpoint_velocity = KOKKOS_LAMBDA (const MT& team) {
       KernelVariables kv(team, tu_ne);
       const auto ie = kv.ie;
@@ -442,9 +442,9 @@ void ComposeTransportImpl::calc_trajectory (const int np1, const Real dt) {
     be->exchange();
     Kokkos::fence();
   }
-  GPTLstop("compose_v_bexchv");
+  stop_timer("compose_v_bexchv");
   { // Calculate departure point.
-    GPTLstart("compose_v2x");
+    start_timer("compose_v2x");
     const int packn = this->packn;
     const int num_phys_lev = this->num_phys_lev;
     const auto m_sphere_cart = geo.m_sphere_cart;
@@ -483,9 +483,9 @@ void ComposeTransportImpl::calc_trajectory (const int np1, const Real dt) {
     };
     Kokkos::parallel_for(m_tp_ne, calc_departure_point);
     Kokkos::fence();
-    GPTLstop("compose_v2x");
+    stop_timer("compose_v2x");
   }
-  GPTLstop("compose_calc_trajectory");
+  stop_timer("compose_calc_trajectory");
 }
 
 static int test_approx_derivative () {
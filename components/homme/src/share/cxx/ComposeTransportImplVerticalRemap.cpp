@@ -41,7 +41,7 @@ void ComposeTransportImpl
 }
 
 void ComposeTransportImpl::remap_q (const TimeLevel& tl) {
-  GPTLstart("compose_vertical_remap");
+  start_timer("compose_vertical_remap");
   const auto np1 = tl.np1;
   const auto np1_qdp = tl.np1_qdp;
   const auto dp = m_derived.m_divdp;
@@ -61,7 +61,7 @@ void ComposeTransportImpl::remap_q (const TimeLevel& tl) {
   Kokkos::fence();
   Kokkos::parallel_for(policy, post);
   Kokkos::fence();
-  GPTLstop("compose_vertical_remap");
+  stop_timer("compose_vertical_remap");
 }
 
 } // namespace Homme
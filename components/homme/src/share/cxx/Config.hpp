@@ -29,6 +29,10 @@
 # define HOMMEXX_MPI_ON_DEVICE 1
 #endif
 
+#ifndef HOMMEXX_MPI_PINNED_HOST
+# define HOMMEXX_MPI_PINNED_HOST 1
+#endif
+
 #include <Kokkos_Core.hpp>
 
 #ifdef HOMMEXX_ENABLE_GPU 
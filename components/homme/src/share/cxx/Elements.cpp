@@ -14,7 +14,7 @@ namespace Homme {
 
 void Elements::init(const int num_elems, const bool consthv, const bool alloc_gradphis,
                     const Real scale_factor, const Real laplacian_rigid_factor,
-                    const bool alloc_sphere_coords) {
+                    const bool alloc_sphere_coords, const bool alloc_state) {
   // Sanity check
   assert (num_elems>0);
 
@@ -24,7 +24,7 @@ void Elements::init(const int num_elems, const bool consthv, const bool alloc_gr
                   scale_factor,
                   laplacian_rigid_factor < 0 ? 1/scale_factor : laplacian_rigid_factor,
                   alloc_sphere_coords);
-  m_state.init(num_elems);
+  m_state.init(num_elems,alloc_state);
   m_derived.init(num_elems);
   m_forcing.init(num_elems);
 
@@ -44,7 +44,9 @@ public:
   void init (const int num_elems, const bool consthv, const bool alloc_gradphis,
              // See ElementsGeometry::init for details about these arguments.
              const Real scale_factor, const Real laplacian_rigid_factor=-1,
-             const bool alloc_sphere_coords=false);
+             const bool alloc_sphere_coords=false,
+             // See ElementsState::init for details about this argument.
+             const bool alloc_state=true);
   void randomize (const int seed, const Real max_pressure = 1.0);
   void randomize (const int seed, const Real max_pressure, const Real ps0, const Real hyai0);
 
@@ -163,6 +163,8 @@ void GllFvRemapImpl
   d.g2f_remapd = decltype(d.g2f_remapd)("g2f_remapd", nf2, np2);
   d.f2g_remapd = decltype(d.f2g_remapd)("f2g_remapd", np2, nf2);
   d.fv_metdet = decltype(d.fv_metdet)("fv_metdet", d.nelemd, nf2);
+  d.g2f_op = decltype(d.g2f_op)("g2f_op", d.nelemd, nf2, np2);
+  d.f2g_op = decltype(d.f2g_op)("f2g_op", d.nelemd, np2, nf2);
   d.D =      decltype(d.D)("D",      d.nelemd, np2, 2, 2);
   d.Dinv =   decltype(d.D)("Dinv",   d.nelemd, np2, 2, 2);
   d.D_f =    decltype(d.D)("D_f",    d.nelemd, nf2, 2, 2);
@@ -171,12 +173,16 @@ void GllFvRemapImpl
   const auto g2f_remapd = create_mirror_view(d.g2f_remapd);
   const auto f2g_remapd = create_mirror_view(d.f2g_remapd);
   const auto fv_metdet = create_mirror_view(d.fv_metdet);
+  const auto g2f_op = create_mirror_view(d.g2f_op);
+  const auto f2g_op = create_mirror_view(d.f2g_op);
   const auto D = create_mirror_view(d.D);
   const auto Dinv = create_mirror_view(d.Dinv);
   const auto D_f = create_mirror_view(d.D_f);
   const auto Dinv_f = create_mirror_view(d.Dinv_f);
   const auto cD = create_mirror_view(m_geometry.m_d); deep_copy(cD, m_geometry.m_d);
   const auto cDinv = create_mirror_view(m_geometry.m_dinv); deep_copy(cDinv, m_geometry.m_dinv);
+  const auto cmetdet = create_mirror_view(m_geometry.m_metdet);
+  deep_copy(cmetdet, m_geometry.m_metdet);
   for (int i = 0; i < nf2; ++i)
     for (int j = 0; j < np2; ++j)
       g2f_remapd(i,j) = fg2f_remapd(j,i);
@@ -199,8 +205,16 @@ void GllFvRemapImpl
           Dinv_f(ie,k,d0,d1) = fDinv_f(k,d0,d1,ie);
         }
       }
+    for (int i = 0; i < nf2; ++i)
+      for (int j = 0; j < np2; ++j) {
+        const Real gll_metdet_j = cmetdet(ie, j / np, j % np);
+        g2f_op(ie,i,j) = g2f_remapd(i,j)*gll_metdet_j/(d.w_ff*fv_metdet(ie,i));
+        f2g_op(ie,j,i) = f2g_remapd(j,i)*fv_metdet(ie,i)/gll_metdet_j;
+      }
   }
   deep_copy(d.fv_metdet, fv_metdet);
+  deep_copy(d.g2f_op, g2f_op);
+  deep_copy(d.f2g_op, f2g_op);
   deep_copy(d.g2f_remapd, g2f_remapd);
   deep_copy(d.f2g_remapd, f2g_remapd);
   deep_copy(d.D, D);
@@ -268,32 +282,28 @@ augment_extrema (const KernelVariables& kv, const int n, const int nlev,
     });  
 }
 
-// Remap a mixing ratio conservatively.
-template <typename RT, typename GS, typename GT, typename DS, typename DT,
-          typename QS, typename WT, typename QT>
+// Remap a mixing ratio conservatively. g2f_op is the element's combined
+// operator Data::g2f_op(ie,:,:).
+template <typename RT, typename DS, typename DT, typename QS, typename WT, typename QT>
 static KOKKOS_FUNCTION void
 g2f_scalar_dp (const KernelVariables& kv, const int np2, const int nf2, const int nlev,
-               const RT& g2f_remap, const GS& geog, const Real sf, const GT& geof,
-               const DS& dpg, const DT& dpf, const QS& qg, const WT& w1, const QT& qf) {
+               const RT& g2f_op, const DS& dpg, const DT& dpf, const QS& qg,
+               const WT& w1, const QT& qf) {
   using g = GllFvRemapImpl;
-  using Kokkos::parallel_for;
   const auto ttrg = Kokkos::TeamThreadRange(kv.team, np2);
-  const auto ttrf = Kokkos::TeamThreadRange(kv.team, nf2);
   const auto tvr  = Kokkos::ThreadVectorRange(kv.team, nlev);
 
   g::loop_ik(ttrg, tvr, [&] (int i, int k) { w1(i,k) = dpg(i,k)*qg(i,k); });
   kv.team_barrier();
-  g::remapd(kv.team, nf2, np2, nlev, g2f_remap, geog, sf, geof, w1, w1, qf);
-  kv.team_barrier();
-  g::loop_ik(ttrf, tvr, [&] (int i, int k) { qf(i,k) /= dpf(i,k); });
+  g::remapd_op(kv.team, nf2, np2, nlev, g2f_op, w1, dpf, qf);
 }
 
 // Remap a mixing ratio conservatively and preventing new extrema.
-template <typename RT, typename GS, typename GT, typename DS, typename DT,
+template <typename RT, typename GT, typename DS, typename DT,
           typename QS, typename WT, typename QT>
 static KOKKOS_FUNCTION void
 g2f_mixing_ratio (const KernelVariables& kv, const int np2, const int nf2, const int nlev,
-                  const RT& g2f_remap, const GS& geog, const Real sf, const GT& geof,
+                  const RT& g2f_op, const Real sf, const GT& geof,
                   const DS& dpg, const DT& dpf, const QS& qg,
                   const WT& w1, const WT& w2, const int iqf, const QT& qf) {
   using g = GllFvRemapImpl;
@@ -302,7 +312,7 @@ g2f_mixing_ratio (const KernelVariables& kv, const int np2, const int nf2, const
   const auto tvr  = Kokkos::ThreadVectorRange(kv.team, nlev);
 
   // Linearly remap qdp GLL->FV.
-  g2f_scalar_dp(kv, np2, nf2, nlev, g2f_remap, geog, sf, geof, dpg, dpf, qg, w1, w2);
+  g2f_scalar_dp(kv, np2, nf2, nlev, g2f_op, dpg, dpf, qg, w1, w2);
   kv.team_barrier();
 
   // Compute extremal q values in element on GLL grid. Use qf as tmp space.
@@ -317,23 +327,19 @@ g2f_mixing_ratio (const KernelVariables& kv, const int np2, const int nf2, const
   g::loop_ik(ttrf, tvr, [&] (int i, int k) { qf(i,iqf,k) = w2(i,k); });
 }
 
-template <typename RT, typename GS, typename GT, typename DS, typename DT, typename WT,
-          typename QFT, typename QGT>
+// f2g_op is the element's combined operator Data::f2g_op(ie,:,:).
+template <typename RT, typename DS, typename DT, typename WT, typename QFT, typename QGT>
 static KOKKOS_FUNCTION void
 f2g_scalar_dp (const KernelVariables& kv, const int nf2, const int np2, const int nlev,
-               const RT& f2g_remap, const GS& geof, const GT& geog, const DS& dpf,
-               const DT& dpg, const QFT& qf, const WT& w1, const QGT& qg) {
+               const RT& f2g_op, const DS& dpf, const DT& dpg, const QFT& qf,
+               const WT& w1, const QGT& qg) {
   using g = GllFvRemapImpl;
-  using Kokkos::parallel_for;
   const auto ttrf = Kokkos::TeamThreadRange(kv.team, nf2);
-  const auto ttrg = Kokkos::TeamThreadRange(kv.team, np2);
   const auto tvr  = Kokkos::ThreadVectorRange(kv.team, nlev);
 
   g::loop_ik(ttrf, tvr, [&] (int i, int k) { w1(i,k) = dpf(i,k)*qf(i,k); });
   kv.team_barrier();
-  g::remapd(kv.team, np2, nf2, nlev, f2g_remap, geof, 1, geog, w1, w1, qg);
-  kv.team_barrier();
-  g::loop_ik(ttrg, tvr, [&] (int i, int k) { qg(i,k) /= dpg(i,k); });
+  g::remapd_op(kv.team, np2, nf2, nlev, f2g_op, w1, dpg, qg);
 }
 
 void GllFvRemapImpl
@@ -389,6 +395,7 @@ void GllFvRemapImpl
   const auto fv_metdet = m_data.fv_metdet;
   const auto w_ff = m_data.w_ff;
   const auto g2f_remapd = m_data.g2f_remapd;
+  const auto g2f_op = m_data.g2f_op;
   const auto Dinv = m_data.Dinv;
   const auto D_f = m_data.D_f;
   const auto dp_fv = m_derived.m_divdp_proj; // store dp_fv between kernels
@@ -507,7 +514,7 @@ void GllFvRemapImpl
       kv.team_barrier(); // w2, w4 in use
       // theta_f
       const auto& th_f = w3f;
-      g2f_scalar_dp(team, np2, nf2, nlevpk, g2f_remapd, gll_metdet_ie, w_ff, fv_metdet_ie,
+      g2f_scalar_dp(team, np2, nf2, nlevpk, Kokkos::subview(g2f_op, ie, all, all),
                     evucs_np2_nlev(&dp3d(ie,timeidx,0,0,0)), dp_fv_ie,
                     evucs_np2_nlev(th_g.data()), evus_np2_nlev(w1g.data()),
                     evus2(th_f.data(), nf2, nlevpk));
@@ -541,13 +548,12 @@ void GllFvRemapImpl
     const auto rw1 = Kokkos::subview(buf10, kv.team_idx, all, all, all);
     const auto rw2 = Kokkos::subview(buf11, kv.team_idx, all, all, all);
 
-    const evucr1 fv_metdet_ie(&fv_metdet(ie,0), nf2),
-      gll_metdet_ie(&gll_metdet(ie,0,0), np2);
+    const evucr1 fv_metdet_ie(&fv_metdet(ie,0), nf2);
     const EVU<const Scalar**> dp_fv_ie(&dp_fv(ie,0,0,0), nf2, nlevpk);
     
     // q
     g2f_mixing_ratio(
-      kv, np2, nf2, nlevpk, g2f_remapd, gll_metdet_ie, w_ff, fv_metdet_ie,
+      kv, np2, nf2, nlevpk, Kokkos::subview(g2f_op, ie, all, all), w_ff, fv_metdet_ie,
       evucs_np2_nlev(&dp_g(ie,timeidx,0,0,0)), dp_fv_ie, evucs_np2_nlev(&q_g(ie,iq,0,0,0)),
       evus_np2_nlev(rw1.data()), evus_np2_nlev(rw2.data()), iq,
       evus3(&q(ie,0,0,0), q.extent_int(1), q.extent_int(2), q.extent_int(3)));
@@ -599,6 +605,8 @@ run_fv_phys_to_dyn (const int timeidx, const CPhys2T& Ts, const CPhys3T& uvs,
   const auto fv_metdet = m_data.fv_metdet;
   const auto g2f_remapd = m_data.g2f_remapd;
   const auto f2g_remapd = m_data.f2g_remapd;
+  const auto g2f_op = m_data.g2f_op;
+  const auto f2g_op = m_data.f2g_op;
   const auto fm = m_forcing.m_fm;
   const auto Dinv_f = m_data.Dinv_f;
   const auto D_g = m_data.D;
@@ -681,7 +689,7 @@ run_fv_phys_to_dyn (const int timeidx, const CPhys2T& Ts, const CPhys3T& uvs,
       kv.team_barrier(); // w3, w4 in use
       // theta_g
       evus_np2_nlev th_g(&fT(ie,0,0,0));
-      f2g_scalar_dp(kv, nf2, np2, nlevpk, f2g_remapd, fv_metdet_ie, gll_metdet_ie,
+      f2g_scalar_dp(kv, nf2, np2, nlevpk, Kokkos::subview(f2g_op, ie, all, all),
                     dp_fv_ie, evucs_np2_nlev(&dp3d(ie,timeidx,0,0,0)),
                     th_f, evus_np2_nlev(rw1.data()), th_g);
       kv.team_barrier(); // w4 in use
@@ -717,8 +725,7 @@ run_fv_phys_to_dyn (const int timeidx, const CPhys2T& Ts, const CPhys3T& uvs,
     const auto rw2 = Kokkos::subview(buf11, kv.team_idx, all, all, all);
     const auto r2w = Kokkos::subview(buf20, kv.team_idx, all, all, all, all);
 
-    const evucr1 fv_metdet_ie(&fv_metdet(ie,0), nf2),
-      gll_metdet_ie(&gll_metdet(ie,0,0), np2);
+    const evucr1 fv_metdet_ie(&fv_metdet(ie,0), nf2);
     const EVU<const Scalar**> dp_fv_ie(&dp_fv(ie,0,0,0), nf2, nlevpk);
 
     {
@@ -734,7 +741,7 @@ run_fv_phys_to_dyn (const int timeidx, const CPhys2T& Ts, const CPhys3T& uvs,
       const evus2 dqf_ie(&r2w(0,0,0,0), nf2, nlevpk);
       const evucs_np2_nlev dp_g_ie(&dp_g(ie,timeidx,0,0,0)), qg_ie(&q_g(ie,iq,0,0,0));
       g2f_mixing_ratio(
-        kv, np2, nf2, nlevpk, g2f_remapd, gll_metdet_ie,
+        kv, np2, nf2, nlevpk, Kokkos::subview(g2f_op, ie, all, all),
         w_ff, fv_metdet_ie, dp_g_ie, dp_fv_ie, qg_ie,
         evus_np2_nlev(rw1.data()), evus_np2_nlev(rw2.data()),
         0, evus3(dqf_ie.data(), nf2, 1, nlevpk));
@@ -744,7 +751,7 @@ run_fv_phys_to_dyn (const int timeidx, const CPhys2T& Ts, const CPhys3T& uvs,
       kv.team_barrier();
       // GLL Q_ten
       const evus_np2_nlev dqg_ie(rw2.data());
-      f2g_scalar_dp(kv, nf2, np2, nlevpk, f2g_remapd, fv_metdet_ie, gll_metdet_ie,
+      f2g_scalar_dp(kv, nf2, np2, nlevpk, Kokkos::subview(f2g_op, ie, all, all),
                     dp_fv_ie, dp_g_ie, dqf_ie, evus_np2_nlev(rw1.data()), dqg_ie);
       kv.team_barrier();
       // GLL Q1
@@ -846,6 +853,7 @@ void GllFvRemapImpl
   const auto fv_metdet = m_data.fv_metdet;
   const auto w_ff = m_data.w_ff;
   const auto g2f_remapd = m_data.g2f_remapd;
+  const auto g2f_op = m_data.g2f_op;
   const auto dp_fv = m_derived.m_divdp_proj; // store dp_fv between kernels
   const auto hvcoord = m_hvcoord;
   
@@ -889,12 +897,11 @@ void GllFvRemapImpl
     const auto rw1 = Kokkos::subview(buf10, kv.team_idx, all, all, all);
     const auto rw2 = Kokkos::subview(buf11, kv.team_idx, all, all, all);
 
-    const evucr1 fv_metdet_ie(&fv_metdet(ie,0), nf2),
-      gll_metdet_ie(&gll_metdet(ie,0,0), np2);
+    const evucr1 fv_metdet_ie(&fv_metdet(ie,0), nf2);
     const EVU<const Scalar**> dp_fv_ie(&dp_fv(ie,0,0,0), nf2, nlevpk);
     
     g2f_mixing_ratio(
-      kv, np2, nf2, nlevpk, g2f_remapd, gll_metdet_ie, w_ff, fv_metdet_ie,
+      kv, np2, nf2, nlevpk, Kokkos::subview(g2f_op, ie, all, all), w_ff, fv_metdet_ie,
       evucs_np2_nlev(&dp_g(ie,timeidx,0,0,0)), dp_fv_ie, evucs_np2_nlev(&q_dyn(ie,iq,0,0)),
       evus_np2_nlev(rw1.data()), evus_np2_nlev(rw2.data()), iq,
       evus3(&q_fv(ie,0,0,0), q_fv.extent_int(1), q_fv.extent_int(2), q_fv.extent_int(3)));
@@ -71,6 +71,13 @@ struct GllFvRemapImpl {
       fv_metdet,   // (nelemd,nf2)
       g2f_remapd,  // (nf2,np2)
       f2g_remapd;  // (np2,nf2)
+    // g2f_remapd and f2g_remapd combined with the metric scalings of each
+    // element, as applied to a density by remapd:
+    //   g2f_op(ie,i,j) = g2f_remapd(i,j) gll_metdet(ie,j)/(w_ff fv_metdet(ie,i))
+    //   f2g_op(ie,i,j) = f2g_remapd(i,j) fv_metdet(ie,j)/gll_metdet(ie,i)
+    ExecView<Real***>
+      g2f_op,      // (nelemd,nf2,np2)
+      f2g_op;      // (nelemd,np2,nf2)
     ExecView<Real****>
       D, Dinv,     // (nelemd,np2,2,2)
       D_f, Dinv_f; // (nelemd,nf2,2,2)
@@ -172,6 +179,32 @@ struct GllFvRemapImpl {
       parallel_for(tvr,   [&] (const int k) { y(i,k) /= s2 * d2(i); }); });
   }
 
+  /* Compute (1-based indexing)
+         y(1:m,k) = (A x(1:n,k))/d(1:m,k), k = 1:nlev
+     where A is one of the combined operators g2f_op(ie,:,:), f2g_op(ie,:,:).
+     Sizes are min; a dim can have larger size.
+         A m by n, x n by nlev, d m by nlev, y m by nlev
+     y must not alias x.
+   */
+  template <typename AT, typename XT, typename DT, typename YT>
+  static KOKKOS_FUNCTION void
+  remapd_op (const MT& team, const int m, const int n, const int nlev,
+             const AT& A, const XT& x, const DT& d, const YT& y) {
+    assert(A.extent_int(0) >= m && A.extent_int(1) >= n);
+    assert(x.extent_int(0) >= n && x.extent_int(1) >= nlev);
+    assert(d.extent_int(0) >= m && d.extent_int(1) >= nlev);
+    assert(y.extent_int(0) >= m && y.extent_int(1) >= nlev);
+    using Kokkos::parallel_for;
+    const auto ttrm = Kokkos::TeamThreadRange(team, m);
+    const auto tvr = Kokkos::ThreadVectorRange(team, nlev);
+    parallel_for( ttrm, [&] (const int i) {
+      parallel_for(tvr, [&] (const int k) {
+        auto yik = A(i,0) * x(0,k);
+        for (int j = 1; j < n; ++j) yik += A(i,j) * x(j,k);
+        y(i,k) = yik / d(i,k);
+      }); });
+  }
+
   // Handle (dof,d) vs (d,dof) index ordering.
   template <bool idx_dof_d> static KOKKOS_INLINE_FUNCTION void
   remapd_idx_order (const int dof, const int d, int& i1, int& i2)
@@ -14,6 +14,7 @@
 
 #include "vector/vector_pragmas.hpp"
 
+#include <cstdlib>
 #include <iostream>
 
 namespace Homme
@@ -83,6 +84,11 @@ void initialize_hommexx_session ()
       initialize_kokkos();
     }
 
+    {
+      const char* const regions = std::getenv("HOMMEXX_PROFILING_REGIONS");
+      profiling_regions_enabled() = regions && std::atoi(regions) != 0;
+    }
+
     // Note: at this point, the Comm *should* already be created.
     const auto& comm = Context::singleton().get<Comm>();
     if (comm.root()) {
@@ -175,7 +175,7 @@ struct PpmVertRemap : public VertRemapAlg {
       , m_pio("pio", num_elems)
       , m_pin("pin", num_elems)
       , m_ppmdx("ppmdx", num_elems)
-      , m_z2("z2", num_elems)
+      , m_z2_pows("z2_pows", num_elems)
       , m_kid("kid", num_elems)
       , m_ppm_tu(get_default_team_policy<ExecSpace>(num_elems * num_remap))
       , m_ao("a0", m_ppm_tu.get_num_ws_slots())
@@ -246,7 +246,7 @@ struct PpmVertRemap : public VertRemapAlg {
 
       compute_remap(kv,
                     Homme::subview(m_kid, kv.ie, igp, jgp),
-                    Homme::subview(m_z2, kv.ie, igp, jgp),
+                    Homme::subview(m_z2_pows, kv.ie, igp, jgp),
                     Homme::subview(m_parabola_coeffs, kv.team_idx, igp, jgp),
                     Homme::subview(m_mass_o, kv.team_idx, igp, jgp),
                     Homme::subview(m_dpo, kv.ie, igp, jgp),
@@ -258,14 +258,16 @@ struct PpmVertRemap : public VertRemapAlg {
   KOKKOS_FORCEINLINE_FUNCTION
   Real compute_mass(const Real sq_coeff, const Real lin_coeff,
                     const Real const_coeff, const Real prev_mass,
-                    const Real prev_dp, const Real x2) const {
+                    const Real prev_dp,
+                    ExecViewUnmanaged<const Real[3][NUM_PHYSICAL_LEV]> z2_pows,
+                    const int k) const {
     // This remapping assumes we're starting from the left interface of an
-    // old grid cell
-    // In fact, we're usually integrating very little or almost all of the
-    // cell in question
-    const Real x1 = -0.5;
+    // old grid cell. The powers of the integration bounds only depend on
+    // the grids, so they were computed once for all tracers in
+    // compute_integral_bounds.
     const Real integral =
-        integrate_parabola(sq_coeff, lin_coeff, const_coeff, x1, x2);
+        integrate_parabola(sq_coeff, lin_coeff, const_coeff,
+                           z2_pows(0, k), z2_pows(1, k), z2_pows(2, k));
     const Real mass = prev_mass + integral * prev_dp;
     return mass;
   }
@@ -275,7 +277,7 @@ struct PpmVertRemap : public VertRemapAlg {
   typename std::enable_if<!Homme::OnGpu<ExecSpaceType>::value, void>::type
   compute_remap(KernelVariables &/* kv */,
       ExecViewUnmanaged<const int[NUM_PHYSICAL_LEV]> k_id,
-      ExecViewUnmanaged<const Real[NUM_PHYSICAL_LEV]> integral_bounds,
+      ExecViewUnmanaged<const Real[3][NUM_PHYSICAL_LEV]> z2_pows,
       ExecViewUnmanaged<const Real[3][NUM_PHYSICAL_LEV]> parabola_coeffs,
       ExecViewUnmanaged<Real[_ppm_consts::MASS_O_PHYSICAL_LEV]> mass,
       ExecViewUnmanaged<const Real[_ppm_consts::DPO_PHYSICAL_LEV]> prev_dp,
@@ -293,14 +295,13 @@ struct PpmVertRemap : public VertRemapAlg {
       const int kk_cur_lev = k_id(k);
       assert(kk_cur_lev < parabola_coeffs.extent_int(1));
 
-      const Real x2_cur_lev = integral_bounds(k);
       // Repurpose the mass buffer to store the new mass.
       // WARNING: This may not be thread safe in future architectures which
       //          use this level of parallelism!!!
       mass2 = compute_mass(
           parabola_coeffs(2, kk_cur_lev), parabola_coeffs(1, kk_cur_lev),
           parabola_coeffs(0, kk_cur_lev), mass(kk_cur_lev),
-          prev_dp(kk_cur_lev + _ppm_consts::INITIAL_PADDING), x2_cur_lev);
+          prev_dp(kk_cur_lev + _ppm_consts::INITIAL_PADDING), z2_pows, k);
       rvar(k) = mass2 - mass1;
       mass1 = mass2;
     }
@@ -311,7 +312,7 @@ struct PpmVertRemap : public VertRemapAlg {
   typename std::enable_if<Homme::OnGpu<ExecSpaceType>::value, void>::type
   compute_remap(KernelVariables &kv,
       ExecViewUnmanaged<const int[NUM_PHYSICAL_LEV]> k_id,
-      ExecViewUnmanaged<const Real[NUM_PHYSICAL_LEV]> integral_bounds,
+      ExecViewUnmanaged<const Real[3][NUM_PHYSICAL_LEV]> z2_pows,
       ExecViewUnmanaged<const Real[3][NUM_PHYSICAL_LEV]> parabola_coeffs,
       ExecViewUnmanaged<Real[_ppm_consts::MASS_O_PHYSICAL_LEV]> prev_mass,
       ExecViewUnmanaged<const Real[_ppm_consts::DPO_PHYSICAL_LEV]> prev_dp,
@@ -327,18 +328,16 @@ struct PpmVertRemap : public VertRemapAlg {
                     parabola_coeffs(1, k_id(k - 1)),
                     parabola_coeffs(0, k_id(k - 1)), prev_mass(k_id(k - 1)),
                     prev_dp(k_id(k - 1) + _ppm_consts::INITIAL_PADDING),
-                    integral_bounds(k - 1))
+                    z2_pows, k - 1)
               : 0.0;
 
-      const Real x2_cur_lev = integral_bounds(k);
-
       const int kk_cur_lev = k_id(k);
       assert(kk_cur_lev < parabola_coeffs.extent_int(1));
 
       const Real mass_2 = compute_mass(
           parabola_coeffs(2, kk_cur_lev), parabola_coeffs(1, kk_cur_lev),
           parabola_coeffs(0, kk_cur_lev), prev_mass(kk_cur_lev),
-          prev_dp(kk_cur_lev + _ppm_consts::INITIAL_PADDING), x2_cur_lev);
+          prev_dp(kk_cur_lev + _ppm_consts::INITIAL_PADDING), z2_pows, k);
 
       remap_var(k)[0] = mass_2 - mass_1;
     }); // k loop
@@ -632,10 +631,16 @@ struct PpmVertRemap : public VertRemapAlg {
         // PPM interpolants are normalized to an independent coordinate
         // domain
         // [-0.5, 0.5].
-        m_z2(kv.ie, igp, jgp, k) =
+        const Real x1 = -0.5;
+        const Real x2 =
             (m_pin(kv.ie, igp, jgp, k + 1) -
              (m_pio(kv.ie, igp, jgp, kk) + m_pio(kv.ie, igp, jgp, kk+1)) * 0.5) /
             m_dpo(kv.ie, igp, jgp, kk + _ppm_consts::INITIAL_PADDING);
+        // Store the differences of the powers of the integration bounds,
+        // so that the remap of each tracer only needs the parabola coeffs
+        m_z2_pows(kv.ie, igp, jgp, 0, k) = x2 - x1;
+        m_z2_pows(kv.ie, igp, jgp, 1, k) = x2 * x2 - x1 * x1;
+        m_z2_pows(kv.ie, igp, jgp, 2, k) = x2 * x2 * x2 - x1 * x1 * x1;
       });
 
       auto point_dpo   = Homme::subview(m_dpo, kv.ie, igp, jgp);
@@ -644,11 +649,13 @@ struct PpmVertRemap : public VertRemapAlg {
     });
   }
 
+  // dx1, dx2, dx3 are x2-x1, x2^2-x1^2 and x2^3-x1^3 for the bounds [x1,x2]
   KOKKOS_FORCEINLINE_FUNCTION Real
   integrate_parabola(const Real sq_coeff, const Real lin_coeff,
-                     const Real const_coeff, Real x1, Real x2) const {
-    return (const_coeff * (x2 - x1) + lin_coeff * (x2 * x2 - x1 * x1) / 2.0) +
-           sq_coeff * (x2 * x2 * x2 - x1 * x1 * x1) / 3.0;
+                     const Real const_coeff, const Real dx1, const Real dx2,
+                     const Real dx3) const {
+    return (const_coeff * dx1 + lin_coeff * dx2 / 2.0) +
+           sq_coeff * dx3 / 3.0;
   }
 
   ExecViewManaged<Real * [NP][NP][_ppm_consts::DPO_PHYSICAL_LEV]> m_dpo;
@@ -657,7 +664,8 @@ struct PpmVertRemap : public VertRemapAlg {
   // pin corresponds to the points in each layer of the target layer thickness
   ExecViewManaged<Real * [NP][NP][_ppm_consts::PIN_PHYSICAL_LEV]> m_pin;
   ExecViewManaged<Real * [NP][NP][10][_ppm_consts::PPMDX_PHYSICAL_LEV]> m_ppmdx;
-  ExecViewManaged<Real * [NP][NP][NUM_PHYSICAL_LEV]>  m_z2;
+  // powers of the normalized upper integration bound of each target level
+  ExecViewManaged<Real * [NP][NP][3][NUM_PHYSICAL_LEV]> m_z2_pows;
   ExecViewManaged<int * [NP][NP][NUM_PHYSICAL_LEV]>   m_kid;
 
   TeamUtils<ExecSpace> m_ppm_tu;
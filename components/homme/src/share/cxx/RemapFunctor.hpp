@@ -569,12 +569,12 @@ private:
   void run_functor(const std::string functor_name, int num_exec) {
     const auto policy = remap_team_policy<FunctorTag>(num_exec);
     // Timers don't work on CUDA, so place them here
-    GPTLstart(functor_name.c_str());
+    start_timer(functor_name.c_str());
     profiling_resume();
     Kokkos::parallel_for("vertical remap", policy, *this);
     Kokkos::fence();
     profiling_pause();
-    GPTLstop(functor_name.c_str());
+    stop_timer(functor_name.c_str());
   }
 
   KOKKOS_INLINE_FUNCTION
@@ -358,6 +358,19 @@ public:
 
   // ================ MULTI-LEVEL IMPLEMENTATION =========================== //
 
+  // In the multi-level operators, each thread handles one gll point, and the
+  // vector lanes the levels. The rows of dvv needed at a gll point (igp,jgp) do
+  // not depend on the level, so load them once into registers, rather than
+  // re-reading dvv from memory at every level.
+  KOKKOS_FORCEINLINE_FUNCTION void
+  load_dvv_rows (const int igp, const int jgp, Real (&dvv_i)[NP], Real (&dvv_j)[NP]) const
+  {
+    for (int kgp = 0; kgp < NP; ++kgp) {
+      dvv_i[kgp] = dvv(igp, kgp);
+      dvv_j[kgp] = dvv(jgp, kgp);
+    }
+  }
+
   // Note: if you are puzzled by the use/need of ViewConst, don't worry, you're not alone.
   //       To be clear, using `const typename ExecViewUnmanaged<Scalar[...]>::const_type`
   //       would also work. I prefer ViewConst cause it does not change the 'template
@@ -396,16 +409,22 @@ public:
                          [&](const int loop_idx) {
       const int igp = loop_idx / NP;
       const int jgp = loop_idx % NP;
+      Real dvv_i[NP], dvv_j[NP];
+      load_dvv_rows(igp,jgp,dvv_i,dvv_j);
+      const Real dinv00 = D_inv(0,0,igp,jgp);
+      const Real dinv01 = D_inv(0,1,igp,jgp);
+      const Real dinv10 = D_inv(1,0,igp,jgp);
+      const Real dinv11 = D_inv(1,1,igp,jgp);
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV_REQUEST), [&] (const int& ilev) {
         Scalar v0, v1;
         for (int kgp = 0; kgp < NP; ++kgp) {
-          v0 += dvv(jgp, kgp) * scalar(igp, kgp, ilev);
-          v1 += dvv(igp, kgp) * scalar(kgp, jgp, ilev);
+          v0 += dvv_j[kgp] * scalar(igp, kgp, ilev);
+          v1 += dvv_i[kgp] * scalar(kgp, jgp, ilev);
         }
         v0 *= m_scale_factor_inv;
         v1 *= m_scale_factor_inv;
-        grad_s(0,igp,jgp,ilev) = D_inv(0,0,igp,jgp) * v0 + D_inv(0,1,igp,jgp) * v1;
-        grad_s(1,igp,jgp,ilev) = D_inv(1,0,igp,jgp) * v0 + D_inv(1,1,igp,jgp) * v1;
+        grad_s(0,igp,jgp,ilev) = dinv00 * v0 + dinv01 * v1;
+        grad_s(1,igp,jgp,ilev) = dinv10 * v0 + dinv11 * v1;
       });
     });
     kv.team_barrier();
@@ -442,16 +461,22 @@ public:
                          [&](const int loop_idx) {
       const int igp = loop_idx / NP;
       const int jgp = loop_idx % NP;
+      Real dvv_i[NP], dvv_j[NP];
+      load_dvv_rows(igp,jgp,dvv_i,dvv_j);
+      const Real dinv00 = D_inv(0,0,igp,jgp);
+      const Real dinv01 = D_inv(0,1,igp,jgp);
+      const Real dinv10 = D_inv(1,0,igp,jgp);
+      const Real dinv11 = D_inv(1,1,igp,jgp);
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV_REQUEST), [&] (const int& ilev) {
         Scalar dsdx, dsdy;
         for (int kgp = 0; kgp < NP; ++kgp) {
-          dsdx += dvv(jgp, kgp) * scalar(igp, kgp, ilev);
-          dsdy += dvv(igp, kgp) * scalar(kgp, jgp, ilev);
+          dsdx += dvv_j[kgp] * scalar(igp, kgp, ilev);
+          dsdy += dvv_i[kgp] * scalar(kgp, jgp, ilev);
         }
         dsdx *= m_scale_factor_inv;
         dsdy *= m_scale_factor_inv;
-        grad_s(0,igp,jgp,ilev) += D_inv(0,0,igp,jgp) * dsdx + D_inv(0,1,igp,jgp) * dsdy;
-        grad_s(1,igp,jgp,ilev) += D_inv(1,0,igp,jgp) * dsdx + D_inv(1,1,igp,jgp) * dsdy;
+        grad_s(0,igp,jgp,ilev) += dinv00 * dsdx + dinv01 * dsdy;
+        grad_s(1,igp,jgp,ilev) += dinv10 * dsdx + dinv11 * dsdy;
       });
     });
     kv.team_barrier();
@@ -522,13 +547,16 @@ public:
                          [&](const int loop_idx) {
       const int igp = loop_idx / NP;
       const int jgp = loop_idx % NP;
+      Real dvv_i[NP], dvv_j[NP];
+      load_dvv_rows(igp,jgp,dvv_i,dvv_j);
+      const Real scale = 1.0 / metdet(igp, jgp) * m_scale_factor_inv;
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV_REQUEST), [&] (const int& ilev) {
         Scalar dudx, dvdy;
         for (int kgp = 0; kgp < NP; ++kgp) {
-          dudx += dvv(jgp, kgp) * gv_buf(0, igp, kgp, ilev);
-          dvdy += dvv(igp, kgp) * gv_buf(1, kgp, jgp, ilev);
+          dudx += dvv_j[kgp] * gv_buf(0, igp, kgp, ilev);
+          dvdy += dvv_i[kgp] * gv_buf(1, kgp, jgp, ilev);
         }
-        combine<CM>((dudx + dvdy) * (1.0 / metdet(igp, jgp) * m_scale_factor_inv),
+        combine<CM>((dudx + dvdy) * scale,
                      div_v(igp, jgp, ilev), alpha, beta);
       });
     });
@@ -640,14 +668,16 @@ public:
                          [&](const int loop_idx) {
       const int igp = loop_idx / NP;
       const int jgp = loop_idx % NP;
+      Real dvv_i[NP], dvv_j[NP];
+      load_dvv_rows(igp,jgp,dvv_i,dvv_j);
+      const Real scale = 1.0 / metdet(igp, jgp) * m_scale_factor_inv;
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV_REQUEST), [&] (const int& ilev) {
         Scalar dudy, dvdx;
         for (int kgp = 0; kgp < NP; ++kgp) {
-          dvdx += dvv(jgp, kgp) * vcov_buf(1, igp, kgp, ilev);
-          dudy += dvv(igp, kgp) * vcov_buf(0, kgp, jgp, ilev);
+          dvdx += dvv_j[kgp] * vcov_buf(1, igp, kgp, ilev);
+          dudy += dvv_i[kgp] * vcov_buf(0, kgp, jgp, ilev);
         }
-        vort(igp, jgp, ilev) = (dvdx - dudy) * (1.0 / metdet(igp, jgp) *
-                                                m_scale_factor_inv);
+        vort(igp, jgp, ilev) = (dvdx - dudy) * scale;
       });
     });
     kv.team_barrier();
@@ -689,14 +719,16 @@ public:
                          [&](const int loop_idx) {
       const int igp = loop_idx / NP;
       const int jgp = loop_idx % NP;
+      Real dvv_i[NP], dvv_j[NP];
+      load_dvv_rows(igp,jgp,dvv_i,dvv_j);
+      const Real scale = 1.0 / metdet(igp, jgp) * m_scale_factor_inv;
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV_REQUEST), [&] (const int& ilev) {
         Scalar dudy, dvdx;
         for (int kgp = 0; kgp < NP; ++kgp) {
-          dvdx += dvv(jgp, kgp) * sphere_buf(1, igp, kgp, ilev);
-          dudy += dvv(igp, kgp) * sphere_buf(0, kgp, jgp, ilev);
+          dvdx += dvv_j[kgp] * sphere_buf(1, igp, kgp, ilev);
+          dudy += dvv_i[kgp] * sphere_buf(0, kgp, jgp, ilev);
         }
-        vort(igp, jgp, ilev) = (dvdx - dudy) * (1.0 / metdet(igp, jgp) *
-                                                m_scale_factor_inv);
+        vort(igp, jgp, ilev) = (dvdx - dudy) * scale;
       });
     });
     kv.team_barrier();
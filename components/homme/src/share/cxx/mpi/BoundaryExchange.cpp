@@ -60,6 +60,9 @@ BoundaryExchange::BoundaryExchange()
   m_send_pending = false;
   m_recv_pending = false;
 
+  // By default, exchange in full precision
+  m_reduced_precision = false;
+
   m_diagnostics_level = 0;
 }
 
@@ -90,6 +93,14 @@ void BoundaryExchange::set_label (const std::string& label) { m_label = label; }
 const std::string& BoundaryExchange::get_label () const { return m_label; }
 void BoundaryExchange::set_diagnostics_level (const int level) { m_diagnostics_level = level; }
 
+void BoundaryExchange::set_reduced_precision (const bool reduced_precision)
+{
+  // The mpi requests and the buffers sizes are set up during registration_completed
+  assert (!m_registration_completed);
+
+  m_reduced_precision = reduced_precision;
+}
+
 void BoundaryExchange::set_connectivity (std::shared_ptr<Connectivity> connectivity)
 {
   // Functionality only available before registration starts
@@ -207,6 +218,61 @@ void BoundaryExchange::clean_up()
   m_cleaned_up = true;
 }
 
+void BoundaryExchange::register_fields (const BoundaryExchange& src)
+{
+  // Sanity checks
+  assert (m_registration_started && !m_registration_completed);
+  assert (src.m_registration_started || src.m_registration_completed);
+  assert (src.m_connectivity==m_connectivity);
+  assert (m_num_1d_fields==0 && src.m_num_1d_fields==0);
+  assert (m_num_2d_fields+src.m_num_2d_fields<=m_2d_fields.extent_int(1));
+  assert (m_num_3d_fields+src.m_num_3d_fields<=m_3d_fields.extent_int(1));
+  assert (m_num_3d_int_fields+src.m_num_3d_int_fields<=m_3d_int_fields.extent_int(1));
+
+  const int num_elems = m_connectivity->get_num_local_elements();
+
+  // Copy the views to the src fields (not the data)
+  if (src.m_num_2d_fields>0) {
+    auto l_offset = m_num_2d_fields;
+    auto l_fields = m_2d_fields;
+    auto l_src_fields = src.m_2d_fields;
+    Kokkos::parallel_for(MDRangePolicy<ExecSpace, 2>({0, 0}, {num_elems, src.m_num_2d_fields}, {1, 1}),
+                         KOKKOS_LAMBDA(const int ie, const int ifield){
+      l_fields(ie, l_offset+ifield) = l_src_fields(ie, ifield);
+    });
+  }
+  if (src.m_num_3d_fields>0) {
+    auto l_offset = m_num_3d_fields;
+    auto l_fields = m_3d_fields;
+    auto l_src_fields = src.m_3d_fields;
+    Kokkos::parallel_for(MDRangePolicy<ExecSpace, 2>({0, 0}, {num_elems, src.m_num_3d_fields}, {1, 1}),
+                         KOKKOS_LAMBDA(const int ie, const int ifield){
+      l_fields(ie, l_offset+ifield) = l_src_fields(ie, ifield);
+    });
+  }
+  if (src.m_num_3d_int_fields>0) {
+    auto l_offset = m_num_3d_int_fields;
+    auto l_fields = m_3d_int_fields;
+    auto l_src_fields = src.m_3d_int_fields;
+    Kokkos::parallel_for(MDRangePolicy<ExecSpace, 2>({0, 0}, {num_elems, src.m_num_3d_int_fields}, {1, 1}),
+                         KOKKOS_LAMBDA(const int ie, const int ifield){
+      l_fields(ie, l_offset+ifield) = l_src_fields(ie, ifield);
+    });
+  }
+
+  // If src registration is completed, and all its 3d fields have NUM_LEV levels,
+  // the nlev bookkeeping has already been cleared
+  if (src.m_3d_nlev_pack.empty()) {
+    for (int i = 0; i < src.m_num_3d_fields; ++i) m_3d_nlev_pack.push_back(NUM_LEV);
+  } else {
+    m_3d_nlev_pack.insert(m_3d_nlev_pack.end(),src.m_3d_nlev_pack.begin(),src.m_3d_nlev_pack.end());
+  }
+
+  m_num_2d_fields     += src.m_num_2d_fields;
+  m_num_3d_fields     += src.m_num_3d_fields;
+  m_num_3d_int_fields += src.m_num_3d_int_fields;
+}
+
 void BoundaryExchange::registration_completed()
 {
   // If everything is already set up, just return
@@ -236,6 +302,10 @@ void BoundaryExchange::registration_completed()
   // Determine what kind of BE is this (exchange or exchange_min_max)
   m_exchange_type = m_num_1d_fields>0 ? MPI_EXCHANGE_MIN_MAX : MPI_EXCHANGE;
 
+  // Rounding min/max values to single precision could make the bounds not satisfiable
+  Errors::runtime_check(!m_reduced_precision || m_exchange_type==MPI_EXCHANGE,
+                        "Reduced precision is not supported for min/max exchanges.");
+
   // Finalize bookkeeping for any exchange on fewer than NUM_LEV levels.
   {
     bool need_nlev_pack = false;
@@ -277,6 +347,12 @@ void BoundaryExchange::exchange (ExecViewUnmanaged<const Real * [NP][NP]> rspher
 }
 
 void BoundaryExchange::exchange (const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp)
+{
+  exchange_start ();
+  exchange_finish (rspheremp);
+}
+
+void BoundaryExchange::exchange_start ()
 {
   // Check that the registration has completed first
   assert (m_registration_completed);
@@ -308,6 +384,21 @@ void BoundaryExchange::exchange (const ExecViewUnmanaged<const Real * [NP][NP]>*
 
   // ---- Pack and send ---- //
   pack_and_send ();
+}
+
+void BoundaryExchange::exchange_finish () {
+  exchange_finish(nullptr);
+}
+
+void BoundaryExchange::exchange_finish (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp) {
+  exchange_finish(&rspheremp);
+}
+
+void BoundaryExchange::exchange_finish (const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp)
+{
+  if (m_num_2d_fields+m_num_3d_fields+m_num_3d_int_fields==0) {
+    return;
+  }
 
   // --- Recv and unpack --- //
   recv_and_unpack (rspheremp);
@@ -509,6 +600,15 @@ void BoundaryExchange::pack_and_send ()
   if (m_num_3d_int_fields > 0)
     pack<NUM_LEV_P>(ucon, ucon_ptr, m_3d_int_fields, m_send_3d_int_buffers,
                     m_num_elems, m_num_3d_int_fields);
+
+  // If all connections are on this rank, everything went into the local
+  // buffer, and unpack runs on the same execution space, so there is nothing
+  // to sync or send.
+  if (m_connectivity->is_rank_local()) {
+    m_send_pending = true;
+    tstop("be pack_and_send");
+    return;
+  }
   Kokkos::fence();
 
   // ---- Send ---- //
@@ -709,17 +809,19 @@ void BoundaryExchange::recv_and_unpack (const ExecViewUnmanaged<const Real * [NP
   tstop("be recv_and_unpack book");
 
   // ---- Recv ---- //
-  tstart("be recv waitall");
-  if ( ! m_recv_requests.empty())
-    HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_recv_requests.size(), m_recv_requests.data(), MPI_STATUSES_IGNORE),
-                            m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
-  m_recv_pending = false;
-  tstop("be recv waitall");
-
-  tstart("be recv_and_unpack book");
-  m_buffers_manager->sync_recv_buffer(this);
+  const bool rank_local = m_connectivity->is_rank_local();
+  if (!rank_local) {
+    tstart("be recv waitall");
+    if ( ! m_recv_requests.empty())
+      HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_recv_requests.size(), m_recv_requests.data(), MPI_STATUSES_IGNORE),
+                              m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
+    tstop("be recv waitall");
 
-  tstop("be recv_and_unpack book");
+    tstart("be recv_and_unpack book");
+    m_buffers_manager->sync_recv_buffer(this);
+    tstop("be recv_and_unpack book");
+  }
+  m_recv_pending = false;
 
   // --- Unpack --- //
   const auto& ucon = m_connectivity->get_d_ucon();
@@ -749,7 +851,7 @@ void BoundaryExchange::recv_and_unpack (const ExecViewUnmanaged<const Real * [NP
   // reusable.
 
   tstart("be waitall 2");
-  if ( ! m_send_requests.empty())
+  if ( ! rank_local && ! m_send_requests.empty())
     HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_send_requests.size(), m_send_requests.data(),
                                         MPI_STATUSES_IGNORE),
                             m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
@@ -859,6 +961,12 @@ void BoundaryExchange::pack_and_send_min_max ()
 
   pack_min_max(m_connectivity->get_d_ucon(), m_connectivity->get_d_ucon_ptr(),
                m_1d_fields, m_send_1d_buffers, m_num_elems, m_num_1d_fields);
+
+  // See pack_and_send
+  if (m_connectivity->is_rank_local()) {
+    m_send_pending = true;
+    return;
+  }
   Kokkos::fence();
 
   // ---- Send ---- //
@@ -965,11 +1073,14 @@ void BoundaryExchange::recv_and_unpack_min_max ()
   }
 
   // ---- Recv ---- //
-  if ( ! m_recv_requests.empty())
-    HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_recv_requests.size(), m_recv_requests.data(), MPI_STATUSES_IGNORE),
-                            m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
+  const bool rank_local = m_connectivity->is_rank_local();
+  if (!rank_local) {
+    if ( ! m_recv_requests.empty())
+      HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_recv_requests.size(), m_recv_requests.data(), MPI_STATUSES_IGNORE),
+                              m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
 
-  m_buffers_manager->sync_recv_buffer(this); // Deep copy mpi_recv_buffer into recv_buffer (no op if MPI is on device)
+    m_buffers_manager->sync_recv_buffer(this); // Deep copy mpi_recv_buffer into recv_buffer (no op if MPI is on device)
+  }
 
   unpack_min_max(m_connectivity->get_d_ucon(), m_connectivity->get_d_ucon_ptr(),
                  m_1d_fields, m_recv_1d_buffers, m_num_elems, m_num_1d_fields);
@@ -979,7 +1090,7 @@ void BoundaryExchange::recv_and_unpack_min_max ()
   // this object has finished its send requests, and may erroneously reuse the
   // buffers. Therefore, we must ensure that, upon return, all buffers are
   // reusable.
-  if ( ! m_send_requests.empty())
+  if ( ! rank_local && ! m_send_requests.empty())
     HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_send_requests.size(), m_send_requests.data(), MPI_STATUSES_IGNORE),
                             m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
 
@@ -1150,6 +1261,12 @@ void BoundaryExchange::build_buffer_views_and_requests()
     m_recv_requests.resize(npids);
     MPIViewManaged<Real*>::pointer_type send_ptr = buffers_manager->get_mpi_send_buffer().data();
     MPIViewManaged<Real*>::pointer_type recv_ptr = buffers_manager->get_mpi_recv_buffer().data();
+    MPIViewManaged<float*>::pointer_type send_ptr_sp = nullptr;
+    MPIViewManaged<float*>::pointer_type recv_ptr_sp = nullptr;
+    if (m_reduced_precision) {
+      send_ptr_sp = buffers_manager->get_mpi_send_buffer_sp().data();
+      recv_ptr_sp = buffers_manager->get_mpi_recv_buffer_sp().data();
+    }
     int offset = 0;
     for (size_t ip = 0; ip < npids; ++ip) {
       int count = 0;
@@ -1158,14 +1275,25 @@ void BoundaryExchange::build_buffer_views_and_requests()
         const auto& info = ucon(i);
         count += m_elem_buf_size[info.kind];
       }
-      HOMMEXX_MPI_CHECK_ERROR(MPI_Send_init(send_ptr + offset, count, MPI_DOUBLE,
-                                            pids[ip], m_exchange_type, mpi_comm,
-                                            &m_send_requests[ip]),
-                              m_connectivity->get_comm().mpi_comm());
-      HOMMEXX_MPI_CHECK_ERROR(MPI_Recv_init(recv_ptr + offset, count, MPI_DOUBLE,
-                                            pids[ip], m_exchange_type, mpi_comm,
-                                            &m_recv_requests[ip]),
-                              m_connectivity->get_comm().mpi_comm());
+      if (m_reduced_precision) {
+        HOMMEXX_MPI_CHECK_ERROR(MPI_Send_init(send_ptr_sp + offset, count, MPI_FLOAT,
+                                              pids[ip], m_exchange_type, mpi_comm,
+                                              &m_send_requests[ip]),
+                                m_connectivity->get_comm().mpi_comm());
+        HOMMEXX_MPI_CHECK_ERROR(MPI_Recv_init(recv_ptr_sp + offset, count, MPI_FLOAT,
+                                              pids[ip], m_exchange_type, mpi_comm,
+                                              &m_recv_requests[ip]),
+                                m_connectivity->get_comm().mpi_comm());
+      } else {
+        HOMMEXX_MPI_CHECK_ERROR(MPI_Send_init(send_ptr + offset, count, MPI_DOUBLE,
+                                              pids[ip], m_exchange_type, mpi_comm,
+                                              &m_send_requests[ip]),
+                                m_connectivity->get_comm().mpi_comm());
+        HOMMEXX_MPI_CHECK_ERROR(MPI_Recv_init(recv_ptr + offset, count, MPI_DOUBLE,
+                                              pids[ip], m_exchange_type, mpi_comm,
+                                              &m_recv_requests[ip]),
+                                m_connectivity->get_comm().mpi_comm());
+      }
       offset += count;
     }
   }
@@ -43,7 +43,10 @@ class MpiBuffersManager;
  * (if vector field). When the exchange method is called, ALL the stored
  * fields are packed/exchanged/unpacked. Therefore, if you have two sets
  * of fields that need to be exchanged at different times, you need to
- * register them into two separate BE objects.
+ * register them into two separate BE objects. Conversely, if the fields of
+ * two or more BE objects are ready at the same time, you can fuse them into
+ * a single BE object (see register_fields(const BoundaryExchange&)), which
+ * exchanges them all with one message per neighboring rank.
  *
  * The registration happens in three steps:
  *
@@ -185,6 +188,16 @@ public:
   template<int DIM, typename... Properties>
   void register_min_max_fields (ExecView<Scalar*[DIM][2][NUM_LEV], Properties...> field_min_max, int num_dims, int start_dim);
 
+  // Register all the 2d/3d fields registered in another BE object (whose registration
+  // must have started, and may be completed). This allows to fuse the exchange of
+  // fields that are usually handled by separate BE objects, but that happen to be
+  // ready at the same time, into a single exchange, with a single message per
+  // neighboring rank. The fields of src must be accounted for in the call to
+  // set_num_fields (see the get_num_Xd_fields methods). If the fused object uses
+  // the same MpiBuffersManager as src, the buffers are simply sized for the fused
+  // object, which is the most demanding customer.
+  void register_fields (const BoundaryExchange& src);
+
   // Size the buffers, and initialize the MPI types
   void registration_completed();
 
@@ -192,6 +205,16 @@ public:
   void exchange ();
   void exchange (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp);
 
+  // Split-phase version of exchange: exchange_start starts the receives, then
+  // packs and sends all the registered fields; exchange_finish waits for the
+  // receives, and unpacks. In between, the caller can do work that does not
+  // touch the registered fields, which then overlaps with the communication.
+  // The buffers are locked in between, so no other BoundaryExchange sharing
+  // the same MpiBuffersManager can exchange until exchange_finish is called.
+  void exchange_start ();
+  void exchange_finish ();
+  void exchange_finish (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp);
+
   // Exchange all registered 1d fields, performing min/max operations with neighbors
   void exchange_min_max ();
 
@@ -226,6 +249,16 @@ public:
   // If you are really not sure whether we are still transmitting, you can make sure we're done by calling this
   void waitall ();
 
+  // Opt-in reduced precision for the exchange: the values sent to other ranks
+  // are converted to single precision, halving the size of the MPI messages.
+  // Values exchanged between elements on the same rank are unaffected. Only
+  // use this for fields that tolerate the loss of precision (e.g., intermediate
+  // quantities that are not part of the model state). All the fields of this
+  // object are affected, so register them in a separate BE object. Must be
+  // called before registration_completed, and is not allowed for min/max exchanges.
+  void set_reduced_precision (const bool reduced_precision);
+  bool is_reduced_precision () const { return m_reduced_precision; }
+
   // Set an optional string label for this object. If present, it is used in
   // optional diagnostic output.
   void set_label (const std::string& label);
@@ -301,6 +334,7 @@ private:
   bool        m_cleaned_up;
   bool        m_send_pending;
   bool        m_recv_pending;
+  bool        m_reduced_precision;
 
   int         m_num_elems;
 
@@ -313,6 +347,7 @@ private:
   void free_requests();
   // Only the impl knows about the raw pointer.
   void exchange(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp);
+  void exchange_finish(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp);
 public: // This is semantically private but must be public for nvcc.
   void recv_and_unpack(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp);
 };
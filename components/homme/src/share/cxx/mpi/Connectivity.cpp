@@ -9,6 +9,9 @@
 
 #include <array>
 #include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace Homme
 {
@@ -16,8 +19,10 @@ namespace Homme
 Connectivity::Connectivity ()
  : m_finalized    (false)
  , m_initialized  (false)
+ , m_rank_local   (false)
  , m_num_local_elements (-1)
  , m_max_corner_elements(-1)
+ , m_num_boundary_elements(0)
 {
   // Nothing to be done here
 }
@@ -134,7 +139,9 @@ void Connectivity::finalize(const bool sanity_check)
     }
     h_num_connections(etoi(ConnectionKind::ANY),etoi(ConnectionKind::ANY)) += h_num_connections(etoi(ConnectionSharing::ANY),kind);
   }
+  m_rank_local = h_num_connections(etoi(ConnectionSharing::SHARED),etoi(ConnectionKind::ANY))==0;
 
+  setup_elem_order();
   setup_ucon();
 
   m_finalized = true;
@@ -159,6 +166,27 @@ bool Connectivity::UConInfo::operator< (const UConInfo& o) const {
   return r_gid < o.r_gid;
 }
 
+void Connectivity::setup_elem_order () {
+  std::vector<bool> is_boundary(m_num_local_elements,false);
+  for (const auto& uci : ucon_info) {
+    if (uci.sharing == etoi(ConnectionSharing::SHARED)) {
+      is_boundary[uci.l_lid] = true;
+    }
+  }
+
+  d_elem_order = decltype(d_elem_order)("Element order", m_num_local_elements);
+  h_elem_order = Kokkos::create_mirror_view(d_elem_order);
+  int pos = 0;
+  for (int ie = 0; ie < m_num_local_elements; ++ie) {
+    if (is_boundary[ie]) h_elem_order(pos++) = ie;
+  }
+  m_num_boundary_elements = pos;
+  for (int ie = 0; ie < m_num_local_elements; ++ie) {
+    if (!is_boundary[ie]) h_elem_order(pos++) = ie;
+  }
+  Kokkos::deep_copy(d_elem_order, h_elem_order);
+}
+
 void Connectivity::setup_ucon () {
   const size_t nconn = ucon_info.size();
 
@@ -313,6 +341,172 @@ void Connectivity::setup_ucon () {
   }
 }
 
+namespace {
+
+// Header of a connectivity cache file, followed by the offsets of the blocks of
+// all ranks (num_ranks+1 values), and by the blocks themselves
+struct CacheHeader {
+  std::uint64_t magic;
+  std::int32_t  version;
+  std::int32_t  num_ranks;
+  // Identity of the mesh
+  std::int32_t  ne;
+  std::int32_t  num_global_elems;
+  std::int64_t  num_global_edges;
+};
+
+// Header of the block of a rank, followed by its connections
+struct CacheBlockHeader {
+  std::int32_t  num_local_elements;
+  std::int32_t  max_corner_elements;
+  std::uint64_t gids_hash;
+  std::int64_t  num_connections;
+};
+
+constexpr std::uint64_t CACHE_MAGIC   = 0x4e4f43584d4d4f48; // "HOMMXCON"
+constexpr std::int32_t  CACHE_VERSION = 2;
+
+// FNV-1a hash of the gids of the local elements
+std::uint64_t hash_gids (const int* gids, const int num_elems) {
+  std::uint64_t h = 14695981039346656037ull;
+  for (int ie=0; ie<num_elems; ++ie) {
+    h ^= static_cast<std::uint32_t>(gids[ie]);
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+// Sum over the ranks of the number of grid edges of each rank
+std::int64_t global_num_edges (const int num_edges, const MPI_Comm comm) {
+  std::int64_t local = num_edges, global = 0;
+  MPI_Allreduce(&local,&global,1,MPI_INT64_T,MPI_SUM,comm);
+  return global;
+}
+
+} // anonymous namespace
+
+bool Connectivity::read_cache (const std::string& filename, const int* local_gids,
+                               const int ne, const int num_global_elems, const int num_edges)
+{
+  assert (m_initialized);
+  assert (!m_finalized);
+
+  const MPI_Comm comm = m_comm.mpi_comm();
+  const std::int64_t num_global_edges = global_num_edges(num_edges,comm);
+  MPI_File fh;
+  if (MPI_File_open(comm,filename.c_str(),MPI_MODE_RDONLY,MPI_INFO_NULL,&fh)!=MPI_SUCCESS) {
+    return false;
+  }
+
+  // Check the header on the root rank
+  CacheHeader header;
+  int ok = 1;
+  if (m_comm.root()) {
+    ok = MPI_File_read_at(fh,0,&header,sizeof(CacheHeader),MPI_BYTE,MPI_STATUS_IGNORE)==MPI_SUCCESS &&
+         header.magic==CACHE_MAGIC && header.version==CACHE_VERSION &&
+         header.num_ranks==m_comm.size() &&
+         header.ne==ne && header.num_global_elems==num_global_elems &&
+         header.num_global_edges==num_global_edges;
+  }
+  MPI_Bcast(&ok,1,MPI_INT,0,comm);
+
+  // Read and check this rank's block
+  std::vector<UConInfo> cached;
+  if (ok) {
+    std::int64_t offsets[2];
+    const MPI_Offset offsets_pos = sizeof(CacheHeader) + m_comm.rank()*sizeof(std::int64_t);
+    CacheBlockHeader block;
+    ok = MPI_File_read_at(fh,offsets_pos,offsets,2*sizeof(std::int64_t),MPI_BYTE,MPI_STATUS_IGNORE)==MPI_SUCCESS &&
+         MPI_File_read_at(fh,offsets[0],&block,sizeof(CacheBlockHeader),MPI_BYTE,MPI_STATUS_IGNORE)==MPI_SUCCESS &&
+         block.num_local_elements==m_num_local_elements &&
+         block.max_corner_elements==m_max_corner_elements &&
+         block.gids_hash==hash_gids(local_gids,m_num_local_elements) &&
+         offsets[1]-offsets[0]==static_cast<std::int64_t>(sizeof(CacheBlockHeader)+block.num_connections*sizeof(UConInfo));
+    if (ok) {
+      cached.resize(block.num_connections);
+      ok = MPI_File_read_at(fh,offsets[0]+sizeof(CacheBlockHeader),cached.data(),
+                            block.num_connections*sizeof(UConInfo),MPI_BYTE,MPI_STATUS_IGNORE)==MPI_SUCCESS;
+    }
+  }
+  MPI_File_close(&fh);
+
+  // Either all ranks use the cache, or none does
+  MPI_Allreduce(MPI_IN_PLACE,&ok,1,MPI_INT,MPI_LAND,comm);
+  if (!ok) {
+    return false;
+  }
+
+  for (const auto& uci : cached) {
+    ++h_num_connections(uci.sharing,uci.kind);
+  }
+  ucon_info = std::move(cached);
+
+  return true;
+}
+
+void Connectivity::write_cache (const std::string& filename, const int* local_gids,
+                                const int ne, const int num_global_elems, const int num_edges) const
+{
+  assert (m_finalized);
+
+  const MPI_Comm comm = m_comm.mpi_comm();
+  const int nranks = m_comm.size();
+  const std::int64_t num_global_edges = global_num_edges(num_edges,comm);
+
+  // Rebuild the connections from the host ucon (ucon_info is emptied in finalize)
+  const int nconn = h_ucon_ptr(m_num_local_elements);
+  std::vector<UConInfo> conns(nconn);
+  for (int i=0; i<nconn; ++i) {
+    const auto& info = h_ucon(i);
+    conns[i] = UConInfo{info.local.lid, info.local.gid, info.remote.lid, info.remote.gid,
+                        info.remote_pid,
+                        info.local.dir, info.local.dir_idx, info.remote.dir, info.remote.dir_idx,
+                        info.kind, info.sharing, info.direction};
+  }
+  CacheBlockHeader block;
+  block.num_local_elements  = m_num_local_elements;
+  block.max_corner_elements = m_max_corner_elements;
+  block.gids_hash           = hash_gids(local_gids,m_num_local_elements);
+  block.num_connections     = nconn;
+
+  // Offset of this rank's block
+  const std::int64_t block_size = sizeof(CacheBlockHeader) + nconn*sizeof(UConInfo);
+  const std::int64_t header_size = sizeof(CacheHeader) + (nranks+1)*sizeof(std::int64_t);
+  std::int64_t offset = 0, total_size = 0;
+  MPI_Exscan(&block_size,&offset,1,MPI_INT64_T,MPI_SUM,comm);
+  MPI_Allreduce(&block_size,&total_size,1,MPI_INT64_T,MPI_SUM,comm);
+  if (m_comm.root()) {
+    offset = 0; // MPI_Exscan leaves it undefined on rank 0
+  }
+  offset += header_size;
+
+  std::vector<std::int64_t> offsets(m_comm.root() ? nranks+1 : 1);
+  MPI_Gather(&offset,1,MPI_INT64_T,offsets.data(),1,MPI_INT64_T,0,comm);
+  offsets.back() = header_size + total_size;
+
+  MPI_File fh;
+  int err = MPI_File_open(comm,filename.c_str(),MPI_MODE_CREATE|MPI_MODE_WRONLY,MPI_INFO_NULL,&fh);
+  Errors::runtime_check(err==MPI_SUCCESS,
+      "Connectivity::write_cache: could not open '" + filename + "' for writing.");
+  MPI_File_set_size(fh,0);
+
+  int ok = 1;
+  if (m_comm.root()) {
+    const CacheHeader header {CACHE_MAGIC,CACHE_VERSION,nranks,ne,num_global_elems,num_global_edges};
+    ok = MPI_File_write_at(fh,0,&header,sizeof(CacheHeader),MPI_BYTE,MPI_STATUS_IGNORE)==MPI_SUCCESS &&
+         MPI_File_write_at(fh,sizeof(CacheHeader),offsets.data(),(nranks+1)*sizeof(std::int64_t),
+                           MPI_BYTE,MPI_STATUS_IGNORE)==MPI_SUCCESS;
+  }
+  ok = ok &&
+       MPI_File_write_at(fh,offset,&block,sizeof(CacheBlockHeader),MPI_BYTE,MPI_STATUS_IGNORE)==MPI_SUCCESS &&
+       MPI_File_write_at(fh,offset+sizeof(CacheBlockHeader),conns.data(),nconn*sizeof(UConInfo),
+                         MPI_BYTE,MPI_STATUS_IGNORE)==MPI_SUCCESS;
+  MPI_File_close(&fh);
+
+  MPI_Allreduce(MPI_IN_PLACE,&ok,1,MPI_INT,MPI_LAND,comm);
+  Errors::runtime_check(ok,"Connectivity::write_cache: could not write '" + filename + "'.");
+}
+
 void Connectivity::clean_up()
 {
   // Cleaning the elements counter
@@ -322,6 +516,9 @@ void Connectivity::clean_up()
   h_ucon = decltype(h_ucon)("", 0);
   d_ucon_ptr = decltype(d_ucon_ptr)("", 0);
   h_ucon_ptr = decltype(h_ucon_ptr)("", 0);
+  d_elem_order = decltype(d_elem_order)("", 0);
+  h_elem_order = decltype(h_elem_order)("", 0);
+  m_num_boundary_elements = 0;
 
   m_initialized = false;
   m_finalized   = false;
@@ -85,6 +85,21 @@ public:
   void finalize (const bool sanity_check = true);
 
   void clean_up ();
+
+  // The local connections can be cached in a file, so that later runs with the
+  // same mesh and decomposition skip their construction. The file is written and
+  // read collectively, with one block per rank. The mesh is identified by ne, the
+  // global number of elements, and the global number of grid edges (the sum over
+  // ranks of num_edges, the number of edges given to this rank); the decomposition
+  // by the number of ranks and the gids of the local elements (in lid order).
+  // read_cache must be called instead of add_connection, and before finalize. It
+  // returns false on all ranks if the file is missing, or does not match the
+  // mesh or the decomposition on any rank, in which case the connectivity is unchanged.
+  // write_cache must be called after finalize.
+  bool read_cache  (const std::string& filename, const int* local_gids,
+                    const int ne, const int num_global_elems, const int num_edges);
+  void write_cache (const std::string& filename, const int* local_gids,
+                    const int ne, const int num_global_elems, const int num_edges) const;
   //@}
 
   //@name Getters
@@ -123,6 +138,20 @@ public:
   int get_num_local_connections  () const { return get_num_connections<MemSpace>(ConnectionSharing::LOCAL, ConnectionKind::ANY); }
 
   int get_num_local_elements     () const { return m_num_local_elements;  }
+
+  // True if no connection leaves this rank, e.g. a doubly-periodic mesh run on
+  // a single rank, where the periodic neighbors wrap around to local elements.
+  // Halo exchanges then need no MPI at all: every connection is a device copy
+  // through the local buffer. Valid only after finalize.
+  bool is_rank_local () const { return m_rank_local; }
+
+  // Local element ids, with the boundary elements (the ones with at least one
+  // shared connection) first, followed by the interior ones, each group in lid
+  // order. Callers that overlap a boundary exchange with computation can work
+  // on elems(0:num_boundary) first, then on elems(num_boundary:num_local).
+  ExecViewUnmanaged<const int*> get_d_elem_order () const { return d_elem_order; }
+  HostViewUnmanaged<const int*> get_h_elem_order () const { return h_elem_order; }
+  int get_num_boundary_elements  () const { return m_num_boundary_elements; }
   int get_max_corner_elements    () const { return m_max_corner_elements; }
 
   bool is_initialized () const { return m_initialized; }
@@ -141,6 +170,7 @@ private:
 
   bool    m_finalized;
   bool    m_initialized;
+  bool    m_rank_local;
 
   int     m_num_local_elements, m_max_corner_elements;
 
@@ -156,6 +186,10 @@ private:
   ExecViewManaged<int*>::HostMirror h_ucon_ptr;
   ExecViewManaged<int*>             d_ucon_dir_ptr;
   ExecViewManaged<int*>::HostMirror h_ucon_dir_ptr;
+  // Boundary-first element ordering
+  int                               m_num_boundary_elements;
+  ExecViewManaged<int*>             d_elem_order;
+  ExecViewManaged<int*>::HostMirror h_elem_order;
   // Helper used to accumulate connections during add_connection phase. Emptied
   // in finalize. l_ is local; r_ is remote.
   struct UConInfo {
@@ -167,6 +201,9 @@ private:
   // In finalize call, construct the unstructured connectivity data using
   // ucon_info.
   void setup_ucon();
+  // In finalize call, construct the boundary-first element ordering using
+  // ucon_info.
+  void setup_elem_order();
 };
 
 } // namespace Homme
@@ -18,6 +18,7 @@ MpiBuffersManager::MpiBuffersManager ()
  , m_local_buffer_size (0)
  , m_buffers_busy      (false)
  , m_views_are_valid   (false)
+ , m_reduced_precision_needed (false)
 {
   // The "fake" buffers used for MISSING connections. These do not depend on the requirements
   // from the custormers, so we can create them right away.
@@ -81,8 +82,31 @@ void MpiBuffersManager::allocate_buffers ()
   m_local_buffer = ExecViewManaged<Real*>("local buffer", m_local_buffer_size);
 
   // The buffers used in MPI calls
+#ifdef HOMMEXX_MPI_PINNED_SPACE
+  // The mpi buffers view pinned host allocations
+  m_pinned_send_buffer = PinnedView<Real>("mpi send buffer", m_mpi_buffer_size);
+  m_pinned_recv_buffer = PinnedView<Real>("mpi recv buffer", m_mpi_buffer_size);
+  m_mpi_send_buffer = decltype(m_mpi_send_buffer)(m_pinned_send_buffer.data(),m_mpi_buffer_size);
+  m_mpi_recv_buffer = decltype(m_mpi_recv_buffer)(m_pinned_recv_buffer.data(),m_mpi_buffer_size);
+#else
   m_mpi_send_buffer = Kokkos::create_mirror_view(decltype(m_mpi_send_buffer)::execution_space(),m_send_buffer);
   m_mpi_recv_buffer = Kokkos::create_mirror_view(decltype(m_mpi_recv_buffer)::execution_space(),m_recv_buffer);
+#endif
+
+  // The single precision buffers, only for the mpi part of the exchange
+  if (m_reduced_precision_needed) {
+    m_send_buffer_sp = ExecViewManaged<float*>("send buffer sp", m_mpi_buffer_size);
+    m_recv_buffer_sp = ExecViewManaged<float*>("recv buffer sp", m_mpi_buffer_size);
+#ifdef HOMMEXX_MPI_PINNED_SPACE
+    m_pinned_send_buffer_sp = PinnedView<float>("mpi send buffer sp", m_mpi_buffer_size);
+    m_pinned_recv_buffer_sp = PinnedView<float>("mpi recv buffer sp", m_mpi_buffer_size);
+    m_mpi_send_buffer_sp = decltype(m_mpi_send_buffer_sp)(m_pinned_send_buffer_sp.data(),m_mpi_buffer_size);
+    m_mpi_recv_buffer_sp = decltype(m_mpi_recv_buffer_sp)(m_pinned_recv_buffer_sp.data(),m_mpi_buffer_size);
+#else
+    m_mpi_send_buffer_sp = Kokkos::create_mirror_view(decltype(m_mpi_send_buffer_sp)::execution_space(),m_send_buffer_sp);
+    m_mpi_recv_buffer_sp = Kokkos::create_mirror_view(decltype(m_mpi_recv_buffer_sp)::execution_space(),m_recv_buffer_sp);
+#endif
+  }
 
   m_views_are_valid = true;
 
@@ -117,7 +141,7 @@ void MpiBuffersManager::add_customer (BoundaryExchange* add_me)
   assert (m_customers.find(add_me)==m_customers.end());
 
   // Add to the list of customers
-  auto pair_it_bool = m_customers.emplace(add_me,CustomerNeeds{0,0});
+  auto pair_it_bool = m_customers.emplace(add_me,CustomerNeeds{0,0,false});
 
   // Update the number of customers
   ++m_num_customers;
@@ -180,6 +204,45 @@ void MpiBuffersManager::update_requested_sizes (typename std::map<BoundaryExchan
     // Mark the views as invalid
     m_views_are_valid = false;
   }
+
+  customer.second.reduced_precision = customer.first->is_reduced_precision();
+  if (customer.second.reduced_precision && !m_reduced_precision_needed) {
+    // We need the single precision buffers too
+    m_reduced_precision_needed = true;
+
+    // Mark the views as invalid
+    m_views_are_valid = false;
+  }
+}
+
+void MpiBuffersManager::sync_send_buffer_sp (const size_t size)
+{
+  // Convert the mpi part of the send buffer to single precision, then deep copy to the mpi buffer
+  ExecViewUnmanaged<const Real*> send_view(m_send_buffer.data(),size);
+  ExecViewUnmanaged<float*> send_view_sp(m_send_buffer_sp.data(),size);
+  Kokkos::parallel_for(Kokkos::RangePolicy<ExecSpace>(0,size),
+                       KOKKOS_LAMBDA(const int i) {
+    send_view_sp(i) = static_cast<float>(send_view(i));
+  });
+  Kokkos::fence();
+
+  MPIViewUnmanaged<float*> mpi_send_view_sp(m_mpi_send_buffer_sp.data(),size);
+  Kokkos::deep_copy(mpi_send_view_sp, send_view_sp);
+}
+
+void MpiBuffersManager::sync_recv_buffer_sp (const size_t size)
+{
+  // Deep copy the mpi buffer, then convert it back to double precision into the recv buffer
+  MPIViewUnmanaged<const float*> mpi_recv_view_sp(m_mpi_recv_buffer_sp.data(),size);
+  ExecViewUnmanaged<float*> recv_view_sp(m_recv_buffer_sp.data(),size);
+  Kokkos::deep_copy(recv_view_sp, mpi_recv_view_sp);
+
+  ExecViewUnmanaged<Real*> recv_view(m_recv_buffer.data(),size);
+  Kokkos::parallel_for(Kokkos::RangePolicy<ExecSpace>(0,size),
+                       KOKKOS_LAMBDA(const int i) {
+    recv_view(i) = recv_view_sp(i);
+  });
+  Kokkos::fence();
 }
 
 void MpiBuffersManager::required_buffer_sizes (const int num_1d_fields, const int num_2d_fields,
@@ -15,6 +15,16 @@
 
 #include "MpiHelpers.hpp"
 
+// In GPU builds where MPI uses host pointers, the host MPI buffers can be
+// allocated in pinned memory, which speeds up the host-device copies
+#if defined(HOMMEXX_ENABLE_GPU) && !HOMMEXX_MPI_ON_DEVICE && HOMMEXX_MPI_PINNED_HOST
+# if defined(KOKKOS_ENABLE_CUDA)
+#  define HOMMEXX_MPI_PINNED_SPACE Kokkos::CudaHostPinnedSpace
+# elif defined(KOKKOS_ENABLE_HIP)
+#  define HOMMEXX_MPI_PINNED_SPACE Kokkos::HIPHostPinnedSpace
+# endif
+#endif
+
 namespace Homme
 {
 
@@ -63,7 +73,9 @@ class BoundaryExchange;
  *    Execution Space. This is always true for CPU/KNL builds, but
  *    it may or may not be true for GPU builds.
  *    The send/recv buffers are used to pack/unpack the data, while
- *    the mpi_send/mpi_recv buffers are used by MPI.
+ *    the mpi_send/mpi_recv buffers are used by MPI. If MPI is done on
+ *    host in a GPU build, the mpi buffers are allocated in pinned host
+ *    memory (unless HOMMEXX_MPI_PINNED_HOST is off).
  *
  * The BM class also takes care of syncing the send/recv buffers
  * with the mpi_send/mpi_recv buffers, via a call to Kokkos::deep_copy,
@@ -111,6 +123,8 @@ public:
   ExecViewUnmanaged<Real*> get_local_buffer          () const;
   MPIViewUnmanaged<Real*>  get_mpi_send_buffer       () const;
   MPIViewUnmanaged<Real*>  get_mpi_recv_buffer       () const;
+  MPIViewUnmanaged<float*> get_mpi_send_buffer_sp    () const;
+  MPIViewUnmanaged<float*> get_mpi_recv_buffer_sp    () const;
   ExecViewUnmanaged<Real*> get_blackhole_send_buffer () const;
   ExecViewUnmanaged<Real*> get_blackhole_recv_buffer () const;
 
@@ -127,17 +141,23 @@ private:
   void add_customer (BoundaryExchange* add_me);
   void remove_customer (BoundaryExchange* remove_me);
   // Deep copy the send/recv buffer to/from the mpi_send/recv buffer
-  // Note: these are no-ops if MPIMemSpace=ExecMemSpace
+  // Note: these are no-ops if MPIMemSpace=ExecMemSpace, unless the customer
+  //       exchanges in reduced precision, in which case the values are
+  //       converted to/from the single precision mpi buffers
   void sync_send_buffer (BoundaryExchange* customer);
   void sync_recv_buffer (BoundaryExchange* customer);
+  void sync_send_buffer_sp (const size_t size);
+  void sync_recv_buffer_sp (const size_t size);
 
   // Small struct, to hold customer's needs. We could use an std::pair, but this is more verbose
   struct CustomerNeeds {
     size_t local_buffer_size;
     size_t mpi_buffer_size;
+    bool   reduced_precision;
 
     bool operator== (const CustomerNeeds& rhs) {
-      return local_buffer_size==rhs.local_buffer_size && mpi_buffer_size==rhs.mpi_buffer_size;
+      return local_buffer_size==rhs.local_buffer_size && mpi_buffer_size==rhs.mpi_buffer_size &&
+             reduced_precision==rhs.reduced_precision;
     }
   };
 
@@ -163,6 +183,9 @@ private:
   // Used to check whether user can still request different sizes
   bool m_views_are_valid;
 
+  // Whether some customer exchanges in reduced precision (see BoundaryExchange::set_reduced_precision)
+  bool m_reduced_precision_needed;
+
   // Customers of this MpiBuffersManager, each with its local and mpi sizes
   std::map<BoundaryExchange*,CustomerNeeds>  m_customers;
 
@@ -178,6 +201,23 @@ private:
   MPIViewManaged<Real*>   m_mpi_send_buffer;
   MPIViewManaged<Real*>   m_mpi_recv_buffer;
 
+  // Single precision versions of the send/recv buffers and of the mpi buffers,
+  // allocated only if some customer exchanges in reduced precision
+  ExecViewManaged<float*> m_send_buffer_sp;
+  ExecViewManaged<float*> m_recv_buffer_sp;
+  MPIViewManaged<float*>  m_mpi_send_buffer_sp;
+  MPIViewManaged<float*>  m_mpi_recv_buffer_sp;
+
+#ifdef HOMMEXX_MPI_PINNED_SPACE
+  // The pinned memory allocations that the mpi buffers view
+  template<typename T>
+  using PinnedView = Kokkos::View<T*,HOMMEXX_MPI_PINNED_SPACE>;
+  PinnedView<Real>  m_pinned_send_buffer;
+  PinnedView<Real>  m_pinned_recv_buffer;
+  PinnedView<float> m_pinned_send_buffer_sp;
+  PinnedView<float> m_pinned_recv_buffer_sp;
+#endif
+
   // The blackhole send/recv buffers (used for missing connections)
   ExecViewManaged<Real*>  m_blackhole_send_buffer;
   ExecViewManaged<Real*>  m_blackhole_recv_buffer;
@@ -188,8 +228,11 @@ inline void MpiBuffersManager::sync_send_buffer (BoundaryExchange* customer)
   // Only customers can call this
   assert (m_customers.find(customer)!=m_customers.end());
 
-  const size_t customer_mpi_buffer_size = m_customers.find(customer)->second.mpi_buffer_size;
-  if (customer_mpi_buffer_size<m_mpi_buffer_size) {
+  const auto& needs = m_customers.find(customer)->second;
+  const size_t customer_mpi_buffer_size = needs.mpi_buffer_size;
+  if (needs.reduced_precision) {
+    sync_send_buffer_sp(customer_mpi_buffer_size);
+  } else if (customer_mpi_buffer_size<m_mpi_buffer_size) {
     // Avoid copying more than we need
     MPIViewUnmanaged<Real*>  mpi_send_view(m_mpi_send_buffer.data(),customer_mpi_buffer_size);
     ExecViewUnmanaged<const Real*> send_view(m_send_buffer.data(),customer_mpi_buffer_size);
@@ -204,8 +247,11 @@ inline void MpiBuffersManager::sync_recv_buffer (BoundaryExchange* customer)
   // Only customers can call this
   assert (m_customers.find(customer)!=m_customers.end());
 
-  const size_t customer_mpi_buffer_size = m_customers.find(customer)->second.mpi_buffer_size;
-  if (customer_mpi_buffer_size<m_mpi_buffer_size) {
+  const auto& needs = m_customers.find(customer)->second;
+  const size_t customer_mpi_buffer_size = needs.mpi_buffer_size;
+  if (needs.reduced_precision) {
+    sync_recv_buffer_sp(customer_mpi_buffer_size);
+  } else if (customer_mpi_buffer_size<m_mpi_buffer_size) {
     // Avoid copying more than we need
     MPIViewUnmanaged<const Real*>  mpi_recv_view(m_mpi_recv_buffer.data(),customer_mpi_buffer_size);
     ExecViewUnmanaged<Real*> recv_view(m_recv_buffer.data(),customer_mpi_buffer_size);
@@ -255,6 +301,22 @@ MpiBuffersManager::get_mpi_recv_buffer() const
   return m_mpi_recv_buffer;
 }
 
+inline MPIViewUnmanaged<float*>
+MpiBuffersManager::get_mpi_send_buffer_sp() const
+{
+  // We ensure that the buffers are valid, and that single precision ones were requested
+  assert(m_views_are_valid && m_reduced_precision_needed);
+  return m_mpi_send_buffer_sp;
+}
+
+inline MPIViewUnmanaged<float*>
+MpiBuffersManager::get_mpi_recv_buffer_sp() const
+{
+  // We ensure that the buffers are valid, and that single precision ones were requested
+  assert(m_views_are_valid && m_reduced_precision_needed);
+  return m_mpi_recv_buffer_sp;
+}
+
 inline ExecViewUnmanaged<Real*>
 MpiBuffersManager::get_blackhole_send_buffer () const
 {
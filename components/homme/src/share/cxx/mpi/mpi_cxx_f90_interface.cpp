@@ -84,6 +84,22 @@ void finalize_connectivity ()
   connectivity.finalize();
 }
 
+void read_connectivity_cache (const char** filename, const int* local_gids,
+                              const int& ne, const int& nelem, const int& num_edges, bool& loaded)
+{
+  Connectivity& connectivity = Context::singleton().get<Connectivity>();
+
+  loaded = connectivity.read_cache(*filename,local_gids,ne,nelem,num_edges);
+}
+
+void write_connectivity_cache (const char** filename, const int* local_gids,
+                               const int& ne, const int& nelem, const int& num_edges)
+{
+  Connectivity& connectivity = Context::singleton().get<Connectivity>();
+
+  connectivity.write_cache(*filename,local_gids,ne,nelem,num_edges);
+}
+
 } // extern "C"
 
 } // namespace Homme
@@ -12,13 +12,44 @@
 
 #include "gptl.h"
 
-#ifdef HOMMEXX_ENABLE_GPU
-#define start_timer(name) {}
-#define stop_timer(name) {}
-#else
-#define start_timer(name) { GPTLstart(name); }
-#define stop_timer(name) { GPTLstop(name); }
-#endif
+namespace Homme {
+
+// If enabled, each GPTL timer also marks a Kokkos Tools region, which
+// Nsight Systems and rocprof show as NVTX and ROCTX ranges. Set
+// HOMMEXX_PROFILING_REGIONS=1 in the environment to enable at run time; this
+// is read in initialize_hommexx_session. When disabled, the cost is a branch.
+inline bool& profiling_regions_enabled () {
+  static bool enabled = false;
+  return enabled;
+}
+
+inline void start_timer (const char* name) {
+  GPTLstart(name);
+  if (profiling_regions_enabled()) Kokkos::Profiling::pushRegion(name);
+}
+
+inline void stop_timer (const char* name) {
+  if (profiling_regions_enabled()) Kokkos::Profiling::popRegion();
+  GPTLstop(name);
+}
+
+// Same as above, but the caller keeps a GPTL handle for the timer (initially
+// null), so that GPTL does not hash the name at each call. GPTL timers are
+// per thread; a handle set by one thread is ignored by the others, which then
+// fall back to the name lookup.
+using timer_handle_t = void*;
+
+inline void start_timer (const char* name, timer_handle_t& handle) {
+  GPTLstart_handle(name, &handle);
+  if (profiling_regions_enabled()) Kokkos::Profiling::pushRegion(name);
+}
+
+inline void stop_timer (const char* name, timer_handle_t& handle) {
+  if (profiling_regions_enabled()) Kokkos::Profiling::popRegion();
+  GPTLstop_handle(name, &handle);
+}
+
+} // namespace Homme
 
 #ifdef VTUNE_PROFILE
 #include <ittnotify.h>
@@ -40,7 +40,10 @@ struct Tracers;
 struct CaarFunctorImpl {
 
   struct Buffers {
-    static constexpr int num_3d_scalar_mid_buf = 10;
+    // Note: some buffers are only needed in the first epochs of the pre-exchange
+    //       kernel, and some only in the last ones. The latter alias the former
+    //       (see init_buffers), so they are not counted here.
+    static constexpr int num_3d_scalar_mid_buf =  8;
     static constexpr int num_3d_vector_mid_buf =  5;
     static constexpr int num_3d_scalar_int_buf =  6;
     static constexpr int num_3d_vector_int_buf =  3;
@@ -123,6 +126,10 @@ struct CaarFunctorImpl {
 
   Kokkos::Array<std::shared_ptr<BoundaryExchange>, NUM_TIME_LEVELS> m_bes;
 
+  // GPTL handles of the timers in run()
+  timer_handle_t m_compute_timer = nullptr;
+  timer_handle_t m_bexch_timer   = nullptr;
+
   CaarFunctorImpl(const Elements &elements, const Tracers &/* tracers */,
                   const ReferenceElement &ref_FE, const HybridVCoord &hvcoord,
                   const SphereOperators &sphere_ops, const SimulationParams& params)
@@ -239,12 +246,14 @@ struct CaarFunctorImpl {
     mem += m_buffers.div_vdp.size();
     m_buffers.omega_p    = decltype(m_buffers.omega_p   )(mem,nslots);
     mem += m_buffers.omega_p.size();
-    m_buffers.vort       = decltype(m_buffers.vort)(mem,nslots);
-    mem += m_buffers.vort.size();
     m_buffers.theta_tens = decltype(m_buffers.theta_tens)(mem,nslots);
     mem += m_buffers.theta_tens.size();
-    m_buffers.dp_tens    = decltype(m_buffers.dp_tens   )(mem,nslots);
-    mem += m_buffers.dp_tens.size();
+
+    // pnh and phi are no longer needed once the vertical advection is done.
+    // dp_tens is first written after the barrier that follows it (in epoch 3),
+    // and vort in compute_v_tens (epoch 4), so they can reuse that memory.
+    m_buffers.dp_tens    = m_buffers.pnh;
+    m_buffers.vort       = m_buffers.phi;
 
     // Midpoints vectors
     m_buffers.grad_exner = decltype(m_buffers.grad_exner)(mem,nslots);
@@ -345,24 +354,24 @@ struct CaarFunctorImpl {
 
     profiling_resume();
 
-    GPTLstart("caar compute");
+    start_timer("caar compute",m_compute_timer);
     int nerr;
     Kokkos::parallel_reduce("caar loop pre-boundary exchange", m_policy_pre, *this, nerr);
     Kokkos::fence();
-    GPTLstop("caar compute");
+    stop_timer("caar compute",m_compute_timer);
     if (nerr > 0)
       check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
 
-    GPTLstart("caar_bexchV");
+    start_timer("caar_bexchV",m_bexch_timer);
     m_bes[data.np1]->exchange(m_geometry.m_rspheremp);
     Kokkos::fence();
-    GPTLstop("caar_bexchV");
+    stop_timer("caar_bexchV",m_bexch_timer);
 
     if (!m_theta_hydrostatic_mode) {
-      GPTLstart("caar compute");
+      start_timer("caar compute",m_compute_timer);
       Kokkos::parallel_for("caar loop post-boundary exchange", m_policy_post, *this);
       Kokkos::fence();
-      GPTLstop("caar compute");
+      stop_timer("caar compute",m_compute_timer);
     }
 
     limiter.run(data.np1);
@@ -1140,12 +1149,9 @@ struct CaarFunctorImpl {
       kv.team_barrier();
 
       // Compute grad(average(w^2/2)). Store in wvor.
+      // Note: grad(w) was already computed in compute_w_and_phi_tens, in grad_w_i.
       m_sphere_ops.gradient_sphere(kv, Homme::subview(m_buffers.temp,kv.team_idx),
                                        wvor);
-
-      // Compute grad(w)
-      m_sphere_ops.gradient_sphere(kv, Homme::subview(m_state.m_w_i,kv.ie,m_data.n0),
-                                       Homme::subview(m_buffers.v_i,kv.team_idx));
       kv.team_barrier();
     }
 
@@ -1179,8 +1185,8 @@ struct CaarFunctorImpl {
       if (!m_theta_hydrostatic_mode) {
         // Compute wvor = grad(average(w^2/2)) - average(w*grad(w))
         // Note: vtens is already storing grad(avg(w^2/2))
-        auto gradw_x = Homme::subview(m_buffers.v_i,kv.team_idx,0,igp,jgp);
-        auto gradw_y = Homme::subview(m_buffers.v_i,kv.team_idx,1,igp,jgp);
+        auto gradw_x = Homme::subview(m_buffers.grad_w_i,kv.team_idx,0,igp,jgp);
+        auto gradw_y = Homme::subview(m_buffers.grad_w_i,kv.team_idx,1,igp,jgp);
         auto w_i = Homme::subview(m_state.m_w_i,kv.ie,m_data.n0,igp,jgp);
 
         const auto w_gradw_x = [&gradw_x,&w_i] (const int ilev) -> Scalar {
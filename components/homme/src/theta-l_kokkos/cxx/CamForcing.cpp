@@ -18,7 +18,7 @@ namespace Homme {
 static void apply_cam_forcing_tracers(const Real dt, ForcingFunctor& ff,
                                       const TimeLevel& tl,
                                       const SimulationParams& p) {
-  GPTLstart("ApplyCAMForcing_tracers");
+  start_timer("ApplyCAMForcing_tracers");
 
   bool adjustment = false;
 
@@ -35,14 +35,14 @@ static void apply_cam_forcing_tracers(const Real dt, ForcingFunctor& ff,
 
   ff.tracers_forcing(dt, tl.n0, tl.n0_qdp, adjustment, p.moisture);
 
-  GPTLstop("ApplyCAMForcing_tracers"); 
+  stop_timer("ApplyCAMForcing_tracers"); 
 }
 
 static void apply_cam_forcing_dynamics(const Real dt, ForcingFunctor& ff,
                                        const TimeLevel& tl) {
-  GPTLstart("ApplyCAMForcing_dynamics");
+  start_timer("ApplyCAMForcing_dynamics");
   ff.states_forcing(dt, tl.n0);
-  GPTLstop("ApplyCAMForcing_dynamics");
+  stop_timer("ApplyCAMForcing_dynamics");
 }
 
 void apply_cam_forcing(const Real dt) {
@@ -249,7 +249,8 @@ struct DirkFunctorImpl {
       const auto
       dl = get_ls_slot(ls, kv.team_idx, 0),
       d  = get_ls_slot(ls, kv.team_idx, 1),
-      du = get_ls_slot(ls, kv.team_idx, 2);
+      du = get_ls_slot(ls, kv.team_idx, 2),
+      jc = get_ls_slot(ls, kv.team_idx, 3);
 
       // View of xfull for use in the solver. We want xfull so that we
       // can use the nlevp-1 entry, which we make sure is 0, when convenient.
@@ -339,6 +340,10 @@ struct DirkFunctorImpl {
 
       loop_ki(kv, nlev, nvec, [&] (int k, int i) { dphi_n0(k,i) = phi_n0(k+1,i) - phi_n0(k,i); });
 
+      // The Jacobian row scalings do not change during the iteration.
+      calc_jacobian_coefs(kv, dt2, dp3d, jc);
+      kv.team_barrier();
+
       int it = 0;
       Real deltaerr;
       for (; it < maxiter; ++it) { // Newton iteration
@@ -350,7 +355,7 @@ struct DirkFunctorImpl {
           x(k,i) = -(w_np1(k,i) - (w_n0(k,i) + grav*dt2*(dpnh_dp_i(k,i) - 1))); // -residual
         });
 
-        calc_jacobian(kv, dt2, dp3d, dphi, pnh, dl, d, du);
+        calc_jacobian(kv, jc, dphi, pnh, dl, d, du);
         kv.team_barrier();
         if (bfb_solver) solvebfb(kv, dl, d, du, x); else solve(kv, dl, d, du, x);
         kv.team_barrier();
@@ -717,18 +722,53 @@ struct DirkFunctorImpl {
                              const R& dp3d, const R& dphi, const R& pnh,
                              const W& dl, const W& d, const W& du,
                              const int nlev = NUM_PHYSICAL_LEV) {
+    const Real a = square(dt2*PhysicalConstants::g)/(1 - PhysicalConstants::kappa);
+    const auto b = [&] (const int k, const int i) {
+      return k == 0 ? a/dp3d(k,i) : 2*a/(dp3d(k-1,i) + dp3d(k,i));
+    };
+    calc_jacobian_from_coefs(kv, b, dphi, pnh, dl, d, du, nlev);
+  }
+
+  // Same as calc_jacobian, but with the row scalings, which depend only on
+  // dp3d, precomputed by calc_jacobian_coefs. dp3d does not change during the
+  // Newton iteration, so run_newton computes them once per column.
+  template <typename R, typename W>
+  KOKKOS_INLINE_FUNCTION
+  static void calc_jacobian (const KernelVariables& kv, const W& jc,
+                             const R& dphi, const R& pnh,
+                             const W& dl, const W& d, const W& du,
+                             const int nlev = NUM_PHYSICAL_LEV) {
+    const auto b = [&] (const int k, const int i) { return jc(k,i); };
+    calc_jacobian_from_coefs(kv, b, dphi, pnh, dl, d, du, nlev);
+  }
+
+  template <typename R, typename W>
+  KOKKOS_INLINE_FUNCTION
+  static void calc_jacobian_coefs (const KernelVariables& kv, const Real& dt2,
+                                   const R& dp3d, const W& jc,
+                                   const int nlev = NUM_PHYSICAL_LEV) {
+    const Real a = square(dt2*PhysicalConstants::g)/(1 - PhysicalConstants::kappa);
+    loop_ki(kv, nlev, npack, [&] (const int k, const int i) {
+      jc(k,i) = k == 0 ? a/dp3d(k,i) : 2*a/(dp3d(k-1,i) + dp3d(k,i));
+    });
+  }
+
+  template <typename B, typename R, typename W>
+  KOKKOS_INLINE_FUNCTION
+  static void calc_jacobian_from_coefs (const KernelVariables& kv, const B& coef,
+                                        const R& dphi, const R& pnh,
+                                        const W& dl, const W& d, const W& du,
+                                        const int nlev) {
     using Kokkos::parallel_for;
 
     const int n = npack;
     const auto pv = Kokkos::ThreadVectorRange(kv.team, n);
     const auto pt1 = Kokkos::TeamThreadRange(kv.team, 1);
 
-    const Real a = square(dt2*PhysicalConstants::g)/(1 - PhysicalConstants::kappa);
-
     const auto f1 = [&] (const int) {
       const auto ks = [&] (const int i) { // first Jacobian row
         const int k = 0;
-        const auto b = a/dp3d(k,i);
+        const auto b = coef(k,i);
         du(k,i) = 2*b*(pnh(k,i)/dphi(k,i));
         d (k,i) = 1 - du(k,i);
       };
@@ -740,7 +780,7 @@ struct DirkFunctorImpl {
       // gnu and std=c++14. The macro ConstExceptGnu is defined in share/cxx/Config.hpp.
       ConstExceptGnu  auto k = km1 + 1;
       const auto kmid = [&] (const int i) { // middle Jacobian rows
-        const auto b = 2*a/(dp3d(k-1,i) + dp3d(k,i));
+        const auto b = coef(k,i);
         dl(k,i) = b*(pnh(k-1,i)/dphi(k-1,i));
         du(k,i) = b*(pnh(k  ,i)/dphi(k  ,i));
         // In all rows k,
@@ -757,7 +797,7 @@ struct DirkFunctorImpl {
     const auto f3 = [&] (const int) {
       const auto ke = [&] (const int i) { // last Jacobian row
         const int k = nlev-1;
-        const auto b = 2*a/(dp3d(k-1,i) + dp3d(k,i));
+        const auto b = coef(k,i);
         dl(k,i) = b*(pnh(k-1,i)/dphi(k-1,i));
         d (k,i) = 1 - dl(k,i) - b*(pnh(k,i)/dphi(k,i));        
       };
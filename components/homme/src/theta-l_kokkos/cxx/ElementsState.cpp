@@ -33,9 +33,20 @@ void RefStates::init(const int num_elems) {
   m_tu     = TeamUtils<ExecSpace>(m_policy);
 }
 
-void ElementsState::init(const int num_elems) {
+void ElementsState::init(const int num_elems, const bool alloc_storage) {
   m_num_elems = num_elems;
 
+  if (alloc_storage) {
+    init_storage(num_elems);
+  }
+
+  m_ref_states.init(num_elems);
+
+  m_policy = get_default_team_policy<ExecSpace>(m_num_elems*NUM_TIME_LEVELS);
+  m_tu     = TeamUtils<ExecSpace>(m_policy);
+}
+
+void ElementsState::init_storage(const int num_elems) {
   m_v         = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][2][NP][NP][NUM_LEV  ]>("Horizontal velocity", num_elems);
   m_w_i       = ExecViewManaged<Scalar * [NUM_TIME_LEVELS]   [NP][NP][NUM_LEV_P]>("Vertical velocity at interfaces", num_elems);
   m_vtheta_dp = ExecViewManaged<Scalar * [NUM_TIME_LEVELS]   [NP][NP][NUM_LEV  ]>("Virtual potential temperature", num_elems);
@@ -43,11 +54,6 @@ void ElementsState::init(const int num_elems) {
   m_dp3d      = ExecViewManaged<Scalar * [NUM_TIME_LEVELS]   [NP][NP][NUM_LEV  ]>("Delta p at levels", num_elems);
 
   m_ps_v = ExecViewManaged<Real * [NUM_TIME_LEVELS][NP][NP]>("PS_V", num_elems);
-
-  m_ref_states.init(num_elems);
-
-  m_policy = get_default_team_policy<ExecSpace>(m_num_elems*NUM_TIME_LEVELS);
-  m_tu     = TeamUtils<ExecSpace>(m_policy);
 }
 
 void ElementsState::randomize(const int seed) {
@@ -50,6 +50,9 @@ public:
 
   ExecViewManaged<Real   * [NUM_TIME_LEVELS]   [NP][NP]           > m_ps_v;       // Surface pressure
 
+  // Allocate the state views. Called by init, unless the views are set by the host
+  // model (e.g., EAMxx, which stores the state in its own fields), in which case
+  // allocating them here would only add to the peak device memory.
   void init_storage(const int num_elems);
 
   ElementsState() :
@@ -58,7 +61,7 @@ public:
     , m_tu(m_policy)
   {}
 
-  void init(const int num_elems);
+  void init(const int num_elems, const bool alloc_storage = true);
 
   void randomize(const int seed);
   void randomize(const int seed, const Real max_pressure);
@@ -33,7 +33,6 @@ HyperviscosityFunctorImpl (const SimulationParams&     params,
  , m_hvcoord (Context::singleton().get<HybridVCoord>())
  , m_policy_update_states (Homme::get_default_team_policy<ExecSpace,TagUpdateStates>(m_num_elems))
  , m_policy_first_laplace (Homme::get_default_team_policy<ExecSpace,TagFirstLaplaceHV>(m_num_elems))
- , m_policy_pre_exchange (Homme::get_default_team_policy<ExecSpace, TagHyperPreExchange>(m_num_elems))
  , m_policy_nutop_laplace (Homme::get_default_team_policy<ExecSpace, TagNutopLaplace>(m_num_elems))
  , m_policy_nutop_update_states (Homme::get_default_team_policy<ExecSpace,TagNutopUpdateStates>(m_num_elems))
  , m_tu(m_policy_update_states)
@@ -53,7 +52,6 @@ HyperviscosityFunctorImpl (const int num_elems, const SimulationParams &params)
   , m_hvcoord (Context::singleton().get<HybridVCoord>())
   , m_policy_update_states (Homme::get_default_team_policy<ExecSpace,TagUpdateStates>(m_num_elems))
   , m_policy_first_laplace (Homme::get_default_team_policy<ExecSpace,TagFirstLaplaceHV>(m_num_elems))
-  , m_policy_pre_exchange (Homme::get_default_team_policy<ExecSpace, TagHyperPreExchange>(m_num_elems))
   , m_policy_nutop_laplace (Homme::get_default_team_policy<ExecSpace, TagNutopLaplace>(m_num_elems))
   , m_policy_nutop_update_states (Homme::get_default_team_policy<ExecSpace,TagNutopUpdateStates>(m_num_elems))
   , m_tu(m_policy_update_states)
@@ -267,18 +265,15 @@ void HyperviscosityFunctorImpl::run (const int np1, const Real dt, const Real et
   Kokkos::fence();
 
   for (int icycle = 0; icycle < m_data.hypervis_subcycle; ++icycle) {
-    GPTLstart("hvf-bhwk");
-    biharmonic_wk_theta ();
-    GPTLstop("hvf-bhwk");
-
-    Kokkos::parallel_for(m_policy_pre_exchange, *this);
-    Kokkos::fence();
+    start_timer("hvf-bhwk",m_bhwk_timer);
+    biharmonic_wk_theta (true);
+    stop_timer("hvf-bhwk",m_bhwk_timer);
 
     // Exchange
     assert (m_be->is_registration_completed());
-    GPTLstart("hvf-bexch");
+    start_timer("hvf-bexch",m_bexch_timer);
     m_be->exchange();
-    GPTLstop("hvf-bexch");
+    stop_timer("hvf-bexch",m_bexch_timer);
 
     // Update states
     Kokkos::parallel_for(m_policy_update_states, *this);
@@ -340,9 +335,9 @@ void HyperviscosityFunctorImpl::run (const int np1, const Real dt, const Real et
 
       // exchange is done on ttens, dptens, vtens, etc.
       assert (m_be->is_registration_completed());
-      GPTLstart("hvf-bexch");
+      start_timer("hvf-bexch",m_bexch_timer);
       m_be_tom->exchange();
-      GPTLstop("hvf-bexch");
+      stop_timer("hvf-bexch",m_bexch_timer);
 
       Kokkos::parallel_for(m_policy_nutop_update_states, *this);
       Kokkos::fence();
@@ -350,7 +345,7 @@ void HyperviscosityFunctorImpl::run (const int np1, const Real dt, const Real et
   } // for sponge layer
 } // run()
 
-void HyperviscosityFunctorImpl::biharmonic_wk_theta() const
+void HyperviscosityFunctorImpl::biharmonic_wk_theta(const bool fuse_pre_exchange) const
 {
   // For the first laplacian we use a differnt kernel, which uses directly the states
   // at timelevel np1 as inputs, and subtracts the reference states.
@@ -360,18 +355,30 @@ void HyperviscosityFunctorImpl::biharmonic_wk_theta() const
 
   // Exchange
   assert (m_be->is_registration_completed());
-  GPTLstart("hvf-bexch");
+  start_timer("hvf-bexch",m_bexch_timer);
   m_be->exchange(m_geometry.m_rspheremp);
-  GPTLstop("hvf-bexch");
+  stop_timer("hvf-bexch",m_bexch_timer);
 
-  // Compute second laplacian, tensor or const hv
+  // Compute second laplacian, tensor or const hv. The pre-exchange work only
+  // touches the element being processed, so it can be done in the same kernel,
+  // saving a launch and a full pass over the tendencies.
   const int ne = m_geometry.num_elems();
   if ( m_data.consthv ) {
-    auto policy = Homme::get_default_team_policy<ExecSpace,TagSecondLaplaceConstHV>(ne);
-    Kokkos::parallel_for(policy, *this);
+    if (fuse_pre_exchange) {
+      auto policy = Homme::get_default_team_policy<ExecSpace,TagSecondLaplaceConstHVPreExchange>(ne);
+      Kokkos::parallel_for(policy, *this);
+    } else {
+      auto policy = Homme::get_default_team_policy<ExecSpace,TagSecondLaplaceConstHV>(ne);
+      Kokkos::parallel_for(policy, *this);
+    }
   }else{
-    auto policy = Homme::get_default_team_policy<ExecSpace,TagSecondLaplaceTensorHV>(ne);
-    Kokkos::parallel_for(policy, *this);
+    if (fuse_pre_exchange) {
+      auto policy = Homme::get_default_team_policy<ExecSpace,TagSecondLaplaceTensorHVPreExchange>(ne);
+      Kokkos::parallel_for(policy, *this);
+    } else {
+      auto policy = Homme::get_default_team_policy<ExecSpace,TagSecondLaplaceTensorHV>(ne);
+      Kokkos::parallel_for(policy, *this);
+    }
   }
   Kokkos::fence();
 } //biharmonic
@@ -80,9 +80,12 @@ public:
   struct TagFirstLaplaceHV {};
   struct TagSecondLaplaceConstHV {};
   struct TagSecondLaplaceTensorHV {};
+  // Second laplacian followed by the pre-exchange scaling of the tendencies,
+  // fused in a single kernel, since both work on one element at a time
+  struct TagSecondLaplaceConstHVPreExchange {};
+  struct TagSecondLaplaceTensorHVPreExchange {};
   struct TagUpdateStates {};
   struct TagApplyInvMass {};
-  struct TagHyperPreExchange {};
   struct TagNutopUpdateStates {};
   struct TagNutopLaplace {};
 
@@ -105,7 +108,9 @@ public:
 
   void run (const int np1, const Real dt, const Real eta_ave_w);
 
-  void biharmonic_wk_theta () const;
+  // If fuse_pre_exchange=true, the tendencies are also scaled by -nu (and the
+  // reference states added back to the states), ready for the final exchange
+  void biharmonic_wk_theta (const bool fuse_pre_exchange = false) const;
 
   // first iter of laplace, const hv
   KOKKOS_INLINE_FUNCTION
@@ -194,6 +199,34 @@ public:
   KOKKOS_INLINE_FUNCTION
   void operator() (const TagSecondLaplaceConstHV&, const TeamMember& team) const {
     KernelVariables kv(team, m_tu);
+    second_laplace_const_hv(kv);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const TagSecondLaplaceConstHVPreExchange&, const TeamMember& team) const {
+    KernelVariables kv(team, m_tu);
+    second_laplace_const_hv(kv);
+    kv.team_barrier();
+    hyper_pre_exchange(kv);
+  }
+
+  //second iter of laplace, tensor hv
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const TagSecondLaplaceTensorHV&, const TeamMember& team) const {
+    KernelVariables kv(team, m_tu);
+    second_laplace_tensor_hv(kv);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const TagSecondLaplaceTensorHVPreExchange&, const TeamMember& team) const {
+    KernelVariables kv(team, m_tu);
+    second_laplace_tensor_hv(kv);
+    kv.team_barrier();
+    hyper_pre_exchange(kv);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void second_laplace_const_hv (const KernelVariables& kv) const {
     // Laplacian of layers thickness
     m_sphere_ops.laplace_simple(kv,
                    Homme::subview(m_buffers.dptens,kv.ie),
@@ -217,12 +250,10 @@ public:
     m_sphere_ops.vlaplace_sphere_wk_contra(kv, m_data.nu_ratio2,
                               Homme::subview(m_buffers.vtens,kv.ie),
                               Homme::subview(m_buffers.vtens,kv.ie));
-  } //tag second laplace const hv
+  } //second laplace const hv
 
-  //second iter of laplace, tensor hv
   KOKKOS_INLINE_FUNCTION
-  void operator() (const TagSecondLaplaceTensorHV&, const TeamMember& team) const {
-    KernelVariables kv(team, m_tu);
+  void second_laplace_tensor_hv (const KernelVariables& kv) const {
     // Laplacian of layers thickness
     m_sphere_ops.laplace_tensor(kv,
                    Homme::subview(m_geometry.m_tensorvisc,kv.ie),
@@ -252,7 +283,7 @@ public:
                    Homme::subview(m_geometry.m_vec_sph2cart,kv.ie),
                    Homme::subview(m_buffers.vtens,kv.ie),
                    Homme::subview(m_buffers.vtens,kv.ie));
-  } //SecondLaplaceTensorHV
+  } //second laplace tensor hv
 
   KOKKOS_INLINE_FUNCTION
   void operator() (const TagUpdateStates&, const TeamMember& team) const {
@@ -312,10 +343,9 @@ public:
   }  //tagupdatestates
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const TagHyperPreExchange, const TeamMember &team) const {
+  void hyper_pre_exchange (const KernelVariables& kv) const {
     using IntColumn = decltype(Homme::subview(m_state.m_w_i,0,0,0,0));
 
-    KernelVariables kv(team, m_tu);
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
                          [&](const int &point_idx) {
       const int igp = point_idx / NP;
@@ -382,7 +412,7 @@ public:
       });//thread vector
 
     });//parallel 4
-  } //taghyperpreexchange
+  } //hyper_pre_exchange
 
 protected:
 
@@ -402,7 +432,6 @@ protected:
   // Policies
   Kokkos::TeamPolicy<ExecSpace,TagUpdateStates>     m_policy_update_states;
   Kokkos::TeamPolicy<ExecSpace,TagFirstLaplaceHV>   m_policy_first_laplace;
-  Kokkos::TeamPolicy<ExecSpace,TagHyperPreExchange> m_policy_pre_exchange;
 
   Kokkos::TeamPolicy<ExecSpace,TagNutopLaplace>      m_policy_nutop_laplace;
   Kokkos::TeamPolicy<ExecSpace,TagNutopUpdateStates> m_policy_nutop_update_states;
@@ -411,6 +440,10 @@ protected:
 
   std::shared_ptr<BoundaryExchange> m_be, m_be_tom;
 
+  // GPTL handles of the timers in run() and biharmonic_wk_theta()
+  mutable timer_handle_t m_bhwk_timer  = nullptr;
+  mutable timer_handle_t m_bexch_timer = nullptr;
+
   ExecViewManaged<Scalar[NUM_LEV]> m_nu_scale_top;
   int m_nu_scale_top_ilev_pack_lim;
 }; //HVfunctorImpl
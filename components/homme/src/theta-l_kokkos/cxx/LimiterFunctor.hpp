@@ -101,11 +101,11 @@ struct LimiterFunctor {
   {
     profiling_resume();
 
-    GPTLstart("caar limiter");
+    start_timer("caar limiter");
     m_np1 = tl;
     Kokkos::parallel_for("caar loop dp3d limiter", m_policy_dp3d_lim, *this);
     Kokkos::fence();
-    GPTLstop("caar limiter");
+    stop_timer("caar limiter");
 
     profiling_pause();
   }
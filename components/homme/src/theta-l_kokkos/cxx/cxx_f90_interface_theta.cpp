@@ -271,7 +271,7 @@ void init_time_level_c (const int& nm1, const int& n0, const int& np1,
   tl.nstep0 = nstep0;
 }
 
-void init_elements_c (const int& num_elems)
+void init_elements_c (const int& num_elems, const bool& allocate_state)
 {
   auto& c = Context::singleton();
 
@@ -281,7 +281,8 @@ void init_elements_c (const int& num_elems)
   const bool consthv = (params.hypervis_scaling==0.0);
   e.init (num_elems, consthv, /* alloc_gradphis = */ true,
           params.scale_factor, params.laplacian_rigid_factor,
-          /* alloc_sphere_coords = */ params.transport_alg > 0);
+          /* alloc_sphere_coords = */ params.transport_alg > 0,
+          allocate_state);
 
   // Init also the tracers structure
   Tracers& t = c.create<Tracers> ();
@@ -30,7 +30,7 @@ void ttype10_imex_timestep(const TimeLevel& tl, const Real dt, const Real eta_av
 
 void prim_advance_exp (TimeLevel& tl, const Real dt, const bool compute_diagnostics)
 {
-  GPTLstart("tl-ae prim_advance_exp");
+  start_timer("tl-ae prim_advance_exp");
 
 #ifdef ARKODE
   Errors::runtime_abort("'ARKODE' support not yet available in C++ build.\n",
@@ -109,9 +109,9 @@ void prim_advance_exp (TimeLevel& tl, const Real dt, const bool compute_diagnost
   //// case nu=0 but nu_top>0?  
   if (params.hypervis_order==2 && params.nu>0) {
     HyperviscosityFunctor& functor = context.get<HyperviscosityFunctor>();
-    GPTLstart("tl-ae advance_hypervis_dp");
+    start_timer("tl-ae advance_hypervis_dp");
     functor.run(tl.np1,dt,eta_ave_w);
-    GPTLstop("tl-ae advance_hypervis_dp");
+    stop_timer("tl-ae advance_hypervis_dp");
   }
 
   if (params.dcmip16_mu>0) {
@@ -124,13 +124,13 @@ void prim_advance_exp (TimeLevel& tl, const Real dt, const bool compute_diagnost
     diags.run_diagnostics(false,5);
   }
 
-  GPTLstop("tl-ae prim_advance_exp");
+  stop_timer("tl-ae prim_advance_exp");
 }
 
 // Implementations of timestep schemes, in terms of CaarFunctor runs
 void ttype5_timestep(const TimeLevel& tl, const Real dt, const Real eta_ave_w)
 {
-  GPTLstart("ttype5_timestep");
+  start_timer("ttype5_timestep");
   // Get elements structure
   Elements& elements = Context::singleton().get<Elements>();
   SimulationParams& params = Context::singleton().get<SimulationParams>();
@@ -199,7 +199,7 @@ void ttype5_timestep(const TimeLevel& tl, const Real dt, const Real eta_ave_w)
 
   // Stage 5: u5 = (5u1-u0)/4 + 3dt/4 RHS(u4), t_rhs = t + dt/5 + dt/5 + dt/3 + 2dt/3
   functor.run(RKStageData(nm1, np1, np1, qn0, 3.0*dt/4.0, 3.0*eta_ave_w/4.0));
-  GPTLstop("ttype5_timestep");
+  stop_timer("ttype5_timestep");
 }
 
 
@@ -220,7 +220,7 @@ void ttype9_imex_timestep(const TimeLevel& tl,
                          const Real eta_ave_w)
 {
 
-  GPTLstart("ttype9_imex_timestep");
+  start_timer("ttype9_imex_timestep");
 
   // The context
   const auto& c = Context::singleton();
@@ -315,7 +315,7 @@ void ttype9_imex_timestep(const TimeLevel& tl,
   Real a3 = 8.0*dt_dyn/18.0;
   dirk.run(nm1, a2, n0, a1, np1, a3, elements, hvcoord);
 
-  GPTLstop("ttype9_imex_timestep");
+  stop_timer("ttype9_imex_timestep");
 
 }
 
@@ -324,7 +324,7 @@ void ttype10_imex_timestep(const TimeLevel& tl,
                          const Real dt_dyn,
                          const Real eta_ave_w)
 {
-  GPTLstart("ttype10_imex_timestep");
+  start_timer("ttype10_imex_timestep");
 
   // The context
   const auto& c = Context::singleton();
@@ -381,7 +381,7 @@ void ttype10_imex_timestep(const TimeLevel& tl,
   caar.run(RKStageData(n0, np1, np1, qn0, dt, eta_ave_w, 1.0, 0.0, 1.0));
   dirk.run(nm1, a2*dt, n0, a1*dt, np1, a3*dt, elements, hvcoord);
 
-  GPTLstop("ttype10_imex_timestep");
+  stop_timer("ttype10_imex_timestep");
 }
 
 } // namespace Homme
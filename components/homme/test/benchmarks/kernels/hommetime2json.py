@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+
+# Extract the per-kernel timers of a theta-l_kokkos run from a HommeTime
+# (GPTL) file and write them as JSON.
+#
+# Exchange bandwidth is estimated from the data each BoundaryExchange packs
+# per call: for each element, 4 edges of np points and 4 corners of 1 point
+# per level and field, sent and received, in 8-byte reals.
+
+import sys, re, json, argparse
+
+np_ = 4
+
+# name in the JSON -> GPTL timer name
+kernels = {
+    'caar'             : 'caar compute',
+    'hyperviscosity'   : 'hvf-bhwk',
+    'dirk'             : 'compute_stage_value_dirk',
+    'vertical_remap'   : 'tl-sc vertical_remap',
+    'sl_transport'     : 'compose_transport',
+    'sl_isl'           : 'compose_isl',
+    'sl_cedr_global'   : 'compose_cedr_global',
+    'sl_cedr_local'    : 'compose_cedr_local',
+    'prim_main_loop'   : 'prim_main_loop',
+}
+
+# name in the JSON -> (GPTL timer name, function of args giving the number of
+# level-fields exchanged per call)
+exchanges = {
+    'caar_exchange'    : ('caar_bexchV', lambda a: 4*a.nlev + 2*(a.nlev + 1)),
+    'hv_exchange'      : ('hvf-bexch',   lambda a: 6*a.nlev),
+    'sl_dss_exchange'  : ('compose_dss_q', lambda a: (a.qsize + 1)*a.nlev),
+}
+
+def parse_timer(txt, name):
+    # GPTL line: name, Called, Recurse, Wallclock, max, min, ...
+    pat = r'^[\s*]*' + re.escape(name) + r'\s+(\d+)\s+(\S+)\s+([0-9.eE+-]+)\s+([0-9.eE+-]+)'
+    m = re.search(pat, txt, flags=re.MULTILINE)
+    if m is None: return None
+    return {'calls': int(m.group(1)), 'wallclock': float(m.group(3)),
+            'max': float(m.group(4))}
+
+def main():
+    p = argparse.ArgumentParser()
+    p.add_argument('hommetime', help='HommeTime file')
+    p.add_argument('--ne', type=int, required=True)
+    p.add_argument('--nmpi', type=int, required=True)
+    p.add_argument('--nlev', type=int, required=True)
+    p.add_argument('--qsize', type=int, required=True)
+    p.add_argument('--nstep', type=int, required=True)
+    a = p.parse_args()
+
+    with open(a.hommetime, 'r', errors='replace') as f:
+        txt = f.read()
+
+    nelem = 6*a.ne*a.ne
+    elem_per_rank = nelem/a.nmpi
+    out = {'config': {'ne': a.ne, 'nelem': nelem, 'nmpi': a.nmpi,
+                      'elem_per_rank': elem_per_rank, 'nlev': a.nlev,
+                      'qsize': a.qsize, 'nstep': a.nstep},
+           'kernels': {}, 'exchanges': {}}
+
+    for k, name in kernels.items():
+        t = parse_timer(txt, name)
+        if t is None: continue
+        t['per_call'] = t['wallclock']/max(1, t['calls'])
+        out['kernels'][k] = t
+
+    for k, (name, nlevfld) in exchanges.items():
+        t = parse_timer(txt, name)
+        if t is None: continue
+        t['per_call'] = t['wallclock']/max(1, t['calls'])
+        nbyte = 2*8*(4*np_ + 4)*nlevfld(a)*elem_per_rank
+        t['bytes_per_call'] = nbyte
+        if t['per_call'] > 0:
+            t['GB_per_s'] = 1e-9*nbyte/t['per_call']
+        out['exchanges'][k] = t
+
+    json.dump(out, sys.stdout, indent=2)
+    print()
+
+if __name__ == '__main__':
+    main()
@@ -53,6 +53,7 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
   constexpr int num_tests = 1;
   constexpr int DIM       = 2;
   constexpr double test_tolerance = 1e-13;
+  constexpr double test_tolerance_sp = 1e-6;
   constexpr int num_min_max_fields_1d = 1; // Count min and max of a field as 1, does not count the x2 due to min and max
   constexpr int num_scalar_fields_2d  = 1;
   constexpr int num_scalar_fields_3d  = 1;
@@ -90,6 +91,9 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
   ExecViewManaged<Real*[NUM_TIME_LEVELS][NP][NP]> field_2d_cxx("", num_elements);
   ExecViewManaged<Real*[NUM_TIME_LEVELS][NP][NP]>::HostMirror field_2d_cxx_host;
   field_2d_cxx_host = Kokkos::create_mirror_view(field_2d_cxx);
+  // A copy of the 2d field, to be exchanged in reduced precision
+  ExecViewManaged<Real*[NUM_TIME_LEVELS][NP][NP]> field_2d_sp_cxx("", num_elements);
+  auto field_2d_sp_cxx_host = Kokkos::create_mirror_view(field_2d_sp_cxx);
 
   HostViewManaged<Real*[NUM_TIME_LEVELS][NUM_PHYSICAL_LEV][NP][NP]> field_3d_f90("", num_elements);
   ExecViewManaged<Scalar*[NUM_TIME_LEVELS][NP][NP][NUM_LEV]> field_3d_cxx ("", num_elements);
@@ -115,6 +119,8 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
   std::shared_ptr<BoundaryExchange> be1 = std::make_shared<BoundaryExchange>(connectivity,buffers_manager);
   std::shared_ptr<BoundaryExchange> be2 = std::make_shared<BoundaryExchange>(connectivity,buffers_manager);
   std::shared_ptr<BoundaryExchange> be3 = std::make_shared<BoundaryExchange>(connectivity,buffers_manager_min_max);
+  std::shared_ptr<BoundaryExchange> be12 = std::make_shared<BoundaryExchange>(connectivity,buffers_manager);
+  std::shared_ptr<BoundaryExchange> be_sp = std::make_shared<BoundaryExchange>(connectivity,buffers_manager);
 
   // Setup the be objects
   be1->set_num_fields(0,num_scalar_fields_2d,DIM*num_vector_fields_3d);
@@ -131,10 +137,25 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
   be3->register_min_max_fields(field_1d_cxx,num_min_max_fields_1d,0);
   be3->registration_completed();
 
+  // Fuse be1 and be2 fields in a single exchange
+  be12->set_num_fields(0,be1->get_num_2d_fields()+be2->get_num_2d_fields(),
+                         be1->get_num_3d_fields()+be2->get_num_3d_fields(),
+                         be1->get_num_3d_int_fields()+be2->get_num_3d_int_fields());
+  be12->register_fields(*be1);
+  be12->register_fields(*be2);
+  be12->registration_completed();
+
+  be_sp->set_reduced_precision(true);
+  be_sp->set_num_fields(0,num_scalar_fields_2d,0);
+  be_sp->register_field(field_2d_sp_cxx,1,field_2d_idim);
+  be_sp->registration_completed();
+
   for (int itest=0; itest<num_tests; ++itest)
   {
     // Whether the neighbor min/max should be done as a whole or with two separate calls (start/pack_and_send and finish/recv_and_unpack)
     int minmax_split = dint(engine);
+    // Whether be1 and be2 fields should be exchanged separately or fused in be12
+    const bool fused = dint(engine)==1;
 
     // Initialize input data to random values
     genRandArray(field_min_1d_f90,engine,dreal_minmax);
@@ -198,6 +219,8 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
     }}}}}}
     Kokkos::deep_copy(field_4d_cxx, field_4d_cxx_host);
 
+    Kokkos::deep_copy(field_2d_sp_cxx, field_2d_cxx);
+
     // Perform boundary exchange
     boundary_exchange_test_f90(field_min_1d_f90.data(), field_max_1d_f90.data(),
                                field_2d_f90.data(), field_3d_f90.data(),
@@ -210,14 +233,20 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
       be3->exchange_min_max();
     } else {
       be3->pack_and_send_min_max();
-      be1->pack_and_send();
-      be1->recv_and_unpack();
-      be2->pack_and_send();
-      be2->recv_and_unpack();
+      if (fused) {
+        be12->exchange();
+      } else {
+        be1->pack_and_send();
+        be1->recv_and_unpack();
+        be2->exchange_start();
+        be2->exchange_finish();
+      }
       be3->recv_and_unpack_min_max();
     }
+    be_sp->exchange();
     Kokkos::deep_copy(field_1d_cxx_host,     field_1d_cxx);
     Kokkos::deep_copy(field_2d_cxx_host,     field_2d_cxx);
+    Kokkos::deep_copy(field_2d_sp_cxx_host,  field_2d_sp_cxx);
     Kokkos::deep_copy(field_3d_cxx_host,     field_3d_cxx);
     Kokkos::deep_copy(field_3d_int_cxx_host, field_3d_int_cxx);
     Kokkos::deep_copy(field_4d_cxx_host,     field_4d_cxx);
@@ -252,6 +281,8 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
               std::cout << "cxx: " << field_2d_cxx_host(ie,itl,igp,jgp) << "\n";
             }
             REQUIRE(compare_answers(field_2d_f90(ie,itl,igp,jgp),field_2d_cxx_host(ie,itl,igp,jgp)) < test_tolerance);
+            // Values from other ranks were rounded to single precision, so check the absolute error
+            REQUIRE(compare_answers(field_2d_f90(ie,itl,igp,jgp),field_2d_sp_cxx_host(ie,itl,igp,jgp),0.0) < test_tolerance_sp);
     }}}}
 
     for (int ie=0; ie<num_elements; ++ie) {
@@ -306,4 +337,6 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
   be1->clean_up();
   be2->clean_up();
   be3->clean_up();
+  be12->clean_up();
+  be_sp->clean_up();
 }
@@ -516,6 +516,22 @@ macro(update_variables)
     set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DOMEGA_TILE_LENGTH=${OMEGA_TILE_LENGTH}")
   endif()
 
+  if(OMEGA_MPI_ON_DEVICE)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DOMEGA_MPI_ON_DEVICE")
+  endif()
+
+  if(OMEGA_COMPACT_MESH)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DOMEGA_COMPACT_MESH")
+  endif()
+
+  if(OMEGA_SINGLE_PRECISION)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DSINGLE_PRECISION")
+  endif()
+
+  if(OMEGA_ASYNC_IO)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DOMEGA_ASYNC_IO")
+  endif()
+
   message(STATUS "OMEGA_LINK_OPTIONS     = ${OMEGA_LINK_OPTIONS}")
 
   # check if MPI is supported
@@ -585,6 +601,23 @@ macro(update_variables)
 
   set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DOMEGA_ENABLE_${OMEGA_ARCH}")
 
+  # vector length of the vertical chunks: one level per thread on GPUs and
+  # the SIMD width (8 doubles for AVX-512) on CPUs, unless set explicitly.
+  # This follows the selection of OMEGA_ARCH above, which defaults to SERIAL.
+  # The architecture default is also passed on its own, for testing.
+  if("${OMEGA_ARCH}" MATCHES "^(CUDA|HIP|SYCL)$")
+    set(OMEGA_DEFAULT_VECTOR_LENGTH 1)
+  else()
+    set(OMEGA_DEFAULT_VECTOR_LENGTH 8)
+  endif()
+  if(NOT OMEGA_VECTOR_LENGTH)
+    set(OMEGA_VECTOR_LENGTH ${OMEGA_DEFAULT_VECTOR_LENGTH})
+  endif()
+
+  message(STATUS "OMEGA_VECTOR_LENGTH = ${OMEGA_VECTOR_LENGTH}")
+  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DOMEGA_VECTOR_LENGTH=${OMEGA_VECTOR_LENGTH}")
+  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DOMEGA_DEFAULT_VECTOR_LENGTH=${OMEGA_DEFAULT_VECTOR_LENGTH}")
+
   # Include the findParmetis script
   list(APPEND CMAKE_MODULE_PATH "${CMAKE_CURRENT_SOURCE_DIR}")
   find_package(Parmetis REQUIRED)
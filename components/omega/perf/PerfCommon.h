@@ -0,0 +1,171 @@
+#ifndef OMEGA_PERF_COMMON_H
+#define OMEGA_PERF_COMMON_H
+//===-- perf/PerfCommon.h - common benchmark utilities ----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines utilities shared by the Omega benchmark drivers
+///
+/// Each benchmark driver times a set of cases with timeCase, which repeats
+/// each case after a few warm-up calls and records the time of the slowest
+/// task, and reports the results with a PerfReport. The report is written by
+/// the master task as one JSON object per line (JSON lines), so results from
+/// different drivers, releases and machines can be appended to one file and
+/// compared with standard tools. Driver options are passed on the command
+/// line as Key=Value arguments (eg levels=64 repeats=20 out=perf.jsonl).
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OMEGA {
+
+/// Command line options of a benchmark driver, given as Key=Value
+/// arguments. A leading -- is ignored and arguments without = (eg Kokkos
+/// options) are skipped.
+class PerfOptions {
+ public:
+   PerfOptions(int argc, char **argv) {
+      for (int Arg = 1; Arg < argc; ++Arg) {
+         std::string Opt = argv[Arg];
+         if (Opt.rfind("--", 0) == 0)
+            Opt = Opt.substr(2);
+         const size_t Eq = Opt.find('=');
+         if (Eq == std::string::npos || Opt.rfind("kokkos", 0) == 0)
+            continue;
+         Values[Opt.substr(0, Eq)] = Opt.substr(Eq + 1);
+      }
+   }
+
+   /// Returns the integer option Key or Default if not given
+   int getInt(const std::string &Key, int Default) const {
+      auto It = Values.find(Key);
+      return It == Values.end() ? Default : std::stoi(It->second);
+   }
+
+   /// Returns the string option Key or Default if not given
+   std::string getString(const std::string &Key,
+                         const std::string &Default) const {
+      auto It = Values.find(Key);
+      return It == Values.end() ? Default : It->second;
+   }
+
+ private:
+   std::map<std::string, std::string> Values; ///< options by key
+};
+
+/// Timing statistics of one benchmark case in seconds
+struct PerfResult {
+   R8 MinTime{std::numeric_limits<R8>::max()}; ///< fastest repetition
+   R8 MeanTime{0.0};                           ///< mean of repetitions
+   R8 MaxTime{0.0};                            ///< slowest repetition
+   I4 NRepeat{0};                              ///< number of repetitions
+};
+
+/// Times NRepeat calls of Kernel after NWarmup untimed calls. Each call is
+/// preceded by a barrier and followed by a fence, and its time is the
+/// maximum over the tasks of Comm.
+template <class F>
+PerfResult timeCase(const F &Kernel, int NRepeat, int NWarmup, MPI_Comm Comm) {
+
+   for (int Iter = 0; Iter < NWarmup; ++Iter)
+      Kernel();
+   Kokkos::fence();
+
+   PerfResult Result;
+   Result.NRepeat = NRepeat;
+   for (int Iter = 0; Iter < NRepeat; ++Iter) {
+      MPI_Barrier(Comm);
+      const R8 Start = MPI_Wtime();
+      Kernel();
+      Kokkos::fence();
+      const R8 LocalTime = MPI_Wtime() - Start;
+
+      R8 Time;
+      MPI_Allreduce(&LocalTime, &Time, 1, MPI_DOUBLE, MPI_MAX, Comm);
+      Result.MinTime = std::min(Result.MinTime, Time);
+      Result.MaxTime = std::max(Result.MaxTime, Time);
+      Result.MeanTime += Time / NRepeat;
+   }
+
+   return Result;
+}
+
+/// Writes the results of a benchmark suite as JSON lines to the file given
+/// by the out option (appended) or to stdout. Each line holds the suite and
+/// case names, the number of tasks, the Kokkos execution space, the case
+/// parameters, the timing statistics, the rate in elements per second for
+/// the global problem size and, if the bytes moved are given, the bandwidth
+/// in GB/s. Both rates use the fastest repetition.
+class PerfReport {
+ public:
+   PerfReport(const std::string &InSuite, ///< [in] name of benchmark suite
+              const PerfOptions &Opts,    ///< [in] driver options
+              const MachEnv *Env          ///< [in] environment of the run
+   ) {
+      Suite    = InSuite;
+      IsMaster = Env->isMasterTask();
+      NumTasks = Env->getNumTasks();
+
+      const std::string FileName = Opts.getString("out", "");
+      if (IsMaster && !FileName.empty())
+         OutFile.open(FileName, std::ios::app);
+   }
+
+   /// Adds the result of one case. Size is the global number of elements
+   /// processed by one repetition and Bytes the global bytes moved.
+   void add(const std::string &Case, ///< [in] case name
+            const std::vector<std::pair<std::string, I8>> &Params, ///< [in]
+            const PerfResult &Result, ///< [in] timing statistics
+            I8 Size,                  ///< [in] global elements per repetition
+            R8 Bytes = 0.0            ///< [in] global bytes per repetition
+   ) {
+      if (!IsMaster)
+         return;
+
+      std::ostringstream Line;
+      Line.precision(6);
+      Line << "{\"suite\": \"" << Suite << "\", \"case\": \"" << Case
+           << "\", \"ranks\": " << NumTasks << ", \"exec_space\": \""
+           << ExecSpace::name() << "\"";
+      for (const auto &[Key, Value] : Params)
+         Line << ", \"" << Key << "\": " << Value;
+      Line << ", \"size\": " << Size << ", \"repeats\": " << Result.NRepeat
+           << std::scientific << ", \"time_min\": " << Result.MinTime
+           << ", \"time_mean\": " << Result.MeanTime
+           << ", \"time_max\": " << Result.MaxTime
+           << ", \"rate\": " << Size / Result.MinTime;
+      if (Bytes > 0.0)
+         Line << ", \"bandwidth_GBs\": " << Bytes / Result.MinTime * 1.0e-9;
+      Line << "}";
+
+      if (OutFile.is_open()) {
+         OutFile << Line.str() << std::endl;
+      } else {
+         std::cout << Line.str() << std::endl;
+      }
+   }
+
+ private:
+   std::string Suite;     ///< name of the benchmark suite
+   bool IsMaster{false};  ///< true on the task writing the report
+   I4 NumTasks{0};        ///< number of tasks in the run
+   std::ofstream OutFile; ///< output file, if any
+};
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_PERF_COMMON_H
@@ -0,0 +1,135 @@
+//===-- Benchmark driver for OMEGA halo exchanges ----------------*- C++ -*-===/
+//
+/// \file
+/// \brief Benchmark driver for OMEGA halo exchanges
+///
+/// This driver times halo exchanges of groups of 2-d cell fields for an
+/// increasing number of halo layers and fields per exchange, with and
+/// without persistent exchange patterns. Options (Key=Value):
+///   mesh       mesh file (default OmegaMesh.nc)
+///   levels     number of vertical levels (default 64)
+///   maxfields  largest number of fields per exchange (default 8)
+///   repeats    timed repetitions of each case (default 20)
+///   warmup     untimed calls before timing (default 2)
+///   out        append the JSON lines results to this file (default stdout)
+//
+//===-----------------------------------------------------------------------===/
+
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "PerfCommon.h"
+#include "mpi.h"
+
+#include <string>
+#include <vector>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Time the halo exchanges of all cases
+
+int haloPerf(const PerfOptions &Opts) {
+
+   int Err = 0;
+
+   MachEnv *DefEnv   = MachEnv::getDefaultEnv();
+   MPI_Comm Comm     = DefEnv->getComm();
+   Decomp *DefDecomp = Decomp::getDefault();
+   Halo *DefHalo     = Halo::getDefault();
+
+   const int NVertLevels = Opts.getInt("levels", 64);
+   const int MaxFields   = Opts.getInt("maxfields", 8);
+   const int NRepeat     = Opts.getInt("repeats", 20);
+   const int NWarmup     = Opts.getInt("warmup", 2);
+
+   // Global number of halo cell levels sent by one layer of one field is not
+   // available from the halo, so the rates are given in global owned cell
+   // levels exchanged per second
+   I8 NCellsGlobal = DefDecomp->NCellsGlobal;
+   NCellsGlobal *= NVertLevels;
+
+   std::vector<Array2DReal> Fields;
+   for (int Field = 0; Field < MaxFields; ++Field) {
+      Fields.push_back(Array2DReal("HaloPerfField" + std::to_string(Field),
+                                   DefDecomp->NCellsSize, NVertLevels));
+      deepCopy(Fields.back(), Field + 1.0);
+   }
+
+   PerfReport Report("Halo", Opts, DefEnv);
+
+   for (int NFields = 1; NFields <= MaxFields; NFields *= 2) {
+      for (int NLayers = 1; NLayers <= DefDecomp->HaloWidth; ++NLayers) {
+         for (int Persistent = 0; Persistent < 2; ++Persistent) {
+
+            const std::string Pattern =
+                Persistent ? "HaloPerf" + std::to_string(NFields) + "x" +
+                                 std::to_string(NLayers)
+                           : "";
+            HaloGroup Group(Pattern);
+            for (int Field = 0; Field < NFields; ++Field)
+               Err += Group.add(Fields[Field], OnCell, NLayers);
+
+            PerfResult Result = timeCase(
+                [&] { Err += DefHalo->exchangeGroup(Group); }, NRepeat,
+                NWarmup, Comm);
+
+            Report.add(Persistent ? "exchangeGroupPersistent" : "exchangeGroup",
+                       {{"levels", NVertLevels},
+                        {"fields", NFields},
+                        {"layers", NLayers}},
+                       Result, NCellsGlobal * NFields);
+         }
+      }
+   }
+
+   if (Err != 0)
+      LOG_ERROR("HaloPerf: errors in halo exchanges");
+
+   return Err;
+
+} // end haloPerf
+
+//------------------------------------------------------------------------------
+// The benchmark driver
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      PerfOptions Opts(argc, argv);
+      const std::string MeshFile = Opts.getString("mesh", "OmegaMesh.nc");
+
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefaultEnv();
+      RetVal += IO::init(DefEnv->getComm());
+      RetVal += Decomp::init(MeshFile);
+      RetVal += Halo::init();
+
+      if (RetVal == 0) {
+         RetVal += haloPerf(Opts);
+      } else {
+         LOG_CRITICAL("HaloPerf: error initializing mesh {}", MeshFile);
+      }
+
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,190 @@
+//===-- Benchmark driver for OMEGA parallel IO -------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Benchmark driver for OMEGA parallel IO
+///
+/// This driver times the parallel write and read of a distributed 2-d R8
+/// cell array, including the open, define and close of the file, so the
+/// times correspond to writing or reading one field in its own file. The
+/// IO system is initialized in turn with each combination of rearranger
+/// (box, subset) and IO task placement (stride with the given number of IO
+/// tasks and stride, node with the given IO tasks per node), and the cases
+/// are named after the combination, eg. write_subset_node, so that the
+/// bandwidths of the settings can be compared on a machine in one run.
+/// Options (Key=Value):
+///   mesh     mesh file (default OmegaMesh.nc)
+///   levels   number of vertical levels (default 64)
+///   file     name of the file written and read (default IOPerf.nc)
+///   iotasks  number of IO tasks for stride placement (default 1)
+///   stride   stride between IO tasks for stride placement (default 1)
+///   pernode  IO tasks per node for node placement (default 1)
+///   repeats  timed repetitions of each case (default 5)
+///   warmup   untimed calls before timing (default 1)
+///   out      append the JSON lines results to this file (default stdout)
+//
+//===-----------------------------------------------------------------------===/
+
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "PerfCommon.h"
+#include "mpi.h"
+
+#include <string>
+#include <vector>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Time the write and read of a cell array with the IO system initialized
+// with IOSettings, naming the cases after CaseName
+
+int ioPerf(const PerfOptions &Opts, const std::string &CaseName,
+           const IO::Settings &IOSettings, PerfReport &Report) {
+
+   int Err = 0;
+
+   MachEnv *DefEnv   = MachEnv::getDefaultEnv();
+   MPI_Comm Comm     = DefEnv->getComm();
+   Decomp *DefDecomp = Decomp::getDefault();
+
+   const int NVertLevels      = Opts.getInt("levels", 64);
+   const int NRepeat          = Opts.getInt("repeats", 5);
+   const int NWarmup          = Opts.getInt("warmup", 1);
+   const std::string FileName = Opts.getString("file", "IOPerf.nc");
+
+   const I4 NCellsOwned  = DefDecomp->NCellsOwned;
+   const I4 NCellsSize   = DefDecomp->NCellsSize;
+   const I4 NCellsGlobal = DefDecomp->NCellsGlobal;
+   const I4 ArraySize    = NCellsSize * NVertLevels;
+
+   // Host array with halo entries excluded from the decomposition
+   HostArray1DI4 CellIDH = DefDecomp->CellIDH;
+   HostArray2DR8 Field("IOPerfField", NCellsSize, NVertLevels);
+   std::vector<int> Offset(ArraySize, -1);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      const int GlobalCell = CellIDH(Cell) - 1;
+      for (int K = 0; K < NVertLevels; ++K) {
+         Field(Cell, K)                 = GlobalCell + 0.001 * K;
+         Offset[Cell * NVertLevels + K] = GlobalCell * NVertLevels + K;
+      }
+   }
+
+   int DecompID;
+   std::vector<int> Dims = {NCellsGlobal, NVertLevels};
+   Err += IO::createDecomp(DecompID, IO::IOTypeR8, 2, Dims, ArraySize, Offset,
+                           IO::DefaultRearr);
+
+   const I8 NGlobal = static_cast<I8>(NCellsGlobal) * NVertLevels;
+   const R8 NBytes  = 8.0 * NGlobal;
+   R8 FillValue     = -1.23456789e30;
+   PerfResult Result;
+
+   // The placement actually used is reported with each case
+   IO::Settings Placed = IOSettings;
+   IO::placeIOTasks(Comm, Placed);
+   const std::vector<std::pair<std::string, I8>> Params = {
+       {"levels", NVertLevels},
+       {"iotasks", Placed.NumIOTasks},
+       {"stride", Placed.IOStride}};
+
+   Result = timeCase(
+       [&] {
+          int FileID, VarID;
+          int DimIDs[2];
+          Err += IO::openFile(FileID, FileName, IO::ModeWrite, IO::FmtDefault,
+                              IO::IfExists::Replace, IO::Precision::Double);
+          Err += IO::defineDim(FileID, "NCells", NCellsGlobal, DimIDs[0]);
+          Err += IO::defineDim(FileID, "NVertLevels", NVertLevels, DimIDs[1]);
+          Err += IO::defineVar(FileID, "Field", IO::IOTypeR8, 2, DimIDs, VarID);
+          Err += IO::endDefinePhase(FileID);
+          Err += IO::writeArray(Field.data(), ArraySize, &FillValue, FileID,
+                                DecompID, VarID);
+          Err += IO::closeFile(FileID);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("write_" + CaseName, Params, Result, NGlobal, NBytes);
+
+   Result = timeCase(
+       [&] {
+          int FileID, VarID;
+          Err += IO::openFile(FileID, FileName, IO::ModeRead);
+          Err += IO::readArray(Field.data(), ArraySize, "Field", FileID,
+                               DecompID, VarID);
+          Err += IO::closeFile(FileID);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("read_" + CaseName, Params, Result, NGlobal, NBytes);
+
+   Err += IO::destroyDecomp(DecompID);
+
+   if (Err != 0)
+      LOG_ERROR("IOPerf: errors in reading or writing {} with {}", FileName,
+                CaseName);
+
+   return Err;
+
+} // end ioPerf
+
+//------------------------------------------------------------------------------
+// The benchmark driver
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      PerfOptions Opts(argc, argv);
+      const std::string MeshFile = Opts.getString("mesh", "OmegaMesh.nc");
+
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefaultEnv();
+      MPI_Comm Comm   = DefEnv->getComm();
+
+      // The mesh is read once with the default settings
+      RetVal += IO::init(Comm);
+      RetVal += Decomp::init(MeshFile);
+
+      if (RetVal == 0) {
+         PerfReport Report("IO", Opts, DefEnv);
+         for (IO::Rearranger Rearr : {IO::RearrBox, IO::RearrSubset}) {
+            for (IO::Placement Place :
+                 {IO::Placement::Stride, IO::Placement::Node}) {
+               IO::Settings IOSettings;
+               IOSettings.NumIOTasks     = Opts.getInt("iotasks", 1);
+               IOSettings.IOStride       = Opts.getInt("stride", 1);
+               IOSettings.IOTasksPerNode = Opts.getInt("pernode", 1);
+               IOSettings.Rearr          = Rearr;
+               IOSettings.Place          = Place;
+               const std::string CaseName =
+                   std::string(Rearr == IO::RearrBox ? "box" : "subset") +
+                   (Place == IO::Placement::Node ? "_node" : "_stride");
+
+               RetVal += IO::finalize();
+               RetVal += IO::init(Comm, IOSettings);
+               RetVal += ioPerf(Opts, CaseName, IOSettings, Report);
+            }
+         }
+      } else {
+         LOG_CRITICAL("IOPerf: error initializing mesh {}", MeshFile);
+      }
+
+      Decomp::clear();
+      RetVal += IO::finalize();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
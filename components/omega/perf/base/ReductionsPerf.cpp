@@ -0,0 +1,104 @@
+//===-- Benchmark driver for OMEGA global reductions -------------*- C++ -*-===/
+//
+/// \file
+/// \brief Benchmark driver for OMEGA global reductions
+///
+/// This driver compares the reproducible (double-double) global sum of a
+/// device array with a plain sum (a local parallel reduction followed by an
+/// MPI_Allreduce) for local array sizes increasing by factors of four.
+/// Options (Key=Value):
+///   maxsize  largest local array size (default 4194304)
+///   repeats  timed repetitions of each case (default 20)
+///   warmup   untimed calls before timing (default 2)
+///   out      append the JSON lines results to this file (default stdout)
+//
+//===-----------------------------------------------------------------------===/
+
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "PerfCommon.h"
+#include "Reductions.h"
+#include "mpi.h"
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Time the reproducible and plain global sums for all sizes
+
+int reductionsPerf(const PerfOptions &Opts) {
+
+   int Err = 0;
+
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+   MPI_Comm Comm   = DefEnv->getComm();
+
+   const int MaxSize = Opts.getInt("maxsize", 4194304);
+   const int NRepeat = Opts.getInt("repeats", 20);
+   const int NWarmup = Opts.getInt("warmup", 2);
+
+   PerfReport Report("Reductions", Opts, DefEnv);
+
+   for (int NLocal = 1024; NLocal <= MaxSize; NLocal *= 4) {
+
+      Array1DR8 A("A", NLocal);
+      parallelFor(
+          {NLocal}, KOKKOS_LAMBDA(int I) { A(I) = 1.0 / (I + 1.0); });
+
+      const I8 NGlobal = static_cast<I8>(NLocal) * DefEnv->getNumTasks();
+      const R8 NBytes  = 8.0 * NGlobal;
+      R8 Sum           = 0.0;
+      PerfResult Result;
+      const std::vector<std::pair<std::string, I8>> Params = {
+          {"local_size", NLocal}};
+
+      Result = timeCase([&] { Err += globalSum(A, Comm, &Sum); }, NRepeat,
+                        NWarmup, Comm);
+      Report.add("globalSumReproducible", Params, Result, NGlobal, NBytes);
+
+      auto LocalSumKernel = KOKKOS_LAMBDA(int I, R8 &Accum) { Accum += A(I); };
+      Result              = timeCase(
+          [&] {
+             R8 LocalSum = 0.0;
+             parallelReduce({NLocal}, LocalSumKernel, LocalSum);
+             Err += MPI_Allreduce(&LocalSum, &Sum, 1, MPI_DOUBLE, MPI_SUM,
+                                  Comm);
+          },
+          NRepeat, NWarmup, Comm);
+      Report.add("globalSumPlain", Params, Result, NGlobal, NBytes);
+   }
+
+   if (Err != 0)
+      LOG_ERROR("ReductionsPerf: errors in global sums");
+
+   return Err;
+
+} // end reductionsPerf
+
+//------------------------------------------------------------------------------
+// The benchmark driver
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      PerfOptions Opts(argc, argv);
+
+      MachEnv::init(MPI_COMM_WORLD);
+      RetVal += reductionsPerf(Opts);
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
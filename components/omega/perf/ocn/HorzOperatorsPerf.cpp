@@ -0,0 +1,240 @@
+//===-- Benchmark driver for OMEGA horizontal operators ----------*- C++ -*-===/
+//
+/// \file
+/// \brief Benchmark driver for OMEGA horizontal operators
+///
+/// This driver times each of the horizontal operator functors over all owned
+/// elements and vertical levels of the mesh and reports the achieved
+/// bandwidth from the operator work estimates. Options (Key=Value):
+///   mesh     mesh file (default OmegaMesh.nc)
+///   levels   number of vertical levels (default 64)
+///   repeats  timed repetitions of each case (default 20)
+///   warmup   untimed calls before timing (default 2)
+///   out      append the JSON lines results to this file (default stdout)
+//
+//===-----------------------------------------------------------------------===/
+
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+#include "PerfCommon.h"
+#include "mpi.h"
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Initialize the mesh used by the benchmarks
+
+int initOperatorsPerf(const std::string &MeshFile) {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+
+   Err += MemoryTracker::init();
+   Err += IO::init(DefEnv->getComm());
+   Err += Decomp::init(MeshFile);
+   Err += Halo::init();
+   Err += HorzMesh::init();
+   if (Err != 0)
+      LOG_CRITICAL("HorzOperatorsPerf: error initializing mesh {}", MeshFile);
+
+   Err += MemoryTracker::print("init");
+
+   return Err;
+
+} // end initOperatorsPerf
+
+//------------------------------------------------------------------------------
+// Time all operators
+
+void operatorsPerf(const PerfOptions &Opts) {
+
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+   MPI_Comm Comm   = DefEnv->getComm();
+   HorzMesh *Mesh  = HorzMesh::getDefault();
+
+   const int NVertLevels = Opts.getInt("levels", 64);
+   const int NRepeat     = Opts.getInt("repeats", 20);
+   const int NWarmup     = Opts.getInt("warmup", 2);
+   const int NChunks     = numVertChunks(NVertLevels);
+
+   const I4 NCellsOwned    = Mesh->NCellsOwned;
+   const I4 NEdgesOwned    = Mesh->NEdgesOwned;
+   const I4 NVerticesOwned = Mesh->NVerticesOwned;
+
+   // Global numbers of element levels for the rates
+   I8 LocalCount[3] = {NCellsOwned, NEdgesOwned, NVerticesOwned};
+   I8 GlobalCount[3];
+   MPI_Allreduce(LocalCount, GlobalCount, 3, MPI_INT64_T, MPI_SUM, Comm);
+   const I8 NCellsGlobal    = GlobalCount[0] * NVertLevels;
+   const I8 NEdgesGlobal    = GlobalCount[1] * NVertLevels;
+   const I8 NVerticesGlobal = GlobalCount[2] * NVertLevels;
+
+   // Input fields, including halos
+   Array2DReal VecEdge("VecEdge", Mesh->NEdgesSize, NVertLevels);
+   Array2DReal ScalarEdge("ScalarEdge", Mesh->NEdgesSize, NVertLevels);
+   Array2DReal ScalarCell("ScalarCell", Mesh->NCellsSize, NVertLevels);
+   deepCopy(VecEdge, 1.0);
+   deepCopy(ScalarEdge, 2.0);
+   deepCopy(ScalarCell, 3.0);
+
+   // Output fields on owned elements
+   Array2DReal DivCell("DivCell", NCellsOwned, NVertLevels);
+   Array2DReal FluxDivCell("FluxDivCell", NCellsOwned, NVertLevels);
+   Array2DReal GradEdge("GradEdge", NEdgesOwned, NVertLevels);
+   Array2DReal ReconEdge("ReconEdge", NEdgesOwned, NVertLevels);
+   Array2DReal RelVortVertex("RelVortVertex", NVerticesOwned, NVertLevels);
+   Array2DReal PotVortVertex("PotVortVertex", NVerticesOwned, NVertLevels);
+
+   const std::vector<std::pair<std::string, I8>> Params = {
+       {"levels", NVertLevels}, {"vec_length", VecLength}};
+   PerfReport Report("HorzOperators", Opts, DefEnv);
+   PerfResult Result;
+
+   // Global bytes moved by one call of an operator from its work estimate
+   auto globalBytes = [&](const OperatorWork &Work) {
+      R8 Bytes = 0.0;
+      MPI_Allreduce(&Work.Bytes, &Bytes, 1, MPI_DOUBLE, MPI_SUM, Comm);
+      return Bytes;
+   };
+
+   DivergenceOnCell DivOnCell(Mesh);
+   auto DivOnCellKernel = KOKKOS_LAMBDA(int ICell, int KChunk) {
+      DivOnCell(DivCell, ICell, KChunk, VecEdge);
+   };
+   Result = timeCase(
+       [&] {
+          parallelFor("perfDivergenceOnCell", {NCellsOwned, NChunks},
+                      DivOnCellKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("DivergenceOnCell", Params, Result, NCellsGlobal,
+              globalBytes(DivergenceOnCell::work(Mesh, NVertLevels)));
+
+   // The same divergence with the CSR cell to edge incidence, to choose
+   // between the padded and CSR forms for a mesh
+   HorzMesh CSRMesh  = *Mesh;
+   CSRMesh.OpCellCSR = true;
+   DivergenceOnCell CSRDivOnCell(&CSRMesh);
+   auto CSRDivOnCellKernel = KOKKOS_LAMBDA(int ICell, int KChunk) {
+      CSRDivOnCell(DivCell, ICell, KChunk, VecEdge);
+   };
+   Result = timeCase(
+       [&] {
+          parallelFor("perfDivergenceOnCellCSR", {NCellsOwned, NChunks},
+                      CSRDivOnCellKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("DivergenceOnCellCSR", Params, Result, NCellsGlobal,
+              globalBytes(DivergenceOnCell::work(Mesh, NVertLevels)));
+
+   GradientOnEdge GradOnEdge(Mesh);
+   auto GradOnEdgeKernel = KOKKOS_LAMBDA(int IEdge, int KChunk) {
+      GradOnEdge(GradEdge, IEdge, KChunk, ScalarCell);
+   };
+   Result = timeCase(
+       [&] {
+          parallelFor("perfGradientOnEdge", {NEdgesOwned, NChunks},
+                      GradOnEdgeKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("GradientOnEdge", Params, Result, NEdgesGlobal,
+              globalBytes(GradientOnEdge::work(Mesh, NVertLevels)));
+
+   CurlOnVertex CurlVertex(Mesh);
+   auto CurlVertexKernel = KOKKOS_LAMBDA(int IVertex, int KChunk) {
+      CurlVertex(RelVortVertex, IVertex, KChunk, VecEdge);
+   };
+   Result = timeCase(
+       [&] {
+          parallelFor("perfCurlOnVertex", {NVerticesOwned, NChunks},
+                      CurlVertexKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("CurlOnVertex", Params, Result, NVerticesGlobal,
+              globalBytes(CurlOnVertex::work(Mesh, NVertLevels)));
+
+   TangentialReconOnEdge ReconOnEdge(Mesh);
+   auto ReconOnEdgeKernel = KOKKOS_LAMBDA(int IEdge, int KChunk) {
+      ReconOnEdge(ReconEdge, IEdge, KChunk, VecEdge);
+   };
+   Result = timeCase(
+       [&] {
+          parallelFor("perfTangentialReconOnEdge", {NEdgesOwned, NChunks},
+                      ReconOnEdgeKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("TangentialReconOnEdge", Params, Result, NEdgesGlobal,
+              globalBytes(TangentialReconOnEdge::work(Mesh, NVertLevels)));
+
+   DivergenceAndFluxDivOnCell FusedDivOnCell(Mesh);
+   auto FusedDivOnCellKernel = KOKKOS_LAMBDA(int ICell, int KChunk) {
+      FusedDivOnCell(DivCell, FluxDivCell, ICell, KChunk, VecEdge, ScalarEdge);
+   };
+   Result = timeCase(
+       [&] {
+          parallelFor("perfDivergenceAndFluxDivOnCell", {NCellsOwned, NChunks},
+                      FusedDivOnCellKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("DivergenceAndFluxDivOnCell", Params, Result, NCellsGlobal,
+              globalBytes(DivergenceAndFluxDivOnCell::work(Mesh, NVertLevels)));
+
+   CurlAndPotVortOnVertex FusedCurlOnVertex(Mesh);
+   auto FusedCurlOnVertexKernel = KOKKOS_LAMBDA(int IVertex, int KChunk) {
+      FusedCurlOnVertex(RelVortVertex, PotVortVertex, IVertex, KChunk, VecEdge,
+                        ScalarCell);
+   };
+   Result = timeCase(
+       [&] {
+          parallelFor("perfCurlAndPotVortOnVertex", {NVerticesOwned, NChunks},
+                      FusedCurlOnVertexKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("CurlAndPotVortOnVertex", Params, Result, NVerticesGlobal,
+              globalBytes(CurlAndPotVortOnVertex::work(Mesh, NVertLevels)));
+
+} // end operatorsPerf
+
+//------------------------------------------------------------------------------
+// The benchmark driver
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      PerfOptions Opts(argc, argv);
+
+      RetVal = initOperatorsPerf(Opts.getString("mesh", "OmegaMesh.nc"));
+      if (RetVal == 0)
+         operatorsPerf(Opts);
+
+      RetVal += MemoryTracker::print("finalize");
+      MemoryTracker::finalize();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,257 @@
+//===-- Benchmark driver for OMEGA array layouts -----------------*- C++ -*-===/
+//
+/// \file
+/// \brief Benchmark driver comparing LayoutRight and LayoutLeft arrays
+///
+/// The memory layout of Omega arrays is fixed at build time by MemLayout.
+/// This driver times the basic horizontal operators and the halo pack and
+/// unpack kernels on the same mesh with 2-d arrays in both layouts, so that
+/// the layouts can be compared in one run without rebuilding. Each layout is
+/// iterated in its own order, ie. with the fastest index in the direction of
+/// contiguous memory. Options (Key=Value):
+///   mesh     mesh file (default OmegaMesh.nc)
+///   levels   number of vertical levels (default 64)
+///   repeats  timed repetitions of each case (default 20)
+///   warmup   untimed calls before timing (default 2)
+///   out      append the JSON lines results to this file (default stdout)
+//
+//===-----------------------------------------------------------------------===/
+
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "PerfCommon.h"
+#include "mpi.h"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// 2-d Real array and 2-d iteration policy for a given layout
+
+template <typename Layout>
+using LayoutArray2DReal = Kokkos::View<Real **, Layout, MemSpace>;
+
+template <typename Layout>
+constexpr Kokkos::Iterate LayoutIterate =
+    std::is_same_v<Layout, Kokkos::LayoutLeft> ? Kokkos::Iterate::Left
+                                                : Kokkos::Iterate::Right;
+
+template <typename Layout>
+using LayoutBounds = Kokkos::MDRangePolicy<
+    ExecSpace,
+    Kokkos::Rank<2, LayoutIterate<Layout>, LayoutIterate<Layout>>>;
+
+template <typename Layout, typename F>
+void layoutFor(const std::string &Label, int N1, int N2, const F &Functor) {
+   Kokkos::parallel_for(Label, LayoutBounds<Layout>({0, 0}, {N1, N2}),
+                        Functor);
+}
+
+//------------------------------------------------------------------------------
+// Indices of the owned cells that neighbor a halo cell, which are the cells
+// sent in the first layer of a cell halo exchange
+
+Array1DI4 sendIndices(const HorzMesh *Mesh) {
+
+   std::vector<I4> Cells;
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+      for (int J = 0; J < Mesh->NEdgesOnCellH(ICell); ++J) {
+         const I4 JCell = Mesh->CellsOnCellH(ICell, J);
+         if (JCell >= Mesh->NCellsOwned && JCell < Mesh->NCellsAll) {
+            Cells.push_back(ICell);
+            break;
+         }
+      }
+   }
+
+   HostArray1DI4 IndH("SendIndicesH", Cells.size());
+   for (int I = 0; I < Cells.size(); ++I)
+      IndH(I) = Cells[I];
+
+   return createDeviceMirrorCopy(IndH);
+
+} // end sendIndices
+
+//------------------------------------------------------------------------------
+// Time all cases with arrays of one layout
+
+template <typename Layout>
+void layoutPerf(const std::string &LayoutName, const PerfOptions &Opts,
+                PerfReport &Report) {
+
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+   MPI_Comm Comm   = DefEnv->getComm();
+   HorzMesh *Mesh  = HorzMesh::getDefault();
+
+   const int NVertLevels = Opts.getInt("levels", 64);
+   const int NRepeat     = Opts.getInt("repeats", 20);
+   const int NWarmup     = Opts.getInt("warmup", 2);
+   const int NChunks     = numVertChunks(NVertLevels);
+
+   const I4 NCellsOwned    = Mesh->NCellsOwned;
+   const I4 NEdgesOwned    = Mesh->NEdgesOwned;
+   const I4 NVerticesOwned = Mesh->NVerticesOwned;
+
+   // Global numbers of element levels for the rates
+   I8 LocalCount[3] = {NCellsOwned, NEdgesOwned, NVerticesOwned};
+   I8 GlobalCount[3];
+   MPI_Allreduce(LocalCount, GlobalCount, 3, MPI_INT64_T, MPI_SUM, Comm);
+   const I8 NCellsGlobal    = GlobalCount[0] * NVertLevels;
+   const I8 NEdgesGlobal    = GlobalCount[1] * NVertLevels;
+   const I8 NVerticesGlobal = GlobalCount[2] * NVertLevels;
+
+   using ArrayType = LayoutArray2DReal<Layout>;
+
+   // Input fields, including halos
+   ArrayType VecEdge("VecEdge", Mesh->NEdgesSize, NVertLevels);
+   ArrayType ScalarCell("ScalarCell", Mesh->NCellsSize, NVertLevels);
+   Kokkos::deep_copy(VecEdge, 1.0);
+   Kokkos::deep_copy(ScalarCell, 3.0);
+
+   // Output fields on owned elements
+   ArrayType DivCell("DivCell", NCellsOwned, NVertLevels);
+   ArrayType GradEdge("GradEdge", NEdgesOwned, NVertLevels);
+   ArrayType ReconEdge("ReconEdge", NEdgesOwned, NVertLevels);
+   ArrayType RelVortVertex("RelVortVertex", NVerticesOwned, NVertLevels);
+
+   const std::vector<std::pair<std::string, I8>> Params = {
+       {"levels", NVertLevels}, {"vec_length", VecLength}};
+   PerfResult Result;
+
+   // Global bytes moved by one call of an operator from its work estimate
+   auto globalBytes = [&](const OperatorWork &Work) {
+      R8 Bytes = 0.0;
+      MPI_Allreduce(&Work.Bytes, &Bytes, 1, MPI_DOUBLE, MPI_SUM, Comm);
+      return Bytes;
+   };
+
+   DivergenceOnCell DivOnCell(Mesh);
+   auto DivOnCellKernel = KOKKOS_LAMBDA(int ICell, int KChunk) {
+      DivOnCell(DivCell, ICell, KChunk, VecEdge);
+   };
+   Result = timeCase(
+       [&] {
+          layoutFor<Layout>("perfDivergenceOnCell", NCellsOwned, NChunks,
+                            DivOnCellKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("DivergenceOnCell" + LayoutName, Params, Result, NCellsGlobal,
+              globalBytes(DivergenceOnCell::work(Mesh, NVertLevels)));
+
+   GradientOnEdge GradOnEdge(Mesh);
+   auto GradOnEdgeKernel = KOKKOS_LAMBDA(int IEdge, int KChunk) {
+      GradOnEdge(GradEdge, IEdge, KChunk, ScalarCell);
+   };
+   Result = timeCase(
+       [&] {
+          layoutFor<Layout>("perfGradientOnEdge", NEdgesOwned, NChunks,
+                            GradOnEdgeKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("GradientOnEdge" + LayoutName, Params, Result, NEdgesGlobal,
+              globalBytes(GradientOnEdge::work(Mesh, NVertLevels)));
+
+   CurlOnVertex CurlVertex(Mesh);
+   auto CurlVertexKernel = KOKKOS_LAMBDA(int IVertex, int KChunk) {
+      CurlVertex(RelVortVertex, IVertex, KChunk, VecEdge);
+   };
+   Result = timeCase(
+       [&] {
+          layoutFor<Layout>("perfCurlOnVertex", NVerticesOwned, NChunks,
+                            CurlVertexKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("CurlOnVertex" + LayoutName, Params, Result, NVerticesGlobal,
+              globalBytes(CurlOnVertex::work(Mesh, NVertLevels)));
+
+   TangentialReconOnEdge ReconOnEdge(Mesh);
+   auto ReconOnEdgeKernel = KOKKOS_LAMBDA(int IEdge, int KChunk) {
+      ReconOnEdge(ReconEdge, IEdge, KChunk, VecEdge);
+   };
+   Result = timeCase(
+       [&] {
+          layoutFor<Layout>("perfTangentialReconOnEdge", NEdgesOwned, NChunks,
+                            ReconOnEdgeKernel);
+       },
+       NRepeat, NWarmup, Comm);
+   Report.add("TangentialReconOnEdge" + LayoutName, Params, Result,
+              NEdgesGlobal,
+              globalBytes(TangentialReconOnEdge::work(Mesh, NVertLevels)));
+
+   // Halo pack and unpack of the first layer of cells. The buffer has the
+   // same order for both layouts, so only the access to the array differs.
+   Array1DI4 Ind  = sendIndices(Mesh);
+   const I4 NExch = Ind.extent(0);
+   Array1DReal Buffer("LayoutPerfBuffer", NExch * NVertLevels);
+   I8 NExchGlobal = NExch;
+   MPI_Allreduce(MPI_IN_PLACE, &NExchGlobal, 1, MPI_INT64_T, MPI_SUM, Comm);
+   NExchGlobal *= NVertLevels;
+   const R8 ExchBytes = 2.0 * sizeof(Real) * NExchGlobal;
+
+   Result = timeCase(
+       [&] { packDeviceBuffer(Buffer, 0, Ind, NExch, ScalarCell); }, NRepeat,
+       NWarmup, Comm);
+   Report.add("HaloPack" + LayoutName, {{"levels", NVertLevels}}, Result,
+              NExchGlobal, ExchBytes);
+
+   Result = timeCase(
+       [&] { unpackDeviceBuffer(Buffer, 0, Ind, NExch, ScalarCell); },
+       NRepeat, NWarmup, Comm);
+   Report.add("HaloUnpack" + LayoutName, {{"levels", NVertLevels}}, Result,
+              NExchGlobal, ExchBytes);
+
+} // end layoutPerf
+
+//------------------------------------------------------------------------------
+// The benchmark driver
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      PerfOptions Opts(argc, argv);
+      const std::string MeshFile = Opts.getString("mesh", "OmegaMesh.nc");
+
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefaultEnv();
+      RetVal += IO::init(DefEnv->getComm());
+      RetVal += Decomp::init(MeshFile);
+      RetVal += Halo::init();
+      RetVal += HorzMesh::init();
+
+      if (RetVal == 0) {
+         PerfReport Report("Layout", Opts, DefEnv);
+         layoutPerf<Kokkos::LayoutRight>("Right", Opts, Report);
+         layoutPerf<Kokkos::LayoutLeft>("Left", Opts, Report);
+      } else {
+         LOG_CRITICAL("LayoutPerf: error initializing mesh {}", MeshFile);
+      }
+
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
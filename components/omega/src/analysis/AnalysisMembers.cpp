@@ -0,0 +1,698 @@
+//===-- analysis/AnalysisMembers.cpp - in-situ analysis ---------*- C++ -*-===//
+//
+// Each member fills a work array of the owned ocean cells on the device and
+// reduces it across tasks in one call. Sums over latitude bins take the
+// cells of a bin from a list sorted by bin, so each bin and level is summed
+// in a fixed order by one thread and the double-double partial sums of all
+// bins are reduced together. Outputs that are global arrays are held in
+// full on every task and written by the first task.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AnalysisMembers.h"
+#include "Config.h"
+#include "Decomp.h"
+#include "IO.h"
+#include "IOField.h"
+#include "IOStream.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "Reductions.h"
+
+#include <cmath>
+
+namespace OMEGA {
+
+AnalysisFields AnalysisMember::CurrentFields;
+I8 AnalysisMember::Epoch = 0;
+std::map<std::string, std::unique_ptr<AnalysisMember>>
+    AnalysisMember::AllMembers;
+
+namespace {
+
+constexpr R8 AnalysisFill = -9.99e30; // fill value of the outputs
+constexpr R8 RadToDeg     = 180.0 / M_PI;
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Sort the owned ocean cells into bins of latitude
+
+LatitudeBins::LatitudeBins(HorzMesh *Mesh, // [in] mesh
+                           I4 InNBins      // [in] number of bins
+                           )
+    : NBins(InNBins) {
+
+   Mesh->loadCoordinates();
+
+   const R8 Width = M_PI / NBins;
+   CenterLatH     = HostArray1DR8("LatBinCenter", NBins);
+   NorthLatH      = HostArray1DR8("LatBinNorth", NBins);
+   for (int IBin = 0; IBin < NBins; ++IBin) {
+      CenterLatH(IBin) = -0.5 * M_PI + (IBin + 0.5) * Width;
+      NorthLatH(IBin)  = -0.5 * M_PI + (IBin + 1) * Width;
+   }
+
+   // Counting sort of the cells by bin
+   std::vector<I4> CellBin(Mesh->NCellsOwned, -1);
+   HostArray1DI4 BinStartH("BinStart", NBins + 1);
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+      if (Mesh->MaxLevelCellH(ICell) < Mesh->MinLevelCellH(ICell))
+         continue;
+      const I4 IBin  = static_cast<I4>((Mesh->LatCellH(ICell) + 0.5 * M_PI) /
+                                       Width);
+      CellBin[ICell] = std::min(std::max(IBin, 0), NBins - 1);
+      ++BinStartH(CellBin[ICell] + 1);
+   }
+   for (int IBin = 0; IBin < NBins; ++IBin)
+      BinStartH(IBin + 1) += BinStartH(IBin);
+
+   HostArray1DI4 BinCellsH("BinCells", BinStartH(NBins));
+   std::vector<I4> Fill(BinStartH.data(), BinStartH.data() + NBins);
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+      if (CellBin[ICell] >= 0)
+         BinCellsH(Fill[CellBin[ICell]]++) = ICell;
+   }
+
+   BinStart = createDeviceMirrorCopy(BinStartH);
+   BinCells = createDeviceMirrorCopy(BinCellsH);
+
+} // end LatitudeBins constructor
+
+//------------------------------------------------------------------------------
+// Reproducible global sums over the cells of each bin and level
+
+int LatitudeBins::sum(std::vector<R8> &Sums,   // [out] sums of bins, levels
+                      const Array2DR8 &Values, // [in] values of cells, levels
+                      const MPI_Comm Comm      // [in] communicator
+) const {
+
+   const I4 NLevels = Values.extent_int(1);
+   Array2DR8 Partial("LatitudeBinsPartial", NBins * NLevels, 2);
+
+   OMEGA_SCOPE(LocBinStart, BinStart);
+   OMEGA_SCOPE(LocBinCells, BinCells);
+
+   parallelFor(
+       "LatitudeBins:sum", {NBins, NLevels},
+       KOKKOS_LAMBDA(int IBin, int K) {
+          DDValue Sum{0.0, 0.0};
+          for (int J = LocBinStart(IBin); J < LocBinStart(IBin + 1); ++J)
+             ddAdd(Sum, Values(LocBinCells(J), K));
+          Partial(IBin * NLevels + K, 0) = Sum.Hi;
+          Partial(IBin * NLevels + K, 1) = Sum.Lo;
+       });
+
+   auto PartialH = createHostMirrorCopy(Partial);
+   std::vector<DDValue> LocalSums(NBins * NLevels);
+   for (int I = 0; I < NBins * NLevels; ++I)
+      LocalSums[I] = DDValue{PartialH(I, 0), PartialH(I, 1)};
+
+   return globalSum(LocalSums, Comm, Sums);
+
+} // end LatitudeBins::sum
+
+//------------------------------------------------------------------------------
+// Base class of the analysis members
+
+AnalysisMember::AnalysisMember(const std::string &InName, HorzMesh *InMesh,
+                               I4 InNVertLevels)
+    : Name(InName), Mesh(InMesh), NVertLevels(InNVertLevels),
+      Comm(MachEnv::getDefaultEnv()->getComm()) {}
+
+// Streams holding the outputs must be removed before the member
+AnalysisMember::~AnalysisMember() {
+   for (const Output &Out : Outputs) {
+      if (IOField::isDefined(Out.FieldName))
+         IOField::erase(Out.FieldName);
+      if (MetaData::has(Out.FieldName))
+         MetaData::destroy(Out.FieldName);
+   }
+   for (int &DecompID : DecompIDs)
+      IO::destroyDecomp(DecompID);
+}
+
+//------------------------------------------------------------------------------
+// Define an output of the member with an update that computes the member
+
+template <typename T>
+int AnalysisMember::defineOutput(
+    const std::string &FieldName,             // [in] field name
+    const std::string &Description,           // [in] long name
+    const std::string &Units,                 // [in] units
+    const std::vector<std::string> &DimNames, // [in] dimension names
+    const std::vector<I4> &DimLengths,        // [in] dimension lengths
+    int DecompID,                             // [in] IO decomposition
+    const T &Data                             // [in] array of the output
+) {
+
+   std::vector<std::shared_ptr<MetaDim>> Dims;
+   for (int IDim = 0; IDim < DimNames.size(); ++IDim) {
+      if (MetaDim::has(DimNames[IDim])) {
+         Dims.push_back(MetaDim::get(DimNames[IDim]));
+      } else {
+         Dims.push_back(MetaDim::create(DimNames[IDim], DimLengths[IDim]));
+      }
+   }
+
+   auto Meta = ArrayMetaData::create(FieldName, Description, Units, "",
+                                     -9.99e30, 9.99e30, AnalysisFill,
+                                     Dims.size(), Dims);
+   if (Meta == nullptr || IOField::define(FieldName) != 0) {
+      LOG_ERROR("AnalysisMember: error defining output {} of {}", FieldName,
+                Name);
+      return 1;
+   }
+
+   int Err = IOField::attachData<T>(FieldName, Data);
+   Err += IOField::setUpdate(FieldName, [this]() { return update(); });
+
+   Outputs.push_back(
+       {FieldName, [FieldName, DimNames, DecompID](const std::string &Stream) {
+           return IOStream::addField<T>(Stream, FieldName, DecompID,
+                                        DimNames);
+        }});
+
+   return Err;
+
+} // end defineOutput
+
+//------------------------------------------------------------------------------
+// IO decomposition of a global array written by the first task
+
+int AnalysisMember::globalDecomp(I4 NGlobal // [in] number of values
+) {
+
+   const bool First = MachEnv::getDefaultEnv()->isMasterTask();
+   std::vector<int> Offset(NGlobal, -1);
+   for (int I = 0; First && I < NGlobal; ++I)
+      Offset[I] = I;
+
+   int DecompID;
+   std::vector<int> Dims{NGlobal};
+   int Err = IO::createDecomp(DecompID, IO::IOTypeR8, 1, Dims, NGlobal, Offset,
+                              IO::DefaultRearr);
+   if (Err != 0) {
+      LOG_ERROR("AnalysisMember: error creating decomposition for {}", Name);
+      return -1;
+   }
+   DecompIDs.push_back(DecompID);
+   return DecompID;
+
+} // end globalDecomp
+
+//------------------------------------------------------------------------------
+// IO decomposition of a cell array
+
+int AnalysisMember::cellDecomp() {
+
+   Decomp *DefDecomp = Decomp::getDefault();
+   const HostArray1DI4 CellIDH = DefDecomp->getHost(DefDecomp->CellIDH);
+   std::vector<int> Offset(Mesh->NCellsSize, -1);
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell)
+      Offset[ICell] = CellIDH(ICell) - 1;
+
+   int DecompID;
+   std::vector<int> Dims{DefDecomp->NCellsGlobal};
+   int Err = IO::createDecomp(DecompID, IO::IOTypeR8, 1, Dims,
+                              Mesh->NCellsSize, Offset, IO::DefaultRearr);
+   if (Err != 0) {
+      LOG_ERROR("AnalysisMember: error creating decomposition for {}", Name);
+      return -1;
+   }
+   DecompIDs.push_back(DecompID);
+   return DecompID;
+
+} // end cellDecomp
+
+//------------------------------------------------------------------------------
+// Add the outputs of the member to a stream
+
+int AnalysisMember::addToStream(const std::string &StreamName // [in] stream
+) {
+
+   int Err = 0;
+   for (const Output &Out : Outputs)
+      Err += Out.AddTo(StreamName);
+   if (Err != 0)
+      LOG_ERROR("AnalysisMember: error adding {} to stream {}", Name,
+                StreamName);
+   return Err;
+
+} // end addToStream
+
+//------------------------------------------------------------------------------
+// Compute the member unless it is up to date with the current fields
+
+int AnalysisMember::update() {
+
+   if (Epoch == 0) {
+      LOG_ERROR("AnalysisMember: {} computed before setFields", Name);
+      return 1;
+   }
+   if (ComputedEpoch == Epoch)
+      return 0;
+
+   int Err = compute(CurrentFields);
+   if (Err != 0) {
+      LOG_ERROR("AnalysisMember: error computing {}", Name);
+      return Err;
+   }
+   ComputedEpoch = Epoch;
+   return 0;
+
+} // end update
+
+//------------------------------------------------------------------------------
+// Static management of the members
+
+void AnalysisMember::setFields(const AnalysisFields &Fields // [in] fields
+) {
+   CurrentFields = Fields;
+   ++Epoch;
+}
+
+int AnalysisMember::computeAll() {
+   int Err = 0;
+   for (auto &[MemberName, Member] : AllMembers)
+      Err += Member->update();
+   return Err;
+}
+
+AnalysisMember *AnalysisMember::add(std::unique_ptr<AnalysisMember> Member
+) {
+   const std::string MemberName = Member->getName();
+   if (AllMembers.find(MemberName) != AllMembers.end()) {
+      LOG_ERROR("AnalysisMember: attempt to add member {} that already exists",
+                MemberName);
+      return nullptr;
+   }
+   AnalysisMember *Ptr     = Member.get();
+   AllMembers[MemberName] = std::move(Member);
+   return Ptr;
+}
+
+AnalysisMember *AnalysisMember::get(const std::string &Name // [in] name
+) {
+   auto It = AllMembers.find(Name);
+   return It == AllMembers.end() ? nullptr : It->second.get();
+}
+
+void AnalysisMember::erase(const std::string &Name // [in] name
+) {
+   AllMembers.erase(Name);
+}
+
+void AnalysisMember::clear() {
+   AllMembers.clear();
+   CurrentFields = AnalysisFields();
+   Epoch         = 0;
+}
+
+//------------------------------------------------------------------------------
+// Create the members enabled in the configuration
+
+int AnalysisMember::init(I4 NVertLevels // [in] number of vertical levels
+) {
+
+   ConfigParam<std::string> StreamName("AnalysisMembers/StreamName", "");
+   ConfigParam<bool> UseZonal("AnalysisMembers/ZonalMean/Enable", false);
+   ConfigParam<I4> ZonalBins("AnalysisMembers/ZonalMean/NLatBins", 180);
+   ConfigParam<bool> UseMHT("AnalysisMembers/MeridionalHeatTransport/Enable",
+                            false);
+   ConfigParam<I4> MHTBins("AnalysisMembers/MeridionalHeatTransport/NLatBins",
+                           180);
+   ConfigParam<bool> UseMLD("AnalysisMembers/MixedLayerDepth/Enable", false);
+   ConfigParam<R8> MLDThreshold(
+       "AnalysisMembers/MixedLayerDepth/DensityThreshold", 0.03);
+
+   int Err = StreamName.bind() + UseZonal.bind() + ZonalBins.bind() +
+             UseMHT.bind() + MHTBins.bind() + UseMLD.bind() +
+             MLDThreshold.bind();
+   if (Err != 0) {
+      LOG_ERROR("AnalysisMember: error reading AnalysisMembers options");
+      return Err;
+   }
+   if ((UseZonal.get() && ZonalBins.get() < 1) ||
+       (UseMHT.get() && MHTBins.get() < 1)) {
+      LOG_ERROR("AnalysisMember: the number of latitude bins must be positive");
+      return 1;
+   }
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+   std::vector<AnalysisMember *> Created;
+   if (UseZonal.get())
+      Created.push_back(add(std::make_unique<ZonalMean>(
+          "ZonalMean", Mesh, NVertLevels, ZonalBins.get())));
+   if (UseMHT.get())
+      Created.push_back(add(std::make_unique<MeridionalHeatTransport>(
+          "MeridionalHeatTransport", Mesh, NVertLevels, MHTBins.get())));
+   if (UseMLD.get())
+      Created.push_back(add(std::make_unique<MixedLayerDepth>(
+          "MixedLayerDepth", Mesh, NVertLevels, MLDThreshold.get())));
+
+   for (AnalysisMember *Member : Created) {
+      if (Member == nullptr) {
+         LOG_ERROR("AnalysisMember: error creating analysis members");
+         return 1;
+      }
+      if (!StreamName.get().empty())
+         Err += Member->addToStream(StreamName.get());
+   }
+
+   return Err;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Zonal means
+
+ZonalMean::ZonalMean(const std::string &Name, // [in] name of the member
+                     HorzMesh *Mesh,          // [in] mesh
+                     I4 NVertLevels,          // [in] vertical levels
+                     I4 NLatBins              // [in] latitude bins
+                     )
+    : AnalysisMember(Name, Mesh, NVertLevels),
+      MeanTemperature(Name + "Temperature", NLatBins, NVertLevels),
+      MeanSalinity(Name + "Salinity", NLatBins, NVertLevels),
+      Bins(Mesh, NLatBins),
+      Work(Name + "Work", Mesh->NCellsSize, 3 * NVertLevels) {
+
+   HostArray1DR8 BinLat(Name + "LatBinCenter", NLatBins);
+   for (int IBin = 0; IBin < NLatBins; ++IBin)
+      BinLat(IBin) = RadToDeg * Bins.CenterLatH(IBin);
+
+   const std::vector<std::string> BinDim{Name + "NLatBins"};
+   const std::vector<std::string> Dims{Name + "NLatBins", "NVertLevels"};
+   const std::vector<I4> Lengths{NLatBins, NVertLevels};
+   const int BinDecomp   = globalDecomp(NLatBins);
+   const int TableDecomp = globalDecomp(NLatBins * NVertLevels);
+
+   int Err = defineOutput(Name + "LatBinCenter",
+                          "Latitude of the center of each bin", "degrees_north",
+                          BinDim, {NLatBins}, BinDecomp, BinLat);
+   Err += defineOutput(Name + "Temperature", "Zonal mean temperature",
+                       "degree_C", Dims, Lengths, TableDecomp,
+                       MeanTemperature);
+   Err += defineOutput(Name + "Salinity", "Zonal mean salinity", "g/kg", Dims,
+                       Lengths, TableDecomp, MeanSalinity);
+   if (Err != 0)
+      LOG_ERROR("ZonalMean: error defining outputs of {}", Name);
+
+} // end ZonalMean constructor
+
+int ZonalMean::compute(const AnalysisFields &Fields // [in] model fields
+) {
+
+   OMEGA_SCOPE(OceanCells, Mesh->OceanCellsOwned);
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+   OMEGA_SCOPE(AreaCell, Mesh->AreaCell);
+   OMEGA_SCOPE(LocWork, Work);
+   const Array2DReal &LayerThick = Fields.LayerThickness;
+   const Array3DReal &Tracers    = Fields.TracerArray;
+   const I4 IndxTemp             = Fields.IndxTemp;
+   const I4 IndxSalt             = Fields.IndxSalt;
+   const I4 NLev                 = NVertLevels;
+
+   parallelFor(
+       "ZonalMean:weights", {Mesh->NCellsOwnedOcean, NLev},
+       KOKKOS_LAMBDA(int IOcean, int K) {
+          const int ICell = OceanCells(IOcean);
+          R8 Vol          = 0;
+          if (K >= MinLevelCell(ICell) && K <= MaxLevelCell(ICell))
+             Vol = AreaCell(ICell) * LayerThick(ICell, K);
+          LocWork(ICell, K)            = Vol;
+          LocWork(ICell, NLev + K)     = Vol * Tracers(IndxTemp, ICell, K);
+          LocWork(ICell, 2 * NLev + K) = Vol * Tracers(IndxSalt, ICell, K);
+       });
+
+   std::vector<R8> Sums;
+   int Err = Bins.sum(Sums, Work, Comm);
+   if (Err != 0)
+      return Err;
+
+   const I4 NCols = 3 * NLev;
+   for (int IBin = 0; IBin < Bins.NBins; ++IBin) {
+      for (int K = 0; K < NLev; ++K) {
+         const R8 Vol = Sums[IBin * NCols + K];
+         MeanTemperature(IBin, K) =
+             Vol > 0 ? Sums[IBin * NCols + NLev + K] / Vol : AnalysisFill;
+         MeanSalinity(IBin, K) =
+             Vol > 0 ? Sums[IBin * NCols + 2 * NLev + K] / Vol : AnalysisFill;
+      }
+   }
+
+   return 0;
+
+} // end ZonalMean::compute
+
+//------------------------------------------------------------------------------
+// Meridional heat transport
+
+MeridionalHeatTransport::MeridionalHeatTransport(
+    const std::string &Name, // [in] name of the member
+    HorzMesh *Mesh,          // [in] mesh
+    I4 NVertLevels,          // [in] vertical levels
+    I4 NLatBins,             // [in] latitude bins
+    R8 InRhoCp               // [in] volumetric heat capacity
+    )
+    : AnalysisMember(Name, Mesh, NVertLevels), Transport(Name, NLatBins),
+      Bins(Mesh, NLatBins), RhoCp(InRhoCp),
+      Work(Name + "Work", Mesh->NCellsSize, 1) {
+
+   HostArray1DR8 BinLat(Name + "LatBinNorth", NLatBins);
+   for (int IBin = 0; IBin < NLatBins; ++IBin)
+      BinLat(IBin) = RadToDeg * Bins.NorthLatH(IBin);
+
+   const std::vector<std::string> BinDim{Name + "NLatBins"};
+   const int BinDecomp = globalDecomp(NLatBins);
+
+   int Err = defineOutput(Name + "LatBinNorth",
+                          "Latitude of the north edge of each bin",
+                          "degrees_north", BinDim, {NLatBins}, BinDecomp,
+                          BinLat);
+   Err += defineOutput(Name, "Northward heat transport at the north edge of "
+                             "each latitude bin",
+                       "PW", BinDim, {NLatBins}, BinDecomp, Transport);
+   if (Err != 0)
+      LOG_ERROR("MeridionalHeatTransport: error defining outputs of {}",
+                Name);
+
+} // end MeridionalHeatTransport constructor
+
+int MeridionalHeatTransport::compute(const AnalysisFields &Fields // [in]
+) {
+
+   OMEGA_SCOPE(OceanCells, Mesh->OceanCellsOwned);
+   OMEGA_SCOPE(NEdgesOnCell, Mesh->NEdgesOnCell);
+   OMEGA_SCOPE(EdgesOnCell, Mesh->EdgesOnCell);
+   OMEGA_SCOPE(CellsOnEdge, Mesh->CellsOnEdge);
+   OMEGA_SCOPE(EdgeSignOnCell, Mesh->EdgeSignOnCell);
+   OMEGA_SCOPE(DvEdge, Mesh->DvEdge);
+   OMEGA_SCOPE(MinLevelEdgeTop, Mesh->MinLevelEdgeTop);
+   OMEGA_SCOPE(MaxLevelEdgeTop, Mesh->MaxLevelEdgeTop);
+   OMEGA_SCOPE(LocWork, Work);
+   const Array2DReal &LayerThick = Fields.LayerThickness;
+   const Array2DReal &NormalVel  = Fields.NormalVelocity;
+   const Array3DReal &Tracers    = Fields.TracerArray;
+   const I4 IndxTemp             = Fields.IndxTemp;
+   const R8 LocRhoCp             = RhoCp;
+   const I4 KLast                = NVertLevels - 1;
+
+   // Heat leaving each cell through its edges, integrated over the column.
+   // The thickness and temperature on an edge are the means of its cells.
+   parallelFor(
+       "MeridionalHeatTransport:flux", {Mesh->NCellsOwnedOcean},
+       KOKKOS_LAMBDA(int IOcean) {
+          const int ICell = OceanCells(IOcean);
+          R8 Flux         = 0;
+          for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+             const int IEdge = EdgesOnCell(ICell, J);
+             const int C0    = CellsOnEdge(IEdge, 0);
+             const int C1    = CellsOnEdge(IEdge, 1);
+             const R8 DvSign = EdgeSignOnCell(ICell, J) * DvEdge(IEdge);
+             const int KEnd  = Kokkos::min(MaxLevelEdgeTop(IEdge), KLast);
+             for (int K = MinLevelEdgeTop(IEdge); K <= KEnd; ++K) {
+                const R8 HTEdge =
+                    0.25 * (LayerThick(C0, K) + LayerThick(C1, K)) *
+                    (Tracers(IndxTemp, C0, K) + Tracers(IndxTemp, C1, K));
+                Flux -= DvSign * NormalVel(IEdge, K) * HTEdge;
+             }
+          }
+          LocWork(ICell, 0) = LocRhoCp * Flux;
+       });
+
+   std::vector<R8> Sums;
+   int Err = Bins.sum(Sums, Work, Comm);
+   if (Err != 0)
+      return Err;
+
+   R8 Accum = 0;
+   for (int IBin = 0; IBin < Bins.NBins; ++IBin) {
+      Accum += Sums[IBin];
+      Transport(IBin) = 1.0e-15 * Accum;
+   }
+
+   return 0;
+
+} // end MeridionalHeatTransport::compute
+
+//------------------------------------------------------------------------------
+// Mixed-layer depth
+
+MixedLayerDepth::MixedLayerDepth(const std::string &Name, // [in] member name
+                                 HorzMesh *Mesh,          // [in] mesh
+                                 I4 NVertLevels,          // [in] levels
+                                 R8 InDensityThreshold    // [in] threshold
+                                 )
+    : AnalysisMember(Name, Mesh, NVertLevels),
+      Depth(Name, Mesh->NCellsSize), DensityThreshold(InDensityThreshold) {
+
+   const int DecompID = cellDecomp();
+   int Err = defineOutput(Name, "Mixed-layer depth from a density threshold",
+                          "m", {"NCells"},
+                          {Decomp::getDefault()->NCellsGlobal}, DecompID,
+                          Depth);
+   if (Err != 0)
+      LOG_ERROR("MixedLayerDepth: error defining outputs of {}", Name);
+
+} // end MixedLayerDepth constructor
+
+int MixedLayerDepth::compute(const AnalysisFields &Fields // [in] fields
+) {
+
+   if (Fields.Density.size() == 0) {
+      LOG_ERROR("MixedLayerDepth: {} requires the density", Name);
+      return 1;
+   }
+
+   OMEGA_SCOPE(OceanCells, Mesh->OceanCellsOwned);
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+   OMEGA_SCOPE(LocDepth, Depth);
+   const Array2DReal &LayerThick = Fields.LayerThickness;
+   const Array2DReal &Density    = Fields.Density;
+   const R8 Threshold            = DensityThreshold;
+   const I4 KLast                = NVertLevels - 1;
+
+   parallelFor(
+       "MixedLayerDepth:compute", {Mesh->NCellsOwnedOcean},
+       KOKKOS_LAMBDA(int IOcean) {
+          const int ICell = OceanCells(IOcean);
+          const int KTop  = MinLevelCell(ICell);
+          const int KEnd  = Kokkos::min(MaxLevelCell(ICell), KLast);
+          const R8 RhoTop = Density(ICell, KTop);
+
+          // Search down the layer centers for the threshold
+          R8 ZTop    = 0;
+          R8 ZPrev   = 0;
+          R8 RhoPrev = RhoTop;
+          R8 MLD     = -1;
+          for (int K = KTop; K <= KEnd; ++K) {
+             const R8 ZMid = ZTop + 0.5 * LayerThick(ICell, K);
+             const R8 Rho  = Density(ICell, K);
+             if (MLD < 0 && Rho - RhoTop > Threshold) {
+                const R8 Frac =
+                    (RhoTop + Threshold - RhoPrev) / (Rho - RhoPrev);
+                MLD = ZPrev + Frac * (ZMid - ZPrev);
+             }
+             ZPrev   = ZMid;
+             RhoPrev = Rho;
+             ZTop += LayerThick(ICell, K);
+          }
+          LocDepth(ICell) = MLD < 0 ? ZTop : MLD;
+       });
+
+   return 0;
+
+} // end MixedLayerDepth::compute
+
+//------------------------------------------------------------------------------
+// Regional means
+
+RegionalMeans::RegionalMeans(
+    const std::string &Name,            // [in] name of the member
+    HorzMesh *Mesh,                     // [in] mesh
+    I4 NVertLevels,                     // [in] vertical levels
+    const std::vector<Array1DI4> &Masks // [in] region masks
+    )
+    : AnalysisMember(Name, Mesh, NVertLevels),
+      Volume(Name + "Volume", Masks.size()),
+      MeanTemperature(Name + "Temperature", Masks.size()),
+      MeanSalinity(Name + "Salinity", Masks.size()) {
+
+   // Combine each region with the active levels of its cells, so the
+   // reductions need a single mask
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+   for (const Array1DI4 &Mask : Masks) {
+      Array2DI4 LevelMask(Name + "Mask", Mesh->NCellsSize, NVertLevels);
+      parallelFor(
+          "RegionalMeans:mask", {Mesh->NCellsOwned, NVertLevels},
+          KOKKOS_LAMBDA(int ICell, int K) {
+             LevelMask(ICell, K) = Mask(ICell) != 0 &&
+                                   K >= MinLevelCell(ICell) &&
+                                   K <= MaxLevelCell(ICell);
+          });
+      LevelMasks.push_back(LevelMask);
+   }
+
+   const I4 NRegions = Masks.size();
+   const std::vector<std::string> Dim{Name + "NRegions"};
+   const int DecompID = globalDecomp(NRegions);
+
+   int Err = defineOutput(Name + "Volume", "Ocean volume of each region",
+                          "m^3", Dim, {NRegions}, DecompID, Volume);
+   Err += defineOutput(Name + "Temperature", "Mean temperature of each region",
+                       "degree_C", Dim, {NRegions}, DecompID,
+                       MeanTemperature);
+   Err += defineOutput(Name + "Salinity", "Mean salinity of each region",
+                       "g/kg", Dim, {NRegions}, DecompID, MeanSalinity);
+   if (Err != 0)
+      LOG_ERROR("RegionalMeans: error defining outputs of {}", Name);
+
+} // end RegionalMeans constructor
+
+int RegionalMeans::compute(const AnalysisFields &Fields // [in] model fields
+) {
+
+   auto Temp = Kokkos::subview(Fields.TracerArray, Fields.IndxTemp,
+                               Kokkos::ALL, Kokkos::ALL);
+   auto Salt = Kokkos::subview(Fields.TracerArray, Fields.IndxSalt,
+                               Kokkos::ALL, Kokkos::ALL);
+   const Array2DReal &LayerThick = Fields.LayerThickness;
+   const I4 NOwned               = Mesh->NCellsOwned;
+
+   // All sums of all regions are reduced in one call
+   std::vector<DDValue> LocalSums;
+   for (const Array2DI4 &Mask : LevelMasks) {
+      LocalSums.push_back(localWeightedSumDD(LayerThick, Mesh->AreaCell,
+                                             NoWeight(), Mask, NOwned));
+      LocalSums.push_back(localWeightedSumDD(Temp, Mesh->AreaCell, LayerThick,
+                                             Mask, NOwned));
+      LocalSums.push_back(localWeightedSumDD(Salt, Mesh->AreaCell, LayerThick,
+                                             Mask, NOwned));
+   }
+
+   std::vector<R8> Sums;
+   int Err = globalSum(LocalSums, Comm, Sums);
+   if (Err != 0)
+      return Err;
+
+   for (int IRegion = 0; IRegion < LevelMasks.size(); ++IRegion) {
+      const R8 Vol             = Sums[3 * IRegion];
+      Volume(IRegion)          = Vol;
+      MeanTemperature(IRegion) = Vol > 0 ? Sums[3 * IRegion + 1] / Vol
+                                         : AnalysisFill;
+      MeanSalinity(IRegion)    = Vol > 0 ? Sums[3 * IRegion + 2] / Vol
+                                         : AnalysisFill;
+   }
+
+   return 0;
+
+} // end RegionalMeans::compute
+
+} // end namespace OMEGA
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,258 @@
+#ifndef OMEGA_ANALYSIS_MEMBERS_H
+#define OMEGA_ANALYSIS_MEMBERS_H
+//===-- analysis/AnalysisMembers.h - in-situ analysis -----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines in-situ analysis members computed on the device
+///
+/// An analysis member computes a diagnostic from the model fields, such as
+/// zonal means, the meridional heat transport, the mixed-layer depth or
+/// averages over regions, in the spirit of the analysis members of
+/// MPAS-Ocean. All members run kernels on the device and reduce across tasks
+/// with reproducible double-double sums. The outputs of a member are IOFields
+/// that are added to an IOStream, and each output has an update function, so
+/// a member is only computed when a stream writes it: the driver gives the
+/// current fields to the members every step with setFields, which is cheap,
+/// and the cost of a member is paid at the output frequency of its stream.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "MetaData.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Model fields read by the analysis members. All arrays are on the device
+/// and must be valid in the halo of the owned cells.
+struct AnalysisFields {
+   Array2DReal LayerThickness; ///< layer thickness (m)
+   Array2DReal NormalVelocity; ///< normal velocity on edges (m/s)
+   Array3DReal TracerArray;    ///< packed tracers
+   I4 IndxTemp = -1;           ///< index of temperature in TracerArray
+   I4 IndxSalt = -1;           ///< index of salinity in TracerArray
+   Array2DReal Density;        ///< density, eg. from Eos (kg/m^3)
+};
+
+/// Bins of latitude of equal width from the south pole to the north pole.
+/// The owned ocean cells of each bin are listed contiguously, so sums over
+/// bins are computed by one kernel over bins and levels without atomics.
+class LatitudeBins {
+ public:
+   I4 NBins;                 ///< number of bins
+   Array1DI4 BinStart;       ///< start of each bin in BinCells (NBins+1)
+   Array1DI4 BinCells;       ///< owned ocean cells sorted by bin
+   HostArray1DR8 CenterLatH; ///< latitude of the center of each bin (rad)
+   HostArray1DR8 NorthLatH;  ///< latitude of the north edge of each bin
+
+   /// Sorts the owned ocean cells of the mesh into NBins bins of latitude,
+   /// which requires the mesh coordinates
+   LatitudeBins(HorzMesh *Mesh, ///< [in] mesh
+                I4 NBins        ///< [in] number of bins
+   );
+
+   /// Computes the reproducible global sum over the cells of each bin of
+   /// each level of Values, which has one column per level. Sums(IBin,K) is
+   /// stored in Sums[IBin * NLevels + K]. Returns an error code.
+   int sum(std::vector<R8> &Sums,   ///< [out] sums of each bin and level
+           const Array2DR8 &Values, ///< [in] values of each cell and level
+           const MPI_Comm Comm      ///< [in] communicator of the mesh
+   ) const;
+};
+
+/// Base class of the analysis members. The members are stored by name and
+/// share the fields last given to setFields.
+class AnalysisMember {
+ public:
+   virtual ~AnalysisMember();
+
+   /// Computes the member from the fields. Returns an error code.
+   virtual int compute(const AnalysisFields &Fields ///< [in] model fields
+                       ) = 0;
+
+   /// Adds the outputs of the member to an existing stream. Returns an
+   /// error code.
+   int addToStream(const std::string &StreamName ///< [in] name of stream
+   );
+
+   /// Name of the member
+   const std::string &getName() const { return Name; }
+
+   /// Creates the members enabled in the AnalysisMembers configuration
+   /// group and adds their outputs to the stream named by its StreamName
+   /// option, if any. Returns an error code.
+   static int init(I4 NVertLevels ///< [in] number of vertical levels
+   );
+
+   /// Stores a member under its name and returns a pointer to it, or
+   /// nullptr if a member of the same name exists
+   static AnalysisMember *add(std::unique_ptr<AnalysisMember> Member ///< [in]
+   );
+
+   /// Returns the member Name, or nullptr if it does not exist
+   static AnalysisMember *get(const std::string &Name ///< [in] name
+   );
+
+   /// Removes the member Name
+   static void erase(const std::string &Name ///< [in] name
+   );
+
+   /// Removes all members
+   static void clear();
+
+   /// Sets the fields read by all members. Members are computed from these
+   /// fields the next time one of their outputs is written, at most once
+   /// per call to setFields.
+   static void setFields(const AnalysisFields &Fields ///< [in] model fields
+   );
+
+   /// Computes all members from the current fields now, eg. for analysis
+   /// that is not written to a stream. Returns an error code.
+   static int computeAll();
+
+ protected:
+   AnalysisMember(const std::string &Name, HorzMesh *Mesh, I4 NVertLevels);
+
+   /// Defines the metadata and IOField of an output of the member, attaches
+   /// its array and sets its update to compute the member. The output is
+   /// written with the IO decomposition DecompID. Returns an error code.
+   template <typename T>
+   int defineOutput(const std::string &FieldName,   ///< [in] field name
+                    const std::string &Description, ///< [in] long name
+                    const std::string &Units,       ///< [in] units
+                    const std::vector<std::string> &DimNames, ///< [in]
+                    const std::vector<I4> &DimLengths,        ///< [in]
+                    int DecompID,                             ///< [in]
+                    const T &Data ///< [in] array of the output
+   );
+
+   /// Creates the IO decomposition of an array of NGlobal values held in
+   /// full on every task and written by the first task
+   int globalDecomp(I4 NGlobal ///< [in] number of values
+   );
+
+   /// Creates the IO decomposition of a cell array with one value per cell
+   int cellDecomp();
+
+   std::string Name; ///< name of the member
+   HorzMesh *Mesh;   ///< mesh of the fields
+   I4 NVertLevels;   ///< number of vertical levels
+   MPI_Comm Comm;    ///< communicator of the mesh
+
+ private:
+   /// An output of the member and the function that adds it to a stream
+   /// with the array type and decomposition of the output
+   struct Output {
+      std::string FieldName;                          ///< name of IOField
+      std::function<int(const std::string &)> AddTo; ///< adds to a stream
+   };
+
+   /// Computes the member from the current fields unless it is up to date
+   int update();
+
+   std::vector<Output> Outputs; ///< outputs of the member
+   std::vector<int> DecompIDs;  ///< IO decompositions created
+   I8 ComputedEpoch = -1;       ///< epoch of the fields last computed
+
+   static AnalysisFields CurrentFields; ///< fields read by the members
+   static I8 Epoch;                     ///< number of calls to setFields
+   static std::map<std::string, std::unique_ptr<AnalysisMember>> AllMembers;
+
+}; // end class AnalysisMember
+
+/// Zonal means of temperature and salinity on each level, weighted by the
+/// volume of each cell, in bins of latitude. Bins and levels with no ocean
+/// are set to the fill value.
+class ZonalMean : public AnalysisMember {
+ public:
+   HostArray2DR8 MeanTemperature; ///< zonal mean temperature (NBins,NLevels)
+   HostArray2DR8 MeanSalinity;    ///< zonal mean salinity (NBins,NLevels)
+
+   ZonalMean(const std::string &Name, ///< [in] name of the member
+             HorzMesh *Mesh,          ///< [in] mesh
+             I4 NVertLevels,          ///< [in] number of vertical levels
+             I4 NLatBins              ///< [in] number of latitude bins
+   );
+
+   int compute(const AnalysisFields &Fields) override;
+
+ private:
+   LatitudeBins Bins; ///< latitude bins
+   Array2DR8 Work;    ///< weighted values of each cell and level
+};
+
+/// Northward heat transport across latitudes. The vertically integrated
+/// heat flux out of each owned cell is summed over bins of latitude and
+/// accumulated from the south pole, so the transport at the north edge of a
+/// bin is the net heat leaving the ocean south of it.
+class MeridionalHeatTransport : public AnalysisMember {
+ public:
+   HostArray1DR8 Transport; ///< transport at the north edge of a bin (PW)
+
+   MeridionalHeatTransport(const std::string &Name,   ///< [in] member name
+                           HorzMesh *Mesh,            ///< [in] mesh
+                           I4 NVertLevels,            ///< [in] levels
+                           I4 NLatBins,               ///< [in] latitude bins
+                           R8 RhoCp = 1026.0 * 3996.0 ///< [in] rho0 cp
+   );
+
+   int compute(const AnalysisFields &Fields) override;
+
+ private:
+   LatitudeBins Bins; ///< latitude bins
+   R8 RhoCp;          ///< volumetric heat capacity (J/m^3/C)
+   Array2DR8 Work;    ///< heat leaving each cell (W)
+};
+
+/// Mixed-layer depth from a density threshold: the depth at which the
+/// density first exceeds the density of the top active layer by
+/// DensityThreshold, interpolated linearly between layer centers. Cells in
+/// which the threshold is not reached are mixed to the bottom.
+class MixedLayerDepth : public AnalysisMember {
+ public:
+   Array1DR8 Depth; ///< mixed-layer depth of each cell (m)
+
+   MixedLayerDepth(const std::string &Name,   ///< [in] name of the member
+                   HorzMesh *Mesh,            ///< [in] mesh
+                   I4 NVertLevels,            ///< [in] vertical levels
+                   R8 DensityThreshold = 0.03 ///< [in] threshold (kg/m^3)
+   );
+
+   int compute(const AnalysisFields &Fields) override;
+
+ private:
+   R8 DensityThreshold; ///< density difference at the base (kg/m^3)
+};
+
+/// Volume-weighted means of temperature and salinity and the volume of the
+/// ocean in regions given by masks on the cells
+class RegionalMeans : public AnalysisMember {
+ public:
+   HostArray1DR8 Volume;          ///< ocean volume of each region (m^3)
+   HostArray1DR8 MeanTemperature; ///< mean temperature of each region
+   HostArray1DR8 MeanSalinity;    ///< mean salinity of each region
+
+   /// Creates the regional means for regions given by masks of length
+   /// NCellsSize that are non-zero in the cells of each region
+   RegionalMeans(const std::string &Name,            ///< [in] member name
+                 HorzMesh *Mesh,                     ///< [in] mesh
+                 I4 NVertLevels,                     ///< [in] levels
+                 const std::vector<Array1DI4> &Masks ///< [in] region masks
+   );
+
+   int compute(const AnalysisFields &Fields) override;
+
+ private:
+   std::vector<Array2DI4> LevelMasks; ///< active levels of each region
+};
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_ANALYSIS_MEMBERS_H
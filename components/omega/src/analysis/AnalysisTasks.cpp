@@ -0,0 +1,343 @@
+//===-- analysis/AnalysisTasks.cpp - concurrent analysis tasks --*- C++ -*-===//
+//
+// The default environment is split into an Ocean environment of the first
+// tasks and an Analysis environment of the last tasks, joined by an MPI
+// intercommunicator. Ocean tasks are assigned to analysis tasks in
+// contiguous blocks. Each field is packed into one message holding the time
+// step, the name and the values, so the receiver can size its buffer from a
+// matched probe. A message with the done tag ends the fields from a task.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AnalysisTasks.h"
+#include "Config.h"
+#include "Logging.h"
+
+#include <climits>
+#include <cstring>
+
+namespace OMEGA {
+
+// Static members
+bool AnalysisTasks::Enabled        = false;
+bool AnalysisTasks::AnalysisFlag   = false;
+I4 AnalysisTasks::NumOceanTasks    = 0;
+I4 AnalysisTasks::NumAnalysisTasks = 0;
+MPI_Comm AnalysisTasks::InterComm  = MPI_COMM_NULL;
+std::list<AnalysisTasks::PendingSend> AnalysisTasks::Pending;
+
+//------------------------------------------------------------------------------
+// Split the default environment into the Ocean and Analysis environments
+
+int AnalysisTasks::init(const I4 NumTasks // [in] number of analysis tasks
+) {
+
+   MachEnv *DefEnv   = MachEnv::getDefaultEnv();
+   const I4 AllTasks = DefEnv->getNumTasks();
+
+   if (NumTasks < 0 || NumTasks >= AllTasks) {
+      LOG_ERROR("AnalysisTasks: invalid number of analysis tasks {}: must be "
+                "in [0,{}]",
+                NumTasks, AllTasks - 1);
+      return 1;
+   }
+
+   NumOceanTasks    = AllTasks - NumTasks;
+   NumAnalysisTasks = NumTasks;
+   Enabled          = NumTasks > 0;
+   AnalysisFlag     = Enabled && DefEnv->getMyTask() >= NumOceanTasks;
+
+   // The constructors store copies of the environments by name
+   MachEnv OceanEnv("Ocean", DefEnv, NumOceanTasks);
+   if (!Enabled)
+      return 0;
+   MachEnv AnalysisEnv("Analysis", DefEnv, NumAnalysisTasks, NumOceanTasks,
+                       1);
+
+   // The leader of each group is its first task and the remote leader is
+   // given as a task in the default environment
+   MPI_Comm LocalComm =
+       AnalysisFlag ? getAnalysisEnv()->getComm() : getOceanEnv()->getComm();
+   const int RemoteLeader = AnalysisFlag ? 0 : NumOceanTasks;
+
+   int Err = MPI_Intercomm_create(LocalComm, 0, DefEnv->getComm(),
+                                  RemoteLeader, FieldTag, &InterComm);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("AnalysisTasks: error creating the ocean-analysis "
+                "intercommunicator");
+      return Err;
+   }
+
+   LOG_INFO("AnalysisTasks: {} ocean tasks and {} analysis tasks",
+            NumOceanTasks, NumAnalysisTasks);
+
+   return 0;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Split the default environment using the number of analysis tasks from the
+// configuration
+
+int AnalysisTasks::init() {
+
+   ConfigParam<I4> NumTasks("Analysis/NumTasks", 0);
+   if (NumTasks.bind() != 0) {
+      LOG_ERROR("AnalysisTasks: error reading Analysis options");
+      return 1;
+   }
+
+   return init(NumTasks.get());
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Complete outstanding sends and remove the environments
+
+void AnalysisTasks::clear() {
+
+   waitSends();
+
+   if (InterComm != MPI_COMM_NULL)
+      MPI_Comm_free(&InterComm);
+
+   if (NumOceanTasks > 0)
+      MachEnv::removeEnv("Ocean");
+   if (Enabled)
+      MachEnv::removeEnv("Analysis");
+
+   Enabled          = false;
+   AnalysisFlag     = false;
+   NumOceanTasks    = 0;
+   NumAnalysisTasks = 0;
+   InterComm        = MPI_COMM_NULL;
+
+} // end clear
+
+//------------------------------------------------------------------------------
+// Retrieval functions
+
+bool AnalysisTasks::isEnabled() { return Enabled; }
+
+bool AnalysisTasks::isAnalysisTask() { return AnalysisFlag; }
+
+MachEnv *AnalysisTasks::getOceanEnv() {
+   if (NumOceanTasks == 0)
+      return nullptr;
+   return MachEnv::getEnv("Ocean");
+}
+
+MachEnv *AnalysisTasks::getAnalysisEnv() {
+   if (!Enabled)
+      return nullptr;
+   return MachEnv::getEnv("Analysis");
+}
+
+I4 AnalysisTasks::getAnalysisTask(const I4 OceanTask // [in] ocean task
+) {
+   return static_cast<I4>(static_cast<I8>(OceanTask) * NumAnalysisTasks /
+                          NumOceanTasks);
+}
+
+//------------------------------------------------------------------------------
+// Count the ocean tasks assigned to the local analysis task
+
+I4 AnalysisTasks::numSenders() {
+
+   const I4 MyTask = getAnalysisEnv()->getMyTask();
+   I4 NumSenders   = 0;
+   for (I4 OceanTask = 0; OceanTask < NumOceanTasks; ++OceanTask) {
+      if (getAnalysisTask(OceanTask) == MyTask)
+         ++NumSenders;
+   }
+   return NumSenders;
+
+} // end numSenders
+
+//------------------------------------------------------------------------------
+// Pack a field and post a non-blocking send to the analysis task
+
+int AnalysisTasks::send(const std::string &Name, // [in] field name
+                        const I8 Step,           // [in] time step
+                        const R8 *Data,          // [in] field values
+                        const I8 Size            // [in] number of values
+) {
+
+   if (!Enabled || AnalysisFlag) {
+      LOG_ERROR("AnalysisTasks: field {} can only be sent from an ocean task "
+                "when analysis tasks are enabled",
+                Name);
+      return 1;
+   }
+
+   // Free the buffers of earlier sends before adding another
+   testSends();
+
+   const I4 NameLen  = Name.size();
+   const I8 NumBytes = sizeof(I8) + sizeof(I4) + NameLen + Size * sizeof(R8);
+   if (Size < 0 || NumBytes > INT_MAX) {
+      LOG_ERROR("AnalysisTasks: invalid size {} for field {}", Size, Name);
+      return MPI_ERR_COUNT;
+   }
+
+   PendingSend &NewSend = Pending.emplace_back();
+   NewSend.Buffer.resize(NumBytes);
+   char *Pos = NewSend.Buffer.data();
+   std::memcpy(Pos, &Step, sizeof(I8));
+   Pos += sizeof(I8);
+   std::memcpy(Pos, &NameLen, sizeof(I4));
+   Pos += sizeof(I4);
+   std::memcpy(Pos, Name.data(), NameLen);
+   Pos += NameLen;
+   if (Size > 0)
+      std::memcpy(Pos, Data, Size * sizeof(R8));
+
+   const I4 Dest = getAnalysisTask(getOceanEnv()->getMyTask());
+
+   int Err = MPI_Isend(NewSend.Buffer.data(), static_cast<int>(NumBytes),
+                       MPI_BYTE, Dest, FieldTag, InterComm, &NewSend.Request);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("AnalysisTasks: error sending field {}", Name);
+      Pending.pop_back();
+   }
+
+   return Err;
+
+} // end send
+
+int AnalysisTasks::send(const std::string &Name,    // [in] field name
+                        const I8 Step,              // [in] time step
+                        const std::vector<R8> &Data // [in] field values
+) {
+   return send(Name, Step, Data.data(), Data.size());
+}
+
+//------------------------------------------------------------------------------
+// Free the buffers of completed sends
+
+I4 AnalysisTasks::testSends() {
+
+   for (auto It = Pending.begin(); It != Pending.end();) {
+      int Done = 0;
+      MPI_Test(&It->Request, &Done, MPI_STATUS_IGNORE);
+      if (Done)
+         It = Pending.erase(It);
+      else
+         ++It;
+   }
+
+   return Pending.size();
+
+} // end testSends
+
+//------------------------------------------------------------------------------
+// Wait for all pending sends
+
+int AnalysisTasks::waitSends() {
+
+   int Err = MPI_SUCCESS;
+   for (PendingSend &Send : Pending) {
+      int SendErr = MPI_Wait(&Send.Request, MPI_STATUS_IGNORE);
+      if (SendErr != MPI_SUCCESS)
+         Err = SendErr;
+   }
+   Pending.clear();
+
+   if (Err != MPI_SUCCESS)
+      LOG_ERROR("AnalysisTasks: error completing field sends");
+
+   return Err;
+
+} // end waitSends
+
+//------------------------------------------------------------------------------
+// Complete the sends of the local ocean task and signal the analysis task
+
+int AnalysisTasks::finishSends() {
+
+   if (!Enabled || AnalysisFlag)
+      return 0;
+
+   int Err = waitSends();
+
+   const I4 Dest = getAnalysisTask(getOceanEnv()->getMyTask());
+   int DoneErr   = MPI_Send(nullptr, 0, MPI_BYTE, Dest, DoneTag, InterComm);
+   if (DoneErr != MPI_SUCCESS) {
+      LOG_ERROR("AnalysisTasks: error sending done message");
+      Err = DoneErr;
+   }
+
+   return Err;
+
+} // end finishSends
+
+//------------------------------------------------------------------------------
+// Receive fields until every assigned ocean task has finished. A matched
+// probe gives the size of each message before it is received.
+
+int AnalysisTasks::run(const AnalysisHandler &Handler // [in] field handler
+) {
+
+   if (!AnalysisFlag) {
+      LOG_ERROR("AnalysisTasks: run can only be called on analysis tasks");
+      return 1;
+   }
+
+   I4 NumRunning = numSenders();
+   std::vector<char> Buffer;
+   AnalysisMessage Message;
+
+   while (NumRunning > 0) {
+
+      MPI_Message Probed;
+      MPI_Status Status;
+      int Err = MPI_Mprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, InterComm, &Probed,
+                           &Status);
+
+      int NumBytes = 0;
+      if (Err == MPI_SUCCESS)
+         Err = MPI_Get_count(&Status, MPI_BYTE, &NumBytes);
+      if (Err == MPI_SUCCESS) {
+         Buffer.resize(NumBytes);
+         Err = MPI_Mrecv(Buffer.data(), NumBytes, MPI_BYTE, &Probed, &Status);
+      }
+      if (Err != MPI_SUCCESS) {
+         LOG_ERROR("AnalysisTasks: error receiving from ocean tasks");
+         return Err;
+      }
+
+      if (Status.MPI_TAG == DoneTag) {
+         --NumRunning;
+         continue;
+      }
+
+      // Unpack the time step, name and values
+      I4 NameLen      = 0;
+      const char *Pos = Buffer.data();
+      std::memcpy(&Message.Step, Pos, sizeof(I8));
+      Pos += sizeof(I8);
+      std::memcpy(&NameLen, Pos, sizeof(I4));
+      Pos += sizeof(I4);
+      Message.Name.assign(Pos, NameLen);
+      Pos += NameLen;
+      Message.Data.resize((NumBytes - (Pos - Buffer.data())) / sizeof(R8));
+      if (!Message.Data.empty())
+         std::memcpy(Message.Data.data(), Pos,
+                     Message.Data.size() * sizeof(R8));
+      Message.OceanTask = Status.MPI_SOURCE;
+
+      Err = Handler(Message);
+      if (Err != 0) {
+         LOG_ERROR("AnalysisTasks: error handling field {} from ocean task {}",
+                   Message.Name, Message.OceanTask);
+         return Err;
+      }
+   }
+
+   return 0;
+
+} // end run
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
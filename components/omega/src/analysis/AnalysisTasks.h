@@ -0,0 +1,146 @@
+#ifndef OMEGA_ANALYSIS_TASKS_H
+#define OMEGA_ANALYSIS_TASKS_H
+//===-- analysis/AnalysisTasks.h - concurrent analysis tasks ----*- C++ -*-===//
+//
+/// \file
+/// \brief Splits the tasks into ocean and analysis subsets
+///
+/// The AnalysisTasks class divides the default machine environment into an
+/// Ocean subset that steps the model and an Analysis subset that runs
+/// in-situ analysis or I/O aggregation concurrently. Both subsets are stored
+/// as named MachEnvs. Ocean tasks copy fields into send buffers and post
+/// non-blocking sends to an assigned analysis task, so the model can keep
+/// stepping while the fields are in flight. Analysis tasks receive fields
+/// in a loop and pass each one to a handler until every ocean task that
+/// sends to them has finished.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+#include "mpi.h"
+
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// A field received by an analysis task
+struct AnalysisMessage {
+   std::string Name;     ///< name of the field
+   I8 Step;              ///< time step at which the field was sent
+   I4 OceanTask;         ///< sending task in the Ocean environment
+   std::vector<R8> Data; ///< field values
+};
+
+/// Function called by analysis tasks for each received field. A non-zero
+/// return code stops the receive loop.
+using AnalysisHandler = std::function<int(const AnalysisMessage &)>;
+
+/// The AnalysisTasks class is a static container that holds the split
+/// of the default environment into the Ocean and Analysis subsets and the
+/// communicator between them.
+class AnalysisTasks {
+
+ private:
+   /// A send that has been posted but may not have completed. The buffer
+   /// must be kept until the send completes.
+   struct PendingSend {
+      MPI_Request Request;      ///< request for the non-blocking send
+      std::vector<char> Buffer; ///< packed field
+   };
+
+   static bool Enabled;        ///< true if analysis tasks are in use
+   static bool AnalysisFlag;   ///< true if local task is an analysis task
+   static I4 NumOceanTasks;    ///< number of tasks in the Ocean env
+   static I4 NumAnalysisTasks; ///< number of tasks in the Analysis env
+   static MPI_Comm InterComm;  ///< intercommunicator between the subsets
+
+   /// Sends that have not yet completed
+   static std::list<PendingSend> Pending;
+
+   /// Number of ocean tasks that send to the local analysis task
+   static I4 numSenders();
+
+ public:
+   /// Tag for messages that carry a field
+   static constexpr int FieldTag = 7101;
+
+   /// Tag for the message that marks the end of the fields from a task
+   static constexpr int DoneTag = 7102;
+
+   /// Splits the default environment so that the last NumTasks tasks form
+   /// the Analysis environment and the rest form the Ocean environment.
+   /// If NumTasks is zero, analysis tasks are disabled and the Ocean
+   /// environment holds all tasks.
+   static int init(const I4 NumTasks ///< [in] number of analysis tasks
+   );
+
+   /// Reads the number of analysis tasks from the Analysis:NumTasks
+   /// configuration option (default 0) and splits the default environment.
+   static int init();
+
+   /// Completes outstanding sends, frees the intercommunicator and removes
+   /// the Ocean and Analysis environments
+   static void clear();
+
+   /// Determine whether analysis tasks are in use
+   static bool isEnabled();
+
+   /// Determine whether the local task is an analysis task
+   static bool isAnalysisTask();
+
+   /// Retrieve the environment of the tasks that step the ocean model
+   static MachEnv *getOceanEnv();
+
+   /// Retrieve the environment of the analysis tasks. This is a null
+   /// pointer if analysis tasks are disabled.
+   static MachEnv *getAnalysisEnv();
+
+   /// Get the analysis task to which a given ocean task sends its fields
+   static I4 getAnalysisTask(const I4 OceanTask ///< [in] ocean task
+   );
+
+   // Ocean side
+
+   /// Copies a field into a send buffer and posts a non-blocking send to
+   /// the analysis task of the local ocean task. The field array may be
+   /// modified as soon as this returns.
+   static int send(const std::string &Name, ///< [in] field name
+                   const I8 Step,           ///< [in] time step
+                   const R8 *Data,          ///< [in] field values
+                   const I8 Size            ///< [in] number of values
+   );
+
+   /// Sends a field held in a vector
+   static int send(const std::string &Name,    ///< [in] field name
+                   const I8 Step,              ///< [in] time step
+                   const std::vector<R8> &Data ///< [in] field values
+   );
+
+   /// Frees the buffers of sends that have completed without waiting
+   /// and returns the number of sends still pending
+   static I4 testSends();
+
+   /// Waits for all pending sends to complete
+   static int waitSends();
+
+   /// Waits for all pending sends and tells the analysis task that no more
+   /// fields will come from the local ocean task
+   static int finishSends();
+
+   // Analysis side
+
+   /// Receives fields and calls the handler for each one until every
+   /// ocean task assigned to the local analysis task has finished
+   static int run(const AnalysisHandler &Handler ///< [in] field handler
+   );
+
+}; // end class AnalysisTasks
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_ANALYSIS_TASKS_H
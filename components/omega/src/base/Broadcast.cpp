@@ -11,6 +11,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "Broadcast.h"
+#include "Logging.h"
+
+#include <climits>
+#include <cstring>
 
 namespace OMEGA {
 
@@ -201,4 +205,273 @@ int Broadcast(std::vector<R8> &Value, const int RankBcast) {
 //    return Broadcast(Value, MachEnv::getDefaultEnv(), RankBcast);
 //}
 
+//------------------------------------------------------------------------------
+// BroadcastPack: batched broadcast of many values
+//------------------------------------------------------------------------------
+
+namespace {
+
+// Appends raw bytes to a pack buffer
+void packBytes(std::vector<char> &Buffer, const void *Src, std::size_t NBytes) {
+   const char *Bytes = static_cast<const char *>(Src);
+   Buffer.insert(Buffer.end(), Bytes, Bytes + NBytes);
+}
+
+// Copies raw bytes out of a pack buffer and advances the offset
+void unpackBytes(const std::vector<char> &Buffer, std::size_t &Offset,
+                 void *Dst, std::size_t NBytes) {
+   if (NBytes > 0)
+      std::memcpy(Dst, Buffer.data() + Offset, NBytes);
+   Offset += NBytes;
+}
+
+// Appends a vector (or string) as its length followed by its elements
+template <class T>
+void packVector(std::vector<char> &Buffer, const T &Vec) {
+   I8 Length = Vec.size();
+   packBytes(Buffer, &Length, sizeof(I8));
+   packBytes(Buffer, Vec.data(), Length * sizeof(typename T::value_type));
+}
+
+template <class T>
+void unpackVector(const std::vector<char> &Buffer, std::size_t &Offset,
+                  T &Vec) {
+   I8 Length = 0;
+   unpackBytes(Buffer, Offset, &Length, sizeof(I8));
+   Vec.resize(Length);
+   unpackBytes(Buffer, Offset, Vec.data(),
+               Length * sizeof(typename T::value_type));
+}
+
+} // end anonymous namespace
+
+BroadcastPack::BroadcastPack(const MachEnv *InEnv, const int RankBcast)
+    : Env(InEnv), Root((RankBcast < 0) ? InEnv->getMasterTask() : RankBcast),
+      VariableSize(false), Pending(false), Request(MPI_REQUEST_NULL) {}
+
+void BroadcastPack::addEntry(ValueKind Kind, void *Ptr) {
+   Values.push_back({Kind, Ptr});
+   if (Kind >= KindString)
+      VariableSize = true;
+}
+
+void BroadcastPack::add(I4 &Value) { addEntry(KindI4, &Value); }
+void BroadcastPack::add(I8 &Value) { addEntry(KindI8, &Value); }
+void BroadcastPack::add(R4 &Value) { addEntry(KindR4, &Value); }
+void BroadcastPack::add(R8 &Value) { addEntry(KindR8, &Value); }
+void BroadcastPack::add(bool &Value) { addEntry(KindBool, &Value); }
+void BroadcastPack::add(std::string &Value) { addEntry(KindString, &Value); }
+void BroadcastPack::add(std::vector<I4> &Value) { addEntry(KindVecI4, &Value); }
+void BroadcastPack::add(std::vector<I8> &Value) { addEntry(KindVecI8, &Value); }
+void BroadcastPack::add(std::vector<R4> &Value) { addEntry(KindVecR4, &Value); }
+void BroadcastPack::add(std::vector<R8> &Value) { addEntry(KindVecR8, &Value); }
+
+int BroadcastPack::getNumValues() const { return Values.size(); }
+
+//------------------------------------------------------------------------------
+// Size of the buffer for a pack of scalars, which all tasks can compute
+I8 BroadcastPack::getFixedSize() const {
+   I8 Size = 0;
+   for (const PackEntry &Entry : Values) {
+      switch (Entry.Kind) {
+      case KindI4:
+         Size += sizeof(I4);
+         break;
+      case KindI8:
+         Size += sizeof(I8);
+         break;
+      case KindR4:
+         Size += sizeof(R4);
+         break;
+      case KindR8:
+         Size += sizeof(R8);
+         break;
+      case KindBool:
+         Size += sizeof(char);
+         break;
+      default:
+         break;
+      }
+   }
+   return Size;
+}
+
+//------------------------------------------------------------------------------
+// Serialize all values into the buffer on the root task
+void BroadcastPack::pack() {
+   Buffer.clear();
+   for (const PackEntry &Entry : Values) {
+      switch (Entry.Kind) {
+      case KindI4:
+         packBytes(Buffer, Entry.Ptr, sizeof(I4));
+         break;
+      case KindI8:
+         packBytes(Buffer, Entry.Ptr, sizeof(I8));
+         break;
+      case KindR4:
+         packBytes(Buffer, Entry.Ptr, sizeof(R4));
+         break;
+      case KindR8:
+         packBytes(Buffer, Entry.Ptr, sizeof(R8));
+         break;
+      case KindBool: {
+         char Flag = *static_cast<bool *>(Entry.Ptr) ? 1 : 0;
+         packBytes(Buffer, &Flag, sizeof(char));
+         break;
+      }
+      case KindString:
+         packVector(Buffer, *static_cast<std::string *>(Entry.Ptr));
+         break;
+      case KindVecI4:
+         packVector(Buffer, *static_cast<std::vector<I4> *>(Entry.Ptr));
+         break;
+      case KindVecI8:
+         packVector(Buffer, *static_cast<std::vector<I8> *>(Entry.Ptr));
+         break;
+      case KindVecR4:
+         packVector(Buffer, *static_cast<std::vector<R4> *>(Entry.Ptr));
+         break;
+      case KindVecR8:
+         packVector(Buffer, *static_cast<std::vector<R8> *>(Entry.Ptr));
+         break;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Copy all values out of the received buffer on the other tasks
+void BroadcastPack::unpack() {
+   std::size_t Offset = 0;
+   for (const PackEntry &Entry : Values) {
+      switch (Entry.Kind) {
+      case KindI4:
+         unpackBytes(Buffer, Offset, Entry.Ptr, sizeof(I4));
+         break;
+      case KindI8:
+         unpackBytes(Buffer, Offset, Entry.Ptr, sizeof(I8));
+         break;
+      case KindR4:
+         unpackBytes(Buffer, Offset, Entry.Ptr, sizeof(R4));
+         break;
+      case KindR8:
+         unpackBytes(Buffer, Offset, Entry.Ptr, sizeof(R8));
+         break;
+      case KindBool: {
+         char Flag = 0;
+         unpackBytes(Buffer, Offset, &Flag, sizeof(char));
+         *static_cast<bool *>(Entry.Ptr) = (Flag != 0);
+         break;
+      }
+      case KindString:
+         unpackVector(Buffer, Offset, *static_cast<std::string *>(Entry.Ptr));
+         break;
+      case KindVecI4:
+         unpackVector(Buffer, Offset,
+                      *static_cast<std::vector<I4> *>(Entry.Ptr));
+         break;
+      case KindVecI8:
+         unpackVector(Buffer, Offset,
+                      *static_cast<std::vector<I8> *>(Entry.Ptr));
+         break;
+      case KindVecR4:
+         unpackVector(Buffer, Offset,
+                      *static_cast<std::vector<R4> *>(Entry.Ptr));
+         break;
+      case KindVecR8:
+         unpackVector(Buffer, Offset,
+                      *static_cast<std::vector<R8> *>(Entry.Ptr));
+         break;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Pack the values on the root task and size the buffer on the other tasks.
+// Only packs with strings or vectors need to broadcast the size.
+int BroadcastPack::broadcastSize() {
+   const bool IsRoot = Env->getMyTask() == Root;
+   if (IsRoot)
+      pack();
+
+   I8 Size = IsRoot ? Buffer.size() : getFixedSize();
+   if (VariableSize) {
+      int Err = MPI_Bcast(&Size, 1, MPI_INT64_T, Root, Env->getComm());
+      if (Err != MPI_SUCCESS)
+         return Err;
+   }
+   if (Size > INT_MAX) {
+      LOG_ERROR("BroadcastPack: pack of {} bytes is too large", Size);
+      return MPI_ERR_COUNT;
+   }
+   if (!IsRoot)
+      Buffer.resize(Size);
+
+   return MPI_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+// Broadcast all values in the pack (blocking)
+int BroadcastPack::broadcast() {
+   if (Pending) {
+      LOG_ERROR("BroadcastPack: broadcast called while a non-blocking "
+                "broadcast is pending");
+      return MPI_ERR_REQUEST;
+   }
+
+   int Err = broadcastSize();
+   if (Err != MPI_SUCCESS)
+      return Err;
+
+   Err = MPI_Bcast(Buffer.data(), Buffer.size(), MPI_BYTE, Root,
+                   Env->getComm());
+   if (Err != MPI_SUCCESS)
+      return Err;
+
+   if (Env->getMyTask() != Root)
+      unpack();
+
+   return MPI_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+// Start a non-blocking broadcast of all values in the pack
+int BroadcastPack::start() {
+   if (Pending) {
+      LOG_ERROR("BroadcastPack: start called while a non-blocking "
+                "broadcast is pending");
+      return MPI_ERR_REQUEST;
+   }
+
+   int Err = broadcastSize();
+   if (Err != MPI_SUCCESS)
+      return Err;
+
+   Err = MPI_Ibcast(Buffer.data(), Buffer.size(), MPI_BYTE, Root,
+                    Env->getComm(), &Request);
+   if (Err != MPI_SUCCESS)
+      return Err;
+
+   Pending = true;
+   return MPI_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+// Wait for a non-blocking broadcast and unpack the values
+int BroadcastPack::finish() {
+   if (!Pending) {
+      LOG_ERROR("BroadcastPack: finish called without a pending broadcast");
+      return MPI_ERR_REQUEST;
+   }
+
+   int Err = MPI_Wait(&Request, MPI_STATUS_IGNORE);
+   Pending = false;
+   if (Err != MPI_SUCCESS)
+      return Err;
+
+   if (Env->getMyTask() != Root)
+      unpack();
+
+   return MPI_SUCCESS;
+}
+
 } // namespace OMEGA
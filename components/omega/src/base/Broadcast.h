@@ -14,6 +14,9 @@
 #include "MachEnv.h"
 #include "mpi.h"
 
+#include <string>
+#include <vector>
+
 namespace OMEGA {
 
 // blocking broadcast scalar
@@ -112,6 +115,85 @@ int Broadcast(std::vector<R8> &Value, const int RankBcast);
 // void IBroadcast(const std::vector<bool> Value, const MachEnv *InEnv, const
 // int RankBcast = -1);
 
+// batched broadcast of many values
+
+/// A BroadcastPack collects references to many values of mixed types,
+/// serializes them on the root task into a single buffer and broadcasts that
+/// buffer, so that a module can broadcast all of its parameters with one or
+/// two MPI calls instead of one call per value. A pack containing only
+/// scalars needs a single broadcast. Strings and vectors have sizes unknown
+/// on the receiving tasks, so their packs broadcast the buffer size first.
+/// The added variables must remain valid until the broadcast completes.
+class BroadcastPack {
+
+ public:
+   /// Creates an empty pack for broadcasting within an environment
+   BroadcastPack(const MachEnv *InEnv = MachEnv::getDefaultEnv(),
+                 const int RankBcast  = -1);
+
+   /// Adds a value to the pack. Values are sent from the root task and
+   /// overwritten on all other tasks.
+   void add(I4 &Value);
+   void add(I8 &Value);
+   void add(R4 &Value);
+   void add(R8 &Value);
+   void add(bool &Value);
+   void add(std::string &Value);
+   void add(std::vector<I4> &Value);
+   void add(std::vector<I8> &Value);
+   void add(std::vector<R4> &Value);
+   void add(std::vector<R8> &Value);
+
+   /// Returns the number of values in the pack
+   int getNumValues() const;
+
+   /// Broadcasts all values in the pack (blocking)
+   int broadcast();
+
+   /// Starts a non-blocking broadcast of all values using MPI_Ibcast. For
+   /// packs with strings or vectors, the buffer size is broadcast first with
+   /// a blocking call. The values must not be accessed until finish.
+   int start();
+
+   /// Waits for a broadcast started by start and unpacks the values
+   int finish();
+
+ private:
+   /// Kinds of values that can be packed
+   enum ValueKind {
+      KindI4,
+      KindI8,
+      KindR4,
+      KindR8,
+      KindBool,
+      KindString,
+      KindVecI4,
+      KindVecI8,
+      KindVecR4,
+      KindVecR8
+   };
+
+   struct PackEntry {
+      ValueKind Kind;
+      void *Ptr;
+   };
+
+   const MachEnv *Env;            ///< environment for the broadcast
+   int Root;                      ///< task broadcasting the values
+   bool VariableSize;             ///< true if pack has strings or vectors
+   bool Pending;                  ///< true between start and finish
+   MPI_Request Request;           ///< request for non-blocking broadcast
+   std::vector<PackEntry> Values; ///< values in order of addition
+   std::vector<char> Buffer;      ///< serialized values
+
+   void addEntry(ValueKind Kind, void *Ptr);
+   I8 getFixedSize() const;
+   void pack();
+   void unpack();
+   int broadcastSize();
+
+}; // end class BroadcastPack
+
 } // namespace OMEGA
 
 #endif // OMEGA_BROADCAST_H
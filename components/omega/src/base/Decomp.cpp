@@ -15,17 +15,23 @@
 //===----------------------------------------------------------------------===//
 
 #include "Decomp.h"
+#include "Config.h"
 #include "DataTypes.h"
 #include "IO.h"
 #include "Logging.h"
 #include "MachEnv.h"
+#include "MemoryTracker.h"
 #include "OmegaKokkos.h"
+#include "Snapshot.h"
 #include "mpi.h"
 #include "parmetis.h"
 
 #include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace OMEGA {
@@ -37,7 +43,7 @@ std::map<std::string, Decomp> Decomp::AllDecomps;
 // Some useful local utility routines
 //------------------------------------------------------------------------------
 // checks a global cell/edge/vertex ID value to see if it is within range.
-// The readMesh function must have been called to define global sizes before
+// The readMeshSizes function must have been called to define global sizes before
 // calling any of these.
 
 bool Decomp::validCellID(I4 InCellID) {
@@ -51,86 +57,303 @@ bool Decomp::validVertexID(I4 InVertexID) {
 }
 
 //------------------------------------------------------------------------------
-// Local routine that searches a std::vector<I4> for a particular entry and
-// returns the index of that entry. If not found, the size is returned
-// (corresponding to the last index + 1)
+// Local routine that returns the (global ID, local index) pairs of the first
+// NLocal entries of a global ID array, sorted by global ID. It is used with
+// findLocalIndex to locate many global IDs with binary searches rather than
+// a linear search of the ID array for each.
 
-I4 srchVector(const std::vector<I4> &InVector, // vector to search
-              I4 Value                         // value to search for
-) {
+std::vector<std::pair<I4, I4>> sortLocalIDs(const HostArray1DI4 &IDs,
+                                            I4 NLocal) {
 
-   // first use the std::find routine to determine the iterator location
-   auto it = std::find(InVector.begin(), InVector.end(), Value);
-   // now translate the iterator into an actual vector index
-   I4 LocIndx = std::distance(InVector.begin(), it);
+   std::vector<std::pair<I4, I4>> Keys(NLocal);
+   for (int Local = 0; Local < NLocal; ++Local)
+      Keys[Local] = {IDs(Local), Local};
+   std::sort(Keys.begin(), Keys.end());
 
-   return LocIndx;
+   return Keys;
 
-} // end function srchVector (std::vector)
+} // end function sortLocalIDs
 
 //------------------------------------------------------------------------------
-// A search routine for vectors in which the vector is a Kokkos array rather
-// than a std::vector. It searches for a value and returns the first index of
-// that // entry. If not found, the size is returned (corresponding to the
-// last index + 1)
+// Local routine that searches the sorted keys from sortLocalIDs for a global
+// ID and returns its local index. If not found, NotFound is returned.
 
-I4 srchVector(HostArray1DI4 InVector, // vector to search
-              I4 Value                // value to search for
-) {
+I4 findLocalIndex(const std::vector<std::pair<I4, I4>> &Keys, I4 GlobalID,
+                  I4 NotFound) {
 
-   // extract the vector length
-   // I4 VecSize  = InVector.totElems();
-   I4 VecSize  = InVector.size();
-   I4 LocIndex = VecSize; // set default to size (return value if not found)
+   auto It = std::lower_bound(
+       Keys.begin(), Keys.end(), GlobalID,
+       [](const std::pair<I4, I4> &Key, I4 ID) { return Key.first < ID; });
+   if (It != Keys.end() && It->first == GlobalID)
+      return It->second;
 
-   // Loop over elements, searching for Value
-   for (int n = 0; n < VecSize; ++n) {
-      if (InVector(n) == Value) { // found value
-         LocIndex = n;
-         break;
+   return NotFound;
+
+} // end function findLocalIndex
+
+//------------------------------------------------------------------------------
+// Local routine that runs a loop over N independent iterations in parallel
+// on the host execution space and waits for it to complete.
+
+template <class F>
+void hostParallelFor(const std::string &Label, I4 N, const F &Fn) {
+
+   Kokkos::parallel_for(Label, Kokkos::RangePolicy<HostExecSpace>(0, N), Fn);
+   HostExecSpace().fence();
+
+} // end function hostParallelFor
+
+//------------------------------------------------------------------------------
+// Computes the local address of every cell within the task that owns it using
+// a reverse Cuthill-McKee (RCM) ordering of the cells owned by each task.
+// Each task is ordered with a breadth-first traversal of the adjacency graph
+// restricted to that task, starting from a cell of minimum degree and visiting
+// neighbors in order of increasing degree. The traversal order is then
+// reversed. Neighboring cells end up close together in the local index space,
+// which improves cache reuse for the indirect accesses in the stencils. The
+// ordering only depends on global data so all tasks compute the same location
+// for every cell.
+
+void orderCellsRCM(
+    I4 NCellsGlobal,                     // total number of cells
+    I4 NumTasks,                         // number of tasks (partitions)
+    const std::vector<idx_t> &AdjAdd,    // start address of nbrs in Adjacency
+    const std::vector<idx_t> &Adjacency, // 0-based nbr cells in packed form
+    const std::vector<idx_t> &CellTask,  // task assigned to each cell
+    std::vector<I4> &CellLocalAdd        // [out] local address of each cell
+) {
+
+   // Compute the degree of each cell in the graph of its own partition
+   std::vector<I4> Degree(NCellsGlobal, 0);
+   for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+      for (int Nbr = AdjAdd[Cell]; Nbr < AdjAdd[Cell + 1]; ++Nbr) {
+         if (CellTask[Adjacency[Nbr]] == CellTask[Cell])
+            ++Degree[Cell];
       }
    }
+   auto LowerDegree = [&Degree](I4 Cell1, I4 Cell2) {
+      return Degree[Cell1] < Degree[Cell2];
+   };
+
+   // Sort the cells on each task by degree to select the starting cell
+   // of each connected component. The stable sort retains the cell ID
+   // order for cells with equal degree.
+   std::vector<std::vector<I4>> TaskCells(NumTasks);
+   for (int Cell = 0; Cell < NCellsGlobal; ++Cell)
+      TaskCells[CellTask[Cell]].push_back(Cell);
+
+   std::vector<bool> Visited(NCellsGlobal, false);
+   std::vector<I4> Queue;
+   std::vector<I4> Nbrs;
+   for (int Task = 0; Task < NumTasks; ++Task) {
+      std::vector<I4> &Starts = TaskCells[Task];
+      std::stable_sort(Starts.begin(), Starts.end(), LowerDegree);
+
+      // Breadth-first traversal of each connected component, the queue
+      // also holds the Cuthill-McKee order of the cells
+      Queue.clear();
+      for (I4 Start : Starts) {
+         if (Visited[Start])
+            continue;
+         Visited[Start] = true;
+         Queue.push_back(Start);
+         for (size_t Head = Queue.size() - 1; Head < Queue.size(); ++Head) {
+            I4 Cell = Queue[Head];
+            Nbrs.clear();
+            for (int Nbr = AdjAdd[Cell]; Nbr < AdjAdd[Cell + 1]; ++Nbr) {
+               I4 NbrCell = Adjacency[Nbr];
+               if (CellTask[NbrCell] == Task && !Visited[NbrCell]) {
+                  Visited[NbrCell] = true;
+                  Nbrs.push_back(NbrCell);
+               }
+            }
+            std::stable_sort(Nbrs.begin(), Nbrs.end(), LowerDegree);
+            Queue.insert(Queue.end(), Nbrs.begin(), Nbrs.end());
+         }
+      }
 
-   return LocIndex;
+      // Reverse the order to obtain the local address of each cell
+      I4 NCellsTask = Queue.size();
+      for (int n = 0; n < NCellsTask; ++n)
+         CellLocalAdd[Queue[n]] = NCellsTask - 1 - n;
+   }
 
-} // end function srchVector (Kokkos)
+} // end function orderCellsRCM
+
+//------------------------------------------------------------------------------
+// Exchanges variable-length lists of integer values between all tasks.
+// The send buffer contains the values for each destination task in task
+// order, with SendCount values for each task. On return, the receive buffer
+// contains the values sent to this task, ordered by source task, with
+// RecvCount values from each task.
+
+int exchangeLists(const std::vector<I4> &SendBuf,   // values to send
+                  const std::vector<I4> &SendCount, // num values per task
+                  std::vector<I4> &RecvBuf,         // [out] values received
+                  std::vector<I4> &RecvCount,       // [out] num recvd per task
+                  MPI_Comm Comm                     // communicator to use
+) {
+
+   int Err     = 0;
+   I4 NumTasks = SendCount.size();
+   RecvCount.resize(NumTasks);
+
+   // Each task first needs to know how many values it will receive
+   Err = MPI_Alltoall(SendCount.data(), 1, MPI_INT32_T, RecvCount.data(), 1,
+                      MPI_INT32_T, Comm);
+   if (Err != 0)
+      return Err;
+
+   std::vector<int> SendDispl(NumTasks, 0);
+   std::vector<int> RecvDispl(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task) {
+      SendDispl[Task] = SendDispl[Task - 1] + SendCount[Task - 1];
+      RecvDispl[Task] = RecvDispl[Task - 1] + RecvCount[Task - 1];
+   }
+   RecvBuf.resize(RecvDispl[NumTasks - 1] + RecvCount[NumTasks - 1]);
+
+   Err = MPI_Alltoallv(SendBuf.data(), SendCount.data(), SendDispl.data(),
+                       MPI_INT32_T, RecvBuf.data(), RecvCount.data(),
+                       RecvDispl.data(), MPI_INT32_T, Comm);
+
+   return Err;
+
+} // end function exchangeLists
 
-// Routines needed for creating the decomposition
 //------------------------------------------------------------------------------
-// Reads mesh adjacency, index and size information from a file. This includes
-// all neighbor information and connections between cells, edges, vertices.
-// These are initially read into a uniform linear distribution across MPI tasks
-// and redistributed later after the decomposition is complete.
-
-int readMesh(const int MeshFileID, // file ID for open mesh file
-             const MachEnv *InEnv, // input machine environment for MPI layout
-             I4 &NCellsGlobal,     // total number of cells
-             I4 &NEdgesGlobal,     // total number of edges
-             I4 &NVerticesGlobal,  // total number of vertices
-             I4 &MaxEdges,         // max number of edges on a cell
-             I4 &MaxCellsOnEdge,   // max number of cells sharing edge
-             I4 &VertexDegree,     // number of cells/edges sharing vrtx
-             std::vector<I4> &CellsOnCellInit, // cell neighbors for each cell
-             std::vector<I4> &EdgesOnCellInit, // edge IDs for each cell edge
-             std::vector<I4> &VerticesOnCellInit, // vertices around each cell
-             std::vector<I4> &CellsOnEdgeInit,    // cell IDs sharing edge
-             std::vector<I4> &EdgesOnEdgeInit,    // all edges neighboring edge
-             std::vector<I4> &VerticesOnEdgeInit, // vertices on ends of edge
-             std::vector<I4> &CellsOnVertexInit,  // cells meeting at each vrtx
-             std::vector<I4> &EdgesOnVertexInit   // edges meeting at each vrtx
+// Partitions the global cell adjacency graph in two levels using the node
+// layout of the input MachEnv. The cells are first partitioned among nodes,
+// with a share of the cells proportional to the number of tasks on each node,
+// and the cells on each node are then partitioned among the tasks on that
+// node. This keeps most of the halo communication within a node and reduces
+// the halo surface between nodes. On return, CellTask contains the task
+// assigned to each cell.
+
+int partGraphByNode(const MachEnv *InEnv,           // env with node info
+                    idx_t NCells,                   // num cells in graph
+                    idx_t NConstraints,             // num balance constraints
+                    std::vector<idx_t> &AdjAdd,     // start addr of cell nbrs
+                    std::vector<idx_t> &Adjacency,  // nbrs of each cell
+                    idx_t *VrtxWgtPtr,              // cell weights or null
+                    std::vector<idx_t> &CellTask    // [out] task for each cell
 ) {
 
    int Err = 0;
 
-   // Retrieve some info on the MPI layout
-   MPI_Comm Comm = InEnv->getComm();
-   I4 NumTasks   = InEnv->getNumTasks();
-   I4 MyTask     = InEnv->getMyTask();
-   I4 MasterTask = InEnv->getMasterTask();
-   bool IsMaster = InEnv->isMasterTask();
+   MPI_Comm Comm  = InEnv->getComm();
+   I4 NumTasks    = InEnv->getNumTasks();
+   I4 MyNode      = InEnv->getMyNode();
+   idx_t NumNodes = InEnv->getNumNodes();
+   idx_t *Options = nullptr; // use default metis options
+   idx_t Edgecut  = 0;
+   int MetisErr   = METIS_OK;
+
+   // Gather the node of every task and list the tasks on each node in
+   // task order
+   std::vector<I4> TaskNode(NumTasks);
+   Err = MPI_Allgather(&MyNode, 1, MPI_INT32_T, TaskNode.data(), 1,
+                       MPI_INT32_T, Comm);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: Error gathering node layout of tasks");
+      return Err;
+   }
+   std::vector<std::vector<idx_t>> NodeTasks(NumNodes);
+   for (int Task = 0; Task < NumTasks; ++Task)
+      NodeTasks[TaskNode[Task]].push_back(Task);
+
+   // Partition the cells among the nodes
+   std::vector<idx_t> CellNode(NCells, 0);
+   if (NumNodes > 1) {
+      std::vector<real_t> TpWgts(NumNodes * NConstraints);
+      for (int Node = 0; Node < NumNodes; ++Node) {
+         for (int Con = 0; Con < NConstraints; ++Con)
+            TpWgts[Node * NConstraints + Con] =
+                real_t(NodeTasks[Node].size()) / NumTasks;
+      }
+      MetisErr = METIS_PartGraphKway(
+          &NCells, &NConstraints, AdjAdd.data(), Adjacency.data(), VrtxWgtPtr,
+          nullptr, nullptr, &NumNodes, TpWgts.data(), nullptr, Options,
+          &Edgecut, CellNode.data());
+      if (MetisErr != METIS_OK) {
+         LOG_ERROR("Decomp: Error in METIS partition across nodes");
+         return -1;
+      }
+   }
+
+   // Partition the cells on each node among the tasks on that node using
+   // the subgraph of cells assigned to the node
+   std::vector<idx_t> SubAdd(NCells, 0); // address of each cell in subgraph
+   for (int Node = 0; Node < NumNodes; ++Node) {
+
+      std::vector<idx_t> SubCells; // graph address of each subgraph cell
+      for (int Cell = 0; Cell < NCells; ++Cell) {
+         if (CellNode[Cell] == Node) {
+            SubAdd[Cell] = SubCells.size();
+            SubCells.push_back(Cell);
+         }
+      }
+      idx_t NSubCells = SubCells.size();
+      idx_t NSubParts = NodeTasks[Node].size();
+      std::vector<idx_t> SubPart(NSubCells, 0);
+
+      if (NSubParts > 1 && NSubCells > 0) {
+
+         // Create the subgraph keeping only neighbors on the same node
+         std::vector<idx_t> SubAdjAdd(NSubCells + 1, 0);
+         std::vector<idx_t> SubAdjacency;
+         std::vector<idx_t> SubWgts;
+         for (int n = 0; n < NSubCells; ++n) {
+            I4 Cell      = SubCells[n];
+            SubAdjAdd[n] = SubAdjacency.size();
+            for (int Nbr = AdjAdd[Cell]; Nbr < AdjAdd[Cell + 1]; ++Nbr) {
+               if (CellNode[Adjacency[Nbr]] == Node)
+                  SubAdjacency.push_back(SubAdd[Adjacency[Nbr]]);
+            }
+            if (VrtxWgtPtr != nullptr) {
+               for (int Con = 0; Con < NConstraints; ++Con)
+                  SubWgts.push_back(VrtxWgtPtr[Cell * NConstraints + Con]);
+            }
+         }
+         SubAdjAdd[NSubCells] = SubAdjacency.size();
+         // METIS expects a valid pointer even for a graph with no edges
+         if (SubAdjacency.empty())
+            SubAdjacency.push_back(0);
+         idx_t *SubWgtPtr = SubWgts.empty() ? nullptr : SubWgts.data();
+
+         MetisErr = METIS_PartGraphKway(
+             &NSubCells, &NConstraints, SubAdjAdd.data(), SubAdjacency.data(),
+             SubWgtPtr, nullptr, nullptr, &NSubParts, nullptr, nullptr,
+             Options, &Edgecut, SubPart.data());
+         if (MetisErr != METIS_OK) {
+            LOG_ERROR("Decomp: Error in METIS partition within node {}", Node);
+            return -1;
+         }
+      }
+
+      // Convert the partition within the node to the global task
+      for (int n = 0; n < NSubCells; ++n)
+         CellTask[SubCells[n]] = NodeTasks[Node][SubPart[n]];
+
+   } // end loop over nodes
+
+   return Err;
+
+} // end function partGraphByNode
+
+// Routines needed for creating the decomposition
+//------------------------------------------------------------------------------
+// Reads the mesh sizes from a file. These are dimension lengths in the input
+// mesh file.
+
+int readMeshSizes(const int MeshFileID, // file ID for open mesh file
+                  I4 &NCellsGlobal,     // total number of cells
+                  I4 &NEdgesGlobal,     // total number of edges
+                  I4 &NVerticesGlobal,  // total number of vertices
+                  I4 &MaxEdges,         // max number of edges on a cell
+                  I4 &MaxCellsOnEdge,   // max number of cells sharing edge
+                  I4 &VertexDegree      // number of cells/edges sharing vrtx
+) {
 
-   // Read in mesh size information - these are dimension lengths in
-   // the input mesh file
    NCellsGlobal = IO::getDimLength(MeshFileID, "nCells");
    if (NCellsGlobal <= 0)
       LOG_CRITICAL("Decomp: error reading nCells");
@@ -146,190 +369,211 @@ int readMesh(const int MeshFileID, // file ID for open mesh file
    VertexDegree = IO::getDimLength(MeshFileID, "vertexDegree");
    if (VertexDegree <= 0)
       LOG_CRITICAL("Decomp: error reading VertexDegree");
-   MaxCellsOnEdge    = 2;            // currently always 2
-   I4 MaxEdgesOnEdge = 2 * MaxEdges; // 2*MaxCellsOnEdge
+   MaxCellsOnEdge = 2; // currently always 2
 
-   // Create the linear decompositions for parallel IO
-   // Determine the size of each block, divided as evenly as possible
-   I4 NCellsChunk    = (NCellsGlobal - 1) / NumTasks + 1;
-   I4 NEdgesChunk    = (NEdgesGlobal - 1) / NumTasks + 1;
-   I4 NVerticesChunk = (NVerticesGlobal - 1) / NumTasks + 1;
+   return 0;
 
-   // If global size did not divide evenly over processors, the last processor
-   // only has the remaining indices and not a full block (chunk)
-   I4 NCellsLocal;
-   I4 NEdgesLocal;
-   I4 NVerticesLocal;
-   if (MyTask < NumTasks - 1) {
-      NCellsLocal    = NCellsChunk;
-      NEdgesLocal    = NEdgesChunk;
-      NVerticesLocal = NVerticesChunk;
-   } else { // last MPI task
-      I4 StartAdd    = NCellsChunk * (NumTasks - 1);
-      NCellsLocal    = NCellsGlobal - StartAdd;
-      StartAdd       = NEdgesChunk * (NumTasks - 1);
-      NEdgesLocal    = NEdgesGlobal - StartAdd;
-      StartAdd       = NVerticesChunk * (NumTasks - 1);
-      NVerticesLocal = NVerticesGlobal - StartAdd;
-   }
+} // end readMeshSizes
 
-   // Define offset index for each array (essentially the global index)
-   // for the parallel IO decomposition. The XxOnCell arrays are all the
-   // same size and decomposition
+//------------------------------------------------------------------------------
+// Reads one mesh adjacency array with NGlobal rows of Width entries (eg
+// cellsOnCell) from a file into a uniform linear distribution across MPI
+// tasks, to be redistributed later after the decomposition is complete.
+// The arrays are read one at a time just before they are needed, so that
+// only a few of them are held in the linear distribution at once. The
+// offsets in the IO decomposition are 64-bit since the product of the
+// global ID and width can exceed the 32-bit range on large meshes.
+
+int readMeshArray(const int MeshFileID,       // file ID for open mesh file
+                  const MachEnv *InEnv,       // machine env for MPI layout
+                  const std::string &VarName, // name of array in mesh file
+                  I4 NGlobal,                 // number of rows (elements)
+                  I4 Width,                   // entries in each row
+                  std::vector<I4> &ArrayInit  // [out] array in linear distrb
+) {
 
-   I4 OnCellSize = NCellsChunk * MaxEdges;
-   I4 NDims      = 2;
-   std::vector<I4> OnCellDims{NCellsGlobal, MaxEdges};
-   std::vector<I4> OnCellOffset(OnCellSize, -1);
-   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
-      I4 CellGlob = MyTask * NCellsChunk + Cell;
-      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
-         OnCellOffset[Cell * MaxEdges + Edge] = CellGlob * MaxEdges + Edge;
-      }
-   }
+   int Err = 0;
 
-   // Now we do the same for XXOnEdge and XXOnVertex arrays
-   // The EdgesOnEdge is a different size so needs its own
-   I4 OnEdgeSize   = NEdgesChunk * MaxCellsOnEdge;
-   I4 OnEdgeSize2  = NEdgesChunk * MaxEdgesOnEdge;
-   I4 OnVertexSize = NVerticesChunk * VertexDegree;
-   std::vector<I4> OnEdgeDims{NEdgesGlobal, MaxCellsOnEdge};
-   std::vector<I4> OnEdgeDims2{NEdgesGlobal, MaxEdgesOnEdge};
-   std::vector<I4> OnVertexDims{NVerticesGlobal, VertexDegree};
-   std::vector<I4> OnEdgeOffset(OnEdgeSize, -1);
-   std::vector<I4> OnEdgeOffset2(OnEdgeSize2, -1);
-   std::vector<I4> OnVertexOffset(OnVertexSize, -1);
-   for (int Edge = 0; Edge < NEdgesLocal; ++Edge) {
-      I4 EdgeGlob = MyTask * NEdgesChunk + Edge;
-      for (int Cell = 0; Cell < MaxCellsOnEdge; ++Cell) {
-         OnEdgeOffset[Edge * MaxCellsOnEdge + Cell] =
-             EdgeGlob * MaxCellsOnEdge + Cell;
-      }
-      for (int Cell = 0; Cell < MaxEdgesOnEdge; ++Cell) {
-         OnEdgeOffset2[Edge * MaxEdgesOnEdge + Cell] =
-             EdgeGlob * MaxEdgesOnEdge + Cell;
-      }
+   I4 NumTasks = InEnv->getNumTasks();
+   I4 MyTask   = InEnv->getMyTask();
+
+   // Size of each block, divided as evenly as possible. If the global size
+   // does not divide evenly, the last task only has the remaining rows.
+   I4 NChunk = (NGlobal - 1) / NumTasks + 1;
+   I4 Start  = std::min(MyTask * NChunk, NGlobal);
+   I4 NLocal = std::min(Start + NChunk, NGlobal) - Start;
+
+   // Offset of each local entry (essentially the global index) for the
+   // parallel IO decomposition
+   I4 Size = NChunk * Width;
+   std::vector<I4> Dims{NGlobal, Width};
+   std::vector<I8> Offset(Size, -1);
+   for (int Row = 0; Row < NLocal; ++Row) {
+      const I8 RowGlob = static_cast<I8>(Start + Row) * Width;
+      for (int Col = 0; Col < Width; ++Col)
+         Offset[Row * Width + Col] = RowGlob + Col;
    }
-   for (int Vrtx = 0; Vrtx < NVerticesLocal; ++Vrtx) {
-      I4 VertexGlob = MyTask * NVerticesChunk + Vrtx;
-      for (int Cell = 0; Cell < VertexDegree; ++Cell) {
-         OnVertexOffset[Vrtx * VertexDegree + Cell] =
-             VertexGlob * VertexDegree + Cell;
-      } // end loop VertexDegree
-   } // end loop NVerticesLocal
 
-   // Create the parallel IO decompositions
-   IO::Rearranger Rearr = IO::RearrBox;
-   I4 OnCellDecomp;
-   I4 OnEdgeDecomp;
-   I4 OnEdgeDecomp2;
-   I4 OnVertexDecomp;
-   Err = IO::createDecomp(OnCellDecomp, IO::IOTypeI4, NDims, OnCellDims,
-                          OnCellSize, OnCellOffset, Rearr);
+   I4 ArrayDecomp;
+   Err = IO::createDecomp(ArrayDecomp, IO::IOTypeI4, 2, Dims, Size, Offset,
+                          IO::RearrBox);
    if (Err != 0)
-      LOG_CRITICAL("Decomp: error creating OnCell IO decomposition");
-   Err = IO::createDecomp(OnEdgeDecomp, IO::IOTypeI4, NDims, OnEdgeDims,
-                          OnEdgeSize, OnEdgeOffset, Rearr);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error creating OnEdge IO decomposition");
-   Err = IO::createDecomp(OnEdgeDecomp2, IO::IOTypeI4, NDims, OnEdgeDims2,
-                          OnEdgeSize2, OnEdgeOffset2, Rearr);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error creating OnEdg2 IO decomposition");
-   Err = IO::createDecomp(OnVertexDecomp, IO::IOTypeI4, NDims, OnVertexDims,
-                          OnVertexSize, OnVertexOffset, Rearr);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error creating Vertex IO decomposition");
-
-   // Now read the connectivity arrays
-   CellsOnCellInit.resize(OnCellSize);
-   EdgesOnCellInit.resize(OnCellSize);
-   VerticesOnCellInit.resize(OnCellSize);
-   CellsOnEdgeInit.resize(OnEdgeSize);
-   EdgesOnEdgeInit.resize(OnEdgeSize2);
-   VerticesOnEdgeInit.resize(OnEdgeSize);
-   CellsOnVertexInit.resize(OnVertexSize);
-   EdgesOnVertexInit.resize(OnVertexSize);
-
-   int CellsOnCellID;
-   Err = IO::readArray(&CellsOnCellInit[0], OnCellSize, "cellsOnCell",
-                       MeshFileID, OnCellDecomp, CellsOnCellID);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error reading CellsOnCell");
+      LOG_CRITICAL("Decomp: error creating {} IO decomposition", VarName);
 
-   int EdgesOnCellID;
-   Err = IO::readArray(&EdgesOnCellInit[0], OnCellSize, "edgesOnCell",
-                       MeshFileID, OnCellDecomp, EdgesOnCellID);
+   ArrayInit.resize(Size);
+   int VarID;
+   Err = IO::readArray(&ArrayInit[0], Size, VarName, MeshFileID, ArrayDecomp,
+                       VarID);
    if (Err != 0)
-      LOG_CRITICAL("Decomp: error reading EdgesOnCell");
+      LOG_CRITICAL("Decomp: error reading {}", VarName);
 
-   int VerticesOnCellID;
-   Err = IO::readArray(&VerticesOnCellInit[0], OnCellSize, "verticesOnCell",
-                       MeshFileID, OnCellDecomp, VerticesOnCellID);
+   // The decomposition is no longer needed so remove it now
+   Err = IO::destroyDecomp(ArrayDecomp);
    if (Err != 0)
-      LOG_CRITICAL("Decomp: error reading VerticesOnCell");
+      LOG_ERROR("Decomp: error destroying {} decomposition", VarName);
 
-   int CellsOnEdgeID;
-   Err = IO::readArray(&CellsOnEdgeInit[0], OnEdgeSize, "cellsOnEdge",
-                       MeshFileID, OnEdgeDecomp, CellsOnEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error reading CellsOnEdge");
+   return Err;
 
-   int EdgesOnEdgeID;
-   Err = IO::readArray(&EdgesOnEdgeInit[0], OnEdgeSize2, "edgesOnEdge",
-                       MeshFileID, OnEdgeDecomp2, EdgesOnEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error reading EdgesOnEdge");
+} // end readMeshArray
 
-   int VerticesOnEdgeID;
-   Err = IO::readArray(&VerticesOnEdgeInit[0], OnEdgeSize, "verticesOnEdge",
-                       MeshFileID, OnEdgeDecomp, VerticesOnEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error reading VerticesOnEdge");
+//------------------------------------------------------------------------------
+// Releases the memory of an array in the initial linear distribution once it
+// has been redistributed
 
-   int CellsOnVertexID;
-   Err = IO::readArray(&CellsOnVertexInit[0], OnVertexSize, "cellsOnVertex",
-                       MeshFileID, OnVertexDecomp, CellsOnVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error reading CellsOnVertex");
+void freeMeshArray(std::vector<I4> &ArrayInit // [inout] array to release
+) {
+   std::vector<I4>().swap(ArrayInit);
+}
 
-   int EdgesOnVertexID;
-   Err = IO::readArray(&EdgesOnVertexInit[0], OnVertexSize, "edgesOnVertex",
-                       MeshFileID, OnVertexDecomp, EdgesOnVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error reading EdgesOnVertex");
+//------------------------------------------------------------------------------
+// Reads integer cell fields (eg maxLevelCell) from the mesh file into the
+// initial linear distribution for use as weights in the partitioning. Each
+// field is a separate balancing constraint. The weights are stored with
+// all the constraints of a cell contiguous, as expected by METIS/ParMETIS.
+// Negative values are not allowed by METIS and are set to zero.
+
+int readCellWeights(
+    const int MeshFileID, // file ID for open mesh file
+    const MachEnv *InEnv, // input machine environment for MPI layout
+    I4 NCellsGlobal,      // total number of cells
+    const std::vector<std::string> &CellWeightNames, // fields for weights
+    std::vector<I4> &CellWeightsInit // [out] weights for each cell
+) {
 
-   // Initial decompositions are no longer needed so remove them now
-   Err = IO::destroyDecomp(OnCellDecomp);
-   if (Err != 0)
-      LOG_ERROR("Decomp: error destroying OnCell decomposition");
-   Err = IO::destroyDecomp(OnEdgeDecomp);
-   if (Err != 0)
-      LOG_ERROR("Decomp: error destroying OnEdge decomposition");
-   Err = IO::destroyDecomp(OnEdgeDecomp2);
-   if (Err != 0)
-      LOG_ERROR("Decomp: error destroying OnEdge2 decomposition");
-   Err = IO::destroyDecomp(OnVertexDecomp);
-   if (Err != 0)
-      LOG_ERROR("Decomp: error destroying OnVertex decomposition");
+   int Err = 0;
+
+   // Retrieve some info on the MPI layout
+   I4 NumTasks = InEnv->getNumTasks();
+   I4 MyTask   = InEnv->getMyTask();
+
+   // Use the same linear distribution as the connectivity arrays
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   I4 CellStart   = std::min(MyTask * NCellsChunk, NCellsGlobal);
+   I4 NCellsLocal = std::min(CellStart + NCellsChunk, NCellsGlobal) - CellStart;
+
+   I4 NDims = 1;
+   std::vector<I4> CellDims{NCellsGlobal};
+   std::vector<I4> CellOffset(NCellsChunk, -1);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell)
+      CellOffset[Cell] = CellStart + Cell;
+
+   IO::Rearranger Rearr = IO::RearrBox;
+   I4 CellDecomp;
+   Err = IO::createDecomp(CellDecomp, IO::IOTypeI4, NDims, CellDims,
+                          NCellsChunk, CellOffset, Rearr);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error creating cell weight IO decomposition");
+      return Err;
+   }
+
+   I4 NWeights = CellWeightNames.size();
+   CellWeightsInit.resize(NCellsChunk * NWeights);
+   std::vector<I4> WeightBuf(NCellsChunk, 0);
+   for (int Wgt = 0; Wgt < NWeights; ++Wgt) {
+      int WeightID;
+      Err = IO::readArray(&WeightBuf[0], NCellsChunk, CellWeightNames[Wgt],
+                          MeshFileID, CellDecomp, WeightID);
+      if (Err != 0) {
+         LOG_ERROR("Decomp: error reading cell weight {}",
+                   CellWeightNames[Wgt]);
+         break;
+      }
+      for (int Cell = 0; Cell < NCellsChunk; ++Cell)
+         CellWeightsInit[Cell * NWeights + Wgt] = std::max(WeightBuf[Cell], 0);
+   }
+
+   int DestroyErr = IO::destroyDecomp(CellDecomp);
+   if (DestroyErr != 0)
+      LOG_ERROR("Decomp: error destroying cell weight decomposition");
 
    return Err;
 
-} // end readMesh
+} // end readCellWeights
 
 //------------------------------------------------------------------------------
 // Initialize the decomposition and create the default decomposition with
-// (currently) one partition per MPI task using a ParMetis KWay method.
+// (currently) one partition per MPI task, using the options in the Decomp
+// group of the configuration.
 
 int Decomp::init(const std::string &MeshFileName) {
 
    int Err = 0; // default successful return code
 
-   // TODO: retrieve from Config when available - currently hardwired
-   // Initialize decomposition options
-   I4 InHaloWidth           = 3;
-   std::string DecompMethod = "MetisKWay";
-   PartMethod Method        = getPartMethodFromStr(DecompMethod);
+   // Default decomposition options, replaced by those in the Decomp group
+   // of the configuration if present
+   I4 InHaloWidth             = 3;
+   std::string InMeshFileName = MeshFileName;
+   std::string DecompMethod   = "MetisKWay";
+   std::string CellOrdering   = "Natural";
+   // Optionally save and reuse the cell partition in a file named after the
+   // mesh file and the number of partitions
+   bool UsePartFile = false;
+   // Integer cell fields in the mesh file used to weight the partition,
+   // eg maxLevelCell to balance the number of active cells in each column.
+   // An empty list gives every cell the same weight.
+   std::vector<std::string> CellWeightNames;
+   // Optionally save and reuse binary snapshots of the initialized
+   // decomposition, halo and mesh on each task, named after the mesh file
+   bool UseSnapshot = false;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("Decomp")) {
+      Config DecompConfig("Decomp");
+      Err = OmegaConfig->get(DecompConfig);
+      if (Err != 0) {
+         LOG_ERROR("Decomp: error retrieving Decomp configuration");
+         return Err;
+      }
+      if (DecompConfig.existsVar("HaloWidth"))
+         Err += DecompConfig.get("HaloWidth", InHaloWidth);
+      if (DecompConfig.existsVar("MeshFileName"))
+         Err += DecompConfig.get("MeshFileName", InMeshFileName);
+      if (DecompConfig.existsVar("DecompMethod"))
+         Err += DecompConfig.get("DecompMethod", DecompMethod);
+      if (DecompConfig.existsVar("CellOrdering"))
+         Err += DecompConfig.get("CellOrdering", CellOrdering);
+      if (DecompConfig.existsVar("UsePartFile"))
+         Err += DecompConfig.get("UsePartFile", UsePartFile);
+      if (DecompConfig.existsVar("UseSnapshot"))
+         Err += DecompConfig.get("UseSnapshot", UseSnapshot);
+      if (DecompConfig.existsVar("CellWeights"))
+         Err += DecompConfig.get("CellWeights", CellWeightNames);
+      if (Err != 0) {
+         LOG_ERROR("Decomp: error reading Decomp options");
+         return Err;
+      }
+   }
+
+   PartMethod Method = getPartMethodFromStr(DecompMethod);
+   if (Method == PartMethodUnknown) {
+      LOG_ERROR("Decomp: unknown DecompMethod {}", DecompMethod);
+      return 1;
+   }
+   CellOrder Order = getCellOrderFromStr(CellOrdering);
+   if (Order == CellOrderUnknown) {
+      LOG_ERROR("Decomp: unknown CellOrdering {}", CellOrdering);
+      return 1;
+   }
 
    // Retrieve the default machine environment
    MachEnv *DefEnv = MachEnv::getDefaultEnv();
@@ -337,9 +581,18 @@ int Decomp::init(const std::string &MeshFileName) {
    // Use one partition per MPI task as the default
    I4 NParts = DefEnv->getNumTasks();
 
+   std::string PartFileName;
+   if (UsePartFile)
+      PartFileName = InMeshFileName + ".part." + std::to_string(NParts);
+
+   std::string SnapshotName;
+   if (UseSnapshot)
+      SnapshotName = InMeshFileName + ".snap";
+
    // Create the default decomposition
    Decomp DefDecomp("Default", DefEnv, NParts, Method, InHaloWidth,
-                    MeshFileName);
+                    InMeshFileName, Order, PartFileName, CellWeightNames, {},
+                    SnapshotName);
 
    // Retrieve this environment and set pointer to DefaultDecomp
    Decomp::DefaultDecomp = Decomp::get("Default");
@@ -357,12 +610,20 @@ Decomp::Decomp(
     const MachEnv *InEnv,            //< [in] MachEnv for the new partition
     I4 NParts,                       //< [in] num of partitions for new decomp
     PartMethod Method,               //< [in] method for partitioning
-    I4 InHaloWidth,                  //< [in] width of halo in new decomp
-    const std::string &MeshFileName_ //< [in] name of file with mesh info
+    I4 InHaloWidth,                   //< [in] width of halo in new decomp
+    const std::string &MeshFileName_, //< [in] name of file with mesh info
+    CellOrder Order,                  //< [in] ordering of owned cells
+    const std::string &PartFileName_, //< [in] file with cell partition
+    const std::vector<std::string> &CellWeightNames, //< [in] weight fields
+    const std::vector<I4> &CellWeightsIn, //< [in] cell wgts in linear distrb
+    const std::string &SnapshotName_      //< [in] prefix of snapshot files
 ) {
 
    int Err = 0; // internal error code
 
+   // Charge the decomposition arrays to the Decomp subsystem
+   MemoryScope Scope("Decomp");
+
    // Retrieve some info on the MPI layout
    MPI_Comm Comm = InEnv->getComm();
    I4 NumTasks   = InEnv->getNumTasks();
@@ -370,34 +631,55 @@ Decomp::Decomp(
    I4 MasterTask = InEnv->getMasterTask();
    bool IsMaster = InEnv->isMasterTask();
 
+   MeshFileName = MeshFileName_;
+   PartFileName = PartFileName_;
+   SnapshotName = SnapshotName_;
+   HaloWidth    = InHaloWidth;
+
+   // Restore the decomposition from a snapshot if one exists for this
+   // configuration. Snapshots are not used for decompositions with weights
+   // provided directly, since these change from run to run.
+   std::vector<I4> SnapshotConfig;
+   if (!SnapshotName.empty() && CellWeightsIn.empty()) {
+      SnapshotConfig =
+          snapshotConfig(InEnv, NParts, Method, Order, CellWeightNames);
+      if (readSnapshot(InEnv, SnapshotConfig) == 0) {
+         copyToDevice();
+         AllDecomps.emplace(Name, *this);
+         return;
+      }
+   }
+
    // Open the mesh file for reading (assume IO has already been initialized)
    int FileID;
-   MeshFileName = MeshFileName_;
-   Err          = IO::openFile(FileID, MeshFileName, IO::ModeRead);
+   Err = IO::openFile(FileID, MeshFileName, IO::ModeRead);
    if (Err != 0)
       LOG_CRITICAL("Decomp: error opening mesh file");
 
-   // Read mesh size and connectivity information
+   // Read the mesh sizes and the cell adjacency needed for partitioning.
+   // The other connectivity arrays are read later, each just before it is
+   // needed, and released once redistributed.
+   Err = readMeshSizes(FileID, NCellsGlobal, NEdgesGlobal, NVerticesGlobal,
+                       MaxEdges, MaxCellsOnEdge, VertexDegree);
    std::vector<I4> CellsOnCellInit;
-   std::vector<I4> EdgesOnCellInit;
-   std::vector<I4> VerticesOnCellInit;
-   std::vector<I4> CellsOnEdgeInit;
-   std::vector<I4> EdgesOnEdgeInit;
-   std::vector<I4> VerticesOnEdgeInit;
-   std::vector<I4> CellsOnVertexInit;
-   std::vector<I4> EdgesOnVertexInit;
-   HaloWidth = InHaloWidth;
-
-   Err = readMesh(FileID, InEnv, NCellsGlobal, NEdgesGlobal, NVerticesGlobal,
-                  MaxEdges, MaxCellsOnEdge, VertexDegree, CellsOnCellInit,
-                  EdgesOnCellInit, VerticesOnCellInit, CellsOnEdgeInit,
-                  EdgesOnEdgeInit, VerticesOnEdgeInit, CellsOnVertexInit,
-                  EdgesOnVertexInit);
+   Err += readMeshArray(FileID, InEnv, "cellsOnCell", NCellsGlobal, MaxEdges,
+                        CellsOnCellInit);
    if (Err != 0)
       LOG_CRITICAL("Decomp: Error reading mesh connectivity");
 
-   // Close file
-   Err = IO::closeFile(FileID);
+   // Read the cell weights for a weighted partition, if requested. Weights
+   // provided directly (eg from a rebalance) replace any weight fields.
+   std::vector<I4> CellWeightsInit;
+   I4 NCellWeights = CellWeightNames.size();
+   if (!CellWeightsIn.empty()) {
+      CellWeightsInit = CellWeightsIn;
+      NCellWeights    = 1;
+   } else if (NCellWeights > 0) {
+      Err = readCellWeights(FileID, InEnv, NCellsGlobal, CellWeightNames,
+                            CellWeightsInit);
+      if (Err != 0)
+         LOG_CRITICAL("Decomp: Error reading cell weights");
+   }
 
    // Use the mesh adjacency information to create a partition of cells
    switch (Method) { // branch depending on method chosen
@@ -406,7 +688,8 @@ Decomp::Decomp(
    // ParMetis KWay method
    case PartMethodMetisKWay: {
 
-      Err = partCellsKWay(InEnv, CellsOnCellInit);
+      Err = partCellsKWay(InEnv, CellsOnCellInit, CellWeightsInit,
+                          NCellWeights, Order);
       if (Err != 0) {
          LOG_CRITICAL("Decomp: Error partitioning cells KWay");
          return;
@@ -414,6 +697,32 @@ Decomp::Decomp(
       break;
    } // end case MethodKWay
 
+   //---------------------------------------------------------------------------
+   // Distributed ParMetis KWay method
+   case PartMethodParMetisKWay: {
+
+      Err = partCellsParMetisKWay(InEnv, CellsOnCellInit, CellWeightsInit,
+                                  NCellWeights, Order);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error partitioning cells ParMETIS KWay");
+         return;
+      }
+      break;
+   } // end case MethodParMetisKWay
+
+   //---------------------------------------------------------------------------
+   // Metis KWay method partitioning across nodes, then tasks on each node
+   case PartMethodMetisKWayNode: {
+
+      Err = partCellsKWay(InEnv, CellsOnCellInit, CellWeightsInit,
+                          NCellWeights, Order, true);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error partitioning cells KWay by node");
+         return;
+      }
+      break;
+   } // end case MethodKWayNode
+
       //---------------------------------------------------------------------------
       // Unknown partitioning method
 
@@ -425,32 +734,72 @@ Decomp::Decomp(
 
    //---------------------------------------------------------------------------
 
-   // Cell partitioning complete. Redistribute the initial XXOnCell arrays
-   // to their final locations.
+   // Cell partitioning complete. Read the remaining initial XXOnCell arrays
+   // and redistribute them to their final locations.
+   freeMeshArray(CellWeightsInit);
+   std::vector<I4> EdgesOnCellInit;
+   std::vector<I4> VerticesOnCellInit;
+   Err = readMeshArray(FileID, InEnv, "edgesOnCell", NCellsGlobal, MaxEdges,
+                       EdgesOnCellInit);
+   Err += readMeshArray(FileID, InEnv, "verticesOnCell", NCellsGlobal,
+                        MaxEdges, VerticesOnCellInit);
+   if (Err != 0)
+      LOG_CRITICAL("Decomp: Error reading XxOnCell arrays");
    Err = rearrangeCellArrays(InEnv, CellsOnCellInit, EdgesOnCellInit,
                              VerticesOnCellInit);
    if (Err != 0) {
       LOG_CRITICAL("Decomp: Error rearranging XxOnCell arrays");
       return;
    }
+   freeMeshArray(CellsOnCellInit);
+   freeMeshArray(EdgesOnCellInit);
+   freeMeshArray(VerticesOnCellInit);
 
    // Partition the edges
+   std::vector<I4> CellsOnEdgeInit;
+   Err = readMeshArray(FileID, InEnv, "cellsOnEdge", NEdgesGlobal,
+                       MaxCellsOnEdge, CellsOnEdgeInit);
+   if (Err != 0)
+      LOG_CRITICAL("Decomp: Error reading CellsOnEdge");
    Err = partEdges(InEnv, CellsOnEdgeInit);
    if (Err != 0) {
       LOG_CRITICAL("Decomp: Error partitioning edges");
       return;
    }
 
-   // Edge partitioning complete. Redistribute the initial XXOnEdge arrays
-   // to their final locations.
+   // Edge partitioning complete. Read the remaining initial XXOnEdge arrays
+   // and redistribute them to their final locations.
+   std::vector<I4> EdgesOnEdgeInit;
+   std::vector<I4> VerticesOnEdgeInit;
+   Err = readMeshArray(FileID, InEnv, "edgesOnEdge", NEdgesGlobal,
+                       2 * MaxEdges, EdgesOnEdgeInit);
+   Err += readMeshArray(FileID, InEnv, "verticesOnEdge", NEdgesGlobal,
+                        MaxCellsOnEdge, VerticesOnEdgeInit);
+   if (Err != 0)
+      LOG_CRITICAL("Decomp: Error reading XxOnEdge arrays");
    Err = rearrangeEdgeArrays(InEnv, CellsOnEdgeInit, EdgesOnEdgeInit,
                              VerticesOnEdgeInit);
    if (Err != 0) {
       LOG_CRITICAL("Decomp: Error rearranging XxOnEdge arrays");
       return;
    }
+   freeMeshArray(CellsOnEdgeInit);
+   freeMeshArray(EdgesOnEdgeInit);
+   freeMeshArray(VerticesOnEdgeInit);
 
    // Partition the vertices
+   std::vector<I4> CellsOnVertexInit;
+   std::vector<I4> EdgesOnVertexInit;
+   Err = readMeshArray(FileID, InEnv, "cellsOnVertex", NVerticesGlobal,
+                       VertexDegree, CellsOnVertexInit);
+   Err += readMeshArray(FileID, InEnv, "edgesOnVertex", NVerticesGlobal,
+                        VertexDegree, EdgesOnVertexInit);
+   if (Err != 0)
+      LOG_CRITICAL("Decomp: Error reading XxOnVertex arrays");
+
+   // All connectivity has been read
+   Err = IO::closeFile(FileID);
+
    Err = partVertices(InEnv, CellsOnVertexInit);
    if (Err != 0) {
       LOG_CRITICAL("Decomp: Error partitioning vertices");
@@ -464,6 +813,8 @@ Decomp::Decomp(
       LOG_CRITICAL("Decomp: Error rearranging XxOnVertex arrays");
       return;
    }
+   freeMeshArray(CellsOnVertexInit);
+   freeMeshArray(EdgesOnVertexInit);
 
    // Convert global addresses to local addresses. Create the global to
    // local address ordered maps to simplify and optimize searches.
@@ -627,36 +978,100 @@ Decomp::Decomp(
    }
 
    // Create device copies of all arrays
+   copyToDevice();
 
-   NCellsHalo = createDeviceMirrorCopy(NCellsHaloH);
-   CellID     = createDeviceMirrorCopy(CellIDH);
-   CellLoc    = createDeviceMirrorCopy(CellLocH);
+   // Save the decomposition for reuse in later runs
+   if (!SnapshotConfig.empty())
+      writeSnapshot(InEnv, SnapshotConfig);
 
-   NEdgesHalo = createDeviceMirrorCopy(NEdgesHaloH);
-   EdgeID     = createDeviceMirrorCopy(EdgeIDH);
-   EdgeLoc    = createDeviceMirrorCopy(EdgeLocH);
+   // Assign this as the default decomposition
+   AllDecomps.emplace(Name, *this);
 
-   NVerticesHalo = createDeviceMirrorCopy(NVerticesHaloH);
-   VertexID      = createDeviceMirrorCopy(VertexIDH);
-   VertexLoc     = createDeviceMirrorCopy(VertexLocH);
+} // end decomposition constructor
 
-   CellsOnCell    = createDeviceMirrorCopy(CellsOnCellH);
-   EdgesOnCell    = createDeviceMirrorCopy(EdgesOnCellH);
-   VerticesOnCell = createDeviceMirrorCopy(VerticesOnCellH);
-   NEdgesOnCell   = createDeviceMirrorCopy(NEdgesOnCellH);
+//------------------------------------------------------------------------------
+// Create a new decomposition that balances a measured cost per cell. The cost
+// of each owned cell is converted into an integer weight relative to the
+// mean cost per cell in the mesh and sent to the task that holds the cell
+// in the initial linear distribution. The mesh is then partitioned again
+// with these weights as a single balancing constraint.
+
+int Decomp::rebalance(
+    const std::string &NewName,    // [in] name for the new decomposition
+    const Decomp *OldDecomp,       // [in] existing decomposition
+    const MachEnv *InEnv,          // [in] MachEnv used by OldDecomp
+    const HostArray1DR8 &CellCost, // [in] cost of each owned cell
+    PartMethod Method,             // [in] partition method
+    CellOrder Order                // [in] ordering of owned cells
+) {
 
-   CellsOnEdge    = createDeviceMirrorCopy(CellsOnEdgeH);
-   EdgesOnEdge    = createDeviceMirrorCopy(EdgesOnEdgeH);
-   VerticesOnEdge = createDeviceMirrorCopy(VerticesOnEdgeH);
-   NEdgesOnEdge   = createDeviceMirrorCopy(NEdgesOnEdgeH);
+   int Err = 0; // initialize return code
 
-   CellsOnVertex = createDeviceMirrorCopy(CellsOnVertexH);
-   EdgesOnVertex = createDeviceMirrorCopy(EdgesOnVertexH);
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
 
-   // Assign this as the default decomposition
-   AllDecomps.emplace(Name, *this);
+   I4 NCellsGlobal = OldDecomp->NCellsGlobal;
+   I4 NCellsOwned  = OldDecomp->NCellsOwned;
+   I4 NCellsChunk  = (NCellsGlobal - 1) / NumTasks + 1;
+
+   // Compute the mean cost per cell to normalize the weights. The weight
+   // scale sets the resolution of the integer weights relative to the mean.
+   const R8 WeightScale = 100.0;
+   R8 LocCost           = 0.0;
+
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell)
+      LocCost += CellCost(Cell);
+   R8 TotCost = 0.0;
+   Err        = MPI_Allreduce(&LocCost, &TotCost, 1, MPI_DOUBLE, MPI_SUM, Comm);
+   if (Err != 0 || TotCost <= 0.0) {
+      LOG_ERROR("Decomp: invalid cell costs for rebalance");
+      return -1;
+   }
+   R8 MeanCost = TotCost / NCellsGlobal;
+
+   // Send the (cell ID, weight) pairs to the tasks holding each cell in the
+   // initial linear distribution. Every weight is at least one so that no
+   // cell is free.
+   HostArray1DI4 OldCellIDH = OldDecomp->getHost(OldDecomp->CellIDH);
+   std::vector<I4> SendCount(NumTasks, 0);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell)
+      SendCount[(OldCellIDH(Cell) - 1) / NCellsChunk] += 2;
+   std::vector<I4> SendAdd(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task)
+      SendAdd[Task] = SendAdd[Task - 1] + SendCount[Task - 1];
+
+   std::vector<I4> SendBuf(2 * NCellsOwned);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      I4 CellID = OldCellIDH(Cell);
+      I4 Task   = (CellID - 1) / NCellsChunk;
+      R8 Weight = WeightScale * CellCost(Cell) / MeanCost;
 
-} // end decomposition constructor
+      SendBuf[SendAdd[Task]]     = CellID;
+      SendBuf[SendAdd[Task] + 1] = std::max(I4(std::lround(Weight)), 1);
+      SendAdd[Task] += 2;
+   }
+
+   std::vector<I4> RecvBuf;
+   std::vector<I4> RecvCount;
+   Err = exchangeLists(SendBuf, SendCount, RecvBuf, RecvCount, Comm);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error communicating cell weights for rebalance");
+      return Err;
+   }
+
+   I4 CellStart = std::min(InEnv->getMyTask() * NCellsChunk, NCellsGlobal);
+   std::vector<I4> CellWeightsInit(NCellsChunk, 0);
+   for (int n = 0; n < RecvBuf.size(); n += 2)
+      CellWeightsInit[RecvBuf[n] - 1 - CellStart] = RecvBuf[n + 1];
+
+   // Create the new decomposition with the same mesh and halo width
+   Decomp NewDecomp(NewName, InEnv, NumTasks, Method, OldDecomp->HaloWidth,
+                    OldDecomp->MeshFileName, Order, "", {}, CellWeightsInit);
+
+   return Err;
+
+} // end rebalance
 
 // Destructor
 //------------------------------------------------------------------------------
@@ -719,11 +1134,15 @@ Decomp *Decomp::get(const std::string Name ///< [in] Name of environment
 // Partition the cells using the Metis/ParMetis KWay method
 // After this partitioning, the decomposition class member CellID and
 // CellLocator arrays have been set as well as the class NCells size variables
-// (owned, halo, all).
+// (owned, halo, all). The owned cells are numbered using the input ordering.
 
 int Decomp::partCellsKWay(
     const MachEnv *InEnv, // [in] input machine environment with MPI info
-    const std::vector<I4> &CellsOnCellInit // [in] cell nbrs in linear distrb
+    const std::vector<I4> &CellsOnCellInit, // [in] cell nbrs in linear distrb
+    const std::vector<I4> &CellWeightsInit, // [in] cell wgts in linear distrb
+    I4 NCellWeights,                        // [in] num weights per cell
+    CellOrder Order,                        // [in] ordering of owned cells
+    bool ByNode                             // [in] two-level partition
 ) {
 
    int Err = 0; // initialize return code
@@ -735,11 +1154,10 @@ int Decomp::partCellsKWay(
    I4 MasterTask = InEnv->getMasterTask();
    bool IsMaster = InEnv->isMasterTask();
 
-   // TEMPORARY:
-   // Due to difficulties with ParMetis, we use serial Metis for now with
-   // each task calling the serial form with the global adjacency data.
-   // This requires us to communicate the CellsOnCell data and pack it
-   // into the Metis structure.
+   // This method uses serial Metis with each task calling the serial form
+   // with the global adjacency data. This requires us to communicate the
+   // CellsOnCell data and pack it into the Metis structure. For large meshes,
+   // the distributed partCellsParMetisKWay method should be used instead.
 
    // Allocate adjacency arrays and a buffer for portions of the CellsOnCell
    // array.
@@ -749,6 +1167,12 @@ int Decomp::partCellsKWay(
    I4 CellsOnCellSize = NCellsChunk * MaxEdges;
    std::vector<I4> CellsOnCellBuf(CellsOnCellSize, 0);
 
+   // If the partition is weighted, the weights are also needed for the
+   // global graph
+   I4 CellWeightsSize = NCellsChunk * NCellWeights;
+   std::vector<idx_t> CellWeights(NCellsGlobal * NCellWeights, 0);
+   std::vector<I4> CellWeightsBuf(CellWeightsSize, 0);
+
    // This is an address counter needed to keep track of the starting
    // address for each cell in the packed adjacency array.
    I4 Add = 0;
@@ -772,6 +1196,19 @@ int Decomp::partCellsKWay(
          return Err;
       }
 
+      if (NCellWeights > 0) {
+         if (MyTask == Task) {
+            for (int n = 0; n < CellWeightsSize; ++n)
+               CellWeightsBuf[n] = CellWeightsInit[n];
+         }
+         Err = MPI_Bcast(&CellWeightsBuf[0], CellWeightsSize, MPI_INT32_T,
+                         Task, Comm);
+         if (Err != 0) {
+            LOG_CRITICAL("Decomp: Error communicating cell weights");
+            return Err;
+         }
+      }
+
       // Create the adjacency graph by aggregating the individual
       // chunks. Prune edges that don't have neighbors.
       for (int Cell = 0; Cell < NCellsChunk; ++Cell) {
@@ -783,6 +1220,9 @@ int Decomp::partCellsKWay(
             break;
 
          AdjAdd[CellGlob] = Add; // start add for cell in Adjacency array
+         for (int Wgt = 0; Wgt < NCellWeights; ++Wgt)
+            CellWeights[CellGlob * NCellWeights + Wgt] =
+                CellWeightsBuf[Cell * NCellWeights + Wgt];
          for (int Edge = 0; Edge < MaxEdges; ++Edge) {
             I4 BufAdd  = Cell * MaxEdges + Edge;
             I4 NbrCell = CellsOnCellBuf[BufAdd];
@@ -801,21 +1241,23 @@ int Decomp::partCellsKWay(
 
    // NConstraints is the number of balancing constraints, mostly for
    // use when multiple vertex weights are assigned. Must be at least 1.
-   // We do not yet support weighted partitions
-   idx_t NConstraints = 1;
+   idx_t NConstraints = std::max(NCellWeights, 1);
 
    // Arrays needed for weighted decompositions. If no weighting used
-   // set pointers to null.
+   // set pointers to null. Only vertex (cell) weights are supported.
    idx_t *VrtxWgtPtr{nullptr};
    idx_t *EdgeWgtPtr{nullptr};
    idx_t *VrtxSize{nullptr};
+   if (NCellWeights > 0)
+      VrtxWgtPtr = &CellWeights[0];
 
    // Use default metis options
    idx_t *Options{nullptr};
 
    // These are for multi-constraint partitions where the vertex weight
    // has to be distributed among the multiple constraints.
-   // We do not use them so set them to null
+   // We use the defaults (an equal share of each constraint for every
+   // partition and the default imbalance tolerance) so set them to null
    real_t *TpWgts{nullptr};
    real_t *Ubvec{nullptr};
 
@@ -825,32 +1267,100 @@ int Decomp::partCellsKWay(
    std::vector<idx_t> CellTask(NCellsGlobal);
    idx_t Edgecut = 0;
 
-   // Call METIS routine to partition the mesh
-   // METIS routines are C code that expect pointers, so we use the
-   // idiom &Var[0] to extract the pointer to the data in std::vector
-   int MetisErr = METIS_PartGraphKway(&NCellsGlobal, &NConstraints, &AdjAdd[0],
-                                      &Adjacency[0], VrtxWgtPtr, VrtxSize,
-                                      EdgeWgtPtr, &NumTasks, TpWgts, Ubvec,
-                                      Options, &Edgecut, &CellTask[0]);
+   // If a partition file from a previous run exists, use the partition
+   // from the file and skip the call to METIS.
+   bool PartFromFile = false;
+   std::vector<I4> TaskChunk;
+   if (!PartFileName.empty() && readPartFile(InEnv, TaskChunk) == 0) {
+      std::vector<I4> ChunkSize(NumTasks);
+      std::vector<I4> ChunkStart(NumTasks);
+      for (int Task = 0; Task < NumTasks; ++Task) {
+         I4 TaskEnd       = std::min((Task + 1) * NCellsChunk, NCellsGlobal);
+         ChunkStart[Task] = std::min(Task * NCellsChunk, NCellsGlobal);
+         ChunkSize[Task]  = TaskEnd - ChunkStart[Task];
+      }
+      std::vector<I4> TaskAll(NCellsGlobal);
+      Err = MPI_Allgatherv(TaskChunk.data(), TaskChunk.size(), MPI_INT32_T,
+                           TaskAll.data(), ChunkSize.data(), ChunkStart.data(),
+                           MPI_INT32_T, Comm);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error communicating cell partition");
+         return Err;
+      }
+      for (int Cell = 0; Cell < NCellsGlobal; ++Cell)
+         CellTask[Cell] = TaskAll[Cell];
+      PartFromFile = true;
+   }
 
-   if (MetisErr != METIS_OK) {
-      LOG_CRITICAL("Decomp: Error in ParMETIS");
-      Err = -1;
-      return Err;
+   if (!PartFromFile && ByNode) {
+      // Partition first across nodes and then within each node
+      Err = partGraphByNode(InEnv, NCellsGlobal, NConstraints, AdjAdd,
+                            Adjacency, VrtxWgtPtr, CellTask);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error in node-aware METIS partition");
+         return Err;
+      }
+   } else if (!PartFromFile) {
+      // Call METIS routine to partition the mesh
+      // METIS routines are C code that expect pointers, so we use the
+      // idiom &Var[0] to extract the pointer to the data in std::vector
+      int MetisErr = METIS_PartGraphKway(
+          &NCellsGlobal, &NConstraints, &AdjAdd[0], &Adjacency[0], VrtxWgtPtr,
+          VrtxSize, EdgeWgtPtr, &NumTasks, TpWgts, Ubvec, Options, &Edgecut,
+          &CellTask[0]);
+
+      if (MetisErr != METIS_OK) {
+         LOG_CRITICAL("Decomp: Error in ParMETIS");
+         Err = -1;
+         return Err;
+      }
    }
 
-   // Determine the initial sizes needed by address arrays
+   if (!PartFromFile) {
+
+      // Save the partition of the local chunk for later runs
+      if (!PartFileName.empty()) {
+         I4 CellStart = std::min(MyTask * NCellsChunk, NCellsGlobal);
+         I4 CellEnd   = std::min((MyTask + 1) * NCellsChunk, NCellsGlobal);
+         TaskChunk.assign(CellTask.begin() + CellStart,
+                          CellTask.begin() + CellEnd);
+         writePartFile(InEnv, TaskChunk);
+      }
+   }
+
+   // Determine the initial sizes needed by address arrays and the local
+   // address of each cell within the task that owns it
 
    std::vector<I4> TaskCount(NumTasks, 0);
+   std::vector<I4> CellLocalAdd(NCellsGlobal, 0);
    for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
-      I4 TaskLoc  = CellTask[Cell];
-      I4 LocalAdd = TaskCount[TaskLoc];
+      I4 TaskLoc         = CellTask[Cell];
+      CellLocalAdd[Cell] = TaskCount[TaskLoc];
       ++TaskCount[TaskLoc]; // increment number of cells assigned to task
    }
    NCellsOwned = TaskCount[MyTask];
 
-   // Assign the full address (TaskID, local index) for each cell. These
-   // are implicity sorted in CellID order.
+   switch (Order) { // branch depending on ordering chosen
+
+   // Owned cells in CellID order, as computed above
+   case CellOrderNatural:
+      break;
+
+   // Reverse Cuthill-McKee ordering of owned cells
+   case CellOrderRCM:
+      orderCellsRCM(NCellsGlobal, NumTasks, AdjAdd, Adjacency, CellTask,
+                    CellLocalAdd);
+      break;
+
+   default:
+      LOG_CRITICAL("Decomp: Unknown or unsupported cell ordering");
+      Err = -1;
+      return Err;
+
+   } // end switch on Order
+
+   // Assign the full address (TaskID, local index) for each cell. For the
+   // natural ordering, these are implicity sorted in CellID order.
    // During this process we also create an ordered list of all local
    // (owned+halo) cells using std::set for later use in halo setup
 
@@ -860,14 +1370,9 @@ int Decomp::partCellsKWay(
    std::vector<I4> CellLocTmp(2 * NCellsOwned, 0); // will grow when halo added
    std::set<I4> CellsInList; // list of unique cells in local owned, halo
 
-   // reset local address counter
-   for (int Task = 0; Task < NumTasks; ++Task)
-      TaskCount[Task] = 0;
-
    for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
       I4 TaskLoc  = CellTask[Cell];
-      I4 LocalAdd = TaskCount[TaskLoc];
-      ++TaskCount[TaskLoc]; // increment number of cells assigned to task
+      I4 LocalAdd = CellLocalAdd[Cell];
       CellLocAll[2 * Cell]     = TaskLoc;  // Task location
       CellLocAll[2 * Cell + 1] = LocalAdd; // local address within task
       // If this cell is on the local task, store as a local cell
@@ -922,21 +1427,342 @@ int Decomp::partCellsKWay(
 
       } // end loop over previous layer
 
-      // Extract the values from the Halo list into the ID and location
-      // vectors. Extend size of ID, Loc arrays.
+      // Extract the values from the Halo list into the ID and location
+      // vectors. Extend size of ID, Loc arrays.
+      I4 HaloAdd = CellLocEnd;
+      CurSize += HaloList.size();
+      NCellsHaloTmp(Halo) = CurSize;
+      CellIDTmp.resize(CurSize);
+      CellLocTmp.resize(2 * CurSize);
+
+      for (auto IHalo = HaloList.begin(); IHalo != HaloList.end(); IHalo++) {
+         ++HaloAdd;
+         NbrID              = *IHalo; // the neighbor cell id from the HaloList
+         NbrGlob            = NbrID - 1; // global address of this neighbor
+         CellIDTmp[HaloAdd] = NbrID;
+         CellLocTmp[2 * HaloAdd]     = CellLocAll[2 * NbrGlob];
+         CellLocTmp[2 * HaloAdd + 1] = CellLocAll[2 * NbrGlob + 1];
+      }
+
+      // Reset for next halo layer
+      CellLocStart = CellLocEnd + 1;
+      CellLocEnd   = NCellsHaloTmp(Halo) - 1;
+   }
+   NCellsAll  = NCellsHaloTmp(HaloWidth - 1);
+   NCellsSize = NCellsAll + 1; // extra entry to store boundary/undefined value
+
+   // The cell decomposition is now complete, copy the information
+   // into the final locations as class members on host (copy to device later)
+
+   NCellsHaloH = NCellsHaloTmp;
+
+   // Copy global ID for each cell, both owned and halo.
+   // Copy cell location (task, local add) for each cell, both owned and halo
+
+   HostArray1DI4 CellIDHTmp("CellID", NCellsSize);
+   HostArray2DI4 CellLocHTmp("CellLoc", NCellsSize, 2);
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      CellIDHTmp(Cell)     = CellIDTmp[Cell];
+      CellLocHTmp(Cell, 0) = CellLocTmp[2 * Cell];     // task owning this cell
+      CellLocHTmp(Cell, 1) = CellLocTmp[2 * Cell + 1]; // local address on task
+   }
+   CellIDH  = CellIDHTmp;
+   CellLocH = CellLocHTmp;
+
+   // All done
+   return Err;
+
+} // end function partCellsKWay
+
+//------------------------------------------------------------------------------
+// Partition the cells using the distributed ParMetis KWay method
+// Unlike partCellsKWay, the adjacency graph is never assembled on a single
+// task. Each task passes its chunk of the initial linear distribution to
+// ParMetis and the cell locations are stored only by the task that holds the
+// cell in the linear distribution, which serves as a directory for the
+// construction of the halos. After this partitioning, the decomposition class
+// member CellID and CellLocator arrays have been set as well as the class
+// NCells size variables (owned, halo, all). The owned cells are numbered using
+// the input ordering.
+
+int Decomp::partCellsParMetisKWay(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    const std::vector<I4> &CellsOnCellInit, // [in] cell nbrs in linear distrb
+    const std::vector<I4> &CellWeightsInit, // [in] cell wgts in linear distrb
+    I4 NCellWeights,                        // [in] num weights per cell
+    CellOrder Order                         // [in] ordering of owned cells
+) {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+
+   // Determine the range of global cells held by each task in the initial
+   // linear distribution. Cells on a task are 0-based global addresses
+   // VtxDist[Task] to VtxDist[Task+1]-1, as required by ParMetis.
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   std::vector<idx_t> VtxDist(NumTasks + 1);
+   for (int Task = 0; Task <= NumTasks; ++Task)
+      VtxDist[Task] = std::min(Task * NCellsChunk, NCellsGlobal);
+   I4 CellStart   = VtxDist[MyTask];
+   I4 NCellsLocal = VtxDist[MyTask + 1] - CellStart;
+
+   // Create the local portion of the distributed adjacency graph in the
+   // packed form needed by ParMETIS. Prune edges that don't have neighbors.
+   std::vector<idx_t> AdjAdd(NCellsLocal + 1, 0);
+   std::vector<idx_t> Adjacency;
+   Adjacency.reserve(NCellsLocal * MaxEdges);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      AdjAdd[Cell] = Adjacency.size();
+      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+         I4 NbrCell = CellsOnCellInit[Cell * MaxEdges + Edge];
+         if (validCellID(NbrCell))
+            Adjacency.push_back(NbrCell - 1); // switch to 0-based indx
+      }
+   }
+   AdjAdd[NCellsLocal] = Adjacency.size();
+
+   // Vertex (cell) weights for a weighted partition. Each weight is a
+   // balancing constraint.
+   std::vector<idx_t> CellWeights(CellWeightsInit.begin(),
+                                  CellWeightsInit.begin() +
+                                      NCellsLocal * NCellWeights);
+
+   // Set up remaining partitioning variables. Each balancing constraint
+   // uses equal target weights for all partitions and the ParMetis default
+   // load imbalance tolerance.
+   idx_t WgtFlag      = NCellWeights > 0 ? 2 : 0; // vertex weights only
+   idx_t NumFlag      = 0;                        // 0-based indexing
+   idx_t NConstraints = std::max(NCellWeights, 1);
+   idx_t NParts       = NumTasks;
+   std::vector<real_t> TpWgts(NParts * NConstraints, 1.0 / NParts);
+   std::vector<real_t> Ubvec(NConstraints, 1.05);
+   idx_t Options[3]  = {0, 0, 0}; // use default options
+   idx_t Edgecut     = 0;
+   MPI_Comm PartComm = Comm;
+   idx_t *VrtxWgtPtr = NCellWeights > 0 ? CellWeights.data() : nullptr;
+
+   // Results are stored in a partition array which returns the task
+   // assigned to each cell in the local chunk
+   std::vector<idx_t> CellTask(NCellsLocal);
+
+   // If a partition file from a previous run exists, use the partition
+   // from the file and skip the call to ParMETIS.
+   std::vector<I4> TaskChunk;
+   if (!PartFileName.empty() && readPartFile(InEnv, TaskChunk) == 0) {
+      for (int Cell = 0; Cell < NCellsLocal; ++Cell)
+         CellTask[Cell] = TaskChunk[Cell];
+
+   } else {
+      int MetisErr = ParMETIS_V3_PartKway(
+          VtxDist.data(), AdjAdd.data(), Adjacency.data(), VrtxWgtPtr,
+          nullptr, &WgtFlag, &NumFlag, &NConstraints, &NParts, TpWgts.data(),
+          Ubvec.data(), Options, &Edgecut, CellTask.data(), &PartComm);
+
+      if (MetisErr != METIS_OK) {
+         LOG_CRITICAL("Decomp: Error in ParMETIS");
+         Err = -1;
+         return Err;
+      }
+
+      // Save the partition of the local chunk for later runs
+      if (!PartFileName.empty()) {
+         TaskChunk.assign(CellTask.begin(), CellTask.end());
+         writePartFile(InEnv, TaskChunk);
+      }
+   }
+
+   // Send each cell in the local chunk, together with its neighbors, to the
+   // task that owns it. Each message contains the cell ID followed by the
+   // MaxEdges entries of CellsOnCell. Cells are sent in CellID order.
+   I4 MsgSize = MaxEdges + 1;
+   std::vector<I4> SendCount(NumTasks, 0);
+   std::vector<I4> SendAdd(NumTasks, 0);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell)
+      SendCount[CellTask[Cell]] += MsgSize;
+   for (int Task = 1; Task < NumTasks; ++Task)
+      SendAdd[Task] = SendAdd[Task - 1] + SendCount[Task - 1];
+
+   std::vector<I4> CellSendAdd(NCellsLocal); // address in send buffer
+   std::vector<I4> SendBuf(NCellsLocal * MsgSize);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      I4 Add            = SendAdd[CellTask[Cell]];
+      CellSendAdd[Cell] = Add;
+      SendBuf[Add]      = CellStart + Cell + 1; // IDs are 1-based
+      for (int Edge = 0; Edge < MaxEdges; ++Edge)
+         SendBuf[Add + Edge + 1] = CellsOnCellInit[Cell * MaxEdges + Edge];
+      SendAdd[CellTask[Cell]] += MsgSize;
+   }
+
+   std::vector<I4> RecvBuf;
+   std::vector<I4> RecvCount;
+   Err = exchangeLists(SendBuf, SendCount, RecvBuf, RecvCount, Comm);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating owned cells");
+      return Err;
+   }
+
+   // The received cells are the owned cells. Because the linear distribution
+   // is in CellID order, they have been received in CellID order.
+   NCellsOwned = RecvBuf.size() / MsgSize;
+   std::vector<I4> OwnedID(NCellsOwned);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell)
+      OwnedID[Cell] = RecvBuf[Cell * MsgSize];
+
+   // Determine the local address of each owned cell
+   std::vector<I4> OwnedAdd(NCellsOwned);
+   switch (Order) { // branch depending on ordering chosen
+
+   // Owned cells in CellID order
+   case CellOrderNatural:
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell)
+         OwnedAdd[Cell] = Cell;
+      break;
+
+   // Reverse Cuthill-McKee ordering of owned cells using the adjacency
+   // graph of the owned cells only
+   case CellOrderRCM: {
+      std::vector<idx_t> OwnedAdjAdd(NCellsOwned + 1, 0);
+      std::vector<idx_t> OwnedAdjacency;
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         OwnedAdjAdd[Cell] = OwnedAdjacency.size();
+         for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+            I4 NbrID = RecvBuf[Cell * MsgSize + Edge + 1];
+            auto It  = std::lower_bound(OwnedID.begin(), OwnedID.end(), NbrID);
+            if (validCellID(NbrID) && It != OwnedID.end() && *It == NbrID)
+               OwnedAdjacency.push_back(std::distance(OwnedID.begin(), It));
+         }
+      }
+      OwnedAdjAdd[NCellsOwned] = OwnedAdjacency.size();
+      std::vector<idx_t> OwnedTask(NCellsOwned, 0);
+      orderCellsRCM(NCellsOwned, 1, OwnedAdjAdd, OwnedAdjacency, OwnedTask,
+                    OwnedAdd);
+      break;
+   }
+
+   default:
+      LOG_CRITICAL("Decomp: Unknown or unsupported cell ordering");
+      Err = -1;
+      return Err;
+
+   } // end switch on Order
+
+   // Store the owned cells at their local address. The neighbor IDs are
+   // retained for the construction of the halo.
+   std::vector<I4> CellIDTmp(NCellsOwned);
+   std::vector<I4> CellLocTmp(2 * NCellsOwned);
+   std::vector<I4> CellNbrTmp(NCellsOwned * MaxEdges);
+   std::set<I4> CellsInList; // list of unique cells in local owned, halo
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      I4 LocalAdd                  = OwnedAdd[Cell];
+      CellIDTmp[LocalAdd]          = OwnedID[Cell];
+      CellLocTmp[2 * LocalAdd]     = MyTask;
+      CellLocTmp[2 * LocalAdd + 1] = LocalAdd;
+      for (int Edge = 0; Edge < MaxEdges; ++Edge)
+         CellNbrTmp[LocalAdd * MaxEdges + Edge] =
+             RecvBuf[Cell * MsgSize + Edge + 1];
+      CellsInList.insert(OwnedID[Cell]);
+   }
+
+   // Return the local address of each owned cell to the task holding
+   // the cell in the linear distribution
+   std::vector<I4> AddCount(NumTasks);
+   for (int Task = 0; Task < NumTasks; ++Task)
+      AddCount[Task] = RecvCount[Task] / MsgSize;
+   std::vector<I4> ChunkAddBuf;
+   std::vector<I4> ChunkAddCount;
+   Err = exchangeLists(OwnedAdd, AddCount, ChunkAddBuf, ChunkAddCount, Comm);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating cell locations");
+      return Err;
+   }
+   std::vector<I4> ChunkAdd(NCellsLocal);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell)
+      ChunkAdd[Cell] = ChunkAddBuf[CellSendAdd[Cell] / MsgSize];
+
+   // Find and add the halo cells to the cell list. Here we use the
+   // neighbors of the previous layer to find the halo cells that are not
+   // already in the list. We use the std::set container to automatically
+   // sort each halo layer by cellID. The location and neighbors of each
+   // halo cell are requested from the task holding the cell in the linear
+   // distribution.
+   I4 CellLocStart = 0;
+   I4 CellLocEnd   = NCellsOwned - 1;
+   I4 CurSize      = NCellsOwned;
+   I4 ReplySize    = MaxEdges + 2; // task, local address and neighbors
+   HostArray1DI4 NCellsHaloTmp("NCellsHalo", HaloWidth);
+   std::set<I4> HaloList;
+   // Loop over each halo layer
+   for (int Halo = 0; Halo < HaloWidth; ++Halo) {
+      HaloList.clear(); // reset list for this halo layer
+      for (int CellLoc = CellLocStart; CellLoc <= CellLocEnd; ++CellLoc) {
+         for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+            I4 NbrID = CellNbrTmp[CellLoc * MaxEdges + Edge];
+            // only add to the list if the cell is valid and not already
+            // listed (the find function will return the end iterator if
+            // not found)
+            if (validCellID(NbrID) &&
+                CellsInList.find(NbrID) == CellsInList.end()) {
+               HaloList.insert(NbrID);
+               CellsInList.insert(NbrID);
+            }
+         }
+      } // end loop over previous layer
+
+      // Request the halo cell info. The sorted halo list is already
+      // ordered by the task holding each cell in the linear distribution.
+      std::vector<I4> ReqBuf(HaloList.begin(), HaloList.end());
+      std::vector<I4> ReqCount(NumTasks, 0);
+      for (I4 NbrID : ReqBuf)
+         ++ReqCount[(NbrID - 1) / NCellsChunk];
+      std::vector<I4> SrchBuf;
+      std::vector<I4> SrchCount;
+      Err = exchangeLists(ReqBuf, ReqCount, SrchBuf, SrchCount, Comm);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error communicating halo cell requests");
+         return Err;
+      }
+
+      // Reply with the location and neighbors of each requested cell
+      std::vector<I4> ReplyBuf(SrchBuf.size() * ReplySize);
+      for (int Req = 0; Req < SrchBuf.size(); ++Req) {
+         I4 Cell                       = SrchBuf[Req] - 1 - CellStart;
+         ReplyBuf[Req * ReplySize]     = CellTask[Cell];
+         ReplyBuf[Req * ReplySize + 1] = ChunkAdd[Cell];
+         for (int Edge = 0; Edge < MaxEdges; ++Edge)
+            ReplyBuf[Req * ReplySize + Edge + 2] =
+                CellsOnCellInit[Cell * MaxEdges + Edge];
+      }
+      for (int Task = 0; Task < NumTasks; ++Task)
+         SrchCount[Task] *= ReplySize;
+      std::vector<I4> HaloBuf;
+      std::vector<I4> HaloCount;
+      Err = exchangeLists(ReplyBuf, SrchCount, HaloBuf, HaloCount, Comm);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error communicating halo cell info");
+         return Err;
+      }
+
+      // Extract the values from the replies into the ID, location and
+      // neighbor vectors. Extend size of ID, Loc arrays.
       I4 HaloAdd = CellLocEnd;
       CurSize += HaloList.size();
       NCellsHaloTmp(Halo) = CurSize;
       CellIDTmp.resize(CurSize);
       CellLocTmp.resize(2 * CurSize);
+      CellNbrTmp.resize(CurSize * MaxEdges);
 
-      for (auto IHalo = HaloList.begin(); IHalo != HaloList.end(); IHalo++) {
+      for (int Req = 0; Req < ReqBuf.size(); ++Req) {
          ++HaloAdd;
-         NbrID              = *IHalo; // the neighbor cell id from the HaloList
-         NbrGlob            = NbrID - 1; // global address of this neighbor
-         CellIDTmp[HaloAdd] = NbrID;
-         CellLocTmp[2 * HaloAdd]     = CellLocAll[2 * NbrGlob];
-         CellLocTmp[2 * HaloAdd + 1] = CellLocAll[2 * NbrGlob + 1];
+         CellIDTmp[HaloAdd]          = ReqBuf[Req];
+         CellLocTmp[2 * HaloAdd]     = HaloBuf[Req * ReplySize];
+         CellLocTmp[2 * HaloAdd + 1] = HaloBuf[Req * ReplySize + 1];
+         for (int Edge = 0; Edge < MaxEdges; ++Edge)
+            CellNbrTmp[HaloAdd * MaxEdges + Edge] =
+                HaloBuf[Req * ReplySize + Edge + 2];
       }
 
       // Reset for next halo layer
@@ -967,7 +1793,371 @@ int Decomp::partCellsKWay(
    // All done
    return Err;
 
-} // end function partCellsKWay
+} // end function partCellsParMetisKWay
+
+//------------------------------------------------------------------------------
+// Reads the cell partition from the partition file. The file has the same
+// format as the MPAS graph.info.part files, with the task assigned to each
+// cell on a separate line in CellID order. The master task validates the
+// file and then sends the chunk of each task in the initial linear
+// distribution, one task at a time, so that no task stores the partition of
+// the full mesh. A non-zero return code indicates that the file does not
+// exist or does not match the mesh and task count.
+
+int Decomp::readPartFile(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    std::vector<I4> &CellTaskChunk // [out] task for cells in linear distrb
+) {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+   I4 MasterTask = InEnv->getMasterTask();
+   bool IsMaster = InEnv->isMasterTask();
+
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+
+   // Check that the file exists and contains a valid task for every cell
+   std::ifstream PartFile;
+   I4 FileErr = 0;
+   if (IsMaster) {
+      PartFile.open(PartFileName);
+      if (!PartFile) {
+         FileErr = 1;
+      } else {
+         I4 NCellsFile = 0;
+         I4 TaskFile;
+         while (PartFile >> TaskFile) {
+            if (TaskFile < 0 || TaskFile >= NumTasks)
+               FileErr = 2;
+            ++NCellsFile;
+         }
+         if (!PartFile.eof() || NCellsFile != NCellsGlobal)
+            FileErr = 2;
+         PartFile.clear();
+         PartFile.seekg(0);
+      }
+   }
+   Err = MPI_Bcast(&FileErr, 1, MPI_INT32_T, MasterTask, Comm);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating partition file status");
+      return Err;
+   }
+   if (FileErr == 1) {
+      LOG_INFO("Decomp: partition file {} not found, partitioning mesh",
+               PartFileName);
+      return FileErr;
+   } else if (FileErr != 0) {
+      LOG_WARN("Decomp: partition file {} does not match mesh, "
+               "partitioning mesh",
+               PartFileName);
+      return FileErr;
+   }
+
+   // Distribute the partition, one chunk at a time
+   I4 CellStart = std::min(MyTask * NCellsChunk, NCellsGlobal);
+   I4 CellEnd   = std::min((MyTask + 1) * NCellsChunk, NCellsGlobal);
+   CellTaskChunk.resize(CellEnd - CellStart);
+
+   if (IsMaster) {
+      std::vector<I4> ChunkBuf(NCellsChunk);
+      for (int Task = 0; Task < NumTasks; ++Task) {
+         I4 TaskStart  = std::min(Task * NCellsChunk, NCellsGlobal);
+         I4 TaskEnd    = std::min((Task + 1) * NCellsChunk, NCellsGlobal);
+         I4 NCellsTask = TaskEnd - TaskStart;
+         for (int Cell = 0; Cell < NCellsTask; ++Cell)
+            PartFile >> ChunkBuf[Cell];
+         if (Task == MyTask) {
+            for (int Cell = 0; Cell < NCellsTask; ++Cell)
+               CellTaskChunk[Cell] = ChunkBuf[Cell];
+         } else {
+            Err = MPI_Send(ChunkBuf.data(), NCellsTask, MPI_INT32_T, Task, 0,
+                           Comm);
+         }
+      }
+   } else {
+      Err = MPI_Recv(CellTaskChunk.data(), CellTaskChunk.size(), MPI_INT32_T,
+                     MasterTask, 0, Comm, MPI_STATUS_IGNORE);
+   }
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating cell partition");
+      return Err;
+   }
+
+   LOG_INFO("Decomp: read cell partition from {}", PartFileName);
+
+   return Err;
+
+} // end function readPartFile
+
+//------------------------------------------------------------------------------
+// Writes the cell partition to the partition file in the format described
+// in readPartFile. Each task sends its chunk of the partition in the initial
+// linear distribution to the master task, which writes the chunks in order.
+// Failure to write the file is not fatal, since the partition only serves as
+// a cache for later runs.
+
+int Decomp::writePartFile(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    const std::vector<I4> &CellTaskChunk // [in] task for cells in linear distrb
+) {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+   I4 MasterTask = InEnv->getMasterTask();
+   bool IsMaster = InEnv->isMasterTask();
+
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+
+   // Open the file on the master task and let all tasks know whether
+   // the file can be written
+   std::ofstream PartFile;
+   I4 FileErr = 0;
+   if (IsMaster) {
+      PartFile.open(PartFileName);
+      if (!PartFile)
+         FileErr = 1;
+   }
+   Err = MPI_Bcast(&FileErr, 1, MPI_INT32_T, MasterTask, Comm);
+   if (Err != 0 || FileErr != 0) {
+      LOG_WARN("Decomp: unable to write partition file {}", PartFileName);
+      return Err != 0 ? Err : FileErr;
+   }
+
+   if (IsMaster) {
+      std::vector<I4> ChunkBuf(NCellsChunk);
+      for (int Task = 0; Task < NumTasks; ++Task) {
+         I4 TaskStart  = std::min(Task * NCellsChunk, NCellsGlobal);
+         I4 TaskEnd    = std::min((Task + 1) * NCellsChunk, NCellsGlobal);
+         I4 NCellsTask = TaskEnd - TaskStart;
+         if (Task == MyTask) {
+            for (int Cell = 0; Cell < NCellsTask; ++Cell)
+               ChunkBuf[Cell] = CellTaskChunk[Cell];
+         } else {
+            Err = MPI_Recv(ChunkBuf.data(), NCellsTask, MPI_INT32_T, Task, 0,
+                           Comm, MPI_STATUS_IGNORE);
+         }
+         for (int Cell = 0; Cell < NCellsTask; ++Cell)
+            PartFile << ChunkBuf[Cell] << "\n";
+      }
+      PartFile.close();
+   } else {
+      Err = MPI_Send(CellTaskChunk.data(), CellTaskChunk.size(), MPI_INT32_T,
+                     MasterTask, 0, Comm);
+   }
+   if (Err != 0) {
+      LOG_WARN("Decomp: Error writing partition file {}", PartFileName);
+      return Err;
+   }
+
+   LOG_INFO("Decomp: wrote cell partition to {}", PartFileName);
+
+   return Err;
+
+} // end function writePartFile
+
+//------------------------------------------------------------------------------
+// Create the device copies of all host arrays of the decomposition
+
+void Decomp::copyToDevice() {
+
+   NCellsHalo = createDeviceMirrorCopy(NCellsHaloH);
+   CellID     = createDeviceMirrorCopy(CellIDH);
+   CellLoc    = createDeviceMirrorCopy(CellLocH);
+
+   NEdgesHalo = createDeviceMirrorCopy(NEdgesHaloH);
+   EdgeID     = createDeviceMirrorCopy(EdgeIDH);
+   EdgeLoc    = createDeviceMirrorCopy(EdgeLocH);
+
+   NVerticesHalo = createDeviceMirrorCopy(NVerticesHaloH);
+   VertexID      = createDeviceMirrorCopy(VertexIDH);
+   VertexLoc     = createDeviceMirrorCopy(VertexLocH);
+
+   CellsOnCell    = createDeviceMirrorCopy(CellsOnCellH);
+   EdgesOnCell    = createDeviceMirrorCopy(EdgesOnCellH);
+   VerticesOnCell = createDeviceMirrorCopy(VerticesOnCellH);
+   NEdgesOnCell   = createDeviceMirrorCopy(NEdgesOnCellH);
+
+   CellsOnEdge    = createDeviceMirrorCopy(CellsOnEdgeH);
+   EdgesOnEdge    = createDeviceMirrorCopy(EdgesOnEdgeH);
+   VerticesOnEdge = createDeviceMirrorCopy(VerticesOnEdgeH);
+   NEdgesOnEdge   = createDeviceMirrorCopy(NEdgesOnEdgeH);
+
+   CellsOnVertex = createDeviceMirrorCopy(CellsOnVertexH);
+   EdgesOnVertex = createDeviceMirrorCopy(EdgesOnVertexH);
+
+
+} // end function copyToDevice
+
+//------------------------------------------------------------------------------
+// Release the host copies of the arrays that have a device copy
+
+void Decomp::releaseHostArrays() {
+
+   forEachHostArray(*this, [](auto &HostArr, const auto &DevArr) {
+      releaseHostMirror(HostArr, DevArr);
+   });
+
+} // end function releaseHostArrays
+
+//------------------------------------------------------------------------------
+// Returns the configuration of a decomposition snapshot. It includes the
+// task layout, the partition options and a hash of the mesh file name and
+// weight fields, so that a snapshot is only reused for the same mesh and
+// options.
+
+std::vector<I4> Decomp::snapshotConfig(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    I4 NParts,            // [in] num of partitions
+    PartMethod Method,    // [in] method for partitioning
+    CellOrder Order,      // [in] ordering of owned cells
+    const std::vector<std::string> &CellWeightNames // [in] weight fields
+) const {
+
+   std::string WeightNames;
+   for (const std::string &WeightName : CellWeightNames)
+      WeightNames += WeightName + ";";
+
+   return {InEnv->getNumTasks(),
+           InEnv->getMyTask(),
+           NParts,
+           Method,
+           HaloWidth,
+           Order,
+           snapshotHash(MeshFileName),
+           snapshotHash(WeightNames)};
+
+} // end function snapshotConfig
+
+//------------------------------------------------------------------------------
+// Restores the decomposition sizes and host arrays from the snapshot file of
+// the local task. The snapshot is only used if the files of all tasks exist
+// and match the configuration.
+
+int Decomp::readSnapshot(
+    const MachEnv *InEnv,         // [in] input machine environment with MPI
+    const std::vector<I4> &Config // [in] configuration of the snapshot
+) {
+
+   SnapshotReader Snapshot;
+   int Err = Snapshot.open(snapshotFileName(SnapshotName, "decomp",
+                                            InEnv->getComm()),
+                           Config, InEnv->getComm());
+   if (Err != 0)
+      return Err;
+
+   std::vector<I4> Sizes;
+   Err = Snapshot.getVector("Sizes", Sizes);
+   if (Err == 0 && Sizes.size() == 15) {
+      NCellsGlobal    = Sizes[0];
+      NCellsOwned     = Sizes[1];
+      NCellsAll       = Sizes[2];
+      NCellsSize      = Sizes[3];
+      MaxEdges        = Sizes[4];
+      NEdgesGlobal    = Sizes[5];
+      NEdgesOwned     = Sizes[6];
+      NEdgesAll       = Sizes[7];
+      NEdgesSize      = Sizes[8];
+      MaxCellsOnEdge  = Sizes[9];
+      NVerticesGlobal = Sizes[10];
+      NVerticesOwned  = Sizes[11];
+      NVerticesAll    = Sizes[12];
+      NVerticesSize   = Sizes[13];
+      VertexDegree    = Sizes[14];
+   } else {
+      Err = 1;
+   }
+
+   Err += Snapshot.getArray("NCellsHalo", NCellsHaloH);
+   Err += Snapshot.getArray("CellID", CellIDH);
+   Err += Snapshot.getArray("CellLoc", CellLocH);
+   Err += Snapshot.getArray("NEdgesHalo", NEdgesHaloH);
+   Err += Snapshot.getArray("EdgeID", EdgeIDH);
+   Err += Snapshot.getArray("EdgeLoc", EdgeLocH);
+   Err += Snapshot.getArray("NVerticesHalo", NVerticesHaloH);
+   Err += Snapshot.getArray("VertexID", VertexIDH);
+   Err += Snapshot.getArray("VertexLoc", VertexLocH);
+   Err += Snapshot.getArray("CellsOnCell", CellsOnCellH);
+   Err += Snapshot.getArray("EdgesOnCell", EdgesOnCellH);
+   Err += Snapshot.getArray("NEdgesOnCell", NEdgesOnCellH);
+   Err += Snapshot.getArray("VerticesOnCell", VerticesOnCellH);
+   Err += Snapshot.getArray("CellsOnEdge", CellsOnEdgeH);
+   Err += Snapshot.getArray("EdgesOnEdge", EdgesOnEdgeH);
+   Err += Snapshot.getArray("NEdgesOnEdge", NEdgesOnEdgeH);
+   Err += Snapshot.getArray("VerticesOnEdge", VerticesOnEdgeH);
+   Err += Snapshot.getArray("CellsOnVertex", CellsOnVertexH);
+   Err += Snapshot.getArray("EdgesOnVertex", EdgesOnVertexH);
+
+   // A snapshot that matches the configuration but is incomplete on any
+   // task can not be used
+   I4 LocErr = Err;
+   MPI_Allreduce(&LocErr, &Err, 1, MPI_INT32_T, MPI_MAX, InEnv->getComm());
+   if (Err != 0) {
+      LOG_WARN("Decomp: snapshot {} is incomplete, partitioning mesh",
+               SnapshotName);
+      return Err;
+   }
+
+   LOG_INFO("Decomp: restored decomposition from snapshot {}", SnapshotName);
+
+   return Err;
+
+} // end function readSnapshot
+
+//------------------------------------------------------------------------------
+// Writes the decomposition sizes and host arrays to the snapshot file of the
+// local task. Failure to write the snapshot is not fatal, since it only
+// serves as a cache for later runs.
+
+int Decomp::writeSnapshot(
+    const MachEnv *InEnv,         // [in] input machine environment with MPI
+    const std::vector<I4> &Config // [in] configuration of the snapshot
+) const {
+
+   SnapshotWriter Snapshot(
+       snapshotFileName(SnapshotName, "decomp", InEnv->getComm()), Config);
+
+   Snapshot.addVector("Sizes",
+                      {NCellsGlobal, NCellsOwned, NCellsAll, NCellsSize,
+                       MaxEdges, NEdgesGlobal, NEdgesOwned, NEdgesAll,
+                       NEdgesSize, MaxCellsOnEdge, NVerticesGlobal,
+                       NVerticesOwned, NVerticesAll, NVerticesSize,
+                       VertexDegree});
+
+   Snapshot.addArray("NCellsHalo", NCellsHaloH);
+   Snapshot.addArray("CellID", CellIDH);
+   Snapshot.addArray("CellLoc", CellLocH);
+   Snapshot.addArray("NEdgesHalo", NEdgesHaloH);
+   Snapshot.addArray("EdgeID", EdgeIDH);
+   Snapshot.addArray("EdgeLoc", EdgeLocH);
+   Snapshot.addArray("NVerticesHalo", NVerticesHaloH);
+   Snapshot.addArray("VertexID", VertexIDH);
+   Snapshot.addArray("VertexLoc", VertexLocH);
+   Snapshot.addArray("CellsOnCell", CellsOnCellH);
+   Snapshot.addArray("EdgesOnCell", EdgesOnCellH);
+   Snapshot.addArray("NEdgesOnCell", NEdgesOnCellH);
+   Snapshot.addArray("VerticesOnCell", VerticesOnCellH);
+   Snapshot.addArray("CellsOnEdge", CellsOnEdgeH);
+   Snapshot.addArray("EdgesOnEdge", EdgesOnEdgeH);
+   Snapshot.addArray("NEdgesOnEdge", NEdgesOnEdgeH);
+   Snapshot.addArray("VerticesOnEdge", VerticesOnEdgeH);
+   Snapshot.addArray("CellsOnVertex", CellsOnVertexH);
+   Snapshot.addArray("EdgesOnVertex", EdgesOnVertexH);
+
+   int Err = Snapshot.write();
+   if (Err != 0)
+      LOG_WARN("Decomp: unable to write snapshot {}", SnapshotName);
+
+   return Err;
+
+} // end function writeSnapshot
 
 //------------------------------------------------------------------------------
 // Partition the edges based on the cell decomposition. The first cell ID in
@@ -1169,6 +2359,9 @@ int Decomp::partEdges(
       EdgeLocTmp(Edge, 1) = NEdgesAll;
    }
 
+   // Sort the local edge IDs for the searches below
+   const auto LocalIDs = sortLocalIDs(EdgeIDTmp, NEdgesAll);
+
    for (int Task = 0; Task < NumTasks; ++Task) {
 
       // fill broadcast buffer with the list of owned edges. The
@@ -1183,17 +2376,18 @@ int Decomp::partEdges(
       // Broadcast the list of edges owned by this task
       Err = MPI_Bcast(&EdgeBuf[0], 2 * NEdgesChunk, MPI_INT32_T, Task, Comm);
 
-      // For each edge in the buffer, search the full list of edges on
-      // this task and store the location
+      // For each edge in the buffer, look up its local address in the
+      // sorted list of edges on this task and store the location.
+      // The edges in the buffer are unique so the loop is parallel.
       I4 BufOwned = EdgeBuf[0];
-      for (int BufEdge = 0; BufEdge < BufOwned; ++BufEdge) {
+      hostParallelFor("partEdgesLoc", BufOwned, [&](int BufEdge) {
          I4 GlobID = EdgeBuf[BufEdge + 1];
-         I4 Edge   = srchVector(EdgeIDTmp, GlobID);
+         I4 Edge   = findLocalIndex(LocalIDs, GlobID, NEdgesAll);
          if (Edge < NEdgesAll) {
             EdgeLocTmp(Edge, 0) = Task;    // Task that owns edge
             EdgeLocTmp(Edge, 1) = BufEdge; // Local address on task
          }
-      }
+      });
    }
 
    // Copy ID and location arrays into permanent storage
@@ -1407,6 +2601,9 @@ int Decomp::partVertices(
       VertexLocTmp(Vrtx, 1) = NVerticesAll;
    }
 
+   // Sort the local vertex IDs for the searches below
+   const auto LocalIDs = sortLocalIDs(VertexIDTmp, NVerticesAll);
+
    for (int Task = 0; Task < NumTasks; ++Task) {
 
       // fill broadcast buffer with the list of owned vertices. The
@@ -1421,17 +2618,18 @@ int Decomp::partVertices(
       // Broadcast the list of edges owned by this task
       Err = MPI_Bcast(&VrtxBuf[0], 2 * NVerticesChunk, MPI_INT32_T, Task, Comm);
 
-      // For each vertex in the buffer, search the full list of vertices on
-      // this task and store the location
+      // For each vertex in the buffer, look up its local address in the
+      // sorted list of vertices on this task and store the location.
+      // The vertices in the buffer are unique so the loop is parallel.
       I4 BufOwned = VrtxBuf[0];
-      for (int BufVrtx = 0; BufVrtx < BufOwned; ++BufVrtx) {
+      hostParallelFor("partVerticesLoc", BufOwned, [&](int BufVrtx) {
          I4 GlobID = VrtxBuf[BufVrtx + 1];
-         I4 Vrtx   = srchVector(VertexIDTmp, GlobID);
+         I4 Vrtx   = findLocalIndex(LocalIDs, GlobID, NVerticesAll);
          if (Vrtx < NVerticesAll) {
             VertexLocTmp(Vrtx, 0) = Task;    // Task that owns vertex
             VertexLocTmp(Vrtx, 1) = BufVrtx; // Local address on task
          }
-      }
+      });
    }
 
    // Copy ID and location arrays into permanent storage
@@ -1509,50 +2707,41 @@ int Decomp::rearrangeCellArrays(
          return Err;
       }
 
-      // For each cell in the message buffer, look through the local
-      // cell IDs and if this task has the cell in either the owned or
-      // halo entries, fill the cell arrays. For edges, we prune the
-      // non-active edges and track the number of edges.
-      for (int Cell = 0; Cell < NCellsChunk; ++Cell) {
-
-         I4 GlobalID = Task * NCellsChunk + Cell + 1; // IDs are 1-based
-         // if NCellsGlobal did not divide evenly, the last task will
-         // have global IDs out of range so break out of loop in that case
-         if (GlobalID > NCellsGlobal)
-            break;
-
-         // Search through local cell list to determine if a match with
-         // the global ID
-         I4 LocCell = srchVector(CellIDH, GlobalID);
-         if (LocCell < NCellsAll) {
-
-            // Local cell needs the info so extract from the buffer
-            // into the local address. For edges, we only store the
-            // active edges and maintain a count of the edges.
-            I4 EdgeCount = 0;
-            for (int Edge = 0; Edge < MaxEdges; ++Edge) {
-               I4 BufAdd  = Cell * SizePerCell + Edge * 3;
-               I4 NbrCell = CellBuf[BufAdd];
-               I4 NbrVrtx = CellBuf[BufAdd + 1];
-               I4 NbrEdge = CellBuf[BufAdd + 2];
-               if (validCellID(NbrCell)) {
-                  CellsOnCellTmp(LocCell, Edge) = NbrCell;
-               } else {
-                  CellsOnCellTmp(LocCell, Edge) = NCellsGlobal + 1;
-               }
-               if (validVertexID(NbrVrtx)) {
-                  VerticesOnCellTmp(LocCell, Edge) = NbrVrtx;
-               } else {
-                  VerticesOnCellTmp(LocCell, Edge) = NVerticesGlobal + 1;
-               }
-               if (validEdgeID(NbrEdge)) {
-                  EdgesOnCellTmp(LocCell, EdgeCount) = NbrEdge;
-                  EdgeCount++;
-               }
+      // Each local cell (owned or halo) with a global ID in this chunk
+      // extracts its entries from the message buffer. The local cells are
+      // independent so they are filled in parallel.
+      const I4 ChunkStart = Task * NCellsChunk + 1; // IDs are 1-based
+      hostParallelFor("rearrangeCells", NCellsAll, [&](int LocCell) {
+         I4 Cell = CellIDH(LocCell) - ChunkStart;
+         if (Cell < 0 || Cell >= NCellsChunk)
+            return;
+
+         // Local cell needs the info so extract from the buffer
+         // into the local address. For edges, we only store the
+         // active edges and maintain a count of the edges.
+         I4 EdgeCount = 0;
+         for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+            I4 BufAdd  = Cell * SizePerCell + Edge * 3;
+            I4 NbrCell = CellBuf[BufAdd];
+            I4 NbrVrtx = CellBuf[BufAdd + 1];
+            I4 NbrEdge = CellBuf[BufAdd + 2];
+            if (validCellID(NbrCell)) {
+               CellsOnCellTmp(LocCell, Edge) = NbrCell;
+            } else {
+               CellsOnCellTmp(LocCell, Edge) = NCellsGlobal + 1;
+            }
+            if (validVertexID(NbrVrtx)) {
+               VerticesOnCellTmp(LocCell, Edge) = NbrVrtx;
+            } else {
+               VerticesOnCellTmp(LocCell, Edge) = NVerticesGlobal + 1;
             }
-            NEdgesOnCellTmp(LocCell) = EdgeCount;
-         } // end if local cell
-      } // end loop over chunk of global cells
+            if (validEdgeID(NbrEdge)) {
+               EdgesOnCellTmp(LocCell, EdgeCount) = NbrEdge;
+               EdgeCount++;
+            }
+         }
+         NEdgesOnCellTmp(LocCell) = EdgeCount;
+      });
    } // end loop over MPI tasks
 
    // Copy to final location on host - wait to create device copies until
@@ -1643,52 +2832,43 @@ int Decomp::rearrangeEdgeArrays(
          return Err;
       }
 
-      // For each edge in the message buffer, look through the local
-      // edge IDs and if this task has the edge in either the owned or
-      // halo entries, fill the edge arrays. For EdgesOnEdge, we prune the
-      // non-active edges and track the number of active entries.
-      for (int Edge = 0; Edge < NEdgesChunk; ++Edge) {
-
-         I4 GlobalID = Task * NEdgesChunk + Edge + 1; // IDs are 1-based
-         // if NEdgesGlobal did not divide evenly, the last task will
-         // have global IDs out of range so break out of loop in that case
-         if (GlobalID > NEdgesGlobal)
-            break;
-
-         // Search through local edge list to determine if a match with
-         // the global ID
-         I4 LocEdge = srchVector(EdgeIDH, GlobalID);
-         if (LocEdge < NEdgesAll) {
-
-            // Local task owns this edge so extract the array info
-            // into the local address. For edges, we only store the
-            // active edges and maintain a count of the edges.
-            I4 BufAdd = Edge * SizePerEdge;
-            for (int Cell = 0; Cell < MaxCellsOnEdge; ++Cell) {
-               CellsOnEdgeTmp(LocEdge, Cell) = EdgeBuf[BufAdd];
-               ++BufAdd;
-            }
-            for (int Vrtx = 0; Vrtx < 2; ++Vrtx) {
-               VerticesOnEdgeTmp(LocEdge, Vrtx) = EdgeBuf[BufAdd];
-               ++BufAdd;
-            }
-            // In the EdgeOnEdge array, a zero entry must be kept in
-            // place but assigned the boundary value NEdgesGlobal+1
-            I4 EdgeCount = 0;
-            for (int NbrEdge = 0; NbrEdge < 2 * MaxEdges; ++NbrEdge) {
-               I4 EdgeID = EdgeBuf[BufAdd];
-               ++BufAdd;
-               if (EdgeID == 0) {
-                  EdgesOnEdgeTmp(LocEdge, EdgeCount) = NEdgesGlobal + 1;
-                  EdgeCount++;
-               } else if (validEdgeID(EdgeID)) {
-                  EdgesOnEdgeTmp(LocEdge, EdgeCount) = EdgeID;
-                  EdgeCount++;
-               }
+      // Each local edge (owned or halo) with a global ID in this chunk
+      // extracts its entries from the message buffer. The local edges are
+      // independent so they are filled in parallel.
+      const I4 ChunkStart = Task * NEdgesChunk + 1; // IDs are 1-based
+      hostParallelFor("rearrangeEdges", NEdgesAll, [&](int LocEdge) {
+         I4 Edge = EdgeIDH(LocEdge) - ChunkStart;
+         if (Edge < 0 || Edge >= NEdgesChunk)
+            return;
+
+         // Local task owns this edge so extract the array info
+         // into the local address. For edges, we only store the
+         // active edges and maintain a count of the edges.
+         I4 BufAdd = Edge * SizePerEdge;
+         for (int Cell = 0; Cell < MaxCellsOnEdge; ++Cell) {
+            CellsOnEdgeTmp(LocEdge, Cell) = EdgeBuf[BufAdd];
+            ++BufAdd;
+         }
+         for (int Vrtx = 0; Vrtx < 2; ++Vrtx) {
+            VerticesOnEdgeTmp(LocEdge, Vrtx) = EdgeBuf[BufAdd];
+            ++BufAdd;
+         }
+         // In the EdgeOnEdge array, a zero entry must be kept in
+         // place but assigned the boundary value NEdgesGlobal+1
+         I4 EdgeCount = 0;
+         for (int NbrEdge = 0; NbrEdge < 2 * MaxEdges; ++NbrEdge) {
+            I4 EdgeID = EdgeBuf[BufAdd];
+            ++BufAdd;
+            if (EdgeID == 0) {
+               EdgesOnEdgeTmp(LocEdge, EdgeCount) = NEdgesGlobal + 1;
+               EdgeCount++;
+            } else if (validEdgeID(EdgeID)) {
+               EdgesOnEdgeTmp(LocEdge, EdgeCount) = EdgeID;
+               EdgeCount++;
             }
-            NEdgesOnEdgeTmp(LocEdge) = EdgeCount;
-         } // end if local cell
-      } // end loop over chunk of global cells
+         }
+         NEdgesOnEdgeTmp(LocEdge) = EdgeCount;
+      });
    } // end loop over MPI tasks
 
    // Copy to final location on host - wait to create device copies until
@@ -1769,35 +2949,27 @@ int Decomp::rearrangeVertexArrays(
          return Err;
       }
 
-      // For each vertex in the message buffer, look through the local
-      // vertex IDs and if this task has the vertex in either the owned or
-      // halo entries, fill the vertex arrays.
-      for (int Vrtx = 0; Vrtx < NVerticesChunk; ++Vrtx) {
-
-         I4 GlobalID = Task * NVerticesChunk + Vrtx + 1; // IDs are 1-based
-         // if NVerticesGlobal did not divide evenly, the last task will
-         // have global IDs out of range so break out of loop in that case
-         if (GlobalID > NVerticesGlobal)
-            break;
-
-         // Search through local vertex list to determine if a match with
-         // the global ID
-         I4 LocVrtx = srchVector(VertexIDH, GlobalID);
-         if (LocVrtx < NVerticesAll) {
-
-            // Local task owns this vertex so extract the array info
-            // into the local address.
-            I4 BufAdd = Vrtx * SizePerVrtx;
-            for (int Cell = 0; Cell < VertexDegree; ++Cell) {
-               CellsOnVertexTmp(LocVrtx, Cell) = VrtxBuf[BufAdd];
-               ++BufAdd;
-            }
-            for (int Edge = 0; Edge < VertexDegree; ++Edge) {
-               EdgesOnVertexTmp(LocVrtx, Edge) = VrtxBuf[BufAdd];
-               ++BufAdd;
-            }
-         } // end if local cell
-      } // end loop over chunk of global cells
+      // Each local vertex (owned or halo) with a global ID in this chunk
+      // extracts its entries from the message buffer. The local vertices are
+      // independent so they are filled in parallel.
+      const I4 ChunkStart = Task * NVerticesChunk + 1; // IDs are 1-based
+      hostParallelFor("rearrangeVertices", NVerticesAll, [&](int LocVrtx) {
+         I4 Vrtx = VertexIDH(LocVrtx) - ChunkStart;
+         if (Vrtx < 0 || Vrtx >= NVerticesChunk)
+            return;
+
+         // Local task owns this vertex so extract the array info
+         // into the local address.
+         I4 BufAdd = Vrtx * SizePerVrtx;
+         for (int Cell = 0; Cell < VertexDegree; ++Cell) {
+            CellsOnVertexTmp(LocVrtx, Cell) = VrtxBuf[BufAdd];
+            ++BufAdd;
+         }
+         for (int Edge = 0; Edge < VertexDegree; ++Edge) {
+            EdgesOnVertexTmp(LocVrtx, Edge) = VrtxBuf[BufAdd];
+            ++BufAdd;
+         }
+      });
    } // end loop over MPI tasks
 
    // Copy to final location on host - wait to create device copies until
@@ -1821,10 +2993,17 @@ PartMethod getPartMethodFromStr(const std::string &InMethod) {
                   [](unsigned char c) { return std::tolower(c); });
 
    // Check supported methods and return appropriate enum
-   // Currently, only the METIS/ParMETIS KWay option is supported
+   // Currently, only the METIS and ParMETIS KWay options are supported,
+   // with an optional two-level (node-aware) form of the METIS KWay method
    if (MethodComp == "metiskway") {
       return PartMethodMetisKWay;
 
+   } else if (MethodComp == "parmetiskway") {
+      return PartMethodParMetisKWay;
+
+   } else if (MethodComp == "metiskwaynode") {
+      return PartMethodMetisKWayNode;
+
    } else {
       return PartMethodUnknown;
 
@@ -1832,9 +3011,182 @@ PartMethod getPartMethodFromStr(const std::string &InMethod) {
 
 } // End getPartMethodFromStr
 
+//------------------------------------------------------------------------------
+// Utility routine to convert a cell ordering string into CellOrder enum
+
+CellOrder getCellOrderFromStr(const std::string &InOrder) {
+
+   // convert string to lower case for easier equivalence checking
+   std::string OrderComp = InOrder;
+   std::transform(OrderComp.begin(), OrderComp.end(), OrderComp.begin(),
+                  [](unsigned char c) { return std::tolower(c); });
+
+   // Check supported orderings and return appropriate enum
+   if (OrderComp == "natural") {
+      return CellOrderNatural;
+
+   } else if (OrderComp == "rcm") {
+      return CellOrderRCM;
+
+   } else {
+      return CellOrderUnknown;
+
+   } // end branch on order string
+
+} // End getCellOrderFromStr
+
 //------------------------------------------------------------------------------
 // end Decomp methods
 
+//------------------------------------------------------------------------------
+// Construct a migration between two decompositions. The task holding each
+// element in a linear distribution of the global IDs serves as a directory:
+// the new owners first register the new location of their owned elements
+// with the directory, the old owners then look up the new location of their
+// owned elements and finally send the new local index to the new owner so
+// that both sides know the order of the values in each message.
+
+Migration::Migration(const MachEnv *InEnv,    // [in] MachEnv for both decomps
+                     const Decomp *OldDecomp, // [in] decomp to migrate from
+                     const Decomp *NewDecomp, // [in] decomp to migrate to
+                     MeshElement Elem         // [in] index space of arrays
+) {
+
+   int Err = 0;
+
+   // Retrieve some info on the MPI layout
+   Comm        = InEnv->getComm();
+   I4 NumTasks = InEnv->getNumTasks();
+   I4 MyTask   = InEnv->getMyTask();
+
+   // Determine the sizes and owned element IDs for this index space
+   I4 NGlobal;
+   I4 NOldOwned;
+   I4 NNewOwned;
+   HostArray1DI4 OldIDH;
+   HostArray1DI4 NewIDH;
+   switch (Elem) {
+   case OnCell:
+      NGlobal   = OldDecomp->NCellsGlobal;
+      NOldOwned = OldDecomp->NCellsOwned;
+      NNewOwned = NewDecomp->NCellsOwned;
+      NOldSize  = OldDecomp->NCellsSize;
+      NNewSize  = NewDecomp->NCellsSize;
+      OldIDH    = OldDecomp->getHost(OldDecomp->CellIDH);
+      NewIDH    = NewDecomp->getHost(NewDecomp->CellIDH);
+      break;
+   case OnEdge:
+      NGlobal   = OldDecomp->NEdgesGlobal;
+      NOldOwned = OldDecomp->NEdgesOwned;
+      NNewOwned = NewDecomp->NEdgesOwned;
+      NOldSize  = OldDecomp->NEdgesSize;
+      NNewSize  = NewDecomp->NEdgesSize;
+      OldIDH    = OldDecomp->getHost(OldDecomp->EdgeIDH);
+      NewIDH    = NewDecomp->getHost(NewDecomp->EdgeIDH);
+      break;
+   case OnVertex:
+      NGlobal   = OldDecomp->NVerticesGlobal;
+      NOldOwned = OldDecomp->NVerticesOwned;
+      NNewOwned = NewDecomp->NVerticesOwned;
+      NOldSize  = OldDecomp->NVerticesSize;
+      NNewSize  = NewDecomp->NVerticesSize;
+      OldIDH    = OldDecomp->getHost(OldDecomp->VertexIDH);
+      NewIDH    = NewDecomp->getHost(NewDecomp->VertexIDH);
+      break;
+   }
+
+   I4 NChunk    = (NGlobal - 1) / NumTasks + 1;
+   I4 ChunkBase = std::min(MyTask * NChunk, NGlobal);
+   I4 NLocal    = std::min(ChunkBase + NChunk, NGlobal) - ChunkBase;
+
+   // Register the (ID, new local index) of each new owned element with the
+   // directory task
+   std::vector<I4> Count(NumTasks, 0);
+   std::vector<I4> Add(NumTasks, 0);
+   for (int n = 0; n < NNewOwned; ++n)
+      Count[(NewIDH(n) - 1) / NChunk] += 2;
+   for (int Task = 1; Task < NumTasks; ++Task)
+      Add[Task] = Add[Task - 1] + Count[Task - 1];
+   std::vector<I4> Buf(2 * NNewOwned);
+   for (int n = 0; n < NNewOwned; ++n) {
+      I4 Task            = (NewIDH(n) - 1) / NChunk;
+      Buf[Add[Task]]     = NewIDH(n);
+      Buf[Add[Task] + 1] = n;
+      Add[Task] += 2;
+   }
+   std::vector<I4> DirBuf;
+   std::vector<I4> DirCount;
+   Err = exchangeLists(Buf, Count, DirBuf, DirCount, Comm);
+   if (Err != 0)
+      LOG_CRITICAL("Migration: error registering new element locations");
+
+   std::vector<I4> DirTask(NLocal, 0);
+   std::vector<I4> DirIndx(NLocal, 0);
+   I4 DirAdd = 0;
+   for (int Task = 0; Task < NumTasks; ++Task) {
+      for (int n = 0; n < DirCount[Task]; n += 2) {
+         I4 Local       = DirBuf[DirAdd + n] - 1 - ChunkBase;
+         DirTask[Local] = Task;
+         DirIndx[Local] = DirBuf[DirAdd + n + 1];
+      }
+      DirAdd += DirCount[Task];
+   }
+
+   // Look up the new location of each old owned element
+   std::fill(Count.begin(), Count.end(), 0);
+   for (int n = 0; n < NOldOwned; ++n)
+      ++Count[(OldIDH(n) - 1) / NChunk];
+   Add[0] = 0;
+   for (int Task = 1; Task < NumTasks; ++Task)
+      Add[Task] = Add[Task - 1] + Count[Task - 1];
+   std::vector<I4> ReqIndx(NOldOwned); // old index of each request
+   Buf.resize(NOldOwned);
+   for (int n = 0; n < NOldOwned; ++n) {
+      I4 Task            = (OldIDH(n) - 1) / NChunk;
+      ReqIndx[Add[Task]] = n;
+      Buf[Add[Task]]     = OldIDH(n);
+      ++Add[Task];
+   }
+   Err = exchangeLists(Buf, Count, DirBuf, DirCount, Comm);
+   if (Err != 0)
+      LOG_CRITICAL("Migration: error requesting new element locations");
+
+   std::vector<I4> ReplyBuf(2 * DirBuf.size());
+   for (int n = 0; n < DirBuf.size(); ++n) {
+      I4 Local            = DirBuf[n] - 1 - ChunkBase;
+      ReplyBuf[2 * n]     = DirTask[Local];
+      ReplyBuf[2 * n + 1] = DirIndx[Local];
+   }
+   for (int Task = 0; Task < NumTasks; ++Task)
+      DirCount[Task] *= 2;
+   std::vector<I4> LocBuf;
+   std::vector<I4> LocCount;
+   Err = exchangeLists(ReplyBuf, DirCount, LocBuf, LocCount, Comm);
+   if (Err != 0)
+      LOG_CRITICAL("Migration: error retrieving new element locations");
+
+   // Sort the old owned elements by destination task and send the new
+   // local index of each element to its new owner
+   SendCount.assign(NumTasks, 0);
+   for (int n = 0; n < NOldOwned; ++n)
+      ++SendCount[LocBuf[2 * n]];
+   Add[0] = 0;
+   for (int Task = 1; Task < NumTasks; ++Task)
+      Add[Task] = Add[Task - 1] + SendCount[Task - 1];
+   SendIndx.resize(NOldOwned);
+   Buf.resize(NOldOwned);
+   for (int n = 0; n < NOldOwned; ++n) {
+      I4 Task             = LocBuf[2 * n];
+      SendIndx[Add[Task]] = ReqIndx[n];
+      Buf[Add[Task]]      = LocBuf[2 * n + 1];
+      ++Add[Task];
+   }
+   Err = exchangeLists(Buf, SendCount, RecvIndx, RecvCount, Comm);
+   if (Err != 0)
+      LOG_CRITICAL("Migration: error communicating migration pattern");
+
+} // end Migration constructor
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
@@ -20,11 +20,15 @@
 //===----------------------------------------------------------------------===//
 
 #include "DataTypes.h"
+#include "Logging.h"
 #include "MachEnv.h"
+#include "OmegaKokkos.h"
 #include "mpi.h"
 #include "parmetis.h"
 
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace OMEGA {
 
@@ -32,11 +36,17 @@ namespace OMEGA {
 /// related to the file itself as well as the contents and size of
 /// the adjacency graph.
 
+/// The meshElement enum identifies the index space to use for a halo exchange
+/// or a migration between decompositions.
+enum MeshElement { OnCell, OnEdge, OnVertex };
+
 /// Supported partitioning methods
 enum PartMethod {
    PartMethodUnknown,   ///< Unknown or undefined method
-   PartMethodMetisKWay, ///< Metis K-way partitioning (default)
-   PartMethodMetisRB    ///< Metis recursive bisection (not yet supported)
+   PartMethodMetisKWay,    ///< Metis K-way partitioning (default)
+   PartMethodParMetisKWay, ///< distributed ParMetis K-way partitioning
+   PartMethodMetisKWayNode, ///< Metis K-way across nodes then within nodes
+   PartMethodMetisRB       ///< Metis recursive bisection (not yet supported)
 };
 
 /// Translates an input string for partition method option to the
@@ -45,6 +55,19 @@ PartMethod getPartMethodFromStr(
     const std::string &InMethod ///< [in] choice of partition method
 );
 
+/// Supported orderings of the owned cells within each partition
+enum CellOrder {
+   CellOrderUnknown, ///< Unknown or undefined ordering
+   CellOrderNatural, ///< Owned cells in global cell ID order (default)
+   CellOrderRCM      ///< Reverse Cuthill-McKee ordering of owned cells
+};
+
+/// Translates an input string for cell ordering option to the
+/// enum for later use
+CellOrder getCellOrderFromStr(
+    const std::string &InOrder ///< [in] choice of cell ordering
+);
+
 /// The Decomp class creates and maintains most of the information related
 /// to the mesh index space and its distribution across partitions or processors
 /// in a parallel domain decomposition. This information includes the location
@@ -65,15 +88,79 @@ class Decomp {
 
    /// Partition cells by calling the METIS/ParMETIS KWay routine
    /// It starts with the CellsOnCell array from the input mesh file
-   /// distributed across tasks in linear contiguous chunks
+   /// distributed across tasks in linear contiguous chunks, and optionally
+   /// NCellWeights weights (balancing constraints) for each cell
    /// On output, it has defined all the NCells sizes (NCellsOwned,
    /// NCellsHalo array, NCellsAll and NCellsSize) and the final CellID
-   /// and CellLoc arrays
+   /// and CellLoc arrays. The owned cells on each task are numbered
+   /// according to the requested cell ordering. If ByNode is true, the
+   /// cells are first partitioned among the nodes of InEnv and then among
+   /// the tasks on each node.
    int partCellsKWay(
-       const MachEnv *InEnv,                  ///< [in] MachEnv with MPI info
-       const std::vector<I4> &CellsOnCellInit ///< [in] cell nbrs in init dstrb
+       const MachEnv *InEnv,                   ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellsOnCellInit, ///< [in] cell nbrs in init dstrb
+       const std::vector<I4> &CellWeightsInit, ///< [in] cell wgts in init dstrb
+       I4 NCellWeights,                        ///< [in] num weights per cell
+       CellOrder Order,                        ///< [in] ordering of owned cells
+       bool ByNode = false                     ///< [in] two-level partition
+   );
+
+   /// Partition cells by calling the distributed ParMETIS KWay routine
+   /// It starts with the CellsOnCell array from the input mesh file
+   /// distributed across tasks in linear contiguous chunks and does not
+   /// require the global adjacency graph on any task. On output, it has
+   /// defined the same NCells sizes and CellID and CellLoc arrays as
+   /// partCellsKWay.
+   int partCellsParMetisKWay(
+       const MachEnv *InEnv,                   ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellsOnCellInit, ///< [in] cell nbrs in init dstrb
+       const std::vector<I4> &CellWeightsInit, ///< [in] cell wgts in init dstrb
+       I4 NCellWeights,                        ///< [in] num weights per cell
+       CellOrder Order                         ///< [in] ordering of owned cells
+   );
+
+   /// Read the task assigned to each cell in the local chunk of the initial
+   /// linear distribution from the partition file. Returns a non-zero
+   /// error code if the file does not exist or does not match the mesh and
+   /// task count, in which case the mesh must be partitioned.
+   int readPartFile(
+       const MachEnv *InEnv,          ///< [in] MachEnv with MPI info
+       std::vector<I4> &CellTaskChunk ///< [out] task for cells in init dstrb
+   );
+
+   /// Write the task assigned to each cell in the local chunk of the initial
+   /// linear distribution to the partition file for reuse in later runs.
+   int writePartFile(
+       const MachEnv *InEnv, ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellTaskChunk ///< [in] task for init dstrb cells
+   );
+
+   /// Returns the configuration stored with a snapshot of the decomposition
+   /// that must match for the snapshot to be reused
+   std::vector<I4> snapshotConfig(
+       const MachEnv *InEnv, ///< [in] MachEnv with MPI info
+       I4 NParts,            ///< [in] num of partitions
+       PartMethod Method,    ///< [in] method for partitioning
+       CellOrder Order,      ///< [in] ordering of owned cells
+       const std::vector<std::string> &CellWeightNames ///< [in] weight fields
+   ) const;
+
+   /// Restore the decomposition from the snapshot of the local task. Returns
+   /// a non-zero error code on all tasks if the snapshots do not exist or do
+   /// not match Config, in which case the mesh must be partitioned.
+   int readSnapshot(const MachEnv *InEnv,          ///< [in] MachEnv with MPI
+                    const std::vector<I4> &Config ///< [in] configuration
    );
 
+   /// Write the decomposition to the snapshot of the local task for reuse
+   /// in later runs with the same configuration
+   int writeSnapshot(const MachEnv *InEnv,          ///< [in] MachEnv with MPI
+                     const std::vector<I4> &Config ///< [in] configuration
+   ) const;
+
+   /// Create the device copies of all host arrays
+   void copyToDevice();
+
    /// Partition the edges given the cell partition and edge connectivity
    /// The first cell ID associated with an edge in the CellsOnEdge array
    /// is assumed to own the edge. The inputs are the edge-cell connectivity
@@ -130,12 +217,36 @@ class Decomp {
        const std::vector<I4> &EdgesOnVertexInit  ///< [in] edges at each vertex
    );
 
+   /// Calls Fn(HostArray, DeviceArray) for each pair of host and device
+   /// arrays that can be released by releaseHostArrays
+   template <typename DecompT, typename F>
+   static void forEachHostArray(DecompT &D, F &&Fn) {
+      Fn(D.CellIDH, D.CellID);
+      Fn(D.CellLocH, D.CellLoc);
+      Fn(D.EdgeIDH, D.EdgeID);
+      Fn(D.EdgeLocH, D.EdgeLoc);
+      Fn(D.VertexIDH, D.VertexID);
+      Fn(D.VertexLocH, D.VertexLoc);
+      Fn(D.CellsOnCellH, D.CellsOnCell);
+      Fn(D.EdgesOnCellH, D.EdgesOnCell);
+      Fn(D.NEdgesOnCellH, D.NEdgesOnCell);
+      Fn(D.VerticesOnCellH, D.VerticesOnCell);
+      Fn(D.CellsOnEdgeH, D.CellsOnEdge);
+      Fn(D.EdgesOnEdgeH, D.EdgesOnEdge);
+      Fn(D.NEdgesOnEdgeH, D.NEdgesOnEdge);
+      Fn(D.VerticesOnEdgeH, D.VerticesOnEdge);
+      Fn(D.CellsOnVertexH, D.CellsOnVertex);
+      Fn(D.EdgesOnVertexH, D.EdgesOnVertex);
+   }
+
  public:
    // Variables
    // Since these are used frequently, we make them public to reduce the
    // number of retrievals required.
 
    std::string MeshFileName; ///< The name of the file with mesh info
+   std::string PartFileName; ///< File with cached cell partition (or empty)
+   std::string SnapshotName; ///< Prefix of snapshot files (or empty)
 
    // Sizes and global IDs
    // Note that all sizes are actual counts (1-based) so that loop extents
@@ -222,13 +333,37 @@ class Decomp {
    static int init(const std::string &MeshFileName = "OmegaMesh.nc");
 
    /// Construct a new decomposition across an input MachEnv with
-   /// NPart partitions of a mesh that is read from a mesh file.
+   /// NPart partitions of a mesh that is read from a mesh file. If a
+   /// snapshot prefix is given, the decomposition is restored from the
+   /// snapshot files of an earlier run with the same configuration if they
+   /// exist, otherwise it is computed and the snapshot files are written.
    Decomp(const std::string &Name, ///< [in] Name for new decomposition
           const MachEnv *InEnv,    ///< [in] MachEnv for the new partition
           I4 NParts,               ///< [in] num of partitions for new decomp
           PartMethod Method,       ///< [in] method for partitioning
           I4 InHaloWidth,          ///< [in] width of halo in new decomp
-          const std::string &MeshFileName_ ///< [in] name of file with mesh info
+          const std::string &MeshFileName_, ///< [in] name of file with mesh
+          CellOrder Order = CellOrderNatural, ///< [in] ordering of owned cells
+          const std::string &PartFileName_ = "", ///< [in] file with partition
+          const std::vector<std::string> &CellWeightNames =
+              {}, ///< [in] integer cell fields used as partition weights
+          const std::vector<I4> &CellWeightsIn =
+              {}, ///< [in] cell wgts in init dstrb, replaces CellWeightNames
+          const std::string &SnapshotName_ = "" ///< [in] snapshot prefix
+   );
+
+   /// Creates a new decomposition of the same mesh with a partition that
+   /// balances a measured cost for each owned cell of an existing
+   /// decomposition, eg the time per step of each task divided evenly among
+   /// its owned cells. The new decomposition is stored under NewName and
+   /// uses the same mesh file and halo width as the existing one.
+   static int rebalance(
+       const std::string &NewName, ///< [in] name for the new decomposition
+       const Decomp *OldDecomp,    ///< [in] existing decomposition
+       const MachEnv *InEnv,       ///< [in] MachEnv used by OldDecomp
+       const HostArray1DR8 &CellCost, ///< [in] cost of each owned cell
+       PartMethod Method = PartMethodParMetisKWay, ///< [in] partition method
+       CellOrder Order   = CellOrderNatural ///< [in] ordering of owned cells
    );
 
    /// Destructor - deallocates all memory and deletes a Decomp.
@@ -265,8 +400,149 @@ class Decomp {
    bool validVertexID(I4 InVertexID ///< [in] a vertex ID to check
    );
 
+   /// Releases the host copies of the global IDs, locations and
+   /// connectivity arrays, which are rarely used on the host once their
+   /// device copies exist, to reduce host memory on GPU nodes. The halo
+   /// sizes (NCellsHaloH, etc.) are kept. Nothing is released in host
+   /// builds, where the host and device arrays share memory. Host code that
+   /// may run after the release must access these arrays with getHost.
+   void releaseHostArrays();
+
+   /// Returns the host array Host of this decomposition, eg.
+   /// getHost(CellIDH). If it was released, a host copy of the device array
+   /// is returned instead, which is freed when no longer referenced.
+   template <typename H> H getHost(const H &Host) const {
+      if (Host.data() != nullptr)
+         return Host;
+      H Copy = Host;
+      forEachHostArray(*this, [&](const auto &HostArr, const auto &DevArr) {
+         if constexpr (std::is_same_v<std::decay_t<decltype(HostArr)>, H>) {
+            if (&HostArr == &Host)
+               Copy = createHostMirrorCopy(DevArr);
+         }
+      });
+      return Copy;
+   }
+
 }; // end class Decomp
 
+/// The Migration class redistributes arrays defined on one index space
+/// (cells, edges or vertices) from the owned elements of one decomposition to
+/// the owned elements of another decomposition of the same mesh, for example
+/// after a rebalance. The communication pattern is computed once when the
+/// Migration is constructed and then reused for every array migrated. Only
+/// the owned elements are migrated, so the halo of a migrated array must be
+/// filled with a halo exchange on the new decomposition.
+class Migration {
+
+ private:
+   MPI_Comm Comm;               ///< MPI communicator for both decomps
+   I4 NOldSize;                 ///< first dimension of arrays on old decomp
+   I4 NNewSize;                 ///< first dimension of arrays on new decomp
+   std::vector<I4> SendCount;   ///< num owned elements sent to each task
+   std::vector<I4> SendIndx;    ///< old local index of each sent element
+   std::vector<I4> RecvCount;   ///< num owned elements recvd from each task
+   std::vector<I4> RecvIndx;    ///< new local index of each recvd element
+
+ public:
+   /// Computes the communication pattern to migrate arrays on the index space
+   /// Elem from OldDecomp to NewDecomp. Both decompositions must be defined
+   /// on the same mesh and the same MachEnv.
+   Migration(const MachEnv *InEnv,     ///< [in] MachEnv for both decomps
+             const Decomp *OldDecomp,  ///< [in] decomposition to migrate from
+             const Decomp *NewDecomp,  ///< [in] decomposition to migrate to
+             MeshElement Elem          ///< [in] index space of arrays
+   );
+
+   /// Migrates the owned elements of an array on the old decomposition to a
+   /// previously allocated array on the new decomposition. The first
+   /// dimension of the arrays must be the index space of the Migration, and
+   /// the remaining dimensions must match. Host and device arrays of rank 1
+   /// to 3 are supported.
+   template <typename T>
+   int migrate(const T &OldArray, ///< [in] array on old decomposition
+               T &NewArray        ///< [out] array on new decomposition
+   ) const {
+
+      using ValType = typename T::non_const_value_type;
+
+      int Err = 0;
+
+      // Check the array sizes
+      I4 NVals = OldArray.extent(0) > 0 ? OldArray.size() / OldArray.extent(0)
+                                        : 0;
+      if (OldArray.extent(0) != NOldSize || NewArray.extent(0) != NNewSize ||
+          NewArray.size() != std::size_t(NNewSize) * NVals) {
+         LOG_ERROR("Migration: array sizes do not match decompositions");
+         return -1;
+      }
+
+      // Work with host copies of the arrays
+      auto OldArrayH = createHostMirrorCopy(OldArray);
+      auto NewArrayH = createHostMirrorCopy(NewArray);
+
+      // Pack the owned values in the order they are sent
+      std::vector<ValType> SendBuf(SendIndx.size() * NVals);
+      for (int n = 0; n < SendIndx.size(); ++n) {
+         for (int Val = 0; Val < NVals; ++Val)
+            SendBuf[n * NVals + Val] = elemValue(OldArrayH, SendIndx[n], Val);
+      }
+
+      // Exchange the values, counted in bytes to support all types
+      I4 NumTasks = SendCount.size();
+      I4 ValSize  = NVals * sizeof(ValType);
+      std::vector<int> SendBytes(NumTasks);
+      std::vector<int> RecvBytes(NumTasks);
+      std::vector<int> SendDispl(NumTasks, 0);
+      std::vector<int> RecvDispl(NumTasks, 0);
+      for (int Task = 0; Task < NumTasks; ++Task) {
+         SendBytes[Task] = SendCount[Task] * ValSize;
+         RecvBytes[Task] = RecvCount[Task] * ValSize;
+         if (Task > 0) {
+            SendDispl[Task] = SendDispl[Task - 1] + SendBytes[Task - 1];
+            RecvDispl[Task] = RecvDispl[Task - 1] + RecvBytes[Task - 1];
+         }
+      }
+      std::vector<ValType> RecvBuf(RecvIndx.size() * NVals);
+      Err = MPI_Alltoallv(SendBuf.data(), SendBytes.data(), SendDispl.data(),
+                          MPI_BYTE, RecvBuf.data(), RecvBytes.data(),
+                          RecvDispl.data(), MPI_BYTE, Comm);
+      if (Err != 0) {
+         LOG_ERROR("Migration: error communicating array values");
+         return Err;
+      }
+
+      // Unpack the values at their new location
+      for (int n = 0; n < RecvIndx.size(); ++n) {
+         for (int Val = 0; Val < NVals; ++Val)
+            elemValue(NewArrayH, RecvIndx[n], Val) = RecvBuf[n * NVals + Val];
+      }
+      deepCopy(NewArray, NewArrayH);
+
+      return Err;
+
+   } // end migrate
+
+ private:
+   /// Accesses a value of an array by element index and the flattened index
+   /// of the remaining dimensions
+   template <typename H>
+   static typename H::reference_type elemValue(const H &Array, I4 Elem,
+                                               I4 Val) {
+      static_assert(H::rank >= 1 && H::rank <= 3,
+                    "Migration only supports arrays of rank 1 to 3");
+      if constexpr (H::rank == 1) {
+         return Array(Elem);
+      } else if constexpr (H::rank == 2) {
+         return Array(Elem, Val);
+      } else {
+         I4 N2 = Array.extent(2);
+         return Array(Elem, Val / N2, Val % N2);
+      }
+   }
+
+}; // end class Migration
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
@@ -8,11 +8,16 @@
 // functions are defined here. The Halo class public member function
 // exchangeFullArrayHalo which is called by the user to perform halo
 // exchanges on a given array is a template function and thus is defined
-// in the associated header file, Halo.h.
+// in the associated header file, Halo.h. Device arrays are packed and
+// unpacked on the device with device buffers; if the MPI library is
+// GPU-aware (OMEGA_MPI_ON_DEVICE), the device buffers are passed directly to
+// MPI, otherwise they are staged through host mirrors.
 //
 //===----------------------------------------------------------------------===//
 
 #include "Halo.h"
+#include "MemoryTracker.h"
+#include "Snapshot.h"
 #include "mpi.h"
 #include <algorithm>
 #include <iterator>
@@ -42,6 +47,63 @@ I4 searchVector(const std::vector<I4> &InVector, // vector to search
 
 } // end function searchVector (std::vector)
 
+//------------------------------------------------------------------------------
+// Local routine that flattens the exchange lists of all neighbors for one
+// index space into a single vector for a snapshot. For each neighbor, the
+// vector holds the number of halo layers followed by the size and indices of
+// each layer.
+
+std::vector<I4> flattenLists(
+    const std::vector<std::vector<std::vector<I4>>> &Lists // lists to flatten
+) {
+
+   std::vector<I4> Flat;
+   for (const auto &NghbrList : Lists) {
+      Flat.push_back(NghbrList.size());
+      for (const auto &LayerList : NghbrList) {
+         Flat.push_back(LayerList.size());
+         Flat.insert(Flat.end(), LayerList.begin(), LayerList.end());
+      }
+   }
+
+   return Flat;
+
+} // end function flattenLists
+
+//------------------------------------------------------------------------------
+// Local routine that restores the exchange lists of NNghbr neighbors from a
+// vector created by flattenLists. Returns a non-zero error code if the
+// vector is not consistent with the number of neighbors.
+
+int unflattenLists(
+    const std::vector<I4> &Flat,                     // flattened lists
+    I4 NNghbr,                                       // number of neighbors
+    std::vector<std::vector<std::vector<I4>>> &Lists // restored lists
+) {
+
+   size_t Pos = 0;
+   Lists.resize(NNghbr);
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (Pos >= Flat.size())
+         return 1;
+      I4 NLayers = Flat[Pos++];
+      Lists[INghbr].resize(NLayers);
+      for (int ILayer = 0; ILayer < NLayers; ++ILayer) {
+         if (Pos >= Flat.size())
+            return 1;
+         I4 NList = Flat[Pos++];
+         if (NList < 0 or Pos + NList > Flat.size())
+            return 1;
+         Lists[INghbr][ILayer].assign(Flat.begin() + Pos,
+                                      Flat.begin() + Pos + NList);
+         Pos += NList;
+      }
+   }
+
+   return Pos == Flat.size() ? 0 : 1;
+
+} // end function unflattenLists
+
 //------------------------------------------------------------------------------
 // Construct a new ExchList based on input 2D vector which contains a list
 // of indices sorted by halo layer
@@ -74,6 +136,17 @@ Halo::ExchList::ExchList(
       Offsets[I + 1] = Offsets[I] + NList[I];
    }
 
+   // Collapse the index lists along the halo layer dimension and copy to
+   // the device for use in device pack and unpack kernels
+   IndFlat       = Array1DI4("HaloIndFlat", NTot);
+   auto IndFlatH = Kokkos::create_mirror_view(IndFlat);
+   for (int ILayer = 0; ILayer < HaloLayers; ++ILayer) {
+      for (int IExch = 0; IExch < NList[ILayer]; ++IExch) {
+         IndFlatH(Offsets[ILayer] + IExch) = Ind[ILayer][IExch];
+      }
+   }
+   deepCopy(IndFlat, IndFlatH);
+
 } // end ExchList constructor
 
 // Empty constructor for ExchList class
@@ -135,6 +208,9 @@ Halo::Halo(const std::string &Name, const MachEnv *InEnv,
 
    I4 IErr{0}; // error code
 
+   // Charge the exchange lists to the Halo subsystem
+   MemoryScope Scope("Halo");
+
    // Set pointer for the Decomp
    MyDecomp = InDecomp;
 
@@ -148,37 +224,65 @@ Halo::Halo(const std::string &Name, const MachEnv *InEnv,
    // Fetch the total number of tasks
    I4 NumTasks = InEnv->getNumTasks();
 
-   // Declare 3D vectors to hold lists of indices generated below which are
-   // used to construct a Neighbor for each neighboring task
-   std::vector<std::vector<std::vector<I4>>> RecvCellLists;
-   std::vector<std::vector<std::vector<I4>>> SendCellLists;
-   std::vector<std::vector<std::vector<I4>>> RecvEdgeLists;
-   std::vector<std::vector<std::vector<I4>>> SendEdgeLists;
-   std::vector<std::vector<std::vector<I4>>> RecvVrtxLists;
-   std::vector<std::vector<std::vector<I4>>> SendVrtxLists;
-
-   // Determine which tasks are neighbors to the local task
-   IErr = determineNeighbors(NumTasks);
-   if (IErr != 0)
-      LOG_ERROR("Halo: Error determining neighbors");
-
-   // Generate the exchange lists for each neighboring task in each index space
-   IErr = generateExchangeLists(SendCellLists, RecvCellLists, OnCell);
-   if (IErr != 0)
-      LOG_ERROR("Halo: Error generating exchange lists for Cells");
-   IErr = generateExchangeLists(SendEdgeLists, RecvEdgeLists, OnEdge);
-   if (IErr != 0)
-      LOG_ERROR("Halo: Error generating exchange lists for Edges");
-   IErr = generateExchangeLists(SendVrtxLists, RecvVrtxLists, OnVertex);
-   if (IErr != 0)
-      LOG_ERROR("Halo: Error generating exchange lists for Vertices");
+   // Default to host arrays in full precision until an exchange is requested
+   OnDevice    = false;
+   InProgress  = false;
+   BuffOffset  = 0;
+   ReducedPrec = false;
+
+   // Default to point-to-point communication, the neighborhood communicator
+   // is only created if the neighborhood collective method is selected
+   Method    = PointToPoint;
+   NghbrComm = MPI_COMM_NULL;
+
+   // Declare 3D vectors for each index space to hold lists of indices
+   // generated below which are used to construct a Neighbor for each
+   // neighboring task
+   std::vector<std::vector<std::vector<I4>>> SendLists[3];
+   std::vector<std::vector<std::vector<I4>>> RecvLists[3];
+
+   // Restore the neighbors and exchange lists from a snapshot if one exists
+   // for this decomposition
+   std::vector<I4> SnapshotConfig;
+   bool Restored = false;
+   if (!MyDecomp->SnapshotName.empty()) {
+      SnapshotConfig = snapshotConfig(NumTasks);
+      Restored       = readSnapshot(SnapshotConfig, SendLists, RecvLists) == 0;
+   }
+
+   if (not Restored) {
+      // Determine which tasks are neighbors to the local task
+      IErr = determineNeighbors();
+      if (IErr != 0)
+         LOG_ERROR("Halo: Error determining neighbors");
+
+      // Generate the exchange lists for each neighboring task in each index
+      // space
+      IErr = generateExchangeLists(SendLists[OnCell], RecvLists[OnCell],
+                                   OnCell);
+      if (IErr != 0)
+         LOG_ERROR("Halo: Error generating exchange lists for Cells");
+      IErr = generateExchangeLists(SendLists[OnEdge], RecvLists[OnEdge],
+                                   OnEdge);
+      if (IErr != 0)
+         LOG_ERROR("Halo: Error generating exchange lists for Edges");
+      IErr = generateExchangeLists(SendLists[OnVertex], RecvLists[OnVertex],
+                                   OnVertex);
+      if (IErr != 0)
+         LOG_ERROR("Halo: Error generating exchange lists for Vertices");
+
+      // Save the exchange lists for reuse in later runs
+      if (!SnapshotConfig.empty())
+         writeSnapshot(SnapshotConfig, SendLists, RecvLists);
+   }
 
    // Construct the Neighbor objects and save them in class member Neighbors
    for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-      Neighbors.push_back(Neighbor(SendCellLists[INghbr], SendEdgeLists[INghbr],
-                                   SendVrtxLists[INghbr], RecvCellLists[INghbr],
-                                   RecvEdgeLists[INghbr], RecvVrtxLists[INghbr],
-                                   NeighborList[INghbr]));
+      Neighbors.push_back(Neighbor(
+          SendLists[OnCell][INghbr], SendLists[OnEdge][INghbr],
+          SendLists[OnVertex][INghbr], RecvLists[OnCell][INghbr],
+          RecvLists[OnEdge][INghbr], RecvLists[OnVertex][INghbr],
+          NeighborList[INghbr]));
    }
 
    // Associate this instance with the input name
@@ -192,7 +296,16 @@ Halo::Halo(const std::string &Name, const MachEnv *InEnv,
 
 Halo::~Halo() {
 
-   // No operations necessary
+   // Free any persistent MPI requests
+   for (auto &Entry : Patterns) {
+      freePatternRequests(Entry.second);
+   }
+
+   // Free the neighborhood communicator
+   int Finalized{0};
+   MPI_Finalized(&Finalized);
+   if (NghbrComm != MPI_COMM_NULL and not Finalized)
+      MPI_Comm_free(&NghbrComm);
 
 } // end destructor
 
@@ -245,9 +358,11 @@ Halo *Halo::get(const std::string Name // name of Halo to retrieve
 
 //------------------------------------------------------------------------------
 // Sets Halo class members NeighborList, NNghbr, SendFlags, and RecvFlags during
-// Halo construction
+// Halo construction. The tasks that need locally owned elements are found with
+// a sparse exchange (exchangeHaloMasks), so the cost scales with the number of
+// neighbors rather than the number of tasks in MyComm.
 
-int Halo::determineNeighbors(const I4 NumTasks) {
+int Halo::determineNeighbors() {
 
    I4 IErr{0}; // internal error code
    I4 Err{0};  // error code to return
@@ -261,11 +376,12 @@ int Halo::determineNeighbors(const I4 NumTasks) {
    // create lists of tasks that own elements in the halo of the local task for
    // each index space
    generateListOfTasksInHalo(MyDecomp->NCellsOwned, MyDecomp->NCellsAll,
-                             MyDecomp->CellLocH, CellTasks);
+                             MyDecomp->getHost(MyDecomp->CellLocH), CellTasks);
    generateListOfTasksInHalo(MyDecomp->NEdgesOwned, MyDecomp->NEdgesAll,
-                             MyDecomp->EdgeLocH, EdgeTasks);
+                             MyDecomp->getHost(MyDecomp->EdgeLocH), EdgeTasks);
    generateListOfTasksInHalo(MyDecomp->NVerticesOwned, MyDecomp->NVerticesAll,
-                             MyDecomp->VertexLocH, VertexTasks);
+                             MyDecomp->getHost(MyDecomp->VertexLocH),
+                             VertexTasks);
 
    std::vector<I4> UofCE;
    std::vector<I4> UofCEV;
@@ -277,45 +393,63 @@ int Halo::determineNeighbors(const I4 NumTasks) {
    std::set_union(UofCE.begin(), UofCE.end(), VertexTasks.begin(),
                   VertexTasks.end(), std::back_inserter(UofCEV));
 
-   std::vector<I4> HaloAll(NumTasks, 0);
-   std::vector<I4> OwnedAll(NumTasks, 0);
-
-   // set vector of flags for all tasks in MyComm which signals whether the
-   // halo for the local task needs elements from each task
+   // for each of these tasks, set a mask with bit IdxSpace set if the halo
+   // of the local task needs elements of that index space from the task
+   const std::vector<I4> *HaloTasks[3] = {&CellTasks, &EdgeTasks,
+                                          &VertexTasks};
+   std::vector<I4> HaloMasks(UofCEV.size(), 0);
    for (int ITask = 0; ITask < UofCEV.size(); ++ITask) {
-      HaloAll[UofCEV[ITask]] = 1;
+      for (int IdxSpace = 0; IdxSpace < 3; ++IdxSpace) {
+         if (std::binary_search(HaloTasks[IdxSpace]->begin(),
+                                HaloTasks[IdxSpace]->end(), UofCEV[ITask]))
+            HaloMasks[ITask] |= 1 << IdxSpace;
+      }
    }
 
-   // perform all to all with all tasks in MyComm in order to determine if there
-   // are any tasks that need elements from the local task that the local task
-   // does not already consider a neighbor
-   IErr =
-       MPI_Alltoall(&HaloAll[0], 1, MPI_INT, &OwnedAll[0], 1, MPI_INT, MyComm);
+   // send the masks to the tasks that own the halo elements and receive the
+   // masks of all tasks that need locally owned elements for their halos
+   std::vector<I4> AddNeighbors;
+   std::vector<I4> AddMasks;
+   IErr = exchangeHaloMasks(UofCEV, HaloMasks, AddNeighbors, AddMasks);
    if (IErr != 0) {
-      LOG_ERROR("Halo: MPI_Alltoall error");
+      LOG_ERROR("Halo: error in sparse exchange of neighbor masks");
       Err = -1;
    }
 
-   // set vector of IDs for all tasks that need locally owned elements for
-   // their halos
-   std::vector<I4> AddNeighbors;
-   for (int ITask = 0; ITask < NumTasks; ++ITask) {
-      if (OwnedAll[ITask])
-         AddNeighbors.push_back(ITask);
+   // sort the received tasks (arrival order is arbitrary) with their masks
+   std::vector<I4> Order(AddNeighbors.size());
+   std::iota(Order.begin(), Order.end(), 0);
+   std::sort(Order.begin(), Order.end(), [&AddNeighbors](I4 A, I4 B) {
+      return AddNeighbors[A] < AddNeighbors[B];
+   });
+   std::vector<I4> SortedNeighbors(Order.size());
+   std::vector<I4> SortedMasks(Order.size());
+   for (int I = 0; I < Order.size(); ++I) {
+      SortedNeighbors[I] = AddNeighbors[Order[I]];
+      SortedMasks[I]     = AddMasks[Order[I]];
    }
 
    // one final union results in a list of IDs for all tasks that need to
    // send elements to the local task or need locally owned elements during
    // a halo exchange in at least one index space, save in Halo member
    // vector NeighborList and set member variable NNghbr
-   std::set_union(UofCEV.begin(), UofCEV.end(), AddNeighbors.begin(),
-                  AddNeighbors.end(), std::back_inserter(NeighborList));
+   std::set_union(UofCEV.begin(), UofCEV.end(), SortedNeighbors.begin(),
+                  SortedNeighbors.end(), std::back_inserter(NeighborList));
    NNghbr = NeighborList.size();
 
+   // masks received from each task in NeighborList, zero for tasks that do
+   // not need locally owned elements
+   std::vector<I4> NeighborMasks(NNghbr, 0);
+   for (int I = 0; I < SortedNeighbors.size(); ++I) {
+      auto It = std::lower_bound(NeighborList.begin(), NeighborList.end(),
+                                 SortedNeighbors[I]);
+      NeighborMasks[It - NeighborList.begin()] = SortedMasks[I];
+   }
+
    // set SendFlags and RecvFlags for each index space
-   setNeighborFlags(CellTasks, OnCell);
-   setNeighborFlags(EdgeTasks, OnEdge);
-   setNeighborFlags(VertexTasks, OnVertex);
+   setNeighborFlags(CellTasks, NeighborMasks, OnCell);
+   setNeighborFlags(EdgeTasks, NeighborMasks, OnEdge);
+   setNeighborFlags(VertexTasks, NeighborMasks, OnVertex);
 
    return Err;
 }
@@ -330,16 +464,16 @@ int Halo::generateListOfTasksInHalo(const I4 NOwned, const I4 NAll,
 
    I4 Err{0}; // error code to return
 
-   // search through halo elements in input Loc array to find each unique
-   // task ID and save in ListOfTasks
-   for (int Idx = NOwned; Idx < NAll; ++Idx) {
-      I4 Value = Loc(Idx, 0);
-      auto It  = std::find(ListOfTasks.begin(), ListOfTasks.end(), Value);
-      if (It == ListOfTasks.end())
-         ListOfTasks.push_back(Value);
-   }
+   // collect the owning task of each halo element in input Loc array, then
+   // sort and remove duplicates to leave each unique task ID in ListOfTasks
+   ListOfTasks.clear();
+   ListOfTasks.reserve(NAll - NOwned);
+   for (int Idx = NOwned; Idx < NAll; ++Idx)
+      ListOfTasks.push_back(Loc(Idx, 0));
 
    std::sort(ListOfTasks.begin(), ListOfTasks.end());
+   ListOfTasks.erase(std::unique(ListOfTasks.begin(), ListOfTasks.end()),
+                     ListOfTasks.end());
 
    return Err;
 }
@@ -347,9 +481,12 @@ int Halo::generateListOfTasksInHalo(const I4 NOwned, const I4 NAll,
 //------------------------------------------------------------------------------
 // For the input index space, set SendFlags and RecvFlags vectors that flag
 // which Neighbors in NeighborList the local task needs to send elements to or
-// receive elements from during a halo exchange
+// receive elements from during a halo exchange. The local task receives from
+// the tasks in ListOfTasks and sends to the tasks whose mask, received in
+// exchangeHaloMasks, has the bit of the index space set.
 
-int Halo::setNeighborFlags(std::vector<I4> ListOfTasks,
+int Halo::setNeighborFlags(const std::vector<I4> &ListOfTasks,
+                           const std::vector<I4> &NeighborMasks,
                            const MeshElement IdxSpace) {
 
    I4 Err{0}; // error code to return
@@ -359,48 +496,99 @@ int Halo::setNeighborFlags(std::vector<I4> ListOfTasks,
    RecvFlags[IdxSpace].resize(NNghbr);
 
    for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-      auto It = std::find(ListOfTasks.begin(), ListOfTasks.end(),
-                          NeighborList[INghbr]);
-      if (It != ListOfTasks.end()) {
+      if (std::binary_search(ListOfTasks.begin(), ListOfTasks.end(),
+                             NeighborList[INghbr])) {
          RecvFlags[IdxSpace][INghbr] = 1;
       } else {
          RecvFlags[IdxSpace][INghbr] = 0;
       }
+      SendFlags[IdxSpace][INghbr] = (NeighborMasks[INghbr] >> IdxSpace) & 1;
    }
 
-   // initialize vectors to track MPI errors for each MPI_Isend and MPI_IRecv
-   std::vector<I4> SendErr(NNghbr, 0);
-   std::vector<I4> RecvErr(NNghbr, 0);
+   return Err;
+}
 
-   // initialize vectors of MPI_Request variables to control non-blocking
-   // MPI communications
-   std::vector<MPI_Request> RecvReqs(NNghbr);
-   std::vector<MPI_Request> SendReqs(NNghbr);
+//------------------------------------------------------------------------------
+// Sparse dynamic exchange of one integer mask with each task in DestTasks,
+// using the nonblocking consensus (NBX) algorithm. Each mask is sent with a
+// synchronous MPI_Issend, so that its completion means the message has been
+// matched, while incoming masks are probed for and received from any task.
+// Once all local sends have completed, the task enters an MPI_Ibarrier and
+// keeps receiving until the barrier completes, which happens only when all
+// sends on all tasks have been matched. On exit, SrcTasks and SrcMasks hold
+// the tasks that sent a mask to the local task, in arrival order, and their
+// masks. Apart from the barrier and the communicator duplication, which cost
+// O(log(NumTasks)), the communication scales with the number of neighbors.
+
+int Halo::exchangeHaloMasks(const std::vector<I4> &DestTasks,
+                            const std::vector<I4> &DestMasks,
+                            std::vector<I4> &SrcTasks,
+                            std::vector<I4> &SrcMasks) {
 
-   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-      RecvErr[INghbr] = MPI_Irecv(&SendFlags[IdxSpace][INghbr], 1, MPI_INT,
-                                  NeighborList[INghbr], MPI_ANY_TAG, MyComm,
-                                  &RecvReqs[INghbr]);
-      if (RecvErr[INghbr] != 0) {
-         LOG_ERROR("MPI error {} on task {} receive from task {}",
-                   RecvErr[INghbr], MyTask, NeighborList[INghbr]);
+   I4 Err{0}; // error code to return
+
+   // The exchange uses a duplicate of MyComm so that the probes can not
+   // match any other message, including those of a later exchange sent by
+   // a task that has already seen the barrier complete.
+   MPI_Comm MaskComm;
+   MPI_Comm_dup(MyComm, &MaskComm);
+   const int MaskTag = 0;
+
+   SrcTasks.clear();
+   SrcMasks.clear();
+
+   I4 NDest = DestTasks.size();
+   std::vector<MPI_Request> SendReqs(NDest);
+   for (int IDest = 0; IDest < NDest; ++IDest) {
+      I4 SendErr = MPI_Issend(&DestMasks[IDest], 1, MPI_INT, DestTasks[IDest],
+                              MaskTag, MaskComm, &SendReqs[IDest]);
+      if (SendErr != 0) {
+         LOG_ERROR("MPI error {} on task {} send to task {}", SendErr, MyTask,
+                   DestTasks[IDest]);
          Err = -1;
       }
    }
 
-   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-      SendErr[INghbr] =
-          MPI_Isend(&RecvFlags[IdxSpace][INghbr], 1, MPI_INT,
-                    NeighborList[INghbr], 0, MyComm, &SendReqs[INghbr]);
-      if (SendErr[INghbr] != 0) {
-         LOG_ERROR("MPI error {} on task {} send to task {}", SendErr[INghbr],
-                   MyTask, NeighborList[INghbr]);
-         Err = -1;
+   MPI_Request BarrierReq = MPI_REQUEST_NULL;
+   bool InBarrier         = false;
+   while (true) {
+
+      int Complete = 0;
+      if (InBarrier) {
+         // all sends on all tasks have been matched, so every mask sent to
+         // the local task has been received. Stop before probing again, as
+         // a probe could now match a message of a later exchange.
+         MPI_Test(&BarrierReq, &Complete, MPI_STATUS_IGNORE);
+         if (Complete)
+            break;
+      } else {
+         // enter the barrier once all local sends have been matched
+         MPI_Testall(NDest, SendReqs.data(), &Complete, MPI_STATUSES_IGNORE);
+         if (Complete) {
+            MPI_Ibarrier(MaskComm, &BarrierReq);
+            InBarrier = true;
+         }
+      }
+
+      // receive any mask that has arrived
+      int Arrived = 0;
+      MPI_Status Status;
+      MPI_Iprobe(MPI_ANY_SOURCE, MaskTag, MaskComm, &Arrived, &Status);
+      if (Arrived) {
+         I4 Mask;
+         I4 RecvErr = MPI_Recv(&Mask, 1, MPI_INT, Status.MPI_SOURCE, MaskTag,
+                               MaskComm, MPI_STATUS_IGNORE);
+         if (RecvErr != 0) {
+            LOG_ERROR("MPI error {} on task {} receive from task {}", RecvErr,
+                      MyTask, Status.MPI_SOURCE);
+            Err = -1;
+         }
+         SrcTasks.push_back(Status.MPI_SOURCE);
+         SrcMasks.push_back(Mask);
       }
    }
 
-   MPI_Waitall(NNghbr, SendReqs.data(), MPI_STATUS_IGNORE);
-   MPI_Waitall(NNghbr, RecvReqs.data(), MPI_STATUS_IGNORE);
+   MPI_Comm_free(&MaskComm);
 
    return Err;
 }
@@ -432,7 +620,7 @@ int Halo::generateExchangeLists(
       NOwnedPtr = &MyDecomp->NCellsOwned;
       NAllPtr   = &MyDecomp->NCellsAll;
       NHaloPtr  = MyDecomp->NCellsHaloH;
-      LocPtr    = MyDecomp->CellLocH;
+      LocPtr    = MyDecomp->getHost(MyDecomp->CellLocH);
       NumLayers = HaloWidth;
 
       break;
@@ -440,7 +628,7 @@ int Halo::generateExchangeLists(
       NOwnedPtr = &MyDecomp->NEdgesOwned;
       NAllPtr   = &MyDecomp->NEdgesAll;
       NHaloPtr  = MyDecomp->NEdgesHaloH;
-      LocPtr    = MyDecomp->EdgeLocH;
+      LocPtr    = MyDecomp->getHost(MyDecomp->EdgeLocH);
       NumLayers = HaloWidth + 1;
 
       break;
@@ -448,7 +636,7 @@ int Halo::generateExchangeLists(
       NOwnedPtr = &MyDecomp->NVerticesOwned;
       NAllPtr   = &MyDecomp->NVerticesAll;
       NHaloPtr  = MyDecomp->NVerticesHaloH;
-      LocPtr    = MyDecomp->VertexLocH;
+      LocPtr    = MyDecomp->getHost(MyDecomp->VertexLocH);
       NumLayers = HaloWidth + 1;
 
       break;
@@ -560,6 +748,116 @@ int Halo::generateExchangeLists(
    return IErr;
 } // end generateExchangeLists
 
+//------------------------------------------------------------------------------
+// Returns the configuration of a halo snapshot. The hashes of the global IDs
+// of the local cells, edges and vertices make sure the snapshot is only
+// reused for the same decomposition.
+
+std::vector<I4> Halo::snapshotConfig(const I4 NumTasks // number of MPI tasks
+) const {
+
+   return {NumTasks,
+           MyTask,
+           HaloWidth,
+           snapshotHash(MyDecomp->getHost(MyDecomp->CellIDH)),
+           snapshotHash(MyDecomp->getHost(MyDecomp->EdgeIDH)),
+           snapshotHash(MyDecomp->getHost(MyDecomp->VertexIDH))};
+
+} // end snapshotConfig
+
+//------------------------------------------------------------------------------
+// Restores the neighbor list, the neighbor flags and the exchange lists of
+// each index space from the snapshot file of the local task
+
+int Halo::readSnapshot(
+    const std::vector<I4> &Config, // configuration of the snapshot
+    std::vector<std::vector<std::vector<I4>>> (&SendLists)[3], // send lists
+    std::vector<std::vector<std::vector<I4>>> (&RecvLists)[3]  // recv lists
+) {
+
+   SnapshotReader Snapshot;
+   I4 Err = Snapshot.open(
+       snapshotFileName(MyDecomp->SnapshotName, "halo", MyComm), Config,
+       MyComm);
+   if (Err != 0)
+      return Err;
+
+   Err    = Snapshot.getVector("NeighborList", NeighborList);
+   NNghbr = NeighborList.size();
+
+   const std::string SpaceNames[3] = {"Cell", "Edge", "Vertex"};
+   for (int Space = 0; Space < 3; ++Space) {
+      std::vector<I4> SendFlat;
+      std::vector<I4> RecvFlat;
+      Err += Snapshot.getVector("SendFlags" + SpaceNames[Space],
+                                SendFlags[Space]);
+      Err += Snapshot.getVector("RecvFlags" + SpaceNames[Space],
+                                RecvFlags[Space]);
+      Err += Snapshot.getVector("SendLists" + SpaceNames[Space], SendFlat);
+      Err += Snapshot.getVector("RecvLists" + SpaceNames[Space], RecvFlat);
+      if (Err == 0) {
+         Err += unflattenLists(SendFlat, NNghbr, SendLists[Space]);
+         Err += unflattenLists(RecvFlat, NNghbr, RecvLists[Space]);
+      }
+   }
+
+   // A snapshot that matches the configuration but is incomplete on any
+   // task can not be used
+   I4 LocErr = Err;
+   MPI_Allreduce(&LocErr, &Err, 1, MPI_INT32_T, MPI_MAX, MyComm);
+   if (Err != 0) {
+      LOG_WARN("Halo: snapshot is incomplete, generating exchange lists");
+      NeighborList.clear();
+      NNghbr = 0;
+      for (int Space = 0; Space < 3; ++Space) {
+         SendFlags[Space].clear();
+         RecvFlags[Space].clear();
+         SendLists[Space].clear();
+         RecvLists[Space].clear();
+      }
+      return Err;
+   }
+
+   LOG_INFO("Halo: restored exchange lists from snapshot {}",
+            MyDecomp->SnapshotName);
+
+   return Err;
+
+} // end readSnapshot
+
+//------------------------------------------------------------------------------
+// Writes the neighbor list, the neighbor flags and the exchange lists of
+// each index space to the snapshot file of the local task. Failure to write
+// the snapshot is not fatal, since it only serves as a cache for later runs.
+
+int Halo::writeSnapshot(
+    const std::vector<I4> &Config, // configuration of the snapshot
+    const std::vector<std::vector<std::vector<I4>>> (&SendLists)[3],
+    const std::vector<std::vector<std::vector<I4>>> (&RecvLists)[3]) const {
+
+   SnapshotWriter Snapshot(
+       snapshotFileName(MyDecomp->SnapshotName, "halo", MyComm), Config);
+
+   Snapshot.addVector("NeighborList", NeighborList);
+
+   const std::string SpaceNames[3] = {"Cell", "Edge", "Vertex"};
+   for (int Space = 0; Space < 3; ++Space) {
+      Snapshot.addVector("SendFlags" + SpaceNames[Space], SendFlags[Space]);
+      Snapshot.addVector("RecvFlags" + SpaceNames[Space], RecvFlags[Space]);
+      Snapshot.addVector("SendLists" + SpaceNames[Space],
+                         flattenLists(SendLists[Space]));
+      Snapshot.addVector("RecvLists" + SpaceNames[Space],
+                         flattenLists(RecvLists[Space]));
+   }
+
+   I4 Err = Snapshot.write();
+   if (Err != 0)
+      LOG_WARN("Halo: unable to write snapshot {}", MyDecomp->SnapshotName);
+
+   return Err;
+
+} // end writeSnapshot
+
 //------------------------------------------------------------------------------
 // Exchange 1D integer vectors with each neighbor. Takes as input two 2D
 // vectors, SendVec and RecvVec, where the first dimension is the neighboring
@@ -615,8 +913,118 @@ int Halo::exchangeVectorInt(
 } // end exchangeVectorInt
 
 //------------------------------------------------------------------------------
-// Allocate RecvBuffer and prepare for MPI communication by calling MPI_Irecv
-// for each Neighbor
+// Set the size of the message to send to and receive from each Neighbor for
+// an exchange of the first NumLayers halo layers of a single array on the
+// current index space MyElem with TotSize buffer elements per mesh element,
+// in reduced precision if requested. Communication flags for each Neighbor
+// are also reset.
+
+int Halo::setExchangeSizes() {
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      MyNeighbor           = &Neighbors[INghbr];
+      MyNeighbor->Received = false;
+      MyNeighbor->Unpacked = false;
+      MyNeighbor->SendSize = 0;
+      MyNeighbor->RecvSize = 0;
+      if (SendFlags[MyElem][INghbr])
+         MyNeighbor->SendSize =
+             messageSize(TotSize * listSize(MyNeighbor->SendLists[MyElem]));
+      if (RecvFlags[MyElem][INghbr])
+         MyNeighbor->RecvSize =
+             messageSize(TotSize * listSize(MyNeighbor->RecvLists[MyElem]));
+   }
+
+   return 0;
+} // end setExchangeSizes
+
+//------------------------------------------------------------------------------
+// Allocate the send and receive buffers for each Neighbor with enough space
+// for the message sizes of the current exchange. Host buffers are resized
+// while device buffers are only reallocated when they need to grow.
+
+int Halo::allocBuffers() {
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      MyNeighbor = &Neighbors[INghbr];
+      if (OnDevice) {
+         allocDeviceBuffers();
+      } else {
+         MyNeighbor->SendBuffer.resize(MyNeighbor->SendSize);
+         MyNeighbor->RecvBuffer.resize(MyNeighbor->RecvSize);
+      }
+   }
+
+   return 0;
+} // end allocBuffers
+
+//------------------------------------------------------------------------------
+// Make sure the device send and receive buffers (and their host staging
+// mirrors) for the current Neighbor are large enough for the message sizes
+// of the current exchange. Buffers are only reallocated when they need to
+// grow so that repeated exchanges do not allocate memory. Returns the
+// largest buffer size needed.
+
+I4 Halo::allocDeviceBuffers() {
+
+   MemoryScope Scope("Halo");
+
+   I4 SendSize = MyNeighbor->SendSize;
+   I4 RecvSize = MyNeighbor->RecvSize;
+
+   if (MyNeighbor->DevSendBuffer.extent_int(0) < SendSize) {
+      MyNeighbor->DevSendBuffer = Array1DReal("HaloDevSendBuffer", SendSize);
+      MyNeighbor->HostSendBuffer =
+          Kokkos::create_mirror_view(MyNeighbor->DevSendBuffer);
+   }
+   if (MyNeighbor->DevRecvBuffer.extent_int(0) < RecvSize) {
+      MyNeighbor->DevRecvBuffer = Array1DReal("HaloDevRecvBuffer", RecvSize);
+      MyNeighbor->HostRecvBuffer =
+          Kokkos::create_mirror_view(MyNeighbor->DevRecvBuffer);
+   }
+
+   return std::max(SendSize, RecvSize);
+} // end allocDeviceBuffers
+
+//------------------------------------------------------------------------------
+// Select the buffer for the current Neighbor to receive into based on where
+// the array resides and whether MPI can access device memory
+
+Real *Halo::recvPointer() {
+
+   if (OnDevice) {
+#ifdef OMEGA_MPI_ON_DEVICE
+      return MyNeighbor->DevRecvBuffer.data();
+#else
+      return MyNeighbor->HostRecvBuffer.data();
+#endif
+   }
+   return MyNeighbor->RecvBuffer.data();
+
+} // end recvPointer
+
+//------------------------------------------------------------------------------
+// Select the buffer for the current Neighbor to send from based on where
+// the array resides and whether MPI can access device memory
+
+Real *Halo::sendPointer() {
+
+   if (OnDevice) {
+#ifdef OMEGA_MPI_ON_DEVICE
+      return MyNeighbor->DevSendBuffer.data();
+#else
+      return MyNeighbor->HostSendBuffer.data();
+#endif
+   }
+   return MyNeighbor->SendBuffer.data();
+
+} // end sendPointer
+
+//------------------------------------------------------------------------------
+// Prepare for MPI communication by calling MPI_Irecv for each Neighbor that
+// the local task receives a message from. For a persistent exchange pattern,
+// the persistent receive requests are started instead. Buffers must already
+// be allocated.
 
 int Halo::startReceives() {
 
@@ -625,14 +1033,35 @@ int Halo::startReceives() {
 
    I4 Err{0}; // Error code to return
 
+   // For neighborhood collectives, the receives are posted together with the
+   // sends by a single collective in startSends
+   if (Method == NeighborCollective)
+      return Err;
+
+   // Collect the active persistent requests and start them all at once
+   if (MyPattern != nullptr) {
+      std::vector<MPI_Request> Reqs;
+      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+         if (Neighbors[INghbr].RecvSize > 0)
+            Reqs.push_back(Neighbors[INghbr].RReq);
+      }
+      if (!Reqs.empty())
+         Err = MPI_Startall(Reqs.size(), Reqs.data());
+      if (Err != 0) {
+         LOG_ERROR("MPI error {} on task {} starting persistent receives", Err,
+                   MyTask);
+         Err = -1;
+      }
+      return Err;
+   }
+
    for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-      if (RecvFlags[MyElem][INghbr]) {
-         MyNeighbor    = &Neighbors[INghbr];
-         I4 BufferSize = TotSize * MyNeighbor->RecvLists[MyElem].NTot;
-         MyNeighbor->RecvBuffer.resize(BufferSize);
-         IErr[INghbr] = MPI_Irecv(&MyNeighbor->RecvBuffer[0], BufferSize,
-                                  MPI_RealKind, MyNeighbor->TaskID, MPI_ANY_TAG,
-                                  MyComm, &MyNeighbor->RReq);
+      MyNeighbor    = &Neighbors[INghbr];
+      I4 BufferSize = MyNeighbor->RecvSize;
+      if (BufferSize > 0) {
+         IErr[INghbr] = MPI_Irecv(recvPointer(), BufferSize, MPI_RealKind,
+                                  MyNeighbor->TaskID, MPI_ANY_TAG, MyComm,
+                                  &MyNeighbor->RReq);
          if (IErr[INghbr] != 0) {
             LOG_ERROR("MPI error {} on task {} receive from task {}",
                       IErr[INghbr], MyTask, MyNeighbor->TaskID);
@@ -646,7 +1075,8 @@ int Halo::startReceives() {
 
 //------------------------------------------------------------------------------
 // Initiate MPI communication by calling MPI_Isend for each Neighbor to send
-// the packed buffers to each task
+// the packed buffers to each task. For a persistent exchange pattern, the
+// persistent send requests are started instead.
 
 int Halo::startSends() {
 
@@ -655,13 +1085,55 @@ int Halo::startSends() {
 
    I4 Err{0}; // Error code to return
 
+   // Device pack kernels must be complete before the buffers are sent
+   if (OnDevice)
+      Kokkos::fence();
+
+#ifndef OMEGA_MPI_ON_DEVICE
+   // Copy packed device buffers to the host staging buffers
+   if (OnDevice) {
+      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+         MyNeighbor = &Neighbors[INghbr];
+         if (MyNeighbor->SendSize > 0) {
+            auto SendRange = std::make_pair(0, MyNeighbor->SendSize);
+            auto HostSend =
+                Kokkos::subview(MyNeighbor->HostSendBuffer, SendRange);
+            auto DevSend =
+                Kokkos::subview(MyNeighbor->DevSendBuffer, SendRange);
+            deepCopy(HostSend, DevSend);
+         }
+      }
+   }
+#endif
+
+   // Start the exchange with a single neighborhood collective
+   if (Method == NeighborCollective)
+      return startNeighborCollective();
+
+   // Collect the active persistent requests and start them all at once
+   if (MyPattern != nullptr) {
+      std::vector<MPI_Request> Reqs;
+      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+         if (Neighbors[INghbr].SendSize > 0)
+            Reqs.push_back(Neighbors[INghbr].SReq);
+      }
+      if (!Reqs.empty())
+         Err = MPI_Startall(Reqs.size(), Reqs.data());
+      if (Err != 0) {
+         LOG_ERROR("MPI error {} on task {} starting persistent sends", Err,
+                   MyTask);
+         Err = -1;
+      }
+      return Err;
+   }
+
    for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-      if (SendFlags[MyElem][INghbr]) {
-         MyNeighbor    = &Neighbors[INghbr];
-         I4 BufferSize = TotSize * MyNeighbor->SendLists[MyElem].NTot;
-         IErr[INghbr] =
-             MPI_Isend(&MyNeighbor->SendBuffer[0], BufferSize, MPI_RealKind,
-                       MyNeighbor->TaskID, 0, MyComm, &MyNeighbor->SReq);
+      MyNeighbor    = &Neighbors[INghbr];
+      I4 BufferSize = MyNeighbor->SendSize;
+      if (BufferSize > 0) {
+         IErr[INghbr] = MPI_Isend(sendPointer(), BufferSize, MPI_RealKind,
+                                  MyNeighbor->TaskID, 0, MyComm,
+                                  &MyNeighbor->SReq);
          if (IErr[INghbr] != 0) {
             LOG_ERROR("MPI error {} on task {} send to task {}", IErr[INghbr],
                       MyTask, MyNeighbor->TaskID);
@@ -674,25 +1146,590 @@ int Halo::startSends() {
 } // end startSends
 
 //------------------------------------------------------------------------------
-// The packBuffer function is overloaded to all supported data types. First, the
-// send buffer for the neighbor is allocated with enough space to send all the
-// halo elements. Then the exchange list for the neighbor and index space
-// is used to select the proper elements and pack them into the send buffer.
+// Start all sends and receives of an exchange with a single non-blocking
+// neighborhood collective (MPI_Ineighbor_alltoallw) on the distributed graph
+// communicator NghbrComm. The buffers of each Neighbor are separate
+// allocations, so their absolute addresses are used as displacements
+// relative to MPI_BOTTOM. Neighbors with no data to exchange have a count of
+// zero. Neighbors appear in the communicator in NeighborList order.
+
+int Halo::startNeighborCollective() {
+
+   I4 Err{0}; // Error code to return
+
+   std::vector<int> SendCounts(NNghbr, 0), RecvCounts(NNghbr, 0);
+   std::vector<MPI_Aint> SendDispls(NNghbr, 0), RecvDispls(NNghbr, 0);
+   std::vector<MPI_Datatype> SendTypes(NNghbr, MPI_RealKind);
+   std::vector<MPI_Datatype> RecvTypes(NNghbr, MPI_RealKind);
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      MyNeighbor = &Neighbors[INghbr];
+      if (MyNeighbor->SendSize > 0) {
+         SendCounts[INghbr] = MyNeighbor->SendSize;
+         MPI_Get_address(sendPointer(), &SendDispls[INghbr]);
+      }
+      if (MyNeighbor->RecvSize > 0) {
+         RecvCounts[INghbr] = MyNeighbor->RecvSize;
+         MPI_Get_address(recvPointer(), &RecvDispls[INghbr]);
+      }
+   }
+
+   Err = MPI_Ineighbor_alltoallw(
+       MPI_BOTTOM, SendCounts.data(), SendDispls.data(), SendTypes.data(),
+       MPI_BOTTOM, RecvCounts.data(), RecvDispls.data(), RecvTypes.data(),
+       NghbrComm, &CollReq);
+   if (Err != 0) {
+      LOG_ERROR("MPI error {} on task {} in neighborhood collective", Err,
+                MyTask);
+      Err = -1;
+   }
+
+   return Err;
+} // end startNeighborCollective
+
+//------------------------------------------------------------------------------
+// Select the method used to communicate halo data. When the neighborhood
+// collective method is first selected, a distributed graph communicator is
+// created from the list of neighboring tasks. The method can not be changed
+// while an exchange is in progress.
+
+int Halo::setExchangeMethod(HaloExchangeMethod InMethod) {
+
+   I4 Err{0}; // Error code to return
+
+   if (InProgress) {
+      LOG_ERROR("Halo: can not change exchange method during an exchange");
+      return -1;
+   }
+
+   if (InMethod == NeighborCollective and NghbrComm == MPI_COMM_NULL) {
+      // The neighbor graph is symmetric, each task both sends to and
+      // receives from each task in NeighborList
+      Err = MPI_Dist_graph_create_adjacent(
+          MyComm, NNghbr, NeighborList.data(), MPI_UNWEIGHTED, NNghbr,
+          NeighborList.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &NghbrComm);
+      if (Err != 0) {
+         LOG_ERROR("MPI error {} on task {} creating neighborhood "
+                   "communicator",
+                   Err, MyTask);
+         return -1;
+      }
+   }
+
+   Method = InMethod;
+
+   return Err;
+} // end setExchangeMethod
+
+//------------------------------------------------------------------------------
+// Return the method currently used to communicate halo data
+
+HaloExchangeMethod Halo::getExchangeMethod() const { return Method; }
+
+//------------------------------------------------------------------------------
+// Set up the persistent exchange pattern labeled Name for the message sizes
+// of the current exchange. The buffers owned by the pattern are swapped into
+// each Neighbor. If the pattern is new, or the message sizes or memory space
+// have changed since the last exchange with this pattern, the buffers are
+// grown as needed and the persistent MPI requests are (re)created with
+// MPI_Recv_init and MPI_Send_init. Otherwise the existing buffers and
+// requests are reused without any allocation or MPI setup.
+
+int Halo::setupPattern(const std::string &Name) {
+
+   I4 Err{0}; // Error code to return
+
+   MemoryScope Scope("Halo");
+
+   PersistentPattern &Pattern = Patterns[Name];
+
+   // Size the member vectors for a new pattern
+   bool Changed = not Pattern.Initialized or Pattern.OnDevice != OnDevice;
+   if (not Pattern.Initialized) {
+      Pattern.SendBuffers.resize(NNghbr);
+      Pattern.RecvBuffers.resize(NNghbr);
+      Pattern.DevSendBuffers.resize(NNghbr);
+      Pattern.DevRecvBuffers.resize(NNghbr);
+      Pattern.HostSendBuffers.resize(NNghbr);
+      Pattern.HostRecvBuffers.resize(NNghbr);
+      Pattern.SendSizes.resize(NNghbr, -1);
+      Pattern.RecvSizes.resize(NNghbr, -1);
+      Pattern.SendReqs.resize(NNghbr, MPI_REQUEST_NULL);
+      Pattern.RecvReqs.resize(NNghbr, MPI_REQUEST_NULL);
+   }
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (Pattern.SendSizes[INghbr] != Neighbors[INghbr].SendSize or
+          Pattern.RecvSizes[INghbr] != Neighbors[INghbr].RecvSize)
+         Changed = true;
+   }
+
+   MyPattern = &Pattern;
+   swapPatternBuffers(Pattern);
+
+   if (Changed) {
+      freePatternRequests(Pattern);
+      allocBuffers();
+
+      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+         MyNeighbor = &Neighbors[INghbr];
+         I4 IErr{0};
+         if (MyNeighbor->RecvSize > 0) {
+            IErr = MPI_Recv_init(recvPointer(), MyNeighbor->RecvSize,
+                                 MPI_RealKind, MyNeighbor->TaskID, MPI_ANY_TAG,
+                                 MyComm, &Pattern.RecvReqs[INghbr]);
+         }
+         if (MyNeighbor->SendSize > 0) {
+            IErr += MPI_Send_init(sendPointer(), MyNeighbor->SendSize,
+                                  MPI_RealKind, MyNeighbor->TaskID, 0, MyComm,
+                                  &Pattern.SendReqs[INghbr]);
+         }
+         if (IErr != 0) {
+            LOG_ERROR("MPI error {} on task {} creating persistent requests "
+                      "for task {}",
+                      IErr, MyTask, MyNeighbor->TaskID);
+            Err = -1;
+         }
+         Pattern.SendSizes[INghbr] = MyNeighbor->SendSize;
+         Pattern.RecvSizes[INghbr] = MyNeighbor->RecvSize;
+      }
+
+      Pattern.OnDevice    = OnDevice;
+      Pattern.Initialized = true;
+   }
+
+   // Copy the persistent request handles to each Neighbor for the waits
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      Neighbors[INghbr].RReq = Pattern.RecvReqs[INghbr];
+      Neighbors[INghbr].SReq = Pattern.SendReqs[INghbr];
+   }
+
+   return Err;
+} // end setupPattern
+
+//------------------------------------------------------------------------------
+// Swap the buffers owned by a persistent exchange pattern with the buffers of
+// each Neighbor. Swapping does not move the buffer memory, so the addresses
+// bound to the persistent requests remain valid.
+
+void Halo::swapPatternBuffers(PersistentPattern &Pattern) {
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      Neighbor &Nghbr = Neighbors[INghbr];
+      std::swap(Nghbr.SendBuffer, Pattern.SendBuffers[INghbr]);
+      std::swap(Nghbr.RecvBuffer, Pattern.RecvBuffers[INghbr]);
+      std::swap(Nghbr.DevSendBuffer, Pattern.DevSendBuffers[INghbr]);
+      std::swap(Nghbr.DevRecvBuffer, Pattern.DevRecvBuffers[INghbr]);
+      std::swap(Nghbr.HostSendBuffer, Pattern.HostSendBuffers[INghbr]);
+      std::swap(Nghbr.HostRecvBuffer, Pattern.HostRecvBuffers[INghbr]);
+   }
+
+} // end swapPatternBuffers
+
+//------------------------------------------------------------------------------
+// Free the persistent MPI requests of an exchange pattern. Requests can not
+// be freed once MPI has been finalized.
+
+void Halo::freePatternRequests(PersistentPattern &Pattern) {
+
+   int Finalized{0};
+   MPI_Finalized(&Finalized);
+   if (Finalized)
+      return;
+
+   for (auto &Req : Pattern.SendReqs) {
+      if (Req != MPI_REQUEST_NULL)
+         MPI_Request_free(&Req);
+   }
+   for (auto &Req : Pattern.RecvReqs) {
+      if (Req != MPI_REQUEST_NULL)
+         MPI_Request_free(&Req);
+   }
+
+} // end freePatternRequests
+
+//------------------------------------------------------------------------------
+// If the received message for the current Neighbor was staged in host
+// memory, copy it to the device receive buffer before unpacking
+
+int Halo::copyRecvToDevice() {
+
+#ifndef OMEGA_MPI_ON_DEVICE
+   if (OnDevice) {
+      auto RecvRange = std::make_pair(0, MyNeighbor->RecvSize);
+      auto DevRecv   = Kokkos::subview(MyNeighbor->DevRecvBuffer, RecvRange);
+      auto HostRecv  = Kokkos::subview(MyNeighbor->HostRecvBuffer, RecvRange);
+      deepCopy(DevRecv, HostRecv);
+   }
+#endif
+
+   return 0;
+} // end copyRecvToDevice
+
+//------------------------------------------------------------------------------
+// Start a split-phase exchange of all the arrays in a HaloGroup. The arrays
+// are packed one after another into a single buffer per Neighbor so that
+// only one message is sent to each neighboring task.
+
+int Halo::beginExchange(HaloGroup &Group) {
+
+   I4 IErr{0}; // error code
+
+   if (InProgress) {
+      LOG_ERROR("Halo: beginExchange called while another exchange is "
+                "in progress");
+      return -1;
+   }
+   if (KernelGraph::isCapturing()) {
+      KernelGraph::abortCapture("halo exchange");
+      return -1;
+   }
+   if (Group.Members.empty())
+      return 0;
+
+   for (auto &Member : Group.Members) {
+      if (Member.NumLayers < 0 or Member.NumLayers > maxLayers(Member.Elem)) {
+         LOG_ERROR("Halo: requested {} halo layers, only {} available",
+                   Member.NumLayers, maxLayers(Member.Elem));
+         return -1;
+      }
+   }
+
+   OnDevice = Group.OnDevice;
+
+   // Accumulate the message sizes for each Neighbor over all group members
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      MyNeighbor           = &Neighbors[INghbr];
+      MyNeighbor->Received = false;
+      MyNeighbor->Unpacked = false;
+      MyNeighbor->SendSize = 0;
+      MyNeighbor->RecvSize = 0;
+      for (auto &Member : Group.Members) {
+         setMemberState(Member.Elem, Member.TotSize, Member.NumLayers,
+                        Member.ReducedPrec);
+         if (SendFlags[MyElem][INghbr])
+            MyNeighbor->SendSize +=
+                messageSize(TotSize * listSize(MyNeighbor->SendLists[MyElem]));
+         if (RecvFlags[MyElem][INghbr])
+            MyNeighbor->RecvSize +=
+                messageSize(TotSize * listSize(MyNeighbor->RecvLists[MyElem]));
+      }
+   }
+
+   // Allocate the buffers, or set up the persistent pattern for a named group.
+   // Persistent requests are only used with point-to-point communication.
+   if (Group.Name.empty() or Method == NeighborCollective) {
+      allocBuffers();
+   } else {
+      IErr = setupPattern(Group.Name);
+   }
+
+   IErr += startReceives();
+
+   // Pack each member into consecutive sections of the Neighbor buffers
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      MyNeighbor = &Neighbors[INghbr];
+      if (MyNeighbor->SendSize == 0)
+         continue;
+      BuffOffset = 0;
+      for (auto &Member : Group.Members) {
+         setMemberState(Member.Elem, Member.TotSize, Member.NumLayers,
+                        Member.ReducedPrec);
+         if (SendFlags[MyElem][INghbr]) {
+            Member.Pack(*this);
+            BuffOffset +=
+                messageSize(TotSize * listSize(MyNeighbor->SendLists[MyElem]));
+         }
+      }
+   }
+
+   IErr += startSends();
+
+   Group.Active = true;
+   InProgress   = true;
+
+   return IErr;
+} // end beginExchange HaloGroup
+
+//------------------------------------------------------------------------------
+// Complete a split-phase exchange of all the arrays in a HaloGroup, unpacking
+// each member from the single message received from each Neighbor
+
+int Halo::finishExchange(HaloGroup &Group) {
+
+   if (not Group.Active) {
+      if (not Group.Members.empty())
+         LOG_ERROR("Halo: finishExchange called for an inactive group");
+      return Group.Members.empty() ? 0 : -1;
+   }
+
+   OnDevice = Group.OnDevice;
+
+   I4 IErr = receiveAndUnpack([&](int INghbr) {
+      BuffOffset = 0;
+      for (auto &Member : Group.Members) {
+         setMemberState(Member.Elem, Member.TotSize, Member.NumLayers,
+                        Member.ReducedPrec);
+         if (RecvFlags[MyElem][INghbr]) {
+            Member.Unpack(*this);
+            BuffOffset +=
+                messageSize(TotSize * listSize(MyNeighbor->RecvLists[MyElem]));
+         }
+      }
+   });
+
+   // Return the buffers of a persistent pattern
+   if (MyPattern != nullptr) {
+      swapPatternBuffers(*MyPattern);
+      MyPattern = nullptr;
+   }
+
+   Group.Active = false;
+   InProgress   = false;
+
+   return IErr;
+} // end finishExchange HaloGroup
+
+//------------------------------------------------------------------------------
+// Perform a blocking exchange of all the arrays in a HaloGroup
+
+int Halo::exchangeGroup(HaloGroup &Group) {
+
+   I4 IErr = beginExchange(Group);
+   if (IErr != 0) {
+      LOG_ERROR("Halo: Error starting halo group exchange");
+      if (not Group.Active)
+         return IErr;
+   }
+
+   IErr += finishExchange(Group);
+
+   return IErr;
+} // end exchangeGroup
+
+//------------------------------------------------------------------------------
+// Set the index space, number of halo layers, array size per mesh element
+// and precision for the next array to be packed or unpacked. If InNumLayers
+// is not positive, all halo layers of the index space are exchanged.
+
+void Halo::setMemberState(MeshElement Elem, I4 InTotSize, I4 InNumLayers,
+                          bool InReducedPrec) {
+
+   MyElem      = Elem;
+   NumLayers   = InNumLayers > 0 ? InNumLayers : maxLayers(Elem);
+   TotSize     = InTotSize;
+   ReducedPrec = InReducedPrec;
+
+} // end setMemberState
+
+//------------------------------------------------------------------------------
+// Return the total number of halo layers in the index space Elem. For
+// cell-based quantities, the number of halo layers equals HaloWidth, edge-
+// and vertex-based quantities have an extra layer.
+
+I4 Halo::maxLayers(MeshElement Elem) const {
+
+   if (Elem == OnCell) {
+      return HaloWidth;
+   } else {
+      return HaloWidth + 1;
+   }
+
+} // end maxLayers
+
+//------------------------------------------------------------------------------
+// Return the number of elements in the first NumLayers halo layers of an
+// exchange list. This is the number of elements exchanged per array element
+// in a partial-depth exchange and is the buffer stride for that list.
+
+I4 Halo::listSize(const ExchList &List) const {
+
+   if (NumLayers <= 0 or List.NList.empty())
+      return 0;
+   return List.Offsets[NumLayers - 1] + List.NList[NumLayers - 1];
+
+} // end listSize
+
+//------------------------------------------------------------------------------
+// Return the number of Real buffer elements needed for NValues values of the
+// current array. In reduced-precision exchanges the values are stored as R4,
+// so the size is rounded up to a whole number of Real elements. This keeps
+// BuffOffset aligned to a Real element for the next array in a group.
+
+I4 Halo::messageSize(I4 NValues) const {
+
+   if (not ReducedPrec)
+      return NValues;
+   return (NValues * sizeof(R4) + sizeof(Real) - 1) / sizeof(Real);
+
+} // end messageSize
+
+//------------------------------------------------------------------------------
+// Remove all arrays from a HaloGroup
+
+void HaloGroup::clear() {
+
+   if (Active) {
+      LOG_ERROR("HaloGroup: can not clear a group during an exchange");
+      return;
+   }
+   Members.clear();
+   OnDevice = false;
+
+} // end HaloGroup clear
+
+//------------------------------------------------------------------------------
+// Construct a HaloGroup. A non-empty PatternName enables persistent mode for
+// exchanges of this group.
+
+HaloGroup::HaloGroup(const std::string &PatternName) : Name(PatternName) {}
+
+//------------------------------------------------------------------------------
+// Pack an R8 host array into the send buffer in R4 precision. The buffer
+// starting at BuffOffset is viewed as an array of R4 with the same layout as
+// a full-precision buffer, so the message needs only half as many bytes.
+
+template <typename T> int Halo::packReduced(const T &Array) {
+
+   constexpr int NDims = T::rank;
+   ExchList *MyList    = &MyNeighbor->SendLists[MyElem];
+   I4 NExch            = listSize(*MyList);
+   I4 NJ               = NDims > 1 ? Array.extent(NDims - 1) : 1;
+
+   R4 *SendBuff =
+       reinterpret_cast<R4 *>(MyNeighbor->SendBuffer.data() + BuffOffset);
+
+   for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
+      for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
+         I4 IList = MyList->Offsets[ILayer] + IExch;
+         I4 IElem = MyList->Ind[ILayer][IExch];
+         if constexpr (NDims == 1) {
+            SendBuff[IList] = static_cast<R4>(Array(IElem));
+         } else if constexpr (NDims == 2) {
+            for (int J = 0; J < NJ; ++J) {
+               SendBuff[IList * NJ + J] = static_cast<R4>(Array(IElem, J));
+            }
+         } else if constexpr (NDims == 3) {
+            for (int K = 0; K < Array.extent_int(0); ++K) {
+               for (int J = 0; J < NJ; ++J) {
+                  I4 IBuff        = (K * NExch + IList) * NJ + J;
+                  SendBuff[IBuff] = static_cast<R4>(Array(K, IElem, J));
+               }
+            }
+         } else if constexpr (NDims == 4) {
+            I4 NK = Array.extent(1);
+            for (int L = 0; L < Array.extent_int(0); ++L) {
+               for (int K = 0; K < NK; ++K) {
+                  for (int J = 0; J < NJ; ++J) {
+                     I4 IBuff        = ((L * NK + K) * NExch + IList) * NJ + J;
+                     SendBuff[IBuff] = static_cast<R4>(Array(L, K, IElem, J));
+                  }
+               }
+            }
+         } else if constexpr (NDims == 5) {
+            I4 NL = Array.extent(1);
+            I4 NK = Array.extent(2);
+            for (int M = 0; M < Array.extent_int(0); ++M) {
+               for (int L = 0; L < NL; ++L) {
+                  for (int K = 0; K < NK; ++K) {
+                     for (int J = 0; J < NJ; ++J) {
+                        I4 IBuff =
+                            (((M * NL + L) * NK + K) * NExch + IList) * NJ + J;
+                        SendBuff[IBuff] =
+                            static_cast<R4>(Array(M, L, K, IElem, J));
+                     }
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   return 0;
+} // end packReduced
+
+//------------------------------------------------------------------------------
+// Unpack a receive buffer holding R4 values into the halo elements of an R8
+// host array, the inverse of packReduced.
+
+template <typename T> int Halo::unpackReduced(T &Array) {
+
+   constexpr int NDims = T::rank;
+   ExchList *MyList    = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch            = listSize(*MyList);
+   I4 NJ               = NDims > 1 ? Array.extent(NDims - 1) : 1;
+
+   const R4 *RecvBuff =
+       reinterpret_cast<R4 *>(MyNeighbor->RecvBuffer.data() + BuffOffset);
+
+   for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
+      for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
+         I4 IList = MyList->Offsets[ILayer] + IExch;
+         I4 IElem = MyList->Ind[ILayer][IExch];
+         if constexpr (NDims == 1) {
+            Array(IElem) = RecvBuff[IList];
+         } else if constexpr (NDims == 2) {
+            for (int J = 0; J < NJ; ++J) {
+               Array(IElem, J) = RecvBuff[IList * NJ + J];
+            }
+         } else if constexpr (NDims == 3) {
+            for (int K = 0; K < Array.extent_int(0); ++K) {
+               for (int J = 0; J < NJ; ++J) {
+                  I4 IBuff           = (K * NExch + IList) * NJ + J;
+                  Array(K, IElem, J) = RecvBuff[IBuff];
+               }
+            }
+         } else if constexpr (NDims == 4) {
+            I4 NK = Array.extent(1);
+            for (int L = 0; L < Array.extent_int(0); ++L) {
+               for (int K = 0; K < NK; ++K) {
+                  for (int J = 0; J < NJ; ++J) {
+                     I4 IBuff = ((L * NK + K) * NExch + IList) * NJ + J;
+                     Array(L, K, IElem, J) = RecvBuff[IBuff];
+                  }
+               }
+            }
+         } else if constexpr (NDims == 5) {
+            I4 NL = Array.extent(1);
+            I4 NK = Array.extent(2);
+            for (int M = 0; M < Array.extent_int(0); ++M) {
+               for (int L = 0; L < NL; ++L) {
+                  for (int K = 0; K < NK; ++K) {
+                     for (int J = 0; J < NJ; ++J) {
+                        I4 IBuff =
+                            (((M * NL + L) * NK + K) * NExch + IList) * NJ + J;
+                        Array(M, L, K, IElem, J) = RecvBuff[IBuff];
+                     }
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   return 0;
+} // end unpackReduced
+
+//------------------------------------------------------------------------------
+// The packBuffer function is overloaded to all supported data types. The
+// exchange list for the neighbor and index space is used to select the proper
+// elements and pack them into the send buffer, starting at BuffOffset. The
+// send buffer must already be allocated by allocBuffers.
 // In multidimensional arrays the second fastest index (second index from the
 // right) is the mesh element dimension. For integer arrays, the value is
 // recast as a Real in a bit-preserving manner using reinterpret_cast to pack
-// into the buffer, which is of type std::vector<Real>.
+// into the buffer, which is of type std::vector<Real>. I8 values are packed
+// with packValue, which splits them across two buffer elements if Real is R4.
 
 int Halo::packBuffer(const HostArray1DI4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          I4 IBuff = MyList->Offsets[ILayer] + IExch;
-         MyNeighbor->SendBuffer[IBuff] =
+         SendBuff[IBuff] =
              reinterpret_cast<Real &>(Array(MyList->Ind[ILayer][IExch]));
       }
    }
@@ -704,13 +1741,12 @@ int Halo::packBuffer(const HostArray1DI8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          I4 IBuff = MyList->Offsets[ILayer] + IExch;
-         MyNeighbor->SendBuffer[IBuff] =
-             reinterpret_cast<Real &>(Array(MyList->Ind[ILayer][IExch]));
+         packValue(SendBuff, IBuff, Array(MyList->Ind[ILayer][IExch]));
       }
    }
 
@@ -721,12 +1757,12 @@ int Halo::packBuffer(const HostArray1DR4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
-         I4 IBuff                      = MyList->Offsets[ILayer] + IExch;
-         MyNeighbor->SendBuffer[IBuff] = Array(MyList->Ind[ILayer][IExch]);
+         I4 IBuff        = MyList->Offsets[ILayer] + IExch;
+         SendBuff[IBuff] = Array(MyList->Ind[ILayer][IExch]);
       }
    }
 
@@ -735,14 +1771,17 @@ int Halo::packBuffer(const HostArray1DR4 Array) {
 
 int Halo::packBuffer(const HostArray1DR8 Array) {
 
+   if (ReducedPrec)
+      return packReduced(Array);
+
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
-         I4 IBuff                      = MyList->Offsets[ILayer] + IExch;
-         MyNeighbor->SendBuffer[IBuff] = Array(MyList->Ind[ILayer][IExch]);
+         I4 IBuff        = MyList->Offsets[ILayer] + IExch;
+         SendBuff[IBuff] = Array(MyList->Ind[ILayer][IExch]);
       }
    }
 
@@ -754,13 +1793,13 @@ int Halo::packBuffer(const HostArray2DI4 Array) {
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
    int NJ           = Array.extent(1);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          for (int J = 0; J < NJ; ++J) {
             I4 IBuff = (MyList->Offsets[ILayer] + IExch) * NJ + J;
-            MyNeighbor->SendBuffer[IBuff] =
+            SendBuff[IBuff] =
                 reinterpret_cast<Real &>(Array(MyList->Ind[ILayer][IExch], J));
          }
       }
@@ -774,14 +1813,13 @@ int Halo::packBuffer(const HostArray2DI8 Array) {
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
    int NJ           = Array.extent(1);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          for (int J = 0; J < NJ; ++J) {
             I4 IBuff = (MyList->Offsets[ILayer] + IExch) * NJ + J;
-            MyNeighbor->SendBuffer[IBuff] =
-                reinterpret_cast<Real &>(Array(MyList->Ind[ILayer][IExch], J));
+            packValue(SendBuff, IBuff, Array(MyList->Ind[ILayer][IExch], J));
          }
       }
    }
@@ -794,14 +1832,13 @@ int Halo::packBuffer(const HostArray2DR4 Array) {
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
    int NJ           = Array.extent(1);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          for (int J = 0; J < NJ; ++J) {
-            I4 IBuff = (MyList->Offsets[ILayer] + IExch) * NJ + J;
-            MyNeighbor->SendBuffer[IBuff] =
-                Array(MyList->Ind[ILayer][IExch], J);
+            I4 IBuff        = (MyList->Offsets[ILayer] + IExch) * NJ + J;
+            SendBuff[IBuff] = Array(MyList->Ind[ILayer][IExch], J);
          }
       }
    }
@@ -811,17 +1848,19 @@ int Halo::packBuffer(const HostArray2DR4 Array) {
 
 int Halo::packBuffer(const HostArray2DR8 Array) {
 
+   if (ReducedPrec)
+      return packReduced(Array);
+
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
    int NJ           = Array.extent(1);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          for (int J = 0; J < NJ; ++J) {
-            I4 IBuff = (MyList->Offsets[ILayer] + IExch) * NJ + J;
-            MyNeighbor->SendBuffer[IBuff] =
-                Array(MyList->Ind[ILayer][IExch], J);
+            I4 IBuff        = (MyList->Offsets[ILayer] + IExch) * NJ + J;
+            SendBuff[IBuff] = Array(MyList->Ind[ILayer][IExch], J);
          }
       }
    }
@@ -832,19 +1871,19 @@ int Halo::packBuffer(const HostArray2DR8 Array) {
 int Halo::packBuffer(const HostArray3DI4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
                I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
-               MyNeighbor->SendBuffer[IBuff] = reinterpret_cast<Real &>(
+                   (K * NExch + MyList->Offsets[ILayer] + IExch) * NJ + J;
+               SendBuff[IBuff] = reinterpret_cast<Real &>(
                    Array(K, MyList->Ind[ILayer][IExch], J));
             }
          }
@@ -857,20 +1896,20 @@ int Halo::packBuffer(const HostArray3DI4 Array) {
 int Halo::packBuffer(const HostArray3DI8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
                I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
-               MyNeighbor->SendBuffer[IBuff] = reinterpret_cast<Real &>(
-                   Array(K, MyList->Ind[ILayer][IExch], J));
+                   (K * NExch + MyList->Offsets[ILayer] + IExch) * NJ + J;
+               packValue(SendBuff, IBuff,
+                         Array(K, MyList->Ind[ILayer][IExch], J));
             }
          }
       }
@@ -882,20 +1921,19 @@ int Halo::packBuffer(const HostArray3DI8 Array) {
 int Halo::packBuffer(const HostArray3DR4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
                I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
-               MyNeighbor->SendBuffer[IBuff] =
-                   Array(K, MyList->Ind[ILayer][IExch], J);
+                   (K * NExch + MyList->Offsets[ILayer] + IExch) * NJ + J;
+               SendBuff[IBuff] = Array(K, MyList->Ind[ILayer][IExch], J);
             }
          }
       }
@@ -906,21 +1944,23 @@ int Halo::packBuffer(const HostArray3DR4 Array) {
 
 int Halo::packBuffer(const HostArray3DR8 Array) {
 
+   if (ReducedPrec)
+      return packReduced(Array);
+
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
                I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
-               MyNeighbor->SendBuffer[IBuff] =
-                   Array(K, MyList->Ind[ILayer][IExch], J);
+                   (K * NExch + MyList->Offsets[ILayer] + IExch) * NJ + J;
+               SendBuff[IBuff] = Array(K, MyList->Ind[ILayer][IExch], J);
             }
          }
       }
@@ -932,22 +1972,23 @@ int Halo::packBuffer(const HostArray3DR8 Array) {
 int Halo::packBuffer(const HostArray4DI4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NExch +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
-                  MyNeighbor->SendBuffer[IBuff] = reinterpret_cast<Real &>(
+                  SendBuff[IBuff] = reinterpret_cast<Real &>(
                       Array(L, K, MyList->Ind[ILayer][IExch], J));
                }
             }
@@ -961,23 +2002,24 @@ int Halo::packBuffer(const HostArray4DI4 Array) {
 int Halo::packBuffer(const HostArray4DI8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NExch +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
-                  MyNeighbor->SendBuffer[IBuff] = reinterpret_cast<Real &>(
-                      Array(L, K, MyList->Ind[ILayer][IExch], J));
+                  packValue(SendBuff, IBuff,
+                            Array(L, K, MyList->Ind[ILayer][IExch], J));
                }
             }
          }
@@ -990,23 +2032,23 @@ int Halo::packBuffer(const HostArray4DI8 Array) {
 int Halo::packBuffer(const HostArray4DR4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NExch +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
-                  MyNeighbor->SendBuffer[IBuff] =
-                      Array(L, K, MyList->Ind[ILayer][IExch], J);
+                  SendBuff[IBuff] = Array(L, K, MyList->Ind[ILayer][IExch], J);
                }
             }
          }
@@ -1018,24 +2060,27 @@ int Halo::packBuffer(const HostArray4DR4 Array) {
 
 int Halo::packBuffer(const HostArray4DR8 Array) {
 
+   if (ReducedPrec)
+      return packReduced(Array);
+
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NExch +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
-                  MyNeighbor->SendBuffer[IBuff] =
-                      Array(L, K, MyList->Ind[ILayer][IExch], J);
+                  SendBuff[IBuff] = Array(L, K, MyList->Ind[ILayer][IExch], J);
                }
             }
          }
@@ -1048,12 +2093,13 @@ int Halo::packBuffer(const HostArray4DR8 Array) {
 int Halo::packBuffer(const HostArray5DI4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -1061,11 +2107,11 @@ int Halo::packBuffer(const HostArray5DI4 Array) {
             for (int K = 0; K < NK; ++K) {
                for (int L = 0; L < NL; ++L) {
                   for (int M = 0; M < NM; ++M) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NExch +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
-                     MyNeighbor->SendBuffer[IBuff] = reinterpret_cast<Real &>(
+                     SendBuff[IBuff] = reinterpret_cast<Real &>(
                          Array(M, L, K, MyList->Ind[ILayer][IExch], J));
                   }
                }
@@ -1080,12 +2126,13 @@ int Halo::packBuffer(const HostArray5DI4 Array) {
 int Halo::packBuffer(const HostArray5DI8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
@@ -1093,12 +2140,12 @@ int Halo::packBuffer(const HostArray5DI8 Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NExch +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
-                     MyNeighbor->SendBuffer[IBuff] = reinterpret_cast<Real &>(
-                         Array(M, L, K, MyList->Ind[ILayer][IExch], J));
+                     packValue(SendBuff, IBuff,
+                               Array(M, L, K, MyList->Ind[ILayer][IExch], J));
                   }
                }
             }
@@ -1112,12 +2159,13 @@ int Halo::packBuffer(const HostArray5DI8 Array) {
 int Halo::packBuffer(const HostArray5DR4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
@@ -1125,11 +2173,11 @@ int Halo::packBuffer(const HostArray5DR4 Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NExch +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
-                     MyNeighbor->SendBuffer[IBuff] =
+                     SendBuff[IBuff] =
                          Array(M, L, K, MyList->Ind[ILayer][IExch], J);
                   }
                }
@@ -1143,13 +2191,17 @@ int Halo::packBuffer(const HostArray5DR4 Array) {
 
 int Halo::packBuffer(const HostArray5DR8 Array) {
 
+   if (ReducedPrec)
+      return packReduced(Array);
+
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   Real *SendBuff = MyNeighbor->SendBuffer.data() + BuffOffset;
 
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
@@ -1157,11 +2209,11 @@ int Halo::packBuffer(const HostArray5DR8 Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NExch +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
-                     MyNeighbor->SendBuffer[IBuff] =
+                     SendBuff[IBuff] =
                          Array(M, L, K, MyList->Ind[ILayer][IExch], J);
                   }
                }
@@ -1182,17 +2234,20 @@ int Halo::packBuffer(const HostArray5DR8 Array) {
 // right) is the mesh element dimension. For integer arrays, the value from
 // the buffer is recast in a bit-preserving manner from a Real to the proper
 // integer type (I4 or I8) using reinterpret_cast, and then saved in the
-// input Array.
+// input Array. I8 values are unpacked with unpackValue, the inverse of
+// packValue.
 
 int Halo::unpackBuffer(HostArray1DI4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          I4 IBuff = MyList->Offsets[ILayer] + IExch;
          Array(MyList->Ind[ILayer][IExch]) =
-             reinterpret_cast<I4 &>(MyNeighbor->RecvBuffer[IBuff]);
+             reinterpret_cast<I4 &>(RecvBuff[IBuff]);
       }
    }
 
@@ -1203,11 +2258,12 @@ int Halo::unpackBuffer(HostArray1DI8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          I4 IBuff = MyList->Offsets[ILayer] + IExch;
-         Array(MyList->Ind[ILayer][IExch]) =
-             reinterpret_cast<I8 &>(MyNeighbor->RecvBuffer[IBuff]);
+         unpackValue(Array(MyList->Ind[ILayer][IExch]), RecvBuff, IBuff);
       }
    }
 
@@ -1218,10 +2274,12 @@ int Halo::unpackBuffer(HostArray1DR4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          I4 IBuff                          = MyList->Offsets[ILayer] + IExch;
-         Array(MyList->Ind[ILayer][IExch]) = MyNeighbor->RecvBuffer[IBuff];
+         Array(MyList->Ind[ILayer][IExch]) = RecvBuff[IBuff];
       }
    }
 
@@ -1230,12 +2288,17 @@ int Halo::unpackBuffer(HostArray1DR4 &Array) {
 
 int Halo::unpackBuffer(HostArray1DR8 &Array) {
 
+   if (ReducedPrec)
+      return unpackReduced(Array);
+
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          I4 IBuff                          = MyList->Offsets[ILayer] + IExch;
-         Array(MyList->Ind[ILayer][IExch]) = MyNeighbor->RecvBuffer[IBuff];
+         Array(MyList->Ind[ILayer][IExch]) = RecvBuff[IBuff];
       }
    }
 
@@ -1247,12 +2310,14 @@ int Halo::unpackBuffer(HostArray2DI4 &Array) {
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
    int NJ           = Array.extent(1);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          for (int J = 0; J < NJ; ++J) {
             I4 IBuff = (MyList->Offsets[ILayer] + IExch) * NJ + J;
             Array(MyList->Ind[ILayer][IExch], J) =
-                reinterpret_cast<I4 &>(MyNeighbor->RecvBuffer[IBuff]);
+                reinterpret_cast<I4 &>(RecvBuff[IBuff]);
          }
       }
    }
@@ -1265,12 +2330,13 @@ int Halo::unpackBuffer(HostArray2DI8 &Array) {
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
    int NJ           = Array.extent(1);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          for (int J = 0; J < NJ; ++J) {
             I4 IBuff = (MyList->Offsets[ILayer] + IExch) * NJ + J;
-            Array(MyList->Ind[ILayer][IExch], J) =
-                reinterpret_cast<I8 &>(MyNeighbor->RecvBuffer[IBuff]);
+            unpackValue(Array(MyList->Ind[ILayer][IExch], J), RecvBuff, IBuff);
          }
       }
    }
@@ -1283,12 +2349,13 @@ int Halo::unpackBuffer(HostArray2DR4 &Array) {
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
    int NJ           = Array.extent(1);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          for (int J = 0; J < NJ; ++J) {
             I4 IBuff = (MyList->Offsets[ILayer] + IExch) * NJ + J;
-            Array(MyList->Ind[ILayer][IExch], J) =
-                MyNeighbor->RecvBuffer[IBuff];
+            Array(MyList->Ind[ILayer][IExch], J) = RecvBuff[IBuff];
          }
       }
    }
@@ -1298,15 +2365,19 @@ int Halo::unpackBuffer(HostArray2DR4 &Array) {
 
 int Halo::unpackBuffer(HostArray2DR8 &Array) {
 
+   if (ReducedPrec)
+      return unpackReduced(Array);
+
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
    int NJ           = Array.extent(1);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
          for (int J = 0; J < NJ; ++J) {
             I4 IBuff = (MyList->Offsets[ILayer] + IExch) * NJ + J;
-            Array(MyList->Ind[ILayer][IExch], J) =
-                MyNeighbor->RecvBuffer[IBuff];
+            Array(MyList->Ind[ILayer][IExch], J) = RecvBuff[IBuff];
          }
       }
    }
@@ -1317,18 +2388,20 @@ int Halo::unpackBuffer(HostArray2DR8 &Array) {
 int Halo::unpackBuffer(HostArray3DI4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
                I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
+                   (K * NExch + MyList->Offsets[ILayer] + IExch) * NJ + J;
                Array(K, MyList->Ind[ILayer][IExch], J) =
-                   reinterpret_cast<I4 &>(MyNeighbor->RecvBuffer[IBuff]);
+                   reinterpret_cast<I4 &>(RecvBuff[IBuff]);
             }
          }
       }
@@ -1340,18 +2413,20 @@ int Halo::unpackBuffer(HostArray3DI4 &Array) {
 int Halo::unpackBuffer(HostArray3DI8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
                I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
-               Array(K, MyList->Ind[ILayer][IExch], J) =
-                   reinterpret_cast<I8 &>(MyNeighbor->RecvBuffer[IBuff]);
+                   (K * NExch + MyList->Offsets[ILayer] + IExch) * NJ + J;
+               unpackValue(Array(K, MyList->Ind[ILayer][IExch], J), RecvBuff,
+                           IBuff);
             }
          }
       }
@@ -1363,18 +2438,19 @@ int Halo::unpackBuffer(HostArray3DI8 &Array) {
 int Halo::unpackBuffer(HostArray3DR4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
                I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
-               Array(K, MyList->Ind[ILayer][IExch], J) =
-                   MyNeighbor->RecvBuffer[IBuff];
+                   (K * NExch + MyList->Offsets[ILayer] + IExch) * NJ + J;
+               Array(K, MyList->Ind[ILayer][IExch], J) = RecvBuff[IBuff];
             }
          }
       }
@@ -1385,19 +2461,23 @@ int Halo::unpackBuffer(HostArray3DR4 &Array) {
 
 int Halo::unpackBuffer(HostArray3DR8 &Array) {
 
+   if (ReducedPrec)
+      return unpackReduced(Array);
+
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
                I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
-               Array(K, MyList->Ind[ILayer][IExch], J) =
-                   MyNeighbor->RecvBuffer[IBuff];
+                   (K * NExch + MyList->Offsets[ILayer] + IExch) * NJ + J;
+               Array(K, MyList->Ind[ILayer][IExch], J) = RecvBuff[IBuff];
             }
          }
       }
@@ -1409,21 +2489,24 @@ int Halo::unpackBuffer(HostArray3DR8 &Array) {
 int Halo::unpackBuffer(HostArray4DI4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NExch +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
                   Array(L, K, MyList->Ind[ILayer][IExch], J) =
-                      reinterpret_cast<I4 &>(MyNeighbor->RecvBuffer[IBuff]);
+                      reinterpret_cast<I4 &>(RecvBuff[IBuff]);
                }
             }
          }
@@ -1436,21 +2519,24 @@ int Halo::unpackBuffer(HostArray4DI4 &Array) {
 int Halo::unpackBuffer(HostArray4DI8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NExch +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
-                  Array(L, K, MyList->Ind[ILayer][IExch], J) =
-                      reinterpret_cast<I8 &>(MyNeighbor->RecvBuffer[IBuff]);
+                  unpackValue(Array(L, K, MyList->Ind[ILayer][IExch], J),
+                              RecvBuff, IBuff);
                }
             }
          }
@@ -1463,21 +2549,23 @@ int Halo::unpackBuffer(HostArray4DI8 &Array) {
 int Halo::unpackBuffer(HostArray4DR4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NExch +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
-                  Array(L, K, MyList->Ind[ILayer][IExch], J) =
-                      MyNeighbor->RecvBuffer[IBuff];
+                  Array(L, K, MyList->Ind[ILayer][IExch], J) = RecvBuff[IBuff];
                }
             }
          }
@@ -1489,22 +2577,27 @@ int Halo::unpackBuffer(HostArray4DR4 &Array) {
 
 int Halo::unpackBuffer(HostArray4DR8 &Array) {
 
+   if (ReducedPrec)
+      return unpackReduced(Array);
+
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NExch +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
-                  Array(L, K, MyList->Ind[ILayer][IExch], J) =
-                      MyNeighbor->RecvBuffer[IBuff];
+                  Array(L, K, MyList->Ind[ILayer][IExch], J) = RecvBuff[IBuff];
                }
             }
          }
@@ -1517,23 +2610,26 @@ int Halo::unpackBuffer(HostArray4DR8 &Array) {
 int Halo::unpackBuffer(HostArray5DI4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
          for (int K = 0; K < NK; ++K) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NExch +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
                      Array(M, L, K, MyList->Ind[ILayer][IExch], J) =
-                         reinterpret_cast<I4 &>(MyNeighbor->RecvBuffer[IBuff]);
+                         reinterpret_cast<I4 &>(RecvBuff[IBuff]);
                   }
                }
             }
@@ -1547,23 +2643,26 @@ int Halo::unpackBuffer(HostArray5DI4 &Array) {
 int Halo::unpackBuffer(HostArray5DI8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
          for (int K = 0; K < NK; ++K) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NExch +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
-                     Array(M, L, K, MyList->Ind[ILayer][IExch], J) =
-                         reinterpret_cast<I8 &>(MyNeighbor->RecvBuffer[IBuff]);
+                     unpackValue(Array(M, L, K, MyList->Ind[ILayer][IExch], J),
+                                 RecvBuff, IBuff);
                   }
                }
             }
@@ -1577,23 +2676,26 @@ int Halo::unpackBuffer(HostArray5DI8 &Array) {
 int Halo::unpackBuffer(HostArray5DR4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
          for (int K = 0; K < NK; ++K) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NExch +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
                      Array(M, L, K, MyList->Ind[ILayer][IExch], J) =
-                         MyNeighbor->RecvBuffer[IBuff];
+                         RecvBuff[IBuff];
                   }
                }
             }
@@ -1606,24 +2708,30 @@ int Halo::unpackBuffer(HostArray5DR4 &Array) {
 
 int Halo::unpackBuffer(HostArray5DR8 &Array) {
 
+   if (ReducedPrec)
+      return unpackReduced(Array);
+
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
+   Real *RecvBuff = MyNeighbor->RecvBuffer.data() + BuffOffset;
+
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
          for (int K = 0; K < NK; ++K) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NExch +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
                      Array(M, L, K, MyList->Ind[ILayer][IExch], J) =
-                         MyNeighbor->RecvBuffer[IBuff];
+                         RecvBuff[IBuff];
                   }
                }
             }
@@ -1634,6 +2742,228 @@ int Halo::unpackBuffer(HostArray5DR8 &Array) {
    return 0;
 } // end unpackBuffer HostArray5DR8
 
+#ifdef OMEGA_TARGET_DEVICE
+//------------------------------------------------------------------------------
+// Generic device pack function. The device exchange list for the current
+// index space is used to pack the requested halo layers into the device send
+// buffer, starting at BuffOffset. The buffer layout is identical to the host
+// buffers. For reduced-precision exchanges of R8 arrays, the buffer is
+// viewed as an array of R4.
+
+template <typename T> int Halo::packDevice(const T &Array) {
+
+   ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NExch         = listSize(*MyList);
+
+   if constexpr (canReducePrecision<T>()) {
+      if (ReducedPrec) {
+         Kokkos::View<R4 *, MemSpace, Kokkos::MemoryUnmanaged> SendBuff(
+             reinterpret_cast<R4 *>(MyNeighbor->DevSendBuffer.data() +
+                                    BuffOffset),
+             TotSize * NExch);
+         packDeviceBuffer(SendBuff, 0, MyList->IndFlat, NExch, Array);
+         return 0;
+      }
+   }
+
+   packDeviceBuffer(MyNeighbor->DevSendBuffer, BuffOffset, MyList->IndFlat,
+                    NExch, Array);
+
+   return 0;
+} // end packDevice
+
+//------------------------------------------------------------------------------
+// Generic device unpack function. The device exchange list is used to unpack
+// the device receive buffer, starting at BuffOffset, into the halo elements
+// of the array on the device.
+
+template <typename T> int Halo::unpackDevice(const T &Array) {
+
+   ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NExch         = listSize(*MyList);
+
+   if constexpr (canReducePrecision<T>()) {
+      if (ReducedPrec) {
+         Kokkos::View<R4 *, MemSpace, Kokkos::MemoryUnmanaged> RecvBuff(
+             reinterpret_cast<R4 *>(MyNeighbor->DevRecvBuffer.data() +
+                                    BuffOffset),
+             TotSize * NExch);
+         unpackDeviceBuffer(RecvBuff, 0, MyList->IndFlat, NExch, Array);
+         return 0;
+      }
+   }
+
+   unpackDeviceBuffer(MyNeighbor->DevRecvBuffer, BuffOffset, MyList->IndFlat,
+                      NExch, Array);
+
+   return 0;
+} // end unpackDevice
+
+//------------------------------------------------------------------------------
+// Device packBuffer and unpackBuffer overloads for each supported device
+// array type. These simply call the generic device pack and unpack functions.
+
+int Halo::packBuffer(const Array1DI4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array1DI4
+
+int Halo::packBuffer(const Array1DI8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array1DI8
+
+int Halo::packBuffer(const Array1DR4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array1DR4
+
+int Halo::packBuffer(const Array1DR8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array1DR8
+
+int Halo::packBuffer(const Array2DI4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array2DI4
+
+int Halo::packBuffer(const Array2DI8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array2DI8
+
+int Halo::packBuffer(const Array2DR4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array2DR4
+
+int Halo::packBuffer(const Array2DR8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array2DR8
+
+int Halo::packBuffer(const Array3DI4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array3DI4
+
+int Halo::packBuffer(const Array3DI8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array3DI8
+
+int Halo::packBuffer(const Array3DR4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array3DR4
+
+int Halo::packBuffer(const Array3DR8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array3DR8
+
+int Halo::packBuffer(const Array4DI4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array4DI4
+
+int Halo::packBuffer(const Array4DI8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array4DI8
+
+int Halo::packBuffer(const Array4DR4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array4DR4
+
+int Halo::packBuffer(const Array4DR8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array4DR8
+
+int Halo::packBuffer(const Array5DI4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array5DI4
+
+int Halo::packBuffer(const Array5DI8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array5DI8
+
+int Halo::packBuffer(const Array5DR4 Array) {
+   return packDevice(Array);
+} // end packBuffer Array5DR4
+
+int Halo::packBuffer(const Array5DR8 Array) {
+   return packDevice(Array);
+} // end packBuffer Array5DR8
+
+int Halo::unpackBuffer(Array1DI4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array1DI4
+
+int Halo::unpackBuffer(Array1DI8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array1DI8
+
+int Halo::unpackBuffer(Array1DR4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array1DR4
+
+int Halo::unpackBuffer(Array1DR8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array1DR8
+
+int Halo::unpackBuffer(Array2DI4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array2DI4
+
+int Halo::unpackBuffer(Array2DI8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array2DI8
+
+int Halo::unpackBuffer(Array2DR4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array2DR4
+
+int Halo::unpackBuffer(Array2DR8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array2DR8
+
+int Halo::unpackBuffer(Array3DI4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array3DI4
+
+int Halo::unpackBuffer(Array3DI8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array3DI8
+
+int Halo::unpackBuffer(Array3DR4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array3DR4
+
+int Halo::unpackBuffer(Array3DR8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array3DR8
+
+int Halo::unpackBuffer(Array4DI4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array4DI4
+
+int Halo::unpackBuffer(Array4DI8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array4DI8
+
+int Halo::unpackBuffer(Array4DR4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array4DR4
+
+int Halo::unpackBuffer(Array4DR8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array4DR8
+
+int Halo::unpackBuffer(Array5DI4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array5DI4
+
+int Halo::unpackBuffer(Array5DI8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array5DI8
+
+int Halo::unpackBuffer(Array5DR4 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array5DR4
+
+int Halo::unpackBuffer(Array5DR8 &Array) {
+   return unpackDevice(Array);
+} // end unpackBuffer Array5DR8
+#endif
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
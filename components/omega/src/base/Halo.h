@@ -13,7 +13,12 @@
 /// exchange The halo exchanges are carried out via non-blocking MPI library
 /// routines. The Halo class public member function exchangeFullArrayHalo
 /// which is called by the user to perform halo exchanges is a template
-/// function and thus is fully defined in this header.
+/// function and thus is fully defined in this header. A split-phase version
+/// of the exchange (beginExchange/finishExchange) is also provided so that
+/// computation can be overlapped with communication. Both host arrays and
+/// device arrays are supported. Device arrays are packed and unpacked on the
+/// device and, if the MPI library is GPU-aware (OMEGA_MPI_ON_DEVICE), the
+/// device buffers are passed directly to MPI.
 ///
 //
 //===----------------------------------------------------------------------===//
@@ -22,7 +27,9 @@
 #include "Decomp.h"
 #include "Logging.h"
 #include "MachEnv.h"
+#include "OmegaKokkos.h"
 #include "mpi.h"
+#include <functional>
 #include <numeric>
 
 namespace OMEGA {
@@ -35,8 +42,269 @@ static const MPI_Datatype MPI_RealKind = MPI_FLOAT;
 static const MPI_Datatype MPI_RealKind = MPI_DOUBLE;
 #endif
 
-/// The meshElement enum identifies the index space to use for a halo exchange.
-enum MeshElement { OnCell, OnEdge, OnVertex };
+/// The HaloExchangeMethod enum selects how halo data is communicated, either
+/// with point-to-point messages to each neighbor or with MPI neighborhood
+/// collectives on a distributed graph communicator.
+enum HaloExchangeMethod { PointToPoint, NeighborCollective };
+
+/// Number of buffer elements of type B used to hold one array value of type
+/// T. Floating point values are converted to B and use a single element.
+/// Integer values are stored bit for bit, so integers wider than B (I8 when
+/// Real is R4) are split across consecutive buffer elements.
+template <typename B, typename T> constexpr int bufferSlots() {
+   if constexpr (std::is_integral_v<T>) {
+      return (sizeof(T) + sizeof(B) - 1) / sizeof(B);
+   } else {
+      return 1;
+   }
+}
+
+/// Pack a single array value into the buffer Buff of elements of type B,
+/// which is Real or, for reduced-precision exchanges, R4. IVal is the index
+/// of the value in the buffer, which occupies bufferSlots<B, T>() elements.
+/// Integer values are stored in a bit-preserving manner so that they can be
+/// recovered exactly by unpackValue.
+template <typename B, typename T>
+KOKKOS_INLINE_FUNCTION void packValue(B *Buff, const I4 IVal, const T &Val) {
+   constexpr int NSlots = bufferSlots<B, T>();
+   if constexpr (std::is_integral_v<T> and NSlots == 1) {
+      static_assert(sizeof(T) <= sizeof(B), "integer wider than buffer");
+      reinterpret_cast<T &>(Buff[IVal]) = Val;
+   } else if constexpr (std::is_integral_v<T>) {
+      using Word = std::conditional_t<sizeof(B) == sizeof(I4), I4, I8>;
+      static_assert(sizeof(T) == NSlots * sizeof(Word),
+                    "integer not a whole number of buffer elements");
+      const Word *Words = reinterpret_cast<const Word *>(&Val);
+      for (int S = 0; S < NSlots; ++S) {
+         reinterpret_cast<Word &>(Buff[IVal * NSlots + S]) = Words[S];
+      }
+   } else {
+      Buff[IVal] = static_cast<B>(Val);
+   }
+}
+
+/// Unpack a single array value from the buffer Buff, the inverse of
+/// packValue
+template <typename B, typename T>
+KOKKOS_INLINE_FUNCTION void unpackValue(T &Val, const B *Buff, const I4 IVal) {
+   constexpr int NSlots = bufferSlots<B, T>();
+   if constexpr (std::is_integral_v<T> and NSlots == 1) {
+      static_assert(sizeof(T) <= sizeof(B), "integer wider than buffer");
+      Val = reinterpret_cast<const T &>(Buff[IVal]);
+   } else if constexpr (std::is_integral_v<T>) {
+      using Word = std::conditional_t<sizeof(B) == sizeof(I4), I4, I8>;
+      static_assert(sizeof(T) == NSlots * sizeof(Word),
+                    "integer not a whole number of buffer elements");
+      Word *Words = reinterpret_cast<Word *>(&Val);
+      for (int S = 0; S < NSlots; ++S) {
+         Words[S] = reinterpret_cast<const Word &>(Buff[IVal * NSlots + S]);
+      }
+   } else {
+      Val = static_cast<T>(Buff[IVal]);
+   }
+}
+
+/// Pack the elements of a device array listed in the device index array Ind
+/// into the device buffer Buffer using a Kokkos kernel. The buffer layout
+/// matches the host packBuffer routines so that host and device buffers are
+/// interchangeable. Only the first NExch entries of Ind (the requested halo
+/// layers) are packed, and NExch is also the buffer stride so that the buffer
+/// is contiguous for partial-depth exchanges. Offset is the start of this
+/// array in the buffer, which may hold several arrays. In multidimensional
+/// arrays the second fastest index (second index from the right) is the mesh
+/// element dimension. The buffer is a 1D device view of Real or, for
+/// reduced-precision exchanges, an unmanaged R4 view of the Real buffer.
+/// These are free functions rather than Halo members since device lambdas
+/// can not be defined within private member functions.
+template <typename B, typename T>
+void packDeviceBuffer(const B &Buffer,      // [out] device buffer
+                      const I4 Offset,      // [in] offset into buffer
+                      const Array1DI4 &Ind, // [in] indices to pack
+                      const I4 NExch,       // [in] number to pack
+                      const T &Array        // [in] array to pack
+) {
+   constexpr int NDims = T::rank;
+   auto *Buff          = Buffer.data() + Offset;
+   if constexpr (NDims == 1) {
+      parallelFor(
+          "HaloPack1D", {NExch}, KOKKOS_LAMBDA(int IExch) {
+             packValue(Buff, IExch, Array(Ind(IExch)));
+          });
+   } else if constexpr (NDims == 2) {
+      const I4 NJ = Array.extent(1);
+      parallelFor(
+          "HaloPack2D", {NExch, NJ}, KOKKOS_LAMBDA(int IExch, int J) {
+             const I4 IBuff = IExch * NJ + J;
+             packValue(Buff, IBuff, Array(Ind(IExch), J));
+          });
+   } else if constexpr (NDims == 3) {
+      const I4 NK = Array.extent(0);
+      const I4 NJ = Array.extent(2);
+      parallelFor(
+          "HaloPack3D", {NK, NExch, NJ},
+          KOKKOS_LAMBDA(int K, int IExch, int J) {
+             const I4 IBuff = (K * NExch + IExch) * NJ + J;
+             packValue(Buff, IBuff, Array(K, Ind(IExch), J));
+          });
+   } else if constexpr (NDims == 4) {
+      const I4 NL = Array.extent(0);
+      const I4 NK = Array.extent(1);
+      const I4 NJ = Array.extent(3);
+      parallelFor(
+          "HaloPack4D", {NL, NK, NExch, NJ},
+          KOKKOS_LAMBDA(int L, int K, int IExch, int J) {
+             const I4 IBuff = ((L * NK + K) * NExch + IExch) * NJ + J;
+             packValue(Buff, IBuff, Array(L, K, Ind(IExch), J));
+          });
+   } else if constexpr (NDims == 5) {
+      const I4 NM = Array.extent(0);
+      const I4 NL = Array.extent(1);
+      const I4 NK = Array.extent(2);
+      const I4 NJ = Array.extent(4);
+      parallelFor(
+          "HaloPack5D", {NM, NL, NK, NExch, NJ},
+          KOKKOS_LAMBDA(int M, int L, int K, int IExch, int J) {
+             const I4 IBuff =
+                 (((M * NL + L) * NK + K) * NExch + IExch) * NJ + J;
+             packValue(Buff, IBuff, Array(M, L, K, Ind(IExch), J));
+          });
+   }
+}
+
+/// Unpack the device buffer Buffer into the elements of a device array
+/// listed in the device index array Ind using a Kokkos kernel, the inverse
+/// of packDeviceBuffer.
+template <typename B, typename T>
+void unpackDeviceBuffer(const B &Buffer,      // [in] device buffer
+                        const I4 Offset,      // [in] offset into buffer
+                        const Array1DI4 &Ind, // [in] indices to unpack
+                        const I4 NExch,       // [in] number to unpack
+                        const T &Array        // [inout] array to unpack
+) {
+   constexpr int NDims = T::rank;
+   const auto *Buff    = Buffer.data() + Offset;
+   if constexpr (NDims == 1) {
+      parallelFor(
+          "HaloUnpack1D", {NExch}, KOKKOS_LAMBDA(int IExch) {
+             unpackValue(Array(Ind(IExch)), Buff, IExch);
+          });
+   } else if constexpr (NDims == 2) {
+      const I4 NJ = Array.extent(1);
+      parallelFor(
+          "HaloUnpack2D", {NExch, NJ}, KOKKOS_LAMBDA(int IExch, int J) {
+             const I4 IBuff = IExch * NJ + J;
+             unpackValue(Array(Ind(IExch), J), Buff, IBuff);
+          });
+   } else if constexpr (NDims == 3) {
+      const I4 NK = Array.extent(0);
+      const I4 NJ = Array.extent(2);
+      parallelFor(
+          "HaloUnpack3D", {NK, NExch, NJ},
+          KOKKOS_LAMBDA(int K, int IExch, int J) {
+             const I4 IBuff = (K * NExch + IExch) * NJ + J;
+             unpackValue(Array(K, Ind(IExch), J), Buff, IBuff);
+          });
+   } else if constexpr (NDims == 4) {
+      const I4 NL = Array.extent(0);
+      const I4 NK = Array.extent(1);
+      const I4 NJ = Array.extent(3);
+      parallelFor(
+          "HaloUnpack4D", {NL, NK, NExch, NJ},
+          KOKKOS_LAMBDA(int L, int K, int IExch, int J) {
+             const I4 IBuff = ((L * NK + K) * NExch + IExch) * NJ + J;
+             unpackValue(Array(L, K, Ind(IExch), J), Buff, IBuff);
+          });
+   } else if constexpr (NDims == 5) {
+      const I4 NM = Array.extent(0);
+      const I4 NL = Array.extent(1);
+      const I4 NK = Array.extent(2);
+      const I4 NJ = Array.extent(4);
+      parallelFor(
+          "HaloUnpack5D", {NM, NL, NK, NExch, NJ},
+          KOKKOS_LAMBDA(int M, int L, int K, int IExch, int J) {
+             const I4 IBuff =
+                 (((M * NL + L) * NK + K) * NExch + IExch) * NJ + J;
+             unpackValue(Array(M, L, K, Ind(IExch), J), Buff, IBuff);
+          });
+   }
+}
+
+/// The HaloRequest class template holds the state of a split-phase halo
+/// exchange between the calls to Halo::beginExchange and
+/// Halo::finishExchange, including a (shallow) copy of the array being
+/// exchanged.
+template <typename T> class HaloRequest {
+ public:
+   T Array;                  ///< array being exchanged
+   MeshElement Elem{OnCell}; ///< index space of the array
+   I4 NumLayers{0};          ///< number of halo layers exchanged
+   I4 TotSize{0};            ///< buffer size at each mesh element
+   bool OnDevice{false};     ///< true if array resides in device memory
+   bool ReducedPrec{false};  ///< true if array is sent in R4 precision
+   bool Active{false};       ///< true if exchange is in progress
+};
+
+/// Returns true if halo messages for arrays of type T can be sent in reduced
+/// (R4) precision, which is only the case for R8 floating point arrays
+template <typename T> constexpr bool canReducePrecision() {
+   return std::is_same_v<typename T::non_const_value_type, R8>;
+}
+
+class Halo;
+
+/// The HaloGroup class collects a list of arrays, of any supported type and
+/// rank and defined on any index space, to be exchanged together with
+/// Halo::exchangeGroup (or Halo::beginExchange/finishExchange). All members
+/// of a group are packed into a single buffer per neighboring task so that
+/// only one message is exchanged with each neighbor. All arrays in a group
+/// must reside in the same memory space (host or device). The group stores
+/// (shallow) copies of the arrays, so arrays must not be reallocated while
+/// they are members of a group. A group constructed with a pattern name is
+/// exchanged in persistent mode, in which the buffers and persistent MPI
+/// requests for the pattern are created once and reused by every exchange
+/// of any group with that name.
+class HaloGroup {
+ public:
+   /// Construct a group, optionally naming the persistent exchange pattern
+   explicit HaloGroup(
+       const std::string &PatternName = "" ///< [in] persistent pattern name
+   );
+
+   /// Add an array defined on index space Elem to the group. If NLayers is
+   /// given, only the first NLayers halo layers of the array are exchanged.
+   /// If ReducedPrec is true, an R8 array is sent in R4 precision, halving
+   /// its message size at the cost of rounding the halo values to R4.
+   template <typename T>
+   int add(T &Array,                ///< [in] array to add to the group
+           MeshElement Elem,        ///< [in] index space Array is defined on
+           I4 NLayers       = 0,    ///< [in] halo layers to exchange, 0 for all
+           bool ReducedPrec = false ///< [in] send R8 array in R4 precision
+   );
+
+   /// Remove all arrays from the group
+   void clear();
+
+   /// Number of arrays in the group
+   I4 size() const { return Members.size(); }
+
+ private:
+   /// Information needed to pack and unpack one group member
+   struct Member {
+      MeshElement Elem;                  ///< index space of the array
+      I4 TotSize;                        ///< buffer size per mesh element
+      I4 NumLayers;                      ///< halo layers, 0 for all
+      bool ReducedPrec;                  ///< true if sent in R4 precision
+      std::function<int(Halo &)> Pack;   ///< packs array into buffer
+      std::function<int(Halo &)> Unpack; ///< unpacks buffer into array
+   };
+
+   std::vector<Member> Members; ///< arrays in the group
+   std::string Name;            ///< persistent pattern name, empty if none
+   bool OnDevice{false};        ///< true if arrays reside in device memory
+   bool Active{false};          ///< true if exchange is in progress
+
+   friend class Halo;
+};
 
 /// The Halo class contains two nested classes, ExchList and Neighbor classes,
 /// defined below. The Halo class holds all the Neighbor objects needed by a
@@ -62,9 +330,17 @@ class Halo {
    I4 MyTask;          /// local MPI Task ID
    I4 HaloWidth;       /// cell width of halo
    I4 NumLayers;       /// number of halo layers for current exchange
-   I4 TotSize;         /// Array size at each mesh element for current exchange
+   I4 TotSize;         /// Buffer size at each mesh element for current exchange
    MPI_Comm MyComm;    /// MPI communicator handle
    MeshElement MyElem; /// index space of current array
+   bool OnDevice;      /// true if current array resides in device memory
+   bool InProgress;    /// true if a split-phase exchange is in progress
+   I4 BuffOffset;      /// offset into Neighbor buffers for current array
+   bool ReducedPrec;   /// true if current array is sent in R4 precision
+
+   HaloExchangeMethod Method; /// method used to communicate halo data
+   MPI_Comm NghbrComm;        /// distributed graph communicator of neighbors
+   MPI_Request CollReq;       /// request handle for neighborhood collective
 
    /// Forward Declaration of Neighbor class, defined below
    class Neighbor;
@@ -103,6 +379,10 @@ class Halo {
       /// indices of elements to be packed into the send buffer, or the local
       /// indices of elements unpacked from the receive buffer
       std::vector<std::vector<I4>> Ind;
+      /// Device copy of Ind collapsed along the halo layer dimension, so
+      /// that the entries for layer ILayer start at Offsets[ILayer]. Used
+      /// by the device pack and unpack kernels.
+      Array1DI4 IndFlat;
 
       /// The constructor for the ExchList class takes as input an array of
       /// vectors, each containing a list of indices to be sent or received for
@@ -132,6 +412,14 @@ class Halo {
       ExchList SendLists[3], RecvLists[3];
       /// Buffers for MPI communication
       std::vector<Real> SendBuffer, RecvBuffer;
+      /// Device buffers for exchanges of device arrays. These are only
+      /// reallocated when a larger buffer is needed.
+      Array1DReal DevSendBuffer, DevRecvBuffer;
+      /// Host staging buffers for device exchanges, used only when the MPI
+      /// library can not access device memory directly
+      HostArray1DReal HostSendBuffer, HostRecvBuffer;
+      /// Sizes of the messages sent and received in the current exchange
+      I4 SendSize{0}, RecvSize{0};
       /// MPI request handles for non-blocking MPI communication
       MPI_Request RReq, SReq;
 
@@ -167,15 +455,25 @@ class Halo {
                                  HostArray2DI4 Locs,
                                  std::vector<I4> &ListOfTasks);
 
-   /// Set SendFlags and RecvFlags for the input index space. Utilized only
-   /// during halo construction
-   int setNeighborFlags(std::vector<I4> NeighborElem,
+   /// Set SendFlags and RecvFlags for the input index space from the sorted
+   /// list of tasks owning halo elements and the masks received from each
+   /// neighbor in exchangeHaloMasks. Utilized only during halo construction
+   int setNeighborFlags(const std::vector<I4> &ListOfTasks,
+                        const std::vector<I4> &NeighborMasks,
                         const MeshElement IdxSpace);
 
+   /// Sends a mask to each task in DestTasks and receives the masks sent to
+   /// the local task, whose senders are not known in advance, with a sparse
+   /// nonblocking consensus (NBX) exchange. Utilized only during halo
+   /// construction
+   int exchangeHaloMasks(const std::vector<I4> &DestTasks,
+                         const std::vector<I4> &DestMasks,
+                         std::vector<I4> &SrcTasks, std::vector<I4> &SrcMasks);
+
    /// Uses info from Decomp to determine all tasks which own elements in the
    /// halo of the local task or need locally owned elements for their halo.
    /// Utilized only during halo construction
-   int determineNeighbors(const I4 NumTasks);
+   int determineNeighbors();
 
    /// Send a vector of integers to each neighboring task and receive a vector
    /// of integers from each neighboring task. The first dimension of each
@@ -196,13 +494,221 @@ class Halo {
                          std::vector<std::vector<std::vector<I4>>> &RecvLists,
                          const MeshElement IndexSpace);
 
-   /// Allocate the recieve buffers and call MPI_Irecv for each Neighbor
+   /// Returns the configuration stored with a snapshot of the halo, which
+   /// must match for the snapshot to be reused. It includes a hash of the
+   /// global IDs of the decomposition.
+   std::vector<I4> snapshotConfig(const I4 NumTasks) const;
+
+   /// Restore the neighbor list, neighbor flags and exchange lists from the
+   /// snapshot of the local task. Returns a non-zero error code on all tasks
+   /// if the snapshots do not exist or do not match Config, in which case the
+   /// exchange lists must be generated. Utilized only during halo
+   /// construction
+   int readSnapshot(const std::vector<I4> &Config,
+                    std::vector<std::vector<std::vector<I4>>> (&SendLists)[3],
+                    std::vector<std::vector<std::vector<I4>>> (&RecvLists)[3]);
+
+   /// Write the neighbor list, neighbor flags and exchange lists to the
+   /// snapshot of the local task for reuse in later runs. Utilized only
+   /// during halo construction
+   int writeSnapshot(
+       const std::vector<I4> &Config,
+       const std::vector<std::vector<std::vector<I4>>> (&SendLists)[3],
+       const std::vector<std::vector<std::vector<I4>>> (&RecvLists)[3]) const;
+
+   /// The PersistentPattern class holds the buffers and persistent MPI
+   /// requests for one named exchange pattern. The buffers are swapped into
+   /// the Neighbor objects for the duration of each exchange using the
+   /// pattern, which keeps their addresses fixed so the persistent requests
+   /// remain valid. Buffers only grow, to the largest message size seen.
+   class PersistentPattern {
+    private:
+      std::vector<std::vector<Real>> SendBuffers, RecvBuffers;
+      std::vector<Array1DReal> DevSendBuffers, DevRecvBuffers;
+      std::vector<HostArray1DReal> HostSendBuffers, HostRecvBuffers;
+      std::vector<I4> SendSizes, RecvSizes; /// message sizes of the requests
+      std::vector<MPI_Request> SendReqs, RecvReqs; /// persistent requests
+      bool OnDevice{false};    /// true if the buffers bound are device buffers
+      bool Initialized{false}; /// true once the requests have been created
+
+      /// Halo is a friend class to allow access to private members
+      /// of the class
+      friend class Halo;
+   }; // end class PersistentPattern
+
+   /// Persistent exchange patterns, stored by name
+   std::map<std::string, PersistentPattern> Patterns;
+
+   /// Pattern used by the current exchange, nullptr if not persistent
+   PersistentPattern *MyPattern{nullptr};
+
+   /// Set up or reuse the persistent pattern labeled Name for the message
+   /// sizes of the current exchange
+   int setupPattern(const std::string &Name);
+
+   /// Swap the buffers of a persistent pattern with the Neighbor buffers
+   void swapPatternBuffers(PersistentPattern &Pattern);
+
+   /// Free the persistent MPI requests of a pattern
+   void freePatternRequests(PersistentPattern &Pattern);
+
+   /// Buffer pointers passed to MPI for the current Neighbor
+   Real *recvPointer();
+   Real *sendPointer();
+
+   /// Set the send and receive message sizes of each Neighbor for an
+   /// exchange of a single array in the current index space
+   int setExchangeSizes();
+
+   /// Allocate the send and receive buffers of each Neighbor for the
+   /// message sizes of the current exchange
+   int allocBuffers();
+
+   /// Make sure the device buffers of the current Neighbor are large enough
+   /// for a device exchange and return the buffer size needed
+   I4 allocDeviceBuffers();
+
+   /// Call MPI_Irecv for each Neighbor to receive a message from
    int startReceives();
 
    /// Call MPI_Isend for each Neighbor to send the packed buffers to
    /// the neighboring tasks
    int startSends();
 
+   /// Start all sends and receives with a single neighborhood collective
+   int startNeighborCollective();
+
+   /// Copy a received message staged in host memory to the device receive
+   /// buffer of the current Neighbor for device exchanges
+   int copyRecvToDevice();
+
+   /// Set the index space, number of halo layers, array size per mesh
+   /// element and precision of the next array to pack or unpack. A
+   /// non-positive number of layers selects all halo layers of the index
+   /// space.
+   void setMemberState(MeshElement Elem, I4 InTotSize, I4 InNumLayers = 0,
+                       bool InReducedPrec = false);
+
+   /// Total number of halo layers for the index space Elem
+   I4 maxLayers(MeshElement Elem) const;
+
+   /// Number of elements in the first NumLayers halo layers of a list
+   I4 listSize(const ExchList &List) const;
+
+   /// Number of Real buffer elements needed to hold NValues values of the
+   /// current array, accounting for reduced-precision exchanges
+   I4 messageSize(I4 NValues) const;
+
+   /// Pack and unpack an R8 array in R4 precision, with two R4 values
+   /// stored in each Real buffer element when Real is R8
+   template <typename T> int packReduced(const T &Array);
+   template <typename T> int unpackReduced(T &Array);
+
+   /// Number of Real buffer elements used for each value of an array of
+   /// type T, which is more than one only for I8 arrays when Real is R4
+   template <typename T> static constexpr I4 bufferSlots() {
+      return OMEGA::bufferSlots<Real, typename T::non_const_value_type>();
+   }
+
+   /// Compute the number of array elements per mesh element of an array
+   /// in which the second index from the right is the mesh dimension
+   template <typename T> static I4 elementSize(const T &Array) {
+      I4 NDims = Array.Rank;
+      I4 Size  = 1;
+      if (NDims == 2) {
+         Size = Array.extent(1);
+      } else if (NDims > 2) {
+         for (int I = 0; I < NDims - 2; ++I) {
+            Size *= Array.extent(I);
+         }
+         Size *= Array.extent(NDims - 1);
+      }
+      return Size;
+   }
+
+   /// Until all messages from neighboring tasks are received, loop through
+   /// Neighbor objects and use MPI_Test to check if each message has been
+   /// received, calling UnpackNeighbor(INghbr) upon receipt of each message.
+   /// Then waits for all local sends to complete.
+   template <typename F> int receiveAndUnpack(F &&UnpackNeighbor) {
+
+      I4 IErr{0}; // error code
+
+      // With neighborhood collectives, all messages arrive together
+      if (Method == NeighborCollective) {
+         MPI_Wait(&CollReq, MPI_STATUS_IGNORE);
+         for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+            MyNeighbor = &Neighbors[INghbr];
+            if (MyNeighbor->RecvSize > 0) {
+               copyRecvToDevice();
+               UnpackNeighbor(INghbr);
+            }
+         }
+         if (OnDevice)
+            Kokkos::fence();
+         return IErr;
+      }
+
+      // Logical flag to track if all messages have been received
+      bool AllReceived{false};
+
+      I4 MaxIter = 1000000000; // Large integer to prevent infinite loop
+      I4 IPass   = 0;          // Number of passes through while loop
+      I4 NRcvd   = 0;          // Integer to track number of messages received
+
+      // Total number of messages the local task will receive
+      I4 NMessages = 0;
+      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+         if (Neighbors[INghbr].RecvSize > 0)
+            ++NMessages;
+      }
+
+      while (not AllReceived) {
+         for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+            MyNeighbor = &Neighbors[INghbr];
+            if (MyNeighbor->RecvSize > 0) {
+               if (not MyNeighbor->Received) {
+                  MPI_Test(&MyNeighbor->RReq, &MyNeighbor->Received,
+                           MPI_STATUS_IGNORE);
+                  if (MyNeighbor->Received) {
+                     ++NRcvd;
+                  }
+               }
+               if (MyNeighbor->Received and not MyNeighbor->Unpacked) {
+                  copyRecvToDevice();
+                  UnpackNeighbor(INghbr);
+                  MyNeighbor->Unpacked = true;
+               }
+            }
+         }
+
+         if (NRcvd == NMessages) {
+            AllReceived = true;
+         }
+         ++IPass;
+         if (IPass == MaxIter) {
+            LOG_ERROR("Halo: Maximum iterations reached during halo exchange");
+            IErr = -1;
+            break;
+         }
+      }
+
+      // Wait for all sends to complete before the send buffers can be reused
+      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+         MyNeighbor = &Neighbors[INghbr];
+         if (MyNeighbor->SendSize > 0) {
+            MPI_Wait(&MyNeighbor->SReq, MPI_STATUS_IGNORE);
+         }
+      }
+
+      // Make sure all unpack kernels are complete before the device buffers
+      // can be reused by another exchange
+      if (OnDevice)
+         Kokkos::fence();
+
+      return IErr;
+   } // end receiveAndUnpack
+
    /// Buffer pack functions overloaded to each supported Kokkos array type.
    /// Select out the proper elements from the input Array to send to a
    /// neighboring task and pack them into SendBuffer for that Neighbor
@@ -252,13 +758,73 @@ class Halo {
    int unpackBuffer(HostArray5DR4 &Array);
    int unpackBuffer(HostArray5DR8 &Array);
 
+#ifdef OMEGA_TARGET_DEVICE
+   /// Device buffer pack functions overloaded to each supported device
+   /// array type. These select the proper elements from the input Array
+   /// and pack them into DevSendBuffer for that Neighbor on the device.
+   /// On host-only builds the device array types are identical to the host
+   /// array types and the host functions above are used instead.
+   int packBuffer(const Array1DI4 Array);
+   int packBuffer(const Array1DI8 Array);
+   int packBuffer(const Array1DR4 Array);
+   int packBuffer(const Array1DR8 Array);
+   int packBuffer(const Array2DI4 Array);
+   int packBuffer(const Array2DI8 Array);
+   int packBuffer(const Array2DR4 Array);
+   int packBuffer(const Array2DR8 Array);
+   int packBuffer(const Array3DI4 Array);
+   int packBuffer(const Array3DI8 Array);
+   int packBuffer(const Array3DR4 Array);
+   int packBuffer(const Array3DR8 Array);
+   int packBuffer(const Array4DI4 Array);
+   int packBuffer(const Array4DI8 Array);
+   int packBuffer(const Array4DR4 Array);
+   int packBuffer(const Array4DR8 Array);
+   int packBuffer(const Array5DI4 Array);
+   int packBuffer(const Array5DI8 Array);
+   int packBuffer(const Array5DR4 Array);
+   int packBuffer(const Array5DR8 Array);
+
+   /// Device buffer unpack functions overloaded to each supported device
+   /// array type. After receiving a message, the elements of DevRecvBuffer
+   /// for that Neighbor are saved into the halo elements of the input Array
+   /// on the device.
+   int unpackBuffer(Array1DI4 &Array);
+   int unpackBuffer(Array1DI8 &Array);
+   int unpackBuffer(Array1DR4 &Array);
+   int unpackBuffer(Array1DR8 &Array);
+   int unpackBuffer(Array2DI4 &Array);
+   int unpackBuffer(Array2DI8 &Array);
+   int unpackBuffer(Array2DR4 &Array);
+   int unpackBuffer(Array2DR8 &Array);
+   int unpackBuffer(Array3DI4 &Array);
+   int unpackBuffer(Array3DI8 &Array);
+   int unpackBuffer(Array3DR4 &Array);
+   int unpackBuffer(Array3DR8 &Array);
+   int unpackBuffer(Array4DI4 &Array);
+   int unpackBuffer(Array4DI8 &Array);
+   int unpackBuffer(Array4DR4 &Array);
+   int unpackBuffer(Array4DR8 &Array);
+   int unpackBuffer(Array5DI4 &Array);
+   int unpackBuffer(Array5DI8 &Array);
+   int unpackBuffer(Array5DR4 &Array);
+   int unpackBuffer(Array5DR8 &Array);
+
+   /// Generic implementations of the device pack and unpack overloads
+   template <typename T> int packDevice(const T &Array);
+   template <typename T> int unpackDevice(const T &Array);
+#endif
+
  public:
    // Methods
 
    /// initialize default Halo
    static int init();
 
-   /// Construct a new halo labeled Name for the input MachEnv and Decomp
+   /// Construct a new halo labeled Name for the input MachEnv and Decomp.
+   /// If the Decomp has a snapshot prefix, the exchange lists are restored
+   /// from the snapshot files of an earlier run if they exist and match,
+   /// otherwise they are generated and the snapshot files are written.
    Halo(const std::string &Name, const MachEnv *InEnv, const Decomp *InDecomp);
 
    /// Destructor
@@ -277,118 +843,231 @@ class Halo {
    /// Retrieves a pointer to a Halo object by Name
    static Halo *get(std::string Name);
 
+   /// Select the method used to communicate halo data, point-to-point
+   /// (default) or MPI neighborhood collectives
+   int setExchangeMethod(HaloExchangeMethod InMethod);
+
+   /// Return the method used to communicate halo data
+   HaloExchangeMethod getExchangeMethod() const;
+
+   /// Return the tasks the local task exchanges halo messages with. The list
+   /// is sorted and symmetric: each task in it also lists the local task.
+   const std::vector<I4> &getNeighborTasks() const { return NeighborList; }
+
+   /// Return the MPI communicator of the halo
+   MPI_Comm getComm() const { return MyComm; }
+
    //---------------------------------------------------------------------------
-   // Function template to perform a full halo exchange on the input Kokkos
-   // array of any supported type defined on the input index space ThisElem
+   // Function template to start a split-phase halo exchange on the input
+   // Kokkos array of any supported type defined on the input index space
+   // ThisElem. Receives are posted and the owned elements needed by each
+   // neighboring task are packed and sent, but the function returns without
+   // waiting for any messages. The exchange must be completed with a call to
+   // finishExchange using the same Request. Between the two calls, the owned
+   // elements of Array may be read or updated, but the halo elements must
+   // not be accessed since they are overwritten in finishExchange. Only one
+   // split-phase exchange may be in progress for a given Halo at a time. If
+   // NLayers is given, only the first NLayers halo layers are exchanged. If
+   // ReducedPrec is true, an R8 array is sent in R4 precision, halving the
+   // message sizes, and its halo values are rounded to R4 precision. The
+   // flag is ignored for other array types.
    template <typename T>
-   int
-   exchangeFullArrayHalo(T &Array,            // Kokkos array of any type
-                         MeshElement ThisElem // index space Array is defined on
+   int beginExchange(T &Array,                // Kokkos array of any type
+                     MeshElement ThisElem,    // index space Array is defined on
+                     HaloRequest<T> &Request, // request handle for exchange
+                     I4 NLayers       = 0,    // halo layers to exchange
+                     bool ReducedPrec = false // send R8 array in R4 precision
    ) {
 
       I4 IErr{0}; // error code
 
-      // Logical flag to track if all messages have been received
-      bool AllReceived{false};
-
-      // Save the index space the input array is defined on
-      MyElem = ThisElem;
+      if (InProgress) {
+         LOG_ERROR("Halo: beginExchange called while another exchange is "
+                   "in progress");
+         return -1;
+      }
 
-      // For cell-based quantities, the number of halo layers equals HaloWidth,
-      // edge- and vertex-based quantities have an extra layer.
-      if (MyElem == OnCell) {
-         NumLayers = HaloWidth;
-      } else {
-         NumLayers = HaloWidth + 1;
+      // Messages can not be sent from within a kernel graph
+      if (KernelGraph::isCapturing()) {
+         KernelGraph::abortCapture("halo exchange");
+         return -1;
       }
 
-      // Determine the number of array elements per cell, edge, or vertex
-      // in the input array
-      I4 NDims = Array.Rank;
-      if (NDims == 1) {
-         TotSize = 1;
-      } else if (NDims == 2) {
-         TotSize = Array.extent(1);
-      } else {
-         TotSize = 1;
-         for (int I = 0; I < NDims - 2; ++I) {
-            TotSize *= Array.extent(I);
-         }
-         TotSize *= Array.extent(NDims - 1);
+      // Determine whether the array resides in device memory. Device arrays
+      // are packed and unpacked on the device using device buffers.
+      OnDevice = not Kokkos::SpaceAccessibility<
+          HostExecSpace, typename T::memory_space>::accessible;
+
+      if (NLayers < 0 or NLayers > maxLayers(ThisElem)) {
+         LOG_ERROR("Halo: requested {} halo layers, only {} available",
+                   NLayers, maxLayers(ThisElem));
+         return -1;
       }
 
-      // Allocate the receive buffers and Call MPI_Irecv for each Neighbor
-      // so the local task is ready to accept messages from each
-      // neighboring task
-      startReceives();
+      // Save the index space the input array is defined on, the number of
+      // halo layers to exchange, the number of array elements per cell,
+      // edge, or vertex in the input array and the precision to send it in
+      setMemberState(ThisElem, elementSize(Array) * bufferSlots<T>(), NLayers,
+                     ReducedPrec and canReducePrecision<T>());
+      BuffOffset = 0;
+
+      // Set the message sizes and allocate the buffers for each Neighbor,
+      // then call MPI_Irecv for each Neighbor so the local task is ready to
+      // accept messages from each neighboring task
+      setExchangeSizes();
+      allocBuffers();
+      IErr = startReceives();
 
-      // Loop through each Neighbor, resetting communication flags and packing
-      // buffers if there are elements to be sent to the neighboring task
+      // Loop through each Neighbor, packing buffers if there are elements to
+      // be sent to the neighboring task
       for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-         MyNeighbor           = &Neighbors[INghbr];
-         MyNeighbor->Received = false;
-         MyNeighbor->Unpacked = false;
+         MyNeighbor = &Neighbors[INghbr];
          if (SendFlags[MyElem][INghbr]) {
             packBuffer(Array);
          }
       }
 
       // Call MPI_Isend for each Neighbor to send the packed buffers
-      startSends();
+      IErr += startSends();
 
-      // Wait for all sends to complete before proceeding
-      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-         if (SendFlags[MyElem][INghbr]) {
-            MyNeighbor = &Neighbors[INghbr];
-            MPI_Wait(&MyNeighbor->SReq, MPI_STATUS_IGNORE);
-         }
+      // Save the state of this exchange in the request handle
+      Request.Array       = Array;
+      Request.Elem        = MyElem;
+      Request.NumLayers   = NumLayers;
+      Request.TotSize     = TotSize;
+      Request.OnDevice    = OnDevice;
+      Request.ReducedPrec = this->ReducedPrec;
+      Request.Active      = true;
+
+      InProgress = true;
+
+      return IErr;
+   } // end beginExchange
+
+   //---------------------------------------------------------------------------
+   // Function template to complete a split-phase halo exchange started by
+   // beginExchange. Waits for the messages from each neighboring task,
+   // unpacking the halo elements of the array as each message arrives, and
+   // then waits for the local sends to complete.
+   template <typename T>
+   int finishExchange(HaloRequest<T> &Request // request handle from begin
+   ) {
+
+      I4 IErr{0}; // error code
+
+      if (not Request.Active) {
+         LOG_ERROR("Halo: finishExchange called for an inactive request");
+         return -1;
       }
 
-      I4 MaxIter = 1000000000; // Large integer to prevent infinite loop
-      I4 IPass   = 0;          // Number of passes through while loop
-      I4 NRcvd   = 0;          // Integer to track number of messages received
+      // Restore the state of the exchange from the request handle
+      MyElem      = Request.Elem;
+      NumLayers   = Request.NumLayers;
+      TotSize     = Request.TotSize;
+      OnDevice    = Request.OnDevice;
+      ReducedPrec = Request.ReducedPrec;
 
-      // Total number of messages the local task will receive
-      I4 NMessages = std::accumulate(RecvFlags[MyElem].begin(),
-                                     RecvFlags[MyElem].end(), 0);
+      BuffOffset = 0;
 
-      // Until all messages from neighboring tasks are received, loop
-      // through Neighbor objects and use MPI_Test to check if the message
-      // has been received. Unpack buffers upon receipt of each message
-      while (not AllReceived) {
-         for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-            if (RecvFlags[MyElem][INghbr]) {
-               MyNeighbor = &Neighbors[INghbr];
-               if (not MyNeighbor->Received) {
-                  MPI_Test(&MyNeighbor->RReq, &MyNeighbor->Received,
-                           MPI_STATUS_IGNORE);
-                  if (MyNeighbor->Received) {
-                     ++NRcvd;
-                  }
-               }
-               if (MyNeighbor->Received and not MyNeighbor->Unpacked) {
-                  unpackBuffer(Array);
-                  MyNeighbor->Unpacked = true;
-               }
-            }
-         }
+      // Wait for and unpack the message from each Neighbor
+      IErr = receiveAndUnpack([&](int) { unpackBuffer(Request.Array); });
 
-         if (NRcvd == NMessages) {
-            AllReceived = true;
-         }
-         ++IPass;
-         if (IPass == MaxIter) {
-            LOG_ERROR("Halo: Maximum iterations reached during halo exchange");
-            IErr = -1;
-            break;
-         }
+      Request.Active = false;
+      InProgress     = false;
+
+      return IErr;
+   } // end finishExchange
+
+   /// Start a split-phase exchange of all arrays in a HaloGroup
+   int beginExchange(HaloGroup &Group);
+
+   /// Complete a split-phase exchange of all arrays in a HaloGroup
+   int finishExchange(HaloGroup &Group);
+
+   /// Exchange all arrays in a HaloGroup, sending a single message to each
+   /// neighboring task
+   int exchangeGroup(HaloGroup &Group);
+
+   //---------------------------------------------------------------------------
+   // Function template to perform a partial-depth halo exchange on the input
+   // Kokkos array of any supported type defined on the input index space
+   // ThisElem, updating only the first NLayers halo layers. This is a
+   // blocking exchange equivalent to calling beginExchange followed
+   // immediately by finishExchange. If ReducedPrec is true, an R8 array is
+   // sent in R4 precision.
+   template <typename T>
+   int exchangeHalo(T &Array,                // Kokkos array of any type
+                    MeshElement ThisElem,    // index space Array is defined on
+                    I4 NLayers,              // halo layers to exchange
+                    bool ReducedPrec = false // send R8 array in R4 precision
+   ) {
+
+      HaloRequest<T> Request;
+
+      I4 IErr = beginExchange(Array, ThisElem, Request, NLayers, ReducedPrec);
+      if (IErr != 0) {
+         LOG_ERROR("Halo: Error starting halo exchange");
+         if (not Request.Active)
+            return IErr;
       }
 
+      IErr += finishExchange(Request);
+
       return IErr;
+   } // end exchangeHalo
+
+   //---------------------------------------------------------------------------
+   // Function template to perform a full halo exchange on the input Kokkos
+   // array of any supported type defined on the input index space ThisElem.
+   template <typename T>
+   int
+   exchangeFullArrayHalo(T &Array,            // Kokkos array of any type
+                         MeshElement ThisElem // index space Array is defined on
+   ) {
+      return exchangeHalo(Array, ThisElem, maxLayers(ThisElem));
    } // end exchangeFullArrayHalo
 
+   /// HaloGroup is a friend class to allow access to the private pack and
+   /// unpack methods
+   friend class HaloGroup;
+
 }; // end class Halo
 
+//------------------------------------------------------------------------------
+// Add an array to a HaloGroup. The pack and unpack operations for the array
+// are stored so that arrays of different types can be exchanged together.
+template <typename T>
+int HaloGroup::add(T &Array, MeshElement Elem, I4 NLayers, bool ReducedPrec) {
+
+   if (Active) {
+      LOG_ERROR("HaloGroup: can not add an array during an exchange");
+      return -1;
+   }
+
+   bool ArrayOnDevice = not Kokkos::SpaceAccessibility<
+       HostExecSpace, typename T::memory_space>::accessible;
+   if (Members.empty()) {
+      OnDevice = ArrayOnDevice;
+   } else if (ArrayOnDevice != OnDevice) {
+      LOG_ERROR("HaloGroup: all arrays in a group must reside in the same "
+                "memory space");
+      return -1;
+   }
+
+   Member NewMember;
+   NewMember.Elem        = Elem;
+   NewMember.TotSize     = Halo::elementSize(Array) * Halo::bufferSlots<T>();
+   NewMember.NumLayers   = NLayers;
+   NewMember.ReducedPrec = ReducedPrec and canReducePrecision<T>();
+   NewMember.Pack        = [Array](Halo &H) { return H.packBuffer(Array); };
+   NewMember.Unpack      = [Array](Halo &H) mutable {
+      return H.unpackBuffer(Array);
+   };
+   Members.push_back(NewMember);
+
+   return 0;
+} // end HaloGroup add
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
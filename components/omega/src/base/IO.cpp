@@ -9,13 +9,19 @@
 
 #include "IO.h"
 #include "DataTypes.h"
+#include "Config.h"
 #include "Logging.h"
-// include "Config.h"
 #include "mpi.h"
 #include "pio.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace OMEGA {
 namespace IO {
@@ -26,6 +32,93 @@ int SysID               = 0;
 FileFmt DefaultFileFmt  = FmtDefault;
 Rearranger DefaultRearr = RearrDefault;
 
+// Arrays queued for a batched write to one file with one decomposition.
+// The data for all arrays is packed contiguously in the order queued as
+// expected by the PIO multi-variable write.
+struct ArrayQueue {
+   PIO_Offset Size = 0;         // local size of each queued array
+   std::vector<int> VarIDs;     // variable ID of each queued array
+   std::vector<char> Data;      // packed data for all queued arrays
+   std::vector<char> FillValue; // packed fill value for each queued array
+};
+// Queued arrays for each open file (FileID) and decomposition (DecompID)
+static std::map<int, std::map<int, ArrayQueue>> WriteQueue;
+// Size in bytes of each element for each defined decomposition
+static std::map<int, int> DecompElemSize;
+// Size in bytes of queued data for each file before an automatic flush
+static I8 WriteBufferSize = 64 * 1024 * 1024;
+// Data type and number of significant bits for each quantized variable,
+// stored by FileID and VarID
+struct QuantizeInfo {
+   IODataType VarType; // data type of the variable (R4 or R8)
+   int NBits;          // number of significant mantissa bits to keep
+};
+static std::map<int, std::map<int, QuantizeInfo>> QuantizeVars;
+
+// Pinned host staging buffers for device arrays, one per staging slot
+using StagingView = Kokkos::View<char *, Kokkos::SharedHostPinnedSpace>;
+static StagingView StagingBuffers[NumStagingSlots];
+
+//------------------------------------------------------------------------------
+// Rounds floating point values in a buffer to NBits significant mantissa
+// bits using round-to-nearest (BitRound). The trailing mantissa bits are
+// set to zero so the data compresses well. Fill values, infinities and NaNs
+// are not changed. R is the floating point type and U the unsigned integer
+// type of the same size.
+template <typename R, typename U>
+void bitRound(void *Data,            // [inout] buffer of values to round
+              int Size,              // [in] number of values in buffer
+              const void *FillValue, // [in] fill value to leave unchanged
+              int NBits              // [in] significant bits to keep
+) {
+   constexpr int NMantissa = std::numeric_limits<R>::digits - 1;
+   if (NBits >= NMantissa)
+      return;
+
+   int NDrop = NMantissa - NBits;
+   U Half    = U(1) << (NDrop - 1);
+   U Mask    = ~((U(1) << NDrop) - 1);
+   R Fill;
+   std::memcpy(&Fill, FillValue, sizeof(R));
+
+   char *Bytes = static_cast<char *>(Data);
+   for (int i = 0; i < Size; ++i) {
+      R Value;
+      std::memcpy(&Value, Bytes + i * sizeof(R), sizeof(R));
+      if (Value == Fill || !std::isfinite(Value))
+         continue;
+      U Bits;
+      std::memcpy(&Bits, &Value, sizeof(R));
+      Bits = (Bits + Half) & Mask;
+      std::memcpy(Bytes + i * sizeof(R), &Bits, sizeof(R));
+   }
+
+} // end bitRound
+
+//------------------------------------------------------------------------------
+// Applies any quantization defined for a variable to a buffer of its values
+
+void quantizeArray(void *Data,            // [inout] buffer of values
+                   int Size,              // [in] number of values in buffer
+                   const void *FillValue, // [in] fill value for variable
+                   int FileID,            // [in] ID of file being written
+                   int VarID              // [in] ID of variable
+) {
+   auto FileIt = QuantizeVars.find(FileID);
+   if (FileIt == QuantizeVars.end())
+      return;
+   auto VarIt = FileIt->second.find(VarID);
+   if (VarIt == FileIt->second.end())
+      return;
+
+   if (VarIt->second.VarType == IOTypeR8) {
+      bitRound<R8, uint64_t>(Data, Size, FillValue, VarIt->second.NBits);
+   } else {
+      bitRound<R4, uint32_t>(Data, Size, FillValue, VarIt->second.NBits);
+   }
+
+} // end quantizeArray
+
 // Utilities
 //------------------------------------------------------------------------------
 // Converts string choice for PIO rearranger to an enum
@@ -63,6 +156,23 @@ RearrFromString(const std::string &Rearr // [in] choice of IO rearranger
 
 } // End RearrFromString
 
+//------------------------------------------------------------------------------
+// Converts string choice for IO task placement to an enum
+Placement
+PlacementFromString(const std::string &Place // [in] choice of placement
+) {
+   std::string PlaceComp = Place;
+   std::transform(PlaceComp.begin(), PlaceComp.end(), PlaceComp.begin(),
+                  [](unsigned char c) { return std::tolower(c); });
+
+   if (PlaceComp == "node")
+      return Placement::Node;
+   if (PlaceComp != "stride")
+      LOG_WARN("IO: unknown IO task placement {}, using stride", Place);
+   return Placement::Stride;
+
+} // End PlacementFromString
+
 //------------------------------------------------------------------------------
 // Converts string choice for File Format to an enum
 FileFmt
@@ -217,34 +327,277 @@ Precision PrecisionFromString(
 } // End PrecisionFromString
 
 // Methods
+//------------------------------------------------------------------------------
+// Reads the parallel IO settings from the IO section of the configuration
+int readSettings(Settings &IOSettings // [out] parallel IO settings
+) {
+
+   int Err             = 0;
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("IO"))
+      return Err;
+
+   Config IOConfig("IO");
+   Err = OmegaConfig->get(IOConfig);
+   if (Err != 0) {
+      LOG_ERROR("IO::readSettings: error retrieving IO configuration");
+      return Err;
+   }
+
+   if (IOConfig.existsVar("IOTasks"))
+      Err += IOConfig.get("IOTasks", IOSettings.NumIOTasks);
+   if (IOConfig.existsVar("IOStride"))
+      Err += IOConfig.get("IOStride", IOSettings.IOStride);
+   if (IOConfig.existsVar("IOTasksPerNode"))
+      Err += IOConfig.get("IOTasksPerNode", IOSettings.IOTasksPerNode);
+   if (IOConfig.existsVar("IORearrMaxPending"))
+      Err += IOConfig.get("IORearrMaxPending", IOSettings.MaxPendingReq);
+   if (IOConfig.existsVar("IOServerTasks"))
+      Err += IOConfig.get("IOServerTasks", IOSettings.NumServerTasks);
+
+   std::string Choice;
+   if (IOConfig.existsVar("IOPlacement")) {
+      Err += IOConfig.get("IOPlacement", Choice);
+      IOSettings.Place = PlacementFromString(Choice);
+   }
+   if (IOConfig.existsVar("IORearranger")) {
+      Err += IOConfig.get("IORearranger", Choice);
+      IOSettings.Rearr = RearrFromString(Choice);
+      if (IOSettings.Rearr == RearrUnknown) {
+         LOG_WARN("IO::readSettings: unknown rearranger {}, using box",
+                  Choice);
+         IOSettings.Rearr = RearrDefault;
+      }
+   }
+   if (IOConfig.existsVar("IORearrComm")) {
+      Err += IOConfig.get("IORearrComm", Choice);
+      std::transform(Choice.begin(), Choice.end(), Choice.begin(),
+                     [](unsigned char c) { return std::tolower(c); });
+      IOSettings.Comm = Choice == "coll" ? RearrComm::Coll : RearrComm::P2P;
+   }
+   if (IOConfig.existsVar("IODefaultFormat")) {
+      Err += IOConfig.get("IODefaultFormat", Choice);
+      FileFmt Format = FileFmtFromString(Choice);
+      if (Format != FmtUnknown)
+         IOSettings.DefaultFormat = Format;
+   }
+
+   if (Err != 0)
+      LOG_ERROR("IO::readSettings: error reading IO configuration");
+
+   return Err;
+
+} // end readSettings
+
+//------------------------------------------------------------------------------
+// Computes the number of IO tasks and stride for the placement in IOSettings
+void placeIOTasks(const MPI_Comm &InComm, // [in] MPI communicator to use
+                  Settings &IOSettings    // [inout] parallel IO settings
+) {
+
+   int NumTasks;
+   int MyTask;
+   MPI_Comm_size(InComm, &NumTasks);
+   MPI_Comm_rank(InComm, &MyTask);
+
+   if (IOSettings.Place == Placement::Node) {
+      // Group the tasks of InComm by node
+      MPI_Comm NodeComm;
+      int NodeSize;
+      int NodeTask;
+      MPI_Comm_split_type(InComm, MPI_COMM_TYPE_SHARED, MyTask,
+                          MPI_INFO_NULL, &NodeComm);
+      MPI_Comm_size(NodeComm, &NodeSize);
+      MPI_Comm_rank(NodeComm, &NodeTask);
+
+      // A fixed stride places the same IO tasks on every node only if all
+      // nodes hold the same number of consecutive tasks
+      int NodeFirst = MyTask - NodeTask;
+      int NodeLast  = NodeFirst;
+      MPI_Allreduce(MPI_IN_PLACE, &NodeFirst, 1, MPI_INT, MPI_MIN, NodeComm);
+      MPI_Allreduce(MPI_IN_PLACE, &NodeLast, 1, MPI_INT, MPI_MAX, NodeComm);
+      MPI_Comm_free(&NodeComm);
+      int Regular = NodeFirst == NodeLast && NodeFirst % NodeSize == 0;
+      int MinSize = NodeSize;
+      int MaxSize = NodeSize;
+      MPI_Allreduce(MPI_IN_PLACE, &Regular, 1, MPI_INT, MPI_LAND, InComm);
+      MPI_Allreduce(MPI_IN_PLACE, &MinSize, 1, MPI_INT, MPI_MIN, InComm);
+      MPI_Allreduce(MPI_IN_PLACE, &MaxSize, 1, MPI_INT, MPI_MAX, InComm);
+
+      if (Regular && MinSize == MaxSize) {
+         // Largest number of IO tasks per node up to the requested number
+         // that divides the tasks of a node evenly
+         int PerNode = std::clamp(IOSettings.IOTasksPerNode, 1, NodeSize);
+         while (NodeSize % PerNode != 0)
+            --PerNode;
+         IOSettings.IOStride   = NodeSize / PerNode;
+         IOSettings.NumIOTasks = NumTasks / IOSettings.IOStride;
+      } else {
+         LOG_WARN("IO::placeIOTasks: irregular node layout, using {} IO "
+                  "tasks with stride {}",
+                  IOSettings.NumIOTasks, IOSettings.IOStride);
+      }
+   }
+
+   // The last IO task must be in the communicator
+   IOSettings.IOStride = std::clamp(IOSettings.IOStride, 1, NumTasks);
+   const int MaxIOTasks = (NumTasks - 1) / IOSettings.IOStride + 1;
+   if (IOSettings.NumIOTasks < 1 || IOSettings.NumIOTasks > MaxIOTasks) {
+      LOG_WARN("IO::placeIOTasks: {} IO tasks with stride {} do not fit in "
+               "{} tasks, using {}",
+               IOSettings.NumIOTasks, IOSettings.IOStride, NumTasks,
+               MaxIOTasks);
+      IOSettings.NumIOTasks = MaxIOTasks;
+   }
+
+} // end placeIOTasks
+
 //------------------------------------------------------------------------------
 // Initializes the IO system based on configuration inputs and
 // default MPI communicator
 int init(const MPI_Comm &InComm // [in] MPI communicator to use
 ) {
 
+   Settings IOSettings;
+   int Err = readSettings(IOSettings);
+   if (Err != 0)
+      return Err;
+
+   return init(InComm, IOSettings);
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Initializes the IO system with the given settings
+int init(const MPI_Comm &InComm,    // [in] MPI communicator to use
+         const Settings &IOSettings // [in] parallel IO settings
+) {
+
    int Err = 0; // success error code
-   // Retrieve parallel IO parameters from the Omega configuration
-   // TODO: replace with actual config, for now hardwired
-   // extern int SysID;
 
-   FileFmt DefaultFileFmt = FileFmtFromString("netcdf4c");
-   int NumIOTasks         = 1;
-   int IOStride           = 1;
-   int IOBaseTask         = 0;
-   Rearranger Rearrange   = RearrDefault;
+   Settings Placed = IOSettings;
+   placeIOTasks(InComm, Placed);
+   const int IOBaseTask = 0;
 
    // Call PIO routine to initialize
-   DefaultRearr = Rearrange;
-   Err          = PIOc_Init_Intracomm(InComm, NumIOTasks, IOStride, IOBaseTask,
-                                      Rearrange, &SysID);
-   if (Err != 0)
+   DefaultRearr   = Placed.Rearr;
+   DefaultFileFmt = Placed.DefaultFormat;
+   Err = PIOc_Init_Intracomm(InComm, Placed.NumIOTasks, Placed.IOStride,
+                             IOBaseTask, Placed.Rearr, &SysID);
+   if (Err != 0) {
       LOG_ERROR("IO::init: Error initializing SCORPIO");
+      return Err;
+   }
+
+   // Rearranger communication, with handshakes and flow control from the
+   // compute to the IO tasks and non-blocking sends back
+   Err = PIOc_set_rearr_opts(SysID, static_cast<int>(Placed.Comm),
+                             PIO_REARR_COMM_FC_2D_ENABLE, true, false,
+                             Placed.MaxPendingReq, false, true,
+                             PIO_REARR_COMM_UNLIMITED_PEND_REQ);
+   if (Err != PIO_NOERR)
+      LOG_ERROR("IO::init: Error setting SCORPIO rearranger options");
+
+   LOG_INFO("IO::init: {} IO tasks with stride {}, {} rearranger",
+            Placed.NumIOTasks, Placed.IOStride,
+            Placed.Rearr == RearrSubset ? "subset" : "box");
 
    return Err;
 
 } // end init
 
+//------------------------------------------------------------------------------
+// Initializes the IO system with a subset of tasks dedicated as asynchronous
+// IO servers. The first NumIOTasks tasks become the IO servers and the
+// remaining tasks are returned in the compute communicator.
+int initAsync(const MPI_Comm &InComm, // [in] MPI communicator to split
+              int NumIOTasks,         // [in] number of IO server tasks
+              MPI_Comm &CompComm      // [out] communicator for compute tasks
+) {
+
+   int Err = 0; // success error code
+
+#ifdef OMEGA_ASYNC_IO
+   // Check for a valid number of server tasks, leaving at least one
+   // compute task
+   int NumTasks;
+   MPI_Comm_size(InComm, &NumTasks);
+   CompComm = MPI_COMM_NULL;
+   if (NumIOTasks < 1 || NumIOTasks >= NumTasks) {
+      LOG_ERROR("IO::initAsync: invalid number of IO server tasks {}",
+                NumIOTasks);
+      return -1;
+   }
+
+   Settings IOSettings;
+   Err = readSettings(IOSettings);
+   if (Err != 0)
+      return Err;
+   Rearranger Rearrange = IOSettings.Rearr;
+   int NumCompTasks     = NumTasks - NumIOTasks;
+
+   // Call PIO routine to initialize with a single compute component. The
+   // null task lists place the IO servers on the first NumIOTasks tasks and
+   // the compute tasks on the rest. Server tasks remain in this call,
+   // processing requests from the compute tasks, until the compute tasks
+   // free the IO system.
+   DefaultRearr    = Rearrange;
+   DefaultFileFmt  = IOSettings.DefaultFormat;
+   MPI_Comm IOComm = MPI_COMM_NULL;
+   Err = PIOc_init_async(InComm, NumIOTasks, nullptr, 1, &NumCompTasks,
+                         nullptr, &IOComm, &CompComm, Rearrange, &SysID);
+   if (Err != PIO_NOERR)
+      LOG_ERROR("IO::initAsync: Error initializing SCORPIO IO servers");
+
+   if (IOComm != MPI_COMM_NULL)
+      MPI_Comm_free(&IOComm);
+#else
+   // Without async support, all tasks are compute tasks
+   LOG_WARN("IO::initAsync: Omega built without OMEGA_ASYNC_IO, "
+            "IO server tasks will not be used");
+   CompComm = InComm;
+   Err      = init(InComm);
+#endif
+
+   return Err;
+
+} // end initAsync
+
+//------------------------------------------------------------------------------
+// Initializes the IO system with the number of IO server tasks set in the
+// IO section of the configuration, if any
+int initAsync(const MPI_Comm &InComm, // [in] MPI communicator to split
+              MPI_Comm &CompComm      // [out] communicator for compute tasks
+) {
+
+   Settings IOSettings;
+   int Err = readSettings(IOSettings);
+   if (Err != 0)
+      return Err;
+
+   if (IOSettings.NumServerTasks < 1) {
+      CompComm = InComm;
+      return init(InComm, IOSettings);
+   }
+
+   return initAsync(InComm, IOSettings.NumServerTasks, CompComm);
+
+} // end initAsync
+
+//------------------------------------------------------------------------------
+// Finalizes the IO system and releases any IO server tasks
+int finalize() {
+
+   clearStaging();
+
+   int Err = PIOc_free_iosystem(SysID);
+   if (Err != PIO_NOERR)
+      LOG_ERROR("IO::finalize: Error finalizing SCORPIO");
+
+   return Err;
+
+} // end finalize
+
 //------------------------------------------------------------------------------
 // This routine opens a file for reading or writing, depending on the
 // Mode argument. The filename with full path must be supplied and
@@ -329,8 +682,23 @@ int openFile(
 // Closes an open file using the fileID, returns an error code
 int closeFile(int &FileID /// [in] ID of the file to be closed
 ) {
-   // Just calls the PIO close routine
-   int Err = PIOc_closefile(FileID);
+   int Err = 0;
+
+   // Write any arrays still queued for this file
+   if (WriteQueue.find(FileID) != WriteQueue.end()) {
+      Err = flushArrays(FileID);
+      if (Err != 0)
+         LOG_ERROR("IO::closeFile: error writing queued arrays");
+   }
+
+   // Variable IDs are not valid after the file is closed
+   QuantizeVars.erase(FileID);
+
+   // Call the PIO close routine
+   int CloseErr = PIOc_closefile(FileID);
+   if (CloseErr != PIO_NOERR)
+      Err = CloseErr;
+
    return Err;
 
 } // End closeFile
@@ -364,6 +732,12 @@ int getDimLength(int FileID, // [in] ID of the file containing dim
                 DimName);
       return -1;
    }
+   if (Length > std::numeric_limits<int>::max()) {
+      LOG_ERROR("IO::getDimLength: length {} of dimension {} exceeds the "
+                "32-bit range",
+                Length, DimName);
+      return -1;
+   }
    return Length;
 
 } // End getDimLength
@@ -625,7 +999,8 @@ int defineVar(int FileID,                 // [in] ID of the file containing dim
               IODataType VarType,         // [in] data type for the variable
               int NDims,                  // [in] number of dimensions
               int *DimIDs,                // [in] vector of NDims dimension IDs
-              int &VarID                  // [out] id assigned to this variable
+              int &VarID,                 // [out] id assigned to this variable
+              const Compression &Compress // [in] compression settings
 ) {
 
    int Err = 0;
@@ -634,6 +1009,33 @@ int defineVar(int FileID,                 // [in] ID of the file containing dim
    if (Err != PIO_NOERR) {
       LOG_ERROR("IO::defineVar: PIO error while defining variable {}", VarName);
       Err = -1;
+      return Err;
+   }
+
+   // Lossless compression is only supported by the NetCDF4 formats, so the
+   // variable is written without compression if the filter is not available
+   if (Compress.DeflateLevel > 0 || Compress.Shuffle) {
+      int Deflate = Compress.DeflateLevel > 0 ? 1 : 0;
+      int PIOErr =
+          PIOc_def_var_deflate(FileID, VarID, Compress.Shuffle ? 1 : 0,
+                               Deflate, Compress.DeflateLevel);
+      if (PIOErr != PIO_NOERR)
+         LOG_WARN("IO::defineVar: compression not available for variable {}",
+                  VarName);
+   }
+
+   // Quantization applies only to floating point variables. The number of
+   // bits kept is also written as an attribute of the variable.
+   if (Compress.QuantizeBits > 0) {
+      if (VarType == IOTypeR4 || VarType == IOTypeR8) {
+         QuantizeVars[FileID][VarID] = {VarType, Compress.QuantizeBits};
+         Err = writeMeta("QuantizeBits", I4(Compress.QuantizeBits), FileID,
+                         VarID);
+      } else {
+         LOG_WARN("IO::defineVar: quantization ignored for non-real "
+                  "variable {}",
+                  VarName);
+      }
    }
 
    return Err;
@@ -670,14 +1072,31 @@ int createDecomp(
     Rearranger Rearr                    // [in] rearranger method to use
 ) {
 
+   // Convert global index array into the 64-bit offsets expected by PIO
+   std::vector<I8> CompMap(GlobalIndx.begin(), GlobalIndx.begin() + Size);
+
+   return createDecomp(DecompID, VarType, NDims, DimLengths, Size, CompMap,
+                       Rearr);
+
+} // End createDecomp
+
+//------------------------------------------------------------------------------
+// Creates a PIO decomposition description with 64-bit global indices
+int createDecomp(
+    int &DecompID,      // [out] ID assigned to the new decomposition
+    IODataType VarType, // [in] data type of array
+    int NDims,          // [in] number of array dimensions
+    const std::vector<int> &DimLengths, // [in] global dimension lengths
+    int Size,                           // [in] local size of array
+    const std::vector<I8> &GlobalIndx,  // [in] global indx for each local indx
+    Rearranger Rearr                    // [in] rearranger method to use
+) {
+
    int Err = 0; // default return code
 
    // Convert global index array into an offset array expected by PIO
-   std::vector<PIO_Offset> CompMap;
-   CompMap.resize(Size);
-   for (int i = 0; i < Size; ++i) {
-      CompMap[i] = GlobalIndx[i];
-   } // end global index loop
+   std::vector<PIO_Offset> CompMap(GlobalIndx.begin(),
+                                   GlobalIndx.begin() + Size);
 
    // Call the PIO routine to define the decomposition
    // int TmpRearr = Rearr; // needed for type compliance across interface
@@ -688,6 +1107,15 @@ int createDecomp(
    if (Err != PIO_NOERR)
       LOG_ERROR("IO::createDecomp: PIO error defining decomposition");
 
+   // Save the element size for batched writes with this decomposition
+   if (VarType == IOTypeI8 || VarType == IOTypeR8) {
+      DecompElemSize[DecompID] = 8;
+   } else if (VarType == IOTypeChar) {
+      DecompElemSize[DecompID] = 1;
+   } else {
+      DecompElemSize[DecompID] = 4;
+   }
+
    return Err;
 
 } // End createDecomp
@@ -700,6 +1128,7 @@ int destroyDecomp(int &DecompID // [inout] ID for decomposition to be removed
    int Err = PIOc_freedecomp(SysID, DecompID);
    if (Err != PIO_NOERR)
       LOG_ERROR("IO::destroyDecomp: PIO error freeing decomposition");
+   DecompElemSize.erase(DecompID);
 
    return Err;
 
@@ -750,6 +1179,20 @@ int writeArray(void *Array,     // [in] array to be written
 
    PIO_Offset Asize = Size;
 
+   // Round a copy of the data if the variable is quantized
+   auto FileIt = QuantizeVars.find(FileID);
+   if (FileIt != QuantizeVars.end() &&
+       FileIt->second.find(VarID) != FileIt->second.end()) {
+      int ElemSize = DecompElemSize[DecompID];
+      std::vector<char> Rounded(static_cast<char *>(Array),
+                                static_cast<char *>(Array) +
+                                    std::size_t(Size) * ElemSize);
+      quantizeArray(Rounded.data(), Size, FillValue, FileID, VarID);
+      Err = PIOc_write_darray(FileID, VarID, DecompID, Asize, Rounded.data(),
+                              FillValue);
+      return Err;
+   }
+
    Err = PIOc_write_darray(FileID, VarID, DecompID, Asize, Array, FillValue);
 
    return Err;
@@ -757,7 +1200,163 @@ int writeArray(void *Array,     // [in] array to be written
 } // end writeArray
 
 //------------------------------------------------------------------------------
+// Adds a distributed array to the queue for a batched write. The data and
+// fill value are copied into the queue for the file and decomposition.
 
+int queueArray(void *Array,     // [in] array to be written
+               int Size,        // [in] size of array to be written
+               void *FillValue, // [in] value to use for missing entries
+               int FileID,      // [in] ID of open file to write to
+               int DecompID,    // [in] decomposition ID for this var
+               int VarID        // [in] variable ID assigned by defineVar
+) {
+   int Err = 0;
+
+   auto ElemIt = DecompElemSize.find(DecompID);
+   if (ElemIt == DecompElemSize.end()) {
+      LOG_ERROR("IO::queueArray: unknown decomposition {}", DecompID);
+      return -1;
+   }
+   int ElemSize = ElemIt->second;
+
+   // All arrays in a queue must have the same size
+   ArrayQueue &Queue = WriteQueue[FileID][DecompID];
+   if (Queue.VarIDs.empty()) {
+      Queue.Size = Size;
+   } else if (Queue.Size != Size) {
+      LOG_ERROR("IO::queueArray: array size {} does not match size {} of "
+                "arrays queued with the same decomposition",
+                Size, Queue.Size);
+      return -1;
+   }
+
+   // Copy the data and fill value to the end of the queue
+   const char *ArrayBytes = static_cast<const char *>(Array);
+   const char *FillBytes  = static_cast<const char *>(FillValue);
+   Queue.VarIDs.push_back(VarID);
+   Queue.Data.insert(Queue.Data.end(), ArrayBytes,
+                     ArrayBytes + std::size_t(Size) * ElemSize);
+   Queue.FillValue.insert(Queue.FillValue.end(), FillBytes,
+                          FillBytes + ElemSize);
+   char *QueuedArray =
+       Queue.Data.data() + Queue.Data.size() - std::size_t(Size) * ElemSize;
+   quantizeArray(QueuedArray, Size, FillValue, FileID, VarID);
+
+   // Flush the queue for this file if the buffer is full
+   I8 QueuedSize = 0;
+   for (auto &DecompQueue : WriteQueue[FileID])
+      QueuedSize += DecompQueue.second.Data.size();
+   if (QueuedSize >= WriteBufferSize)
+      Err = flushArrays(FileID);
+
+   return Err;
+
+} // end queueArray
+
+//------------------------------------------------------------------------------
+// Writes all queued arrays for a file with one multi-variable write for each
+// decomposition and empties the queue for the file.
+
+int flushArrays(int FileID // [in] ID of open file with queued arrays
+) {
+   int Err = 0;
+
+   auto FileIt = WriteQueue.find(FileID);
+   if (FileIt == WriteQueue.end())
+      return Err;
+
+   for (auto &DecompQueue : FileIt->second) {
+      int DecompID      = DecompQueue.first;
+      ArrayQueue &Queue = DecompQueue.second;
+      int NVars         = Queue.VarIDs.size();
+      int ElemSize      = DecompElemSize[DecompID];
+
+      // PIO expects a pointer to the fill value of each variable
+      std::vector<const void *> FillPtrs(NVars);
+      for (int Var = 0; Var < NVars; ++Var)
+         FillPtrs[Var] = &Queue.FillValue[Var * ElemSize];
+
+      int PIOErr = PIOc_write_darray_multi(
+          FileID, Queue.VarIDs.data(), DecompID, NVars, Queue.Size,
+          Queue.Data.data(), nullptr, FillPtrs.data(), true);
+      if (PIOErr != PIO_NOERR) {
+         LOG_ERROR("IO::flushArrays: PIO error writing {} queued arrays",
+                   NVars);
+         Err = PIOErr;
+      }
+   }
+
+   WriteQueue.erase(FileIt);
+
+   return Err;
+
+} // end flushArrays
+
+//------------------------------------------------------------------------------
+// Sets the size of the buffers used for queued arrays and by SCORPIO
+
+int setWriteBufferSize(I8 BufferSize // [in] buffer size in bytes
+) {
+   int Err = 0;
+
+   if (BufferSize <= 0) {
+      LOG_ERROR("IO::setWriteBufferSize: invalid buffer size {}", BufferSize);
+      return -1;
+   }
+   WriteBufferSize = BufferSize;
+   PIOc_set_buffer_size_limit(BufferSize);
+
+   return Err;
+
+} // end setWriteBufferSize
+
+//------------------------------------------------------------------------------
+// Returns the staging buffer of a slot, growing it if needed. The buffers
+// are only reallocated when a larger array is staged, so after the first
+// output they are reused without any allocation.
+
+void *getStagingBuffer(std::size_t Bytes, // [in] required size in bytes
+                       int Slot           // [in] staging slot
+) {
+   auto &Buffer = StagingBuffers[Slot];
+   if (Buffer.size() < Bytes) {
+      // Any transfer into the old buffer must be complete before it is freed
+      waitStaged(Slot);
+      Buffer = StagingView(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "IOStaging"), Bytes);
+   }
+   return Buffer.data();
+
+} // end getStagingBuffer
+
+//------------------------------------------------------------------------------
+// Returns the execution space instance for the transfers of a slot. Slot 0
+// uses the predefined IO instance.
+
+const ExecSpace &getStagingSpace(int Slot // [in] staging slot
+) {
+   if (Slot == 0)
+      return ExecInstances::get(ExecInstances::IO);
+   return ExecInstances::get("IOStaging" + std::to_string(Slot));
+} // end getStagingSpace
+
+//------------------------------------------------------------------------------
+// Waits for the transfer into a staging slot
+
+void waitStaged(int Slot // [in] staging slot
+) {
+   getStagingSpace(Slot).fence("OMEGA::IO::waitStaged");
+} // end waitStaged
+
+//------------------------------------------------------------------------------
+// Releases the staging buffers
+
+void clearStaging() {
+   for (int Slot = 0; Slot < NumStagingSlots; ++Slot)
+      StagingBuffers[Slot] = StagingView();
+} // end clearStaging
+
+//------------------------------------------------------------------------------
 } // end namespace IO
 } // end namespace OMEGA
 
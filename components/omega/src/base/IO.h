@@ -27,16 +27,35 @@
 ///    #  a contiguous chunk of data). Subset is available for exploring
 ///    #  the most efficient approach. See SCORPIO documentation for details.
 ///    IORearranger: box
+///    # Placement of the IO tasks. With stride, IOTasks and IOStride are
+///    #  used as given. With node, IOTasksPerNode IO tasks are placed on
+///    #  every node, evenly spaced among the tasks of the node, eg. one
+///    #  per socket, and IOTasks and IOStride are computed from the node
+///    #  layout of the communicator.
+///    IOPlacement: stride
+///    IOTasksPerNode: 1
+///    # Communication used by the rearranger between compute and IO tasks,
+///    #  p2p (point-to-point) or coll (collective), and the maximum number
+///    #  of pending requests to each IO task (flow control), -1 unlimited
+///    IORearrComm: p2p
+///    IORearrMaxPending: -1
 ///    # The IO supports a number of file formats. We specify a default
 ///    #  here, but this value can be overridden on a file-by-file basis
 ///    #  through the streams interface. Choices include all the various
 ///    #  netCDF file formats as well as the ADIOS format.
 ///    IODefaultFormat: NetCDF4
+///    # Number of MPI tasks to dedicate as asynchronous IO servers. These
+///    #  tasks do not take part in the model computation and write the
+///    #  data sent from the compute tasks in the background. Requires a
+///    #  build with OMEGA_ASYNC_IO. Default is 0 (no IO servers).
+///    IOServerTasks: 0
 /// \EndConfigInput
 //
 //===----------------------------------------------------------------------===//
 
 #include "DataTypes.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
 #include "mpi.h"
 #include "pio.h"
 
@@ -71,6 +90,32 @@ enum FileFmt {
    FmtDefault  = PIO_IOTYPE_NETCDF4C, ///< NetCDF4 is default
 };
 
+/// Placement of the IO tasks among the tasks of the communicator
+enum class Placement {
+   Stride, ///< IOTasks tasks spaced by IOStride from the first task
+   Node,   ///< a fixed number of evenly spaced IO tasks on every node
+};
+
+/// Communication pattern of the rearranger
+enum class RearrComm {
+   P2P  = PIO_REARR_COMM_P2P,  ///< point-to-point messages
+   Coll = PIO_REARR_COMM_COLL, ///< collective (all-to-all) messages
+};
+
+/// Parallel IO settings used to initialize the IO system, normally read
+/// from the IO section of the configuration by readSettings
+struct Settings {
+   int NumIOTasks        = 1;                 ///< number of IO tasks
+   int IOStride          = 1;                 ///< stride between IO tasks
+   Placement Place       = Placement::Stride; ///< placement of IO tasks
+   int IOTasksPerNode    = 1;                 ///< IO tasks on each node
+   Rearranger Rearr      = RearrDefault;      ///< rearranger algorithm
+   RearrComm Comm        = RearrComm::P2P;    ///< rearranger messages
+   int MaxPendingReq     = -1;                ///< flow control, -1 none
+   FileFmt DefaultFormat = FmtDefault;        ///< default file format
+   int NumServerTasks    = 0;                 ///< async IO server tasks
+};
+
 /// File operations
 enum Mode {
    ModeUnknown, /// Unknown or undefined
@@ -101,6 +146,17 @@ enum IODataType {
    IOTypeLogical = PIO_INT     /// Logicals are converted to ints for IO
 };
 
+/// Compression options for a variable in an output file. Lossless
+/// compression (deflate with optional shuffle) requires a NetCDF4 file
+/// format. Lossy quantization rounds floating point values to QuantizeBits
+/// significant bits of the mantissa (BitRound) before writing, which allows
+/// much better compression of the data. Default values disable compression.
+struct Compression {
+   int DeflateLevel = 0;     ///< deflate level (1-9), 0 for no deflate
+   bool Shuffle     = false; ///< apply the shuffle filter before deflate
+   int QuantizeBits = 0;     ///< significant bits kept, 0 for no rounding
+};
+
 /// The IO system id, defined on IO initialization and used by all
 /// IO functions
 extern int SysID;
@@ -119,6 +175,11 @@ extern Rearranger DefaultRearr;
 Rearranger
 RearrFromString(const std::string &Rearr ///< [in] choice of IO rearranger
 );
+/// Converts string choice for IO task placement to an enum, returning
+/// the stride placement for unknown choices
+Placement
+PlacementFromString(const std::string &Place ///< [in] choice of placement
+);
 /// Converts string choice for File Format to an enum
 FileFmt
 FileFmtFromString(const std::string &Format ///< [in] choice of IO file format
@@ -138,11 +199,57 @@ Precision PrecisionFromString(
 
 // Methods
 
+/// Reads the parallel IO settings from the IO section of the Omega
+/// configuration. Settings that are not in the configuration keep their
+/// default values. Returns an error code.
+int readSettings(Settings &IOSettings ///< [out] parallel IO settings
+);
+
+/// Computes the number of IO tasks and the stride for the placement of
+/// IOSettings on the tasks of InComm. For node placement, the tasks of each
+/// node must be consecutive and every node must have the same number of
+/// tasks, otherwise the configured number and stride are used. The number
+/// of IO tasks is reduced if needed to fit in the communicator.
+void placeIOTasks(const MPI_Comm &InComm, ///< [in] MPI communicator to use
+                  Settings &IOSettings    ///< [inout] parallel IO settings
+);
+
 /// Initializes the IO system based on configuration inputs and
 /// default MPI communicator
 int init(const MPI_Comm &InComm ///< [in] MPI communicator to use
 );
 
+/// Initializes the IO system on InComm with the given settings, with the
+/// IO tasks placed by placeIOTasks
+int init(const MPI_Comm &InComm,    ///< [in] MPI communicator to use
+         const Settings &IOSettings ///< [in] parallel IO settings
+);
+
+/// Initializes the IO system with the first NumIOTasks tasks of InComm
+/// dedicated as asynchronous IO servers. On compute tasks, the routine
+/// returns the communicator for the remaining compute tasks in CompComm,
+/// which should be used to initialize the MachEnv. On the IO server tasks,
+/// the routine does not return until the compute tasks have called
+/// finalize and CompComm is set to MPI_COMM_NULL. If Omega is built without
+/// OMEGA_ASYNC_IO, the IO system is initialized as in init with all tasks
+/// used for computation.
+int initAsync(const MPI_Comm &InComm, ///< [in] MPI communicator to split
+              int NumIOTasks,         ///< [in] number of IO server tasks
+              MPI_Comm &CompComm      ///< [out] communicator for compute tasks
+);
+
+/// Initializes the IO system with the number of asynchronous IO server
+/// tasks given by IOServerTasks in the IO section of the configuration, as
+/// in the routine above. If no server tasks are requested, the IO system is
+/// initialized as in init and CompComm is InComm.
+int initAsync(const MPI_Comm &InComm, ///< [in] MPI communicator to split
+              MPI_Comm &CompComm      ///< [out] communicator for compute tasks
+);
+
+/// Finalizes the IO system and frees the IO system resources. When IO
+/// server tasks are used, this also releases the servers.
+int finalize();
+
 /// This routine opens a file for reading or writing, depending on the
 /// Mode argument. The filename with full path must be supplied and
 /// a FileID is returned to be used by other IO functions.
@@ -241,13 +348,15 @@ int readMeta(const std::string &MetaName, ///< [in] name of metadata
 
 /// Defines a variable for an output file. The name and dimensions of
 /// the variable must be supplied. An ID is assigned to the variable
-/// for later use in the writing of the variable.
+/// for later use in the writing of the variable. Optional compression
+/// settings can be supplied and are applied to all writes of the variable.
 int defineVar(int FileID, ///< [in] ID of the file containing dim
               const std::string &VarName, ///< [in] name of variable
               IODataType VarType,         ///< [in] data type for the variable
               int NDims,                  ///< [in] number of dimensions
               int *DimIDs, ///< [in] vector of NDims dimension IDs
-              int &VarID   ///< [out] id assigned to this variable
+              int &VarID,  ///< [out] id assigned to this variable
+              const Compression &Compress = Compression() ///< [in] compression
 );
 
 /// Ends define mode signifying all field definitions and metadata
@@ -267,6 +376,18 @@ int createDecomp(
     Rearranger Rearr                    ///< [in] rearranger method to use
 );
 
+/// Creates a PIO decomposition as above with 64-bit global indices, for
+/// arrays whose global size (eg cells times levels) exceeds the 32-bit range
+int createDecomp(
+    int &DecompID,                      ///< [out] ID for the new decomposition
+    IODataType VarType,                 ///< [in] data type of array
+    int NDims,                          ///< [in] number of array dimensions
+    const std::vector<int> &DimLengths, ///< [in] global dimension lengths
+    int Size,                           ///< [in] local size of array
+    const std::vector<I8> &GlobalIndx,  ///< [in] global indx for each loc indx
+    Rearranger Rearr                    ///< [in] rearranger method to use
+);
+
 /// Removes a PIO decomposition to free memory.
 int destroyDecomp(int &DecompID ///< [inout] ID for decomp to remove
 );
@@ -287,7 +408,9 @@ int readArray(void *Array,                ///< [out] array to be read
 /// Writes a distributed array. A void pointer is used to create a generic
 /// interface. Arrays are assumed to be in contiguous storage and the variable
 /// must have a valid ID assigned by the defineVar function. A void pointer
-/// to a scalar FillValue is also required to fill missing values.
+/// to a scalar FillValue is also required to fill missing values. When IO
+/// server tasks are used, the routine returns once the data has been sent
+/// to the IO servers and the file is written in the background.
 int writeArray(void *Array,     ///< [in] array to be written
                int Size,        ///< [in] size of array to be written
                void *FillValue, ///< [in] value to use for missing entries
@@ -296,6 +419,144 @@ int writeArray(void *Array,     ///< [in] array to be written
                int VarID        ///< [in] variable ID assigned by defineVar
 );
 
+/// Adds a distributed array to the queue of arrays to be written to a file
+/// in a single batched write. The array data and FillValue are copied, so
+/// the input array can be reused after the call. All arrays queued for the
+/// same file and decomposition must have the same local size and are written
+/// together by flushArrays. If the queued data for the file exceeds the
+/// write buffer size, the queue is flushed automatically.
+int queueArray(void *Array,     ///< [in] array to be written
+               int Size,        ///< [in] size of array to be written
+               void *FillValue, ///< [in] value to use for missing entries
+               int FileID,      ///< [in] ID of open file to write to
+               int DecompID,    ///< [in] decomposition ID for this var
+               int VarID        ///< [in] variable ID assigned by defineVar
+);
+
+/// Writes all arrays queued for a file, using one collective write for
+/// each decomposition, and empties the queue. Any queued arrays are also
+/// flushed when the file is closed.
+int flushArrays(int FileID ///< [in] ID of open file with queued arrays
+);
+
+/// Sets the size in bytes of the buffer used for queued arrays on each task
+/// and of the SCORPIO write buffer. Returns an error code.
+int setWriteBufferSize(I8 BufferSize ///< [in] buffer size in bytes
+);
+
+//------------------------------------------------------------------------------
+// Reading and writing Kokkos arrays
+//
+// The routines below read and write contiguous Kokkos arrays in any memory
+// space, so callers do not need their own host mirrors. Arrays accessible
+// from the host are passed to SCORPIO directly. Device arrays are staged
+// through a pool of NumStagingSlots pinned host buffers that grow as needed
+// and are reused by all calls, each with its own execution space instance
+// for the transfers. A caller writing several arrays can start the copy of
+// the next array into one slot with stageArray while the current array in
+// the other slot is written, so that the transfers overlap with the writes.
+
+/// Number of staging buffers
+constexpr int NumStagingSlots = 2;
+
+/// Returns a pinned host staging buffer of at least Bytes bytes for a slot.
+/// The buffer is valid until the next call for the same slot.
+void *getStagingBuffer(std::size_t Bytes, ///< [in] required size in bytes
+                       int Slot           ///< [in] staging slot
+);
+
+/// Returns the execution space instance used for the transfers of a slot
+const ExecSpace &getStagingSpace(int Slot ///< [in] staging slot
+);
+
+/// Waits for the transfer into a staging slot started by stageArray
+void waitStaged(int Slot ///< [in] staging slot
+);
+
+/// Releases the staging buffers
+void clearStaging();
+
+/// Starts copying a contiguous array to the host through a staging slot
+/// and returns a pointer to the host data, which is valid once waitStaged
+/// has been called for the slot. For arrays accessible from the host, no
+/// copy is made and the array data pointer is returned.
+template <typename T>
+void *stageArray(const T &Array, ///< [in] array to stage
+                 int Slot        ///< [in] staging slot
+) {
+   using ValType = typename T::non_const_value_type;
+   if constexpr (Kokkos::SpaceAccessibility<
+                     Kokkos::HostSpace, typename T::memory_space>::accessible) {
+      return const_cast<ValType *>(Array.data());
+   } else {
+      const std::size_t Size = Array.size();
+      auto *Host = static_cast<ValType *>(
+          getStagingBuffer(Size * sizeof(ValType), Slot));
+      Kokkos::View<ValType *, Kokkos::HostSpace,
+                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+          HostData(Host, Size);
+      Kokkos::View<const ValType *, typename T::memory_space,
+                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+          Data(Array.data(), Size);
+      // The array may still be written by kernels on the default instance
+      ExecSpace().fence();
+      Kokkos::deep_copy(getStagingSpace(Slot), HostData, Data);
+      return Host;
+   }
+}
+
+/// Reads a distributed array into a contiguous Kokkos array in any memory
+/// space, as readArray above
+template <typename T>
+int readArray(const T &Array,              ///< [out] array to be read
+              const std::string &VarName,  ///< [in] name of variable to read
+              int FileID,                  ///< [in] ID of open file
+              int DecompID, ///< [in] decomposition ID for this var
+              int &VarID    ///< [out] variable ID in case metadata needed
+) {
+   using ValType = typename T::non_const_value_type;
+   if (!Array.span_is_contiguous()) {
+      LOG_ERROR("IO::readArray: array for {} is not contiguous", VarName);
+      return -1;
+   }
+   const int Size = Array.size();
+   if constexpr (Kokkos::SpaceAccessibility<
+                     Kokkos::HostSpace, typename T::memory_space>::accessible) {
+      return readArray(Array.data(), Size, VarName, FileID, DecompID, VarID);
+   } else {
+      auto *Host =
+          static_cast<ValType *>(getStagingBuffer(Size * sizeof(ValType), 0));
+      int Err = readArray(Host, Size, VarName, FileID, DecompID, VarID);
+      if (Err == 0) {
+         Kokkos::View<const ValType *, Kokkos::HostSpace,
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+             HostData(Host, Size);
+         Kokkos::View<ValType *, typename T::memory_space,
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+             Data(Array.data(), Size);
+         Kokkos::deep_copy(Data, HostData);
+      }
+      return Err;
+   }
+}
+
+/// Writes a contiguous Kokkos array in any memory space, as writeArray above
+template <typename T>
+int writeArray(const T &Array,  ///< [in] array to be written
+               void *FillValue, ///< [in] value to use for missing entries
+               int FileID,      ///< [in] ID of open file to write to
+               int DecompID,    ///< [in] decomposition ID for this var
+               int VarID        ///< [in] variable ID assigned by defineVar
+) {
+   if (!Array.span_is_contiguous()) {
+      LOG_ERROR("IO::writeArray: array for var ID {} is not contiguous", VarID);
+      return -1;
+   }
+   void *Host = stageArray(Array, 0);
+   waitStaged(0);
+   return writeArray(Host, Array.size(), FillValue, FileID, DecompID, VarID);
+}
+
 } // end namespace IO
 } // end namespace OMEGA
 
@@ -66,6 +66,9 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
    // All tasks are members of this communicator's group
    MemberFlag = true;
 
+   // Determine the node layout of the tasks
+   initNodeInfo();
+
 #ifdef OMEGA_THREADED
    // total number of OpenMP threads
    NumThreads = omp_get_num_threads();
@@ -155,6 +158,8 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
       } else {
          MasterTaskFlag = false;
       }
+      // determine the node layout of the tasks
+      initNodeInfo();
 
       // otherwise initialize all values to bogus values
    } else {
@@ -164,6 +169,12 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
       NumTasks       = -999;
       MasterTask     = -999;
       MasterTaskFlag = false;
+      NodeComm       = MPI_COMM_NULL;
+      NodeLeaderComm = MPI_COMM_NULL;
+      MyNode         = -999;
+      NumNodes       = -999;
+      MyNodeTask     = -999;
+      NumNodeTasks   = -999;
    }
 
 #ifdef OMEGA_THREADED
@@ -256,6 +267,8 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
       } else {
          MasterTaskFlag = false;
       }
+      // determine the node layout of the tasks
+      initNodeInfo();
 
       // otherwise, set all members to bogus values
    } else {
@@ -265,6 +278,12 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
       NumTasks       = -999;
       MasterTask     = -999;
       MasterTaskFlag = false;
+      NodeComm       = MPI_COMM_NULL;
+      NodeLeaderComm = MPI_COMM_NULL;
+      MyNode         = -999;
+      NumNodes       = -999;
+      MyNodeTask     = -999;
+      NumNodeTasks   = -999;
    }
 
 #ifdef OMEGA_THREADED
@@ -354,6 +373,8 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
       } else {
          MasterTaskFlag = false;
       }
+      // determine the node layout of the tasks
+      initNodeInfo();
 
       // otherwise, set all members to bogus values
    } else {
@@ -363,6 +384,12 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
       NumTasks       = -999;
       MasterTask     = -999;
       MasterTaskFlag = false;
+      NodeComm       = MPI_COMM_NULL;
+      NodeLeaderComm = MPI_COMM_NULL;
+      MyNode         = -999;
+      NumNodes       = -999;
+      MyNodeTask     = -999;
+      NumNodeTasks   = -999;
    }
 
 #ifdef OMEGA_THREADED
@@ -377,6 +404,34 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
 
 } // end constructor with selected tasks
 
+//------------------------------------------------------------------------------
+// Determine the node layout of the tasks in an environment. Tasks that share
+// memory are grouped into a node communicator and the nodes are numbered
+// using the order of the lowest task on each node.
+
+void MachEnv::initNodeInfo() {
+
+   // Split the communicator into groups of tasks sharing a node
+   MPI_Comm_split_type(Comm, MPI_COMM_TYPE_SHARED, MyTask, MPI_INFO_NULL,
+                       &NodeComm);
+   MPI_Comm_rank(NodeComm, &MyNodeTask);
+   MPI_Comm_size(NodeComm, &NumNodeTasks);
+
+   // The first task on each node is the node leader. The node ID and number
+   // of nodes are found from a communicator of the node leaders and then
+   // broadcast to the other tasks on the node. The leader communicator is
+   // retained for two-stage (node, then global) reductions.
+   int LeaderColor = MyNodeTask == 0 ? 0 : MPI_UNDEFINED;
+   MPI_Comm_split(Comm, LeaderColor, MyTask, &NodeLeaderComm);
+   if (NodeLeaderComm != MPI_COMM_NULL) {
+      MPI_Comm_rank(NodeLeaderComm, &MyNode);
+      MPI_Comm_size(NodeLeaderComm, &NumNodes);
+   }
+   MPI_Bcast(&MyNode, 1, MPI_INT, 0, NodeComm);
+   MPI_Bcast(&NumNodes, 1, MPI_INT, 0, NodeComm);
+
+} // end initNodeInfo
+
 //------------------------------------------------------------------------------
 // Initializes the Machine Environment by creating the DefaultEnv for Omega
 
@@ -437,6 +492,22 @@ MachEnv *MachEnv::getEnv(const std::string Name ///< [in] Name of environment
 
 } // end getEnv
 
+//------------------------------------------------------------------------------
+// Get the environment that uses a communicator. Only environments of which
+// the local task is a member are searched, since other environments do not
+// have a valid communicator on this task.
+MachEnv *MachEnv::getEnvByComm(const MPI_Comm InComm ///< [in] communicator
+) {
+
+   for (auto &It : AllEnvs) {
+      MachEnv &Env = It.second;
+      if (Env.MemberFlag && Env.Comm == InComm)
+         return &Env;
+   }
+   return nullptr;
+
+} // end getEnvByComm
+
 //------------------------------------------------------------------------------
 // Get communicator for an environment
 MPI_Comm MachEnv::getComm() const { return Comm; }
@@ -458,6 +529,45 @@ int MachEnv::getMasterTask() const { return MasterTask; }
 
 bool MachEnv::isMasterTask() const { return MasterTaskFlag; }
 
+//------------------------------------------------------------------------------
+// Get communicator for the tasks on the local node
+MPI_Comm MachEnv::getNodeComm() const { return NodeComm; }
+
+//------------------------------------------------------------------------------
+// Get communicator for the node leaders
+MPI_Comm MachEnv::getNodeLeaderComm() const { return NodeLeaderComm; }
+
+//------------------------------------------------------------------------------
+// Get node ID for the local task
+int MachEnv::getMyNode() const { return MyNode; }
+
+//------------------------------------------------------------------------------
+// Get total number of nodes
+int MachEnv::getNumNodes() const { return NumNodes; }
+
+//------------------------------------------------------------------------------
+// Get local task/rank ID within the node
+int MachEnv::getMyNodeTask() const { return MyNodeTask; }
+
+//------------------------------------------------------------------------------
+// Get number of tasks on the local node
+int MachEnv::getNumNodeTasks() const { return NumNodeTasks; }
+
+//------------------------------------------------------------------------------
+// Get the device for the local task by dividing the tasks on the node into
+// contiguous blocks, one per device. If there are more devices than tasks,
+// each task gets its own device.
+
+int MachEnv::getDeviceID(const int NumDevices // [in] devices per node
+) const {
+
+   if (NumDevices <= 0 || NumNodeTasks <= 0)
+      return -1;
+
+   return (static_cast<long long>(MyNodeTask) * NumDevices) / NumNodeTasks;
+
+} // end getDeviceID
+
 //------------------------------------------------------------------------------
 // Determine whether local task is in this communicator's group
 
@@ -502,6 +612,10 @@ void MachEnv::print() const {
    std::cout << "  MasterTask     = " << MasterTask << std::endl;
    std::cout << "  MasterTaskFlag = " << MasterTaskFlag << std::endl;
    std::cout << "  MemberFlag     = " << MemberFlag << std::endl;
+   std::cout << "  MyNode         = " << MyNode << std::endl;
+   std::cout << "  NumNodes       = " << NumNodes << std::endl;
+   std::cout << "  MyNodeTask     = " << MyNodeTask << std::endl;
+   std::cout << "  NumNodeTasks   = " << NumNodeTasks << std::endl;
    std::cout << "  NumThreads     = " << NumThreads << std::endl;
    std::cout << "  VecLength      = " << VecLength << std::endl;
 
@@ -25,14 +25,25 @@
 namespace OMEGA {
 
 // For CPUs, a compile-time vector length is useful for
-// blocking the inner loops. This should be set to an appropriate
-// length (typically 32, 64, 128) for CPU-only builds, but set to one for
-// GPU builds to maximize parallelism instead.
+// blocking the inner loops over vertical levels. It is set by the build
+// (OMEGA_VECTOR_LENGTH) for the target architecture: one for GPU builds to
+// maximize parallelism and coalesce memory accesses across threads, and the
+// SIMD width (eg. 8 in double and 16 in single precision for AVX-512) for
+// CPU builds.
 #ifdef OMEGA_VECTOR_LENGTH
 constexpr int VecLength = OMEGA_VECTOR_LENGTH;
 #else
 constexpr int VecLength = 1;
 #endif
+static_assert(VecLength > 0, "OMEGA_VECTOR_LENGTH must be positive");
+
+/// Returns the number of chunks of VecLength vertical levels that cover
+/// NVertLevels levels. The last chunk is partial if NVertLevels is not a
+/// multiple of VecLength.
+constexpr int numVertChunks(int NVertLevels ///< [in] number of levels
+) {
+   return (NVertLevels + VecLength - 1) / VecLength;
+}
 
 /// The MachEnv class is a container that holds information on
 /// the message passing, threading and node environment.
@@ -49,10 +60,15 @@ class MachEnv {
    // Add threading variables here
    int NumThreads; ///< number of OpenMP threads per task
 
+   // Node (shared-memory) layout of the tasks in this environment
+   MPI_Comm NodeComm;       ///< MPI communicator for tasks on the local node
+   MPI_Comm NodeLeaderComm; ///< communicator of node leaders (null otherwise)
+   int MyNode;              ///< node ID (0-based) for the local task
+   int NumNodes;            ///< total number of nodes used by this environment
+   int MyNodeTask;          ///< task ID (rank) within the local node
+   int NumNodeTasks;        ///< number of tasks on the local node
+
    // Add any other useful machine parameters here
-   // It may be useful at some point to track the number
-   // of various devices per node (CPUs, GPUs), the number
-   // of tasks allocated per node, etc.
 
    /// The default environment describes the environment for OMEGA
    /// defined for most of the model. Because it is used most often,
@@ -70,6 +86,11 @@ class MachEnv {
            const MPI_Comm inComm   ///< [in] MPI communicator to use
    );
 
+   /// Determines the node layout of the tasks in this environment by
+   /// splitting the communicator into shared-memory groups. Nodes are
+   /// numbered in the order of the lowest task on each node.
+   void initNodeInfo();
+
  public:
    // Methods
 
@@ -130,6 +151,12 @@ class MachEnv {
    static MachEnv *getEnv(const std::string Name ///< [in] name of environment
    );
 
+   /// Retrieve the environment that uses a given communicator. Returns a
+   /// null pointer if no environment of which the local task is a member
+   /// uses the communicator.
+   static MachEnv *getEnvByComm(const MPI_Comm InComm ///< [in] communicator
+   );
+
    /// Get communicator for an environment
    MPI_Comm getComm() const; ///< returns MPI communicator for this env
 
@@ -145,6 +172,32 @@ class MachEnv {
    /// Determine whether local task is the master
    bool isMasterTask() const;
 
+   /// Get communicator for the tasks that share the local node
+   MPI_Comm getNodeComm() const;
+
+   /// Get communicator for the node leaders, ie the first task on each
+   /// node. This is MPI_COMM_NULL on tasks that are not node leaders.
+   MPI_Comm getNodeLeaderComm() const;
+
+   /// Get the node ID (0-based) of the local task
+   int getMyNode() const;
+
+   /// Get the total number of nodes used by this environment
+   int getNumNodes() const;
+
+   /// Get the local task/rank ID within the local node
+   int getMyNodeTask() const;
+
+   /// Get the number of tasks on the local node
+   int getNumNodeTasks() const;
+
+   /// Get the device (GPU) that the local task should use given the number
+   /// of devices on each node. The tasks on a node are assigned to devices
+   /// in contiguous blocks so that neighboring tasks share a device.
+   /// Returns -1 if there are no devices.
+   int getDeviceID(const int NumDevices ///< [in] number of devices per node
+   ) const;
+
    /// Determine whether local task is a member of this environment.
    /// This is primarily to prevent retrievals of non-existent
    /// values when a given environment uses only a subset of the
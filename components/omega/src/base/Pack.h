@@ -0,0 +1,195 @@
+#ifndef OMEGA_PACK_H
+#define OMEGA_PACK_H
+//===-- base/Pack.h - SIMD chunks of vertical levels ------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines a SIMD type holding a chunk of VecLength vertical levels
+///
+/// A Pack holds the values of one chunk of VecLength vertical levels, the
+/// unit of work of the kernels that loop over vertical chunks (see
+/// numVertChunks in MachEnv.h). It is built on Kokkos::Experimental::simd
+/// and stores the chunk in VecLength / W registers of the native SIMD type,
+/// of width W, of the default execution space, so that arithmetic on a Pack
+/// compiles to vector instructions on CPUs instead of depending on the
+/// compiler to vectorize loops over the levels. On GPUs the native SIMD type
+/// is a scalar and, with the default VecLength of one, a Pack is a single
+/// value per thread. If VecLength is not a multiple of W, the Pack uses
+/// scalar registers.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+
+#include <Kokkos_SIMD.hpp>
+#include <type_traits>
+
+namespace OMEGA {
+
+namespace PackImpl {
+
+template <typename T> using NativeSimd = Kokkos::Experimental::native_simd<T>;
+
+template <typename T>
+using ScalarSimd =
+    Kokkos::Experimental::simd<T, Kokkos::Experimental::simd_abi::scalar>;
+
+/// Register type of a Pack of T
+template <typename T>
+using Register = std::conditional_t<VecLength % NativeSimd<T>::size() == 0,
+                                    NativeSimd<T>, ScalarSimd<T>>;
+
+/// True if the levels of a row of V are contiguous values of type T
+template <typename T, typename V>
+constexpr bool IsContiguous =
+    std::is_same_v<typename V::array_layout, Kokkos::LayoutRight> &&
+    std::is_same_v<typename V::non_const_value_type, T>;
+
+} // end namespace PackImpl
+
+/// The Pack class holds a chunk of VecLength vertical levels in SIMD
+/// registers. The chunk starting at level KStart of row I of a 2-d array is
+/// loaded with Pack::load and stored with Pack::store. As in the scalar
+/// loops over a chunk, the loads of a partial last chunk are clamped to the
+/// last level KLast and the stores skip the levels beyond it.
+template <typename T> class Pack {
+
+ public:
+   using RegType                  = PackImpl::Register<T>;
+   static constexpr int RegLength = RegType::size();
+   static constexpr int NumRegs   = VecLength / RegLength;
+
+   /// Creates a Pack with undefined values
+   Pack() = default;
+
+   /// Creates a Pack with all levels set to Value
+   KOKKOS_INLINE_FUNCTION explicit Pack(T Value) {
+      for (int R = 0; R < NumRegs; ++R)
+         Regs[R] = RegType(Value);
+   }
+
+   /// Loads the chunk of levels KStart to KStart + VecLength - 1 of row I
+   /// of Array, with the levels beyond KLast replaced by level KLast
+   template <typename V>
+   KOKKOS_INLINE_FUNCTION static Pack load(const V &Array, int I, int KStart,
+                                           int KLast) {
+      Pack Chunk;
+      if constexpr (PackImpl::IsContiguous<T, V>) {
+         if (KStart + VecLength - 1 <= KLast) {
+            const T *Ptr = &Array(I, KStart);
+            for (int R = 0; R < NumRegs; ++R)
+               Chunk.Regs[R].copy_from(
+                   Ptr + R * RegLength,
+                   Kokkos::Experimental::element_aligned_tag());
+            return Chunk;
+         }
+      }
+      T Tmp[VecLength];
+      for (int KVec = 0; KVec < VecLength; ++KVec)
+         Tmp[KVec] = Array(I, Kokkos::min(KStart + KVec, KLast));
+      for (int R = 0; R < NumRegs; ++R)
+         Chunk.Regs[R].copy_from(Tmp + R * RegLength,
+                                 Kokkos::Experimental::element_aligned_tag());
+      return Chunk;
+   }
+
+   /// Stores the chunk in levels KStart to KStart + VecLength - 1 of row I
+   /// of Array, skipping the levels beyond KLast
+   template <typename V>
+   KOKKOS_INLINE_FUNCTION void store(const V &Array, int I, int KStart,
+                                     int KLast) const {
+      if constexpr (PackImpl::IsContiguous<T, V>) {
+         if (KStart + VecLength - 1 <= KLast) {
+            T *Ptr = &Array(I, KStart);
+            for (int R = 0; R < NumRegs; ++R)
+               Regs[R].copy_to(Ptr + R * RegLength,
+                               Kokkos::Experimental::element_aligned_tag());
+            return;
+         }
+      }
+      T Tmp[VecLength];
+      copyTo(Tmp);
+      for (int KVec = 0; KVec < VecLength && KStart + KVec <= KLast; ++KVec)
+         Array(I, KStart + KVec) = Tmp[KVec];
+   }
+
+   /// Adds the chunk to a register array of VecLength values
+   KOKKOS_INLINE_FUNCTION void addTo(T (&Sum)[VecLength]) const {
+      T Tmp[VecLength];
+      copyTo(Tmp);
+      for (int KVec = 0; KVec < VecLength; ++KVec)
+         Sum[KVec] += Tmp[KVec];
+   }
+
+   /// Copies the chunk to a register array of VecLength values
+   KOKKOS_INLINE_FUNCTION void copyTo(T (&Values)[VecLength]) const {
+      for (int R = 0; R < NumRegs; ++R)
+         Regs[R].copy_to(Values + R * RegLength,
+                         Kokkos::Experimental::element_aligned_tag());
+   }
+
+   KOKKOS_INLINE_FUNCTION Pack &operator+=(const Pack &Other) {
+      for (int R = 0; R < NumRegs; ++R)
+         Regs[R] = Regs[R] + Other.Regs[R];
+      return *this;
+   }
+
+   KOKKOS_INLINE_FUNCTION Pack &operator-=(const Pack &Other) {
+      for (int R = 0; R < NumRegs; ++R)
+         Regs[R] = Regs[R] - Other.Regs[R];
+      return *this;
+   }
+
+   KOKKOS_INLINE_FUNCTION Pack &operator*=(const Pack &Other) {
+      for (int R = 0; R < NumRegs; ++R)
+         Regs[R] = Regs[R] * Other.Regs[R];
+      return *this;
+   }
+
+   KOKKOS_INLINE_FUNCTION Pack &operator/=(const Pack &Other) {
+      for (int R = 0; R < NumRegs; ++R)
+         Regs[R] = Regs[R] / Other.Regs[R];
+      return *this;
+   }
+
+   KOKKOS_INLINE_FUNCTION friend Pack operator+(Pack A, const Pack &B) {
+      return A += B;
+   }
+   KOKKOS_INLINE_FUNCTION friend Pack operator-(Pack A, const Pack &B) {
+      return A -= B;
+   }
+   KOKKOS_INLINE_FUNCTION friend Pack operator*(Pack A, const Pack &B) {
+      return A *= B;
+   }
+   KOKKOS_INLINE_FUNCTION friend Pack operator/(Pack A, const Pack &B) {
+      return A /= B;
+   }
+
+   // Operations with a scalar apply it to all levels
+   KOKKOS_INLINE_FUNCTION friend Pack operator+(Pack A, T B) {
+      return A += Pack(B);
+   }
+   KOKKOS_INLINE_FUNCTION friend Pack operator-(Pack A, T B) {
+      return A -= Pack(B);
+   }
+   KOKKOS_INLINE_FUNCTION friend Pack operator*(Pack A, T B) {
+      return A *= Pack(B);
+   }
+   KOKKOS_INLINE_FUNCTION friend Pack operator*(T A, Pack B) {
+      return B *= Pack(A);
+   }
+   KOKKOS_INLINE_FUNCTION friend Pack operator/(Pack A, T B) {
+      return A /= Pack(B);
+   }
+
+ private:
+   RegType Regs[NumRegs];
+};
+
+/// Pack of the default real type
+using RealPack = Pack<Real>;
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_PACK_H
@@ -9,18 +9,22 @@
 //===----------------------------------------------------------------------===//
 
 #include <complex>
+#include <utility>
+#include <vector>
 using std::complex;
 
 #include "DataTypes.h"
+#include "MachEnv.h"
 #include "OmegaKokkos.h"
 
 namespace OMEGA {
 
-static int R8SumInitialized = 0;
+inline int R8SumInitialized = 0;
 
-static MPI_Op MPI_SUMDD; // special MPI operator for reproducible R8 sum
+inline MPI_Op MPI_SUMDD; // special MPI operator for reproducible R8 sum
 
-void ddSum(void *InBuffer, void *OutBuffer, int *Len, MPI_Datatype *DataType) {
+inline void ddSum(void *InBuffer, void *OutBuffer, int *Len,
+                  MPI_Datatype *DataType) {
    complex<double> *dda = (complex<double> *)InBuffer;
    complex<double> *ddb = (complex<double> *)OutBuffer;
    double e, t1, t2;
@@ -33,13 +37,170 @@ void ddSum(void *InBuffer, void *OutBuffer, int *Len, MPI_Datatype *DataType) {
    }
 }
 
-int globalSumInit() {
+inline int globalSumInit() {
    int ierr = MPI_Op_create(&ddSum, 1, &MPI_SUMDD);
    if (ierr == 0)
       R8SumInitialized = 1;
    return ierr;
 }
 
+///-----------------------------------------------------------------------------
+/// Hierarchical (node-aware) reductions
+///-----------------------------------------------------------------------------
+
+/// Methods for the blocking global reductions. Flat reductions use a single
+/// MPI_Allreduce over all tasks. Hierarchical reductions first reduce over
+/// the tasks on each node to the node leader, then reduce across the node
+/// leaders and finally broadcast the result within each node, so that only
+/// one task per node takes part in the global stage.
+enum class ReductionMethod { Flat, Hierarchical };
+
+inline ReductionMethod ReduceMethod = ReductionMethod::Flat;
+
+/// Select the method used by the blocking global reductions
+inline void setReductionMethod(const ReductionMethod Method) {
+   ReduceMethod = Method;
+}
+
+/// Returns the method used by the blocking global reductions
+inline ReductionMethod getReductionMethod() { return ReduceMethod; }
+
+/// Node-aware replacement for MPI_Allreduce used by all of the blocking
+/// reductions. Hierarchical reductions are only used if Comm is the
+/// communicator of a MachEnv (which holds the node and node leader
+/// communicators) that spans more than one node and has more than one task
+/// on some node; otherwise a flat MPI_Allreduce is used. The reduction
+/// operator, including the reproducible MPI_SUMDD, is applied at both
+/// stages.
+inline int nodeAllreduce(const void *SendBuf, void *RecvBuf, const int Count,
+                         MPI_Datatype DataType, MPI_Op Op,
+                         const MPI_Comm Comm) {
+   const MachEnv *Env = nullptr;
+   if (ReduceMethod == ReductionMethod::Hierarchical)
+      Env = MachEnv::getEnvByComm(Comm);
+   if (Env == nullptr || Env->getNumNodes() <= 1 ||
+       Env->getNumNodes() == Env->getNumTasks()) {
+      return MPI_Allreduce(SendBuf, RecvBuf, Count, DataType, Op, Comm);
+   }
+
+   MPI_Comm NodeComm   = Env->getNodeComm();
+   MPI_Comm LeaderComm = Env->getNodeLeaderComm();
+
+   // Reduce over the tasks on the node to the node leader (task 0 of the
+   // node communicator), then across the node leaders, and broadcast the
+   // result to the other tasks on the node
+   int ierr = MPI_Reduce(SendBuf, RecvBuf, Count, DataType, Op, 0, NodeComm);
+   if (ierr == MPI_SUCCESS && LeaderComm != MPI_COMM_NULL)
+      ierr = MPI_Allreduce(MPI_IN_PLACE, RecvBuf, Count, DataType, Op,
+                           LeaderComm);
+   if (ierr == MPI_SUCCESS)
+      ierr = MPI_Bcast(RecvBuf, Count, DataType, 0, NodeComm);
+   return ierr;
+}
+
+///-----------------------------------------------------------------------------
+/// Double-double accumulation of reproducible R8 sums on the host or device
+///-----------------------------------------------------------------------------
+
+/// Double-double value holding a sum (Hi) and its rounding error (Lo). It has
+/// the same layout as the complex<double> values reduced with MPI_SUMDD.
+struct DDValue {
+   R8 Hi;
+   R8 Lo;
+};
+
+/// Add the double-double value (BHi,BLo) to Sum using Knuth's algorithm
+KOKKOS_INLINE_FUNCTION void ddAdd(DDValue &Sum, const R8 BHi,
+                                  const R8 BLo = 0.0) {
+   R8 t1 = BHi + Sum.Hi;
+   R8 e  = t1 - BHi;
+   R8 t2 = ((Sum.Hi - e) + (BHi - (t1 - e))) + Sum.Lo + BLo;
+   // The result is t1 + t2, after normalization.
+   Sum.Hi = t1 + t2;
+   Sum.Lo = t2 - (Sum.Hi - t1);
+}
+
+/// Kokkos reducer that accumulates the partial sums of a parallelReduce in
+/// double-double precision, so that device sums are reproducible in the
+/// same way as host sums. The result is stored in a host DDValue.
+template <class Space = Kokkos::HostSpace> struct DDSum {
+ public:
+   using reducer    = DDSum<Space>;
+   using value_type = DDValue;
+   using result_view_type =
+       Kokkos::View<value_type, Space, Kokkos::MemoryUnmanaged>;
+
+ private:
+   result_view_type Value;
+
+ public:
+   KOKKOS_INLINE_FUNCTION
+   DDSum(value_type &InValue) : Value(&InValue) {}
+
+   KOKKOS_INLINE_FUNCTION
+   void join(value_type &Dest, const value_type &Src) const {
+      ddAdd(Dest, Src.Hi, Src.Lo);
+   }
+
+   KOKKOS_INLINE_FUNCTION
+   void init(value_type &Val) const {
+      Val.Hi = 0.0;
+      Val.Lo = 0.0;
+   }
+
+   KOKKOS_INLINE_FUNCTION
+   value_type &reference() const { return *Value.data(); }
+
+   KOKKOS_INLINE_FUNCTION
+   result_view_type view() const { return Value; }
+
+   KOKKOS_INLINE_FUNCTION
+   bool references_scalar() const { return true; }
+};
+
+/// Double-double local sum of the elements imin to imax-1 of a contiguous
+/// R8 or R4 host or device array
+template <typename V>
+DDValue localSumDD(const V &arr, const int imin, const int imax) {
+   DDValue LocalSum{0.0, 0.0};
+   if constexpr (Kokkos::SpaceAccessibility<typename V::memory_space,
+                                            Kokkos::HostSpace>::accessible) {
+      for (int i = imin; i < imax; i++) {
+         ddAdd(LocalSum, arr.data()[i]);
+      }
+   } else {
+      parallelReduce(
+          {imax - imin},
+          KOKKOS_LAMBDA(int i, DDValue &Accum) {
+             ddAdd(Accum, arr.data()[imin + i]);
+          },
+          DDSum<>(LocalSum));
+   }
+   return LocalSum;
+}
+
+/// Double-double local sum of the element-by-element product of the
+/// elements imin to imax-1 of two contiguous R8 host or device arrays
+template <typename V>
+DDValue localSumDD(const V &arr, const V &arr2, const int imin,
+                   const int imax) {
+   DDValue LocalSum{0.0, 0.0};
+   if constexpr (Kokkos::SpaceAccessibility<typename V::memory_space,
+                                            Kokkos::HostSpace>::accessible) {
+      for (int i = imin; i < imax; i++) {
+         ddAdd(LocalSum, arr.data()[i] * arr2.data()[i]);
+      }
+   } else {
+      parallelReduce(
+          {imax - imin},
+          KOKKOS_LAMBDA(int i, DDValue &Accum) {
+             ddAdd(Accum, arr.data()[imin + i] * arr2.data()[imin + i]);
+          },
+          DDSum<>(LocalSum));
+   }
+   return LocalSum;
+}
+
 ///-----------------------------------------------------------------------------
 /// Sum given values across all Comm's MPI processors
 ///-----------------------------------------------------------------------------
@@ -48,27 +209,27 @@ int globalSumInit() {
 // Global sum scalars
 //////////
 // I4
-int globalSum(const I4 *Val, const MPI_Comm Comm, I4 *Res) {
-   return MPI_Allreduce(Val, Res, 1, MPI_INT32_T, MPI_SUM, Comm);
+inline int globalSum(const I4 *Val, const MPI_Comm Comm, I4 *Res) {
+   return nodeAllreduce(Val, Res, 1, MPI_INT32_T, MPI_SUM, Comm);
 }
 
 // I8
-int globalSum(const I8 *Val, const MPI_Comm Comm, I8 *Res) {
-   return MPI_Allreduce(Val, Res, 1, MPI_INT64_T, MPI_SUM, Comm);
+inline int globalSum(const I8 *Val, const MPI_Comm Comm, I8 *Res) {
+   return nodeAllreduce(Val, Res, 1, MPI_INT64_T, MPI_SUM, Comm);
 }
 
 // R4
-int globalSum(const R4 *Val, const MPI_Comm Comm, R4 *Res) {
+inline int globalSum(const R4 *Val, const MPI_Comm Comm, R4 *Res) {
    R8 LocalTmp, GlobalTmp;
    LocalTmp = *Val;
    int ierr =
-       MPI_Allreduce(&LocalTmp, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
+       nodeAllreduce(&LocalTmp, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
    *Res = GlobalTmp;
    return ierr;
 }
 
 // R8
-int globalSum(const R8 *Val, const MPI_Comm Comm, R8 *Res) {
+inline int globalSum(const R8 *Val, const MPI_Comm Comm, R8 *Res) {
    // initialize reproducible MPI_SUMDD operator
    if (!R8SumInitialized) {
       globalSumInit();
@@ -77,7 +238,7 @@ int globalSum(const R8 *Val, const MPI_Comm Comm, R8 *Res) {
    complex<double> LocalTmp(*Val, 0.0);
    complex<double> GlobalTmp(0.0, 0.0);
 
-   int ierr = MPI_Allreduce(&LocalTmp, &GlobalTmp, 1, MPI_C_DOUBLE_COMPLEX,
+   int ierr = nodeAllreduce(&LocalTmp, &GlobalTmp, 1, MPI_C_DOUBLE_COMPLEX,
                             MPI_SUMDD, Comm);
    *Res     = real(GlobalTmp);
    return ierr;
@@ -111,7 +272,7 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm, IT *GlobalSum,
           {imax}, KOKKOS_LAMBDA(int i, IT &Accum) { Accum += arr.data()[i]; },
           LocalSum);
    }
-   return MPI_Allreduce(&LocalSum, GlobalSum, 1, MPI_INT64_T, MPI_SUM, Comm);
+   return nodeAllreduce(&LocalSum, GlobalSum, 1, MPI_INT64_T, MPI_SUM, Comm);
 }
 
 // R4 array
@@ -138,21 +299,24 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm, R4 *GlobalSum,
           {imax}, KOKKOS_LAMBDA(int i, R8 &Accum) { Accum += arr.data()[i]; },
           LocalSum);
    }
-   ierr = MPI_Allreduce(&LocalSum, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
+   ierr = nodeAllreduce(&LocalSum, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
    *GlobalSum = GlobalTmp;
    return ierr;
 }
 
-// R8 array
+// R8 array, or R4 array summed to an R8 result without rounding to R4, eg.
+// for the conservation checks of a single precision build
 template <typename T, typename ML, typename MS>
-std::enable_if_t<std::is_same_v<R8, typename Kokkos::View<T>::value_type>, int>
+std::enable_if_t<std::is_same_v<R8, typename Kokkos::View<T>::value_type> ||
+                     std::is_same_v<R4, typename Kokkos::View<T>::value_type>,
+                 int>
 globalSum(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm, R8 *GlobalSum,
           const std::vector<I4> *IndxRange = nullptr) {
    if (!R8SumInitialized) {
       globalSumInit();
    }
    int dim = arr.rank;
-   int i, imin, imax, ierr;
+   int imin, imax, ierr;
    if (IndxRange == nullptr) {
       imin = 0;
       imax = arr.size();
@@ -161,29 +325,13 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm, R8 *GlobalSum,
       imax = (*IndxRange)[dim * 2 - 1];
    }
 
-   if (Kokkos::SpaceAccessibility<MS, Kokkos::HostSpace>::accessible) {
-      // Accumulate the local sum using Knuth's algorithm
-      complex<double> LocalSum(0.0, 0.0), GlobalTmp(0.0, 0.0);
-      double e, t1, t2, ai;
-      for (i = imin; i < imax; i++) {
-         ai = arr.data()[i];
-         t1 = ai + real(LocalSum);
-         e  = t1 - ai;
-         t2 = ((real(LocalSum) - e) + (ai - (t1 - e))) + imag(LocalSum);
-         // The result is t1 + t2, after normalization.
-         LocalSum = complex<double>(t1 + t2, t2 - ((t1 + t2) - t1));
-      }
-      ierr       = MPI_Allreduce(&LocalSum, &GlobalTmp, 1, MPI_C_DOUBLE_COMPLEX,
-                                 MPI_SUMDD, Comm);
-      *GlobalSum = real(GlobalTmp);
-   } else {
-      R8 LocalSum = 0.0, GlobalTmp = 0.0;
-      parallelReduce(
-          {imax}, KOKKOS_LAMBDA(int i, R8 &Accum) { Accum += arr.data()[i]; },
-          LocalSum);
-      ierr = MPI_Allreduce(&LocalSum, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
-      *GlobalSum = GlobalTmp;
-   }
+   // Accumulate the local sum in double-double precision on the host or
+   // device using Knuth's algorithm
+   DDValue LocalTmp = localSumDD(arr, imin, imax);
+   complex<double> LocalSum(LocalTmp.Hi, LocalTmp.Lo), GlobalTmp(0.0, 0.0);
+   ierr       = nodeAllreduce(&LocalSum, &GlobalTmp, 1, MPI_C_DOUBLE_COMPLEX,
+                              MPI_SUMDD, Comm);
+   *GlobalSum = real(GlobalTmp);
    return ierr;
 }
 
@@ -219,7 +367,7 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const Kokkos::View<T, ML, MS> arr2,
           },
           LocalSum);
    }
-   return MPI_Allreduce(&LocalSum, GlobalSum, 1, MPI_INT64_T, MPI_SUM, Comm);
+   return nodeAllreduce(&LocalSum, GlobalSum, 1, MPI_INT64_T, MPI_SUM, Comm);
 }
 
 // R4 array
@@ -250,7 +398,7 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const Kokkos::View<T, ML, MS> arr2,
           },
           LocalSum);
    }
-   ierr = MPI_Allreduce(&LocalSum, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
+   ierr = nodeAllreduce(&LocalSum, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
    *GlobalSum = GlobalTmp;
    return ierr;
 }
@@ -265,7 +413,7 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const Kokkos::View<T, ML, MS> arr2,
       globalSumInit();
    }
    int dim = arr.rank;
-   int i, imin, imax, ierr;
+   int imin, imax, ierr;
    if (IndxRange == nullptr) {
       imin = 0;
       imax = arr.size();
@@ -274,32 +422,13 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const Kokkos::View<T, ML, MS> arr2,
       imax = (*IndxRange)[dim * 2 - 1];
    }
 
-   if (Kokkos::SpaceAccessibility<MS, Kokkos::HostSpace>::accessible) {
-      // Accumulate the local sum using Knuth's algorithm
-      complex<double> LocalSum(0.0, 0.0), GlobalTmp(0.0, 0.0);
-      double e, t1, t2, ai;
-      for (i = imin; i < imax; i++) {
-         ai = arr.data()[i] * arr2.data()[i];
-         t1 = ai + real(LocalSum);
-         e  = t1 - ai;
-         t2 = ((real(LocalSum) - e) + (ai - (t1 - e))) + imag(LocalSum);
-         // The result is t1 + t2, after normalization.
-         LocalSum = complex<double>(t1 + t2, t2 - ((t1 + t2) - t1));
-      }
-      ierr       = MPI_Allreduce(&LocalSum, &GlobalTmp, 1, MPI_C_DOUBLE_COMPLEX,
-                                 MPI_SUMDD, Comm);
-      *GlobalSum = real(GlobalTmp);
-   } else {
-      R8 LocalSum = 0.0, GlobalTmp = 0.0;
-      parallelReduce(
-          {imax},
-          KOKKOS_LAMBDA(int i, R8 &Accum) {
-             Accum += arr.data()[i] * arr2.data()[i];
-          },
-          LocalSum);
-      ierr = MPI_Allreduce(&LocalSum, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
-      *GlobalSum = GlobalTmp;
-   }
+   // Accumulate the local sum in double-double precision on the host or
+   // device using Knuth's algorithm
+   DDValue LocalTmp = localSumDD(arr, arr2, imin, imax);
+   complex<double> LocalSum(LocalTmp.Hi, LocalTmp.Lo), GlobalTmp(0.0, 0.0);
+   ierr       = nodeAllreduce(&LocalSum, &GlobalTmp, 1, MPI_C_DOUBLE_COMPLEX,
+                              MPI_SUMDD, Comm);
+   *GlobalSum = real(GlobalTmp);
    return ierr;
 }
 
@@ -307,31 +436,31 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const Kokkos::View<T, ML, MS> arr2,
 // Global sum multi-field
 //////////
 // I4 scalars
-int globalSum(const std::vector<I4> scalars, const MPI_Comm Comm,
-              std::vector<I4> GlobalSum) {
+inline int globalSum(const std::vector<I4> scalars, const MPI_Comm Comm,
+                     std::vector<I4> &GlobalSum) {
    int nFlds = scalars.size();
-   return MPI_Allreduce(&scalars[0], &GlobalSum[0], nFlds, MPI_INT32_T, MPI_SUM,
+   return nodeAllreduce(&scalars[0], &GlobalSum[0], nFlds, MPI_INT32_T, MPI_SUM,
                         Comm);
 }
 
 // I8 scalars
-int globalSum(const std::vector<I8> scalars, const MPI_Comm Comm,
-              std::vector<I8> GlobalSum) {
+inline int globalSum(const std::vector<I8> scalars, const MPI_Comm Comm,
+                     std::vector<I8> &GlobalSum) {
    int nFlds = scalars.size();
-   return MPI_Allreduce(&scalars[0], &GlobalSum[0], nFlds, MPI_INT64_T, MPI_SUM,
+   return nodeAllreduce(&scalars[0], &GlobalSum[0], nFlds, MPI_INT64_T, MPI_SUM,
                         Comm);
 }
 
 // R4 scalars
-int globalSum(const std::vector<R4> scalars, const MPI_Comm Comm,
-              std::vector<R4> GlobalSum) {
+inline int globalSum(const std::vector<R4> scalars, const MPI_Comm Comm,
+                     std::vector<R4> &GlobalSum) {
    int nFlds = scalars.size();
    R8 LocalTmp[nFlds], GlobalTmp[nFlds];
    int i, ierr;
    for (i = 0; i < nFlds; i++) {
       LocalTmp[i] = scalars[i]; // R8<-R4
    }
-   ierr = MPI_Allreduce(LocalTmp, GlobalTmp, nFlds, MPI_DOUBLE, MPI_SUM, Comm);
+   ierr = nodeAllreduce(LocalTmp, GlobalTmp, nFlds, MPI_DOUBLE, MPI_SUM, Comm);
    for (i = 0; i < nFlds; i++) {
       GlobalSum[i] = GlobalTmp[i]; // R4<-R8
    }
@@ -339,8 +468,8 @@ int globalSum(const std::vector<R4> scalars, const MPI_Comm Comm,
 }
 
 // R8 scalars
-int globalSum(const std::vector<R8> scalars, const MPI_Comm Comm,
-              std::vector<R8> GlobalSum) {
+inline int globalSum(const std::vector<R8> scalars, const MPI_Comm Comm,
+                     std::vector<R8> &GlobalSum) {
    if (!R8SumInitialized) {
       globalSumInit();
    }
@@ -351,7 +480,7 @@ int globalSum(const std::vector<R8> scalars, const MPI_Comm Comm,
       LocalTmp[i]  = complex<double>(scalars[i], 0.0);
       GlobalTmp[i] = complex<double>(0.0, 0.0);
    }
-   ierr = MPI_Allreduce(LocalTmp, GlobalTmp, nFlds, MPI_C_DOUBLE_COMPLEX,
+   ierr = nodeAllreduce(LocalTmp, GlobalTmp, nFlds, MPI_C_DOUBLE_COMPLEX,
                         MPI_SUMDD, Comm);
    for (i = 0; i < nFlds; i++) {
       GlobalSum[i] = real(GlobalTmp[i]);
@@ -359,11 +488,32 @@ int globalSum(const std::vector<R8> scalars, const MPI_Comm Comm,
    return ierr;
 }
 
+// Double-double partial sums, eg. local sums of the bins of a histogram
+// accumulated on the device, reduced together in one call
+inline int globalSum(const std::vector<DDValue> &Partials,
+                     const MPI_Comm Comm, std::vector<R8> &GlobalSum) {
+   if (!R8SumInitialized) {
+      globalSumInit();
+   }
+   int nFlds = Partials.size();
+   std::vector<complex<double>> LocalTmp(nFlds), GlobalTmp(nFlds);
+   for (int i = 0; i < nFlds; i++) {
+      LocalTmp[i] = complex<double>(Partials[i].Hi, Partials[i].Lo);
+   }
+   int ierr = nodeAllreduce(LocalTmp.data(), GlobalTmp.data(), nFlds,
+                            MPI_C_DOUBLE_COMPLEX, MPI_SUMDD, Comm);
+   GlobalSum.resize(nFlds);
+   for (int i = 0; i < nFlds; i++) {
+      GlobalSum[i] = real(GlobalTmp[i]);
+   }
+   return ierr;
+}
+
 // I4 arrays
 template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<I4, typename Kokkos::View<T>::value_type>, int>
 globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
-          const MPI_Comm Comm, std::vector<I4> GlobalSum,
+          const MPI_Comm Comm, std::vector<I4> &GlobalSum,
           const std::vector<I4> *IndxRange = nullptr) {
    int i, imin, imax, ifld;
    int nFlds = arrays.size();
@@ -382,7 +532,7 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
          LocalSum[ifld] += arrays[ifld].data()[i];
       }
    }
-   return MPI_Allreduce(LocalSum, &GlobalSum[0], nFlds, MPI_INT32_T, MPI_SUM,
+   return nodeAllreduce(LocalSum, &GlobalSum[0], nFlds, MPI_INT32_T, MPI_SUM,
                         Comm);
 }
 
@@ -390,7 +540,7 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
 template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<I8, typename Kokkos::View<T>::value_type>, int>
 globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
-          const MPI_Comm Comm, std::vector<I8> GlobalSum,
+          const MPI_Comm Comm, std::vector<I8> &GlobalSum,
           const std::vector<I4> *IndxRange = nullptr) {
    int i, imin, imax, ifld;
    int nFlds = arrays.size();
@@ -409,7 +559,7 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
          LocalSum[ifld] += arrays[ifld].data()[i];
       }
    }
-   return MPI_Allreduce(LocalSum, &GlobalSum[0], nFlds, MPI_INT64_T, MPI_SUM,
+   return nodeAllreduce(LocalSum, &GlobalSum[0], nFlds, MPI_INT64_T, MPI_SUM,
                         Comm);
 }
 
@@ -417,7 +567,7 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
 template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<R4, typename Kokkos::View<T>::value_type>, int>
 globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
-          const MPI_Comm Comm, std::vector<R4> GlobalSum,
+          const MPI_Comm Comm, std::vector<R4> &GlobalSum,
           const std::vector<I4> *IndxRange = nullptr) {
    int i, imin, imax, ifld, ierr;
    int nFlds = arrays.size();
@@ -436,7 +586,7 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
          LocalSum[ifld] += arrays[ifld].data()[i];
       }
    }
-   ierr = MPI_Allreduce(LocalSum, GlobalTmp, nFlds, MPI_DOUBLE, MPI_SUM, Comm);
+   ierr = nodeAllreduce(LocalSum, GlobalTmp, nFlds, MPI_DOUBLE, MPI_SUM, Comm);
    for (ifld = 0; ifld < nFlds; ifld++) {
       GlobalSum[ifld] = GlobalTmp[ifld]; // R4<-R8
    }
@@ -447,12 +597,12 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
 template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<R8, typename Kokkos::View<T>::value_type>, int>
 globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
-          const MPI_Comm Comm, std::vector<R8> GlobalSum,
+          const MPI_Comm Comm, std::vector<R8> &GlobalSum,
           const std::vector<I4> *IndxRange = nullptr) {
    if (!R8SumInitialized) {
       globalSumInit();
    }
-   int i, imin, imax, ifld, ierr;
+   int imin, imax, ifld, ierr;
    int nFlds = arrays.size();
    int dim   = arrays[0].rank;
    complex<double> GlobalTmp[nFlds], LocalSum[nFlds];
@@ -463,21 +613,14 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
       imin = (*IndxRange)[0];
       imax = (*IndxRange)[dim * 2 - 1];
    }
-   double e, t1, t2, ai;
+   // Accumulate the local sums in double-double precision on the host or
+   // device and reduce all fields in a single MPI call
    for (ifld = 0; ifld < nFlds; ifld++) {
-      LocalSum[ifld] = complex<double>(0.0, 0.0);
-      for (i = imin; i < imax; i++) {
-         ai = arrays[ifld].data()[i];
-         t1 = ai + real(LocalSum[ifld]);
-         e  = t1 - ai;
-         t2 = ((real(LocalSum[ifld]) - e) + (ai - (t1 - e))) +
-              imag(LocalSum[ifld]);
-         // The result is t1 + t2, after normalization.
-         LocalSum[ifld] = complex<double>(t1 + t2, t2 - ((t1 + t2) - t1));
-      }
-      GlobalTmp[ifld] = complex<double>(0.0, 0.0);
+      DDValue LocalTmp = localSumDD(arrays[ifld], imin, imax);
+      LocalSum[ifld]   = complex<double>(LocalTmp.Hi, LocalTmp.Lo);
+      GlobalTmp[ifld]  = complex<double>(0.0, 0.0);
    }
-   ierr = MPI_Allreduce(LocalSum, GlobalTmp, nFlds, MPI_C_DOUBLE_COMPLEX,
+   ierr = nodeAllreduce(LocalSum, GlobalTmp, nFlds, MPI_C_DOUBLE_COMPLEX,
                         MPI_SUMDD, Comm);
    for (ifld = 0; ifld < nFlds; ifld++) {
       GlobalSum[ifld] = real(GlobalTmp[ifld]);
@@ -493,7 +636,7 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<I4, typename Kokkos::View<T>::value_type>, int>
 globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
           const std::vector<Kokkos::View<T, ML, MS>> arrays2,
-          const MPI_Comm Comm, std::vector<I4> GlobalSum,
+          const MPI_Comm Comm, std::vector<I4> &GlobalSum,
           const std::vector<I4> *IndxRange = nullptr) {
    int i, imin, imax, ifld;
    int nFlds = arrays.size();
@@ -512,7 +655,7 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
          LocalSum[ifld] += arrays[ifld].data()[i] * arrays2[ifld].data()[i];
       }
    }
-   return MPI_Allreduce(LocalSum, &GlobalSum[0], nFlds, MPI_INT32_T, MPI_SUM,
+   return nodeAllreduce(LocalSum, &GlobalSum[0], nFlds, MPI_INT32_T, MPI_SUM,
                         Comm);
 }
 
@@ -521,7 +664,7 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<I8, typename Kokkos::View<T>::value_type>, int>
 globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
           const std::vector<Kokkos::View<T, ML, MS>> arrays2,
-          const MPI_Comm Comm, std::vector<I8> GlobalSum,
+          const MPI_Comm Comm, std::vector<I8> &GlobalSum,
           const std::vector<I4> *IndxRange = nullptr) {
    int i, imin, imax, ifld;
    int nFlds = arrays.size();
@@ -540,7 +683,7 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
          LocalSum[ifld] += arrays[ifld].data()[i] * arrays2[ifld].data()[i];
       }
    }
-   return MPI_Allreduce(LocalSum, &GlobalSum[0], nFlds, MPI_INT64_T, MPI_SUM,
+   return nodeAllreduce(LocalSum, &GlobalSum[0], nFlds, MPI_INT64_T, MPI_SUM,
                         Comm);
 }
 
@@ -549,7 +692,7 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<R4, typename Kokkos::View<T>::value_type>, int>
 globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
           const std::vector<Kokkos::View<T, ML, MS>> arrays2,
-          const MPI_Comm Comm, std::vector<R4> GlobalSum,
+          const MPI_Comm Comm, std::vector<R4> &GlobalSum,
           const std::vector<I4> *IndxRange = nullptr) {
    int i, imin, imax, ifld, ierr;
    int nFlds = arrays.size();
@@ -568,7 +711,7 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
          LocalSum[ifld] += arrays[ifld].data()[i] * arrays2[ifld].data()[i];
       }
    }
-   ierr = MPI_Allreduce(LocalSum, GlobalTmp, nFlds, MPI_DOUBLE, MPI_SUM, Comm);
+   ierr = nodeAllreduce(LocalSum, GlobalTmp, nFlds, MPI_DOUBLE, MPI_SUM, Comm);
    for (ifld = 0; ifld < nFlds; ifld++) {
       GlobalSum[ifld] = GlobalTmp[ifld]; // R4<-R8
    }
@@ -580,12 +723,12 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<R8, typename Kokkos::View<T>::value_type>, int>
 globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
           const std::vector<Kokkos::View<T, ML, MS>> arrays2,
-          const MPI_Comm Comm, std::vector<R8> GlobalSum,
+          const MPI_Comm Comm, std::vector<R8> &GlobalSum,
           const std::vector<I4> *IndxRange = nullptr) {
    if (!R8SumInitialized) {
       globalSumInit();
    }
-   int i, imin, imax, ifld, ierr;
+   int imin, imax, ifld, ierr;
    int nFlds = arrays.size();
    int dim   = arrays[0].rank;
    complex<double> GlobalTmp[nFlds], LocalSum[nFlds];
@@ -596,21 +739,14 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
       imin = (*IndxRange)[0];
       imax = (*IndxRange)[dim * 2 - 1];
    }
-   double e, t1, t2, ai;
+   // Accumulate the local sums in double-double precision on the host or
+   // device and reduce all fields in a single MPI call
    for (ifld = 0; ifld < nFlds; ifld++) {
-      LocalSum[ifld] = complex<double>(0.0, 0.0);
-      for (i = imin; i < imax; i++) {
-         ai = arrays[ifld].data()[i] * arrays2[ifld].data()[i];
-         t1 = ai + real(LocalSum[ifld]);
-         e  = t1 - ai;
-         t2 = ((real(LocalSum[ifld]) - e) + (ai - (t1 - e))) +
-              imag(LocalSum[ifld]);
-         // The result is t1 + t2, after normalization.
-         LocalSum[ifld] = complex<double>(t1 + t2, t2 - ((t1 + t2) - t1));
-      }
-      GlobalTmp[ifld] = complex<double>(0.0, 0.0);
+      DDValue LocalTmp = localSumDD(arrays[ifld], arrays2[ifld], imin, imax);
+      LocalSum[ifld]   = complex<double>(LocalTmp.Hi, LocalTmp.Lo);
+      GlobalTmp[ifld]  = complex<double>(0.0, 0.0);
    }
-   ierr = MPI_Allreduce(LocalSum, GlobalTmp, nFlds, MPI_C_DOUBLE_COMPLEX,
+   ierr = nodeAllreduce(LocalSum, GlobalTmp, nFlds, MPI_C_DOUBLE_COMPLEX,
                         MPI_SUMDD, Comm);
    for (ifld = 0; ifld < nFlds; ifld++) {
       GlobalSum[ifld] = real(GlobalTmp[ifld]);
@@ -643,16 +779,16 @@ globalMinVal(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm,
    }
 
    if (typeid(IT) == typeid(I4)) {
-      ierr = MPI_Allreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_INT32_T, MPI_MIN,
+      ierr = nodeAllreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_INT32_T, MPI_MIN,
                            Comm);
    } else if (typeid(IT) == typeid(I8)) {
-      ierr = MPI_Allreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_INT64_T, MPI_MIN,
+      ierr = nodeAllreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_INT64_T, MPI_MIN,
                            Comm);
    } else if (typeid(IT) == typeid(R4)) {
-      ierr = MPI_Allreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_FLOAT, MPI_MIN,
+      ierr = nodeAllreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_FLOAT, MPI_MIN,
                            Comm);
    } else if (typeid(IT) == typeid(R8)) {
-      ierr = MPI_Allreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_DOUBLE, MPI_MIN,
+      ierr = nodeAllreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_DOUBLE, MPI_MIN,
                            Comm);
    }
    return ierr;
@@ -682,16 +818,16 @@ globalMinVal(const Kokkos::View<T, ML, MS> arr,
    }
 
    if (typeid(IT) == typeid(I4)) {
-      ierr = MPI_Allreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_INT32_T, MPI_MIN,
+      ierr = nodeAllreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_INT32_T, MPI_MIN,
                            Comm);
    } else if (typeid(IT) == typeid(I8)) {
-      ierr = MPI_Allreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_INT64_T, MPI_MIN,
+      ierr = nodeAllreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_INT64_T, MPI_MIN,
                            Comm);
    } else if (typeid(IT) == typeid(R4)) {
-      ierr = MPI_Allreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_FLOAT, MPI_MIN,
+      ierr = nodeAllreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_FLOAT, MPI_MIN,
                            Comm);
    } else if (typeid(IT) == typeid(R8)) {
-      ierr = MPI_Allreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_DOUBLE, MPI_MIN,
+      ierr = nodeAllreduce(&LocalMinVal, &GlobalMinVal, 1, MPI_DOUBLE, MPI_MIN,
                            Comm);
    }
    return ierr;
@@ -723,16 +859,16 @@ globalMinVal(const std::vector<Kokkos::View<T, ML, MS>> arrays,
       }
    }
    if (typeid(IT) == typeid(I4)) {
-      ierr = MPI_Allreduce(LocalMinVal, &GlobalMinVal[0], nFlds, MPI_INT32_T,
+      ierr = nodeAllreduce(LocalMinVal, &GlobalMinVal[0], nFlds, MPI_INT32_T,
                            MPI_MIN, Comm);
    } else if (typeid(IT) == typeid(I8)) {
-      ierr = MPI_Allreduce(LocalMinVal, &GlobalMinVal[0], nFlds, MPI_INT64_T,
+      ierr = nodeAllreduce(LocalMinVal, &GlobalMinVal[0], nFlds, MPI_INT64_T,
                            MPI_MIN, Comm);
    } else if (typeid(IT) == typeid(R4)) {
-      ierr = MPI_Allreduce(LocalMinVal, &GlobalMinVal[0], nFlds, MPI_FLOAT,
+      ierr = nodeAllreduce(LocalMinVal, &GlobalMinVal[0], nFlds, MPI_FLOAT,
                            MPI_MIN, Comm);
    } else if (typeid(IT) == typeid(R8)) {
-      ierr = MPI_Allreduce(LocalMinVal, &GlobalMinVal[0], nFlds, MPI_DOUBLE,
+      ierr = nodeAllreduce(LocalMinVal, &GlobalMinVal[0], nFlds, MPI_DOUBLE,
                            MPI_MIN, Comm);
    }
    return ierr;
@@ -763,16 +899,16 @@ globalMaxVal(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm,
    }
 
    if (typeid(IT) == typeid(I4)) {
-      ierr = MPI_Allreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_INT32_T, MPI_MAX,
+      ierr = nodeAllreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_INT32_T, MPI_MAX,
                            Comm);
    } else if (typeid(IT) == typeid(I8)) {
-      ierr = MPI_Allreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_INT64_T, MPI_MAX,
+      ierr = nodeAllreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_INT64_T, MPI_MAX,
                            Comm);
    } else if (typeid(IT) == typeid(R4)) {
-      ierr = MPI_Allreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_FLOAT, MPI_MAX,
+      ierr = nodeAllreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_FLOAT, MPI_MAX,
                            Comm);
    } else if (typeid(IT) == typeid(R8)) {
-      ierr = MPI_Allreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_DOUBLE, MPI_MAX,
+      ierr = nodeAllreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_DOUBLE, MPI_MAX,
                            Comm);
    }
    return ierr;
@@ -802,16 +938,16 @@ globalMaxVal(const Kokkos::View<T, ML, MS> arr,
    }
 
    if (typeid(IT) == typeid(I4)) {
-      ierr = MPI_Allreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_INT32_T, MPI_MAX,
+      ierr = nodeAllreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_INT32_T, MPI_MAX,
                            Comm);
    } else if (typeid(IT) == typeid(I8)) {
-      ierr = MPI_Allreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_INT64_T, MPI_MAX,
+      ierr = nodeAllreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_INT64_T, MPI_MAX,
                            Comm);
    } else if (typeid(IT) == typeid(R4)) {
-      ierr = MPI_Allreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_FLOAT, MPI_MAX,
+      ierr = nodeAllreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_FLOAT, MPI_MAX,
                            Comm);
    } else if (typeid(IT) == typeid(R8)) {
-      ierr = MPI_Allreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_DOUBLE, MPI_MAX,
+      ierr = nodeAllreduce(&LocalMaxVal, &GlobalMaxVal, 1, MPI_DOUBLE, MPI_MAX,
                            Comm);
    }
    return ierr;
@@ -843,45 +979,229 @@ globalMaxVal(const std::vector<Kokkos::View<T, ML, MS>> arrays,
       }
    }
    if (typeid(IT) == typeid(I4)) {
-      ierr = MPI_Allreduce(LocalMaxVal, &GlobalMaxVal[0], nFlds, MPI_INT32_T,
+      ierr = nodeAllreduce(LocalMaxVal, &GlobalMaxVal[0], nFlds, MPI_INT32_T,
                            MPI_MAX, Comm);
    } else if (typeid(IT) == typeid(I8)) {
-      ierr = MPI_Allreduce(LocalMaxVal, &GlobalMaxVal[0], nFlds, MPI_INT64_T,
+      ierr = nodeAllreduce(LocalMaxVal, &GlobalMaxVal[0], nFlds, MPI_INT64_T,
                            MPI_MAX, Comm);
    } else if (typeid(IT) == typeid(R4)) {
-      ierr = MPI_Allreduce(LocalMaxVal, &GlobalMaxVal[0], nFlds, MPI_FLOAT,
+      ierr = nodeAllreduce(LocalMaxVal, &GlobalMaxVal[0], nFlds, MPI_FLOAT,
                            MPI_MAX, Comm);
    } else if (typeid(IT) == typeid(R8)) {
-      ierr = MPI_Allreduce(LocalMaxVal, &GlobalMaxVal[0], nFlds, MPI_DOUBLE,
+      ierr = nodeAllreduce(LocalMaxVal, &GlobalMaxVal[0], nFlds, MPI_DOUBLE,
                            MPI_MAX, Comm);
    }
    return ierr;
 }
 
+///-----------------------------------------------------------------------------
+/// Weighted and masked reductions over owned cells
+///-----------------------------------------------------------------------------
+
+/// Placeholder passed in place of a weight array for unweighted reductions
+struct NoWeight {};
+
+/// Placeholder passed in place of a mask array for unmasked reductions
+struct NoMask {};
+
+/// Element (i,k) of a 1-d or 2-d array, where 1-d arrays (eg. AreaCell) are
+/// broadcast over the second (vertical) dimension
+template <typename V>
+KOKKOS_INLINE_FUNCTION R8 reductionValue(const V &Arr, const int i,
+                                         const int k) {
+   if constexpr (V::rank == 1) {
+      return Arr(i);
+   } else {
+      return Arr(i, k);
+   }
+}
+
+/// Weight of element (i,k), which is one for NoWeight
+template <typename W>
+KOKKOS_INLINE_FUNCTION R8 reductionWeight(const W &Weight, const int i,
+                                          const int k) {
+   if constexpr (std::is_same_v<W, NoWeight>) {
+      return 1.0;
+   } else {
+      return reductionValue(Weight, i, k);
+   }
+}
+
+/// Returns true if element (i,k) is included, ie if the mask is non-zero
+template <typename M>
+KOKKOS_INLINE_FUNCTION bool reductionMask(const M &Mask, const int i,
+                                          const int k) {
+   if constexpr (std::is_same_v<M, NoMask>) {
+      return true;
+   } else if constexpr (M::rank == 1) {
+      return Mask(i) != 0;
+   } else {
+      return Mask(i, k) != 0;
+   }
+}
+
+/// Double-double local sum of Arr*Weight1*Weight2 over the unmasked elements
+/// of the first NOwned cells (rows) of a 1-d or 2-d host or device array.
+/// The weights and mask are evaluated in the same loop or kernel, so no
+/// temporary product arrays are needed.
+template <typename V, typename W1, typename W2, typename M>
+DDValue localWeightedSumDD(const V &Arr, const W1 &Weight1, const W2 &Weight2,
+                           const M &Mask, const I4 NOwned) {
+   static_assert(V::rank == 1 or V::rank == 2,
+                 "Weighted reductions require 1-d or 2-d arrays");
+   const int NLevels = V::rank == 1 ? 1 : Arr.extent_int(1);
+
+   DDValue LocalSum{0.0, 0.0};
+   if constexpr (Kokkos::SpaceAccessibility<typename V::memory_space,
+                                            Kokkos::HostSpace>::accessible) {
+      for (int i = 0; i < NOwned; i++) {
+         for (int k = 0; k < NLevels; k++) {
+            if (reductionMask(Mask, i, k))
+               ddAdd(LocalSum, reductionValue(Arr, i, k) *
+                                   reductionWeight(Weight1, i, k) *
+                                   reductionWeight(Weight2, i, k));
+         }
+      }
+   } else {
+      parallelReduce(
+          {NOwned, NLevels},
+          KOKKOS_LAMBDA(int i, int k, DDValue &Accum) {
+             if (reductionMask(Mask, i, k))
+                ddAdd(Accum, reductionValue(Arr, i, k) *
+                                 reductionWeight(Weight1, i, k) *
+                                 reductionWeight(Weight2, i, k));
+          },
+          DDSum<>(LocalSum));
+   }
+   return LocalSum;
+}
+
+/// Local minimum (IsMax false) or maximum (IsMax true) of Arr*Weight over
+/// the unmasked elements of the first NOwned cells (rows) of a 1-d or 2-d
+/// host or device array. If all elements are masked, the result is the
+/// identity of the reduction (the largest or lowest R8 value).
+template <bool IsMax, typename V, typename W, typename M>
+R8 localMaskedExtremum(const V &Arr, const W &Weight, const M &Mask,
+                       const I4 NOwned) {
+   static_assert(V::rank == 1 or V::rank == 2,
+                 "Masked reductions require 1-d or 2-d arrays");
+   const int NLevels = V::rank == 1 ? 1 : Arr.extent_int(1);
+
+   R8 LocalVal = IsMax ? Kokkos::reduction_identity<R8>::max()
+                       : Kokkos::reduction_identity<R8>::min();
+   if constexpr (Kokkos::SpaceAccessibility<typename V::memory_space,
+                                            Kokkos::HostSpace>::accessible) {
+      for (int i = 0; i < NOwned; i++) {
+         for (int k = 0; k < NLevels; k++) {
+            if (reductionMask(Mask, i, k)) {
+               R8 Val = reductionValue(Arr, i, k) *
+                        reductionWeight(Weight, i, k);
+               LocalVal = IsMax ? Kokkos::max(LocalVal, Val)
+                                : Kokkos::min(LocalVal, Val);
+            }
+         }
+      }
+   } else {
+      auto Kernel = KOKKOS_LAMBDA(int i, int k, R8 &Accum) {
+         if (reductionMask(Mask, i, k)) {
+            R8 Val = reductionValue(Arr, i, k) * reductionWeight(Weight, i, k);
+            Accum  = IsMax ? Kokkos::max(Accum, Val) : Kokkos::min(Accum, Val);
+         }
+      };
+      if constexpr (IsMax) {
+         parallelReduce({NOwned, NLevels}, Kernel, Kokkos::Max<R8>(LocalVal));
+      } else {
+         parallelReduce({NOwned, NLevels}, Kernel, Kokkos::Min<R8>(LocalVal));
+      }
+   }
+   return LocalVal;
+}
+
+//////////
+// Global weighted and masked sum
+//////////
+// Reproducible sum of Arr*Weight over the unmasked elements of the first
+// NOwned cells, eg. the area-weighted sum of a field over owned ocean cells.
+// Weight and Mask may be NoWeight() and NoMask().
+template <typename V, typename W, typename M>
+std::enable_if_t<Kokkos::is_view_v<V>, int>
+globalSum(const V &Arr, const W &Weight, const M &Mask, const MPI_Comm Comm,
+          R8 *GlobalSum, const I4 NOwned) {
+   if (!R8SumInitialized) {
+      globalSumInit();
+   }
+   DDValue LocalTmp = localWeightedSumDD(Arr, Weight, NoWeight(), Mask, NOwned);
+   complex<double> LocalSum(LocalTmp.Hi, LocalTmp.Lo), GlobalTmp(0.0, 0.0);
+   int ierr   = nodeAllreduce(&LocalSum, &GlobalTmp, 1, MPI_C_DOUBLE_COMPLEX,
+                              MPI_SUMDD, Comm);
+   *GlobalSum = real(GlobalTmp);
+   return ierr;
+}
+
+// Reproducible sum of Arr*Weight1*Weight2, eg. weighted by both the cell area
+// and the layer thickness of each cell
+template <typename V, typename W1, typename W2, typename M>
+std::enable_if_t<Kokkos::is_view_v<V>, int>
+globalSum(const V &Arr, const W1 &Weight1, const W2 &Weight2, const M &Mask,
+          const MPI_Comm Comm, R8 *GlobalSum, const I4 NOwned) {
+   if (!R8SumInitialized) {
+      globalSumInit();
+   }
+   DDValue LocalTmp = localWeightedSumDD(Arr, Weight1, Weight2, Mask, NOwned);
+   complex<double> LocalSum(LocalTmp.Hi, LocalTmp.Lo), GlobalTmp(0.0, 0.0);
+   int ierr   = nodeAllreduce(&LocalSum, &GlobalTmp, 1, MPI_C_DOUBLE_COMPLEX,
+                              MPI_SUMDD, Comm);
+   *GlobalSum = real(GlobalTmp);
+   return ierr;
+}
+
+//////////
+// Global weighted and masked minval and maxval
+//////////
+// Minimum of Arr*Weight over the unmasked elements of the first NOwned cells
+template <typename V, typename W, typename M>
+std::enable_if_t<Kokkos::is_view_v<V>, int>
+globalMinVal(const V &Arr, const W &Weight, const M &Mask, const MPI_Comm Comm,
+             R8 *GlobalMinVal, const I4 NOwned) {
+   R8 LocalMinVal = localMaskedExtremum<false>(Arr, Weight, Mask, NOwned);
+   return nodeAllreduce(&LocalMinVal, GlobalMinVal, 1, MPI_DOUBLE, MPI_MIN,
+                        Comm);
+}
+
+// Maximum of Arr*Weight over the unmasked elements of the first NOwned cells
+template <typename V, typename W, typename M>
+std::enable_if_t<Kokkos::is_view_v<V>, int>
+globalMaxVal(const V &Arr, const W &Weight, const M &Mask, const MPI_Comm Comm,
+             R8 *GlobalMaxVal, const I4 NOwned) {
+   R8 LocalMaxVal = localMaskedExtremum<true>(Arr, Weight, Mask, NOwned);
+   return nodeAllreduce(&LocalMaxVal, GlobalMaxVal, 1, MPI_DOUBLE, MPI_MAX,
+                        Comm);
+}
+
 ///-----------------------------------------------------------------------------
 /// Get MIN-value across all MPI processors in the MachEnv
 ///-----------------------------------------------------------------------------
-int globalMin(const I4 *Val, I4 *Res, const MPI_Comm Comm) {
-   return MPI_Allreduce(Val, Res, 1, MPI_INT32_T, MPI_MIN, Comm);
+inline int globalMin(const I4 *Val, I4 *Res, const MPI_Comm Comm) {
+   return nodeAllreduce(Val, Res, 1, MPI_INT32_T, MPI_MIN, Comm);
 }
 
-int globalMin(const I8 *Val, I8 *Res, const MPI_Comm Comm) {
-   return MPI_Allreduce(Val, Res, 1, MPI_INT64_T, MPI_MIN, Comm);
+inline int globalMin(const I8 *Val, I8 *Res, const MPI_Comm Comm) {
+   return nodeAllreduce(Val, Res, 1, MPI_INT64_T, MPI_MIN, Comm);
 }
 
-int globalMin(const R4 *Val, R4 *Res, const MPI_Comm Comm) {
-   return MPI_Allreduce(Val, Res, 1, MPI_FLOAT, MPI_MIN, Comm);
+inline int globalMin(const R4 *Val, R4 *Res, const MPI_Comm Comm) {
+   return nodeAllreduce(Val, Res, 1, MPI_FLOAT, MPI_MIN, Comm);
 }
 
-int globalMin(const R8 *Val, R8 *Res, const MPI_Comm Comm) {
-   return MPI_Allreduce(Val, Res, 1, MPI_DOUBLE, MPI_MIN, Comm);
+inline int globalMin(const R8 *Val, R8 *Res, const MPI_Comm Comm) {
+   return nodeAllreduce(Val, Res, 1, MPI_DOUBLE, MPI_MIN, Comm);
 }
 
 template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<I4, typename Kokkos::View<T>::value_type>, int>
 globalMin(Kokkos::View<T, ML, MS> const in, Kokkos::View<T, ML, MS> out,
           const MPI_Comm Comm) {
-   return MPI_Allreduce(in.data(), out.data(), in.size(), MPI_INT32_T, MPI_MIN,
+   return nodeAllreduce(in.data(), out.data(), in.size(), MPI_INT32_T, MPI_MIN,
                         Comm);
 }
 
@@ -889,7 +1209,7 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<I8, typename Kokkos::View<T>::value_type>, int>
 globalMin(Kokkos::View<T, ML, MS> const in, Kokkos::View<T, ML, MS> out,
           const MPI_Comm Comm) {
-   return MPI_Allreduce(in.data(), out.data(), in.size(), MPI_INT64_T, MPI_MIN,
+   return nodeAllreduce(in.data(), out.data(), in.size(), MPI_INT64_T, MPI_MIN,
                         Comm);
 }
 
@@ -897,7 +1217,7 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<R4, typename Kokkos::View<T>::value_type>, int>
 globalMin(Kokkos::View<T, ML, MS> const in, Kokkos::View<T, ML, MS> out,
           const MPI_Comm Comm) {
-   return MPI_Allreduce(in.data(), out.data(), in.size(), MPI_FLOAT, MPI_MIN,
+   return nodeAllreduce(in.data(), out.data(), in.size(), MPI_FLOAT, MPI_MIN,
                         Comm);
 }
 
@@ -905,34 +1225,34 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<R8, typename Kokkos::View<T>::value_type>, int>
 globalMin(Kokkos::View<T, ML, MS> const in, Kokkos::View<T, ML, MS> out,
           const MPI_Comm Comm) {
-   return MPI_Allreduce(in.data(), out.data(), in.size(), MPI_DOUBLE, MPI_MIN,
+   return nodeAllreduce(in.data(), out.data(), in.size(), MPI_DOUBLE, MPI_MIN,
                         Comm);
 }
 
 ///-----------------------------------------------------------------------------
 /// Get MAX-value across all MPI processors in the MachEnv
 ///-----------------------------------------------------------------------------
-int globalMax(const I4 *Val, I4 *Res, const MPI_Comm Comm) {
-   return MPI_Allreduce(Val, Res, 1, MPI_INT32_T, MPI_MAX, Comm);
+inline int globalMax(const I4 *Val, I4 *Res, const MPI_Comm Comm) {
+   return nodeAllreduce(Val, Res, 1, MPI_INT32_T, MPI_MAX, Comm);
 }
 
-int globalMax(const I8 *Val, I8 *Res, const MPI_Comm Comm) {
-   return MPI_Allreduce(Val, Res, 1, MPI_INT64_T, MPI_MAX, Comm);
+inline int globalMax(const I8 *Val, I8 *Res, const MPI_Comm Comm) {
+   return nodeAllreduce(Val, Res, 1, MPI_INT64_T, MPI_MAX, Comm);
 }
 
-int globalMax(const R4 *Val, R4 *Res, const MPI_Comm Comm) {
-   return MPI_Allreduce(Val, Res, 1, MPI_FLOAT, MPI_MAX, Comm);
+inline int globalMax(const R4 *Val, R4 *Res, const MPI_Comm Comm) {
+   return nodeAllreduce(Val, Res, 1, MPI_FLOAT, MPI_MAX, Comm);
 }
 
-int globalMax(const R8 *Val, R8 *Res, const MPI_Comm Comm) {
-   return MPI_Allreduce(Val, Res, 1, MPI_DOUBLE, MPI_MAX, Comm);
+inline int globalMax(const R8 *Val, R8 *Res, const MPI_Comm Comm) {
+   return nodeAllreduce(Val, Res, 1, MPI_DOUBLE, MPI_MAX, Comm);
 }
 
 template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<I4, typename Kokkos::View<T>::value_type>, int>
 globalMax(Kokkos::View<T, ML, MS> const in, Kokkos::View<T, ML, MS> out,
           const MPI_Comm Comm) {
-   return MPI_Allreduce(in.data(), out.data(), in.size(), MPI_INT32_T, MPI_MAX,
+   return nodeAllreduce(in.data(), out.data(), in.size(), MPI_INT32_T, MPI_MAX,
                         Comm);
 }
 
@@ -940,7 +1260,7 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<I8, typename Kokkos::View<T>::value_type>, int>
 globalMax(Kokkos::View<T, ML, MS> const in, Kokkos::View<T, ML, MS> out,
           const MPI_Comm Comm) {
-   return MPI_Allreduce(in.data(), out.data(), in.size(), MPI_INT64_T, MPI_MAX,
+   return nodeAllreduce(in.data(), out.data(), in.size(), MPI_INT64_T, MPI_MAX,
                         Comm);
 }
 
@@ -948,7 +1268,7 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<R4, typename Kokkos::View<T>::value_type>, int>
 globalMax(Kokkos::View<T, ML, MS> const in, Kokkos::View<T, ML, MS> out,
           const MPI_Comm Comm) {
-   return MPI_Allreduce(in.data(), out.data(), in.size(), MPI_FLOAT, MPI_MAX,
+   return nodeAllreduce(in.data(), out.data(), in.size(), MPI_FLOAT, MPI_MAX,
                         Comm);
 }
 
@@ -956,10 +1276,277 @@ template <typename T, typename ML, typename MS>
 std::enable_if_t<std::is_same_v<R8, typename Kokkos::View<T>::value_type>, int>
 globalMax(Kokkos::View<T, ML, MS> const in, Kokkos::View<T, ML, MS> out,
           const MPI_Comm Comm) {
-   return MPI_Allreduce(in.data(), out.data(), in.size(), MPI_DOUBLE, MPI_MAX,
+   return nodeAllreduce(in.data(), out.data(), in.size(), MPI_DOUBLE, MPI_MAX,
                         Comm);
 }
 
+///-----------------------------------------------------------------------------
+/// Non-blocking global reductions
+///-----------------------------------------------------------------------------
+// Each start function computes the local values of a reduction, starts an
+// MPI_Iallreduce and returns immediately. The result is collected by the
+// matching finish function, so that other work (eg. the next stage of a time
+// step) can overlap the communication. The request holds the local and
+// global buffers of the reduction and must not be reused or destroyed before
+// the finish call.
+
+/// State of a non-blocking global reduction. Only one of the double-double,
+/// R8 or I8 buffers is used by a given reduction.
+struct ReductionRequest {
+   MPI_Request Request{MPI_REQUEST_NULL}; ///< MPI request in progress
+   std::vector<complex<double>> LocalDD;  ///< local double-double R8 sums
+   std::vector<complex<double>> GlobalDD; ///< global double-double R8 sums
+   std::vector<R8> LocalR8;               ///< local R4/R8 values
+   std::vector<R8> GlobalR8;              ///< global R4/R8 values
+   std::vector<I8> LocalI8;               ///< local integer values
+   std::vector<I8> GlobalI8;              ///< global integer values
+};
+
+/// Store local values in the request buffer for their type. R8 sums use the
+/// double-double buffer, other R4 and R8 reductions the R8 buffer and
+/// integers the I8 buffer.
+template <typename T>
+void setLocalValues(ReductionRequest &Req, const T *Vals, const int NVals,
+                    const bool SumDD) {
+   Req.LocalDD.clear();
+   Req.LocalR8.clear();
+   Req.LocalI8.clear();
+   for (int i = 0; i < NVals; i++) {
+      if constexpr (std::is_integral_v<T>) {
+         Req.LocalI8.push_back(Vals[i]);
+      } else {
+         if (SumDD) {
+            Req.LocalDD.push_back(complex<double>(Vals[i], 0.0));
+         } else {
+            Req.LocalR8.push_back(Vals[i]);
+         }
+      }
+   }
+}
+
+/// Start the global reduction of the local values in the request with the
+/// operator Op (MPI_SUM, MPI_MIN or MPI_MAX). Double-double sums use the
+/// reproducible MPI_SUMDD operator.
+inline int startReduction(ReductionRequest &Req, MPI_Op Op,
+                          const MPI_Comm Comm) {
+   if (!Req.LocalDD.empty()) {
+      if (!R8SumInitialized) {
+         globalSumInit();
+      }
+      Req.GlobalDD.assign(Req.LocalDD.size(), complex<double>(0.0, 0.0));
+      return MPI_Iallreduce(Req.LocalDD.data(), Req.GlobalDD.data(),
+                            Req.LocalDD.size(), MPI_C_DOUBLE_COMPLEX,
+                            MPI_SUMDD, Comm, &Req.Request);
+   } else if (!Req.LocalR8.empty()) {
+      Req.GlobalR8.assign(Req.LocalR8.size(), 0.0);
+      return MPI_Iallreduce(Req.LocalR8.data(), Req.GlobalR8.data(),
+                            Req.LocalR8.size(), MPI_DOUBLE, Op, Comm,
+                            &Req.Request);
+   } else {
+      Req.GlobalI8.assign(Req.LocalI8.size(), 0);
+      return MPI_Iallreduce(Req.LocalI8.data(), Req.GlobalI8.data(),
+                            Req.LocalI8.size(), MPI_INT64_T, Op, Comm,
+                            &Req.Request);
+   }
+}
+
+/// Wait for a reduction and copy its NVals global values to Res
+template <typename T>
+int finishReduction(ReductionRequest &Req, T *Res, const int NVals) {
+   int ierr = MPI_Wait(&Req.Request, MPI_STATUS_IGNORE);
+   for (int i = 0; i < NVals; i++) {
+      if (!Req.GlobalDD.empty()) {
+         Res[i] = real(Req.GlobalDD[i]);
+      } else if (!Req.GlobalR8.empty()) {
+         Res[i] = Req.GlobalR8[i];
+      } else {
+         Res[i] = Req.GlobalI8[i];
+      }
+   }
+   Req.GlobalDD.clear();
+   Req.GlobalR8.clear();
+   Req.GlobalI8.clear();
+   return ierr;
+}
+
+/// Number of values in the reduction of a request
+inline int reductionSize(const ReductionRequest &Req) {
+   if (!Req.LocalDD.empty())
+      return Req.LocalDD.size();
+   if (!Req.LocalR8.empty())
+      return Req.LocalR8.size();
+   return Req.LocalI8.size();
+}
+
+//////////
+// Start a global sum
+//////////
+// I4, I8, R4 or R8 scalar
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, int>
+globalSumStart(const T *Val, const MPI_Comm Comm, ReductionRequest &Req) {
+   setLocalValues(Req, Val, 1, std::is_same_v<T, R8>);
+   return startReduction(Req, MPI_SUM, Comm);
+}
+
+// Multi-field scalars
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, int>
+globalSumStart(const std::vector<T> &Vals, const MPI_Comm Comm,
+               ReductionRequest &Req) {
+   setLocalValues(Req, Vals.data(), Vals.size(), std::is_same_v<T, R8>);
+   return startReduction(Req, MPI_SUM, Comm);
+}
+
+// R8 array, with the local sum in double-double precision on the host or
+// device
+template <typename T, typename ML, typename MS>
+std::enable_if_t<std::is_same_v<R8, typename Kokkos::View<T>::value_type>, int>
+globalSumStart(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm,
+               ReductionRequest &Req,
+               const std::vector<I4> *IndxRange = nullptr) {
+   int dim = arr.rank;
+   int imin, imax;
+   if (IndxRange == nullptr) {
+      imin = 0;
+      imax = arr.size();
+   } else {
+      imin = (*IndxRange)[0];
+      imax = (*IndxRange)[dim * 2 - 1];
+   }
+   DDValue LocalTmp = localSumDD(arr, imin, imax);
+   Req.LocalR8.clear();
+   Req.LocalI8.clear();
+   Req.LocalDD.assign(1, complex<double>(LocalTmp.Hi, LocalTmp.Lo));
+   return startReduction(Req, MPI_SUM, Comm);
+}
+
+// Multi-field R8 arrays, reduced in a single MPI call
+template <typename T, typename ML, typename MS>
+std::enable_if_t<std::is_same_v<R8, typename Kokkos::View<T>::value_type>, int>
+globalSumStart(const std::vector<Kokkos::View<T, ML, MS>> &arrays,
+               const MPI_Comm Comm, ReductionRequest &Req,
+               const std::vector<I4> *IndxRange = nullptr) {
+   int dim = arrays[0].rank;
+   int imin, imax;
+   if (IndxRange == nullptr) {
+      imin = 0;
+      imax = arrays[0].size();
+   } else {
+      imin = (*IndxRange)[0];
+      imax = (*IndxRange)[dim * 2 - 1];
+   }
+   Req.LocalR8.clear();
+   Req.LocalI8.clear();
+   Req.LocalDD.clear();
+   for (const auto &arr : arrays) {
+      DDValue LocalTmp = localSumDD(arr, imin, imax);
+      Req.LocalDD.push_back(complex<double>(LocalTmp.Hi, LocalTmp.Lo));
+   }
+   return startReduction(Req, MPI_SUM, Comm);
+}
+
+// Weighted and masked R8 array over the first NOwned cells
+template <typename V, typename W, typename M>
+std::enable_if_t<Kokkos::is_view_v<V>, int>
+globalSumStart(const V &Arr, const W &Weight, const M &Mask,
+               const MPI_Comm Comm, ReductionRequest &Req, const I4 NOwned) {
+   DDValue LocalTmp = localWeightedSumDD(Arr, Weight, NoWeight(), Mask, NOwned);
+   Req.LocalR8.clear();
+   Req.LocalI8.clear();
+   Req.LocalDD.assign(1, complex<double>(LocalTmp.Hi, LocalTmp.Lo));
+   return startReduction(Req, MPI_SUM, Comm);
+}
+
+// Weighted and masked dot products of pairs of arrays over the first NOwned
+// cells, eg. the inner products of one iteration of a Krylov solver, reduced
+// together in a single MPI call. The results are returned in the order of
+// the pairs by the multi-field globalSumFinish.
+template <typename V, typename W, typename M>
+std::enable_if_t<Kokkos::is_view_v<V>, int>
+globalDotStart(const std::vector<std::pair<V, V>> &Pairs, const W &Weight,
+               const M &Mask, const MPI_Comm Comm, ReductionRequest &Req,
+               const I4 NOwned) {
+   Req.LocalR8.clear();
+   Req.LocalI8.clear();
+   Req.LocalDD.clear();
+   for (const auto &Pair : Pairs) {
+      DDValue LocalTmp =
+          localWeightedSumDD(Pair.first, Pair.second, Weight, Mask, NOwned);
+      Req.LocalDD.push_back(complex<double>(LocalTmp.Hi, LocalTmp.Lo));
+   }
+   return startReduction(Req, MPI_SUM, Comm);
+}
+
+//////////
+// Start a global min or max
+//////////
+// I4, I8, R4 or R8 scalar
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, int>
+globalMinStart(const T *Val, const MPI_Comm Comm, ReductionRequest &Req) {
+   setLocalValues(Req, Val, 1, false);
+   return startReduction(Req, MPI_MIN, Comm);
+}
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, int>
+globalMaxStart(const T *Val, const MPI_Comm Comm, ReductionRequest &Req) {
+   setLocalValues(Req, Val, 1, false);
+   return startReduction(Req, MPI_MAX, Comm);
+}
+
+// Weighted and masked array over the first NOwned cells
+template <typename V, typename W, typename M>
+std::enable_if_t<Kokkos::is_view_v<V>, int>
+globalMinValStart(const V &Arr, const W &Weight, const M &Mask,
+                  const MPI_Comm Comm, ReductionRequest &Req,
+                  const I4 NOwned) {
+   R8 LocalMinVal = localMaskedExtremum<false>(Arr, Weight, Mask, NOwned);
+   setLocalValues(Req, &LocalMinVal, 1, false);
+   return startReduction(Req, MPI_MIN, Comm);
+}
+
+template <typename V, typename W, typename M>
+std::enable_if_t<Kokkos::is_view_v<V>, int>
+globalMaxValStart(const V &Arr, const W &Weight, const M &Mask,
+                  const MPI_Comm Comm, ReductionRequest &Req,
+                  const I4 NOwned) {
+   R8 LocalMaxVal = localMaskedExtremum<true>(Arr, Weight, Mask, NOwned);
+   setLocalValues(Req, &LocalMaxVal, 1, false);
+   return startReduction(Req, MPI_MAX, Comm);
+}
+
+//////////
+// Finish a global sum, min or max
+//////////
+// Scalar result
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, int>
+globalSumFinish(ReductionRequest &Req, T *Res) {
+   return finishReduction(Req, Res, 1);
+}
+
+// Multi-field result
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, int>
+globalSumFinish(ReductionRequest &Req, std::vector<T> &Res) {
+   Res.resize(reductionSize(Req));
+   return finishReduction(Req, Res.data(), Res.size());
+}
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, int>
+globalMinFinish(ReductionRequest &Req, T *Res) {
+   return finishReduction(Req, Res, 1);
+}
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, int>
+globalMaxFinish(ReductionRequest &Req, T *Res) {
+   return finishReduction(Req, Res, 1);
+}
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,367 @@
+//===-- base/Snapshot.cpp - binary initialization snapshots -----*- C++ -*-===//
+//
+// The snapshot writer and reader store named host arrays in a per-task
+// binary file that is memory-mapped when read. The file starts with a
+// header (magic string, format version, number of records) followed by the
+// records. Each record holds its name, type, rank and dimensions followed by
+// its data, which is aligned to 8 bytes within the file. The first record
+// is always the configuration vector of the writer.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Snapshot.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "mpi.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OMEGA {
+
+namespace {
+
+// Header of a snapshot file
+const char SnapshotMagic[8] = {'O', 'M', 'E', 'G', 'A', 'S', 'N', 'P'};
+constexpr I4 SnapshotVersion = 1;
+constexpr size_t HeaderSize  = sizeof(SnapshotMagic) + 2 * sizeof(I4);
+
+// Name of the record holding the configuration of the writer
+const std::string ConfigName = "SnapshotConfig";
+
+// Size in bytes of one element of a snapshot type
+size_t snapshotTypeSize(SnapshotType Type) {
+   switch (Type) {
+   case SnapshotType::I4:
+      return sizeof(I4);
+   case SnapshotType::I8:
+      return sizeof(I8);
+   case SnapshotType::R4:
+      return sizeof(R4);
+   case SnapshotType::R8:
+      return sizeof(R8);
+   }
+   return 0;
+}
+
+// Round an offset up to the 8-byte alignment of record data
+size_t alignOffset(size_t Offset) { return (Offset + 7) / 8 * 8; }
+
+// Append the bytes of a value to a buffer
+template <typename T> void appendBytes(std::vector<char> &Buf, const T &Val) {
+   const char *Bytes = reinterpret_cast<const char *>(&Val);
+   Buf.insert(Buf.end(), Bytes, Bytes + sizeof(T));
+}
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Returns the snapshot file name for a component on the local task
+
+std::string snapshotFileName(const std::string &Prefix,    // [in] prefix
+                             const std::string &Component, // [in] component
+                             MPI_Comm Comm // [in] communicator of tasks
+) {
+
+   int NumTasks = 0;
+   int MyTask   = 0;
+   MPI_Comm_size(Comm, &NumTasks);
+   MPI_Comm_rank(Comm, &MyTask);
+
+   return Prefix + "." + Component + "." + std::to_string(NumTasks) + "." +
+          std::to_string(MyTask);
+
+} // end snapshotFileName
+
+//------------------------------------------------------------------------------
+// Construct a writer and add the configuration as the first record
+
+SnapshotWriter::SnapshotWriter(const std::string &InFileName,  // [in] file
+                               const std::vector<I4> &Config // [in] config
+) {
+
+   FileName = InFileName;
+   addVector(ConfigName, Config);
+
+} // end SnapshotWriter constructor
+
+//------------------------------------------------------------------------------
+// Add an integer vector as a 1-d record
+
+void SnapshotWriter::addVector(const std::string &Name,   // [in] record name
+                               const std::vector<I4> &Vec // [in] vector
+) {
+
+   std::vector<I8> Dims{static_cast<I8>(Vec.size())};
+   addRecord(Name, SnapshotType::I4, Dims, Vec.data(), Vec.size() * sizeof(I4));
+
+} // end addVector
+
+//------------------------------------------------------------------------------
+// Append a record with its name, type, dimensions and aligned data. Offsets
+// are aligned relative to the start of the file, which follows the header.
+
+void SnapshotWriter::addRecord(const std::string &Name, // [in] record name
+                               SnapshotType Type,       // [in] data type
+                               const std::vector<I8> &Dims, // [in] dims
+                               const void *InData,          // [in] data
+                               size_t NBytes // [in] size of data in bytes
+) {
+
+   appendBytes(Data, static_cast<I4>(Name.size()));
+   Data.insert(Data.end(), Name.begin(), Name.end());
+   appendBytes(Data, static_cast<I4>(Type));
+   appendBytes(Data, static_cast<I4>(Dims.size()));
+   for (I8 Dim : Dims)
+      appendBytes(Data, Dim);
+
+   Data.resize(alignOffset(HeaderSize + Data.size()) - HeaderSize, 0);
+   const char *Bytes = static_cast<const char *>(InData);
+   Data.insert(Data.end(), Bytes, Bytes + NBytes);
+
+   ++NRecords;
+
+} // end addRecord
+
+//------------------------------------------------------------------------------
+// Write the header and all records to the snapshot file
+
+int SnapshotWriter::write() {
+
+   std::string TmpName = FileName + ".tmp";
+   std::ofstream File(TmpName, std::ios::binary | std::ios::trunc);
+   if (!File) {
+      LOG_WARN("Snapshot: unable to open {} for writing", TmpName);
+      return 1;
+   }
+
+   File.write(SnapshotMagic, sizeof(SnapshotMagic));
+   File.write(reinterpret_cast<const char *>(&SnapshotVersion), sizeof(I4));
+   File.write(reinterpret_cast<const char *>(&NRecords), sizeof(I4));
+   File.write(Data.data(), Data.size());
+   File.close();
+   if (!File) {
+      LOG_WARN("Snapshot: error writing {}", TmpName);
+      std::remove(TmpName.c_str());
+      return 1;
+   }
+
+   if (std::rename(TmpName.c_str(), FileName.c_str()) != 0) {
+      LOG_WARN("Snapshot: unable to rename {} to {}", TmpName, FileName);
+      std::remove(TmpName.c_str());
+      return 1;
+   }
+
+   return 0;
+
+} // end write
+
+//------------------------------------------------------------------------------
+// Unmap the file when the reader is destroyed
+
+SnapshotReader::~SnapshotReader() { close(); }
+
+//------------------------------------------------------------------------------
+// Map the snapshot file into memory and check the configuration on all tasks
+
+int SnapshotReader::open(const std::string &InFileName,  // [in] file
+                         const std::vector<I4> &Config, // [in] configuration
+                         MPI_Comm Comm // [in] communicator of tasks
+) {
+
+   close();
+   FileName = InFileName;
+
+   I4 LocErr = 0;
+   int FD    = ::open(FileName.c_str(), O_RDONLY);
+   if (FD < 0) {
+      LocErr = 1;
+   } else {
+      struct stat FileStat;
+      if (fstat(FD, &FileStat) != 0 or
+          static_cast<size_t>(FileStat.st_size) < HeaderSize) {
+         LocErr = 2;
+      } else {
+         MapSize = FileStat.st_size;
+         MapAddr = mmap(nullptr, MapSize, PROT_READ, MAP_PRIVATE, FD, 0);
+         if (MapAddr == MAP_FAILED) {
+            MapAddr = nullptr;
+            LocErr  = 2;
+         }
+      }
+      ::close(FD);
+   }
+
+   if (LocErr == 0 and parse() != 0)
+      LocErr = 2;
+
+   if (LocErr == 0) {
+      std::vector<I4> FileConfig;
+      if (getVector(ConfigName, FileConfig) != 0 or FileConfig != Config)
+         LocErr = 3;
+   }
+
+   // All tasks must agree to use their snapshots
+   I4 Err = 0;
+   MPI_Allreduce(&LocErr, &Err, 1, MPI_INT32_T, MPI_MAX, Comm);
+
+   if (Err == 1) {
+      LOG_INFO("Snapshot: no snapshot {} on all tasks", FileName);
+   } else if (Err == 2) {
+      LOG_WARN("Snapshot: snapshot {} is unreadable on some tasks", FileName);
+   } else if (Err == 3) {
+      LOG_WARN("Snapshot: snapshot {} does not match the configuration",
+               FileName);
+   }
+   if (Err != 0)
+      close();
+
+   return Err;
+
+} // end open
+
+//------------------------------------------------------------------------------
+// Unmap the file and remove the record index
+
+void SnapshotReader::close() {
+
+   if (MapAddr != nullptr)
+      munmap(MapAddr, MapSize);
+   MapAddr = nullptr;
+   MapSize = 0;
+   Records.clear();
+
+} // end close
+
+//------------------------------------------------------------------------------
+// Build the record index from the mapped file, checking that every record
+// lies within the file
+
+int SnapshotReader::parse() {
+
+   const char *Base = static_cast<const char *>(MapAddr);
+   if (std::memcmp(Base, SnapshotMagic, sizeof(SnapshotMagic)) != 0)
+      return 1;
+
+   I4 Version;
+   I4 NRecords;
+   size_t Offset = sizeof(SnapshotMagic);
+   std::memcpy(&Version, Base + Offset, sizeof(I4));
+   Offset += sizeof(I4);
+   std::memcpy(&NRecords, Base + Offset, sizeof(I4));
+   Offset += sizeof(I4);
+   if (Version != SnapshotVersion or NRecords < 0)
+      return 1;
+
+   // Read a value at the current offset, failing if past the end of file
+   auto readI4 = [&](I4 &Val) {
+      if (Offset + sizeof(I4) > MapSize)
+         return false;
+      std::memcpy(&Val, Base + Offset, sizeof(I4));
+      Offset += sizeof(I4);
+      return true;
+   };
+
+   for (int IRec = 0; IRec < NRecords; ++IRec) {
+      I4 NameLen;
+      if (not readI4(NameLen) or NameLen < 0 or Offset + NameLen > MapSize)
+         return 1;
+      std::string Name(Base + Offset, NameLen);
+      Offset += NameLen;
+
+      I4 Type;
+      I4 Rank;
+      if (not readI4(Type) or not readI4(Rank) or Rank < 0)
+         return 1;
+
+      Record Rec;
+      Rec.Type      = static_cast<SnapshotType>(Type);
+      size_t NElems = 1;
+      for (int Dim = 0; Dim < Rank; ++Dim) {
+         I8 Len;
+         if (Offset + sizeof(I8) > MapSize)
+            return 1;
+         std::memcpy(&Len, Base + Offset, sizeof(I8));
+         Offset += sizeof(I8);
+         if (Len < 0)
+            return 1;
+         Rec.Dims.push_back(Len);
+         NElems *= Len;
+      }
+
+      Offset     = alignOffset(Offset);
+      Rec.NBytes = NElems * snapshotTypeSize(Rec.Type);
+      if (Rec.NBytes == 0 and NElems > 0)
+         return 1;
+      if (Offset + Rec.NBytes > MapSize)
+         return 1;
+      Rec.Data = Base + Offset;
+      Offset += Rec.NBytes;
+
+      Records[Name] = Rec;
+   }
+
+   return 0;
+
+} // end parse
+
+//------------------------------------------------------------------------------
+// Returns true if the snapshot contains a record of the given name
+
+bool SnapshotReader::has(const std::string &Name) const {
+   return Records.find(Name) != Records.end();
+}
+
+//------------------------------------------------------------------------------
+// Find a record and check its type and rank
+
+const SnapshotReader::Record *
+SnapshotReader::findRecord(const std::string &Name, // [in] record name
+                           SnapshotType Type,       // [in] expected type
+                           int Rank                 // [in] expected rank
+) const {
+
+   auto It = Records.find(Name);
+   if (It == Records.end()) {
+      LOG_ERROR("Snapshot: record {} not found in {}", Name, FileName);
+      return nullptr;
+   }
+   if (It->second.Type != Type or It->second.Dims.size() != Rank) {
+      LOG_ERROR("Snapshot: record {} in {} has the wrong type or rank", Name,
+                FileName);
+      return nullptr;
+   }
+
+   return &It->second;
+
+} // end findRecord
+
+//------------------------------------------------------------------------------
+// Copy an integer vector record from the mapped file
+
+int SnapshotReader::getVector(const std::string &Name, // [in] record name
+                              std::vector<I4> &Vec     // [out] vector
+) const {
+
+   const Record *Rec = findRecord(Name, SnapshotType::I4, 1);
+   if (Rec == nullptr)
+      return 1;
+
+   Vec.resize(Rec->Dims[0]);
+   std::memcpy(Vec.data(), Rec->Data, Rec->NBytes);
+
+   return 0;
+
+} // end getVector
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,205 @@
+#ifndef OMEGA_SNAPSHOT_H
+#define OMEGA_SNAPSHOT_H
+//===-- base/Snapshot.h - binary initialization snapshots -------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines per-task binary snapshots of initialized model state
+///
+/// A snapshot is a binary file written by a single MPI task that stores a
+/// set of named host arrays and integer vectors, eg the local arrays of a
+/// fully initialized decomposition. A later run with the same task count
+/// can map the file into memory and restore the arrays directly, skipping
+/// the mesh reads, partitioning and other setup needed to compute them.
+/// Each snapshot stores a configuration vector given by the writer (task
+/// count, halo width, etc). A snapshot is only reused if the configuration
+/// matches on every task, so that all tasks either reuse their snapshots or
+/// recompute their state together.
+///
+/// Snapshots are an unportable cache: they use the native byte order and
+/// type sizes and should be removed if the mesh or the code changes.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "mpi.h"
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Supported types of snapshot records
+enum class SnapshotType { I4, I8, R4, R8 };
+
+/// Returns the snapshot record type for a supported data type
+template <typename T> constexpr SnapshotType snapshotTypeOf();
+template <> constexpr SnapshotType snapshotTypeOf<I4>() {
+   return SnapshotType::I4;
+}
+template <> constexpr SnapshotType snapshotTypeOf<I8>() {
+   return SnapshotType::I8;
+}
+template <> constexpr SnapshotType snapshotTypeOf<R4>() {
+   return SnapshotType::R4;
+}
+template <> constexpr SnapshotType snapshotTypeOf<R8>() {
+   return SnapshotType::R8;
+}
+
+/// Returns the name of the snapshot file for a component of the snapshot
+/// Prefix on the local task of Comm. The name includes the task count so
+/// that snapshots for different task counts can coexist.
+std::string snapshotFileName(const std::string &Prefix,    ///< [in] prefix
+                             const std::string &Component, ///< [in] component
+                             MPI_Comm Comm ///< [in] communicator of tasks
+);
+
+/// Returns a hash of the contents of a host array, used to check that a
+/// snapshot was written for the same decomposition
+template <typename T> I4 snapshotHash(const T &Array) {
+   // 32-bit FNV-1a hash of the bytes of the array
+   unsigned int Hash = 2166136261u;
+   const unsigned char *Bytes =
+       reinterpret_cast<const unsigned char *>(Array.data());
+   size_t NBytes = Array.size() * sizeof(typename T::value_type);
+   for (size_t I = 0; I < NBytes; ++I) {
+      Hash ^= Bytes[I];
+      Hash *= 16777619u;
+   }
+   I4 Result;
+   std::memcpy(&Result, &Hash, sizeof(Result));
+   return Result;
+}
+
+/// The SnapshotWriter collects the records of a snapshot and writes them
+/// to the snapshot file of the local task.
+class SnapshotWriter {
+
+ public:
+   /// Construct a writer for the file FileName with the configuration
+   /// Config that a reader must match to reuse the snapshot
+   SnapshotWriter(const std::string &FileName,  ///< [in] snapshot file
+                  const std::vector<I4> &Config ///< [in] configuration
+   );
+
+   /// Add an integer vector to the snapshot
+   void addVector(const std::string &Name,   ///< [in] record name
+                  const std::vector<I4> &Vec ///< [in] vector to add
+   );
+
+   /// Add a contiguous 1-d or 2-d host array of a supported type to the
+   /// snapshot. Unallocated arrays are not added.
+   template <typename T>
+   void addArray(const std::string &Name, ///< [in] record name
+                 const T &Array           ///< [in] host array to add
+   ) {
+      if (Array.size() == 0)
+         return;
+      std::vector<I8> Dims;
+      for (int Dim = 0; Dim < T::rank; ++Dim)
+         Dims.push_back(Array.extent(Dim));
+      addRecord(Name, snapshotTypeOf<typename T::non_const_value_type>(),
+                Dims, Array.data(),
+                Array.size() * sizeof(typename T::value_type));
+   }
+
+   /// Write all records to the snapshot file. The file is written under a
+   /// temporary name and renamed when complete, so that an interrupted
+   /// write never leaves a partial snapshot. Returns an error code.
+   int write();
+
+ private:
+   /// Append a record to the snapshot buffer
+   void addRecord(const std::string &Name, SnapshotType Type,
+                  const std::vector<I8> &Dims, const void *Data,
+                  size_t NBytes);
+
+   std::string FileName;    ///< name of the snapshot file
+   std::vector<char> Data;  ///< serialized records
+   I4 NRecords{0};          ///< number of records in Data
+}; // end class SnapshotWriter
+
+/// The SnapshotReader maps the snapshot file of the local task into memory
+/// and restores its records.
+class SnapshotReader {
+
+ public:
+   SnapshotReader() = default;
+
+   /// Unmaps the snapshot file
+   ~SnapshotReader();
+
+   SnapshotReader(const SnapshotReader &)            = delete;
+   SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+   /// Map the snapshot file FileName into memory and check its
+   /// configuration against Config on all tasks of Comm. Returns zero only
+   /// if the snapshots of all tasks exist and match, otherwise the file is
+   /// unmapped and a non-zero code is returned on all tasks.
+   int open(const std::string &FileName,   ///< [in] snapshot file
+            const std::vector<I4> &Config, ///< [in] expected configuration
+            MPI_Comm Comm                  ///< [in] communicator of tasks
+   );
+
+   /// Unmap the snapshot file
+   void close();
+
+   /// Returns true if a snapshot is mapped
+   bool isOpen() const { return MapAddr != nullptr; }
+
+   /// Returns true if the snapshot contains a record Name
+   bool has(const std::string &Name) const;
+
+   /// Restore an integer vector. Returns an error code.
+   int getVector(const std::string &Name, ///< [in] record name
+                 std::vector<I4> &Vec     ///< [out] restored vector
+   ) const;
+
+   /// Allocate a host array with the dimensions of the record Name and
+   /// copy the record from the mapped file. Returns an error code.
+   template <typename T>
+   int getArray(const std::string &Name, ///< [in] record name
+                T &Array                 ///< [out] restored host array
+   ) const {
+      const Record *Rec =
+          findRecord(Name, snapshotTypeOf<typename T::value_type>(), T::rank);
+      if (Rec == nullptr)
+         return 1;
+      if constexpr (T::rank == 1) {
+         Array = T(Name, Rec->Dims[0]);
+      } else {
+         Array = T(Name, Rec->Dims[0], Rec->Dims[1]);
+      }
+      std::memcpy(Array.data(), Rec->Data, Rec->NBytes);
+      return 0;
+   }
+
+ private:
+   /// Location and shape of a record in the mapped file
+   struct Record {
+      SnapshotType Type;
+      std::vector<I8> Dims;
+      const char *Data;
+      size_t NBytes;
+   };
+
+   /// Parse the record index of the mapped file. Returns an error code.
+   int parse();
+
+   /// Returns the record Name if it has the given type and rank, otherwise
+   /// logs an error and returns a null pointer
+   const Record *findRecord(const std::string &Name, SnapshotType Type,
+                            int Rank) const;
+
+   std::string FileName;                  ///< name of the mapped file
+   void *MapAddr{nullptr};                ///< address of the mapped file
+   size_t MapSize{0};                     ///< size of the mapped file
+   std::map<std::string, Record> Records; ///< records by name
+}; // end class SnapshotReader
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_SNAPSHOT_H
@@ -0,0 +1,335 @@
+//===-- drivers/OceanCoupler.cpp - coupler interface ------------*- C++ -*-===//
+//
+// The field lists of the driver are resolved once into tables of raw
+// pointers and strides, so each exchange is one kernel over the owned cells
+// and the fields of the list, whatever the number, rank or layout of the
+// arrays. The export table is refreshed from the sources before each export
+// since the state arrays are swapped between time levels. The staging arrays
+// are only allocated when the arrays of Omega are not accessible from the
+// host; otherwise the kernels use the buffer of the driver in place.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OceanCoupler.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+
+#include <sstream>
+
+namespace OMEGA {
+
+namespace {
+
+// Buffers of the driver viewed with the layout of the attribute vectors
+using BufferView = Kokkos::View<R8 **, Kokkos::LayoutRight, HostMemSpace,
+                                Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+using ConstBufferView =
+    Kokkos::View<const R8 **, Kokkos::LayoutRight, HostMemSpace,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+// True when the arrays of Omega can be read by the host, so the kernels may
+// use the buffer of the driver directly
+constexpr bool DirectAccess =
+    Kokkos::SpaceAccessibility<HostExecSpace, MemSpace>::accessible;
+
+// Splits a colon-separated list, ignoring empty names
+std::vector<std::string> splitList(const std::string &List) {
+   std::vector<std::string> Names;
+   std::istringstream Stream(List);
+   std::string Name;
+   while (std::getline(Stream, Name, ':'))
+      if (!Name.empty())
+         Names.push_back(Name);
+   return Names;
+}
+
+// Gathers the fields of the table into the columns of Dest. Fields without
+// data and surface fields of land cells are exported as zero.
+template <typename V>
+void gatherFields(const V &Dest,
+                  const Kokkos::View<CouplerField *, MemSpace> &Table,
+                  const HorzMesh *Mesh, I4 NCells) {
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+   const I4 NFields = Table.extent_int(0);
+
+   parallelFor(
+       "OceanCoupler:gather", {NCells, NFields},
+       KOKKOS_LAMBDA(int ICell, int IField) {
+          const CouplerField Field = Table(IField);
+          R8 Value                 = 0;
+          if (Field.Data != nullptr) {
+             if (Field.Surface == 0) {
+                Value = Field.Data[ICell * Field.CellStride];
+             } else if (MaxLevelCell(ICell) >= MinLevelCell(ICell)) {
+                Value = Field.Data[ICell * Field.CellStride +
+                                   MinLevelCell(ICell) * Field.LevelStride];
+             }
+          }
+          Dest(ICell, IField) = Value;
+       });
+}
+
+// Scatters the columns of Src into the fields of the table
+template <typename V>
+void scatterFields(const V &Src,
+                   const Kokkos::View<CouplerField *, MemSpace> &Table,
+                   I4 NCells) {
+   const I4 NFields = Table.extent_int(0);
+
+   parallelFor(
+       "OceanCoupler:scatter", {NCells, NFields},
+       KOKKOS_LAMBDA(int ICell, int IField) {
+          const CouplerField Field = Table(IField);
+          if (Field.Data != nullptr)
+             Field.Data[ICell * Field.CellStride] = Src(ICell, IField);
+       });
+}
+
+} // end anonymous namespace
+
+std::unique_ptr<OceanCoupler> OceanCoupler::DefaultCoupler;
+
+//------------------------------------------------------------------------------
+// Constructs a coupler for the owned cells of a mesh
+
+OceanCoupler::OceanCoupler(HorzMesh *Mesh, const Decomp *MeshDecomp,
+                           Halo *MeshHalo)
+    : Mesh(Mesh), Dcmp(MeshDecomp), MeshHalo(MeshHalo),
+      NCellsOwned(Mesh->NCellsOwned) {}
+
+//------------------------------------------------------------------------------
+// Registers an exported field given by its source
+
+int OceanCoupler::addExportSource(const std::string &Name, Source Src) {
+
+   if (ListsSet) {
+      LOG_ERROR("OceanCoupler: export {} added after the field lists", Name);
+      return 1;
+   }
+   for (const auto &Export : Exports) {
+      if (Export.first == Name) {
+         LOG_ERROR("OceanCoupler: export {} already exists", Name);
+         return 1;
+      }
+   }
+   Exports.emplace_back(Name, std::move(Src));
+
+   return 0;
+
+} // end addExportSource
+
+//------------------------------------------------------------------------------
+// Registers a field exported from a cell array without levels
+
+int OceanCoupler::addExport(const std::string &Name,
+                            const Array1DReal &Array) {
+
+   return addExportSource(Name, [Array]() {
+      return CouplerField{Array.data(), static_cast<I8>(Array.stride(0)), 0,
+                          0};
+   });
+
+} // end addExport
+
+//------------------------------------------------------------------------------
+// Registers a field imported into a cell array without levels
+
+int OceanCoupler::addImport(const std::string &Name,
+                            const Array1DReal &Array) {
+
+   if (ListsSet) {
+      LOG_ERROR("OceanCoupler: import {} added after the field lists", Name);
+      return 1;
+   }
+   for (const auto &Import : Imports) {
+      if (Import.first == Name) {
+         LOG_ERROR("OceanCoupler: import {} already exists", Name);
+         return 1;
+      }
+   }
+   Imports.emplace_back(Name, Array);
+
+   return 0;
+
+} // end addImport
+
+//------------------------------------------------------------------------------
+// Sets the order of the fields in the buffers from the lists of the driver
+
+int OceanCoupler::setFieldLists(const std::string &ExportList,
+                                const std::string &ImportList) {
+
+   ExportNames = splitList(ExportList);
+   ImportNames = splitList(ImportList);
+
+   const I4 NExport = ExportNames.size();
+   const I4 NImport = ImportNames.size();
+
+   // Export columns keep their source, which is resolved at every export
+   ExportSources.assign(NExport, Source());
+   for (int I = 0; I < NExport; ++I) {
+      for (const auto &Export : Exports)
+         if (Export.first == ExportNames[I])
+            ExportSources[I] = Export.second;
+      if (!ExportSources[I])
+         LOG_INFO("OceanCoupler: export {} not provided, sent as zero",
+                  ExportNames[I]);
+   }
+
+   // Imported arrays do not change, so their table is filled once
+   ImportDest.clear();
+   auto ImportTableH =
+       Kokkos::View<CouplerField *, HostMemSpace>("ImportTableH", NImport);
+   for (int I = 0; I < NImport; ++I) {
+      ImportTableH(I) = CouplerField();
+      for (const auto &Import : Imports) {
+         if (Import.first == ImportNames[I]) {
+            const Array1DReal &Array = Import.second;
+            ImportTableH(I) = CouplerField{
+                Array.data(), static_cast<I8>(Array.stride(0)), 0, 0};
+            ImportDest.push_back(Array);
+         }
+      }
+      if (ImportTableH(I).Data == nullptr)
+         LOG_INFO("OceanCoupler: import {} not used", ImportNames[I]);
+   }
+
+   using TableView = Kokkos::View<CouplerField *, MemSpace>;
+   ExportTable     = TableView("ExportTable", NExport);
+   ImportTable     = TableView("ImportTable", NImport);
+   ExportTableH    = Kokkos::create_mirror_view(HostMemSpace(), ExportTable);
+   Kokkos::deep_copy(ImportTable, ImportTableH);
+
+   if constexpr (!DirectAccess) {
+      ExportStaging = Kokkos::View<R8 **, Kokkos::LayoutRight, MemSpace>(
+          "ExportStaging", NCellsOwned, NExport);
+      ImportStaging = Kokkos::View<R8 **, Kokkos::LayoutRight, MemSpace>(
+          "ImportStaging", NCellsOwned, NImport);
+   }
+
+   ListsSet = true;
+
+   return 0;
+
+} // end setFieldLists
+
+//------------------------------------------------------------------------------
+// Fills the export table from the sources
+
+void OceanCoupler::updateExportTable() {
+
+   for (int I = 0; I < ExportSources.size(); ++I)
+      ExportTableH(I) = ExportSources[I] ? ExportSources[I]() : CouplerField();
+   Kokkos::deep_copy(ExportTable, ExportTableH);
+
+} // end updateExportTable
+
+//------------------------------------------------------------------------------
+// Gathers all exported fields into the buffer of the driver
+
+int OceanCoupler::exportFields(R8 *Buffer) {
+
+   if (!ListsSet) {
+      LOG_ERROR("OceanCoupler: export before the field lists are set");
+      return 1;
+   }
+
+   updateExportTable();
+
+   BufferView Dest(Buffer, NCellsOwned, ExportNames.size());
+   if constexpr (DirectAccess) {
+      gatherFields(Dest, ExportTable, Mesh, NCellsOwned);
+   } else {
+      gatherFields(ExportStaging, ExportTable, Mesh, NCellsOwned);
+      Kokkos::deep_copy(Dest, ExportStaging);
+   }
+   Kokkos::fence();
+
+   return 0;
+
+} // end exportFields
+
+//------------------------------------------------------------------------------
+// Scatters all imported fields from the buffer of the driver
+
+int OceanCoupler::importFields(const R8 *Buffer) {
+
+   if (!ListsSet) {
+      LOG_ERROR("OceanCoupler: import before the field lists are set");
+      return 1;
+   }
+
+   ConstBufferView Src(Buffer, NCellsOwned, ImportNames.size());
+   if constexpr (DirectAccess) {
+      scatterFields(Src, ImportTable, NCellsOwned);
+   } else {
+      Kokkos::deep_copy(ImportStaging, Src);
+      scatterFields(ImportStaging, ImportTable, NCellsOwned);
+   }
+
+   if (ImportDest.empty())
+      return 0;
+
+   HaloGroup Group("OceanCouplerImport");
+   for (auto &Array : ImportDest)
+      Group.add(Array, OnCell);
+   int Err = MeshHalo->exchangeGroup(Group);
+   if (Err != 0)
+      LOG_ERROR("OceanCoupler: error exchanging imported fields");
+
+   return Err;
+
+} // end importFields
+
+//------------------------------------------------------------------------------
+// Global indices of the owned cells
+
+std::vector<I4> OceanCoupler::getGlobalIndices() const {
+
+   const HostArray1DI4 CellIDH = Dcmp->getHost(Dcmp->CellIDH);
+   std::vector<I4> Indices(NCellsOwned);
+   for (int ICell = 0; ICell < NCellsOwned; ++ICell)
+      Indices[ICell] = CellIDH(ICell);
+
+   return Indices;
+
+} // end getGlobalIndices
+
+//------------------------------------------------------------------------------
+// Creates the default coupler
+
+int OceanCoupler::init() {
+
+   HorzMesh *DefMesh = HorzMesh::getDefault();
+   Decomp *DefDecomp = Decomp::getDefault();
+   Halo *DefHalo     = Halo::getDefault();
+   if (DefMesh == nullptr || DefDecomp == nullptr || DefHalo == nullptr) {
+      LOG_ERROR("OceanCoupler: default mesh, decomp and halo required");
+      return 1;
+   }
+
+   DefaultCoupler =
+       std::make_unique<OceanCoupler>(DefMesh, DefDecomp, DefHalo);
+
+   return 0;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Returns the default coupler
+
+OceanCoupler *OceanCoupler::getDefault() { return DefaultCoupler.get(); }
+
+//------------------------------------------------------------------------------
+// Removes the default coupler
+
+void OceanCoupler::clear() { DefaultCoupler.reset(); }
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
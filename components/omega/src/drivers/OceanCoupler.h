@@ -0,0 +1,169 @@
+#ifndef OMEGA_OCEAN_COUPLER_H
+#define OMEGA_OCEAN_COUPLER_H
+//===-- drivers/OceanCoupler.h - coupler interface --------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the interface between Omega and the E3SM coupler
+///
+/// The OceanCoupler class exchanges surface fields with the MCT and MOAB
+/// drivers of E3SM. The component caps of the drivers hold the fields of
+/// each direction in one contiguous attribute vector with the fields of a
+/// cell next to each other, in the order of a colon-separated field list,
+/// such as "So_t:So_s:So_ssh". The coupler maps each field of the lists to
+/// a registered Omega array once, so an export is a single kernel that
+/// gathers every field from the device state into a staging array with
+/// the layout of the attribute vector, followed by one copy to the caller's
+/// buffer. An import is the reverse, with one halo exchange for all
+/// imported fields. When Omega arrays are in host memory, the kernels read
+/// and write the caller's buffer directly and no copy is made at all.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Location of the value of a field in an Omega array, which is read or
+/// written by the exchange kernels through a raw pointer and strides so
+/// that arrays of any rank, layout or subview are gathered by one kernel
+struct CouplerField {
+   Real *Data     = nullptr; ///< first element, or nullptr for no field
+   I8 CellStride  = 0;       ///< distance between cells
+   I8 LevelStride = 0;       ///< distance between levels
+   I4 Surface     = 0;       ///< 1 to use the top active level of a cell
+};
+
+/// Interface of the ocean to the E3SM coupler
+class OceanCoupler {
+ public:
+   /// Source of an exported field, called at every export so that arrays
+   /// that change with the time level of the state are always current
+   using Source = std::function<CouplerField()>;
+
+   /// Constructs a coupler for the owned cells of a mesh. Imported fields
+   /// are exchanged with the halo MeshHalo.
+   OceanCoupler(HorzMesh *Mesh,           ///< [in] mesh
+                const Decomp *MeshDecomp, ///< [in] decomposition of mesh
+                Halo *MeshHalo            ///< [in] halo of the mesh
+   );
+
+   /// Registers a field exported from the top active level of a cell array
+   /// with levels, eg. the sea surface temperature from a subview of the
+   /// tracer array. SurfaceOf is called at every export and returns the
+   /// current 2-d array. Returns an error code.
+   template <typename F>
+   int addSurfaceExport(const std::string &Name, ///< [in] coupler field name
+                        F SurfaceOf              ///< [in] current 2-d array
+   ) {
+      return addExportSource(Name, [SurfaceOf]() {
+         auto Array = SurfaceOf();
+         static_assert(decltype(Array)::rank == 2,
+                       "Surface exports require 2-d cell arrays");
+         return CouplerField{Array.data(), static_cast<I8>(Array.stride(0)),
+                             static_cast<I8>(Array.stride(1)), 1};
+      });
+   }
+
+   /// Registers a field exported from a cell array without levels
+   int addExport(const std::string &Name, ///< [in] coupler field name
+                 const Array1DReal &Array ///< [in] cell array
+   );
+
+   /// Registers a field imported into a cell array without levels, eg. a
+   /// surface flux. Imported arrays are valid in the halo after an import.
+   int addImport(const std::string &Name, ///< [in] coupler field name
+                 const Array1DReal &Array ///< [in] cell array
+   );
+
+   /// Sets the order of the fields in the attribute vectors of the driver
+   /// from their colon-separated lists. Fields in a list that are not
+   /// registered are exported as zero and ignored on import. Registered
+   /// fields that are not in a list are not exchanged. Returns an error
+   /// code.
+   int setFieldLists(const std::string &ExportList, ///< [in] exported list
+                     const std::string &ImportList  ///< [in] imported list
+   );
+
+   /// Gathers all exported fields into Buffer, which holds the fields of
+   /// the owned cells in the order of the export list, the fields of each
+   /// cell being contiguous. Returns an error code.
+   int exportFields(R8 *Buffer ///< [out] NExport * NCellsOwned values
+   );
+
+   /// Scatters all imported fields from Buffer, laid out as for the export,
+   /// and exchanges their halos. Returns an error code.
+   int importFields(const R8 *Buffer ///< [in] NImport * NCellsOwned values
+   );
+
+   /// Global indices (1-based) of the owned cells, in the order of the
+   /// cells in the buffers, for the global segment map of the driver
+   std::vector<I4> getGlobalIndices() const;
+
+   /// Number of cells in the buffers
+   I4 getNumCells() const { return NCellsOwned; }
+
+   /// Number of fields in the export list
+   I4 getNumExport() const { return ExportNames.size(); }
+
+   /// Number of fields in the import list
+   I4 getNumImport() const { return ImportNames.size(); }
+
+   /// Registers the default coupler on the default mesh, decomposition and
+   /// halo. Returns an error code.
+   static int init();
+
+   /// Returns the default coupler, or nullptr before init
+   static OceanCoupler *getDefault();
+
+   /// Removes the default coupler
+   static void clear();
+
+ private:
+   /// Registers an exported field given by a function returning its
+   /// location. Returns an error code.
+   int addExportSource(const std::string &Name, Source Src);
+
+   /// Fills the table of the exported fields from their sources and copies
+   /// it to the device
+   void updateExportTable();
+
+   HorzMesh *Mesh;       ///< mesh
+   const Decomp *Dcmp;   ///< decomposition of the mesh
+   Halo *MeshHalo;       ///< halo of the mesh
+   I4 NCellsOwned;       ///< cells in the buffers
+   bool ListsSet{false}; ///< true once the field lists are set
+
+   std::vector<std::string> ExportNames; ///< export list of the driver
+   std::vector<std::string> ImportNames; ///< import list of the driver
+
+   std::vector<std::pair<std::string, Source>> Exports;      ///< registered
+   std::vector<std::pair<std::string, Array1DReal>> Imports; ///< registered
+
+   std::vector<Source> ExportSources;   ///< source of each export column
+   std::vector<Array1DReal> ImportDest; ///< arrays of imported columns
+
+   Kokkos::View<CouplerField *, MemSpace> ExportTable; ///< export columns
+   Kokkos::View<CouplerField *, MemSpace> ImportTable; ///< import columns
+   Kokkos::View<CouplerField *, HostMemSpace>
+       ExportTableH; ///< host copy of the export columns
+
+   /// Staging arrays with the layout of the attribute vectors
+   Kokkos::View<R8 **, Kokkos::LayoutRight, MemSpace> ExportStaging;
+   Kokkos::View<R8 **, Kokkos::LayoutRight, MemSpace> ImportStaging;
+
+   static std::unique_ptr<OceanCoupler> DefaultCoupler;
+
+}; // end class OceanCoupler
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_OCEAN_COUPLER_H
@@ -19,6 +19,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 namespace OMEGA {
@@ -76,11 +77,13 @@ Config::Config() {} // end Config constructor
 // Reads the full configuration for omega and stores in it a static
 // YAML node for later use.  The file must be in YAML format and must be in
 // the same directory as the executable, though Unix soft links can be used
-// to point to a file in an alternate location.  The full configuration is
-// only read by the master task.  The accessor functions (get/set) will
-// broadcast or communicate the data as needed to/from other MPI tasks.
+// to point to a file in an alternate location.  In the default broadcast
+// mode, only the master task touches the file system. It broadcasts the
+// file text and all tasks parse the text from memory. In the grouped mode,
+// every task reads the file itself, one group of tasks at a time.
 
-int Config::readAll(const std::string ConfigFile // [in] input YAML config file
+int Config::readAll(const std::string ConfigFile, // [in] input YAML config file
+                    ReadMode Mode                 // [in] read mode
 ) {
    int Err = 0;
 
@@ -88,16 +91,69 @@ int Config::readAll(const std::string ConfigFile // [in] input YAML config file
    // top-level omega node from the Root.
    ConfigAll.Name = "omega";
 
-   for (int ReadGroup = 0; ReadGroup < Config::NumReadGroups; ++ReadGroup) {
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+
+   if (Mode == ReadGrouped) {
+
+      // Assign tasks to read groups in a round-robin way. This is done here
+      // as well as in the constructor since readAll may be called before
+      // any Config has been constructed.
+      I4 NumTasks   = DefEnv->getNumTasks();
+      NumReadGroups = (NumTasks - 1) / ReadGroupSize + 1;
+      ReadGroupID   = DefEnv->getMyTask() % NumReadGroups;
+
+      for (int ReadGroup = 0; ReadGroup < NumReadGroups; ++ReadGroup) {
+
+         // If it is this tasks turn, read the configuration file
+         if (ReadGroupID == ReadGroup) {
+            // Read temporary root node
+            YAML::Node RootNode = YAML::LoadFile(ConfigFile);
+            // Extract Omega node
+            ConfigAll.Node = RootNode["omega"];
+         }
+         MPI_Barrier(DefEnv->getComm());
+      }
+
+      return Err;
+   }
 
-      // If it is this tasks turn, read the configuration file
-      if (Config::ReadGroupID == ReadGroup) {
-         // Read temporary root node
-         YAML::Node RootNode = YAML::LoadFile(ConfigFile);
-         // Extract Omega node
-         ConfigAll.Node = RootNode["omega"];
+   // Master task reads the full file text
+   std::string ConfigText;
+   I4 ReadErr = 0;
+   if (DefEnv->isMasterTask()) {
+      std::ifstream ConfigStream(ConfigFile);
+      if (ConfigStream) {
+         std::stringstream Buffer;
+         Buffer << ConfigStream.rdbuf();
+         ConfigText = Buffer.str();
+      } else {
+         ReadErr = 1;
       }
-      MPI_Barrier(ConfigComm);
+   }
+
+   // Make sure all tasks know whether the read succeeded before sending
+   // the text
+   Err = Broadcast(ReadErr, DefEnv);
+   if (Err != 0 || ReadErr != 0) {
+      LOG_ERROR("Config::readAll: unable to read config file {}", ConfigFile);
+      return 1;
+   }
+
+   Err = Broadcast(ConfigText, DefEnv);
+   if (Err != 0) {
+      LOG_ERROR("Config::readAll: error broadcasting config file {}",
+                ConfigFile);
+      return Err;
+   }
+
+   // Parse the text into a temporary root node and extract the Omega node
+   try {
+      YAML::Node RootNode = YAML::Load(ConfigText);
+      ConfigAll.Node      = RootNode["omega"];
+   } catch (const YAML::Exception &Ex) {
+      LOG_ERROR("Config::readAll: error parsing config file {}: {}",
+                ConfigFile, Ex.what());
+      return 1;
    }
 
    return Err;
@@ -14,10 +14,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "DataTypes.h"
+#include "Logging.h"
 #include "MachEnv.h"
 #include "mpi.h"
 #include "yaml-cpp/yaml.h"
 
+#include <list>
 #include <string>
 
 namespace OMEGA {
@@ -42,8 +44,8 @@ class Config {
    /// The YAML node containing the configuration.
    YAML::Node Node;
 
-   /// All MPI tasks must read the initial input file but there may
-   /// be a limit to the number of tasks who can simultaneously read
+   /// When all MPI tasks read the initial input file (ReadGrouped), there
+   /// may be a limit to the number of tasks who can simultaneously read
    /// so only a subset of tasks reads at the same time
    static const int ReadGroupSize;
    static int ReadGroupID;
@@ -56,6 +58,12 @@ class Config {
    static bool NotInitialized;
 
  public:
+   /// Ways of reading the full configuration file in readAll
+   enum ReadMode {
+      ReadBroadcast, ///< master task reads and broadcasts the file text
+      ReadGrouped    ///< all tasks read the file, a group at a time
+   };
+
    // Methods
 
    /// Constructor that creates a Configuration with a given name and an
@@ -81,10 +89,12 @@ class Config {
    /// Reads the full configuration for omega and stores in it a static
    /// YAML node for later use.  The file must be in YAML format and must be in
    /// the same directory as the executable, though Unix soft links can be used
-   /// to point to a file in an alternate location.  The full configuration is
-   /// only read by the master task.  The accessor functions (get/set) will
-   /// broadcast or communicate the data as needed to/from other MPI tasks.
-   static int readAll(std::string FileName ///< [in] input omega config file
+   /// to point to a file in an alternate location.  By default, only the
+   /// master task reads the file and broadcasts its text so that every task
+   /// parses the configuration from memory. The ReadGrouped mode has every
+   /// task read the file itself in groups of ReadGroupSize tasks.
+   static int readAll(std::string FileName, ///< [in] input omega config file
+                      ReadMode Mode = ReadBroadcast ///< [in] read mode
    );
 
    // Retrieval (get) functions
@@ -365,6 +375,96 @@ class Config {
 
 }; // end class Config
 
+/// A ConfigParam is a typed configuration variable that is resolved once,
+/// typically during initialization, from the full Omega configuration.
+/// The path names the nested groups and the variable separated by '/', for
+/// example "Advection/FluxThicknessType". After bind, the value is held as a
+/// plain member so code in the time step loop can read it without any YAML
+/// traversal or conversion. A variable missing from the configuration keeps
+/// the default value unless it is required. The type must be one supported
+/// by Config::get.
+template <typename T> class ConfigParam {
+
+ private:
+   std::string Path; ///< group and variable names separated by '/'
+   T Value;          ///< current value, the default until bound
+   bool Bound;       ///< true once bind has succeeded
+   bool Found;       ///< true if the value was found in the configuration
+
+ public:
+   /// Constructs an unbound parameter holding the default value
+   ConfigParam(const std::string &InPath, ///< [in] group/variable path
+               const T &DefaultValue      ///< [in] value if not configured
+               )
+       : Path(InPath), Value(DefaultValue), Bound(false), Found(false) {}
+
+   /// Resolves the parameter from the full Omega configuration.
+   /// Returns a non-zero error code if a group or variable in the path
+   /// exists but cannot be retrieved, or if a required variable is missing.
+   int bind(bool Required = false ///< [in] error if not in configuration
+   ) {
+      // Sub-configurations along the path are kept in a list since
+      // assigning one Config to another would modify the shared YAML node
+      std::list<Config> Groups;
+      Config *Current = Config::getOmegaConfig();
+
+      std::size_t Start = 0;
+      std::size_t Slash = Path.find('/');
+      while (Slash != std::string::npos) {
+         const std::string GroupName = Path.substr(Start, Slash - Start);
+         if (!Current->existsGroup(GroupName))
+            return missing(Required);
+         Groups.emplace_back(GroupName);
+         if (Current->get(Groups.back()) != 0) {
+            LOG_ERROR("ConfigParam: error retrieving group {} for {}",
+                      GroupName, Path);
+            return 1;
+         }
+         Current = &Groups.back();
+         Start   = Slash + 1;
+         Slash   = Path.find('/', Start);
+      }
+
+      const std::string VarName = Path.substr(Start);
+      if (!Current->existsVar(VarName))
+         return missing(Required);
+      if (Current->get(VarName, Value) != 0) {
+         LOG_ERROR("ConfigParam: error retrieving {}", Path);
+         return 1;
+      }
+      Found = true;
+      Bound = true;
+      return 0;
+   }
+
+   /// Returns the bound (or default) value
+   const T &get() const { return Value; }
+   operator const T &() const { return Value; }
+
+   /// Returns true once the parameter has been bound
+   bool isBound() const { return Bound; }
+
+   /// Returns true if the value came from the configuration
+   bool isFromConfig() const { return Found; }
+
+   /// Returns the path of the parameter
+   const std::string &getPath() const { return Path; }
+
+ private:
+   /// Handles a group or variable missing from the configuration
+   int missing(bool Required) {
+      if (Required) {
+         LOG_ERROR("ConfigParam: required variable {} not in configuration",
+                   Path);
+         return 1;
+      }
+      Found = false;
+      Bound = true;
+      return 0;
+   }
+
+}; // end class ConfigParam
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
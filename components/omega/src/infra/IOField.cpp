@@ -16,13 +16,16 @@
 #include "DataTypes.h"
 #include "Logging.h"
 #include "MetaData.h"
-#include <map>
+#include <functional>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace OMEGA {
 
 // Initialize static variables
-std::map<std::string, std::shared_ptr<IOField>> IOField::AvailableFields;
+std::vector<std::unique_ptr<IOField>> IOField::AllFields;
+std::unordered_map<std::string, I4> IOField::FieldHandles;
 
 //------------------------------------------------------------------------------
 // Defines a field so it is available for IO. The caller must
@@ -33,8 +36,17 @@ std::map<std::string, std::shared_ptr<IOField>> IOField::AvailableFields;
 int IOField::define(
     const std::string &FieldName ///< [in] Name of field to be defined
 ) {
+   I4 Handle;
+   return define(FieldName, Handle);
+}
+
+int IOField::define(
+    const std::string &FieldName, ///< [in] Name of field to be defined
+    I4 &Handle                    ///< [out] handle of new field
+) {
 
    int Err = 0; // initialize return code
+   Handle  = -1;
 
    // Perform some error checks.
    // If MetaData not defined, exit with an error
@@ -53,13 +65,15 @@ int IOField::define(
    }
 
    // Create an empty IOField
-   auto ThisField = std::make_shared<IOField>();
+   auto ThisField = std::make_unique<IOField>();
 
    // Retrieve and attach the MetaData
    ThisField->MetadataPtr = MetaData::get(FieldName);
 
-   // Add entry to available fields
-   IOField::AvailableFields[FieldName] = ThisField;
+   // Add entry to available fields in the next slot
+   Handle = AllFields.size();
+   AllFields.push_back(std::move(ThisField));
+   FieldHandles[FieldName] = Handle;
 
    return Err;
 }
@@ -68,12 +82,17 @@ int IOField::define(
 // Checks to see if a field exists with a given name
 bool IOField::isDefined(const std::string &FieldName // [in] Name of field
 ) {
-   auto it = IOField::AvailableFields.find(FieldName);
-   if (it != IOField::AvailableFields.end()) { // entry found
-      return true;
-   } else {
-      return false;
-   }
+   return FieldHandles.find(FieldName) != FieldHandles.end();
+}
+
+//------------------------------------------------------------------------------
+// Retrieves the handle of a field, or -1 if the field is not defined
+I4 IOField::getHandle(const std::string &FieldName // [in] Name of field
+) {
+   auto It = FieldHandles.find(FieldName);
+   if (It == FieldHandles.end())
+      return -1;
+   return It->second;
 }
 
 //------------------------------------------------------------------------------
@@ -83,31 +102,127 @@ std::shared_ptr<MetaData>
 IOField::getMetaData(const std::string &FieldName ///< [in] name of IOField
 ) {
 
-   if (IOField::isDefined(FieldName)) { // entry found
+   IOField *ThisField = getField(getHandle(FieldName));
+   if (ThisField == nullptr) { // field not found
+      LOG_ERROR("IOField: Attempted to get metadata failed, {} does not exist",
+                FieldName);
+      return nullptr;
+   }
 
-      auto ThisField = IOField::AvailableFields[FieldName];
-      return ThisField->MetadataPtr;
+   return ThisField->MetadataPtr;
+}
 
-   } else { // field not found
+std::shared_ptr<MetaData>
+IOField::getMetaData(const I4 Handle ///< [in] handle of IOField
+) {
 
-      LOG_ERROR("IOField: Attempted to get metadata failed, {} does not exist",
-                FieldName);
+   IOField *ThisField = getField(Handle);
+   if (ThisField == nullptr) { // field not found
+      LOG_ERROR("IOField: Attempted to get metadata failed, field handle {} "
+                "does not exist",
+                Handle);
       return nullptr;
    }
+
+   return ThisField->MetadataPtr;
 }
 
 //------------------------------------------------------------------------------
-// Removes a single IOField from the list of available fields
+// Retrieves the compression settings for an IOField from its MetaData
+
+IO::Compression
+IOField::getCompression(const std::string &FieldName ///< [in] name of IOField
+) {
+
+   const I4 Handle = getHandle(FieldName);
+   if (Handle < 0) {
+      LOG_ERROR("IOField: Attempted to get compression failed, {} does not "
+                "exist",
+                FieldName);
+      return IO::Compression();
+   }
+
+   return getCompression(Handle);
+}
+
+IO::Compression IOField::getCompression(const I4 Handle ///< [in] handle
+) {
+
+   IO::Compression Compress; // defaults to no compression
+
+   std::shared_ptr<MetaData> FieldMeta = getMetaData(Handle);
+   if (FieldMeta == nullptr)
+      return Compress;
+
+   if (FieldMeta->hasEntry("CompressionLevel"))
+      FieldMeta->getEntry("CompressionLevel", Compress.DeflateLevel);
+   if (FieldMeta->hasEntry("CompressionShuffle"))
+      FieldMeta->getEntry("CompressionShuffle", Compress.Shuffle);
+   if (FieldMeta->hasEntry("QuantizeBits"))
+      FieldMeta->getEntry("QuantizeBits", Compress.QuantizeBits);
+
+   return Compress;
+}
+
+//------------------------------------------------------------------------------
+// Sets the function that updates the attached data of a field
+
+int IOField::setUpdate(const std::string &FieldName, // [in] name of field
+                       std::function<int()> Func     // [in] update function
+) {
+
+   IOField *ThisField = getField(getHandle(FieldName));
+   if (ThisField == nullptr) {
+      LOG_ERROR("IOField: error setting update of {}. Field not defined",
+                FieldName);
+      return -1;
+   }
+
+   ThisField->UpdateFunc = std::move(Func);
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Calls the update function of a field, if any
+
+int IOField::update(const std::string &FieldName // [in] name of field
+) {
+   return update(getHandle(FieldName));
+}
+
+int IOField::update(const I4 Handle // [in] handle of field
+) {
+
+   IOField *ThisField = getField(Handle);
+   if (ThisField == nullptr || !ThisField->UpdateFunc)
+      return 0;
+
+   int Err = ThisField->UpdateFunc();
+   if (Err != 0)
+      LOG_ERROR("IOField: error updating data of field handle {}", Handle);
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Removes a single IOField from the list of available fields. The slot of
+// the field is emptied rather than removed so other handles stay valid.
 
 void IOField::erase(const std::string &Name /// Name of IOField to remove
 ) {
-   IOField::AvailableFields.erase(Name);
+   auto It = FieldHandles.find(Name);
+   if (It == FieldHandles.end())
+      return;
+   AllFields[It->second].reset();
+   FieldHandles.erase(It);
 }
 
 //------------------------------------------------------------------------------
 // Removes all IOFields. This must be called before exiting environments
 
-void IOField::clear() { IOField::AvailableFields.clear(); }
+void IOField::clear() {
+   AllFields.clear();
+   FieldHandles.clear();
+}
 
 } // end namespace OMEGA
 //===----------------------------------------------------------------------===//
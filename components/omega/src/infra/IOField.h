@@ -15,27 +15,52 @@
 //===----------------------------------------------------------------------===//
 
 #include "DataTypes.h"
+#include "IO.h"
 #include "Logging.h"
 #include "MetaData.h"
-#include <map>
+#include <functional>
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 
 namespace OMEGA {
 
 class IOField {
 
  private:
-   /// Store and maintain all defined fields
-   static std::map<std::string, std::shared_ptr<IOField>> AvailableFields;
+   /// Store and maintain all defined fields, indexed by field handle. An
+   /// erased field leaves an empty slot so the handles of the remaining
+   /// fields stay valid.
+   static std::vector<std::unique_ptr<IOField>> AllFields;
+
+   /// Handles of all defined fields by name
+   static std::unordered_map<std::string, I4> FieldHandles;
 
    /// Metadata associated with this field
    std::shared_ptr<MetaData> MetadataPtr;
 
    /// Data assigned to this field. We use a void pointer to manage the
    /// many different Array types. These are cast to the appropriate type
-   /// on retrieval.
+   /// on retrieval after checking the type recorded when attached.
    std::shared_ptr<void> Data;
 
+   /// Type of the attached data array
+   std::type_index DataType = typeid(void);
+
+   /// Optional function that brings the attached data up to date before
+   /// it is used for output, eg. to compute a diagnostic only when needed
+   std::function<int()> UpdateFunc;
+
+   /// Returns the field with a given handle or a null pointer if the
+   /// handle does not refer to a defined field
+   static IOField *getField(const I4 Handle ///< [in] field handle
+   ) {
+      if (Handle < 0 || Handle >= static_cast<I4>(AllFields.size()))
+         return nullptr;
+      return AllFields[Handle].get();
+   }
+
  public:
    //---------------------------------------------------------------------------
    /// Checks to see if a field is defined
@@ -51,6 +76,21 @@ class IOField {
    static int define(const std::string &FieldName ///< [in] Name of field
    );
 
+   //---------------------------------------------------------------------------
+   /// Defines a field as above and also returns its handle. The handle
+   /// can be used in place of the name to retrieve the field without a
+   /// name lookup, eg. by streams that access the field every time step.
+   static int define(const std::string &FieldName, ///< [in] Name of field
+                     I4 &Handle                    ///< [out] field handle
+   );
+
+   //---------------------------------------------------------------------------
+   /// Retrieves the handle of a field by name. Returns -1 if the field is
+   /// not defined. Handles remain valid until the field is erased or all
+   /// fields are cleared.
+   static I4 getHandle(const std::string &FieldName ///< [in] name of field
+   );
+
    //---------------------------------------------------------------------------
    /// Retrieves IOField MetaData by name. Returns a shared pointer to
    /// the attached metadata.
@@ -58,6 +98,24 @@ class IOField {
    getMetaData(const std::string &FieldName ///< [in] name of IOField
    );
 
+   /// Retrieves IOField MetaData by handle
+   static std::shared_ptr<MetaData>
+   getMetaData(const I4 Handle ///< [in] handle of IOField
+   );
+
+   //---------------------------------------------------------------------------
+   /// Retrieves the compression settings for writing an IOField. These are
+   /// set with the optional MetaData entries CompressionLevel (I4 deflate
+   /// level), CompressionShuffle (bool) and QuantizeBits (I4 significant
+   /// bits). Missing entries leave the corresponding compression off.
+   static IO::Compression
+   getCompression(const std::string &FieldName ///< [in] name of IOField
+   );
+
+   /// Retrieves the compression settings for writing an IOField by handle
+   static IO::Compression getCompression(const I4 Handle ///< [in] handle
+   );
+
    // Template functions must have implementation in header files
    //---------------------------------------------------------------------------
    /// Attaches an array of data to an existing IOField. If a data array
@@ -70,21 +128,41 @@ class IOField {
                          const T &DataArray ///< [in] Array with data to attach
    ) {
 
-      int Err = 0; // initialize return code
-
       // Check to make sure field exists
-      if (isDefined(FieldName)) { // entry found
-         // Retrieve the IO field
-         auto ThisField = AvailableFields[FieldName];
-         // Attach the data array
-         ThisField->Data = std::make_shared<T>(DataArray);
-
-      } else { // field has not yet been defined
-         Err = -1;
+      const I4 Handle = getHandle(FieldName);
+      if (Handle < 0) { // field has not yet been defined
          LOG_ERROR("IOField: error attaching data to {}. Field not defined",
                    FieldName);
+         return -1;
+      }
+
+      return attachData<T>(Handle, DataArray);
+   };
+
+   /// Attaches an array of data to an existing IOField by handle. An array
+   /// of the same type as the attached array replaces it in place.
+   template <typename T>
+   static int attachData(const I4 Handle,   ///< [in] handle of IOField
+                         const T &DataArray ///< [in] Array with data to attach
+   ) {
+
+      IOField *ThisField = getField(Handle);
+      if (ThisField == nullptr) {
+         LOG_ERROR("IOField: error attaching data to field handle {}. "
+                   "Field not defined",
+                   Handle);
+         return -1;
+      }
+
+      // Reuse the storage of an array of the same type
+      if (ThisField->DataType == typeid(T) && ThisField->Data != nullptr) {
+         *static_cast<T *>(ThisField->Data.get()) = DataArray;
+      } else {
+         ThisField->Data     = std::make_shared<T>(DataArray);
+         ThisField->DataType = typeid(T);
       }
-      return Err;
+
+      return 0;
    };
 
    //---------------------------------------------------------------------------
@@ -98,7 +176,8 @@ class IOField {
    ) {
 
       // Check to see if field is defined
-      if (!isDefined(FieldName)) { // no entry found return error
+      const I4 Handle = getHandle(FieldName);
+      if (Handle < 0) { // no entry found return error
          LOG_ERROR("IOField: Attempted to get data failed, {} does not exist",
                    FieldName);
          // return an empty data object
@@ -106,29 +185,59 @@ class IOField {
          return Data;
       }
 
-      // Retrieve the field by name
-      auto ThisField = AvailableFields[FieldName];
-
-      // Check to make sure data is attached
-      if (ThisField->Data != nullptr) { // data is attached
+      return getData<T>(Handle);
+   };
 
-         // Convert the data pointer to the appropriate type and
-         // return data array dereferenced from the pointer
-         return *(std::static_pointer_cast<T>(ThisField->Data));
+   /// Retrieves IOField data array by handle
+   template <typename T>
+   static T getData(const I4 Handle ///< [in] handle of IOField
+   ) {
 
-      } else { // data has not yet been attached
+      IOField *ThisField = getField(Handle);
+      if (ThisField == nullptr) {
+         LOG_ERROR("IOField: Attempted to get data failed, field handle {} "
+                   "does not exist",
+                   Handle);
+         T Data;
+         return Data;
+      }
 
-         LOG_ERROR("IOField: Attempted to get data failed from field {}. "
-                   "Data array has not been attached",
-                   FieldName);
+      // Check to make sure data of the requested type is attached
+      if (ThisField->Data == nullptr || ThisField->DataType != typeid(T)) {
+         LOG_ERROR("IOField: Attempted to get data failed from field handle "
+                   "{}. No data array of the requested type is attached",
+                   Handle);
          // return an empty data object
          T Data;
          return Data;
       }
+
+      // Return data array dereferenced from the typed pointer
+      return *static_cast<const T *>(ThisField->Data.get());
    };
 
    //---------------------------------------------------------------------------
-   /// Removes a single IOField from the list of available fields
+   /// Sets a function that updates the attached data of a field. Streams
+   /// call it (through update) each time they retrieve the field data, so
+   /// fields derived from the model state, such as auxiliary variables, are
+   /// only computed when a stream needs them. Returns an error code.
+   static int setUpdate(const std::string &FieldName, ///< [in] name of field
+                        std::function<int()> Func     ///< [in] update func
+   );
+
+   //---------------------------------------------------------------------------
+   /// Calls the update function of a field if it has one. Returns an error
+   /// code.
+   static int update(const std::string &FieldName ///< [in] name of field
+   );
+
+   /// Calls the update function of a field by handle
+   static int update(const I4 Handle ///< [in] handle of field
+   );
+
+   //---------------------------------------------------------------------------
+   /// Removes a single IOField from the list of available fields. Its
+   /// handle is not reused until all fields are cleared.
    /// That process also decrements the reference counters for the
    /// shared pointers and removes them if those counters reach 0.
    static void erase(const std::string &FieldName /// Name of IOField to remove
@@ -136,7 +245,7 @@ class IOField {
 
    //---------------------------------------------------------------------------
    /// Removes all IOFields. This must be called before exiting environments
-   /// This removes all fields from the map structure and also
+   /// This removes all fields and their handles and also
    /// decrements the reference counter for the shared pointers,
    /// removing them if the count has reached 0.
    static void clear();
@@ -0,0 +1,452 @@
+//===-- infra/IOStream.cpp - IO stream implementation -----------*- C++ -*-===//
+//
+// \file
+// \brief Implements the IOStream class and methods
+//
+// This file implements the non-templated functions of the IOStream class.
+// Streams manage the reading and writing of IOFields at times determined by
+// a TimeMgr Alarm, including the time-averaged accumulation of output fields
+// between writes.
+//
+//===----------------------------------------------------------------------===//
+
+#include "IOStream.h"
+#include "DataTypes.h"
+#include "IO.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MetaData.h"
+#include "TimeMgr.h"
+#include <algorithm>
+#include <any>
+#include <cctype>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <typeinfo>
+
+namespace OMEGA {
+
+// Initialize static variables
+std::map<std::string, std::shared_ptr<IOStream>> IOStream::AllStreams;
+
+//------------------------------------------------------------------------------
+// Converts a string to a StreamOp. Unrecognized strings default to Instant.
+
+StreamOp StreamOpFromString(const std::string &OpString // [in] op choice
+) {
+
+   // Convert input string to lowercase for easier comparison
+   std::string OpComp = OpString;
+   std::transform(OpComp.begin(), OpComp.end(), OpComp.begin(),
+                  [](unsigned char c) { return std::tolower(c); });
+
+   if (OpComp == "mean" or OpComp == "average") {
+      return StreamOp::Mean;
+   } else if (OpComp == "min" or OpComp == "minimum") {
+      return StreamOp::Min;
+   } else if (OpComp == "max" or OpComp == "maximum") {
+      return StreamOp::Max;
+   } else {
+      return StreamOp::Instant;
+   }
+
+} // end StreamOpFromString
+
+//------------------------------------------------------------------------------
+// Retrieves global dimension lengths and the fill value from field metadata
+
+int IOStreamField::getMetaInfo() {
+
+   int Err = 0;
+
+   std::shared_ptr<MetaData> FieldMeta = IOField::getMetaData(FieldHandle);
+   if (FieldMeta == nullptr)
+      return -1;
+
+   // Dimension lengths
+   std::vector<std::shared_ptr<MetaDim>> Dims;
+   if (!FieldMeta->hasEntry("Dimensions") ||
+       FieldMeta->getEntry("Dimensions", Dims) != 0) {
+      LOG_ERROR("IOStream: no dimensions in metadata for field {}", FieldName);
+      return -2;
+   }
+   if (Dims.size() != DimNames.size()) {
+      LOG_ERROR("IOStream: {} dimension names supplied for field {} with {} "
+                "dimensions",
+                DimNames.size(), FieldName, Dims.size());
+      return -3;
+   }
+   DimLengths.resize(Dims.size());
+   for (int IDim = 0; IDim < Dims.size(); ++IDim) {
+      I4 Length;
+      Err += Dims[IDim]->getLength(Length);
+      DimLengths[IDim] = Length;
+   }
+
+   // Fill value, which may be stored in any of the supported types
+   if (FieldMeta->hasEntry("FillValue")) {
+      const std::any &Fill = (*FieldMeta->getAllEntries())["FillValue"];
+      if (Fill.type() == typeid(R8)) {
+         FillValue = std::any_cast<R8>(Fill);
+      } else if (Fill.type() == typeid(R4)) {
+         FillValue = std::any_cast<R4>(Fill);
+      } else if (Fill.type() == typeid(I8)) {
+         FillValue = std::any_cast<I8>(Fill);
+      } else if (Fill.type() == typeid(I4)) {
+         FillValue = std::any_cast<I4>(Fill);
+      }
+   }
+
+   return Err;
+
+} // end getMetaInfo
+
+//------------------------------------------------------------------------------
+// Creates a new stream and adds it to the list of defined streams
+
+int IOStream::create(const std::string &Name,     // [in] name of stream
+                     const std::string &Filename, // [in] file name or template
+                     IO::Mode Mode,               // [in] read/write mode
+                     IO::Precision Precision,     // [in] precision for floats
+                     IO::IfExists IfExists,       // [in] action if file exists
+                     const TimeInterval &Freq,    // [in] time frequency for I/O
+                     Clock *ModelClock // [in] model clock for stream times
+) {
+
+   if (isDefined(Name)) {
+      LOG_ERROR("IOStream: stream {} already exists", Name);
+      return -1;
+   }
+   if (ModelClock == nullptr) {
+      LOG_ERROR("IOStream: a valid clock is required for stream {}", Name);
+      return -2;
+   }
+
+   auto NewStream        = std::make_shared<IOStream>();
+   NewStream->Name       = Name;
+   NewStream->Filename   = Filename;
+   NewStream->Mode       = Mode;
+   NewStream->Precision  = Precision;
+   NewStream->IfExists   = IfExists;
+   NewStream->ModelClock = ModelClock;
+   NewStream->StreamAlarm =
+       std::make_unique<Alarm>(Name, Freq, ModelClock->getStartTime());
+
+   AllStreams[Name] = NewStream;
+
+   return 0;
+
+} // end create
+
+//------------------------------------------------------------------------------
+// Restricts a stream to the times between a start and end time
+
+int IOStream::setStartEnd(const std::string &Name,  // [in] name of stream
+                          const TimeInstant &Start, // [in] start time
+                          const TimeInstant &End    // [in] end time
+) {
+
+   if (!isDefined(Name)) {
+      LOG_ERROR("IOStream: cannot set start/end for undefined stream {}",
+                Name);
+      return -1;
+   }
+   if (End < Start) {
+      LOG_ERROR("IOStream: end time before start time for stream {}", Name);
+      return -2;
+   }
+
+   auto ThisStream         = AllStreams[Name];
+   ThisStream->UseStartEnd = true;
+   ThisStream->StartTime   = Start;
+   ThisStream->EndTime     = End;
+
+   return 0;
+
+} // end setStartEnd
+
+//------------------------------------------------------------------------------
+// Checks whether a stream has been defined
+
+bool IOStream::isDefined(const std::string &Name // [in] name of stream
+) {
+   return (AllStreams.find(Name) != AllStreams.end());
+}
+
+//------------------------------------------------------------------------------
+// Returns true if the current clock time is within the stream start/end
+
+bool IOStream::isActive() const {
+
+   if (!UseStartEnd)
+      return true;
+
+   TimeInstant CurrTime = ModelClock->getCurrentTime();
+   return (CurrTime >= StartTime and CurrTime <= EndTime);
+}
+
+//------------------------------------------------------------------------------
+// Expands the filename template for the current time
+
+std::string IOStream::getFilename() const {
+   return expandFilename(Filename, ModelClock->getCurrentTime());
+}
+
+//------------------------------------------------------------------------------
+// Expands a filename template for a given time. The tokens $Y, $M, $D, $h, $m
+// and $s are replaced by the year, month, day, hour, minute and (whole)
+// second of the time.
+
+std::string
+IOStream::expandFilename(const std::string &Filename, // [in] template
+                         const TimeInstant &Time      // [in] time
+) {
+
+   I8 Year, Month, Day, Hour, Minute;
+   R8 Second;
+   Time.get(Year, Month, Day, Hour, Minute, Second);
+
+   std::map<char, std::string> Tokens;
+   char Buffer[32];
+   std::snprintf(Buffer, sizeof(Buffer), "%04lld", (long long)Year);
+   Tokens['Y'] = Buffer;
+   std::snprintf(Buffer, sizeof(Buffer), "%02lld", (long long)Month);
+   Tokens['M'] = Buffer;
+   std::snprintf(Buffer, sizeof(Buffer), "%02lld", (long long)Day);
+   Tokens['D'] = Buffer;
+   std::snprintf(Buffer, sizeof(Buffer), "%02lld", (long long)Hour);
+   Tokens['h'] = Buffer;
+   std::snprintf(Buffer, sizeof(Buffer), "%02lld", (long long)Minute);
+   Tokens['m'] = Buffer;
+   std::snprintf(Buffer, sizeof(Buffer), "%02lld", (long long)Second);
+   Tokens['s'] = Buffer;
+
+   std::string OutName;
+   for (int I = 0; I < Filename.size(); ++I) {
+      if (Filename[I] == '$' and I + 1 < Filename.size() and
+          Tokens.find(Filename[I + 1]) != Tokens.end()) {
+         OutName += Tokens[Filename[I + 1]];
+         ++I;
+      } else {
+         OutName += Filename[I];
+      }
+   }
+
+   return OutName;
+
+} // end getFilename
+
+//------------------------------------------------------------------------------
+// Writes the contents of a stream to a file, including the accumulated
+// values of any averaged fields, and resets the accumulations.
+
+int IOStream::writeStream() {
+
+   int Err = 0;
+
+   std::string OutName = getFilename();
+   int FileID;
+   Err = IO::openFile(FileID, OutName, IO::ModeWrite, IO::FmtDefault, IfExists,
+                      Precision);
+   if (Err != 0) {
+      LOG_ERROR("IOStream: error opening file {} for stream {}", OutName,
+                Name);
+      return Err;
+   }
+
+   // Write the time of the stream as a global attribute
+   std::string TimeString = ModelClock->getCurrentTime().getString(4, 0, "_");
+   Err = IO::writeMeta("StreamTime", TimeString, FileID, IO::GlobalID);
+   if (Err != 0)
+      LOG_WARN("IOStream: error writing time for stream {}", Name);
+
+   // Define dimensions, with each name defined once per file
+   std::map<std::string, int> DimIDs;
+   for (auto &Field : Contents) {
+      for (int IDim = 0; IDim < Field->DimNames.size(); ++IDim) {
+         const std::string &DimName = Field->DimNames[IDim];
+         if (DimIDs.find(DimName) != DimIDs.end())
+            continue;
+         int DimID;
+         Err = IO::defineDim(FileID, DimName, Field->DimLengths[IDim], DimID);
+         if (Err != 0) {
+            LOG_ERROR("IOStream: error defining dim {} for stream {}",
+                      DimName, Name);
+            IO::closeFile(FileID);
+            return Err;
+         }
+         DimIDs[DimName] = DimID;
+      }
+   }
+
+   // Define variables
+   std::vector<int> VarIDs(Contents.size());
+   for (int IField = 0; IField < Contents.size(); ++IField) {
+      auto &Field = Contents[IField];
+      std::vector<int> FieldDimIDs;
+      for (auto &DimName : Field->DimNames)
+         FieldDimIDs.push_back(DimIDs[DimName]);
+      Err = IO::defineVar(FileID, Field->FieldName,
+                          Field->getIOType(Precision), FieldDimIDs.size(),
+                          FieldDimIDs.data(), VarIDs[IField],
+                          IOField::getCompression(Field->FieldHandle));
+      if (Err != 0) {
+         LOG_ERROR("IOStream: error defining var {} for stream {}",
+                   Field->FieldName, Name);
+         IO::closeFile(FileID);
+         return Err;
+      }
+      if (Field->Op != StreamOp::Instant)
+         IO::writeMeta("NumSamples", Field->NumSamples, FileID,
+                       VarIDs[IField]);
+   }
+
+   Err = IO::endDefinePhase(FileID);
+   if (Err != 0) {
+      LOG_ERROR("IOStream: error ending define phase for stream {}", Name);
+      IO::closeFile(FileID);
+      return Err;
+   }
+
+   // Write the data. The copy of each field to the host is started before
+   // the previous field is written, alternating between the IO staging
+   // slots, so that device to host transfers overlap with the writes.
+   const int NFields = Contents.size();
+   if (NFields > 0)
+      Contents[0]->stage(0);
+   for (int IField = 0; IField < NFields; ++IField) {
+      const int Slot = IField % IO::NumStagingSlots;
+      if (IField + 1 < NFields)
+         Contents[IField + 1]->stage((IField + 1) % IO::NumStagingSlots);
+      int FieldErr =
+          Contents[IField]->writeStaged(FileID, VarIDs[IField], Slot);
+      if (FieldErr != 0) {
+         LOG_ERROR("IOStream: error writing {} for stream {}",
+                   Contents[IField]->FieldName, Name);
+         Err += FieldErr;
+      }
+   }
+
+   int CloseErr = IO::closeFile(FileID);
+   if (CloseErr != 0) {
+      LOG_ERROR("IOStream: error closing file {} for stream {}", OutName,
+                Name);
+      Err += CloseErr;
+   }
+
+   return Err;
+
+} // end writeStream
+
+//------------------------------------------------------------------------------
+// Accumulates fields in all active output streams and writes any stream
+// whose alarm is ringing
+
+int IOStream::writeAll() {
+
+   int Err = 0;
+
+   for (auto &[StreamName, ThisStream] : AllStreams) {
+      if (ThisStream->Mode != IO::ModeWrite or !ThisStream->isActive())
+         continue;
+
+      for (auto &Field : ThisStream->Contents)
+         Field->accumulate();
+
+      Err += write(StreamName);
+   }
+
+   return Err;
+
+} // end writeAll
+
+//------------------------------------------------------------------------------
+// Writes a single stream if its alarm is ringing and resets the alarm
+
+int IOStream::write(const std::string &Name // [in] name of stream
+) {
+
+   int Err = 0;
+
+   if (!isDefined(Name)) {
+      LOG_ERROR("IOStream: cannot write undefined stream {}", Name);
+      return -1;
+   }
+   auto ThisStream = AllStreams[Name];
+   if (ThisStream->Mode != IO::ModeWrite) {
+      LOG_ERROR("IOStream: cannot write input stream {}", Name);
+      return -2;
+   }
+
+   TimeInstant CurrTime = ThisStream->ModelClock->getCurrentTime();
+   Err = ThisStream->StreamAlarm->updateStatus(CurrTime);
+   if (Err != 0) {
+      LOG_ERROR("IOStream: error updating alarm for stream {}", Name);
+      return Err;
+   }
+
+   // The alarm is reset even outside the active period so that a stream
+   // is not written immediately when its start time is reached
+   if (ThisStream->StreamAlarm->isRinging()) {
+      if (ThisStream->isActive())
+         Err = ThisStream->writeStream();
+      ThisStream->StreamAlarm->reset(CurrTime);
+   }
+
+   return Err;
+
+} // end write
+
+//------------------------------------------------------------------------------
+// Reads all fields of an input stream
+
+int IOStream::read(const std::string &Name // [in] name of stream
+) {
+
+   int Err = 0;
+
+   if (!isDefined(Name)) {
+      LOG_ERROR("IOStream: cannot read undefined stream {}", Name);
+      return -1;
+   }
+   auto ThisStream = AllStreams[Name];
+
+   std::string InName = ThisStream->getFilename();
+   int FileID;
+   Err = IO::openFile(FileID, InName, IO::ModeRead);
+   if (Err != 0) {
+      LOG_ERROR("IOStream: error opening file {} for stream {}", InName, Name);
+      return Err;
+   }
+
+   for (auto &Field : ThisStream->Contents) {
+      int FieldErr = Field->read(FileID);
+      if (FieldErr != 0) {
+         LOG_ERROR("IOStream: error reading {} for stream {}",
+                   Field->FieldName, Name);
+         Err += FieldErr;
+      }
+   }
+
+   Err += IO::closeFile(FileID);
+
+   return Err;
+
+} // end read
+
+//------------------------------------------------------------------------------
+// Removes a single stream
+
+void IOStream::erase(const std::string &Name // [in] name of stream
+) {
+   AllStreams.erase(Name);
+}
+
+//------------------------------------------------------------------------------
+// Removes all streams
+
+void IOStream::clear() { AllStreams.clear(); }
+
+} // end namespace OMEGA
+//===----------------------------------------------------------------------===//
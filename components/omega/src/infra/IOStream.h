@@ -0,0 +1,440 @@
+#ifndef OMEGA_IOSTREAM_H
+#define OMEGA_IOSTREAM_H
+//===-- infra/IOStream.h - IO stream class ----------------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the IOStream class and methods
+///
+/// This header defines the IOStream class for managing input and output
+/// streams in OMEGA. Each stream describes a file (or sequence of files) with
+/// a set of contents (previously defined IOFields), a read/write mode, a
+/// floating point precision and a time frequency managed by a TimeMgr Alarm.
+/// For output streams, each field can either be written instantaneously or
+/// accumulated as a running mean, minimum or maximum between writes. The
+/// accumulation is performed in the memory space of the attached field, so
+/// device fields are accumulated with device kernels and are only copied to
+/// the host when the stream is written. Like other OMEGA classes, all streams
+/// are stored and managed within the class. Because the field contents are
+/// templated on the array type, the templated functions are defined in this
+/// header.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "IO.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace OMEGA {
+
+/// Operation applied to a field in an output stream between writes
+enum class StreamOp {
+   Instant, ///< Write the current (instantaneous) field value
+   Mean,    ///< Write the mean of all samples since the last write
+   Min,     ///< Write the minimum of all samples since the last write
+   Max,     ///< Write the maximum of all samples since the last write
+};
+
+/// Converts a string (instant, mean, min or max) to a StreamOp
+StreamOp StreamOpFromString(const std::string &OpString ///< [in] op choice
+);
+
+//------------------------------------------------------------------------------
+/// The IOStreamField class holds a single field in the contents of a stream,
+/// together with any accumulation buffer. This base class stores the
+/// type-independent info and defines the interface used by the stream, while
+/// the derived IOStreamFieldT class implements the interface for each
+/// supported array type.
+class IOStreamField {
+
+ public:
+   std::string FieldName;             ///< name of the IOField
+   I4 FieldHandle = -1;               ///< handle of the IOField
+   int DecompID;                      ///< IO decomposition for the field
+   std::vector<std::string> DimNames; ///< dimension names in file
+   std::vector<int> DimLengths;       ///< global dimension lengths
+   StreamOp Op;                       ///< accumulation operation
+   I4 NumSamples = 0;                 ///< samples accumulated since write
+   R8 FillValue  = 0.0;               ///< fill value from field metadata
+
+   virtual ~IOStreamField() = default;
+
+   /// Adds the current field values to the accumulated values
+   virtual void accumulate() = 0;
+
+   /// Starts copying the field (or its accumulated values) to the host
+   /// through an IO staging slot and resets the accumulation. The copy
+   /// runs in the background until writeStaged is called for the slot.
+   virtual void stage(int Slot ///< [in] IO staging slot
+                      ) = 0;
+
+   /// Writes the field staged in a slot to an open file, using the
+   /// variable ID assigned by defineVar
+   virtual int writeStaged(int FileID, ///< [in] ID of open file
+                           int VarID,  ///< [in] variable ID in file
+                           int Slot    ///< [in] IO staging slot
+                           ) = 0;
+
+   /// Writes the field (or its accumulated values) to an open file and
+   /// resets the accumulation
+   int write(int FileID, ///< [in] ID of open file
+             int VarID   ///< [in] variable ID in file
+   ) {
+      stage(0);
+      return writeStaged(FileID, VarID, 0);
+   }
+
+   /// Reads the field from an open file into the attached data array
+   virtual int read(int FileID ///< [in] ID of open file
+                    ) = 0;
+
+   /// Returns the IO data type used for this field in a file
+   virtual IO::IODataType
+   getIOType(IO::Precision Precision ///< [in] precision for reals
+             ) const = 0;
+
+   /// Retrieves the global dimension lengths and fill value from the
+   /// field metadata. Returns an error code.
+   int getMetaInfo();
+
+}; // end class IOStreamField
+
+//------------------------------------------------------------------------------
+/// Implementation of a stream field for a given array type T. Arrays are
+/// assumed to be contiguous so that all operations can be performed on a
+/// flattened 1-d view of the data in the memory space of the array.
+template <typename T> class IOStreamFieldT : public IOStreamField {
+
+ private:
+   using ValType  = typename T::non_const_value_type;
+   using ExecType = typename T::execution_space;
+   using FlatType = Kokkos::View<ValType *, typename T::memory_space>;
+   using FlatData = Kokkos::View<ValType *, typename T::memory_space,
+                                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+   /// Single precision fields are accumulated in double precision so that
+   /// the mean over many samples keeps the precision of the field
+   using AccumValType =
+       std::conditional_t<std::is_same_v<ValType, R4>, R8, ValType>;
+   using AccumType = Kokkos::View<AccumValType *, typename T::memory_space>;
+
+   AccumType Accum; ///< accumulated values (Mean, Min, Max only)
+
+   FlatType Result;            ///< converted or scaled values being staged
+   void *StagedData = nullptr; ///< host data of the staged values
+   int StagedSize   = 0;       ///< number of staged values
+
+   /// Returns a flattened, unmanaged view of the attached field data,
+   /// after updating the data if the field has an update function
+   FlatData getFlatData() const {
+      IOField::update(FieldHandle);
+      T Data = IOField::getData<T>(FieldHandle);
+      return FlatData(Data.data(), Data.size());
+   }
+
+ public:
+   //---------------------------------------------------------------------------
+   /// Allocates the accumulation buffer on the array's memory space if
+   /// the field is accumulated.
+   void allocate() {
+      if (Op != StreamOp::Instant) {
+         T Data = IOField::getData<T>(FieldHandle);
+         Accum  = AccumType("Stream" + FieldName, Data.size());
+      }
+   }
+
+   //---------------------------------------------------------------------------
+   void accumulate() override {
+
+      // Instantaneous fields are only retrieved at write time
+      if (Op == StreamOp::Instant)
+         return;
+
+      auto FieldData = getFlatData();
+      auto LocAccum  = Accum;
+      int Size       = FieldData.size();
+
+      if (NumSamples == 0) {
+         Kokkos::parallel_for(
+             "StreamFirst", Kokkos::RangePolicy<ExecType>(0, Size),
+             KOKKOS_LAMBDA(int I) { LocAccum(I) = FieldData(I); });
+      } else if (Op == StreamOp::Mean) {
+         Kokkos::parallel_for(
+             "StreamMean", Kokkos::RangePolicy<ExecType>(0, Size),
+             KOKKOS_LAMBDA(int I) { LocAccum(I) += FieldData(I); });
+      } else if (Op == StreamOp::Min) {
+         Kokkos::parallel_for(
+             "StreamMin", Kokkos::RangePolicy<ExecType>(0, Size),
+             KOKKOS_LAMBDA(int I) {
+                if (FieldData(I) < LocAccum(I))
+                   LocAccum(I) = FieldData(I);
+             });
+      } else if (Op == StreamOp::Max) {
+         Kokkos::parallel_for(
+             "StreamMax", Kokkos::RangePolicy<ExecType>(0, Size),
+             KOKKOS_LAMBDA(int I) {
+                if (FieldData(I) > LocAccum(I))
+                   LocAccum(I) = FieldData(I);
+             });
+      }
+      ++NumSamples;
+   }
+
+   //---------------------------------------------------------------------------
+   void stage(int Slot) override {
+
+      // Select the source of the data to write. Instantaneous fields and
+      // fields with no accumulated samples use the current field values.
+      // Accumulated values are converted to the type of the field after
+      // finishing the mean in the precision of the accumulation.
+      FlatData Source;
+      Result = FlatType();
+      if (Op == StreamOp::Instant || NumSamples == 0) {
+         Source = getFlatData();
+      } else {
+         constexpr bool Convert = !std::is_same_v<AccumValType, ValType>;
+         const int AccumSize    = Accum.size();
+         if constexpr (Convert) {
+            Result = FlatType("StreamResult", AccumSize);
+            Source = FlatData(Result.data(), AccumSize);
+         } else {
+            Source = FlatData(Accum.data(), AccumSize);
+         }
+         const bool Scaled = Op == StreamOp::Mean && NumSamples > 1;
+         if (Convert || Scaled) {
+            auto LocAccum  = Accum;
+            auto LocSource = Source;
+            if constexpr (std::is_floating_point_v<ValType>) {
+               AccumValType Scale = Scaled ? 1.0 / NumSamples : 1.0;
+               Kokkos::parallel_for(
+                   "StreamScale", Kokkos::RangePolicy<ExecType>(0, AccumSize),
+                   KOKKOS_LAMBDA(int I) {
+                      LocSource(I) = LocAccum(I) * Scale;
+                   });
+            } else {
+               I4 NSamples = Scaled ? NumSamples : 1;
+               Kokkos::parallel_for(
+                   "StreamScale", Kokkos::RangePolicy<ExecType>(0, AccumSize),
+                   KOKKOS_LAMBDA(int I) {
+                      LocSource(I) = LocAccum(I) / NSamples;
+                   });
+            }
+         }
+      }
+
+      // Start the copy to the host for writing. For reduced precision
+      // output, the conversion to single precision is performed by PIO.
+      StagedSize = Source.size();
+      StagedData = IO::stageArray(Source, Slot);
+      NumSamples = 0;
+   }
+
+   //---------------------------------------------------------------------------
+   int writeStaged(int FileID, int VarID, int Slot) override {
+
+      IO::waitStaged(Slot);
+      ValType FillVal = FillValue;
+      int Err = IO::writeArray(StagedData, StagedSize, &FillVal, FileID,
+                               DecompID, VarID);
+      Result     = FlatType();
+      StagedData = nullptr;
+
+      return Err;
+   }
+
+   //---------------------------------------------------------------------------
+   int read(int FileID) override {
+
+      int VarID;
+      return IO::readArray(getFlatData(), FieldName, FileID, DecompID, VarID);
+   }
+
+   //---------------------------------------------------------------------------
+   IO::IODataType getIOType(IO::Precision Precision) const override {
+      if constexpr (std::is_same_v<ValType, R8>) {
+         if (Precision == IO::Precision::Single)
+            return IO::IOTypeR4;
+         return IO::IOTypeR8;
+      } else if constexpr (std::is_same_v<ValType, R4>) {
+         return IO::IOTypeR4;
+      } else if constexpr (std::is_same_v<ValType, I8>) {
+         return IO::IOTypeI8;
+      } else {
+         return IO::IOTypeI4;
+      }
+   }
+
+}; // end class IOStreamFieldT
+
+//------------------------------------------------------------------------------
+/// The IOStream class carries all the information for an input or output
+/// stream and the contents of the stream. All streams are stored within
+/// the class and are referred to by name.
+class IOStream {
+
+ private:
+   std::string Name;     ///< name of stream
+   std::string Filename; ///< filename or filename template
+
+   IO::Mode Mode;           ///< mode (read or write)
+   IO::Precision Precision; ///< precision for floating point vars
+   IO::IfExists IfExists;   ///< behavior if output file exists
+
+   Clock *ModelClock; ///< clock used to check the stream alarm
+   std::unique_ptr<Alarm> StreamAlarm; ///< alarm for read/write times
+
+   bool UseStartEnd = false; ///< flag for using start, end times
+   TimeInstant StartTime;    ///< start time for stream
+   TimeInstant EndTime;      ///< end time for stream
+
+   /// Contents of the stream
+   std::vector<std::shared_ptr<IOStreamField>> Contents;
+
+   /// Store and maintain all defined streams
+   static std::map<std::string, std::shared_ptr<IOStream>> AllStreams;
+
+   /// Returns true if the stream time is within the start/end interval
+   bool isActive() const;
+
+   /// Expands the filename template for the current time
+   std::string getFilename() const;
+
+   /// Writes the stream contents to a file
+   int writeStream();
+
+ public:
+   //---------------------------------------------------------------------------
+   /// Creates a new stream and adds it to the list of defined streams. A
+   /// periodic alarm with the input frequency is created using the clock
+   /// start time as the start of the first interval. The clock must remain
+   /// valid for the life of the stream. Returns an error code.
+   static int
+   create(const std::string &Name,     ///< [in] name of stream
+          const std::string &Filename, ///< [in] file name or template
+          IO::Mode Mode,               ///< [in] read/write mode
+          IO::Precision Precision,     ///< [in] precision for floats
+          IO::IfExists IfExists,       ///< [in] action if file exists
+          const TimeInterval &Freq,    ///< [in] time frequency for I/O
+          Clock *ModelClock            ///< [in] model clock for stream times
+   );
+
+   //---------------------------------------------------------------------------
+   /// Restricts a stream to the times between a start and end time.
+   /// Fields are neither accumulated nor written outside this interval.
+   static int setStartEnd(const std::string &Name,  ///< [in] name of stream
+                          const TimeInstant &Start, ///< [in] start time
+                          const TimeInstant &End    ///< [in] end time
+   );
+
+   //---------------------------------------------------------------------------
+   /// Checks whether a stream of a given name has been defined
+   static bool isDefined(const std::string &Name ///< [in] name of stream
+   );
+
+   //---------------------------------------------------------------------------
+   /// Adds a previously defined IOField to a stream. The array type of the
+   /// attached data must be supplied as a template argument (eg <Array2DR8>)
+   /// along with the IO decomposition ID and the names of the dimensions to
+   /// use in the file. The global dimension lengths are retrieved from the
+   /// field metadata. For output streams, the optional operation selects
+   /// whether the field is written instantaneously or accumulated between
+   /// writes. Accumulated fields allocate a buffer the size of the local
+   /// array in the array's memory space. Returns an error code.
+   template <typename T>
+   static int addField(const std::string &StreamName, ///< [in] name of stream
+                       const std::string &FieldName,  ///< [in] name of field
+                       int DecompID, ///< [in] IO decomposition for field
+                       const std::vector<std::string> &DimNames, ///< [in]
+                       StreamOp Op = StreamOp::Instant ///< [in] operation
+   ) {
+
+      int Err = 0;
+
+      if (!isDefined(StreamName)) {
+         LOG_ERROR("IOStream: cannot add field {} to undefined stream {}",
+                   FieldName, StreamName);
+         return -1;
+      }
+      const I4 FieldHandle = IOField::getHandle(FieldName);
+      if (FieldHandle < 0) {
+         LOG_ERROR("IOStream: cannot add undefined field {} to stream {}",
+                   FieldName, StreamName);
+         return -2;
+      }
+      auto ThisStream = AllStreams[StreamName];
+      if (ThisStream->Mode == IO::ModeRead && Op != StreamOp::Instant) {
+         LOG_WARN("IOStream: accumulation ignored for {} in read stream {}",
+                  FieldName, StreamName);
+         Op = StreamOp::Instant;
+      }
+
+      auto NewField         = std::make_shared<IOStreamFieldT<T>>();
+      NewField->FieldName   = FieldName;
+      NewField->FieldHandle = FieldHandle;
+      NewField->DecompID    = DecompID;
+      NewField->DimNames    = DimNames;
+      NewField->Op          = Op;
+
+      Err = NewField->getMetaInfo();
+      if (Err != 0) {
+         LOG_ERROR("IOStream: error retrieving metadata for {} in stream {}",
+                   FieldName, StreamName);
+         return Err;
+      }
+      NewField->allocate();
+
+      ThisStream->Contents.push_back(NewField);
+
+      return Err;
+   }
+
+   //---------------------------------------------------------------------------
+   /// Expands a filename template for a given time. The tokens $Y, $M, $D,
+   /// $h, $m and $s are replaced by the year, month, day, hour, minute and
+   /// (whole) second of the time.
+   static std::string
+   expandFilename(const std::string &Filename, ///< [in] filename template
+                  const TimeInstant &Time      ///< [in] time for the file
+   );
+
+   //---------------------------------------------------------------------------
+   /// Updates all output streams and should be called once per timestep
+   /// after the model clock has been advanced. Fields in active streams are
+   /// accumulated and any stream whose alarm is ringing is written and its
+   /// alarm reset. Returns an error code.
+   static int writeAll();
+
+   //---------------------------------------------------------------------------
+   /// Writes a single stream if its alarm is ringing and resets the alarm.
+   /// Accumulated fields are not sampled by this call. Returns an error code.
+   static int write(const std::string &Name ///< [in] name of stream
+   );
+
+   //---------------------------------------------------------------------------
+   /// Reads all fields of an input stream into the attached data arrays.
+   /// Returns an error code.
+   static int read(const std::string &Name ///< [in] name of stream
+   );
+
+   //---------------------------------------------------------------------------
+   /// Removes a single stream
+   static void erase(const std::string &Name ///< [in] name of stream
+   );
+
+   //---------------------------------------------------------------------------
+   /// Removes all streams and frees the accumulation buffers
+   static void clear();
+
+}; // end class IOStream
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_IOSTREAM_H
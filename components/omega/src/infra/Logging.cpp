@@ -3,13 +3,18 @@
 /// \file
 /// \brief implements Omega logging functions
 ///
-/// This implements Omega logging initialization.
+/// This implements Omega logging initialization, including the asynchronous
+/// and task-filtered loggers used for large runs.
 //
 //===----------------------------------------------------------------------===//
 
 #include "Logging.h"
+#include <algorithm>
 #include <iostream>
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/stdout_sinks.h>
 
 namespace OMEGA {
 
@@ -29,4 +34,66 @@ void initLogging(std::string const &LogFilePath) {
    initLogging(Logger);
 }
 
+bool isLoggingTask(const LogOptions &Options, int MyTask, int MasterTask) {
+
+   switch (Options.Tasks) {
+   case LogOptions::AllTasks:
+      return true;
+   case LogOptions::MasterTask:
+      return MyTask == MasterTask;
+   case LogOptions::EveryNthTask:
+      return Options.TaskStride > 0 && MyTask % Options.TaskStride == 0;
+   case LogOptions::ListedTasks:
+      return std::find(Options.TaskList.begin(), Options.TaskList.end(),
+                       MyTask) != Options.TaskList.end();
+   }
+   return true;
+}
+
+void initLogging(std::string const &LogFilePath, const LogOptions &Options,
+                 int MyTask, int MasterTask) {
+
+   try {
+      std::shared_ptr<spdlog::logger> Logger;
+
+      if (!isLoggingTask(Options, MyTask, MasterTask)) {
+         // Excluded tasks open no file but still report errors
+         auto ErrSink = std::make_shared<spdlog::sinks::stderr_sink_mt>();
+         ErrSink->set_level(spdlog::level::err);
+         Logger = std::make_shared<spdlog::logger>("*", ErrSink);
+
+      } else {
+         std::string FilePath = LogFilePath;
+         if (Options.PerTaskFiles)
+            FilePath += "." + std::to_string(MyTask);
+         auto FileSink =
+             std::make_shared<spdlog::sinks::basic_file_sink_mt>(FilePath);
+
+         if (Options.Async) {
+            spdlog::init_thread_pool(Options.AsyncQueueSize, 1);
+            Logger = std::make_shared<spdlog::async_logger>(
+                "*", FileSink, spdlog::thread_pool(),
+                spdlog::async_overflow_policy::block);
+         } else {
+            Logger = std::make_shared<spdlog::logger>("*", FileSink);
+         }
+      }
+
+      initLogging(Logger);
+
+   } catch (spdlog::spdlog_ex const &Ex) {
+      std::cout << "Log init failed: " << Ex.what() << std::endl;
+   }
+}
+
+void finalizeLogging() {
+
+   // Shutting down drains the queue of an asynchronous logger
+   spdlog::default_logger()->flush();
+   spdlog::shutdown();
+
+   auto NullSink = std::make_shared<spdlog::sinks::null_sink_mt>();
+   spdlog::set_default_logger(std::make_shared<spdlog::logger>("*", NullSink));
+}
+
 } // namespace OMEGA
@@ -13,12 +13,60 @@
 #include "LogFormatters.h"
 #include <spdlog/spdlog.h>
 
+#include <string>
+#include <vector>
+
 namespace OMEGA {
 
 const std::string OmegaDefaultLogfile = "omega.log";
 
+/// Options for the logger created by initLogging. The defaults reproduce a
+/// synchronous logger writing a single file from every task.
+struct LogOptions {
+   /// MPI tasks that write log messages
+   enum TaskFilter {
+      AllTasks,     ///< every task logs
+      MasterTask,   ///< only the master task logs
+      EveryNthTask, ///< tasks that are a multiple of TaskStride log
+      ListedTasks   ///< tasks in TaskList log
+   };
+
+   TaskFilter Tasks = AllTasks; ///< which tasks log
+   int TaskStride   = 1;        ///< stride for EveryNthTask
+   std::vector<int> TaskList;   ///< tasks for ListedTasks
+
+   /// Each logging task writes its own file with the task number appended
+   /// to the file name. Messages stay buffered until a flush.
+   bool PerTaskFiles = false;
+
+   /// Messages are formatted and written by a background thread so that
+   /// logging calls do not block on file IO
+   bool Async                 = false;
+   std::size_t AsyncQueueSize = 8192; ///< messages queued before blocking
+};
+
 void initLogging(std::shared_ptr<spdlog::logger> Logger);
 void initLogging(std::string const &LogFilePath);
+
+/// Creates the default logger for this task according to the options.
+/// Tasks excluded by the task filter write no log file but still report
+/// errors to stderr.
+void initLogging(std::string const &LogFilePath, ///< [in] log file
+                 const LogOptions &Options,      ///< [in] logger options
+                 int MyTask,                     ///< [in] this MPI task
+                 int MasterTask = 0              ///< [in] master MPI task
+);
+
+/// Returns true if the given task writes log messages under the options
+bool isLoggingTask(const LogOptions &Options, ///< [in] logger options
+                   int MyTask,                ///< [in] this MPI task
+                   int MasterTask = 0         ///< [in] master MPI task
+);
+
+/// Flushes all pending messages, including those queued by an asynchronous
+/// logger, and replaces the default logger with one that discards messages
+void finalizeLogging();
+
 } // namespace OMEGA
 
 #define LOG_LEVEL_TRACE    SPDLOG_LEVEL_TRACE
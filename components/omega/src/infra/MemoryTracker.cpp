@@ -0,0 +1,282 @@
+//===-- infra/MemoryTracker.cpp - memory usage tracking ---------*- C++ -*-===//
+//
+// The Kokkos allocation callbacks charge each allocation to the innermost
+// subsystem scope and to the Total subsystem of its memory space, and record
+// the subsystem of each live allocation by address so that the deallocation
+// is charged to the same subsystem. Allocations made before tracking started
+// are not in the table and are ignored when freed. At print, each task
+// serializes its usage records and the master task gathers them to compute
+// the statistics across tasks.
+//
+//===----------------------------------------------------------------------===//
+
+#include "MemoryTracker.h"
+#include "Config.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace OMEGA {
+
+// Static members
+std::map<std::pair<std::string, std::string>, MemoryTracker::Usage>
+    MemoryTracker::Usages;
+std::map<const void *, MemoryTracker::Allocation> MemoryTracker::Allocations;
+std::vector<std::string> MemoryTracker::Scopes;
+bool MemoryTracker::Enabled = false;
+
+namespace {
+
+// Statistics of one usage record across tasks
+struct UsageStats {
+   I8 MinCurrent{std::numeric_limits<I8>::max()};
+   I8 MaxCurrent{0};
+   I8 MinPeak{std::numeric_limits<I8>::max()};
+   I8 MaxPeak{0};
+   int MaxPeakTask{0};
+   I4 NumTasks{0};
+};
+
+// Converts bytes to MB
+R8 toMB(I8 Bytes) { return Bytes / (1024.0 * 1024.0); }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Read the tracker options and register the allocation callbacks
+
+int MemoryTracker::init() {
+
+   int Err = 0;
+
+   bool Enable = true;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("MemoryTracker")) {
+      Config TrackerConfig("MemoryTracker");
+      Err = OmegaConfig->get(TrackerConfig);
+      if (Err != 0) {
+         LOG_ERROR("MemoryTracker: error retrieving MemoryTracker "
+                   "configuration");
+         return Err;
+      }
+      if (TrackerConfig.existsVar("Enable"))
+         Err += TrackerConfig.get("Enable", Enable);
+   }
+
+   if (!Enable || Enabled)
+      return Err;
+
+   if (Kokkos::Profiling::profileLibraryLoaded()) {
+      LOG_INFO("MemoryTracker: Kokkos Tools library loaded, memory tracking "
+               "disabled");
+      return Err;
+   }
+
+   Kokkos::Tools::Experimental::set_allocate_data_callback(allocateCallback);
+   Kokkos::Tools::Experimental::set_deallocate_data_callback(
+       deallocateCallback);
+   Enabled = true;
+
+   return Err;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Unregister the callbacks and remove all records
+
+void MemoryTracker::finalize() {
+
+   if (Enabled) {
+      Kokkos::Tools::Experimental::set_allocate_data_callback(nullptr);
+      Kokkos::Tools::Experimental::set_deallocate_data_callback(nullptr);
+      Enabled = false;
+   }
+
+   Usages.clear();
+   Allocations.clear();
+   Scopes.clear();
+
+} // end finalize
+
+//------------------------------------------------------------------------------
+// Return true if tracking is enabled
+
+bool MemoryTracker::isEnabled() { return Enabled; }
+
+//------------------------------------------------------------------------------
+// Start and end subsystem scopes
+
+void MemoryTracker::pushScope(const std::string &Name // [in] subsystem name
+) {
+   Scopes.push_back(Name);
+}
+
+void MemoryTracker::popScope() {
+   if (!Scopes.empty())
+      Scopes.pop_back();
+}
+
+//------------------------------------------------------------------------------
+// Gather the usage of all tasks on the master task and log the statistics
+
+int MemoryTracker::print(const std::string &Stage // [in] stage of the run
+) {
+
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+   MPI_Comm Comm   = DefEnv->getComm();
+   int NumTasks    = DefEnv->getNumTasks();
+   int MasterTask  = DefEnv->getMasterTask();
+   bool IsMaster   = DefEnv->isMasterTask();
+
+   // Serialize the local records as lines of subsystem and space names and
+   // pairs of current and peak usage
+   std::string Names;
+   std::vector<I8> Values;
+   for (const auto &[Key, Use] : Usages) {
+      Names += Key.first + "\t" + Key.second + "\n";
+      Values.push_back(Use.Current);
+      Values.push_back(Use.Peak);
+   }
+
+   int NameLen = Names.size();
+   int NValues = Values.size();
+   std::vector<int> NameLens(NumTasks);
+   std::vector<int> ValueLens(NumTasks);
+   MPI_Gather(&NameLen, 1, MPI_INT, NameLens.data(), 1, MPI_INT, MasterTask,
+              Comm);
+   MPI_Gather(&NValues, 1, MPI_INT, ValueLens.data(), 1, MPI_INT, MasterTask,
+              Comm);
+
+   std::vector<int> NameDispls(NumTasks, 0);
+   std::vector<int> ValueDispls(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task) {
+      NameDispls[Task]  = NameDispls[Task - 1] + NameLens[Task - 1];
+      ValueDispls[Task] = ValueDispls[Task - 1] + ValueLens[Task - 1];
+   }
+   std::vector<char> AllNames;
+   std::vector<I8> AllValues;
+   if (IsMaster) {
+      AllNames.resize(NameDispls[NumTasks - 1] + NameLens[NumTasks - 1]);
+      AllValues.resize(ValueDispls[NumTasks - 1] + ValueLens[NumTasks - 1]);
+   }
+   MPI_Gatherv(Names.data(), NameLen, MPI_CHAR, AllNames.data(),
+               NameLens.data(), NameDispls.data(), MPI_CHAR, MasterTask, Comm);
+   MPI_Gatherv(Values.data(), NValues, MPI_INT64_T, AllValues.data(),
+               ValueLens.data(), ValueDispls.data(), MPI_INT64_T, MasterTask,
+               Comm);
+
+   if (!IsMaster)
+      return 0;
+
+   if (!Enabled) {
+      LOG_INFO("Memory usage at {}: tracking disabled", Stage);
+      return 0;
+   }
+
+   // Compute the statistics of each record over the tasks that have it
+   std::map<std::pair<std::string, std::string>, UsageStats> Stats;
+   for (int Task = 0; Task < NumTasks; ++Task) {
+      std::stringstream TaskNames(std::string(
+          AllNames.data() + NameDispls[Task], NameLens[Task]));
+      std::string Line;
+      int Index = 0;
+      while (std::getline(TaskNames, Line)) {
+         const size_t Tab = Line.find('\t');
+         UsageStats &Stat = Stats[{Line.substr(0, Tab), Line.substr(Tab + 1)}];
+         const I8 Current = AllValues[ValueDispls[Task] + 2 * Index];
+         const I8 Peak    = AllValues[ValueDispls[Task] + 2 * Index + 1];
+         Stat.MinCurrent  = std::min(Stat.MinCurrent, Current);
+         Stat.MaxCurrent  = std::max(Stat.MaxCurrent, Current);
+         Stat.MinPeak     = std::min(Stat.MinPeak, Peak);
+         if (Peak >= Stat.MaxPeak) {
+            Stat.MaxPeak     = Peak;
+            Stat.MaxPeakTask = Task;
+         }
+         ++Stat.NumTasks;
+         ++Index;
+      }
+   }
+
+   LOG_INFO("Memory usage (MB) at {}:", Stage);
+   LOG_INFO("{:<24} {:<16} {:>6} {:>12} {:>12} {:>12} {:>12} {:>8}",
+            "Subsystem", "Space", "Tasks", "Min current", "Max current",
+            "Min peak", "Max peak", "Max task");
+   for (const auto &[Key, Stat] : Stats) {
+      LOG_INFO("{:<24} {:<16} {:>6} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} "
+               "{:>8}",
+               Key.first, Key.second, Stat.NumTasks, toMB(Stat.MinCurrent),
+               toMB(Stat.MaxCurrent), toMB(Stat.MinPeak), toMB(Stat.MaxPeak),
+               Stat.MaxPeakTask);
+   }
+
+   return 0;
+
+} // end print
+
+//------------------------------------------------------------------------------
+// Current and peak usage of a subsystem on the local task
+
+I8 MemoryTracker::getCurrent(const std::string &Subsystem, // [in] subsystem
+                             const std::string &Space      // [in] memory space
+) {
+   auto It = Usages.find({Subsystem, Space});
+   return It == Usages.end() ? 0 : It->second.Current;
+}
+
+I8 MemoryTracker::getPeak(const std::string &Subsystem, // [in] subsystem
+                          const std::string &Space      // [in] memory space
+) {
+   auto It = Usages.find({Subsystem, Space});
+   return It == Usages.end() ? 0 : It->second.Peak;
+}
+
+//------------------------------------------------------------------------------
+// Add to or remove from a usage record
+
+void MemoryTracker::addUsage(const std::string &Subsystem,
+                             const std::string &Space, I8 Size) {
+   Usage &Use = Usages[{Subsystem, Space}];
+   Use.Current += Size;
+   Use.Peak = std::max(Use.Peak, Use.Current);
+}
+
+//------------------------------------------------------------------------------
+// Kokkos Tools callbacks
+
+void MemoryTracker::allocateCallback(
+    const Kokkos::Profiling::SpaceHandle Handle, const char *Label,
+    const void *Ptr, const uint64_t Size) {
+
+   Allocation &Alloc = Allocations[Ptr];
+   Alloc.Subsystem   = Scopes.empty() ? "Other" : Scopes.back();
+   Alloc.Space       = Handle.name;
+   Alloc.Size        = static_cast<I8>(Size);
+
+   addUsage(Alloc.Subsystem, Alloc.Space, Alloc.Size);
+   addUsage("Total", Alloc.Space, Alloc.Size);
+
+} // end allocateCallback
+
+void MemoryTracker::deallocateCallback(
+    const Kokkos::Profiling::SpaceHandle Handle, const char *Label,
+    const void *Ptr, const uint64_t Size) {
+
+   auto It = Allocations.find(Ptr);
+   if (It == Allocations.end())
+      return;
+
+   const Allocation &Alloc = It->second;
+   addUsage(Alloc.Subsystem, Alloc.Space, -Alloc.Size);
+   addUsage("Total", Alloc.Space, -Alloc.Size);
+   Allocations.erase(It);
+
+} // end deallocateCallback
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,132 @@
+#ifndef OMEGA_MEMORYTRACKER_H
+#define OMEGA_MEMORYTRACKER_H
+//===-- infra/MemoryTracker.h - memory usage tracking -----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the tracking of host and device memory usage
+///
+/// The MemoryTracker class records the current and peak memory used by all
+/// Kokkos allocations in each memory space, charged to the Omega subsystem
+/// (eg HorzMesh, Decomp, Halo) that made the allocation. Allocations are
+/// observed through the Kokkos Tools allocation callbacks, so every labelled
+/// view is tracked without changes to the view types. The subsystem of an
+/// allocation is the innermost active MemoryScope, or Other if none is
+/// active. The usage statistics across tasks are printed at chosen stages of
+/// a run (eg after initialization and at finalize) to size jobs.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OMEGA {
+
+/// The MemoryTracker class holds the memory usage of each subsystem and
+/// memory space. All methods are static. Tracking is disabled if a Kokkos
+/// Tools library is loaded, since the library owns the allocation callbacks.
+class MemoryTracker {
+
+ public:
+   /// Reads the MemoryTracker configuration group (if present) and, unless
+   /// disabled, registers the Kokkos allocation callbacks. Must be called
+   /// after Kokkos is initialized. Returns an error code.
+   static int init();
+
+   /// Unregisters the allocation callbacks and removes all usage records
+   static void finalize();
+
+   /// Returns true if allocations are being tracked
+   static bool isEnabled();
+
+   /// Makes Name the subsystem charged for new allocations until the
+   /// matching popScope. Scopes can be nested.
+   static void pushScope(const std::string &Name ///< [in] subsystem name
+   );
+
+   /// Ends the innermost subsystem scope
+   static void popScope();
+
+   /// Gathers the usage of all tasks in the default environment and logs,
+   /// from the master task, the min and max across tasks of the current and
+   /// peak usage of each subsystem and memory space, labelled with Stage.
+   /// This is a collective call. Returns an error code.
+   static int print(const std::string &Stage ///< [in] stage of the run
+   );
+
+   /// Returns the current usage in bytes on the local task of Subsystem in
+   /// the memory space Space (eg Host, Cuda). The subsystem Total holds the
+   /// usage of all subsystems.
+   static I8 getCurrent(const std::string &Subsystem, ///< [in] subsystem
+                        const std::string &Space      ///< [in] memory space
+   );
+
+   /// Returns the peak usage in bytes on the local task of Subsystem in the
+   /// memory space Space
+   static I8 getPeak(const std::string &Subsystem, ///< [in] subsystem
+                     const std::string &Space      ///< [in] memory space
+   );
+
+ private:
+   /// Current and peak usage in bytes
+   struct Usage {
+      I8 Current{0}; ///< bytes currently allocated
+      I8 Peak{0};    ///< maximum of Current
+   };
+
+   /// Subsystem, memory space and size of a live allocation
+   struct Allocation {
+      std::string Subsystem; ///< subsystem charged for the allocation
+      std::string Space;     ///< memory space of the allocation
+      I8 Size{0};            ///< bytes allocated
+   };
+
+   /// Adds (Size > 0) or removes (Size < 0) bytes from a usage record
+   static void addUsage(const std::string &Subsystem, const std::string &Space,
+                        I8 Size);
+
+   /// Kokkos Tools allocation callbacks
+   static void allocateCallback(const Kokkos::Profiling::SpaceHandle Handle,
+                                const char *Label, const void *Ptr,
+                                const uint64_t Size);
+   static void deallocateCallback(const Kokkos::Profiling::SpaceHandle Handle,
+                                  const char *Label, const void *Ptr,
+                                  const uint64_t Size);
+
+   /// Usage by subsystem and memory space
+   static std::map<std::pair<std::string, std::string>, Usage> Usages;
+
+   /// Live allocations by address
+   static std::map<const void *, Allocation> Allocations;
+
+   /// Stack of active subsystem scopes
+   static std::vector<std::string> Scopes;
+
+   /// True if the allocation callbacks are registered
+   static bool Enabled;
+
+}; // end class MemoryTracker
+
+/// Charges the allocations made during the lifetime of the object to a
+/// subsystem, eg at the top of a constructor
+class MemoryScope {
+ public:
+   explicit MemoryScope(const std::string &Name ///< [in] subsystem name
+   ) {
+      MemoryTracker::pushScope(Name);
+   }
+
+   ~MemoryScope() { MemoryTracker::popScope(); }
+
+   MemoryScope(const MemoryScope &)            = delete;
+   MemoryScope &operator=(const MemoryScope &) = delete;
+};
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_MEMORYTRACKER_H
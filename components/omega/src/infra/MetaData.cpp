@@ -13,7 +13,7 @@
 
 namespace OMEGA {
 
-std::map<std::string, std::shared_ptr<MetaData>> MetaData::AllFields;
+std::unordered_map<std::string, std::shared_ptr<MetaData>> MetaData::AllFields;
 std::map<std::string, std::shared_ptr<MetaDim>> MetaDim::AllDims;
 std::map<std::string, std::shared_ptr<MetaGroup>> MetaGroup::AllGroups;
 
@@ -106,12 +106,13 @@ int MetaData::destroy(const std::string Name /// Name of field to remove
 
 std::shared_ptr<MetaData> MetaData::get(const std::string Name /// Name of field
 ) {
-   if (!has(Name)) {
+   auto It = AllFields.find(Name);
+   if (It == AllFields.end()) {
       throw std::runtime_error("Failed to retrieve a field instance because '" +
                                Name + "' does not exist.");
    }
 
-   return AllFields[Name];
+   return It->second;
 }
 
 bool MetaData::hasEntry(const std::string Name // Name of metadata
@@ -157,100 +158,71 @@ int MetaData::removeEntry(const std::string Name /// Name of metadata to remove
    return RetVal;
 }
 
-int MetaData::getEntry(const std::string Name, /// Name of metadata to get
-                       I4 &Value               /// I4 Value of metadata
-) {
-   int RetVal = 0;
+// Retrieves an entry with a single lookup in the metadata map. The value is
+// retrieved with a checked cast so that an entry of another type returns an
+// error code rather than throwing.
+template <typename T>
+int MetaData::getTypedEntry(const std::string &Name, // Name of metadata
+                            T &Value                 // Value of metadata
+) const {
 
-   if (!hasEntry(Name)) {
+   auto It = MetaMap.find(Name);
+   if (It == MetaMap.end()) {
       LOG_ERROR("Metadata '" + Name + "' does not exist.");
-      RetVal = -1;
+      return -1;
+   }
 
-   } else {
-      Value = std::any_cast<I4>(MetaMap[Name]);
+   const T *TypedValue = std::any_cast<T>(&It->second);
+   if (TypedValue == nullptr) {
+      LOG_ERROR("Metadata '" + Name + "' has a different type.");
+      return -2;
    }
 
-   return RetVal;
+   Value = *TypedValue;
+   return 0;
 }
 
 int MetaData::getEntry(const std::string Name, /// Name of metadata to get
-                       I8 &Value               /// I8 Value of metadata
+                       I4 &Value               /// I4 Value of metadata
 ) {
-   int RetVal = 0;
-
-   if (!hasEntry(Name)) {
-      LOG_ERROR("Metadata '" + Name + "' does not exist.");
-      RetVal = -1;
-
-   } else {
-      Value = std::any_cast<I8>(MetaMap[Name]);
-   }
+   return getTypedEntry(Name, Value);
+}
 
-   return RetVal;
+int MetaData::getEntry(const std::string Name, /// Name of metadata to get
+                       I8 &Value               /// I8 Value of metadata
+) {
+   return getTypedEntry(Name, Value);
 }
 
 int MetaData::getEntry(const std::string Name, /// Name of metadata to get
                        R4 &Value               /// R4 Value of metadata
 ) {
-   int RetVal = 0;
-
-   if (!hasEntry(Name)) {
-      LOG_ERROR("Metadata '" + Name + "' does not exist.");
-      RetVal = -1;
-
-   } else {
-      Value = std::any_cast<R4>(MetaMap[Name]);
-   }
-
-   return RetVal;
+   return getTypedEntry(Name, Value);
 }
 
 int MetaData::getEntry(const std::string Name, /// Name of metadata to get
                        R8 &Value               /// R8 Value of metadata
 ) {
-   int RetVal = 0;
-
-   if (!hasEntry(Name)) {
-      LOG_ERROR("Metadata '" + Name + "' does not exist.");
-      RetVal = -1;
-
-   } else {
-      Value = std::any_cast<R8>(MetaMap[Name]);
-   }
-
-   return RetVal;
+   return getTypedEntry(Name, Value);
 }
 
 int MetaData::getEntry(const std::string Name, /// Name of metadata to get
                        bool &Value             /// Bool Value of metadata
 ) {
-   int RetVal = 0;
-
-   if (!hasEntry(Name)) {
-      LOG_ERROR("Metadata '" + Name + "' does not exist.");
-      RetVal = -1;
-
-   } else {
-      Value = std::any_cast<bool>(MetaMap[Name]);
-   }
-
-   return RetVal;
+   return getTypedEntry(Name, Value);
 }
 
 int MetaData::getEntry(const std::string Name, /// Name of metadata to get
                        std::string &Value      /// String Value of metadata
 ) {
-   int RetVal = 0;
-
-   if (!hasEntry(Name)) {
-      LOG_ERROR("Metadata '" + Name + "' does not exist.");
-      RetVal = -1;
-
-   } else {
-      Value = std::any_cast<std::string>(MetaMap[Name]);
-   }
+   return getTypedEntry(Name, Value);
+}
 
-   return RetVal;
+int MetaData::getEntry(
+    const std::string Name,                      /// Name of metadata to get
+    std::vector<std::shared_ptr<MetaDim>> &Value /// Dimensions of field
+) {
+   return getTypedEntry(Name, Value);
 }
 
 std::map<std::string, std::any> *MetaData::getAllEntries() { return &MetaMap; }
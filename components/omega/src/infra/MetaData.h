@@ -11,6 +11,9 @@
 #include "DataTypes.h"
 #include <any>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace OMEGA {
 
@@ -51,8 +54,16 @@ class MetaData {
    /// metadata stored in map
    std::map<std::string, std::any> MetaMap;
 
-   /// Store and maintain all defined metadata in this vector
-   static std::map<std::string, std::shared_ptr<MetaData>> AllFields;
+   /// Store and maintain all defined metadata, hashed by name for fast
+   /// retrieval
+   static std::unordered_map<std::string, std::shared_ptr<MetaData>> AllFields;
+
+   /// Retrieves an entry of a given type with a single map lookup. Returns
+   /// -1 if the entry does not exist and -2 if it has a different type.
+   template <typename T>
+   int getTypedEntry(const std::string &MetaName, /// Name of metadata to get
+                     T &Value                     /// Value of metadata
+   ) const;
 
  public:
    static std::shared_ptr<MetaData>
@@ -107,6 +118,11 @@ class MetaData {
                 std::string &Value          /// string Value of metadata
    );
 
+   int getEntry(
+       const std::string MetaName,                  /// Name of metadata to get
+       std::vector<std::shared_ptr<MetaDim>> &Value /// Dimensions of field
+   );
+
    /// returns the pointer to the metadata map
    std::map<std::string, std::any> *getAllEntries();
 };
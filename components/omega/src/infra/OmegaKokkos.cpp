@@ -0,0 +1,576 @@
+//===-- infra/OmegaKokkos.cpp - Omega extension of Kokkos -------*- C++ -*-===//
+//
+// The ExecInstances class holds the pool of named execution space instances
+// used to overlap independent kernels and copies. The KernelTiles class holds
+// the per-kernel tile sizes used by the multi-dimensional parallelFor and
+// parallelReduce launches. Tiles are read from the KernelTiles group of the
+// Omega configuration, for example
+//
+//    KernelTiles:
+//       Autotune: false
+//       AutotuneTrials: 3
+//       Tiles:
+//          computeVelTend: [1, 128]
+//          computeThickTend: [2, 64]
+//
+// and can optionally be autotuned during the first launches of each kernel.
+// The ScratchArena class holds the buffer of the scratch arrays, sized from
+// the ScratchArena group of the configuration, eg.
+//
+//    ScratchArena:
+//       Size: 512
+//
+// for a 512 MB buffer on each task. The KernelGraph class holds the kernel
+// graphs captured from fixed sequences of kernels.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OmegaKokkos.h"
+#include "Config.h"
+#include "Logging.h"
+#include "MachEnv.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#if defined(KOKKOS_ENABLE_CUDA)
+#include <cuda_runtime.h>
+#elif defined(KOKKOS_ENABLE_HIP)
+#include <hip/hip_runtime.h>
+#endif
+
+namespace OMEGA {
+
+// Static members
+const std::string ExecInstances::Compute = "Compute";
+const std::string ExecInstances::Comm    = "Comm";
+const std::string ExecInstances::IO      = "IO";
+std::map<std::string, ExecSpace> ExecInstances::Instances;
+
+std::map<std::string, std::vector<int>> KernelTiles::Tiles;
+std::map<std::string, KernelTiles::TuneState> KernelTiles::Tuning;
+bool KernelTiles::Autotune = false;
+int KernelTiles::NTrials   = 1;
+
+Kokkos::View<char *, MemSpace> ScratchArena::Buffer;
+std::vector<ScratchArena::Overflow> ScratchArena::Overflows;
+I8 ScratchArena::Used       = 0;
+I8 ScratchArena::HighWater  = 0;
+I8 ScratchArena::NOverflows = 0;
+bool ScratchArena::HookSet  = false;
+
+std::map<std::string, KernelGraph::Graph> KernelGraph::Graphs;
+std::set<std::string> KernelGraph::NotCapturable;
+std::optional<KernelGraph::Node> KernelGraph::Tail;
+bool KernelGraph::Capturing = false;
+bool KernelGraph::Aborted   = false;
+bool KernelGraph::HookSet   = false;
+
+namespace {
+
+// Alignment of the scratch arrays, enough for coalesced device access and
+// for the vector loads of any array type
+constexpr I8 ScratchAlign = 256;
+
+} // end anonymous namespace
+
+namespace {
+
+// Tile lengths tried when autotuning along the contiguous dimension of the
+// memory layout and along the adjacent dimension
+const std::vector<int> InnerLengths = {16, 32, 64, 128, 256};
+const std::vector<int> OuterLengths = {1, 2, 4};
+
+// Returns the candidate tiles for an N-dimensional kernel. All other
+// dimensions have a tile length of one, as in DefaultTile.
+std::vector<std::vector<int>> candidateTiles(const int N) {
+
+#if OMEGA_LAYOUT_RIGHT
+   const int InnerDim = N - 1;
+   const int OuterDim = N - 2;
+#else
+   const int InnerDim = 0;
+   const int OuterDim = 1;
+#endif
+
+   std::vector<std::vector<int>> Candidates;
+   for (int Outer : OuterLengths) {
+      for (int Inner : InnerLengths) {
+         std::vector<int> Tile(N, 1);
+         Tile[InnerDim] = Inner;
+         Tile[OuterDim] = Outer;
+         Candidates.push_back(Tile);
+      }
+   }
+   return Candidates;
+
+} // end candidateTiles
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Returns the instance Name, creating it from the default instance if it is
+// not in the pool. The pool is released by a finalize hook, since instances
+// must be destroyed before Kokkos is finalized.
+
+const ExecSpace &ExecInstances::get(const std::string &Name // [in] name
+) {
+
+   auto It = Instances.find(Name);
+   if (It != Instances.end())
+      return It->second;
+
+   if (Instances.empty())
+      Kokkos::push_finalize_hook(ExecInstances::clear);
+
+   ExecSpace Instance =
+       Kokkos::Experimental::partition_space(ExecSpace(), 1)[0];
+   return Instances.emplace(Name, Instance).first->second;
+
+} // end get
+
+//------------------------------------------------------------------------------
+// Wait for the work on one instance
+
+void ExecInstances::fence(const std::string &Name // [in] name
+) {
+   auto It = Instances.find(Name);
+   if (It != Instances.end())
+      It->second.fence("OMEGA::ExecInstances::fence: " + Name);
+}
+
+//------------------------------------------------------------------------------
+// Wait for the work on all instances
+
+void ExecInstances::fenceAll() {
+   for (auto &[Name, Instance] : Instances)
+      Instance.fence("OMEGA::ExecInstances::fence: " + Name);
+}
+
+//------------------------------------------------------------------------------
+// Release all instances
+
+void ExecInstances::clear() { Instances.clear(); }
+
+//------------------------------------------------------------------------------
+// Read the tile table and autotuning options from the configuration
+
+int KernelTiles::init() {
+
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("KernelTiles"))
+      return Err;
+
+   Config TilesConfig("KernelTiles");
+   Err = OmegaConfig->get(TilesConfig);
+   if (Err != 0) {
+      LOG_ERROR("KernelTiles: error retrieving KernelTiles configuration");
+      return Err;
+   }
+
+   bool EnableAutotune = false;
+   I4 InTrials         = 1;
+   if (TilesConfig.existsVar("Autotune"))
+      Err += TilesConfig.get("Autotune", EnableAutotune);
+   if (TilesConfig.existsVar("AutotuneTrials"))
+      Err += TilesConfig.get("AutotuneTrials", InTrials);
+   setAutotune(EnableAutotune, InTrials);
+
+   if (TilesConfig.existsGroup("Tiles")) {
+      Config TileTable("Tiles");
+      Err += TilesConfig.get(TileTable);
+      for (auto It = TileTable.begin(); It != TileTable.end(); ++It) {
+         std::string Label;
+         std::vector<I4> Tile;
+         if (Config::getName(It, Label) != 0 ||
+             TileTable.get(Label, Tile) != 0 || Tile.empty()) {
+            LOG_ERROR("KernelTiles: invalid tile entry {}", Label);
+            ++Err;
+            continue;
+         }
+         setTile(Label, Tile);
+      }
+   }
+
+   LOG_INFO("KernelTiles: {} kernel tiles read, autotuning {}", Tiles.size(),
+            Autotune ? "on" : "off");
+
+   return Err;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Set the tile for a kernel
+
+void KernelTiles::setTile(const std::string &Label,    // [in] kernel label
+                          const std::vector<int> &Tile // [in] tile sizes
+) {
+   Tiles[Label] = Tile;
+}
+
+//------------------------------------------------------------------------------
+// Enable or disable autotuning
+
+void KernelTiles::setAutotune(const bool Enable, // [in] enable autotuning
+                              const int InTrials // [in] launches per tile
+) {
+   Autotune = Enable;
+   NTrials  = InTrials > 0 ? InTrials : 1;
+   if (!Autotune)
+      Tuning.clear();
+}
+
+//------------------------------------------------------------------------------
+// Select the candidate tile for an autotuning trial. Kernels without a label
+// or with a tile in the table are not tuned. Candidates are cycled through
+// so that each is timed once in every pass over the candidates.
+
+bool KernelTiles::startTrial(const std::string &Label, // [in] kernel label
+                             const int N,              // [in] kernel rank
+                             int *Tile                 // [out] candidate tile
+) {
+
+   if (Label.empty() || Tiles.find(Label) != Tiles.end())
+      return false;
+
+   TuneState &State = Tuning[Label];
+   if (State.Candidates.empty()) {
+      State.Candidates = candidateTiles(N);
+      State.Times.assign(State.Candidates.size(), 0.0);
+   }
+
+   const std::vector<int> &Candidate =
+       State.Candidates[State.NLaunches % State.Candidates.size()];
+   for (int Dim = 0; Dim < N; ++Dim)
+      Tile[Dim] = Candidate[Dim];
+
+   return true;
+
+} // end startTrial
+
+//------------------------------------------------------------------------------
+// Record the time of a trial and select the fastest tile once every
+// candidate has been timed NTrials times
+
+void KernelTiles::endTrial(const std::string &Label, // [in] kernel label
+                           const double Time         // [in] launch time
+) {
+
+   auto It = Tuning.find(Label);
+   if (It == Tuning.end())
+      return;
+   TuneState &State = It->second;
+
+   const int NCandidates = State.Candidates.size();
+   State.Times[State.NLaunches % NCandidates] += Time;
+   ++State.NLaunches;
+   if (State.NLaunches < NCandidates * NTrials)
+      return;
+
+   int Best        = 0;
+   double BestTime = std::numeric_limits<double>::max();
+   for (int Cand = 0; Cand < NCandidates; ++Cand) {
+      if (State.Times[Cand] < BestTime) {
+         BestTime = State.Times[Cand];
+         Best     = Cand;
+      }
+   }
+   setTile(Label, State.Candidates[Best]);
+   LOG_INFO("KernelTiles: autotuned kernel {} in {} launches, mean time {} s",
+            Label, State.NLaunches, BestTime / NTrials);
+   Tuning.erase(It);
+
+} // end endTrial
+
+//------------------------------------------------------------------------------
+// Write the tile table in the format of the configuration file. Only the
+// master task writes the file.
+
+int KernelTiles::write(const std::string &FileName // [in] output file
+) {
+
+   int Err         = 0;
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+   if (!DefEnv->isMasterTask())
+      return Err;
+
+   std::ofstream OutFile(FileName);
+   if (!OutFile.good()) {
+      LOG_ERROR("KernelTiles: unable to open {} for writing", FileName);
+      return 1;
+   }
+
+   OutFile << "omega:" << std::endl;
+   OutFile << "   KernelTiles:" << std::endl;
+   OutFile << "      Tiles:" << std::endl;
+   for (const auto &[Label, Tile] : Tiles) {
+      OutFile << "         " << Label << ": [";
+      for (size_t Dim = 0; Dim < Tile.size(); ++Dim)
+         OutFile << (Dim > 0 ? ", " : "") << Tile[Dim];
+      OutFile << "]" << std::endl;
+   }
+   OutFile.close();
+   if (!OutFile) {
+      LOG_ERROR("KernelTiles: error writing {}", FileName);
+      Err = 1;
+   }
+
+   return Err;
+
+} // end write
+
+//------------------------------------------------------------------------------
+// Remove all tiles and autotuning state
+
+void KernelTiles::clear() {
+   Tiles.clear();
+   Tuning.clear();
+   Autotune = false;
+   NTrials  = 1;
+}
+
+//------------------------------------------------------------------------------
+// Allocate the scratch buffer from the configuration
+
+int ScratchArena::init() {
+
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("ScratchArena"))
+      return Err;
+
+   Config ArenaConfig("ScratchArena");
+   Err = OmegaConfig->get(ArenaConfig);
+   if (Err != 0) {
+      LOG_ERROR("ScratchArena: error retrieving ScratchArena configuration");
+      return Err;
+   }
+
+   I4 SizeMB = 0;
+   if (ArenaConfig.existsVar("Size"))
+      Err += ArenaConfig.get("Size", SizeMB);
+   if (Err == 0 && SizeMB > 0)
+      Err += reserve(static_cast<I8>(SizeMB) * 1024 * 1024);
+
+   return Err;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Grow the buffer, which is only possible when no scratch array is in use
+
+int ScratchArena::reserve(const I8 Bytes // [in] buffer size in bytes
+) {
+
+   if (Bytes <= getCapacity())
+      return 0;
+   if (Used != 0) {
+      LOG_ERROR("ScratchArena: can not grow the buffer while {} bytes are in "
+                "use",
+                Used);
+      return 1;
+   }
+
+   if (!HookSet) {
+      Kokkos::push_finalize_hook(ScratchArena::clear);
+      HookSet = true;
+   }
+   Buffer = Kokkos::View<char *, MemSpace>();
+   Buffer = Kokkos::View<char *, MemSpace>(
+       Kokkos::view_alloc("ScratchArena", Kokkos::WithoutInitializing), Bytes);
+
+   return 0;
+
+} // end reserve
+
+//------------------------------------------------------------------------------
+// Take memory from the top of the stack
+
+void *ScratchArena::allocate(const I8 Bytes) {
+
+   const I8 Offset = Used;
+   const I8 Size   = (Bytes + ScratchAlign - 1) / ScratchAlign * ScratchAlign;
+   Used += Size;
+   HighWater = std::max(HighWater, Used);
+
+   if (Used <= getCapacity())
+      return Buffer.data() + Offset;
+
+   // The request does not fit, so it gets its own memory until it is
+   // released. The buffer is grown when the arena is next empty.
+   if (!HookSet) {
+      Kokkos::push_finalize_hook(ScratchArena::clear);
+      HookSet = true;
+   }
+   ++NOverflows;
+   Overflows.push_back(
+       {Offset, Kokkos::View<char *, MemSpace>(
+                    Kokkos::view_alloc("ScratchOverflow",
+                                       Kokkos::WithoutInitializing),
+                    Size)});
+   return Overflows.back().Mem.data();
+
+} // end allocate
+
+//------------------------------------------------------------------------------
+// Release the arrays above a mark
+
+void ScratchArena::release(const I8 Mark // [in] top of the stack to restore
+) {
+
+   Used = std::min(Used, Mark);
+   while (!Overflows.empty() && Overflows.back().Offset >= Used)
+      Overflows.pop_back();
+
+   if (Used == 0 && HighWater > getCapacity())
+      reserve(HighWater);
+
+} // end release
+
+//------------------------------------------------------------------------------
+// Write the arena statistics to the log
+
+void ScratchArena::report() {
+   LOG_INFO("ScratchArena: capacity {} bytes, high-water {} bytes, {} "
+            "overflow allocations",
+            getCapacity(), HighWater, NOverflows);
+}
+
+//------------------------------------------------------------------------------
+// Release the buffer and reset the statistics
+
+void ScratchArena::clear() {
+   Overflows.clear();
+   Buffer     = Kokkos::View<char *, MemSpace>();
+   Used       = 0;
+   HighWater  = 0;
+   NOverflows = 0;
+   HookSet    = false;
+}
+
+//------------------------------------------------------------------------------
+// Replay a graph, capturing it first if needed. The graph is built on the
+// default instance, which orders it with the kernels launched before and
+// after it.
+
+int KernelGraph::run(const std::string &Name,            // [in] graph name
+                     const std::function<void()> &Kernels // [in] sequence
+) {
+
+   if (Capturing) {
+      LOG_ERROR("KernelGraph: graph {} run during a capture", Name);
+      abortCapture("nested graph " + Name);
+      return 1;
+   }
+
+   if (NotCapturable.count(Name) > 0) {
+      Kernels();
+      return 0;
+   }
+
+   auto It = Graphs.find(Name);
+   if (It != Graphs.end()) {
+      It->second.submit();
+      return 0;
+   }
+
+   if (!HookSet) {
+      Kokkos::push_finalize_hook(KernelGraph::clear);
+      HookSet = true;
+   }
+
+   Capturing = true;
+   Aborted   = false;
+   Graph NewGraph =
+       Kokkos::Experimental::create_graph(ExecSpace(), [&](const auto &Root) {
+          Tail = Root;
+          Kernels();
+       });
+   Capturing = false;
+   Tail.reset();
+
+   if (Aborted) {
+      NotCapturable.insert(Name);
+      return 1;
+   }
+
+   NewGraph.submit();
+   Graphs.emplace(Name, std::move(NewGraph));
+
+   return 0;
+
+} // end run
+
+//------------------------------------------------------------------------------
+// Abort the current capture
+
+void KernelGraph::abortCapture(const std::string &Reason // [in] cause
+) {
+   if (Capturing && !Aborted)
+      LOG_WARN("KernelGraph: capture aborted by {}, the sequence will run "
+               "without a graph",
+               Reason);
+   Aborted = true;
+}
+
+//------------------------------------------------------------------------------
+// Remove graphs
+
+void KernelGraph::erase(const std::string &Name // [in] graph name
+) {
+   Graphs.erase(Name);
+   NotCapturable.erase(Name);
+}
+
+void KernelGraph::clear() {
+   Graphs.clear();
+   NotCapturable.clear();
+   HookSet = false;
+}
+
+//------------------------------------------------------------------------------
+// Number of devices visible to the local task, queried from the vendor
+// runtime since Kokkos is not yet initialized
+
+int getNumDevices() {
+   int NumDevices = 0;
+#if defined(KOKKOS_ENABLE_CUDA)
+   if (cudaGetDeviceCount(&NumDevices) != cudaSuccess)
+      NumDevices = 0;
+#elif defined(KOKKOS_ENABLE_HIP)
+   if (hipGetDeviceCount(&NumDevices) != hipSuccess)
+      NumDevices = 0;
+#endif
+   return NumDevices;
+}
+
+//------------------------------------------------------------------------------
+// Initialize Kokkos with the device chosen from the node-local task ID
+
+void initKokkos(const MachEnv *Env // [in] environment of the tasks
+) {
+
+   Kokkos::InitializationSettings Settings;
+
+   const int NumDevices = getNumDevices();
+   const int DeviceID   = Env->getDeviceID(NumDevices);
+   if (DeviceID >= 0)
+      Settings.set_device_id(DeviceID);
+
+   Kokkos::initialize(Settings);
+
+   if (DeviceID >= 0)
+      LOG_INFO("initKokkos: task {} (node {} task {} of {}) uses device {} "
+               "of {}",
+               Env->getMyTask(), Env->getMyNode(), Env->getMyNodeTask(),
+               Env->getNumNodeTasks(), DeviceID, NumDevices);
+
+} // end initKokkos
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -10,7 +10,16 @@
 //===----------------------------------------------------------------------===//
 
 #include "DataTypes.h"
+#include "MachEnv.h"
+#include <Kokkos_Graph.hpp>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace OMEGA {
 
@@ -41,6 +50,70 @@ void deepCopy(E &space, D &dst, const S &src) {
    Kokkos::deep_copy(space, dst, src);
 }
 
+// Mirror copies enqueued on an execution space instance. The copies are
+// asynchronous with respect to the host and other instances; the instance
+// must be fenced before the mirror is used.
+template <typename V>
+auto createHostMirrorCopy(const ExecSpace &Space, const V &view)
+    -> Kokkos::View<typename V::data_type, HostMemLayout, HostMemSpace> {
+   return Kokkos::create_mirror_view_and_copy(
+       Kokkos::view_alloc(Space, HostMemSpace()), view);
+}
+
+template <typename V>
+auto createDeviceMirrorCopy(const ExecSpace &Space, const V &view)
+    -> Kokkos::View<typename V::data_type, MemLayout, MemSpace> {
+   return Kokkos::create_mirror_view_and_copy(
+       Kokkos::view_alloc(Space, MemSpace()), view);
+}
+
+// Releases the host mirror Host of the device array Dev to free host
+// memory. Nothing is released if the two share memory (host builds) or Dev
+// is not allocated, so that the host data can always be recreated from Dev.
+template <typename H, typename D>
+void releaseHostMirror(H &Host, const D &Dev) {
+   if (Dev.data() != nullptr && Host.data() != Dev.data())
+      Host = H();
+}
+
+/// The ExecInstances class holds a pool of named execution space instances
+/// so that independent work can overlap on the device, eg. tracer kernels
+/// on one instance concurrent with velocity kernels on another, or halo
+/// packing and output staging concurrent with the next computation. On
+/// devices each instance has its own stream; on host backends the instances
+/// may share the default instance. Work on one instance is ordered, but
+/// there is no ordering between instances, so an instance must be fenced
+/// before another instance (or the host) uses its results. The Compute,
+/// Comm and IO instances are predefined names; any other name creates a new
+/// instance on first use. The instances are released when Kokkos is
+/// finalized.
+class ExecInstances {
+
+ public:
+   /// Predefined instance names
+   static const std::string Compute; ///< model computation
+   static const std::string Comm;    ///< halo packing and communication
+   static const std::string IO;      ///< IO staging and transfers
+
+   /// Returns the instance Name, creating it if needed. The reference is
+   /// valid until Kokkos is finalized.
+   static const ExecSpace &get(const std::string &Name ///< [in] name
+   );
+
+   /// Waits for all work on the instance Name to complete
+   static void fence(const std::string &Name ///< [in] name
+   );
+
+   /// Waits for all work on all instances to complete
+   static void fenceAll();
+
+   /// Releases all instances. Called automatically by Kokkos::finalize.
+   static void clear();
+
+ private:
+   static std::map<std::string, ExecSpace> Instances; ///< instances by name
+};
+
 #if OMEGA_LAYOUT_RIGHT
 
 template <int N, class... Args>
@@ -61,54 +134,539 @@ using Bounds = Kokkos::MDRangePolicy<
 
 #endif
 
-// parallelFor: with label
+/// The KernelTiles class holds the tile sizes used by the multi-dimensional
+/// parallelFor and parallelReduce launches, selected by the kernel label.
+/// A kernel with a non-empty label that is found in the tile table uses the
+/// tile from the table instead of the tile given in the code (by default
+/// DefaultTile). The table is read from the KernelTiles group of the Omega
+/// configuration and can also be set directly. In the optional autotuning
+/// mode, each parallelFor with a label not in the table cycles through a
+/// list of candidate tiles during its first launches, timing each launch,
+/// and the fastest tile is then added to the table. Since the tile can
+/// change the order of the sums, parallelReduce kernels are never autotuned
+/// so that reductions remain reproducible.
+class KernelTiles {
+
+ public:
+   /// Reads the tile table and autotuning options from the KernelTiles
+   /// group of the Omega configuration, if present. Returns an error code.
+   static int init();
+
+   /// Sets the tile for the kernel Label
+   static void setTile(const std::string &Label,   ///< [in] kernel label
+                       const std::vector<int> &Tile ///< [in] tile sizes
+   );
+
+   /// Copies the tile of an N-dimensional kernel Label to Tile and returns
+   /// true if the table holds a tile of that rank for the kernel
+   static bool getTile(const std::string &Label, ///< [in] kernel label
+                       const int N,              ///< [in] kernel rank
+                       int *Tile                 ///< [out] tile sizes
+   ) {
+      if (Tiles.empty() || Label.empty())
+         return false;
+      auto It = Tiles.find(Label);
+      if (It == Tiles.end() || static_cast<int>(It->second.size()) != N)
+         return false;
+      for (int Dim = 0; Dim < N; ++Dim)
+         Tile[Dim] = It->second[Dim];
+      return true;
+   }
+
+   /// Enables or disables autotuning. Each candidate tile is timed over
+   /// NTrials launches of a kernel.
+   static void setAutotune(const bool Enable,   ///< [in] enable autotuning
+                           const int NTrials = 1 ///< [in] launches per tile
+   );
+
+   /// Returns true if autotuning is enabled
+   static bool isAutotuning() { return Autotune; }
+
+   /// If the launch of the N-dimensional kernel Label is an autotuning
+   /// trial, copies the candidate tile to Tile and returns true
+   static bool startTrial(const std::string &Label, ///< [in] kernel label
+                          const int N,              ///< [in] kernel rank
+                          int *Tile                 ///< [out] candidate tile
+   );
+
+   /// Records the time of a trial started with startTrial. Once all
+   /// candidates are timed, the fastest tile is added to the table.
+   static void endTrial(const std::string &Label, ///< [in] kernel label
+                        const double Time         ///< [in] launch time (s)
+   );
+
+   /// Writes the tile table to a file in the format of the KernelTiles
+   /// configuration group, eg. to reuse autotuned tiles in later runs.
+   /// Returns an error code.
+   static int write(const std::string &FileName ///< [in] output file
+   );
+
+   /// Removes all tiles and autotuning state
+   static void clear();
+
+ private:
+   /// Autotuning state of a kernel
+   struct TuneState {
+      std::vector<std::vector<int>> Candidates; ///< candidate tiles
+      std::vector<double> Times;                ///< time for each candidate
+      int NLaunches{0};                         ///< number of trial launches
+   };
+
+   static std::map<std::string, std::vector<int>> Tiles; ///< tile table
+   static std::map<std::string, TuneState> Tuning; ///< kernels being tuned
+   static bool Autotune; ///< true if autotuning is enabled
+   static int NTrials;   ///< launches per candidate tile
+};
+
+/// The ScratchArena class holds a preallocated buffer in the memory space of
+/// the Omega arrays from which temporary arrays are taken with a stack (bump)
+/// allocator, so that scratch arrays of the tendency and auxiliary
+/// computations do not allocate device memory, which is slow and
+/// synchronizing on GPUs. Arrays are returned as unmanaged views that are
+/// valid until the ScratchScope open when they were taken is closed, eg. one
+/// scope per time step or per stage, so every step and stage reuses the same
+/// memory. The arena records its high-water mark. A request that does not
+/// fit in the buffer is served by a separate allocation, and the buffer is
+/// grown to the high-water mark the next time the arena is empty, so that
+/// later steps do not allocate. All methods are static and called from the
+/// host. Work on the default execution space is ordered, so memory released
+/// by a scope may be reused by the next kernels without a fence, but arrays
+/// used on other execution space instances must be fenced before their
+/// scope is closed.
+class ScratchArena {
+
+ public:
+   /// Unmanaged array type returned for an Omega array type V
+   template <typename V>
+   using ArrayType =
+       Kokkos::View<typename V::data_type, typename V::array_layout,
+                    typename V::memory_space,
+                    Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+   /// Allocates the buffer with the Size (in MB) of the ScratchArena group of
+   /// the Omega configuration, if present. Returns an error code.
+   static int init();
+
+   /// Grows the buffer to at least Bytes bytes. The arena must be empty.
+   /// Returns an error code.
+   static int reserve(const I8 Bytes ///< [in] buffer size in bytes
+   );
+
+   /// Returns a scratch array of type V with the given extents, eg.
+   /// ScratchArena::get<Array2DReal>(NCellsSize, NVertLevels). The array is
+   /// not initialized.
+   template <typename V, typename... Extents>
+   static ArrayType<V> get(const Extents... Ext) {
+      static_assert(std::is_same_v<typename V::memory_space, MemSpace>,
+                    "Scratch arrays are in the memory space of Omega arrays");
+      const I8 Bytes = ArrayType<V>::required_allocation_size(Ext...);
+      return ArrayType<V>(
+          static_cast<typename V::pointer_type>(allocate(Bytes)), Ext...);
+   }
+
+   /// Returns the current top of the stack, to be passed to release
+   static I8 mark() { return Used; }
+
+   /// Releases all arrays taken since mark returned Mark
+   static void release(const I8 Mark ///< [in] top of the stack to restore
+   );
+
+   /// Bytes currently in use
+   static I8 getUsed() { return Used; }
+
+   /// Largest number of bytes in use at any time
+   static I8 getHighWater() { return HighWater; }
+
+   /// Size of the buffer in bytes
+   static I8 getCapacity() { return Buffer.size(); }
+
+   /// Number of requests that did not fit in the buffer
+   static I8 getNumOverflows() { return NOverflows; }
+
+   /// Writes the capacity, high-water mark and overflows to the log
+   static void report();
+
+   /// Releases the buffer and resets the statistics. Called automatically
+   /// by Kokkos::finalize.
+   static void clear();
+
+ private:
+   /// Returns Bytes bytes, aligned for any array type, from the top of the
+   /// stack or from a separate allocation if they do not fit
+   static void *allocate(const I8 Bytes);
+
+   /// Separate allocation of a request that did not fit in the buffer
+   struct Overflow {
+      I8 Offset;                          ///< stack position of the request
+      Kokkos::View<char *, MemSpace> Mem; ///< allocated memory
+   };
+
+   static Kokkos::View<char *, MemSpace> Buffer; ///< preallocated buffer
+   static std::vector<Overflow> Overflows; ///< outstanding overflow requests
+   static I8 Used;                         ///< top of the stack (bytes)
+   static I8 HighWater;                    ///< largest top of the stack
+   static I8 NOverflows;                   ///< requests not fitting
+   static bool HookSet; ///< true once the finalize hook is registered
+};
+
+/// Releases the scratch arrays taken during its lifetime when it goes out of
+/// scope, eg. at the end of a time step or stage
+class ScratchScope {
+
+ public:
+   ScratchScope() : Mark(ScratchArena::mark()) {}
+   ~ScratchScope() { ScratchArena::release(Mark); }
+
+   ScratchScope(const ScratchScope &)            = delete;
+   ScratchScope &operator=(const ScratchScope &) = delete;
+
+ private:
+   I8 Mark; ///< top of the stack when the scope was opened
+};
+
+/// The KernelGraph class captures a fixed sequence of kernels, eg. the
+/// kernels of a time stepper stage between two halo exchanges, as a
+/// Kokkos graph the first time it is run and replays the graph on later
+/// runs, so that the sequence costs one launch instead of one per kernel.
+/// While a sequence is captured, parallelFor and parallelForTeam add their
+/// kernels to the graph instead of launching them. The kernels are not
+/// executed by the capture itself, which ends by submitting the new graph.
+/// Since a replay only repeats the kernels, a captured sequence must not
+/// depend on host values that change between runs (other than through
+/// the arrays it reads), and the arrays it uses must keep their memory.
+/// Work that needs the host during the sequence, such as halo exchanges
+/// and parallelReduce, aborts the capture: the sequence is then marked as
+/// not capturable and must be run without a graph by the caller.
+class KernelGraph {
+
+ public:
+   /// Replays the graph Name, capturing it from Kernels first if it does
+   /// not exist. Kernels is called directly if the sequence is not
+   /// capturable. Returns an error code if the capture was aborted, in
+   /// which case none of the kernels were executed.
+   static int run(const std::string &Name,           ///< [in] graph name
+                  const std::function<void()> &Kernels ///< [in] sequence
+   );
+
+   /// Returns true if the graph Name has been captured
+   static bool isCaptured(const std::string &Name ///< [in] graph name
+   ) {
+      return Graphs.find(Name) != Graphs.end();
+   }
+
+   /// Returns true while a sequence is being captured
+   static bool isCapturing() { return Capturing; }
+
+   /// Adds a kernel to the graph being captured
+   template <class P, class F>
+   static void addKernel(const std::string &Label, const P &Policy,
+                         const F &Functor) {
+      if (!Aborted)
+         Tail = Tail->then_parallel_for(Label, Policy, Functor);
+   }
+
+   /// Aborts the current capture because of Reason, eg. a halo exchange
+   static void abortCapture(const std::string &Reason ///< [in] cause
+   );
+
+   /// Removes the graph Name, so that it is captured again on its next run
+   static void erase(const std::string &Name ///< [in] graph name
+   );
+
+   /// Removes all graphs. Called automatically by Kokkos::finalize.
+   static void clear();
+
+ private:
+   using Graph = Kokkos::Experimental::Graph<ExecSpace>;
+   using Node  = Kokkos::Experimental::GraphNodeRef<ExecSpace>;
+
+   static std::map<std::string, Graph> Graphs; ///< captured graphs
+   static std::set<std::string> NotCapturable; ///< aborted sequences
+   static std::optional<Node> Tail; ///< last node of the capture
+   static bool Capturing;           ///< true during a capture
+   static bool Aborted;             ///< true if the capture was aborted
+   static bool HookSet; ///< true once the finalize hook is registered
+};
+
+// parallelFor: with execution space instance and label
 template <int N, class F, class... Args>
-inline void parallelFor(const std::string &label, const int (&upper_bounds)[N],
-                        const F &f,
+inline void parallelFor(const ExecSpace &Space, const std::string &label,
+                        const int (&upper_bounds)[N], const F &f,
                         const int (&tile)[N] = DefaultTile<N>::value) {
    if constexpr (N == 1) {
-      const auto policy = Kokkos::RangePolicy<Args...>(0, upper_bounds[0]);
+      if (KernelGraph::isCapturing()) {
+         KernelGraph::addKernel(
+             label, Kokkos::RangePolicy<ExecSpace, Args...>(0, upper_bounds[0]),
+             f);
+         return;
+      }
+      const auto policy =
+          Kokkos::RangePolicy<ExecSpace, Args...>(Space, 0, upper_bounds[0]);
       Kokkos::parallel_for(label, policy, f);
 
    } else {
       const int lower_bounds[N] = {0};
-      const auto policy = Bounds<N, Args...>(lower_bounds, upper_bounds, tile);
-      Kokkos::parallel_for(label, policy, f);
+      int TuneTile[N];
+      if (KernelGraph::isCapturing()) {
+         // Captured kernels use the tile table but are never autotuned
+         if (!KernelTiles::getTile(label, N, TuneTile)) {
+            for (int Dim = 0; Dim < N; ++Dim)
+               TuneTile[Dim] = tile[Dim];
+         }
+         KernelGraph::addKernel(
+             label, Bounds<N, Args...>(lower_bounds, upper_bounds, TuneTile),
+             f);
+      } else if (KernelTiles::isAutotuning() &&
+                 KernelTiles::startTrial(label, N, TuneTile)) {
+         Space.fence();
+         Kokkos::Timer Timer;
+         const auto policy =
+             Bounds<N, Args...>(Space, lower_bounds, upper_bounds, TuneTile);
+         Kokkos::parallel_for(label, policy, f);
+         Space.fence();
+         KernelTiles::endTrial(label, Timer.seconds());
+      } else if (KernelTiles::getTile(label, N, TuneTile)) {
+         const auto policy =
+             Bounds<N, Args...>(Space, lower_bounds, upper_bounds, TuneTile);
+         Kokkos::parallel_for(label, policy, f);
+      } else {
+         const auto policy =
+             Bounds<N, Args...>(Space, lower_bounds, upper_bounds, tile);
+         Kokkos::parallel_for(label, policy, f);
+      }
    }
 }
 
+// parallelFor: with execution space instance and without label
+template <int N, class F>
+inline void parallelFor(const ExecSpace &Space, const int (&upper_bounds)[N],
+                        const F &f,
+                        const int (&tile)[N] = DefaultTile<N>::value) {
+   parallelFor(Space, "", upper_bounds, f, tile);
+}
+
+// parallelFor: with label
+template <int N, class F, class... Args>
+inline void parallelFor(const std::string &label, const int (&upper_bounds)[N],
+                        const F &f,
+                        const int (&tile)[N] = DefaultTile<N>::value) {
+   parallelFor<N, F, Args...>(ExecSpace(), label, upper_bounds, f, tile);
+}
+
 // parallelFor: without label
 template <int N, class F>
 inline void parallelFor(const int (&upper_bounds)[N], const F &f,
                         const int (&tile)[N] = DefaultTile<N>::value) {
-   parallelFor("", upper_bounds, f, tile);
+   parallelFor(ExecSpace(), "", upper_bounds, f, tile);
 }
 
-// parallelReduce: with label
+// parallelReduce: with execution space instance and label
 template <int N, class F, class R, class... Args>
-inline void parallelReduce(const std::string &label,
+inline void parallelReduce(const ExecSpace &Space, const std::string &label,
                            const int (&upper_bounds)[N], const F &f,
                            R &&reducer,
                            const int (&tile)[N] = DefaultTile<N>::value) {
+   // The result of a reduction is needed on the host, so it can not be
+   // part of a kernel graph
+   if (KernelGraph::isCapturing()) {
+      KernelGraph::abortCapture("parallelReduce " + label);
+      return;
+   }
    if constexpr (N == 1) {
-      const auto policy = Kokkos::RangePolicy<Args...>(0, upper_bounds[0]);
+      const auto policy =
+          Kokkos::RangePolicy<ExecSpace, Args...>(Space, 0, upper_bounds[0]);
       Kokkos::parallel_reduce(label, policy, f, std::forward<R>(reducer));
 
    } else {
       const int lower_bounds[N] = {0};
-      const auto policy = Bounds<N, Args...>(lower_bounds, upper_bounds, tile);
-      Kokkos::parallel_reduce(label, policy, f, std::forward<R>(reducer));
+      int TableTile[N];
+      if (KernelTiles::getTile(label, N, TableTile)) {
+         const auto policy =
+             Bounds<N, Args...>(Space, lower_bounds, upper_bounds, TableTile);
+         Kokkos::parallel_reduce(label, policy, f, std::forward<R>(reducer));
+      } else {
+         const auto policy =
+             Bounds<N, Args...>(Space, lower_bounds, upper_bounds, tile);
+         Kokkos::parallel_reduce(label, policy, f, std::forward<R>(reducer));
+      }
    }
 }
 
+// parallelReduce: with execution space instance and without label
+template <int N, class F, class R>
+inline void parallelReduce(const ExecSpace &Space,
+                           const int (&upper_bounds)[N], const F &f,
+                           R &&reducer,
+                           const int (&tile)[N] = DefaultTile<N>::value) {
+   parallelReduce(Space, "", upper_bounds, f, std::forward<R>(reducer), tile);
+}
+
+// parallelReduce: with label
+template <int N, class F, class R, class... Args>
+inline void parallelReduce(const std::string &label,
+                           const int (&upper_bounds)[N], const F &f,
+                           R &&reducer,
+                           const int (&tile)[N] = DefaultTile<N>::value) {
+   parallelReduce<N, F, R, Args...>(ExecSpace(), label, upper_bounds, f,
+                                    std::forward<R>(reducer), tile);
+}
+
 // parallelReduce: without label
 template <int N, class F, class R, class... Args>
 inline void parallelReduce(const int (&upper_bounds)[N], const F &f,
                            R &&reducer,
                            const int (&tile)[N] = DefaultTile<N>::value) {
-   parallelReduce("", upper_bounds, f, std::forward<R>(reducer), tile);
+   parallelReduce(ExecSpace(), "", upper_bounds, f, std::forward<R>(reducer),
+                  tile);
 }
 
+// Hierarchical (team) parallelism. A team of threads, each with several
+// vector lanes, is assigned to each outer index (eg. a mesh element) and the
+// inner iterations (eg. vertical levels or chunks) are distributed over the
+// threads and vector lanes of the team. Data shared by the team, such as the
+// connectivity of the element, can be staged in team scratch memory.
+
+using TeamPolicy = Kokkos::TeamPolicy<ExecSpace>;
+using TeamMember = TeamPolicy::member_type;
+
+// Unmanaged arrays in team scratch memory
+template <class T>
+using ScratchArray1D = Kokkos::View<T *, ExecSpace::scratch_memory_space,
+                                    Kokkos::MemoryUnmanaged>;
+template <class T>
+using ScratchArray2D = Kokkos::View<T **, ExecSpace::scratch_memory_space,
+                                    Kokkos::MemoryUnmanaged>;
+
+// Team policy on the instance Space with NTeams teams and ScratchBytes of
+// level-0 scratch memory per team. The team size and vector length are
+// chosen by Kokkos unless they are given (positive).
+inline TeamPolicy teamPolicy(const ExecSpace &Space, const int NTeams,
+                             const int ScratchBytes = 0,
+                             const int TeamSize     = 0,
+                             const int VectorLength = 0) {
+   TeamPolicy Policy;
+   if (TeamSize > 0 && VectorLength > 0) {
+      Policy = TeamPolicy(Space, NTeams, TeamSize, VectorLength);
+   } else if (TeamSize > 0) {
+      Policy = TeamPolicy(Space, NTeams, TeamSize, Kokkos::AUTO);
+   } else if (VectorLength > 0) {
+      Policy = TeamPolicy(Space, NTeams, Kokkos::AUTO, VectorLength);
+   } else {
+      Policy = TeamPolicy(Space, NTeams, Kokkos::AUTO, Kokkos::AUTO);
+   }
+   if (ScratchBytes > 0)
+      Policy.set_scratch_size(0, Kokkos::PerTeam(ScratchBytes));
+   return Policy;
+}
+
+// Team policy on the default instance
+inline TeamPolicy teamPolicy(const int NTeams, const int ScratchBytes = 0,
+                             const int TeamSize     = 0,
+                             const int VectorLength = 0) {
+   return teamPolicy(ExecSpace(), NTeams, ScratchBytes, TeamSize,
+                     VectorLength);
+}
+
+// parallelForTeam: with execution space instance and label
+// Calls f(Member) once for each of the NTeams teams, where Member is the
+// TeamMember handle of the team (Member.league_rank() is the team index)
+template <class F>
+inline void parallelForTeam(const ExecSpace &Space, const std::string &label,
+                            const int NTeams, const F &f,
+                            const int ScratchBytes = 0,
+                            const int TeamSize     = 0,
+                            const int VectorLength = 0) {
+   if (KernelGraph::isCapturing()) {
+      KernelGraph::addKernel(
+          label, teamPolicy(NTeams, ScratchBytes, TeamSize, VectorLength), f);
+      return;
+   }
+   const auto policy =
+       teamPolicy(Space, NTeams, ScratchBytes, TeamSize, VectorLength);
+   Kokkos::parallel_for(label, policy, f);
+}
+
+// parallelForTeam: with label
+template <class F>
+inline void parallelForTeam(const std::string &label, const int NTeams,
+                            const F &f, const int ScratchBytes = 0,
+                            const int TeamSize     = 0,
+                            const int VectorLength = 0) {
+   parallelForTeam(ExecSpace(), label, NTeams, f, ScratchBytes, TeamSize,
+                   VectorLength);
+}
+
+// parallelForTeam: without label
+template <class F>
+inline void parallelForTeam(const int NTeams, const F &f,
+                            const int ScratchBytes = 0,
+                            const int TeamSize     = 0,
+                            const int VectorLength = 0) {
+   parallelForTeam("", NTeams, f, ScratchBytes, TeamSize, VectorLength);
+}
+
+// parallelForTeam: with execution space instance, label and two bounds
+// Calls f(IOuter, IInner) with one team for each outer index and the inner
+// indices distributed over the threads and vector lanes of the team
+template <class F>
+inline void parallelForTeam(const ExecSpace &Space, const std::string &label,
+                            const int (&upper_bounds)[2], const F &f) {
+   const int NInner  = upper_bounds[1];
+   const auto Kernel = KOKKOS_LAMBDA(const TeamMember &Member) {
+      const int IOuter = Member.league_rank();
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(Member, NInner),
+                           [&](int IInner) { f(IOuter, IInner); });
+   };
+   if (KernelGraph::isCapturing()) {
+      KernelGraph::addKernel(label, teamPolicy(upper_bounds[0]), Kernel);
+      return;
+   }
+   Kokkos::parallel_for(label, teamPolicy(Space, upper_bounds[0]), Kernel);
+}
+
+// parallelForTeam: with label and two bounds on the default instance
+template <class F>
+inline void parallelForTeam(const std::string &label,
+                            const int (&upper_bounds)[2], const F &f) {
+   parallelForTeam(ExecSpace(), label, upper_bounds, f);
+}
+
+// parallelForTeam: without label and with two bounds
+template <class F>
+inline void parallelForTeam(const int (&upper_bounds)[2], const F &f) {
+   parallelForTeam(ExecSpace(), "", upper_bounds, f);
+}
+
+// Inner loops within a team kernel over the threads of the team, the vector
+// lanes of a thread, or both
+template <class F>
+KOKKOS_INLINE_FUNCTION void teamThreadFor(const TeamMember &Member,
+                                          const int N, const F &f) {
+   Kokkos::parallel_for(Kokkos::TeamThreadRange(Member, N), f);
+}
+
+template <class F>
+KOKKOS_INLINE_FUNCTION void threadVectorFor(const TeamMember &Member,
+                                            const int N, const F &f) {
+   Kokkos::parallel_for(Kokkos::ThreadVectorRange(Member, N), f);
+}
+
+template <class F>
+KOKKOS_INLINE_FUNCTION void teamVectorFor(const TeamMember &Member,
+                                          const int N, const F &f) {
+   Kokkos::parallel_for(Kokkos::TeamVectorRange(Member, N), f);
+}
+
+/// Returns the number of devices (GPUs) visible to the local task, or zero
+/// for host backends
+int getNumDevices();
+
+/// Initializes Kokkos, binding each task to a device chosen from its rank on
+/// the node (MachEnv::getDeviceID) so that the tasks on a node are spread
+/// over the node devices without relying on launcher or wrapper scripts.
+/// On host backends this is equivalent to Kokkos::initialize.
+void initKokkos(const MachEnv *Env = MachEnv::getDefaultEnv());
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,509 @@
+//===-- infra/Restart.cpp - restart checkpoint class ------------*- C++ -*-===//
+//
+// NetCDF restarts are a pair of full-precision IOStreams, one for writing and
+// one for reading, with the same file name template. Node binary restarts
+// gather the packed local arrays of the tasks on each node to the first task
+// on the node, which streams them to the node file in chunks so that the
+// whole node checkpoint is never held in memory. The node file starts with a
+// header holding the number of tasks and the field names and sizes of each
+// task, which is checked on reading to ensure the decomposition is the same.
+// Drains to the parallel file system run in a std::async task on the first
+// task of each node and are waited for before the next write.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Restart.h"
+#include "MachEnv.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+namespace OMEGA {
+
+// Initialize static variables
+std::map<std::string, std::shared_ptr<Restart>> Restart::AllRestarts;
+
+// Identifier at the start of node binary files
+static const char NodeFileMagic[8] = {'O', 'M', 'E', 'G', 'A', 'R', 'S', 'T'};
+
+// Maximum size of the messages used to move node file data between tasks
+constexpr I8 ChunkBytes = 1 << 26;
+
+// Maximum length of a field name in a node binary file
+constexpr I4 MaxNameLen = 1024;
+
+//------------------------------------------------------------------------------
+// Converts a string to a restart format
+
+RestartFormat
+RestartFormatFromString(const std::string &Format // [in] format choice
+) {
+
+   std::string FormatLower = Format;
+   std::transform(FormatLower.begin(), FormatLower.end(), FormatLower.begin(),
+                  [](unsigned char C) { return std::tolower(C); });
+
+   if (FormatLower == "nodebinary")
+      return RestartFormat::NodeBinary;
+   if (FormatLower != "netcdf")
+      LOG_WARN("Restart: unknown format {}, using netcdf", Format);
+   return RestartFormat::NetCDF;
+
+} // end RestartFormatFromString
+
+//------------------------------------------------------------------------------
+// Sends and receives a buffer of any size in messages of at most ChunkBytes
+
+static int sendChunks(const char *Buffer, // [in] data to send
+                      I8 NumBytes,        // [in] size of data
+                      int Dest,           // [in] destination task
+                      MPI_Comm Comm       // [in] communicator
+) {
+   int Err = MPI_SUCCESS;
+   for (I8 Start = 0; Start < NumBytes && Err == MPI_SUCCESS;
+        Start += ChunkBytes) {
+      int Count = std::min(ChunkBytes, NumBytes - Start);
+      Err       = MPI_Send(Buffer + Start, Count, MPI_BYTE, Dest, 0, Comm);
+   }
+   return Err;
+}
+
+static int recvChunks(char *Buffer, // [out] received data
+                      I8 NumBytes,  // [in] size of data
+                      int Source,   // [in] source task
+                      MPI_Comm Comm // [in] communicator
+) {
+   int Err = MPI_SUCCESS;
+   for (I8 Start = 0; Start < NumBytes && Err == MPI_SUCCESS;
+        Start += ChunkBytes) {
+      int Count = std::min(ChunkBytes, NumBytes - Start);
+      Err       = MPI_Recv(Buffer + Start, Count, MPI_BYTE, Source, 0, Comm,
+                           MPI_STATUS_IGNORE);
+   }
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Creates a restart and adds it to the list of defined restarts
+
+int Restart::create(const std::string &Name,     // [in] name of restart
+                    const std::string &Filename, // [in] file name template
+                    RestartFormat Format,        // [in] file format
+                    const TimeInterval &Freq,    // [in] write frequency
+                    Clock *ModelClock,           // [in] model clock
+                    const std::string &DrainDir  // [in] drain directory
+) {
+
+   if (isDefined(Name)) {
+      LOG_ERROR("Restart: restart {} already exists", Name);
+      return -1;
+   }
+   if (ModelClock == nullptr) {
+      LOG_ERROR("Restart: a valid clock is required for restart {}", Name);
+      return -2;
+   }
+
+   auto NewRestart        = std::make_shared<Restart>();
+   NewRestart->Name       = Name;
+   NewRestart->Filename   = Filename;
+   NewRestart->Format     = Format;
+   NewRestart->DrainDir   = DrainDir;
+   NewRestart->ModelClock = ModelClock;
+
+   // NetCDF restarts are full-precision streams that replace any existing
+   // file of the same time
+   if (Format == RestartFormat::NetCDF) {
+      int Err = IOStream::create(NewRestart->getWriteStreamName(), Filename,
+                                 IO::ModeWrite, IO::Precision::Double,
+                                 IO::IfExists::Replace, Freq, ModelClock);
+      Err += IOStream::create(NewRestart->getReadStreamName(), Filename,
+                              IO::ModeRead, IO::Precision::Double,
+                              IO::IfExists::Fail, Freq, ModelClock);
+      if (Err != 0) {
+         LOG_ERROR("Restart: error creating streams for restart {}", Name);
+         return -3;
+      }
+   } else {
+      NewRestart->RestartAlarm =
+          std::make_unique<Alarm>(Name, Freq, ModelClock->getStartTime());
+   }
+
+   AllRestarts[Name] = NewRestart;
+
+   return 0;
+
+} // end create
+
+//------------------------------------------------------------------------------
+// Checks whether a restart has been defined
+
+bool Restart::isDefined(const std::string &Name // [in] name of restart
+) {
+   return AllRestarts.find(Name) != AllRestarts.end();
+}
+
+//------------------------------------------------------------------------------
+// Names of the streams and files of a restart
+
+std::string Restart::getWriteStreamName() const { return Name + "Write"; }
+
+std::string Restart::getReadStreamName() const { return Name + "Read"; }
+
+std::string Restart::getNodeFilename() const {
+   return IOStream::expandFilename(Filename, ModelClock->getCurrentTime()) +
+          ".node" + std::to_string(MachEnv::getDefaultEnv()->getMyNode());
+}
+
+//------------------------------------------------------------------------------
+// Writes a restart if its alarm is ringing
+
+int Restart::write(const std::string &Name // [in] name of restart
+) {
+
+   auto It = AllRestarts.find(Name);
+   if (It == AllRestarts.end()) {
+      LOG_ERROR("Restart: cannot write undefined restart {}", Name);
+      return -1;
+   }
+   Restart *ThisRestart = It->second.get();
+
+   if (ThisRestart->Format == RestartFormat::NetCDF)
+      return IOStream::write(ThisRestart->getWriteStreamName());
+
+   TimeInstant CurrTime = ThisRestart->ModelClock->getCurrentTime();
+   int Err              = ThisRestart->RestartAlarm->updateStatus(CurrTime);
+   if (Err != 0) {
+      LOG_ERROR("Restart: error updating alarm for restart {}", Name);
+      return Err;
+   }
+
+   if (ThisRestart->RestartAlarm->isRinging()) {
+      Err = ThisRestart->writeNodeBinary();
+      ThisRestart->RestartAlarm->reset(CurrTime);
+   }
+
+   return Err;
+
+} // end write
+
+//------------------------------------------------------------------------------
+// Writes the node binary file of the local node. The first task on the node
+// writes the header and its own arrays, then receives and writes the arrays
+// of the other tasks in turn.
+
+int Restart::writeNodeBinary() {
+
+   MachEnv *DefEnv     = MachEnv::getDefaultEnv();
+   MPI_Comm NodeComm   = DefEnv->getNodeComm();
+   const I4 NodeTask   = DefEnv->getMyNodeTask();
+   const I4 NodeTasks  = DefEnv->getNumNodeTasks();
+   const I4 NumFields  = Contents.size();
+
+   // The previous node file must be drained before it is overwritten
+   int Err = waitDrain();
+
+   // Pack the local arrays
+   std::vector<I8> FieldBytes(NumFields);
+   I8 LocalBytes = 0;
+   for (int IField = 0; IField < NumFields; ++IField) {
+      FieldBytes[IField] = Contents[IField]->getNumBytes();
+      LocalBytes += FieldBytes[IField];
+   }
+   std::vector<char> LocalBuffer(LocalBytes);
+   I8 Offset = 0;
+   for (int IField = 0; IField < NumFields; ++IField) {
+      Contents[IField]->pack(LocalBuffer.data() + Offset);
+      Offset += FieldBytes[IField];
+   }
+
+   // Gather the field sizes of all tasks on the node
+   std::vector<I8> AllFieldBytes(NodeTask == 0 ? NodeTasks * NumFields : 0);
+   MPI_Gather(FieldBytes.data(), NumFields, MPI_INT64_T, AllFieldBytes.data(),
+              NumFields, MPI_INT64_T, 0, NodeComm);
+
+   // Open the file and write the header
+   std::string NodeFilename = getNodeFilename();
+   std::ofstream NodeFile;
+   int OpenErr = 0;
+   if (NodeTask == 0) {
+      NodeFile.open(NodeFilename, std::ios::binary | std::ios::trunc);
+      if (NodeFile) {
+         NodeFile.write(NodeFileMagic, sizeof(NodeFileMagic));
+         NodeFile.write(reinterpret_cast<const char *>(&NodeTasks),
+                        sizeof(I4));
+         NodeFile.write(reinterpret_cast<const char *>(&NumFields),
+                        sizeof(I4));
+         for (auto &Field : Contents) {
+            I4 NameLen = Field->FieldName.size();
+            NodeFile.write(reinterpret_cast<const char *>(&NameLen),
+                           sizeof(I4));
+            NodeFile.write(Field->FieldName.data(), NameLen);
+         }
+         NodeFile.write(reinterpret_cast<const char *>(AllFieldBytes.data()),
+                        AllFieldBytes.size() * sizeof(I8));
+      }
+      OpenErr = NodeFile ? 0 : 1;
+   }
+   MPI_Bcast(&OpenErr, 1, MPI_INT, 0, NodeComm);
+   if (OpenErr != 0) {
+      LOG_ERROR("Restart: error opening node file {} for restart {}",
+                NodeFilename, Name);
+      return -1;
+   }
+
+   // Move the arrays of each task to the file
+   int MoveErr = 0;
+   if (NodeTask == 0) {
+      NodeFile.write(LocalBuffer.data(), LocalBytes);
+      std::vector<char> Chunk;
+      for (int Task = 1; Task < NodeTasks; ++Task) {
+         I8 TaskBytes = 0;
+         for (int IField = 0; IField < NumFields; ++IField)
+            TaskBytes += AllFieldBytes[Task * NumFields + IField];
+         for (I8 Start = 0; Start < TaskBytes; Start += ChunkBytes) {
+            I8 Count = std::min(ChunkBytes, TaskBytes - Start);
+            Chunk.resize(Count);
+            MoveErr += recvChunks(Chunk.data(), Count, Task, NodeComm);
+            NodeFile.write(Chunk.data(), Count);
+         }
+      }
+      NodeFile.close();
+      if (!NodeFile)
+         MoveErr += 1;
+   } else {
+      MoveErr = sendChunks(LocalBuffer.data(), LocalBytes, 0, NodeComm);
+   }
+   if (MoveErr != 0) {
+      LOG_ERROR("Restart: error writing node file {} for restart {}",
+                NodeFilename, Name);
+      Err += MoveErr;
+   }
+
+   // Copy the node file to the drain directory in the background
+   if (NodeTask == 0 && !DrainDir.empty() && MoveErr == 0) {
+      std::filesystem::path Source(NodeFilename);
+      std::filesystem::path Dest =
+          std::filesystem::path(DrainDir) / Source.filename();
+      Drain = std::async(std::launch::async, [Source, Dest]() {
+         std::error_code CopyErr;
+         std::filesystem::copy_file(
+             Source, Dest, std::filesystem::copy_options::overwrite_existing,
+             CopyErr);
+         return CopyErr ? 1 : 0;
+      });
+   }
+
+   return Err;
+
+} // end writeNodeBinary
+
+//------------------------------------------------------------------------------
+// Reads a restart for the current time
+
+int Restart::read(const std::string &Name // [in] name of restart
+) {
+
+   auto It = AllRestarts.find(Name);
+   if (It == AllRestarts.end()) {
+      LOG_ERROR("Restart: cannot read undefined restart {}", Name);
+      return -1;
+   }
+   Restart *ThisRestart = It->second.get();
+
+   if (ThisRestart->Format == RestartFormat::NetCDF)
+      return IOStream::read(ThisRestart->getReadStreamName());
+
+   return ThisRestart->readNodeBinary();
+
+} // end read
+
+//------------------------------------------------------------------------------
+// Reads the node binary file of the local node. The first task on the node
+// checks the header against the contents, then reads and sends the arrays of
+// the other tasks in turn. Each task checks that its array sizes match the
+// sizes in the file before any arrays are moved.
+
+int Restart::readNodeBinary() {
+
+   MachEnv *DefEnv     = MachEnv::getDefaultEnv();
+   MPI_Comm NodeComm   = DefEnv->getNodeComm();
+   const I4 NodeTask   = DefEnv->getMyNodeTask();
+   const I4 NodeTasks  = DefEnv->getNumNodeTasks();
+   const I4 NumFields  = Contents.size();
+
+   // A drain in progress may still be reading the node file
+   int Err = waitDrain();
+
+   // Open the node file, or its drained copy, and check the header
+   std::string NodeFilename = getNodeFilename();
+   std::ifstream NodeFile;
+   std::vector<I8> AllFieldBytes(NodeTask == 0 ? NodeTasks * NumFields : 0);
+   int HeaderErr = 0;
+   if (NodeTask == 0) {
+      NodeFile.open(NodeFilename, std::ios::binary);
+      if (!NodeFile && !DrainDir.empty()) {
+         NodeFilename = (std::filesystem::path(DrainDir) /
+                         std::filesystem::path(NodeFilename).filename())
+                            .string();
+         NodeFile.open(NodeFilename, std::ios::binary);
+      }
+
+      char Magic[sizeof(NodeFileMagic)];
+      I4 FileTasks  = 0;
+      I4 FileFields = 0;
+      NodeFile.read(Magic, sizeof(Magic));
+      NodeFile.read(reinterpret_cast<char *>(&FileTasks), sizeof(I4));
+      NodeFile.read(reinterpret_cast<char *>(&FileFields), sizeof(I4));
+      if (!NodeFile ||
+          std::memcmp(Magic, NodeFileMagic, sizeof(Magic)) != 0 ||
+          FileTasks != NodeTasks || FileFields != NumFields) {
+         HeaderErr = 1;
+      }
+      for (int IField = 0; HeaderErr == 0 && IField < NumFields; ++IField) {
+         I4 NameLen = 0;
+         NodeFile.read(reinterpret_cast<char *>(&NameLen), sizeof(I4));
+         if (!NodeFile || NameLen < 0 || NameLen > MaxNameLen) {
+            HeaderErr = 1;
+            break;
+         }
+         std::string FieldName(NameLen, ' ');
+         NodeFile.read(FieldName.data(), NameLen);
+         if (!NodeFile || FieldName != Contents[IField]->FieldName)
+            HeaderErr = 1;
+      }
+      if (HeaderErr == 0) {
+         NodeFile.read(reinterpret_cast<char *>(AllFieldBytes.data()),
+                       AllFieldBytes.size() * sizeof(I8));
+         if (!NodeFile)
+            HeaderErr = 1;
+      }
+   }
+   MPI_Bcast(&HeaderErr, 1, MPI_INT, 0, NodeComm);
+   if (HeaderErr != 0) {
+      LOG_ERROR("Restart: node file {} for restart {} is missing or does not "
+                "match the restart contents and task layout",
+                NodeFilename, Name);
+      return -1;
+   }
+
+   // Check the local array sizes against the sizes in the file
+   std::vector<I8> FieldBytes(NumFields);
+   MPI_Scatter(AllFieldBytes.data(), NumFields, MPI_INT64_T, FieldBytes.data(),
+               NumFields, MPI_INT64_T, 0, NodeComm);
+   int SizeErr   = 0;
+   I8 LocalBytes = 0;
+   for (int IField = 0; IField < NumFields; ++IField) {
+      if (FieldBytes[IField] != Contents[IField]->getNumBytes())
+         SizeErr = 1;
+      LocalBytes += FieldBytes[IField];
+   }
+   MPI_Allreduce(MPI_IN_PLACE, &SizeErr, 1, MPI_INT, MPI_MAX, NodeComm);
+   if (SizeErr != 0) {
+      LOG_ERROR("Restart: array sizes in node file {} for restart {} do not "
+                "match the current decomposition",
+                NodeFilename, Name);
+      return -2;
+   }
+
+   // Move the arrays of each task from the file
+   std::vector<char> LocalBuffer(LocalBytes);
+   int MoveErr = 0;
+   if (NodeTask == 0) {
+      NodeFile.read(LocalBuffer.data(), LocalBytes);
+      std::vector<char> Chunk;
+      for (int Task = 1; Task < NodeTasks; ++Task) {
+         I8 TaskBytes = 0;
+         for (int IField = 0; IField < NumFields; ++IField)
+            TaskBytes += AllFieldBytes[Task * NumFields + IField];
+         for (I8 Start = 0; Start < TaskBytes; Start += ChunkBytes) {
+            I8 Count = std::min(ChunkBytes, TaskBytes - Start);
+            Chunk.resize(Count);
+            NodeFile.read(Chunk.data(), Count);
+            MoveErr += sendChunks(Chunk.data(), Count, Task, NodeComm);
+         }
+      }
+      if (!NodeFile)
+         MoveErr += 1;
+   } else {
+      MoveErr = recvChunks(LocalBuffer.data(), LocalBytes, 0, NodeComm);
+   }
+   if (MoveErr != 0) {
+      LOG_ERROR("Restart: error reading node file {} for restart {}",
+                NodeFilename, Name);
+      return Err + MoveErr;
+   }
+
+   // Unpack the local arrays
+   I8 Offset = 0;
+   for (int IField = 0; IField < NumFields; ++IField) {
+      Contents[IField]->unpack(LocalBuffer.data() + Offset);
+      Offset += FieldBytes[IField];
+   }
+
+   return Err;
+
+} // end readNodeBinary
+
+//------------------------------------------------------------------------------
+// Waits for the background copy of the last node file
+
+int Restart::waitDrain() {
+
+   if (!Drain.valid())
+      return 0;
+
+   int Err = Drain.get();
+   if (Err != 0)
+      LOG_ERROR("Restart: error draining node file of restart {} to {}", Name,
+                DrainDir);
+   return Err;
+
+} // end waitDrain
+
+int Restart::waitDrain(const std::string &Name // [in] name of restart
+) {
+
+   auto It = AllRestarts.find(Name);
+   if (It == AllRestarts.end()) {
+      LOG_ERROR("Restart: cannot wait for undefined restart {}", Name);
+      return -1;
+   }
+
+   return It->second->waitDrain();
+
+} // end waitDrain
+
+//------------------------------------------------------------------------------
+// Removes a single restart and its streams
+
+void Restart::erase(const std::string &Name // [in] name of restart
+) {
+
+   auto It = AllRestarts.find(Name);
+   if (It == AllRestarts.end())
+      return;
+
+   It->second->waitDrain();
+   if (It->second->Format == RestartFormat::NetCDF) {
+      IOStream::erase(It->second->getWriteStreamName());
+      IOStream::erase(It->second->getReadStreamName());
+   }
+   AllRestarts.erase(It);
+
+} // end erase
+
+//------------------------------------------------------------------------------
+// Removes all restarts
+
+void Restart::clear() {
+   while (!AllRestarts.empty()) {
+      std::string Name = AllRestarts.begin()->first;
+      erase(Name);
+   }
+}
+
+} // end namespace OMEGA
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,242 @@
+#ifndef OMEGA_RESTART_H
+#define OMEGA_RESTART_H
+//===-- infra/Restart.h - restart checkpoint class --------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the Restart class for checkpointing the model state
+///
+/// A restart is a set of IOFields that are written periodically and read
+/// to continue a simulation. Two formats are supported. NetCDF restarts are
+/// ordinary IOStreams written and read in full precision through PIO, so
+/// they can be read by any decomposition. Node binary restarts are fast
+/// checkpoints for restarting on the same decomposition. The tasks on each
+/// node send their local arrays to the first task on the node, which writes
+/// a single file per node, typically to a node-local burst buffer. The node
+/// files can then be copied (drained) to a parallel file system in the
+/// background while the model continues. Like other OMEGA classes, all
+/// restarts are stored and managed within the class, and the templated
+/// functions are defined in this header.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "IOField.h"
+#include "IOStream.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// File format of a restart
+enum class RestartFormat {
+   NetCDF,     ///< PIO NetCDF file that can be read by any decomposition
+   NodeBinary, ///< One binary file per node for the same decomposition
+};
+
+/// Converts a string (netcdf or nodebinary) to a RestartFormat
+RestartFormat
+RestartFormatFromString(const std::string &Format ///< [in] format choice
+);
+
+//------------------------------------------------------------------------------
+/// The RestartField class holds a single field of a node binary restart and
+/// copies the local array to and from a contiguous byte buffer on the host.
+class RestartField {
+
+ public:
+   std::string FieldName; ///< name of the IOField
+   I4 FieldHandle = -1;   ///< handle of the IOField
+
+   virtual ~RestartField() = default;
+
+   /// Returns the size in bytes of the local array
+   virtual I8 getNumBytes() const = 0;
+
+   /// Copies the local array into a buffer of getNumBytes() bytes
+   virtual void pack(char *Buffer ///< [out] buffer for array values
+   ) const = 0;
+
+   /// Copies the local array from a buffer of getNumBytes() bytes
+   virtual void unpack(const char *Buffer ///< [in] buffer of array values
+   ) const = 0;
+
+}; // end class RestartField
+
+//------------------------------------------------------------------------------
+/// Implementation of a restart field for a given array type T. Arrays are
+/// assumed to be contiguous. Device arrays are copied through a host mirror.
+template <typename T> class RestartFieldT : public RestartField {
+
+ private:
+   using ValType = typename T::non_const_value_type;
+
+ public:
+   I8 getNumBytes() const override {
+      T Data = IOField::getData<T>(FieldHandle);
+      return Data.size() * sizeof(ValType);
+   }
+
+   void pack(char *Buffer) const override {
+      T Data        = IOField::getData<T>(FieldHandle);
+      auto HostData = createHostMirrorCopy(Data);
+      std::memcpy(Buffer, HostData.data(), Data.size() * sizeof(ValType));
+   }
+
+   void unpack(const char *Buffer) const override {
+      T Data        = IOField::getData<T>(FieldHandle);
+      auto HostData = Kokkos::create_mirror_view(Data);
+      std::memcpy(HostData.data(), Buffer, Data.size() * sizeof(ValType));
+      Kokkos::deep_copy(Data, HostData);
+   }
+
+}; // end class RestartFieldT
+
+//------------------------------------------------------------------------------
+/// The Restart class describes a restart checkpoint: its file name
+/// template, format, frequency and contents. All restarts are stored within
+/// the class and are referred to by name.
+class Restart {
+
+ private:
+   std::string Name;     ///< name of restart
+   std::string Filename; ///< file name template
+   RestartFormat Format; ///< file format
+   std::string DrainDir; ///< directory for drained node files (or empty)
+
+   Clock *ModelClock;                   ///< clock for restart times
+   std::unique_ptr<Alarm> RestartAlarm; ///< alarm for node binary writes
+
+   /// Contents of a node binary restart
+   std::vector<std::shared_ptr<RestartField>> Contents;
+
+   /// Result of the background copy of the last node file, valid only on
+   /// the first task of each node
+   std::future<int> Drain;
+
+   /// Store and maintain all defined restarts
+   static std::map<std::string, std::shared_ptr<Restart>> AllRestarts;
+
+   /// Names of the output and input streams of a NetCDF restart
+   std::string getWriteStreamName() const;
+   std::string getReadStreamName() const;
+
+   /// Returns the name of the node binary file of the local node for the
+   /// current time
+   std::string getNodeFilename() const;
+
+   /// Writes and reads the node binary files of the local node
+   int writeNodeBinary();
+   int readNodeBinary();
+
+   /// Waits for the background copy of the last node file, if any
+   int waitDrain();
+
+ public:
+   //---------------------------------------------------------------------------
+   /// Creates a restart written with the given frequency. The file name
+   /// template uses the tokens of IOStream file names ($Y, $M, $D, $h, $m,
+   /// $s). Node binary restarts append the node number to the file name
+   /// and, if DrainDir is not empty, copy each node file to that directory
+   /// in the background after it is written. The clock must remain valid
+   /// for the life of the restart. Returns an error code.
+   static int create(const std::string &Name,         ///< [in] restart name
+                     const std::string &Filename,     ///< [in] file template
+                     RestartFormat Format,            ///< [in] file format
+                     const TimeInterval &Freq,        ///< [in] write frequency
+                     Clock *ModelClock,               ///< [in] model clock
+                     const std::string &DrainDir = "" ///< [in] drain dir
+   );
+
+   //---------------------------------------------------------------------------
+   /// Checks whether a restart of a given name has been defined
+   static bool isDefined(const std::string &Name ///< [in] name of restart
+   );
+
+   //---------------------------------------------------------------------------
+   /// Adds a previously defined IOField to a restart. The array type of the
+   /// attached data must be supplied as a template argument (eg <Array2DR8>)
+   /// along with the IO decomposition and dimension names used by NetCDF
+   /// restarts. Returns an error code.
+   template <typename T>
+   static int addField(const std::string &RestartName, ///< [in] restart name
+                       const std::string &FieldName,   ///< [in] field name
+                       int DecompID, ///< [in] IO decomposition for field
+                       const std::vector<std::string> &DimNames ///< [in]
+   ) {
+
+      auto It = AllRestarts.find(RestartName);
+      if (It == AllRestarts.end()) {
+         LOG_ERROR("Restart: cannot add field {} to undefined restart {}",
+                   FieldName, RestartName);
+         return -1;
+      }
+      Restart *ThisRestart = It->second.get();
+
+      if (ThisRestart->Format == RestartFormat::NetCDF) {
+         int Err = IOStream::addField<T>(ThisRestart->getWriteStreamName(),
+                                         FieldName, DecompID, DimNames);
+         Err += IOStream::addField<T>(ThisRestart->getReadStreamName(),
+                                      FieldName, DecompID, DimNames);
+         return Err;
+      }
+
+      const I4 FieldHandle = IOField::getHandle(FieldName);
+      if (FieldHandle < 0) {
+         LOG_ERROR("Restart: cannot add undefined field {} to restart {}",
+                   FieldName, RestartName);
+         return -2;
+      }
+
+      auto NewField         = std::make_shared<RestartFieldT<T>>();
+      NewField->FieldName   = FieldName;
+      NewField->FieldHandle = FieldHandle;
+      ThisRestart->Contents.push_back(NewField);
+
+      return 0;
+   }
+
+   //---------------------------------------------------------------------------
+   /// Writes a restart if its alarm is ringing and resets the alarm. This
+   /// should be called once per time step after the clock is advanced. A
+   /// node binary write first waits for the drain of the previous write.
+   /// Returns an error code.
+   static int write(const std::string &Name ///< [in] name of restart
+   );
+
+   //---------------------------------------------------------------------------
+   /// Reads a restart for the current clock time into the attached data
+   /// arrays. Node binary restarts are read from the node file, or from its
+   /// drained copy if the node file no longer exists, and must have been
+   /// written by the same decomposition and task layout. Returns an error
+   /// code.
+   static int read(const std::string &Name ///< [in] name of restart
+   );
+
+   //---------------------------------------------------------------------------
+   /// Waits for the background copy of the last node binary write of a
+   /// restart to complete. Returns an error code.
+   static int waitDrain(const std::string &Name ///< [in] name of restart
+   );
+
+   //---------------------------------------------------------------------------
+   /// Removes a single restart, waiting for any drain in progress
+   static void erase(const std::string &Name ///< [in] name of restart
+   );
+
+   //---------------------------------------------------------------------------
+   /// Removes all restarts, waiting for any drains in progress
+   static void clear();
+
+}; // end class Restart
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_RESTART_H
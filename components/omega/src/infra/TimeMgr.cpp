@@ -30,6 +30,7 @@
 #include "TimeMgr.h"
 #include "Logging.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <climits>
 #include <cmath>
@@ -549,6 +550,10 @@ TimeFrac::~TimeFrac(void) { // No operation - nothing to clean up
 bool TimeFrac::operator==(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // fast path for proper fractions on the same denominator
+   if (Denom == Time.Denom && isProper() && Time.isProper())
+      return Whole == Time.Whole && Numer == Time.Numer;
+
    // make local copies; don't change the originals.
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
@@ -573,6 +578,10 @@ bool TimeFrac::operator==(
 bool TimeFrac::operator!=(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // fast path for proper fractions on the same denominator
+   if (Denom == Time.Denom && isProper() && Time.isProper())
+      return Whole != Time.Whole || Numer != Time.Numer;
+
    // make local copies; don't change the originals.
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
@@ -597,6 +606,10 @@ bool TimeFrac::operator!=(
 bool TimeFrac::operator<(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // fast path for proper fractions on the same denominator
+   if (Denom == Time.Denom && isProper() && Time.isProper())
+      return Whole != Time.Whole ? Whole < Time.Whole : Numer < Time.Numer;
+
    // make local copies; don't change the originals.
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
@@ -626,6 +639,10 @@ bool TimeFrac::operator<(
 bool TimeFrac::operator>(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // fast path for proper fractions on the same denominator
+   if (Denom == Time.Denom && isProper() && Time.isProper())
+      return Whole != Time.Whole ? Whole > Time.Whole : Numer > Time.Numer;
+
    // make local copies so we do not change the originals.
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
@@ -657,6 +674,10 @@ bool TimeFrac::operator>(
 bool TimeFrac::operator<=(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // fast path for proper fractions on the same denominator
+   if (Denom == Time.Denom && isProper() && Time.isProper())
+      return Whole != Time.Whole ? Whole < Time.Whole : Numer <= Time.Numer;
+
    // reuse < and == operators defined above
    return *this < Time || *this == Time;
 
@@ -669,6 +690,10 @@ bool TimeFrac::operator<=(
 bool TimeFrac::operator>=(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // fast path for proper fractions on the same denominator
+   if (Denom == Time.Denom && isProper() && Time.isProper())
+      return Whole != Time.Whole ? Whole > Time.Whole : Numer >= Time.Numer;
+
    // reuse > and == operators defined above
    return *this > Time || *this == Time;
 
@@ -689,8 +714,17 @@ TimeFrac::operator+(const TimeFrac &Time) const { // [in] TimeFrac to add
 
    TimeFrac Sum;
 
+   // fast path for whole seconds, already in simplified form
+   if (Numer == 0 && Time.Numer == 0) {
+      Sum.Whole = Whole + Time.Whole;
+      Sum.Numer = 0;
+      Sum.Denom = 1;
+      return Sum;
+   }
+
    // fractional part addition
-   Sum.Denom = TimeFracLCM(Denom, Time.Denom);
+   Sum.Denom =
+       (Denom == Time.Denom) ? Denom : TimeFracLCM(Denom, Time.Denom);
    Sum.Numer =
        Numer * (Sum.Denom / Denom) + Time.Numer * (Sum.Denom / Time.Denom);
 
@@ -719,9 +753,18 @@ TimeFrac::operator-(const TimeFrac &Time) const { // [in] TimeFrac to subtract
 
    TimeFrac Diff;
 
+   // fast path for whole seconds, already in simplified form
+   if (Numer == 0 && Time.Numer == 0) {
+      Diff.Whole = Whole - Time.Whole;
+      Diff.Numer = 0;
+      Diff.Denom = 1;
+      return Diff;
+   }
+
    // fractional part subtraction
    // must convert to same denominator
-   Diff.Denom = TimeFracLCM(Denom, Time.Denom);
+   Diff.Denom =
+       (Denom == Time.Denom) ? Denom : TimeFracLCM(Denom, Time.Denom);
    Diff.Numer =
        Numer * (Diff.Denom / Denom) - Time.Numer * (Diff.Denom / Time.Denom);
 
@@ -770,6 +813,14 @@ TimeFrac::operator*(const I4 Multiplier) const { // [in] integer multiplier
 
    TimeFrac Product;
 
+   // fast path for whole seconds, already in simplified form
+   if (isWholeSeconds()) {
+      Product.Whole = Whole * Multiplier;
+      Product.Numer = 0;
+      Product.Denom = 1;
+      return Product;
+   }
+
    // fractional part multiplication.
    Product.Numer = Numer * Multiplier;
    Product.Denom = Denom;
@@ -3298,6 +3349,12 @@ bool TimeInterval::isPositive(void) {
 
 } // end TimeInterval::isPositive
 
+//------------------------------------------------------------------------------
+// TimeInterval::isCalendar
+// Function that returns true if this is a calendar (year, month, day) interval
+
+bool TimeInterval::isCalendar(void) const { return IsCalendar; }
+
 //------------------------------------------------------------------------------
 // TimeInstant definitions
 //------------------------------------------------------------------------------
@@ -3973,6 +4030,9 @@ std::string TimeInstant::getString(
 // Alarm definitions
 //------------------------------------------------------------------------------
 
+// Counter of alarm changes used by clocks to rebuild their alarm schedules
+I8 Alarm::ChangeEpoch = 0;
+
 // Alarm constructors/destructors
 //------------------------------------------------------------------------------
 // Alarm::Alarm - construct single instance alarm
@@ -3994,6 +4054,7 @@ Alarm::Alarm(
 
    // Now set ringing time to desired input value
    RingTime = AlarmTime;
+   ++ChangeEpoch;
 
 } // end Alarm::Alarm (single instance alarm)
 
@@ -4023,6 +4084,7 @@ Alarm::Alarm(
    // present) later calls to the updateStatus method will move the previous
    // ring time forward to be closer to the actual time
    RingTime = IntervalStart + AlarmInterval;
+   ++ChangeEpoch;
 
 } // end Alarm::Alarm constructor for periodic/interval alarms
 
@@ -4100,6 +4162,7 @@ I4 Alarm::reset(const TimeInstant InTime // [in] new alarm time
       // input value
       RingTime = InTime;
    }
+   ++ChangeEpoch;
 
    return Err;
 
@@ -4115,6 +4178,7 @@ I4 Alarm::stop(void) {
    I4 Err{0};
    Stopped = true;
    Ringing = false;
+   ++ChangeEpoch;
    return Err;
 
 } // end Alarm::stop
@@ -4137,6 +4201,21 @@ I4 Alarm::rename(const std::string NewName ///< [in] new name for alarm
 
 std::string Alarm::getName() const { return Name; }
 
+//------------------------------------------------------------------------------
+// Alarm::getRingTime - retrieves the next ring time of an alarm
+
+TimeInstant Alarm::getRingTime() const { return RingTime; }
+
+//------------------------------------------------------------------------------
+// Alarm::isStopped - checks whether an alarm has been stopped
+
+bool Alarm::isStopped() const { return Stopped; }
+
+//------------------------------------------------------------------------------
+// Alarm::getChangeEpoch - retrieves the counter of alarm changes
+
+I8 Alarm::getChangeEpoch() { return ChangeEpoch; }
+
 //------------------------------------------------------------------------------
 // Clock definitions
 //------------------------------------------------------------------------------
@@ -4170,6 +4249,11 @@ Clock::Clock(const TimeInstant InStartTime, //< [in] Start time for clock
       Alarms[I] = nullptr;
    }
 
+   // The alarm schedule is built on the first advance
+   ScheduleStep  = 0;
+   ScheduleEpoch = -1;
+   ScheduleValid = false;
+
 } // end Clock::Clock
 
 //------------------------------------------------------------------------------
@@ -4204,6 +4288,9 @@ I4 Clock::setCurrentTime(
       CurrTime = InCurrTime;
       PrevTime = CurrTime - TimeStep;
       NextTime = CurrTime + TimeStep;
+
+      // Alarm steps are relative to the current time
+      ScheduleValid = false;
    }
 
    return Err;
@@ -4227,6 +4314,9 @@ I4 Clock::changeTimeStep(
    // Update the next time based on new time step
    NextTime = CurrTime + TimeStep;
 
+   // Alarm steps depend on the time step
+   ScheduleValid = false;
+
    return Err;
 
 } // end Clock::changeTimeStep
@@ -4282,21 +4372,80 @@ I4 Clock::attachAlarm(Alarm *InAlarm // [in] pointer to alarm to attach
 
    // Now add the pointer to the next available slot in the array
    Alarms[NumAlarms - 1] = InAlarm;
+   ScheduleValid         = false;
 
    return Err;
 
 } // end Clock::attachAlarm
 
 // Clock methods
+//------------------------------------------------------------------------------
+// Clock::stepsToRing - Computes the steps until an alarm rings
+// Returns the number of advances after which the current time will be at or
+// after the alarm ring time. The real-valued estimate is reduced by one step
+// so that it is never late; advance checks the alarm exactly and reschedules
+// it for the following step if it is not yet ringing.
+
+I8 Clock::stepsToRing(const Alarm *InAlarm // [in] alarm to schedule
+) const {
+
+   R8 SecondsToRing{0.0};
+   R8 StepSeconds{0.0};
+   TimeInterval ToRing = InAlarm->getRingTime() - CurrTime;
+   I4 Err              = ToRing.get(SecondsToRing, TimeUnits::Seconds);
+   Err += TimeStep.get(StepSeconds, TimeUnits::Seconds);
+   if (Err != 0 || StepSeconds <= 0.0 || SecondsToRing <= StepSeconds)
+      return 1;
+
+   // Guard against overflow for alarms far in the future
+   const R8 Steps = std::ceil(SecondsToRing / StepSeconds) - 1.0;
+   if (Steps >= R8(LLONG_MAX / 2))
+      return LLONG_MAX / 2;
+
+   return std::max(I8(1), I8(Steps));
+
+} // end Clock::stepsToRing
+
+//------------------------------------------------------------------------------
+// Clock::buildAlarmSchedule - Rebuilds the schedule of alarm checks
+// Schedules each active alarm at the step at which it may ring. Ringing and
+// stopped alarms do not change status until they are reset, which changes
+// the alarm epoch and triggers another rebuild.
+
+void Clock::buildAlarmSchedule(void) {
+
+   AlarmSchedule = decltype(AlarmSchedule)();
+   ScheduleStep  = 0;
+   ScheduleEpoch = Alarm::getChangeEpoch();
+   ScheduleValid = true;
+
+   for (I4 N = 0; N < NumAlarms; ++N) {
+      if (Alarms[N]->isStopped() || Alarms[N]->isRinging())
+         continue;
+      AlarmSchedule.emplace(stepsToRing(Alarms[N]), N);
+   }
+
+} // end Clock::buildAlarmSchedule
+
 //------------------------------------------------------------------------------
 // Clock::advance - Advances a clock one timestep and updates alarms
 // This method advances a clock one interval and updates the status of all
-// attached alarms.
+// attached alarms. For non-calendar time steps, only alarms at the top of the
+// alarm schedule are checked, so the cost does not grow with the number of
+// alarms. Calendar time steps have a variable length in seconds, so all
+// alarms are checked at every step.
 
 I4 Clock::advance(void) {
 
    I4 Err{0};
 
+   // Rebuild the alarm schedule from the current time if alarms or the
+   // clock have changed since it was built
+   const bool UseSchedule = !TimeStep.isCalendar();
+   if (UseSchedule &&
+       (!ScheduleValid || ScheduleEpoch != Alarm::getChangeEpoch()))
+      buildAlarmSchedule();
+
    // Update previous time and current time from previously computed times
    PrevTime = CurrTime;
    CurrTime = NextTime;
@@ -4304,14 +4453,33 @@ I4 Clock::advance(void) {
    // Advance next time
    NextTime += TimeStep;
 
-   // Update status of all attached alarms
    I4 Err1{0};
-   for (I4 N = 0; N < NumAlarms; ++N) {
-      Err1 = Alarms[N]->updateStatus(CurrTime);
-      if (Err1 != 0) {
-         ++Err;
-         LOG_ERROR("TimeMgr: Clock::advance error updating alarm # {}", N);
-         break;
+   if (UseSchedule) {
+      // Update status of alarms that may ring at this step
+      ++ScheduleStep;
+      while (!AlarmSchedule.empty() &&
+             AlarmSchedule.top().first <= ScheduleStep) {
+         const I4 N = AlarmSchedule.top().second;
+         AlarmSchedule.pop();
+         Err1 = Alarms[N]->updateStatus(CurrTime);
+         if (Err1 != 0) {
+            ++Err;
+            LOG_ERROR("TimeMgr: Clock::advance error updating alarm # {}", N);
+            break;
+         }
+         // An early estimate is checked again at the next step
+         if (!Alarms[N]->isRinging())
+            AlarmSchedule.emplace(ScheduleStep + 1, N);
+      }
+   } else {
+      // Update status of all attached alarms
+      for (I4 N = 0; N < NumAlarms; ++N) {
+         Err1 = Alarms[N]->updateStatus(CurrTime);
+         if (Err1 != 0) {
+            ++Err;
+            LOG_ERROR("TimeMgr: Clock::advance error updating alarm # {}", N);
+            break;
+         }
       }
    }
 
@@ -35,7 +35,11 @@
 
 #include "DataTypes.h"
 
+#include <functional>
+#include <queue>
 #include <string>
+#include <utility>
+#include <vector>
 
 // Definitions of conversions
 /// Define seconds per day
@@ -251,6 +255,19 @@ class TimeFrac {
    /// Reduce a time fraction to simplest form
    I4 simplify(void);
 
+   /// Check whether the time is a whole number of seconds. Arithmetic on
+   /// whole seconds uses a fast path with plain integer operations.
+   bool isWholeSeconds(void) const { return Numer == 0 && Denom != 0; }
+
+   /// Check whether the fraction is proper (positive denominator and a
+   /// numerator smaller than the denominator with the sign of the whole
+   /// seconds). Proper fractions on the same denominator are compared
+   /// directly without simplifying.
+   bool isProper(void) const {
+      return Denom > 0 && Numer < Denom && Numer > -Denom &&
+             (Numer == 0 || Whole == 0 || (Numer > 0) == (Whole > 0));
+   }
+
 }; // end class TimeFrac
 
 /// The Calendar class encapsulates the knowledge (attributes and behavior)
@@ -556,6 +573,9 @@ class TimeInterval {
    /// Check whether a time interval is positive
    bool isPositive(void);
 
+   /// Check whether this is a calendar (year, month, day) interval
+   bool isCalendar(void) const;
+
    /// commutative multiplication operators need to be defined as
    /// free functions, and therefore need to be given acces to
    /// private members of TimeInterval
@@ -743,6 +763,10 @@ class Alarm {
    TimeInterval RingInterval; ///< interval at which this alarm rings
    TimeInstant RingTimePrev;  ///< previous alarm time for interval alarms
 
+   /// Counter incremented whenever any alarm is created, reset or stopped
+   /// so that clocks know when to rebuild their alarm schedules
+   static I8 ChangeEpoch;
+
  public:
    // constructors/destructors
 
@@ -789,6 +813,15 @@ class Alarm {
    /// Get alarm name
    std::string getName(void) const;
 
+   /// Get the time at/after which the alarm next rings
+   TimeInstant getRingTime(void) const;
+
+   /// Check whether an alarm has been stopped
+   bool isStopped(void) const;
+
+   /// Get the counter of alarm changes (creation, reset or stop)
+   static I8 getChangeEpoch(void);
+
    I4 print(void) const;
 
 }; // end class Alarm
@@ -816,6 +849,24 @@ class Clock {
    std::vector<Alarm *>
        Alarms; ///< pointers to alarms associated with this clock
 
+   /// Alarm schedule: a min-heap of (step at which to check, alarm index)
+   /// so that advance only checks alarms that may ring at this step.
+   /// Steps are counted from the time the schedule was built.
+   using AlarmEvent = std::pair<I8, I4>;
+   std::priority_queue<AlarmEvent, std::vector<AlarmEvent>,
+                       std::greater<AlarmEvent>>
+       AlarmSchedule;
+   I8 ScheduleStep;    ///< steps advanced since schedule was built
+   I8 ScheduleEpoch;   ///< alarm change epoch when schedule was built
+   bool ScheduleValid; ///< false if schedule must be rebuilt
+
+   /// Rebuilds the alarm schedule from the current time and time step
+   void buildAlarmSchedule(void);
+
+   /// Computes the number of steps after which the current time will be
+   /// at/after an alarm ring time. The estimate may be early but never late.
+   I8 stepsToRing(const Alarm *InAlarm) const;
+
  public:
    // constructors/destructors
 
@@ -0,0 +1,463 @@
+//===-- infra/Timer.cpp - timers for code profiling -------------*- C++ -*-===//
+//
+// The timers are stored as a call tree in a vector of timer nodes, with the
+// children of each node indexed by name. Starting a timer moves down the
+// tree from the currently running timer and stopping it moves back up, so
+// the same timer name is timed separately at each location in the tree. At
+// print, each task serializes the path, context and times of its timers and
+// the master task gathers them to compute the statistics across tasks.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Timer.h"
+#include "Config.h"
+#include "Logging.h"
+#include "mpi.h"
+
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace OMEGA {
+
+// Static members
+std::vector<Timer::TimerNode> Timer::Timers(1);
+int Timer::CurTimer          = 0;
+std::string Timer::TimerFile = "";
+bool Timer::DeviceSync       = false;
+R8 Timer::PeakBandwidth      = 0.0;
+
+namespace {
+
+// Statistics of one timer across tasks
+struct TimerStats {
+   std::string EnvName;
+   I8 NumCalls{0};
+   R8 MinTime{std::numeric_limits<R8>::max()};
+   R8 MaxTime{0.0};
+   R8 SumTime{0.0};
+   R8 SumBytes{0.0};
+   R8 SumFlops{0.0};
+   I4 NumTasks{0};
+};
+
+// Splits a string at a separator
+std::vector<std::string> splitString(const std::string &Str, char Sep) {
+   std::vector<std::string> Parts;
+   std::stringstream Stream(Str);
+   std::string Part;
+   while (std::getline(Stream, Part, Sep))
+      Parts.push_back(Part);
+   return Parts;
+}
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Read the timer options and start the Total timer
+
+int Timer::initialize() {
+
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("Timers")) {
+      Config TimerConfig("Timers");
+      Err = OmegaConfig->get(TimerConfig);
+      if (Err != 0) {
+         LOG_ERROR("Timer: error retrieving Timers configuration");
+         return Err;
+      }
+
+      std::string InFile;
+      if (TimerConfig.existsVar("TimerFile")) {
+         Err += TimerConfig.get("TimerFile", InFile);
+         setTimerFile(InFile);
+      }
+      bool InSync = false;
+      if (TimerConfig.existsVar("DeviceSync")) {
+         Err += TimerConfig.get("DeviceSync", InSync);
+         setDeviceSync(InSync);
+      }
+      R8 InPeak = 0.0;
+      if (TimerConfig.existsVar("PeakBandwidth")) {
+         Err += TimerConfig.get("PeakBandwidth", InPeak);
+         setPeakBandwidth(InPeak);
+      }
+   }
+
+   Err += start("Total");
+
+   return Err;
+
+} // end initialize
+
+//------------------------------------------------------------------------------
+// Stop all timers, print and remove the timers
+
+int Timer::finalize() {
+
+   int Err = print();
+   clear();
+
+   return Err;
+
+} // end finalize
+
+//------------------------------------------------------------------------------
+// Start a timer as a child of the current timer
+
+int Timer::start(const std::string &Name,   // [in] timer name
+                 const std::string &EnvName // [in] context env
+) {
+
+   int Index;
+   auto It = Timers[CurTimer].Children.find(Name);
+   if (It != Timers[CurTimer].Children.end()) {
+      Index = It->second;
+   } else {
+      if (!EnvName.empty() && MachEnv::getEnv(EnvName) == nullptr) {
+         LOG_ERROR("Timer: unknown MachEnv {} for timer {}", EnvName, Name);
+         return 1;
+      }
+      Index = Timers.size();
+      TimerNode NewTimer;
+      NewTimer.Name      = Name;
+      NewTimer.EnvName   = EnvName;
+      NewTimer.Parent    = CurTimer;
+      NewTimer.CallLevel = Timers[CurTimer].CallLevel + 1;
+      Timers.push_back(NewTimer);
+      Timers[CurTimer].Children[Name] = Index;
+   }
+
+   Kokkos::Profiling::pushRegion(Name);
+   if (DeviceSync)
+      Kokkos::fence();
+
+   TimerNode &Node = Timers[Index];
+   Node.IsRunning  = true;
+   Node.StartTime  = wallTime();
+   CurTimer        = Index;
+
+   return 0;
+
+} // end start
+
+//------------------------------------------------------------------------------
+// Stop the current timer and accumulate its time
+
+int Timer::stop(const std::string &Name // [in] timer name
+) {
+
+   if (CurTimer == 0 || Timers[CurTimer].Name != Name) {
+      LOG_ERROR("Timer: stopping timer {} that is not the running timer {}",
+                Name, CurTimer == 0 ? "(none)" : Timers[CurTimer].Name);
+      return 1;
+   }
+
+   if (DeviceSync)
+      Kokkos::fence();
+
+   TimerNode &Node = Timers[CurTimer];
+   Node.AccumTime += wallTime() - Node.StartTime;
+   Node.IsRunning = false;
+   ++Node.NumCalls;
+   CurTimer = Node.Parent;
+
+   Kokkos::Profiling::popRegion();
+
+   return 0;
+
+} // end stop
+
+//------------------------------------------------------------------------------
+// Add the bytes and flops of work to the current timer
+
+int Timer::addWork(R8 Bytes, // [in] bytes moved to or from memory
+                   R8 Flops  // [in] floating point operations
+) {
+
+   if (CurTimer == 0) {
+      LOG_ERROR("Timer: adding work with no running timer");
+      return 1;
+   }
+
+   Timers[CurTimer].Bytes += Bytes;
+   Timers[CurTimer].Flops += Flops;
+
+   return 0;
+
+} // end addWork
+
+//------------------------------------------------------------------------------
+// Gather the timers of all tasks on the master task and print the statistics
+
+int Timer::print() {
+
+   int Err = 0;
+
+   // Stop all running timers
+   while (CurTimer != 0)
+      Err += stop(Timers[CurTimer].Name);
+
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+   MPI_Comm Comm   = DefEnv->getComm();
+   int NumTasks    = DefEnv->getNumTasks();
+   int MasterTask  = DefEnv->getMasterTask();
+   bool IsMaster   = DefEnv->isMasterTask();
+
+   // Serialize the local timers as lines of path and context names and
+   // the call count, time, bytes and flops of each timer
+   constexpr int NFields = 4;
+   std::string Names;
+   std::vector<R8> Values;
+   for (int Index = 1; Index < Timers.size(); ++Index) {
+      Names += getPath(Index) + "\t" + Timers[Index].EnvName + "\n";
+      Values.push_back(static_cast<R8>(Timers[Index].NumCalls));
+      Values.push_back(Timers[Index].AccumTime);
+      Values.push_back(Timers[Index].Bytes);
+      Values.push_back(Timers[Index].Flops);
+   }
+
+   int NameLen = Names.size();
+   int NValues = Values.size();
+   std::vector<int> NameLens(NumTasks);
+   std::vector<int> ValueLens(NumTasks);
+   MPI_Gather(&NameLen, 1, MPI_INT, NameLens.data(), 1, MPI_INT, MasterTask,
+              Comm);
+   MPI_Gather(&NValues, 1, MPI_INT, ValueLens.data(), 1, MPI_INT, MasterTask,
+              Comm);
+
+   std::vector<int> NameDispls(NumTasks, 0);
+   std::vector<int> ValueDispls(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task) {
+      NameDispls[Task]  = NameDispls[Task - 1] + NameLens[Task - 1];
+      ValueDispls[Task] = ValueDispls[Task - 1] + ValueLens[Task - 1];
+   }
+   std::vector<char> AllNames;
+   std::vector<R8> AllValues;
+   if (IsMaster) {
+      AllNames.resize(NameDispls[NumTasks - 1] + NameLens[NumTasks - 1]);
+      AllValues.resize(ValueDispls[NumTasks - 1] + ValueLens[NumTasks - 1]);
+   }
+   MPI_Gatherv(Names.data(), NameLen, MPI_CHAR, AllNames.data(),
+               NameLens.data(), NameDispls.data(), MPI_CHAR, MasterTask, Comm);
+   MPI_Gatherv(Values.data(), NValues, MPI_DOUBLE, AllValues.data(),
+               ValueLens.data(), ValueDispls.data(), MPI_DOUBLE, MasterTask,
+               Comm);
+
+   if (!IsMaster)
+      return Err;
+
+   // Compute the statistics of each timer path over the tasks that called
+   // it. The map ordering of the split paths lists children after parents.
+   std::map<std::vector<std::string>, TimerStats> Stats;
+   bool HasWork = false;
+   for (int Task = 0; Task < NumTasks; ++Task) {
+      std::string TaskNames(AllNames.data() + NameDispls[Task],
+                            NameLens[Task]);
+      std::vector<std::string> Lines = splitString(TaskNames, '\n');
+      for (int Line = 0; Line < Lines.size(); ++Line) {
+         std::vector<std::string> Fields = splitString(Lines[Line], '\t');
+         TimerStats &Stat = Stats[splitString(Fields[0], '/')];
+         const R8 *Value  = &AllValues[ValueDispls[Task] + NFields * Line];
+         Stat.EnvName     = Fields.size() > 1 ? Fields[1] : "";
+         Stat.NumCalls    = std::max(Stat.NumCalls, static_cast<I8>(Value[0]));
+         Stat.MinTime     = std::min(Stat.MinTime, Value[1]);
+         Stat.MaxTime     = std::max(Stat.MaxTime, Value[1]);
+         Stat.SumTime += Value[1];
+         Stat.SumBytes += Value[2];
+         Stat.SumFlops += Value[3];
+         ++Stat.NumTasks;
+         HasWork = HasWork || Value[2] > 0.0 || Value[3] > 0.0;
+      }
+   }
+
+   // Format the statistics with indentation for the call level and the
+   // percentage of the mean time of the top-level and parent timers. If any
+   // timer has work, the rates of all tasks over the time of the slowest
+   // task are added, with the bandwidth as a percentage of the peak of the
+   // tasks that called the timer.
+   const bool HasPeak = HasWork && PeakBandwidth > 0.0;
+   std::vector<std::string> Output;
+   std::string Header = fmt::format("{:<40} {:>10} {:>6} {:>12} {:>12} {:>12} "
+                                    "{:>8} {:>8}",
+                                    "Timer", "Calls", "Tasks", "Min (s)",
+                                    "Max (s)", "Mean (s)", "%Total", "%Parent");
+   if (HasWork)
+      Header += fmt::format(" {:>10} {:>10}", "GB/s", "GFlop/s");
+   if (HasPeak)
+      Header += fmt::format(" {:>8}", "%Peak");
+   Output.push_back(Header);
+   for (const auto &[Path, Stat] : Stats) {
+      const R8 Mean = Stat.SumTime / Stat.NumTasks;
+
+      const TimerStats &Top = Stats.at({Path[0]});
+      std::vector<std::string> ParentPath(Path.begin(), Path.end() - 1);
+      const TimerStats &Parent =
+          ParentPath.empty() ? Stat : Stats.at(ParentPath);
+      const R8 TopMean    = Top.SumTime / Top.NumTasks;
+      const R8 ParentMean = Parent.SumTime / Parent.NumTasks;
+
+      std::string Label = std::string(2 * (Path.size() - 1), ' ') + Path.back();
+      if (!Stat.EnvName.empty())
+         Label += " [" + Stat.EnvName + "]";
+      std::string Line = fmt::format(
+          "{:<40} {:>10} {:>6} {:>12.6f} {:>12.6f} {:>12.6f} {:>8.2f} "
+          "{:>8.2f}",
+          Label, Stat.NumCalls, Stat.NumTasks, Stat.MinTime, Stat.MaxTime,
+          Mean, TopMean > 0.0 ? 100.0 * Mean / TopMean : 0.0,
+          ParentMean > 0.0 ? 100.0 * Mean / ParentMean : 0.0);
+      if (HasWork) {
+         const R8 GBPerSec =
+             Stat.MaxTime > 0.0 ? 1.0e-9 * Stat.SumBytes / Stat.MaxTime : 0.0;
+         const R8 GFlopPerSec =
+             Stat.MaxTime > 0.0 ? 1.0e-9 * Stat.SumFlops / Stat.MaxTime : 0.0;
+         Line += fmt::format(" {:>10.3f} {:>10.3f}", GBPerSec, GFlopPerSec);
+         const R8 PctPeak = 100.0 * GBPerSec / (PeakBandwidth * Stat.NumTasks);
+         if (HasPeak)
+            Line += fmt::format(" {:>8.2f}", PctPeak);
+      }
+      Output.push_back(Line);
+   }
+
+   if (TimerFile.empty() || TimerFile == "None" || TimerFile == "Log") {
+      LOG_INFO("Timer statistics:");
+      for (const std::string &Line : Output)
+         LOG_INFO("{}", Line);
+   } else {
+      std::ofstream OutFile(TimerFile);
+      if (!OutFile.good()) {
+         LOG_ERROR("Timer: unable to open timer file {}", TimerFile);
+         return Err + 1;
+      }
+      for (const std::string &Line : Output)
+         OutFile << Line << std::endl;
+      OutFile.close();
+   }
+
+   return Err;
+
+} // end print
+
+//------------------------------------------------------------------------------
+// Remove all timers
+
+void Timer::clear() {
+
+   // Close the Kokkos regions of any running timers
+   for (; CurTimer != 0; CurTimer = Timers[CurTimer].Parent)
+      Kokkos::Profiling::popRegion();
+
+   Timers.clear();
+   Timers.resize(1);
+
+} // end clear
+
+//------------------------------------------------------------------------------
+// Set the timer output file
+
+void Timer::setTimerFile(const std::string &FileName // [in] file name
+) {
+   TimerFile = FileName;
+}
+
+//------------------------------------------------------------------------------
+// Enable or disable device synchronization at timer starts and stops
+
+void Timer::setDeviceSync(bool Enable // [in] enable device sync
+) {
+   DeviceSync = Enable;
+}
+
+//------------------------------------------------------------------------------
+// Set the peak memory bandwidth per task
+
+void Timer::setPeakBandwidth(R8 GBPerSec // [in] peak bandwidth per task
+) {
+   PeakBandwidth = GBPerSec;
+}
+
+//------------------------------------------------------------------------------
+// Accumulated time of a timer on the local task
+
+R8 Timer::getTime(const std::string &Path // [in] timer path
+) {
+   int Index = findPath(Path);
+   return Index > 0 ? Timers[Index].AccumTime : -1.0;
+}
+
+//------------------------------------------------------------------------------
+// Number of calls of a timer on the local task
+
+I8 Timer::getNumCalls(const std::string &Path // [in] timer path
+) {
+   int Index = findPath(Path);
+   return Index > 0 ? Timers[Index].NumCalls : -1;
+}
+
+//------------------------------------------------------------------------------
+// Bytes added to a timer on the local task
+
+R8 Timer::getBytes(const std::string &Path // [in] timer path
+) {
+   int Index = findPath(Path);
+   return Index > 0 ? Timers[Index].Bytes : -1.0;
+}
+
+//------------------------------------------------------------------------------
+// Flops added to a timer on the local task
+
+R8 Timer::getFlops(const std::string &Path // [in] timer path
+) {
+   int Index = findPath(Path);
+   return Index > 0 ? Timers[Index].Flops : -1.0;
+}
+
+//------------------------------------------------------------------------------
+// Current wall clock time in seconds
+
+R8 Timer::wallTime() {
+   using Clock = std::chrono::steady_clock;
+   return std::chrono::duration<R8>(Clock::now().time_since_epoch()).count();
+}
+
+//------------------------------------------------------------------------------
+// Find a timer by its path from the root
+
+int Timer::findPath(const std::string &Path // [in] timer path
+) {
+
+   int Index = 0;
+   for (const std::string &Name : splitString(Path, '/')) {
+      auto It = Timers[Index].Children.find(Name);
+      if (It == Timers[Index].Children.end())
+         return -1;
+      Index = It->second;
+   }
+
+   return Index;
+
+} // end findPath
+
+//------------------------------------------------------------------------------
+// Path of a timer from the root
+
+std::string Timer::getPath(int Index // [in] timer index
+) {
+
+   std::string Path = Timers[Index].Name;
+   int Parent       = Timers[Index].Parent;
+   while (Parent > 0) {
+      Path   = Timers[Parent].Name + "/" + Path;
+      Parent = Timers[Parent].Parent;
+   }
+
+   return Path;
+
+} // end getPath
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
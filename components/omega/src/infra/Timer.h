@@ -0,0 +1,165 @@
+#ifndef OMEGA_TIMER_H
+#define OMEGA_TIMER_H
+//===-- infra/Timer.h - timers for code profiling ---------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines timers for profiling Omega
+///
+/// The Timer class provides named timers that are started and stopped
+/// around code regions. Timers started while another timer is running are
+/// children of the running timer, so the same timer name called from
+/// different parts of the code is timed separately for each location in the
+/// call tree. Each start and stop is also forwarded to the Kokkos Tools
+/// interface as a region, so that external profilers (nsys, rocprof, Kokkos
+/// Tools) see the same labels. At finalize, the timers of all tasks are
+/// gathered and the number of calls and the min, max and mean time across
+/// the tasks of each timer are printed with the call tree indentation.
+/// Timers are always on and cheap enough to leave in production runs: a
+/// start/stop pair costs a map lookup and two reads of the system clock.
+/// Optionally, the bytes moved and floating point operations of the work
+/// done inside a timer can be added to it, in which case the achieved
+/// memory bandwidth and flop rate, and the bandwidth as a percentage of the
+/// peak bandwidth of the machine if configured, are printed with the times.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// The Timer class holds all timers and the current position in the timer
+/// call tree. All methods are static. Timers are not thread-safe and must
+/// be called outside of threaded regions.
+class Timer {
+
+ public:
+   /// Reads the Timers configuration group (if present) and starts the
+   /// top-level timer named Total. Returns an error code.
+   static int initialize();
+
+   /// Stops all running timers, prints the timer statistics and removes all
+   /// timers. This is a collective call over the default environment.
+   /// Returns an error code.
+   static int finalize();
+
+   /// Starts the timer Name as a child of the currently running timer,
+   /// creating it on first use. Timer names must not contain slashes. If
+   /// the timer is called from a subset of tasks, the name of the MachEnv of
+   /// that subset can be given so that it is reported with the statistics.
+   /// Returns an error code.
+   static int start(const std::string &Name,        ///< [in] timer name
+                    const std::string &EnvName = "" ///< [in] context env
+   );
+
+   /// Stops the timer Name, which must be the currently running timer, and
+   /// accumulates the time since the last start. Returns an error code.
+   static int stop(const std::string &Name ///< [in] timer name
+   );
+
+   /// Adds the bytes moved and floating point operations of work done
+   /// since the currently running timer was started (eg the estimates of
+   /// a kernel from its access pattern). Returns an error code.
+   static int addWork(R8 Bytes, ///< [in] bytes moved to or from memory
+                      R8 Flops  ///< [in] floating point operations
+   );
+
+   /// Stops all running timers, gathers the timers of all tasks in the
+   /// default environment and prints the statistics to the timer file (or
+   /// the log if no file is set) from the master task. Returns an error
+   /// code.
+   static int print();
+
+   /// Removes all timers
+   static void clear();
+
+   /// Sets the file for the timer output. An empty name, None or Log sends
+   /// the output to the log.
+   static void setTimerFile(const std::string &FileName ///< [in] file name
+   );
+
+   /// Sets the peak memory bandwidth per task in GB/s used to print the
+   /// achieved bandwidth of timers with work as a percentage of the peak.
+   /// Zero disables the percentage.
+   static void setPeakBandwidth(R8 GBPerSec ///< [in] peak bandwidth per task
+   );
+
+   /// If enabled, Kokkos::fence is called before each timer start and stop
+   /// so that device kernels are included in the time of the timer that
+   /// launched them. Enabling this serializes the host and device.
+   static void setDeviceSync(bool Enable ///< [in] enable device sync
+   );
+
+   /// Returns the accumulated time on the local task of the timer with the
+   /// path Path, made of the timer names from Total down to the timer
+   /// separated by slashes (eg Total/Step/Halo). Returns a negative value if
+   /// the timer does not exist.
+   static R8 getTime(const std::string &Path ///< [in] timer path
+   );
+
+   /// Returns the number of calls on the local task of the timer Path, or
+   /// -1 if the timer does not exist
+   static I8 getNumCalls(const std::string &Path ///< [in] timer path
+   );
+
+   /// Returns the bytes added on the local task to the timer Path, or a
+   /// negative value if the timer does not exist
+   static R8 getBytes(const std::string &Path ///< [in] timer path
+   );
+
+   /// Returns the floating point operations added on the local task to the
+   /// timer Path, or a negative value if the timer does not exist
+   static R8 getFlops(const std::string &Path ///< [in] timer path
+   );
+
+ private:
+   /// One timer in the call tree
+   struct TimerNode {
+      std::string Name;                    ///< timer name
+      std::string EnvName;                 ///< context (empty for default)
+      int Parent{-1};                      ///< index of parent timer
+      I4 CallLevel{0};                     ///< level in the call tree
+      bool IsRunning{false};               ///< true if the timer is running
+      I8 NumCalls{0};                      ///< number of completed calls
+      R8 StartTime{0.0};                   ///< start of current interval
+      R8 AccumTime{0.0};                   ///< accumulated time
+      R8 Bytes{0.0};                       ///< accumulated bytes moved
+      R8 Flops{0.0};                       ///< accumulated flops
+      std::map<std::string, int> Children; ///< child timers by name
+   };
+
+   /// Returns the current wall clock time in seconds
+   static R8 wallTime();
+
+   /// Returns the index of the timer with the given path or -1
+   static int findPath(const std::string &Path);
+
+   /// Returns the path of the timer with the given index
+   static std::string getPath(int Index);
+
+   /// All timers. Timers[0] is the root of the call tree and is not itself
+   /// a timer.
+   static std::vector<TimerNode> Timers;
+
+   /// Index of the currently running timer (0 if none)
+   static int CurTimer;
+
+   /// Name of the file for the timer output
+   static std::string TimerFile;
+
+   /// Fence the device at each timer start and stop
+   static bool DeviceSync;
+
+   /// Peak memory bandwidth per task in GB/s, zero if unknown
+   static R8 PeakBandwidth;
+
+}; // end class Timer
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_TIMER_H
@@ -0,0 +1,328 @@
+//===-- ocn/AuxiliaryState.cpp - auxiliary variable engine ------*- C++ -*-===//
+//
+// Each auxiliary state remembers which kinds of variables are up to date and
+// the state arrays and state epoch they were computed from. A request for
+// kinds that are all up to date returns without launching a kernel. The
+// state epoch is a global counter incremented by invalidateAll, so the time
+// steppers can invalidate all auxiliary states without knowing them.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AuxiliaryState.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "MemoryTracker.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+
+namespace OMEGA {
+
+// Static members
+I8 AuxiliaryState::StateEpoch                  = 0;
+AuxiliaryState *AuxiliaryState::DefaultAuxState = nullptr;
+std::map<std::string, std::unique_ptr<AuxiliaryState>>
+    AuxiliaryState::AllAuxStates;
+
+//------------------------------------------------------------------------------
+// Create the default auxiliary state from the configuration
+
+int AuxiliaryState::init(I4 NVertLevels // [in] number of vertical levels
+) {
+
+   ConfigParam<std::string> FluxThickStr("Advection/FluxThicknessType",
+                                         "Center");
+   if (FluxThickStr.bind() != 0) {
+      LOG_ERROR("AuxiliaryState: error reading Advection options");
+      return 1;
+   }
+
+   FluxThickType FluxThickChoice;
+   if (FluxThickStr.get() == "Center") {
+      FluxThickChoice = Center;
+   } else if (FluxThickStr.get() == "Upwind") {
+      FluxThickChoice = Upwind;
+   } else {
+      LOG_ERROR("AuxiliaryState: unknown FluxThicknessType {}",
+                FluxThickStr.get());
+      return 1;
+   }
+
+   DefaultAuxState = create("Default", HorzMesh::getDefault(), NVertLevels,
+                            FluxThickChoice, OceanState::getDefault());
+   if (DefaultAuxState == nullptr) {
+      LOG_ERROR("AuxiliaryState: error creating default auxiliary state");
+      return 1;
+   }
+
+   return 0;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Create an auxiliary state and store it by name
+
+AuxiliaryState *
+AuxiliaryState::create(const std::string &Name,       // [in] name
+                       const HorzMesh *Mesh,          // [in] mesh
+                       I4 NVertLevels,                // [in] vert levels
+                       FluxThickType FluxThickChoice, // [in] flux thickness
+                       OceanState *OutputState        // [in] output state
+) {
+
+   if (AllAuxStates.find(Name) != AllAuxStates.end()) {
+      LOG_ERROR("AuxiliaryState: attempt to create auxiliary state {} that "
+                "already exists",
+                Name);
+      return nullptr;
+   }
+   if (Mesh == nullptr) {
+      LOG_ERROR("AuxiliaryState: auxiliary state {} requires a mesh", Name);
+      return nullptr;
+   }
+
+   MemoryScope Scope("AuxiliaryState");
+
+   std::unique_ptr<AuxiliaryState> NewAuxState(new AuxiliaryState(
+       Name, Mesh, NVertLevels, FluxThickChoice, OutputState));
+   if (NewAuxState->defineIOFields() != 0) {
+      LOG_ERROR("AuxiliaryState: error registering IO fields of auxiliary "
+                "state {}",
+                Name);
+      return nullptr;
+   }
+
+   AuxiliaryState *AuxState = NewAuxState.get();
+   AllAuxStates.emplace(Name, std::move(NewAuxState));
+   return AuxState;
+
+} // end create
+
+//------------------------------------------------------------------------------
+// Construct an auxiliary state and allocate all variables
+
+AuxiliaryState::AuxiliaryState(const std::string &InName,
+                               const HorzMesh *InMesh, I4 InNVertLevels,
+                               FluxThickType FluxThickChoice,
+                               OceanState *InOutputState)
+    : LayerThicknessAux(InName == "Default" ? "" : InName, InMesh,
+                        InNVertLevels, FluxThickChoice),
+      KineticAux(InName == "Default" ? "" : InName, InMesh, InNVertLevels),
+      VorticityAux(InName == "Default" ? "" : InName, InMesh, InNVertLevels),
+      Name(InName), Mesh(InMesh), NChunks(numVertChunks(InNVertLevels)),
+      OutputState(InOutputState), ValidKinds(0), ValidEpoch(-1),
+      ValidThickData(nullptr), ValidVelData(nullptr), NumPasses(0) {}
+
+//------------------------------------------------------------------------------
+// Remove the IO fields of an auxiliary state when it is destroyed
+
+AuxiliaryState::~AuxiliaryState() {
+
+   LayerThicknessAux.eraseIOFields();
+   KineticAux.eraseIOFields();
+   VorticityAux.eraseIOFields();
+
+} // end destructor
+
+//------------------------------------------------------------------------------
+// Retrieve, remove and clear auxiliary states
+
+AuxiliaryState *AuxiliaryState::getDefault() { return DefaultAuxState; }
+
+AuxiliaryState *AuxiliaryState::get(const std::string &Name // [in] name
+) {
+   auto It = AllAuxStates.find(Name);
+   if (It == AllAuxStates.end()) {
+      LOG_ERROR("AuxiliaryState: attempt to retrieve non-existent auxiliary "
+                "state {}",
+                Name);
+      return nullptr;
+   }
+   return It->second.get();
+}
+
+void AuxiliaryState::erase(const std::string &Name // [in] name
+) {
+   if (DefaultAuxState != nullptr && DefaultAuxState->Name == Name)
+      DefaultAuxState = nullptr;
+   AllAuxStates.erase(Name);
+}
+
+void AuxiliaryState::clear() {
+   DefaultAuxState = nullptr;
+   AllAuxStates.clear();
+}
+
+//------------------------------------------------------------------------------
+// Invalidate the computed variables
+
+void AuxiliaryState::invalidateAll() { ++StateEpoch; }
+
+void AuxiliaryState::invalidate() { ValidKinds = 0; }
+
+//------------------------------------------------------------------------------
+// Add the kinds that the requested kinds depend on. The vorticity at edges
+// is averaged from the vorticity at vertices.
+
+I4 AuxiliaryState::addDependencies(I4 Kinds) {
+   if (Kinds & AuxVortEdge)
+      Kinds |= AuxVortVertex;
+   return Kinds & AuxAllKinds;
+}
+
+//------------------------------------------------------------------------------
+// Check whether the requested kinds are up to date
+
+bool AuxiliaryState::isValid(I4 Kinds,                      // [in] kinds
+                             const Array2DReal &LayerThick, // [in] thickness
+                             const Array2DReal &NormalVel   // [in] velocity
+) const {
+   Kinds = addDependencies(Kinds);
+   return ValidEpoch == StateEpoch && ValidThickData == LayerThick.data() &&
+          ValidVelData == NormalVel.data() && (ValidKinds & Kinds) == Kinds;
+}
+
+//------------------------------------------------------------------------------
+// Compute the requested kinds that are out of date, with one loop over each
+// kind of mesh element
+
+int AuxiliaryState::compute(I4 Kinds,                      // [in] kinds
+                            const Array2DReal &LayerThick, // [in] thickness
+                            const Array2DReal &NormalVel   // [in] velocity
+) {
+
+   Kinds = addDependencies(Kinds);
+
+   // Variables computed from other arrays or before the last state change
+   // are out of date
+   if (ValidEpoch != StateEpoch || ValidThickData != LayerThick.data() ||
+       ValidVelData != NormalVel.data()) {
+      ValidKinds     = 0;
+      ValidEpoch     = StateEpoch;
+      ValidThickData = LayerThick.data();
+      ValidVelData   = NormalVel.data();
+   }
+
+   const I4 Needed = Kinds & ~ValidKinds;
+   if (Needed == 0)
+      return 0;
+
+   OMEGA_SCOPE(LocLayerThicknessAux, LayerThicknessAux);
+   OMEGA_SCOPE(LocKineticAux, KineticAux);
+   OMEGA_SCOPE(LocVorticityAux, VorticityAux);
+
+   // Loop over the owned and halo elements with active levels only
+   OMEGA_SCOPE(OceanVertices, Mesh->OceanVerticesAll);
+   OMEGA_SCOPE(OceanCells, Mesh->OceanCellsAll);
+   OMEGA_SCOPE(OceanEdges, Mesh->OceanEdgesAll);
+
+   if (Needed & AuxVortVertex) {
+      parallelFor(
+          "AuxVarsOnVertex", {Mesh->NVerticesAllOcean, NChunks},
+          KOKKOS_LAMBDA(int IOcean, int KChunk) {
+             const int IVertex = OceanVertices(IOcean);
+             LocVorticityAux.computeVarsOnVertex(IVertex, KChunk, LayerThick,
+                                                 NormalVel);
+          });
+      ++NumPasses;
+   }
+
+   if (Needed & AuxKineticCell) {
+      parallelFor(
+          "AuxVarsOnCell", {Mesh->NCellsAllOcean, NChunks},
+          KOKKOS_LAMBDA(int IOcean, int KChunk) {
+             const int ICell = OceanCells(IOcean);
+             LocKineticAux.computeVarsOnCell(ICell, KChunk, NormalVel);
+          });
+      ++NumPasses;
+   }
+
+   if (Needed & (AuxLayerThickEdge | AuxVortEdge)) {
+      const bool DoThick = Needed & AuxLayerThickEdge;
+      const bool DoVort  = Needed & AuxVortEdge;
+      parallelFor(
+          "AuxVarsOnEdge", {Mesh->NEdgesAllOcean, NChunks},
+          KOKKOS_LAMBDA(int IOcean, int KChunk) {
+             const int IEdge = OceanEdges(IOcean);
+             if (DoThick)
+                LocLayerThicknessAux.computeVarsOnEdge(IEdge, KChunk,
+                                                       LayerThick, NormalVel);
+             if (DoVort)
+                LocVorticityAux.computeVarsOnEdge(IEdge, KChunk);
+          });
+      ++NumPasses;
+   }
+
+   ValidKinds |= Needed;
+
+   return 0;
+
+} // end compute
+
+//------------------------------------------------------------------------------
+// Compute the kinds of a field from the current time level of the output
+// state before the field is written
+
+int AuxiliaryState::computeForOutput(I4 Kinds) {
+
+   if (OutputState == nullptr) {
+      LOG_ERROR("AuxiliaryState: auxiliary state {} has no state for output",
+                Name);
+      return 1;
+   }
+
+   Array2DReal LayerThick;
+   Array2DReal NormalVel;
+   int Err = OutputState->getLayerThickness(LayerThick, 0);
+   Err += OutputState->getNormalVelocity(NormalVel, 0);
+   if (Err != 0)
+      return Err;
+
+   return compute(Kinds, LayerThick, NormalVel);
+
+} // end computeForOutput
+
+//------------------------------------------------------------------------------
+// Register the variables for IO with functions that update them on output
+
+int AuxiliaryState::defineIOFields() {
+
+   int Err = 0;
+   Err += LayerThicknessAux.defineIOFields();
+   Err += KineticAux.defineIOFields();
+   Err += VorticityAux.defineIOFields();
+   if (Err != 0)
+      return Err;
+
+   const std::string Suffix = Name == "Default" ? "" : Name;
+
+   // Each field updates only its own kind
+   const std::pair<const char *, I4> FieldKinds[] = {
+       {"FluxLayerThickEdge", AuxLayerThickEdge},
+       {"MeanLayerThickEdge", AuxLayerThickEdge},
+       {"KineticEnergyCell", AuxKineticCell},
+       {"VelocityDivCell", AuxKineticCell},
+       {"RelVortVertex", AuxVortVertex},
+       {"NormRelVortVertex", AuxVortVertex},
+       {"NormPlanetVortVertex", AuxVortVertex},
+       {"NormRelVortEdge", AuxVortEdge},
+       {"NormPlanetVortEdge", AuxVortEdge}};
+
+   for (const auto &[FieldName, Kind] : FieldKinds) {
+      const I4 FieldKind = Kind;
+      Err += IOField::setUpdate(std::string(FieldName) + Suffix,
+                                [this, FieldKind]() {
+                                   return computeForOutput(FieldKind);
+                                });
+   }
+
+   return Err;
+
+} // end defineIOFields
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
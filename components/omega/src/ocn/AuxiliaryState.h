@@ -0,0 +1,150 @@
+#ifndef OMEGA_AUXILIARYSTATE_H
+#define OMEGA_AUXILIARYSTATE_H
+//===-- ocn/AuxiliaryState.h - auxiliary variable engine --------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the auxiliary state
+///
+/// The AuxiliaryState class holds all auxiliary variable groups of a mesh
+/// and computes them on request. Tendency terms and output streams request
+/// the kinds of variables they need, and only the requested kinds and the
+/// kinds they depend on that are not already up to date are computed.
+/// Computed variables stay valid until the state they were computed from
+/// changes, so a variable shared by several tendency terms is computed at
+/// most once per stage. All the kinds computed on the same kind of mesh
+/// element are computed in a single loop over those elements, with the
+/// vertex loop first, then the cell loop and the edge loop last, so that
+/// variables on edges can depend on variables on vertices.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AuxiliaryVars.h"
+#include "DataTypes.h"
+#include "HorzMesh.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace OMEGA {
+
+class OceanState;
+
+/// Kinds of auxiliary variables, as flags that can be combined to request
+/// several kinds at once
+enum AuxVarKind : I4 {
+   AuxLayerThickEdge = 1 << 0, ///< FluxLayerThickEdge, MeanLayerThickEdge
+   AuxKineticCell    = 1 << 1, ///< KineticEnergyCell, VelocityDivCell
+   AuxVortVertex     = 1 << 2, ///< RelVortVertex and normalized vorticities
+   AuxVortEdge       = 1 << 3, ///< NormRelVortEdge, NormPlanetVortEdge
+   AuxAllKinds       = (1 << 4) - 1 ///< all kinds
+};
+
+/// The AuxiliaryState class holds and computes the auxiliary variables
+class AuxiliaryState {
+
+ public:
+   LayerThicknessAuxVars LayerThicknessAux;
+   KineticAuxVars KineticAux;
+   VorticityAuxVars VorticityAux;
+
+   ~AuxiliaryState();
+
+   /// Creates the default auxiliary state on the default mesh, with the
+   /// options of the Advection configuration group. Output of the
+   /// auxiliary variables is computed from the default ocean state, which
+   /// should be created first. Returns an error code.
+   static int init(I4 NVertLevels ///< [in] number of vertical levels
+   );
+
+   /// Creates an auxiliary state and stores it under Name. The IO fields of
+   /// the default auxiliary state are named after the variables, those of
+   /// other auxiliary states have the name appended. Returns a pointer to
+   /// the new auxiliary state, or nullptr on error.
+   static AuxiliaryState *
+   create(const std::string &Name,   ///< [in] name of the auxiliary state
+          const HorzMesh *Mesh,      ///< [in] mesh
+          I4 NVertLevels,            ///< [in] number of vertical levels
+          FluxThickType FluxThickChoice, ///< [in] thickness flux choice
+          OceanState *OutputState    ///< [in] state used for output
+   );
+
+   /// Returns the default auxiliary state
+   static AuxiliaryState *getDefault();
+
+   /// Returns the auxiliary state Name, or nullptr if it does not exist
+   static AuxiliaryState *get(const std::string &Name ///< [in] name
+   );
+
+   /// Removes the auxiliary state Name
+   static void erase(const std::string &Name ///< [in] name
+   );
+
+   /// Removes all auxiliary states
+   static void clear();
+
+   /// Marks the auxiliary variables of all auxiliary states as out of date.
+   /// This must be called whenever a state array is modified in place, and
+   /// is called by the time steppers after every update of the state.
+   static void invalidateAll();
+
+   /// Marks the auxiliary variables of this auxiliary state as out of date
+   void invalidate();
+
+   /// Computes the requested kinds of auxiliary variables, and the kinds
+   /// they depend on, from the layer thickness and normal velocity, if they
+   /// were not already computed from the same arrays since the last
+   /// invalidation. Returns an error code.
+   int compute(I4 Kinds,                       ///< [in] AuxVarKind flags
+               const Array2DReal &LayerThick,   ///< [in] layer thickness
+               const Array2DReal &NormalVel     ///< [in] normal velocity
+   );
+
+   /// Returns true if all the requested kinds are up to date for the given
+   /// layer thickness and normal velocity
+   bool isValid(I4 Kinds,                     ///< [in] AuxVarKind flags
+                const Array2DReal &LayerThick, ///< [in] layer thickness
+                const Array2DReal &NormalVel   ///< [in] normal velocity
+   ) const;
+
+   /// Returns the number of loops over mesh elements launched so far
+   I4 getNumPasses() const { return NumPasses; }
+
+ private:
+   AuxiliaryState(const std::string &InName, const HorzMesh *InMesh,
+                  I4 InNVertLevels, FluxThickType FluxThickChoice,
+                  OceanState *InOutputState);
+
+   /// Adds the kinds that the requested kinds depend on
+   static I4 addDependencies(I4 Kinds);
+
+   /// Registers the variables for IO, with an update function that
+   /// computes each variable from the output state before it is written
+   int defineIOFields();
+
+   /// Computes the kinds of a field for output
+   int computeForOutput(I4 Kinds);
+
+   std::string Name;        ///< name of this auxiliary state
+   const HorzMesh *Mesh;    ///< mesh with the lists of ocean elements
+   I4 NChunks;              ///< number of vertical chunks
+   OceanState *OutputState; ///< state used to compute output
+
+   I4 ValidKinds;               ///< kinds that are up to date
+   I8 ValidEpoch;               ///< state epoch of the valid kinds
+   const Real *ValidThickData;  ///< thickness of the valid kinds
+   const Real *ValidVelData;    ///< velocity of the valid kinds
+   I4 NumPasses;                ///< number of loops launched
+
+   /// Counter incremented whenever the state changes
+   static I8 StateEpoch;
+
+   static AuxiliaryState *DefaultAuxState;
+   static std::map<std::string, std::unique_ptr<AuxiliaryState>> AllAuxStates;
+
+}; // end class AuxiliaryState
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_AUXILIARYSTATE_H
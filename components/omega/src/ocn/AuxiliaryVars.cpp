@@ -0,0 +1,136 @@
+//===-- ocn/AuxiliaryVars.cpp - auxiliary variable groups -------*- C++ -*-===//
+//
+// Constructors and IO registration of the auxiliary variable groups. The
+// compute functions are defined inline in AuxiliaryVars.h so that they can
+// be called from kernels.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AuxiliaryVars.h"
+#include "DataTypes.h"
+#include "FieldDefs.h"
+#include "HorzMesh.h"
+
+#include <vector>
+
+namespace OMEGA {
+
+namespace {
+
+// Defines the IO field of an auxiliary variable from its definition in
+// FieldDefs.inc and attaches its array. Returns an error code.
+int defineAuxField(FieldId Id, const std::string &Suffix,
+                   const Array2DReal &Data) {
+   I4 Handle;
+   return defineField(Id, Suffix, Data, Handle);
+}
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Layer thickness at edges
+
+LayerThicknessAuxVars::LayerThicknessAuxVars(const std::string &AuxStateSuffix,
+                                             const HorzMesh *Mesh,
+                                             int NVertLevels,
+                                             FluxThickType InFluxThickChoice)
+    : FluxLayerThickEdge("FluxLayerThickEdge" + AuxStateSuffix,
+                         Mesh->NEdgesSize, NVertLevels),
+      MeanLayerThickEdge("MeanLayerThickEdge" + AuxStateSuffix,
+                         Mesh->NEdgesSize, NVertLevels),
+      FluxThickChoice(InFluxThickChoice), Suffix(AuxStateSuffix),
+      CellsOnEdge(Mesh->CellsOnEdge), MinLevelEdgeBot(Mesh->MinLevelEdgeBot),
+      MaxLevelEdgeBot(Mesh->MaxLevelEdgeBot) {}
+
+int LayerThicknessAuxVars::defineIOFields() {
+   int Err = 0;
+   Err +=
+       defineAuxField(FieldId::FluxLayerThickEdge, Suffix, FluxLayerThickEdge);
+   Err +=
+       defineAuxField(FieldId::MeanLayerThickEdge, Suffix, MeanLayerThickEdge);
+   return Err;
+}
+
+void LayerThicknessAuxVars::eraseIOFields() {
+   eraseField(FieldId::FluxLayerThickEdge, Suffix);
+   eraseField(FieldId::MeanLayerThickEdge, Suffix);
+}
+
+//------------------------------------------------------------------------------
+// Kinetic energy and velocity divergence at cells
+
+KineticAuxVars::KineticAuxVars(const std::string &AuxStateSuffix,
+                               const HorzMesh *Mesh, int NVertLevels)
+    : KineticEnergyCell("KineticEnergyCell" + AuxStateSuffix,
+                        Mesh->NCellsSize, NVertLevels),
+      VelocityDivCell("VelocityDivCell" + AuxStateSuffix, Mesh->NCellsSize,
+                      NVertLevels),
+      Suffix(AuxStateSuffix), NEdgesOnCell(Mesh->NEdgesOnCell),
+      EdgesOnCell(Mesh->EdgesOnCell), DcEdge(Mesh->DcEdge),
+      DvEdge(Mesh->DvEdge), InvAreaCell(Mesh->OpInvAreaCell),
+      DvEdgeSignOnCell(Mesh->OpDvEdgeSignOnCell),
+      MinLevelCell(Mesh->MinLevelCell), MaxLevelCell(Mesh->MaxLevelCell) {}
+
+int KineticAuxVars::defineIOFields() {
+   int Err = 0;
+   Err +=
+       defineAuxField(FieldId::KineticEnergyCell, Suffix, KineticEnergyCell);
+   Err += defineAuxField(FieldId::VelocityDivCell, Suffix, VelocityDivCell);
+   return Err;
+}
+
+void KineticAuxVars::eraseIOFields() {
+   eraseField(FieldId::KineticEnergyCell, Suffix);
+   eraseField(FieldId::VelocityDivCell, Suffix);
+}
+
+//------------------------------------------------------------------------------
+// Vorticity at vertices and edges
+
+VorticityAuxVars::VorticityAuxVars(const std::string &AuxStateSuffix,
+                                   const HorzMesh *Mesh, int NVertLevels)
+    : RelVortVertex("RelVortVertex" + AuxStateSuffix, Mesh->NVerticesSize,
+                    NVertLevels),
+      NormRelVortVertex("NormRelVortVertex" + AuxStateSuffix,
+                        Mesh->NVerticesSize, NVertLevels),
+      NormPlanetVortVertex("NormPlanetVortVertex" + AuxStateSuffix,
+                           Mesh->NVerticesSize, NVertLevels),
+      NormRelVortEdge("NormRelVortEdge" + AuxStateSuffix, Mesh->NEdgesSize,
+                      NVertLevels),
+      NormPlanetVortEdge("NormPlanetVortEdge" + AuxStateSuffix,
+                         Mesh->NEdgesSize, NVertLevels),
+      Suffix(AuxStateSuffix), VertexDegree(Mesh->VertexDegree),
+      EdgesOnVertex(Mesh->EdgesOnVertex), CellsOnVertex(Mesh->CellsOnVertex),
+      VerticesOnEdge(Mesh->VerticesOnEdge),
+      InvAreaTriangle(Mesh->OpInvAreaTriangle),
+      DcEdgeSignOnVertex(Mesh->OpDcEdgeSignOnVertex),
+      KiteFracOnVertex(Mesh->OpKiteFracOnVertex), FVertex(Mesh->FVertex),
+      MinLevelVertexBot(Mesh->MinLevelVertexBot),
+      MaxLevelVertexBot(Mesh->MaxLevelVertexBot),
+      MinLevelEdgeBot(Mesh->MinLevelEdgeBot),
+      MaxLevelEdgeBot(Mesh->MaxLevelEdgeBot) {}
+
+int VorticityAuxVars::defineIOFields() {
+   int Err = 0;
+   Err += defineAuxField(FieldId::RelVortVertex, Suffix, RelVortVertex);
+   Err +=
+       defineAuxField(FieldId::NormRelVortVertex, Suffix, NormRelVortVertex);
+   Err += defineAuxField(FieldId::NormPlanetVortVertex, Suffix,
+                         NormPlanetVortVertex);
+   Err += defineAuxField(FieldId::NormRelVortEdge, Suffix, NormRelVortEdge);
+   Err +=
+       defineAuxField(FieldId::NormPlanetVortEdge, Suffix, NormPlanetVortEdge);
+   return Err;
+}
+
+void VorticityAuxVars::eraseIOFields() {
+   eraseField(FieldId::RelVortVertex, Suffix);
+   eraseField(FieldId::NormRelVortVertex, Suffix);
+   eraseField(FieldId::NormPlanetVortVertex, Suffix);
+   eraseField(FieldId::NormRelVortEdge, Suffix);
+   eraseField(FieldId::NormPlanetVortEdge, Suffix);
+}
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
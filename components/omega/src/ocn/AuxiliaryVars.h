@@ -0,0 +1,268 @@
+#ifndef OMEGA_AUXILIARYVARS_H
+#define OMEGA_AUXILIARYVARS_H
+//===-- ocn/AuxiliaryVars.h - auxiliary variable groups ---------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the groups of auxiliary variables
+///
+/// Auxiliary variables are functions of the prognostic state that are
+/// shared by several tendency terms. Each group holds the arrays of
+/// variables that are naturally computed together and compute functions
+/// that evaluate them over a chunk of vertical levels at one mesh element,
+/// following the Auxiliary Variables design document. The compute functions
+/// do not launch kernels themselves, so that AuxiliaryState can call the
+/// functions of several groups inside one loop over each kind of mesh
+/// element. Chunks that lie entirely outside the active levels of an
+/// element are set to zero without reading the state.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+
+#include <string>
+
+namespace OMEGA {
+
+/// Choice of the layer thickness used in the thickness flux at edges
+enum FluxThickType { Center, Upwind };
+
+/// Layer thickness at edges: the mean of the two neighboring cells and the
+/// thickness used in the thickness flux
+class LayerThicknessAuxVars {
+ public:
+   Array2DReal FluxLayerThickEdge;
+   Array2DReal MeanLayerThickEdge;
+   FluxThickType FluxThickChoice;
+
+   LayerThicknessAuxVars(const std::string &AuxStateSuffix,
+                         const HorzMesh *Mesh, int NVertLevels,
+                         FluxThickType InFluxThickChoice);
+
+   KOKKOS_FUNCTION void
+   computeVarsOnEdge(int IEdge, int KChunk, const Array2DReal &LayerThickCell,
+                     const Array2DReal &NormalVelEdge) const {
+      if (isInactiveChunk(KChunk, MinLevelEdgeBot(IEdge),
+                          MaxLevelEdgeBot(IEdge))) {
+         zeroChunk(MeanLayerThickEdge, IEdge, KChunk);
+         zeroChunk(FluxLayerThickEdge, IEdge, KChunk);
+         return;
+      }
+
+      const int KStart = KChunk * VecLength;
+      const int KEnd   = Kokkos::min(KStart + VecLength,
+                                     MeanLayerThickEdge.extent_int(1));
+      const int JCell0 = CellsOnEdge(IEdge, 0);
+      const int JCell1 = CellsOnEdge(IEdge, 1);
+
+      for (int K = KStart; K < KEnd; ++K) {
+         MeanLayerThickEdge(IEdge, K) =
+             0.5_Real * (LayerThickCell(JCell0, K) + LayerThickCell(JCell1, K));
+      }
+
+      switch (FluxThickChoice) {
+      case Center:
+         for (int K = KStart; K < KEnd; ++K) {
+            FluxLayerThickEdge(IEdge, K) = MeanLayerThickEdge(IEdge, K);
+         }
+         break;
+      case Upwind:
+         for (int K = KStart; K < KEnd; ++K) {
+            if (NormalVelEdge(IEdge, K) > 0) {
+               FluxLayerThickEdge(IEdge, K) = LayerThickCell(JCell0, K);
+            } else if (NormalVelEdge(IEdge, K) < 0) {
+               FluxLayerThickEdge(IEdge, K) = LayerThickCell(JCell1, K);
+            } else {
+               FluxLayerThickEdge(IEdge, K) = Kokkos::max(
+                   LayerThickCell(JCell0, K), LayerThickCell(JCell1, K));
+            }
+         }
+         break;
+      }
+   }
+
+   /// Registers the variables for IO. Returns an error code.
+   int defineIOFields();
+
+   /// Removes the variables from IO
+   void eraseIOFields();
+
+ private:
+   std::string Suffix;
+   Array2DI4 CellsOnEdge;
+   Array1DI4 MinLevelEdgeBot;
+   Array1DI4 MaxLevelEdgeBot;
+};
+
+/// Kinetic energy and velocity divergence at cell centers
+class KineticAuxVars {
+ public:
+   Array2DReal KineticEnergyCell;
+   Array2DReal VelocityDivCell;
+
+   KineticAuxVars(const std::string &AuxStateSuffix, const HorzMesh *Mesh,
+                  int NVertLevels);
+
+   KOKKOS_FUNCTION void
+   computeVarsOnCell(int ICell, int KChunk,
+                     const Array2DReal &NormalVelEdge) const {
+      if (isInactiveChunk(KChunk, MinLevelCell(ICell), MaxLevelCell(ICell))) {
+         zeroChunk(KineticEnergyCell, ICell, KChunk);
+         zeroChunk(VelocityDivCell, ICell, KChunk);
+         return;
+      }
+
+      const int KStart   = KChunk * VecLength;
+      const int KLast    = KineticEnergyCell.extent_int(1) - 1;
+      const Real InvArea = InvAreaCell(ICell);
+
+      Real KineticEnergyTmp[VecLength] = {0};
+      Real VelocityDivTmp[VecLength]   = {0};
+
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const int JEdge   = EdgesOnCell(ICell, J);
+         const Real Area   = 0.25_Real * DcEdge(JEdge) * DvEdge(JEdge);
+         const Real DvSign = DvEdgeSignOnCell(ICell, J);
+         for (int KVec = 0; KVec < VecLength; ++KVec) {
+            const int K    = Kokkos::min(KStart + KVec, KLast);
+            const Real Vel = NormalVelEdge(JEdge, K);
+            KineticEnergyTmp[KVec] += Area * Vel * Vel * InvArea;
+            VelocityDivTmp[KVec] -= DvSign * Vel * InvArea;
+         }
+      }
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const int K = KStart + KVec;
+         if (K <= KLast) {
+            KineticEnergyCell(ICell, K) = KineticEnergyTmp[KVec];
+            VelocityDivCell(ICell, K)   = VelocityDivTmp[KVec];
+         }
+      }
+   }
+
+   /// Registers the variables for IO. Returns an error code.
+   int defineIOFields();
+
+   /// Removes the variables from IO
+   void eraseIOFields();
+
+ private:
+   std::string Suffix;
+   Array1DI4 NEdgesOnCell;
+   Array2DI4 EdgesOnCell;
+   Array1DR8 DcEdge;
+   Array1DR8 DvEdge;
+   Array1DMetric InvAreaCell;
+   Array2DMetric DvEdgeSignOnCell;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+};
+
+/// Relative, normalized relative and normalized planetary vorticity at
+/// vertices, and the normalized vorticities averaged to edges. The edge
+/// values are computed from the vertex values, so they must be computed in
+/// a later loop than the vertex values.
+class VorticityAuxVars {
+ public:
+   Array2DReal RelVortVertex;
+   Array2DReal NormRelVortVertex;
+   Array2DReal NormPlanetVortVertex;
+   Array2DReal NormRelVortEdge;
+   Array2DReal NormPlanetVortEdge;
+
+   VorticityAuxVars(const std::string &AuxStateSuffix, const HorzMesh *Mesh,
+                    int NVertLevels);
+
+   KOKKOS_FUNCTION void
+   computeVarsOnVertex(int IVertex, int KChunk,
+                       const Array2DReal &LayerThickCell,
+                       const Array2DReal &NormalVelEdge) const {
+      if (isInactiveChunk(KChunk, MinLevelVertexBot(IVertex),
+                          MaxLevelVertexBot(IVertex))) {
+         zeroChunk(RelVortVertex, IVertex, KChunk);
+         zeroChunk(NormRelVortVertex, IVertex, KChunk);
+         zeroChunk(NormPlanetVortVertex, IVertex, KChunk);
+         return;
+      }
+
+      const int KStart   = KChunk * VecLength;
+      const int KLast    = RelVortVertex.extent_int(1) - 1;
+      const Real InvArea = InvAreaTriangle(IVertex);
+
+      Real RelVortTmp[VecLength]   = {0};
+      Real ThickVertTmp[VecLength] = {0};
+
+      for (int J = 0; J < VertexDegree; ++J) {
+         const int JEdge     = EdgesOnVertex(IVertex, J);
+         const int JCell     = CellsOnVertex(IVertex, J);
+         const Real DcSign   = DcEdgeSignOnVertex(IVertex, J);
+         const Real KiteFrac = KiteFracOnVertex(IVertex, J);
+         for (int KVec = 0; KVec < VecLength; ++KVec) {
+            const int K = Kokkos::min(KStart + KVec, KLast);
+            RelVortTmp[KVec] += DcSign * NormalVelEdge(JEdge, K) * InvArea;
+            ThickVertTmp[KVec] += KiteFrac * LayerThickCell(JCell, K);
+         }
+      }
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const int K = KStart + KVec;
+         if (K <= KLast) {
+            const Real InvThick              = 1.0_Real / ThickVertTmp[KVec];
+            RelVortVertex(IVertex, K)        = RelVortTmp[KVec];
+            NormRelVortVertex(IVertex, K)    = RelVortTmp[KVec] * InvThick;
+            NormPlanetVortVertex(IVertex, K) = FVertex(IVertex) * InvThick;
+         }
+      }
+   }
+
+   KOKKOS_FUNCTION void computeVarsOnEdge(int IEdge, int KChunk) const {
+      if (isInactiveChunk(KChunk, MinLevelEdgeBot(IEdge),
+                          MaxLevelEdgeBot(IEdge))) {
+         zeroChunk(NormRelVortEdge, IEdge, KChunk);
+         zeroChunk(NormPlanetVortEdge, IEdge, KChunk);
+         return;
+      }
+
+      const int KStart   = KChunk * VecLength;
+      const int KEnd     = Kokkos::min(KStart + VecLength,
+                                       NormRelVortEdge.extent_int(1));
+      const int JVertex0 = VerticesOnEdge(IEdge, 0);
+      const int JVertex1 = VerticesOnEdge(IEdge, 1);
+
+      for (int K = KStart; K < KEnd; ++K) {
+         NormRelVortEdge(IEdge, K) =
+             0.5_Real * (NormRelVortVertex(JVertex0, K) +
+                         NormRelVortVertex(JVertex1, K));
+         NormPlanetVortEdge(IEdge, K) =
+             0.5_Real * (NormPlanetVortVertex(JVertex0, K) +
+                         NormPlanetVortVertex(JVertex1, K));
+      }
+   }
+
+   /// Registers the variables for IO. Returns an error code.
+   int defineIOFields();
+
+   /// Removes the variables from IO
+   void eraseIOFields();
+
+ private:
+   std::string Suffix;
+   I4 VertexDegree;
+   Array2DI4 EdgesOnVertex;
+   Array2DI4 CellsOnVertex;
+   Array2DI4 VerticesOnEdge;
+   Array1DMetric InvAreaTriangle;
+   Array2DMetric DcEdgeSignOnVertex;
+   Array2DMetric KiteFracOnVertex;
+   Array1DR8 FVertex;
+   Array1DI4 MinLevelVertexBot;
+   Array1DI4 MaxLevelVertexBot;
+   Array1DI4 MinLevelEdgeBot;
+   Array1DI4 MaxLevelEdgeBot;
+};
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_AUXILIARYVARS_H
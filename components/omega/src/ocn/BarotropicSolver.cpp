@@ -0,0 +1,303 @@
+//===-- ocn/BarotropicSolver.cpp - barotropic elliptic solver ---*- C++ -*-===//
+//
+// The pipelined conjugate gradient iteration keeps, besides the residual R
+// and its preconditioned form U, the images W = A U, M = P^-1 W and N = A M
+// and updates the images of the search direction by recurrences instead of
+// applying the operator to it. The inner products (R,U), (W,U) and (R,R) of
+// an iteration then only depend on arrays that are already known when the
+// iteration starts, so they are reduced together while M is exchanged and
+// the operator is applied to it. All vector updates of an iteration, and the
+// preconditioning of the new W, are fused in one kernel.
+//
+//===----------------------------------------------------------------------===//
+
+#include "BarotropicSolver.h"
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+#include "Reductions.h"
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace OMEGA {
+
+namespace {
+
+// Views a cell field as a field with one vertical level, so that it can be
+// passed to the horizontal operators
+Array2DReal asOneLevel(const Array1DReal &Field) {
+   return Array2DReal(Field.data(), Field.extent(0), 1);
+}
+
+// Applies the operator X - Div(CoefEdge Grad(X)) in the owned cells. The
+// flux is needed on the edges of the owned cells, so only the first halo
+// layer of X is used.
+void applyOperator(const Array2DReal &AX,              // [out] operator on X
+                   const Array2DReal &X,               // [in] cell field
+                   const Array2DReal &FluxEdge,        // [out] scratch flux
+                   const Array1DReal &CoefEdge,        // [in] coefficient
+                   const GradientOnEdge &Gradient,     // [in] gradient
+                   const DivergenceOnCell &Divergence, // [in] divergence
+                   const HorzMesh *Mesh                // [in] mesh
+) {
+
+   parallelFor(
+       "BarotropicSolver:flux", {Mesh->NEdgesHaloH(0)},
+       KOKKOS_LAMBDA(int IEdge) {
+          Gradient(FluxEdge, IEdge, 0, X);
+          FluxEdge(IEdge, 0) *= CoefEdge(IEdge);
+       });
+
+   parallelFor(
+       "BarotropicSolver:div", {Mesh->NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+          Divergence(AX, ICell, 0, FluxEdge);
+          AX(ICell, 0) = X(ICell, 0) - AX(ICell, 0);
+       });
+
+} // end applyOperator
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+
+BarotropicSolver::BarotropicSolver(
+    const std::string &InName, // [in] name of the solver
+    const HorzMesh *InMesh,    // [in] mesh
+    Halo *InHalo,              // [in] halo for mesh
+    Real InTol,                // [in] relative tolerance
+    I4 InMaxIters              // [in] max iterations
+    )
+    : Name(InName), Mesh(InMesh), MeshHalo(InHalo), Tol(InTol),
+      MaxIters(InMaxIters), Gradient(InMesh), Divergence(InMesh),
+      DirGroup("BarotropicSolver" + InName) {
+
+   MemoryScope Scope("BarotropicSolver");
+
+   const I4 NCells = Mesh->NCellsSize;
+   CoefEdge        = Array1DReal("CoefEdge" + Name, Mesh->NEdgesSize);
+   InvDiag         = Array1DReal("InvDiag" + Name, NCells);
+   FluxEdge        = Array2DReal("FluxEdge" + Name, Mesh->NEdgesSize, 1);
+   R               = Array2DReal("R" + Name, NCells, 1);
+   U               = Array2DReal("U" + Name, NCells, 1);
+   W               = Array2DReal("W" + Name, NCells, 1);
+   M               = Array2DReal("M" + Name, NCells, 1);
+   N               = Array2DReal("N" + Name, NCells, 1);
+   P               = Array2DReal("P" + Name, NCells, 1);
+   S               = Array2DReal("S" + Name, NCells, 1);
+   Q               = Array2DReal("Q" + Name, NCells, 1);
+   Z               = Array2DReal("Z" + Name, NCells, 1);
+
+   if (DirGroup.add(M, OnCell, 1) != 0)
+      LOG_ERROR("BarotropicSolver: error creating the halo group for {}", Name);
+
+} // end BarotropicSolver constructor
+
+//------------------------------------------------------------------------------
+// Sets the edge coefficients and the Jacobi preconditioner
+
+int BarotropicSolver::setCoefficients(
+    const Array1DReal &ThickEdge, // [in] thickness on edges
+    Real Gravity,                 // [in] gravitational acceleration
+    Real Dt                       // [in] time step
+) {
+
+   if (ThickEdge.extent_int(0) < Mesh->NEdgesHaloH(0)) {
+      LOG_ERROR("BarotropicSolver: thickness array is too small for {}", Name);
+      return 1;
+   }
+
+   OMEGA_SCOPE(LocCoefEdge, CoefEdge);
+   OMEGA_SCOPE(LocInvDiag, InvDiag);
+   OMEGA_SCOPE(NEdgesOnCell, Mesh->NEdgesOnCell);
+   OMEGA_SCOPE(EdgesOnCell, Mesh->EdgesOnCell);
+   OMEGA_SCOPE(DvEdge, Mesh->DvEdge);
+   OMEGA_SCOPE(InvDcEdge, Mesh->OpInvDcEdge);
+   OMEGA_SCOPE(InvAreaCell, Mesh->OpInvAreaCell);
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+   OMEGA_SCOPE(MinLevelEdgeTop, Mesh->MinLevelEdgeTop);
+   OMEGA_SCOPE(MaxLevelEdgeTop, Mesh->MaxLevelEdgeTop);
+   const Real Coef = Gravity * Dt * Dt;
+
+   parallelFor(
+       "BarotropicSolver:coef", {Mesh->NEdgesHaloH(0)},
+       KOKKOS_LAMBDA(int IEdge) {
+          LocCoefEdge(IEdge) = Coef * ThickEdge(IEdge);
+       });
+
+   // The diagonal only includes the edges on which the gradient operator is
+   // active, so that it matches the operator
+   parallelFor(
+       "BarotropicSolver:diag", {Mesh->NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+          Real Diag = 1;
+          if (!isInactiveChunk(0, MinLevelCell(ICell), MaxLevelCell(ICell))) {
+             for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+                const int JEdge = EdgesOnCell(ICell, J);
+                if (!isInactiveChunk(0, MinLevelEdgeTop(JEdge),
+                                     MaxLevelEdgeTop(JEdge)))
+                   Diag += InvAreaCell(ICell) * DvEdge(JEdge) *
+                           InvDcEdge(JEdge) * LocCoefEdge(JEdge);
+             }
+          }
+          LocInvDiag(ICell) = 1 / Diag;
+       });
+
+   return 0;
+
+} // end setCoefficients
+
+//------------------------------------------------------------------------------
+// Applies the operator to a cell field
+
+int BarotropicSolver::apply(const Array1DReal &AX, // [out] operator on X
+                            const Array1DReal &X   // [in] cell field
+) const {
+
+   applyOperator(asOneLevel(AX), asOneLevel(X), FluxEdge, CoefEdge, Gradient,
+                 Divergence, Mesh);
+
+   return 0;
+
+} // end apply
+
+//------------------------------------------------------------------------------
+// Solves the system with the preconditioned pipelined conjugate gradient
+// method
+
+int BarotropicSolver::solve(const Array1DReal &X,  // [inout] guess, solution
+                            const Array1DReal &Rhs // [in] right-hand side
+) {
+
+   int Err = 0;
+
+   const I4 NCellsOwned = Mesh->NCellsOwned;
+   const MPI_Comm Comm  = MachEnv::getDefaultEnv()->getComm();
+   Array2DReal XLevel   = asOneLevel(X);
+
+   OMEGA_SCOPE(LocInvDiag, InvDiag);
+   OMEGA_SCOPE(LocR, R);
+   OMEGA_SCOPE(LocU, U);
+   OMEGA_SCOPE(LocW, W);
+   OMEGA_SCOPE(LocM, M);
+   OMEGA_SCOPE(LocN, N);
+   OMEGA_SCOPE(LocP, P);
+   OMEGA_SCOPE(LocS, S);
+   OMEGA_SCOPE(LocQ, Q);
+   OMEGA_SCOPE(LocZ, Z);
+
+   // Residual of the initial guess, its preconditioned form U and the
+   // images W and M of U
+   Array1DReal XHalo = X;
+   Err += MeshHalo->exchangeHalo(XHalo, OnCell, 1);
+   applyOperator(R, XLevel, FluxEdge, CoefEdge, Gradient, Divergence, Mesh);
+
+   parallelFor(
+       "BarotropicSolver:init", {NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+          LocR(ICell, 0) = Rhs(ICell) - LocR(ICell, 0);
+          LocU(ICell, 0) = LocInvDiag(ICell) * LocR(ICell, 0);
+          LocP(ICell, 0) = 0;
+          LocS(ICell, 0) = 0;
+          LocQ(ICell, 0) = 0;
+          LocZ(ICell, 0) = 0;
+       });
+
+   Err += MeshHalo->exchangeHalo(U, OnCell, 1);
+   applyOperator(W, U, FluxEdge, CoefEdge, Gradient, Divergence, Mesh);
+
+   parallelFor(
+       "BarotropicSolver:precond", {NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+          LocM(ICell, 0) = LocInvDiag(ICell) * LocW(ICell, 0);
+       });
+
+   // The norm of the right-hand side is reduced with the inner products of
+   // the first iteration
+   std::vector<std::pair<Array2DReal, Array2DReal>> DotPairs{
+       {R, U}, {W, U}, {R, R}, {asOneLevel(Rhs), asOneLevel(Rhs)}};
+   std::vector<R8> Dots;
+   ReductionRequest DotReq;
+
+   R8 GammaOld    = 0;
+   R8 AlphaOld    = 0;
+   R8 RefNorm     = 0;
+   bool Converged = false;
+
+   for (int Iter = 0; Iter <= MaxIters; ++Iter) {
+
+      // The inner products are reduced while M is exchanged and the
+      // operator is applied to it
+      Err += globalDotStart(DotPairs, Mesh->AreaCell, NoMask(), Comm, DotReq,
+                            NCellsOwned);
+      Err += MeshHalo->beginExchange(DirGroup);
+      Err += MeshHalo->finishExchange(DirGroup);
+      applyOperator(N, M, FluxEdge, CoefEdge, Gradient, Divergence, Mesh);
+      Err += globalSumFinish(DotReq, Dots);
+      if (Err != 0) {
+         LOG_ERROR("BarotropicSolver: communication error in {}", Name);
+         return Err;
+      }
+
+      const R8 Gamma   = Dots[0];
+      const R8 Delta   = Dots[1];
+      const R8 ResNorm = std::sqrt(Dots[2]);
+      if (Iter == 0) {
+         // A zero right-hand side has the trivial solution, so the residual
+         // of the initial guess is the reference
+         RefNorm = Dots[3] > 0 ? std::sqrt(Dots[3]) : ResNorm;
+         DotPairs.pop_back();
+      }
+      RelResidual   = RefNorm > 0 ? ResNorm / RefNorm : 0;
+      NumIterations = Iter;
+      Converged     = RelResidual <= Tol;
+      if (Converged || Iter == MaxIters)
+         break;
+
+      const R8 Beta = Iter > 0 ? Gamma / GammaOld : 0;
+      const R8 Alpha =
+          Iter > 0 ? Gamma / (Delta - Beta * Gamma / AlphaOld) : Gamma / Delta;
+      GammaOld = Gamma;
+      AlphaOld = Alpha;
+
+      const Real LocAlpha = Alpha;
+      const Real LocBeta  = Beta;
+      parallelFor(
+          "BarotropicSolver:update", {NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+             const Real ZNew = LocN(ICell, 0) + LocBeta * LocZ(ICell, 0);
+             const Real QNew = LocM(ICell, 0) + LocBeta * LocQ(ICell, 0);
+             const Real SNew = LocW(ICell, 0) + LocBeta * LocS(ICell, 0);
+             const Real PNew = LocU(ICell, 0) + LocBeta * LocP(ICell, 0);
+             LocZ(ICell, 0)  = ZNew;
+             LocQ(ICell, 0)  = QNew;
+             LocS(ICell, 0)  = SNew;
+             LocP(ICell, 0)  = PNew;
+             XLevel(ICell, 0) += LocAlpha * PNew;
+             LocR(ICell, 0) -= LocAlpha * SNew;
+             LocU(ICell, 0) -= LocAlpha * QNew;
+             LocW(ICell, 0) -= LocAlpha * ZNew;
+             LocM(ICell, 0) = LocInvDiag(ICell) * LocW(ICell, 0);
+          });
+   }
+
+   Err += MeshHalo->exchangeFullArrayHalo(XHalo, OnCell);
+
+   if (!Converged) {
+      LOG_ERROR("BarotropicSolver: {} did not converge in {} iterations, "
+                "relative residual {}",
+                Name, NumIterations, RelResidual);
+      ++Err;
+   }
+
+   return Err;
+
+} // end solve
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,115 @@
+#ifndef OMEGA_BAROTROPICSOLVER_H
+#define OMEGA_BAROTROPICSOLVER_H
+//===-- ocn/BarotropicSolver.h - barotropic elliptic solver -----*- C++ -*-===//
+//
+/// \file
+/// \brief Defines an elliptic solver for semi-implicit barotropic stepping
+///
+/// A semi-implicit treatment of the barotropic mode, as in the semi-implicit
+/// option of MPAS-Ocean, removes the external gravity wave limit on the
+/// barotropic time step at the cost of solving a Helmholtz equation for the
+/// new sea surface height at every step
+///    X - Div(g Dt^2 H Grad(X)) = Rhs
+/// where H is the layer-integrated thickness on edges. The
+/// BarotropicSolver class solves this system with the Jacobi-preconditioned
+/// pipelined conjugate gradient method of Ghysels and Vanroose, which
+/// rearranges the recurrences so that all inner products of an iteration are
+/// reduced in a single non-blocking global reduction that proceeds while the
+/// halo of the next search direction is exchanged and the operator is
+/// applied to it. An iteration therefore has one reduction and one
+/// single-layer halo exchange, and neither waits for the other. The operator
+/// is built from the GradientOnEdge and DivergenceOnCell operators, so it
+/// follows the level bounds of the mesh and land cells decouple with a unit
+/// diagonal.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+
+#include <string>
+
+namespace OMEGA {
+
+/// Elliptic solver for the sea surface height of a semi-implicit barotropic
+/// time step. The inner products are weighted by the cell areas, in which the
+/// operator is symmetric positive definite.
+class BarotropicSolver {
+ public:
+   /// Constructs a solver on a mesh and allocates its work arrays. The solve
+   /// stops when the residual norm is less than Tol times the norm of the
+   /// right-hand side, or after MaxIters iterations.
+   BarotropicSolver(const std::string &Name, ///< [in] name of the solver
+                    const HorzMesh *Mesh,    ///< [in] mesh
+                    Halo *MeshHalo,          ///< [in] halo for mesh
+                    Real Tol    = 1.0e-10,   ///< [in] relative tolerance
+                    I4 MaxIters = 500        ///< [in] max iterations
+   );
+
+   /// Sets the coefficient g Dt^2 H of the operator on each edge from the
+   /// thickness H on the edges of the owned cells, and the Jacobi
+   /// preconditioner. Must be called before solve whenever the thickness or
+   /// time step changes. Returns an error code.
+   int setCoefficients(const Array1DReal &ThickEdge, ///< [in] H on edges
+                       Real Gravity,                 ///< [in] gravity
+                       Real Dt                       ///< [in] time step
+   );
+
+   /// Applies the operator to X in the owned cells. The first halo layer of X
+   /// must be up to date. Returns an error code.
+   int apply(const Array1DReal &AX, ///< [out] operator applied to X
+             const Array1DReal &X   ///< [in] cell field with halo
+   ) const;
+
+   /// Solves the system for the right-hand side Rhs in the owned cells, with
+   /// X as the initial guess on input and the solution on output, including
+   /// its halo. Returns an error code, which is nonzero if the solve did not
+   /// converge.
+   int solve(const Array1DReal &X,  ///< [inout] initial guess, solution
+             const Array1DReal &Rhs ///< [in] right-hand side
+   );
+
+   /// Number of iterations of the last solve
+   I4 getNumIterations() const { return NumIterations; }
+
+   /// Residual norm of the last solve relative to the right-hand side
+   Real getRelResidual() const { return RelResidual; }
+
+ private:
+   std::string Name;     ///< name of the solver
+   const HorzMesh *Mesh; ///< mesh of the solver
+   Halo *MeshHalo;       ///< halo for mesh
+   Real Tol;             ///< relative tolerance of the residual norm
+   I4 MaxIters;          ///< max iterations of a solve
+
+   I4 NumIterations{0}; ///< iterations of the last solve
+   Real RelResidual{0}; ///< relative residual norm of the last solve
+
+   GradientOnEdge Gradient;     ///< gradient of a cell field
+   DivergenceOnCell Divergence; ///< divergence of an edge field
+
+   Array1DReal CoefEdge; ///< g Dt^2 H on edges
+   Array1DReal InvDiag;  ///< inverse of the operator diagonal
+   Array2DReal FluxEdge; ///< coefficient times gradient on edges
+
+   // Work arrays of the pipelined recurrences, with one level so that they
+   // can be passed to the horizontal operators
+   Array2DReal R; ///< residual
+   Array2DReal U; ///< preconditioned residual
+   Array2DReal W; ///< operator applied to U
+   Array2DReal M; ///< preconditioned W, exchanged every iteration
+   Array2DReal N; ///< operator applied to M
+   Array2DReal P; ///< search direction
+   Array2DReal S; ///< operator applied to P
+   Array2DReal Q; ///< preconditioned S
+   Array2DReal Z; ///< operator applied to Q
+
+   HaloGroup DirGroup; ///< persistent exchange of the first halo layer of M
+};
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_BAROTROPICSOLVER_H
@@ -0,0 +1,111 @@
+//===-- ocn/Del4Operators.cpp - biharmonic operators ------------*- C++ -*-===//
+//
+// Each operator makes two loops over the owned elements with one halo
+// exchange of the scratch array between them. The exchanges use persistent
+// patterns named after the operator, so their buffers and MPI requests are
+// created by the first exchange and reused afterwards.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Del4Operators.h"
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Vector biharmonic operator on edges
+
+Del4OnEdge::Del4OnEdge(const std::string &InName, // [in] name of operator
+                       const HorzMesh *InMesh,    // [in] mesh
+                       Halo *InHalo,              // [in] halo for mesh
+                       I4 NVertLevels             // [in] vertical levels
+                       )
+    : Name(InName), Mesh(InMesh), MeshHalo(InHalo),
+      NChunks(numVertChunks(NVertLevels)), Laplacian(InMesh) {
+
+   MemoryScope Scope("Del4");
+   Del2Edge = Array2DReal("Del2Edge" + Name, Mesh->NEdgesSize, NVertLevels);
+
+} // end Del4OnEdge constructor
+
+int Del4OnEdge::computeDel2(const Array2DReal &VecEdge // [in] vector on edges
+) {
+
+   OMEGA_SCOPE(LocLaplacian, Laplacian);
+   OMEGA_SCOPE(LocDel2Edge, Del2Edge);
+   OMEGA_SCOPE(OceanEdges, Mesh->OceanEdgesOwned);
+
+   parallelFor(
+       "Del4OnEdge:del2", {Mesh->NEdgesOwnedOcean, NChunks},
+       KOKKOS_LAMBDA(int IOcean, int KChunk) {
+          const int IEdge = OceanEdges(IOcean);
+          LocLaplacian(LocDel2Edge, IEdge, KChunk, VecEdge);
+       });
+
+   HaloGroup Group("Del4OnEdge" + Name);
+   int Err = Group.add(Del2Edge, OnEdge, NHaloLayers);
+   Err += MeshHalo->exchangeGroup(Group);
+   if (Err != 0)
+      LOG_ERROR("Del4OnEdge: error exchanging the Laplacian halo in {}", Name);
+
+   return Err;
+
+} // end Del4OnEdge::computeDel2
+
+int Del4OnEdge::compute(const Array2DReal &Del4Edge, // [out] del4 on edges
+                        const Array2DReal &VecEdge   // [in] vector on edges
+) {
+
+   int Err = computeDel2(VecEdge);
+
+   OMEGA_SCOPE(LocLaplacian, Laplacian);
+   OMEGA_SCOPE(LocDel2Edge, Del2Edge);
+   OMEGA_SCOPE(OceanEdges, Mesh->OceanEdgesOwned);
+
+   parallelFor(
+       "Del4OnEdge:del4", {Mesh->NEdgesOwnedOcean, NChunks},
+       KOKKOS_LAMBDA(int IOcean, int KChunk) {
+          const int IEdge = OceanEdges(IOcean);
+          LocLaplacian(Del4Edge, IEdge, KChunk, LocDel2Edge);
+       });
+
+   return Err;
+
+} // end Del4OnEdge::compute
+
+//------------------------------------------------------------------------------
+// Scalar biharmonic operator on cells
+
+Del4OnCell::Del4OnCell(const std::string &InName, // [in] name of operator
+                       const HorzMesh *InMesh,    // [in] mesh
+                       Halo *InHalo,              // [in] halo for mesh
+                       I4 NVertLevels             // [in] vertical levels
+                       )
+    : Name(InName), Mesh(InMesh), MeshHalo(InHalo),
+      NChunks(numVertChunks(NVertLevels)), Laplacian(InMesh) {
+
+   MemoryScope Scope("Del4");
+   Del2Cell = Array2DReal("Del2Cell" + Name, Mesh->NCellsSize, NVertLevels);
+
+} // end Del4OnCell constructor
+
+int Del4OnCell::exchangeDel2() {
+
+   HaloGroup Group("Del4OnCell" + Name);
+   int Err = Group.add(Del2Cell, OnCell, NHaloLayers);
+   Err += MeshHalo->exchangeGroup(Group);
+   if (Err != 0)
+      LOG_ERROR("Del4OnCell: error exchanging the Laplacian halo in {}", Name);
+
+   return Err;
+
+} // end Del4OnCell::exchangeDel2
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,159 @@
+#ifndef OMEGA_DEL4OPERATORS_H
+#define OMEGA_DEL4OPERATORS_H
+//===-- ocn/Del4Operators.h - biharmonic operators --------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the biharmonic (del4) operators for hyperdiffusion
+///
+/// The biharmonic operator is the Laplacian of the Laplacian. Applied naively
+/// it takes separate loops for the gradient, divergence and curl of each
+/// Laplacian, with a full-size temporary array for each and a halo exchange
+/// between the two Laplacians. The operators here evaluate each Laplacian in
+/// a single loop with the fused Laplacian operators of HorzOperators.h, which
+/// compute the intermediate divergence, curl or gradient on the fly. The
+/// first Laplacian is computed on the owned elements only, into a scratch
+/// array allocated once, and the halo layers read by the second Laplacian are
+/// filled with one partial-depth halo exchange. The second Laplacian is then
+/// computed on the owned elements, either by the compute method or fused with
+/// other terms through the Laplacian operator's add method. Both loops only
+/// visit the owned elements that have active levels.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "OmegaKokkos.h"
+
+#include <string>
+
+namespace OMEGA {
+
+/// Biharmonic operator for a vector normal to the edges, such as the normal
+/// velocity
+class Del4OnEdge {
+ public:
+   /// Number of edge halo layers of the input read by the first Laplacian on
+   /// the owned edges, and of the first Laplacian read by the second
+   static constexpr I4 NHaloLayers = 2;
+
+   /// Constructs the operator and allocates its scratch array. The name is
+   /// used for the scratch array and the persistent halo exchange pattern.
+   Del4OnEdge(const std::string &Name, ///< [in] name of the operator
+              const HorzMesh *Mesh,    ///< [in] mesh
+              Halo *MeshHalo,          ///< [in] halo for the mesh
+              I4 NVertLevels           ///< [in] number of vertical levels
+   );
+
+   /// Computes the Laplacian of VecEdge on the owned edges into the scratch
+   /// array and exchanges its first NHaloLayers halo layers. VecEdge must be
+   /// up to date on its first NHaloLayers halo layers. Returns an error code.
+   int computeDel2(const Array2DReal &VecEdge ///< [in] vector on edges
+   );
+
+   /// Computes the biharmonic operator of VecEdge on the owned edges, with
+   /// the same requirements on VecEdge as computeDel2. Returns an error code.
+   int compute(const Array2DReal &Del4Edge, ///< [out] del4 on owned edges
+               const Array2DReal &VecEdge   ///< [in] vector on edges
+   );
+
+   /// Returns the Laplacian from the last computeDel2, valid on the owned
+   /// edges and the first NHaloLayers halo layers
+   const Array2DReal &getDel2() const { return Del2Edge; }
+
+   /// Returns the fused Laplacian operator, eg. to add the second Laplacian
+   /// to a tendency
+   const VectorLaplacianOnEdge &getLaplacian() const { return Laplacian; }
+
+ private:
+   std::string Name;                ///< name of the operator
+   const HorzMesh *Mesh;            ///< mesh
+   Halo *MeshHalo;                  ///< halo for the mesh
+   I4 NChunks;                      ///< number of vertical chunks
+   VectorLaplacianOnEdge Laplacian; ///< fused Laplacian operator
+   Array2DReal Del2Edge;            ///< scratch array for the Laplacian
+};
+
+/// Biharmonic operator for a scalar on cells, such as a tracer
+class Del4OnCell {
+ public:
+   /// Number of cell halo layers of the input read by the first Laplacian on
+   /// the owned cells, and of the first Laplacian read by the second
+   static constexpr I4 NHaloLayers = 1;
+
+   /// Constructs the operator and allocates its scratch array. The name is
+   /// used for the scratch array and the persistent halo exchange pattern.
+   Del4OnCell(const std::string &Name, ///< [in] name of the operator
+              const HorzMesh *Mesh,    ///< [in] mesh
+              Halo *MeshHalo,          ///< [in] halo for the mesh
+              I4 NVertLevels           ///< [in] number of vertical levels
+   );
+
+   /// Computes the Laplacian of ScalarCell on the owned cells into the
+   /// scratch array and exchanges its first NHaloLayers halo layers.
+   /// ScalarCell can be any rank-2 view, such as a single tracer, and must be
+   /// up to date on its first NHaloLayers halo layers. Returns an error code.
+   template <typename ScalarArray>
+   int computeDel2(const ScalarArray &ScalarCell ///< [in] scalar on cells
+   ) {
+      OMEGA_SCOPE(LocLaplacian, Laplacian);
+      OMEGA_SCOPE(LocDel2Cell, Del2Cell);
+      OMEGA_SCOPE(OceanCells, Mesh->OceanCellsOwned);
+
+      parallelFor(
+          "Del4OnCell:del2", {Mesh->NCellsOwnedOcean, NChunks},
+          KOKKOS_LAMBDA(int IOcean, int KChunk) {
+             const int ICell = OceanCells(IOcean);
+             LocLaplacian(LocDel2Cell, ICell, KChunk, ScalarCell);
+          });
+
+      return exchangeDel2();
+   }
+
+   /// Computes the biharmonic operator of ScalarCell on the owned cells, with
+   /// the same requirements on ScalarCell as computeDel2. Returns an error
+   /// code.
+   template <typename ScalarArray>
+   int compute(const Array2DReal &Del4Cell,  ///< [out] del4 on owned cells
+               const ScalarArray &ScalarCell ///< [in] scalar on cells
+   ) {
+      int Err = computeDel2(ScalarCell);
+
+      OMEGA_SCOPE(LocLaplacian, Laplacian);
+      OMEGA_SCOPE(LocDel2Cell, Del2Cell);
+      OMEGA_SCOPE(OceanCells, Mesh->OceanCellsOwned);
+
+      parallelFor(
+          "Del4OnCell:del4", {Mesh->NCellsOwnedOcean, NChunks},
+          KOKKOS_LAMBDA(int IOcean, int KChunk) {
+             const int ICell = OceanCells(IOcean);
+             LocLaplacian(Del4Cell, ICell, KChunk, LocDel2Cell);
+          });
+
+      return Err;
+   }
+
+   /// Returns the Laplacian from the last computeDel2, valid on the owned
+   /// cells and the first NHaloLayers halo layers
+   const Array2DReal &getDel2() const { return Del2Cell; }
+
+   /// Returns the fused Laplacian operator
+   const ScalarLaplacianOnCell &getLaplacian() const { return Laplacian; }
+
+ private:
+   std::string Name;                ///< name of the operator
+   const HorzMesh *Mesh;            ///< mesh
+   Halo *MeshHalo;                  ///< halo for the mesh
+   I4 NChunks;                      ///< number of vertical chunks
+   ScalarLaplacianOnCell Laplacian; ///< fused Laplacian operator
+   Array2DReal Del2Cell;            ///< scratch array for the Laplacian
+
+   /// Exchanges the first NHaloLayers halo layers of the scratch array
+   int exchangeDel2();
+};
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_DEL4OPERATORS_H
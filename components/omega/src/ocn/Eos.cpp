@@ -0,0 +1,299 @@
+//===-- ocn/Eos.cpp - equation of state -------------------------*- C++ -*-===//
+//
+// All forms of the equation of state are evaluated by the same kernel, which
+// is instantiated for each functor. The kernel loads the temperature,
+// salinity and depth of a chunk of levels into registers, calls the functor
+// and stores the density and both coefficients, so each cell and level is
+// read and written once for the three quantities.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Eos.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "Logging.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+
+namespace OMEGA {
+
+Eos *Eos::DefaultEos = nullptr;
+std::map<std::string, std::unique_ptr<Eos>> Eos::AllEos;
+
+namespace {
+
+// Evaluates the equation of state Form in all active chunks of the ocean
+// cells, including the halo. Inactive chunks are set to zero, as in the
+// horizontal operators.
+template <typename F>
+void computeEos(const F &Form,                  // [in] equation of state
+                const HorzMesh *Mesh,           // [in] mesh
+                I4 NChunks,                     // [in] vertical chunks
+                const Array2DReal &Density,     // [out] density
+                const Array2DReal &ThermExp,    // [out] thermal expansion
+                const Array2DReal &HalineCont,  // [out] haline contraction
+                const Array3DReal &TracerArray, // [in] packed tracers
+                I4 IndxTemp,                    // [in] temperature index
+                I4 IndxSalt,                    // [in] salinity index
+                const Array2DReal &Depth        // [in] depth of levels
+) {
+
+   OMEGA_SCOPE(OceanCells, Mesh->OceanCellsAll);
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+   const int KLast = Density.extent_int(1) - 1;
+
+   parallelFor(
+       "Eos:compute", {Mesh->NCellsAllOcean, NChunks},
+       KOKKOS_LAMBDA(int IOcean, int KChunk) {
+          const int ICell = OceanCells(IOcean);
+          if (isInactiveChunk(KChunk, MinLevelCell(ICell),
+                              MaxLevelCell(ICell))) {
+             zeroChunk(Density, ICell, KChunk);
+             zeroChunk(ThermExp, ICell, KChunk);
+             zeroChunk(HalineCont, ICell, KChunk);
+             return;
+          }
+          const int KStart = KChunk * VecLength;
+
+          Real Temp[VecLength], Salt[VecLength], Z[VecLength];
+          for (int KVec = 0; KVec < VecLength; ++KVec) {
+             const int K = Kokkos::min(KStart + KVec, KLast);
+             Temp[KVec]  = TracerArray(IndxTemp, ICell, K);
+             Salt[KVec]  = TracerArray(IndxSalt, ICell, K);
+             Z[KVec]     = Depth(ICell, K);
+          }
+
+          Real Rho[VecLength], Alpha[VecLength], Beta[VecLength];
+          Form(Rho, Alpha, Beta, Temp, Salt, Z);
+
+          for (int KVec = 0; KVec < VecLength; ++KVec) {
+             const int K = KStart + KVec;
+             if (K <= KLast) {
+                Density(ICell, K)    = Rho[KVec];
+                ThermExp(ICell, K)   = Alpha[KVec];
+                HalineCont(ICell, K) = Beta[KVec];
+             }
+          }
+       });
+
+} // end computeEos
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Fill the table from the polynomial at each node
+
+EosTable::EosTable(const PolynomialEos &Poly, // [in] equation of state
+                   Real InTempMin,            // [in] lowest temperature
+                   Real TempMax,              // [in] highest temperature
+                   I4 InNTemp,                // [in] number of temperatures
+                   Real InSaltMin,            // [in] lowest salinity
+                   Real SaltMax,              // [in] highest salinity
+                   I4 InNSalt,                // [in] number of salinities
+                   Real DepthMax,             // [in] largest depth
+                   I4 InNDepth                // [in] number of depths
+                   )
+    : TempMin(InTempMin), SaltMin(InSaltMin),
+      InvDTemp((InNTemp - 1) / (TempMax - InTempMin)),
+      InvDSalt((InNSalt - 1) / (SaltMax - InSaltMin)),
+      InvDDepth((InNDepth - 1) / DepthMax), NTemp(InNTemp), NSalt(InNSalt),
+      NDepth(InNDepth) {
+
+   MemoryScope Scope("Eos");
+   Table = Array4DReal("EosTable", NDepth, NSalt, NTemp, 3);
+
+   OMEGA_SCOPE(LocTable, Table);
+   const Real DTemp  = 1 / InvDTemp;
+   const Real DSalt  = 1 / InvDSalt;
+   const Real DDepth = 1 / InvDDepth;
+   const Real T0     = TempMin;
+   const Real S0     = SaltMin;
+
+   parallelFor(
+       "EosTable:fill", {NDepth, NSalt, NTemp},
+       KOKKOS_LAMBDA(int IZ, int IS, int IT) {
+          Real Temp[VecLength], Salt[VecLength], Z[VecLength];
+          for (int KVec = 0; KVec < VecLength; ++KVec) {
+             Temp[KVec] = T0 + IT * DTemp;
+             Salt[KVec] = S0 + IS * DSalt;
+             Z[KVec]    = IZ * DDepth;
+          }
+          Real Rho[VecLength], Alpha[VecLength], Beta[VecLength];
+          Poly(Rho, Alpha, Beta, Temp, Salt, Z);
+          LocTable(IZ, IS, IT, 0) = Rho[0];
+          LocTable(IZ, IS, IT, 1) = Alpha[0];
+          LocTable(IZ, IS, IT, 2) = Beta[0];
+       });
+
+} // end EosTable constructor
+
+//------------------------------------------------------------------------------
+// Create the default equation of state from the configuration
+
+int Eos::init(I4 NVertLevels // [in] vertical levels
+) {
+
+   EosOptions Options;
+
+   ConfigParam<std::string> Type("Eos/EosType", "Linear");
+   ConfigParam<R8> RhoRef("Eos/RhoRef", Options.RhoRef);
+   ConfigParam<R8> LinearAlpha("Eos/LinearAlpha", Options.LinearAlpha);
+   ConfigParam<R8> LinearBeta("Eos/LinearBeta", Options.LinearBeta);
+   ConfigParam<bool> UseTable("Eos/UseTable", Options.UseTable);
+
+   int Err = Type.bind() + RhoRef.bind() + LinearAlpha.bind() +
+             LinearBeta.bind() + UseTable.bind();
+   if (Err != 0) {
+      LOG_ERROR("Eos: error reading Eos options");
+      return Err;
+   }
+
+   if (Type.get() == "Linear") {
+      Options.Type = EosType::Linear;
+   } else if (Type.get() == "Polynomial") {
+      Options.Type = EosType::Polynomial;
+   } else {
+      LOG_ERROR("Eos: unknown EosType {}, must be Linear or Polynomial",
+                Type.get());
+      return 1;
+   }
+   Options.RhoRef      = RhoRef.get();
+   Options.LinearAlpha = LinearAlpha.get();
+   Options.LinearBeta  = LinearBeta.get();
+   Options.UseTable    = UseTable.get();
+
+   DefaultEos = create("Default", HorzMesh::getDefault(), NVertLevels, Options);
+   if (DefaultEos == nullptr) {
+      LOG_ERROR("Eos: error creating default equation of state");
+      return 1;
+   }
+
+   return 0;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Create an equation of state and store it by name
+
+Eos *Eos::create(const std::string &Name,  // [in] name
+                 const HorzMesh *Mesh,     // [in] mesh
+                 I4 NVertLevels,           // [in] vertical levels
+                 const EosOptions &Options // [in] choice of form
+) {
+
+   if (AllEos.find(Name) != AllEos.end()) {
+      LOG_ERROR("Eos: attempt to create equation of state {} that already "
+                "exists",
+                Name);
+      return nullptr;
+   }
+   if (Mesh == nullptr) {
+      LOG_ERROR("Eos: equation of state {} requires a mesh", Name);
+      return nullptr;
+   }
+   if (Options.UseTable &&
+       (Options.TableNTemp < 2 || Options.TableNSalt < 2 ||
+        Options.TableNDepth < 2 ||
+        Options.TableTempMax <= Options.TableTempMin ||
+        Options.TableSaltMax <= Options.TableSaltMin ||
+        Options.TableDepthMax <= 0)) {
+      LOG_ERROR("Eos: invalid table for equation of state {}", Name);
+      return nullptr;
+   }
+
+   std::unique_ptr<Eos> NewEos(new Eos(Name, Mesh, NVertLevels, Options));
+
+   Eos *NewEosPtr = NewEos.get();
+   AllEos.emplace(Name, std::move(NewEos));
+   return NewEosPtr;
+
+} // end create
+
+//------------------------------------------------------------------------------
+// Construct the equation of state and allocate the output arrays
+
+Eos::Eos(const std::string &InName, // [in] name
+         const HorzMesh *InMesh,    // [in] mesh
+         I4 NVertLevels,            // [in] vertical levels
+         const EosOptions &Options  // [in] choice of form
+         )
+    : Name(InName), Mesh(InMesh), NChunks(numVertChunks(NVertLevels)),
+      Type(Options.Type) {
+
+   MemoryScope Scope("Eos");
+
+   Linear.RhoRef     = Options.RhoRef;
+   Linear.Alpha      = Options.LinearAlpha;
+   Linear.Beta       = Options.LinearBeta;
+   Polynomial.RhoRef = Options.RhoRef;
+
+   if (Type == EosType::Polynomial && Options.UseTable)
+      Table = std::make_unique<EosTable>(
+          Polynomial, Options.TableTempMin, Options.TableTempMax,
+          Options.TableNTemp, Options.TableSaltMin, Options.TableSaltMax,
+          Options.TableNSalt, Options.TableDepthMax, Options.TableNDepth);
+
+   const I4 NCells   = Mesh->NCellsSize;
+   Density           = Array2DReal("Density" + Name, NCells, NVertLevels);
+   ThermalExpansion  = Array2DReal("ThermalExpansion" + Name, NCells,
+                                   NVertLevels);
+   HalineContraction = Array2DReal("HalineContraction" + Name, NCells,
+                                   NVertLevels);
+
+} // end constructor
+
+//------------------------------------------------------------------------------
+// Retrieve, remove and clear equations of state
+
+Eos *Eos::getDefault() { return DefaultEos; }
+
+Eos *Eos::get(const std::string &Name // [in] name
+) {
+   auto It = AllEos.find(Name);
+   if (It == AllEos.end()) {
+      LOG_ERROR("Eos: attempt to retrieve non-existent equation of state {}",
+                Name);
+      return nullptr;
+   }
+   return It->second.get();
+}
+
+void Eos::erase(const std::string &Name // [in] name
+) {
+   if (DefaultEos != nullptr && DefaultEos->Name == Name)
+      DefaultEos = nullptr;
+   AllEos.erase(Name);
+}
+
+void Eos::clear() {
+   DefaultEos = nullptr;
+   AllEos.clear();
+}
+
+//------------------------------------------------------------------------------
+// Compute the density and coefficients with the chosen form
+
+void Eos::compute(const Array3DReal &TracerArray, // [in] packed tracers
+                  I4 IndxTemp,                    // [in] temperature index
+                  I4 IndxSalt,                    // [in] salinity index
+                  const Array2DReal &Depth        // [in] depth of levels
+) const {
+
+   if (Table != nullptr)
+      computeEos(*Table, Mesh, NChunks, Density, ThermalExpansion,
+                 HalineContraction, TracerArray, IndxTemp, IndxSalt, Depth);
+   else if (Type == EosType::Polynomial)
+      computeEos(Polynomial, Mesh, NChunks, Density, ThermalExpansion,
+                 HalineContraction, TracerArray, IndxTemp, IndxSalt, Depth);
+   else
+      computeEos(Linear, Mesh, NChunks, Density, ThermalExpansion,
+                 HalineContraction, TracerArray, IndxTemp, IndxSalt, Depth);
+
+} // end compute
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
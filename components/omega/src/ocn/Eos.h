@@ -0,0 +1,259 @@
+#ifndef OMEGA_EOS_H
+#define OMEGA_EOS_H
+//===-- ocn/Eos.h - equation of state ---------------------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the equation of state of sea water
+///
+/// The Eos class computes the density of sea water and its thermal expansion
+/// and haline contraction coefficients from the temperature and salinity
+/// tracers and the depth, for every ocean cell and level. Each form of the
+/// equation of state is a functor that evaluates all three quantities for a
+/// chunk of VecLength levels held in registers, so the compiler vectorizes
+/// the evaluation over the levels of the chunk, and the kernel of Eos loads
+/// the temperature and salinity directly from the packed tracer array and
+/// stores the three results in one pass. A nonlinear equation of state can
+/// also be evaluated by trilinear interpolation in a table built once from
+/// the polynomial.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace OMEGA {
+
+/// Forms of the equation of state
+enum class EosType {
+   Linear,    ///< linear in temperature and salinity
+   Polynomial ///< simplified TEOS-10 polynomial of Roquet et al. (2015)
+};
+
+/// Linear equation of state
+///    Rho = RhoRef (1 - Alpha (T - TempRef) + Beta (S - SaltRef))
+/// with constant expansion and contraction coefficients
+class LinearEos {
+ public:
+   Real RhoRef  = 1026.0; ///< reference density (kg/m^3)
+   Real TempRef = 10.0;   ///< reference temperature (C)
+   Real SaltRef = 35.0;   ///< reference salinity (g/kg)
+   Real Alpha   = 2.0e-4; ///< thermal expansion coefficient (1/C)
+   Real Beta    = 7.6e-4; ///< haline contraction coefficient (kg/g)
+
+   KOKKOS_FUNCTION void operator()(Real (&Rho)[VecLength],
+                                   Real (&ThermExp)[VecLength],
+                                   Real (&HalineCont)[VecLength],
+                                   const Real (&Temp)[VecLength],
+                                   const Real (&Salt)[VecLength],
+                                   const Real (&Depth)[VecLength]) const {
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         Rho[KVec] = RhoRef * (1 - Alpha * (Temp[KVec] - TempRef) +
+                               Beta * (Salt[KVec] - SaltRef));
+         ThermExp[KVec]   = Alpha;
+         HalineCont[KVec] = Beta;
+      }
+   }
+};
+
+/// Simplified equation of state of Roquet et al. (2015), a polynomial fit
+/// to TEOS-10 that keeps the cabbeling, thermobaricity and the nonlinear
+/// dependence of the expansion coefficients on temperature
+///    Rho = RhoRef - A0 (1 + Lambda1/2 T' + Mu1 Z) T'
+///                 + B0 (1 - Lambda2/2 S' - Mu2 Z) S' - Nu T' S'
+/// with T' = T - 10 C, S' = S - 35 g/kg and the depth Z in m
+class PolynomialEos {
+ public:
+   Real RhoRef  = 1026.0;    ///< reference density (kg/m^3)
+   Real A0      = 1.6550e-1; ///< linear thermal expansion (kg/m^3/C)
+   Real B0      = 7.6554e-1; ///< linear haline contraction (kg/m^3/(g/kg))
+   Real Lambda1 = 5.9520e-2; ///< cabbeling in temperature (1/C)
+   Real Lambda2 = 7.4914e-4; ///< cabbeling in salinity (kg/g)
+   Real Mu1     = 1.4970e-4; ///< thermobaricity in temperature (1/m)
+   Real Mu2     = 1.1090e-5; ///< thermobaricity in salinity (1/m)
+   Real Nu      = 2.4341e-3; ///< cabbeling between T and S
+
+   KOKKOS_FUNCTION void operator()(Real (&Rho)[VecLength],
+                                   Real (&ThermExp)[VecLength],
+                                   Real (&HalineCont)[VecLength],
+                                   const Real (&Temp)[VecLength],
+                                   const Real (&Salt)[VecLength],
+                                   const Real (&Depth)[VecLength]) const {
+      const Real InvRhoRef = 1 / RhoRef;
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const Real TA    = Temp[KVec] - 10;
+         const Real SA    = Salt[KVec] - 35;
+         const Real Z     = Depth[KVec];
+         const Real TTerm = A0 * (1 + 0.5 * Lambda1 * TA + Mu1 * Z);
+         const Real STerm = B0 * (1 - 0.5 * Lambda2 * SA - Mu2 * Z);
+         Rho[KVec]        = RhoRef - TTerm * TA + STerm * SA - Nu * TA * SA;
+         ThermExp[KVec] =
+             (A0 * (1 + Lambda1 * TA + Mu1 * Z) + Nu * SA) * InvRhoRef;
+         HalineCont[KVec] =
+             (B0 * (1 - Lambda2 * SA - Mu2 * Z) - Nu * TA) * InvRhoRef;
+      }
+   }
+};
+
+/// Table of the density and expansion coefficients on a regular grid in
+/// temperature, salinity and depth, interpolated trilinearly. Values outside
+/// the range of the table are taken at the nearest point of the range.
+class EosTable {
+ public:
+   /// Fills the table from the polynomial equation of state
+   EosTable(const PolynomialEos &Poly, ///< [in] equation of state
+            Real TempMin,              ///< [in] lowest temperature (C)
+            Real TempMax,              ///< [in] highest temperature (C)
+            I4 NTemp,                  ///< [in] number of temperatures
+            Real SaltMin,              ///< [in] lowest salinity (g/kg)
+            Real SaltMax,              ///< [in] highest salinity (g/kg)
+            I4 NSalt,                  ///< [in] number of salinities
+            Real DepthMax,             ///< [in] largest depth (m)
+            I4 NDepth                  ///< [in] number of depths
+   );
+
+   KOKKOS_FUNCTION void operator()(Real (&Rho)[VecLength],
+                                   Real (&ThermExp)[VecLength],
+                                   Real (&HalineCont)[VecLength],
+                                   const Real (&Temp)[VecLength],
+                                   const Real (&Salt)[VecLength],
+                                   const Real (&Depth)[VecLength]) const {
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         int IT, IS, IZ;
+         Real WT, WS, WZ;
+         locate(IT, WT, Temp[KVec], TempMin, InvDTemp, NTemp);
+         locate(IS, WS, Salt[KVec], SaltMin, InvDSalt, NSalt);
+         locate(IZ, WZ, Depth[KVec], 0, InvDDepth, NDepth);
+
+         Real Val[3] = {0, 0, 0};
+         for (int CZ = 0; CZ < 2; ++CZ) {
+            const Real FZ = CZ == 0 ? 1 - WZ : WZ;
+            for (int CS = 0; CS < 2; ++CS) {
+               const Real FZS = FZ * (CS == 0 ? 1 - WS : WS);
+               for (int CT = 0; CT < 2; ++CT) {
+                  const Real F = FZS * (CT == 0 ? 1 - WT : WT);
+                  for (int V = 0; V < 3; ++V)
+                     Val[V] += F * Table(IZ + CZ, IS + CS, IT + CT, V);
+               }
+            }
+         }
+         Rho[KVec]        = Val[0];
+         ThermExp[KVec]   = Val[1];
+         HalineCont[KVec] = Val[2];
+      }
+   }
+
+ private:
+   /// Finds the lower node I of the interval holding X and the weight W of
+   /// the upper node, clamping X to the range of the table
+   KOKKOS_FUNCTION static void locate(int &I, Real &W, Real X, Real XMin,
+                                      Real InvDX, int NX) {
+      const Real Pos =
+          Kokkos::min(Kokkos::max((X - XMin) * InvDX, Real(0)), Real(NX - 1));
+      I = Kokkos::min(static_cast<int>(Pos), NX - 2);
+      W = Pos - I;
+   }
+
+   Real TempMin;      ///< lowest temperature of the table
+   Real SaltMin;      ///< lowest salinity of the table
+   Real InvDTemp;     ///< inverse of the temperature spacing
+   Real InvDSalt;     ///< inverse of the salinity spacing
+   Real InvDDepth;    ///< inverse of the depth spacing
+   I4 NTemp;          ///< number of temperatures
+   I4 NSalt;          ///< number of salinities
+   I4 NDepth;         ///< number of depths
+   Array4DReal Table; ///< density, expansion and contraction at each node
+};
+
+/// Options of the equation of state
+struct EosOptions {
+   EosType Type     = EosType::Linear; ///< form of the equation of state
+   R8 RhoRef        = 1026.0;          ///< reference density (kg/m^3)
+   R8 LinearAlpha   = 2.0e-4;          ///< linear thermal expansion (1/C)
+   R8 LinearBeta    = 7.6e-4;          ///< linear haline contraction (kg/g)
+   bool UseTable    = false;           ///< interpolate the polynomial
+   R8 TableTempMin  = -2.5;            ///< lowest temperature of the table
+   R8 TableTempMax  = 35.0;            ///< highest temperature of the table
+   I4 TableNTemp    = 151;             ///< temperatures of the table
+   R8 TableSaltMin  = 0.0;             ///< lowest salinity of the table
+   R8 TableSaltMax  = 42.0;            ///< highest salinity of the table
+   I4 TableNSalt    = 169;             ///< salinities of the table
+   R8 TableDepthMax = 6000.0;          ///< largest depth of the table
+   I4 TableNDepth   = 7;               ///< depths of the table
+};
+
+/// Equation of state of sea water. Computes the density, thermal expansion
+/// coefficient -1/RhoRef dRho/dT and haline contraction coefficient
+/// 1/RhoRef dRho/dS in all ocean cells, including the halo, with one kernel.
+class Eos {
+ public:
+   Array2DReal Density;           ///< density (kg/m^3)
+   Array2DReal ThermalExpansion;  ///< thermal expansion coefficient (1/C)
+   Array2DReal HalineContraction; ///< haline contraction coefficient (kg/g)
+
+   /// Creates the default equation of state on the default mesh, with the
+   /// options of the Eos configuration group. Returns an error code.
+   static int init(I4 NVertLevels ///< [in] number of vertical levels
+   );
+
+   /// Creates an equation of state and stores it under Name. Returns a
+   /// pointer to the new equation of state, or nullptr on error.
+   static Eos *create(const std::string &Name,  ///< [in] name
+                      const HorzMesh *Mesh,     ///< [in] mesh
+                      I4 NVertLevels,           ///< [in] vertical levels
+                      const EosOptions &Options ///< [in] choice of form
+   );
+
+   /// Returns the default equation of state
+   static Eos *getDefault();
+
+   /// Returns the equation of state Name, or nullptr if it does not exist
+   static Eos *get(const std::string &Name ///< [in] name
+   );
+
+   /// Removes the equation of state Name
+   static void erase(const std::string &Name ///< [in] name
+   );
+
+   /// Removes all equations of state
+   static void clear();
+
+   /// Computes the density and the expansion and contraction coefficients
+   /// from the temperature and salinity in the packed tracer array and the
+   /// depth of each cell and level (m, positive downward)
+   void compute(const Array3DReal &TracerArray, ///< [in] packed tracers
+                I4 IndxTemp,                    ///< [in] temperature index
+                I4 IndxSalt,                    ///< [in] salinity index
+                const Array2DReal &Depth        ///< [in] depth of levels
+   ) const;
+
+   /// Form of the equation of state
+   EosType getType() const { return Type; }
+
+   /// True if the polynomial is interpolated from a table
+   bool usesTable() const { return Table != nullptr; }
+
+ private:
+   Eos(const std::string &InName, const HorzMesh *InMesh, I4 InNVertLevels,
+       const EosOptions &Options);
+
+   std::string Name;                ///< name of this equation of state
+   const HorzMesh *Mesh;            ///< mesh of the cells
+   I4 NChunks;                      ///< number of vertical chunks
+   EosType Type;                    ///< form of the equation of state
+   LinearEos Linear;                ///< linear form
+   PolynomialEos Polynomial;        ///< polynomial form
+   std::unique_ptr<EosTable> Table; ///< table of the polynomial, if used
+
+   static Eos *DefaultEos;
+   static std::map<std::string, std::unique_ptr<Eos>> AllEos;
+
+}; // end class Eos
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_EOS_H
@@ -0,0 +1,78 @@
+//===-- ocn/FieldDefs.cpp - compile-time field definitions ------*- C++ -*-===//
+//
+// IO registration of the fields listed in FieldDefs.inc
+//
+//===----------------------------------------------------------------------===//
+
+#include "FieldDefs.h"
+#include "Decomp.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MetaData.h"
+
+#include <memory>
+
+namespace OMEGA {
+
+namespace {
+
+// Returns the metadata dimension Name, creating it if needed
+std::shared_ptr<MetaDim> getDim(const std::string &Name, I4 Length) {
+   if (MetaDim::has(Name))
+      return MetaDim::get(Name);
+   return MetaDim::create(Name, Length);
+}
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Define the metadata and IO field of a field and attach its array
+
+int defineField(FieldId Id, const std::string &Suffix, const Array2DReal &Data,
+                I4 &Handle) {
+
+   const FieldDef &Def         = getFieldDef(Id);
+   const std::string FieldName = Def.Name + Suffix;
+
+   Decomp *DefDecomp = Decomp::getDefault();
+   std::shared_ptr<MetaDim> MeshDimPtr;
+   switch (Def.Dim) {
+   case MeshDim::Cells:
+      MeshDimPtr = getDim("NCells", DefDecomp->NCellsGlobal);
+      break;
+   case MeshDim::Edges:
+      MeshDimPtr = getDim("NEdges", DefDecomp->NEdgesGlobal);
+      break;
+   case MeshDim::Vertices:
+      MeshDimPtr = getDim("NVertices", DefDecomp->NVerticesGlobal);
+      break;
+   }
+
+   auto Meta = ArrayMetaData::create(
+       FieldName, Def.Description, Def.Units, Def.StdName, Def.ValidMin,
+       Def.ValidMax, Def.FillValue, 2,
+       {MeshDimPtr, getDim("NVertLevels", Data.extent_int(1))});
+   if (Meta == nullptr || IOField::define(FieldName, Handle) != 0) {
+      LOG_ERROR("FieldDefs: error registering {} for IO", FieldName);
+      Handle = -1;
+      return 1;
+   }
+
+   return IOField::attachData<Array2DReal>(Handle, Data);
+
+} // end defineField
+
+//------------------------------------------------------------------------------
+// Remove the IO field and metadata of a field
+
+void eraseField(FieldId Id, const std::string &Suffix) {
+
+   const std::string FieldName = getFieldDef(Id).Name + Suffix;
+   if (IOField::isDefined(FieldName))
+      IOField::erase(FieldName);
+   if (MetaData::has(FieldName))
+      MetaData::destroy(FieldName);
+
+} // end eraseField
+
+} // end namespace OMEGA
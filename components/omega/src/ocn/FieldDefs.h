@@ -0,0 +1,81 @@
+#ifndef OMEGA_FIELDDEFS_H
+#define OMEGA_FIELDDEFS_H
+//===-- ocn/FieldDefs.h - compile-time field definitions --------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the table of model field definitions
+///
+/// The metadata of the state and auxiliary fields (description, units,
+/// valid range and mesh dimension) are listed once in FieldDefs.inc and
+/// compiled into a constexpr table indexed by the FieldId enum, in the same
+/// way tracers are listed in TracerDefs.inc. Modules register a field for
+/// IO with defineField, which builds the metadata from the table and
+/// returns the IOField handle, so that arrays can later be re-attached
+/// (eg. when time levels change) without any lookup by name.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <string>
+
+namespace OMEGA {
+
+/// Mesh dimension of a field
+enum class MeshDim : I4 { Cells, Edges, Vertices };
+
+/// Integer IDs of all fields in FieldDefs.inc
+enum class FieldId : I4 {
+#define OMEGA_FIELD(Name, Desc, Units, StdName, Min, Max, Fill, Dim) Name,
+#include "FieldDefs.inc"
+#undef OMEGA_FIELD
+   NumFields
+};
+
+/// Definition of a field
+struct FieldDef {
+   const char *Name;        ///< base name of the IO field
+   const char *Description; ///< long name
+   const char *Units;       ///< units
+   const char *StdName;     ///< CF standard name
+   R8 ValidMin;             ///< min valid value
+   R8 ValidMax;             ///< max valid value
+   R8 FillValue;            ///< fill value
+   MeshDim Dim;             ///< mesh dimension
+};
+
+/// Definitions of all fields, indexed by FieldId
+constexpr FieldDef FieldDefinitions[] = {
+#define OMEGA_FIELD(Name, Desc, Units, StdName, Min, Max, Fill, Dim) \
+   {#Name, Desc, Units, StdName, Min, Max, Fill, Dim},
+#include "FieldDefs.inc"
+#undef OMEGA_FIELD
+};
+
+static_assert(sizeof(FieldDefinitions) / sizeof(FieldDef) ==
+                  static_cast<size_t>(FieldId::NumFields),
+              "FieldDefinitions must have one entry per FieldId");
+
+/// Returns the definition of a field
+constexpr const FieldDef &getFieldDef(FieldId Id) {
+   return FieldDefinitions[static_cast<I4>(Id)];
+}
+
+/// Defines the metadata and IO field Name + Suffix of a (mesh element,
+/// vertical level) field from its definition and attaches its array. The
+/// IOField handle is returned in Handle. Returns an error code.
+int defineField(FieldId Id,                 ///< [in] field ID
+                const std::string &Suffix,  ///< [in] suffix of the field name
+                const Array2DReal &Data,    ///< [in] array to attach
+                I4 &Handle                  ///< [out] IOField handle
+);
+
+/// Removes the IO field and metadata of a field defined with defineField
+void eraseField(FieldId Id,               ///< [in] field ID
+                const std::string &Suffix ///< [in] suffix of the field name
+);
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_FIELDDEFS_H
@@ -10,12 +10,20 @@
 //===----------------------------------------------------------------------===//
 
 #include "HorzMesh.h"
+#include "Config.h"
 #include "DataTypes.h"
 #include "Decomp.h"
+#include "Halo.h"
 #include "IO.h"
 #include "Logging.h"
 #include "MachEnv.h"
+#include "MemoryTracker.h"
 #include "OmegaKokkos.h"
+#include "Snapshot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace OMEGA {
 
@@ -23,6 +31,37 @@ namespace OMEGA {
 HorzMesh *HorzMesh::DefaultHorzMesh = nullptr;
 std::map<std::string, HorzMesh> HorzMesh::AllHorzMeshes;
 
+namespace {
+
+// Rotation rate of the Earth (s^-1) used for the Coriolis parameters
+constexpr R8 RotationRate = 7.29212e-5;
+
+// Great circle angle between two points given by unit vectors
+KOKKOS_INLINE_FUNCTION R8 arcAngle(const R8 A[3], const R8 B[3]) {
+   R8 Cross0 = A[1] * B[2] - A[2] * B[1];
+   R8 Cross1 = A[2] * B[0] - A[0] * B[2];
+   R8 Cross2 = A[0] * B[1] - A[1] * B[0];
+   R8 Dot    = A[0] * B[0] + A[1] * B[1] + A[2] * B[2];
+   return Kokkos::atan2(
+       Kokkos::sqrt(Cross0 * Cross0 + Cross1 * Cross1 + Cross2 * Cross2), Dot);
+}
+
+// Area on the unit sphere of the spherical triangle with corners given by
+// unit vectors, from the spherical excess E with
+// tan(E/2) = |A.(BxC)| / (1 + A.B + B.C + C.A)
+KOKKOS_INLINE_FUNCTION R8 triangleArea(const R8 A[3], const R8 B[3],
+                                       const R8 C[3]) {
+   R8 Triple = A[0] * (B[1] * C[2] - B[2] * C[1]) +
+               A[1] * (B[2] * C[0] - B[0] * C[2]) +
+               A[2] * (B[0] * C[1] - B[1] * C[0]);
+   R8 Denom  = 1.0 + A[0] * B[0] + A[1] * B[1] + A[2] * B[2] + B[0] * C[0] +
+              B[1] * C[1] + B[2] * C[2] + C[0] * A[0] + C[1] * A[1] +
+              C[2] * A[2];
+   return 2.0 * Kokkos::atan2(Kokkos::fabs(Triple), Denom);
+}
+
+} // end anonymous namespace
+
 //------------------------------------------------------------------------------
 // Initialize the mesh. Assumes that Decomp has already been initialized.
 
@@ -33,11 +72,52 @@ int HorzMesh::init() {
    // Retrieve the default decomposition
    Decomp *DefDecomp = Decomp::getDefault();
 
+   // Optional mesh fields to read when the mesh is created, from the
+   // HorzMesh group of the configuration if present. Fields that are not
+   // read here are read on first request (eg loadCoordinates).
+   bool ReadCoordinates = false;
+   bool ReadMeshDensity = false;
+   // Compute the derived mesh quantities rather than reading them
+   bool ComputeDerived = false;
+   // Release the host copies of the decomposition and mesh arrays once they
+   // are on the device ("device-only" mode), to reduce host memory when
+   // several GPUs share a node. Host code rematerializes them with getHost.
+   bool ReleaseHostArrays = false;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("HorzMesh")) {
+      Config MeshConfig("HorzMesh");
+      Err = OmegaConfig->get(MeshConfig);
+      if (Err != 0) {
+         LOG_ERROR("HorzMesh: error retrieving HorzMesh configuration");
+         return Err;
+      }
+      if (MeshConfig.existsVar("ReadCoordinates"))
+         Err += MeshConfig.get("ReadCoordinates", ReadCoordinates);
+      if (MeshConfig.existsVar("ReadMeshDensity"))
+         Err += MeshConfig.get("ReadMeshDensity", ReadMeshDensity);
+      if (MeshConfig.existsVar("ComputeDerived"))
+         Err += MeshConfig.get("ComputeDerived", ComputeDerived);
+      if (MeshConfig.existsVar("ReleaseHostArrays"))
+         Err += MeshConfig.get("ReleaseHostArrays", ReleaseHostArrays);
+      if (Err != 0) {
+         LOG_ERROR("HorzMesh: error reading HorzMesh options");
+         return Err;
+      }
+   }
+
    // Create the default mesh
-   HorzMesh DefHorzMesh("Default", DefDecomp);
+   HorzMesh DefHorzMesh("Default", DefDecomp, ReadCoordinates,
+                        ReadMeshDensity, ComputeDerived);
 
    // Retrieve this mesh and set pointer to DefaultHorzMesh
    HorzMesh::DefaultHorzMesh = HorzMesh::get("Default");
+
+   if (ReleaseHostArrays) {
+      DefDecomp->releaseHostArrays();
+      HorzMesh::DefaultHorzMesh->releaseHostArrays();
+   }
+
    return Err;
 }
 
@@ -45,11 +125,19 @@ int HorzMesh::init() {
 // Construct a new local mesh given a decomposition
 
 HorzMesh::HorzMesh(const std::string &Name, //< [in] Name for new mesh
-                   Decomp *MeshDecomp       //< [in] Decomp for the new mesh
+                   Decomp *MeshDecomp,      //< [in] Decomp for the new mesh
+                   bool ReadCoordinates,    //< [in] read optional coordinates
+                   bool ReadMeshDensity,    //< [in] read optional mesh density
+                   bool ComputeDerived      //< [in] compute derived quantities
 ) {
 
-   // Retrieve mesh files name from Decomp
+   // Charge the mesh arrays to the HorzMesh subsystem
+   MemoryScope Scope("HorzMesh");
+
+   // Retrieve mesh files name from Decomp and save the decomposition
+   // for later reads of optional fields
    MeshFileName = MeshDecomp->MeshFileName;
+   ReadDecomp   = MeshDecomp;
 
    // Retrieve mesh cell/edge/vertex totals from Decomp
    NCellsOwned = MeshDecomp->NCellsOwned;
@@ -67,6 +155,20 @@ HorzMesh::HorzMesh(const std::string &Name, //< [in] Name for new mesh
    NVerticesSize  = MeshDecomp->NVerticesSize;
    VertexDegree   = MeshDecomp->VertexDegree;
 
+   HaloWidth   = MeshDecomp->HaloWidth;
+   NCellsHaloH = MeshDecomp->NCellsHaloH;
+   NEdgesHaloH = MeshDecomp->NEdgesHaloH;
+
+   // Select the compile-time specializations of the horizontal operators for
+   // the common MPAS-Ocean mesh values, otherwise use the generic operators
+   OpMaxEdges     = (MaxEdges >= 6 and MaxEdges <= 8) ? MaxEdges : 0;
+   OpVertexDegree = VertexDegree == 3 ? VertexDegree : 0;
+
+   // The padded cell to edge incidence is the default. The CSR form avoids
+   // the unused entries of meshes with cells of fewer than MaxEdges edges
+   // and can be selected from the benchmark of the operators.
+   OpCellCSR = false;
+
    // Retrieve connectivity arrays from Decomp
    CellsOnCellH    = MeshDecomp->CellsOnCellH;
    EdgesOnCellH    = MeshDecomp->EdgesOnCellH;
@@ -90,42 +192,74 @@ HorzMesh::HorzMesh(const std::string &Name, //< [in] Name for new mesh
    CellsOnVertex  = MeshDecomp->CellsOnVertex;
    EdgesOnVertex  = MeshDecomp->EdgesOnVertex;
 
-   // Open the mesh file for reading (assume IO has already been initialized)
-   I4 Err;
-   Err = OMEGA::IO::openFile(MeshFileID, MeshFileName, IO::ModeRead);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error opening mesh file");
-
-   // Create the parallel IO decompositions required to read in mesh variables
-   initParallelIO(MeshDecomp);
-
-   // Read x/y/z and lon/lat coordinates for cells, edges, and vertices
-   readCoordinates();
-
-   // Read the cell-centered bottom depth
-   readBottomDepth();
-
-   // Read the mesh areas, lengths, and angles
-   readMeasurements();
-
-   // Read the edge mesh weights
-   readWeights();
-
-   // Read the Coriolis parameter at the cells, edges, and vertices
-   readCoriolis();
-
-   // Destroy the parallel IO decompositions
-   finalizeParallelIO();
-
-   // Copy host data to device
-   copyToDevice();
+   // Restore the mesh variables from a snapshot if one exists for the
+   // default decomposition
+   MPI_Comm Comm = MachEnv::getDefaultEnv()->getComm();
+   std::vector<I4> SnapshotConfig;
+   bool Restored = false;
+   if (!MeshDecomp->SnapshotName.empty() and
+       MeshDecomp == Decomp::getDefault()) {
+      SnapshotConfig = snapshotConfig(Comm, ComputeDerived);
+      Restored       = readSnapshot(Comm, SnapshotConfig) == 0;
+   }
 
-   // TODO: add ability to compute (rather than read in)
-   // dependent mesh quantities
+   if (Restored) {
+      // Read any requested optional fields missing from the snapshot
+      if (ReadCoordinates)
+         loadCoordinates();
+      if (ReadMeshDensity)
+         loadMeshDensity();
+   } else {
+      // Open the mesh file for reading (assume IO has already been
+      // initialized)
+      I4 Err;
+      Err = OMEGA::IO::openFile(MeshFileID, MeshFileName, IO::ModeRead);
+      if (Err != 0)
+         LOG_CRITICAL("HorzMesh: error opening mesh file");
+
+      // Create the parallel IO decompositions required to read in mesh
+      // variables
+      initParallelIO(MeshDecomp);
+
+      // The derived quantities can only be computed for spherical meshes
+      if (ComputeDerived)
+         ComputeDerived = readSphereRadius();
+
+      // Read all mesh variables and transfer those needed to the device
+      readMesh(ReadCoordinates, ReadMeshDensity, ComputeDerived);
+
+      // Destroy the parallel IO decompositions and close the mesh file
+      finalizeParallelIO();
+
+      Err = IO::closeFile(MeshFileID);
+      if (Err != 0)
+         LOG_ERROR("HorzMesh: error closing mesh file");
+
+      // Compute the derived mesh quantities that were not read
+      if (ComputeDerived)
+         computeDerivedMesh();
+
+      // Save the mesh variables for reuse in later runs
+      if (!SnapshotConfig.empty())
+         writeSnapshot(Comm, SnapshotConfig);
+   }
 
    // Compute EdgeSignOnCells and EdgeSignOnVertex
    computeEdgeSign();
 
+   // Compute the metric terms used by the horizontal operators
+   computeOperatorMetrics();
+
+   // Make all levels active until the vertical levels are initialized. The
+   // neighbor entries beyond the local cells have no active levels.
+   MinLevelCellH = HostArray1DI4("MinLevelCell", NCellsSize);
+   MaxLevelCellH = HostArray1DI4("MaxLevelCell", NCellsSize);
+   for (int Cell = 0; Cell < NCellsSize; ++Cell) {
+      MinLevelCellH(Cell) = Cell < NCellsAll ? 0 : AllLevelsActive;
+      MaxLevelCellH(Cell) = Cell < NCellsAll ? AllLevelsActive : -1;
+   }
+   updateLevelBounds();
+
    // Associate this instance with a name
    AllHorzMeshes.emplace(Name, *this);
 
@@ -167,9 +301,10 @@ void HorzMesh::initParallelIO(Decomp *MeshDecomp) {
 
    // Create the IO decomp for arrays with (NCells) dimensions
    std::vector<I4> CellDims{MeshDecomp->NCellsGlobal};
+   const HostArray1DI4 CellIDH = MeshDecomp->getHost(MeshDecomp->CellIDH);
    std::vector<I4> CellID(NCellsAll);
    for (int Cell = 0; Cell < NCellsAll; ++Cell) {
-      CellID[Cell] = MeshDecomp->CellIDH(Cell) - 1;
+      CellID[Cell] = CellIDH(Cell) - 1;
    }
 
    Err = IO::createDecomp(CellDecompR8, IO::IOTypeR8, NDims, CellDims,
@@ -179,9 +314,10 @@ void HorzMesh::initParallelIO(Decomp *MeshDecomp) {
 
    // Create the IO decomp for arrays with (NEdges) dimensions
    std::vector<I4> EdgeDims{MeshDecomp->NEdgesGlobal};
+   const HostArray1DI4 EdgeIDH = MeshDecomp->getHost(MeshDecomp->EdgeIDH);
    std::vector<I4> EdgeID(NEdgesAll);
    for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
-      EdgeID[Edge] = MeshDecomp->EdgeIDH(Edge) - 1;
+      EdgeID[Edge] = EdgeIDH(Edge) - 1;
    }
 
    Err = IO::createDecomp(EdgeDecompR8, IO::IOTypeR8, NDims, EdgeDims,
@@ -191,9 +327,11 @@ void HorzMesh::initParallelIO(Decomp *MeshDecomp) {
 
    // Create the IO decomp for arrays with (NVertices) dimensions
    std::vector<I4> VertexDims{MeshDecomp->NVerticesGlobal};
+   const HostArray1DI4 VertexIDH =
+       MeshDecomp->getHost(MeshDecomp->VertexIDH);
    std::vector<I4> VertexID(NVerticesAll);
    for (int Vertex = 0; Vertex < NVerticesAll; ++Vertex) {
-      VertexID[Vertex] = MeshDecomp->VertexIDH(Vertex) - 1;
+      VertexID[Vertex] = VertexIDH(Vertex) - 1;
    }
 
    Err = IO::createDecomp(VertexDecompR8, IO::IOTypeR8, NDims, VertexDims,
@@ -206,10 +344,11 @@ void HorzMesh::initParallelIO(Decomp *MeshDecomp) {
    MaxEdges2 = 2 * MaxEdges;
    std::vector<I4> OnEdgeDims2{MeshDecomp->NEdgesGlobal, MaxEdges2};
    I4 OnEdgeSize2 = NEdgesAll * MaxEdges2;
-   std::vector<I4> OnEdgeOffset2(OnEdgeSize2, -1);
+   // The offsets of 2-d arrays can exceed the 32-bit range on large meshes
+   std::vector<I8> OnEdgeOffset2(OnEdgeSize2, -1);
    for (int Edge = 0; Edge < NEdgesAll; Edge++) {
       for (int i = 0; i < MaxEdges2; i++) {
-         I4 GlobalID = EdgeID[Edge] * MaxEdges2 + i;
+         I8 GlobalID = static_cast<I8>(EdgeID[Edge]) * MaxEdges2 + i;
 
          OnEdgeOffset2[Edge * MaxEdges2 + i] = GlobalID;
       }
@@ -223,10 +362,10 @@ void HorzMesh::initParallelIO(Decomp *MeshDecomp) {
    // Create the IO decomp for arrays with (NVertices, VertexDegree) dimensions
    std::vector<I4> OnVertexDims{MeshDecomp->NVerticesGlobal, VertexDegree};
    I4 OnVertexSize = NVerticesAll * VertexDegree;
-   std::vector<I4> OnVertexOffset(OnVertexSize, -1);
+   std::vector<I8> OnVertexOffset(OnVertexSize, -1);
    for (int Vertex = 0; Vertex < NVerticesAll; Vertex++) {
       for (int i = 0; i < VertexDegree; i++) {
-         I4 GlobalID = VertexID[Vertex] * VertexDegree + i;
+         I8 GlobalID = static_cast<I8>(VertexID[Vertex]) * VertexDegree + i;
          OnVertexOffset[Vertex * VertexDegree + i] = GlobalID;
       }
    }
@@ -272,240 +411,671 @@ void HorzMesh::finalizeParallelIO() {
 } // end finalizeParallelIO
 
 //------------------------------------------------------------------------------
-// Read x/y/z and lon/lat coordinates for cells, edges, and vertices
-void HorzMesh::readCoordinates() {
+// Read a batch of 1-d mesh variables that share a decomposition into a single
+// contiguous host buffer, with one read per variable issued back to back.
+// Each host array is set to the portion of the buffer for its variable and
+// the buffer is returned so that the batch can be moved to the device with a
+// single transfer.
+HostArray1DR8
+HorzMesh::readBatch(const std::vector<std::string> &VarNames, // [in] vars
+                    const std::vector<HostArray1DR8 *> &Arrays, // [out] arrays
+                    I4 DecompID, // [in] IO decomposition for batch
+                    I4 NAll,     // [in] number of local (owned+halo) entries
+                    I4 NSize     // [in] array size for each variable
+) {
+
+   I4 NVars = VarNames.size();
+   HostArray1DR8 Buffer("MeshBatch", NVars * NSize);
+
+   for (int IVar = 0; IVar < NVars; ++IVar) {
+      I4 Offset     = IVar * NSize;
+      *Arrays[IVar] = Kokkos::subview(
+          Buffer, Kokkos::make_pair(Offset, Offset + NSize));
+
+      int VarID;
+      I4 Err = IO::readArray(Arrays[IVar]->data(), NAll, VarNames[IVar],
+                             MeshFileID, DecompID, VarID);
+      if (Err != 0)
+         LOG_CRITICAL("HorzMesh: error reading {}", VarNames[IVar]);
+   }
+
+   return Buffer;
+
+} // end readBatch
+
+//------------------------------------------------------------------------------
+// Start a single asynchronous transfer of a batch buffer to the device and
+// set each device array to the portion of the device buffer for its
+// variable. If the device and host memory spaces are the same, no copy is
+// made and the device arrays share the host buffer.
+void HorzMesh::copyBatchToDevice(
+    ExecSpace &CopySpace,                  // [in] execution space for copy
+    const HostArray1DR8 &Buffer,           // [in] host batch buffer
+    const std::vector<Array1DR8 *> &Arrays, // [out] device arrays
+    I4 NSize                                // [in] array size for each var
+) {
+
+   auto DevBuffer = Kokkos::create_mirror_view(MemSpace(), Buffer);
+   deepCopy(CopySpace, DevBuffer, Buffer);
+
+   for (int IVar = 0; IVar < Arrays.size(); ++IVar) {
+      I4 Offset     = IVar * NSize;
+      *Arrays[IVar] = Kokkos::subview(
+          DevBuffer, Kokkos::make_pair(Offset, Offset + NSize));
+   }
+
+} // end copyBatchToDevice
+
+//------------------------------------------------------------------------------
+// Read all mesh variables from the mesh file and transfer those needed by
+// the device. Variables are grouped in batches by decomposition and by
+// whether a device copy is required. Each device batch is transferred with
+// one asynchronous copy as soon as it is read, so that the transfers overlap
+// with the remaining reads, and the host-only variables (coordinates and mesh
+// density) are never copied to the device. The host-only variables are
+// optional and are only read here if requested. If the derived quantities
+// are to be computed, only the bottom depth and the coordinates they are
+// computed from are read.
+void HorzMesh::readMesh(bool ReadCoordinates, // [in] read coordinates
+                        bool ReadMeshDensity, // [in] read mesh density
+                        bool ComputeDerived   // [in] skip derived quantities
+) {
 
    I4 Err;
+   ExecSpace CopySpace = ExecInstances::get(ExecInstances::IO);
 
-   // Read mesh cell coordinates
-   int XCellID;
-   XCellH = HostArray1DR8("XCell", NCellsSize);
-   Err    = IO::readArray(XCellH.data(), NCellsAll, "xCell", MeshFileID,
-                          CellDecompR8, XCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading xCell");
+   if (ComputeDerived) {
+      HostArray1DR8 CellBuffer = readBatch({"bottomDepth"}, {&BottomDepthH},
+                                           CellDecompR8, NCellsAll,
+                                           NCellsSize);
+      copyBatchToDevice(CopySpace, CellBuffer, {&BottomDepth}, NCellsSize);
 
-   int YCellID;
-   YCellH = HostArray1DR8("YCell", NCellsSize);
-   Err    = IO::readArray(YCellH.data(), NCellsAll, "yCell", MeshFileID,
-                          CellDecompR8, YCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading yCell");
+      readCoordinateBatches();
+      if (ReadMeshDensity)
+         readMeshDensityBatch();
 
-   int ZCellID;
-   ZCellH = HostArray1DR8("ZCell", NCellsSize);
-   Err    = IO::readArray(ZCellH.data(), NCellsAll, "zCell", MeshFileID,
-                          CellDecompR8, ZCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading zCell");
+      CopySpace.fence();
+      return;
+   }
 
-   int LonCellID;
-   LonCellH = HostArray1DR8("LonCell", NCellsSize);
-   Err      = IO::readArray(LonCellH.data(), NCellsAll, "lonCell", MeshFileID,
-                            CellDecompR8, LonCellID);
+   // Cell variables needed on the device
+   HostArray1DR8 CellBuffer =
+       readBatch({"areaCell", "bottomDepth", "fCell"},
+                 {&AreaCellH, &BottomDepthH, &FCellH}, CellDecompR8,
+                 NCellsAll, NCellsSize);
+   copyBatchToDevice(CopySpace, CellBuffer, {&AreaCell, &BottomDepth, &FCell},
+                     NCellsSize);
+
+   // Edge variables needed on the device
+   HostArray1DR8 EdgeBuffer =
+       readBatch({"dvEdge", "dcEdge", "angleEdge", "fEdge"},
+                 {&DvEdgeH, &DcEdgeH, &AngleEdgeH, &FEdgeH}, EdgeDecompR8,
+                 NEdgesAll, NEdgesSize);
+   copyBatchToDevice(CopySpace, EdgeBuffer,
+                     {&DvEdge, &DcEdge, &AngleEdge, &FEdge}, NEdgesSize);
+
+   // Vertex variables needed on the device
+   HostArray1DR8 VertexBuffer = readBatch(
+       {"areaTriangle", "fVertex"}, {&AreaTriangleH, &FVertexH},
+       VertexDecompR8, NVerticesAll, NVerticesSize);
+   copyBatchToDevice(CopySpace, VertexBuffer, {&AreaTriangle, &FVertex},
+                     NVerticesSize);
+
+   // Read the kite areas and edge weights, which are the only variables on
+   // their decompositions, and start their transfers
+   int KiteAreasOnVertexID;
+   KiteAreasOnVertexH =
+       HostArray2DR8("KiteAreasOnVertex", NVerticesSize, VertexDegree);
+   Err = IO::readArray(KiteAreasOnVertexH.data(), NVerticesAll * VertexDegree,
+                       "kiteAreasOnVertex", MeshFileID, OnVertexDecompR8,
+                       KiteAreasOnVertexID);
    if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading lonCell");
+      LOG_CRITICAL("HorzMesh: error reading kiteAreasOnVertex");
+   KiteAreasOnVertex =
+       Kokkos::create_mirror_view(MemSpace(), KiteAreasOnVertexH);
+   deepCopy(CopySpace, KiteAreasOnVertex, KiteAreasOnVertexH);
 
-   int LatCellID;
-   LatCellH = HostArray1DR8("LatCell", NCellsSize);
-   Err      = IO::readArray(LatCellH.data(), NCellsAll, "latCell", MeshFileID,
-                            CellDecompR8, LatCellID);
+   int WeightsOnEdgeID;
+   WeightsOnEdgeH = HostArray2DR8("WeightsOnEdge", NEdgesSize, MaxEdges2);
+   Err            = IO::readArray(WeightsOnEdgeH.data(), NEdgesAll * MaxEdges2,
+                                  "weightsOnEdge", MeshFileID, OnEdgeDecompR8,
+                                  WeightsOnEdgeID);
    if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading latCell");
+      LOG_CRITICAL("HorzMesh: error reading weightsOnEdge");
+   WeightsOnEdge = Kokkos::create_mirror_view(MemSpace(), WeightsOnEdgeH);
+   deepCopy(CopySpace, WeightsOnEdge, WeightsOnEdgeH);
 
-   // Read mesh edge coordinateID
-   int XEdgeID;
-   XEdgeH = HostArray1DR8("XEdge", NEdgesSize);
-   Err    = IO::readArray(XEdgeH.data(), NEdgesAll, "xEdge", MeshFileID,
-                          EdgeDecompR8, XEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading xEdge");
+   // Read any requested host-only variables while the device transfers
+   // complete
+   if (ReadCoordinates)
+      readCoordinateBatches();
+   if (ReadMeshDensity)
+      readMeshDensityBatch();
 
-   int YEdgeID;
-   YEdgeH = HostArray1DR8("YEdge", NEdgesSize);
-   Err    = IO::readArray(YEdgeH.data(), NEdgesAll, "yEdge", MeshFileID,
-                          EdgeDecompR8, YEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading yEdge");
+   // Wait for the device transfers before the arrays are used
+   CopySpace.fence();
 
-   int ZEdgeID;
-   ZEdgeH = HostArray1DR8("ZEdge", NEdgesSize);
-   Err    = IO::readArray(ZEdgeH.data(), NEdgesAll, "zEdge", MeshFileID,
-                          EdgeDecompR8, ZEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading zEdge");
+} // end readMesh
 
-   int LonEdgeID;
-   LonEdgeH = HostArray1DR8("LonEdge", NEdgesSize);
-   Err      = IO::readArray(LonEdgeH.data(), NEdgesAll, "lonEdge", MeshFileID,
-                            EdgeDecompR8, LonEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading lonEdge");
+//------------------------------------------------------------------------------
+// Read the optional x/y/z and lon/lat coordinates for cells, edges and
+// vertices. Assumes the mesh file is open and the IO decompositions exist.
+void HorzMesh::readCoordinateBatches() {
 
-   int LatEdgeID;
-   LatEdgeH = HostArray1DR8("LatEdge", NEdgesSize);
-   Err      = IO::readArray(LatEdgeH.data(), NEdgesAll, "latEdge", MeshFileID,
-                            EdgeDecompR8, LatEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading latEdge");
+   readBatch({"xCell", "yCell", "zCell", "lonCell", "latCell"},
+             {&XCellH, &YCellH, &ZCellH, &LonCellH, &LatCellH}, CellDecompR8,
+             NCellsAll, NCellsSize);
+   readBatch({"xEdge", "yEdge", "zEdge", "lonEdge", "latEdge"},
+             {&XEdgeH, &YEdgeH, &ZEdgeH, &LonEdgeH, &LatEdgeH}, EdgeDecompR8,
+             NEdgesAll, NEdgesSize);
+   readBatch({"xVertex", "yVertex", "zVertex", "lonVertex", "latVertex"},
+             {&XVertexH, &YVertexH, &ZVertexH, &LonVertexH, &LatVertexH},
+             VertexDecompR8, NVerticesAll, NVerticesSize);
 
-   // Read mesh vertex coordinates
-   int XVertexID;
-   XVertexH = HostArray1DR8("XVertex", NVerticesSize);
-   Err = IO::readArray(XVertexH.data(), NVerticesAll, "xVertex", MeshFileID,
-                       VertexDecompR8, XVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading xVertex");
+   CoordinatesLoaded = true;
 
-   int YVertexID;
-   YVertexH = HostArray1DR8("YVertex", NVerticesSize);
-   Err = IO::readArray(YVertexH.data(), NVerticesAll, "yVertex", MeshFileID,
-                       VertexDecompR8, YVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading yVertex");
+} // end readCoordinateBatches
 
-   int ZVertexID;
-   ZVertexH = HostArray1DR8("ZVertex", NVerticesSize);
-   Err = IO::readArray(ZVertexH.data(), NVerticesAll, "zVertex", MeshFileID,
-                       VertexDecompR8, ZVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading zVertex");
+//------------------------------------------------------------------------------
+// Read the optional mesh density. Assumes the mesh file is open and the IO
+// decompositions exist.
+void HorzMesh::readMeshDensityBatch() {
 
-   int LonVertexID;
-   LonVertexH = HostArray1DR8("LonVertex", NVerticesSize);
-   Err = IO::readArray(LonVertexH.data(), NVerticesAll, "lonVertex", MeshFileID,
-                       VertexDecompR8, LonVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading lonVertex");
+   readBatch({"meshDensity"}, {&MeshDensityH}, CellDecompR8, NCellsAll,
+             NCellsSize);
 
-   int LatVertexID;
-   LatVertexH = HostArray1DR8("LatVertex", NVerticesSize);
-   Err = IO::readArray(LatVertexH.data(), NVerticesAll, "latVertex", MeshFileID,
-                       VertexDecompR8, LatVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading latVertex");
+   MeshDensityLoaded = true;
 
-} // end readCoordinates
+} // end readMeshDensityBatch
 
 //------------------------------------------------------------------------------
-// Read the cell-centered bottom depth
-void HorzMesh::readBottomDepth() {
+// Read the sphere radius needed to compute the derived mesh quantities.
+// Returns false if the mesh is not on a sphere, in which case the derived
+// quantities are read from the mesh file instead.
+bool HorzMesh::readSphereRadius() {
+
+   // The on_a_sphere attribute is either YES or NO
+   std::string OnSphere;
+   int Err = IO::readMeta("on_a_sphere", OnSphere, MeshFileID, IO::GlobalID);
+   if (Err != 0 or OnSphere.empty() or OnSphere[0] != 'Y') {
+      LOG_WARN("HorzMesh: derived mesh quantities can only be computed for "
+               "spherical meshes - reading them from the mesh file");
+      return false;
+   }
 
-   I4 Err;
+   Err = IO::readMeta("sphere_radius", SphereRadius, MeshFileID, IO::GlobalID);
+   if (Err != 0 or SphereRadius <= 0.0) {
+      LOG_WARN("HorzMesh: invalid sphere_radius - reading derived mesh "
+               "quantities from the mesh file");
+      return false;
+   }
 
-   int BottomDepthID;
-   BottomDepthH = HostArray1DR8("BottomDepth", NCellsSize);
-   Err          = IO::readArray(BottomDepthH.data(), NCellsAll, "bottomDepth",
-                                MeshFileID, CellDecompR8, BottomDepthID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading bottomDepth");
+   return true;
 
-} // end readDepth
+} // end readSphereRadius
 
 //------------------------------------------------------------------------------
-// Read the mesh areas (cell, triangle, and kite),
-// lengths (between centers and vertices), and edge angles
-void HorzMesh::readMeasurements() {
+// Open the mesh file and create the IO decompositions to read optional mesh
+// fields after the mesh has been constructed. Returns an error code.
+int HorzMesh::openOptionalRead() {
+
+   int Err = IO::openFile(MeshFileID, MeshFileName, IO::ModeRead);
+   if (Err != 0) {
+      LOG_ERROR("HorzMesh: error opening mesh file for optional fields");
+      return Err;
+   }
 
-   I4 Err;
+   initParallelIO(ReadDecomp);
 
-   int AreaCellID;
-   AreaCellH = HostArray1DR8("AreaCell", NCellsSize);
-   Err = IO::readArray(AreaCellH.data(), NCellsAll, "areaCell", MeshFileID,
-                       CellDecompR8, AreaCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading areaCell");
+   return Err;
 
-   int AreaTriangleID;
-   AreaTriangleH = HostArray1DR8("AreaTriangle", NVerticesSize);
-   Err = IO::readArray(AreaTriangleH.data(), NVerticesAll, "areaTriangle",
-                       MeshFileID, VertexDecompR8, AreaTriangleID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading areaTriangle");
+} // end openOptionalRead
+
+//------------------------------------------------------------------------------
+// Destroy the IO decompositions and close the mesh file after reading
+// optional mesh fields. Returns an error code.
+int HorzMesh::closeOptionalRead() {
+
+   finalizeParallelIO();
 
-   int DvEdgeID;
-   DvEdgeH = HostArray1DR8("DvEdge", NEdgesSize);
-   Err     = IO::readArray(DvEdgeH.data(), NEdgesAll, "dvEdge", MeshFileID,
-                           EdgeDecompR8, DvEdgeID);
+   int Err = IO::closeFile(MeshFileID);
    if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading dvEdge");
+      LOG_ERROR("HorzMesh: error closing mesh file");
+
+   return Err;
+
+} // end closeOptionalRead
+
+//------------------------------------------------------------------------------
+// Read the cell, edge and vertex coordinates on first request
+int HorzMesh::loadCoordinates() {
+
+   if (CoordinatesLoaded)
+      return 0;
+
+   MemoryScope Scope("HorzMesh");
 
-   int DcEdgeID;
-   DcEdgeH = HostArray1DR8("DcEdge", NEdgesSize);
-   Err     = IO::readArray(DcEdgeH.data(), NEdgesAll, "dcEdge", MeshFileID,
-                           EdgeDecompR8, DcEdgeID);
+   int Err = openOptionalRead();
    if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading dcEdge");
+      return Err;
+
+   readCoordinateBatches();
+
+   return closeOptionalRead();
+
+} // end loadCoordinates
+
+//------------------------------------------------------------------------------
+// Read the mesh density on first request
+int HorzMesh::loadMeshDensity() {
+
+   if (MeshDensityLoaded)
+      return 0;
 
-   int AngleEdgeID;
-   AngleEdgeH = HostArray1DR8("AngleEdge", NEdgesSize);
-   Err = IO::readArray(AngleEdgeH.data(), NEdgesAll, "angleEdge", MeshFileID,
-                       EdgeDecompR8, AngleEdgeID);
+   MemoryScope Scope("HorzMesh");
+
+   int Err = openOptionalRead();
    if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading angleEdge");
+      return Err;
+
+   readMeshDensityBatch();
+
+   return closeOptionalRead();
+
+} // end loadMeshDensity
+
+//------------------------------------------------------------------------------
+// Read maxLevelCell from the mesh file, which counts the active levels of
+// each cell from one with zero for land cells, into the 0-based
+// MaxLevelCellH. Returns an error code.
+int HorzMesh::readMaxLevelCell(I4 NVertLevels // [in] number of levels
+) {
+
+   int Err = IO::openFile(MeshFileID, MeshFileName, IO::ModeRead);
+   if (Err != 0) {
+      LOG_ERROR("HorzMesh: error opening mesh file for maxLevelCell");
+      return Err;
+   }
 
-   int MeshDensityID;
-   MeshDensityH = HostArray1DR8("MeshDensity", NCellsSize);
-   Err          = IO::readArray(MeshDensityH.data(), NCellsAll, "meshDensity",
-                                MeshFileID, CellDecompR8, MeshDensityID);
+   std::vector<I4> CellDims{ReadDecomp->NCellsGlobal};
+   const HostArray1DI4 CellIDH = ReadDecomp->getHost(ReadDecomp->CellIDH);
+   std::vector<I4> CellID(NCellsAll);
+   for (int Cell = 0; Cell < NCellsAll; ++Cell)
+      CellID[Cell] = CellIDH(Cell) - 1;
+
+   I4 CellDecompI4;
+   Err = IO::createDecomp(CellDecompI4, IO::IOTypeI4, 1, CellDims, NCellsAll,
+                          CellID, IO::RearrBox);
+   if (Err != 0) {
+      LOG_ERROR("HorzMesh: error creating maxLevelCell IO decomposition");
+      IO::closeFile(MeshFileID);
+      return Err;
+   }
+
+   int VarID;
+   Err = IO::readArray(MaxLevelCellH.data(), NCellsAll, "maxLevelCell",
+                       MeshFileID, CellDecompI4, VarID);
    if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading meshDensity");
+      LOG_ERROR("HorzMesh: error reading maxLevelCell");
 
-   int KiteAreasOnVertexID;
-   KiteAreasOnVertexH =
-       HostArray2DR8("KiteAreasOnVertex", NVerticesSize, VertexDegree);
-   Err = IO::readArray(KiteAreasOnVertexH.data(), NVerticesAll * VertexDegree,
-                       "kiteAreasOnVertex", MeshFileID, OnVertexDecompR8,
-                       KiteAreasOnVertexID);
+   IO::destroyDecomp(CellDecompI4);
+   int CloseErr = IO::closeFile(MeshFileID);
+   if (CloseErr != 0)
+      LOG_ERROR("HorzMesh: error closing mesh file");
    if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading kiteAreasOnVertex");
+      return Err;
+
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      MaxLevelCellH(Cell) -= 1;
+      if (MaxLevelCellH(Cell) >= NVertLevels) {
+         LOG_ERROR("HorzMesh: maxLevelCell exceeds the {} vertical levels",
+                   NVertLevels);
+         return 1;
+      }
+   }
 
-} // end readMeasurements
+   return CloseErr;
+
+} // end readMaxLevelCell
 
 //------------------------------------------------------------------------------
-// Read the edge weights used in the discrete potential vorticity flux term
-void HorzMesh::readWeights() {
+// Set the active vertical levels of each cell, either from the bottom depth
+// and the reference level depths or from maxLevelCell in the mesh file
+int HorzMesh::initVertLevels(
+    I4 NVertLevels,                       // [in] number of vertical levels
+    const std::vector<R8> &RefBottomDepth // [in] bottom of reference levels
+) {
 
-   I4 Err;
+   MemoryScope Scope("HorzMesh");
 
-   int WeightsOnEdgeID;
-   WeightsOnEdgeH = HostArray2DR8("WeightsOnEdge", NEdgesSize, MaxEdges2);
-   Err            = IO::readArray(WeightsOnEdgeH.data(), NEdgesAll * MaxEdges2,
-                                  "weightsOnEdge", MeshFileID, OnEdgeDecompR8,
-                                  WeightsOnEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading weightsOnEdge");
+   MinLevelCellH = HostArray1DI4("MinLevelCell", NCellsSize);
+   MaxLevelCellH = HostArray1DI4("MaxLevelCell", NCellsSize);
+   deepCopy(MinLevelCellH, AllLevelsActive);
+   deepCopy(MaxLevelCellH, -1);
 
-} // end readWeights
+   if (!RefBottomDepth.empty()) {
+      if (RefBottomDepth.size() != static_cast<size_t>(NVertLevels)) {
+         LOG_ERROR("HorzMesh: {} reference depths given for {} levels",
+                   RefBottomDepth.size(), NVertLevels);
+         return 1;
+      }
+      for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+         const R8 Depth = BottomDepthH(Cell);
+         if (Depth <= 0.0)
+            continue;
+         I4 MaxLevel = NVertLevels - 1;
+         for (int K = 0; K < NVertLevels; ++K) {
+            if (RefBottomDepth[K] >= Depth) {
+               MaxLevel = K;
+               break;
+            }
+         }
+         MaxLevelCellH(Cell) = MaxLevel;
+      }
+   } else {
+      int Err = readMaxLevelCell(NVertLevels);
+      if (Err != 0)
+         return Err;
+   }
+
+   // All columns currently start at the surface
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      if (MaxLevelCellH(Cell) >= 0)
+         MinLevelCellH(Cell) = 0;
+   }
+
+   updateLevelBounds();
+
+   return 0;
+
+} // end initVertLevels
 
 //------------------------------------------------------------------------------
-// Read the Coriolis parameter at the cells, edges, and vertices
-void HorzMesh::readCoriolis() {
+// Derive the edge and vertex level bounds and the lists of ocean
+// elements from the cell level bounds on the host, and copy them to the
+// device. An edge is active at the levels of both (Top) or either (Bot) of
+// its cells, and a vertex at the levels of all (Top) or any (Bot) of its
+// cells.
+void HorzMesh::updateLevelBounds() {
+
+   // The connectivity may have been released by releaseHostArrays
+   const HostArray2DI4 CellsOnEdgeHost   = getHost(CellsOnEdgeH);
+   const HostArray2DI4 CellsOnVertexHost = getHost(CellsOnVertexH);
+
+   MinLevelEdgeTopH = HostArray1DI4("MinLevelEdgeTop", NEdgesSize);
+   MaxLevelEdgeTopH = HostArray1DI4("MaxLevelEdgeTop", NEdgesSize);
+   MinLevelEdgeBotH = HostArray1DI4("MinLevelEdgeBot", NEdgesSize);
+   MaxLevelEdgeBotH = HostArray1DI4("MaxLevelEdgeBot", NEdgesSize);
+   deepCopy(MinLevelEdgeTopH, AllLevelsActive);
+   deepCopy(MaxLevelEdgeTopH, -1);
+   deepCopy(MinLevelEdgeBotH, AllLevelsActive);
+   deepCopy(MaxLevelEdgeBotH, -1);
+
+   for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
+      const I4 Cell0 = CellsOnEdgeHost(Edge, 0);
+      const I4 Cell1 = CellsOnEdgeHost(Edge, 1);
+
+      MinLevelEdgeTopH(Edge) =
+          std::max(MinLevelCellH(Cell0), MinLevelCellH(Cell1));
+      MaxLevelEdgeTopH(Edge) =
+          std::min(MaxLevelCellH(Cell0), MaxLevelCellH(Cell1));
+      MinLevelEdgeBotH(Edge) =
+          std::min(MinLevelCellH(Cell0), MinLevelCellH(Cell1));
+      MaxLevelEdgeBotH(Edge) =
+          std::max(MaxLevelCellH(Cell0), MaxLevelCellH(Cell1));
+   }
 
-   int Err;
+   MinLevelVertexTopH = HostArray1DI4("MinLevelVertexTop", NVerticesSize);
+   MaxLevelVertexTopH = HostArray1DI4("MaxLevelVertexTop", NVerticesSize);
+   MinLevelVertexBotH = HostArray1DI4("MinLevelVertexBot", NVerticesSize);
+   MaxLevelVertexBotH = HostArray1DI4("MaxLevelVertexBot", NVerticesSize);
+   deepCopy(MinLevelVertexTopH, AllLevelsActive);
+   deepCopy(MaxLevelVertexTopH, -1);
+   deepCopy(MinLevelVertexBotH, AllLevelsActive);
+   deepCopy(MaxLevelVertexBotH, -1);
 
-   int FCellID;
-   FCellH = HostArray1DR8("FCell", NCellsSize);
-   Err    = IO::readArray(FCellH.data(), NCellsAll, "fCell", MeshFileID,
-                          CellDecompR8, FCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading fCell");
+   for (int Vertex = 0; Vertex < NVerticesAll; ++Vertex) {
+      I4 MinTop = 0;
+      I4 MaxTop = AllLevelsActive;
+      I4 MinBot = AllLevelsActive;
+      I4 MaxBot = -1;
+      for (int I = 0; I < VertexDegree; ++I) {
+         const I4 Cell = CellsOnVertexHost(Vertex, I);
+         MinTop        = std::max(MinTop, MinLevelCellH(Cell));
+         MaxTop        = std::min(MaxTop, MaxLevelCellH(Cell));
+         MinBot        = std::min(MinBot, MinLevelCellH(Cell));
+         MaxBot        = std::max(MaxBot, MaxLevelCellH(Cell));
+      }
+      MinLevelVertexTopH(Vertex) = MinTop;
+      MaxLevelVertexTopH(Vertex) = MaxTop;
+      MinLevelVertexBotH(Vertex) = MinBot;
+      MaxLevelVertexBotH(Vertex) = MaxBot;
+   }
+
+   // The device arrays are allocated once and updated in place, so that
+   // operators constructed before the levels are initialized see the update
+   auto copyToDevice = [](Array1DI4 &Dev, const HostArray1DI4 &Host) {
+      if (Dev.extent(0) != Host.extent(0))
+         Dev = Array1DI4(Host.label(), Host.extent(0));
+      deepCopy(Dev, Host);
+   };
+   copyToDevice(MinLevelCell, MinLevelCellH);
+   copyToDevice(MaxLevelCell, MaxLevelCellH);
+   copyToDevice(MinLevelEdgeTop, MinLevelEdgeTopH);
+   copyToDevice(MaxLevelEdgeTop, MaxLevelEdgeTopH);
+   copyToDevice(MinLevelEdgeBot, MinLevelEdgeBotH);
+   copyToDevice(MaxLevelEdgeBot, MaxLevelEdgeBotH);
+   copyToDevice(MinLevelVertexTop, MinLevelVertexTopH);
+   copyToDevice(MaxLevelVertexTop, MaxLevelVertexTopH);
+   copyToDevice(MinLevelVertexBot, MinLevelVertexBotH);
+   copyToDevice(MaxLevelVertexBot, MaxLevelVertexBotH);
+
+   // Compact the elements with active levels, keeping their order, into a
+   // device list. Kernels looping over the lists read them from the mesh
+   // when launched, since their length changes with the bounds.
+   auto compact = [](I4 NElems, const HostArray1DI4 &MinLevel,
+                     const HostArray1DI4 &MaxLevel, const std::string &Label,
+                     I4 &NOcean, Array1DI4 &OceanList) {
+      std::vector<I4> List;
+      for (int I = 0; I < NElems; ++I) {
+         if (MaxLevel(I) >= MinLevel(I))
+            List.push_back(I);
+      }
+      NOcean    = List.size();
+      OceanList = Array1DI4(Label, NOcean);
+      deepCopy(OceanList, HostArray1DI4(List.data(), NOcean));
+   };
+   compact(NCellsOwned, MinLevelCellH, MaxLevelCellH, "OceanCellsOwned",
+           NCellsOwnedOcean, OceanCellsOwned);
+   compact(NEdgesOwned, MinLevelEdgeTopH, MaxLevelEdgeTopH, "OceanEdgesOwned",
+           NEdgesOwnedOcean, OceanEdgesOwned);
+   compact(NVerticesOwned, MinLevelVertexBotH, MaxLevelVertexBotH,
+           "OceanVerticesOwned", NVerticesOwnedOcean, OceanVerticesOwned);
+   compact(NCellsAll, MinLevelCellH, MaxLevelCellH, "OceanCellsAll",
+           NCellsAllOcean, OceanCellsAll);
+   compact(NEdgesAll, MinLevelEdgeBotH, MaxLevelEdgeBotH, "OceanEdgesAll",
+           NEdgesAllOcean, OceanEdgesAll);
+   compact(NVerticesAll, MinLevelVertexBotH, MaxLevelVertexBotH,
+           "OceanVerticesAll", NVerticesAllOcean, OceanVerticesAll);
+
+} // end updateLevelBounds
+
+//------------------------------------------------------------------------------
+// Release the host copies of the arrays that have a device copy
+
+void HorzMesh::releaseHostArrays() {
+
+   forEachHostArray(*this, [](auto &HostArr, const auto &DevArr) {
+      releaseHostMirror(HostArr, DevArr);
+   });
+
+} // end releaseHostArrays
+
+//------------------------------------------------------------------------------
+// Returns the configuration of a mesh snapshot. The hashes of the global IDs
+// of the decomposition and of the mesh file name make sure the snapshot is
+// only reused for the same mesh and decomposition.
+std::vector<I4> HorzMesh::snapshotConfig(MPI_Comm Comm, // [in] communicator
+                                         bool ComputeDerived // [in] option
+) const {
+
+   int NumTasks;
+   int MyTask;
+   MPI_Comm_size(Comm, &NumTasks);
+   MPI_Comm_rank(Comm, &MyTask);
+
+   return {NumTasks,
+           MyTask,
+           ComputeDerived,
+           snapshotHash(MeshFileName),
+           snapshotHash(ReadDecomp->getHost(ReadDecomp->CellIDH)),
+           snapshotHash(ReadDecomp->getHost(ReadDecomp->EdgeIDH)),
+           snapshotHash(ReadDecomp->getHost(ReadDecomp->VertexIDH))};
+
+} // end snapshotConfig
+
+//------------------------------------------------------------------------------
+// Restore the mesh variables from the snapshot file of the local task and
+// copy those needed to the device. The optional coordinates and mesh density
+// are restored if they were loaded when the snapshot was written. Returns a
+// non-zero error code on all tasks if the snapshot can not be used.
+int HorzMesh::readSnapshot(MPI_Comm Comm, // [in] communicator of tasks
+                           const std::vector<I4> &Config // [in] config
+) {
 
-   int FVertexID;
-   FVertexH = HostArray1DR8("FVertex", NVerticesSize);
-   Err = IO::readArray(FVertexH.data(), NVerticesAll, "fVertex", MeshFileID,
-                       VertexDecompR8, FVertexID);
+   SnapshotReader Snapshot;
+   I4 Err = Snapshot.open(
+       snapshotFileName(ReadDecomp->SnapshotName, "mesh", Comm), Config, Comm);
    if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading fVertex");
+      return Err;
+
+   std::vector<I4> Flags;
+   Err = Snapshot.getVector("Flags", Flags);
+   if (Err == 0 and Flags.size() == 1)
+      DerivedComputed = Flags[0];
+   else
+      Err = 1;
+
+   Err += Snapshot.getArray("AreaCell", AreaCellH);
+   Err += Snapshot.getArray("BottomDepth", BottomDepthH);
+   Err += Snapshot.getArray("FCell", FCellH);
+   Err += Snapshot.getArray("DvEdge", DvEdgeH);
+   Err += Snapshot.getArray("DcEdge", DcEdgeH);
+   Err += Snapshot.getArray("AngleEdge", AngleEdgeH);
+   Err += Snapshot.getArray("FEdge", FEdgeH);
+   Err += Snapshot.getArray("AreaTriangle", AreaTriangleH);
+   Err += Snapshot.getArray("FVertex", FVertexH);
+   Err += Snapshot.getArray("KiteAreasOnVertex", KiteAreasOnVertexH);
+   Err += Snapshot.getArray("WeightsOnEdge", WeightsOnEdgeH);
+
+   if (Snapshot.has("XCell")) {
+      Err += Snapshot.getArray("XCell", XCellH);
+      Err += Snapshot.getArray("YCell", YCellH);
+      Err += Snapshot.getArray("ZCell", ZCellH);
+      Err += Snapshot.getArray("LonCell", LonCellH);
+      Err += Snapshot.getArray("LatCell", LatCellH);
+      Err += Snapshot.getArray("XEdge", XEdgeH);
+      Err += Snapshot.getArray("YEdge", YEdgeH);
+      Err += Snapshot.getArray("ZEdge", ZEdgeH);
+      Err += Snapshot.getArray("LonEdge", LonEdgeH);
+      Err += Snapshot.getArray("LatEdge", LatEdgeH);
+      Err += Snapshot.getArray("XVertex", XVertexH);
+      Err += Snapshot.getArray("YVertex", YVertexH);
+      Err += Snapshot.getArray("ZVertex", ZVertexH);
+      Err += Snapshot.getArray("LonVertex", LonVertexH);
+      Err += Snapshot.getArray("LatVertex", LatVertexH);
+      CoordinatesLoaded = true;
+   }
+   if (Snapshot.has("MeshDensity")) {
+      Err += Snapshot.getArray("MeshDensity", MeshDensityH);
+      MeshDensityLoaded = true;
+   }
 
-   int FEdgeID;
-   FEdgeH = HostArray1DR8("FEdge", NEdgesSize);
-   Err    = IO::readArray(FEdgeH.data(), NEdgesAll, "fEdge", MeshFileID,
-                          EdgeDecompR8, FEdgeID);
+   // A snapshot that matches the configuration but is incomplete on any
+   // task can not be used
+   I4 LocErr = Err;
+   MPI_Allreduce(&LocErr, &Err, 1, MPI_INT32_T, MPI_MAX, Comm);
+   if (Err != 0) {
+      LOG_WARN("HorzMesh: snapshot is incomplete, reading mesh file");
+      CoordinatesLoaded = false;
+      MeshDensityLoaded = false;
+      DerivedComputed   = false;
+      return Err;
+   }
+
+   AreaCell          = createDeviceMirrorCopy(AreaCellH);
+   BottomDepth       = createDeviceMirrorCopy(BottomDepthH);
+   FCell             = createDeviceMirrorCopy(FCellH);
+   DvEdge            = createDeviceMirrorCopy(DvEdgeH);
+   DcEdge            = createDeviceMirrorCopy(DcEdgeH);
+   AngleEdge         = createDeviceMirrorCopy(AngleEdgeH);
+   FEdge             = createDeviceMirrorCopy(FEdgeH);
+   AreaTriangle      = createDeviceMirrorCopy(AreaTriangleH);
+   FVertex           = createDeviceMirrorCopy(FVertexH);
+   KiteAreasOnVertex = createDeviceMirrorCopy(KiteAreasOnVertexH);
+   WeightsOnEdge     = createDeviceMirrorCopy(WeightsOnEdgeH);
+
+   LOG_INFO("HorzMesh: restored mesh from snapshot {}",
+            ReadDecomp->SnapshotName);
+
+   return Err;
+
+} // end readSnapshot
+
+//------------------------------------------------------------------------------
+// Write the mesh variables to the snapshot file of the local task, including
+// the optional coordinates and mesh density if they have been loaded. Failure
+// to write the snapshot is not fatal, since it only serves as a cache for
+// later runs.
+int HorzMesh::writeSnapshot(MPI_Comm Comm, // [in] communicator of tasks
+                            const std::vector<I4> &Config // [in] config
+) const {
+
+   SnapshotWriter Snapshot(
+       snapshotFileName(ReadDecomp->SnapshotName, "mesh", Comm), Config);
+
+   Snapshot.addVector("Flags", {DerivedComputed});
+
+   Snapshot.addArray("AreaCell", AreaCellH);
+   Snapshot.addArray("BottomDepth", BottomDepthH);
+   Snapshot.addArray("FCell", FCellH);
+   Snapshot.addArray("DvEdge", DvEdgeH);
+   Snapshot.addArray("DcEdge", DcEdgeH);
+   Snapshot.addArray("AngleEdge", AngleEdgeH);
+   Snapshot.addArray("FEdge", FEdgeH);
+   Snapshot.addArray("AreaTriangle", AreaTriangleH);
+   Snapshot.addArray("FVertex", FVertexH);
+   Snapshot.addArray("KiteAreasOnVertex", KiteAreasOnVertexH);
+   Snapshot.addArray("WeightsOnEdge", WeightsOnEdgeH);
+
+   if (CoordinatesLoaded) {
+      Snapshot.addArray("XCell", XCellH);
+      Snapshot.addArray("YCell", YCellH);
+      Snapshot.addArray("ZCell", ZCellH);
+      Snapshot.addArray("LonCell", LonCellH);
+      Snapshot.addArray("LatCell", LatCellH);
+      Snapshot.addArray("XEdge", XEdgeH);
+      Snapshot.addArray("YEdge", YEdgeH);
+      Snapshot.addArray("ZEdge", ZEdgeH);
+      Snapshot.addArray("LonEdge", LonEdgeH);
+      Snapshot.addArray("LatEdge", LatEdgeH);
+      Snapshot.addArray("XVertex", XVertexH);
+      Snapshot.addArray("YVertex", YVertexH);
+      Snapshot.addArray("ZVertex", ZVertexH);
+      Snapshot.addArray("LonVertex", LonVertexH);
+      Snapshot.addArray("LatVertex", LatVertexH);
+   }
+   if (MeshDensityLoaded)
+      Snapshot.addArray("MeshDensity", MeshDensityH);
+
+   I4 Err = Snapshot.write();
    if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading fEdge");
+      LOG_WARN("HorzMesh: unable to write snapshot {}",
+               ReadDecomp->SnapshotName);
+
+   return Err;
 
-} // end readCoriolis
+} // end writeSnapshot
 
 //------------------------------------------------------------------------------
 // Compute the sign of edge contributions to a cell/vertex for each edge
@@ -560,20 +1130,424 @@ void HorzMesh::computeEdgeSign() {
 } // end computeEdgeSign
 
 //------------------------------------------------------------------------------
-// Perform copy to device for mesh variables
-void HorzMesh::copyToDevice() {
+// Compute the mesh metric terms used by the horizontal operators in
+// MetricReal precision. Edge lengths are multiplied by the edge signs, which
+// is exact, and inverse areas and lengths are computed as in the operators,
+// so that without OMEGA_COMPACT_MESH the operator results are unchanged. The
+// divergence, Laplacian and curl weights combine the lengths, signs and
+// areas in R8 before they are rounded, and the divergence weights are also
+// stored in CSR form.
+void HorzMesh::computeOperatorMetrics() {
+
+   OpDvEdgeSignOnCell =
+       Array2DMetric("OpDvEdgeSignOnCell", NCellsSize, MaxEdges);
+   OpInvAreaCell = Array1DMetric("OpInvAreaCell", NCellsSize);
 
-   AreaCell          = createDeviceMirrorCopy(AreaCellH);
-   AreaTriangle      = createDeviceMirrorCopy(AreaTriangleH);
-   KiteAreasOnVertex = createDeviceMirrorCopy(KiteAreasOnVertexH);
-   DcEdge            = createDeviceMirrorCopy(DcEdgeH);
-   DvEdge            = createDeviceMirrorCopy(DvEdgeH);
-   AngleEdge         = createDeviceMirrorCopy(AngleEdgeH);
-   WeightsOnEdge     = createDeviceMirrorCopy(WeightsOnEdgeH);
-   FVertex           = createDeviceMirrorCopy(FVertexH);
-   BottomDepth       = createDeviceMirrorCopy(BottomDepthH);
+   OMEGA_SCOPE(o_NEdgesOnCell, NEdgesOnCell);
+   OMEGA_SCOPE(o_EdgesOnCell, EdgesOnCell);
+   OMEGA_SCOPE(o_DvEdge, DvEdge);
+   OMEGA_SCOPE(o_AreaCell, AreaCell);
+   OMEGA_SCOPE(o_EdgeSignOnCell, EdgeSignOnCell);
+   OMEGA_SCOPE(o_OpDvEdgeSignOnCell, OpDvEdgeSignOnCell);
+   OMEGA_SCOPE(o_OpInvAreaCell, OpInvAreaCell);
+
+   OpDivWeightsOnCell =
+       Array2DMetric("OpDivWeightsOnCell", NCellsSize, MaxEdges);
+   OpLapWeightsOnCell =
+       Array2DMetric("OpLapWeightsOnCell", NCellsSize, MaxEdges);
+   OMEGA_SCOPE(o_DcEdge, DcEdge);
+   OMEGA_SCOPE(o_OpDivWeightsOnCell, OpDivWeightsOnCell);
+   OMEGA_SCOPE(o_OpLapWeightsOnCell, OpLapWeightsOnCell);
+
+   parallelFor(
+       {NCellsAll}, KOKKOS_LAMBDA(int Cell) {
+          o_OpInvAreaCell(Cell) = 1._Real / o_AreaCell(Cell);
+          for (int i = 0; i < o_NEdgesOnCell(Cell); i++) {
+             int Edge = o_EdgesOnCell(Cell, i);
+             o_OpDvEdgeSignOnCell(Cell, i) =
+                 o_DvEdge(Edge) * o_EdgeSignOnCell(Cell, i);
+             const R8 DivWeight = o_DvEdge(Edge) *
+                                  o_EdgeSignOnCell(Cell, i) /
+                                  o_AreaCell(Cell);
+             o_OpDivWeightsOnCell(Cell, i) = DivWeight;
+             o_OpLapWeightsOnCell(Cell, i) = DivWeight / o_DcEdge(Edge);
+          }
+       });
+
+   // CSR form of the cell to edge incidence. The cells beyond NCellsAll
+   // have no edges.
+   HostArray1DI4 OpEdgeOffsetsOnCellH("OpEdgeOffsetsOnCell", NCellsSize + 1);
+   OpEdgeOffsetsOnCellH(0) = 0;
+   for (int Cell = 0; Cell < NCellsSize; ++Cell) {
+      const I4 NEdges = Cell < NCellsAll ? NEdgesOnCellH(Cell) : 0;
+      OpEdgeOffsetsOnCellH(Cell + 1) = OpEdgeOffsetsOnCellH(Cell) + NEdges;
+   }
+   const I4 NIncidence = OpEdgeOffsetsOnCellH(NCellsSize);
+
+   HostArray1DI4 OpEdgesOnCellCSRH("OpEdgesOnCellCSR", NIncidence);
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      for (int i = 0; i < NEdgesOnCellH(Cell); ++i)
+         OpEdgesOnCellCSRH(OpEdgeOffsetsOnCellH(Cell) + i) =
+             EdgesOnCellH(Cell, i);
+   }
+
+   OpEdgeOffsetsOnCell = createDeviceMirrorCopy(OpEdgeOffsetsOnCellH);
+   OpEdgesOnCellCSR    = createDeviceMirrorCopy(OpEdgesOnCellCSRH);
+   OpDivWeightsOnCellCSR =
+       Array1DMetric("OpDivWeightsOnCellCSR", NIncidence);
+
+   OMEGA_SCOPE(o_OpEdgeOffsetsOnCell, OpEdgeOffsetsOnCell);
+   OMEGA_SCOPE(o_OpDivWeightsOnCellCSR, OpDivWeightsOnCellCSR);
+
+   parallelFor(
+       {NCellsAll}, KOKKOS_LAMBDA(int Cell) {
+          const int Offset = o_OpEdgeOffsetsOnCell(Cell);
+          for (int i = 0; i < o_NEdgesOnCell(Cell); i++) {
+             o_OpDivWeightsOnCellCSR(Offset + i) =
+                 o_OpDivWeightsOnCell(Cell, i);
+          }
+       });
+
+   OpDcEdgeSignOnVertex =
+       Array2DMetric("OpDcEdgeSignOnVertex", NVerticesSize, VertexDegree);
+   OpKiteFracOnVertex =
+       Array2DMetric("OpKiteFracOnVertex", NVerticesSize, VertexDegree);
+   OpInvAreaTriangle = Array1DMetric("OpInvAreaTriangle", NVerticesSize);
+   OpCurlWeightsOnVertex =
+       Array2DMetric("OpCurlWeightsOnVertex", NVerticesSize, VertexDegree);
+
+   OMEGA_SCOPE(o_VertexDegree, VertexDegree);
+   OMEGA_SCOPE(o_EdgesOnVertex, EdgesOnVertex);
+   OMEGA_SCOPE(o_AreaTriangle, AreaTriangle);
+   OMEGA_SCOPE(o_KiteAreasOnVertex, KiteAreasOnVertex);
+   OMEGA_SCOPE(o_EdgeSignOnVertex, EdgeSignOnVertex);
+   OMEGA_SCOPE(o_OpDcEdgeSignOnVertex, OpDcEdgeSignOnVertex);
+   OMEGA_SCOPE(o_OpKiteFracOnVertex, OpKiteFracOnVertex);
+   OMEGA_SCOPE(o_OpInvAreaTriangle, OpInvAreaTriangle);
+   OMEGA_SCOPE(o_OpCurlWeightsOnVertex, OpCurlWeightsOnVertex);
+
+   parallelFor(
+       {NVerticesAll}, KOKKOS_LAMBDA(int Vertex) {
+          const Real InvAreaTriangle  = 1._Real / o_AreaTriangle(Vertex);
+          o_OpInvAreaTriangle(Vertex) = InvAreaTriangle;
+          for (int i = 0; i < o_VertexDegree; i++) {
+             int Edge = o_EdgesOnVertex(Vertex, i);
+             o_OpDcEdgeSignOnVertex(Vertex, i) =
+                 o_DcEdge(Edge) * o_EdgeSignOnVertex(Vertex, i);
+             o_OpKiteFracOnVertex(Vertex, i) =
+                 o_KiteAreasOnVertex(Vertex, i) * InvAreaTriangle;
+             o_OpCurlWeightsOnVertex(Vertex, i) =
+                 o_DcEdge(Edge) * o_EdgeSignOnVertex(Vertex, i) /
+                 o_AreaTriangle(Vertex);
+          }
+       });
+
+   OpInvDcEdge     = Array1DMetric("OpInvDcEdge", NEdgesSize);
+   OpWeightsOnEdge = Array2DMetric("OpWeightsOnEdge", NEdgesSize, MaxEdges2);
+
+   OMEGA_SCOPE(o_MaxEdges2, MaxEdges2);
+   OMEGA_SCOPE(o_WeightsOnEdge, WeightsOnEdge);
+   OMEGA_SCOPE(o_OpInvDcEdge, OpInvDcEdge);
+   OMEGA_SCOPE(o_OpWeightsOnEdge, OpWeightsOnEdge);
+
+   parallelFor(
+       {NEdgesAll}, KOKKOS_LAMBDA(int Edge) {
+          o_OpInvDcEdge(Edge) = 1._Real / o_DcEdge(Edge);
+          for (int i = 0; i < o_MaxEdges2; i++) {
+             o_OpWeightsOnEdge(Edge, i) = o_WeightsOnEdge(Edge, i);
+          }
+       });
+
+} // end computeOperatorMetrics
+
+//------------------------------------------------------------------------------
+// Compute the derived mesh quantities on the device from the coordinates and
+// connectivity of a spherical mesh, rather than reading them from the mesh
+// file. Lengths and areas follow from great circle arcs and spherical
+// triangles, the Coriolis parameters from the latitude and the edge angles
+// from the local east and north directions at each edge. The reconstruction
+// weights are the TRiSK weights of Thuburn et al. (2009), with the tangent
+// direction from VerticesOnEdge(Edge,0) to VerticesOnEdge(Edge,1) and the
+// edges of each cell ordered counter-clockwise. Elements in the outermost
+// halo do not have all of their neighbors, so their values are replaced by a
+// halo exchange when the mesh uses the default decomposition.
+void HorzMesh::computeDerivedMesh() {
+
+   // Unit vectors to the cell centers, edge midpoints and vertices. The extra
+   // boundary entry is left as zero.
+   HostArray2DR8 CellUnitH("CellUnit", NCellsSize, 3);
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      R8 Norm = std::sqrt(XCellH(Cell) * XCellH(Cell) +
+                          YCellH(Cell) * YCellH(Cell) +
+                          ZCellH(Cell) * ZCellH(Cell));
+      CellUnitH(Cell, 0) = XCellH(Cell) / Norm;
+      CellUnitH(Cell, 1) = YCellH(Cell) / Norm;
+      CellUnitH(Cell, 2) = ZCellH(Cell) / Norm;
+   }
+   HostArray2DR8 EdgeUnitH("EdgeUnit", NEdgesSize, 3);
+   for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
+      R8 Norm = std::sqrt(XEdgeH(Edge) * XEdgeH(Edge) +
+                          YEdgeH(Edge) * YEdgeH(Edge) +
+                          ZEdgeH(Edge) * ZEdgeH(Edge));
+      EdgeUnitH(Edge, 0) = XEdgeH(Edge) / Norm;
+      EdgeUnitH(Edge, 1) = YEdgeH(Edge) / Norm;
+      EdgeUnitH(Edge, 2) = ZEdgeH(Edge) / Norm;
+   }
+   HostArray2DR8 VertexUnitH("VertexUnit", NVerticesSize, 3);
+   for (int Vertex = 0; Vertex < NVerticesAll; ++Vertex) {
+      R8 Norm = std::sqrt(XVertexH(Vertex) * XVertexH(Vertex) +
+                          YVertexH(Vertex) * YVertexH(Vertex) +
+                          ZVertexH(Vertex) * ZVertexH(Vertex));
+      VertexUnitH(Vertex, 0) = XVertexH(Vertex) / Norm;
+      VertexUnitH(Vertex, 1) = YVertexH(Vertex) / Norm;
+      VertexUnitH(Vertex, 2) = ZVertexH(Vertex) / Norm;
+   }
+   Array2DR8 CellUnit   = createDeviceMirrorCopy(CellUnitH);
+   Array2DR8 EdgeUnit   = createDeviceMirrorCopy(EdgeUnitH);
+   Array2DR8 VertexUnit = createDeviceMirrorCopy(VertexUnitH);
+
+   AreaCell          = Array1DR8("AreaCell", NCellsSize);
+   FCell             = Array1DR8("FCell", NCellsSize);
+   AreaTriangle      = Array1DR8("AreaTriangle", NVerticesSize);
+   KiteAreasOnVertex =
+       Array2DR8("KiteAreasOnVertex", NVerticesSize, VertexDegree);
+   FVertex       = Array1DR8("FVertex", NVerticesSize);
+   DcEdge        = Array1DR8("DcEdge", NEdgesSize);
+   DvEdge        = Array1DR8("DvEdge", NEdgesSize);
+   AngleEdge     = Array1DR8("AngleEdge", NEdgesSize);
+   FEdge         = Array1DR8("FEdge", NEdgesSize);
+   WeightsOnEdge = Array2DR8("WeightsOnEdge", NEdgesSize, MaxEdges2);
+
+   const R8 Radius2 = SphereRadius * SphereRadius;
+
+   OMEGA_SCOPE(o_NCellsAll, NCellsAll);
+   OMEGA_SCOPE(o_NEdgesAll, NEdgesAll);
+   OMEGA_SCOPE(o_NVerticesAll, NVerticesAll);
+   OMEGA_SCOPE(o_VertexDegree, VertexDegree);
+   OMEGA_SCOPE(o_SphereRadius, SphereRadius);
+   OMEGA_SCOPE(o_NEdgesOnCell, NEdgesOnCell);
+   OMEGA_SCOPE(o_EdgesOnCell, EdgesOnCell);
+   OMEGA_SCOPE(o_VerticesOnCell, VerticesOnCell);
+   OMEGA_SCOPE(o_CellsOnEdge, CellsOnEdge);
+   OMEGA_SCOPE(o_NEdgesOnEdge, NEdgesOnEdge);
+   OMEGA_SCOPE(o_EdgesOnEdge, EdgesOnEdge);
+   OMEGA_SCOPE(o_VerticesOnEdge, VerticesOnEdge);
+   OMEGA_SCOPE(o_CellsOnVertex, CellsOnVertex);
+   OMEGA_SCOPE(o_EdgesOnVertex, EdgesOnVertex);
+   OMEGA_SCOPE(o_AreaCell, AreaCell);
+   OMEGA_SCOPE(o_FCell, FCell);
+   OMEGA_SCOPE(o_AreaTriangle, AreaTriangle);
+   OMEGA_SCOPE(o_KiteAreasOnVertex, KiteAreasOnVertex);
+   OMEGA_SCOPE(o_FVertex, FVertex);
+   OMEGA_SCOPE(o_DcEdge, DcEdge);
+   OMEGA_SCOPE(o_DvEdge, DvEdge);
+   OMEGA_SCOPE(o_AngleEdge, AngleEdge);
+   OMEGA_SCOPE(o_FEdge, FEdge);
+   OMEGA_SCOPE(o_WeightsOnEdge, WeightsOnEdge);
+
+   // Cell areas are the sum of the triangles formed by the cell center and
+   // each pair of adjacent vertices
+   parallelFor(
+       {NCellsAll}, KOKKOS_LAMBDA(int Cell) {
+          const R8 C[3] = {CellUnit(Cell, 0), CellUnit(Cell, 1),
+                           CellUnit(Cell, 2)};
+          o_FCell(Cell) = 2.0 * RotationRate * C[2];
+
+          const int NEdges = o_NEdgesOnCell(Cell);
+          R8 Area          = 0.0;
+          for (int i = 0; i < NEdges; ++i) {
+             int Vertex0 = o_VerticesOnCell(Cell, i);
+             int Vertex1 = o_VerticesOnCell(Cell, (i + 1) % NEdges);
+             if (Vertex0 >= o_NVerticesAll or Vertex1 >= o_NVerticesAll) {
+                Area = 0.0;
+                break;
+             }
+             const R8 V0[3] = {VertexUnit(Vertex0, 0), VertexUnit(Vertex0, 1),
+                               VertexUnit(Vertex0, 2)};
+             const R8 V1[3] = {VertexUnit(Vertex1, 0), VertexUnit(Vertex1, 1),
+                               VertexUnit(Vertex1, 2)};
+             Area += triangleArea(C, V0, V1);
+          }
+          o_AreaCell(Cell) = Radius2 * Area;
+       });
+
+   // Kite areas are the two triangles formed by the vertex, the cell center
+   // and the midpoints of the two edges on the vertex that border the cell.
+   // The dual cell area is the sum of its kites.
+   parallelFor(
+       {NVerticesAll}, KOKKOS_LAMBDA(int Vertex) {
+          const R8 V[3] = {VertexUnit(Vertex, 0), VertexUnit(Vertex, 1),
+                           VertexUnit(Vertex, 2)};
+          o_FVertex(Vertex) = 2.0 * RotationRate * V[2];
+
+          R8 AreaDual = 0.0;
+          for (int i = 0; i < o_VertexDegree; ++i) {
+             int Cell = o_CellsOnVertex(Vertex, i);
+             R8 Kite  = 0.0;
+             if (Cell < o_NCellsAll) {
+                const R8 C[3] = {CellUnit(Cell, 0), CellUnit(Cell, 1),
+                                 CellUnit(Cell, 2)};
+                for (int j = 0; j < o_VertexDegree; ++j) {
+                   int Edge = o_EdgesOnVertex(Vertex, j);
+                   if (Edge < o_NEdgesAll and
+                       (o_CellsOnEdge(Edge, 0) == Cell or
+                        o_CellsOnEdge(Edge, 1) == Cell)) {
+                      const R8 E[3] = {EdgeUnit(Edge, 0), EdgeUnit(Edge, 1),
+                                       EdgeUnit(Edge, 2)};
+                      Kite += triangleArea(V, E, C);
+                   }
+                }
+             }
+             o_KiteAreasOnVertex(Vertex, i) = Radius2 * Kite;
+             AreaDual += Radius2 * Kite;
+          }
+          o_AreaTriangle(Vertex) = AreaDual;
+       });
+
+   // Edge lengths are the great circle arcs between the cells and vertices on
+   // the edge. The edge angle is measured from the local east direction to
+   // the normal, which points from CellsOnEdge(Edge,0) to CellsOnEdge(Edge,1).
+   parallelFor(
+       {NEdgesAll}, KOKKOS_LAMBDA(int Edge) {
+          const R8 E[3] = {EdgeUnit(Edge, 0), EdgeUnit(Edge, 1),
+                           EdgeUnit(Edge, 2)};
+          o_FEdge(Edge) = 2.0 * RotationRate * E[2];
+
+          int Cell0 = o_CellsOnEdge(Edge, 0);
+          int Cell1 = o_CellsOnEdge(Edge, 1);
+          if (Cell0 < o_NCellsAll and Cell1 < o_NCellsAll) {
+             const R8 C0[3] = {CellUnit(Cell0, 0), CellUnit(Cell0, 1),
+                               CellUnit(Cell0, 2)};
+             const R8 C1[3] = {CellUnit(Cell1, 0), CellUnit(Cell1, 1),
+                               CellUnit(Cell1, 2)};
+             o_DcEdge(Edge) = o_SphereRadius * arcAngle(C0, C1);
+
+             R8 Horz     = Kokkos::sqrt(E[0] * E[0] + E[1] * E[1]);
+             R8 East[3]  = {-E[1] / Horz, E[0] / Horz, 0.0};
+             R8 North[3] = {-E[2] * E[0] / Horz, -E[2] * E[1] / Horz, Horz};
+             R8 Normal[3] = {C1[0] - C0[0], C1[1] - C0[1], C1[2] - C0[2]};
+             o_AngleEdge(Edge) = Kokkos::atan2(
+                 Normal[0] * North[0] + Normal[1] * North[1] +
+                     Normal[2] * North[2],
+                 Normal[0] * East[0] + Normal[1] * East[1] +
+                     Normal[2] * East[2]);
+          }
+
+          int Vertex0 = o_VerticesOnEdge(Edge, 0);
+          int Vertex1 = o_VerticesOnEdge(Edge, 1);
+          if (Vertex0 < o_NVerticesAll and Vertex1 < o_NVerticesAll) {
+             const R8 V0[3] = {VertexUnit(Vertex0, 0), VertexUnit(Vertex0, 1),
+                               VertexUnit(Vertex0, 2)};
+             const R8 V1[3] = {VertexUnit(Vertex1, 0), VertexUnit(Vertex1, 1),
+                               VertexUnit(Vertex1, 2)};
+             o_DvEdge(Edge) = o_SphereRadius * arcAngle(V0, V1);
+          }
+       });
+
+   // Reconstruction weights. For each cell on the edge, the edges of the
+   // cell are visited counter-clockwise starting from the edge, accumulating
+   // the fraction of the cell area in the kites of the vertices passed. The
+   // sign accounts for the orientation of the normal of each edge relative
+   // to the cell and of the tangent of the edge relative to the first vertex
+   // passed. Each weight is stored in the EdgesOnEdge entry of its edge.
+   parallelFor(
+       {NEdgesAll}, KOKKOS_LAMBDA(int Edge) {
+          // Returns the vertex shared by two edges
+          auto sharedVertex = [&](int EdgeA, int EdgeB) {
+             int VertexA = o_VerticesOnEdge(EdgeA, 0);
+             return (VertexA == o_VerticesOnEdge(EdgeB, 0) or
+                     VertexA == o_VerticesOnEdge(EdgeB, 1))
+                        ? VertexA
+                        : o_VerticesOnEdge(EdgeA, 1);
+          };
+
+          if (o_CellsOnEdge(Edge, 0) >= o_NCellsAll or
+              o_CellsOnEdge(Edge, 1) >= o_NCellsAll)
+             return;
+
+          for (int j = 0; j < 2; ++j) {
+             int Cell = o_CellsOnEdge(Edge, j);
+             if (o_AreaCell(Cell) <= 0.0)
+                continue;
+
+             const int NEdges = o_NEdgesOnCell(Cell);
+             int Inx          = 0;
+             bool Complete    = true;
+             for (int i = 0; i < NEdges; ++i) {
+                int CellEdge = o_EdgesOnCell(Cell, i);
+                if (CellEdge >= o_NEdgesAll)
+                   Complete = false;
+                if (CellEdge == Edge)
+                   Inx = i;
+             }
+             if (not Complete)
+                continue;
+
+             int StartVertex =
+                 sharedVertex(Edge, o_EdgesOnCell(Cell, (Inx + 1) % NEdges));
+             R8 TangentSign =
+                 o_VerticesOnEdge(Edge, 1) == StartVertex ? 1.0 : -1.0;
+
+             R8 KiteFrac  = 0.0;
+             int PrevEdge = Edge;
+             for (int k = 1; k < NEdges; ++k) {
+                int NextEdge = o_EdgesOnCell(Cell, (Inx + k) % NEdges);
+                int Vertex   = sharedVertex(PrevEdge, NextEdge);
+                if (Vertex >= o_NVerticesAll)
+                   break;
+                for (int i = 0; i < o_VertexDegree; ++i) {
+                   if (o_CellsOnVertex(Vertex, i) == Cell)
+                      KiteFrac +=
+                          o_KiteAreasOnVertex(Vertex, i) / o_AreaCell(Cell);
+                }
+
+                R8 NormalSign =
+                    o_CellsOnEdge(NextEdge, 0) == Cell ? 1.0 : -1.0;
+                R8 Weight = (0.5 - KiteFrac) * NormalSign * TangentSign *
+                            o_DvEdge(NextEdge) / o_DcEdge(Edge);
+                for (int i = 0; i < o_NEdgesOnEdge(Edge); ++i) {
+                   if (o_EdgesOnEdge(Edge, i) == NextEdge)
+                      o_WeightsOnEdge(Edge, i) = Weight;
+                }
+                PrevEdge = NextEdge;
+             }
+          }
+       });
+
+   // Replace the incomplete values in the outermost halo with those from
+   // the owning tasks
+   Halo *DefHalo = Halo::getDefault();
+   if (ReadDecomp == Decomp::getDefault() and DefHalo != nullptr) {
+      int Err = 0;
+      Err += DefHalo->exchangeFullArrayHalo(AreaCell, OnCell);
+      Err += DefHalo->exchangeFullArrayHalo(AreaTriangle, OnVertex);
+      Err += DefHalo->exchangeFullArrayHalo(KiteAreasOnVertex, OnVertex);
+      Err += DefHalo->exchangeFullArrayHalo(DcEdge, OnEdge);
+      Err += DefHalo->exchangeFullArrayHalo(DvEdge, OnEdge);
+      Err += DefHalo->exchangeFullArrayHalo(AngleEdge, OnEdge);
+      Err += DefHalo->exchangeFullArrayHalo(WeightsOnEdge, OnEdge);
+      if (Err != 0)
+         LOG_ERROR("HorzMesh: error exchanging halos of derived quantities");
+   } else {
+      LOG_WARN("HorzMesh: no halo for mesh decomposition - derived mesh "
+               "quantities in the outermost halo may be incomplete");
+   }
 
-} // end copyToDevice
+   // Copy the derived quantities to the host
+   AreaCellH          = createHostMirrorCopy(AreaCell);
+   FCellH             = createHostMirrorCopy(FCell);
+   AreaTriangleH      = createHostMirrorCopy(AreaTriangle);
+   KiteAreasOnVertexH = createHostMirrorCopy(KiteAreasOnVertex);
+   FVertexH           = createHostMirrorCopy(FVertex);
+   DcEdgeH            = createHostMirrorCopy(DcEdge);
+   DvEdgeH            = createHostMirrorCopy(DvEdge);
+   AngleEdgeH         = createHostMirrorCopy(AngleEdge);
+   FEdgeH             = createHostMirrorCopy(FEdge);
+   WeightsOnEdgeH     = createHostMirrorCopy(WeightsOnEdge);
+
+   DerivedComputed = true;
+
+} // end computeDerivedMesh
 
 //------------------------------------------------------------------------------
 // Get default mesh
@@ -15,10 +15,26 @@
 #include "MachEnv.h"
 #include "OmegaKokkos.h"
 
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace OMEGA {
 
+/// Floating point type of the mesh metric terms used by the horizontal
+/// operators. These are stored in single precision if Omega is built with
+/// OMEGA_COMPACT_MESH, which reduces the memory traffic of the operators.
+#ifdef OMEGA_COMPACT_MESH
+using MetricReal    = R4;
+using Array1DMetric = Array1DR4;
+using Array2DMetric = Array2DR4;
+#else
+using MetricReal    = R8;
+using Array1DMetric = Array1DR8;
+using Array2DMetric = Array2DR8;
+#endif
+
 /// A class for the horizontal mesh information
 
 /// The HorzMesh class reads in the remaining mesh information that is
@@ -32,19 +48,64 @@ class HorzMesh {
 
    void finalizeParallelIO();
 
-   void readCoordinates();
-
-   void readBottomDepth();
-
-   void readMeasurements();
-
-   void readWeights();
-
-   void readCoriolis();
-
-   // void computeEdgeSign();
-
-   void copyToDevice();
+   void readMesh(bool ReadCoordinates, bool ReadMeshDensity,
+                 bool ComputeDerived);
+
+   bool readSphereRadius();
+
+   std::vector<I4> snapshotConfig(MPI_Comm Comm, bool ComputeDerived) const;
+
+   int readSnapshot(MPI_Comm Comm, const std::vector<I4> &Config);
+
+   int writeSnapshot(MPI_Comm Comm, const std::vector<I4> &Config) const;
+
+   void readCoordinateBatches();
+
+   void readMeshDensityBatch();
+
+   int openOptionalRead();
+
+   int closeOptionalRead();
+
+   HostArray1DR8 readBatch(const std::vector<std::string> &VarNames,
+                           const std::vector<HostArray1DR8 *> &Arrays,
+                           I4 DecompID, I4 NAll, I4 NSize);
+
+   void copyBatchToDevice(ExecSpace &CopySpace, const HostArray1DR8 &Buffer,
+                          const std::vector<Array1DR8 *> &Arrays, I4 NSize);
+
+   int readMaxLevelCell(I4 NVertLevels);
+
+   /// Calls Fn(HostArray, DeviceArray) for each pair of host and device
+   /// arrays that can be released by releaseHostArrays. The coordinates,
+   /// mesh density and level bounds are only kept on the host and are not
+   /// included.
+   template <typename MeshT, typename F>
+   static void forEachHostArray(MeshT &M, F &&Fn) {
+      Fn(M.CellsOnCellH, M.CellsOnCell);
+      Fn(M.EdgesOnCellH, M.EdgesOnCell);
+      Fn(M.NEdgesOnCellH, M.NEdgesOnCell);
+      Fn(M.VerticesOnCellH, M.VerticesOnCell);
+      Fn(M.CellsOnEdgeH, M.CellsOnEdge);
+      Fn(M.EdgesOnEdgeH, M.EdgesOnEdge);
+      Fn(M.NEdgesOnEdgeH, M.NEdgesOnEdge);
+      Fn(M.VerticesOnEdgeH, M.VerticesOnEdge);
+      Fn(M.CellsOnVertexH, M.CellsOnVertex);
+      Fn(M.EdgesOnVertexH, M.EdgesOnVertex);
+      Fn(M.AreaCellH, M.AreaCell);
+      Fn(M.AreaTriangleH, M.AreaTriangle);
+      Fn(M.KiteAreasOnVertexH, M.KiteAreasOnVertex);
+      Fn(M.DvEdgeH, M.DvEdge);
+      Fn(M.DcEdgeH, M.DcEdge);
+      Fn(M.AngleEdgeH, M.AngleEdge);
+      Fn(M.WeightsOnEdgeH, M.WeightsOnEdge);
+      Fn(M.FEdgeH, M.FEdge);
+      Fn(M.FCellH, M.FCell);
+      Fn(M.FVertexH, M.FVertex);
+      Fn(M.BottomDepthH, M.BottomDepth);
+      Fn(M.EdgeSignOnCellH, M.EdgeSignOnCell);
+      Fn(M.EdgeSignOnVertexH, M.EdgeSignOnVertex);
+   }
 
    // int computeMesh();
    I4 CellDecompR8;
@@ -53,6 +114,9 @@ class HorzMesh {
    I4 OnEdgeDecompR8;
    I4 OnVertexDecompR8;
 
+   /// Decomposition used to read optional fields on first request
+   Decomp *ReadDecomp;
+
    static HorzMesh *DefaultHorzMesh;
 
    static std::map<std::string, HorzMesh> AllHorzMeshes;
@@ -61,6 +125,8 @@ class HorzMesh {
    // KOKKOS_LAMBDA does not allow to have parallel_* functions inside of a
    // private function.
    void computeEdgeSign();
+   void computeOperatorMetrics();
+   void computeDerivedMesh();
    // Variables
    // Since these are used frequently, we make them public to reduce the
    // number of retrievals required.
@@ -68,6 +134,9 @@ class HorzMesh {
    std::string MeshFileName;
    int MeshFileID;
 
+   R8 SphereRadius = 0.0; ///< Radius of the sphere (m), set when the derived
+                          ///  mesh quantities are computed
+
    // Sizes and global IDs
    // Note that all sizes are actual counts (1-based) so that loop extents
    // should always use the 0:NCellsXX-1 form.
@@ -88,6 +157,22 @@ class HorzMesh {
    I4 NVerticesSize;  ///< Array length (incl padding, bndy) for vrtx dim
    I4 VertexDegree;   ///< Number of cells that meet at each vertex
 
+   // Halo layers of the decomposition. NCellsHaloH(L) is the number of owned
+   // cells plus the cells of halo layers 0 to L, and NEdgesHaloH(L) the
+   // number of edges of the owned cells and the cells of halo layers 0 to
+   // L-1.
+
+   I4 HaloWidth;              ///< Number of halo layers for cells
+   HostArray1DI4 NCellsHaloH; ///< num cells owned+halo for halo layer
+   HostArray1DI4 NEdgesHaloH; ///< num edges owned+halo for halo layer
+
+   // Loop bounds for which the horizontal operators are specialized at
+   // compile time, selected from MaxEdges and VertexDegree when the mesh is
+   // constructed. A value of zero selects the generic runtime-bounded loops.
+   I4 OpMaxEdges;     ///< MaxEdges specialization of operators, 0 if none
+   I4 OpVertexDegree; ///< VertexDegree specialization of operators, 0 if none
+   bool OpCellCSR;    ///< Use CSR cell to edge incidence in operators
+
    // Mesh connectivity
 
    Array2DI4 CellsOnCell;      ///< Indx of cells that neighbor each cell
@@ -173,6 +258,16 @@ class HorzMesh {
    HostArray1DR8 MeshDensityH; ///< Value of density function used to generate a
                                ///  particular mesh at cell centers
 
+   // Optional fields. The coordinates and mesh density are only read when
+   // the mesh is created if requested, otherwise they are read on the first
+   // call to loadCoordinates or loadMeshDensity and remain unallocated if
+   // never requested.
+
+   bool CoordinatesLoaded = false; ///< True once coordinates have been read
+   bool MeshDensityLoaded = false; ///< True once MeshDensityH has been read
+
+   bool DerivedComputed = false; ///< True if derived quantities were computed
+
    // Weights
 
    Array2DR8 WeightsOnEdge; ///< Reconstruction weights associated with each of
@@ -196,6 +291,66 @@ class HorzMesh {
    Array1DR8 BottomDepth;      ///< Depth of the bottom of the ocean (m)
    HostArray1DR8 BottomDepthH; ///< Depth of the bottom of the ocean (m)
 
+   // Vertical level bounds. Levels are 0-based and the active levels of an
+   // element are MinLevel to MaxLevel, so an element with MaxLevel < MinLevel
+   // (eg. a land cell) has no active levels. At an edge, the Top bounds give
+   // the levels where both cells are active and the Bot bounds the levels
+   // where either cell is active, and similarly at a vertex for all or any of
+   // its cells. Until initVertLevels is called all levels of every cell are
+   // active, with MaxLevelCell set to AllLevelsActive. Neighbor entries beyond
+   // the local elements have no active levels.
+
+   /// Upper bound of MaxLevelCell for which all levels are active
+   static constexpr I4 AllLevelsActive = std::numeric_limits<I4>::max() / 2;
+
+   Array1DI4 MinLevelCell;      ///< Top active level of each cell
+   HostArray1DI4 MinLevelCellH; ///< Top active level of each cell
+   Array1DI4 MaxLevelCell;      ///< Bottom active level of each cell
+   HostArray1DI4 MaxLevelCellH; ///< Bottom active level of each cell
+
+   Array1DI4 MinLevelEdgeTop;      ///< Top level active at both edge cells
+   HostArray1DI4 MinLevelEdgeTopH; ///< Top level active at both edge cells
+   Array1DI4 MaxLevelEdgeTop;      ///< Bottom level active at both edge cells
+   HostArray1DI4 MaxLevelEdgeTopH; ///< Bottom level active at both edge cells
+   Array1DI4 MinLevelEdgeBot;      ///< Top level active at either edge cell
+   HostArray1DI4 MinLevelEdgeBotH; ///< Top level active at either edge cell
+   Array1DI4 MaxLevelEdgeBot;      ///< Bottom level active at either edge cell
+   HostArray1DI4 MaxLevelEdgeBotH; ///< Bottom level active at either edge cell
+
+   Array1DI4 MinLevelVertexTop;      ///< Top level active at all vertex cells
+   HostArray1DI4 MinLevelVertexTopH; ///< Top level active at all vertex cells
+   Array1DI4 MaxLevelVertexTop;      ///< Bottom level active at all vrtx cells
+   HostArray1DI4 MaxLevelVertexTopH; ///< Bottom level active at all vrtx cells
+   Array1DI4 MinLevelVertexBot;      ///< Top level active at any vertex cell
+   HostArray1DI4 MinLevelVertexBotH; ///< Top level active at any vertex cell
+   Array1DI4 MaxLevelVertexBot;      ///< Bottom level active at any vertex cell
+   HostArray1DI4 MaxLevelVertexBotH; ///< Bottom level active at any vertex cell
+
+   // Owned elements with at least one active level, for loops that skip land
+   // columns: cells with an active level, edges with a level active at both
+   // cells (Top bounds) and vertices with a level active at any cell (Bot
+   // bounds)
+
+   I4 NCellsOwnedOcean;          ///< Number of owned cells with active levels
+   I4 NEdgesOwnedOcean;          ///< Number of owned edges with active levels
+   I4 NVerticesOwnedOcean;       ///< Number of owned vertices with active lvls
+   Array1DI4 OceanCellsOwned;    ///< Indices of owned cells with active levels
+   Array1DI4 OceanEdgesOwned;    ///< Indices of owned edges with active levels
+   Array1DI4 OceanVerticesOwned; ///< Indices of owned vertices with active lvls
+
+   // Owned and halo elements with at least one active level, for loops that
+   // also fill the halo: cells with an active level, and edges and vertices
+   // with a level active at any of their cells (Bot bounds). The lists are
+   // rebuilt, and may change length, whenever updateLevelBounds is called, so
+   // kernels must read them from the mesh when launched.
+
+   I4 NCellsAllOcean;          ///< Number of local cells with active levels
+   I4 NEdgesAllOcean;          ///< Number of local edges with active levels
+   I4 NVerticesAllOcean;       ///< Number of local vertices with active lvls
+   Array1DI4 OceanCellsAll;    ///< Indices of local cells with active levels
+   Array1DI4 OceanEdgesAll;    ///< Indices of local edges with active levels
+   Array1DI4 OceanVerticesAll; ///< Indices of local vertices with active lvls
+
    // Edge sign
 
    Array2DR8 EdgeSignOnCell;      ///< Sign of vector connecting cells
@@ -204,16 +359,108 @@ class HorzMesh {
    Array2DR8 EdgeSignOnVertex;      ///< Sign of vector connecting vertices
    HostArray2DR8 EdgeSignOnVertexH; ///< Sign of vector connecting vertices
 
+   // Metric terms used by the horizontal operators, stored in MetricReal
+   // precision. The edge signs are folded into the edge lengths and the
+   // areas are stored as inverses, so that operators stream fewer arrays.
+
+   Array2DMetric OpDvEdgeSignOnCell;   ///< DvEdge times EdgeSignOnCell
+   Array2DMetric OpDcEdgeSignOnVertex; ///< DcEdge times EdgeSignOnVertex
+   Array1DMetric OpInvAreaCell;        ///< Inverse of AreaCell
+   Array1DMetric OpInvAreaTriangle;    ///< Inverse of AreaTriangle
+   Array1DMetric OpInvDcEdge;          ///< Inverse of DcEdge
+   Array2DMetric OpKiteFracOnVertex;   ///< KiteAreasOnVertex / AreaTriangle
+   Array2DMetric OpWeightsOnEdge;      ///< Copy of WeightsOnEdge
+
+   // Combined coefficients of the curl and of the scalar Laplacian, so that
+   // each term of these operators is a single multiply-add
+
+   Array2DMetric OpCurlWeightsOnVertex; ///< DcEdgeSignOnVertex/AreaTriangle
+   Array2DMetric OpLapWeightsOnCell;    ///< OpDivWeightsOnCell/DcEdge
+
+   // Cell to edge incidence of the divergence with precomputed weights
+   // DvEdge * EdgeSignOnCell / AreaCell. The padded form has MaxEdges entries
+   // per cell with zero weights beyond NEdgesOnCell. The CSR form stores only
+   // the edges of each cell, from OpEdgeOffsetsOnCell(Cell) to
+   // OpEdgeOffsetsOnCell(Cell+1), and is used by the operators if OpCellCSR.
+
+   Array2DMetric OpDivWeightsOnCell;    ///< DvEdge*EdgeSignOnCell/AreaCell
+   Array1DI4 OpEdgeOffsetsOnCell;       ///< Offset of each cell in CSR form
+   Array1DI4 OpEdgesOnCellCSR;          ///< EdgesOnCell in CSR form
+   Array1DMetric OpDivWeightsOnCellCSR; ///< OpDivWeightsOnCell in CSR form
+
    // Methods
 
    /// Initialize Omega local mesh
    static int init();
 
-   /// Construct a new local mesh for a given decomposition
-   HorzMesh(const std::string &Name, ///< [in] Name for mesh
-            Decomp *Decomp           ///< [in] Decomposition for mesh
+   /// Construct a new local mesh for a given decomposition. The optional
+   /// coordinates and mesh density are only read if requested. The
+   /// decomposition must remain defined if these are read later. If
+   /// ComputeDerived is true, the metric terms, Coriolis parameters and
+   /// reconstruction weights are computed on the device from the
+   /// coordinates and connectivity rather than read from the mesh file.
+   /// If the default decomposition has a snapshot prefix, the mesh
+   /// variables are restored from the snapshot files of an earlier run if
+   /// they exist and match, otherwise they are read and the snapshot files
+   /// are written.
+   HorzMesh(const std::string &Name,     ///< [in] Name for mesh
+            Decomp *Decomp,              ///< [in] Decomposition for mesh
+            bool ReadCoordinates = true, ///< [in] read coordinates now
+            bool ReadMeshDensity = true, ///< [in] read mesh density now
+            bool ComputeDerived  = false ///< [in] compute derived quantities
    );
 
+   /// Read the cell, edge and vertex coordinates if they have not already
+   /// been read. Returns an error code.
+   int loadCoordinates();
+
+   /// Read the mesh density if it has not already been read. Returns an
+   /// error code.
+   int loadMeshDensity();
+
+   /// Set the active vertical levels of each cell for NVertLevels levels and
+   /// derive the edge and vertex bounds and the lists of ocean elements. If
+   /// RefBottomDepth, the depth of the bottom of each reference level, is
+   /// given, the bottom level of a cell is the first level whose bottom is at
+   /// or below BottomDepth, and cells with no positive depth are land.
+   /// Otherwise maxLevelCell is read from the mesh file. Returns an error
+   /// code.
+   int initVertLevels(I4 NVertLevels, ///< [in] number of vertical levels
+                      const std::vector<R8> &RefBottomDepth = {} ///< [in]
+   );
+
+   /// Derive the edge and vertex bounds and rebuild the lists of ocean
+   /// elements from the cell bounds MinLevelCellH and MaxLevelCellH, and
+   /// update the device arrays. Called by initVertLevels, and after the cell
+   /// bounds are modified on the host when cells become active or inactive,
+   /// eg. by wetting and drying.
+   void updateLevelBounds();
+
+   /// Releases the host copies of the connectivity, geometry, Coriolis and
+   /// edge sign arrays, which are rarely used on the host once their device
+   /// copies exist, to reduce host memory on GPU nodes. The shared
+   /// connectivity is only freed once the decomposition has also released
+   /// it (Decomp::releaseHostArrays). Nothing is released in host builds,
+   /// where the host and device arrays share memory. Host code that may run
+   /// after the release must access these arrays with getHost.
+   void releaseHostArrays();
+
+   /// Returns the host array Host of this mesh, eg. getHost(AreaCellH). If it
+   /// was released, a host copy of the device array is returned instead,
+   /// which is freed when no longer referenced.
+   template <typename H> H getHost(const H &Host) const {
+      if (Host.data() != nullptr)
+         return Host;
+      H Copy = Host;
+      forEachHostArray(*this, [&](const auto &HostArr, const auto &DevArr) {
+         if constexpr (std::is_same_v<std::decay_t<decltype(HostArr)>, H>) {
+            if (&HostArr == &Host)
+               Copy = createHostMirrorCopy(DevArr);
+         }
+      });
+      return Copy;
+   }
+
    /// Destructor - deallocates all memory and deletes a HorzMesh
    ~HorzMesh();
 
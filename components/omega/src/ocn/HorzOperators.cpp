@@ -2,23 +2,192 @@
 #include "DataTypes.h"
 #include "HorzMesh.h"
 
+#include <algorithm>
+
 namespace OMEGA {
 
+namespace {
+
+// Sizes in bytes of the field, metric and index entries
+constexpr R8 RealBytes   = sizeof(Real);
+constexpr R8 MetricBytes = sizeof(MetricReal);
+constexpr R8 IndexBytes  = sizeof(I4);
+
+// Mean number of edges of the owned cells, estimated from the ratio of owned
+// edges to owned cells since each edge is shared by two cells
+R8 meanEdgesOnCell(HorzMesh const *Mesh) {
+   if (Mesh->NCellsOwned == 0)
+      return 0.0;
+   return std::min(static_cast<R8>(Mesh->MaxEdges),
+                   2.0 * Mesh->NEdgesOwned / Mesh->NCellsOwned);
+}
+
+} // end anonymous namespace
+
 DivergenceOnCell::DivergenceOnCell(HorzMesh const *Mesh)
-    : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell),
-      EdgeSignOnCell(Mesh->EdgeSignOnCell) {}
+    : OpMaxEdges(Mesh->OpMaxEdges), OpCellCSR(Mesh->OpCellCSR),
+      NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
+      DivWeightsOnCell(Mesh->OpDivWeightsOnCell),
+      EdgeOffsetsOnCell(Mesh->OpEdgeOffsetsOnCell),
+      EdgesOnCellCSR(Mesh->OpEdgesOnCellCSR),
+      DivWeightsOnCellCSR(Mesh->OpDivWeightsOnCellCSR),
+      MinLevelCell(Mesh->MinLevelCell), MaxLevelCell(Mesh->MaxLevelCell) {}
+
+// The number of edges of a cell and its offset in the CSR form have the same
+// size, so the estimate holds for both forms of the incidence
+OperatorWork DivergenceOnCell::work(HorzMesh const *Mesh, I4 NVertLevels) {
+   const R8 NCells = Mesh->NCellsOwned;
+   const R8 NEdges = Mesh->NEdgesOwned;
+   const R8 JEdges = meanEdgesOnCell(Mesh);
+
+   OperatorWork Work;
+   Work.Bytes = (NEdges + NCells) * NVertLevels * RealBytes +
+                NCells * IndexBytes +
+                NCells * JEdges * (IndexBytes + MetricBytes);
+   Work.Flops = 2.0 * NCells * JEdges * NVertLevels;
+   return Work;
+}
 
 GradientOnEdge::GradientOnEdge(HorzMesh const *Mesh)
-    : CellsOnEdge(Mesh->CellsOnEdge), DcEdge(Mesh->DcEdge) {}
+    : CellsOnEdge(Mesh->CellsOnEdge), InvDcEdge(Mesh->OpInvDcEdge),
+      MinLevelEdgeTop(Mesh->MinLevelEdgeTop),
+      MaxLevelEdgeTop(Mesh->MaxLevelEdgeTop) {}
+
+OperatorWork GradientOnEdge::work(HorzMesh const *Mesh, I4 NVertLevels) {
+   const R8 NCells = Mesh->NCellsOwned;
+   const R8 NEdges = Mesh->NEdgesOwned;
+
+   OperatorWork Work;
+   Work.Bytes = (NCells + NEdges) * NVertLevels * RealBytes +
+                NEdges * (2.0 * IndexBytes + MetricBytes);
+   Work.Flops = 2.0 * NEdges * NVertLevels;
+   return Work;
+}
 
 CurlOnVertex::CurlOnVertex(HorzMesh const *Mesh)
-    : VertexDegree(Mesh->VertexDegree), EdgesOnVertex(Mesh->EdgesOnVertex),
-      DcEdge(Mesh->DcEdge), AreaTriangle(Mesh->AreaTriangle),
-      EdgeSignOnVertex(Mesh->EdgeSignOnVertex) {}
+    : VertexDegree(Mesh->VertexDegree), OpVertexDegree(Mesh->OpVertexDegree),
+      EdgesOnVertex(Mesh->EdgesOnVertex),
+      CurlWeightsOnVertex(Mesh->OpCurlWeightsOnVertex),
+      MinLevelVertexBot(Mesh->MinLevelVertexBot),
+      MaxLevelVertexBot(Mesh->MaxLevelVertexBot) {}
+
+OperatorWork CurlOnVertex::work(HorzMesh const *Mesh, I4 NVertLevels) {
+   const R8 NEdges    = Mesh->NEdgesOwned;
+   const R8 NVertices = Mesh->NVerticesOwned;
+   const R8 JEdges    = Mesh->VertexDegree;
+
+   OperatorWork Work;
+   Work.Bytes = (NEdges + NVertices) * NVertLevels * RealBytes +
+                NVertices * JEdges * (IndexBytes + MetricBytes);
+   Work.Flops = 2.0 * NVertices * JEdges * NVertLevels;
+   return Work;
+}
 
 TangentialReconOnEdge::TangentialReconOnEdge(HorzMesh const *Mesh)
-    : NEdgesOnEdge(Mesh->NEdgesOnEdge), EdgesOnEdge(Mesh->EdgesOnEdge),
-      WeightsOnEdge(Mesh->WeightsOnEdge) {}
+    : OpMaxEdges(Mesh->OpMaxEdges), NEdgesOnEdge(Mesh->NEdgesOnEdge),
+      EdgesOnEdge(Mesh->EdgesOnEdge), WeightsOnEdge(Mesh->OpWeightsOnEdge),
+      MinLevelEdgeTop(Mesh->MinLevelEdgeTop),
+      MaxLevelEdgeTop(Mesh->MaxLevelEdgeTop) {}
+
+OperatorWork TangentialReconOnEdge::work(HorzMesh const *Mesh,
+                                         I4 NVertLevels) {
+   // The edges of an edge are the other edges of its two cells
+   const R8 NEdges = Mesh->NEdgesOwned;
+   const R8 JEdges = std::max(0.0, 2.0 * (meanEdgesOnCell(Mesh) - 1.0));
+
+   OperatorWork Work;
+   Work.Bytes = 2.0 * NEdges * NVertLevels * RealBytes + NEdges * IndexBytes +
+                NEdges * JEdges * (IndexBytes + MetricBytes);
+   Work.Flops = 2.0 * NEdges * JEdges * NVertLevels;
+   return Work;
+}
+
+DivergenceAndFluxDivOnCell::DivergenceAndFluxDivOnCell(HorzMesh const *Mesh)
+    : OpMaxEdges(Mesh->OpMaxEdges), NEdgesOnCell(Mesh->NEdgesOnCell),
+      EdgesOnCell(Mesh->EdgesOnCell),
+      DivWeightsOnCell(Mesh->OpDivWeightsOnCell),
+      MinLevelCell(Mesh->MinLevelCell), MaxLevelCell(Mesh->MaxLevelCell) {}
+
+OperatorWork DivergenceAndFluxDivOnCell::work(HorzMesh const *Mesh,
+                                              I4 NVertLevels) {
+   const R8 NCells = Mesh->NCellsOwned;
+   const R8 NEdges = Mesh->NEdgesOwned;
+   const R8 JEdges = meanEdgesOnCell(Mesh);
+
+   OperatorWork Work;
+   Work.Bytes = 2.0 * (NEdges + NCells) * NVertLevels * RealBytes +
+                NCells * IndexBytes +
+                NCells * JEdges * (IndexBytes + MetricBytes);
+   Work.Flops = 4.0 * NCells * JEdges * NVertLevels;
+   return Work;
+}
+
+CurlAndPotVortOnVertex::CurlAndPotVortOnVertex(HorzMesh const *Mesh)
+    : VertexDegree(Mesh->VertexDegree), OpVertexDegree(Mesh->OpVertexDegree),
+      EdgesOnVertex(Mesh->EdgesOnVertex), CellsOnVertex(Mesh->CellsOnVertex),
+      CurlWeightsOnVertex(Mesh->OpCurlWeightsOnVertex),
+      KiteFracOnVertex(Mesh->OpKiteFracOnVertex), FVertex(Mesh->FVertex),
+      MinLevelVertexBot(Mesh->MinLevelVertexBot),
+      MaxLevelVertexBot(Mesh->MaxLevelVertexBot) {}
+
+OperatorWork CurlAndPotVortOnVertex::work(HorzMesh const *Mesh,
+                                          I4 NVertLevels) {
+   const R8 NCells    = Mesh->NCellsOwned;
+   const R8 NEdges    = Mesh->NEdgesOwned;
+   const R8 NVertices = Mesh->NVerticesOwned;
+   const R8 JEdges    = Mesh->VertexDegree;
+
+   OperatorWork Work;
+   Work.Bytes = (NEdges + NCells + 2.0 * NVertices) * NVertLevels * RealBytes +
+                NVertices * sizeof(R8) +
+                NVertices * JEdges * 2.0 * (IndexBytes + MetricBytes);
+   Work.Flops = (4.0 * JEdges + 2.0) * NVertices * NVertLevels;
+   return Work;
+}
+
+ScalarLaplacianOnCell::ScalarLaplacianOnCell(HorzMesh const *Mesh)
+    : OpMaxEdges(Mesh->OpMaxEdges), NEdgesOnCell(Mesh->NEdgesOnCell),
+      EdgesOnCell(Mesh->EdgesOnCell), CellsOnEdge(Mesh->CellsOnEdge),
+      LapWeightsOnCell(Mesh->OpLapWeightsOnCell),
+      MinLevelCell(Mesh->MinLevelCell), MaxLevelCell(Mesh->MaxLevelCell) {}
+
+OperatorWork ScalarLaplacianOnCell::work(HorzMesh const *Mesh,
+                                         I4 NVertLevels) {
+   // The cells across the edges of a cell are gathered from the cache
+   const R8 NCells = Mesh->NCellsOwned;
+   const R8 JEdges = meanEdgesOnCell(Mesh);
+
+   OperatorWork Work;
+   Work.Bytes = 2.0 * NCells * NVertLevels * RealBytes + NCells * IndexBytes +
+                NCells * JEdges * (3.0 * IndexBytes + MetricBytes);
+   Work.Flops = 3.0 * NCells * JEdges * NVertLevels;
+   return Work;
+}
+
+VectorLaplacianOnEdge::VectorLaplacianOnEdge(HorzMesh const *Mesh)
+    : OpMaxEdges(Mesh->OpMaxEdges), VertexDegree(Mesh->VertexDegree),
+      OpVertexDegree(Mesh->OpVertexDegree), NEdgesOnCell(Mesh->NEdgesOnCell),
+      EdgesOnCell(Mesh->EdgesOnCell), CellsOnEdge(Mesh->CellsOnEdge),
+      VerticesOnEdge(Mesh->VerticesOnEdge),
+      EdgesOnVertex(Mesh->EdgesOnVertex), InvDcEdge(Mesh->OpInvDcEdge),
+      DvEdge(Mesh->DvEdge), DivWeightsOnCell(Mesh->OpDivWeightsOnCell),
+      CurlWeightsOnVertex(Mesh->OpCurlWeightsOnVertex),
+      MinLevelEdgeTop(Mesh->MinLevelEdgeTop),
+      MaxLevelEdgeTop(Mesh->MaxLevelEdgeTop) {}
+
+OperatorWork VectorLaplacianOnEdge::work(HorzMesh const *Mesh,
+                                         I4 NVertLevels) {
+   // The divergence is evaluated at two cells and the curl at two vertices
+   // of each edge, with the neighboring values gathered from the cache
+   const R8 NEdges = Mesh->NEdgesOwned;
+   const R8 JEdges = meanEdgesOnCell(Mesh);
+   const R8 VEdges = Mesh->VertexDegree;
+
+   OperatorWork Work;
+   Work.Bytes = 2.0 * NEdges * NVertLevels * RealBytes +
+                NEdges * (4.0 * IndexBytes + MetricBytes + sizeof(R8));
+   Work.Flops = (4.0 * (JEdges + VEdges) + 5.0) * NEdges * NVertLevels;
+   return Work;
+}
 
 } // namespace OMEGA
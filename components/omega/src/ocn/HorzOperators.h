@@ -3,133 +3,652 @@
 
 #include "DataTypes.h"
 #include "HorzMesh.h"
+#include "Pack.h"
 
 namespace OMEGA {
 
+// The loops over the edges of a cell or vertex in the operators below are
+// specialized at compile time for the values of MaxEdges and VertexDegree
+// selected by the mesh (HorzMesh::OpMaxEdges and HorzMesh::OpVertexDegree),
+// which allows the compiler to fully unroll them and keep the sums in
+// registers. For MaxEdges specializations, the loops run over all MaxEdges
+// entries and skip those beyond the number of edges of the element, which
+// gives uniform trip counts across threads. Template arguments of zero select
+// the generic loops with runtime bounds.
+//
+// The operators compute a chunk of VecLength vertical levels per call, with
+// KChunk running over numVertChunks(NVertLevels) chunks, where NVertLevels is
+// the second extent of the output array. If NVertLevels is not a multiple of
+// VecLength, the last chunk is partial. Operators that accumulate over the
+// neighbors of an element hold the chunk in SIMD registers (RealPack, see
+// Pack.h): the loads of a partial chunk are clamped to the last level, so
+// the sums keep their full vector width, and only the stores of levels
+// beyond the last are skipped. Operators without accumulation loop over the
+// levels of the chunk directly.
+//
+// Each operator skips the chunks with no active levels of its element, given
+// by the vertical level bounds of the mesh (HorzMesh::MinLevelCell, etc.), so
+// that no work is done below the bottom of the ocean or in land columns. The
+// call operators set the output of a skipped chunk to zero and the add
+// methods leave the sum unchanged. Chunks with at least one active level are
+// computed in full.
+//
+// The static work function of each operator estimates the bytes moved and
+// floating point operations of one call over all owned elements and
+// NVertLevels levels, which can be added to a timer around the call (see
+// Timer::addWork) to report the achieved bandwidth and flop rate. The bytes
+// are the compulsory traffic, in which each input and output value and each
+// mesh array entry is moved once, and the number of edges of a cell is
+// estimated by its mean over the owned cells.
+
+/// Estimated work of one operator call
+struct OperatorWork {
+   R8 Bytes{0.0}; ///< bytes moved to or from memory
+   R8 Flops{0.0}; ///< floating point operations
+};
+
+/// Returns true if chunk KChunk has no level between MinLevel and MaxLevel
+KOKKOS_INLINE_FUNCTION bool isInactiveChunk(int KChunk, int MinLevel,
+                                            int MaxLevel) {
+   const int KStart = KChunk * VecLength;
+   return KStart > MaxLevel || KStart + VecLength <= MinLevel;
+}
+
+/// Sets the levels of chunk KChunk of element I of Array to zero
+template <typename V>
+KOKKOS_INLINE_FUNCTION void zeroChunk(const V &Array, int I, int KChunk) {
+   const int KStart = KChunk * VecLength;
+   const int KEnd   = Kokkos::min(KStart + VecLength, Array.extent_int(1));
+   for (int K = KStart; K < KEnd; ++K)
+      Array(I, K) = 0;
+}
+
 class DivergenceOnCell {
  public:
    DivergenceOnCell(HorzMesh const *Mesh);
 
-   KOKKOS_FUNCTION void operator()(const Array2DReal &DivCell, int ICell,
-                                   int KChunk,
-                                   const Array2DReal &VecEdge) const {
-      const int KStart       = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+   static OperatorWork work(HorzMesh const *Mesh, I4 NVertLevels);
 
-      Real DivCellTmp[VecLength] = {0};
+   template <typename OutArray, typename InArray>
+   KOKKOS_FUNCTION void operator()(const OutArray &DivCell, int ICell,
+                                   int KChunk, const InArray &VecEdge) const {
+      if (isInactiveChunk(KChunk, MinLevelCell(ICell), MaxLevelCell(ICell))) {
+         zeroChunk(DivCell, ICell, KChunk);
+         return;
+      }
+      if (OpCellCSR) {
+         computeCSR(DivCell, ICell, KChunk, VecEdge);
+         return;
+      }
+      switch (OpMaxEdges) {
+      case 6:
+         compute<6>(DivCell, ICell, KChunk, VecEdge);
+         break;
+      case 7:
+         compute<7>(DivCell, ICell, KChunk, VecEdge);
+         break;
+      case 8:
+         compute<8>(DivCell, ICell, KChunk, VecEdge);
+         break;
+      default:
+         compute<0>(DivCell, ICell, KChunk, VecEdge);
+      }
+   }
+
+ private:
+   template <int MaxEdgesT, typename OutArray, typename InArray>
+   KOKKOS_FUNCTION void compute(const OutArray &DivCell, int ICell,
+                                int KChunk, const InArray &VecEdge) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = DivCell.extent_int(1) - 1;
+      const int NEdges = NEdgesOnCell(ICell);
+      const int JEnd   = MaxEdgesT > 0 ? MaxEdgesT : NEdges;
+
+      RealPack DivCellTmp(0);
 
-      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const int JEdge = EdgesOnCell(ICell, J);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            DivCellTmp[KVec] -= DvEdge(JEdge) * EdgeSignOnCell(ICell, J) *
-                                VecEdge(JEdge, K) * InvAreaCell;
+      for (int J = 0; J < JEnd; ++J) {
+         if (J < NEdges) {
+            const int JEdge   = EdgesOnCell(ICell, J);
+            const Real Weight = DivWeightsOnCell(ICell, J);
+            DivCellTmp -=
+                Weight * RealPack::load(VecEdge, JEdge, KStart, KLast);
          }
       }
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K       = KStart + KVec;
-         DivCell(ICell, K) = DivCellTmp[KVec];
+      DivCellTmp.store(DivCell, ICell, KStart, KLast);
+   }
+
+   template <typename OutArray, typename InArray>
+   KOKKOS_FUNCTION void computeCSR(const OutArray &DivCell, int ICell,
+                                   int KChunk, const InArray &VecEdge) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = DivCell.extent_int(1) - 1;
+      const int JStart = EdgeOffsetsOnCell(ICell);
+      const int JEnd   = EdgeOffsetsOnCell(ICell + 1);
+
+      RealPack DivCellTmp(0);
+
+      for (int J = JStart; J < JEnd; ++J) {
+         const int JEdge   = EdgesOnCellCSR(J);
+         const Real Weight = DivWeightsOnCellCSR(J);
+         DivCellTmp -= Weight * RealPack::load(VecEdge, JEdge, KStart, KLast);
       }
+
+      DivCellTmp.store(DivCell, ICell, KStart, KLast);
    }
 
- private:
+   I4 OpMaxEdges;
+   bool OpCellCSR;
    Array1DI4 NEdgesOnCell;
    Array2DI4 EdgesOnCell;
-   Array1DR8 DvEdge;
-   Array1DR8 AreaCell;
-   Array2DR8 EdgeSignOnCell;
+   Array2DMetric DivWeightsOnCell;
+   Array1DI4 EdgeOffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
+   Array1DMetric DivWeightsOnCellCSR;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
 };
 
 class GradientOnEdge {
  public:
    GradientOnEdge(HorzMesh const *Mesh);
 
-   KOKKOS_FUNCTION void operator()(const Array2DReal &GradEdge, int IEdge,
+   static OperatorWork work(HorzMesh const *Mesh, I4 NVertLevels);
+
+   template <typename OutArray, typename InArray>
+   KOKKOS_FUNCTION void operator()(const OutArray &GradEdge, int IEdge,
                                    int KChunk,
-                                   const Array2DReal &ScalarCell) const {
-      const int KStart     = KChunk * VecLength;
-      const Real InvDcEdge = 1._Real / DcEdge(IEdge);
-      const auto JCell0    = CellsOnEdge(IEdge, 0);
-      const auto JCell1    = CellsOnEdge(IEdge, 1);
-
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K = KStart + KVec;
+                                   const InArray &ScalarCell) const {
+      if (isInactiveChunk(KChunk, MinLevelEdgeTop(IEdge),
+                          MaxLevelEdgeTop(IEdge))) {
+         zeroChunk(GradEdge, IEdge, KChunk);
+         return;
+      }
+      const int KStart  = KChunk * VecLength;
+      const int KEnd =
+          Kokkos::min(KStart + VecLength, GradEdge.extent_int(1));
+      const Real InvDc  = InvDcEdge(IEdge);
+      const auto JCell0 = CellsOnEdge(IEdge, 0);
+      const auto JCell1 = CellsOnEdge(IEdge, 1);
+
+      for (int K = KStart; K < KEnd; ++K) {
          GradEdge(IEdge, K) =
-             InvDcEdge * (ScalarCell(JCell1, K) - ScalarCell(JCell0, K));
+             InvDc * (ScalarCell(JCell1, K) - ScalarCell(JCell0, K));
       }
    }
 
  private:
    Array2DI4 CellsOnEdge;
-   Array1DR8 DcEdge;
+   Array1DMetric InvDcEdge;
+   Array1DI4 MinLevelEdgeTop;
+   Array1DI4 MaxLevelEdgeTop;
 };
 
 class CurlOnVertex {
  public:
    CurlOnVertex(HorzMesh const *Mesh);
 
-   KOKKOS_FUNCTION void operator()(const Array2DReal &CurlVertex, int IVertex,
-                                   int KChunk,
-                                   const Array2DReal &VecEdge) const {
-      const int KStart           = KChunk * VecLength;
-      const Real InvAreaTriangle = 1._Real / AreaTriangle(IVertex);
-
-      Real CurlVertexTmp[VecLength] = {0};
-
-      for (int J = 0; J < VertexDegree; ++J) {
-         const int JEdge = EdgesOnVertex(IVertex, J);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            CurlVertexTmp[KVec] += DcEdge(JEdge) *
-                                   EdgeSignOnVertex(IVertex, J) *
-                                   VecEdge(JEdge, K) * InvAreaTriangle;
-         }
-      }
+   static OperatorWork work(HorzMesh const *Mesh, I4 NVertLevels);
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K            = KStart + KVec;
-         CurlVertex(IVertex, K) = CurlVertexTmp[KVec];
+   template <typename OutArray, typename InArray>
+   KOKKOS_FUNCTION void operator()(const OutArray &CurlVertex, int IVertex,
+                                   int KChunk, const InArray &VecEdge) const {
+      if (isInactiveChunk(KChunk, MinLevelVertexBot(IVertex),
+                          MaxLevelVertexBot(IVertex))) {
+         zeroChunk(CurlVertex, IVertex, KChunk);
+         return;
+      }
+      if (OpVertexDegree == 3) {
+         compute<3>(CurlVertex, IVertex, KChunk, VecEdge);
+      } else {
+         compute<0>(CurlVertex, IVertex, KChunk, VecEdge);
       }
    }
 
  private:
+   template <int VertexDegreeT, typename OutArray, typename InArray>
+   KOKKOS_FUNCTION void compute(const OutArray &CurlVertex, int IVertex,
+                                int KChunk, const InArray &VecEdge) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = CurlVertex.extent_int(1) - 1;
+      const int JEnd   = VertexDegreeT > 0 ? VertexDegreeT : VertexDegree;
+
+      RealPack CurlVertexTmp(0);
+
+      for (int J = 0; J < JEnd; ++J) {
+         const int JEdge   = EdgesOnVertex(IVertex, J);
+         const Real Weight = CurlWeightsOnVertex(IVertex, J);
+         CurlVertexTmp +=
+             Weight * RealPack::load(VecEdge, JEdge, KStart, KLast);
+      }
+
+      CurlVertexTmp.store(CurlVertex, IVertex, KStart, KLast);
+   }
+
    I4 VertexDegree;
+   I4 OpVertexDegree;
    Array2DI4 EdgesOnVertex;
-   Array1DR8 DcEdge;
-   Array1DR8 AreaTriangle;
-   Array2DR8 EdgeSignOnVertex;
+   Array2DMetric CurlWeightsOnVertex;
+   Array1DI4 MinLevelVertexBot;
+   Array1DI4 MaxLevelVertexBot;
 };
 
 class TangentialReconOnEdge {
  public:
    TangentialReconOnEdge(HorzMesh const *Mesh);
 
-   KOKKOS_FUNCTION void operator()(const Array2DReal &ReconEdge, int IEdge,
+   static OperatorWork work(HorzMesh const *Mesh, I4 NVertLevels);
+
+   template <typename OutArray, typename InArray>
+   KOKKOS_FUNCTION void operator()(const OutArray &ReconEdge, int IEdge,
+                                   int KChunk, const InArray &VecEdge) const {
+      if (isInactiveChunk(KChunk, MinLevelEdgeTop(IEdge),
+                          MaxLevelEdgeTop(IEdge))) {
+         zeroChunk(ReconEdge, IEdge, KChunk);
+         return;
+      }
+      switch (OpMaxEdges) {
+      case 6:
+         compute<12>(ReconEdge, IEdge, KChunk, VecEdge);
+         break;
+      case 7:
+         compute<14>(ReconEdge, IEdge, KChunk, VecEdge);
+         break;
+      case 8:
+         compute<16>(ReconEdge, IEdge, KChunk, VecEdge);
+         break;
+      default:
+         compute<0>(ReconEdge, IEdge, KChunk, VecEdge);
+      }
+   }
+
+ private:
+   template <int MaxEdges2T, typename OutArray, typename InArray>
+   KOKKOS_FUNCTION void compute(const OutArray &ReconEdge, int IEdge,
+                                int KChunk, const InArray &VecEdge) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = ReconEdge.extent_int(1) - 1;
+      const int NEdges = NEdgesOnEdge(IEdge);
+      const int JEnd   = MaxEdges2T > 0 ? MaxEdges2T : NEdges;
+
+      RealPack ReconEdgeTmp(0);
+
+      for (int J = 0; J < JEnd; ++J) {
+         if (J < NEdges) {
+            const int JEdge   = EdgesOnEdge(IEdge, J);
+            const Real Weight = WeightsOnEdge(IEdge, J);
+            ReconEdgeTmp +=
+                Weight * RealPack::load(VecEdge, JEdge, KStart, KLast);
+         }
+      }
+
+      ReconEdgeTmp.store(ReconEdge, IEdge, KStart, KLast);
+   }
+
+   I4 OpMaxEdges;
+   Array1DI4 NEdgesOnEdge;
+   Array2DI4 EdgesOnEdge;
+   Array2DMetric WeightsOnEdge;
+   Array1DI4 MinLevelEdgeTop;
+   Array1DI4 MaxLevelEdgeTop;
+};
+
+// Fused operator computing in a single pass over the edges of each cell both
+// the divergence of VecEdge and the flux-form divergence of the product of
+// VecEdge and ScalarEdge, so that the cell connectivity and metric terms are
+// only loaded once
+class DivergenceAndFluxDivOnCell {
+ public:
+   DivergenceAndFluxDivOnCell(HorzMesh const *Mesh);
+
+   static OperatorWork work(HorzMesh const *Mesh, I4 NVertLevels);
+
+   KOKKOS_FUNCTION void operator()(const Array2DReal &DivCell,
+                                   const Array2DReal &FluxDivCell, int ICell,
+                                   int KChunk, const Array2DReal &VecEdge,
+                                   const Array2DReal &ScalarEdge) const {
+      if (isInactiveChunk(KChunk, MinLevelCell(ICell), MaxLevelCell(ICell))) {
+         zeroChunk(DivCell, ICell, KChunk);
+         zeroChunk(FluxDivCell, ICell, KChunk);
+         return;
+      }
+      switch (OpMaxEdges) {
+      case 6:
+         compute<6>(DivCell, FluxDivCell, ICell, KChunk, VecEdge, ScalarEdge);
+         break;
+      case 7:
+         compute<7>(DivCell, FluxDivCell, ICell, KChunk, VecEdge, ScalarEdge);
+         break;
+      case 8:
+         compute<8>(DivCell, FluxDivCell, ICell, KChunk, VecEdge, ScalarEdge);
+         break;
+      default:
+         compute<0>(DivCell, FluxDivCell, ICell, KChunk, VecEdge, ScalarEdge);
+      }
+   }
+
+ private:
+   template <int MaxEdgesT>
+   KOKKOS_FUNCTION void compute(const Array2DReal &DivCell,
+                                const Array2DReal &FluxDivCell, int ICell,
+                                int KChunk, const Array2DReal &VecEdge,
+                                const Array2DReal &ScalarEdge) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = DivCell.extent_int(1) - 1;
+      const int NEdges = NEdgesOnCell(ICell);
+      const int JEnd   = MaxEdgesT > 0 ? MaxEdgesT : NEdges;
+
+      RealPack DivCellTmp(0);
+      RealPack FluxDivCellTmp(0);
+
+      for (int J = 0; J < JEnd; ++J) {
+         if (J < NEdges) {
+            const int JEdge   = EdgesOnCell(ICell, J);
+            const Real Weight = DivWeightsOnCell(ICell, J);
+            const RealPack DivTerm =
+                Weight * RealPack::load(VecEdge, JEdge, KStart, KLast);
+            DivCellTmp -= DivTerm;
+            FluxDivCellTmp -=
+                DivTerm * RealPack::load(ScalarEdge, JEdge, KStart, KLast);
+         }
+      }
+
+      DivCellTmp.store(DivCell, ICell, KStart, KLast);
+      FluxDivCellTmp.store(FluxDivCell, ICell, KStart, KLast);
+   }
+
+   I4 OpMaxEdges;
+   Array1DI4 NEdgesOnCell;
+   Array2DI4 EdgesOnCell;
+   Array2DMetric DivWeightsOnCell;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+};
+
+// Fused operator computing in a single pass over the edges and cells of each
+// vertex the curl (relative vorticity) of VecEdge and the potential vorticity
+// (RelVort + FVertex) / ThickVertex, where the thickness at the vertex is the
+// kite-area weighted average of the cell thickness ThickCell
+class CurlAndPotVortOnVertex {
+ public:
+   CurlAndPotVortOnVertex(HorzMesh const *Mesh);
+
+   static OperatorWork work(HorzMesh const *Mesh, I4 NVertLevels);
+
+   KOKKOS_FUNCTION void operator()(const Array2DReal &RelVortVertex,
+                                   const Array2DReal &PotVortVertex,
+                                   int IVertex, int KChunk,
+                                   const Array2DReal &VecEdge,
+                                   const Array2DReal &ThickCell) const {
+      if (isInactiveChunk(KChunk, MinLevelVertexBot(IVertex),
+                          MaxLevelVertexBot(IVertex))) {
+         zeroChunk(RelVortVertex, IVertex, KChunk);
+         zeroChunk(PotVortVertex, IVertex, KChunk);
+         return;
+      }
+      if (OpVertexDegree == 3) {
+         compute<3>(RelVortVertex, PotVortVertex, IVertex, KChunk, VecEdge,
+                    ThickCell);
+      } else {
+         compute<0>(RelVortVertex, PotVortVertex, IVertex, KChunk, VecEdge,
+                    ThickCell);
+      }
+   }
+
+ private:
+   template <int VertexDegreeT>
+   KOKKOS_FUNCTION void compute(const Array2DReal &RelVortVertex,
+                                const Array2DReal &PotVortVertex, int IVertex,
+                                int KChunk, const Array2DReal &VecEdge,
+                                const Array2DReal &ThickCell) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = RelVortVertex.extent_int(1) - 1;
+      const int JEnd   = VertexDegreeT > 0 ? VertexDegreeT : VertexDegree;
+
+      RealPack RelVortTmp(0);
+      RealPack ThickVertTmp(0);
+
+      for (int J = 0; J < JEnd; ++J) {
+         const int JEdge     = EdgesOnVertex(IVertex, J);
+         const int JCell     = CellsOnVertex(IVertex, J);
+         const Real Weight   = CurlWeightsOnVertex(IVertex, J);
+         const Real KiteFrac = KiteFracOnVertex(IVertex, J);
+         RelVortTmp += Weight * RealPack::load(VecEdge, JEdge, KStart, KLast);
+         ThickVertTmp +=
+             KiteFrac * RealPack::load(ThickCell, JCell, KStart, KLast);
+      }
+
+      const Real FVert = FVertex(IVertex);
+      RelVortTmp.store(RelVortVertex, IVertex, KStart, KLast);
+      ((RelVortTmp + FVert) / ThickVertTmp)
+          .store(PotVortVertex, IVertex, KStart, KLast);
+   }
+
+   I4 VertexDegree;
+   I4 OpVertexDegree;
+   Array2DI4 EdgesOnVertex;
+   Array2DI4 CellsOnVertex;
+   Array2DMetric CurlWeightsOnVertex;
+   Array2DMetric KiteFracOnVertex;
+   Array1DR8 FVertex;
+   Array1DI4 MinLevelVertexBot;
+   Array1DI4 MaxLevelVertexBot;
+};
+
+// Laplacian of a scalar ScalarCell, computed as the divergence of its
+// gradient with the gradient at each edge of the cell evaluated on the fly,
+// so that no array of gradients is needed. The add method adds a multiple of
+// the Laplacian at one chunk to a register array, so that it can be summed
+// with other terms before a single store. The scalar can be any rank-2 view,
+// such as a single tracer of the tracer array.
+class ScalarLaplacianOnCell {
+ public:
+   ScalarLaplacianOnCell(HorzMesh const *Mesh);
+
+   static OperatorWork work(HorzMesh const *Mesh, I4 NVertLevels);
+
+   template <typename ScalarArray>
+   KOKKOS_FUNCTION void operator()(const Array2DReal &LapCell, int ICell,
                                    int KChunk,
-                                   const Array2DReal &VecEdge) const {
+                                   const ScalarArray &ScalarCell) const {
+      if (isInactiveChunk(KChunk, MinLevelCell(ICell), MaxLevelCell(ICell))) {
+         zeroChunk(LapCell, ICell, KChunk);
+         return;
+      }
       const int KStart = KChunk * VecLength;
+      const int KLast  = LapCell.extent_int(1) - 1;
 
-      Real ReconEdgeTmp[VecLength] = {0};
+      RealPack LapCellTmp(0);
+      accumulate(LapCellTmp, ICell, KChunk, 1.0_Real, ScalarCell);
+      LapCellTmp.store(LapCell, ICell, KStart, KLast);
+   }
 
-      for (int J = 0; J < NEdgesOnEdge(IEdge); ++J) {
-         const int JEdge = EdgesOnEdge(IEdge, J);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            ReconEdgeTmp[KVec] += WeightsOnEdge(IEdge, J) * VecEdge(JEdge, K);
+   template <typename ScalarArray>
+   KOKKOS_FUNCTION void add(Real (&Tend)[VecLength], int ICell, int KChunk,
+                            Real Coeff, const ScalarArray &ScalarCell) const {
+      if (isInactiveChunk(KChunk, MinLevelCell(ICell), MaxLevelCell(ICell)))
+         return;
+      RealPack LapCellTmp(0);
+      accumulate(LapCellTmp, ICell, KChunk, Coeff, ScalarCell);
+      LapCellTmp.addTo(Tend);
+   }
+
+ private:
+   template <typename ScalarArray>
+   KOKKOS_FUNCTION void accumulate(RealPack &Sum, int ICell, int KChunk,
+                                   Real Coeff,
+                                   const ScalarArray &ScalarCell) const {
+      switch (OpMaxEdges) {
+      case 6:
+         compute<6>(Sum, ICell, KChunk, Coeff, ScalarCell);
+         break;
+      case 7:
+         compute<7>(Sum, ICell, KChunk, Coeff, ScalarCell);
+         break;
+      case 8:
+         compute<8>(Sum, ICell, KChunk, Coeff, ScalarCell);
+         break;
+      default:
+         compute<0>(Sum, ICell, KChunk, Coeff, ScalarCell);
+      }
+   }
+
+   template <int MaxEdgesT, typename ScalarArray>
+   KOKKOS_FUNCTION void compute(RealPack &Sum, int ICell, int KChunk,
+                                Real Coeff,
+                                const ScalarArray &ScalarCell) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = ScalarCell.extent_int(1) - 1;
+      const int NEdges = NEdgesOnCell(ICell);
+      const int JEnd   = MaxEdgesT > 0 ? MaxEdgesT : NEdges;
+
+      for (int J = 0; J < JEnd; ++J) {
+         if (J < NEdges) {
+            const int JEdge   = EdgesOnCell(ICell, J);
+            const int JCell0  = CellsOnEdge(JEdge, 0);
+            const int JCell1  = CellsOnEdge(JEdge, 1);
+            const Real Weight = Coeff * LapWeightsOnCell(ICell, J);
+            Sum -= Weight *
+                   (RealPack::load(ScalarCell, JCell1, KStart, KLast) -
+                    RealPack::load(ScalarCell, JCell0, KStart, KLast));
          }
       }
+   }
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K         = KStart + KVec;
-         ReconEdge(IEdge, K) = ReconEdgeTmp[KVec];
+   I4 OpMaxEdges;
+   Array1DI4 NEdgesOnCell;
+   Array2DI4 EdgesOnCell;
+   Array2DI4 CellsOnEdge;
+   Array2DMetric LapWeightsOnCell;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+};
+
+// Laplacian of a vector VecEdge normal to the edges, computed as the gradient
+// of its divergence minus the perpendicular gradient of its curl. The
+// divergence at the two cells and the curl at the two vertices of the edge
+// are evaluated on the fly, so that no arrays of divergence or curl are
+// needed, at the cost of evaluating each of them at several edges. On an
+// owned edge, the Laplacian reads VecEdge on the first two edge halo layers.
+// As for the scalar Laplacian, the add method adds a multiple of the
+// Laplacian at one chunk to a register array.
+class VectorLaplacianOnEdge {
+ public:
+   VectorLaplacianOnEdge(HorzMesh const *Mesh);
+
+   static OperatorWork work(HorzMesh const *Mesh, I4 NVertLevels);
+
+   KOKKOS_FUNCTION void operator()(const Array2DReal &LapEdge, int IEdge,
+                                   int KChunk,
+                                   const Array2DReal &VecEdge) const {
+      if (isInactiveChunk(KChunk, MinLevelEdgeTop(IEdge),
+                          MaxLevelEdgeTop(IEdge))) {
+         zeroChunk(LapEdge, IEdge, KChunk);
+         return;
       }
+      const int KStart = KChunk * VecLength;
+      const int KLast  = LapEdge.extent_int(1) - 1;
+
+      RealPack LapEdgeTmp(0);
+      accumulate(LapEdgeTmp, IEdge, KChunk, 1.0_Real, VecEdge);
+      LapEdgeTmp.store(LapEdge, IEdge, KStart, KLast);
+   }
+
+   KOKKOS_FUNCTION void add(Real (&Tend)[VecLength], int IEdge, int KChunk,
+                            Real Coeff, const Array2DReal &VecEdge) const {
+      if (isInactiveChunk(KChunk, MinLevelEdgeTop(IEdge),
+                          MaxLevelEdgeTop(IEdge)))
+         return;
+      RealPack LapEdgeTmp(0);
+      accumulate(LapEdgeTmp, IEdge, KChunk, Coeff, VecEdge);
+      LapEdgeTmp.addTo(Tend);
    }
 
  private:
-   Array1DI4 NEdgesOnEdge;
-   Array2DI4 EdgesOnEdge;
-   Array2DR8 WeightsOnEdge;
+   KOKKOS_FUNCTION void accumulate(RealPack &Sum, int IEdge, int KChunk,
+                                   Real Coeff,
+                                   const Array2DReal &VecEdge) const {
+      if (OpVertexDegree == 3) {
+         addEdges<3>(Sum, IEdge, KChunk, Coeff, VecEdge);
+      } else {
+         addEdges<0>(Sum, IEdge, KChunk, Coeff, VecEdge);
+      }
+   }
+
+   template <int VertexDegreeT>
+   KOKKOS_FUNCTION void addEdges(RealPack &Sum, int IEdge, int KChunk,
+                                 Real Coeff,
+                                 const Array2DReal &VecEdge) const {
+      switch (OpMaxEdges) {
+      case 6:
+         compute<6, VertexDegreeT>(Sum, IEdge, KChunk, Coeff, VecEdge);
+         break;
+      case 7:
+         compute<7, VertexDegreeT>(Sum, IEdge, KChunk, Coeff, VecEdge);
+         break;
+      case 8:
+         compute<8, VertexDegreeT>(Sum, IEdge, KChunk, Coeff, VecEdge);
+         break;
+      default:
+         compute<0, VertexDegreeT>(Sum, IEdge, KChunk, Coeff, VecEdge);
+      }
+   }
+
+   template <int MaxEdgesT, int VertexDegreeT>
+   KOKKOS_FUNCTION void compute(RealPack &Sum, int IEdge, int KChunk,
+                                Real Coeff,
+                                const Array2DReal &VecEdge) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = VecEdge.extent_int(1) - 1;
+      const int VEnd   = VertexDegreeT > 0 ? VertexDegreeT : VertexDegree;
+
+      // Differences across the edge of the divergence between its cells and
+      // of the curl between its vertices
+      RealPack DivDiff(0);
+      RealPack CurlDiff(0);
+
+      for (int JSide = 0; JSide < 2; ++JSide) {
+         const Real Side = JSide == 0 ? -1.0_Real : 1.0_Real;
+
+         const int JCell  = CellsOnEdge(IEdge, JSide);
+         const int NEdges = NEdgesOnCell(JCell);
+         const int JEnd   = MaxEdgesT > 0 ? MaxEdgesT : NEdges;
+         for (int J = 0; J < JEnd; ++J) {
+            if (J < NEdges) {
+               const int JEdge   = EdgesOnCell(JCell, J);
+               const Real Weight = Side * DivWeightsOnCell(JCell, J);
+               DivDiff -=
+                   Weight * RealPack::load(VecEdge, JEdge, KStart, KLast);
+            }
+         }
+
+         const int JVertex = VerticesOnEdge(IEdge, JSide);
+         for (int J = 0; J < VEnd; ++J) {
+            const int JEdge   = EdgesOnVertex(JVertex, J);
+            const Real Weight = Side * CurlWeightsOnVertex(JVertex, J);
+            CurlDiff += Weight * RealPack::load(VecEdge, JEdge, KStart, KLast);
+         }
+      }
+
+      const Real CoeffInvDc = Coeff * InvDcEdge(IEdge);
+      const Real CoeffInvDv = Coeff / DvEdge(IEdge);
+      Sum += CoeffInvDc * DivDiff - CoeffInvDv * CurlDiff;
+   }
+
+   I4 OpMaxEdges;
+   I4 VertexDegree;
+   I4 OpVertexDegree;
+   Array1DI4 NEdgesOnCell;
+   Array2DI4 EdgesOnCell;
+   Array2DI4 CellsOnEdge;
+   Array2DI4 VerticesOnEdge;
+   Array2DI4 EdgesOnVertex;
+   Array1DMetric InvDcEdge;
+   Array1DR8 DvEdge;
+   Array2DMetric DivWeightsOnCell;
+   Array2DMetric CurlWeightsOnVertex;
+   Array1DI4 MinLevelEdgeTop;
+   Array1DI4 MaxLevelEdgeTop;
 };
 
 } // namespace OMEGA
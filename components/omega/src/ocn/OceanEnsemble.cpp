@@ -0,0 +1,300 @@
+//===-- ocn/OceanEnsemble.cpp - ensemble of ocean states --------*- C++ -*-===//
+//
+// Each variable and time level of the ensemble is one allocation holding
+// the members one after another, each with the layout of an Array2DReal.
+// The slices of the members are unmanaged views into this storage and the
+// view of all members adds a leading member dimension with the stride of one
+// member. The time levels are advanced by rotating the vectors of levels, as
+// in OceanState.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OceanEnsemble.h"
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+
+#include <algorithm>
+
+namespace OMEGA {
+
+namespace {
+
+// Mean and standard deviation over the members of one variable, with the
+// sums accumulated in R8
+void memberStatistics(const Array2DReal &Mean, const Array2DReal &Spread,
+                      const EnsembleArray &All, I4 NElements) {
+   const I4 NMembers = All.extent_int(0);
+   const I4 NLevels  = All.extent_int(2);
+
+   parallelFor(
+       "EnsembleStatistics", {NElements, NLevels},
+       KOKKOS_LAMBDA(int I, int K) {
+          R8 Sum = 0;
+          for (int M = 0; M < NMembers; ++M)
+             Sum += All(M, I, K);
+          const R8 MeanVal = Sum / NMembers;
+          R8 SumSq         = 0;
+          for (int M = 0; M < NMembers; ++M) {
+             const R8 Diff = All(M, I, K) - MeanVal;
+             SumSq += Diff * Diff;
+          }
+          Mean(I, K)   = MeanVal;
+          Spread(I, K) = Kokkos::sqrt(SumSq / NMembers);
+       });
+}
+
+} // end anonymous namespace
+
+// Static members
+std::map<std::string, std::unique_ptr<OceanEnsemble>>
+    OceanEnsemble::AllEnsembles;
+
+//------------------------------------------------------------------------------
+// Create an ensemble and store it by name
+
+OceanEnsemble *OceanEnsemble::create(const std::string &Name, // [in] name
+                                     HorzMesh *Mesh,          // [in] mesh
+                                     Halo *MeshHalo,          // [in] halo
+                                     I4 NMembers,             // [in] members
+                                     I4 NVertLevels,          // [in] levels
+                                     I4 NTimeLevels           // [in] t levels
+) {
+
+   if (AllEnsembles.find(Name) != AllEnsembles.end()) {
+      LOG_ERROR("OceanEnsemble: attempt to create ensemble {} that already "
+                "exists",
+                Name);
+      return nullptr;
+   }
+   if (Mesh == nullptr || MeshHalo == nullptr) {
+      LOG_ERROR("OceanEnsemble: ensemble {} requires a mesh and halo", Name);
+      return nullptr;
+   }
+   if (NMembers < 1 || NTimeLevels < 1) {
+      LOG_ERROR("OceanEnsemble: ensemble {} needs at least one member and "
+                "time level, got {} and {}",
+                Name, NMembers, NTimeLevels);
+      return nullptr;
+   }
+
+   std::unique_ptr<OceanEnsemble> NewEnsemble(new OceanEnsemble(
+       Name, Mesh, MeshHalo, NMembers, NVertLevels, NTimeLevels));
+
+   OceanEnsemble *Ensemble = NewEnsemble.get();
+   AllEnsembles.emplace(Name, std::move(NewEnsemble));
+   return Ensemble;
+
+} // end create
+
+//------------------------------------------------------------------------------
+// Construct an ensemble and allocate all time levels
+
+OceanEnsemble::OceanEnsemble(const std::string &InName, HorzMesh *InMesh,
+                             Halo *InHalo, I4 InNMembers, I4 InNVertLevels,
+                             I4 InNTimeLevels)
+    : NCellsOwned(InMesh->NCellsOwned), NCellsSize(InMesh->NCellsSize),
+      NEdgesOwned(InMesh->NEdgesOwned), NEdgesSize(InMesh->NEdgesSize),
+      NVertLevels(InNVertLevels), Name(InName), MeshHalo(InHalo),
+      NMembers(InNMembers), NTimeLevels(InNTimeLevels) {
+
+   MemoryScope Scope("OceanEnsemble");
+
+   for (int Level = 0; Level < NTimeLevels; ++Level) {
+      const std::string Suffix = Name + std::to_string(Level);
+      LayerThickness.push_back(allocateLevel("LayerThickness" + Suffix,
+                                             NMembers, NCellsSize,
+                                             NVertLevels));
+      NormalVelocity.push_back(allocateLevel("NormalVelocity" + Suffix,
+                                             NMembers, NEdgesSize,
+                                             NVertLevels));
+   }
+
+} // end constructor
+
+//------------------------------------------------------------------------------
+// Allocate one time level of a variable for all members
+
+OceanEnsemble::EnsembleLevel
+OceanEnsemble::allocateLevel(const std::string &Label, // [in] array label
+                             I4 NMembers,              // [in] members
+                             I4 NElements,             // [in] elements
+                             I4 NVertLevels            // [in] vert levels
+) {
+
+   const I8 MemberSize = static_cast<I8>(NElements) * NVertLevels;
+
+   EnsembleLevel Level;
+   Level.Storage = Array1DReal(Label, NMembers * MemberSize);
+   for (int Member = 0; Member < NMembers; ++Member)
+      Level.Members.emplace_back(Level.Storage.data() + Member * MemberSize,
+                                 NElements, NVertLevels);
+
+   // The element and level strides are those of the member slices
+   const Array2DReal &First = Level.Members[0];
+   Kokkos::LayoutStride Layout(NMembers, MemberSize, NElements, First.stride(0),
+                               NVertLevels, First.stride(1));
+   Level.All = EnsembleArray(Level.Storage.data(), Layout);
+
+   return Level;
+
+} // end allocateLevel
+
+//------------------------------------------------------------------------------
+// Retrieve, remove and clear ensembles
+
+OceanEnsemble *OceanEnsemble::get(const std::string &Name // [in] name
+) {
+   auto It = AllEnsembles.find(Name);
+   if (It == AllEnsembles.end()) {
+      LOG_ERROR("OceanEnsemble: attempt to retrieve non-existent ensemble {}",
+                Name);
+      return nullptr;
+   }
+   return It->second.get();
+}
+
+void OceanEnsemble::erase(const std::string &Name // [in] name
+) {
+   AllEnsembles.erase(Name);
+}
+
+void OceanEnsemble::clear() { AllEnsembles.clear(); }
+
+//------------------------------------------------------------------------------
+// Check the time level and member arguments
+
+bool OceanEnsemble::validTimeLevel(I4 TimeLevel) const {
+   if (TimeLevel < 0 || TimeLevel >= NTimeLevels) {
+      LOG_ERROR("OceanEnsemble: time level {} out of range for ensemble {}",
+                TimeLevel, Name);
+      return false;
+   }
+   return true;
+}
+
+bool OceanEnsemble::validMember(I4 Member) const {
+   if (Member < 0 || Member >= NMembers) {
+      LOG_ERROR("OceanEnsemble: member {} out of range for ensemble {}",
+                Member, Name);
+      return false;
+   }
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Retrieve the state variables of all members at a time level
+
+int OceanEnsemble::getLayerThickness(EnsembleArray &LayerThick, // [out] h
+                                     I4 TimeLevel // [in] time level
+) const {
+   if (!validTimeLevel(TimeLevel))
+      return 1;
+   LayerThick = LayerThickness[TimeLevel].All;
+   return 0;
+}
+
+int OceanEnsemble::getNormalVelocity(EnsembleArray &NormVel, // [out] u
+                                     I4 TimeLevel // [in] time level
+) const {
+   if (!validTimeLevel(TimeLevel))
+      return 1;
+   NormVel = NormalVelocity[TimeLevel].All;
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Retrieve the state variables of one member at a time level
+
+int OceanEnsemble::getMemberLayerThickness(Array2DReal &LayerThick, // [out]
+                                           I4 Member,   // [in] member
+                                           I4 TimeLevel // [in] time level
+) const {
+   if (!validTimeLevel(TimeLevel) || !validMember(Member))
+      return 1;
+   LayerThick = LayerThickness[TimeLevel].Members[Member];
+   return 0;
+}
+
+int OceanEnsemble::getMemberNormalVelocity(Array2DReal &NormVel, // [out]
+                                           I4 Member,   // [in] member
+                                           I4 TimeLevel // [in] time level
+) const {
+   if (!validTimeLevel(TimeLevel) || !validMember(Member))
+      return 1;
+   NormVel = NormalVelocity[TimeLevel].Members[Member];
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Exchange the halos of all members at a time level in one message per
+// neighbor
+
+int OceanEnsemble::exchangeHalo(I4 TimeLevel // [in] time level
+) {
+
+   if (!validTimeLevel(TimeLevel))
+      return 1;
+
+   HaloGroup Group("OceanEnsemble" + Name);
+   int Err = 0;
+   for (int Member = 0; Member < NMembers; ++Member) {
+      Err += Group.add(LayerThickness[TimeLevel].Members[Member], OnCell);
+      Err += Group.add(NormalVelocity[TimeLevel].Members[Member], OnEdge);
+   }
+   Err += MeshHalo->exchangeGroup(Group);
+   if (Err != 0)
+      LOG_ERROR("OceanEnsemble: error exchanging halos of ensemble {}", Name);
+
+   return Err;
+
+} // end exchangeHalo
+
+//------------------------------------------------------------------------------
+// Advance the time levels by swapping the array handles
+
+int OceanEnsemble::updateTimeLevels() {
+
+   if (NTimeLevels < 2)
+      return 0;
+
+   int Err = exchangeHalo(1);
+
+   std::rotate(LayerThickness.begin(), LayerThickness.begin() + 1,
+               LayerThickness.end());
+   std::rotate(NormalVelocity.begin(), NormalVelocity.begin() + 1,
+               NormalVelocity.end());
+
+   return Err;
+
+} // end updateTimeLevels
+
+//------------------------------------------------------------------------------
+// Ensemble mean and standard deviation of the state at a time level
+
+int OceanEnsemble::computeStatistics(
+    const Array2DReal &MeanThick,   // [out] mean thickness
+    const Array2DReal &SpreadThick, // [out] thickness standard deviation
+    const Array2DReal &MeanVel,     // [out] mean velocity
+    const Array2DReal &SpreadVel,   // [out] velocity standard deviation
+    I4 TimeLevel                    // [in] time level
+) const {
+
+   if (!validTimeLevel(TimeLevel))
+      return 1;
+
+   memberStatistics(MeanThick, SpreadThick, LayerThickness[TimeLevel].All,
+                    NCellsOwned);
+   memberStatistics(MeanVel, SpreadVel, NormalVelocity[TimeLevel].All,
+                    NEdgesOwned);
+
+   return 0;
+
+} // end computeStatistics
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,162 @@
+#ifndef OMEGA_OCEANENSEMBLE_H
+#define OMEGA_OCEANENSEMBLE_H
+//===-- ocn/OceanEnsemble.h - ensemble of ocean states ----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines an ensemble of ocean states on a shared mesh
+///
+/// The OceanEnsemble class holds the prognostic layer thickness and normal
+/// velocity of several ensemble members that share one mesh, decomposition
+/// and halo, for runs of many small members in one process. Each variable
+/// and time level is a single allocation with a leading member dimension,
+/// so kernels can iterate over all members in one launch. The slice of one
+/// member is an ordinary Array2DReal, so a member can also be used wherever
+/// the state of a single run is expected, eg. by a time stepper.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Array of all members of an ensemble variable, indexed by member, element
+/// and level. The element and level strides are those of Array2DReal.
+using EnsembleArray = Kokkos::View<Real ***, Kokkos::LayoutStride, MemSpace>;
+
+/// The OceanEnsemble class holds the prognostic variables of all members
+/// for all time levels. Ensembles are created with create and retrieved by
+/// name, like other Omega objects. Time level 0 is the current time and 1
+/// the next time.
+class OceanEnsemble {
+
+ public:
+   /// Creates an ensemble and stores it under Name. Returns a pointer to
+   /// the new ensemble, or nullptr on error.
+   static OceanEnsemble *
+   create(const std::string &Name, ///< [in] name of the ensemble
+          HorzMesh *Mesh,          ///< [in] mesh shared by the members
+          Halo *MeshHalo,          ///< [in] halo for the mesh
+          I4 NMembers,             ///< [in] number of members
+          I4 NVertLevels,          ///< [in] number of vertical levels
+          I4 NTimeLevels           ///< [in] number of time levels
+   );
+
+   /// Returns the ensemble Name, or nullptr if it does not exist
+   static OceanEnsemble *get(const std::string &Name ///< [in] ensemble name
+   );
+
+   /// Removes the ensemble Name
+   static void erase(const std::string &Name ///< [in] ensemble name
+   );
+
+   /// Removes all ensembles
+   static void clear();
+
+   /// Retrieves the layer thickness of all members at a time level.
+   /// Returns an error code.
+   int getLayerThickness(EnsembleArray &LayerThick, ///< [out] thickness
+                         I4 TimeLevel = 0           ///< [in] time level
+   ) const;
+
+   /// Retrieves the normal velocity of all members at a time level.
+   /// Returns an error code.
+   int getNormalVelocity(EnsembleArray &NormVel, ///< [out] normal velocity
+                         I4 TimeLevel = 0        ///< [in] time level
+   ) const;
+
+   /// Retrieves the layer thickness of one member at a time level. The
+   /// array shares the storage of the ensemble. Returns an error code.
+   int getMemberLayerThickness(Array2DReal &LayerThick, ///< [out] thickness
+                               I4 Member,               ///< [in] member
+                               I4 TimeLevel = 0         ///< [in] time level
+   ) const;
+
+   /// Retrieves the normal velocity of one member at a time level. The
+   /// array shares the storage of the ensemble. Returns an error code.
+   int getMemberNormalVelocity(Array2DReal &NormVel, ///< [out] velocity
+                               I4 Member,            ///< [in] member
+                               I4 TimeLevel = 0      ///< [in] time level
+   ) const;
+
+   /// Exchanges the halos of the layer thickness and normal velocity of all
+   /// members at a time level in one message per neighbor. Returns an error
+   /// code.
+   int exchangeHalo(I4 TimeLevel = 0 ///< [in] time level
+   );
+
+   /// Exchanges the halos of the next time level, then advances the time
+   /// levels of all members by one. Only the array handles are swapped.
+   /// Returns an error code.
+   int updateTimeLevels();
+
+   /// Computes the ensemble mean and standard deviation of the layer
+   /// thickness and normal velocity at a time level on the owned elements,
+   /// with one kernel per variable over the elements, levels and members.
+   /// Returns an error code.
+   int computeStatistics(const Array2DReal &MeanThick,   ///< [out] mean h
+                         const Array2DReal &SpreadThick, ///< [out] std dev h
+                         const Array2DReal &MeanVel,     ///< [out] mean u
+                         const Array2DReal &SpreadVel,   ///< [out] std dev u
+                         I4 TimeLevel = 0                ///< [in] time level
+   ) const;
+
+   /// Returns the number of members
+   I4 getNumMembers() const { return NMembers; }
+
+   /// Returns the number of time levels
+   I4 getNumTimeLevels() const { return NTimeLevels; }
+
+   /// Returns the name of this ensemble
+   const std::string &getName() const { return Name; }
+
+   I4 NCellsOwned; ///< number of cells owned by this task
+   I4 NCellsSize;  ///< array length in cells
+   I4 NEdgesOwned; ///< number of edges owned by this task
+   I4 NEdgesSize;  ///< array length in edges
+   I4 NVertLevels; ///< number of vertical levels
+
+ private:
+   OceanEnsemble(const std::string &InName, HorzMesh *InMesh, Halo *InHalo,
+                 I4 InNMembers, I4 InNVertLevels, I4 InNTimeLevels);
+
+   /// One time level of a variable: the storage of all members, the view
+   /// of all members and the slice of each member
+   struct EnsembleLevel {
+      Array1DReal Storage;
+      EnsembleArray All;
+      std::vector<Array2DReal> Members;
+   };
+
+   /// Allocates one time level of a variable with NElements elements
+   static EnsembleLevel allocateLevel(const std::string &Label,
+                                      I4 NMembers, I4 NElements,
+                                      I4 NVertLevels);
+
+   /// Checks that a time level and member are in range
+   bool validTimeLevel(I4 TimeLevel) const;
+   bool validMember(I4 Member) const;
+
+   std::string Name; ///< name of this ensemble
+   Halo *MeshHalo;   ///< halo used to update the members
+   I4 NMembers;      ///< number of members
+   I4 NTimeLevels;   ///< number of time levels
+
+   /// Prognostic variables for each time level
+   std::vector<EnsembleLevel> LayerThickness;
+   std::vector<EnsembleLevel> NormalVelocity;
+
+   static std::map<std::string, std::unique_ptr<OceanEnsemble>> AllEnsembles;
+
+}; // end class OceanEnsemble
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_OCEANENSEMBLE_H
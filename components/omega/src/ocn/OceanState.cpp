@@ -0,0 +1,243 @@
+//===-- ocn/OceanState.cpp - ocean prognostic state -------------*- C++ -*-===//
+//
+// The time levels of each variable are kept in a vector of arrays and the
+// time levels are advanced by rotating the vectors. The IO fields always
+// refer to the current time level, so they are re-attached by handle after
+// each rotation. Halo exchanges use a persistent pattern named after the state.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OceanState.h"
+#include "DataTypes.h"
+#include "FieldDefs.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+
+namespace OMEGA {
+
+// Static members
+OceanState *OceanState::DefaultOceanState = nullptr;
+std::map<std::string, std::unique_ptr<OceanState>> OceanState::AllOceanStates;
+
+//------------------------------------------------------------------------------
+// Create the default state
+
+int OceanState::init(I4 NVertLevels, // [in] number of vertical levels
+                     I4 NTimeLevels  // [in] number of time levels
+) {
+
+   DefaultOceanState = create("Default", HorzMesh::getDefault(),
+                              Halo::getDefault(), NVertLevels, NTimeLevels);
+   if (DefaultOceanState == nullptr) {
+      LOG_ERROR("OceanState: error creating default state");
+      return 1;
+   }
+
+   return 0;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Create a state and store it by name
+
+OceanState *OceanState::create(const std::string &Name, // [in] name
+                               HorzMesh *Mesh,          // [in] mesh
+                               Halo *MeshHalo,          // [in] halo
+                               I4 NVertLevels,          // [in] vert levels
+                               I4 NTimeLevels           // [in] time levels
+) {
+
+   if (AllOceanStates.find(Name) != AllOceanStates.end()) {
+      LOG_ERROR("OceanState: attempt to create state {} that already exists",
+                Name);
+      return nullptr;
+   }
+   if (Mesh == nullptr || MeshHalo == nullptr) {
+      LOG_ERROR("OceanState: state {} requires a mesh and halo", Name);
+      return nullptr;
+   }
+   if (NTimeLevels < 1) {
+      LOG_ERROR("OceanState: state {} needs at least one time level, got {}",
+                Name, NTimeLevels);
+      return nullptr;
+   }
+
+   std::unique_ptr<OceanState> NewState(
+       new OceanState(Name, Mesh, MeshHalo, NVertLevels, NTimeLevels));
+   if (NewState->defineIOFields() != 0) {
+      LOG_ERROR("OceanState: error registering IO fields of state {}", Name);
+      return nullptr;
+   }
+
+   OceanState *State = NewState.get();
+   AllOceanStates.emplace(Name, std::move(NewState));
+   return State;
+
+} // end create
+
+//------------------------------------------------------------------------------
+// Construct a state and allocate all time levels
+
+OceanState::OceanState(const std::string &InName, HorzMesh *InMesh,
+                       Halo *InHalo, I4 InNVertLevels, I4 InNTimeLevels)
+    : NCellsOwned(InMesh->NCellsOwned), NCellsAll(InMesh->NCellsAll),
+      NCellsSize(InMesh->NCellsSize), NEdgesOwned(InMesh->NEdgesOwned),
+      NEdgesAll(InMesh->NEdgesAll), NEdgesSize(InMesh->NEdgesSize),
+      NVertLevels(InNVertLevels), Name(InName), MeshHalo(InHalo),
+      NTimeLevels(InNTimeLevels) {
+
+   MemoryScope Scope("OceanState");
+
+   for (int Level = 0; Level < NTimeLevels; ++Level) {
+      const std::string Suffix = Name + std::to_string(Level);
+      LayerThickness.emplace_back("LayerThickness" + Suffix, NCellsSize,
+                                  NVertLevels);
+      NormalVelocity.emplace_back("NormalVelocity" + Suffix, NEdgesSize,
+                                  NVertLevels);
+   }
+
+   FieldSuffix = Name == "Default" ? "" : Name;
+
+} // end constructor
+
+//------------------------------------------------------------------------------
+// Remove the IO fields of a state when it is destroyed
+
+OceanState::~OceanState() {
+
+   eraseField(FieldId::LayerThickness, FieldSuffix);
+   eraseField(FieldId::NormalVelocity, FieldSuffix);
+
+} // end destructor
+
+//------------------------------------------------------------------------------
+// Retrieve, remove and clear states
+
+OceanState *OceanState::getDefault() { return DefaultOceanState; }
+
+OceanState *OceanState::get(const std::string &Name // [in] state name
+) {
+   auto It = AllOceanStates.find(Name);
+   if (It == AllOceanStates.end()) {
+      LOG_ERROR("OceanState: attempt to retrieve non-existent state {}", Name);
+      return nullptr;
+   }
+   return It->second.get();
+}
+
+void OceanState::erase(const std::string &Name // [in] state name
+) {
+   if (DefaultOceanState != nullptr && DefaultOceanState->Name == Name)
+      DefaultOceanState = nullptr;
+   AllOceanStates.erase(Name);
+}
+
+void OceanState::clear() {
+   DefaultOceanState = nullptr;
+   AllOceanStates.clear();
+}
+
+//------------------------------------------------------------------------------
+// Define the metadata and IO fields of the state variables
+
+int OceanState::defineIOFields() {
+
+   int Err = 0;
+   Err += defineField(FieldId::LayerThickness, FieldSuffix, LayerThickness[0],
+                      ThickHandle);
+   Err += defineField(FieldId::NormalVelocity, FieldSuffix, NormalVelocity[0],
+                      VelHandle);
+   return Err;
+
+} // end defineIOFields
+
+//------------------------------------------------------------------------------
+// Attach the current time level to the IO fields
+
+int OceanState::attachIOData() {
+
+   int Err = 0;
+   Err += IOField::attachData<Array2DReal>(ThickHandle, LayerThickness[0]);
+   Err += IOField::attachData<Array2DReal>(VelHandle, NormalVelocity[0]);
+   return Err;
+
+} // end attachIOData
+
+//------------------------------------------------------------------------------
+// Retrieve the state variables at a time level
+
+bool OceanState::validTimeLevel(I4 TimeLevel) const {
+   if (TimeLevel < 0 || TimeLevel >= NTimeLevels) {
+      LOG_ERROR("OceanState: time level {} out of range for state {}",
+                TimeLevel, Name);
+      return false;
+   }
+   return true;
+}
+
+int OceanState::getLayerThickness(Array2DReal &LayerThick, // [out] thickness
+                                  I4 TimeLevel             // [in] time level
+) const {
+   if (!validTimeLevel(TimeLevel))
+      return 1;
+   LayerThick = LayerThickness[TimeLevel];
+   return 0;
+}
+
+int OceanState::getNormalVelocity(Array2DReal &NormVel, // [out] velocity
+                                  I4 TimeLevel          // [in] time level
+) const {
+   if (!validTimeLevel(TimeLevel))
+      return 1;
+   NormVel = NormalVelocity[TimeLevel];
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Exchange the halos of a time level in one message per neighbor
+
+int OceanState::exchangeHalo(I4 TimeLevel // [in] time level
+) {
+
+   if (!validTimeLevel(TimeLevel))
+      return 1;
+
+   HaloGroup Group("OceanState" + Name);
+   int Err = Group.add(LayerThickness[TimeLevel], OnCell);
+   Err += Group.add(NormalVelocity[TimeLevel], OnEdge);
+   Err += MeshHalo->exchangeGroup(Group);
+   if (Err != 0)
+      LOG_ERROR("OceanState: error exchanging halos of state {}", Name);
+
+   return Err;
+
+} // end exchangeHalo
+
+//------------------------------------------------------------------------------
+// Advance the time levels by swapping the array handles
+
+int OceanState::updateTimeLevels() {
+
+   if (NTimeLevels < 2)
+      return 0;
+
+   int Err = exchangeHalo(1);
+
+   std::rotate(LayerThickness.begin(), LayerThickness.begin() + 1,
+               LayerThickness.end());
+   std::rotate(NormalVelocity.begin(), NormalVelocity.begin() + 1,
+               NormalVelocity.end());
+   Err += attachIOData();
+
+   return Err;
+
+} // end updateTimeLevels
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
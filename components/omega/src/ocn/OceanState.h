@@ -0,0 +1,134 @@
+#ifndef OMEGA_OCEANSTATE_H
+#define OMEGA_OCEANSTATE_H
+//===-- ocn/OceanState.h - ocean prognostic state ---------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the ocean prognostic state
+///
+/// The OceanState class holds the prognostic layer thickness and normal
+/// velocity on device for a number of time levels. Each time level is a
+/// separate array, so advancing the time levels at the end of a step only
+/// swaps the array handles rather than copying the state. At creation, a
+/// state registers its current time level with IOField and a persistent
+/// halo exchange pattern for its arrays.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// The OceanState class holds the prognostic variables for all time levels.
+/// States are created with create and retrieved by name, like other Omega
+/// objects. Time level 0 is the current time and 1 the next time.
+class OceanState {
+
+ public:
+   ~OceanState();
+
+   /// Creates the default state on the default mesh and halo. Returns an
+   /// error code.
+   static int init(I4 NVertLevels,    ///< [in] number of vertical levels
+                   I4 NTimeLevels = 2 ///< [in] number of time levels
+   );
+
+   /// Creates a state and stores it under Name. The IO fields of the
+   /// default state are named LayerThickness and NormalVelocity, those of
+   /// other states have the state name appended. Returns a pointer to the
+   /// new state, or nullptr on error.
+   static OceanState *
+   create(const std::string &Name, ///< [in] name of the state
+          HorzMesh *Mesh,          ///< [in] mesh
+          Halo *MeshHalo,          ///< [in] halo for the mesh
+          I4 NVertLevels,          ///< [in] number of vertical levels
+          I4 NTimeLevels           ///< [in] number of time levels
+   );
+
+   /// Returns the default state
+   static OceanState *getDefault();
+
+   /// Returns the state Name, or nullptr if it does not exist
+   static OceanState *get(const std::string &Name ///< [in] state name
+   );
+
+   /// Removes the state Name
+   static void erase(const std::string &Name ///< [in] state name
+   );
+
+   /// Removes all states
+   static void clear();
+
+   /// Retrieves the layer thickness at a time level. Returns an error code.
+   int getLayerThickness(Array2DReal &LayerThick, ///< [out] layer thickness
+                         I4 TimeLevel = 0         ///< [in] time level
+   ) const;
+
+   /// Retrieves the normal velocity at a time level. Returns an error code.
+   int getNormalVelocity(Array2DReal &NormVel, ///< [out] normal velocity
+                         I4 TimeLevel = 0      ///< [in] time level
+   ) const;
+
+   /// Exchanges the halos of the layer thickness and normal velocity at a
+   /// time level in one message per neighbor. Returns an error code.
+   int exchangeHalo(I4 TimeLevel = 0 ///< [in] time level
+   );
+
+   /// Exchanges the halos of the next time level, then advances the time
+   /// levels by one so that it becomes the current time level. Only the
+   /// array handles are swapped. Returns an error code.
+   int updateTimeLevels();
+
+   /// Returns the number of time levels
+   I4 getNumTimeLevels() const { return NTimeLevels; }
+
+   /// Returns the name of this state
+   const std::string &getName() const { return Name; }
+
+   I4 NCellsOwned; ///< number of cells owned by this task
+   I4 NCellsAll;   ///< number of owned and halo cells
+   I4 NCellsSize;  ///< array length in cells
+   I4 NEdgesOwned; ///< number of edges owned by this task
+   I4 NEdgesAll;   ///< number of owned and halo edges
+   I4 NEdgesSize;  ///< array length in edges
+   I4 NVertLevels; ///< number of vertical levels
+
+ private:
+   OceanState(const std::string &InName, HorzMesh *InMesh, Halo *InHalo,
+              I4 InNVertLevels, I4 InNTimeLevels);
+
+   /// Defines the metadata and IO fields of the state
+   int defineIOFields();
+
+   /// Attaches the current time level to the IO fields
+   int attachIOData();
+
+   /// Checks that a time level is in range
+   bool validTimeLevel(I4 TimeLevel) const;
+
+   std::string Name;           ///< name of this state
+   Halo *MeshHalo;             ///< halo used to update the state
+   I4 NTimeLevels;             ///< number of time levels
+   std::string FieldSuffix;    ///< suffix of the IO field names
+   I4 ThickHandle = -1;        ///< IO field handle of the layer thickness
+   I4 VelHandle   = -1;        ///< IO field handle of the normal velocity
+
+   /// Prognostic variables for each time level
+   std::vector<Array2DReal> LayerThickness;
+   std::vector<Array2DReal> NormalVelocity;
+
+   static OceanState *DefaultOceanState;
+   static std::map<std::string, std::unique_ptr<OceanState>> AllOceanStates;
+
+}; // end class OceanState
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_OCEANSTATE_H
@@ -0,0 +1,566 @@
+//===-- ocn/Particles.cpp - Lagrangian particles ----------------*- C++ -*-===//
+//
+// The particles of a task are compacted after each step: the particles that
+// stay are copied in order to the front of a second set of arrays, which are
+// then swapped with the public arrays, and the particles that left are packed
+// in the same scan into one send buffer, grouped by the neighbor that owns
+// their new cell. The counts are exchanged first so that each task posts
+// exactly sized receives, and the packed particles are then exchanged with
+// one message per neighbor, from device buffers if MPI is GPU-aware.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Particles.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "Logging.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+#include "Reductions.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace OMEGA {
+
+namespace {
+
+// Values packed for each migrating particle: position, level, id and the
+// index of its cell on the receiving task
+constexpr int NFields = 6;
+
+// MPI tags of the migration messages
+constexpr int CountTag    = 201;
+constexpr int ParticleTag = 202;
+
+// Max number of cells crossed by a walk
+constexpr int MaxWalkSteps = 64;
+
+KOKKOS_INLINE_FUNCTION R8 dist2(const R8 (&X)[3], const Array2DR8 &Coord,
+                                int I) {
+   const R8 D0 = X[0] - Coord(I, 0);
+   const R8 D1 = X[1] - Coord(I, 1);
+   const R8 D2 = X[2] - Coord(I, 2);
+   return D0 * D0 + D1 * D1 + D2 * D2;
+}
+
+// Moves X radially back to the sphere of the given radius
+KOKKOS_INLINE_FUNCTION void toSphere(R8 (&X)[3], R8 Radius) {
+   const R8 Scale =
+       Radius / Kokkos::sqrt(X[0] * X[0] + X[1] * X[1] + X[2] * X[2]);
+   for (int D = 0; D < 3; ++D)
+      X[D] *= Scale;
+}
+
+// Mesh data needed to move particles on the device
+class ParticleMesh {
+ public:
+   I4 NCellsAll;
+   Array1DI4 NEdgesOnCell;
+   Array2DI4 EdgesOnCell;
+   Array2DI4 CellsOnCell;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+   Array2DR8 CellCoord;
+   Array2DR8 EdgeCoord;
+   Array2DR8 EdgeNormal;
+   Array2DR8 EdgeTangent;
+
+   // Walks from ICell to the cell with the closest center to X among the
+   // local cells active at level K
+   KOKKOS_FUNCTION int walk(int ICell, int K, const R8 (&X)[3]) const {
+      for (int Step = 0; Step < MaxWalkSteps; ++Step) {
+         int Next   = ICell;
+         R8 DistMin = dist2(X, CellCoord, ICell);
+         for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+            const int JCell = CellsOnCell(ICell, J);
+            if (JCell < NCellsAll && K >= MinLevelCell(JCell) &&
+                K <= MaxLevelCell(JCell)) {
+               const R8 Dist = dist2(X, CellCoord, JCell);
+               if (Dist < DistMin) {
+                  DistMin = Dist;
+                  Next    = JCell;
+               }
+            }
+         }
+         if (Next == ICell)
+            break;
+         ICell = Next;
+      }
+      return ICell;
+   }
+
+   // Interpolates the velocity at X in cell ICell and level K from the
+   // velocity vectors on the edges of the cell, weighted by the inverse
+   // square distance to the edge midpoints, regularized by 1 m^2, and
+   // removes its radial part
+   KOKKOS_FUNCTION void velocity(R8 (&V)[3], const R8 (&X)[3], int ICell,
+                                 int K, const Array2DReal &NormalVel,
+                                 const Array2DReal &TangVel) const {
+      R8 WeightSum = 0;
+      V[0] = V[1] = V[2] = 0;
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const int JEdge = EdgesOnCell(ICell, J);
+         const R8 Weight = 1 / (dist2(X, EdgeCoord, JEdge) + 1);
+         const R8 Un     = NormalVel(JEdge, K);
+         const R8 Ut     = TangVel(JEdge, K);
+         for (int D = 0; D < 3; ++D)
+            V[D] += Weight * (Un * EdgeNormal(JEdge, D) +
+                              Ut * EdgeTangent(JEdge, D));
+         WeightSum += Weight;
+      }
+      const R8 R2     = X[0] * X[0] + X[1] * X[1] + X[2] * X[2];
+      const R8 Radial = (V[0] * X[0] + V[1] * X[1] + V[2] * X[2]) / R2;
+      for (int D = 0; D < 3; ++D)
+         V[D] = (V[D] - Radial * X[D]) / WeightSum;
+   }
+};
+
+// Collects the mesh data needed by the particle kernels
+ParticleMesh makeParticleMesh(const HorzMesh *Mesh,
+                              const Array2DR8 &CellCoord,
+                              const Array2DR8 &EdgeCoord,
+                              const Array2DR8 &EdgeNormal,
+                              const Array2DR8 &EdgeTangent) {
+   return ParticleMesh{Mesh->NCellsAll,    Mesh->NEdgesOnCell,
+                       Mesh->EdgesOnCell,  Mesh->CellsOnCell,
+                       Mesh->MinLevelCell, Mesh->MaxLevelCell,
+                       CellCoord,          EdgeCoord,
+                       EdgeNormal,         EdgeTangent};
+}
+
+// Walks the particles First to Last-1 from their current cell to the cell
+// containing them
+void locateParticles(const ParticleMesh &PMesh, const Array2DR8 &Position,
+                     const Array1DI4 &CellIndx, const Array1DI4 &Level,
+                     I4 First, I4 Last) {
+
+   if (Last <= First)
+      return;
+
+   parallelFor(
+       "Particles:locate", {Last - First}, KOKKOS_LAMBDA(int IOff) {
+          const int I   = First + IOff;
+          const R8 X[3] = {Position(I, 0), Position(I, 1), Position(I, 2)};
+          CellIndx(I)   = PMesh.walk(CellIndx(I), Level(I), X);
+       });
+
+} // end locateParticles
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+
+Particles::Particles(const std::string &InName, // [in] name of the particles
+                     HorzMesh *InMesh,          // [in] mesh
+                     const Decomp *MeshDecomp,  // [in] decomposition of mesh
+                     const Halo *InHalo,        // [in] halo of the mesh
+                     I4 InNVertLevels,          // [in] number of levels
+                     I4 InCapacity              // [in] max particles
+                     )
+    : Name(InName), Mesh(InMesh), MeshHalo(InHalo), NVertLevels(InNVertLevels),
+      NChunks(numVertChunks(InNVertLevels)), Capacity(InCapacity),
+      TangRecon(InMesh), NeighborTasks(InHalo->getNeighborTasks()) {
+
+   MemoryScope Scope("Particles");
+
+   Position    = Array2DR8("ParticlePosition" + Name, Capacity, 3);
+   CellIndx    = Array1DI4("ParticleCell" + Name, Capacity);
+   Level       = Array1DI4("ParticleLevel" + Name, Capacity);
+   Id          = Array1DI8("ParticleId" + Name, Capacity);
+   NewPosition = Array2DR8("ParticleNewPosition" + Name, Capacity, 3);
+   NewCellIndx = Array1DI4("ParticleNewCell" + Name, Capacity);
+   NewLevel    = Array1DI4("ParticleNewLevel" + Name, Capacity);
+   NewId       = Array1DI8("ParticleNewId" + Name, Capacity);
+
+   const I4 NNghbr = NeighborTasks.size();
+   SendCount       = Array1DI4("ParticleSendCount" + Name, NNghbr);
+   SendFill        = Array1DI4("ParticleSendFill" + Name, NNghbr);
+   SendOffset      = Array1DI4("ParticleSendOffset" + Name, NNghbr);
+
+   TangVel = Array2DReal("ParticleTangVel" + Name, Mesh->NEdgesSize,
+                         NVertLevels);
+
+   // Positions of the cell centers and edge midpoints, and the unit normal
+   // and tangent vectors of the edges. The normal points from the first to
+   // the second cell of the edge and the tangent is k x n, as for the
+   // normal and tangential velocities. If a cell of a halo edge is not
+   // local, the normal is taken between the edge and the local cell.
+   InMesh->loadCoordinates();
+
+   const I4 NCellsAll = Mesh->NCellsAll;
+   HostArray2DR8 CellCoordH("CellCoordH", Mesh->NCellsSize, 3);
+   for (int ICell = 0; ICell < NCellsAll; ++ICell) {
+      CellCoordH(ICell, 0) = Mesh->XCellH(ICell);
+      CellCoordH(ICell, 1) = Mesh->YCellH(ICell);
+      CellCoordH(ICell, 2) = Mesh->ZCellH(ICell);
+   }
+
+   HostArray2DR8 EdgeCoordH("EdgeCoordH", Mesh->NEdgesSize, 3);
+   HostArray2DR8 EdgeNormalH("EdgeNormalH", Mesh->NEdgesSize, 3);
+   HostArray2DR8 EdgeTangentH("EdgeTangentH", Mesh->NEdgesSize, 3);
+   const HostArray2DI4 CellsOnEdgeH = Mesh->getHost(Mesh->CellsOnEdgeH);
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge) {
+      const R8 XE[3] = {Mesh->XEdgeH(IEdge), Mesh->YEdgeH(IEdge),
+                        Mesh->ZEdgeH(IEdge)};
+      const int Cell0 = CellsOnEdgeH(IEdge, 0);
+      const int Cell1 = CellsOnEdgeH(IEdge, 1);
+
+      R8 Normal[3];
+      for (int D = 0; D < 3; ++D) {
+         const R8 X0 = Cell0 < NCellsAll ? CellCoordH(Cell0, D) : XE[D];
+         const R8 X1 = Cell1 < NCellsAll ? CellCoordH(Cell1, D) : XE[D];
+         Normal[D]   = X1 - X0;
+      }
+
+      const R8 REdge = std::sqrt(XE[0] * XE[0] + XE[1] * XE[1] +
+                                 XE[2] * XE[2]);
+      const R8 K[3]  = {XE[0] / REdge, XE[1] / REdge, XE[2] / REdge};
+      const R8 NDotK = Normal[0] * K[0] + Normal[1] * K[1] + Normal[2] * K[2];
+      for (int D = 0; D < 3; ++D)
+         Normal[D] -= NDotK * K[D];
+      const R8 NLen = std::sqrt(Normal[0] * Normal[0] +
+                                Normal[1] * Normal[1] +
+                                Normal[2] * Normal[2]);
+      for (int D = 0; D < 3; ++D) {
+         EdgeCoordH(IEdge, D)  = XE[D];
+         EdgeNormalH(IEdge, D) = Normal[D] / NLen;
+      }
+      EdgeTangentH(IEdge, 0) =
+          K[1] * EdgeNormalH(IEdge, 2) - K[2] * EdgeNormalH(IEdge, 1);
+      EdgeTangentH(IEdge, 1) =
+          K[2] * EdgeNormalH(IEdge, 0) - K[0] * EdgeNormalH(IEdge, 2);
+      EdgeTangentH(IEdge, 2) =
+          K[0] * EdgeNormalH(IEdge, 1) - K[1] * EdgeNormalH(IEdge, 0);
+   }
+
+   CellCoord   = createDeviceMirrorCopy(CellCoordH);
+   EdgeCoord   = createDeviceMirrorCopy(EdgeCoordH);
+   EdgeNormal  = createDeviceMirrorCopy(EdgeNormalH);
+   EdgeTangent = createDeviceMirrorCopy(EdgeTangentH);
+
+   // For each halo cell, the neighbor that owns it and its index there
+   HostArray1DI4 NeighborOfCellH("NeighborOfCellH", Mesh->NCellsSize);
+   HostArray1DI4 RemoteCellH("RemoteCellH", Mesh->NCellsSize);
+   for (int ICell = 0; ICell < Mesh->NCellsSize; ++ICell) {
+      NeighborOfCellH(ICell) = -1;
+      RemoteCellH(ICell)     = -1;
+   }
+   const HostArray2DI4 CellLocH = MeshDecomp->getHost(MeshDecomp->CellLocH);
+   for (int ICell = Mesh->NCellsOwned; ICell < NCellsAll; ++ICell) {
+      const I4 Task = CellLocH(ICell, 0);
+      auto It =
+          std::lower_bound(NeighborTasks.begin(), NeighborTasks.end(), Task);
+      NeighborOfCellH(ICell) = It - NeighborTasks.begin();
+      RemoteCellH(ICell)     = CellLocH(ICell, 1);
+   }
+   NeighborOfCell = createDeviceMirrorCopy(NeighborOfCellH);
+   RemoteCell     = createDeviceMirrorCopy(RemoteCellH);
+
+} // end constructor
+
+//------------------------------------------------------------------------------
+// Add particles from host arrays
+
+int Particles::add(const HostArray2DR8 &Pos,    // [in] positions
+                   const HostArray1DI4 &Cell,   // [in] starting cells
+                   const HostArray1DI4 &Levels, // [in] vertical levels
+                   const HostArray1DI8 &Ids     // [in] global ids
+) {
+
+   const I4 NNew = Pos.extent_int(0);
+   if (NumParticles + NNew > Capacity) {
+      LOG_ERROR("Particles: adding {} particles to {} exceeds the capacity {} "
+                "of {}",
+                NNew, NumParticles, Capacity, Name);
+      return 1;
+   }
+
+   auto PosD    = createDeviceMirrorCopy(Pos);
+   auto CellD   = createDeviceMirrorCopy(Cell);
+   auto LevelsD = createDeviceMirrorCopy(Levels);
+   auto IdsD    = createDeviceMirrorCopy(Ids);
+
+   OMEGA_SCOPE(LocPosition, Position);
+   OMEGA_SCOPE(LocCellIndx, CellIndx);
+   OMEGA_SCOPE(LocLevel, Level);
+   OMEGA_SCOPE(LocId, Id);
+   const I4 First = NumParticles;
+
+   parallelFor(
+       "Particles:add", {NNew}, KOKKOS_LAMBDA(int INew) {
+          const int I = First + INew;
+          for (int D = 0; D < 3; ++D)
+             LocPosition(I, D) = PosD(INew, D);
+          LocCellIndx(I) = CellD(INew);
+          LocLevel(I)    = LevelsD(INew);
+          LocId(I)       = IdsD(INew);
+       });
+
+   NumParticles += NNew;
+
+   const ParticleMesh PMesh =
+       makeParticleMesh(Mesh, CellCoord, EdgeCoord, EdgeNormal, EdgeTangent);
+   locateParticles(PMesh, Position, CellIndx, Level, First, NumParticles);
+
+   return 0;
+
+} // end add
+
+//------------------------------------------------------------------------------
+// Advance all particles with a midpoint step and migrate them
+
+int Particles::advance(const Array2DReal &NormalVelocity, // [in] velocity
+                       Real Dt                            // [in] time step
+) {
+
+   // Reconstruct the tangential velocity on all local edges
+   OMEGA_SCOPE(LocTangRecon, TangRecon);
+   OMEGA_SCOPE(LocTangVel, TangVel);
+   parallelFor(
+       "Particles:reconstruct", {Mesh->NEdgesAll, NChunks},
+       KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          LocTangRecon(LocTangVel, IEdge, KChunk, NormalVelocity);
+       });
+
+   const ParticleMesh PMesh =
+       makeParticleMesh(Mesh, CellCoord, EdgeCoord, EdgeNormal, EdgeTangent);
+   OMEGA_SCOPE(LocPosition, Position);
+   OMEGA_SCOPE(LocCellIndx, CellIndx);
+   OMEGA_SCOPE(LocLevel, Level);
+   const R8 StepDt = Dt;
+
+   parallelFor(
+       "Particles:advance", {NumParticles}, KOKKOS_LAMBDA(int I) {
+          const int K = LocLevel(I);
+          int ICell   = LocCellIndx(I);
+          const R8 X0[3] = {LocPosition(I, 0), LocPosition(I, 1),
+                            LocPosition(I, 2)};
+          const R8 Radius =
+              Kokkos::sqrt(X0[0] * X0[0] + X0[1] * X0[1] + X0[2] * X0[2]);
+          R8 X[3], V[3];
+
+          // Half step to the midpoint
+          PMesh.velocity(V, X0, ICell, K, NormalVelocity, LocTangVel);
+          for (int D = 0; D < 3; ++D)
+             X[D] = X0[D] + 0.5 * StepDt * V[D];
+          toSphere(X, Radius);
+          ICell = PMesh.walk(ICell, K, X);
+
+          // Full step with the midpoint velocity
+          PMesh.velocity(V, X, ICell, K, NormalVelocity, LocTangVel);
+          for (int D = 0; D < 3; ++D)
+             X[D] = X0[D] + StepDt * V[D];
+          toSphere(X, Radius);
+          ICell = PMesh.walk(ICell, K, X);
+
+          for (int D = 0; D < 3; ++D)
+             LocPosition(I, D) = X[D];
+          LocCellIndx(I) = ICell;
+       });
+
+   return migrate();
+
+} // end advance
+
+//------------------------------------------------------------------------------
+// Send the particles in halo cells to the owners of the cells
+
+int Particles::migrate() {
+
+   int Err = 0;
+
+   const I4 NNghbr = NeighborTasks.size();
+   const I4 NOwned = Mesh->NCellsOwned;
+   MPI_Comm Comm   = MeshHalo->getComm();
+   OMEGA_SCOPE(LocPosition, Position);
+   OMEGA_SCOPE(LocCellIndx, CellIndx);
+   OMEGA_SCOPE(LocLevel, Level);
+   OMEGA_SCOPE(LocId, Id);
+   OMEGA_SCOPE(LocSendCount, SendCount);
+   OMEGA_SCOPE(LocNeighborOfCell, NeighborOfCell);
+
+   // Count the particles leaving for each neighbor
+   deepCopy(SendCount, 0);
+   parallelFor(
+       "Particles:count", {NumParticles}, KOKKOS_LAMBDA(int I) {
+          const int ICell = LocCellIndx(I);
+          if (ICell >= NOwned)
+             Kokkos::atomic_inc(&LocSendCount(LocNeighborOfCell(ICell)));
+       });
+   auto SendCountH = createHostMirrorCopy(SendCount);
+
+   std::vector<I4> SendCounts(NNghbr), RecvCounts(NNghbr, 0);
+   std::vector<I4> SendOffsets(NNghbr), RecvOffsets(NNghbr);
+   I4 NSend = 0;
+   HostArray1DI4 SendOffsetH("SendOffsetH", NNghbr);
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      SendCounts[INghbr]  = SendCountH(INghbr);
+      SendOffsets[INghbr] = NSend;
+      SendOffsetH(INghbr) = NSend;
+      NSend += SendCounts[INghbr];
+   }
+   deepCopy(SendOffset, SendOffsetH);
+
+   // Post the exchange of the counts before packing
+   std::vector<MPI_Request> CountReqs(2 * NNghbr, MPI_REQUEST_NULL);
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      Err += MPI_Irecv(&RecvCounts[INghbr], 1, MPI_INT, NeighborTasks[INghbr],
+                       CountTag, Comm, &CountReqs[INghbr]);
+      Err += MPI_Isend(&SendCounts[INghbr], 1, MPI_INT, NeighborTasks[INghbr],
+                       CountTag, Comm, &CountReqs[NNghbr + INghbr]);
+   }
+
+   // Compact the particles that stay and pack the others by neighbor
+   MemoryScope Scope("Particles");
+   if (SendBuffer.extent_int(0) < NSend * NFields) {
+      SendBuffer  = Array1DR8("ParticleSendBuffer" + Name, NSend * NFields);
+      SendBufferH = Kokkos::create_mirror_view(SendBuffer);
+   }
+   deepCopy(SendFill, 0);
+
+   OMEGA_SCOPE(LocNewPosition, NewPosition);
+   OMEGA_SCOPE(LocNewCellIndx, NewCellIndx);
+   OMEGA_SCOPE(LocNewLevel, NewLevel);
+   OMEGA_SCOPE(LocNewId, NewId);
+   OMEGA_SCOPE(LocSendFill, SendFill);
+   OMEGA_SCOPE(LocSendOffset, SendOffset);
+   OMEGA_SCOPE(LocSendBuffer, SendBuffer);
+   OMEGA_SCOPE(LocRemoteCell, RemoteCell);
+   I4 NKeep = 0;
+
+   Kokkos::parallel_scan(
+       "Particles:compact", Kokkos::RangePolicy<ExecSpace>(0, NumParticles),
+       KOKKOS_LAMBDA(int I, I4 &Update, const bool Final) {
+          const int ICell = LocCellIndx(I);
+          if (ICell < NOwned) {
+             if (Final) {
+                for (int D = 0; D < 3; ++D)
+                   LocNewPosition(Update, D) = LocPosition(I, D);
+                LocNewCellIndx(Update) = ICell;
+                LocNewLevel(Update)    = LocLevel(I);
+                LocNewId(Update)       = LocId(I);
+             }
+             ++Update;
+          } else if (Final) {
+             const int INghbr = LocNeighborOfCell(ICell);
+             const int IBuff =
+                 (LocSendOffset(INghbr) +
+                  Kokkos::atomic_fetch_add(&LocSendFill(INghbr), 1)) *
+                 NFields;
+             LocSendBuffer(IBuff)     = LocPosition(I, 0);
+             LocSendBuffer(IBuff + 1) = LocPosition(I, 1);
+             LocSendBuffer(IBuff + 2) = LocPosition(I, 2);
+             LocSendBuffer(IBuff + 3) = LocLevel(I);
+             LocSendBuffer(IBuff + 4) = LocId(I);
+             LocSendBuffer(IBuff + 5) = LocRemoteCell(ICell);
+          }
+       },
+       NKeep);
+
+   std::swap(Position, NewPosition);
+   std::swap(CellIndx, NewCellIndx);
+   std::swap(Level, NewLevel);
+   std::swap(Id, NewId);
+
+   Err += MPI_Waitall(2 * NNghbr, CountReqs.data(), MPI_STATUSES_IGNORE);
+
+   I4 NRecv = 0;
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      RecvOffsets[INghbr] = NRecv;
+      NRecv += RecvCounts[INghbr];
+   }
+   if (RecvBuffer.extent_int(0) < NRecv * NFields) {
+      RecvBuffer  = Array1DR8("ParticleRecvBuffer" + Name, NRecv * NFields);
+      RecvBufferH = Kokkos::create_mirror_view(RecvBuffer);
+   }
+
+#ifdef OMEGA_MPI_ON_DEVICE
+   R8 *SendPtr = SendBuffer.data();
+   R8 *RecvPtr = RecvBuffer.data();
+   Kokkos::fence();
+#else
+   deepCopy(SendBufferH, SendBuffer);
+   R8 *SendPtr = SendBufferH.data();
+   R8 *RecvPtr = RecvBufferH.data();
+#endif
+
+   // Exchange the packed particles, one message per neighbor
+   std::vector<MPI_Request> Reqs(2 * NNghbr, MPI_REQUEST_NULL);
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (RecvCounts[INghbr] > 0)
+         Err += MPI_Irecv(RecvPtr + RecvOffsets[INghbr] * NFields,
+                          RecvCounts[INghbr] * NFields, MPI_DOUBLE,
+                          NeighborTasks[INghbr], ParticleTag, Comm,
+                          &Reqs[INghbr]);
+      if (SendCounts[INghbr] > 0)
+         Err += MPI_Isend(SendPtr + SendOffsets[INghbr] * NFields,
+                          SendCounts[INghbr] * NFields, MPI_DOUBLE,
+                          NeighborTasks[INghbr], ParticleTag, Comm,
+                          &Reqs[NNghbr + INghbr]);
+   }
+   Err += MPI_Waitall(2 * NNghbr, Reqs.data(), MPI_STATUSES_IGNORE);
+   if (Err != 0) {
+      LOG_ERROR("Particles: MPI error migrating particles of {}", Name);
+      Err = 1;
+   }
+
+#ifndef OMEGA_MPI_ON_DEVICE
+   deepCopy(RecvBuffer, RecvBufferH);
+#endif
+
+   // Unpack the received particles after the ones that stayed
+   I4 NAdd = NRecv;
+   if (NKeep + NRecv > Capacity) {
+      LOG_ERROR("Particles: {} particles received exceed the capacity {} of "
+                "{}, {} particles dropped",
+                NRecv, Capacity, Name, NKeep + NRecv - Capacity);
+      NAdd = Capacity - NKeep;
+      Err  = 1;
+   }
+
+   // The scoped references follow the swap to the compacted arrays
+   OMEGA_SCOPE(LocRecvBuffer, RecvBuffer);
+   parallelFor(
+       "Particles:unpack", {NAdd}, KOKKOS_LAMBDA(int IRecv) {
+          const int I     = NKeep + IRecv;
+          const int IBuff = IRecv * NFields;
+          for (int D = 0; D < 3; ++D)
+             LocPosition(I, D) = LocRecvBuffer(IBuff + D);
+          LocLevel(I)    = static_cast<I4>(LocRecvBuffer(IBuff + 3));
+          LocId(I)       = static_cast<I8>(LocRecvBuffer(IBuff + 4));
+          LocCellIndx(I) = static_cast<I4>(LocRecvBuffer(IBuff + 5));
+       });
+
+   NumParticles = NKeep + NAdd;
+
+   // A particle may have left the halo of the sender, so continue its walk
+   const ParticleMesh PMesh =
+       makeParticleMesh(Mesh, CellCoord, EdgeCoord, EdgeNormal, EdgeTangent);
+   locateParticles(PMesh, Position, CellIndx, Level, NKeep, NumParticles);
+
+   return Err;
+
+} // end migrate
+
+//------------------------------------------------------------------------------
+// Total number of particles on all tasks
+
+I8 Particles::getGlobalNumParticles() const {
+
+   I8 LocalNum  = NumParticles;
+   I8 GlobalNum = 0;
+   globalSum(&LocalNum, MeshHalo->getComm(), &GlobalNum);
+   return GlobalNum;
+
+} // end getGlobalNumParticles
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
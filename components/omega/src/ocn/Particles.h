@@ -0,0 +1,124 @@
+#ifndef OMEGA_PARTICLES_H
+#define OMEGA_PARTICLES_H
+//===-- ocn/Particles.h - Lagrangian particles ------------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines Lagrangian particles advected on the device
+///
+/// The Particles class tracks Lagrangian particles in the horizontal velocity
+/// of the model, in the spirit of the LIGHT floats of MPAS-Ocean. Each
+/// particle stays on a vertical level and moves on the sphere. All particle
+/// data lives on the device, and a time step of all particles is one kernel:
+/// the velocity at a particle is interpolated from the full velocity vectors
+/// on the edges of its cell, built from the normal velocity and its
+/// tangential reconstruction, and the particle is advanced with a midpoint
+/// step. After each stage the containing cell is found by walking on
+/// CellsOnCell from the previous cell to the cell whose center is closest,
+/// which is the Voronoi cell containing the particle. Particles that walk
+/// into the halo are sent to the owner of the halo cell in one message per
+/// neighboring task of the Halo, so a particle must not move more than the
+/// halo width in one step.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Lagrangian particles on a mesh. The particles of a task are stored in the
+/// first getNumParticles entries of the public arrays, in no particular
+/// order, and are identified by their global Id.
+class Particles {
+ public:
+   Array2DR8 Position; ///< Cartesian position of each particle (m)
+   Array1DI4 CellIndx; ///< Local index of the cell holding each particle
+   Array1DI4 Level;    ///< Vertical level of each particle
+   Array1DI8 Id;       ///< Global id of each particle
+
+   /// Constructs an empty set of particles on a mesh, with room for Capacity
+   /// particles on this task, and loads the mesh coordinates if needed
+   Particles(const std::string &Name,  ///< [in] name of the particles
+             HorzMesh *Mesh,           ///< [in] mesh
+             const Decomp *MeshDecomp, ///< [in] decomposition of the mesh
+             const Halo *MeshHalo,     ///< [in] halo of the mesh
+             I4 NVertLevels,           ///< [in] number of vertical levels
+             I4 Capacity               ///< [in] max particles on this task
+   );
+
+   /// Adds particles at the given Cartesian positions on the sphere. Cell is
+   /// an owned cell at or near each position, from which the containing
+   /// cell is found. Particles found in the halo are sent to their owner at
+   /// the next migration. Returns an error code.
+   int add(const HostArray2DR8 &Pos,    ///< [in] positions (NNew,3) (m)
+           const HostArray1DI4 &Cell,   ///< [in] starting cell of the walk
+           const HostArray1DI4 &Levels, ///< [in] vertical levels
+           const HostArray1DI8 &Ids     ///< [in] global ids
+   );
+
+   /// Advances all particles by Dt with the normal velocity NormalVelocity,
+   /// which must be valid on the edges of all local cells, and migrates the
+   /// particles that left the owned cells. Returns an error code.
+   int advance(const Array2DReal &NormalVelocity, ///< [in] normal velocity
+               Real Dt                            ///< [in] time step
+   );
+
+   /// Sends the particles in halo cells to the tasks that own those cells
+   /// and receives the particles sent to this task. Must be called by all
+   /// tasks of the halo. Returns an error code.
+   int migrate();
+
+   /// Number of particles on this task
+   I4 getNumParticles() const { return NumParticles; }
+
+   /// Max number of particles on this task
+   I4 getCapacity() const { return Capacity; }
+
+   /// Number of particles on all tasks
+   I8 getGlobalNumParticles() const;
+
+ private:
+   std::string Name;                ///< name of the particles
+   const HorzMesh *Mesh;            ///< mesh
+   const Halo *MeshHalo;            ///< halo of the mesh
+   I4 NVertLevels;                  ///< number of vertical levels
+   I4 NChunks;                      ///< number of vertical chunks
+   I4 Capacity;                     ///< max particles on this task
+   I4 NumParticles{0};              ///< particles on this task
+   TangentialReconOnEdge TangRecon; ///< tangential velocity reconstruction
+
+   Array2DR8 CellCoord;   ///< Cartesian position of cell centers (m)
+   Array2DR8 EdgeCoord;   ///< Cartesian position of edge midpoints (m)
+   Array2DR8 EdgeNormal;  ///< unit normal vector of each edge
+   Array2DR8 EdgeTangent; ///< unit tangent vector of each edge
+   Array2DReal TangVel;   ///< tangential velocity on edges
+
+   std::vector<I4> NeighborTasks; ///< tasks particles are exchanged with
+   Array1DI4 NeighborOfCell;      ///< neighbor index of the owner of a cell
+   Array1DI4 RemoteCell;          ///< index of a cell on its owner
+
+   // Work arrays of the migration, reused between calls
+   Array2DR8 NewPosition;     ///< compacted positions
+   Array1DI4 NewCellIndx;     ///< compacted cells
+   Array1DI4 NewLevel;        ///< compacted levels
+   Array1DI8 NewId;           ///< compacted ids
+   Array1DI4 SendCount;       ///< particles sent to each neighbor
+   Array1DI4 SendFill;        ///< particles packed for each neighbor
+   Array1DI4 SendOffset;      ///< start of each neighbor in the send buffer
+   Array1DR8 SendBuffer;      ///< packed particles sent
+   Array1DR8 RecvBuffer;      ///< packed particles received
+   HostArray1DR8 SendBufferH; ///< host copy of the send buffer
+   HostArray1DR8 RecvBufferH; ///< host copy of the receive buffer
+
+}; // end class Particles
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_PARTICLES_H
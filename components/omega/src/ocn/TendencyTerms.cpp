@@ -0,0 +1,378 @@
+//===-- ocn/TendencyTerms.cpp - shallow water tendency terms ----*- C++ -*-===//
+//
+// Each tendency is computed by requesting from the auxiliary state the kinds
+// of variables used by the enabled terms, which computes any that are out of
+// date, and then launching one loop over the owned elements in which every
+// enabled term adds its contribution to a register array that is stored
+// once. The enabled flags are the same for all elements, so the branches on
+// them do not diverge.
+//
+//===----------------------------------------------------------------------===//
+
+#include "TendencyTerms.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+#include "Timer.h"
+
+namespace OMEGA {
+
+// Static members
+ShallowWaterTendencies *ShallowWaterTendencies::DefaultTendencies = nullptr;
+std::map<std::string, std::unique_ptr<ShallowWaterTendencies>>
+    ShallowWaterTendencies::AllTendencies;
+
+//------------------------------------------------------------------------------
+// Tendency term constructors, which keep references to the mesh arrays
+
+ThicknessFluxDivOnCell::ThicknessFluxDivOnCell(const HorzMesh *Mesh)
+    : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
+      InvAreaCell(Mesh->OpInvAreaCell),
+      DvEdgeSignOnCell(Mesh->OpDvEdgeSignOnCell) {}
+
+PotentialVortHAdvOnEdge::PotentialVortHAdvOnEdge(const HorzMesh *Mesh)
+    : NEdgesOnEdge(Mesh->NEdgesOnEdge), EdgesOnEdge(Mesh->EdgesOnEdge),
+      WeightsOnEdge(Mesh->OpWeightsOnEdge) {}
+
+KEGradOnEdge::KEGradOnEdge(const HorzMesh *Mesh)
+    : CellsOnEdge(Mesh->CellsOnEdge), InvDcEdge(Mesh->OpInvDcEdge) {}
+
+SSHGradOnEdge::SSHGradOnEdge(const HorzMesh *Mesh)
+    : CellsOnEdge(Mesh->CellsOnEdge), InvDcEdge(Mesh->OpInvDcEdge),
+      BottomDepth(Mesh->BottomDepth) {}
+
+VelocityDiffusionOnEdge::VelocityDiffusionOnEdge(const HorzMesh *Mesh)
+    : CellsOnEdge(Mesh->CellsOnEdge), VerticesOnEdge(Mesh->VerticesOnEdge),
+      InvDcEdge(Mesh->OpInvDcEdge), DvEdge(Mesh->DvEdge) {}
+
+VelocityHyperDiffOnEdge::VelocityHyperDiffOnEdge(const HorzMesh *Mesh)
+    : Laplacian(Mesh) {}
+
+BottomDragOnEdge::BottomDragOnEdge(const HorzMesh *Mesh)
+    : CellsOnEdge(Mesh->CellsOnEdge) {}
+
+//------------------------------------------------------------------------------
+// Create the default tendencies from the configuration
+
+int ShallowWaterTendencies::init(I4 NVertLevels // [in] vertical levels
+) {
+
+   TendencyOptions Options;
+
+   ConfigParam<bool> ThickFluxEnable("Tendencies/ThicknessFluxTendencyEnable",
+                                     Options.ThicknessFluxTendencyEnable);
+   ConfigParam<bool> PVEnable("Tendencies/PVTendencyEnable",
+                              Options.PVTendencyEnable);
+   ConfigParam<bool> KEEnable("Tendencies/KETendencyEnable",
+                              Options.KETendencyEnable);
+   ConfigParam<bool> SSHEnable("Tendencies/SSHTendencyEnable",
+                               Options.SSHTendencyEnable);
+   ConfigParam<bool> VelDiffEnable("Tendencies/VelDiffTendencyEnable",
+                                   Options.VelDiffTendencyEnable);
+   ConfigParam<bool> VelHyperDiffEnable(
+       "Tendencies/VelHyperDiffTendencyEnable",
+       Options.VelHyperDiffTendencyEnable);
+   ConfigParam<bool> BottomDragEnable("Tendencies/BottomDragTendencyEnable",
+                                      Options.BottomDragTendencyEnable);
+   ConfigParam<R8> ViscDel2("Tendencies/ViscDel2", Options.ViscDel2);
+   ConfigParam<R8> ViscDel4("Tendencies/ViscDel4", Options.ViscDel4);
+   ConfigParam<R8> BottomDragCoeff("Tendencies/BottomDragCoeff",
+                                   Options.BottomDragCoeff);
+   ConfigParam<R8> Gravity("Tendencies/Gravity", Options.Gravity);
+
+   int Err = ThickFluxEnable.bind() + PVEnable.bind() + KEEnable.bind() +
+             SSHEnable.bind() + VelDiffEnable.bind() +
+             VelHyperDiffEnable.bind() + BottomDragEnable.bind() +
+             ViscDel2.bind() + ViscDel4.bind() + BottomDragCoeff.bind() +
+             Gravity.bind();
+   if (Err != 0) {
+      LOG_ERROR("ShallowWaterTendencies: error reading Tendencies options");
+      return Err;
+   }
+
+   Options.ThicknessFluxTendencyEnable = ThickFluxEnable.get();
+   Options.PVTendencyEnable            = PVEnable.get();
+   Options.KETendencyEnable            = KEEnable.get();
+   Options.SSHTendencyEnable           = SSHEnable.get();
+   Options.VelDiffTendencyEnable       = VelDiffEnable.get();
+   Options.VelHyperDiffTendencyEnable  = VelHyperDiffEnable.get();
+   Options.BottomDragTendencyEnable    = BottomDragEnable.get();
+   Options.ViscDel2                    = ViscDel2.get();
+   Options.ViscDel4                    = ViscDel4.get();
+   Options.BottomDragCoeff             = BottomDragCoeff.get();
+   Options.Gravity                     = Gravity.get();
+
+   DefaultTendencies =
+       create("Default", HorzMesh::getDefault(), Halo::getDefault(),
+              AuxiliaryState::getDefault(), NVertLevels, Options);
+   if (DefaultTendencies == nullptr) {
+      LOG_ERROR("ShallowWaterTendencies: error creating default tendencies");
+      return 1;
+   }
+
+   return 0;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Create tendencies and store them by name
+
+ShallowWaterTendencies *ShallowWaterTendencies::create(
+    const std::string &Name,       // [in] name of the tendencies
+    const HorzMesh *Mesh,          // [in] mesh
+    Halo *MeshHalo,                // [in] halo for the mesh
+    AuxiliaryState *AuxState,      // [in] auxiliary state
+    I4 NVertLevels,                // [in] number of vertical levels
+    const TendencyOptions &Options // [in] choice of terms
+) {
+
+   if (AllTendencies.find(Name) != AllTendencies.end()) {
+      LOG_ERROR("ShallowWaterTendencies: attempt to create tendencies {} "
+                "that already exist",
+                Name);
+      return nullptr;
+   }
+   if (Mesh == nullptr || MeshHalo == nullptr || AuxState == nullptr) {
+      LOG_ERROR("ShallowWaterTendencies: tendencies {} require a mesh, a "
+                "halo and an auxiliary state",
+                Name);
+      return nullptr;
+   }
+
+   MemoryScope Scope("Tendencies");
+
+   std::unique_ptr<ShallowWaterTendencies> NewTendencies(
+       new ShallowWaterTendencies(Name, Mesh, MeshHalo, AuxState,
+                                  NVertLevels, Options));
+
+   ShallowWaterTendencies *NewTend = NewTendencies.get();
+   AllTendencies.emplace(Name, std::move(NewTendencies));
+   return NewTend;
+
+} // end create
+
+//------------------------------------------------------------------------------
+// Construct the tendencies and the biharmonic operator
+
+ShallowWaterTendencies::ShallowWaterTendencies(const std::string &InName,
+                                               const HorzMesh *InMesh,
+                                               Halo *InMeshHalo,
+                                               AuxiliaryState *InAuxState,
+                                               I4 InNVertLevels,
+                                               const TendencyOptions &Options)
+    : ThicknessFluxDiv(InMesh), PotentialVortHAdv(InMesh), KEGrad(InMesh),
+      SSHGrad(InMesh), VelocityDiffusion(InMesh), VelocityHyperDiff(InMesh),
+      BottomDrag(InMesh), Name(InName), Mesh(InMesh), AuxState(InAuxState),
+      NVertLevels(InNVertLevels), NChunks(numVertChunks(InNVertLevels)),
+      NumPasses(0),
+      VelDel4("Tendencies" + InName, InMesh, InMeshHalo, InNVertLevels) {
+
+   ThicknessFluxDiv.Enabled   = Options.ThicknessFluxTendencyEnable;
+   PotentialVortHAdv.Enabled  = Options.PVTendencyEnable;
+   KEGrad.Enabled             = Options.KETendencyEnable;
+   SSHGrad.Enabled            = Options.SSHTendencyEnable;
+   SSHGrad.Gravity            = Options.Gravity;
+   VelocityDiffusion.Enabled  = Options.VelDiffTendencyEnable;
+   VelocityDiffusion.ViscDel2 = Options.ViscDel2;
+   VelocityHyperDiff.Enabled  = Options.VelHyperDiffTendencyEnable;
+   VelocityHyperDiff.ViscDel4 = Options.ViscDel4;
+   BottomDrag.Enabled         = Options.BottomDragTendencyEnable;
+   BottomDrag.Coeff           = Options.BottomDragCoeff;
+
+} // end constructor
+
+//------------------------------------------------------------------------------
+// Retrieve, remove and clear tendencies
+
+ShallowWaterTendencies *ShallowWaterTendencies::getDefault() {
+   return DefaultTendencies;
+}
+
+ShallowWaterTendencies *
+ShallowWaterTendencies::get(const std::string &Name // [in] name
+) {
+   auto It = AllTendencies.find(Name);
+   if (It == AllTendencies.end()) {
+      LOG_ERROR("ShallowWaterTendencies: attempt to retrieve non-existent "
+                "tendencies {}",
+                Name);
+      return nullptr;
+   }
+   return It->second.get();
+}
+
+void ShallowWaterTendencies::erase(const std::string &Name // [in] name
+) {
+   if (DefaultTendencies != nullptr && DefaultTendencies->Name == Name)
+      DefaultTendencies = nullptr;
+   AllTendencies.erase(Name);
+}
+
+void ShallowWaterTendencies::clear() {
+   DefaultTendencies = nullptr;
+   AllTendencies.clear();
+}
+
+//------------------------------------------------------------------------------
+// Thickness tendency on owned cells
+
+void ShallowWaterTendencies::computeThicknessTendency(
+    const Array2DReal &ThickTend,      // [out] thickness tendency
+    const Array2DReal &NormalVelocity, // [in] normal velocity
+    const Array2DReal &LayerThickness, // [in] layer thickness
+    const TimeInstant &Time            // [in] time of the tendency
+) {
+
+   Timer::start("Tendencies:thickness");
+
+   const I4 Kinds = ThicknessFluxDiv.Enabled ? AuxLayerThickEdge : 0;
+   if (AuxState->compute(Kinds, LayerThickness, NormalVelocity) != 0)
+      LOG_ERROR("ShallowWaterTendencies: error computing auxiliary "
+                "variables for the thickness tendency");
+
+   OMEGA_SCOPE(LocThicknessFluxDiv, ThicknessFluxDiv);
+   OMEGA_SCOPE(FluxLayerThickEdge,
+               AuxState->LayerThicknessAux.FluxLayerThickEdge);
+   OMEGA_SCOPE(OceanCells, Mesh->OceanCellsOwned);
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+
+   // Loop over the owned cells with active levels only, and set the
+   // tendency of chunks without active levels to zero
+   parallelFor(
+       "ThicknessTendency", {Mesh->NCellsOwnedOcean, NChunks},
+       KOKKOS_LAMBDA(int IOcean, int KChunk) {
+          const int ICell = OceanCells(IOcean);
+          if (isInactiveChunk(KChunk, MinLevelCell(ICell),
+                              MaxLevelCell(ICell))) {
+             zeroChunk(ThickTend, ICell, KChunk);
+             return;
+          }
+          const int KStart = KChunk * VecLength;
+          const int KLast  = ThickTend.extent_int(1) - 1;
+
+          Real Tend[VecLength] = {0};
+          if (LocThicknessFluxDiv.Enabled)
+             LocThicknessFluxDiv(Tend, ICell, KChunk, FluxLayerThickEdge,
+                                 NormalVelocity);
+
+          for (int KVec = 0; KVec < VecLength; ++KVec) {
+             const int K = KStart + KVec;
+             if (K <= KLast)
+                ThickTend(ICell, K) = Tend[KVec];
+          }
+       });
+   ++NumPasses;
+
+   Timer::stop("Tendencies:thickness");
+
+} // end computeThicknessTendency
+
+//------------------------------------------------------------------------------
+// Velocity tendency on owned edges
+
+void ShallowWaterTendencies::computeVelocityTendency(
+    const Array2DReal &VelTend,        // [out] velocity tendency
+    const Array2DReal &NormalVelocity, // [in] normal velocity
+    const Array2DReal &LayerThickness, // [in] layer thickness
+    const TimeInstant &Time            // [in] time of the tendency
+) {
+
+   Timer::start("Tendencies:velocity");
+
+   // Request the auxiliary variables of all enabled terms at once, so they
+   // are computed with at most one loop per kind of mesh element
+   I4 Kinds = 0;
+   if (PotentialVortHAdv.Enabled)
+      Kinds |= AuxLayerThickEdge | AuxVortEdge;
+   if (KEGrad.Enabled)
+      Kinds |= AuxKineticCell;
+   if (VelocityDiffusion.Enabled)
+      Kinds |= AuxKineticCell | AuxVortVertex;
+   if (BottomDrag.Enabled)
+      Kinds |= AuxLayerThickEdge | AuxKineticCell;
+   if (AuxState->compute(Kinds, LayerThickness, NormalVelocity) != 0)
+      LOG_ERROR("ShallowWaterTendencies: error computing auxiliary "
+                "variables for the velocity tendency");
+
+   OMEGA_SCOPE(LayerThicknessAux, AuxState->LayerThicknessAux);
+   OMEGA_SCOPE(KineticAux, AuxState->KineticAux);
+   OMEGA_SCOPE(VorticityAux, AuxState->VorticityAux);
+
+   // The biharmonic viscosity needs the Laplacian of the velocity on the
+   // first edge halo layers, which takes a loop and a halo exchange
+   if (VelocityHyperDiff.Enabled) {
+      if (VelDel4.computeDel2(NormalVelocity) != 0)
+         LOG_ERROR("ShallowWaterTendencies: error computing the Laplacian "
+                   "for the biharmonic viscosity");
+      ++NumPasses;
+   }
+
+   OMEGA_SCOPE(LocPotentialVortHAdv, PotentialVortHAdv);
+   OMEGA_SCOPE(LocKEGrad, KEGrad);
+   OMEGA_SCOPE(LocSSHGrad, SSHGrad);
+   OMEGA_SCOPE(LocVelocityDiffusion, VelocityDiffusion);
+   OMEGA_SCOPE(LocVelocityHyperDiff, VelocityHyperDiff);
+   OMEGA_SCOPE(LocBottomDrag, BottomDrag);
+   OMEGA_SCOPE(FluxLayerThickEdge, LayerThicknessAux.FluxLayerThickEdge);
+   OMEGA_SCOPE(MeanLayerThickEdge, LayerThicknessAux.MeanLayerThickEdge);
+   OMEGA_SCOPE(KineticEnergyCell, KineticAux.KineticEnergyCell);
+   OMEGA_SCOPE(VelocityDivCell, KineticAux.VelocityDivCell);
+   OMEGA_SCOPE(RelVortVertex, VorticityAux.RelVortVertex);
+   OMEGA_SCOPE(NormRelVortEdge, VorticityAux.NormRelVortEdge);
+   OMEGA_SCOPE(NormPlanetVortEdge, VorticityAux.NormPlanetVortEdge);
+   OMEGA_SCOPE(Del2VelEdge, VelDel4.getDel2());
+   OMEGA_SCOPE(OceanEdges, Mesh->OceanEdgesOwned);
+   OMEGA_SCOPE(MinLevelEdgeTop, Mesh->MinLevelEdgeTop);
+   OMEGA_SCOPE(MaxLevelEdgeTop, Mesh->MaxLevelEdgeTop);
+
+   // Loop over the owned edges with active levels only, as for the thickness
+   parallelFor(
+       "VelocityTendency", {Mesh->NEdgesOwnedOcean, NChunks},
+       KOKKOS_LAMBDA(int IOcean, int KChunk) {
+          const int IEdge = OceanEdges(IOcean);
+          if (isInactiveChunk(KChunk, MinLevelEdgeTop(IEdge),
+                              MaxLevelEdgeTop(IEdge))) {
+             zeroChunk(VelTend, IEdge, KChunk);
+             return;
+          }
+          const int KStart = KChunk * VecLength;
+          const int KLast  = VelTend.extent_int(1) - 1;
+
+          Real Tend[VecLength] = {0};
+          if (LocPotentialVortHAdv.Enabled)
+             LocPotentialVortHAdv(Tend, IEdge, KChunk, NormRelVortEdge,
+                                  NormPlanetVortEdge, FluxLayerThickEdge,
+                                  NormalVelocity);
+          if (LocKEGrad.Enabled)
+             LocKEGrad(Tend, IEdge, KChunk, KineticEnergyCell);
+          if (LocSSHGrad.Enabled)
+             LocSSHGrad(Tend, IEdge, KChunk, LayerThickness);
+          if (LocVelocityDiffusion.Enabled)
+             LocVelocityDiffusion(Tend, IEdge, KChunk, VelocityDivCell,
+                                  RelVortVertex);
+          if (LocVelocityHyperDiff.Enabled)
+             LocVelocityHyperDiff(Tend, IEdge, KChunk, Del2VelEdge);
+          if (LocBottomDrag.Enabled)
+             LocBottomDrag(Tend, IEdge, KChunk, NormalVelocity,
+                           KineticEnergyCell, MeanLayerThickEdge);
+
+          for (int KVec = 0; KVec < VecLength; ++KVec) {
+             const int K = KStart + KVec;
+             if (K <= KLast)
+                VelTend(IEdge, K) = Tend[KVec];
+          }
+       });
+   ++NumPasses;
+
+   Timer::stop("Tendencies:velocity");
+
+} // end computeVelocityTendency
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
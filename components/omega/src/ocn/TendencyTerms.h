@@ -0,0 +1,367 @@
+#ifndef OMEGA_TENDENCYTERMS_H
+#define OMEGA_TENDENCYTERMS_H
+//===-- ocn/TendencyTerms.h - shallow water tendency terms ------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the tendency terms of the shallow water equations
+///
+/// Each tendency term is a functor, in the style of the horizontal operators,
+/// that adds its contribution over a chunk of VecLength vertical levels at
+/// one mesh element to a tendency held in registers. The terms neither
+/// launch kernels nor write to memory, so ShallowWaterTendencies sums all
+/// the enabled terms of an equation inside one loop over the mesh elements
+/// and stores the total once, without a temporary array or a separate pass
+/// per term. The auxiliary variables read by the terms are computed
+/// beforehand by an AuxiliaryState. The equations and terms follow the
+/// Omega-0 shallow water design document.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AuxiliaryState.h"
+#include "DataTypes.h"
+#include "Del4Operators.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace OMEGA {
+
+// As in the operators, the loads of levels beyond the last level of a
+// partial chunk are clamped to the last level, and the fused kernels skip
+// the stores of those levels.
+
+/// Thickness tendency from the divergence of the thickness flux,
+/// -div(h u), with the thickness at edges FluxLayerThickEdge
+class ThicknessFluxDivOnCell {
+ public:
+   bool Enabled = true;
+
+   ThicknessFluxDivOnCell(const HorzMesh *Mesh);
+
+   KOKKOS_FUNCTION void operator()(Real (&Tend)[VecLength], int ICell,
+                                   int KChunk,
+                                   const Array2DReal &FluxLayerThickEdge,
+                                   const Array2DReal &NormalVelEdge) const {
+      const int KStart   = KChunk * VecLength;
+      const int KLast    = NormalVelEdge.extent_int(1) - 1;
+      const Real InvArea = InvAreaCell(ICell);
+
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const int JEdge   = EdgesOnCell(ICell, J);
+         const Real DvSign = DvEdgeSignOnCell(ICell, J);
+         for (int KVec = 0; KVec < VecLength; ++KVec) {
+            const int K = Kokkos::min(KStart + KVec, KLast);
+            Tend[KVec] += DvSign * FluxLayerThickEdge(JEdge, K) *
+                          NormalVelEdge(JEdge, K) * InvArea;
+         }
+      }
+   }
+
+ private:
+   Array1DI4 NEdgesOnCell;
+   Array2DI4 EdgesOnCell;
+   Array1DMetric InvAreaCell;
+   Array2DMetric DvEdgeSignOnCell;
+};
+
+/// Velocity tendency from the potential vorticity flux, -q (h u)^perp, with
+/// the potential vorticity averaged between each edge and the edges used in
+/// the reconstruction of the tangential thickness flux
+class PotentialVortHAdvOnEdge {
+ public:
+   bool Enabled = true;
+
+   PotentialVortHAdvOnEdge(const HorzMesh *Mesh);
+
+   KOKKOS_FUNCTION void operator()(Real (&Tend)[VecLength], int IEdge,
+                                   int KChunk,
+                                   const Array2DReal &NormRelVortEdge,
+                                   const Array2DReal &NormPlanetVortEdge,
+                                   const Array2DReal &FluxLayerThickEdge,
+                                   const Array2DReal &NormalVelEdge) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = NormalVelEdge.extent_int(1) - 1;
+
+      for (int J = 0; J < NEdgesOnEdge(IEdge); ++J) {
+         const int JEdge   = EdgesOnEdge(IEdge, J);
+         const Real Weight = WeightsOnEdge(IEdge, J);
+         for (int KVec = 0; KVec < VecLength; ++KVec) {
+            const int K = Kokkos::min(KStart + KVec, KLast);
+            const Real NormVort =
+                0.5_Real *
+                (NormRelVortEdge(IEdge, K) + NormPlanetVortEdge(IEdge, K) +
+                 NormRelVortEdge(JEdge, K) + NormPlanetVortEdge(JEdge, K));
+            Tend[KVec] += Weight * NormalVelEdge(JEdge, K) *
+                          FluxLayerThickEdge(JEdge, K) * NormVort;
+         }
+      }
+   }
+
+ private:
+   Array1DI4 NEdgesOnEdge;
+   Array2DI4 EdgesOnEdge;
+   Array2DMetric WeightsOnEdge;
+};
+
+/// Velocity tendency from the gradient of the kinetic energy, -grad(K)
+class KEGradOnEdge {
+ public:
+   bool Enabled = true;
+
+   KEGradOnEdge(const HorzMesh *Mesh);
+
+   KOKKOS_FUNCTION void operator()(Real (&Tend)[VecLength], int IEdge,
+                                   int KChunk,
+                                   const Array2DReal &KineticEnergyCell) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = KineticEnergyCell.extent_int(1) - 1;
+      const int JCell0 = CellsOnEdge(IEdge, 0);
+      const int JCell1 = CellsOnEdge(IEdge, 1);
+      const Real InvDc = InvDcEdge(IEdge);
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const int K = Kokkos::min(KStart + KVec, KLast);
+         Tend[KVec] -= InvDc * (KineticEnergyCell(JCell1, K) -
+                                KineticEnergyCell(JCell0, K));
+      }
+   }
+
+ private:
+   Array2DI4 CellsOnEdge;
+   Array1DMetric InvDcEdge;
+};
+
+/// Velocity tendency from the gradient of the sea surface height,
+/// -g grad(h - b), where h is the layer thickness and b the bottom depth
+class SSHGradOnEdge {
+ public:
+   bool Enabled = true;
+   Real Gravity = 9.80616_Real; ///< gravitational acceleration (m/s^2)
+
+   SSHGradOnEdge(const HorzMesh *Mesh);
+
+   KOKKOS_FUNCTION void operator()(Real (&Tend)[VecLength], int IEdge,
+                                   int KChunk,
+                                   const Array2DReal &LayerThickCell) const {
+      const int KStart   = KChunk * VecLength;
+      const int KLast    = LayerThickCell.extent_int(1) - 1;
+      const int JCell0   = CellsOnEdge(IEdge, 0);
+      const int JCell1   = CellsOnEdge(IEdge, 1);
+      const Real GInvDc  = Gravity * InvDcEdge(IEdge);
+      const Real Bottom0 = BottomDepth(JCell0);
+      const Real Bottom1 = BottomDepth(JCell1);
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const int K = Kokkos::min(KStart + KVec, KLast);
+         Tend[KVec] -= GInvDc * ((LayerThickCell(JCell1, K) - Bottom1) -
+                                 (LayerThickCell(JCell0, K) - Bottom0));
+      }
+   }
+
+ private:
+   Array2DI4 CellsOnEdge;
+   Array1DMetric InvDcEdge;
+   Array1DR8 BottomDepth;
+};
+
+/// Velocity tendency from the Laplacian viscosity, nu_2 del2(u), where the
+/// Laplacian of the velocity is the gradient of its divergence minus the
+/// curl of its vorticity
+class VelocityDiffusionOnEdge {
+ public:
+   bool Enabled  = false;
+   Real ViscDel2 = 0; ///< Laplacian viscosity (m^2/s)
+
+   VelocityDiffusionOnEdge(const HorzMesh *Mesh);
+
+   KOKKOS_FUNCTION void operator()(Real (&Tend)[VecLength], int IEdge,
+                                   int KChunk, const Array2DReal &DivCell,
+                                   const Array2DReal &RelVortVertex) const {
+      const int KStart   = KChunk * VecLength;
+      const int KLast    = DivCell.extent_int(1) - 1;
+      const int JCell0   = CellsOnEdge(IEdge, 0);
+      const int JCell1   = CellsOnEdge(IEdge, 1);
+      const int JVertex0 = VerticesOnEdge(IEdge, 0);
+      const int JVertex1 = VerticesOnEdge(IEdge, 1);
+      const Real InvDc   = InvDcEdge(IEdge);
+      const Real InvDv   = 1.0_Real / DvEdge(IEdge);
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const int K      = Kokkos::min(KStart + KVec, KLast);
+         const Real Del2U = InvDc * (DivCell(JCell1, K) - DivCell(JCell0, K)) -
+                            InvDv * (RelVortVertex(JVertex1, K) -
+                                     RelVortVertex(JVertex0, K));
+         Tend[KVec] += ViscDel2 * Del2U;
+      }
+   }
+
+ private:
+   Array2DI4 CellsOnEdge;
+   Array2DI4 VerticesOnEdge;
+   Array1DMetric InvDcEdge;
+   Array1DR8 DvEdge;
+};
+
+/// Velocity tendency from the biharmonic viscosity, -nu_4 del4(u), computed
+/// as the Laplacian of the Laplacian of the velocity Del2Edge, which must be
+/// up to date on the first two edge halo layers (see Del4OnEdge)
+class VelocityHyperDiffOnEdge {
+ public:
+   bool Enabled  = false;
+   Real ViscDel4 = 0; ///< biharmonic viscosity (m^4/s)
+
+   VelocityHyperDiffOnEdge(const HorzMesh *Mesh);
+
+   KOKKOS_FUNCTION void operator()(Real (&Tend)[VecLength], int IEdge,
+                                   int KChunk,
+                                   const Array2DReal &Del2Edge) const {
+      Laplacian.add(Tend, IEdge, KChunk, -ViscDel4, Del2Edge);
+   }
+
+ private:
+   VectorLaplacianOnEdge Laplacian;
+};
+
+/// Velocity tendency from quadratic bottom drag, -C_D u |u| / h, with the
+/// speed at the edge estimated from the kinetic energy of the two cells
+class BottomDragOnEdge {
+ public:
+   bool Enabled = false;
+   Real Coeff   = 0; ///< bottom drag coefficient
+
+   BottomDragOnEdge(const HorzMesh *Mesh);
+
+   KOKKOS_FUNCTION void
+   operator()(Real (&Tend)[VecLength], int IEdge, int KChunk,
+              const Array2DReal &NormalVelEdge,
+              const Array2DReal &KineticEnergyCell,
+              const Array2DReal &MeanLayerThickEdge) const {
+      const int KStart = KChunk * VecLength;
+      const int KLast  = NormalVelEdge.extent_int(1) - 1;
+      const int JCell0 = CellsOnEdge(IEdge, 0);
+      const int JCell1 = CellsOnEdge(IEdge, 1);
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const int K      = Kokkos::min(KStart + KVec, KLast);
+         const Real Speed = Kokkos::sqrt(KineticEnergyCell(JCell0, K) +
+                                         KineticEnergyCell(JCell1, K));
+         Tend[KVec] -= Coeff * NormalVelEdge(IEdge, K) * Speed /
+                       MeanLayerThickEdge(IEdge, K);
+      }
+   }
+
+ private:
+   Array2DI4 CellsOnEdge;
+};
+
+/// Choices of the shallow water tendency terms
+struct TendencyOptions {
+   bool ThicknessFluxTendencyEnable = true;    ///< thickness flux divergence
+   bool PVTendencyEnable            = true;    ///< potential vorticity flux
+   bool KETendencyEnable            = true;    ///< kinetic energy gradient
+   bool SSHTendencyEnable           = true;    ///< sea surface height gradient
+   bool VelDiffTendencyEnable       = false;   ///< Laplacian viscosity
+   bool VelHyperDiffTendencyEnable  = false;   ///< biharmonic viscosity
+   bool BottomDragTendencyEnable    = false;   ///< bottom drag
+   R8 ViscDel2                      = 0.0;     ///< Laplacian viscosity
+   R8 ViscDel4                      = 0.0;     ///< biharmonic viscosity
+   R8 BottomDragCoeff               = 0.0;     ///< bottom drag coefficient
+   R8 Gravity                       = 9.80616; ///< gravity (m/s^2)
+};
+
+/// The right-hand sides of the shallow water equations, as the sum of the
+/// enabled tendency terms. The terms are public so that they can be enabled
+/// or disabled and their coefficients changed after creation. Each tendency
+/// is computed with one kernel over the owned elements that sums all enabled
+/// terms, after the auxiliary variables they need are computed. The
+/// biharmonic viscosity adds one loop over the owned edges and one halo
+/// exchange to compute the Laplacian of the velocity.
+class ShallowWaterTendencies : public Tendencies {
+ public:
+   ThicknessFluxDivOnCell ThicknessFluxDiv;
+   PotentialVortHAdvOnEdge PotentialVortHAdv;
+   KEGradOnEdge KEGrad;
+   SSHGradOnEdge SSHGrad;
+   VelocityDiffusionOnEdge VelocityDiffusion;
+   VelocityHyperDiffOnEdge VelocityHyperDiff;
+   BottomDragOnEdge BottomDrag;
+
+   /// Creates the default tendencies on the default mesh, halo and
+   /// auxiliary state, with the options of the Tendencies configuration
+   /// group.
+   /// Returns an error code.
+   static int init(I4 NVertLevels ///< [in] number of vertical levels
+   );
+
+   /// Creates tendencies and stores them under Name. Returns a pointer to
+   /// the new tendencies, or nullptr on error.
+   static ShallowWaterTendencies *
+   create(const std::string &Name,       ///< [in] name of the tendencies
+          const HorzMesh *Mesh,          ///< [in] mesh
+          Halo *MeshHalo,                ///< [in] halo for the mesh
+          AuxiliaryState *AuxState,      ///< [in] auxiliary state
+          I4 NVertLevels,                ///< [in] number of vertical levels
+          const TendencyOptions &Options ///< [in] choice of terms
+   );
+
+   /// Returns the default tendencies
+   static ShallowWaterTendencies *getDefault();
+
+   /// Returns the tendencies Name, or nullptr if they do not exist
+   static ShallowWaterTendencies *get(const std::string &Name ///< [in] name
+   );
+
+   /// Removes the tendencies Name
+   static void erase(const std::string &Name ///< [in] name
+   );
+
+   /// Removes all tendencies
+   static void clear();
+
+   void computeThicknessTendency(const Array2DReal &ThickTend,
+                                 const Array2DReal &NormalVelocity,
+                                 const Array2DReal &LayerThickness,
+                                 const TimeInstant &Time) override;
+
+   void computeVelocityTendency(const Array2DReal &VelTend,
+                                const Array2DReal &NormalVelocity,
+                                const Array2DReal &LayerThickness,
+                                const TimeInstant &Time) override;
+
+   /// The tendencies can be captured in a kernel graph unless the
+   /// biharmonic viscosity, which exchanges halos, is enabled
+   bool canCaptureGraph() const override { return !VelocityHyperDiff.Enabled; }
+
+   /// Returns the number of loops over mesh elements launched so far, not
+   /// counting those of the auxiliary state
+   I4 getNumPasses() const { return NumPasses; }
+
+ private:
+   ShallowWaterTendencies(const std::string &InName, const HorzMesh *InMesh,
+                          Halo *InMeshHalo, AuxiliaryState *InAuxState,
+                          I4 InNVertLevels, const TendencyOptions &Options);
+
+   std::string Name;         ///< name of these tendencies
+   const HorzMesh *Mesh;     ///< mesh the tendencies are computed on
+   AuxiliaryState *AuxState; ///< auxiliary variables used by the terms
+   I4 NVertLevels;           ///< number of vertical levels
+   I4 NChunks;               ///< number of vertical chunks
+   I4 NumPasses;             ///< number of loops launched
+   Del4OnEdge VelDel4;       ///< Laplacian for the biharmonic viscosity
+
+   static ShallowWaterTendencies *DefaultTendencies;
+   static std::map<std::string, std::unique_ptr<ShallowWaterTendencies>>
+       AllTendencies;
+
+}; // end class ShallowWaterTendencies
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_TENDENCYTERMS_H
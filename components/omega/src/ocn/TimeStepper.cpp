@@ -0,0 +1,862 @@
+//===-- ocn/TimeStepper.cpp - time stepping schemes -------------*- C++ -*-===//
+//
+// The schemes update the state on owned elements with fused kernels that
+// compute all the combinations of a stage in one pass over the arrays, then
+// exchange the halos of the arrays needed by the next stage. Halo exchanges
+// use persistent patterns named after the stepper, so their buffers are also
+// allocated once. The kernels are free functions so that the device lambdas
+// are not defined in protected member functions. Every update of a state
+// array is followed by a halo exchange, after which the auxiliary variables
+// are invalidated so that the next tendencies recompute them. With graph
+// capture, the kernels between two exchanges are run by runKernels as one
+// kernel graph, which is captured at the first step and replayed after.
+//
+//===----------------------------------------------------------------------===//
+
+#include "TimeStepper.h"
+#include "AuxiliaryState.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "MemoryTracker.h"
+#include "OceanEnsemble.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <string>
+
+namespace OMEGA {
+
+// Static members
+TimeStepper *TimeStepper::DefaultTimeStepper = nullptr;
+std::map<std::string, std::unique_ptr<TimeStepper>>
+    TimeStepper::AllTimeSteppers;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Fused stage update kernels over the owned elements of an index space. The
+// accumulated state may be an R8 array, in which case the update is computed
+// in double precision also in a single precision build.
+
+// Out = In + Coef * Tend
+template <typename V>
+void updateState(const Array2DReal &Out, const V &In, const Array2DReal &Tend,
+                 typename V::non_const_value_type Coef, I4 NOwned,
+                 I4 NVertLevels) {
+   parallelFor(
+       {NOwned, NVertLevels}, KOKKOS_LAMBDA(int I, int K) {
+          Out(I, K) = In(I, K) + Coef * Tend(I, K);
+       });
+}
+
+// Provis = State + ProvisCoef * Tend and Accum = State + AccumCoef * Tend
+template <typename V>
+void startStages(const Array2DReal &Provis, const V &Accum,
+                 const Array2DReal &State, const Array2DReal &Tend,
+                 Real ProvisCoef, typename V::non_const_value_type AccumCoef,
+                 I4 NOwned, I4 NVertLevels) {
+   parallelFor(
+       {NOwned, NVertLevels}, KOKKOS_LAMBDA(int I, int K) {
+          const Real Val = State(I, K);
+          const Real Tnd = Tend(I, K);
+          Provis(I, K)   = Val + ProvisCoef * Tnd;
+          Accum(I, K)    = Val + AccumCoef * Tnd;
+       });
+}
+
+// Provis = State + ProvisCoef * Tend and Accum += AccumCoef * Tend
+template <typename V>
+void addStage(const Array2DReal &Provis, const V &Accum,
+              const Array2DReal &State, const Array2DReal &Tend,
+              Real ProvisCoef, typename V::non_const_value_type AccumCoef,
+              I4 NOwned, I4 NVertLevels) {
+   parallelFor(
+       {NOwned, NVertLevels}, KOKKOS_LAMBDA(int I, int K) {
+          const Real Tnd = Tend(I, K);
+          Provis(I, K)   = State(I, K) + ProvisCoef * Tnd;
+          Accum(I, K) += AccumCoef * Tnd;
+       });
+}
+
+// Splits the velocity on owned edges into its barotropic (vertical mean) and
+// baroclinic parts. The barotropic velocity and the vertical mean of the
+// slow tendency are stored, the baroclinic velocity at the start of the step
+// is saved in BclVel and the velocity is replaced by the baroclinic velocity
+// advanced with the baroclinic part of the slow tendency.
+void splitVelocity(const Array2DReal &NormalVelocity, const Array2DReal &BclVel,
+                   const Array1DReal &BtrVel, const Array1DReal &BtrVelMean,
+                   const Array1DReal &BtrForcing, const Array2DReal &VelTend,
+                   Real Dt, I4 NEdgesOwned, I4 NVertLevels) {
+   const Real InvNVertLevels = 1.0_Real / NVertLevels;
+   parallelFor(
+       {NEdgesOwned}, KOKKOS_LAMBDA(int IEdge) {
+          R8 MeanVel  = 0;
+          R8 MeanTend = 0;
+          for (int K = 0; K < NVertLevels; ++K) {
+             MeanVel += NormalVelocity(IEdge, K);
+             MeanTend += VelTend(IEdge, K);
+          }
+          MeanVel *= InvNVertLevels;
+          MeanTend *= InvNVertLevels;
+          for (int K = 0; K < NVertLevels; ++K) {
+             const Real Bcl   = NormalVelocity(IEdge, K) - MeanVel;
+             BclVel(IEdge, K) = Bcl;
+             NormalVelocity(IEdge, K) =
+                 Bcl + Dt * (VelTend(IEdge, K) - MeanTend);
+          }
+          BtrVel(IEdge)     = MeanVel;
+          BtrVelMean(IEdge) = 0;
+          BtrForcing(IEdge) = MeanTend;
+       });
+}
+
+// Sums the layer thickness over each owned column
+void sumColumns(const Array1DReal &BtrThick, const Array2DReal &LayerThickness,
+                I4 NCellsOwned, I4 NVertLevels) {
+   parallelFor(
+       {NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+          R8 Sum = 0;
+          for (int K = 0; K < NVertLevels; ++K) {
+             Sum += LayerThickness(ICell, K);
+          }
+          BtrThick(ICell) = Sum;
+       });
+}
+
+// Out += Coef * Tend for a single-level array
+void updateColumns(const Array1DReal &Out, const Array1DReal &Tend, Real Coef,
+                   I4 NOwned) {
+   parallelFor(
+       {NOwned}, KOKKOS_LAMBDA(int I) { Out(I) += Coef * Tend(I); });
+}
+
+// Advances the barotropic velocity on the first NEdges edges with its
+// forcing and fast tendency and adds the new velocity, with weight
+// MeanWeight, to its mean
+void updateBtrVelocity(const Array1DReal &BtrVel,
+                       const Array1DReal &BtrVelMean,
+                       const Array1DReal &BtrForcing,
+                       const Array1DReal &BtrVelTend, Real Dtb,
+                       Real MeanWeight, I4 NEdges) {
+   parallelFor(
+       {NEdges}, KOKKOS_LAMBDA(int IEdge) {
+          const Real Vel =
+              BtrVel(IEdge) + Dtb * (BtrForcing(IEdge) + BtrVelTend(IEdge));
+          BtrVel(IEdge) = Vel;
+          BtrVelMean(IEdge) += MeanWeight * Vel;
+       });
+}
+
+// Adds a single-level value to every level of an array
+void addToLevels(const Array2DReal &Array, const Array1DReal &Value,
+                 I4 NOwned, I4 NVertLevels) {
+   parallelFor(
+       {NOwned, NVertLevels},
+       KOKKOS_LAMBDA(int I, int K) { Array(I, K) += Value(I); });
+}
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// Default barotropic tendency, an error for tendencies that do not provide one
+
+int Tendencies::computeBarotropicTendency(const Array1DReal &BtrVelTend,
+                                          const Array1DReal &BtrThickTend,
+                                          const Array1DReal &BtrVelocity,
+                                          const Array1DReal &BtrThickness,
+                                          const TimeInstant &Time, I4 NCells,
+                                          I4 NEdges) {
+   LOG_ERROR("TimeStepper: barotropic tendency required by the "
+             "split-explicit scheme is not defined");
+   return 1;
+}
+
+//------------------------------------------------------------------------------
+// Create the default time stepper from the configuration
+
+int TimeStepper::init(Tendencies *Tend, // [in] right-hand sides
+                      I4 NVertLevels    // [in] number of vertical levels
+) {
+
+   int Err = 0;
+
+   std::string StepperName = "RungeKutta4";
+   I4 NBtrSubcycles        = 1;
+   I4 NBtrHaloLayers       = 0;
+   bool GraphCapture       = false;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("TimeIntegration")) {
+      Config TimeIntConfig("TimeIntegration");
+      Err = OmegaConfig->get(TimeIntConfig);
+      if (Err != 0) {
+         LOG_ERROR("TimeStepper: error retrieving TimeIntegration "
+                   "configuration");
+         return Err;
+      }
+      if (TimeIntConfig.existsVar("TimeStepperType"))
+         Err += TimeIntConfig.get("TimeStepperType", StepperName);
+      if (TimeIntConfig.existsVar("BarotropicSubcycles"))
+         Err += TimeIntConfig.get("BarotropicSubcycles", NBtrSubcycles);
+      if (TimeIntConfig.existsVar("BarotropicHaloLayers"))
+         Err += TimeIntConfig.get("BarotropicHaloLayers", NBtrHaloLayers);
+      if (TimeIntConfig.existsVar("GraphCapture"))
+         Err += TimeIntConfig.get("GraphCapture", GraphCapture);
+      if (Err != 0) {
+         LOG_ERROR("TimeStepper: error reading TimeIntegration options");
+         return Err;
+      }
+   }
+
+   TimeStepperType Type = getTimeStepperFromStr(StepperName);
+
+   DefaultTimeStepper =
+       create("Default", Type, Tend, HorzMesh::getDefault(),
+              Halo::getDefault(), NVertLevels, NBtrSubcycles);
+   if (DefaultTimeStepper == nullptr) {
+      LOG_ERROR("TimeStepper: error creating default time stepper {}",
+                StepperName);
+      return 1;
+   }
+
+   if (Type == TimeStepperType::SplitExplicit && NBtrHaloLayers > 0) {
+      auto *Split = static_cast<SplitExplicitStepper *>(DefaultTimeStepper);
+      Err += Split->setBtrHaloLayers(NBtrHaloLayers);
+   }
+
+   DefaultTimeStepper->setGraphCapture(GraphCapture);
+
+   return Err;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Create a time stepper of the requested type and store it by name
+
+TimeStepper *TimeStepper::create(const std::string &Name, // [in] name
+                                 TimeStepperType Type,    // [in] scheme
+                                 Tendencies *Tend, // [in] right-hand sides
+                                 HorzMesh *Mesh,   // [in] mesh
+                                 Halo *MeshHalo,   // [in] halo for the mesh
+                                 I4 NVertLevels,   // [in] vertical levels
+                                 I4 NBtrSubcycles  // [in] barotropic substeps
+) {
+
+   if (AllTimeSteppers.find(Name) != AllTimeSteppers.end()) {
+      LOG_ERROR("TimeStepper: attempt to create stepper {} that already "
+                "exists",
+                Name);
+      return nullptr;
+   }
+   if (Tend == nullptr || Mesh == nullptr || MeshHalo == nullptr) {
+      LOG_ERROR("TimeStepper: stepper {} requires tendencies, mesh and halo",
+                Name);
+      return nullptr;
+   }
+
+   MemoryScope Scope("TimeStepper");
+
+   std::unique_ptr<TimeStepper> NewStepper;
+   switch (Type) {
+   case TimeStepperType::ForwardBackward:
+      NewStepper = std::make_unique<ForwardBackwardStepper>(
+          Name, Tend, Mesh, MeshHalo, NVertLevels);
+      break;
+   case TimeStepperType::RungeKutta2:
+      NewStepper = std::make_unique<RungeKutta2Stepper>(Name, Tend, Mesh,
+                                                        MeshHalo, NVertLevels);
+      break;
+   case TimeStepperType::RungeKutta4:
+      NewStepper = std::make_unique<RungeKutta4Stepper>(Name, Tend, Mesh,
+                                                        MeshHalo, NVertLevels);
+      break;
+   case TimeStepperType::SplitExplicit:
+      if (NBtrSubcycles < 1) {
+         LOG_ERROR("TimeStepper: stepper {} needs at least one barotropic "
+                   "subcycle, got {}",
+                   Name, NBtrSubcycles);
+         return nullptr;
+      }
+      NewStepper = std::make_unique<SplitExplicitStepper>(
+          Name, Tend, Mesh, MeshHalo, NVertLevels, NBtrSubcycles);
+      break;
+   default:
+      LOG_ERROR("TimeStepper: unknown time stepper type for stepper {}",
+                Name);
+      return nullptr;
+   }
+
+   TimeStepper *Stepper = NewStepper.get();
+   AllTimeSteppers.emplace(Name, std::move(NewStepper));
+   return Stepper;
+
+} // end create
+
+//------------------------------------------------------------------------------
+// Retrieve, remove and clear time steppers
+
+TimeStepper *TimeStepper::getDefault() { return DefaultTimeStepper; }
+
+TimeStepper *TimeStepper::get(const std::string &Name // [in] stepper name
+) {
+   auto It = AllTimeSteppers.find(Name);
+   if (It == AllTimeSteppers.end()) {
+      LOG_ERROR("TimeStepper: attempt to retrieve non-existent stepper {}",
+                Name);
+      return nullptr;
+   }
+   return It->second.get();
+}
+
+void TimeStepper::erase(const std::string &Name // [in] stepper name
+) {
+   if (DefaultTimeStepper != nullptr && DefaultTimeStepper->Name == Name)
+      DefaultTimeStepper = nullptr;
+   AllTimeSteppers.erase(Name);
+}
+
+void TimeStepper::clear() {
+   DefaultTimeStepper = nullptr;
+   AllTimeSteppers.clear();
+}
+
+//------------------------------------------------------------------------------
+// Construct the base stepper and allocate the tendency buffers
+
+TimeStepper::TimeStepper(const std::string &InName, TimeStepperType InType,
+                         Tendencies *InTend, HorzMesh *InMesh, Halo *InHalo,
+                         I4 InNVertLevels)
+    : Name(InName), Type(InType), Tend(InTend), Mesh(InMesh),
+      MeshHalo(InHalo), NVertLevels(InNVertLevels),
+      VelTend("VelTend" + InName, InMesh->NEdgesSize, InNVertLevels),
+      ThickTend("ThickTend" + InName, InMesh->NCellsSize, InNVertLevels) {}
+
+//------------------------------------------------------------------------------
+// Remove the kernel graphs of the stepper
+
+TimeStepper::~TimeStepper() {
+   for (const auto &GraphName : GraphNames)
+      KernelGraph::erase(GraphName);
+}
+
+//------------------------------------------------------------------------------
+// Enable or disable graph capture
+
+void TimeStepper::setGraphCapture(bool Enable // [in] enable graph capture
+) {
+   GraphCapture = Enable;
+   if (GraphCapture && !Tend->canCaptureGraph())
+      LOG_INFO("TimeStepper: tendencies of stepper {} can not be captured, "
+               "kernels are launched directly",
+               Name);
+}
+
+//------------------------------------------------------------------------------
+// Advance the state by one step of the clock
+
+int TimeStepper::doStep(Array2DReal &NormalVelocity, // [inout] normal vel
+                        Array2DReal &LayerThickness, // [inout] thickness
+                        Clock *ModelClock            // [inout] model clock
+) {
+
+   int Err = 0;
+
+   Timer::start("TimeStepper:doStep");
+
+   const TimeInstant Time      = ModelClock->getCurrentTime();
+   const TimeInterval TimeStep  = ModelClock->getTimeStep();
+
+   Err = advance(NormalVelocity, LayerThickness, Time, TimeStep);
+   if (Err != 0) {
+      LOG_ERROR("TimeStepper: error advancing state with stepper {}", Name);
+   } else {
+      Err = ModelClock->advance();
+      if (Err != 0)
+         LOG_ERROR("TimeStepper: error advancing clock");
+   }
+
+   Timer::stop("TimeStepper:doStep");
+
+   return Err;
+
+} // end doStep
+
+//------------------------------------------------------------------------------
+// Advance all members of an ensemble by one step, then the clock
+
+int TimeStepper::doStep(OceanEnsemble *Ensemble, // [inout] ensemble
+                        Clock *ModelClock        // [inout] model clock
+) {
+
+   int Err = 0;
+
+   Timer::start("TimeStepper:doStep");
+
+   const TimeInstant Time     = ModelClock->getCurrentTime();
+   const TimeInterval TimeStep = ModelClock->getTimeStep();
+
+   for (int Member = 0; Member < Ensemble->getNumMembers(); ++Member) {
+      Array2DReal NormalVelocity;
+      Array2DReal LayerThickness;
+      Err += Ensemble->getMemberNormalVelocity(NormalVelocity, Member);
+      Err += Ensemble->getMemberLayerThickness(LayerThickness, Member);
+      if (Err == 0)
+         Err = advance(NormalVelocity, LayerThickness, Time, TimeStep);
+      if (Err != 0) {
+         LOG_ERROR("TimeStepper: error advancing member {} of ensemble {} "
+                   "with stepper {}",
+                   Member, Ensemble->getName(), Name);
+         break;
+      }
+   }
+
+   if (Err == 0) {
+      Err = ModelClock->advance();
+      if (Err != 0)
+         LOG_ERROR("TimeStepper: error advancing clock");
+   }
+
+   Timer::stop("TimeStepper:doStep");
+
+   return Err;
+
+} // end doStep
+
+//------------------------------------------------------------------------------
+// Exchange the halos of a velocity and thickness pair
+
+int TimeStepper::exchangeState(Array2DReal &NormalVelocity,
+                               Array2DReal &LayerThickness,
+                               const std::string &Pattern) {
+
+   HaloGroup Group("TimeStepper" + Name + Pattern);
+   int Err = Group.add(NormalVelocity, OnEdge);
+   Err += Group.add(LayerThickness, OnCell);
+   Err += MeshHalo->exchangeGroup(Group);
+   if (Err != 0)
+      LOG_ERROR("TimeStepper: error exchanging halos in stepper {}", Name);
+   AuxiliaryState::invalidateAll();
+
+   return Err;
+
+} // end exchangeState
+
+//------------------------------------------------------------------------------
+// Run the kernels of a part of the step, through a kernel graph if enabled
+
+int TimeStepper::runKernels(const std::string &Segment,        // [in] part
+                            const Array2DReal &NormalVelocity, // [in] vel
+                            const Array2DReal &LayerThickness, // [in] thick
+                            R8 Dt,                             // [in] step
+                            const std::function<void()> &Kernels // [in]
+) {
+
+   if (!GraphCapture || !Tend->canCaptureGraph()) {
+      Kernels();
+      return 0;
+   }
+
+   // The time step is part of the kernels, so a new time step makes the
+   // graphs out of date
+   if (Dt != GraphDt) {
+      for (const auto &GraphName : GraphNames)
+         KernelGraph::erase(GraphName);
+      GraphNames.clear();
+      GraphDt = Dt;
+   }
+
+   std::ostringstream Key;
+   Key << "TimeStepper" << Name << Segment << ":" << NormalVelocity.data()
+       << ":" << LayerThickness.data();
+   const std::string GraphName = Key.str();
+
+   // The auxiliary variables are computed by the tendencies only when they
+   // are not valid, so they are invalidated before a capture for their
+   // kernels to be part of the graph
+   if (!KernelGraph::isCaptured(GraphName))
+      AuxiliaryState::invalidateAll();
+   GraphNames.insert(GraphName);
+
+   if (KernelGraph::run(GraphName, Kernels) == 0)
+      return 0;
+
+   // The capture was aborted before any kernel ran and KernelGraph will run
+   // the kernels directly from now on, so they are run directly here too
+   AuxiliaryState::invalidateAll();
+   Kernels();
+
+   return 0;
+
+} // end runKernels
+
+//------------------------------------------------------------------------------
+// Forward-backward scheme
+
+ForwardBackwardStepper::ForwardBackwardStepper(const std::string &InName,
+                                               Tendencies *InTend,
+                                               HorzMesh *InMesh, Halo *InHalo,
+                                               I4 InNVertLevels)
+    : TimeStepper(InName, TimeStepperType::ForwardBackward, InTend, InMesh,
+                  InHalo, InNVertLevels) {}
+
+int ForwardBackwardStepper::advance(Array2DReal &NormalVelocity,
+                                    Array2DReal &LayerThickness,
+                                    const TimeInstant &Time,
+                                    const TimeInterval &TimeStep) {
+
+   R8 Dt;
+   int Err = TimeStep.get(Dt, TimeUnits::Seconds);
+
+   const TimeInstant NewTime = Time + TimeStep;
+
+   // Forward step of the thickness with the current velocity
+   Err += runKernels("Thick", NormalVelocity, LayerThickness, Dt, [&] {
+      Tend->computeThicknessTendency(ThickTend, NormalVelocity,
+                                     LayerThickness, Time);
+      updateState(LayerThickness, LayerThickness, ThickTend, Dt,
+                  Mesh->NCellsOwned, NVertLevels);
+   });
+
+   HaloGroup ThickGroup("TimeStepper" + Name + "Thick");
+   Err += ThickGroup.add(LayerThickness, OnCell);
+   Err += MeshHalo->exchangeGroup(ThickGroup);
+   AuxiliaryState::invalidateAll();
+
+   // Backward step of the velocity with the new thickness
+   Err += runKernels("Vel", NormalVelocity, LayerThickness, Dt, [&] {
+      Tend->computeVelocityTendency(VelTend, NormalVelocity, LayerThickness,
+                                    NewTime);
+      updateState(NormalVelocity, NormalVelocity, VelTend, Dt,
+                  Mesh->NEdgesOwned, NVertLevels);
+   });
+
+   HaloGroup VelGroup("TimeStepper" + Name + "Vel");
+   Err += VelGroup.add(NormalVelocity, OnEdge);
+   Err += MeshHalo->exchangeGroup(VelGroup);
+   AuxiliaryState::invalidateAll();
+
+   return Err;
+
+} // end ForwardBackwardStepper::advance
+
+//------------------------------------------------------------------------------
+// Second-order Runge-Kutta (Heun) scheme
+
+RungeKutta2Stepper::RungeKutta2Stepper(const std::string &InName,
+                                       Tendencies *InTend, HorzMesh *InMesh,
+                                       Halo *InHalo, I4 InNVertLevels)
+    : TimeStepper(InName, TimeStepperType::RungeKutta2, InTend, InMesh, InHalo,
+                  InNVertLevels),
+      ProvisVel("ProvisVel" + InName, InMesh->NEdgesSize, InNVertLevels),
+      ProvisThick("ProvisThick" + InName, InMesh->NCellsSize, InNVertLevels) {}
+
+int RungeKutta2Stepper::advance(Array2DReal &NormalVelocity,
+                                Array2DReal &LayerThickness,
+                                const TimeInstant &Time,
+                                const TimeInterval &TimeStep) {
+
+   R8 Dt;
+   int Err = TimeStep.get(Dt, TimeUnits::Seconds);
+
+   const I4 NCellsOwned = Mesh->NCellsOwned;
+   const I4 NEdgesOwned = Mesh->NEdgesOwned;
+
+   // First stage: the provisional state is a forward Euler step and the
+   // state accumulates half of the first-stage tendency in the same pass
+   Err += runKernels("Stage0", NormalVelocity, LayerThickness, Dt, [&] {
+      Tend->computeThicknessTendency(ThickTend, NormalVelocity,
+                                     LayerThickness, Time);
+      Tend->computeVelocityTendency(VelTend, NormalVelocity, LayerThickness,
+                                    Time);
+      startStages(ProvisThick, LayerThickness, LayerThickness, ThickTend, Dt,
+                  0.5 * Dt, NCellsOwned, NVertLevels);
+      startStages(ProvisVel, NormalVelocity, NormalVelocity, VelTend, Dt,
+                  0.5 * Dt, NEdgesOwned, NVertLevels);
+   });
+   Err += exchangeState(ProvisVel, ProvisThick, "Provis");
+
+   // Second stage at the end of the step
+   const TimeInstant NewTime = Time + TimeStep;
+   Err += runKernels("Stage1", NormalVelocity, LayerThickness, Dt, [&] {
+      Tend->computeThicknessTendency(ThickTend, ProvisVel, ProvisThick,
+                                     NewTime);
+      Tend->computeVelocityTendency(VelTend, ProvisVel, ProvisThick, NewTime);
+      updateState(LayerThickness, LayerThickness, ThickTend, 0.5 * Dt,
+                  NCellsOwned, NVertLevels);
+      updateState(NormalVelocity, NormalVelocity, VelTend, 0.5 * Dt,
+                  NEdgesOwned, NVertLevels);
+   });
+   Err += exchangeState(NormalVelocity, LayerThickness, "State");
+
+   return Err;
+
+} // end RungeKutta2Stepper::advance
+
+//------------------------------------------------------------------------------
+// Classical fourth-order Runge-Kutta scheme
+
+RungeKutta4Stepper::RungeKutta4Stepper(const std::string &InName,
+                                       Tendencies *InTend, HorzMesh *InMesh,
+                                       Halo *InHalo, I4 InNVertLevels)
+    : TimeStepper(InName, TimeStepperType::RungeKutta4, InTend, InMesh, InHalo,
+                  InNVertLevels),
+      ProvisVel("ProvisVel" + InName, InMesh->NEdgesSize, InNVertLevels),
+      ProvisThick("ProvisThick" + InName, InMesh->NCellsSize, InNVertLevels),
+      AccumVel("AccumVel" + InName, InMesh->NEdgesSize, InNVertLevels),
+      AccumThick("AccumThick" + InName, InMesh->NCellsSize, InNVertLevels) {}
+
+int RungeKutta4Stepper::advance(Array2DReal &NormalVelocity,
+                                Array2DReal &LayerThickness,
+                                const TimeInstant &Time,
+                                const TimeInterval &TimeStep) {
+
+   // Coefficients of the provisional states (A), the accumulated new state
+   // (B) and the stage times (C)
+   constexpr R8 RKA[3] = {0.5, 0.5, 1.0};
+   constexpr R8 RKB[4] = {1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0};
+   constexpr R8 RKC[4] = {0.0, 0.5, 0.5, 1.0};
+
+   R8 Dt;
+   int Err = TimeStep.get(Dt, TimeUnits::Seconds);
+
+   const I4 NCellsOwned = Mesh->NCellsOwned;
+   const I4 NEdgesOwned = Mesh->NEdgesOwned;
+
+   // First stage from the state
+   Err += runKernels("Stage0", NormalVelocity, LayerThickness, Dt, [&] {
+      Tend->computeThicknessTendency(ThickTend, NormalVelocity,
+                                     LayerThickness, Time);
+      Tend->computeVelocityTendency(VelTend, NormalVelocity, LayerThickness,
+                                    Time);
+      startStages(ProvisThick, AccumThick, LayerThickness, ThickTend,
+                  RKA[0] * Dt, RKB[0] * Dt, NCellsOwned, NVertLevels);
+      startStages(ProvisVel, AccumVel, NormalVelocity, VelTend, RKA[0] * Dt,
+                  RKB[0] * Dt, NEdgesOwned, NVertLevels);
+   });
+   Err += exchangeState(ProvisVel, ProvisThick, "Provis");
+
+   // Second and third stages from the provisional state
+   for (int Stage = 1; Stage < 3; ++Stage) {
+      const TimeInstant StageTime = Time + TimeStep * RKC[Stage];
+      Err += runKernels(
+          "Stage" + std::to_string(Stage), NormalVelocity, LayerThickness, Dt,
+          [&] {
+             Tend->computeThicknessTendency(ThickTend, ProvisVel, ProvisThick,
+                                            StageTime);
+             Tend->computeVelocityTendency(VelTend, ProvisVel, ProvisThick,
+                                           StageTime);
+             addStage(ProvisThick, AccumThick, LayerThickness, ThickTend,
+                      RKA[Stage] * Dt, RKB[Stage] * Dt, NCellsOwned,
+                      NVertLevels);
+             addStage(ProvisVel, AccumVel, NormalVelocity, VelTend,
+                      RKA[Stage] * Dt, RKB[Stage] * Dt, NEdgesOwned,
+                      NVertLevels);
+          });
+      Err += exchangeState(ProvisVel, ProvisThick, "Provis");
+   }
+
+   // Last stage completes the new state
+   const TimeInstant NewTime = Time + TimeStep;
+   Err += runKernels("Stage3", NormalVelocity, LayerThickness, Dt, [&] {
+      Tend->computeThicknessTendency(ThickTend, ProvisVel, ProvisThick,
+                                     NewTime);
+      Tend->computeVelocityTendency(VelTend, ProvisVel, ProvisThick, NewTime);
+      updateState(LayerThickness, AccumThick, ThickTend, RKB[3] * Dt,
+                  NCellsOwned, NVertLevels);
+      updateState(NormalVelocity, AccumVel, VelTend, RKB[3] * Dt, NEdgesOwned,
+                  NVertLevels);
+   });
+   Err += exchangeState(NormalVelocity, LayerThickness, "State");
+
+   return Err;
+
+} // end RungeKutta4Stepper::advance
+
+//------------------------------------------------------------------------------
+// Split-explicit scheme
+
+SplitExplicitStepper::SplitExplicitStepper(const std::string &InName,
+                                           Tendencies *InTend,
+                                           HorzMesh *InMesh, Halo *InHalo,
+                                           I4 InNVertLevels,
+                                           I4 InNBtrSubcycles)
+    : TimeStepper(InName, TimeStepperType::SplitExplicit, InTend, InMesh,
+                  InHalo, InNVertLevels),
+      NBtrSubcycles(InNBtrSubcycles), BtrHaloLayers(InMesh->HaloWidth),
+      NBtrExchanges(0),
+      TransportVel("TransportVel" + InName, InMesh->NEdgesSize,
+                   InNVertLevels),
+      BtrForcing("BtrForcing" + InName, InMesh->NEdgesSize),
+      BtrVel("BtrVel" + InName, InMesh->NEdgesSize),
+      BtrVelMean("BtrVelMean" + InName, InMesh->NEdgesSize),
+      BtrThick("BtrThick" + InName, InMesh->NCellsSize),
+      BtrVelTend("BtrVelTend" + InName, InMesh->NEdgesSize),
+      BtrThickTend("BtrThickTend" + InName, InMesh->NCellsSize) {}
+
+int SplitExplicitStepper::setBtrHaloLayers(I4 NLayers // [in] halo layers
+) {
+   if (NLayers < 1 || NLayers > Mesh->HaloWidth) {
+      LOG_ERROR("TimeStepper: {} barotropic halo layers requested for "
+                "stepper {}, must be between 1 and the halo width {}",
+                NLayers, Name, Mesh->HaloWidth);
+      return 1;
+   }
+   BtrHaloLayers = NLayers;
+   return 0;
+}
+
+// The halo layer L of the cells ends at NCellsHaloH(L) and contains the
+// neighbors of the cells of layer L-1, so the cells and edges within Depth
+// layers are those that can be updated from values valid within Depth+1
+// layers
+I4 SplitExplicitStepper::cellsInLayers(I4 Depth) const {
+   return Depth == 0 ? Mesh->NCellsOwned : Mesh->NCellsHaloH(Depth - 1);
+}
+
+I4 SplitExplicitStepper::edgesInLayers(I4 Depth) const {
+   return Depth < Mesh->HaloWidth ? Mesh->NEdgesHaloH(Depth) : Mesh->NEdgesAll;
+}
+
+int SplitExplicitStepper::advance(Array2DReal &NormalVelocity,
+                                  Array2DReal &LayerThickness,
+                                  const TimeInstant &Time,
+                                  const TimeInterval &TimeStep) {
+
+   R8 Dt;
+   int Err = TimeStep.get(Dt, TimeUnits::Seconds);
+
+   const I4 NCellsOwned = Mesh->NCellsOwned;
+   const I4 NEdgesOwned = Mesh->NEdgesOwned;
+
+   // Slow tendency and baroclinic velocity update over the full step
+   Err += runKernels("Slow", NormalVelocity, LayerThickness, Dt, [&] {
+      Tend->computeVelocityTendency(VelTend, NormalVelocity, LayerThickness,
+                                    Time);
+      splitVelocity(NormalVelocity, TransportVel, BtrVel, BtrVelMean,
+                    BtrForcing, VelTend, Dt, NEdgesOwned, NVertLevels);
+      sumColumns(BtrThick, LayerThickness, NCellsOwned, NVertLevels);
+   });
+
+   // The barotropic state is exchanged over BtrHaloLayers cell layers and
+   // the edges of these cells, with the forcing at the first exchange only.
+   // The patterns are named after the number of layers, which can change.
+   const I4 NLayers         = BtrHaloLayers;
+   const std::string Suffix = std::to_string(NLayers);
+   HaloGroup BtrStartGroup("TimeStepper" + Name + "BtrStart" + Suffix);
+   HaloGroup BtrGroup("TimeStepper" + Name + "Btr" + Suffix);
+   Err += BtrStartGroup.add(BtrThick, OnCell, NLayers);
+   Err += BtrStartGroup.add(BtrVel, OnEdge, NLayers + 1);
+   Err += BtrStartGroup.add(BtrForcing, OnEdge, NLayers + 1);
+   Err += BtrGroup.add(BtrThick, OnCell, NLayers);
+   Err += BtrGroup.add(BtrVel, OnEdge, NLayers + 1);
+   Err += MeshHalo->exchangeGroup(BtrStartGroup);
+   ++NBtrExchanges;
+
+   // Forward-backward subcycles of the barotropic mode, forced by the
+   // vertical mean of the slow tendency. CellDepth and EdgeDepth are the
+   // halo layers within which the thickness and velocity are valid. Each
+   // update reads one layer beyond the elements it updates, so it is made
+   // one layer shallower than its inputs, and the state is exchanged only
+   // when the update would no longer cover the owned elements.
+   const TimeInterval SubStep = TimeStep / NBtrSubcycles;
+   const Real Dtb             = Dt / NBtrSubcycles;
+   const Real MeanWeight      = 1.0_Real / NBtrSubcycles;
+   TimeInstant SubTime        = Time;
+   I4 CellDepth               = NLayers;
+   I4 EdgeDepth               = NLayers;
+   auto exchangeIfShallow     = [&](I4 &Depth) {
+      if (Depth >= 0)
+         return;
+      Err += MeshHalo->exchangeGroup(BtrGroup);
+      ++NBtrExchanges;
+      CellDepth = NLayers;
+      EdgeDepth = NLayers;
+      Depth     = NLayers - 1;
+   };
+   for (int Sub = 0; Sub < NBtrSubcycles; ++Sub) {
+
+      I4 Depth = std::min(EdgeDepth, CellDepth - 1);
+      exchangeIfShallow(Depth);
+      Err += Tend->computeBarotropicTendency(
+          BtrVelTend, BtrThickTend, BtrVel, BtrThick, SubTime,
+          cellsInLayers(Depth), edgesInLayers(Depth));
+      updateColumns(BtrThick, BtrThickTend, Dtb, cellsInLayers(Depth));
+      CellDepth = Depth;
+
+      SubTime += SubStep;
+      Depth = std::min(CellDepth, EdgeDepth) - 1;
+      exchangeIfShallow(Depth);
+      Err += Tend->computeBarotropicTendency(
+          BtrVelTend, BtrThickTend, BtrVel, BtrThick, SubTime,
+          cellsInLayers(Depth), edgesInLayers(Depth));
+      updateBtrVelocity(BtrVel, BtrVelMean, BtrForcing, BtrVelTend, Dtb,
+                        MeanWeight, edgesInLayers(Depth));
+      EdgeDepth = Depth;
+
+      if (Err != 0)
+         return Err;
+   }
+
+   // Thickness transport by the baroclinic velocity at the start of the step
+   // plus the mean barotropic velocity over the subcycles
+   addToLevels(TransportVel, BtrVelMean, NEdgesOwned, NVertLevels);
+   HaloGroup TransportGroup("TimeStepper" + Name + "Transport");
+   Err += TransportGroup.add(TransportVel, OnEdge);
+   Err += MeshHalo->exchangeGroup(TransportGroup);
+   AuxiliaryState::invalidateAll();
+
+   // Thickness update, and recombination of the baroclinic and final
+   // barotropic velocity
+   Err += runKernels("Final", NormalVelocity, LayerThickness, Dt, [&] {
+      Tend->computeThicknessTendency(ThickTend, TransportVel, LayerThickness,
+                                     Time);
+      updateState(LayerThickness, LayerThickness, ThickTend, Dt, NCellsOwned,
+                  NVertLevels);
+      addToLevels(NormalVelocity, BtrVel, NEdgesOwned, NVertLevels);
+   });
+   Err += exchangeState(NormalVelocity, LayerThickness, "State");
+
+   return Err;
+
+} // end SplitExplicitStepper::advance
+
+//------------------------------------------------------------------------------
+// Utility routine to convert a time stepper name into a TimeStepperType
+
+TimeStepperType getTimeStepperFromStr(const std::string &InType) {
+
+   // convert string to lower case for easier equivalence checking
+   std::string TypeComp = InType;
+   std::transform(TypeComp.begin(), TypeComp.end(), TypeComp.begin(),
+                  [](unsigned char c) { return std::tolower(c); });
+
+   if (TypeComp == "forwardbackward") {
+      return TimeStepperType::ForwardBackward;
+
+   } else if (TypeComp == "rungekutta2") {
+      return TimeStepperType::RungeKutta2;
+
+   } else if (TypeComp == "rungekutta4") {
+      return TimeStepperType::RungeKutta4;
+
+   } else if (TypeComp == "splitexplicit") {
+      return TimeStepperType::SplitExplicit;
+
+   } else {
+      return TimeStepperType::Unknown;
+
+   } // end branch on type string
+
+} // End getTimeStepperFromStr
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,329 @@
+#ifndef OMEGA_TIMESTEPPER_H
+#define OMEGA_TIMESTEPPER_H
+//===-- ocn/TimeStepper.h - time stepping schemes ---------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the explicit time stepping schemes for the ocean model
+///
+/// The TimeStepper classes advance the prognostic normal velocity and layer
+/// thickness by one time step of a model clock. The schemes are
+/// forward-backward, second-order Runge-Kutta (Heun), classical fourth-order
+/// Runge-Kutta and split-explicit with subcycling of the barotropic mode.
+/// The right-hand sides of the equations are supplied by an object derived
+/// from Tendencies, so the schemes are independent of the terms included in
+/// the equations. All stage buffers are allocated when a stepper is created,
+/// and the update of each stage is done by a single fused kernel per index
+/// space, so that a time step does not allocate memory.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "TimeMgr.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace OMEGA {
+
+class OceanEnsemble;
+
+/// Supported time stepping schemes
+enum class TimeStepperType {
+   ForwardBackward, ///< forward-backward
+   RungeKutta2,     ///< second-order Runge-Kutta (Heun)
+   RungeKutta4,     ///< classical fourth-order Runge-Kutta
+   SplitExplicit,   ///< split-explicit with barotropic subcycling
+   Unknown          ///< unknown or undefined
+};
+
+/// Translates a scheme name (eg RungeKutta4) to a TimeStepperType
+TimeStepperType getTimeStepperFromStr(const std::string &InType ///< [in] name
+);
+
+/// Interface for the right-hand sides of the prognostic equations. Each
+/// method computes the tendency on the owned elements of the mesh from
+/// input arrays whose halos are up to date, at the time Time. The
+/// barotropic method is only needed by the split-explicit scheme.
+class Tendencies {
+ public:
+   virtual ~Tendencies() = default;
+
+   /// Computes the layer thickness tendency on owned cells
+   virtual void computeThicknessTendency(
+       const Array2DReal &ThickTend,      ///< [out] thickness tendency
+       const Array2DReal &NormalVelocity, ///< [in] normal velocity
+       const Array2DReal &LayerThickness, ///< [in] layer thickness
+       const TimeInstant &Time            ///< [in] time of the tendency
+       ) = 0;
+
+   /// Computes the normal velocity tendency on owned edges. For the
+   /// split-explicit scheme, this is the slow (baroclinic) tendency that
+   /// excludes the terms treated in the barotropic tendency.
+   virtual void computeVelocityTendency(
+       const Array2DReal &VelTend,        ///< [out] velocity tendency
+       const Array2DReal &NormalVelocity, ///< [in] normal velocity
+       const Array2DReal &LayerThickness, ///< [in] layer thickness
+       const TimeInstant &Time            ///< [in] time of the tendency
+       ) = 0;
+
+   /// Computes the fast tendencies of the barotropic (vertical mean)
+   /// normal velocity on the first NEdges edges and of the total column
+   /// thickness on the first NCells cells. These extend into the halo, since
+   /// the split-explicit scheme takes several substeps between halo
+   /// exchanges on a shrinking region, so the tendency at an element may
+   /// only read the inputs at the cells and edges of the cells next to it.
+   /// Returns an error code; the default returns an error.
+   virtual int computeBarotropicTendency(
+       const Array1DReal &BtrVelTend,   ///< [out] barotropic vel tendency
+       const Array1DReal &BtrThickTend, ///< [out] column thick tendency
+       const Array1DReal &BtrVelocity,  ///< [in] barotropic velocity
+       const Array1DReal &BtrThickness, ///< [in] total column thickness
+       const TimeInstant &Time,         ///< [in] time of the tendency
+       I4 NCells,                       ///< [in] number of cells to compute
+       I4 NEdges                        ///< [in] number of edges to compute
+   );
+
+   /// Returns true if the thickness and velocity tendencies only launch
+   /// kernels with parallelFor, independently of the time, so that a stage
+   /// can be captured in a kernel graph (see KernelGraph). A replayed graph
+   /// reuses the host values seen at capture, so the default is false and
+   /// tendencies opt in once they have been checked not to exchange halos,
+   /// reduce to the host or use time-dependent host values.
+   virtual bool canCaptureGraph() const { return false; }
+};
+
+/// Base class of the time stepping schemes. Steppers are created with
+/// create and retrieved by name, like other Omega objects.
+class TimeStepper {
+
+ public:
+   virtual ~TimeStepper();
+
+   /// Creates the default time stepper from the TimeIntegration group of
+   /// the configuration, on the default mesh and halo. Returns an error
+   /// code.
+   static int init(Tendencies *Tend, ///< [in] right-hand sides
+                   I4 NVertLevels    ///< [in] number of vertical levels
+   );
+
+   /// Creates a time stepper of type Type and stores it under Name.
+   /// Returns a pointer to the new stepper, or nullptr on error.
+   static TimeStepper *
+   create(const std::string &Name, ///< [in] name of the stepper
+          TimeStepperType Type,    ///< [in] scheme
+          Tendencies *Tend,        ///< [in] right-hand sides
+          HorzMesh *Mesh,          ///< [in] mesh
+          Halo *MeshHalo,          ///< [in] halo for the mesh
+          I4 NVertLevels,          ///< [in] number of vertical levels
+          I4 NBtrSubcycles = 1     ///< [in] barotropic substeps per step
+   );
+
+   /// Returns the default time stepper
+   static TimeStepper *getDefault();
+
+   /// Returns the time stepper Name, or nullptr if it does not exist
+   static TimeStepper *get(const std::string &Name ///< [in] stepper name
+   );
+
+   /// Removes the time stepper Name
+   static void erase(const std::string &Name ///< [in] stepper name
+   );
+
+   /// Removes all time steppers
+   static void clear();
+
+   /// Advances NormalVelocity and LayerThickness by one time step of
+   /// ModelClock from its current time, updates their halos and advances
+   /// the clock. Returns an error code.
+   int doStep(Array2DReal &NormalVelocity, ///< [inout] normal velocity
+              Array2DReal &LayerThickness, ///< [inout] layer thickness
+              Clock *ModelClock            ///< [inout] model clock
+   );
+
+   /// Advances every member of an ensemble at its current time level by one
+   /// time step of ModelClock, then advances the clock once. The members
+   /// share the tendencies and stage buffers of this stepper and are
+   /// advanced one after another. Returns an error code.
+   int doStep(OceanEnsemble *Ensemble, ///< [inout] ensemble of states
+              Clock *ModelClock        ///< [inout] model clock
+   );
+
+   /// Returns the scheme of this stepper
+   TimeStepperType getType() const { return Type; }
+
+   /// Returns the name of this stepper
+   const std::string &getName() const { return Name; }
+
+   /// Enables or disables the capture of the kernels of each stage in a
+   /// kernel graph that is replayed at later steps. The halo exchanges
+   /// between stages are not part of the graphs. Capture also requires
+   /// tendencies that can be captured, and the barotropic subcycles of the
+   /// split-explicit scheme are never captured.
+   void setGraphCapture(bool Enable ///< [in] enable graph capture
+   );
+
+   /// Returns true if graph capture is enabled for this stepper
+   bool getGraphCapture() const { return GraphCapture; }
+
+ protected:
+   TimeStepper(const std::string &InName, TimeStepperType InType,
+               Tendencies *InTend, HorzMesh *InMesh, Halo *InHalo,
+               I4 InNVertLevels);
+
+   /// Advances the state from Time by TimeStep, updating the halos of the
+   /// state. Returns an error code.
+   virtual int advance(Array2DReal &NormalVelocity,
+                       Array2DReal &LayerThickness, const TimeInstant &Time,
+                       const TimeInterval &TimeStep) = 0;
+
+   /// Exchanges the halos of a velocity and thickness pair. The Pattern
+   /// names the persistent exchange pattern so that repeated exchanges of
+   /// the same arrays do not allocate buffers.
+   int exchangeState(Array2DReal &NormalVelocity, Array2DReal &LayerThickness,
+                     const std::string &Pattern);
+
+   /// Runs the kernels of the part Segment of a step, between two halo
+   /// exchanges, through a kernel graph when graph capture is enabled. The
+   /// graphs are specific to the state arrays and to the time step Dt,
+   /// which the kernels capture by value, so a state with other arrays, eg.
+   /// another time level, gets its own graphs and a new time step
+   /// recaptures them. Returns an error code.
+   int runKernels(const std::string &Segment,        ///< [in] part of step
+                  const Array2DReal &NormalVelocity, ///< [in] state velocity
+                  const Array2DReal &LayerThickness, ///< [in] state thickness
+                  R8 Dt,                             ///< [in] time step
+                  const std::function<void()> &Kernels ///< [in] kernels
+   );
+
+   std::string Name;      ///< name of this stepper
+   TimeStepperType Type;  ///< scheme of this stepper
+   Tendencies *Tend;      ///< right-hand sides
+   HorzMesh *Mesh;        ///< mesh the state is defined on
+   Halo *MeshHalo;        ///< halo used to update the state
+   I4 NVertLevels;        ///< number of vertical levels
+
+   // Tendency buffers used by all schemes
+   Array2DReal VelTend;   ///< normal velocity tendency
+   Array2DReal ThickTend; ///< layer thickness tendency
+
+   // Kernel graphs of the stages
+   bool GraphCapture{false};         ///< true if stages are captured
+   R8 GraphDt{0};                    ///< time step of the captured graphs
+   std::set<std::string> GraphNames; ///< names of the captured graphs
+
+ private:
+   static TimeStepper *DefaultTimeStepper;
+   static std::map<std::string, std::unique_ptr<TimeStepper>> AllTimeSteppers;
+};
+
+/// Forward-backward scheme: the thickness is advanced with the tendency at
+/// the current state and the velocity with the tendency using the updated
+/// thickness
+class ForwardBackwardStepper : public TimeStepper {
+ public:
+   ForwardBackwardStepper(const std::string &InName, Tendencies *InTend,
+                          HorzMesh *InMesh, Halo *InHalo, I4 InNVertLevels);
+
+ protected:
+   int advance(Array2DReal &NormalVelocity, Array2DReal &LayerThickness,
+               const TimeInstant &Time, const TimeInterval &TimeStep) override;
+};
+
+/// Second-order Runge-Kutta (Heun) scheme
+class RungeKutta2Stepper : public TimeStepper {
+ public:
+   RungeKutta2Stepper(const std::string &InName, Tendencies *InTend,
+                      HorzMesh *InMesh, Halo *InHalo, I4 InNVertLevels);
+
+ protected:
+   int advance(Array2DReal &NormalVelocity, Array2DReal &LayerThickness,
+               const TimeInstant &Time, const TimeInterval &TimeStep) override;
+
+ private:
+   Array2DReal ProvisVel;   ///< provisional normal velocity
+   Array2DReal ProvisThick; ///< provisional layer thickness
+};
+
+/// Classical fourth-order Runge-Kutta scheme. The new state is accumulated
+/// in separate R8 buffers so that the state is only overwritten at the end,
+/// and the stages are combined in double precision in a single precision
+/// build.
+class RungeKutta4Stepper : public TimeStepper {
+ public:
+   RungeKutta4Stepper(const std::string &InName, Tendencies *InTend,
+                      HorzMesh *InMesh, Halo *InHalo, I4 InNVertLevels);
+
+ protected:
+   int advance(Array2DReal &NormalVelocity, Array2DReal &LayerThickness,
+               const TimeInstant &Time, const TimeInterval &TimeStep) override;
+
+ private:
+   Array2DReal ProvisVel;   ///< provisional normal velocity
+   Array2DReal ProvisThick; ///< provisional layer thickness
+   Array2DR8 AccumVel;      ///< accumulated new normal velocity
+   Array2DR8 AccumThick;    ///< accumulated new layer thickness
+};
+
+/// Split-explicit scheme. The baroclinic velocity is advanced with the slow
+/// tendency over the full time step, while the barotropic velocity and
+/// total column thickness are advanced with NBtrSubcycles forward-backward
+/// substeps of the fast barotropic tendency, forced by the vertical mean of
+/// the slow tendency. The layer thickness is then advanced with the
+/// baroclinic velocity plus the time mean of the barotropic velocity over
+/// the substeps. The barotropic state is exchanged over several halo layers
+/// and the substeps are computed on a region that shrinks by one layer per
+/// half substep, so that it is only exchanged again when the region would
+/// no longer cover the owned elements.
+class SplitExplicitStepper : public TimeStepper {
+ public:
+   SplitExplicitStepper(const std::string &InName, Tendencies *InTend,
+                        HorzMesh *InMesh, Halo *InHalo, I4 InNVertLevels,
+                        I4 InNBtrSubcycles);
+
+   /// Returns the number of barotropic substeps per time step
+   I4 getNumSubcycles() const { return NBtrSubcycles; }
+
+   /// Sets the number of cell halo layers filled by each exchange of the
+   /// barotropic state, between 1 and the halo width of the mesh, which is
+   /// the default. Returns an error code.
+   int setBtrHaloLayers(I4 NLayers ///< [in] halo layers to exchange
+   );
+
+   /// Returns the number of cell halo layers of the barotropic exchanges
+   I4 getBtrHaloLayers() const { return BtrHaloLayers; }
+
+   /// Returns the number of barotropic halo exchanges made so far
+   I4 getNumBtrExchanges() const { return NBtrExchanges; }
+
+ protected:
+   int advance(Array2DReal &NormalVelocity, Array2DReal &LayerThickness,
+               const TimeInstant &Time, const TimeInterval &TimeStep) override;
+
+ private:
+   /// Number of owned cells and cells in the first Depth halo layers
+   I4 cellsInLayers(I4 Depth) const;
+
+   /// Number of edges of the cells in cellsInLayers(Depth)
+   I4 edgesInLayers(I4 Depth) const;
+
+   I4 NBtrSubcycles;         ///< barotropic substeps per time step
+   I4 BtrHaloLayers;         ///< cell halo layers of barotropic exchanges
+   I4 NBtrExchanges;         ///< number of barotropic exchanges made
+   Array2DReal TransportVel; ///< velocity for the thickness transport
+   Array1DReal BtrForcing;   ///< vertical mean of the slow tendency
+   Array1DReal BtrVel;       ///< barotropic velocity
+   Array1DReal BtrVelMean;   ///< time mean of the barotropic velocity
+   Array1DReal BtrThick;     ///< total column thickness
+   Array1DReal BtrVelTend;   ///< barotropic velocity tendency
+   Array1DReal BtrThickTend; ///< column thickness tendency
+};
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_TIMESTEPPER_H
@@ -0,0 +1,439 @@
+//===-- ocn/Tracers.cpp - tracer definitions and storage --------*- C++ -*-===//
+//
+// Tracers are defined in TracerDefs.inc before the selection is applied,
+// since a tracer may be selected through a group it is added to after its
+// definition. The selection is resolved in organize, which numbers the
+// selected tracers in definition order so that the members of a group that
+// are defined together have contiguous indices.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Tracers.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MemoryTracker.h"
+#include "MetaData.h"
+#include "OmegaKokkos.h"
+
+#include <algorithm>
+#include <set>
+
+namespace OMEGA {
+
+// Static members
+std::vector<Tracers::TracerDef> Tracers::Definitions;
+std::map<std::string, std::vector<std::string>> Tracers::DefinedGroups;
+I4 Tracers::NumTracers = 0;
+std::vector<Array3DReal> Tracers::AllTracers;
+std::map<std::string, I4> Tracers::Index;
+std::vector<std::string> Tracers::Names;
+std::map<std::string, std::vector<I4>> Tracers::Groups;
+std::map<std::string, std::vector<bool>> Tracers::MemberFlag;
+std::map<std::string, Array1DI4> Tracers::GroupIndices;
+
+//------------------------------------------------------------------------------
+// Initialize the tracers selected in the configuration
+
+int Tracers::init(I4 NVertLevels, // [in] number of vertical levels
+                  I4 NTimeLevels  // [in] number of time levels
+) {
+
+   int Err = 0;
+
+   std::vector<std::string> Selection = {"Base"};
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsVar("Tracers")) {
+      Selection.clear();
+      Err = OmegaConfig->get("Tracers", Selection);
+      if (Err != 0) {
+         LOG_ERROR("Tracers: error reading the Tracers selection list");
+         return Err;
+      }
+   }
+
+   return init(Selection, NVertLevels, NTimeLevels);
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Initialize the tracers and groups named in Selection
+
+int Tracers::init(const std::vector<std::string> &Selection, // [in] list
+                  I4 NVertLevels, // [in] number of vertical levels
+                  I4 NTimeLevels  // [in] number of time levels
+) {
+
+   int Err = 0;
+
+   if (NumTracers > 0 || !Definitions.empty()) {
+      LOG_ERROR("Tracers: tracers already initialized");
+      return 1;
+   }
+   if (NTimeLevels < 1) {
+      LOG_ERROR("Tracers: need at least one time level, got {}", NTimeLevels);
+      return 1;
+   }
+
+   // Define all supported tracers
+#include "TracerDefs.inc"
+
+   if (Err != 0) {
+      LOG_ERROR("Tracers: error defining tracers");
+      return Err;
+   }
+
+   Err = organize(Selection);
+   if (Err != 0)
+      return Err;
+
+   // Allocate the packed storage for each time level
+   MemoryScope Scope("Tracers");
+   HorzMesh *DefMesh = HorzMesh::getDefault();
+   AllTracers.clear();
+   for (int Level = 0; Level < NTimeLevels; ++Level) {
+      AllTracers.emplace_back("Tracers" + std::to_string(Level), NumTracers,
+                              DefMesh->NCellsSize, NVertLevels);
+   }
+
+   // Register the selected tracers for IO
+   Decomp *DefDecomp = Decomp::getDefault();
+   std::shared_ptr<MetaDim> CellDim;
+   std::shared_ptr<MetaDim> VertDim;
+   if (MetaDim::has("NCells")) {
+      CellDim = MetaDim::get("NCells");
+   } else {
+      CellDim = MetaDim::create("NCells", DefDecomp->NCellsGlobal);
+   }
+   if (MetaDim::has("NVertLevels")) {
+      VertDim = MetaDim::get("NVertLevels");
+   } else {
+      VertDim = MetaDim::create("NVertLevels", NVertLevels);
+   }
+   for (const TracerDef &Def : Definitions) {
+      if (Index.find(Def.Name) == Index.end())
+         continue;
+      auto Meta = ArrayMetaData::create(
+          Def.Name, Def.Description, Def.Units, Def.StdName, Def.ValidMin,
+          Def.ValidMax, Def.FillValue, 2, {CellDim, VertDim});
+      if (Meta == nullptr || IOField::define(Def.Name) != 0) {
+         LOG_ERROR("Tracers: error registering tracer {} for IO", Def.Name);
+         ++Err;
+      }
+   }
+   Err += attachIOData();
+
+   LOG_INFO("Tracers: {} tracers selected with {} time levels", NumTracers,
+            NTimeLevels);
+
+   return Err;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Define a supported tracer
+
+int Tracers::define(const std::string &Name,        // [in] tracer name
+                    const std::string &Description, // [in] long name
+                    const std::string &Units,       // [in] units
+                    const std::string &StdName,     // [in] CF standard name
+                    Real ValidMin,                  // [in] min valid value
+                    Real ValidMax,                  // [in] max valid value
+                    Real FillValue                  // [in] fill value
+) {
+
+   for (const TracerDef &Def : Definitions) {
+      if (Def.Name == Name) {
+         LOG_ERROR("Tracers: tracer {} defined more than once", Name);
+         return 1;
+      }
+   }
+
+   Definitions.push_back(
+       {Name, Description, Units, StdName, ValidMin, ValidMax, FillValue});
+
+   return 0;
+
+} // end define
+
+//------------------------------------------------------------------------------
+// Add a defined tracer to a group
+
+int Tracers::addToGroup(const std::string &GroupName, // [in] group name
+                        const std::string &TracerName // [in] tracer name
+) {
+
+   bool Defined = std::any_of(
+       Definitions.begin(), Definitions.end(),
+       [&TracerName](const TracerDef &Def) { return Def.Name == TracerName; });
+   if (!Defined) {
+      LOG_ERROR("Tracers: can not add undefined tracer {} to group {}",
+                TracerName, GroupName);
+      return 1;
+   }
+
+   std::vector<std::string> &Members = DefinedGroups[GroupName];
+   if (std::find(Members.begin(), Members.end(), TracerName) == Members.end())
+      Members.push_back(TracerName);
+
+   return 0;
+
+} // end addToGroup
+
+//------------------------------------------------------------------------------
+// Select the tracers, assign indices and build the groups
+
+int Tracers::organize(const std::vector<std::string> &Selection) {
+
+   int Err = 0;
+
+   // Expand the selected groups into tracer names
+   std::set<std::string> Selected;
+   for (const std::string &Item : Selection) {
+      auto Group = DefinedGroups.find(Item);
+      if (Group != DefinedGroups.end()) {
+         Selected.insert(Group->second.begin(), Group->second.end());
+      } else if (std::any_of(Definitions.begin(), Definitions.end(),
+                             [&Item](const TracerDef &Def) {
+                                return Def.Name == Item;
+                             })) {
+         Selected.insert(Item);
+      } else {
+         LOG_ERROR("Tracers: selected tracer or group {} is not defined",
+                   Item);
+         ++Err;
+      }
+   }
+   if (Err != 0)
+      return Err;
+
+   // Number the selected tracers in definition order
+   Index.clear();
+   Names.clear();
+   for (const TracerDef &Def : Definitions) {
+      if (Selected.count(Def.Name) > 0) {
+         Index[Def.Name] = Names.size();
+         Names.push_back(Def.Name);
+      }
+   }
+   NumTracers = Names.size();
+
+   // Keep the selected members of each group, plus the All group
+   Groups.clear();
+   MemberFlag.clear();
+   GroupIndices.clear();
+   for (const auto &[GroupName, Members] : DefinedGroups) {
+      std::vector<I4> Indices;
+      for (const std::string &Member : Members) {
+         auto It = Index.find(Member);
+         if (It != Index.end())
+            Indices.push_back(It->second);
+      }
+      if (Indices.empty())
+         continue;
+      std::sort(Indices.begin(), Indices.end());
+      Groups[GroupName] = Indices;
+   }
+   if (NumTracers > 0) {
+      std::vector<I4> AllIndices(NumTracers);
+      for (int I = 0; I < NumTracers; ++I)
+         AllIndices[I] = I;
+      Groups["All"] = AllIndices;
+   }
+
+   MemoryScope Scope("Tracers");
+   for (const auto &[GroupName, Indices] : Groups) {
+      std::vector<bool> Flags(NumTracers, false);
+      HostArray1DI4 IndicesH("GroupIndices" + GroupName, Indices.size());
+      for (int I = 0; I < Indices.size(); ++I) {
+         Flags[Indices[I]] = true;
+         IndicesH(I)       = Indices[I];
+      }
+      MemberFlag[GroupName]   = Flags;
+      GroupIndices[GroupName] = createDeviceMirrorCopy(IndicesH);
+   }
+
+   return Err;
+
+} // end organize
+
+//------------------------------------------------------------------------------
+// Attach the current time level of each tracer to its IO field. IO requires
+// contiguous arrays, which single tracers are only in the LAYOUT_RIGHT order.
+
+int Tracers::attachIOData() {
+
+   int Err = 0;
+
+#ifdef OMEGA_LAYOUT_RIGHT
+   for (int I = 0; I < NumTracers; ++I) {
+      Array2DReal Tracer =
+          Kokkos::subview(AllTracers[0], I, Kokkos::ALL, Kokkos::ALL);
+      Err += IOField::attachData<Array2DReal>(Names[I], Tracer);
+   }
+#endif
+
+   return Err;
+
+} // end attachIOData
+
+//------------------------------------------------------------------------------
+// Retrieve tracer counts, names and indices
+
+I4 Tracers::getNumTracers() { return NumTracers; }
+
+I4 Tracers::getNumTimeLevels() { return AllTracers.size(); }
+
+I4 Tracers::getIndex(const std::string &TracerName // [in] tracer name
+) {
+   auto It = Index.find(TracerName);
+   return It == Index.end() ? -1 : It->second;
+}
+
+std::string Tracers::getName(I4 TracerIndex // [in] tracer index
+) {
+   if (TracerIndex < 0 || TracerIndex >= NumTracers) {
+      LOG_ERROR("Tracers: tracer index {} out of range", TracerIndex);
+      return "";
+   }
+   return Names[TracerIndex];
+}
+
+//------------------------------------------------------------------------------
+// Retrieve tracer arrays
+
+Array3DReal Tracers::getAll(I4 TimeLevel // [in] time level
+) {
+   if (TimeLevel < 0 || TimeLevel >= getNumTimeLevels()) {
+      LOG_ERROR("Tracers: time level {} out of range", TimeLevel);
+      return Array3DReal();
+   }
+   return AllTracers[TimeLevel];
+}
+
+TracerArray2D Tracers::get(I4 TracerIndex, // [in] tracer index
+                           I4 TimeLevel    // [in] time level
+) {
+   if (TracerIndex < 0 || TracerIndex >= NumTracers) {
+      LOG_ERROR("Tracers: tracer index {} out of range", TracerIndex);
+      return TracerArray2D();
+   }
+   Array3DReal Level = getAll(TimeLevel);
+   if (Level.size() == 0)
+      return TracerArray2D();
+   return Kokkos::subview(Level, TracerIndex, Kokkos::ALL, Kokkos::ALL);
+}
+
+//------------------------------------------------------------------------------
+// Retrieve group members
+
+std::vector<I4> Tracers::getGroup(const std::string &GroupName // [in] group
+) {
+   auto It = Groups.find(GroupName);
+   return It == Groups.end() ? std::vector<I4>() : It->second;
+}
+
+Array1DI4 Tracers::getGroupIndices(const std::string &GroupName // [in] group
+) {
+   auto It = GroupIndices.find(GroupName);
+   return It == GroupIndices.end() ? Array1DI4() : It->second;
+}
+
+int Tracers::getGroupRange(const std::string &GroupName, // [in] group
+                           I4 &FirstIndex, // [out] first tracer index
+                           I4 &Count       // [out] number of tracers
+) {
+   auto It = Groups.find(GroupName);
+   if (It == Groups.end()) {
+      LOG_ERROR("Tracers: group {} has no selected tracers", GroupName);
+      return 1;
+   }
+   const std::vector<I4> &Indices = It->second;
+   const I4 NIndices              = Indices.size();
+   if (Indices.back() - Indices.front() + 1 != NIndices) {
+      LOG_ERROR("Tracers: indices of group {} are not contiguous", GroupName);
+      return 2;
+   }
+   FirstIndex = Indices.front();
+   Count      = NIndices;
+   return 0;
+}
+
+bool Tracers::isMember(I4 TracerIndex,              // [in] tracer index
+                       const std::string &GroupName // [in] group name
+) {
+   auto It = MemberFlag.find(GroupName);
+   if (It == MemberFlag.end() || TracerIndex < 0 ||
+       TracerIndex >= NumTracers)
+      return false;
+   return It->second[TracerIndex];
+}
+
+//------------------------------------------------------------------------------
+// Exchange the halos of all tracers in one message per neighbor
+
+int Tracers::exchangeHalo(I4 TimeLevel // [in] time level
+) {
+
+   Array3DReal Level = getAll(TimeLevel);
+   if (Level.size() == 0)
+      return 1;
+
+   HaloGroup Group("Tracers");
+   int Err = Group.add(Level, OnCell);
+   Err += Halo::getDefault()->exchangeGroup(Group);
+   if (Err != 0)
+      LOG_ERROR("Tracers: error exchanging tracer halos");
+
+   return Err;
+
+} // end exchangeHalo
+
+//------------------------------------------------------------------------------
+// Rotate the time levels so that the next time level becomes current
+
+void Tracers::updateTimeLevels() {
+
+   if (AllTracers.size() < 2)
+      return;
+
+   std::rotate(AllTracers.begin(), AllTracers.begin() + 1, AllTracers.end());
+   attachIOData();
+
+} // end updateTimeLevels
+
+//------------------------------------------------------------------------------
+// Remove all tracers
+
+int Tracers::clear() {
+
+   int Err = 0;
+
+   for (const std::string &TracerName : Names) {
+      IOField::erase(TracerName);
+      if (MetaData::has(TracerName))
+         Err += MetaData::destroy(TracerName);
+   }
+
+   Definitions.clear();
+   DefinedGroups.clear();
+   NumTracers = 0;
+   AllTracers.clear();
+   Index.clear();
+   Names.clear();
+   Groups.clear();
+   MemberFlag.clear();
+   GroupIndices.clear();
+
+   return Err;
+
+} // end clear
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,182 @@
+#ifndef OMEGA_TRACERS_H
+#define OMEGA_TRACERS_H
+//===-- ocn/Tracers.h - tracer definitions and storage ----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the tracer container
+///
+/// The Tracers class defines all supported tracers and their groups and
+/// stores the tracers selected for a simulation in a single packed array
+/// for each time level, indexed as (tracer, cell, vertical level). Packing
+/// all tracers together allows kernels to parallelize over the tracer and
+/// cell dimensions in one launch and the halos of all tracers to be
+/// exchanged in one message per neighbor, rather than one launch and one
+/// exchange per tracer. The memory order of the packed array follows the
+/// Omega memory layout (OMEGA_LAYOUT_RIGHT or OMEGA_LAYOUT_LEFT), so it is
+/// contiguous in the vertical on CPUs and in the tracer index on GPUs.
+/// Changing time levels at the end of a step only swaps the array handles.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// A single tracer at one time level, as a (cell, vertical level) view into
+/// the packed tracer array. It is strided in the LAYOUT_LEFT memory order.
+using TracerArray2D = Kokkos::View<Real **, Kokkos::LayoutStride, MemSpace>;
+
+/// The Tracers class holds the definitions, groups and storage of all
+/// tracers. All members are static since there is one set of tracers.
+class Tracers {
+
+ public:
+   /// Initializes the tracers selected in the Tracers list of the
+   /// configuration (the Base group if absent) on the default mesh. All
+   /// supported tracers are defined by including TracerDefs.inc. Returns an
+   /// error code.
+   static int init(I4 NVertLevels,    ///< [in] number of vertical levels
+                   I4 NTimeLevels = 2 ///< [in] number of time levels
+   );
+
+   /// Initializes the tracers and groups named in Selection on the default
+   /// mesh. Returns an error code.
+   static int init(const std::vector<std::string> &Selection, ///< [in] list
+                   I4 NVertLevels,    ///< [in] number of vertical levels
+                   I4 NTimeLevels = 2 ///< [in] number of time levels
+   );
+
+   /// Defines a supported tracer and its metadata. Only tracers that are
+   /// selected, by name or through one of their groups, are given an index
+   /// and storage at the end of init. Returns an error code.
+   static int define(const std::string &Name,        ///< [in] tracer name
+                     const std::string &Description, ///< [in] long name
+                     const std::string &Units,       ///< [in] units
+                     const std::string &StdName,     ///< [in] CF standard name
+                     Real ValidMin,                  ///< [in] min valid value
+                     Real ValidMax,                  ///< [in] max valid value
+                     Real FillValue ///< [in] value for undefined entries
+   );
+
+   /// Adds a defined tracer to a group, creating the group if needed.
+   /// Returns an error code.
+   static int addToGroup(const std::string &GroupName, ///< [in] group name
+                         const std::string &TracerName ///< [in] tracer name
+   );
+
+   /// Returns the number of selected tracers
+   static I4 getNumTracers();
+
+   /// Returns the number of time levels
+   static I4 getNumTimeLevels();
+
+   /// Returns the index of a selected tracer, or -1 if it is not selected
+   static I4 getIndex(const std::string &TracerName ///< [in] tracer name
+   );
+
+   /// Returns the name of the tracer with index TracerIndex
+   static std::string getName(I4 TracerIndex ///< [in] tracer index
+   );
+
+   /// Returns the packed array of all tracers at a time level, where time
+   /// level 0 is the current time and 1 the next time
+   static Array3DReal getAll(I4 TimeLevel = 0 ///< [in] time level
+   );
+
+   /// Returns a single tracer at a time level
+   static TracerArray2D get(I4 TracerIndex,  ///< [in] tracer index
+                            I4 TimeLevel = 0 ///< [in] time level
+   );
+
+   /// Returns the indices of the selected tracers in a group, in increasing
+   /// order, or an empty vector if the group has no selected tracers
+   static std::vector<I4> getGroup(const std::string &GroupName ///< [in]
+   );
+
+   /// Returns the indices of the tracers in a group as a device array for
+   /// use in kernels, or an empty array if the group has no selected tracers
+   static Array1DI4 getGroupIndices(const std::string &GroupName ///< [in]
+   );
+
+   /// Retrieves the first index and number of tracers of a group whose
+   /// indices are contiguous, so that the group can be processed as a range
+   /// of the packed array. Returns an error code if the group does not
+   /// exist or is not contiguous.
+   static int getGroupRange(const std::string &GroupName, ///< [in] group
+                            I4 &FirstIndex, ///< [out] first tracer index
+                            I4 &Count       ///< [out] number of tracers
+   );
+
+   /// Returns true if the tracer TracerIndex is a member of a group
+   static bool isMember(I4 TracerIndex,              ///< [in] tracer index
+                        const std::string &GroupName ///< [in] group name
+   );
+
+   /// Exchanges the halos of all tracers at a time level in one message per
+   /// neighbor using the default halo. Returns an error code.
+   static int exchangeHalo(I4 TimeLevel = 0 ///< [in] time level
+   );
+
+   /// Advances the time levels by one: the next time level becomes the
+   /// current one and the storage of the current time level is reused for
+   /// the last one. Only the array handles are swapped.
+   static void updateTimeLevels();
+
+   /// Removes all tracer definitions, groups and storage. Returns an error
+   /// code.
+   static int clear();
+
+ private:
+   /// Metadata of a defined tracer
+   struct TracerDef {
+      std::string Name;
+      std::string Description;
+      std::string Units;
+      std::string StdName;
+      Real ValidMin;
+      Real ValidMax;
+      Real FillValue;
+   };
+
+   /// Selects the tracers, numbers them in definition order and keeps the
+   /// selected members of each group. Returns an error code.
+   static int organize(const std::vector<std::string> &Selection);
+
+   /// Attaches the current time level of each tracer to its IO field
+   static int attachIOData();
+
+   /// Definitions of all supported tracers, in definition order
+   static std::vector<TracerDef> Definitions;
+
+   /// Groups of defined tracers, by name, before selection
+   static std::map<std::string, std::vector<std::string>> DefinedGroups;
+
+   /// Number of selected tracers
+   static I4 NumTracers;
+
+   /// Packed storage of the selected tracers for each time level
+   static std::vector<Array3DReal> AllTracers;
+
+   /// Maps between the names and indices of selected tracers
+   static std::map<std::string, I4> Index;
+   static std::vector<std::string> Names;
+
+   /// Indices of the selected tracers in each group
+   static std::map<std::string, std::vector<I4>> Groups;
+
+   /// Flags, for each group, if each selected tracer is a member
+   static std::map<std::string, std::vector<bool>> MemberFlag;
+
+   /// Device copies of the group indices
+   static std::map<std::string, Array1DI4> GroupIndices;
+
+}; // end class Tracers
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_TRACERS_H
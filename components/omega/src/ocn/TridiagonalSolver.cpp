@@ -0,0 +1,206 @@
+//===-- ocn/TridiagonalSolver.cpp - vertical tridiagonal solver -*- C++ -*-===//
+//
+// The forward sweep of the Thomas algorithm normalizes each row by its pivot
+// and eliminates the subdiagonal, and the backward sweep substitutes from the
+// bottom of the column. The factored superdiagonal is the only quantity of
+// the factorization needed by the backward sweep and is kept in a scratch
+// array; with several right-hand sides the inverse pivots are kept as well,
+// so that the factorization is shared by all right-hand sides.
+//
+//===----------------------------------------------------------------------===//
+
+#include "TridiagonalSolver.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Constructor
+
+TridiagonalSolver::TridiagonalSolver(
+    const std::string &InName, // [in] name of the solver
+    I4 InNColumns,             // [in] max number of columns
+    I4 InNVertLevels           // [in] number of levels
+    )
+    : Name(InName), NColumns(InNColumns), NVertLevels(InNVertLevels) {
+
+   MemoryScope Scope("TridiagonalSolver");
+   UpperFac = Array2DReal("UpperFac" + Name, NColumns, NVertLevels);
+   InvPivot = Array2DReal("InvPivot" + Name, NColumns, NVertLevels);
+
+} // end TridiagonalSolver constructor
+
+//------------------------------------------------------------------------------
+// Checks the extents of the arrays of a solve
+
+int TridiagonalSolver::checkExtents(const Array2DReal &Lower,
+                                    const Array2DReal &Diag,
+                                    const Array2DReal &Upper, I4 XCols,
+                                    I4 XLevels, I4 NCols) const {
+
+   int Err = 0;
+
+   if (NCols > NColumns) {
+      LOG_ERROR("TridiagonalSolver: {} columns requested in {} but it was "
+                "constructed for {}",
+                NCols, Name, NColumns);
+      ++Err;
+   }
+
+   const Array2DReal *Coeffs[] = {&Lower, &Diag, &Upper};
+   for (const Array2DReal *Coeff : Coeffs) {
+      if (Coeff->extent_int(0) < NCols ||
+          Coeff->extent_int(1) != NVertLevels) {
+         LOG_ERROR("TridiagonalSolver: coefficient array {} has the wrong "
+                   "extents for {}",
+                   Coeff->label(), Name);
+         ++Err;
+      }
+   }
+
+   if (XCols < NCols || XLevels != NVertLevels) {
+      LOG_ERROR("TridiagonalSolver: right-hand side has the wrong extents "
+                "for {}",
+                Name);
+      ++Err;
+   }
+
+   return Err;
+
+} // end checkExtents
+
+//------------------------------------------------------------------------------
+// Solves for one right-hand side with one column per thread
+
+int TridiagonalSolver::solve(const Array2DReal &Lower, // [in] subdiagonal
+                             const Array2DReal &Diag,  // [in] diagonal
+                             const Array2DReal &Upper, // [in] superdiagonal
+                             const Array2DReal &X,     // [inout] rhs, solution
+                             I4 NCols // [in] number of columns to solve
+) const {
+
+   int Err = checkExtents(Lower, Diag, Upper, X.extent_int(0),
+                          X.extent_int(1), NCols);
+   if (Err != 0)
+      return Err;
+
+   OMEGA_SCOPE(LocUpperFac, UpperFac);
+   const I4 NLevels = NVertLevels;
+
+   parallelFor(
+       "TridiagonalSolver:thread", {NCols}, KOKKOS_LAMBDA(int ICol) {
+          // Forward elimination, keeping the factored superdiagonal of the
+          // level above in a register
+          Real Inv             = 1 / Diag(ICol, 0);
+          Real PrevUpper       = Upper(ICol, 0) * Inv;
+          LocUpperFac(ICol, 0) = PrevUpper;
+          X(ICol, 0) *= Inv;
+          for (int K = 1; K < NLevels; ++K) {
+             Inv = 1 / (Diag(ICol, K) - Lower(ICol, K) * PrevUpper);
+             PrevUpper            = Upper(ICol, K) * Inv;
+             LocUpperFac(ICol, K) = PrevUpper;
+             X(ICol, K) = (X(ICol, K) - Lower(ICol, K) * X(ICol, K - 1)) * Inv;
+          }
+
+          // Back substitution
+          for (int K = NLevels - 2; K >= 0; --K)
+             X(ICol, K) -= LocUpperFac(ICol, K) * X(ICol, K + 1);
+       });
+
+   return 0;
+
+} // end solve (one right-hand side)
+
+//------------------------------------------------------------------------------
+// Solves for several right-hand sides sharing one factorization
+
+int TridiagonalSolver::solve(const Array2DReal &Lower, // [in] subdiagonal
+                             const Array2DReal &Diag,  // [in] diagonal
+                             const Array2DReal &Upper, // [in] superdiagonal
+                             const Array3DReal &X,     // [inout] rhs, solution
+                             I4 NCols,              // [in] columns to solve
+                             ColumnParallelism Par  // [in] distribution
+) const {
+
+   int Err = checkExtents(Lower, Diag, Upper, X.extent_int(1),
+                          X.extent_int(2), NCols);
+   if (Err != 0)
+      return Err;
+
+   OMEGA_SCOPE(LocUpperFac, UpperFac);
+   OMEGA_SCOPE(LocInvPivot, InvPivot);
+   const I4 NLevels = NVertLevels;
+   const I4 NRhs    = X.extent_int(0);
+
+   if (Par == ColumnParallelism::Thread) {
+
+      // Each thread factors its column and eliminates all right-hand sides
+      // of the column in the same sweep
+      parallelFor(
+          "TridiagonalSolver:threadMulti", {NCols}, KOKKOS_LAMBDA(int ICol) {
+             Real Inv             = 1 / Diag(ICol, 0);
+             Real PrevUpper       = Upper(ICol, 0) * Inv;
+             LocUpperFac(ICol, 0) = PrevUpper;
+             for (int N = 0; N < NRhs; ++N)
+                X(N, ICol, 0) *= Inv;
+             for (int K = 1; K < NLevels; ++K) {
+                const Real LowerK = Lower(ICol, K);
+                Inv = 1 / (Diag(ICol, K) - LowerK * PrevUpper);
+                PrevUpper            = Upper(ICol, K) * Inv;
+                LocUpperFac(ICol, K) = PrevUpper;
+                for (int N = 0; N < NRhs; ++N)
+                   X(N, ICol, K) =
+                       (X(N, ICol, K) - LowerK * X(N, ICol, K - 1)) * Inv;
+             }
+
+             for (int K = NLevels - 2; K >= 0; --K) {
+                const Real UpperK = LocUpperFac(ICol, K);
+                for (int N = 0; N < NRhs; ++N)
+                   X(N, ICol, K) -= UpperK * X(N, ICol, K + 1);
+             }
+          });
+
+   } else {
+
+      // One thread of each team factors the column, then the right-hand
+      // sides are eliminated in parallel over the threads of the team
+      parallelForTeam(
+          "TridiagonalSolver:team", NCols,
+          KOKKOS_LAMBDA(const TeamMember &Member) {
+             const int ICol = Member.league_rank();
+
+             Kokkos::single(Kokkos::PerTeam(Member), [&]() {
+                Real Inv             = 1 / Diag(ICol, 0);
+                LocInvPivot(ICol, 0) = Inv;
+                LocUpperFac(ICol, 0) = Upper(ICol, 0) * Inv;
+                for (int K = 1; K < NLevels; ++K) {
+                   Inv = 1 / (Diag(ICol, K) -
+                              Lower(ICol, K) * LocUpperFac(ICol, K - 1));
+                   LocInvPivot(ICol, K) = Inv;
+                   LocUpperFac(ICol, K) = Upper(ICol, K) * Inv;
+                }
+             });
+             Member.team_barrier();
+
+             teamThreadFor(Member, NRhs, [&](int N) {
+                X(N, ICol, 0) *= LocInvPivot(ICol, 0);
+                for (int K = 1; K < NLevels; ++K)
+                   X(N, ICol, K) =
+                       (X(N, ICol, K) - Lower(ICol, K) * X(N, ICol, K - 1)) *
+                       LocInvPivot(ICol, K);
+                for (int K = NLevels - 2; K >= 0; --K)
+                   X(N, ICol, K) -= LocUpperFac(ICol, K) * X(N, ICol, K + 1);
+             });
+          });
+   }
+
+   return 0;
+
+} // end solve (several right-hand sides)
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
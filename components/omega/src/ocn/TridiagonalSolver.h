@@ -0,0 +1,88 @@
+#ifndef OMEGA_TRIDIAGONALSOLVER_H
+#define OMEGA_TRIDIAGONALSOLVER_H
+//===-- ocn/TridiagonalSolver.h - vertical tridiagonal solver ---*- C++ -*-===//
+//
+/// \file
+/// \brief Defines a batched tridiagonal solver for vertical columns
+///
+/// Implicit vertical mixing of momentum and tracers requires the solution of
+/// a tridiagonal system in every column of the mesh at every time step. The
+/// TridiagonalSolver class solves a batch of such systems with the Thomas
+/// algorithm (Gaussian elimination without pivoting), one column at a time,
+/// with the columns distributed either over threads or over teams. The
+/// coefficient and right-hand side arrays are indexed (column, level), or
+/// (rhs, column, level) for several right-hand sides, in the default
+/// MemLayout, so that a column is contiguous with LayoutRight on CPUs and
+/// neighboring columns are contiguous with LayoutLeft on GPUs. All
+/// right-hand sides of a column, eg. all tracers that share a diffusivity,
+/// are eliminated in the same sweep with one factorization of the matrix.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <string>
+
+namespace OMEGA {
+
+/// Distribution of the columns of a batched solve over the device
+enum class ColumnParallelism {
+   Thread, ///< one column per thread, for many columns
+   Team    ///< one column per team with its right-hand sides over the
+           ///< threads of the team, for few columns with many right-hand sides
+};
+
+/// Batched tridiagonal solver for vertical columns. Row K of the system in
+/// a column is
+///    Lower(K) X(K-1) + Diag(K) X(K) + Upper(K) X(K+1) = Rhs(K)
+/// where Lower(0) and Upper(NVertLevels-1) are not used. The algorithm does
+/// not pivot, so the matrix must be diagonally dominant, which is the case
+/// for the backward Euler discretization of vertical diffusion.
+class TridiagonalSolver {
+ public:
+   /// Constructs a solver for up to NColumns columns of NVertLevels levels and
+   /// allocates the scratch arrays for the factorization
+   TridiagonalSolver(const std::string &Name, ///< [in] name of the solver
+                     I4 NColumns,             ///< [in] max number of columns
+                     I4 NVertLevels           ///< [in] number of levels
+   );
+
+   /// Solves the system in each of the first NCols columns for one right-hand
+   /// side, which is overwritten with the solution, with one column per
+   /// thread. Returns an error code.
+   int solve(const Array2DReal &Lower, ///< [in] subdiagonal
+             const Array2DReal &Diag,  ///< [in] diagonal
+             const Array2DReal &Upper, ///< [in] superdiagonal
+             const Array2DReal &X,     ///< [inout] right-hand side, solution
+             I4 NCols                  ///< [in] number of columns to solve
+   ) const;
+
+   /// Solves the system in each of the first NCols columns for all
+   /// right-hand sides X(N, :, :), eg. the packed tracer array, which are
+   /// overwritten with the solutions. The matrix is factored once per
+   /// column. Returns an error code.
+   int solve(const Array2DReal &Lower, ///< [in] subdiagonal
+             const Array2DReal &Diag,  ///< [in] diagonal
+             const Array2DReal &Upper, ///< [in] superdiagonal
+             const Array3DReal &X,     ///< [inout] right-hand sides, solutions
+             I4 NCols,                 ///< [in] number of columns to solve
+             ColumnParallelism Par = ColumnParallelism::Thread ///< [in]
+   ) const;
+
+ private:
+   /// Checks the extents of the arrays of a solve. Returns an error code.
+   int checkExtents(const Array2DReal &Lower, const Array2DReal &Diag,
+                    const Array2DReal &Upper, I4 XCols, I4 XLevels,
+                    I4 NCols) const;
+
+   std::string Name;     ///< name of the solver
+   I4 NColumns;          ///< max number of columns
+   I4 NVertLevels;       ///< number of vertical levels
+   Array2DReal UpperFac; ///< superdiagonal of the factored matrix
+   Array2DReal InvPivot; ///< inverse of the pivots of the factored matrix
+};
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_TRIDIAGONALSOLVER_H
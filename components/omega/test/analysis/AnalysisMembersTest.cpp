@@ -0,0 +1,397 @@
+//===-- Test driver for OMEGA analysis members -------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA in-situ analysis members
+///
+/// This driver sets fields on the default mesh for which the results of the
+/// analysis members are known: temperature that increases with latitude for
+/// the zonal means, a density jump at a known depth for the mixed-layer
+/// depth and temperature that depends only on the level for the regional
+/// means. The heat transport is tested to vanish with no velocity and to
+/// close at the north pole for any velocity. It also tests that members are
+/// only computed when an output is updated, and writes all outputs to a
+/// stream.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AnalysisMembers.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "IOField.h"
+#include "IOStream.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "Reductions.h"
+#include "TimeMgr.h"
+#include "mpi.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace OMEGA;
+
+constexpr I4 NVertLevels = 4;    // number of vertical levels
+constexpr I4 NLatBins    = 36;   // number of latitude bins
+constexpr R8 Thick       = 10.0; // layer thickness (m)
+constexpr R8 Tol         = 1e-10;
+
+//------------------------------------------------------------------------------
+// Fields with temperature 10 + K + sin(lat), salinity 35, uniform thickness
+// and a density that jumps by DRho below level KJump
+
+AnalysisFields makeFields(R8 DRho, I4 KJump) {
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   HostArray2DReal ThickH("ThickH", Mesh->NCellsSize, NVertLevels);
+   HostArray3DReal TracersH("TracersH", 2, Mesh->NCellsSize, NVertLevels);
+   HostArray2DReal DensityH("DensityH", Mesh->NCellsSize, NVertLevels);
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         ThickH(ICell, K)      = Thick;
+         TracersH(0, ICell, K) = 10 + K + std::sin(Mesh->LatCellH(ICell));
+         TracersH(1, ICell, K) = 35;
+         DensityH(ICell, K)    = K < KJump ? 1025 : 1025 + DRho;
+      }
+   }
+
+   AnalysisFields Fields;
+   Fields.LayerThickness = createDeviceMirrorCopy(ThickH);
+   Fields.NormalVelocity =
+       Array2DReal("NormalVelocity", Mesh->NEdgesSize, NVertLevels);
+   Fields.TracerArray = createDeviceMirrorCopy(TracersH);
+   Fields.IndxTemp    = 0;
+   Fields.IndxSalt    = 1;
+   Fields.Density     = createDeviceMirrorCopy(DensityH);
+   return Fields;
+
+} // end makeFields
+
+//------------------------------------------------------------------------------
+// Tests the zonal means against the range of the temperature in each bin
+
+int testZonalMean(ZonalMean *Zonal) {
+
+   int Err = 0;
+
+   const R8 Width = M_PI / NLatBins;
+   I4 NBad        = 0;
+   I4 NFilled     = 0;
+   for (int IBin = 0; IBin < NLatBins; ++IBin) {
+      const R8 South = std::sin(-0.5 * M_PI + IBin * Width);
+      const R8 North = std::sin(-0.5 * M_PI + (IBin + 1) * Width);
+      for (int K = 0; K < NVertLevels; ++K) {
+         const R8 Mean = Zonal->MeanTemperature(IBin, K);
+         if (Mean < -1e30) {
+            ++NFilled;
+            continue;
+         }
+         if (Mean < 10 + K + South - Tol || Mean > 10 + K + North + Tol ||
+             std::abs(Zonal->MeanSalinity(IBin, K) - 35) > Tol)
+            ++NBad;
+      }
+   }
+   if (NBad == 0 && NFilled < NLatBins * NVertLevels) {
+      LOG_INFO("AnalysisMembersTest: zonal means in range of bins: PASS");
+   } else {
+      LOG_ERROR("AnalysisMembersTest: {} zonal means out of range: FAIL",
+                NBad);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testZonalMean
+
+//------------------------------------------------------------------------------
+// Tests the heat transport with no velocity and with an arbitrary velocity,
+// whose net heat flux out of the whole ocean vanishes
+
+int testHeatTransport(MeridionalHeatTransport *MHT) {
+
+   int Err = 0;
+
+   HorzMesh *Mesh        = HorzMesh::getDefault();
+   AnalysisFields Fields = makeFields(0, 0);
+
+   Err += MHT->compute(Fields);
+   R8 MaxAbs = 0;
+   for (int IBin = 0; IBin < NLatBins; ++IBin)
+      MaxAbs = std::max(MaxAbs, std::abs(MHT->Transport(IBin)));
+   if (Err == 0 && MaxAbs == 0) {
+      LOG_INFO("AnalysisMembersTest: no transport without velocity: PASS");
+   } else {
+      LOG_ERROR("AnalysisMembersTest: transport {} without velocity: FAIL",
+                MaxAbs);
+      Err += 1;
+   }
+
+   HostArray2DReal VelH("VelH", Mesh->NEdgesSize, NVertLevels);
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge)
+      for (int K = 0; K < NVertLevels; ++K)
+         VelH(IEdge, K) = std::cos(Mesh->LonEdgeH(IEdge) + K) *
+                          std::sin(3 * Mesh->LatEdgeH(IEdge));
+   Fields.NormalVelocity = createDeviceMirrorCopy(VelH);
+
+   Err += MHT->compute(Fields);
+   MaxAbs = 0;
+   for (int IBin = 0; IBin < NLatBins; ++IBin)
+      MaxAbs = std::max(MaxAbs, std::abs(MHT->Transport(IBin)));
+   const R8 Closure = std::abs(MHT->Transport(NLatBins - 1));
+   if (MaxAbs > 0 && Closure < Tol * MaxAbs) {
+      LOG_INFO("AnalysisMembersTest: transport closes at the pole: PASS");
+   } else {
+      LOG_ERROR("AnalysisMembersTest: transport {} at the pole of max {}: "
+                "FAIL",
+                Closure, MaxAbs);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testHeatTransport
+
+//------------------------------------------------------------------------------
+// Tests the mixed-layer depth, which is computed only when its output is
+// updated after new fields are set
+
+int testMixedLayerDepth(MixedLayerDepth *MLD) {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   // Counts the owned ocean cells whose depth differs from Expected
+   auto countBad = [&](R8 Expected) {
+      auto DepthH = createHostMirrorCopy(MLD->Depth);
+      I4 NBad     = 0;
+      for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell)
+         if (std::abs(DepthH(ICell) - Expected) > Tol * Expected)
+            ++NBad;
+      MPI_Allreduce(MPI_IN_PLACE, &NBad, 1, MPI_INT, MPI_SUM,
+                    MachEnv::getDefaultEnv()->getComm());
+      return NBad;
+   };
+
+   // A jump of 1 kg/m^3 between the centers of levels 1 and 2 is crossed
+   // by the 0.03 kg/m^3 threshold 3% of the way down
+   AnalysisMember::setFields(makeFields(1.0, 2));
+   Err += IOField::update(MLD->getName());
+   const R8 JumpDepth = 1.5 * Thick + 0.03 * Thick;
+   if (countBad(JumpDepth) == 0) {
+      LOG_INFO("AnalysisMembersTest: mixed-layer depth at jump: PASS");
+   } else {
+      LOG_ERROR("AnalysisMembersTest: mixed-layer depth at jump: FAIL");
+      Err += 1;
+   }
+
+   // Uniform density mixes to the bottom, but only once updated
+   AnalysisMember::setFields(makeFields(0.0, 0));
+   const I4 NStale = countBad(JumpDepth);
+   Err += IOField::update(MLD->getName());
+   if (NStale == 0 && countBad(NVertLevels * Thick) == 0) {
+      LOG_INFO("AnalysisMembersTest: mixed-layer depth computed on update: "
+               "PASS");
+   } else {
+      LOG_ERROR("AnalysisMembersTest: mixed-layer depth computed on update: "
+                "FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testMixedLayerDepth
+
+//------------------------------------------------------------------------------
+// Tests the regional means of the northern hemisphere and the whole ocean
+
+int testRegionalMeans(RegionalMeans *Regions) {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   R8 Area = 0;
+   Err += globalSum(Mesh->AreaCell, NoWeight(), NoMask(),
+                    MachEnv::getDefaultEnv()->getComm(), &Area,
+                    Mesh->NCellsOwned);
+
+   // The mean of K weighted by uniform thickness is (NVertLevels - 1)/2,
+   // and the mean of sin(lat) over the whole sphere vanishes
+   const R8 Volume   = Area * Thick * NVertLevels;
+   const R8 MeanTemp = 10 + 0.5 * (NVertLevels - 1);
+   if (std::abs(Regions->Volume(1) - Volume) < Tol * Volume &&
+       Regions->Volume(0) > 0 && Regions->Volume(0) < Volume &&
+       std::abs(Regions->MeanTemperature(1) - MeanTemp) < 1e-2 &&
+       Regions->MeanTemperature(0) > MeanTemp &&
+       std::abs(Regions->MeanSalinity(0) - 35) < Tol) {
+      LOG_INFO("AnalysisMembersTest: regional means: PASS");
+   } else {
+      LOG_ERROR("AnalysisMembersTest: regional means volume {} {} "
+                "temperature {} {}: FAIL",
+                Regions->Volume(0), Regions->Volume(1),
+                Regions->MeanTemperature(0), Regions->MeanTemperature(1));
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testRegionalMeans
+
+//------------------------------------------------------------------------------
+// Tests the analysis members and writes their outputs to a stream
+
+int testAnalysisMembers() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   // Masks of the northern hemisphere and the whole ocean
+   HostArray1DI4 NorthH("NorthH", Mesh->NCellsSize);
+   HostArray1DI4 AllH("AllH", Mesh->NCellsSize);
+   Mesh->loadCoordinates();
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      NorthH(ICell) = Mesh->LatCellH(ICell) > 0;
+      AllH(ICell)   = 1;
+   }
+   std::vector<Array1DI4> Masks{createDeviceMirrorCopy(NorthH),
+                                createDeviceMirrorCopy(AllH)};
+
+   auto *Zonal = static_cast<ZonalMean *>(AnalysisMember::add(
+       std::make_unique<ZonalMean>("ZonalMean", Mesh, NVertLevels, NLatBins)));
+
+   auto *MHT = static_cast<MeridionalHeatTransport *>(
+       AnalysisMember::add(std::make_unique<MeridionalHeatTransport>(
+           "MeridionalHeatTransport", Mesh, NVertLevels, NLatBins)));
+
+   auto *MLD = static_cast<MixedLayerDepth *>(AnalysisMember::add(
+       std::make_unique<MixedLayerDepth>("MixedLayerDepth", Mesh,
+                                         NVertLevels)));
+
+   auto *Regions = static_cast<RegionalMeans *>(
+       AnalysisMember::add(std::make_unique<RegionalMeans>(
+           "RegionalMeans", Mesh, NVertLevels, Masks)));
+
+   if (Zonal == nullptr || MHT == nullptr || MLD == nullptr ||
+       Regions == nullptr) {
+      LOG_ERROR("AnalysisMembersTest: error creating members: FAIL");
+      return 1;
+   }
+
+   Err += testMixedLayerDepth(MLD);
+
+   Err += AnalysisMember::computeAll();
+   Err += testZonalMean(Zonal);
+   Err += testRegionalMeans(Regions);
+   Err += testHeatTransport(MHT);
+
+   // Write all outputs to a stream after four hourly steps
+   Calendar CalNoLeap("No Leap", CalendarNoLeap);
+   TimeInstant StartTime(&CalNoLeap, 1, 1, 1, 0, 0, 0.0);
+   TimeInterval TimeStep(1, TimeUnits::Hours);
+   TimeInterval StreamFreq(4, TimeUnits::Hours);
+   Clock ModelClock(StartTime, TimeStep);
+
+   int StreamErr = IOStream::create(
+       "Analysis", "AnalysisMembersTest.$Y-$M-$D_$h.nc", IO::ModeWrite,
+       IO::Precision::Double, IO::IfExists::Replace, StreamFreq, &ModelClock);
+   for (const char *Name : {"ZonalMean", "MeridionalHeatTransport",
+                            "MixedLayerDepth", "RegionalMeans"})
+      StreamErr += AnalysisMember::get(Name)->addToStream("Analysis");
+   for (int Step = 0; Step < 4; ++Step) {
+      AnalysisMember::setFields(makeFields(1.0, 2));
+      ModelClock.advance();
+      StreamErr += IOStream::writeAll();
+   }
+   if (StreamErr == 0) {
+      LOG_INFO("AnalysisMembersTest: write analysis stream: PASS");
+   } else {
+      LOG_ERROR("AnalysisMembersTest: write analysis stream: FAIL");
+      Err += 1;
+   }
+
+   IOStream::clear();
+   AnalysisMember::clear();
+
+   return Err;
+
+} // end testAnalysisMembers
+
+//------------------------------------------------------------------------------
+// The initialization routine for analysis member testing
+
+int initAnalysisMembersTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("AnalysisMembersTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("AnalysisMembersTest: error initializing decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("AnalysisMembersTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("AnalysisMembersTest: error initializing default mesh");
+   }
+
+   return Err;
+
+} // end initAnalysisMembersTest
+
+//------------------------------------------------------------------------------
+// The test driver for the analysis members
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initAnalysisMembersTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("AnalysisMembersTest: Error initializing");
+
+      RetVal += testAnalysisMembers();
+
+      if (RetVal == 0)
+         LOG_INFO("AnalysisMembersTest: Successful completion");
+
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,205 @@
+//===-- Test driver for OMEGA AnalysisTasks ----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA AnalysisTasks
+///
+/// This driver tests the splitting of the default environment into ocean and
+/// analysis tasks and the transfer of fields from the ocean tasks to the
+/// analysis tasks. Ocean tasks send several fields over a few steps while
+/// the analysis tasks receive them concurrently and check their contents.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AnalysisTasks.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "mpi.h"
+
+#include <iostream>
+
+using namespace OMEGA;
+
+// Number of steps sent by each ocean task, size of the fields and number of
+// analysis tasks
+constexpr I4 NumSteps    = 3;
+constexpr I4 FieldSize   = 10;
+constexpr I4 NumAnalysis = 2;
+
+//------------------------------------------------------------------------------
+// Check the split of the default environment
+
+int testSplit() {
+
+   int Err         = 0;
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+   const I4 MyTask = DefEnv->getMyTask();
+   const I4 NumOcn = DefEnv->getNumTasks() - NumAnalysis;
+
+   MachEnv *OcnEnv = AnalysisTasks::getOceanEnv();
+   MachEnv *AnaEnv = AnalysisTasks::getAnalysisEnv();
+
+   if (!AnalysisTasks::isEnabled() || OcnEnv == nullptr || AnaEnv == nullptr) {
+      LOG_ERROR("AnalysisTasksTest: environments not created FAIL");
+      return 1;
+   }
+
+   const bool IsAnalysis = MyTask >= NumOcn;
+   if (AnalysisTasks::isAnalysisTask() != IsAnalysis ||
+       OcnEnv->isMember() == IsAnalysis || AnaEnv->isMember() != IsAnalysis) {
+      LOG_ERROR("AnalysisTasksTest: task membership FAIL");
+      ++Err;
+   }
+   if (!IsAnalysis && (OcnEnv->getNumTasks() != NumOcn ||
+                       OcnEnv->getMyTask() != MyTask)) {
+      LOG_ERROR("AnalysisTasksTest: ocean environment FAIL");
+      ++Err;
+   }
+   if (IsAnalysis && (AnaEnv->getNumTasks() != NumAnalysis ||
+                      AnaEnv->getMyTask() != MyTask - NumOcn)) {
+      LOG_ERROR("AnalysisTasksTest: analysis environment FAIL");
+      ++Err;
+   }
+
+   // Ocean tasks are assigned to analysis tasks in contiguous blocks
+   if (AnalysisTasks::getAnalysisTask(0) != 0 ||
+       AnalysisTasks::getAnalysisTask(NumOcn - 1) != NumAnalysis - 1) {
+      LOG_ERROR("AnalysisTasksTest: task assignment FAIL");
+      ++Err;
+   }
+
+   if (Err == 0)
+      LOG_INFO("AnalysisTasksTest: environment split PASS");
+
+   return Err;
+
+} // end testSplit
+
+//------------------------------------------------------------------------------
+// Send fields from the ocean tasks and check them on the analysis tasks
+
+int testTransfer() {
+
+   int Err         = 0;
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+   const I4 NumOcn = DefEnv->getNumTasks() - NumAnalysis;
+
+   if (AnalysisTasks::isAnalysisTask()) {
+
+      // Count the fields received from each assigned ocean task and check
+      // that each holds the values sent
+      const I4 MyTask = AnalysisTasks::getAnalysisEnv()->getMyTask();
+      std::vector<I4> NumReceived(NumOcn, 0);
+      int RunErr = AnalysisTasks::run([&](const AnalysisMessage &Msg) {
+         ++NumReceived[Msg.OceanTask];
+         bool Valid = Msg.Name == "Temperature" &&
+                      Msg.Data.size() == static_cast<size_t>(FieldSize) &&
+                      AnalysisTasks::getAnalysisTask(Msg.OceanTask) == MyTask;
+         for (I4 I = 0; Valid && I < FieldSize; ++I)
+            Valid = Msg.Data[I] == 1000 * Msg.Step + 10 * Msg.OceanTask + I;
+         return Valid ? 0 : 1;
+      });
+      if (RunErr != 0) {
+         LOG_ERROR("AnalysisTasksTest: received field FAIL");
+         ++Err;
+      }
+
+      for (I4 OceanTask = 0; OceanTask < NumOcn; ++OceanTask) {
+         I4 Expected = AnalysisTasks::getAnalysisTask(OceanTask) == MyTask
+                           ? NumSteps
+                           : 0;
+         if (NumReceived[OceanTask] != Expected) {
+            LOG_ERROR("AnalysisTasksTest: received {} fields from task {} "
+                      "FAIL",
+                      NumReceived[OceanTask], OceanTask);
+            ++Err;
+         }
+      }
+
+   } else {
+
+      // Reuse one field array for all steps: sends copy the data so the
+      // array can be changed while the fields are in flight
+      const I4 MyTask = AnalysisTasks::getOceanEnv()->getMyTask();
+      std::vector<R8> Field(FieldSize);
+      for (I4 Step = 0; Step < NumSteps; ++Step) {
+         for (I4 I = 0; I < FieldSize; ++I)
+            Field[I] = 1000 * Step + 10 * MyTask + I;
+         Err += AnalysisTasks::send("Temperature", Step, Field);
+      }
+      Err += AnalysisTasks::finishSends();
+      if (AnalysisTasks::testSends() != 0) {
+         LOG_ERROR("AnalysisTasksTest: sends pending after finish FAIL");
+         ++Err;
+      }
+   }
+
+   // Sends are only allowed from ocean tasks
+   if (AnalysisTasks::isAnalysisTask()) {
+      std::vector<R8> Field(FieldSize, 0.0);
+      if (AnalysisTasks::send("Temperature", 0, Field) == 0) {
+         LOG_ERROR("AnalysisTasksTest: send from analysis task FAIL");
+         ++Err;
+      }
+   }
+
+   if (Err == 0)
+      LOG_INFO("AnalysisTasksTest: field transfer PASS");
+
+   return Err;
+
+} // end testTransfer
+
+//------------------------------------------------------------------------------
+// The test driver for AnalysisTasks
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv = MachEnv::getDefaultEnv();
+
+   if (DefEnv->getNumTasks() < 4) {
+      std::cerr << "Please run unit test with at least 4 tasks" << std::endl;
+      std::cout << "AnalysisTasks unit test: FAIL" << std::endl;
+      return -1;
+   }
+
+   // Invalid numbers of analysis tasks are rejected
+   if (AnalysisTasks::init(-1) == 0 ||
+       AnalysisTasks::init(DefEnv->getNumTasks()) == 0) {
+      LOG_ERROR("AnalysisTasksTest: invalid number of tasks FAIL");
+      ++RetVal;
+   }
+
+   // Without analysis tasks the ocean environment holds all tasks
+   RetVal += AnalysisTasks::init(0);
+   if (AnalysisTasks::isEnabled() || AnalysisTasks::isAnalysisTask() ||
+       AnalysisTasks::getAnalysisEnv() != nullptr ||
+       AnalysisTasks::getOceanEnv()->getNumTasks() != DefEnv->getNumTasks()) {
+      LOG_ERROR("AnalysisTasksTest: disabled analysis tasks FAIL");
+      ++RetVal;
+   }
+   AnalysisTasks::clear();
+
+   RetVal += AnalysisTasks::init(NumAnalysis);
+   RetVal += testSplit();
+   RetVal += testTransfer();
+   AnalysisTasks::clear();
+
+   if (RetVal == 0)
+      LOG_INFO("AnalysisTasksTest: Successful completion");
+
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
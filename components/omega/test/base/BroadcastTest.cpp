@@ -131,6 +131,75 @@ void TestBroadcast(OMEGA::MachEnv *Env, std::string TypeName, int *RetVal) {
    }
 }
 
+//------------------------------------------------------------------------------
+// Tests broadcasting a pack of mixed types with blocking and non-blocking calls
+void TestBroadcastPack(OMEGA::MachEnv *Env, int *RetVal) {
+
+   const int MyTask   = Env->getMyTask();
+   const int RootTask = 2;
+   const bool IsRoot  = MyTask == RootTask;
+
+   for (int Blocking = 1; Blocking >= 0; --Blocking) {
+
+      OMEGA::I4 ValI4    = IsRoot ? 4 : -1;
+      OMEGA::I8 ValI8    = IsRoot ? 8 : -1;
+      OMEGA::R4 ValR4    = IsRoot ? 4.5 : -1;
+      OMEGA::R8 ValR8    = IsRoot ? 8.5 : -1;
+      bool ValBool       = IsRoot;
+      std::string ValStr = IsRoot ? "packed string" : "x";
+      std::vector<OMEGA::R8> ValVec;
+      if (IsRoot)
+         ValVec = {1.0, 2.0, 3.0};
+
+      OMEGA::BroadcastPack Pack(Env, RootTask);
+      Pack.add(ValI4);
+      Pack.add(ValI8);
+      Pack.add(ValR4);
+      Pack.add(ValR8);
+      Pack.add(ValBool);
+      Pack.add(ValStr);
+      Pack.add(ValVec);
+
+      int Err;
+      if (Blocking) {
+         Err = Pack.broadcast();
+      } else {
+         Err = Pack.start();
+         if (Err == 0)
+            Err = Pack.finish();
+      }
+
+      const std::string Mode = Blocking ? "blocking" : "non-blocking";
+      if (Err == 0 && Pack.getNumValues() == 7 && ValI4 == 4 && ValI8 == 8 &&
+          ValR4 == 4.5 && ValR8 == 8.5 && ValBool &&
+          ValStr == "packed string" &&
+          ValVec == std::vector<OMEGA::R8>{1.0, 2.0, 3.0}) {
+         std::cout << Mode << " pack broadcast at rank " << MyTask
+                   << " : PASS" << std::endl;
+      } else {
+         std::cout << Mode << " pack broadcast at rank " << MyTask
+                   << " : FAIL" << std::endl;
+         *RetVal += 1;
+      }
+   }
+
+   // A pack of scalars only needs a single broadcast
+   OMEGA::I4 ValI4 = (MyTask == Env->getMasterTask()) ? 3 : 0;
+   OMEGA::R8 ValR8 = (MyTask == Env->getMasterTask()) ? 3.5 : 0;
+   OMEGA::BroadcastPack ScalarPack;
+   ScalarPack.add(ValI4);
+   ScalarPack.add(ValR8);
+   int Err = ScalarPack.broadcast();
+   if (Err == 0 && ValI4 == 3 && ValR8 == 3.5) {
+      std::cout << "scalar pack broadcast at rank " << MyTask << " : PASS"
+                << std::endl;
+   } else {
+      std::cout << "scalar pack broadcast at rank " << MyTask << " : FAIL"
+                << std::endl;
+      *RetVal += 1;
+   }
+}
+
 //------------------------------------------------------------------------------
 // The test driver for MachEnv. This tests the values stored in the Default
 // Environment and three other based on the three subsetting options.  All
@@ -184,6 +253,9 @@ int main(int argc, char *argv[]) {
    // string Broadcast tests
    TestBroadcast<std::string>(DefEnv, "string", &RetVal);
 
+   // mixed-type pack Broadcast tests
+   TestBroadcastPack(DefEnv, &RetVal);
+
    // Initialize general subset environment
    int InclSize     = 4;
    int InclTasks[4] = {1, 2, 5, 7};
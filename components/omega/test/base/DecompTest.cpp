@@ -12,13 +12,21 @@
 //===-----------------------------------------------------------------------===/
 
 #include "Decomp.h"
+#include "Config.h"
 #include "DataTypes.h"
 #include "IO.h"
 #include "Logging.h"
 #include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "Snapshot.h"
 #include "mpi.h"
 
+#include <cstdio>
 #include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // The initialization routine for Decomp testing. It calls various
@@ -137,6 +145,409 @@ int main(int argc, char *argv[]) {
                   RefSumVertices);
       }
 
+      // Test a decomposition with a reverse Cuthill-McKee ordering of the
+      // owned cells. The partition is the same as the default, so each task
+      // should own the same cells and halo layers, but the owned cells are
+      // renumbered and the cell locations must be consistent with the new
+      // local addresses.
+      OMEGA::Decomp RCMDecomp("RCM", DefEnv, NumTasks,
+                              OMEGA::PartMethodMetisKWay, DefDecomp->HaloWidth,
+                              DefDecomp->MeshFileName, OMEGA::CellOrderRCM);
+      OMEGA::Decomp *RCMDecompPtr = OMEGA::Decomp::get("RCM");
+
+      OMEGA::I4 LocErrCount = 0;
+      if (RCMDecompPtr->NCellsOwned != DefDecomp->NCellsOwned ||
+          RCMDecompPtr->NCellsAll != DefDecomp->NCellsAll ||
+          RCMDecompPtr->NEdgesAll != DefDecomp->NEdgesAll ||
+          RCMDecompPtr->NVerticesAll != DefDecomp->NVerticesAll)
+         ++LocErrCount;
+      for (int Halo = 0; Halo < DefDecomp->HaloWidth; ++Halo) {
+         if (RCMDecompPtr->NCellsHaloH(Halo) != DefDecomp->NCellsHaloH(Halo))
+            ++LocErrCount;
+      }
+
+      // Owned cells are a permutation of the default owned cells and
+      // the local address of each owned cell is its own index
+      std::set<OMEGA::I4> DefOwned;
+      for (int Cell = 0; Cell < DefDecomp->NCellsOwned; ++Cell)
+         DefOwned.insert(DefDecomp->CellIDH(Cell));
+      for (int Cell = 0; Cell < RCMDecompPtr->NCellsOwned; ++Cell) {
+         if (DefOwned.find(RCMDecompPtr->CellIDH(Cell)) == DefOwned.end() ||
+             RCMDecompPtr->CellLocH(Cell, 0) != MyTask ||
+             RCMDecompPtr->CellLocH(Cell, 1) != Cell)
+            ++LocErrCount;
+      }
+
+      // Neighbor cells of owned cells must be consistent with the global IDs
+      std::map<OMEGA::I4, OMEGA::I4> DefLocToGlob;
+      for (int Cell = 0; Cell < DefDecomp->NCellsOwned; ++Cell) {
+         for (int Nbr = 0; Nbr < DefDecomp->NEdgesOnCellH(Cell); ++Nbr) {
+            OMEGA::I4 NbrCell = DefDecomp->CellsOnCellH(Cell, Nbr);
+            if (NbrCell < DefDecomp->NCellsAll)
+               DefLocToGlob[DefDecomp->CellIDH(Cell) * DefDecomp->MaxEdges +
+                            Nbr] = DefDecomp->CellIDH(NbrCell);
+         }
+      }
+      for (int Cell = 0; Cell < RCMDecompPtr->NCellsOwned; ++Cell) {
+         for (int Nbr = 0; Nbr < RCMDecompPtr->NEdgesOnCellH(Cell); ++Nbr) {
+            OMEGA::I4 NbrCell = RCMDecompPtr->CellsOnCellH(Cell, Nbr);
+            if (NbrCell < RCMDecompPtr->NCellsAll &&
+                DefLocToGlob[RCMDecompPtr->CellIDH(Cell) *
+                                 RCMDecompPtr->MaxEdges +
+                             Nbr] != RCMDecompPtr->CellIDH(NbrCell))
+               ++LocErrCount;
+         }
+      }
+
+      OMEGA::I4 ErrCount = 0;
+      Err = MPI_Allreduce(&LocErrCount, &ErrCount, 1, MPI_INT32_T, MPI_SUM,
+                          Comm);
+      if (ErrCount == 0) {
+         LOG_INFO("DecompTest: RCM cell ordering test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: RCM cell ordering test FAIL");
+      }
+
+      // Test a decomposition with the distributed ParMETIS partitioning.
+      // The partition differs from the default, but all cells must still be
+      // owned by exactly one task and the halo cell locations must refer to
+      // the owned cells on the remote task.
+      OMEGA::Decomp ParDecomp("ParMetis", DefEnv, NumTasks,
+                              OMEGA::PartMethodParMetisKWay,
+                              DefDecomp->HaloWidth, DefDecomp->MeshFileName);
+      OMEGA::Decomp *ParDecompPtr = OMEGA::Decomp::get("ParMetis");
+
+      LocSumCells = 0;
+      for (int n = 0; n < ParDecompPtr->NCellsOwned; ++n)
+         LocSumCells += ParDecompPtr->CellIDH(n);
+      Err =
+          MPI_Allreduce(&LocSumCells, &SumCells, 1, MPI_INT32_T, MPI_SUM, Comm);
+
+      // Gather the global ID of every owned cell by location so that the
+      // location of each halo cell can be checked
+      std::vector<OMEGA::I4> NOwnedAll(NumTasks);
+      std::vector<OMEGA::I4> OwnedDispl(NumTasks, 0);
+      Err = MPI_Allgather(&ParDecompPtr->NCellsOwned, 1, MPI_INT32_T,
+                          NOwnedAll.data(), 1, MPI_INT32_T, Comm);
+      for (int Task = 1; Task < NumTasks; ++Task)
+         OwnedDispl[Task] = OwnedDispl[Task - 1] + NOwnedAll[Task - 1];
+      std::vector<OMEGA::I4> OwnedIDAll(DefDecomp->NCellsGlobal);
+      Err = MPI_Allgatherv(ParDecompPtr->CellIDH.data(),
+                           ParDecompPtr->NCellsOwned, MPI_INT32_T,
+                           OwnedIDAll.data(), NOwnedAll.data(),
+                           OwnedDispl.data(), MPI_INT32_T, Comm);
+      LocErrCount = 0;
+      for (int Cell = 0; Cell < ParDecompPtr->NCellsAll; ++Cell) {
+         OMEGA::I4 Task = ParDecompPtr->CellLocH(Cell, 0);
+         OMEGA::I4 Add  = ParDecompPtr->CellLocH(Cell, 1);
+         if (OwnedIDAll[OwnedDispl[Task] + Add] != ParDecompPtr->CellIDH(Cell))
+            ++LocErrCount;
+      }
+      Err = MPI_Allreduce(&LocErrCount, &ErrCount, 1, MPI_INT32_T, MPI_SUM,
+                          Comm);
+
+      if (SumCells == RefSumCells && ErrCount == 0) {
+         LOG_INFO("DecompTest: ParMETIS partition test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: ParMETIS partition test FAIL {} {} {}",
+                  SumCells, RefSumCells, ErrCount);
+      }
+
+      // Test the two-level decomposition that partitions across nodes and
+      // then among the tasks on each node. As for ParMETIS, all cells must
+      // be owned by exactly one task and the halo cell locations must refer
+      // to the owned cells on the remote task.
+      OMEGA::Decomp NodeDecomp("NodeAware", DefEnv, NumTasks,
+                               OMEGA::PartMethodMetisKWayNode,
+                               DefDecomp->HaloWidth, DefDecomp->MeshFileName);
+      OMEGA::Decomp *NodeDecompPtr = OMEGA::Decomp::get("NodeAware");
+
+      LocSumCells = 0;
+      for (int n = 0; n < NodeDecompPtr->NCellsOwned; ++n)
+         LocSumCells += NodeDecompPtr->CellIDH(n);
+      Err =
+          MPI_Allreduce(&LocSumCells, &SumCells, 1, MPI_INT32_T, MPI_SUM, Comm);
+
+      Err = MPI_Allgather(&NodeDecompPtr->NCellsOwned, 1, MPI_INT32_T,
+                          NOwnedAll.data(), 1, MPI_INT32_T, Comm);
+      for (int Task = 1; Task < NumTasks; ++Task)
+         OwnedDispl[Task] = OwnedDispl[Task - 1] + NOwnedAll[Task - 1];
+      Err = MPI_Allgatherv(NodeDecompPtr->CellIDH.data(),
+                           NodeDecompPtr->NCellsOwned, MPI_INT32_T,
+                           OwnedIDAll.data(), NOwnedAll.data(),
+                           OwnedDispl.data(), MPI_INT32_T, Comm);
+      LocErrCount = 0;
+      if (NodeDecompPtr->NCellsOwned <= 0)
+         ++LocErrCount;
+      for (int Cell = 0; Cell < NodeDecompPtr->NCellsAll; ++Cell) {
+         OMEGA::I4 Task = NodeDecompPtr->CellLocH(Cell, 0);
+         OMEGA::I4 Add  = NodeDecompPtr->CellLocH(Cell, 1);
+         if (OwnedIDAll[OwnedDispl[Task] + Add] != NodeDecompPtr->CellIDH(Cell))
+            ++LocErrCount;
+      }
+      Err = MPI_Allreduce(&LocErrCount, &ErrCount, 1, MPI_INT32_T, MPI_SUM,
+                          Comm);
+
+      if (SumCells == RefSumCells && ErrCount == 0) {
+         LOG_INFO("DecompTest: node-aware partition test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: node-aware partition test FAIL {} {} {}",
+                  SumCells, RefSumCells, ErrCount);
+      }
+
+      // Test saving and reusing the cell partition in a partition file.
+      // The first decomposition partitions the mesh and writes the file,
+      // the second reads the partition from the file and must reproduce
+      // the same decomposition.
+      std::string PartFileName =
+          "DecompTestPart.part." + std::to_string(NumTasks);
+      if (IsMaster)
+         std::remove(PartFileName.c_str());
+      MPI_Barrier(Comm);
+      OMEGA::Decomp PartWrite("PartWrite", DefEnv, NumTasks,
+                              OMEGA::PartMethodMetisKWay, DefDecomp->HaloWidth,
+                              DefDecomp->MeshFileName, OMEGA::CellOrderNatural,
+                              PartFileName);
+      OMEGA::Decomp PartRead("PartRead", DefEnv, NumTasks,
+                             OMEGA::PartMethodParMetisKWay,
+                             DefDecomp->HaloWidth, DefDecomp->MeshFileName,
+                             OMEGA::CellOrderNatural, PartFileName);
+      OMEGA::Decomp *PartWritePtr = OMEGA::Decomp::get("PartWrite");
+      OMEGA::Decomp *PartReadPtr  = OMEGA::Decomp::get("PartRead");
+
+      LocErrCount = 0;
+      if (PartReadPtr->NCellsAll != PartWritePtr->NCellsAll ||
+          PartReadPtr->NEdgesAll != PartWritePtr->NEdgesAll ||
+          PartReadPtr->NVerticesAll != PartWritePtr->NVerticesAll) {
+         ++LocErrCount;
+      } else {
+         for (int Cell = 0; Cell < PartReadPtr->NCellsAll; ++Cell) {
+            if (PartReadPtr->CellIDH(Cell) != PartWritePtr->CellIDH(Cell) ||
+                PartReadPtr->CellLocH(Cell, 0) !=
+                    PartWritePtr->CellLocH(Cell, 0))
+               ++LocErrCount;
+         }
+      }
+      Err = MPI_Allreduce(&LocErrCount, &ErrCount, 1, MPI_INT32_T, MPI_SUM,
+                          Comm);
+      if (IsMaster)
+         std::remove(PartFileName.c_str());
+
+      if (ErrCount == 0) {
+         LOG_INFO("DecompTest: partition file test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: partition file test FAIL");
+      }
+
+      // Test saving and restoring the decomposition with snapshot files.
+      // The first decomposition partitions the mesh and writes a snapshot
+      // on each task, the second restores the decomposition from the
+      // snapshot and must reproduce the same decomposition.
+      std::string SnapshotName = "DecompTestSnap";
+      std::string SnapshotFile =
+          OMEGA::snapshotFileName(SnapshotName, "decomp", Comm);
+      std::remove(SnapshotFile.c_str());
+      MPI_Barrier(Comm);
+      OMEGA::Decomp SnapWrite("SnapWrite", DefEnv, NumTasks,
+                              OMEGA::PartMethodMetisKWay, DefDecomp->HaloWidth,
+                              DefDecomp->MeshFileName, OMEGA::CellOrderNatural,
+                              "", {}, {}, SnapshotName);
+      OMEGA::Decomp SnapRead("SnapRead", DefEnv, NumTasks,
+                             OMEGA::PartMethodMetisKWay, DefDecomp->HaloWidth,
+                             DefDecomp->MeshFileName, OMEGA::CellOrderNatural,
+                             "", {}, {}, SnapshotName);
+      OMEGA::Decomp *SnapWritePtr = OMEGA::Decomp::get("SnapWrite");
+      OMEGA::Decomp *SnapReadPtr  = OMEGA::Decomp::get("SnapRead");
+
+      LocErrCount = 0;
+      if (SnapReadPtr->NCellsOwned != SnapWritePtr->NCellsOwned ||
+          SnapReadPtr->NCellsAll != SnapWritePtr->NCellsAll ||
+          SnapReadPtr->NEdgesAll != SnapWritePtr->NEdgesAll ||
+          SnapReadPtr->NVerticesAll != SnapWritePtr->NVerticesAll ||
+          SnapReadPtr->MaxEdges != SnapWritePtr->MaxEdges) {
+         ++LocErrCount;
+      } else {
+         auto CellsOnCellR = OMEGA::createHostMirrorCopy(
+             SnapReadPtr->CellsOnCell);
+         for (int Cell = 0; Cell < SnapReadPtr->NCellsAll; ++Cell) {
+            if (SnapReadPtr->CellIDH(Cell) != SnapWritePtr->CellIDH(Cell) ||
+                SnapReadPtr->CellLocH(Cell, 1) !=
+                    SnapWritePtr->CellLocH(Cell, 1))
+               ++LocErrCount;
+            for (int Nbr = 0; Nbr < SnapReadPtr->MaxEdges; ++Nbr) {
+               if (CellsOnCellR(Cell, Nbr) !=
+                   SnapWritePtr->CellsOnCellH(Cell, Nbr))
+                  ++LocErrCount;
+            }
+         }
+         for (int Edge = 0; Edge < SnapReadPtr->NEdgesAll; ++Edge) {
+            if (SnapReadPtr->EdgeIDH(Edge) != SnapWritePtr->EdgeIDH(Edge) ||
+                SnapReadPtr->CellsOnEdgeH(Edge, 0) !=
+                    SnapWritePtr->CellsOnEdgeH(Edge, 0))
+               ++LocErrCount;
+         }
+         for (int Vrtx = 0; Vrtx < SnapReadPtr->NVerticesAll; ++Vrtx) {
+            if (SnapReadPtr->VertexIDH(Vrtx) != SnapWritePtr->VertexIDH(Vrtx))
+               ++LocErrCount;
+         }
+      }
+      Err = MPI_Allreduce(&LocErrCount, &ErrCount, 1, MPI_INT32_T, MPI_SUM,
+                          Comm);
+      std::remove(SnapshotFile.c_str());
+
+      if (ErrCount == 0) {
+         LOG_INFO("DecompTest: snapshot test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: snapshot test FAIL");
+      }
+
+      // Test weighted partitions with one and two balancing constraints.
+      // The nEdgesOnCell field is present in all meshes so is used as a
+      // stand-in for the number of active levels in each cell.
+      for (int NWeights = 1; NWeights <= 2; ++NWeights) {
+         std::vector<std::string> WeightNames(NWeights, "nEdgesOnCell");
+         std::string WgtName = "Weighted" + std::to_string(NWeights);
+         OMEGA::Decomp WgtDecomp(WgtName, DefEnv, NumTasks,
+                                 OMEGA::PartMethodMetisKWay,
+                                 DefDecomp->HaloWidth, DefDecomp->MeshFileName,
+                                 OMEGA::CellOrderNatural, "", WeightNames);
+         OMEGA::Decomp *WgtDecompPtr = OMEGA::Decomp::get(WgtName);
+
+         LocSumCells = 0;
+         for (int n = 0; n < WgtDecompPtr->NCellsOwned; ++n)
+            LocSumCells += WgtDecompPtr->CellIDH(n);
+         Err = MPI_Allreduce(&LocSumCells, &SumCells, 1, MPI_INT32_T, MPI_SUM,
+                             Comm);
+
+         if (SumCells == RefSumCells) {
+            LOG_INFO("DecompTest: weighted partition {} test PASS", NWeights);
+         } else {
+            RetVal += 1;
+            LOG_INFO("DecompTest: weighted partition {} test FAIL", NWeights);
+         }
+      }
+
+      // Test rebalancing with a cost that is larger on half of the tasks
+      // and the migration of arrays from the default to the new decomp.
+      OMEGA::HostArray1DR8 CellCost("CellCost", DefDecomp->NCellsSize);
+      for (int Cell = 0; Cell < DefDecomp->NCellsOwned; ++Cell)
+         CellCost(Cell) = MyTask % 2 == 0 ? 1.0 : 3.0;
+      Err = OMEGA::Decomp::rebalance("Rebalanced", DefDecomp, DefEnv, CellCost);
+      OMEGA::Decomp *NewDecomp = OMEGA::Decomp::get("Rebalanced");
+      if (Err != 0 || NewDecomp == nullptr) {
+         RetVal += 1;
+         LOG_INFO("DecompTest: rebalance test FAIL");
+      } else {
+         LOG_INFO("DecompTest: rebalance test PASS");
+
+         // Migrate the global IDs as arrays and compare with the IDs in
+         // the new decomposition
+         LocErrCount = 0;
+         OMEGA::Migration CellMigrate(DefEnv, DefDecomp, NewDecomp,
+                                      OMEGA::OnCell);
+         OMEGA::HostArray2DR8 OldCellArr("OldCellArr", DefDecomp->NCellsSize,
+                                         2);
+         OMEGA::HostArray2DR8 NewCellArr("NewCellArr", NewDecomp->NCellsSize,
+                                         2);
+         for (int Cell = 0; Cell < DefDecomp->NCellsOwned; ++Cell) {
+            OldCellArr(Cell, 0) = DefDecomp->CellIDH(Cell);
+            OldCellArr(Cell, 1) = -DefDecomp->CellIDH(Cell);
+         }
+         Err = CellMigrate.migrate(OldCellArr, NewCellArr);
+         for (int Cell = 0; Cell < NewDecomp->NCellsOwned; ++Cell) {
+            if (NewCellArr(Cell, 0) != NewDecomp->CellIDH(Cell) ||
+                NewCellArr(Cell, 1) != -NewDecomp->CellIDH(Cell))
+               ++LocErrCount;
+         }
+
+         OMEGA::Migration EdgeMigrate(DefEnv, DefDecomp, NewDecomp,
+                                      OMEGA::OnEdge);
+         OMEGA::HostArray1DI4 NewEdgeID("NewEdgeID", NewDecomp->NEdgesSize);
+         Err += EdgeMigrate.migrate(DefDecomp->EdgeIDH, NewEdgeID);
+         for (int Edge = 0; Edge < NewDecomp->NEdgesOwned; ++Edge) {
+            if (NewEdgeID(Edge) != NewDecomp->EdgeIDH(Edge))
+               ++LocErrCount;
+         }
+
+         OMEGA::Migration VrtxMigrate(DefEnv, DefDecomp, NewDecomp,
+                                      OMEGA::OnVertex);
+         OMEGA::HostArray1DI4 NewVrtxID("NewVrtxID", NewDecomp->NVerticesSize);
+         Err += VrtxMigrate.migrate(DefDecomp->VertexIDH, NewVrtxID);
+         for (int Vrtx = 0; Vrtx < NewDecomp->NVerticesOwned; ++Vrtx) {
+            if (NewVrtxID(Vrtx) != NewDecomp->VertexIDH(Vrtx))
+               ++LocErrCount;
+         }
+         if (Err != 0)
+            ++LocErrCount;
+
+         Err = MPI_Allreduce(&LocErrCount, &ErrCount, 1, MPI_INT32_T,
+                             MPI_SUM, Comm);
+         if (ErrCount == 0) {
+            LOG_INFO("DecompTest: migration test PASS");
+         } else {
+            RetVal += 1;
+            LOG_INFO("DecompTest: migration test FAIL");
+         }
+      }
+
+      // Test the configuration options by recreating the default
+      // decomposition from a Decomp group with a cell ordering and
+      // partition file option. The owned cells must match the RCM
+      // decomposition above and the partition file must be written.
+      std::string MeshFileName = DefDecomp->MeshFileName;
+      OMEGA::I4 HaloWidth      = DefDecomp->HaloWidth;
+      std::string ConfigPartFileName =
+          MeshFileName + ".part." + std::to_string(NumTasks);
+      if (IsMaster)
+         std::remove(ConfigPartFileName.c_str());
+      MPI_Barrier(Comm);
+      OMEGA::Decomp::erase("Default");
+
+      OMEGA::Config DecompConfig("Decomp");
+      Err = DecompConfig.add("HaloWidth", HaloWidth);
+      Err += DecompConfig.add("MeshFileName", MeshFileName);
+      Err += DecompConfig.add("DecompMethod", std::string("MetisKWay"));
+      Err += DecompConfig.add("CellOrdering", std::string("RCM"));
+      Err += DecompConfig.add("UsePartFile", true);
+      Err += OMEGA::Config::getOmegaConfig()->add(DecompConfig);
+      if (Err == 0)
+         Err = OMEGA::Decomp::init();
+
+      LocErrCount = 0;
+      DefDecomp   = OMEGA::Decomp::getDefault();
+      if (Err != 0 || DefDecomp == nullptr ||
+          DefDecomp->NCellsOwned != RCMDecompPtr->NCellsOwned) {
+         ++LocErrCount;
+      } else {
+         for (int Cell = 0; Cell < DefDecomp->NCellsOwned; ++Cell) {
+            if (DefDecomp->CellIDH(Cell) != RCMDecompPtr->CellIDH(Cell))
+               ++LocErrCount;
+         }
+      }
+      Err = MPI_Allreduce(&LocErrCount, &ErrCount, 1, MPI_INT32_T, MPI_SUM,
+                          Comm);
+      if (IsMaster) {
+         std::FILE *PartFile = std::fopen(ConfigPartFileName.c_str(), "r");
+         if (PartFile == nullptr) {
+            ++ErrCount;
+         } else {
+            std::fclose(PartFile);
+            std::remove(ConfigPartFileName.c_str());
+         }
+      }
+
+      if (ErrCount == 0) {
+         LOG_INFO("DecompTest: decomposition config test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: decomposition config test FAIL");
+      }
+
       // Clean up
       OMEGA::Decomp::clear();
       OMEGA::MachEnv::removeAll();
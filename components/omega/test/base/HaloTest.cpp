@@ -10,6 +10,7 @@
 /// type and dimensionality supported in OMEGA, initializing each array based
 /// on global IDs of the mesh elememts, performing halo exchanges, and
 /// confirming the exchanged arrays are identical to the initial arrays.
+/// Exchanges of device arrays are also tested.
 ///
 //
 //===-----------------------------------------------------------------------===/
@@ -23,6 +24,37 @@
 #include "OmegaKokkos.h"
 #include "mpi.h"
 
+//------------------------------------------------------------------------------
+// This function template compares two Kokkos arrays of the same type and size
+// element by element, returning an error if any elements differ. Device
+// arrays are copied to the host for the comparison.
+
+template <typename T> OMEGA::I4 compareArrays(T InitArray, T TestArray) {
+
+   // Copy arrays to host if needed
+   auto InitArrayH = OMEGA::createHostMirrorCopy(InitArray);
+   auto TestArrayH = OMEGA::createHostMirrorCopy(TestArray);
+   using HostT     = decltype(InitArrayH);
+
+   // Collapse arrays to 1D for easy iteration
+   Kokkos::View<typename HostT::value_type *, typename HostT::array_layout,
+                typename HostT::memory_space>
+       CollapsedInit(InitArrayH.data(), InitArrayH.size());
+   Kokkos::View<typename HostT::value_type *, typename HostT::array_layout,
+                typename HostT::memory_space>
+       CollapsedTest(TestArrayH.data(), TestArrayH.size());
+
+   // Confirm all elements are identical, if not return an error
+   for (int N = 0; N < InitArrayH.size(); ++N) {
+      if (CollapsedInit(N) != CollapsedTest(N)) {
+         return -1;
+      }
+   }
+
+   return 0;
+
+} // end compareArrays
+
 //------------------------------------------------------------------------------
 // This function template performs a single test on a Kokkos array type in a
 // given index space. Two Kokkos arrays of the same type and size are input,
@@ -32,7 +64,8 @@
 // output, an integer to accumulate errors, and optionally the index space of
 // the input arrays (default is OnCell) are also input. A halo exchange is
 // performed on TestArray, and then TestArray is compared to InitArray. If any
-// elements differ the test is a failure and an error is returned.
+// elements differ the test is a failure and an error is returned. Device
+// arrays are copied to the host for the comparison.
 
 template <typename T>
 void haloExchangeTest(
@@ -64,22 +97,8 @@ void haloExchangeTest(
       return;
    }
 
-   // Collapse arrays to 1D for easy iteration
-   Kokkos::View<typename T::value_type *, typename T::array_layout,
-                typename T::memory_space>
-       CollapsedInit(InitArray.data(), InitArray.size());
-   Kokkos::View<typename T::value_type *, typename T::array_layout,
-                typename T::memory_space>
-       CollapsedTest(TestArray.data(), TestArray.size());
-
    // Confirm all elements are identical, if not set error code
-   // and break out of loop
-   for (int N = 0; N < NTot; ++N) {
-      if (CollapsedInit(N) != CollapsedTest(N)) {
-         IErr = -1;
-         break;
-      }
-   }
+   IErr = compareArrays(InitArray, TestArray);
 
    if (IErr == 0) {
       LOG_INFO("HaloTest: {} exchange test PASS", Label);
@@ -429,7 +448,333 @@ int main(int argc, char *argv[]) {
       haloExchangeTest(DefHalo, Init5DR4, Test5DR4, "5DR4", TotErr);
       haloExchangeTest(DefHalo, Init5DR8, Test5DR8, "5DR8", TotErr);
 
+      // Run device array tests by copying the host init arrays to the device
+      // and resetting the halo elements of the host test arrays before
+      // copying them to the device
+      OMEGA::Array2DI4 Init2DI4Dev("Init2DI4Dev", NumAll, N2);
+      OMEGA::Array2DR8 Init2DR8Dev("Init2DR8Dev", NumAll, N2);
+      OMEGA::Array3DR4 Init3DR4Dev("Init3DR4Dev", N3, NumAll, N2);
+      OMEGA::Array3DR8 Init3DR8Dev("Init3DR8Dev", N3, NumAll, N2);
+      OMEGA::Array2DI4 Test2DI4Dev("Test2DI4Dev", NumAll, N2);
+      OMEGA::Array2DR8 Test2DR8Dev("Test2DR8Dev", NumAll, N2);
+      OMEGA::Array3DR4 Test3DR4Dev("Test3DR4Dev", N3, NumAll, N2);
+      OMEGA::Array3DR8 Test3DR8Dev("Test3DR8Dev", N3, NumAll, N2);
+
+      for (int K = 0; K < N3; ++K) {
+         for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+            for (int J = 0; J < N2; ++J) {
+               Test3DR4(K, ICell, J) = -1;
+               Test3DR8(K, ICell, J) = -1;
+            }
+         }
+      }
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         for (int J = 0; J < N2; ++J) {
+            Test2DI4(ICell, J) = -1;
+            Test2DR8(ICell, J) = -1;
+         }
+      }
+
+      OMEGA::deepCopy(Init2DI4Dev, Init2DI4);
+      OMEGA::deepCopy(Init2DR8Dev, Init2DR8);
+      OMEGA::deepCopy(Init3DR4Dev, Init3DR4);
+      OMEGA::deepCopy(Init3DR8Dev, Init3DR8);
+      OMEGA::deepCopy(Test2DI4Dev, Test2DI4);
+      OMEGA::deepCopy(Test2DR8Dev, Test2DR8);
+      OMEGA::deepCopy(Test3DR4Dev, Test3DR4);
+      OMEGA::deepCopy(Test3DR8Dev, Test3DR8);
+
+      haloExchangeTest(DefHalo, Init2DI4Dev, Test2DI4Dev, "Device 2DI4",
+                       TotErr);
+      haloExchangeTest(DefHalo, Init2DR8Dev, Test2DR8Dev, "Device 2DR8",
+                       TotErr);
+      haloExchangeTest(DefHalo, Init3DR4Dev, Test3DR4Dev, "Device 3DR4",
+                       TotErr);
+      haloExchangeTest(DefHalo, Init3DR8Dev, Test3DR8Dev, "Device 3DR8",
+                       TotErr);
+
+      // Test a device exchange in the edge index space, which has an extra
+      // halo layer
+      NumOwned = DefDecomp->NEdgesOwned;
+      NumAll   = DefDecomp->NEdgesAll;
+
+      OMEGA::HostArray2DR8 Init2DR8EdgeH("Init2DR8EdgeH",
+                                         DefDecomp->NEdgesSize, N2);
+      OMEGA::HostArray2DR8 Test2DR8EdgeH("Test2DR8EdgeH",
+                                         DefDecomp->NEdgesSize, N2);
+      for (int IEdge = 0; IEdge < NumAll; ++IEdge) {
+         for (int J = 0; J < N2; ++J) {
+            OMEGA::R8 NewVal        = (J + 1) * DefDecomp->EdgeIDH(IEdge);
+            Init2DR8EdgeH(IEdge, J) = NewVal;
+            Test2DR8EdgeH(IEdge, J) = IEdge < NumOwned ? NewVal : -1;
+         }
+      }
+
+      auto Init2DR8Edge = OMEGA::createDeviceMirrorCopy(Init2DR8EdgeH);
+      auto Test2DR8Edge = OMEGA::createDeviceMirrorCopy(Test2DR8EdgeH);
+
+      haloExchangeTest(DefHalo, Init2DR8Edge, Test2DR8Edge, "Device 2DR8 Edge",
+                       TotErr, OMEGA::OnEdge);
+
+      // Test the split-phase exchange, overlapping an update of the owned
+      // cells of a second array with the exchange. Reset the cell halo of
+      // the device 2DR8 test array and exchange it again.
+      NumOwned = DefDecomp->NCellsOwned;
+      NumAll   = DefDecomp->NCellsAll;
+      OMEGA::deepCopy(Test2DR8Dev, Test2DR8);
+
+      OMEGA::Array2DR8 Owned2DR8("Owned2DR8", NumAll, N2);
+      OMEGA::HaloRequest<OMEGA::Array2DR8> Request;
+
+      IErr = DefHalo->beginExchange(Test2DR8Dev, OMEGA::OnCell, Request);
+      if (IErr != 0)
+         LOG_ERROR("HaloTest: error in beginExchange");
+
+      OMEGA::parallelFor(
+          {NumOwned, N2}, KOKKOS_LAMBDA(int ICell, int J) {
+             Owned2DR8(ICell, J) = 2.0 * ICell + J;
+          });
+
+      IErr = DefHalo->finishExchange(Request);
+
+      // Compare the exchanged array to the initial array
+      if (IErr == 0)
+         IErr = compareArrays(Init2DR8Dev, Test2DR8Dev);
+
+      // Check that the overlapped update completed on the owned cells and
+      // left the halo cells of the second array untouched
+      if (IErr == 0) {
+         auto Owned2DR8H = OMEGA::createHostMirrorCopy(Owned2DR8);
+         for (int ICell = 0; ICell < NumAll; ++ICell) {
+            for (int J = 0; J < N2; ++J) {
+               OMEGA::R8 RefVal = ICell < NumOwned ? 2.0 * ICell + J : 0.0;
+               if (Owned2DR8H(ICell, J) != RefVal)
+                  IErr = -1;
+            }
+         }
+      }
+
+      if (IErr == 0) {
+         LOG_INFO("HaloTest: Split-phase 2DR8 exchange test PASS");
+      } else {
+         LOG_INFO("HaloTest: Split-phase 2DR8 exchange test FAIL");
+         TotErr += -1;
+      }
+
+      // Test a grouped exchange of arrays of mixed type, rank and index space
+      // which are sent in a single message to each neighbor. Reset the halo
+      // elements of each test array and exchange them all together.
+      for (int IEdge = DefDecomp->NEdgesOwned; IEdge < DefDecomp->NEdgesAll;
+           ++IEdge) {
+         Test1DI4Edge(IEdge) = -1;
+      }
+      for (int IVertex = DefDecomp->NVerticesOwned;
+           IVertex < DefDecomp->NVerticesAll; ++IVertex) {
+         Test1DI4Vertex(IVertex) = -1;
+      }
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         Test1DR8(ICell) = -1;
+         for (int J = 0; J < N2; ++J) {
+            Test2DI8(ICell, J) = -1;
+            for (int K = 0; K < N3; ++K) {
+               Test3DR8(K, ICell, J) = -1;
+            }
+         }
+      }
+
+      OMEGA::HaloGroup Group;
+      IErr = Group.add(Test1DR8, OMEGA::OnCell);
+      IErr += Group.add(Test2DI8, OMEGA::OnCell);
+      IErr += Group.add(Test3DR8, OMEGA::OnCell);
+      IErr += Group.add(Test1DI4Edge, OMEGA::OnEdge);
+      IErr += Group.add(Test1DI4Vertex, OMEGA::OnVertex);
+      if (IErr == 0)
+         IErr = DefHalo->exchangeGroup(Group);
+      if (IErr == 0) {
+         IErr += compareArrays(Init1DR8, Test1DR8);
+         IErr += compareArrays(Init2DI8, Test2DI8);
+         IErr += compareArrays(Init3DR8, Test3DR8);
+         IErr += compareArrays(Init1DI4Edge, Test1DI4Edge);
+         IErr += compareArrays(Init1DI4Vertex, Test1DI4Vertex);
+      }
+
+      if (IErr == 0) {
+         LOG_INFO("HaloTest: Grouped exchange test PASS");
+      } else {
+         LOG_INFO("HaloTest: Grouped exchange test FAIL");
+         TotErr += -1;
+      }
+
+      // Test a persistent exchange pattern by repeating the exchange of a
+      // named group several times, resetting the halo elements each time
+      OMEGA::HaloGroup PersistGroup("HaloTestPattern");
+      IErr = PersistGroup.add(Test2DR8, OMEGA::OnCell);
+      IErr += PersistGroup.add(Test1DI4Edge, OMEGA::OnEdge);
+
+      for (int IStep = 0; IStep < 3; ++IStep) {
+         for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+            for (int J = 0; J < N2; ++J) {
+               Test2DR8(ICell, J) = -1;
+            }
+         }
+         for (int IEdge = DefDecomp->NEdgesOwned;
+              IEdge < DefDecomp->NEdgesAll; ++IEdge) {
+            Test1DI4Edge(IEdge) = -1;
+         }
+         if (IErr == 0)
+            IErr = DefHalo->exchangeGroup(PersistGroup);
+         if (IErr == 0) {
+            IErr += compareArrays(Init2DR8, Test2DR8);
+            IErr += compareArrays(Init1DI4Edge, Test1DI4Edge);
+         }
+      }
+
+      if (IErr == 0) {
+         LOG_INFO("HaloTest: Persistent exchange test PASS");
+      } else {
+         LOG_INFO("HaloTest: Persistent exchange test FAIL");
+         TotErr += -1;
+      }
+
+      // Test partial-depth exchanges which update only the first halo layer.
+      // Halo elements beyond the first layer must be left untouched.
+      OMEGA::I4 NFirstLayer = DefDecomp->NCellsHaloH(0);
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         Test1DR8(ICell) = -1;
+         for (int J = 0; J < N2; ++J) {
+            for (int K = 0; K < N3; ++K) {
+               Test3DR4(K, ICell, J) = -1;
+            }
+         }
+      }
+
+      IErr = DefHalo->exchangeHalo(Test1DR8, OMEGA::OnCell, 1);
+      IErr += DefHalo->exchangeHalo(Test3DR4, OMEGA::OnCell, 1);
+
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         bool InFirst = ICell < NFirstLayer;
+         if (Test1DR8(ICell) != (InFirst ? Init1DR8(ICell) : -1))
+            IErr = -1;
+         for (int J = 0; J < N2; ++J) {
+            for (int K = 0; K < N3; ++K) {
+               OMEGA::R4 Expected = InFirst ? Init3DR4(K, ICell, J) : -1;
+               if (Test3DR4(K, ICell, J) != Expected)
+                  IErr = -1;
+            }
+         }
+      }
+
+      if (IErr == 0) {
+         LOG_INFO("HaloTest: Partial-depth exchange test PASS");
+      } else {
+         LOG_INFO("HaloTest: Partial-depth exchange test FAIL");
+         TotErr += -1;
+      }
+
+      // Repeat several exchanges using neighborhood collectives instead of
+      // point-to-point messages, then switch back to the default method
+      IErr = DefHalo->setExchangeMethod(OMEGA::NeighborCollective);
+      if (IErr != 0) {
+         LOG_ERROR("HaloTest: error setting neighborhood collective method");
+         TotErr += -1;
+      }
+
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         Test1DR8(ICell) = -1;
+         for (int J = 0; J < N2; ++J) {
+            for (int K = 0; K < N3; ++K) {
+               Test3DR4(K, ICell, J) = -1;
+            }
+         }
+      }
+      haloExchangeTest(DefHalo, Init1DR8, Test1DR8, "Collective 1DR8", TotErr);
+      haloExchangeTest(DefHalo, Init3DR4, Test3DR4, "Collective 3DR4", TotErr);
+
+      for (int IEdge = DefDecomp->NEdgesOwned; IEdge < DefDecomp->NEdgesAll;
+           ++IEdge) {
+         Test1DI4Edge(IEdge) = -1;
+      }
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         for (int J = 0; J < N2; ++J) {
+            Test2DR8(ICell, J) = -1;
+         }
+      }
+      IErr = DefHalo->exchangeGroup(PersistGroup);
+      if (IErr == 0) {
+         IErr += compareArrays(Init2DR8, Test2DR8);
+         IErr += compareArrays(Init1DI4Edge, Test1DI4Edge);
+      }
+      if (IErr == 0) {
+         LOG_INFO("HaloTest: Collective group exchange test PASS");
+      } else {
+         LOG_INFO("HaloTest: Collective group exchange test FAIL");
+         TotErr += -1;
+      }
+
+      DefHalo->setExchangeMethod(OMEGA::PointToPoint);
+
+      // Test reduced-precision exchanges, in which R8 arrays are sent in R4
+      // precision. Halo values must equal the owned values rounded to R4.
+      OMEGA::HostArray1DR8 InitFrac("InitFrac", NumAll);
+      OMEGA::HostArray1DR8 TestFrac("TestFrac", NumAll);
+      for (int ICell = 0; ICell < NumAll; ++ICell) {
+         InitFrac(ICell) = DefDecomp->CellIDH(ICell) + 1.0 / 3.0;
+      }
+      OMEGA::deepCopy(TestFrac, InitFrac);
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         TestFrac(ICell) = -1;
+      }
+
+      IErr = DefHalo->exchangeHalo(TestFrac, OMEGA::OnCell, 0, true);
+
+      for (int ICell = 0; ICell < NumAll; ++ICell) {
+         OMEGA::R8 Expected = InitFrac(ICell);
+         if (ICell >= NumOwned)
+            Expected = static_cast<OMEGA::R4>(Expected);
+         if (TestFrac(ICell) != Expected)
+            IErr = -1;
+      }
+
+      if (IErr == 0) {
+         LOG_INFO("HaloTest: Reduced-precision exchange test PASS");
+      } else {
+         LOG_INFO("HaloTest: Reduced-precision exchange test FAIL");
+         TotErr += -1;
+      }
+
+      // Exchange a group mixing a reduced-precision R8 array with an integer
+      // array, which is always sent exactly
+      OMEGA::HaloGroup ReducedGroup;
+      IErr = ReducedGroup.add(Test3DR8, OMEGA::OnCell, 0, true);
+      IErr += ReducedGroup.add(Test1DI4Edge, OMEGA::OnEdge);
+
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         for (int J = 0; J < N2; ++J) {
+            for (int K = 0; K < N3; ++K) {
+               Test3DR8(K, ICell, J) = -1;
+            }
+         }
+      }
+      for (int IEdge = DefDecomp->NEdgesOwned; IEdge < DefDecomp->NEdgesAll;
+           ++IEdge) {
+         Test1DI4Edge(IEdge) = -1;
+      }
+
+      IErr += DefHalo->exchangeGroup(ReducedGroup);
+      if (IErr == 0) {
+         // The values of Init3DR8 are integers exactly representable in R4
+         IErr += compareArrays(Init3DR8, Test3DR8);
+         IErr += compareArrays(Init1DI4Edge, Test1DI4Edge);
+      }
+      if (IErr == 0) {
+         LOG_INFO("HaloTest: Reduced-precision group exchange test PASS");
+      } else {
+         LOG_INFO("HaloTest: Reduced-precision group exchange test FAIL");
+         TotErr += -1;
+      }
+
       // Memory clean up
+      OMEGA::Halo::clear();
       OMEGA::Decomp::clear();
       OMEGA::MachEnv::removeAll();
 
@@ -10,13 +10,16 @@
 //===-----------------------------------------------------------------------===/
 
 #include "IO.h"
+#include "Config.h"
 #include "DataTypes.h"
 #include "Decomp.h"
 #include "Logging.h"
 #include "MachEnv.h"
 #include "mpi.h"
 
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // The initialization routine for IO testing. It calls various
@@ -972,6 +975,31 @@ int main(int argc, char *argv[]) {
          LOG_INFO("IOTest: read/write var metadata string test FAIL");
       }
 
+      // Read the same array directly into a device array and check it
+      // against the host reference
+      OMEGA::Array2DR8 DevR8Cell("DevR8Cell", NCellsSize, NVertLevels);
+      Err = OMEGA::IO::readArray(DevR8Cell, "CellR8", InFileID, DecompCellR8,
+                                 VarIDCellR8);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("IOTest: error reading R8 device array on Cells FAIL");
+      }
+      auto DevR8CellH = Kokkos::create_mirror_view_and_copy(
+          Kokkos::HostSpace(), DevR8Cell);
+      Err = 0;
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         for (int k = 0; k < NVertLevels; ++k) {
+            if (DevR8CellH(Cell, k) != RefR8Cell(Cell, k))
+               ++Err;
+         }
+      }
+      if (Err == 0) {
+         LOG_INFO("IOTest: read R8 device array test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("IOTest: read R8 device array test FAIL");
+      }
+
       // Finished reading, close file
       Err = OMEGA::IO::closeFile(InFileID);
       if (Err != 0) {
@@ -979,6 +1007,113 @@ int main(int argc, char *argv[]) {
          LOG_ERROR("IOTest: error closing input file FAIL");
       }
 
+      // Test batched writes of several arrays that share a decomposition
+      // using the write queue, with a small buffer to also test the
+      // automatic flush.
+      int BatchFileID;
+      Err = OMEGA::IO::openFile(BatchFileID, "IOTestBatch.nc",
+                                OMEGA::IO::ModeWrite, OMEGA::IO::FmtDefault,
+                                OMEGA::IO::IfExists::Replace);
+      int BatchDimIDs[2];
+      Err += OMEGA::IO::defineDim(BatchFileID, "NCells", NCellsGlobal,
+                                  BatchDimIDs[0]);
+      Err += OMEGA::IO::defineDim(BatchFileID, "NVertLevels", NVertLevels,
+                                  BatchDimIDs[1]);
+      int VarIDBatchR8A;
+      int VarIDBatchR8B;
+      int VarIDBatchI4;
+      int VarIDCompress;
+      Err += OMEGA::IO::defineVar(BatchFileID, "BatchR8A", OMEGA::IO::IOTypeR8,
+                                  2, BatchDimIDs, VarIDBatchR8A);
+      Err += OMEGA::IO::defineVar(BatchFileID, "BatchR8B", OMEGA::IO::IOTypeR8,
+                                  2, BatchDimIDs, VarIDBatchR8B);
+      Err += OMEGA::IO::defineVar(BatchFileID, "BatchI4", OMEGA::IO::IOTypeI4,
+                                  2, BatchDimIDs, VarIDBatchI4);
+      OMEGA::IO::Compression Compress;
+      Compress.DeflateLevel = 1;
+      Compress.Shuffle      = true;
+      Compress.QuantizeBits = 10;
+      Err += OMEGA::IO::defineVar(BatchFileID, "CompressR8",
+                                  OMEGA::IO::IOTypeR8, 2, BatchDimIDs,
+                                  VarIDCompress, Compress);
+      Err += OMEGA::IO::endDefinePhase(BatchFileID);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("IOTest: error defining batched write file FAIL");
+      }
+
+      OMEGA::HostArray2DR8 RefR8CellB("RefR8CellB", NCellsSize, NVertLevels);
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         for (int k = 0; k < NVertLevels; ++k)
+            RefR8CellB(Cell, k) = -RefR8Cell(Cell, k);
+      }
+      OMEGA::I8 BatchBufferSize = 2 * CellArraySize * sizeof(OMEGA::R8);
+      Err = OMEGA::IO::setWriteBufferSize(BatchBufferSize);
+      Err += OMEGA::IO::queueArray(RefR8Cell.data(), CellArraySize, &FillR8,
+                                   BatchFileID, DecompCellR8, VarIDBatchR8A);
+      Err += OMEGA::IO::queueArray(RefR8CellB.data(), CellArraySize, &FillR8,
+                                   BatchFileID, DecompCellR8, VarIDBatchR8B);
+      Err += OMEGA::IO::queueArray(RefI4Cell.data(), CellArraySize, &FillI4,
+                                   BatchFileID, DecompCellI4, VarIDBatchI4);
+      Err += OMEGA::IO::flushArrays(BatchFileID);
+      Err += OMEGA::IO::writeArray(RefR8Cell.data(), CellArraySize, &FillR8,
+                                   BatchFileID, DecompCellR8, VarIDCompress);
+      Err += OMEGA::IO::closeFile(BatchFileID);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("IOTest: error in batched write FAIL");
+      }
+
+      Err = OMEGA::IO::openFile(BatchFileID, "IOTestBatch.nc",
+                                OMEGA::IO::ModeRead);
+      Err += OMEGA::IO::readArray(NewR8Cell.data(), CellArraySize, "BatchR8A",
+                                  BatchFileID, DecompCellR8, VarIDBatchR8A);
+      OMEGA::HostArray2DR8 NewR8CellB("NewR8CellB", NCellsSize, NVertLevels);
+      Err += OMEGA::IO::readArray(NewR8CellB.data(), CellArraySize, "BatchR8B",
+                                  BatchFileID, DecompCellR8, VarIDBatchR8B);
+      Err += OMEGA::IO::readArray(NewI4Cell.data(), CellArraySize, "BatchI4",
+                                  BatchFileID, DecompCellI4, VarIDBatchI4);
+      OMEGA::HostArray2DR8 NewCompress("NewCompress", NCellsSize, NVertLevels);
+      Err += OMEGA::IO::readArray(NewCompress.data(), CellArraySize,
+                                  "CompressR8", BatchFileID, DecompCellR8,
+                                  VarIDCompress);
+      OMEGA::I4 QuantizeBitsNew = 0;
+      Err += OMEGA::IO::readMeta("QuantizeBits", QuantizeBitsNew, BatchFileID,
+                                 VarIDCompress);
+      Err += OMEGA::IO::closeFile(BatchFileID);
+
+      Err1 = 0;
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         for (int k = 0; k < NVertLevels; ++k) {
+            if (NewR8Cell(Cell, k) != RefR8Cell(Cell, k) ||
+                NewR8CellB(Cell, k) != RefR8CellB(Cell, k) ||
+                NewI4Cell(Cell, k) != RefI4Cell(Cell, k))
+               Err1++;
+         }
+      }
+      if (Err == 0 && Err1 == 0) {
+         LOG_INFO("IOTest: batched write test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("IOTest: batched write test FAIL");
+      }
+
+      // Quantized values must be within the rounding error of the bits kept
+      Err2 = 0;
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         for (int k = 0; k < NVertLevels; ++k) {
+            OMEGA::R8 Tol = std::abs(RefR8Cell(Cell, k)) * std::ldexp(1.0, -10);
+            if (std::abs(NewCompress(Cell, k) - RefR8Cell(Cell, k)) > Tol)
+               Err2++;
+         }
+      }
+      if (Err == 0 && Err2 == 0 && QuantizeBitsNew == 10) {
+         LOG_INFO("IOTest: compressed write test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("IOTest: compressed write test FAIL");
+      }
+
       // Test destruction of Decompositions
       Err = OMEGA::IO::destroyDecomp(DecompCellI4);
       if (Err != 0) {
@@ -1043,6 +1178,133 @@ int main(int argc, char *argv[]) {
          LOG_ERROR("IOTest: error destroying decomp Vrtx R8 FAIL");
       }
 
+      // Finalize the IO system
+      Err = OMEGA::IO::finalize();
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("IOTest: error finalizing IO FAIL");
+      }
+
+      // Test asynchronous writes by initializing the IO system again with
+      // one IO server task set in the IO section of the configuration. The
+      // compute tasks write a linearly distributed array and read it back,
+      // while the server task stays in initAsync until the compute tasks
+      // finalize the IO system. Without OMEGA_ASYNC_IO, all tasks compute.
+      OMEGA::Config IOConfig("IO");
+      Err = IOConfig.add("IOServerTasks", 1);
+      Err += OMEGA::Config::getOmegaConfig()->add(IOConfig);
+      MPI_Comm CompComm = MPI_COMM_NULL;
+      if (Err == 0)
+         Err = OMEGA::IO::initAsync(Comm, CompComm);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("IOTest: error initializing async IO FAIL");
+      } else if (CompComm != MPI_COMM_NULL) {
+         int NumCompTasks;
+         int MyCompTask;
+         MPI_Comm_size(CompComm, &NumCompTasks);
+         MPI_Comm_rank(CompComm, &MyCompTask);
+         const int NLocal  = 100;
+         const int NGlobal = NLocal * NumCompTasks;
+
+         std::vector<int> OffsetAsync(NLocal);
+         std::vector<OMEGA::R8> RefAsync(NLocal);
+         std::vector<OMEGA::R8> NewAsync(NLocal, 0.0);
+         for (int I = 0; I < NLocal; ++I) {
+            OffsetAsync[I] = MyCompTask * NLocal + I;
+            RefAsync[I]    = OffsetAsync[I] * 1.23456789;
+         }
+
+         int DecompAsync;
+         int AsyncFileID;
+         int DimAsyncID;
+         int VarIDAsync;
+         std::vector<int> AsyncDims{NGlobal};
+         Err = OMEGA::IO::createDecomp(DecompAsync, OMEGA::IO::IOTypeR8, 1,
+                                       AsyncDims, NLocal, OffsetAsync,
+                                       OMEGA::IO::DefaultRearr);
+         Err += OMEGA::IO::openFile(AsyncFileID, "IOTestAsync.nc",
+                                    OMEGA::IO::ModeWrite, OMEGA::IO::FmtDefault,
+                                    OMEGA::IO::IfExists::Replace);
+         Err += OMEGA::IO::defineDim(AsyncFileID, "NAsync", NGlobal,
+                                     DimAsyncID);
+         Err += OMEGA::IO::defineVar(AsyncFileID, "AsyncR8",
+                                     OMEGA::IO::IOTypeR8, 1, &DimAsyncID,
+                                     VarIDAsync);
+         Err += OMEGA::IO::endDefinePhase(AsyncFileID);
+         Err += OMEGA::IO::writeArray(RefAsync.data(), NLocal, &FillR8,
+                                      AsyncFileID, DecompAsync, VarIDAsync);
+         Err += OMEGA::IO::closeFile(AsyncFileID);
+
+         Err += OMEGA::IO::openFile(AsyncFileID, "IOTestAsync.nc",
+                                    OMEGA::IO::ModeRead);
+         Err += OMEGA::IO::readArray(NewAsync.data(), NLocal, "AsyncR8",
+                                     AsyncFileID, DecompAsync, VarIDAsync);
+         Err += OMEGA::IO::closeFile(AsyncFileID);
+         Err += OMEGA::IO::destroyDecomp(DecompAsync);
+
+         int AsyncErrCount = 0;
+         for (int I = 0; I < NLocal; ++I) {
+            if (NewAsync[I] != RefAsync[I])
+               ++AsyncErrCount;
+         }
+         MPI_Allreduce(MPI_IN_PLACE, &AsyncErrCount, 1, MPI_INT, MPI_SUM,
+                       CompComm);
+
+         if (Err == 0 && AsyncErrCount == 0) {
+            LOG_INFO("IOTest: async write and read PASS");
+         } else {
+            RetVal += 1;
+            LOG_ERROR("IOTest: async write and read FAIL");
+         }
+
+         Err = OMEGA::IO::finalize();
+         if (Err != 0) {
+            RetVal += 1;
+            LOG_ERROR("IOTest: error finalizing async IO FAIL");
+         }
+      }
+
+      // Placement of IO tasks by stride, reduced to fit in the tasks
+      OMEGA::IO::Settings IOSettings;
+      IOSettings.NumIOTasks = NumTasks + 1;
+      IOSettings.IOStride   = 3;
+      OMEGA::IO::placeIOTasks(Comm, IOSettings);
+      if (IOSettings.NumIOTasks == (NumTasks - 1) / 3 + 1 &&
+          IOSettings.IOStride == 3) {
+         LOG_INFO("IOTest: stride placement PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("IOTest: stride placement {} tasks stride {} FAIL",
+                   IOSettings.NumIOTasks, IOSettings.IOStride);
+      }
+
+      // Placement of two IO tasks per node. On a single node, the IO tasks
+      // are evenly spaced among all tasks.
+      IOSettings.Place          = OMEGA::IO::Placement::Node;
+      IOSettings.IOTasksPerNode = 2;
+      IOSettings.Rearr          = OMEGA::IO::RearrSubset;
+      OMEGA::IO::placeIOTasks(Comm, IOSettings);
+      if (DefEnv->getNumNodes() > 1 ||
+          (NumTasks % 2 == 0 && IOSettings.NumIOTasks == 2 &&
+           IOSettings.IOStride == NumTasks / 2)) {
+         LOG_INFO("IOTest: node placement PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("IOTest: node placement {} tasks stride {} FAIL",
+                   IOSettings.NumIOTasks, IOSettings.IOStride);
+      }
+
+      // Re-initialize with the subset rearranger and node placement
+      Err = OMEGA::IO::init(Comm, IOSettings);
+      Err += OMEGA::IO::finalize();
+      if (Err == 0 && OMEGA::IO::DefaultRearr == OMEGA::IO::RearrSubset) {
+         LOG_INFO("IOTest: init with settings PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("IOTest: init with settings FAIL");
+      }
+
       // Exit environments
       OMEGA::Decomp::clear();
       OMEGA::MachEnv::removeAll();
@@ -481,19 +481,95 @@ int main(int argc, char *argv[]) {
    } // end if member of general subset env
 
    //---------------------------------------------------------------------------
-   // Test setting of compile-time vector length
+   // Test the node layout of the default environment. The number of tasks
+   // on each node summed over the node leaders must be the total number
+   // of tasks.
+
+   int MyNode       = DefEnv->getMyNode();
+   int NumNodes     = DefEnv->getNumNodes();
+   int MyNodeTask   = DefEnv->getMyNodeTask();
+   int NumNodeTasks = DefEnv->getNumNodeTasks();
+   int LeaderTasks  = MyNodeTask == 0 ? NumNodeTasks : 0;
+   int LeaderCount  = MyNodeTask == 0 ? 1 : 0;
+   int SumNodeTasks = 0;
+   int SumLeaders   = 0;
+   MPI_Allreduce(&LeaderTasks, &SumNodeTasks, 1, MPI_INT, MPI_SUM,
+                 MPI_COMM_WORLD);
+   MPI_Allreduce(&LeaderCount, &SumLeaders, 1, MPI_INT, MPI_SUM,
+                 MPI_COMM_WORLD);
+   if (MyNode >= 0 && MyNode < NumNodes && MyNodeTask >= 0 &&
+       MyNodeTask < NumNodeTasks && SumNodeTasks == WorldSize &&
+       SumLeaders == NumNodes)
+      std::cout << "DefaultEnv node layout test: PASS" << std::endl;
+   else {
+      RetVal += 1;
+      std::cout << "DefaultEnv node layout test: FAIL "
+                << "MyNode, NumNodes = " << MyNode << " " << NumNodes
+                << " MyNodeTask, NumNodeTasks = " << MyNodeTask << " "
+                << NumNodeTasks << std::endl;
+   }
+
+   // Test the device binding: no devices, one device per task, a single
+   // device and two devices shared by contiguous blocks of tasks
+   int DeviceID2 = DefEnv->getDeviceID(2);
+   if (DefEnv->getDeviceID(0) == -1 &&
+       DefEnv->getDeviceID(NumNodeTasks) == MyNodeTask &&
+       DefEnv->getDeviceID(1) == 0 && DeviceID2 >= 0 && DeviceID2 < 2 &&
+       (NumNodeTasks < 2 || DeviceID2 == (2 * MyNodeTask) / NumNodeTasks))
+      std::cout << "DefaultEnv device binding test: PASS" << std::endl;
+   else {
+      RetVal += 1;
+      std::cout << "DefaultEnv device binding test: FAIL" << std::endl;
+   }
 
+   //---------------------------------------------------------------------------
+   // Test setting of compile-time vector length. It is the configured
+   // OMEGA_VECTOR_LENGTH, which defaults to one level per thread on GPUs and
+   // the SIMD width on CPUs (see OmegaBuild.cmake)
+
+#if defined(OMEGA_ENABLE_CUDA) || defined(OMEGA_ENABLE_HIP) || \
+    defined(OMEGA_ENABLE_SYCL)
+   constexpr int ArchVecLength = 1;
+#else
+   constexpr int ArchVecLength = 8;
+#endif
 #ifdef OMEGA_VECTOR_LENGTH
-   if (OMEGA::VecLength == 16)
+   constexpr int ConfigVecLength = OMEGA_VECTOR_LENGTH;
+#else
+   constexpr int ConfigVecLength = 1;
+#endif
+   if (OMEGA::VecLength == ConfigVecLength)
       std::cout << "MPI vector length test: PASS" << std::endl;
    else {
       RetVal += 1;
-      std::cout << "MPI vector length test: FAIL" << std::endl;
-      std::cout << "Was test driver built with -D OMEGA_VECTOR_LENGTH=16 ?"
-                << std::endl;
+      std::cout << "MPI vector length test: FAIL "
+                << "VecLength = " << OMEGA::VecLength
+                << ", expected = " << ConfigVecLength << std::endl;
+   }
+
+#ifdef OMEGA_DEFAULT_VECTOR_LENGTH
+   if (OMEGA_DEFAULT_VECTOR_LENGTH == ArchVecLength)
+      std::cout << "MPI default vector length test: PASS" << std::endl;
+   else {
+      RetVal += 1;
+      std::cout << "MPI default vector length test: FAIL "
+                << "default = " << OMEGA_DEFAULT_VECTOR_LENGTH
+                << ", expected = " << ArchVecLength << std::endl;
    }
 #endif
 
+   // The vertical chunks must cover all levels, with a partial last chunk
+   // if the number of levels is not a multiple of the vector length
+   if (OMEGA::numVertChunks(OMEGA::VecLength) == 1 &&
+       OMEGA::numVertChunks(3 * OMEGA::VecLength) == 3 &&
+       OMEGA::numVertChunks(3 * OMEGA::VecLength + 1) == 4 &&
+       OMEGA::numVertChunks(1) == 1)
+      std::cout << "Vertical chunks test: PASS" << std::endl;
+   else {
+      RetVal += 1;
+      std::cout << "Vertical chunks test: FAIL" << std::endl;
+   }
+
    // finalize and clean up environments (test both removal functions)
    OMEGA::MachEnv::removeEnv("Contig");
    OMEGA::MachEnv::removeAll();
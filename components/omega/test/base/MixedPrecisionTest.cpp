@@ -0,0 +1,156 @@
+//===-- Test driver for OMEGA mixed precision --------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the precision guarantees of Real reductions
+///
+/// This driver checks the types used by a build, ie. that Real is R4 only
+/// with SINGLE_PRECISION and that the mesh metrics stay R8 unless
+/// OMEGA_COMPACT_MESH is set, and checks that sums of Real arrays are
+/// accumulated in double precision whatever the precision of Real. The sums
+/// use values whose single precision accumulation loses every small term,
+/// while the exact sum is representable in double precision. The test
+/// passes in both the default and the single precision build, which is
+/// verified by running the full test suite with OMEGA_SINGLE_PRECISION.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "Reductions.h"
+#include "mpi.h"
+
+#include <type_traits>
+
+using namespace OMEGA;
+
+constexpr I4 NCells  = 1 << 16; // elements per task
+constexpr I4 NLevels = 4;       // levels of 2-d arrays
+constexpr R8 Small   = 0x1p-24; // lost when added to 1 in R4
+
+//------------------------------------------------------------------------------
+// Checks the floating point types of the build
+
+int testTypes() {
+
+   int Err = 0;
+
+#ifdef SINGLE_PRECISION
+   constexpr bool RealOK = std::is_same_v<Real, R4>;
+#else
+   constexpr bool RealOK = std::is_same_v<Real, R8>;
+#endif
+#ifdef OMEGA_COMPACT_MESH
+   constexpr bool MetricOK = std::is_same_v<MetricReal, R4>;
+#else
+   constexpr bool MetricOK = std::is_same_v<MetricReal, R8>;
+#endif
+   constexpr bool MeshOK =
+       std::is_same_v<decltype(HorzMesh::AreaCell), Array1DR8> &&
+       std::is_same_v<decltype(HorzMesh::DvEdge), Array1DR8>;
+
+   if (RealOK && MetricOK && MeshOK) {
+      LOG_INFO("MixedPrecisionTest: types of build: PASS");
+   } else {
+      LOG_ERROR("MixedPrecisionTest: types of build: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testTypes
+
+//------------------------------------------------------------------------------
+// Checks that global and local sums of Real arrays accumulate in R8
+
+int testSums() {
+
+   int Err = 0;
+
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm Comm    = DefEnv->getComm();
+   const I4 NTasks  = DefEnv->getNumTasks();
+   const R8 TaskSum = 1.0 + (NCells - 1) * Small;
+   const R8 Exact   = NTasks * TaskSum;
+
+   // One large value followed by small values on each task
+   Array1DReal Values("Values", NCells);
+   Kokkos::deep_copy(Values, static_cast<Real>(Small));
+   Kokkos::deep_copy(Kokkos::subview(Values, 0), 1.0_Real);
+
+   // Global sum to an R8 result
+   R8 Sum8 = 0;
+   Err += globalSum(Values, Comm, &Sum8);
+   if (Sum8 == Exact) {
+      LOG_INFO("MixedPrecisionTest: global sum of Real to R8: PASS");
+   } else {
+      LOG_ERROR("MixedPrecisionTest: global sum {} expected {}: FAIL", Sum8,
+                Exact);
+      Err += 1;
+   }
+
+   // Global sum to a Real result is the exact sum rounded once
+   Real SumReal = 0;
+   Err += globalSum(Values, Comm, &SumReal);
+   if (SumReal == static_cast<Real>(Exact)) {
+      LOG_INFO("MixedPrecisionTest: global sum of Real to Real: PASS");
+   } else {
+      LOG_ERROR("MixedPrecisionTest: global sum {} expected {}: FAIL",
+                SumReal, static_cast<Real>(Exact));
+      Err += 1;
+   }
+
+   // Weighted double-double sums over cells and levels
+   Array2DReal Layers("Layers", NCells, NLevels);
+   Kokkos::deep_copy(Layers, static_cast<Real>(Small));
+   Kokkos::deep_copy(Kokkos::subview(Layers, 0, Kokkos::ALL), 1.0_Real);
+   Array1DReal Weight("Weight", NCells);
+   Kokkos::deep_copy(Weight, 2.0_Real);
+   DDValue Local = localWeightedSumDD(Layers, Weight, NoWeight(), NoMask(),
+                                      NCells);
+   std::vector<R8> WeightedSum;
+   Err += globalSum(std::vector<DDValue>{Local}, Comm, WeightedSum);
+   if (WeightedSum[0] == 2 * NLevels * Exact) {
+      LOG_INFO("MixedPrecisionTest: weighted sum of Real: PASS");
+   } else {
+      LOG_ERROR("MixedPrecisionTest: weighted sum {} expected {}: FAIL",
+                WeightedSum[0], 2 * NLevels * Exact);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testSums
+
+//------------------------------------------------------------------------------
+// The test driver for mixed precision
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+
+      RetVal += testTypes();
+      RetVal += testSums();
+
+      if (RetVal == 0)
+         LOG_INFO("MixedPrecisionTest: Successful completion");
+
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,127 @@
+//===-- Test driver for OMEGA SIMD packs -------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA SIMD packs
+///
+/// This driver tests the Pack type that holds a chunk of VecLength vertical
+/// levels. It loads the chunks of an array with a number of levels that is
+/// not a multiple of VecLength, combines them with Pack arithmetic in a
+/// parallel loop and checks the stored result, including the clamping of
+/// the loads and the skipped stores of the partial last chunk. It outputs
+/// a PASS if all results match the same operations on scalars.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include <iostream>
+
+#include "DataTypes.h"
+#include "OmegaKokkos.h"
+#include "Pack.h"
+#include "mpi.h"
+
+using namespace OMEGA;
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   // initialize environments
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      const int NumCells    = 10;
+      const int NumVertLvls = 3 * VecLength + 1;
+      const int KLast       = NumVertLvls - 1;
+      const Real Fill       = -1.0_Real;
+
+      HostArray2DReal RefA("RefA", NumCells, NumVertLvls);
+      HostArray2DReal RefB("RefB", NumCells, NumVertLvls);
+      for (int ICell = 0; ICell < NumCells; ++ICell) {
+         for (int K = 0; K < NumVertLvls; ++K) {
+            RefA(ICell, K) = ICell + 0.5_Real * K + 1.0_Real;
+            RefB(ICell, K) = 2.0_Real * ICell - K;
+         }
+      }
+      Array2DReal A = createDeviceMirrorCopy(RefA);
+      Array2DReal B = createDeviceMirrorCopy(RefB);
+
+      // Result array with one extra level, to check that the stores of the
+      // partial last chunk stop at KLast
+      Array2DReal Res("Res", NumCells, NumVertLvls + 1);
+      Kokkos::deep_copy(Res, Fill);
+      auto ResLvls = Kokkos::subview(Res, Kokkos::ALL,
+                                     std::make_pair(0, NumVertLvls));
+
+      parallelFor(
+          {NumCells, numVertChunks(NumVertLvls)},
+          KOKKOS_LAMBDA(int ICell, int KChunk) {
+             const int KStart = KChunk * VecLength;
+             const RealPack PA = RealPack::load(A, ICell, KStart, KLast);
+             const RealPack PB = RealPack::load(B, ICell, KStart, KLast);
+             RealPack Sum(1.0_Real);
+             Sum += 2.0_Real * PA - PB * PA / (PA + 1.0_Real);
+             Sum.store(ResLvls, ICell, KStart, KLast);
+          });
+
+      auto ResH = createHostMirrorCopy(Res);
+
+      int ErrCount = 0;
+      for (int ICell = 0; ICell < NumCells; ++ICell) {
+         for (int K = 0; K < NumVertLvls; ++K) {
+            const Real ValA = RefA(ICell, K);
+            const Real ValB = RefB(ICell, K);
+            const Real Ref =
+                1.0_Real + (2.0_Real * ValA - ValB * ValA / (ValA + 1.0_Real));
+            if (Kokkos::abs(ResH(ICell, K) - Ref) >
+                1.0e-6_Real * Kokkos::abs(Ref))
+               ++ErrCount;
+         }
+         if (ResH(ICell, NumVertLvls) != Fill)
+            ++ErrCount;
+      }
+
+      if (ErrCount == 0)
+         std::cout << "Pack arithmetic and load/store test: PASS" << std::endl;
+      else {
+         RetVal += 1;
+         std::cout << "Pack arithmetic and load/store test: FAIL" << std::endl;
+      }
+
+      // Check the sum of a pack into a register array
+      Array1DReal SumArr("SumArr", VecLength);
+      parallelFor(
+          {1}, KOKKOS_LAMBDA(int I) {
+             Real Tend[VecLength];
+             for (int KVec = 0; KVec < VecLength; ++KVec)
+                Tend[KVec] = KVec;
+             const RealPack PA = RealPack::load(A, 0, 0, KLast);
+             PA.addTo(Tend);
+             for (int KVec = 0; KVec < VecLength; ++KVec)
+                SumArr(KVec) = Tend[KVec];
+          });
+      auto SumArrH = createHostMirrorCopy(SumArr);
+
+      ErrCount = 0;
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         if (SumArrH(KVec) != KVec + RefA(0, KVec))
+            ++ErrCount;
+      }
+
+      if (ErrCount == 0)
+         std::cout << "Pack addTo test: PASS" << std::endl;
+      else {
+         RetVal += 1;
+         std::cout << "Pack addTo test: FAIL" << std::endl;
+      }
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
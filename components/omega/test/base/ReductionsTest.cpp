@@ -6,7 +6,9 @@
 //
 //===-----------------------------------------------------------------------===/
 
+#include <cmath>
 #include <string>
+#include <vector>
 
 #include <mpi.h>
 
@@ -363,6 +365,200 @@ int main(int argc, char *argv[]) {
          RetVal += 1;
       printf("Global sum device A1DR4: %s (exp,act=%.10f,%.10f)\n", res, expR4,
              MyResR4);
+
+      // test reproducible SUM of R8 arrays on device, which must match the
+      // host sums of the same arrays
+      Array1DR8 DevArr1DR8("DevArr1DR8", NumCells);
+      Array2DR8 DevArr2DR8("DevArr2DR8", NumCells, NumVertLvls);
+      deepCopy(DevArr1DR8, HostArr1DR8);
+      deepCopy(DevArr2DR8, HostArr2DR8);
+
+      R8 HostRes1DR8 = 0.0, HostRes2DR8 = 0.0, DevRes1DR8 = 0.0;
+      err = globalSum(HostArr1DR8, Comm, &HostRes1DR8);
+      err += globalSum(DevArr1DR8, Comm, &DevRes1DR8);
+      res = "FAIL";
+      if (err == 0 && DevRes1DR8 == HostRes1DR8)
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global sum device A1DR8: %s (exp,act=%.13lf,%.13lf)\n", res,
+             HostRes1DR8, DevRes1DR8);
+
+      R8 DevRes2DR8 = 0.0;
+      err = globalSum(HostArr2DR8, Comm, &HostRes2DR8);
+      err += globalSum(DevArr2DR8, Comm, &DevRes2DR8);
+      res = "FAIL";
+      if (err == 0 && DevRes2DR8 == HostRes2DR8)
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global sum device A2DR8: %s (exp,act=%.13lf,%.13lf)\n", res,
+             HostRes2DR8, DevRes2DR8);
+
+      // test multi-field SUM of R8 arrays on device, which reduces all
+      // fields in a single MPI call
+      Array2DR8 DevArr2DR8b("DevArr2DR8b", NumCells, NumVertLvls);
+      parallelFor(
+          {NumCells, NumVertLvls}, KOKKOS_LAMBDA(int i, int j) {
+             DevArr2DR8b(i, j) = 2.0 * DevArr2DR8(i, j);
+          });
+      Kokkos::fence();
+
+      std::vector<Array2DR8> DevFields{DevArr2DR8, DevArr2DR8b};
+      std::vector<R8> DevFieldSums(2, 0.0);
+      R8 DevRes2DR8b = 0.0;
+      err = globalSum(DevArr2DR8b, Comm, &DevRes2DR8b);
+      err += globalSum(DevFields, Comm, DevFieldSums);
+      res = "FAIL";
+      if (err == 0 && DevFieldSums[0] == HostRes2DR8 &&
+          DevFieldSums[1] == DevRes2DR8b)
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global sum device multi-field A2DR8: %s\n", res);
+
+      // test multi-field SUM with product of R8 arrays on device, using the
+      // second array as a mask that doubles the first
+      std::vector<Array2DR8> DevMasks(2);
+      DevMasks[0] = Array2DR8("DevMask0", NumCells, NumVertLvls);
+      DevMasks[1] = Array2DR8("DevMask1", NumCells, NumVertLvls);
+      Kokkos::deep_copy(DevMasks[0], 2.0);
+      Kokkos::deep_copy(DevMasks[1], 1.0);
+      std::vector<Array2DR8> DevProdFields{DevArr2DR8, DevArr2DR8b};
+      err = globalSum(DevProdFields, DevMasks, Comm, DevFieldSums);
+      res = "FAIL";
+      if (err == 0 && DevFieldSums[0] == DevRes2DR8b &&
+          DevFieldSums[1] == DevRes2DR8b)
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global sum device multi-field product A2DR8: %s\n", res);
+
+      // test weighted and masked SUM, MIN, MAX over owned cells on device
+      // with a cell weight and a mask that excludes the last cell and level
+      I4 NOwned = NumCells - 1;
+      Array1DR8 DevWeight("DevWeight", NumCells);
+      Array2DI4 DevMask("DevMask", NumCells, NumVertLvls);
+      Kokkos::deep_copy(DevWeight, 2.0);
+      parallelFor(
+          {NumCells, NumVertLvls}, KOKKOS_LAMBDA(int i, int j) {
+             DevMask(i, j) = j < NumVertLvls - 1 ? 1 : 0;
+          });
+      Kokkos::fence();
+      auto HostWeight = createHostMirrorCopy(DevWeight);
+      auto HostMask   = createHostMirrorCopy(DevMask);
+
+      R8 SumWeighted = 0.0;
+      for (i = 0; i < NOwned; i++) {
+         for (j = 0; j < NumVertLvls - 1; j++) {
+            SumWeighted += 2.0 * HostArr2DR8(i, j);
+         }
+      }
+      expR8 = SumWeighted * MySize;
+
+      R8 HostResWtd = 0.0, DevResWtd = 0.0;
+      err = globalSum(HostArr2DR8, HostWeight, HostMask, Comm, &HostResWtd,
+                      NOwned);
+      err += globalSum(DevArr2DR8, DevWeight, DevMask, Comm, &DevResWtd,
+                       NOwned);
+      res = "FAIL";
+      if (err == 0 && DevResWtd == HostResWtd &&
+          std::abs(HostResWtd - expR8) <= 1.0e-13 * std::abs(expR8))
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global weighted sum device A2DR8: %s (exp,act=%.13lf,%.13lf)\n",
+             res, expR8, DevResWtd);
+
+      // Weighting by the mask as a second weight gives the same sum
+      R8 DevResWtd2 = 0.0;
+      Array2DR8 DevMaskR8("DevMaskR8", NumCells, NumVertLvls);
+      parallelFor(
+          {NumCells, NumVertLvls},
+          KOKKOS_LAMBDA(int i, int j) { DevMaskR8(i, j) = DevMask(i, j); });
+      Kokkos::fence();
+      err = globalSum(DevArr2DR8, DevWeight, DevMaskR8, NoMask(), Comm,
+                      &DevResWtd2, NOwned);
+      res = "FAIL";
+      if (err == 0 && DevResWtd2 == DevResWtd)
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global two-weight sum device A2DR8: %s\n", res);
+
+      R8 DevMinWtd = 0.0, DevMaxWtd = 0.0;
+      err = globalMinVal(DevArr2DR8, DevWeight, DevMask, Comm, &DevMinWtd,
+                         NOwned);
+      err += globalMaxVal(DevArr2DR8, NoWeight(), DevMask, Comm, &DevMaxWtd,
+                          NOwned);
+      res = "FAIL";
+      if (err == 0 && DevMinWtd == 2.0 * HostArr2DR8(0, 0) &&
+          DevMaxWtd == HostArr2DR8(NOwned - 1, NumVertLvls - 2))
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global masked min/max device A2DR8: %s\n", res);
+
+      // test non-blocking reductions, which must match the blocking ones
+      // when several are in flight at once
+      ReductionRequest SumReq, ArrReq, FieldReq, MaxReq;
+      R8 NbResR8 = 0.0, NbResArr = 0.0, NbMaxR8 = 0.0;
+      std::vector<R8> NbFieldSums;
+      err = globalSumStart(&MyR8, Comm, SumReq);
+      err += globalSumStart(DevArr2DR8, Comm, ArrReq);
+      err += globalSumStart(DevFields, Comm, FieldReq);
+      err += globalMaxStart(&MyR8Tmp, Comm, MaxReq);
+      err += globalMaxFinish(MaxReq, &NbMaxR8);
+      err += globalSumFinish(FieldReq, NbFieldSums);
+      err += globalSumFinish(ArrReq, &NbResArr);
+      err += globalSumFinish(SumReq, &NbResR8);
+      res = "FAIL";
+      if (err == 0 && NbResR8 == MyR8 * MySize && NbResArr == DevRes2DR8 &&
+          NbFieldSums.size() == 2 && NbFieldSums[0] == DevRes2DR8 &&
+          NbFieldSums[1] == DevRes2DR8b && NbMaxR8 == MySize - 1 + MyR8)
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global non-blocking reductions: %s\n", res);
+
+      // test fused non-blocking dot products, which must match the
+      // blocking weighted sums of the same products
+      ReductionRequest DotReq;
+      std::vector<R8> DotSums;
+      R8 DevResSq = 0.0;
+      std::vector<std::pair<Array2DR8, Array2DR8>> DotPairs{
+          {DevArr2DR8, DevMaskR8}, {DevArr2DR8, DevArr2DR8}};
+      err = globalDotStart(DotPairs, DevWeight, NoMask(), Comm, DotReq, NOwned);
+      err += globalSumFinish(DotReq, DotSums);
+      err += globalSum(DevArr2DR8, DevWeight, DevArr2DR8, NoMask(), Comm,
+                       &DevResSq, NOwned);
+      res = "FAIL";
+      if (err == 0 && DotSums.size() == 2 && DotSums[0] == DevResWtd2 &&
+          DotSums[1] == DevResSq)
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global fused dot products: %s\n", res);
+
+      // test hierarchical (node, then global) reductions, which must give
+      // the same results as the flat reductions
+      setReductionMethod(ReductionMethod::Hierarchical);
+      R8 HierResR8 = 0.0, HierResArr = 0.0, HierMaxR8 = 0.0;
+      I4 HierResI4 = 0;
+      err = globalSum(&MyR8, Comm, &HierResR8);
+      err += globalSum(&MyInt4, Comm, &HierResI4);
+      err += globalSum(DevArr2DR8, Comm, &HierResArr);
+      err += globalMax(&MyR8Tmp, &HierMaxR8, Comm);
+      setReductionMethod(ReductionMethod::Flat);
+      res = "FAIL";
+      if (err == 0 && HierResR8 == MyR8 * MySize &&
+          HierResI4 == MySize * (MySize - 1) / 2 &&
+          HierResArr == DevRes2DR8 && HierMaxR8 == MySize - 1 + MyR8)
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global hierarchical reductions: %s (nodes=%d)\n", res,
+             DefEnv->getNumNodes());
    }
    Kokkos::finalize();
    MPI_Finalize();
@@ -0,0 +1,299 @@
+//===-- Test driver for OMEGA OceanCoupler -----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA coupler interface
+///
+/// This driver registers exports from a cell array, from the top active
+/// level of a layered array and from a subview of a tracer array, and
+/// imports into cell arrays. It tests that the buffers hold the fields of
+/// each cell contiguously in the order of the field lists of the driver,
+/// that fields missing from the model are exported as zero, that imported
+/// fields are valid in the halo, that the global indices match the
+/// decomposition and that misuse of the interface is reported as an error.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanCoupler.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <vector>
+
+using namespace OMEGA;
+
+constexpr I4 NVertLevels = 4;
+constexpr I4 NTracers    = 2;
+
+//------------------------------------------------------------------------------
+// Value of a layered test field in a cell of global ID CellID at level K
+
+R8 layerValue(I4 CellID, I4 K, I4 Field) {
+   return 100.0 * CellID + 10.0 * K + Field;
+}
+
+//------------------------------------------------------------------------------
+// Tests the exchange of fields through the coupler
+
+int testOceanCoupler() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh    = HorzMesh::getDefault();
+   Decomp *DefDecomp = Decomp::getDefault();
+   MPI_Comm Comm     = MachEnv::getDefaultEnv()->getComm();
+
+   // Fields of the model with values given by the global cell ID
+   HostArray2DReal TempH("TempH", Mesh->NCellsSize, NVertLevels);
+   HostArray3DReal TracersH("TracersH", NTracers, Mesh->NCellsSize,
+                            NVertLevels);
+   HostArray1DReal SshH("SshH", Mesh->NCellsSize);
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      const I4 CellID = DefDecomp->CellIDH(ICell);
+      SshH(ICell)     = -CellID;
+      for (int K = 0; K < NVertLevels; ++K) {
+         TempH(ICell, K) = layerValue(CellID, K, 0);
+         for (int L = 0; L < NTracers; ++L)
+            TracersH(L, ICell, K) = layerValue(CellID, K, L + 1);
+      }
+   }
+   Array2DReal Temp    = createDeviceMirrorCopy(TempH);
+   Array3DReal Tracers = createDeviceMirrorCopy(TracersH);
+   Array1DReal Ssh     = createDeviceMirrorCopy(SshH);
+   Array1DReal TauX("TauX", Mesh->NCellsSize);
+   Array1DReal TauY("TauY", Mesh->NCellsSize);
+
+   OceanCoupler Coupler(Mesh, DefDecomp, Halo::getDefault());
+   Err += Coupler.addSurfaceExport("So_t", [&]() { return Temp; });
+   Err += Coupler.addSurfaceExport("So_s", [&]() {
+      return Kokkos::subview(Tracers, 1, Kokkos::ALL, Kokkos::ALL);
+   });
+   Err += Coupler.addExport("So_ssh", Ssh);
+   Err += Coupler.addImport("Foxx_taux", TauX);
+   Err += Coupler.addImport("Foxx_tauy", TauY);
+
+   // Duplicate fields are an error
+   if (Coupler.addExport("So_ssh", Ssh) != 0 &&
+       Coupler.addImport("Foxx_taux", TauX) != 0) {
+      LOG_INFO("OceanCouplerTest: duplicate fields detected: PASS");
+   } else {
+      LOG_ERROR("OceanCouplerTest: duplicate fields not detected: FAIL");
+      Err += 1;
+   }
+
+   // Exchanging before the field lists are set is an error
+   const I4 NCells = Coupler.getNumCells();
+   std::vector<R8> Buffer(4 * NCells, -1);
+   if (Coupler.exportFields(Buffer.data()) != 0 &&
+       Coupler.importFields(Buffer.data()) != 0) {
+      LOG_INFO("OceanCouplerTest: exchange without lists detected: PASS");
+   } else {
+      LOG_ERROR("OceanCouplerTest: exchange without lists not detected: FAIL");
+      Err += 1;
+   }
+
+   Err += Coupler.setFieldLists("So_t:So_u:So_ssh:So_s",
+                                "Foxx_tauy:Faxa_rain:Foxx_taux");
+   if (Coupler.getNumExport() != 4 || Coupler.getNumImport() != 3) {
+      LOG_ERROR("OceanCouplerTest: wrong number of fields in lists: FAIL");
+      Err += 1;
+   }
+
+   // Registering fields after the lists are set is an error
+   Array1DReal Extra("Extra", Mesh->NCellsSize);
+   if (Coupler.addExport("So_u", Extra) != 0) {
+      LOG_INFO("OceanCouplerTest: late registration detected: PASS");
+   } else {
+      LOG_ERROR("OceanCouplerTest: late registration not detected: FAIL");
+      Err += 1;
+   }
+
+   // Export: the surface fields come from the top active level of each cell
+   Err += Coupler.exportFields(Buffer.data());
+   I4 NWrong = 0;
+   for (int ICell = 0; ICell < NCells; ++ICell) {
+      const I4 CellID = DefDecomp->CellIDH(ICell);
+      const I4 KTop   = Mesh->MinLevelCellH(ICell);
+      const bool Wet  = Mesh->MaxLevelCellH(ICell) >= KTop;
+      const R8 *Cell  = &Buffer[4 * ICell];
+      if (Cell[0] != (Wet ? layerValue(CellID, KTop, 0) : 0) ||
+          Cell[1] != 0 || Cell[2] != -CellID ||
+          Cell[3] != (Wet ? layerValue(CellID, KTop, 2) : 0))
+         ++NWrong;
+   }
+   MPI_Allreduce(MPI_IN_PLACE, &NWrong, 1, MPI_INT, MPI_SUM, Comm);
+   if (NWrong == 0) {
+      LOG_INFO("OceanCouplerTest: export: PASS");
+   } else {
+      LOG_ERROR("OceanCouplerTest: export wrong in {} cells: FAIL", NWrong);
+      Err += 1;
+   }
+
+   // Exports follow arrays that are replaced between exports
+   Temp = Array2DReal("TempNew", Mesh->NCellsSize, NVertLevels);
+   Kokkos::deep_copy(Temp, 1);
+   Err += Coupler.exportFields(Buffer.data());
+   NWrong = 0;
+   for (int ICell = 0; ICell < NCells; ++ICell) {
+      const bool Wet =
+          Mesh->MaxLevelCellH(ICell) >= Mesh->MinLevelCellH(ICell);
+      if (Buffer[4 * ICell] != (Wet ? 1 : 0))
+         ++NWrong;
+   }
+   MPI_Allreduce(MPI_IN_PLACE, &NWrong, 1, MPI_INT, MPI_SUM, Comm);
+   if (NWrong == 0) {
+      LOG_INFO("OceanCouplerTest: export of replaced array: PASS");
+   } else {
+      LOG_ERROR("OceanCouplerTest: replaced array wrong in {} cells: FAIL",
+                NWrong);
+      Err += 1;
+   }
+
+   // Import: the imported fields are also valid in the halo
+   std::vector<R8> ImportBuffer(3 * NCells);
+   for (int ICell = 0; ICell < NCells; ++ICell) {
+      const I4 CellID             = DefDecomp->CellIDH(ICell);
+      ImportBuffer[3 * ICell]     = 2 * CellID;
+      ImportBuffer[3 * ICell + 1] = -1;
+      ImportBuffer[3 * ICell + 2] = 3 * CellID;
+   }
+   Err += Coupler.importFields(ImportBuffer.data());
+   auto TauXH = createHostMirrorCopy(TauX);
+   auto TauYH = createHostMirrorCopy(TauY);
+   NWrong     = 0;
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      const I4 CellID = DefDecomp->CellIDH(ICell);
+      if (TauXH(ICell) != 3 * CellID || TauYH(ICell) != 2 * CellID)
+         ++NWrong;
+   }
+   MPI_Allreduce(MPI_IN_PLACE, &NWrong, 1, MPI_INT, MPI_SUM, Comm);
+   if (NWrong == 0) {
+      LOG_INFO("OceanCouplerTest: import: PASS");
+   } else {
+      LOG_ERROR("OceanCouplerTest: import wrong in {} cells: FAIL", NWrong);
+      Err += 1;
+   }
+
+   // The global indices cover every cell of the mesh once
+   std::vector<I4> Indices = Coupler.getGlobalIndices();
+   std::vector<I4> Count(DefDecomp->NCellsGlobal, 0);
+   for (I4 Index : Indices)
+      if (Index >= 1 && Index <= DefDecomp->NCellsGlobal)
+         Count[Index - 1] += 1;
+   MPI_Allreduce(MPI_IN_PLACE, Count.data(), Count.size(), MPI_INT, MPI_SUM,
+                 Comm);
+   NWrong = 0;
+   for (I4 C : Count)
+      if (C != 1)
+         ++NWrong;
+   if (static_cast<I4>(Indices.size()) == NCells && NWrong == 0) {
+      LOG_INFO("OceanCouplerTest: global indices: PASS");
+   } else {
+      LOG_ERROR("OceanCouplerTest: {} cells not indexed once: FAIL", NWrong);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testOceanCoupler
+
+//------------------------------------------------------------------------------
+// The initialization routine for coupler testing. The top level of cells of
+// even global ID is moved down when the column is deep enough, so that the
+// surface of the exports is not always the first level.
+
+int initOceanCouplerTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("OceanCouplerTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("OceanCouplerTest: error initializing default decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("OceanCouplerTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("OceanCouplerTest: error initializing default mesh");
+   }
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+   MeshErr        = Mesh->initVertLevels(NVertLevels, {10, 20, 30, 40});
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("OceanCouplerTest: error initializing vertical levels");
+   }
+   Decomp *DefDecomp = Decomp::getDefault();
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell)
+      if (DefDecomp->CellIDH(ICell) % 2 == 0 && Mesh->MaxLevelCellH(ICell) > 0)
+         Mesh->MinLevelCellH(ICell) = 1;
+   Mesh->updateLevelBounds();
+
+   int CouplerErr = OceanCoupler::init();
+   if (CouplerErr != 0 || OceanCoupler::getDefault() == nullptr) {
+      Err++;
+      LOG_ERROR("OceanCouplerTest: error initializing default coupler");
+   }
+
+   return Err;
+
+} // end initOceanCouplerTest
+
+//------------------------------------------------------------------------------
+// The test driver for the coupler interface
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initOceanCouplerTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("OceanCouplerTest: Error initializing");
+
+      RetVal += testOceanCoupler();
+
+      if (RetVal == 0)
+         LOG_INFO("OceanCouplerTest: Successful completion");
+
+      OceanCoupler::clear();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -887,7 +887,26 @@ int main(int argc, char *argv[]) {
       LOG_INFO("ConfigTest {}: write successful FAIL", MyTask);
    }
 
-   // Read the environment back in
+   // Reading a missing file should return an error on all tasks
+   Err = OMEGA::Config::readAll("omegaConfigMissing.yml");
+   if (Err != 0) {
+      LOG_INFO("ConfigTest {}: read missing file error PASS", MyTask);
+   } else {
+      RetVal += 1;
+      LOG_INFO("ConfigTest {}: read missing file error FAIL", MyTask);
+   }
+
+   // Read the file with all tasks reading in groups
+   Err = OMEGA::Config::readAll("omegaConfigTst.yml",
+                                OMEGA::Config::ReadGrouped);
+   if (Err == 0) {
+      LOG_INFO("ConfigTest {}: grouped read successful PASS", MyTask);
+   } else {
+      RetVal += 1;
+      LOG_INFO("ConfigTest {}: grouped read successful FAIL", MyTask);
+   }
+
+   // Read the environment back in with the default broadcast read
    Err = OMEGA::Config::readAll("omegaConfigTst.yml");
    if (Err == 0) {
       LOG_INFO("ConfigTest {}: read successful PASS", MyTask);
@@ -930,6 +949,36 @@ int main(int argc, char *argv[]) {
       LOG_INFO("ConfigTest {}: retrieve bool from full config FAIL", MyTask);
    }
 
+   // Bind typed parameters once from the full configuration
+   OMEGA::ConfigParam<OMEGA::I4> ParamHmixI4("Hmix/HmixI4", -1);
+   OMEGA::ConfigParam<OMEGA::R8> ParamDel2R8("Hmix/HmixDel2/HmixDel2R8", -1.0);
+   OMEGA::ConfigParam<OMEGA::R8> ParamMissing("Hmix/NoSuchVar", 5.0);
+   OMEGA::ConfigParam<OMEGA::R8> ParamNoGroup("NoSuchGroup/HmixR8", 6.0);
+   Err1 = ParamHmixI4.bind();
+   Err2 = ParamDel2R8.bind(true);
+   Err3 = ParamMissing.bind() + ParamNoGroup.bind();
+   OMEGA::R8 Del2R8 = ParamDel2R8;
+   RefTest = (Err1 == 0 && Err2 == 0 && Err3 == 0 &&
+              ParamHmixI4.get() == NewHmixI4 && Del2R8 == NewHmixDel2R8 &&
+              ParamHmixI4.isFromConfig() && !ParamMissing.isFromConfig() &&
+              ParamMissing.isBound() && ParamMissing.get() == 5.0 &&
+              ParamNoGroup.get() == 6.0);
+   if (RefTest) {
+      LOG_INFO("ConfigTest {}: bind typed parameters PASS", MyTask);
+   } else {
+      RetVal += 1;
+      LOG_INFO("ConfigTest {}: bind typed parameters FAIL", MyTask);
+   }
+
+   OMEGA::ConfigParam<OMEGA::R8> ParamRequired("Hmix/NoSuchVar", 5.0);
+   Err1 = ParamRequired.bind(true);
+   if (Err1 != 0 && !ParamRequired.isBound()) {
+      LOG_INFO("ConfigTest {}: bind missing required parameter PASS", MyTask);
+   } else {
+      RetVal += 1;
+      LOG_INFO("ConfigTest {}: bind missing required parameter FAIL", MyTask);
+   }
+
    Err1    = ConfigHmixOmega.get("HmixI4", HmixI4);
    Err2    = ConfigVmixOmega.get("VmixI4", VmixI4);
    Err3    = ConfigHmixDel2Omega.get("HmixDel2I4", HmixDel2I4);
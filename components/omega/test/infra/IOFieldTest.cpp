@@ -249,6 +249,23 @@ int main(int argc, char **argv) {
       }
       Err += std::abs(Err1) + std::abs(Err2) + std::abs(Err3) + std::abs(Err4);
 
+      // Test compression settings set through metadata entries
+      MetaR8D->addEntry("CompressionLevel", OMEGA::I4(4));
+      MetaR8D->addEntry("CompressionShuffle", true);
+      MetaR8D->addEntry("QuantizeBits", OMEGA::I4(12));
+      OMEGA::IO::Compression CompressR8D =
+          OMEGA::IOField::getCompression("FieldR8D");
+      OMEGA::IO::Compression CompressI4D =
+          OMEGA::IOField::getCompression("FieldI4D");
+      if (CompressR8D.DeflateLevel == 4 && CompressR8D.Shuffle &&
+          CompressR8D.QuantizeBits == 12 && CompressI4D.DeflateLevel == 0 &&
+          !CompressI4D.Shuffle && CompressI4D.QuantizeBits == 0) {
+         LOG_INFO("IOField: Retrieve compression settings: PASS");
+      } else {
+         Err += 1;
+         LOG_ERROR("IOField: Retrieve compression settings: FAIL");
+      }
+
       // Now retrieve full data
       OMEGA::HostArray2DI4 NewI4H =
           OMEGA::IOField::getData<OMEGA::HostArray2DI4>("FieldI4H");
@@ -308,10 +325,58 @@ int main(int argc, char **argv) {
 
       Err += std::abs(Err1) + std::abs(Err2) + std::abs(Err3);
 
-      // Erase a field and check for non-existence
+      // Retrieve data and metadata by handle
+      OMEGA::I4 HandleR8H = OMEGA::IOField::getHandle("FieldR8H");
+      OMEGA::I4 HandleR8D = OMEGA::IOField::getHandle("FieldR8D");
+      OMEGA::HostArray2DR8 HandleDataR8H =
+          OMEGA::IOField::getData<OMEGA::HostArray2DR8>(HandleR8H);
+      if (HandleR8H >= 0 && HandleR8D >= 0 && HandleR8H != HandleR8D &&
+          OMEGA::IOField::getHandle("FieldJunk") == -1 &&
+          HandleDataR8H.data() == NewR8H.data() &&
+          OMEGA::IOField::getMetaData(HandleR8H) == MetaR8H &&
+          OMEGA::IOField::getCompression(HandleR8D).DeflateLevel == 4) {
+         LOG_INFO("IOFieldTest: retrieval by handle PASS");
+      } else {
+         LOG_ERROR("IOFieldTest: retrieval by handle FAIL");
+         ++Err;
+      }
+
+      // Data retrieved with the wrong type is empty and metadata retrieved
+      // with the wrong type returns an error
+      OMEGA::HostArray2DI4 WrongType =
+          OMEGA::IOField::getData<OMEGA::HostArray2DI4>(HandleR8H);
+      OMEGA::I4 WrongEntry;
+      if (WrongType.data() == nullptr &&
+          MetaR8H->getEntry("Units", WrongEntry) != 0) {
+         LOG_INFO("IOFieldTest: wrong type retrieval PASS");
+      } else {
+         LOG_ERROR("IOFieldTest: wrong type retrieval FAIL");
+         ++Err;
+      }
+
+      // Attaching a new array of the same type replaces the data under the
+      // same handle
+      OMEGA::HostArray2DR8 NewDataR8H("NewDataR8H", NCellsSize, NVertLevels);
+      Err1 = OMEGA::IOField::attachData<OMEGA::HostArray2DR8>(HandleR8H,
+                                                              NewDataR8H);
+      if (Err1 == 0 &&
+          OMEGA::IOField::getData<OMEGA::HostArray2DR8>("FieldR8H").data() ==
+              NewDataR8H.data()) {
+         LOG_INFO("IOFieldTest: attach data by handle PASS");
+      } else {
+         LOG_ERROR("IOFieldTest: attach data by handle FAIL");
+         ++Err;
+      }
+
+      // Erase a field and check for non-existence. The handles of other
+      // fields remain valid.
+      OMEGA::I4 HandleI4D = OMEGA::IOField::getHandle("FieldI4D");
       OMEGA::IOField::erase("FieldI4D");
       FieldExistsI4D = OMEGA::IOField::isDefined("FieldI4D");
-      if (!FieldExistsI4D) {
+      if (!FieldExistsI4D &&
+          OMEGA::IOField::getMetaData(HandleI4D) == nullptr &&
+          OMEGA::IOField::getData<OMEGA::Array2DR8>(HandleR8D).data() ==
+              NewR8D.data()) {
          LOG_INFO("IOFieldTest: erase field PASS");
       } else {
          LOG_ERROR("IOFieldTest: erase field FAIL");
@@ -0,0 +1,240 @@
+//===-- Test driver for OMEGA IO Streams -------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA IO Streams
+///
+/// This driver tests the OMEGA IOStreams. It creates an output stream with
+/// time-averaged and maximum fields on the device, steps a clock forward to
+/// trigger the stream alarm and write the file, then reads the file with an
+/// input stream to verify the accumulated contents.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "IOStream.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "IO.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "MetaData.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "mpi.h"
+
+#include <cmath>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// The initialization routine for IOStream testing. It calls various
+// init routines, including the creation of the default decomposition.
+
+int initIOStreamTest() {
+
+   int Err = 0;
+
+   // Initialize the Machine Environment class - this also creates
+   // the default MachEnv. Then retrieve the default environment and
+   // some needed data members.
+   OMEGA::MachEnv::init(MPI_COMM_WORLD);
+   OMEGA::MachEnv *DefEnv = OMEGA::MachEnv::getDefaultEnv();
+   MPI_Comm DefComm       = DefEnv->getComm();
+
+   // Initialize the IO system
+   Err = OMEGA::IO::init(DefComm);
+   if (Err != 0)
+      LOG_ERROR("IOStreamTest: error initializing parallel IO");
+
+   // Create the default decomposition (initializes the decomposition)
+   Err = OMEGA::Decomp::init();
+   if (Err != 0)
+      LOG_ERROR("IOStreamTest: error initializing default decomposition");
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for IOStreams.
+//
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   // Initialize the global MPI environment
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      int Err = initIOStreamTest();
+      if (Err != 0)
+         LOG_CRITICAL("IOStreamTest: Error initializing");
+
+      OMEGA::Decomp *DefDecomp = OMEGA::Decomp::getDefault();
+      OMEGA::I4 NCellsSize     = DefDecomp->NCellsSize;
+      OMEGA::I4 NCellsOwned    = DefDecomp->NCellsOwned;
+      OMEGA::I4 NCellsGlobal   = DefDecomp->NCellsGlobal;
+      OMEGA::I4 NVertLevels    = 16;
+
+      // Create the IO decomposition for cell arrays
+      OMEGA::HostArray1DI4 CellIDH = DefDecomp->CellIDH;
+      std::vector<int> OffsetCell(NCellsSize * NVertLevels, -1);
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            OffsetCell[Cell * NVertLevels + K] =
+                (CellIDH(Cell) - 1) * NVertLevels + K;
+         }
+      }
+      int DecompCellR8;
+      std::vector<int> CellDims{NCellsGlobal, NVertLevels};
+      Err = OMEGA::IO::createDecomp(DecompCellR8, OMEGA::IO::IOTypeR8, 2,
+                                    CellDims, NCellsSize * NVertLevels,
+                                    OffsetCell, OMEGA::IO::DefaultRearr);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("IOStreamTest: error creating cell decomp FAIL");
+      }
+
+      // Define the fields. The mean and max fields share the same array.
+      auto CellDim = OMEGA::MetaDim::create("NCells", NCellsGlobal);
+      auto VertDim = OMEGA::MetaDim::create("NVertLevels", NVertLevels);
+      std::vector<std::shared_ptr<OMEGA::MetaDim>> Dimensions{CellDim,
+                                                              VertDim};
+      std::vector<std::string> DimNames{"NCells", "NVertLevels"};
+      std::vector<std::string> FieldNames{"StreamMeanR8", "StreamMaxR8"};
+      for (auto &FieldName : FieldNames) {
+         OMEGA::ArrayMetaData::create(FieldName, "Test stream field", "m",
+                                      "StreamStdName", -1.0e10, 1.0e10,
+                                      -9.99E+30, 2, Dimensions);
+         Err = OMEGA::IOField::define(FieldName);
+         if (Err != 0) {
+            RetVal += 1;
+            LOG_ERROR("IOStreamTest: error defining field {} FAIL", FieldName);
+         }
+      }
+      OMEGA::Array2DR8 FieldR8("FieldR8", NCellsSize, NVertLevels);
+      Err = OMEGA::IOField::attachData<OMEGA::Array2DR8>("StreamMeanR8",
+                                                         FieldR8);
+      Err += OMEGA::IOField::attachData<OMEGA::Array2DR8>("StreamMaxR8",
+                                                          FieldR8);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("IOStreamTest: error attaching field data FAIL");
+      }
+
+      // Create a clock with an hourly time step and an output stream
+      // written every four hours
+      OMEGA::Calendar CalNoLeap("No Leap", OMEGA::CalendarNoLeap);
+      OMEGA::TimeInstant StartTime(&CalNoLeap, 1, 1, 1, 0, 0, 0.0);
+      OMEGA::TimeInterval TimeStep(1, OMEGA::TimeUnits::Hours);
+      OMEGA::TimeInterval StreamFreq(4, OMEGA::TimeUnits::Hours);
+      OMEGA::Clock ModelClock(StartTime, TimeStep);
+
+      Err = OMEGA::IOStream::create(
+          "History", "IOStreamTest.$Y-$M-$D_$h.nc", OMEGA::IO::ModeWrite,
+          OMEGA::IO::Precision::Double, OMEGA::IO::IfExists::Replace,
+          StreamFreq, &ModelClock);
+      if (Err == 0 and OMEGA::IOStream::isDefined("History")) {
+         LOG_INFO("IOStreamTest: create stream PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("IOStreamTest: create stream FAIL");
+      }
+
+      Err = OMEGA::IOStream::addField<OMEGA::Array2DR8>(
+          "History", "StreamMeanR8", DecompCellR8, DimNames,
+          OMEGA::StreamOp::Mean);
+      Err += OMEGA::IOStream::addField<OMEGA::Array2DR8>(
+          "History", "StreamMaxR8", DecompCellR8, DimNames,
+          OMEGA::StreamOp::Max);
+      if (Err == 0) {
+         LOG_INFO("IOStreamTest: add fields PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("IOStreamTest: add fields FAIL");
+      }
+
+      // Step forward, setting the field on the device to the step number
+      // times a reference value. The stream is written after step 4.
+      int NSteps = 4;
+      for (int Step = 1; Step <= NSteps; ++Step) {
+         OMEGA::R8 StepVal = Step;
+         OMEGA::parallelFor(
+             {NCellsSize, NVertLevels}, KOKKOS_LAMBDA(int Cell, int K) {
+                FieldR8(Cell, K) = StepVal * (Cell + K);
+             });
+         ModelClock.advance();
+         Err = OMEGA::IOStream::writeAll();
+         if (Err != 0) {
+            RetVal += 1;
+            LOG_ERROR("IOStreamTest: error writing streams at step {} FAIL",
+                      Step);
+         }
+      }
+
+      // Read the file back into new arrays with an input stream
+      OMEGA::Array2DR8 MeanIn("MeanIn", NCellsSize, NVertLevels);
+      OMEGA::Array2DR8 MaxIn("MaxIn", NCellsSize, NVertLevels);
+      OMEGA::IOField::attachData<OMEGA::Array2DR8>("StreamMeanR8", MeanIn);
+      OMEGA::IOField::attachData<OMEGA::Array2DR8>("StreamMaxR8", MaxIn);
+
+      Err = OMEGA::IOStream::create(
+          "HistoryIn", "IOStreamTest.$Y-$M-$D_$h.nc", OMEGA::IO::ModeRead,
+          OMEGA::IO::Precision::Double, OMEGA::IO::IfExists::Fail, StreamFreq,
+          &ModelClock);
+      Err += OMEGA::IOStream::addField<OMEGA::Array2DR8>(
+          "HistoryIn", "StreamMeanR8", DecompCellR8, DimNames);
+      Err += OMEGA::IOStream::addField<OMEGA::Array2DR8>(
+          "HistoryIn", "StreamMaxR8", DecompCellR8, DimNames);
+      Err += OMEGA::IOStream::read("HistoryIn");
+      if (Err == 0) {
+         LOG_INFO("IOStreamTest: read stream PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("IOStreamTest: read stream FAIL");
+      }
+
+      // Check the mean and max of the four samples
+      auto MeanInH = OMEGA::createHostMirrorCopy(MeanIn);
+      auto MaxInH  = OMEGA::createHostMirrorCopy(MaxIn);
+      int Count    = 0;
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            OMEGA::R8 MeanRef = 2.5 * (Cell + K);
+            OMEGA::R8 MaxRef  = 4.0 * (Cell + K);
+            if (std::abs(MeanInH(Cell, K) - MeanRef) > 1.0e-12 * MaxRef)
+               ++Count;
+            if (MaxInH(Cell, K) != MaxRef)
+               ++Count;
+         }
+      }
+      if (Count == 0) {
+         LOG_INFO("IOStreamTest: time-averaged stream contents PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("IOStreamTest: time-averaged stream contents FAIL");
+      }
+
+      // Clean up
+      OMEGA::IOStream::clear();
+      OMEGA::IOField::clear();
+      Err = OMEGA::IO::destroyDecomp(DecompCellR8);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("IOStreamTest: error destroying decomp FAIL");
+      }
+      Err = OMEGA::IO::finalize();
+      OMEGA::Decomp::clear();
+      OMEGA::MachEnv::removeAll();
+      if (RetVal == 0)
+         LOG_INFO("IOStreamTest: Successful completion");
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
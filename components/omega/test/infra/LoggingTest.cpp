@@ -10,7 +10,10 @@
 //
 //===-----------------------------------------------------------------------===/
 
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <unistd.h>
 
 // #include "DataTypes.h"
 #include "Logging.h"
@@ -122,6 +125,79 @@ int testKokkosDataTypes() {
    return RetVal;
 }
 
+int testTaskFilter() {
+
+   int RetVal = 0;
+
+   LogOptions Options;
+   bool Pass = isLoggingTask(Options, 5);
+
+   Options.Tasks = LogOptions::MasterTask;
+   Pass = Pass && isLoggingTask(Options, 0) && !isLoggingTask(Options, 5) &&
+          isLoggingTask(Options, 2, 2);
+
+   Options.Tasks      = LogOptions::EveryNthTask;
+   Options.TaskStride = 4;
+   Pass = Pass && isLoggingTask(Options, 8) && !isLoggingTask(Options, 6);
+
+   Options.Tasks    = LogOptions::ListedTasks;
+   Options.TaskList = {1, 7};
+   Pass = Pass && isLoggingTask(Options, 7) && !isLoggingTask(Options, 0);
+
+   if (Pass) {
+      std::cout << "Log task filter: PASS" << std::endl;
+   } else {
+      std::cout << "Log task filter: FAIL" << std::endl;
+      RetVal += 1;
+   }
+
+   return RetVal;
+}
+
+int testAsyncLogging() {
+
+   int RetVal = 0;
+
+   // The process id keeps the file names distinct across test processes
+   const std::string LogFilePath =
+       "tmpasync" + std::to_string(getpid()) + ".log";
+   const int MyTask            = 3;
+   const std::string TaskFile  = LogFilePath + "." + std::to_string(MyTask);
+   const std::string AsyncMsg  = "This is an async message.";
+   const std::string FilterMsg = "This should be filtered.";
+
+   LogOptions Options;
+   Options.Tasks        = LogOptions::EveryNthTask;
+   Options.TaskStride   = 3;
+   Options.PerTaskFiles = true;
+   Options.Async        = true;
+
+   initLogging(LogFilePath, Options, MyTask);
+   LOG_INFO(AsyncMsg);
+   finalizeLogging();
+
+   // A filtered task writes no file
+   initLogging(LogFilePath, Options, MyTask + 1);
+   LOG_INFO(FilterMsg);
+   finalizeLogging();
+
+   std::ifstream LogFile(TaskFile);
+   std::stringstream Contents;
+   Contents << LogFile.rdbuf();
+   std::ifstream FilteredFile(LogFilePath + "." + std::to_string(MyTask + 1));
+
+   if (hasSubstring(Contents.str(), AsyncMsg) && !FilteredFile.good()) {
+      std::cout << "Async per-task logging: PASS" << std::endl;
+   } else {
+      std::cout << "Async per-task logging: FAIL" << std::endl;
+      RetVal += 1;
+   }
+
+   std::remove(TaskFile.c_str());
+
+   return RetVal;
+}
+
 int main(int argc, char **argv) {
 
    int RetVal                    = 0;
@@ -143,6 +219,10 @@ int main(int argc, char **argv) {
 
       RetVal += testDefaultLogLevel();
       RetVal += testKokkosDataTypes();
+      RetVal += testTaskFilter();
+
+      // replaces the default logger so must be last
+      RetVal += testAsyncLogging();
 
       // std::remove(LogFilePath.c_str());
 
@@ -0,0 +1,121 @@
+//===-- Test driver for OMEGA MemoryTracker ----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA memory usage tracking
+///
+/// This driver tests the tracking of the current and peak memory usage of
+/// Kokkos allocations, the charging of allocations to nested subsystem
+/// scopes and the printing of the usage statistics across tasks.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "MemoryTracker.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "mpi.h"
+
+#include <string>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// The test driver for the memory tracker
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+   int Err    = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+
+      Err = MemoryTracker::init();
+      if (Err != 0) {
+         LOG_ERROR("MemoryTrackerTest: init: FAIL");
+         RetVal += 1;
+      }
+
+      // The test is skipped if tracking is disabled by a Kokkos Tools library
+      if (MemoryTracker::isEnabled()) {
+
+         const std::string DevSpace  = Array1DR8::memory_space::name();
+         const std::string HostSpace = HostArray1DR8::memory_space::name();
+         const I8 NBytes             = 1000 * sizeof(R8);
+         const I8 NInner             = DevSpace == HostSpace ? 3 : 2;
+
+         // Allocations in nested scopes are charged to the innermost
+         {
+            MemoryScope Outer("TestOuter");
+            Array1DR8 A("TestA", 1000);
+            {
+               MemoryScope Inner("TestInner");
+               Array1DR8 B("TestB", 2000);
+               HostArray1DR8 C("TestC", 1000);
+
+               if (MemoryTracker::getCurrent("TestOuter", DevSpace) ==
+                       NBytes &&
+                   MemoryTracker::getCurrent("TestInner", DevSpace) ==
+                       NInner * NBytes &&
+                   MemoryTracker::getCurrent("TestInner", HostSpace) ==
+                       (DevSpace == HostSpace ? NInner : 1) * NBytes &&
+                   MemoryTracker::getCurrent("Total", DevSpace) >=
+                       3 * NBytes) {
+                  LOG_INFO("MemoryTrackerTest: scopes: PASS");
+               } else {
+                  LOG_ERROR("MemoryTrackerTest: scopes: FAIL");
+                  RetVal += 1;
+               }
+            }
+
+            // Freed allocations reduce the current usage but not the peak
+            if (MemoryTracker::getCurrent("TestInner", DevSpace) == 0 &&
+                MemoryTracker::getPeak("TestInner", DevSpace) ==
+                    NInner * NBytes &&
+                MemoryTracker::getCurrent("TestOuter", DevSpace) == NBytes) {
+               LOG_INFO("MemoryTrackerTest: deallocation: PASS");
+            } else {
+               LOG_ERROR("MemoryTrackerTest: deallocation: FAIL");
+               RetVal += 1;
+            }
+         }
+
+         // Allocations outside any scope are charged to Other
+         Array1DR8 D("TestD", 1000);
+         if (MemoryTracker::getCurrent("Other", DevSpace) >= NBytes) {
+            LOG_INFO("MemoryTrackerTest: default scope: PASS");
+         } else {
+            LOG_ERROR("MemoryTrackerTest: default scope: FAIL");
+            RetVal += 1;
+         }
+      }
+
+      Err = MemoryTracker::print("test");
+      if (Err != 0) {
+         LOG_ERROR("MemoryTrackerTest: print: FAIL");
+         RetVal += 1;
+      }
+
+      MemoryTracker::finalize();
+      if (!MemoryTracker::isEnabled() &&
+          MemoryTracker::getPeak("TestInner", "Host") == 0) {
+         LOG_INFO("MemoryTrackerTest: finalize: PASS");
+      } else {
+         LOG_ERROR("MemoryTrackerTest: finalize: FAIL");
+         RetVal += 1;
+      }
+
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
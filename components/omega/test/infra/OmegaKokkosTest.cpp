@@ -122,6 +122,218 @@ int main(int argc, char **argv) {
                       << Gbytes * nrepeat / time << " GB/s )" << std::endl;
          }
 
+         // Test the hierarchical parallelFor with one team per row of a
+         // matrix and the columns distributed over the threads and vector
+         // lanes of the team
+         const int NRows = 64;
+         const int NCols = 100;
+         Array2DI4 B("B", NRows, NCols);
+         parallelForTeam(
+             {NRows, NCols},
+             KOKKOS_LAMBDA(int J, int I) { B(J, I) = J * NCols + I; });
+
+         // Test a team kernel that stages each row in team scratch memory
+         // and writes it back reversed, which requires the staged values
+         // of other threads
+         Array2DI4 C("C", NRows, NCols);
+         const int ScratchBytes = ScratchArray1D<I4>::shmem_size(NCols);
+         parallelForTeam(
+             NRows,
+             KOKKOS_LAMBDA(const TeamMember &Member) {
+                const int J = Member.league_rank();
+                ScratchArray1D<I4> Row(Member.team_scratch(0), NCols);
+                teamVectorFor(Member, NCols, [&](int I) { Row(I) = B(J, I); });
+                Member.team_barrier();
+                teamVectorFor(Member, NCols,
+                              [&](int I) { C(J, I) = Row(NCols - 1 - I); });
+             },
+             ScratchBytes);
+
+         auto BH     = createHostMirrorCopy(B);
+         auto CH     = createHostMirrorCopy(C);
+         int TeamErr = 0;
+         for (int J = 0; J < NRows; ++J) {
+            for (int I = 0; I < NCols; ++I) {
+               if (BH(J, I) != J * NCols + I ||
+                   CH(J, I) != J * NCols + NCols - 1 - I)
+                  ++TeamErr;
+            }
+         }
+         if (TeamErr == 0) {
+            std::cout << "OmegaKokkos team parallelFor: PASS" << std::endl;
+         } else {
+            std::cout << "OmegaKokkos team parallelFor: FAIL" << std::endl;
+            RetVal += 1;
+         }
+
+         // Test a labelled kernel with a tile from the tile table and a
+         // labelled kernel that is autotuned over its first launches
+         KernelTiles::setTile("TileTableKernel", {2, 16});
+         Array2DI4 D("D", NRows, NCols);
+         parallelFor(
+             "TileTableKernel", {NRows, NCols},
+             KOKKOS_LAMBDA(int J, int I) { D(J, I) = 2 * (J * NCols + I); });
+
+         KernelTiles::setAutotune(true);
+         Array2DI4 E("E", NRows, NCols);
+         const int NLaunches = 40;
+         for (int Launch = 0; Launch < NLaunches; ++Launch) {
+            parallelFor(
+                "AutotuneKernel", {NRows, NCols},
+                KOKKOS_LAMBDA(int J, int I) { E(J, I) += J * NCols + I; });
+         }
+
+         int TunedTile[2];
+         int TileErr = 0;
+         if (!KernelTiles::getTile("AutotuneKernel", 2, TunedTile))
+            ++TileErr;
+         auto DH = createHostMirrorCopy(D);
+         auto EH = createHostMirrorCopy(E);
+         for (int J = 0; J < NRows; ++J) {
+            for (int I = 0; I < NCols; ++I) {
+               if (DH(J, I) != 2 * (J * NCols + I) ||
+                   EH(J, I) != NLaunches * (J * NCols + I))
+                  ++TileErr;
+            }
+         }
+         KernelTiles::clear();
+         if (TileErr == 0) {
+            std::cout << "OmegaKokkos kernel tiles: PASS" << std::endl;
+         } else {
+            std::cout << "OmegaKokkos kernel tiles: FAIL" << std::endl;
+            RetVal += 1;
+         }
+
+         // Test independent kernels and copies on separate execution space
+         // instances
+         const ExecSpace &ComputeSpace =
+             ExecInstances::get(ExecInstances::Compute);
+         const ExecSpace &CommSpace = ExecInstances::get(ExecInstances::Comm);
+         Array2DI4 F("F", NRows, NCols);
+         Array2DI4 G("G", NRows, NCols);
+         parallelFor(
+             ComputeSpace, "ComputeKernel", {NRows, NCols},
+             KOKKOS_LAMBDA(int J, int I) { F(J, I) = J * NCols + I; });
+         parallelForTeam(
+             CommSpace, "CommKernel", {NRows, NCols},
+             KOKKOS_LAMBDA(int J, int I) { G(J, I) = 3 * (J * NCols + I); });
+         I4 FSum = 0;
+         parallelReduce(
+             ComputeSpace, {NRows, NCols},
+             KOKKOS_LAMBDA(int J, int I, I4 &Accum) { Accum += F(J, I); },
+             FSum);
+         auto GH = createHostMirrorCopy(CommSpace, G);
+         ExecInstances::fenceAll();
+
+         int SpaceErr = 0;
+         if (FSum != NRows * NCols * (NRows * NCols - 1) / 2)
+            ++SpaceErr;
+         for (int J = 0; J < NRows; ++J) {
+            for (int I = 0; I < NCols; ++I) {
+               if (GH(J, I) != 3 * (J * NCols + I))
+                  ++SpaceErr;
+            }
+         }
+         if (SpaceErr == 0) {
+            std::cout << "OmegaKokkos execution space instances: PASS"
+                      << std::endl;
+         } else {
+            std::cout << "OmegaKokkos execution space instances: FAIL"
+                      << std::endl;
+            RetVal += 1;
+         }
+
+         // Test the scratch arena. Each step reuses the memory of the
+         // previous step, and the stage array that does not fit in the
+         // buffer in the first step grows the buffer once the arena is empty.
+         int ScratchErr = ScratchArena::reserve(NRows * NCols * sizeof(R8));
+         const void *StepPtr = nullptr;
+         for (int Step = 0; Step < 3; ++Step) {
+            ScratchScope StepScope;
+            auto Tmp = ScratchArena::get<Array2DR8>(NRows, NCols);
+            if (Step == 1)
+               StepPtr = Tmp.data();
+            else if (Step > 1 && Tmp.data() != StepPtr)
+               ++ScratchErr;
+            parallelFor(
+                {NRows, NCols},
+                KOKKOS_LAMBDA(int J, int I) { Tmp(J, I) = Step + J * NCols; });
+            {
+               ScratchScope StageScope;
+               auto Stage = ScratchArena::get<Array1DI4>(NCols);
+               parallelFor({NCols}, KOKKOS_LAMBDA(int I) { Stage(I) = I; });
+               I4 StageSum = 0;
+               parallelReduce(
+                   {NCols},
+                   KOKKOS_LAMBDA(int I, I4 &Accum) { Accum += Stage(I); },
+                   StageSum);
+               if (StageSum != NCols * (NCols - 1) / 2)
+                  ++ScratchErr;
+            }
+            auto TmpH = createHostMirrorCopy(Tmp);
+            for (int J = 0; J < NRows; ++J) {
+               for (int I = 0; I < NCols; ++I) {
+                  if (TmpH(J, I) != Step + J * NCols)
+                     ++ScratchErr;
+               }
+            }
+         }
+         if (ScratchArena::getUsed() != 0 ||
+             ScratchArena::getNumOverflows() != 1 ||
+             ScratchArena::getCapacity() < ScratchArena::getHighWater())
+            ++ScratchErr;
+         ScratchArena::clear();
+         if (ScratchErr == 0) {
+            std::cout << "OmegaKokkos scratch arena: PASS" << std::endl;
+         } else {
+            std::cout << "OmegaKokkos scratch arena: FAIL" << std::endl;
+            RetVal += 1;
+         }
+
+         // Test kernel graphs. The sequence is captured at its first run
+         // and replayed after, and a reduction aborts the capture of a
+         // sequence without running its kernels, which are then run
+         // directly.
+         Array1DI4 Count("Count", NCols);
+         auto AddOne   = KOKKOS_LAMBDA(int I) { Count(I) += 1; };
+         auto AddTwo   = KOKKOS_LAMBDA(int I) { Count(I) += 2; };
+         auto SumCount = KOKKOS_LAMBDA(int I, I4 &Accum) {
+            Accum += Count(I);
+         };
+         int GraphErr = 0;
+         int NCalls   = 0;
+         for (int Step = 0; Step < 3; ++Step) {
+            GraphErr += KernelGraph::run("TestGraph", [&] {
+               ++NCalls;
+               parallelFor("GraphAddOne", {NCols}, AddOne);
+               parallelFor("GraphAddTwo", {NCols}, AddTwo);
+            });
+         }
+         I4 CountSum = 0;
+         parallelReduce({NCols}, SumCount, CountSum);
+         if (NCalls != 1 || !KernelGraph::isCaptured("TestGraph") ||
+             CountSum != 9 * NCols)
+            ++GraphErr;
+         for (int Step = 0; Step < 2; ++Step) {
+            const int AbortErr = KernelGraph::run("TestAbort", [&] {
+               parallelFor("GraphAddOne", {NCols}, AddOne);
+               I4 Sum = 0;
+               parallelReduce({NCols}, SumCount, Sum);
+            });
+            if ((Step == 0) != (AbortErr != 0))
+               ++GraphErr;
+         }
+         parallelReduce({NCols}, SumCount, CountSum);
+         if (KernelGraph::isCaptured("TestAbort") || CountSum != 10 * NCols)
+            ++GraphErr;
+         KernelGraph::clear();
+         if (GraphErr == 0) {
+            std::cout << "OmegaKokkos kernel graphs: PASS" << std::endl;
+         } else {
+            std::cout << "OmegaKokkos kernel graphs: FAIL" << std::endl;
+            RetVal += 1;
+         }
+
          std::cout << "OmegaKokkos test: PASS" << std::endl;
       }
       Kokkos::finalize();
@@ -0,0 +1,305 @@
+//===-- Test driver for OMEGA Restart ----------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA Restart
+///
+/// This driver tests OMEGA restart checkpoints. It creates a NetCDF restart
+/// and a node binary restart with a drain directory, steps a clock forward
+/// to trigger the restart alarms and write the files, then clears the
+/// arrays and reads them back. The node binary restart is read both from the
+/// node files and from their drained copies, and a read with a changed
+/// array size must fail.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Restart.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "IO.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "MetaData.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "mpi.h"
+
+#include <filesystem>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// The initialization routine for Restart testing. It calls various
+// init routines, including the creation of the default decomposition.
+
+int initRestartTest() {
+
+   int Err = 0;
+
+   // Initialize the Machine Environment class - this also creates
+   // the default MachEnv. Then retrieve the default environment and
+   // some needed data members.
+   OMEGA::MachEnv::init(MPI_COMM_WORLD);
+   OMEGA::MachEnv *DefEnv = OMEGA::MachEnv::getDefaultEnv();
+   MPI_Comm DefComm       = DefEnv->getComm();
+
+   // Initialize the IO system
+   Err = OMEGA::IO::init(DefComm);
+   if (Err != 0)
+      LOG_ERROR("RestartTest: error initializing parallel IO");
+
+   // Create the default decomposition (initializes the decomposition)
+   Err = OMEGA::Decomp::init();
+   if (Err != 0)
+      LOG_ERROR("RestartTest: error initializing default decomposition");
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Set the test arrays to values that depend on the global cell ID
+
+void setFields(OMEGA::Array2DR8 &FieldR8, OMEGA::Array1DI4 &FieldI4,
+               const OMEGA::Array1DI4 &CellID) {
+
+   OMEGA::parallelFor(
+       {FieldR8.extent_int(0), FieldR8.extent_int(1)},
+       KOKKOS_LAMBDA(int Cell, int K) {
+          FieldR8(Cell, K) = 0.5 * CellID(Cell) + K;
+       });
+   OMEGA::parallelFor(
+       {FieldI4.extent_int(0)},
+       KOKKOS_LAMBDA(int Cell) { FieldI4(Cell) = 3 * CellID(Cell); });
+}
+
+//------------------------------------------------------------------------------
+// Count the owned cells where the test arrays differ from the set values
+
+int checkFields(const OMEGA::Array2DR8 &FieldR8,
+                const OMEGA::Array1DI4 &FieldI4,
+                const OMEGA::HostArray1DI4 &CellIDH, OMEGA::I4 NCellsOwned) {
+
+   auto FieldR8H = OMEGA::createHostMirrorCopy(FieldR8);
+   auto FieldI4H = OMEGA::createHostMirrorCopy(FieldI4);
+   int Count     = 0;
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      for (int K = 0; K < FieldR8H.extent_int(1); ++K) {
+         if (FieldR8H(Cell, K) != 0.5 * CellIDH(Cell) + K)
+            ++Count;
+      }
+      if (FieldI4H(Cell) != 3 * CellIDH(Cell))
+         ++Count;
+   }
+   return Count;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for Restart.
+//
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   // Initialize the global MPI environment
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      int Err = initRestartTest();
+      if (Err != 0)
+         LOG_CRITICAL("RestartTest: Error initializing");
+
+      OMEGA::MachEnv *DefEnv   = OMEGA::MachEnv::getDefaultEnv();
+      OMEGA::Decomp *DefDecomp = OMEGA::Decomp::getDefault();
+      OMEGA::I4 NCellsSize     = DefDecomp->NCellsSize;
+      OMEGA::I4 NCellsOwned    = DefDecomp->NCellsOwned;
+      OMEGA::I4 NCellsGlobal   = DefDecomp->NCellsGlobal;
+      OMEGA::I4 NVertLevels    = 8;
+
+      // Create the IO decompositions for cell arrays
+      OMEGA::HostArray1DI4 CellIDH = DefDecomp->CellIDH;
+      OMEGA::Array1DI4 CellID      = DefDecomp->CellID;
+      std::vector<int> OffsetCell(NCellsSize, -1);
+      std::vector<int> OffsetCellK(NCellsSize * NVertLevels, -1);
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         OffsetCell[Cell] = CellIDH(Cell) - 1;
+         for (int K = 0; K < NVertLevels; ++K) {
+            OffsetCellK[Cell * NVertLevels + K] =
+                (CellIDH(Cell) - 1) * NVertLevels + K;
+         }
+      }
+      int DecompCellI4;
+      int DecompCellR8;
+      std::vector<int> CellDims{NCellsGlobal};
+      std::vector<int> CellKDims{NCellsGlobal, NVertLevels};
+      Err = OMEGA::IO::createDecomp(DecompCellI4, OMEGA::IO::IOTypeI4, 1,
+                                    CellDims, NCellsSize, OffsetCell,
+                                    OMEGA::IO::DefaultRearr);
+      Err += OMEGA::IO::createDecomp(DecompCellR8, OMEGA::IO::IOTypeR8, 2,
+                                     CellKDims, NCellsSize * NVertLevels,
+                                     OffsetCellK, OMEGA::IO::DefaultRearr);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("RestartTest: error creating cell decomps FAIL");
+      }
+
+      // Define the fields
+      auto CellDim = OMEGA::MetaDim::create("NCells", NCellsGlobal);
+      auto VertDim = OMEGA::MetaDim::create("NVertLevels", NVertLevels);
+      std::vector<std::shared_ptr<OMEGA::MetaDim>> DimsR8{CellDim, VertDim};
+      std::vector<std::shared_ptr<OMEGA::MetaDim>> DimsI4{CellDim};
+      std::vector<std::string> DimNamesR8{"NCells", "NVertLevels"};
+      std::vector<std::string> DimNamesI4{"NCells"};
+      OMEGA::ArrayMetaData::create("RestartR8", "Test restart field", "m",
+                                   "RestartStdName", -1.0e10, 1.0e10,
+                                   -9.99E+30, 2, DimsR8);
+      OMEGA::ArrayMetaData::create("RestartI4", "Test restart field", "1",
+                                   "RestartStdName", -1000000000, 1000000000,
+                                   -999, 1, DimsI4);
+      Err = OMEGA::IOField::define("RestartR8");
+      Err += OMEGA::IOField::define("RestartI4");
+
+      OMEGA::Array2DR8 FieldR8("FieldR8", NCellsSize, NVertLevels);
+      OMEGA::Array1DI4 FieldI4("FieldI4", NCellsSize);
+      Err += OMEGA::IOField::attachData<OMEGA::Array2DR8>("RestartR8", FieldR8);
+      Err += OMEGA::IOField::attachData<OMEGA::Array1DI4>("RestartI4", FieldI4);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("RestartTest: error defining fields FAIL");
+      }
+
+      // Create a clock with an hourly time step and restarts written every
+      // two hours. The drain directory must exist before the first write.
+      OMEGA::Calendar CalNoLeap("No Leap", OMEGA::CalendarNoLeap);
+      OMEGA::TimeInstant StartTime(&CalNoLeap, 1, 1, 1, 0, 0, 0.0);
+      OMEGA::TimeInterval TimeStep(1, OMEGA::TimeUnits::Hours);
+      OMEGA::TimeInterval RestartFreq(2, OMEGA::TimeUnits::Hours);
+      OMEGA::Clock ModelClock(StartTime, TimeStep);
+
+      const std::string DrainDir = "RestartTestDrain";
+      if (DefEnv->isMasterTask())
+         std::filesystem::create_directories(DrainDir);
+      MPI_Barrier(DefEnv->getComm());
+
+      Err = OMEGA::Restart::create("RestartNC", "RestartTest.$Y-$M-$D_$h.nc",
+                                   OMEGA::RestartFormat::NetCDF, RestartFreq,
+                                   &ModelClock);
+      Err += OMEGA::Restart::create(
+          "RestartBin", "RestartTest.$Y-$M-$D_$h.bin",
+          OMEGA::RestartFormat::NodeBinary, RestartFreq, &ModelClock, DrainDir);
+      if (Err == 0 and OMEGA::Restart::isDefined("RestartNC") and
+          OMEGA::Restart::isDefined("RestartBin")) {
+         LOG_INFO("RestartTest: create restarts PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("RestartTest: create restarts FAIL");
+      }
+
+      std::vector<std::string> RestartNames{"RestartNC", "RestartBin"};
+      Err = 0;
+      for (auto &RestartName : RestartNames) {
+         Err += OMEGA::Restart::addField<OMEGA::Array2DR8>(
+             RestartName, "RestartR8", DecompCellR8, DimNamesR8);
+         Err += OMEGA::Restart::addField<OMEGA::Array1DI4>(
+             RestartName, "RestartI4", DecompCellI4, DimNamesI4);
+      }
+      if (Err == 0) {
+         LOG_INFO("RestartTest: add fields PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("RestartTest: add fields FAIL");
+      }
+
+      // Step forward two steps to write both restarts, waiting for the
+      // drain of the node files before they are read
+      setFields(FieldR8, FieldI4, CellID);
+      for (int Step = 1; Step <= 2; ++Step) {
+         ModelClock.advance();
+         for (auto &RestartName : RestartNames) {
+            Err = OMEGA::Restart::write(RestartName);
+            if (Err != 0) {
+               RetVal += 1;
+               LOG_ERROR("RestartTest: error writing {} at step {} FAIL",
+                         RestartName, Step);
+            }
+         }
+      }
+      Err = OMEGA::Restart::waitDrain("RestartBin");
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("RestartTest: error draining node files FAIL");
+      }
+
+      // Clear the arrays and read each restart
+      for (auto &RestartName : RestartNames) {
+         Kokkos::deep_copy(FieldR8, 0.0);
+         Kokkos::deep_copy(FieldI4, 0);
+         Err = OMEGA::Restart::read(RestartName);
+         if (Err == 0 and
+             checkFields(FieldR8, FieldI4, CellIDH, NCellsOwned) == 0) {
+            LOG_INFO("RestartTest: read {} PASS", RestartName);
+         } else {
+            RetVal += 1;
+            LOG_ERROR("RestartTest: read {} FAIL", RestartName);
+         }
+      }
+
+      // Remove the node files so the node binary restart is read from the
+      // drained copies
+      MPI_Barrier(DefEnv->getComm());
+      if (DefEnv->isMasterTask()) {
+         for (auto &Entry : std::filesystem::directory_iterator(".")) {
+            std::string FileName = Entry.path().filename().string();
+            if (FileName.find(".bin.node") != std::string::npos)
+               std::filesystem::remove(Entry.path());
+         }
+      }
+      MPI_Barrier(DefEnv->getComm());
+
+      Kokkos::deep_copy(FieldR8, 0.0);
+      Kokkos::deep_copy(FieldI4, 0);
+      Err = OMEGA::Restart::read("RestartBin");
+      if (Err == 0 and
+          checkFields(FieldR8, FieldI4, CellIDH, NCellsOwned) == 0) {
+         LOG_INFO("RestartTest: read drained node files PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("RestartTest: read drained node files FAIL");
+      }
+
+      // A node binary restart must be read with the same array sizes
+      OMEGA::I4 NewSize = DefEnv->isMasterTask() ? NCellsSize + 1 : NCellsSize;
+      OMEGA::Array1DI4 ResizedI4("ResizedI4", NewSize);
+      OMEGA::IOField::attachData<OMEGA::Array1DI4>("RestartI4", ResizedI4);
+      Err = OMEGA::Restart::read("RestartBin");
+      if (Err != 0) {
+         LOG_INFO("RestartTest: read with changed size fails PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("RestartTest: read with changed size fails FAIL");
+      }
+
+      // Clean up
+      OMEGA::Restart::clear();
+      OMEGA::IOField::clear();
+      Err = OMEGA::IO::destroyDecomp(DecompCellI4);
+      Err += OMEGA::IO::destroyDecomp(DecompCellR8);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("RestartTest: error destroying decomps FAIL");
+      }
+      Err = OMEGA::IO::finalize();
+      OMEGA::Decomp::clear();
+      OMEGA::MachEnv::removeAll();
+      if (RetVal == 0)
+         LOG_INFO("RestartTest: Successful completion");
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
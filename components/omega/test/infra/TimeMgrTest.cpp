@@ -15,6 +15,9 @@
 #include "DataTypes.h"
 #include "Logging.h"
 
+#include <memory>
+#include <vector>
+
 //------------------------------------------------------------------------------
 // TimeFrac test
 
@@ -499,6 +502,33 @@ int testTimeFrac(void) {
       LOG_ERROR("TimeMgrTest/TimeFrac: convert: FAIL");
    }
 
+   // Test the integer fast paths against the general forms: whole seconds
+   // on a non-unit denominator, negative times and proper fractions on
+   // the same denominator must give simplified results
+
+   OMEGA::TimeFrac WholeA(7, 0, 5);
+   OMEGA::TimeFrac WholeB(-3, 0, 1);
+   OMEGA::TimeFrac HalfA(2, 1, 2);
+   OMEGA::TimeFrac HalfB(0, 3, 2); // not proper, same value as 1 1/2
+   OMEGA::TimeFrac HalfC(1, 1, 2);
+
+   Err1 = (WholeA + WholeB).get(WTst, NTst, DTst);
+   bool FastTest = Err1 == 0 && WTst == 4 && NTst == 0 && DTst == 1;
+   Err1          = (WholeB - WholeA).get(WTst, NTst, DTst);
+   FastTest = FastTest && Err1 == 0 && WTst == -10 && NTst == 0 && DTst == 1;
+   Err1     = (WholeA * 3).get(WTst, NTst, DTst);
+   FastTest = FastTest && Err1 == 0 && WTst == 21 && NTst == 0 && DTst == 1;
+   FastTest = FastTest && HalfB == HalfC && HalfA > HalfC && HalfC < HalfA &&
+              HalfA >= HalfA && HalfB <= HalfC && HalfA != HalfB &&
+              WholeB < WholeA && OMEGA::TimeFrac(7, 0, 1) == WholeA;
+
+   if (FastTest) {
+      LOG_INFO("TimeMgrTest/TimeFrac: integer fast paths: PASS");
+   } else {
+      ++ErrAll;
+      LOG_ERROR("TimeMgrTest/TimeFrac: integer fast paths: FAIL");
+   }
+
    return ErrAll;
 
 } // end testTimeFrac
@@ -4326,6 +4356,84 @@ int testClock(void) {
 
 } // end testClock
 
+//------------------------------------------------------------------------------
+// Checks that the clock alarm schedule rings alarms at the same steps as a
+// direct comparison of every alarm with the current time, including alarms
+// on fractional intervals, resets, stops and changes of the time step.
+
+int testClockSchedule(void) {
+
+   LOG_INFO("TimeMgrTest: Clock schedule tests ------------------------------");
+
+   OMEGA::I4 ErrAll{0};
+   OMEGA::I4 NumRings{0};
+
+   OMEGA::Calendar CalNoLeap("No Leap", OMEGA::CalendarNoLeap);
+   OMEGA::TimeInstant Time0(&CalNoLeap, 2000, 1, 1, 0, 0, 0.0);
+   OMEGA::TimeInterval TimeStep(10, OMEGA::TimeUnits::Minutes);
+   OMEGA::Clock ModelClock(Time0, TimeStep);
+
+   // Periodic alarms on intervals that do and do not align with the step,
+   // one of them 7.5 minutes
+   const OMEGA::I4 NumAlarms = 40;
+   std::vector<std::unique_ptr<OMEGA::Alarm>> Alarms;
+   for (OMEGA::I4 N = 0; N < NumAlarms; ++N) {
+      OMEGA::TimeInterval Interval(7 * (N + 1), OMEGA::TimeUnits::Minutes);
+      if (N == 0)
+         Interval = OMEGA::TimeInterval(450, 0, 1);
+      Alarms.push_back(std::make_unique<OMEGA::Alarm>(
+          "Schedule " + std::to_string(N), Interval, Time0));
+      ModelClock.attachAlarm(Alarms.back().get());
+   }
+   OMEGA::TimeInstant OneTime(&CalNoLeap, 2000, 1, 3, 5, 5, 0.0);
+   OMEGA::Alarm AlarmOneTime("Schedule one-time", OneTime);
+   ModelClock.attachAlarm(&AlarmOneTime);
+
+   for (OMEGA::I4 Step = 1; Step <= 1000; ++Step) {
+
+      if (Step == 300)
+         Alarms[3]->stop();
+      if (Step == 500)
+         ModelClock.changeTimeStep(
+             OMEGA::TimeInterval(5, OMEGA::TimeUnits::Minutes));
+
+      ModelClock.advance();
+      OMEGA::TimeInstant CurrTime = ModelClock.getCurrentTime();
+
+      for (OMEGA::I4 N = 0; N < NumAlarms; ++N) {
+         OMEGA::Alarm *ThisAlarm = Alarms[N].get();
+         bool Expected           = !ThisAlarm->isStopped() &&
+                         CurrTime >= ThisAlarm->getRingTime();
+         if (ThisAlarm->isRinging() != Expected) {
+            ++ErrAll;
+            LOG_ERROR("TimeMgrTest/Clock: schedule alarm {} step {}: FAIL", N,
+                      Step);
+         }
+         if (ThisAlarm->isRinging()) {
+            ++NumRings;
+            ThisAlarm->reset(CurrTime);
+         }
+      }
+
+      bool Expected = CurrTime >= OneTime;
+      if (AlarmOneTime.isRinging() != Expected) {
+         ++ErrAll;
+         LOG_ERROR("TimeMgrTest/Clock: schedule one-time alarm step {}: FAIL",
+                   Step);
+      }
+   }
+
+   if (ErrAll == 0 && NumRings > 0) {
+      LOG_INFO("TimeMgrTest/Clock: alarm schedule: PASS");
+   } else {
+      ++ErrAll;
+      LOG_ERROR("TimeMgrTest/Clock: alarm schedule: FAIL");
+   }
+
+   return ErrAll;
+
+} // end testClockSchedule
+
 //------------------------------------------------------------------------------
 // The test driver.
 
@@ -4352,6 +4460,9 @@ int main(int argc, char *argv[]) {
    Err = testClock();
    TotErr += Err;
 
+   Err = testClockSchedule();
+   TotErr += Err;
+
    if (TotErr == 0) {
       LOG_INFO("TimeMgrTest: Successful completion");
    } else {
@@ -0,0 +1,164 @@
+//===-- Test driver for OMEGA Timers -----------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA timers
+///
+/// This driver tests the OMEGA timers, including nested timers, timers
+/// called from different locations in the call tree, timers on a subset of
+/// tasks, the work rates of timers and the gathering and printing of the
+/// timer statistics.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Timer.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// A utility routine with a timer that is called from several locations
+
+void sleepRoutine(int Milliseconds) {
+   Timer::start("Sleep");
+   std::this_thread::sleep_for(std::chrono::milliseconds(Milliseconds));
+   Timer::stop("Sleep");
+}
+
+//------------------------------------------------------------------------------
+// The test driver for timers
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+   int Err    = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefaultEnv();
+
+      // Create a sub-environment with half of the tasks
+      const int NumSubTasks = DefEnv->getNumTasks() / 2 + 1;
+      MachEnv SubEnv("TimerSubset", DefEnv, NumSubTasks);
+      MachEnv *Subset = MachEnv::getEnv("TimerSubset");
+
+      Err = Timer::initialize();
+      if (Err != 0) {
+         LOG_ERROR("TimerTest: initialize: FAIL");
+         RetVal += 1;
+      }
+      Timer::setDeviceSync(true);
+
+      // Nested timers with the same utility timer at two locations
+      const int NSteps = 3;
+      for (int Step = 0; Step < NSteps; ++Step) {
+         Timer::start("Step");
+         sleepRoutine(5);
+         Timer::start("Compute");
+         Array1DR8 A("A", 1000);
+         parallelFor({1000}, KOKKOS_LAMBDA(int I) { A(I) = I; });
+         Timer::addWork(8000.0, 1000.0);
+         sleepRoutine(10);
+         Timer::stop("Compute");
+         Timer::stop("Step");
+      }
+
+      if (Timer::getNumCalls("Total/Step") == NSteps &&
+          Timer::getNumCalls("Total/Step/Sleep") == NSteps &&
+          Timer::getNumCalls("Total/Step/Compute/Sleep") == NSteps &&
+          Timer::getTime("Total/Step/Sleep") >= 0.005 * NSteps &&
+          Timer::getTime("Total/Step/Compute/Sleep") >= 0.010 * NSteps &&
+          Timer::getTime("Total/Step") >=
+              Timer::getTime("Total/Step/Compute") &&
+          Timer::getBytes("Total/Step/Compute") == 8000.0 * NSteps &&
+          Timer::getFlops("Total/Step/Compute") == 1000.0 * NSteps &&
+          Timer::getBytes("Total/Step") == 0.0 &&
+          Timer::getTime("Total/NoTimer") < 0.0) {
+         LOG_INFO("TimerTest: nested timers: PASS");
+      } else {
+         LOG_ERROR("TimerTest: nested timers: FAIL");
+         RetVal += 1;
+      }
+
+      // Stopping a timer that is not running returns an error without
+      // changing the running timer
+      Timer::start("Outer");
+      Err = Timer::stop("Step");
+      if (Err != 0 && Timer::stop("Outer") == 0) {
+         LOG_INFO("TimerTest: stop error: PASS");
+      } else {
+         LOG_ERROR("TimerTest: stop error: FAIL");
+         RetVal += 1;
+      }
+
+      // Timer on a subset of tasks
+      if (Subset->isMember()) {
+         Timer::start("SubsetWork", "TimerSubset");
+         std::this_thread::sleep_for(std::chrono::milliseconds(2));
+         Timer::stop("SubsetWork");
+      }
+      if (Timer::start("BadEnv", "NoSuchEnv") != 0) {
+         LOG_INFO("TimerTest: unknown context: PASS");
+      } else {
+         LOG_ERROR("TimerTest: unknown context: FAIL");
+         RetVal += 1;
+      }
+
+      // Print the statistics to a file and check its contents
+      const std::string TimerFile = "TimerTest.txt";
+      Timer::setTimerFile(TimerFile);
+      Timer::setPeakBandwidth(100.0);
+      Err = Timer::finalize();
+      if (Err != 0) {
+         LOG_ERROR("TimerTest: finalize: FAIL");
+         RetVal += 1;
+      }
+
+      if (DefEnv->isMasterTask()) {
+         std::ifstream InFile(TimerFile);
+         std::string Line;
+         int NFound = 0;
+         std::getline(InFile, Line);
+         if (Line.find("GB/s") != std::string::npos &&
+             Line.find("%Peak") != std::string::npos)
+            ++NFound;
+         while (std::getline(InFile, Line)) {
+            if (Line.find("Total") == 0 || Line.find("    Sleep") == 0 ||
+                Line.find("  SubsetWork [TimerSubset]") == 0)
+               ++NFound;
+         }
+         if (NFound == 4) {
+            LOG_INFO("TimerTest: print: PASS");
+         } else {
+            LOG_ERROR("TimerTest: print: FAIL");
+            RetVal += 1;
+         }
+      }
+
+      if (Timer::getNumCalls("Total") < 0) {
+         LOG_INFO("TimerTest: clear: PASS");
+      } else {
+         LOG_ERROR("TimerTest: clear: FAIL");
+         RetVal += 1;
+      }
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
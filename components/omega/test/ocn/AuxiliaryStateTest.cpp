@@ -0,0 +1,327 @@
+//===-- Test driver for OMEGA AuxiliaryState ---------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA auxiliary state
+///
+/// This driver tests that the auxiliary variables match the horizontal
+/// operators, that each kind is computed only when requested and at most
+/// once until the state changes, and that the IO fields compute their kind
+/// from the output state when they are updated.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AuxiliaryState.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "IO.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanState.h"
+#include "OceanTestCommon.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+using namespace OMEGA;
+
+constexpr I4 NVertLevels = 16;
+
+//------------------------------------------------------------------------------
+// Set a smooth, positive thickness and a nonzero velocity on all elements
+
+int setState(const Array2DReal &LayerThick, const Array2DReal &NormalVel) {
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+   auto AreaCell  = Mesh->AreaCell;
+   auto AngleEdge = Mesh->AngleEdge;
+   auto AreaCellH = Mesh->AreaCellH;
+
+   Real MeanArea = 0;
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell)
+      MeanArea += AreaCellH(ICell) / Mesh->NCellsOwned;
+
+   parallelFor(
+       {Mesh->NCellsAll, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          LayerThick(ICell, K) = 10 + K + AreaCell(ICell) / MeanArea;
+       });
+   parallelFor(
+       {Mesh->NEdgesAll, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+          NormalVel(IEdge, K) = Kokkos::cos(AngleEdge(IEdge)) + 0.01 * K;
+       });
+
+   return 0;
+
+} // end setState
+
+//------------------------------------------------------------------------------
+// Compare the auxiliary variables with the horizontal operators
+
+int testValues() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh           = HorzMesh::getDefault();
+   AuxiliaryState *AuxState = AuxiliaryState::get("Default");
+
+   Array2DReal LayerThick("TestThick", Mesh->NCellsSize, NVertLevels);
+   Array2DReal NormalVel("TestVel", Mesh->NEdgesSize, NVertLevels);
+   Err += setState(LayerThick, NormalVel);
+   Err += AuxState->compute(AuxAllKinds, LayerThick, NormalVel);
+
+   Array2DReal DivCell("TestDiv", Mesh->NCellsSize, NVertLevels);
+   Array2DReal CurlVertex("TestCurl", Mesh->NVerticesSize, NVertLevels);
+   DivergenceOnCell DivergenceCell(Mesh);
+   CurlOnVertex CurlVert(Mesh);
+   parallelFor(
+       {Mesh->NCellsOwned, numVertChunks(NVertLevels)},
+       KOKKOS_LAMBDA(int ICell, int KChunk) {
+          DivergenceCell(DivCell, ICell, KChunk, NormalVel);
+       });
+   parallelFor(
+       {Mesh->NVerticesOwned, numVertChunks(NVertLevels)},
+       KOKKOS_LAMBDA(int IVertex, int KChunk) {
+          CurlVert(CurlVertex, IVertex, KChunk, NormalVel);
+       });
+
+   auto DivH     = createHostMirrorCopy(DivCell);
+   auto CurlH    = createHostMirrorCopy(CurlVertex);
+   auto ThickH   = createHostMirrorCopy(LayerThick);
+   auto AuxDivH  = createHostMirrorCopy(AuxState->KineticAux.VelocityDivCell);
+   auto AuxVortH = createHostMirrorCopy(AuxState->VorticityAux.RelVortVertex);
+   auto AuxMeanH =
+       createHostMirrorCopy(AuxState->LayerThicknessAux.MeanLayerThickEdge);
+   auto AuxNormH =
+       createHostMirrorCopy(AuxState->VorticityAux.NormRelVortVertex);
+   auto AuxNormEdgeH =
+       createHostMirrorCopy(AuxState->VorticityAux.NormRelVortEdge);
+   const Real RTol = sizeof(Real) == 4 ? 1e-5 : 1e-10;
+
+   int NErr = 0;
+   for (int K = 0; K < NVertLevels; ++K) {
+      for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+         if (!isApprox(AuxDivH(ICell, K), DivH(ICell, K), RTol))
+            ++NErr;
+      }
+      for (int IVertex = 0; IVertex < Mesh->NVerticesOwned; ++IVertex) {
+         if (!isApprox(AuxVortH(IVertex, K), CurlH(IVertex, K), RTol))
+            ++NErr;
+      }
+      for (int IEdge = 0; IEdge < Mesh->NEdgesOwned; ++IEdge) {
+         const int JCell0   = Mesh->CellsOnEdgeH(IEdge, 0);
+         const int JCell1   = Mesh->CellsOnEdgeH(IEdge, 1);
+         const int JVertex0 = Mesh->VerticesOnEdgeH(IEdge, 0);
+         const int JVertex1 = Mesh->VerticesOnEdgeH(IEdge, 1);
+         const Real MeanThick =
+             0.5_Real * (ThickH(JCell0, K) + ThickH(JCell1, K));
+         const Real MeanVort =
+             0.5_Real * (AuxNormH(JVertex0, K) + AuxNormH(JVertex1, K));
+         if (!isApprox(AuxMeanH(IEdge, K), MeanThick, RTol) ||
+             !isApprox(AuxNormEdgeH(IEdge, K), MeanVort, RTol))
+            ++NErr;
+      }
+   }
+
+   if (Err == 0 && NErr == 0) {
+      LOG_INFO("AuxiliaryStateTest: values: PASS");
+   } else {
+      LOG_ERROR("AuxiliaryStateTest: values: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testValues
+
+//------------------------------------------------------------------------------
+// Check that each kind is computed only when it is out of date, and that all
+// kinds on the same mesh element are computed in one loop
+
+int testLazy() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh           = HorzMesh::getDefault();
+   AuxiliaryState *AuxState = AuxiliaryState::get("Default");
+
+   Array2DReal LayerThick("TestThick", Mesh->NCellsSize, NVertLevels);
+   Array2DReal NormalVel("TestVel", Mesh->NEdgesSize, NVertLevels);
+   Err += setState(LayerThick, NormalVel);
+
+   // New arrays invalidate all kinds and a request computes only the
+   // requested kind
+   I4 Passes = AuxState->getNumPasses();
+   Err += AuxState->compute(AuxKineticCell, LayerThick, NormalVel);
+   bool Pass = AuxState->getNumPasses() == Passes + 1 &&
+               AuxState->isValid(AuxKineticCell, LayerThick, NormalVel) &&
+               !AuxState->isValid(AuxLayerThickEdge, LayerThick, NormalVel);
+
+   // A second request for the same kind is free
+   Passes = AuxState->getNumPasses();
+   Err += AuxState->compute(AuxKineticCell, LayerThick, NormalVel);
+   Pass = Pass && AuxState->getNumPasses() == Passes;
+
+   // Both edge kinds and their vertex dependency take one vertex loop and
+   // one edge loop
+   Err += AuxState->compute(AuxLayerThickEdge | AuxVortEdge, LayerThick,
+                            NormalVel);
+   Pass = Pass && AuxState->getNumPasses() == Passes + 2 &&
+          AuxState->isValid(AuxAllKinds, LayerThick, NormalVel);
+
+   // A state change invalidates all kinds
+   AuxiliaryState::invalidateAll();
+   Pass = Pass && !AuxState->isValid(AuxKineticCell, LayerThick, NormalVel);
+   Passes = AuxState->getNumPasses();
+   Err += AuxState->compute(AuxAllKinds, LayerThick, NormalVel);
+   Pass = Pass && AuxState->getNumPasses() == Passes + 3;
+
+   AuxState->invalidate();
+   Pass = Pass && !AuxState->isValid(AuxVortVertex, LayerThick, NormalVel);
+
+   if (Err == 0 && Pass) {
+      LOG_INFO("AuxiliaryStateTest: lazy compute: PASS");
+   } else {
+      LOG_ERROR("AuxiliaryStateTest: lazy compute: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testLazy
+
+//------------------------------------------------------------------------------
+// Check that updating an IO field computes its kind from the output state
+
+int testOutput() {
+
+   int Err = 0;
+
+   AuxiliaryState *AuxState = AuxiliaryState::get("Default");
+   OceanState *State        = OceanState::getDefault();
+
+   Array2DReal LayerThick;
+   Array2DReal NormalVel;
+   Err += State->getLayerThickness(LayerThick, 0);
+   Err += State->getNormalVelocity(NormalVel, 0);
+   Err += setState(LayerThick, NormalVel);
+   AuxiliaryState::invalidateAll();
+
+   I4 Passes = AuxState->getNumPasses();
+   Err += IOField::update("KineticEnergyCell");
+   Err += IOField::update("VelocityDivCell");
+   bool Pass = AuxState->getNumPasses() == Passes + 1 &&
+               AuxState->isValid(AuxKineticCell, LayerThick, NormalVel) &&
+               !AuxState->isValid(AuxVortVertex, LayerThick, NormalVel);
+
+   if (Err == 0 && Pass) {
+      LOG_INFO("AuxiliaryStateTest: output: PASS");
+   } else {
+      LOG_ERROR("AuxiliaryStateTest: output: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testOutput
+
+//------------------------------------------------------------------------------
+// The initialization routine for auxiliary state testing
+
+int initAuxStateTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("AuxiliaryStateTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("AuxiliaryStateTest: error initializing default "
+                "decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("AuxiliaryStateTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("AuxiliaryStateTest: error initializing default mesh");
+   }
+
+   int StateErr = OceanState::init(NVertLevels, 2);
+   if (StateErr != 0) {
+      Err++;
+      LOG_ERROR("AuxiliaryStateTest: error initializing default state");
+   }
+
+   AuxiliaryState *AuxState =
+       AuxiliaryState::create("Default", HorzMesh::getDefault(), NVertLevels,
+                              Center, OceanState::getDefault());
+   if (AuxState == nullptr || AuxState != AuxiliaryState::get("Default")) {
+      Err++;
+      LOG_ERROR("AuxiliaryStateTest: error creating auxiliary state");
+   }
+
+   return Err;
+
+} // end initAuxStateTest
+
+//------------------------------------------------------------------------------
+// The test driver for the auxiliary state
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initAuxStateTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("AuxiliaryStateTest: Error initializing");
+
+      RetVal += testValues();
+      RetVal += testLazy();
+      RetVal += testOutput();
+
+      AuxiliaryState::clear();
+      if (!IOField::isDefined("KineticEnergyCell")) {
+         LOG_INFO("AuxiliaryStateTest: clear: PASS");
+      } else {
+         LOG_ERROR("AuxiliaryStateTest: clear: FAIL");
+         RetVal += 1;
+      }
+
+      if (RetVal == 0)
+         LOG_INFO("AuxiliaryStateTest: Successful completion");
+
+      OceanState::clear();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,207 @@
+//===-- Test driver for OMEGA BarotropicSolver -------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA semi-implicit barotropic solver
+///
+/// This driver applies the operator of the barotropic solver to a smooth
+/// field and tests that the solver recovers the field, including its halo,
+/// from the result, that a solve started from the solution takes no
+/// iterations, and that a solve limited to too few iterations reports an
+/// error.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "BarotropicSolver.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OMEGA;
+
+constexpr Real Gravity  = 9.80616;
+constexpr Real Dt       = 3600;
+constexpr Real Depth    = 4000;
+constexpr Real SolveTol = sizeof(Real) == 4 ? 1e-5 : 1e-10;
+constexpr Real ErrTol   = sizeof(Real) == 4 ? 1e-3 : 1e-7;
+
+//------------------------------------------------------------------------------
+// Sets a smooth field on all cells
+
+void setField(const Array1DReal &Field) {
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   HostArray1DReal FieldH("FieldH", Mesh->NCellsSize);
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell)
+      FieldH(ICell) =
+          std::cos(Mesh->LatCellH(ICell)) * std::cos(Mesh->LonCellH(ICell));
+   deepCopy(Field, FieldH);
+
+} // end setField
+
+//------------------------------------------------------------------------------
+// Returns the max difference of two fields over the first NCells cells
+// relative to the largest value of the reference, over all tasks
+
+Real maxRelDiff(const Array1DReal &Test, const Array1DReal &Ref, I4 NCells) {
+
+   auto TestH = createHostMirrorCopy(Test);
+   auto RefH  = createHostMirrorCopy(Ref);
+
+   Real MaxDiff[2] = {0, 0};
+   for (int ICell = 0; ICell < NCells; ++ICell) {
+      MaxDiff[0] = std::max(MaxDiff[0], std::abs(TestH(ICell) - RefH(ICell)));
+      MaxDiff[1] = std::max(MaxDiff[1], std::abs(RefH(ICell)));
+   }
+   MPI_Allreduce(MPI_IN_PLACE, MaxDiff, 2, MPI_RealKind, MPI_MAX,
+                 MachEnv::getDefaultEnv()->getComm());
+
+   return MaxDiff[0] / MaxDiff[1];
+
+} // end maxRelDiff
+
+//------------------------------------------------------------------------------
+// Tests the solver on a manufactured solution
+
+int testSolve() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   Array1DReal ThickEdge("ThickEdge", Mesh->NEdgesSize);
+   deepCopy(ThickEdge, Depth);
+
+   BarotropicSolver Solver("Test", Mesh, Halo::getDefault(), SolveTol);
+   Err += Solver.setCoefficients(ThickEdge, Gravity, Dt);
+
+   Array1DReal XRef("XRef", Mesh->NCellsSize);
+   Array1DReal Rhs("Rhs", Mesh->NCellsSize);
+   Array1DReal X("X", Mesh->NCellsSize);
+   setField(XRef);
+   Err += Solver.apply(Rhs, XRef);
+
+   // Solve from a zero initial guess
+   int SolveErr = Solver.solve(X, Rhs);
+   Real RelDiff = maxRelDiff(X, XRef, Mesh->NCellsAll);
+   if (SolveErr == 0 && RelDiff < ErrTol &&
+       Solver.getRelResidual() <= SolveTol) {
+      LOG_INFO("BarotropicSolverTest: solve in {} iterations: PASS",
+               Solver.getNumIterations());
+   } else {
+      LOG_ERROR("BarotropicSolverTest: solve error {} after {} iterations: "
+                "FAIL",
+                RelDiff, Solver.getNumIterations());
+      Err += 1;
+   }
+
+   // A solve started from the solution has converged before iterating
+   deepCopy(X, XRef);
+   SolveErr = Solver.solve(X, Rhs);
+   if (SolveErr == 0 && Solver.getNumIterations() == 0) {
+      LOG_INFO("BarotropicSolverTest: warm start: PASS");
+   } else {
+      LOG_ERROR("BarotropicSolverTest: warm start took {} iterations: FAIL",
+                Solver.getNumIterations());
+      Err += 1;
+   }
+
+   // A solve limited to too few iterations must report an error
+   BarotropicSolver ShortSolver("TestShort", Mesh, Halo::getDefault(),
+                                SolveTol, 2);
+   Err += ShortSolver.setCoefficients(ThickEdge, Gravity, Dt);
+   deepCopy(X, 0);
+   if (ShortSolver.solve(X, Rhs) != 0) {
+      LOG_INFO("BarotropicSolverTest: non-convergence detected: PASS");
+   } else {
+      LOG_ERROR("BarotropicSolverTest: non-convergence not detected: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testSolve
+
+//------------------------------------------------------------------------------
+// The initialization routine for barotropic solver testing
+
+int initBarotropicSolverTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("BarotropicSolverTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("BarotropicSolverTest: error initializing default "
+                "decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("BarotropicSolverTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("BarotropicSolverTest: error initializing default mesh");
+   }
+
+   return Err;
+
+} // end initBarotropicSolverTest
+
+//------------------------------------------------------------------------------
+// The test driver for the barotropic solver
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initBarotropicSolverTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("BarotropicSolverTest: Error initializing");
+
+      RetVal += testSolve();
+
+      if (RetVal == 0)
+         LOG_INFO("BarotropicSolverTest: Successful completion");
+
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
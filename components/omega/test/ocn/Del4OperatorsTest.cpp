@@ -0,0 +1,334 @@
+//===-- Test driver for OMEGA Del4Operators ----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA biharmonic operators
+///
+/// This driver tests that the fused Laplacian operators match the
+/// composition of the gradient, divergence and curl operators, and that the
+/// biharmonic operators, which compute the first Laplacian on the owned
+/// elements and exchange its halo, match two Laplacians computed without an
+/// exchange by evaluating the first one redundantly on the halo.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Del4Operators.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OMEGA;
+
+constexpr I4 NVertLevels = 12;
+
+//------------------------------------------------------------------------------
+// Set smooth fields on all cells and edges
+
+void setFields(const Array2DReal &ScalarCell, const Array2DReal &VecEdge) {
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   HostArray2DReal ScalarCellH("ScalarCellH", Mesh->NCellsSize, NVertLevels);
+   HostArray2DReal VecEdgeH("VecEdgeH", Mesh->NEdgesSize, NVertLevels);
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         ScalarCellH(ICell, K) = std::cos(Mesh->LatCellH(ICell)) *
+                                 std::cos(Mesh->LonCellH(ICell)) *
+                                 (1.0 + 0.1 * K);
+      }
+   }
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         VecEdgeH(IEdge, K) = std::cos(Mesh->LatEdgeH(IEdge)) *
+                              std::sin(2.0 * Mesh->LonEdgeH(IEdge) +
+                                       Mesh->AngleEdgeH(IEdge)) *
+                              (1.0 + 0.1 * K);
+      }
+   }
+   deepCopy(ScalarCell, ScalarCellH);
+   deepCopy(VecEdge, VecEdgeH);
+
+} // end setFields
+
+//------------------------------------------------------------------------------
+// Count the elements of the first NElems where two arrays differ by more than
+// a tolerance relative to the largest value of the reference
+
+int countDiffs(const Array2DReal &Test, const Array2DReal &Ref, I4 NElems) {
+
+   auto TestH = createHostMirrorCopy(Test);
+   auto RefH  = createHostMirrorCopy(Ref);
+
+   Real MaxRef = 0;
+   for (int I = 0; I < NElems; ++I) {
+      for (int K = 0; K < NVertLevels; ++K)
+         MaxRef = std::max(MaxRef, std::abs(RefH(I, K)));
+   }
+
+   const Real RTol = sizeof(Real) == 4 ? 1e-4 : 1e-10;
+   int NErr        = 0;
+   for (int I = 0; I < NElems; ++I) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (std::abs(TestH(I, K) - RefH(I, K)) > RTol * MaxRef)
+            ++NErr;
+      }
+   }
+
+   return NErr;
+
+} // end countDiffs
+
+//------------------------------------------------------------------------------
+// Compare the fused Laplacians with the composition of the operators
+
+int testLaplacians() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh     = HorzMesh::getDefault();
+   const I4 NChunks   = numVertChunks(NVertLevels);
+   const I4 NCellsAll = Mesh->NCellsAll;
+   const I4 NEdgesAll = Mesh->NEdgesAll;
+   const I4 NVertAll  = Mesh->NVerticesAll;
+
+   Array2DReal ScalarCell("ScalarCell", Mesh->NCellsSize, NVertLevels);
+   Array2DReal VecEdge("VecEdge", Mesh->NEdgesSize, NVertLevels);
+   setFields(ScalarCell, VecEdge);
+
+   // Scalar Laplacian as the divergence of the gradient
+   Array2DReal GradEdge("GradEdge", Mesh->NEdgesSize, NVertLevels);
+   Array2DReal RefCell("RefCell", Mesh->NCellsSize, NVertLevels);
+   Array2DReal LapCell("LapCell", Mesh->NCellsSize, NVertLevels);
+   GradientOnEdge Gradient(Mesh);
+   DivergenceOnCell Divergence(Mesh);
+   ScalarLaplacianOnCell ScalarLaplacian(Mesh);
+   parallelFor(
+       {NEdgesAll, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          Gradient(GradEdge, IEdge, KChunk, ScalarCell);
+       });
+   parallelFor(
+       {Mesh->NCellsOwned, NChunks}, KOKKOS_LAMBDA(int ICell, int KChunk) {
+          Divergence(RefCell, ICell, KChunk, GradEdge);
+          ScalarLaplacian(LapCell, ICell, KChunk, ScalarCell);
+       });
+
+   int NErr = countDiffs(LapCell, RefCell, Mesh->NCellsOwned);
+   if (NErr == 0) {
+      LOG_INFO("Del4OperatorsTest: scalar Laplacian: PASS");
+   } else {
+      LOG_ERROR("Del4OperatorsTest: scalar Laplacian: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   // Vector Laplacian as the gradient of the divergence minus the
+   // perpendicular gradient of the curl
+   Array2DReal DivCell("DivCell", Mesh->NCellsSize, NVertLevels);
+   Array2DReal CurlVertex("CurlVertex", Mesh->NVerticesSize, NVertLevels);
+   Array2DReal RefEdge("RefEdge", Mesh->NEdgesSize, NVertLevels);
+   Array2DReal LapEdge("LapEdge", Mesh->NEdgesSize, NVertLevels);
+   CurlOnVertex Curl(Mesh);
+   VectorLaplacianOnEdge VectorLaplacian(Mesh);
+   parallelFor(
+       {NCellsAll, NChunks}, KOKKOS_LAMBDA(int ICell, int KChunk) {
+          Divergence(DivCell, ICell, KChunk, VecEdge);
+       });
+   parallelFor(
+       {NVertAll, NChunks}, KOKKOS_LAMBDA(int IVertex, int KChunk) {
+          Curl(CurlVertex, IVertex, KChunk, VecEdge);
+       });
+   auto CellsOnEdge    = Mesh->CellsOnEdge;
+   auto VerticesOnEdge = Mesh->VerticesOnEdge;
+   auto DcEdge         = Mesh->DcEdge;
+   auto DvEdge         = Mesh->DvEdge;
+   parallelFor(
+       {Mesh->NEdgesOwned, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+          const int JCell0   = CellsOnEdge(IEdge, 0);
+          const int JCell1   = CellsOnEdge(IEdge, 1);
+          const int JVertex0 = VerticesOnEdge(IEdge, 0);
+          const int JVertex1 = VerticesOnEdge(IEdge, 1);
+          RefEdge(IEdge, K) =
+              (DivCell(JCell1, K) - DivCell(JCell0, K)) / DcEdge(IEdge) -
+              (CurlVertex(JVertex1, K) - CurlVertex(JVertex0, K)) /
+                  DvEdge(IEdge);
+       });
+   parallelFor(
+       {Mesh->NEdgesOwned, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          VectorLaplacian(LapEdge, IEdge, KChunk, VecEdge);
+       });
+
+   NErr = countDiffs(LapEdge, RefEdge, Mesh->NEdgesOwned);
+   if (NErr == 0) {
+      LOG_INFO("Del4OperatorsTest: vector Laplacian: PASS");
+   } else {
+      LOG_ERROR("Del4OperatorsTest: vector Laplacian: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testLaplacians
+
+//------------------------------------------------------------------------------
+// Compare the biharmonic operators with two Laplacians computed without an
+// exchange, the first over the halo layers read by the second
+
+int testDel4() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh   = HorzMesh::getDefault();
+   Decomp *Dcmp     = Decomp::getDefault();
+   const I4 NChunks = numVertChunks(NVertLevels);
+
+   Array2DReal ScalarCell("ScalarCell", Mesh->NCellsSize, NVertLevels);
+   Array2DReal VecEdge("VecEdge", Mesh->NEdgesSize, NVertLevels);
+   setFields(ScalarCell, VecEdge);
+
+   // Vector biharmonic on edges
+   Del4OnEdge EdgeDel4("Test", Mesh, Halo::getDefault(), NVertLevels);
+   Array2DReal Del4Edge("Del4Edge", Mesh->NEdgesSize, NVertLevels);
+   Err += EdgeDel4.compute(Del4Edge, VecEdge);
+
+   VectorLaplacianOnEdge VectorLaplacian(Mesh);
+   Array2DReal Del2Edge("Del2Edge", Mesh->NEdgesSize, NVertLevels);
+   Array2DReal RefEdge("RefEdge", Mesh->NEdgesSize, NVertLevels);
+   const I4 NEdgesDel2 = Dcmp->NEdgesHaloH(Del4OnEdge::NHaloLayers - 1);
+   parallelFor(
+       {NEdgesDel2, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          VectorLaplacian(Del2Edge, IEdge, KChunk, VecEdge);
+       });
+   parallelFor(
+       {Mesh->NEdgesOwned, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          VectorLaplacian(RefEdge, IEdge, KChunk, Del2Edge);
+       });
+
+   int NErr = countDiffs(Del4Edge, RefEdge, Mesh->NEdgesOwned);
+   if (Err == 0 && NErr == 0) {
+      LOG_INFO("Del4OperatorsTest: edge del4: PASS");
+   } else {
+      LOG_ERROR("Del4OperatorsTest: edge del4: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   // Scalar biharmonic on cells
+   Del4OnCell CellDel4("Test", Mesh, Halo::getDefault(), NVertLevels);
+   Array2DReal Del4Cell("Del4Cell", Mesh->NCellsSize, NVertLevels);
+   int CellErr = CellDel4.compute(Del4Cell, ScalarCell);
+
+   ScalarLaplacianOnCell ScalarLaplacian(Mesh);
+   Array2DReal Del2Cell("Del2Cell", Mesh->NCellsSize, NVertLevels);
+   Array2DReal RefCell("RefCell", Mesh->NCellsSize, NVertLevels);
+   const I4 NCellsDel2 = Dcmp->NCellsHaloH(Del4OnCell::NHaloLayers - 1);
+   parallelFor(
+       {NCellsDel2, NChunks}, KOKKOS_LAMBDA(int ICell, int KChunk) {
+          ScalarLaplacian(Del2Cell, ICell, KChunk, ScalarCell);
+       });
+   parallelFor(
+       {Mesh->NCellsOwned, NChunks}, KOKKOS_LAMBDA(int ICell, int KChunk) {
+          ScalarLaplacian(RefCell, ICell, KChunk, Del2Cell);
+       });
+
+   NErr = countDiffs(Del4Cell, RefCell, Mesh->NCellsOwned);
+   if (CellErr == 0 && NErr == 0) {
+      LOG_INFO("Del4OperatorsTest: cell del4: PASS");
+   } else {
+      LOG_ERROR("Del4OperatorsTest: cell del4: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   // A second call reuses the scratch array and exchange pattern
+   Err += EdgeDel4.compute(Del4Edge, VecEdge);
+   NErr = countDiffs(Del4Edge, RefEdge, Mesh->NEdgesOwned);
+   if (NErr != 0) {
+      LOG_ERROR("Del4OperatorsTest: repeated edge del4: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testDel4
+
+//------------------------------------------------------------------------------
+// The initialization routine for biharmonic operator testing
+
+int initDel4Test() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("Del4OperatorsTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("Del4OperatorsTest: error initializing default "
+                "decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("Del4OperatorsTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("Del4OperatorsTest: error initializing default mesh");
+   }
+
+   return Err;
+
+} // end initDel4Test
+
+//------------------------------------------------------------------------------
+// The test driver for the biharmonic operators
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initDel4Test();
+      if (RetVal != 0)
+         LOG_CRITICAL("Del4OperatorsTest: Error initializing");
+
+      RetVal += testLaplacians();
+      RetVal += testDel4();
+
+      if (RetVal == 0)
+         LOG_INFO("Del4OperatorsTest: Successful completion");
+
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
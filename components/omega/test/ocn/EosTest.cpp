@@ -0,0 +1,341 @@
+//===-- Test driver for OMEGA Eos --------------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA equation of state
+///
+/// This driver tests the linear and polynomial equations of state against
+/// their definitions, the expansion and contraction coefficients of the
+/// polynomial against finite differences of the density, the table of the
+/// polynomial against the polynomial, and that Eos computes the same values
+/// on the mesh from the packed tracer array as the functors.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Eos.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OMEGA;
+
+constexpr I4 NVertLevels = 20;
+constexpr I4 NPoints     = 1000;
+constexpr Real RTol      = sizeof(Real) == 4 ? 1e-5 : 1e-12;
+
+//------------------------------------------------------------------------------
+// Temperature, salinity and depth of test point I, spread over the ocean
+// range
+
+KOKKOS_INLINE_FUNCTION Real testTemp(int I) {
+   return 15 + 15 * Kokkos::sin(0.37 * I);
+}
+KOKKOS_INLINE_FUNCTION Real testSalt(int I) {
+   return 20 + 18 * Kokkos::cos(0.23 * I);
+}
+KOKKOS_INLINE_FUNCTION Real testDepth(int I) {
+   return 2900 + 2800 * Kokkos::sin(0.11 * I);
+}
+
+//------------------------------------------------------------------------------
+// Evaluates an equation of state at the test points on the device and
+// returns the results on the host, with the temperature of each point
+// shifted by DTemp and its salinity by DSalt
+
+template <typename F>
+HostArray2DReal evalPoints(const F &Form, Real DTemp = 0, Real DSalt = 0) {
+
+   Array2DReal Vals("Vals", NPoints, 3);
+   parallelFor(
+       {NPoints}, KOKKOS_LAMBDA(int I) {
+          Real Temp[VecLength], Salt[VecLength], Z[VecLength];
+          for (int KVec = 0; KVec < VecLength; ++KVec) {
+             Temp[KVec] = testTemp(I) + DTemp;
+             Salt[KVec] = testSalt(I) + DSalt;
+             Z[KVec]    = testDepth(I);
+          }
+          Real Rho[VecLength], Alpha[VecLength], Beta[VecLength];
+          Form(Rho, Alpha, Beta, Temp, Salt, Z);
+          Vals(I, 0) = Rho[0];
+          Vals(I, 1) = Alpha[0];
+          Vals(I, 2) = Beta[0];
+       });
+
+   return createHostMirrorCopy(Vals);
+
+} // end evalPoints
+
+//------------------------------------------------------------------------------
+// Tests the linear and polynomial forms and the table
+
+int testForms() {
+
+   int Err = 0;
+
+   // Linear form against its definition
+   LinearEos Linear;
+   auto LinVals = evalPoints(Linear);
+   Real MaxErr  = 0;
+   for (int I = 0; I < NPoints; ++I) {
+      const Real Rho =
+          Linear.RhoRef * (1 - Linear.Alpha * (testTemp(I) - Linear.TempRef) +
+                           Linear.Beta * (testSalt(I) - Linear.SaltRef));
+      MaxErr = std::max(MaxErr, std::abs(LinVals(I, 0) - Rho) / Rho);
+      if (LinVals(I, 1) != Linear.Alpha || LinVals(I, 2) != Linear.Beta)
+         MaxErr = 1;
+   }
+   if (MaxErr < RTol) {
+      LOG_INFO("EosTest: linear form: PASS");
+   } else {
+      LOG_ERROR("EosTest: linear form error {}: FAIL", MaxErr);
+      Err += 1;
+   }
+
+   // The polynomial is exact at the reference point, and since it is
+   // quadratic in temperature and salinity its coefficients equal centered
+   // differences of the density
+   PolynomialEos Poly;
+   Real Rho[VecLength], Alpha[VecLength], Beta[VecLength];
+   Real Temp[VecLength], Salt[VecLength], Z[VecLength];
+   for (int KVec = 0; KVec < VecLength; ++KVec) {
+      Temp[KVec] = 10;
+      Salt[KVec] = 35;
+      Z[KVec]    = 0;
+   }
+   Poly(Rho, Alpha, Beta, Temp, Salt, Z);
+   if (Rho[0] != Poly.RhoRef ||
+       std::abs(Alpha[0] - Poly.A0 / Poly.RhoRef) > RTol * Alpha[0] ||
+       std::abs(Beta[0] - Poly.B0 / Poly.RhoRef) > RTol * Beta[0]) {
+      LOG_ERROR("EosTest: polynomial at reference point: FAIL");
+      Err += 1;
+   }
+
+   // The coefficients change sign in cold fresh water, so their errors are
+   // measured relative to their values at the reference point
+   const Real AlphaRef = Poly.A0 / Poly.RhoRef;
+   const Real BetaRef  = Poly.B0 / Poly.RhoRef;
+   const Real Delta    = 0.5;
+   const Real DTol     = sizeof(Real) == 4 ? 1e-2 : 1e-8;
+   auto PolyVals       = evalPoints(Poly);
+   auto TempPlus       = evalPoints(Poly, Delta, 0);
+   auto TempMinus      = evalPoints(Poly, -Delta, 0);
+   auto SaltPlus       = evalPoints(Poly, 0, Delta);
+   auto SaltMinus      = evalPoints(Poly, 0, -Delta);
+   Real MaxDiffErr     = 0;
+   for (int I = 0; I < NPoints; ++I) {
+      const Real AlphaFD = -(TempPlus(I, 0) - TempMinus(I, 0)) /
+                           (2 * Delta * Poly.RhoRef);
+      const Real BetaFD =
+          (SaltPlus(I, 0) - SaltMinus(I, 0)) / (2 * Delta * Poly.RhoRef);
+      MaxDiffErr = std::max(MaxDiffErr,
+                            std::abs(PolyVals(I, 1) - AlphaFD) / AlphaRef);
+      MaxDiffErr =
+          std::max(MaxDiffErr, std::abs(PolyVals(I, 2) - BetaFD) / BetaRef);
+   }
+   if (MaxDiffErr < DTol) {
+      LOG_INFO("EosTest: polynomial coefficients: PASS");
+   } else {
+      LOG_ERROR("EosTest: polynomial coefficients error {}: FAIL",
+                MaxDiffErr);
+      Err += 1;
+   }
+
+   // The table interpolates the quadratic terms of the density and is exact
+   // for the coefficients, which are linear in each variable
+   EosOptions Opts;
+   EosTable Table(Poly, Opts.TableTempMin, Opts.TableTempMax, Opts.TableNTemp,
+                  Opts.TableSaltMin, Opts.TableSaltMax, Opts.TableNSalt,
+                  Opts.TableDepthMax, Opts.TableNDepth);
+   auto TableVals     = evalPoints(Table);
+   const Real RhoTol  = 1e-4; // kg/m^3
+   const Real CoefTol = sizeof(Real) == 4 ? 1e-4 : 1e-8;
+   Real MaxRhoErr     = 0;
+   Real MaxCoefErr    = 0;
+   for (int I = 0; I < NPoints; ++I) {
+      MaxRhoErr =
+          std::max(MaxRhoErr, std::abs(TableVals(I, 0) - PolyVals(I, 0)));
+      MaxCoefErr = std::max(
+          MaxCoefErr, std::abs(TableVals(I, 1) - PolyVals(I, 1)) / AlphaRef);
+      MaxCoefErr = std::max(
+          MaxCoefErr, std::abs(TableVals(I, 2) - PolyVals(I, 2)) / BetaRef);
+   }
+   if (MaxRhoErr < RhoTol && MaxCoefErr < CoefTol) {
+      LOG_INFO("EosTest: table: PASS");
+   } else {
+      LOG_ERROR("EosTest: table density error {} coefficient error {}: FAIL",
+                MaxRhoErr, MaxCoefErr);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testForms
+
+//------------------------------------------------------------------------------
+// Tests the computation on the mesh from the packed tracer array against the
+// functors, for each form
+
+int testCompute() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh    = HorzMesh::getDefault();
+   const I4 NCells   = Mesh->NCellsAll;
+   const I4 IndxSalt = 0;
+   const I4 IndxTemp = 2;
+
+   // Temperature and salinity are placed among other tracers
+   Array3DReal TracerArray("TracerArray", 3, Mesh->NCellsSize, NVertLevels);
+   Array2DReal Depth("Depth", Mesh->NCellsSize, NVertLevels);
+   parallelFor(
+       {NCells, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          const int I                     = ICell * NVertLevels + K;
+          TracerArray(IndxTemp, ICell, K) = testTemp(I);
+          TracerArray(IndxSalt, ICell, K) = testSalt(I);
+          TracerArray(1, ICell, K)        = -1;
+          Depth(ICell, K)                 = testDepth(I);
+       });
+
+   const std::string Names[3] = {"Linear", "Polynomial", "Table"};
+   for (int N = 0; N < 3; ++N) {
+      EosOptions Opts;
+      Opts.Type     = N == 0 ? EosType::Linear : EosType::Polynomial;
+      Opts.UseTable = N == 2;
+      Eos *TestEos  = Eos::create(Names[N], Mesh, NVertLevels, Opts);
+      if (TestEos == nullptr || TestEos->usesTable() != Opts.UseTable) {
+         LOG_ERROR("EosTest: error creating {} equation of state", Names[N]);
+         Err += 1;
+         continue;
+      }
+      TestEos->compute(TracerArray, IndxTemp, IndxSalt, Depth);
+
+      auto DensityH = createHostMirrorCopy(TestEos->Density);
+      auto AlphaH   = createHostMirrorCopy(TestEos->ThermalExpansion);
+      auto BetaH    = createHostMirrorCopy(TestEos->HalineContraction);
+
+      LinearEos Linear;
+      PolynomialEos Poly;
+      const Real AlphaRef = Poly.A0 / Poly.RhoRef;
+      const Real BetaRef  = Poly.B0 / Poly.RhoRef;
+      Real MaxErr         = 0;
+      for (int ICell = 0; ICell < NCells; ++ICell) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            const int I = ICell * NVertLevels + K;
+            Real Rho[VecLength], Alpha[VecLength], Beta[VecLength];
+            Real Temp[VecLength], Salt[VecLength], Z[VecLength];
+            for (int KVec = 0; KVec < VecLength; ++KVec) {
+               Temp[KVec] = testTemp(I);
+               Salt[KVec] = testSalt(I);
+               Z[KVec]    = testDepth(I);
+            }
+            if (N == 0)
+               Linear(Rho, Alpha, Beta, Temp, Salt, Z);
+            else
+               Poly(Rho, Alpha, Beta, Temp, Salt, Z);
+            MaxErr = std::max(MaxErr,
+                              std::abs(DensityH(ICell, K) - Rho[0]) / Rho[0]);
+            MaxErr = std::max(MaxErr,
+                              std::abs(AlphaH(ICell, K) - Alpha[0]) / AlphaRef);
+            MaxErr = std::max(MaxErr,
+                              std::abs(BetaH(ICell, K) - Beta[0]) / BetaRef);
+         }
+      }
+      // The table is checked against the polynomial to its accuracy
+      const Real Tol = N == 2 ? 1e-5 : 10 * RTol;
+      if (MaxErr < Tol) {
+         LOG_INFO("EosTest: {} compute on mesh: PASS", Names[N]);
+      } else {
+         LOG_ERROR("EosTest: {} compute on mesh error {}: FAIL", Names[N],
+                   MaxErr);
+         Err += 1;
+      }
+   }
+
+   Eos::clear();
+
+   return Err;
+
+} // end testCompute
+
+//------------------------------------------------------------------------------
+// The initialization routine for equation of state testing
+
+int initEosTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("EosTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("EosTest: error initializing default decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("EosTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("EosTest: error initializing default mesh");
+   }
+
+   return Err;
+
+} // end initEosTest
+
+//------------------------------------------------------------------------------
+// The test driver for the equation of state
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initEosTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("EosTest: Error initializing");
+
+      RetVal += testForms();
+      RetVal += testCompute();
+
+      if (RetVal == 0)
+         LOG_INFO("EosTest: Successful completion");
+
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -12,13 +12,16 @@
 #include "DataTypes.h"
 #include "Decomp.h"
 #include "Halo.h"
+#include "HorzOperators.h"
 #include "IO.h"
 #include "Logging.h"
 #include "MachEnv.h"
 #include "OmegaKokkos.h"
 #include "mpi.h"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // The initialization routine for Mesh testing. It calls various
@@ -163,6 +166,32 @@ int main(int argc, char *argv[]) {
       // Retrieve default mesh
       OMEGA::HorzMesh *Mesh = OMEGA::HorzMesh::getDefault();
 
+      // Test on-demand loading of optional mesh fields
+      // The default mesh does not read the coordinates or mesh density on
+      // creation, so they are only allocated once requested
+      bool LoadPass = !Mesh->CoordinatesLoaded and
+                      !Mesh->MeshDensityLoaded and Mesh->XCellH.size() == 0 and
+                      Mesh->MeshDensityH.size() == 0;
+      Err = Mesh->loadCoordinates();
+      if (Err != 0 or !Mesh->CoordinatesLoaded or
+          Mesh->XCellH.size() != Mesh->NCellsSize or
+          Mesh->LatVertexH.size() != Mesh->NVerticesSize)
+         LoadPass = false;
+      // A second request should not re-read the coordinates
+      auto XCellData = Mesh->XCellH.data();
+      Err            = Mesh->loadCoordinates();
+      if (Err != 0 or Mesh->XCellH.data() != XCellData)
+         LoadPass = false;
+      if (Mesh->MeshDensityLoaded or Mesh->MeshDensityH.size() != 0)
+         LoadPass = false;
+
+      if (LoadPass) {
+         LOG_INFO("HorzMeshTest: optional field loading PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: optional field loading FAIL");
+      }
+
       // Test sum of local mesh cells
       // Get the global sum of all local cell counts
       // Tests that the correct cell counts have been retrieved from the Decomp
@@ -674,6 +703,38 @@ int main(int argc, char *argv[]) {
          LOG_INFO("HorzMeshTest: edgeSignOnVertex test FAIL");
       }
 
+      // Test operator metrics
+      // Check that the signed lengths and inverse areas stored for the
+      // operators are consistent with the mesh arrays they are derived from
+      // Tests that the operator metrics were calculated correctly
+      const OMEGA::R8 MetricTol = sizeof(OMEGA::MetricReal) == 4 ? 1e-6 : tol;
+      auto OpDvEdgeSignOnCellH =
+          OMEGA::createHostMirrorCopy(Mesh->OpDvEdgeSignOnCell);
+      auto OpInvAreaCellH = OMEGA::createHostMirrorCopy(Mesh->OpInvAreaCell);
+      count = 0;
+      for (int Cell = 0; Cell < LocCells; Cell++) {
+         if (abs(OpInvAreaCellH(Cell) * Mesh->AreaCellH(Cell) - 1.0) >
+             MetricTol) {
+            count++;
+         }
+         for (int i = 0; i < Mesh->NEdgesOnCellH(Cell); i++) {
+            int Edge = Mesh->EdgesOnCellH(Cell, i);
+            OMEGA::R8 DvSign =
+                Mesh->DvEdgeH(Edge) * Mesh->EdgeSignOnCellH(Cell, i);
+            if (abs(OpDvEdgeSignOnCellH(Cell, i) - DvSign) >
+                MetricTol * abs(DvSign)) {
+               count++;
+            }
+         }
+      }
+
+      if (count == 0) {
+         LOG_INFO("HorzMeshTest: operator metrics test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: operator metrics test FAIL");
+      }
+
       // Test cell halo values
       // Perform halo exhange on owned cell only array and compare
       // read values
@@ -759,8 +820,222 @@ int main(int argc, char *argv[]) {
          RetVal += 1;
          LOG_INFO("HorzMeshTest: vertex halo exhange FAIL");
       }
+
+      // Test computed derived mesh quantities
+      // Create a second mesh that computes the derived quantities from the
+      // coordinates and connectivity and compare them with the values read
+      // from the mesh file
+      OMEGA::HorzMesh ComputedMesh("Computed", DefDecomp, true, false, true);
+      OMEGA::HorzMesh *CMesh = OMEGA::HorzMesh::get("Computed");
+
+      const OMEGA::R8 DerivedTol = 1e-6;
+      count                      = 0;
+      if (CMesh->DerivedComputed) {
+         for (int Cell = 0; Cell < Mesh->NCellsOwned; Cell++) {
+            if (abs(CMesh->AreaCellH(Cell) - Mesh->AreaCellH(Cell)) >
+                DerivedTol * Mesh->AreaCellH(Cell))
+               count++;
+            if (abs(CMesh->FCellH(Cell) - Mesh->FCellH(Cell)) > 1e-12)
+               count++;
+         }
+         for (int Vertex = 0; Vertex < Mesh->NVerticesOwned; Vertex++) {
+            if (abs(CMesh->AreaTriangleH(Vertex) -
+                    Mesh->AreaTriangleH(Vertex)) >
+                DerivedTol * Mesh->AreaTriangleH(Vertex))
+               count++;
+            for (int i = 0; i < Mesh->VertexDegree; i++) {
+               if (abs(CMesh->KiteAreasOnVertexH(Vertex, i) -
+                       Mesh->KiteAreasOnVertexH(Vertex, i)) >
+                   DerivedTol * Mesh->AreaTriangleH(Vertex))
+                  count++;
+            }
+         }
+         for (int Edge = 0; Edge < Mesh->NEdgesOwned; Edge++) {
+            if (abs(CMesh->DcEdgeH(Edge) - Mesh->DcEdgeH(Edge)) >
+                DerivedTol * Mesh->DcEdgeH(Edge))
+               count++;
+            if (abs(CMesh->DvEdgeH(Edge) - Mesh->DvEdgeH(Edge)) >
+                DerivedTol * Mesh->DvEdgeH(Edge))
+               count++;
+            OMEGA::R8 AngleDiff =
+                abs(CMesh->AngleEdgeH(Edge) - Mesh->AngleEdgeH(Edge));
+            if (std::min(AngleDiff, 2.0 * pi - AngleDiff) > DerivedTol)
+               count++;
+            for (int i = 0; i < Mesh->NEdgesOnEdgeH(Edge); i++) {
+               if (abs(CMesh->WeightsOnEdgeH(Edge, i) -
+                       Mesh->WeightsOnEdgeH(Edge, i)) > DerivedTol)
+                  count++;
+            }
+         }
+      }
+
+      if (count == 0) {
+         LOG_INFO("HorzMeshTest: computed derived quantities PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: computed derived quantities FAIL");
+      }
+
+      // Test the vertical level bounds derived from the bottom depth with
+      // uniformly spaced reference levels on the computed mesh
+      const OMEGA::I4 NVertLevels = 60;
+      OMEGA::R8 MaxDepth          = 0.0;
+      for (int Cell = 0; Cell < CMesh->NCellsAll; Cell++)
+         MaxDepth = std::max(MaxDepth, CMesh->BottomDepthH(Cell));
+      std::vector<OMEGA::R8> RefBottomDepth(NVertLevels);
+      for (int K = 0; K < NVertLevels; K++)
+         RefBottomDepth[K] = (K + 1) * MaxDepth / NVertLevels;
+
+      count = CMesh->initVertLevels(NVertLevels, RefBottomDepth);
+
+      OMEGA::I4 NOcean = 0;
+      for (int Cell = 0; Cell < CMesh->NCellsOwned; Cell++) {
+         const OMEGA::R8 Depth  = CMesh->BottomDepthH(Cell);
+         const OMEGA::I4 MinLev = CMesh->MinLevelCellH(Cell);
+         const OMEGA::I4 MaxLev = CMesh->MaxLevelCellH(Cell);
+         if (Depth > 0.0) {
+            if (MinLev != 0 || MaxLev < 0 || MaxLev >= NVertLevels ||
+                RefBottomDepth[MaxLev] < Depth ||
+                (MaxLev > 0 && RefBottomDepth[MaxLev - 1] >= Depth))
+               count++;
+            NOcean++;
+         } else if (MaxLev >= MinLev) {
+            count++;
+         }
+      }
+      if (NOcean != CMesh->NCellsOwnedOcean)
+         count++;
+      auto OceanCellsH = OMEGA::createHostMirrorCopy(CMesh->OceanCellsOwned);
+      for (int I = 0; I < CMesh->NCellsOwnedOcean; I++) {
+         if (CMesh->BottomDepthH(OceanCellsH(I)) <= 0.0)
+            count++;
+      }
+
+      for (int Edge = 0; Edge < CMesh->NEdgesOwned; Edge++) {
+         const OMEGA::I4 Cell0 = CMesh->CellsOnEdgeH(Edge, 0);
+         const OMEGA::I4 Cell1 = CMesh->CellsOnEdgeH(Edge, 1);
+         if (CMesh->MaxLevelEdgeTopH(Edge) !=
+                 std::min(CMesh->MaxLevelCellH(Cell0),
+                          CMesh->MaxLevelCellH(Cell1)) ||
+             CMesh->MaxLevelEdgeBotH(Edge) !=
+                 std::max(CMesh->MaxLevelCellH(Cell0),
+                          CMesh->MaxLevelCellH(Cell1)))
+            count++;
+      }
+      for (int Vertex = 0; Vertex < CMesh->NVerticesOwned; Vertex++) {
+         if (CMesh->MaxLevelVertexTopH(Vertex) >
+                 CMesh->MaxLevelVertexBotH(Vertex) ||
+             CMesh->MinLevelVertexTopH(Vertex) <
+                 CMesh->MinLevelVertexBotH(Vertex))
+            count++;
+      }
+
+      // Chunks below the bottom of a cell must be zeroed by the operators
+      const int NChunks = OMEGA::numVertChunks(NVertLevels);
+      OMEGA::Array2DReal VecEdge("VecEdge", CMesh->NEdgesSize, NVertLevels);
+      OMEGA::Array2DReal DivCell("DivCell", CMesh->NCellsSize, NVertLevels);
+      OMEGA::deepCopy(VecEdge, 1.0);
+      OMEGA::deepCopy(DivCell, 1.0);
+      OMEGA::DivergenceOnCell DivOp(CMesh);
+      OMEGA::parallelFor(
+          {CMesh->NCellsOwned, NChunks}, KOKKOS_LAMBDA(int ICell, int KChunk) {
+             DivOp(DivCell, ICell, KChunk, VecEdge);
+          });
+      auto DivCellH = OMEGA::createHostMirrorCopy(DivCell);
+      for (int Cell = 0; Cell < CMesh->NCellsOwned; Cell++) {
+         const OMEGA::I4 MaxLev = CMesh->MaxLevelCellH(Cell);
+         const int KFirstInactive =
+             MaxLev < 0 ? 0
+                        : (MaxLev / OMEGA::VecLength + 1) * OMEGA::VecLength;
+         for (int K = KFirstInactive; K < NVertLevels; K++) {
+            if (DivCellH(Cell, K) != 0.0)
+               count++;
+         }
+      }
+
+      if (count == 0) {
+         LOG_INFO("HorzMeshTest: vertical level bounds PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: vertical level bounds FAIL");
+      }
+
+      // Test that the lists of ocean elements follow a change of the cell
+      // bounds, making the first owned ocean cell land
+      count                      = 0;
+      const OMEGA::I4 NOwnedPrev = CMesh->NCellsOwnedOcean;
+      const OMEGA::I4 NAllPrev   = CMesh->NCellsAllOcean;
+      if (NOwnedPrev > 0) {
+         const OMEGA::I4 LandCell       = OceanCellsH(0);
+         CMesh->MaxLevelCellH(LandCell) = -1;
+         CMesh->updateLevelBounds();
+
+         if (CMesh->NCellsOwnedOcean != NOwnedPrev - 1 ||
+             CMesh->NCellsAllOcean != NAllPrev - 1)
+            count++;
+         auto OceanCellsAllH =
+             OMEGA::createHostMirrorCopy(CMesh->OceanCellsAll);
+         for (int I = 0; I < CMesh->NCellsAllOcean; I++) {
+            if (OceanCellsAllH(I) == LandCell)
+               count++;
+         }
+
+         OMEGA::I4 NEdgesOcean = 0;
+         for (int Edge = 0; Edge < CMesh->NEdgesAll; Edge++) {
+            const OMEGA::I4 Cell0 = CMesh->CellsOnEdgeH(Edge, 0);
+            const OMEGA::I4 Cell1 = CMesh->CellsOnEdgeH(Edge, 1);
+            if (CMesh->MaxLevelCellH(Cell0) >= 0 ||
+                CMesh->MaxLevelCellH(Cell1) >= 0)
+               NEdgesOcean++;
+         }
+         if (NEdgesOcean != CMesh->NEdgesAllOcean)
+            count++;
+      }
+
+      if (count == 0) {
+         LOG_INFO("HorzMeshTest: ocean element lists update PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: ocean element lists update FAIL");
+      }
+
+      // Test that released host arrays are recreated from the device copies
+      count = 0;
+      OMEGA::HostArray2DI4 CellsOnEdgeRef("CellsOnEdgeRef", Mesh->NEdgesSize,
+                                          2);
+      OMEGA::HostArray1DR8 AreaCellRef("AreaCellRef", Mesh->NCellsSize);
+      OMEGA::HostArray1DI4 CellIDRef("CellIDRef", DefDecomp->NCellsSize);
+      Kokkos::deep_copy(CellsOnEdgeRef, Mesh->CellsOnEdgeH);
+      Kokkos::deep_copy(AreaCellRef, Mesh->AreaCellH);
+      Kokkos::deep_copy(CellIDRef, DefDecomp->CellIDH);
+
+      DefDecomp->releaseHostArrays();
+      Mesh->releaseHostArrays();
+
+      auto CellsOnEdgeNew = Mesh->getHost(Mesh->CellsOnEdgeH);
+      auto AreaCellNew    = Mesh->getHost(Mesh->AreaCellH);
+      auto CellIDNew      = DefDecomp->getHost(DefDecomp->CellIDH);
+      for (int Edge = 0; Edge < Mesh->NEdgesAll; Edge++) {
+         if (CellsOnEdgeNew(Edge, 0) != CellsOnEdgeRef(Edge, 0) ||
+             CellsOnEdgeNew(Edge, 1) != CellsOnEdgeRef(Edge, 1))
+            count++;
+      }
+      for (int Cell = 0; Cell < Mesh->NCellsAll; Cell++) {
+         if (AreaCellNew(Cell) != AreaCellRef(Cell) ||
+             CellIDNew(Cell) != CellIDRef(Cell))
+            count++;
+      }
+
+      if (count == 0) {
+         LOG_INFO("HorzMeshTest: release host arrays PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: release host arrays FAIL");
+      }
+
       // Finalize Omega objects
       OMEGA::HorzMesh::clear();
+      OMEGA::Halo::clear();
       OMEGA::Decomp::clear();
       OMEGA::MachEnv::removeAll();
 
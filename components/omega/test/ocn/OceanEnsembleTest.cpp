@@ -0,0 +1,403 @@
+//===-- Test driver for OMEGA OceanEnsemble ----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA ensemble of ocean states
+///
+/// This driver tests that an ensemble allocates the members of each time
+/// level in one array with a leading member dimension whose slices are the
+/// member arrays, that the halos of all members are exchanged together,
+/// that the time levels are advanced by swapping handles, that the member
+/// statistics are computed over all members, and that a time step of the
+/// ensemble gives each member the same result as a run of that member
+/// alone.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "OceanEnsemble.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+#include "mpi.h"
+
+#include <cmath>
+
+using namespace OMEGA;
+
+constexpr I4 NVertLevels = 8;
+constexpr I4 NMembers    = 3;
+
+// Value of a state variable of a member at the element with global ID
+// GlobalID
+KOKKOS_INLINE_FUNCTION Real memberValue(int GlobalID, int K, int Member) {
+   return GlobalID + 0.01 * K + 1000.0 * Member;
+}
+
+// Tendencies in which the velocity decays and the thickness is constant
+class DecayTendencies : public Tendencies {
+ public:
+   DecayTendencies(HorzMesh *InMesh) : Mesh(InMesh) {}
+
+   void computeThicknessTendency(const Array2DReal &ThickTend,
+                                 const Array2DReal &NormalVelocity,
+                                 const Array2DReal &LayerThickness,
+                                 const TimeInstant &Time) override {
+      deepCopy(ThickTend, 0);
+   }
+
+   void computeVelocityTendency(const Array2DReal &VelTend,
+                                const Array2DReal &NormalVelocity,
+                                const Array2DReal &LayerThickness,
+                                const TimeInstant &Time) override {
+      parallelFor(
+          {Mesh->NEdgesOwned, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+             VelTend(IEdge, K) = -NormalVelocity(IEdge, K);
+          });
+   }
+
+ private:
+   HorzMesh *Mesh;
+};
+
+//------------------------------------------------------------------------------
+// Check the sizes of the ensemble and that the member arrays are slices of
+// the ensemble arrays
+
+int testCreate(OceanEnsemble *Ensemble) {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   EnsembleArray Thick;
+   EnsembleArray Vel;
+   Err += Ensemble->getLayerThickness(Thick, 0);
+   Err += Ensemble->getNormalVelocity(Vel, 0);
+
+   // Fill each member through its own array
+   for (int Member = 0; Member < NMembers; ++Member) {
+      Array2DReal MemberThick;
+      Err += Ensemble->getMemberLayerThickness(MemberThick, Member, 0);
+      deepCopy(MemberThick, Member + 1);
+   }
+
+   // Read all members through the ensemble array
+   I4 NWrong = 0;
+   parallelReduce(
+       {NMembers, Mesh->NCellsSize, NVertLevels},
+       KOKKOS_LAMBDA(int Member, int ICell, int K, I4 &Count) {
+          if (Thick(Member, ICell, K) != Member + 1)
+             ++Count;
+       },
+       NWrong);
+
+   // Out of range members and time levels must be rejected
+   Array2DReal Invalid;
+   int InvalidErr =
+       (Ensemble->getMemberLayerThickness(Invalid, NMembers) != 0) +
+       (Ensemble->getMemberNormalVelocity(Invalid, 0, 2) != 0);
+
+   if (Err == 0 && NWrong == 0 && InvalidErr == 2 &&
+       Ensemble->getNumMembers() == NMembers &&
+       Thick.extent_int(0) == NMembers &&
+       Thick.extent_int(1) == Mesh->NCellsSize &&
+       Thick.extent_int(2) == NVertLevels &&
+       Vel.extent_int(1) == Mesh->NEdgesSize &&
+       OceanEnsemble::get("Test") == Ensemble) {
+      LOG_INFO("OceanEnsembleTest: create: PASS");
+   } else {
+      LOG_ERROR("OceanEnsembleTest: create: {} errors: FAIL", NWrong);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testCreate
+
+//------------------------------------------------------------------------------
+// Set the next time level of all members on owned elements, advance the
+// time levels and check the halos of every member
+
+int testTimeLevels(OceanEnsemble *Ensemble) {
+
+   int Err = 0;
+
+   Decomp *DefDecomp = Decomp::getDefault();
+   HorzMesh *Mesh    = HorzMesh::getDefault();
+   Array1DI4 CellID  = DefDecomp->CellID;
+   Array1DI4 EdgeID  = DefDecomp->EdgeID;
+
+   EnsembleArray CurThick;
+   EnsembleArray NextThick;
+   EnsembleArray NextVel;
+   Err += Ensemble->getLayerThickness(CurThick, 0);
+   Err += Ensemble->getLayerThickness(NextThick, 1);
+   Err += Ensemble->getNormalVelocity(NextVel, 1);
+
+   // One launch over all members of each variable
+   parallelFor(
+       {NMembers, Mesh->NCellsOwned, NVertLevels},
+       KOKKOS_LAMBDA(int Member, int ICell, int K) {
+          NextThick(Member, ICell, K) = memberValue(CellID(ICell), K, Member);
+       });
+   parallelFor(
+       {NMembers, Mesh->NEdgesOwned, NVertLevels},
+       KOKKOS_LAMBDA(int Member, int IEdge, int K) {
+          NextVel(Member, IEdge, K) = memberValue(EdgeID(IEdge), K, Member);
+       });
+
+   Err += Ensemble->updateTimeLevels();
+
+   EnsembleArray NewThick;
+   EnsembleArray NewNextThick;
+   Err += Ensemble->getLayerThickness(NewThick, 0);
+   Err += Ensemble->getLayerThickness(NewNextThick, 1);
+
+   int NErr = 0;
+   for (int Member = 0; Member < NMembers; ++Member) {
+      Array2DReal MemberThick;
+      Array2DReal MemberVel;
+      Err += Ensemble->getMemberLayerThickness(MemberThick, Member);
+      Err += Ensemble->getMemberNormalVelocity(MemberVel, Member);
+      auto ThickH = createHostMirrorCopy(MemberThick);
+      auto VelH   = createHostMirrorCopy(MemberVel);
+      for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            if (ThickH(ICell, K) !=
+                memberValue(DefDecomp->CellIDH(ICell), K, Member))
+               ++NErr;
+         }
+      }
+      for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            if (VelH(IEdge, K) !=
+                memberValue(DefDecomp->EdgeIDH(IEdge), K, Member))
+               ++NErr;
+         }
+      }
+   }
+
+   if (Err == 0 && NErr == 0 && NewThick.data() == NextThick.data() &&
+       NewNextThick.data() == CurThick.data()) {
+      LOG_INFO("OceanEnsembleTest: time levels: PASS");
+   } else {
+      LOG_ERROR("OceanEnsembleTest: time levels: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testTimeLevels
+
+//------------------------------------------------------------------------------
+// Check the mean and standard deviation of the members set by
+// testTimeLevels, which differ by 1000 between consecutive members
+
+int testStatistics(OceanEnsemble *Ensemble) {
+
+   int Err = 0;
+
+   Decomp *DefDecomp = Decomp::getDefault();
+   HorzMesh *Mesh    = HorzMesh::getDefault();
+
+   Array2DReal MeanThick("MeanThick", Mesh->NCellsOwned, NVertLevels);
+   Array2DReal SpreadThick("SpreadThick", Mesh->NCellsOwned, NVertLevels);
+   Array2DReal MeanVel("MeanVel", Mesh->NEdgesOwned, NVertLevels);
+   Array2DReal SpreadVel("SpreadVel", Mesh->NEdgesOwned, NVertLevels);
+   Err += Ensemble->computeStatistics(MeanThick, SpreadThick, MeanVel,
+                                      SpreadVel);
+
+   const R8 MeanShift = 1000.0 * (NMembers - 1) / 2.0;
+   const R8 Spread = 1000.0 * std::sqrt((NMembers * NMembers - 1) / 12.0);
+   const R8 RTol   = sizeof(Real) == 4 ? 1e-6 : 1e-12;
+
+   auto MeanH   = createHostMirrorCopy(MeanThick);
+   auto SpreadH = createHostMirrorCopy(SpreadThick);
+   auto VelH    = createHostMirrorCopy(MeanVel);
+   int NErr     = 0;
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         const R8 Mean = memberValue(DefDecomp->CellIDH(ICell), K, 0) +
+                         MeanShift;
+         if (std::abs(MeanH(ICell, K) - Mean) > RTol * Mean ||
+             std::abs(SpreadH(ICell, K) - Spread) > RTol * Mean)
+            ++NErr;
+      }
+   }
+   for (int IEdge = 0; IEdge < Mesh->NEdgesOwned; ++IEdge) {
+      const R8 Mean = memberValue(DefDecomp->EdgeIDH(IEdge), 0, 0) +
+                      MeanShift;
+      if (std::abs(VelH(IEdge, 0) - Mean) > RTol * Mean)
+         ++NErr;
+   }
+
+   if (Err == 0 && NErr == 0) {
+      LOG_INFO("OceanEnsembleTest: statistics: PASS");
+   } else {
+      LOG_ERROR("OceanEnsembleTest: statistics: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testStatistics
+
+//------------------------------------------------------------------------------
+// Step the ensemble and a copy of one member alone with the same stepper,
+// which must give bitwise identical results
+
+int testStep(OceanEnsemble *Ensemble) {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+   Calendar CalGreg("Gregorian", CalendarGregorian);
+   TimeInstant StartTime(&CalGreg, 2000, 1, 1, 0, 0, 0.0);
+   TimeInterval TimeStep(0.1, TimeUnits::Seconds);
+   Clock EnsembleClock(StartTime, TimeStep);
+   Clock MemberClock(StartTime, TimeStep);
+
+   DecayTendencies Tend(Mesh);
+   TimeStepper *Stepper = TimeStepper::create(
+       "Ensemble", TimeStepperType::RungeKutta2, &Tend, Mesh,
+       Halo::getDefault(), NVertLevels);
+   if (Stepper == nullptr) {
+      LOG_ERROR("OceanEnsembleTest: error creating stepper");
+      return 1;
+   }
+
+   // Copy of the last member, advanced alone
+   const I4 Last = NMembers - 1;
+   Array2DReal LastVel;
+   Array2DReal LastThick;
+   Err += Ensemble->getMemberNormalVelocity(LastVel, Last);
+   Err += Ensemble->getMemberLayerThickness(LastThick, Last);
+   Array2DReal AloneVel("AloneVel", Mesh->NEdgesSize, NVertLevels);
+   Array2DReal AloneThick("AloneThick", Mesh->NCellsSize, NVertLevels);
+   deepCopy(AloneVel, LastVel);
+   deepCopy(AloneThick, LastThick);
+
+   const int NSteps = 4;
+   for (int Step = 0; Step < NSteps; ++Step) {
+      Err += Stepper->doStep(Ensemble, &EnsembleClock);
+      Err += Stepper->doStep(AloneVel, AloneThick, &MemberClock);
+   }
+
+   auto EnsVelH   = createHostMirrorCopy(LastVel);
+   auto AloneVelH = createHostMirrorCopy(AloneVel);
+   int NErr       = 0;
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (EnsVelH(IEdge, K) != AloneVelH(IEdge, K))
+            ++NErr;
+      }
+   }
+
+   if (Err == 0 && NErr == 0 &&
+       EnsembleClock.getCurrentTime() == MemberClock.getCurrentTime()) {
+      LOG_INFO("OceanEnsembleTest: step: PASS");
+   } else {
+      LOG_ERROR("OceanEnsembleTest: step: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   TimeStepper::erase("Ensemble");
+
+   return Err;
+
+} // end testStep
+
+//------------------------------------------------------------------------------
+// The initialization routine for ensemble testing
+
+int initOceanEnsembleTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("OceanEnsembleTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("OceanEnsembleTest: error initializing default decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("OceanEnsembleTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("OceanEnsembleTest: error initializing default mesh");
+   }
+
+   return Err;
+
+} // end initOceanEnsembleTest
+
+//------------------------------------------------------------------------------
+// The test driver for ensembles
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initOceanEnsembleTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("OceanEnsembleTest: Error initializing");
+
+      OceanEnsemble *Ensemble =
+          OceanEnsemble::create("Test", HorzMesh::getDefault(),
+                                Halo::getDefault(), NMembers, NVertLevels, 2);
+      if (Ensemble == nullptr ||
+          OceanEnsemble::create("Test", HorzMesh::getDefault(),
+                                Halo::getDefault(), NMembers, NVertLevels,
+                                2) != nullptr) {
+         LOG_ERROR("OceanEnsembleTest: error creating ensemble");
+         RetVal += 1;
+      } else {
+         RetVal += testCreate(Ensemble);
+         RetVal += testTimeLevels(Ensemble);
+         RetVal += testStatistics(Ensemble);
+         RetVal += testStep(Ensemble);
+      }
+
+      if (RetVal == 0)
+         LOG_INFO("OceanEnsembleTest: Successful completion");
+
+      OceanEnsemble::clear();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
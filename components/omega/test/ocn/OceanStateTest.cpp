@@ -0,0 +1,267 @@
+//===-- Test driver for OMEGA OceanState -------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA ocean state
+///
+/// This driver tests that the ocean state allocates its time levels,
+/// exchanges the halos of the next time level and advances the time levels
+/// by swapping array handles, and that its IO fields always refer to the
+/// current time level.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "OceanState.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+using namespace OMEGA;
+
+constexpr I4 NVertLevels = 16;
+
+// Value of a state variable at the element with global ID GlobalID
+KOKKOS_INLINE_FUNCTION Real stateValue(int GlobalID, int K) {
+   return GlobalID + 0.01 * K;
+}
+
+//------------------------------------------------------------------------------
+// Check the sizes and time levels of the default state
+
+int testCreate() {
+
+   int Err = 0;
+
+   OceanState *State = OceanState::getDefault();
+   HorzMesh *Mesh    = HorzMesh::getDefault();
+
+   Array2DReal Thick0;
+   Array2DReal Thick1;
+   Array2DReal Vel0;
+   Err += State->getLayerThickness(Thick0, 0);
+   Err += State->getLayerThickness(Thick1, 1);
+   Err += State->getNormalVelocity(Vel0, 0);
+
+   // Out of range time levels must be rejected
+   Array2DReal Invalid;
+   int InvalidErr = State->getLayerThickness(Invalid, 2);
+
+   if (Err == 0 && InvalidErr != 0 && State->getNumTimeLevels() == 2 &&
+       Thick0.extent_int(0) == Mesh->NCellsSize &&
+       Thick0.extent_int(1) == NVertLevels &&
+       Vel0.extent_int(0) == Mesh->NEdgesSize &&
+       Thick0.data() != Thick1.data() &&
+       OceanState::get("Default") == State &&
+       IOField::isDefined("LayerThickness") &&
+       IOField::isDefined("NormalVelocity")) {
+      LOG_INFO("OceanStateTest: create: PASS");
+   } else {
+      LOG_ERROR("OceanStateTest: create: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testCreate
+
+//------------------------------------------------------------------------------
+// Set the next time level on owned elements, advance the time levels and
+// check that the handles were swapped and the halos filled
+
+int testTimeLevels() {
+
+   int Err = 0;
+
+   OceanState *State = OceanState::getDefault();
+   Decomp *DefDecomp = Decomp::getDefault();
+   Array1DI4 CellID  = DefDecomp->CellID;
+   Array1DI4 EdgeID  = DefDecomp->EdgeID;
+
+   Array2DReal CurThick;
+   Array2DReal NextThick;
+   Array2DReal NextVel;
+   Err += State->getLayerThickness(CurThick, 0);
+   Err += State->getLayerThickness(NextThick, 1);
+   Err += State->getNormalVelocity(NextVel, 1);
+
+   parallelFor(
+       {State->NCellsOwned, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          NextThick(ICell, K) = stateValue(CellID(ICell), K);
+       });
+   parallelFor(
+       {State->NEdgesOwned, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+          NextVel(IEdge, K) = stateValue(EdgeID(IEdge), K);
+       });
+
+   Err += State->updateTimeLevels();
+
+   Array2DReal NewThick;
+   Array2DReal NewVel;
+   Array2DReal NewNextThick;
+   Err += State->getLayerThickness(NewThick, 0);
+   Err += State->getNormalVelocity(NewVel, 0);
+   Err += State->getLayerThickness(NewNextThick, 1);
+
+   auto ThickH = createHostMirrorCopy(NewThick);
+   auto VelH   = createHostMirrorCopy(NewVel);
+   int NErr    = 0;
+   for (int ICell = 0; ICell < State->NCellsAll; ++ICell) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (ThickH(ICell, K) != stateValue(DefDecomp->CellIDH(ICell), K))
+            ++NErr;
+      }
+   }
+   for (int IEdge = 0; IEdge < State->NEdgesAll; ++IEdge) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (VelH(IEdge, K) != stateValue(DefDecomp->EdgeIDH(IEdge), K))
+            ++NErr;
+      }
+   }
+
+   // The IO fields must follow the current time level
+   auto ThickField = IOField::getData<Array2DReal>("LayerThickness");
+   auto VelField   = IOField::getData<Array2DReal>("NormalVelocity");
+
+   if (Err == 0 && NErr == 0 && NewThick.data() == NextThick.data() &&
+       NewVel.data() == NextVel.data() &&
+       NewNextThick.data() == CurThick.data() &&
+       ThickField.data() == NewThick.data() &&
+       VelField.data() == NewVel.data()) {
+      LOG_INFO("OceanStateTest: time levels: PASS");
+   } else {
+      LOG_ERROR("OceanStateTest: time levels: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testTimeLevels
+
+//------------------------------------------------------------------------------
+// Check that a second state has its own IO fields and is removed cleanly
+
+int testNamedState() {
+
+   int Err = 0;
+
+   OceanState *Other =
+       OceanState::create("Other", HorzMesh::getDefault(),
+                          Halo::getDefault(), NVertLevels, 3);
+   OceanState *Duplicate =
+       OceanState::create("Other", HorzMesh::getDefault(),
+                          Halo::getDefault(), NVertLevels, 3);
+
+   bool Created = Other != nullptr && Duplicate == nullptr &&
+                  Other->getNumTimeLevels() == 3 &&
+                  IOField::isDefined("LayerThicknessOther");
+
+   OceanState::erase("Other");
+
+   if (Created && !IOField::isDefined("LayerThicknessOther") &&
+       IOField::isDefined("LayerThickness")) {
+      LOG_INFO("OceanStateTest: named state: PASS");
+   } else {
+      LOG_ERROR("OceanStateTest: named state: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testNamedState
+
+//------------------------------------------------------------------------------
+// The initialization routine for ocean state testing
+
+int initOceanStateTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("OceanStateTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("OceanStateTest: error initializing default decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("OceanStateTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("OceanStateTest: error initializing default mesh");
+   }
+
+   int StateErr = OceanState::init(NVertLevels, 2);
+   if (StateErr != 0) {
+      Err++;
+      LOG_ERROR("OceanStateTest: error initializing default state");
+   }
+
+   return Err;
+
+} // end initOceanStateTest
+
+//------------------------------------------------------------------------------
+// The test driver for the ocean state
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initOceanStateTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("OceanStateTest: Error initializing");
+
+      RetVal += testCreate();
+      RetVal += testTimeLevels();
+      RetVal += testNamedState();
+
+      OceanState::clear();
+      if (OceanState::getDefault() == nullptr &&
+          !IOField::isDefined("LayerThickness")) {
+         LOG_INFO("OceanStateTest: clear: PASS");
+      } else {
+         LOG_ERROR("OceanStateTest: clear: FAIL");
+         RetVal += 1;
+      }
+
+      if (RetVal == 0)
+         LOG_INFO("OceanStateTest: Successful completion");
+
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
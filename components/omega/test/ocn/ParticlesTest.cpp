@@ -0,0 +1,300 @@
+//===-- Test driver for OMEGA Particles --------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA Lagrangian particles
+///
+/// This driver seeds a particle at the center of each owned cell and
+/// advects the particles in a solid-body rotation about the polar axis for
+/// long enough that most of them migrate to other tasks. It tests that no
+/// particle is lost, that every particle ends in the owned cell whose center
+/// is closest to it, and that the particles follow the exact rotation. It
+/// also tests that particles do not move in a zero velocity and that adding
+/// particles beyond the capacity is an error.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "Particles.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace OMEGA;
+
+constexpr Real U0        = 20;   // equatorial velocity (m/s)
+constexpr Real Dt        = 3600; // time step (s)
+constexpr int NSteps     = 24;   // number of steps
+constexpr R8 MaxLat      = 1.0;  // seed cells equatorward of this latitude
+constexpr R8 PathRelTol  = 0.1;  // position error relative to the path
+constexpr R8 StillRelTol = 1e-12;
+
+//------------------------------------------------------------------------------
+// Seeds a particle at the center of each owned cell equatorward of MaxLat,
+// with the global cell ID as its id, and returns the seed positions of all
+// tasks indexed by id
+
+std::vector<R8> seedParticles(Particles &Parts) {
+
+   HorzMesh *Mesh    = HorzMesh::getDefault();
+   Decomp *DefDecomp = Decomp::getDefault();
+
+   std::vector<I4> SeedCells;
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell)
+      if (std::abs(Mesh->LatCellH(ICell)) < MaxLat)
+         SeedCells.push_back(ICell);
+   const I4 NSeeds = SeedCells.size();
+
+   HostArray2DR8 Pos("Pos", NSeeds, 3);
+   HostArray1DI4 Cell("Cell", NSeeds);
+   HostArray1DI4 Levels("Levels", NSeeds);
+   HostArray1DI8 Ids("Ids", NSeeds);
+   std::vector<R8> SeedPos(3 * (DefDecomp->NCellsGlobal + 1), 0);
+   for (int I = 0; I < NSeeds; ++I) {
+      const I4 ICell = SeedCells[I];
+      Pos(I, 0)      = Mesh->XCellH(ICell);
+      Pos(I, 1)      = Mesh->YCellH(ICell);
+      Pos(I, 2)      = Mesh->ZCellH(ICell);
+      Cell(I)        = ICell;
+      Levels(I)      = 0;
+      Ids(I)         = DefDecomp->CellIDH(ICell);
+      for (int D = 0; D < 3; ++D)
+         SeedPos[3 * Ids(I) + D] = Pos(I, D);
+   }
+   MPI_Allreduce(MPI_IN_PLACE, SeedPos.data(), SeedPos.size(), MPI_DOUBLE,
+                 MPI_SUM, MachEnv::getDefaultEnv()->getComm());
+
+   if (Parts.add(Pos, Cell, Levels, Ids) != 0)
+      LOG_ERROR("ParticlesTest: error adding particles");
+
+   return SeedPos;
+
+} // end seedParticles
+
+//------------------------------------------------------------------------------
+// Sets the normal velocity of the zonal flow U0 cos(lat) times Scale
+
+Array2DReal zonalVelocity(Real Scale) {
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   HostArray2DReal VelH("VelH", Mesh->NEdgesSize, 1);
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge)
+      VelH(IEdge, 0) = Scale * U0 * std::cos(Mesh->LatEdgeH(IEdge)) *
+                       std::cos(Mesh->AngleEdgeH(IEdge));
+
+   return createDeviceMirrorCopy(VelH);
+
+} // end zonalVelocity
+
+//------------------------------------------------------------------------------
+// Returns the max distance of the particles from their expected positions,
+// the seed positions rotated about the polar axis by Angle, and counts the
+// particles that are not in the owned cell with the closest center
+
+R8 maxDistance(const Particles &Parts, const std::vector<R8> &SeedPos,
+               R8 Angle, I4 &NMisplaced) {
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   auto PosH  = createHostMirrorCopy(Parts.Position);
+   auto CellH = createHostMirrorCopy(Parts.CellIndx);
+   auto IdH   = createHostMirrorCopy(Parts.Id);
+
+   auto Dist2 = [&](int I, int ICell) {
+      const R8 DX = PosH(I, 0) - Mesh->XCellH(ICell);
+      const R8 DY = PosH(I, 1) - Mesh->YCellH(ICell);
+      const R8 DZ = PosH(I, 2) - Mesh->ZCellH(ICell);
+      return DX * DX + DY * DY + DZ * DZ;
+   };
+
+   R8 MaxDist = 0;
+   NMisplaced = 0;
+   for (int I = 0; I < Parts.getNumParticles(); ++I) {
+      const R8 *X0 = &SeedPos[3 * IdH(I)];
+      const R8 XEx = X0[0] * std::cos(Angle) - X0[1] * std::sin(Angle);
+      const R8 YEx = X0[0] * std::sin(Angle) + X0[1] * std::cos(Angle);
+      const R8 ZEx = X0[2];
+      const R8 DX  = PosH(I, 0) - XEx;
+      const R8 DY  = PosH(I, 1) - YEx;
+      const R8 DZ  = PosH(I, 2) - ZEx;
+      MaxDist = std::max(MaxDist, std::sqrt(DX * DX + DY * DY + DZ * DZ));
+
+      const I4 ICell = CellH(I);
+      bool Closest   = ICell < Mesh->NCellsOwned;
+      for (int J = 0; Closest && J < Mesh->NEdgesOnCellH(ICell); ++J) {
+         const I4 JCell = Mesh->CellsOnCellH(ICell, J);
+         if (JCell < Mesh->NCellsAll && Dist2(I, JCell) < Dist2(I, ICell))
+            Closest = false;
+      }
+      if (!Closest)
+         ++NMisplaced;
+   }
+
+   MPI_Comm Comm = MachEnv::getDefaultEnv()->getComm();
+   MPI_Allreduce(MPI_IN_PLACE, &MaxDist, 1, MPI_DOUBLE, MPI_MAX, Comm);
+   MPI_Allreduce(MPI_IN_PLACE, &NMisplaced, 1, MPI_INT, MPI_SUM, Comm);
+
+   return MaxDist;
+
+} // end maxDistance
+
+//------------------------------------------------------------------------------
+// Tests particles in a zero velocity and in a solid-body rotation
+
+int testParticles() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh    = HorzMesh::getDefault();
+   Decomp *DefDecomp = Decomp::getDefault();
+
+   Particles Parts("Test", Mesh, DefDecomp, Halo::getDefault(), 1,
+                   DefDecomp->NCellsGlobal);
+   std::vector<R8> SeedPos = seedParticles(Parts);
+   const I8 NGlobal        = Parts.getGlobalNumParticles();
+   const R8 Radius         = std::sqrt(Mesh->XCellH(0) * Mesh->XCellH(0) +
+                                       Mesh->YCellH(0) * Mesh->YCellH(0) +
+                                       Mesh->ZCellH(0) * Mesh->ZCellH(0));
+
+   // Particles do not move in a zero velocity
+   Array2DReal Still = zonalVelocity(0);
+   Err += Parts.advance(Still, Dt);
+   I4 NMisplaced = 0;
+   R8 Dist       = maxDistance(Parts, SeedPos, 0, NMisplaced);
+   if (Dist < StillRelTol * Radius && NMisplaced == 0 &&
+       Parts.getGlobalNumParticles() == NGlobal) {
+      LOG_INFO("ParticlesTest: zero velocity: PASS");
+   } else {
+      LOG_ERROR("ParticlesTest: zero velocity moved particles by {}: FAIL",
+                Dist);
+      Err += 1;
+   }
+
+   // Solid-body rotation with angular velocity U0/Radius
+   Array2DReal Rotation = zonalVelocity(1);
+   for (int Step = 0; Step < NSteps; ++Step)
+      Err += Parts.advance(Rotation, Dt);
+
+   const R8 Path = U0 * Dt * NSteps;
+   Dist          = maxDistance(Parts, SeedPos, Path / Radius, NMisplaced);
+   if (Parts.getGlobalNumParticles() == NGlobal) {
+      LOG_INFO("ParticlesTest: {} particles conserved: PASS", NGlobal);
+   } else {
+      LOG_ERROR("ParticlesTest: {} particles became {}: FAIL", NGlobal,
+                Parts.getGlobalNumParticles());
+      Err += 1;
+   }
+   if (NMisplaced == 0) {
+      LOG_INFO("ParticlesTest: particles in containing cells: PASS");
+   } else {
+      LOG_ERROR("ParticlesTest: {} particles not in containing cells: FAIL",
+                NMisplaced);
+      Err += 1;
+   }
+   if (Dist < PathRelTol * Path) {
+      LOG_INFO("ParticlesTest: rotation error {} m: PASS", Dist);
+   } else {
+      LOG_ERROR("ParticlesTest: rotation error {} m over {} m: FAIL", Dist,
+                Path);
+      Err += 1;
+   }
+
+   // Adding particles beyond the capacity is an error
+   Particles Small("TestSmall", Mesh, DefDecomp, Halo::getDefault(), 1, 0);
+   HostArray2DR8 Pos("Pos", 1, 3);
+   HostArray1DI4 Cell("Cell", 1);
+   HostArray1DI4 Levels("Levels", 1);
+   HostArray1DI8 Ids("Ids", 1);
+   if (Small.add(Pos, Cell, Levels, Ids) != 0) {
+      LOG_INFO("ParticlesTest: capacity exceeded detected: PASS");
+   } else {
+      LOG_ERROR("ParticlesTest: capacity exceeded not detected: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testParticles
+
+//------------------------------------------------------------------------------
+// The initialization routine for particle testing
+
+int initParticlesTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("ParticlesTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("ParticlesTest: error initializing default decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("ParticlesTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("ParticlesTest: error initializing default mesh");
+   }
+
+   return Err;
+
+} // end initParticlesTest
+
+//------------------------------------------------------------------------------
+// The test driver for the particles
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initParticlesTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("ParticlesTest: Error initializing");
+
+      RetVal += testParticles();
+
+      if (RetVal == 0)
+         LOG_INFO("ParticlesTest: Successful completion");
+
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
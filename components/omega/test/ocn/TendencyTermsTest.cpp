@@ -0,0 +1,385 @@
+//===-- Test driver for OMEGA TendencyTerms ----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA shallow water tendency terms
+///
+/// This driver tests that the tendency terms match the horizontal operators,
+/// that the fused velocity tendency equals the sum of the tendencies of the
+/// individual terms, that a lake at rest has no pressure gradient, and that
+/// each tendency is computed in one loop over the owned elements.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "TendencyTerms.h"
+#include "AuxiliaryState.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "HorzOperators.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanState.h"
+#include "OceanTestCommon.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "mpi.h"
+
+#include <cmath>
+
+using namespace OMEGA;
+
+constexpr I4 NVertLevels = 16;
+
+//------------------------------------------------------------------------------
+// Set a smooth, positive thickness and a nonzero velocity on all elements
+
+int setState(const Array2DReal &LayerThick, const Array2DReal &NormalVel) {
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+   auto AreaCell  = Mesh->AreaCell;
+   auto AngleEdge = Mesh->AngleEdge;
+   auto AreaCellH = Mesh->AreaCellH;
+
+   Real MeanArea = 0;
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell)
+      MeanArea += AreaCellH(ICell) / Mesh->NCellsOwned;
+
+   parallelFor(
+       {Mesh->NCellsAll, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          LayerThick(ICell, K) = 10 + K + AreaCell(ICell) / MeanArea;
+       });
+   parallelFor(
+       {Mesh->NEdgesAll, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+          NormalVel(IEdge, K) = Kokkos::cos(AngleEdge(IEdge)) + 0.01 * K;
+       });
+
+   return 0;
+
+} // end setState
+
+//------------------------------------------------------------------------------
+// Returns options with only the given terms of the velocity equation enabled
+
+TendencyOptions velocityOptions(bool PV, bool KE, bool SSH, bool VelDiff,
+                                bool VelHyperDiff, bool BottomDrag) {
+   TendencyOptions Options;
+   Options.PVTendencyEnable           = PV;
+   Options.KETendencyEnable           = KE;
+   Options.SSHTendencyEnable          = SSH;
+   Options.VelDiffTendencyEnable      = VelDiff;
+   Options.VelHyperDiffTendencyEnable = VelHyperDiff;
+   Options.BottomDragTendencyEnable   = BottomDrag;
+   Options.ViscDel2                   = 1.0e3;
+   Options.ViscDel4                   = 1.0e10;
+   Options.BottomDragCoeff            = 1.0e-3;
+   return Options;
+}
+
+//------------------------------------------------------------------------------
+// Compare the thickness tendency and the kinetic energy gradient with the
+// horizontal operators
+
+int testOperators() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh           = HorzMesh::getDefault();
+   AuxiliaryState *AuxState = AuxiliaryState::get("Default");
+   TimeInstant Time;
+
+   Array2DReal LayerThick("TestThick", Mesh->NCellsSize, NVertLevels);
+   Array2DReal NormalVel("TestVel", Mesh->NEdgesSize, NVertLevels);
+   Err += setState(LayerThick, NormalVel);
+
+   ShallowWaterTendencies *KEOnly = ShallowWaterTendencies::create(
+       "KEOnly", Mesh, Halo::getDefault(), AuxState, NVertLevels,
+       velocityOptions(false, true, false, false, false, false));
+   if (KEOnly == nullptr)
+      return 1;
+
+   Array2DReal ThickTend("TestThickTend", Mesh->NCellsSize, NVertLevels);
+   Array2DReal VelTend("TestVelTend", Mesh->NEdgesSize, NVertLevels);
+   KEOnly->computeThicknessTendency(ThickTend, NormalVel, LayerThick, Time);
+   KEOnly->computeVelocityTendency(VelTend, NormalVel, LayerThick, Time);
+
+   Array2DReal DivCell("TestDiv", Mesh->NCellsSize, NVertLevels);
+   Array2DReal FluxDivCell("TestFluxDiv", Mesh->NCellsSize, NVertLevels);
+   Array2DReal GradEdge("TestGrad", Mesh->NEdgesSize, NVertLevels);
+   DivergenceAndFluxDivOnCell FluxDiv(Mesh);
+   GradientOnEdge Gradient(Mesh);
+   auto FluxLayerThickEdge = AuxState->LayerThicknessAux.FluxLayerThickEdge;
+   auto KineticEnergyCell  = AuxState->KineticAux.KineticEnergyCell;
+   parallelFor(
+       {Mesh->NCellsOwned, numVertChunks(NVertLevels)},
+       KOKKOS_LAMBDA(int ICell, int KChunk) {
+          FluxDiv(DivCell, FluxDivCell, ICell, KChunk, NormalVel,
+                  FluxLayerThickEdge);
+       });
+   parallelFor(
+       {Mesh->NEdgesOwned, numVertChunks(NVertLevels)},
+       KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          Gradient(GradEdge, IEdge, KChunk, KineticEnergyCell);
+       });
+
+   auto ThickTendH = createHostMirrorCopy(ThickTend);
+   auto VelTendH   = createHostMirrorCopy(VelTend);
+   auto FluxDivH   = createHostMirrorCopy(FluxDivCell);
+   auto GradH      = createHostMirrorCopy(GradEdge);
+   const Real RTol = sizeof(Real) == 4 ? 1e-5 : 1e-10;
+
+   int NErr = 0;
+   for (int K = 0; K < NVertLevels; ++K) {
+      for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+         if (!isApprox(ThickTendH(ICell, K), -FluxDivH(ICell, K), RTol))
+            ++NErr;
+      }
+      for (int IEdge = 0; IEdge < Mesh->NEdgesOwned; ++IEdge) {
+         if (!isApprox(VelTendH(IEdge, K), -GradH(IEdge, K), RTol))
+            ++NErr;
+      }
+   }
+
+   if (Err == 0 && NErr == 0) {
+      LOG_INFO("TendencyTermsTest: operators: PASS");
+   } else {
+      LOG_ERROR("TendencyTermsTest: operators: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   ShallowWaterTendencies::erase("KEOnly");
+
+   return Err;
+
+} // end testOperators
+
+//------------------------------------------------------------------------------
+// Check that the fused velocity tendency equals the sum of the tendencies of
+// the individual terms, and that it takes one loop over the owned edges
+
+int testFused() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh           = HorzMesh::getDefault();
+   AuxiliaryState *AuxState = AuxiliaryState::get("Default");
+   TimeInstant Time;
+
+   Array2DReal LayerThick("TestThick", Mesh->NCellsSize, NVertLevels);
+   Array2DReal NormalVel("TestVel", Mesh->NEdgesSize, NVertLevels);
+   Err += setState(LayerThick, NormalVel);
+
+   constexpr int NTerms = 6;
+   Array2DReal VelTend("TestVelTend", Mesh->NEdgesSize, NVertLevels);
+   HostArray2DReal SumH("TestSum", Mesh->NEdgesSize, NVertLevels);
+   HostArray2DReal AbsSumH("TestAbsSum", Mesh->NEdgesSize, NVertLevels);
+
+   for (int ITerm = 0; ITerm < NTerms; ++ITerm) {
+      ShallowWaterTendencies *Single = ShallowWaterTendencies::create(
+          "Single", Mesh, Halo::getDefault(), AuxState, NVertLevels,
+          velocityOptions(ITerm == 0, ITerm == 1, ITerm == 2, ITerm == 3,
+                          ITerm == 4, ITerm == 5));
+      if (Single == nullptr)
+         return 1;
+      Single->computeVelocityTendency(VelTend, NormalVel, LayerThick, Time);
+      auto VelTendH = createHostMirrorCopy(VelTend);
+      for (int IEdge = 0; IEdge < Mesh->NEdgesOwned; ++IEdge) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            SumH(IEdge, K) += VelTendH(IEdge, K);
+            AbsSumH(IEdge, K) += std::abs(VelTendH(IEdge, K));
+         }
+      }
+      ShallowWaterTendencies::erase("Single");
+   }
+
+   ShallowWaterTendencies *Fused = ShallowWaterTendencies::create(
+       "Fused", Mesh, Halo::getDefault(), AuxState, NVertLevels,
+       velocityOptions(true, true, true, true, true, true));
+   if (Fused == nullptr)
+      return 1;
+   Fused->computeVelocityTendency(VelTend, NormalVel, LayerThick, Time);
+   auto VelTendH = createHostMirrorCopy(VelTend);
+
+   // The sums of terms of different sizes are compared relative to the
+   // largest terms
+   const Real RTol = sizeof(Real) == 4 ? 1e-5 : 1e-10;
+   int NErr        = 0;
+   for (int IEdge = 0; IEdge < Mesh->NEdgesOwned; ++IEdge) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (std::abs(VelTendH(IEdge, K) - SumH(IEdge, K)) >
+             RTol * AbsSumH(IEdge, K))
+            ++NErr;
+      }
+   }
+
+   // One edge loop for the tendency and one for the biharmonic Laplacian
+   I4 Passes = Fused->getNumPasses();
+   Fused->VelocityHyperDiff.Enabled = false;
+   Fused->computeVelocityTendency(VelTend, NormalVel, LayerThick, Time);
+   bool Pass = Passes == 2 && Fused->getNumPasses() == 3;
+
+   if (Err == 0 && NErr == 0 && Pass) {
+      LOG_INFO("TendencyTermsTest: fused: PASS");
+   } else {
+      LOG_ERROR("TendencyTermsTest: fused: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   ShallowWaterTendencies::erase("Fused");
+
+   return Err;
+
+} // end testFused
+
+//------------------------------------------------------------------------------
+// Check that a flat sea surface over varying bottom depth has no pressure
+// gradient
+
+int testLakeAtRest() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh           = HorzMesh::getDefault();
+   AuxiliaryState *AuxState = AuxiliaryState::get("Default");
+   TimeInstant Time;
+
+   Array2DReal LayerThick("TestThick", Mesh->NCellsSize, NVertLevels);
+   Array2DReal NormalVel("TestVel", Mesh->NEdgesSize, NVertLevels);
+   auto BottomDepth = Mesh->BottomDepth;
+   parallelFor(
+       {Mesh->NCellsAll, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          LayerThick(ICell, K) = 100 + BottomDepth(ICell);
+       });
+
+   ShallowWaterTendencies *SSHOnly = ShallowWaterTendencies::create(
+       "SSHOnly", Mesh, Halo::getDefault(), AuxState, NVertLevels,
+       velocityOptions(false, false, true, false, false, false));
+   if (SSHOnly == nullptr)
+      return 1;
+
+   Array2DReal VelTend("TestVelTend", Mesh->NEdgesSize, NVertLevels);
+   SSHOnly->computeVelocityTendency(VelTend, NormalVel, LayerThick, Time);
+   auto VelTendH   = createHostMirrorCopy(VelTend);
+   auto ThickH     = createHostMirrorCopy(LayerThick);
+   const Real RTol = sizeof(Real) == 4 ? 1e-5 : 1e-10;
+
+   int NErr = 0;
+   for (int IEdge = 0; IEdge < Mesh->NEdgesOwned; ++IEdge) {
+      const int JCell0 = Mesh->CellsOnEdgeH(IEdge, 0);
+      const int JCell1 = Mesh->CellsOnEdgeH(IEdge, 1);
+      for (int K = 0; K < NVertLevels; ++K) {
+         const Real Scale = SSHOnly->SSHGrad.Gravity / Mesh->DcEdgeH(IEdge) *
+                            (ThickH(JCell0, K) + ThickH(JCell1, K));
+         if (std::abs(VelTendH(IEdge, K)) > RTol * Scale)
+            ++NErr;
+      }
+   }
+
+   if (Err == 0 && NErr == 0) {
+      LOG_INFO("TendencyTermsTest: lake at rest: PASS");
+   } else {
+      LOG_ERROR("TendencyTermsTest: lake at rest: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   ShallowWaterTendencies::erase("SSHOnly");
+
+   return Err;
+
+} // end testLakeAtRest
+
+//------------------------------------------------------------------------------
+// The initialization routine for tendency terms testing
+
+int initTendencyTermsTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: error initializing default "
+                "decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: error initializing default mesh");
+   }
+
+   int StateErr = OceanState::init(NVertLevels, 2);
+   if (StateErr != 0) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: error initializing default state");
+   }
+
+   AuxiliaryState *AuxState =
+       AuxiliaryState::create("Default", HorzMesh::getDefault(), NVertLevels,
+                              Center, OceanState::getDefault());
+   if (AuxState == nullptr) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: error creating auxiliary state");
+   }
+
+   return Err;
+
+} // end initTendencyTermsTest
+
+//------------------------------------------------------------------------------
+// The test driver for the tendency terms
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initTendencyTermsTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("TendencyTermsTest: Error initializing");
+
+      RetVal += testOperators();
+      RetVal += testFused();
+      RetVal += testLakeAtRest();
+
+      ShallowWaterTendencies::clear();
+
+      if (RetVal == 0)
+         LOG_INFO("TendencyTermsTest: Successful completion");
+
+      AuxiliaryState::clear();
+      OceanState::clear();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,588 @@
+//===-- Test driver for OMEGA time steppers ----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA time steppers
+///
+/// This driver tests the convergence order of the time stepping schemes on a
+/// problem with an exact solution: the velocity decays as du/dt = -Ra u and
+/// the thickness is forced as dh/dt = cos(t), so the order of both the state
+/// update and the stage times are checked. The split-explicit scheme with no
+/// barotropic tendency must reproduce the forward-backward scheme. With a
+/// gravity wave in the barotropic mode, the split-explicit scheme must give
+/// the same result with one halo layer per barotropic exchange as with the
+/// full halo, which needs fewer exchanges. Without the time-dependent
+/// forcing, each scheme must give the same result with and without the
+/// capture of its stages in kernel graphs.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "TimeStepper.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using namespace OMEGA;
+
+// Tendencies of the test problem
+class DecayTendencies : public Tendencies {
+ public:
+   DecayTendencies(HorzMesh *InMesh, I4 InNVertLevels,
+                   const TimeInstant &InStart)
+       : Mesh(InMesh), NVertLevels(InNVertLevels), StartTime(InStart) {}
+
+   void computeThicknessTendency(const Array2DReal &ThickTend,
+                                 const Array2DReal &NormalVelocity,
+                                 const Array2DReal &LayerThickness,
+                                 const TimeInstant &Time) override {
+      R8 Elapsed;
+      (Time - StartTime).get(Elapsed, TimeUnits::Seconds);
+      const Real Forcing = TimeForcing ? std::cos(Elapsed) : 0;
+      parallelFor(
+          {Mesh->NCellsOwned, NVertLevels},
+          KOKKOS_LAMBDA(int ICell, int K) { ThickTend(ICell, K) = Forcing; });
+   }
+
+   void computeVelocityTendency(const Array2DReal &VelTend,
+                                const Array2DReal &NormalVelocity,
+                                const Array2DReal &LayerThickness,
+                                const TimeInstant &Time) override {
+      const Real Rate = DecayRate;
+      parallelFor(
+          {Mesh->NEdgesOwned, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+             VelTend(IEdge, K) = -Rate * NormalVelocity(IEdge, K);
+          });
+   }
+
+   // Linear gravity wave with squared wave speed WaveSpeedSq, zero if it is
+   // zero
+   int computeBarotropicTendency(const Array1DReal &BtrVelTend,
+                                 const Array1DReal &BtrThickTend,
+                                 const Array1DReal &BtrVelocity,
+                                 const Array1DReal &BtrThickness,
+                                 const TimeInstant &Time, I4 NCells,
+                                 I4 NEdges) override {
+      if (WaveSpeedSq == 0) {
+         deepCopy(BtrVelTend, 0);
+         deepCopy(BtrThickTend, 0);
+         return 0;
+      }
+
+      const Real DepthFac = WaveSpeedSq / Gravity;
+      const Real Grav     = Gravity;
+      OMEGA_SCOPE(NEdgesOnCell, Mesh->NEdgesOnCell);
+      OMEGA_SCOPE(EdgesOnCell, Mesh->EdgesOnCell);
+      OMEGA_SCOPE(DvEdgeSignOnCell, Mesh->OpDvEdgeSignOnCell);
+      OMEGA_SCOPE(InvAreaCell, Mesh->OpInvAreaCell);
+      OMEGA_SCOPE(CellsOnEdge, Mesh->CellsOnEdge);
+      OMEGA_SCOPE(InvDcEdge, Mesh->OpInvDcEdge);
+      parallelFor(
+          {NCells}, KOKKOS_LAMBDA(int ICell) {
+             Real Flux = 0;
+             for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+                const int JEdge = EdgesOnCell(ICell, J);
+                Flux += DvEdgeSignOnCell(ICell, J) * BtrVelocity(JEdge);
+             }
+             BtrThickTend(ICell) = DepthFac * Flux * InvAreaCell(ICell);
+          });
+      parallelFor(
+          {NEdges}, KOKKOS_LAMBDA(int IEdge) {
+             const int JCell0  = CellsOnEdge(IEdge, 0);
+             const int JCell1  = CellsOnEdge(IEdge, 1);
+             BtrVelTend(IEdge) = -Grav * InvDcEdge(IEdge) *
+                                 (BtrThickness(JCell1) - BtrThickness(JCell0));
+          });
+      return 0;
+   }
+
+   // The forcing of the thickness depends on the time, so the stages can
+   // only be captured without it
+   bool canCaptureGraph() const override { return !TimeForcing; }
+
+   Real DecayRate   = 1;
+   Real WaveSpeedSq = 0;
+   Real Gravity     = 9.80616;
+   bool TimeForcing = true;
+
+ private:
+   HorzMesh *Mesh;
+   I4 NVertLevels;
+   TimeInstant StartTime;
+};
+
+// Errors of a run at the final time
+struct RunErrors {
+   R8 Vel;
+   R8 Thick;
+};
+
+constexpr I4 NVertLevels = 4;
+constexpr R8 FinalTime   = 1.0;
+
+//------------------------------------------------------------------------------
+// Integrate the test problem to FinalTime with NSteps steps of a stepper and
+// return the max errors on the owned elements
+
+int runStepper(RunErrors &Errors, const std::string &Name,
+               TimeStepperType Type, I4 NSteps, I4 NBtrSubcycles,
+               Array2DReal &NormalVelocity, Array2DReal &LayerThickness,
+               Real WaveSpeedSq = 0, I4 BtrHaloLayers = 0,
+               I4 *NBtrExchanges = nullptr) {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+   Calendar CalGreg("Gregorian", CalendarGregorian);
+   TimeInstant StartTime(&CalGreg, 2000, 1, 1, 0, 0, 0.0);
+   TimeInterval TimeStep(FinalTime / NSteps, TimeUnits::Seconds);
+   Clock ModelClock(StartTime, TimeStep);
+
+   DecayTendencies Tend(Mesh, NVertLevels, StartTime);
+   Tend.WaveSpeedSq = WaveSpeedSq;
+   TimeStepper *Stepper =
+       TimeStepper::create(Name, Type, &Tend, Mesh, Halo::getDefault(),
+                           NVertLevels, NBtrSubcycles);
+   if (Stepper == nullptr) {
+      LOG_ERROR("TimeStepperTest: error creating stepper {}", Name);
+      return 1;
+   }
+   auto *Split = Type == TimeStepperType::SplitExplicit
+                     ? static_cast<SplitExplicitStepper *>(Stepper)
+                     : nullptr;
+   if (Split != nullptr && BtrHaloLayers > 0)
+      Err += Split->setBtrHaloLayers(BtrHaloLayers);
+
+   NormalVelocity = Array2DReal("NormalVelocity", Mesh->NEdgesSize,
+                                NVertLevels);
+   LayerThickness = Array2DReal("LayerThickness", Mesh->NCellsSize,
+                                NVertLevels);
+   deepCopy(NormalVelocity, 1);
+   deepCopy(LayerThickness, 1);
+
+   for (int Step = 0; Step < NSteps; ++Step) {
+      Err += Stepper->doStep(NormalVelocity, LayerThickness, &ModelClock);
+   }
+
+   if (Split != nullptr && NBtrExchanges != nullptr)
+      *NBtrExchanges = Split->getNumBtrExchanges();
+
+   const R8 ExactVel   = std::exp(-Tend.DecayRate * FinalTime);
+   const R8 ExactThick = 1.0 + std::sin(FinalTime);
+
+   auto VelH   = createHostMirrorCopy(NormalVelocity);
+   auto ThickH = createHostMirrorCopy(LayerThickness);
+   R8 LocErrors[2] = {0.0, 0.0};
+   for (int IEdge = 0; IEdge < Mesh->NEdgesOwned; ++IEdge) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         LocErrors[0] =
+             std::max(LocErrors[0], std::abs(VelH(IEdge, K) - ExactVel));
+      }
+   }
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         LocErrors[1] =
+             std::max(LocErrors[1], std::abs(ThickH(ICell, K) - ExactThick));
+      }
+   }
+   R8 GlobErrors[2];
+   MPI_Allreduce(LocErrors, GlobErrors, 2, MPI_DOUBLE, MPI_MAX,
+                 MachEnv::getDefaultEnv()->getComm());
+   Errors.Vel   = GlobErrors[0];
+   Errors.Thick = GlobErrors[1];
+
+   TimeStepper::erase(Name);
+
+   return Err;
+
+} // end runStepper
+
+//------------------------------------------------------------------------------
+// Check the convergence order of a scheme from runs at two time steps
+
+int testOrder(const std::string &Name, TimeStepperType Type,
+              R8 ExpectedOrder) {
+
+   int Err = 0;
+
+   Array2DReal NormalVelocity;
+   Array2DReal LayerThickness;
+   RunErrors Coarse;
+   RunErrors Fine;
+   Err += runStepper(Coarse, Name + "Coarse", Type, 8, 1, NormalVelocity,
+                     LayerThickness);
+   Err += runStepper(Fine, Name + "Fine", Type, 16, 1, NormalVelocity,
+                     LayerThickness);
+
+   const R8 VelOrder   = std::log2(Coarse.Vel / Fine.Vel);
+   const R8 ThickOrder = std::log2(Coarse.Thick / Fine.Thick);
+
+   if (Err == 0 && std::abs(VelOrder - ExpectedOrder) < 0.2 &&
+       std::abs(ThickOrder - ExpectedOrder) < 0.2) {
+      LOG_INFO("TimeStepperTest: {} order {} {}: PASS", Name, VelOrder,
+               ThickOrder);
+   } else {
+      LOG_ERROR("TimeStepperTest: {} order {} {}, expected {}: FAIL", Name,
+                VelOrder, ThickOrder, ExpectedOrder);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testOrder
+
+//------------------------------------------------------------------------------
+// Check that the split-explicit scheme with no barotropic tendency matches
+// the forward-backward scheme for this problem
+
+int testSplitExplicit() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+
+   Array2DReal RefVelocity;
+   Array2DReal RefThickness;
+   Array2DReal NormalVelocity;
+   Array2DReal LayerThickness;
+   RunErrors RefErrors;
+   RunErrors Errors;
+   Err += runStepper(RefErrors, "Reference", TimeStepperType::ForwardBackward,
+                     8, 1, RefVelocity, RefThickness);
+   Err += runStepper(Errors, "Split", TimeStepperType::SplitExplicit, 8, 4,
+                     NormalVelocity, LayerThickness);
+
+   const R8 Tol = sizeof(Real) == 4 ? 1e-5 : 1e-12;
+
+   auto RefVelH   = createHostMirrorCopy(RefVelocity);
+   auto VelH      = createHostMirrorCopy(NormalVelocity);
+   auto RefThickH = createHostMirrorCopy(RefThickness);
+   auto ThickH    = createHostMirrorCopy(LayerThickness);
+   int NDiff      = 0;
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (std::abs(VelH(IEdge, K) - RefVelH(IEdge, K)) > Tol)
+            ++NDiff;
+      }
+   }
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (std::abs(ThickH(ICell, K) - RefThickH(ICell, K)) > Tol)
+            ++NDiff;
+      }
+   }
+
+   int GlobDiff;
+   MPI_Allreduce(&NDiff, &GlobDiff, 1, MPI_INT, MPI_SUM,
+                 MachEnv::getDefaultEnv()->getComm());
+
+   if (Err == 0 && GlobDiff == 0) {
+      LOG_INFO("TimeStepperTest: split-explicit: PASS");
+   } else {
+      LOG_ERROR("TimeStepperTest: split-explicit: {} values differ: FAIL",
+                GlobDiff);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testSplitExplicit
+
+//------------------------------------------------------------------------------
+// Check that the split-explicit scheme with a barotropic gravity wave gives
+// the same state with one halo layer per barotropic exchange as with the
+// full halo, and that the full halo needs fewer exchanges
+
+int testBtrHaloLayers() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh         = HorzMesh::getDefault();
+   const Real WaveSpeedSq = 1.0e4;
+   const I4 NSteps        = 8;
+   const I4 NBtrSubcycles = 12;
+
+   Array2DReal RefVelocity;
+   Array2DReal RefThickness;
+   Array2DReal NormalVelocity;
+   Array2DReal LayerThickness;
+   RunErrors Errors;
+   I4 NRefExchanges = 0;
+   I4 NExchanges    = 0;
+   Err += runStepper(Errors, "SplitOneLayer", TimeStepperType::SplitExplicit,
+                     NSteps, NBtrSubcycles, RefVelocity, RefThickness,
+                     WaveSpeedSq, 1, &NRefExchanges);
+   Err += runStepper(Errors, "SplitWideHalo", TimeStepperType::SplitExplicit,
+                     NSteps, NBtrSubcycles, NormalVelocity, LayerThickness,
+                     WaveSpeedSq, 0, &NExchanges);
+
+   const R8 Tol = sizeof(Real) == 4 ? 1e-5 : 1e-12;
+
+   auto RefVelH   = createHostMirrorCopy(RefVelocity);
+   auto VelH      = createHostMirrorCopy(NormalVelocity);
+   auto RefThickH = createHostMirrorCopy(RefThickness);
+   auto ThickH    = createHostMirrorCopy(LayerThickness);
+   int NDiff      = 0;
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (std::abs(VelH(IEdge, K) - RefVelH(IEdge, K)) > Tol)
+            ++NDiff;
+      }
+   }
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (std::abs(ThickH(ICell, K) - RefThickH(ICell, K)) > Tol)
+            ++NDiff;
+      }
+   }
+
+   int GlobDiff;
+   MPI_Allreduce(&NDiff, &GlobDiff, 1, MPI_INT, MPI_SUM,
+                 MachEnv::getDefaultEnv()->getComm());
+
+   // One layer needs an exchange every substep, while HaloWidth layers
+   // allow HaloWidth - 1 substeps per exchange
+   const bool FewerExchanges =
+       Mesh->HaloWidth < 2 || NExchanges < NRefExchanges;
+
+   if (Err == 0 && GlobDiff == 0 && FewerExchanges) {
+      LOG_INFO("TimeStepperTest: barotropic halo layers, {} and {} "
+               "exchanges: PASS",
+               NRefExchanges, NExchanges);
+   } else {
+      LOG_ERROR("TimeStepperTest: barotropic halo layers, {} values differ, "
+                "{} and {} exchanges: FAIL",
+                GlobDiff, NRefExchanges, NExchanges);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testBtrHaloLayers
+
+//------------------------------------------------------------------------------
+// Check that a scheme gives the same state with and without graph capture.
+// The state alternates between two pairs of arrays, as with time levels, so
+// that each pair has its own graphs.
+
+int testGraphCapture(const std::string &Name, TimeStepperType Type) {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+   Calendar CalGreg("Gregorian", CalendarGregorian);
+   TimeInstant StartTime(&CalGreg, 2000, 1, 1, 0, 0, 0.0);
+   TimeInterval TimeStep(FinalTime / 8, TimeUnits::Seconds);
+
+   DecayTendencies Tend(Mesh, NVertLevels, StartTime);
+   Tend.TimeForcing = false;
+
+   HostArray2DReal FinalVelH[2];
+   HostArray2DReal FinalThickH[2];
+   for (int Capture = 0; Capture < 2; ++Capture) {
+      const std::string StepperName = Name + "Graph" + std::to_string(Capture);
+      TimeStepper *Stepper =
+          TimeStepper::create(StepperName, Type, &Tend, Mesh,
+                              Halo::getDefault(), NVertLevels, 2);
+      if (Stepper == nullptr) {
+         LOG_ERROR("TimeStepperTest: error creating stepper {}", StepperName);
+         return 1;
+      }
+      Stepper->setGraphCapture(Capture == 1);
+
+      Array2DReal Vel[2];
+      Array2DReal Thick[2];
+      for (int Level = 0; Level < 2; ++Level) {
+         Vel[Level] =
+             Array2DReal("NormalVelocity", Mesh->NEdgesSize, NVertLevels);
+         Thick[Level] =
+             Array2DReal("LayerThickness", Mesh->NCellsSize, NVertLevels);
+      }
+      deepCopy(Vel[0], 1);
+      deepCopy(Thick[0], 1);
+
+      Clock ModelClock(StartTime, TimeStep);
+      for (int Step = 0; Step < 8; ++Step) {
+         const int Cur  = Step % 2;
+         const int Next = 1 - Cur;
+         deepCopy(Vel[Next], Vel[Cur]);
+         deepCopy(Thick[Next], Thick[Cur]);
+         Err += Stepper->doStep(Vel[Next], Thick[Next], &ModelClock);
+      }
+      FinalVelH[Capture]   = createHostMirrorCopy(Vel[0]);
+      FinalThickH[Capture] = createHostMirrorCopy(Thick[0]);
+
+      TimeStepper::erase(StepperName);
+   }
+
+   I4 NDiff = 0;
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge)
+      for (int K = 0; K < NVertLevels; ++K)
+         if (FinalVelH[0](IEdge, K) != FinalVelH[1](IEdge, K))
+            ++NDiff;
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell)
+      for (int K = 0; K < NVertLevels; ++K)
+         if (FinalThickH[0](ICell, K) != FinalThickH[1](ICell, K))
+            ++NDiff;
+   MPI_Allreduce(MPI_IN_PLACE, &NDiff, 1, MPI_INT, MPI_SUM,
+                 MachEnv::getDefaultEnv()->getComm());
+
+   if (Err == 0 && NDiff == 0) {
+      LOG_INFO("TimeStepperTest: {} graph capture: PASS", Name);
+   } else {
+      LOG_ERROR("TimeStepperTest: {} graph capture, {} values differ: FAIL",
+                Name, NDiff);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testGraphCapture
+
+//------------------------------------------------------------------------------
+// Check the creation, retrieval and removal of steppers
+
+int testRegistry() {
+
+   int Err = 0;
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+   Calendar CalGreg("Gregorian", CalendarGregorian);
+   TimeInstant StartTime(&CalGreg, 2000, 1, 1, 0, 0, 0.0);
+   DecayTendencies Tend(Mesh, NVertLevels, StartTime);
+
+   Err += TimeStepper::init(&Tend, NVertLevels);
+   TimeStepper *DefStepper = TimeStepper::getDefault();
+   if (Err == 0 && DefStepper != nullptr &&
+       DefStepper == TimeStepper::get("Default")) {
+      LOG_INFO("TimeStepperTest: init and get: PASS");
+   } else {
+      LOG_ERROR("TimeStepperTest: init and get: FAIL");
+      Err += 1;
+   }
+
+   // Duplicate names and unknown types are rejected
+   TimeStepper *Duplicate =
+       TimeStepper::create("Default", TimeStepperType::RungeKutta2, &Tend,
+                           Mesh, Halo::getDefault(), NVertLevels);
+   TimeStepper *Unknown =
+       TimeStepper::create("Unknown", getTimeStepperFromStr("Leapfrog"),
+                           &Tend, Mesh, Halo::getDefault(), NVertLevels);
+   if (Duplicate == nullptr && Unknown == nullptr &&
+       getTimeStepperFromStr("splitExplicit") ==
+           TimeStepperType::SplitExplicit) {
+      LOG_INFO("TimeStepperTest: create errors: PASS");
+   } else {
+      LOG_ERROR("TimeStepperTest: create errors: FAIL");
+      Err += 1;
+   }
+
+   TimeStepper::clear();
+   if (TimeStepper::getDefault() == nullptr) {
+      LOG_INFO("TimeStepperTest: clear: PASS");
+   } else {
+      LOG_ERROR("TimeStepperTest: clear: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testRegistry
+
+//------------------------------------------------------------------------------
+// The initialization routine for time stepper testing
+
+int initTimeStepperTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: error initializing default decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: error initializing default mesh");
+   }
+
+   return Err;
+
+} // end initTimeStepperTest
+
+//------------------------------------------------------------------------------
+// The test driver for time steppers
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initTimeStepperTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("TimeStepperTest: Error initializing");
+
+      RetVal += testOrder("ForwardBackward", TimeStepperType::ForwardBackward,
+                          1.0);
+      RetVal += testOrder("RungeKutta2", TimeStepperType::RungeKutta2, 2.0);
+      // Fourth-order errors are below single precision roundoff
+      if (sizeof(Real) == 8)
+         RetVal += testOrder("RungeKutta4", TimeStepperType::RungeKutta4, 4.0);
+      RetVal += testSplitExplicit();
+      RetVal += testBtrHaloLayers();
+      RetVal += testGraphCapture("ForwardBackward",
+                                 TimeStepperType::ForwardBackward);
+      RetVal += testGraphCapture("RungeKutta2", TimeStepperType::RungeKutta2);
+      RetVal += testGraphCapture("RungeKutta4", TimeStepperType::RungeKutta4);
+      RetVal +=
+          testGraphCapture("SplitExplicit", TimeStepperType::SplitExplicit);
+      RetVal += testRegistry();
+
+      if (RetVal == 0)
+         LOG_INFO("TimeStepperTest: Successful completion");
+
+      TimeStepper::clear();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
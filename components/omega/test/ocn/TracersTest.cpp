@@ -0,0 +1,291 @@
+//===-- Test driver for OMEGA Tracers ----------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA tracers
+///
+/// This driver tests the selection and indexing of tracers and tracer
+/// groups, batched kernels and halo exchanges over the packed tracer array,
+/// and the swapping of time levels. The Base and Debug groups defined in
+/// TracerDefs.inc are selected.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Tracers.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "IOField.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <cmath>
+
+using namespace OMEGA;
+
+constexpr I4 NVertLevels = 16;
+
+// Value of tracer ITracer in the cell with global ID GlobalCell at level K
+KOKKOS_INLINE_FUNCTION Real tracerValue(int ITracer, int GlobalCell, int K) {
+   return 1000 * ITracer + GlobalCell + 0.01 * K;
+}
+
+// Compare values that may differ by roundoff between host and device
+bool isClose(Real X, Real Y) {
+   return std::abs(X - Y) <= 1e-5 * std::abs(Y);
+}
+
+//------------------------------------------------------------------------------
+// Check the selection, indices and groups
+
+int testIndexing() {
+
+   int Err = 0;
+
+   I4 First     = -1;
+   I4 Count     = -1;
+   int RangeErr = Tracers::getGroupRange("Debug", First, Count);
+
+   if (Tracers::getNumTracers() == 5 && Tracers::getIndex("Temp") == 0 &&
+       Tracers::getIndex("Salt") == 1 && Tracers::getName(2) == "Debug1" &&
+       Tracers::getIndex("NotATracer") == -1 && RangeErr == 0 &&
+       First == 2 && Count == 3 && Tracers::isMember(1, "Base") &&
+       !Tracers::isMember(2, "Base") && Tracers::isMember(4, "All") &&
+       Tracers::getGroup("Base").size() == 2 &&
+       Tracers::getGroupIndices("Debug").extent(0) == 3 &&
+       IOField::isDefined("Temp") && !IOField::isDefined("NotATracer")) {
+      LOG_INFO("TracersTest: indexing and groups: PASS");
+   } else {
+      LOG_ERROR("TracersTest: indexing and groups: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testIndexing
+
+//------------------------------------------------------------------------------
+// Set all tracers on owned cells in one kernel, exchange all halos in one
+// exchange and check the halo values
+
+int testBatchedHalo() {
+
+   int Err = 0;
+
+   Decomp *DefDecomp  = Decomp::getDefault();
+   Array1DI4 CellID   = DefDecomp->CellID;
+   Array3DReal Tracer = Tracers::getAll(0);
+   const I4 NTracers  = Tracers::getNumTracers();
+   const I4 NCellsAll = DefDecomp->NCellsAll;
+
+   parallelFor(
+       {NTracers, DefDecomp->NCellsOwned, NVertLevels},
+       KOKKOS_LAMBDA(int ITracer, int ICell, int K) {
+          Tracer(ITracer, ICell, K) = tracerValue(ITracer, CellID(ICell), K);
+       });
+
+   Err += Tracers::exchangeHalo(0);
+
+   auto TracerH = createHostMirrorCopy(Tracer);
+   int NErr     = 0;
+   for (int ITracer = 0; ITracer < NTracers; ++ITracer) {
+      for (int ICell = 0; ICell < NCellsAll; ++ICell) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            const Real Expected =
+                tracerValue(ITracer, DefDecomp->CellIDH(ICell), K);
+            if (!isClose(TracerH(ITracer, ICell, K), Expected))
+               ++NErr;
+         }
+      }
+   }
+
+   if (Err == 0 && NErr == 0) {
+      LOG_INFO("TracersTest: batched halo exchange: PASS");
+   } else {
+      LOG_ERROR("TracersTest: batched halo exchange: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testBatchedHalo
+
+//------------------------------------------------------------------------------
+// Update one group through its device indices and another through its index
+// range, then check single tracers
+
+int testGroups() {
+
+   int Err = 0;
+
+   Decomp *DefDecomp  = Decomp::getDefault();
+   Array3DReal Tracer = Tracers::getAll(0);
+   const I4 NCellsAll = DefDecomp->NCellsAll;
+
+   // Add one to the Debug tracers with the group indices
+   Array1DI4 DebugIndices = Tracers::getGroupIndices("Debug");
+   parallelFor(
+       {DebugIndices.extent_int(0), NCellsAll, NVertLevels},
+       KOKKOS_LAMBDA(int IMember, int ICell, int K) {
+          Tracer(DebugIndices(IMember), ICell, K) += 1;
+       });
+
+   // Double the Base tracers selected from a contiguous index range
+   I4 First;
+   I4 Count;
+   Err += Tracers::getGroupRange("Base", First, Count);
+   parallelFor(
+       {Count, NCellsAll, NVertLevels},
+       KOKKOS_LAMBDA(int IMember, int ICell, int K) {
+          Tracer(First + IMember, ICell, K) *= 2;
+       });
+
+   int NErr = 0;
+   for (int ITracer = 0; ITracer < Tracers::getNumTracers(); ++ITracer) {
+      auto SingleH = createHostMirrorCopy(Tracers::get(ITracer, 0));
+      for (int ICell = 0; ICell < NCellsAll; ++ICell) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            Real Expected = tracerValue(ITracer, DefDecomp->CellIDH(ICell), K);
+            if (Tracers::isMember(ITracer, "Debug"))
+               Expected += 1;
+            if (Tracers::isMember(ITracer, "Base"))
+               Expected *= 2;
+            if (!isClose(SingleH(ICell, K), Expected))
+               ++NErr;
+         }
+      }
+   }
+
+   if (Err == 0 && NErr == 0) {
+      LOG_INFO("TracersTest: group kernels: PASS");
+   } else {
+      LOG_ERROR("TracersTest: group kernels: {} errors: FAIL", NErr);
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testGroups
+
+//------------------------------------------------------------------------------
+// Check that advancing the time levels swaps handles without copies
+
+int testTimeLevels() {
+
+   int Err = 0;
+
+   Array3DReal Cur  = Tracers::getAll(0);
+   Array3DReal Next = Tracers::getAll(1);
+   deepCopy(Next, 3);
+
+   Tracers::updateTimeLevels();
+
+   Array3DReal NewCur  = Tracers::getAll(0);
+   Array3DReal NewNext = Tracers::getAll(1);
+   auto NewCurH        = createHostMirrorCopy(NewCur);
+
+   if (Tracers::getNumTimeLevels() == 2 && NewCur.data() == Next.data() &&
+       NewNext.data() == Cur.data() && NewCurH(0, 0, 0) == 3) {
+      LOG_INFO("TracersTest: time levels: PASS");
+   } else {
+      LOG_ERROR("TracersTest: time levels: FAIL");
+      Err += 1;
+   }
+
+   return Err;
+
+} // end testTimeLevels
+
+//------------------------------------------------------------------------------
+// The initialization routine for tracer testing
+
+int initTracersTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefaultEnv();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   int IOErr = IO::init(DefComm);
+   if (IOErr != 0) {
+      Err++;
+      LOG_ERROR("TracersTest: error initializing parallel IO");
+   }
+
+   int DecompErr = Decomp::init();
+   if (DecompErr != 0) {
+      Err++;
+      LOG_ERROR("TracersTest: error initializing default decomposition");
+   }
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0) {
+      Err++;
+      LOG_ERROR("TracersTest: error initializing default halo");
+   }
+
+   int MeshErr = HorzMesh::init();
+   if (MeshErr != 0) {
+      Err++;
+      LOG_ERROR("TracersTest: error initializing default mesh");
+   }
+
+   int TracerErr = Tracers::init({"Base", "Debug"}, NVertLevels, 2);
+   if (TracerErr != 0) {
+      Err++;
+      LOG_ERROR("TracersTest: error initializing tracers");
+   }
+
+   return Err;
+
+} // end initTracersTest
+
+//------------------------------------------------------------------------------
+// The test driver for tracers
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      RetVal += initTracersTest();
+      if (RetVal != 0)
+         LOG_CRITICAL("TracersTest: Error initializing");
+
+      RetVal += testIndexing();
+      RetVal += testBatchedHalo();
+      RetVal += testGroups();
+      RetVal += testTimeLevels();
+
+      RetVal += Tracers::clear();
+      if (Tracers::getNumTracers() == 0 && !IOField::isDefined("Temp")) {
+         LOG_INFO("TracersTest: clear: PASS");
+      } else {
+         LOG_ERROR("TracersTest: clear: FAIL");
+         RetVal += 1;
+      }
+
+      if (RetVal == 0)
+         LOG_INFO("TracersTest: Successful completion");
+
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
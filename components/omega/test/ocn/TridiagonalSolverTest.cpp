@@ -0,0 +1,277 @@
+//===-- Test driver for OMEGA TridiagonalSolver ------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA batched tridiagonal solver
+///
+/// This driver tests that the solutions of the tridiagonal solver satisfy
+/// the systems to round-off, that columns beyond the requested number are
+/// not modified, that the solves with several right-hand sides match the
+/// solve with one for both distributions of the columns, and that arrays of
+/// the wrong size are rejected.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "TridiagonalSolver.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OMEGA;
+
+constexpr I4 NColumns    = 1000;
+constexpr I4 NVertLevels = 60;
+constexpr I4 NRhs        = 5;
+constexpr Real Tol       = 1.0e-10;
+
+//------------------------------------------------------------------------------
+// Sets the coefficients of a backward Euler vertical diffusion operator with
+// a diffusivity that varies between columns and levels
+
+void setCoeffs(const Array2DReal &Lower, const Array2DReal &Diag,
+               const Array2DReal &Upper) {
+
+   parallelFor(
+       {NColumns, NVertLevels}, KOKKOS_LAMBDA(int ICol, int K) {
+          const Real KappaAbove =
+              K > 0 ? 1 + Kokkos::sin(0.1 * ICol + 0.3 * K) : 0;
+          const Real KappaBelow =
+              K < NVertLevels - 1 ? 1 + Kokkos::cos(0.2 * ICol + 0.3 * K) : 0;
+          Lower(ICol, K) = -KappaAbove;
+          Upper(ICol, K) = -KappaBelow;
+          Diag(ICol, K)  = 1 + KappaAbove + KappaBelow;
+       });
+
+} // end setCoeffs
+
+//------------------------------------------------------------------------------
+// Sets the right-hand sides
+
+void setRhs(const Array3DReal &Rhs) {
+
+   parallelFor(
+       {NRhs, NColumns, NVertLevels}, KOKKOS_LAMBDA(int N, int ICol, int K) {
+          Rhs(N, ICol, K) = (N + 1) * Kokkos::cos(0.05 * ICol * (N + 1) + K);
+       });
+
+} // end setRhs
+
+//------------------------------------------------------------------------------
+// Copies right-hand side N into a two-dimensional array. A subview would be
+// strided with LayoutLeft.
+
+void copyRhs(const Array2DReal &Dst, const Array3DReal &Src, int N) {
+
+   parallelFor(
+       {NColumns, NVertLevels},
+       KOKKOS_LAMBDA(int ICol, int K) { Dst(ICol, K) = Src(N, ICol, K); });
+
+} // end copyRhs
+
+//------------------------------------------------------------------------------
+// Returns the max norm of the residual of the solution X of the system with
+// right-hand side Rhs in each of the first NCols columns
+
+Real maxResidual(const Array2DReal &Lower, const Array2DReal &Diag,
+                 const Array2DReal &Upper, const Array2DReal &X,
+                 const Array2DReal &Rhs, I4 NCols) {
+
+   auto LowerH = createHostMirrorCopy(Lower);
+   auto DiagH  = createHostMirrorCopy(Diag);
+   auto UpperH = createHostMirrorCopy(Upper);
+   auto XH     = createHostMirrorCopy(X);
+   auto RhsH   = createHostMirrorCopy(Rhs);
+
+   Real MaxRes = 0;
+   for (int ICol = 0; ICol < NCols; ++ICol) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         Real Ax = DiagH(ICol, K) * XH(ICol, K);
+         if (K > 0)
+            Ax += LowerH(ICol, K) * XH(ICol, K - 1);
+         if (K < NVertLevels - 1)
+            Ax += UpperH(ICol, K) * XH(ICol, K + 1);
+         MaxRes = std::max(MaxRes, std::abs(Ax - RhsH(ICol, K)));
+      }
+   }
+
+   return MaxRes;
+
+} // end maxResidual
+
+//------------------------------------------------------------------------------
+// Tests the solve with one right-hand side on a subset of the columns
+
+int testSingleRhs() {
+
+   int Err = 0;
+
+   Array2DReal Lower("Lower", NColumns, NVertLevels);
+   Array2DReal Diag("Diag", NColumns, NVertLevels);
+   Array2DReal Upper("Upper", NColumns, NVertLevels);
+   Array3DReal Rhs("Rhs", NRhs, NColumns, NVertLevels);
+   setCoeffs(Lower, Diag, Upper);
+   setRhs(Rhs);
+
+   Array2DReal Rhs0("Rhs0", NColumns, NVertLevels);
+   Array2DReal X("X", NColumns, NVertLevels);
+   copyRhs(Rhs0, Rhs, 0);
+   deepCopy(X, Rhs0);
+
+   TridiagonalSolver Solver("Test", NColumns, NVertLevels);
+
+   // Solve all but the last column, which must be left unchanged
+   const I4 NCols = NColumns - 1;
+   Err += Solver.solve(Lower, Diag, Upper, X, NCols);
+
+   Real MaxRes = maxResidual(Lower, Diag, Upper, X, Rhs0, NCols);
+   if (MaxRes > Tol) {
+      LOG_ERROR("TridiagonalSolverTest: single rhs residual {} FAIL", MaxRes);
+      ++Err;
+   }
+
+   auto XH    = createHostMirrorCopy(X);
+   auto Rhs0H = createHostMirrorCopy(Rhs0);
+   for (int K = 0; K < NVertLevels; ++K) {
+      if (XH(NCols, K) != Rhs0H(NCols, K)) {
+         LOG_ERROR("TridiagonalSolverTest: unsolved column modified FAIL");
+         ++Err;
+         break;
+      }
+   }
+
+   if (Err == 0)
+      LOG_INFO("TridiagonalSolverTest: single rhs PASS");
+
+   return Err;
+
+} // end testSingleRhs
+
+//------------------------------------------------------------------------------
+// Tests the solve with several right-hand sides for both distributions of
+// the columns against the solve with one right-hand side
+
+int testMultiRhs(ColumnParallelism Par, const std::string &ParName) {
+
+   int Err = 0;
+
+   Array2DReal Lower("Lower", NColumns, NVertLevels);
+   Array2DReal Diag("Diag", NColumns, NVertLevels);
+   Array2DReal Upper("Upper", NColumns, NVertLevels);
+   Array3DReal Rhs("Rhs", NRhs, NColumns, NVertLevels);
+   Array3DReal X("X", NRhs, NColumns, NVertLevels);
+   setCoeffs(Lower, Diag, Upper);
+   setRhs(Rhs);
+   deepCopy(X, Rhs);
+
+   TridiagonalSolver Solver("Test" + ParName, NColumns, NVertLevels);
+   Err += Solver.solve(Lower, Diag, Upper, X, NColumns, Par);
+
+   Array2DReal RhsN("RhsN", NColumns, NVertLevels);
+   Array2DReal XN("XN", NColumns, NVertLevels);
+   Array2DReal XSingle("XSingle", NColumns, NVertLevels);
+   for (int N = 0; N < NRhs; ++N) {
+      copyRhs(RhsN, Rhs, N);
+      copyRhs(XN, X, N);
+
+      Real MaxRes = maxResidual(Lower, Diag, Upper, XN, RhsN, NColumns);
+      if (MaxRes > Tol) {
+         LOG_ERROR("TridiagonalSolverTest: {} rhs {} residual {} FAIL",
+                   ParName, N, MaxRes);
+         ++Err;
+      }
+
+      deepCopy(XSingle, RhsN);
+      Err += Solver.solve(Lower, Diag, Upper, XSingle, NColumns);
+
+      auto XNH      = createHostMirrorCopy(XN);
+      auto XSingleH = createHostMirrorCopy(XSingle);
+      Real MaxDiff  = 0;
+      for (int ICol = 0; ICol < NColumns; ++ICol)
+         for (int K = 0; K < NVertLevels; ++K)
+            MaxDiff = std::max(MaxDiff,
+                               std::abs(XNH(ICol, K) - XSingleH(ICol, K)));
+      if (MaxDiff > Tol) {
+         LOG_ERROR("TridiagonalSolverTest: {} rhs {} differs from single "
+                   "rhs solve by {} FAIL",
+                   ParName, N, MaxDiff);
+         ++Err;
+      }
+   }
+
+   if (Err == 0)
+      LOG_INFO("TridiagonalSolverTest: {} multiple rhs PASS", ParName);
+
+   return Err;
+
+} // end testMultiRhs
+
+//------------------------------------------------------------------------------
+// Tests that arrays with the wrong extents are rejected
+
+int testExtents() {
+
+   int Err = 0;
+
+   Array2DReal Coeff("Coeff", NColumns, NVertLevels);
+   Array2DReal ShortX("ShortX", NColumns, NVertLevels - 1);
+   Array3DReal ShortMulti("ShortMulti", NRhs, NColumns / 2, NVertLevels);
+
+   TridiagonalSolver Solver("TestExtents", NColumns, NVertLevels);
+
+   if (Solver.solve(Coeff, Coeff, Coeff, ShortX, NColumns) == 0) {
+      LOG_ERROR("TridiagonalSolverTest: wrong number of levels accepted FAIL");
+      ++Err;
+   }
+   if (Solver.solve(Coeff, Coeff, Coeff, ShortMulti, NColumns) == 0) {
+      LOG_ERROR("TridiagonalSolverTest: wrong number of columns accepted "
+                "FAIL");
+      ++Err;
+   }
+   if (Solver.solve(Coeff, Coeff, Coeff, Coeff, NColumns + 1) == 0) {
+      LOG_ERROR("TridiagonalSolverTest: too many columns accepted FAIL");
+      ++Err;
+   }
+
+   if (Err == 0)
+      LOG_INFO("TridiagonalSolverTest: extent checks PASS");
+
+   return Err;
+
+} // end testExtents
+
+//------------------------------------------------------------------------------
+// The test driver for the tridiagonal solver
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+
+      RetVal += testSingleRhs();
+      RetVal += testMultiRhs(ColumnParallelism::Thread, "Thread");
+      RetVal += testMultiRhs(ColumnParallelism::Team, "Team");
+      RetVal += testExtents();
+
+      if (RetVal == 0)
+         LOG_INFO("TridiagonalSolverTest: Successful completion");
+
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
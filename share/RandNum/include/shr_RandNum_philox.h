@@ -0,0 +1,80 @@
+#pragma once
+
+/*
+ * Counter-based random numbers (Philox4x32-10, Salmon et al., SC11) for use
+ * inside device kernels.
+ *
+ * Unlike the dSFMT and KISS generators wrapped by shr_RandNum_mod, Philox
+ * has no state: each draw is a pure function of a key and a counter. Keying
+ * on the global column ID and putting the time step, a stream ID and the
+ * draw index in the counter gives random numbers that do not depend on the
+ * decomposition or on the order in which threads run, and that can be
+ * generated directly on the device.
+ *
+ * The functions are host/device callable under Kokkos or YAKL, and plain
+ * inline functions otherwise.
+ *
+ *   shr_randnum::Philox rng(gcol, nstep, stream);
+ *   double r = rng.uniform(n);   // n-th number of this (gcol, nstep, stream)
+ */
+
+#include <cstdint>
+
+#if defined(KOKKOS_INLINE_FUNCTION)
+#  define SHR_RANDNUM_INLINE KOKKOS_INLINE_FUNCTION
+#elif defined(YAKL_INLINE)
+#  define SHR_RANDNUM_INLINE YAKL_INLINE
+#else
+#  define SHR_RANDNUM_INLINE inline
+#endif
+
+namespace shr_randnum {
+
+// Streams in use, so that different parameterizations keyed on the same
+// column and step draw independent numbers. Add new streams at the end.
+enum Stream : uint32_t {
+  stream_crm_perturb = 1,
+};
+
+class Philox {
+public:
+  SHR_RANDNUM_INLINE Philox(uint64_t gcol, uint32_t nstep, uint32_t stream)
+    : key0_(static_cast<uint32_t>(gcol)), key1_(static_cast<uint32_t>(gcol >> 32)),
+      nstep_(nstep), stream_(stream) {}
+
+  // Four independent 32-bit words for draw index n.
+  SHR_RANDNUM_INLINE void bits(uint32_t n, uint32_t out[4]) const {
+    uint32_t c0 = n, c1 = 0, c2 = nstep_, c3 = stream_;
+    uint32_t k0 = key0_, k1 = key1_;
+    for (int r = 0; r < 10; ++r) {
+      uint32_t hi0, lo0, hi1, lo1;
+      mulhilo(0xD2511F53u, c0, hi0, lo0);
+      mulhilo(0xCD9E8D57u, c2, hi1, lo1);
+      uint32_t const n0 = hi1 ^ c1 ^ k0;
+      uint32_t const n2 = hi0 ^ c3 ^ k1;
+      c0 = n0; c1 = lo1; c2 = n2; c3 = lo0;
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+  }
+
+  // Uniform double in the open interval (0,1) with 53 random bits.
+  SHR_RANDNUM_INLINE double uniform(uint32_t n) const {
+    uint32_t w[4];
+    bits(n, w);
+    uint64_t const m = (static_cast<uint64_t>(w[0]) << 21) ^ (w[1] >> 11);
+    return (static_cast<double>(m) + 0.5) * (1.0 / 9007199254740992.0);
+  }
+
+private:
+  SHR_RANDNUM_INLINE static void mulhilo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo) {
+    uint64_t const p = static_cast<uint64_t>(a) * b;
+    hi = static_cast<uint32_t>(p >> 32);
+    lo = static_cast<uint32_t>(p);
+  }
+
+  uint32_t key0_, key1_, nstep_, stream_;
+};
+
+} // namespace shr_randnum
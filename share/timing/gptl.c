@@ -162,6 +162,9 @@ static int collect_data( const int, MPI_Comm, int *, Summarystats ** );
 static int collect_data( const int, const int, int *, Summarystats ** );
 #endif
 static int merge_thread_data();
+#ifdef HAVE_MPI
+static void summarystats_op (void *, void *, int *, MPI_Datatype *);
+#endif
 
 static void print_multparentinfo (FILE *, Timer *);
 static inline int get_cpustamp (long *, long *);
@@ -1044,6 +1047,37 @@ int GPTLstart (const char *timername)                  /* timer name */
   return (0);
 }
 
+/*
+** GPTLinit_handle: look up the handle of a timer for the calling thread
+** without starting it. The handle is set to 0 if the timer has not been
+** started yet on this thread; GPTLstart_handle then sets it on first use.
+**
+** Input arguments:
+**   name: timer name
+**   handle: pointer to timer matching "name" (output)
+**
+** Return value: 0 (success) or GPTLerror (failure)
+*/
+
+int GPTLinit_handle (const char *name,  /* timer name */
+		     void **handle)     /* handle (output) */
+{
+  int t;                                 /* thread index (of this thread) */
+  unsigned int indx;                     /* hash table index */
+  static const char *thisfunc = "GPTLinit_handle";
+
+  *handle = 0;
+
+  if ( ! initialized)
+    return 0;
+
+  if ((t = get_thread_num ()) < 0)
+    return GPTLerror ("%s: bad return from get_thread_num\n", thisfunc);
+
+  *handle = (void *) getentry (hashtable[t], name, &indx);
+  return 0;
+}
+
 /*
 ** GPTLstart_handle: start a timer based on a handle
 **
@@ -1105,9 +1139,11 @@ int GPTLstart_handle (const char *name,  /* timer name */
   /*
   ** If on input, handle references a non-zero value, assume it's a previously returned Timer*
   ** passed in by the user. If zero, generate the hash entry and return it to the user.
+  ** Timers live in per-thread tables, so a handle set by another thread is not used
+  ** (nor overwritten): this thread looks the timer up in its own table instead.
   */
 
-  if (*handle) {
+  if (*handle && ((Timer *) *handle)->thread == t) {
     ptr = (Timer *) *handle;
   } else {
     ptr = getentry (hashtable[t], name, &indx);
@@ -1384,9 +1420,11 @@ int GPTLstartf_handle (const char *name,  /* timer name */
   /*
   ** If on input, handle references a non-zero value, assume it's a previously returned Timer*
   ** passed in by the user. If zero, generate the hash entry and return it to the user.
+  ** Timers live in per-thread tables, so a handle set by another thread is not used
+  ** (nor overwritten): this thread looks the timer up in its own table instead.
   */
 
-  if (*handle) {
+  if (*handle && ((Timer *) *handle)->thread == t) {
     ptr = (Timer *) *handle;
   } else {
     numchars = MIN (namelen, MAX_CHARS);
@@ -1531,6 +1569,7 @@ static int update_ll_hash (Timer *ptr, const int t, const unsigned int indx)
   if (nchars > max_name_len[t])
     max_name_len[t] = nchars;
 
+  ptr->thread = t;
   last[t]->next = ptr;
   last[t] = ptr;
   ++hashtable[t][indx].nument;
@@ -1923,9 +1962,11 @@ int GPTLstop_handle (const char *name,     /* timer name */
   /*
   ** If on input, handle references a non-zero value, assume it's a previously returned Timer*
   ** passed in by the user. If zero, generate the hash entry and return it to the user.
+  ** Timers live in per-thread tables, so a handle set by another thread is not used
+  ** (nor overwritten): this thread looks the timer up in its own table instead.
   */
 
-  if (*handle) {
+  if (*handle && ((Timer *) *handle)->thread == t) {
     ptr = (Timer *) *handle;
   } else {
     if ( ! (ptr = getentry (hashtable[t], name, &indx)))
@@ -2195,9 +2236,11 @@ int GPTLstopf_handle (const char *name,     /* timer name */
   /*
   ** If on input, handle references a non-zero value, assume it's a previously returned Timer*
   ** passed in by the user. If zero, generate the hash entry and return it to the user.
+  ** Timers live in per-thread tables, so a handle set by another thread is not used
+  ** (nor overwritten): this thread looks the timer up in its own table instead.
   */
 
-  if (*handle) {
+  if (*handle && ((Timer *) *handle)->thread == t) {
     ptr = (Timer *) *handle;
   } else {
     if ( ! (ptr = getentryf (hashtable[t], name, namelen, &indx))){
@@ -3850,6 +3893,54 @@ static int collect_data(const int iam,
   }
 
 #ifdef HAVE_MPI
+  /*
+  ** Fast path: in the usual case every process has the same list of timers, in
+  ** the same order. Then the stats can be combined with a single MPI_Reduce,
+  ** instead of exchanging and merging timer names at each level of the tree below.
+  ** The reduction op is not marked commutative, so ties in max/min are resolved
+  ** in favor of the lower rank, as in the tree.
+  */
+  if (nproc > 1) {
+    unsigned long long hash = 14695981039346656037ULL;  /* FNV-1a of the timer names */
+    unsigned long long minmax[4];
+    MPI_Datatype stats_type;
+    MPI_Op stats_op;
+
+    x = 0;
+    for (k = 0; k < *count; k++) {
+      const char *c;
+      for (c = timerlist[0] + x; *c; ++c)
+        hash = (hash ^ (unsigned char) *c) * 1099511628211ULL;
+      hash = hash * 1099511628211ULL;
+      x += MAX_CHARS + 1;
+    }
+    /* max of ~v is ~(min of v), so one reduction gives min and max of both */
+    minmax[0] = *count;
+    minmax[1] = ~((unsigned long long) *count);
+    minmax[2] = hash;
+    minmax[3] = ~hash;
+    if ((ret = MPI_Allreduce (MPI_IN_PLACE, minmax, 4, MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm)) != MPI_SUCCESS)
+      return GPTLerror ("%s rank %d: Bad return from MPI_Allreduce=%d\n", thisfunc, iam, ret);
+
+    if (minmax[0] == ~minmax[1] && minmax[2] == ~minmax[3]) {
+      MPI_Type_contiguous (sizeof (Summarystats), MPI_BYTE, &stats_type);
+      MPI_Type_commit (&stats_type);
+      MPI_Op_create (summarystats_op, 0, &stats_op);
+      if (iam == 0)
+        ret = MPI_Reduce (MPI_IN_PLACE, summarystats, *count, stats_type, stats_op, 0, comm);
+      else
+        ret = MPI_Reduce (summarystats, 0, *count, stats_type, stats_op, 0, comm);
+      MPI_Op_free (&stats_op);
+      MPI_Type_free (&stats_type);
+      if (ret != MPI_SUCCESS)
+        return GPTLerror ("%s rank %d: Bad return from MPI_Reduce=%d\n", thisfunc, iam, ret);
+
+      free(tempname);
+      *summarystats_cumul = summarystats;
+      return 0;
+    }
+  }
+
   step = 1;
   mstep = 2;
   while( step < nproc ) {
@@ -3993,7 +4084,7 @@ static int collect_data(const int iam,
       if ((ret = MPI_Send (count, 1, MPI_INTEGER, procid, taga, comm)) != MPI_SUCCESS)
         return GPTLerror ("%s rank %d: Bad return from MPI_Send=%d\n", thisfunc, iam, ret);
 
-      if ( count != 0) {
+      if (*count != 0) {
         if ((ret = MPI_Recv (&signal, 1, MPI_INTEGER, procid, tagb, comm, MPI_STATUS_IGNORE)) != MPI_SUCCESS)
           return GPTLerror ("%s rank %d: Bad return from MPI_Recv=%d\n", thisfunc, iam, ret);
         if ((ret = MPI_Send (timerlist[0], (*count) * (MAX_CHARS + 1), MPI_CHAR, procid, tagb, comm)) != MPI_SUCCESS)
@@ -4019,6 +4110,27 @@ static int collect_data(const int iam,
   return 0;
 }
 
+#ifdef HAVE_MPI
+/*
+** summarystats_op: MPI reduction op combining the stats of identical timer lists.
+** Per MPI, inout = in op inout, with in coming from the lower ranks.
+*/
+
+static void summarystats_op (void *in, void *inout, int *len, MPI_Datatype *type)
+{
+  Summarystats *lo = (Summarystats *) in;
+  Summarystats *hi = (Summarystats *) inout;
+  Summarystats tmp;
+  int k;
+
+  for (k = 0; k < *len; k++) {
+    tmp = lo[k];
+    get_summarystats (&tmp, &hi[k]);
+    hi[k] = tmp;
+  }
+}
+#endif
+
 /*
 ** get_index: calculates the index number of an element in a list
 ** based on the start memory address and memory address of the element
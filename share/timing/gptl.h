@@ -134,6 +134,7 @@ extern int GPTLprefix_set (const char *);
 extern int GPTLprefix_setf (const char *, const int);
 extern int GPTLprefix_unset (void);
 extern int GPTLstart (const char *);
+extern int GPTLinit_handle (const char *, void **);
 extern int GPTLstart_handle (const char *, void **);
 extern int GPTLstartf (const char *, const int);
 extern int GPTLstartf_handle (const char *, const int, void **);
@@ -109,6 +109,7 @@ typedef struct TIMER {
   unsigned int nparent;     /* number of parents */
   unsigned int norphan;     /* number of times this timer was an orphan */
   int num_desc;             /* number of descendants */
+  int thread;               /* thread whose hash table holds this timer */
 } Timer;
 
 typedef struct {